@@ -0,0 +1,276 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/archive_asset_bundle.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <regex>
+#include <utility>
+
+#include "flutter/fml/endianness.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/zlib/zlib.h"
+
+namespace flutter {
+
+namespace {
+
+std::shared_ptr<const fml::FileMapping> MapArchive(
+    const fml::UniqueFD& archive_file) {
+  if (!archive_file.is_valid()) {
+    return nullptr;
+  }
+  auto mapping = std::make_shared<fml::FileMapping>(archive_file);
+  if (!mapping->IsValid()) {
+    return nullptr;
+  }
+  return mapping;
+}
+
+bool IsInBounds(uint64_t offset, uint64_t size, uint64_t bounds) {
+  return offset <= bounds && size <= bounds - offset;
+}
+
+}  // namespace
+
+uint64_t ArchiveAssetBundle::HashName(std::string_view name) {
+  uint64_t hash = 0xcbf29ce484222325u;
+  for (char c : name) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 0x100000001b3u;
+  }
+  return hash;
+}
+
+ArchiveAssetBundle::ArchiveAssetBundle(
+    const fml::UniqueFD& archive_file,
+    bool is_valid_after_asset_manager_change)
+    : ArchiveAssetBundle(MapArchive(archive_file),
+                         is_valid_after_asset_manager_change) {
+  archive_file_mapping_ =
+      std::static_pointer_cast<const fml::FileMapping>(archive_);
+}
+
+ArchiveAssetBundle::ArchiveAssetBundle(
+    std::shared_ptr<const fml::Mapping> archive,
+    bool is_valid_after_asset_manager_change)
+    : archive_(std::move(archive)) {
+  if (!archive_ || archive_->GetMapping() == nullptr ||
+      archive_->GetSize() < sizeof(Header)) {
+    return;
+  }
+
+  memcpy(&header_, archive_->GetMapping(), sizeof(Header));
+  header_.version = fml::LittleEndianToArch(header_.version);
+  header_.entry_count = fml::LittleEndianToArch(header_.entry_count);
+  header_.bucket_count = fml::LittleEndianToArch(header_.bucket_count);
+  header_.names_offset = fml::LittleEndianToArch(header_.names_offset);
+  header_.names_size = fml::LittleEndianToArch(header_.names_size);
+  if (memcmp(header_.magic, kArchiveMagic, sizeof(kArchiveMagic)) != 0) {
+    FML_LOG(ERROR) << "Asset archive has an invalid magic.";
+    return;
+  }
+  if (header_.version != kArchiveVersion) {
+    FML_LOG(ERROR) << "Asset archive has unsupported version "
+                   << header_.version << ".";
+    return;
+  }
+
+  // The index must have an empty bucket for lookups of missing names to
+  // terminate.
+  const uint64_t size = archive_->GetSize();
+  const uint64_t index_size =
+      static_cast<uint64_t>(header_.bucket_count) * sizeof(uint32_t) +
+      static_cast<uint64_t>(header_.entry_count) * sizeof(Entry);
+  if (header_.bucket_count <= header_.entry_count ||
+      !IsInBounds(sizeof(Header), index_size, size) ||
+      !IsInBounds(header_.names_offset, header_.names_size, size)) {
+    FML_LOG(ERROR) << "Asset archive has an invalid index.";
+    return;
+  }
+
+  is_valid_after_asset_manager_change_ = is_valid_after_asset_manager_change;
+  is_valid_ = true;
+}
+
+ArchiveAssetBundle::~ArchiveAssetBundle() = default;
+
+size_t ArchiveAssetBundle::GetEntryCount() const {
+  return is_valid_ ? header_.entry_count : 0u;
+}
+
+std::optional<ArchiveAssetBundle::Entry> ArchiveAssetBundle::GetEntry(
+    size_t index) const {
+  FML_DCHECK(index < header_.entry_count);
+  const auto offset = sizeof(Header) +
+                      header_.bucket_count * sizeof(uint32_t) +
+                      index * sizeof(Entry);
+  Entry entry;
+  memcpy(&entry, archive_->GetMapping() + offset, sizeof(Entry));
+  entry.name_hash = fml::LittleEndianToArch(entry.name_hash);
+  entry.name_offset = fml::LittleEndianToArch(entry.name_offset);
+  entry.name_size = fml::LittleEndianToArch(entry.name_size);
+  entry.data_offset = fml::LittleEndianToArch(entry.data_offset);
+  entry.data_size = fml::LittleEndianToArch(entry.data_size);
+  entry.uncompressed_size = fml::LittleEndianToArch(entry.uncompressed_size);
+  entry.compression = fml::LittleEndianToArch(entry.compression);
+
+  // Entries are only validated when they are used so that opening an archive
+  // doesn't touch every page of its index.
+  if (!IsInBounds(entry.name_offset, entry.name_size, header_.names_size) ||
+      !IsInBounds(entry.data_offset, entry.data_size, archive_->GetSize()) ||
+      entry.uncompressed_size > std::numeric_limits<uLongf>::max()) {
+    FML_LOG(ERROR) << "Asset archive has an invalid entry at " << index << ".";
+    return std::nullopt;
+  }
+  return entry;
+}
+
+std::string_view ArchiveAssetBundle::GetName(const Entry& entry) const {
+  return std::string_view(
+      reinterpret_cast<const char*>(archive_->GetMapping() +
+                                    header_.names_offset + entry.name_offset),
+      entry.name_size);
+}
+
+std::optional<ArchiveAssetBundle::Entry> ArchiveAssetBundle::FindEntry(
+    std::string_view name) const {
+  const auto hash = HashName(name);
+  const auto* buckets = archive_->GetMapping() + sizeof(Header);
+  for (uint32_t probe = 0; probe < header_.bucket_count; probe++) {
+    const auto bucket_index = (hash + probe) % header_.bucket_count;
+    uint32_t bucket;
+    memcpy(&bucket, buckets + bucket_index * sizeof(uint32_t),
+           sizeof(uint32_t));
+    bucket = fml::LittleEndianToArch(bucket);
+    if (bucket == 0u) {
+      return std::nullopt;
+    }
+    if (bucket > header_.entry_count) {
+      FML_LOG(ERROR) << "Asset archive has an invalid bucket.";
+      return std::nullopt;
+    }
+    auto entry = GetEntry(bucket - 1u);
+    if (entry.has_value() && entry->name_hash == hash &&
+        GetName(entry.value()) == name) {
+      return entry;
+    }
+  }
+  return std::nullopt;
+}
+
+std::unique_ptr<fml::Mapping> ArchiveAssetBundle::MapEntry(
+    const Entry& entry) const {
+  const auto* data = archive_->GetMapping() + entry.data_offset;
+  switch (static_cast<Compression>(entry.compression)) {
+    case Compression::kNone:
+      // The views keep the archive mapped after the bundle is gone.
+      return std::make_unique<fml::RangeMapping>(archive_, entry.data_offset,
+                                                 entry.data_size);
+    case Compression::kDeflate: {
+      TRACE_EVENT0("flutter", "ArchiveAssetBundle::Inflate");
+      if (entry.uncompressed_size == 0u) {
+        return std::make_unique<fml::MallocMapping>();
+      }
+      auto* inflated = static_cast<uint8_t*>(malloc(entry.uncompressed_size));
+      if (inflated == nullptr) {
+        FML_LOG(ERROR) << "Could not allocate " << entry.uncompressed_size
+                       << " bytes to inflate an asset.";
+        return nullptr;
+      }
+      auto inflated_size = static_cast<uLongf>(entry.uncompressed_size);
+      if (uncompress(inflated, &inflated_size, data,
+                     static_cast<uLong>(entry.data_size)) != Z_OK ||
+          inflated_size != entry.uncompressed_size) {
+        FML_LOG(ERROR) << "Could not inflate an asset.";
+        free(inflated);
+        return nullptr;
+      }
+      // The compressed data is no longer needed once it is inflated.
+      if (archive_file_mapping_) {
+        archive_file_mapping_->Advise(fml::FileMapping::Advice::kDontNeed,
+                                      entry.data_offset, entry.data_size);
+      }
+      return std::make_unique<fml::MallocMapping>(inflated, inflated_size);
+    }
+  }
+  FML_LOG(ERROR) << "Asset archive entry has unsupported compression "
+                 << entry.compression << ".";
+  return nullptr;
+}
+
+// |AssetResolver|
+bool ArchiveAssetBundle::IsValid() const {
+  return is_valid_;
+}
+
+// |AssetResolver|
+bool ArchiveAssetBundle::IsValidAfterAssetManagerChange() const {
+  return is_valid_after_asset_manager_change_;
+}
+
+// |AssetResolver|
+AssetResolver::AssetResolverType ArchiveAssetBundle::GetType() const {
+  return AssetResolver::AssetResolverType::kArchiveAssetBundle;
+}
+
+// |AssetResolver|
+std::unique_ptr<fml::Mapping> ArchiveAssetBundle::GetAsMapping(
+    const std::string& asset_name) const {
+  if (!is_valid_) {
+    FML_DLOG(WARNING) << "Asset bundle was not valid.";
+    return nullptr;
+  }
+
+  auto entry = FindEntry(asset_name);
+  if (!entry.has_value()) {
+    return nullptr;
+  }
+  return MapEntry(entry.value());
+}
+
+// |AssetResolver|
+std::vector<std::unique_ptr<fml::Mapping>> ArchiveAssetBundle::GetAsMappings(
+    const std::string& asset_pattern,
+    const std::optional<std::string>& subdir) const {
+  std::vector<std::unique_ptr<fml::Mapping>> mappings;
+  if (!is_valid_) {
+    FML_DLOG(WARNING) << "Asset bundle was not valid.";
+    return mappings;
+  }
+
+  // Like the directory bundle, match the file names of all assets, or of the
+  // assets directly in the subdirectory.
+  std::regex asset_regex(asset_pattern);
+  for (size_t i = 0; i < header_.entry_count; i++) {
+    auto entry = GetEntry(i);
+    if (!entry.has_value()) {
+      continue;
+    }
+    const auto name = GetName(entry.value());
+    const auto separator = name.rfind('/');
+    const auto directory = separator == std::string_view::npos
+                               ? std::string_view()
+                               : name.substr(0, separator);
+    const auto filename = separator == std::string_view::npos
+                              ? name
+                              : name.substr(separator + 1);
+    if (subdir.has_value() && directory != subdir.value()) {
+      continue;
+    }
+    if (!std::regex_match(filename.begin(), filename.end(), asset_regex)) {
+      continue;
+    }
+    auto mapping = MapEntry(entry.value());
+    if (mapping) {
+      mappings.push_back(std::move(mapping));
+    }
+  }
+  return mappings;
+}
+
+}  // namespace flutter
@@ -0,0 +1,135 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_ASSETS_ARCHIVE_ASSET_BUNDLE_H_
+#define FLUTTER_ASSETS_ARCHIVE_ASSET_BUNDLE_H_
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "flutter/assets/asset_resolver.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      An asset resolver for assets packed into a single archive file.
+///
+///             The whole archive is mapped once when the bundle is created
+///             and assets are found through a hashed index in constant time,
+///             so resolving an asset costs no system calls. Uncompressed
+///             assets are returned as views into the mapped archive, which is
+///             kept alive by the returned mappings. Compressed assets are only
+///             inflated when they are requested.
+///
+///             All fields of the archive are little-endian. An archive
+///             consists of:
+///
+///             * A `Header`.
+///             * `bucket_count` 32-bit buckets of an open addressing hash
+///               table with linear probing. Each bucket holds one plus the
+///               index of an entry, or 0 if it is empty. Entries are found
+///               starting at the bucket `HashName(name) % bucket_count`.
+///             * `entry_count` `Entry`s.
+///             * The names of the entries, at `names_offset`.
+///             * The contents of the entries. Uncompressed contents should
+///               start at multiples of `kArchiveAlignment`.
+///
+class ArchiveAssetBundle : public AssetResolver {
+ public:
+  /// The name of the archive in the assets directory of an application.
+  static constexpr char kArchiveFileName[] = "assets.pak";
+
+  static constexpr uint8_t kArchiveMagic[8] = {'F', 'L', 'T', 'A',
+                                               'S', 'S', 'E', 'T'};
+  static constexpr uint32_t kArchiveVersion = 1u;
+  static constexpr uint64_t kArchiveAlignment = 4096u;
+
+  enum class Compression : uint32_t {
+    kNone = 0,
+    /// A zlib stream.
+    kDeflate = 1,
+  };
+
+  struct __attribute__((packed, aligned(1))) Header {
+    uint8_t magic[8];
+    uint32_t version;
+    uint32_t entry_count;
+    uint32_t bucket_count;
+    uint32_t reserved;
+    uint64_t names_offset;
+    uint64_t names_size;
+  };
+
+  struct __attribute__((packed, aligned(1))) Entry {
+    uint64_t name_hash;
+    uint32_t name_offset;
+    uint32_t name_size;
+    uint64_t data_offset;
+    uint64_t data_size;
+    uint64_t uncompressed_size;
+    uint32_t compression;
+    uint32_t reserved;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      The FNV-1a hash of an asset name used by the index of the
+  ///             archive.
+  ///
+  static uint64_t HashName(std::string_view name);
+
+  ArchiveAssetBundle(const fml::UniqueFD& archive_file,
+                     bool is_valid_after_asset_manager_change);
+
+  ArchiveAssetBundle(std::shared_ptr<const fml::Mapping> archive,
+                     bool is_valid_after_asset_manager_change);
+
+  ~ArchiveAssetBundle() override;
+
+  size_t GetEntryCount() const;
+
+ private:
+  std::shared_ptr<const fml::Mapping> archive_;
+  // The archive, if the bundle mapped it from a file itself.
+  std::shared_ptr<const fml::FileMapping> archive_file_mapping_;
+  Header header_ = {};
+  bool is_valid_ = false;
+  bool is_valid_after_asset_manager_change_ = false;
+
+  std::optional<Entry> GetEntry(size_t index) const;
+
+  std::string_view GetName(const Entry& entry) const;
+
+  std::optional<Entry> FindEntry(std::string_view name) const;
+
+  std::unique_ptr<fml::Mapping> MapEntry(const Entry& entry) const;
+
+  // |AssetResolver|
+  bool IsValid() const override;
+
+  // |AssetResolver|
+  bool IsValidAfterAssetManagerChange() const override;
+
+  // |AssetResolver|
+  AssetResolver::AssetResolverType GetType() const override;
+
+  // |AssetResolver|
+  std::unique_ptr<fml::Mapping> GetAsMapping(
+      const std::string& asset_name) const override;
+
+  // |AssetResolver|
+  std::vector<std::unique_ptr<fml::Mapping>> GetAsMappings(
+      const std::string& asset_pattern,
+      const std::optional<std::string>& subdir) const override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ArchiveAssetBundle);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_ASSETS_ARCHIVE_ASSET_BUNDLE_H_
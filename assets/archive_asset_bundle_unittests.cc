@@ -0,0 +1,232 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/archive_asset_bundle.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "gtest/gtest.h"
+#include "third_party/zlib/zlib.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+struct TestAsset {
+  std::string name;
+  std::string contents;
+  bool compress = false;
+};
+
+template <typename T>
+void Append(std::vector<uint8_t>& archive, const T& value) {
+  const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+  archive.insert(archive.end(), bytes, bytes + sizeof(T));
+}
+
+std::vector<uint8_t> MakeArchive(const std::vector<TestAsset>& assets) {
+  using Bundle = ArchiveAssetBundle;
+  const uint32_t entry_count = assets.size();
+  const uint32_t bucket_count = entry_count * 2u + 1u;
+
+  std::string names;
+  std::vector<std::string> contents;
+  std::vector<Bundle::Entry> entries;
+  for (const auto& asset : assets) {
+    Bundle::Entry entry = {};
+    entry.name_hash = Bundle::HashName(asset.name);
+    entry.name_offset = names.size();
+    entry.name_size = asset.name.size();
+    entry.uncompressed_size = asset.contents.size();
+    names += asset.name;
+    if (asset.compress) {
+      uLongf size = compressBound(asset.contents.size());
+      std::string compressed(size, '\0');
+      EXPECT_EQ(compress(reinterpret_cast<Bytef*>(compressed.data()), &size,
+                         reinterpret_cast<const Bytef*>(asset.contents.data()),
+                         asset.contents.size()),
+                Z_OK);
+      compressed.resize(size);
+      entry.compression =
+          static_cast<uint32_t>(Bundle::Compression::kDeflate);
+      contents.push_back(compressed);
+    } else {
+      entry.compression = static_cast<uint32_t>(Bundle::Compression::kNone);
+      contents.push_back(asset.contents);
+    }
+    entry.data_size = contents.back().size();
+    entries.push_back(entry);
+  }
+
+  std::vector<uint32_t> buckets(bucket_count, 0u);
+  for (uint32_t i = 0; i < entry_count; i++) {
+    auto bucket = entries[i].name_hash % bucket_count;
+    while (buckets[bucket] != 0u) {
+      bucket = (bucket + 1u) % bucket_count;
+    }
+    buckets[bucket] = i + 1u;
+  }
+
+  Bundle::Header header = {};
+  memcpy(header.magic, Bundle::kArchiveMagic, sizeof(header.magic));
+  header.version = Bundle::kArchiveVersion;
+  header.entry_count = entry_count;
+  header.bucket_count = bucket_count;
+  header.names_offset = sizeof(Bundle::Header) +
+                        bucket_count * sizeof(uint32_t) +
+                        entry_count * sizeof(Bundle::Entry);
+  header.names_size = names.size();
+
+  // Page align the contents of every entry.
+  uint64_t data_offset = header.names_offset + names.size();
+  for (size_t i = 0; i < entries.size(); i++) {
+    data_offset = (data_offset + Bundle::kArchiveAlignment - 1u) /
+                  Bundle::kArchiveAlignment * Bundle::kArchiveAlignment;
+    entries[i].data_offset = data_offset;
+    data_offset += contents[i].size();
+  }
+
+  std::vector<uint8_t> archive;
+  Append(archive, header);
+  for (auto bucket : buckets) {
+    Append(archive, bucket);
+  }
+  for (const auto& entry : entries) {
+    Append(archive, entry);
+  }
+  archive.insert(archive.end(), names.begin(), names.end());
+  for (size_t i = 0; i < entries.size(); i++) {
+    archive.resize(entries[i].data_offset, 0u);
+    archive.insert(archive.end(), contents[i].begin(), contents[i].end());
+  }
+  return archive;
+}
+
+std::string ToString(const std::unique_ptr<fml::Mapping>& mapping) {
+  return std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                     mapping->GetSize());
+}
+
+}  // namespace
+
+TEST(ArchiveAssetBundleTest, FindsStoredAndCompressedAssets) {
+  auto archive = std::make_shared<fml::DataMapping>(MakeArchive({
+      {.name = "AssetManifest.json", .contents = "{}"},
+      {.name = "fonts/Roboto.ttf", .contents = "font"},
+      {.name = "shaders/ink.frag",
+       .contents = std::string(1000u, 'x'),
+       .compress = true},
+  }));
+  std::unique_ptr<AssetResolver> bundle =
+      std::make_unique<ArchiveAssetBundle>(archive, true);
+  ASSERT_TRUE(bundle->IsValid());
+  EXPECT_TRUE(bundle->IsValidAfterAssetManagerChange());
+  EXPECT_EQ(bundle->GetType(),
+            AssetResolver::AssetResolverType::kArchiveAssetBundle);
+
+  auto manifest = bundle->GetAsMapping("AssetManifest.json");
+  ASSERT_NE(manifest, nullptr);
+  EXPECT_EQ(ToString(manifest), "{}");
+  // Stored assets are views into the archive.
+  EXPECT_GE(manifest->GetMapping(), archive->GetMapping());
+  EXPECT_LT(manifest->GetMapping(),
+            archive->GetMapping() + archive->GetSize());
+
+  auto font = bundle->GetAsMapping("fonts/Roboto.ttf");
+  ASSERT_NE(font, nullptr);
+  EXPECT_EQ(ToString(font), "font");
+
+  auto shader = bundle->GetAsMapping("shaders/ink.frag");
+  ASSERT_NE(shader, nullptr);
+  EXPECT_EQ(ToString(shader), std::string(1000u, 'x'));
+
+  EXPECT_EQ(bundle->GetAsMapping("Roboto.ttf"), nullptr);
+  EXPECT_EQ(bundle->GetAsMapping("fonts/Roboto.ttf2"), nullptr);
+}
+
+TEST(ArchiveAssetBundleTest, MappingsOutliveTheBundle) {
+  std::unique_ptr<fml::Mapping> mapping;
+  {
+    auto archive = std::make_shared<fml::DataMapping>(
+        MakeArchive({{.name = "a", .contents = "contents"}}));
+    std::unique_ptr<AssetResolver> bundle =
+        std::make_unique<ArchiveAssetBundle>(std::move(archive), false);
+    mapping = bundle->GetAsMapping("a");
+  }
+  ASSERT_NE(mapping, nullptr);
+  EXPECT_EQ(ToString(mapping), "contents");
+}
+
+TEST(ArchiveAssetBundleTest, MatchesFileNamesOfPattern) {
+  std::unique_ptr<AssetResolver> bundle = std::make_unique<ArchiveAssetBundle>(
+      std::make_shared<fml::DataMapping>(MakeArchive({
+          {.name = "a.so", .contents = "a"},
+          {.name = "lib/b.so", .contents = "b", .compress = true},
+          {.name = "lib/c.txt", .contents = "c"},
+          {.name = "lib/nested/d.so", .contents = "d"},
+      })),
+      false);
+  ASSERT_TRUE(bundle->IsValid());
+
+  EXPECT_EQ(bundle->GetAsMappings(".*\\.so", std::nullopt).size(), 3u);
+
+  auto mappings = bundle->GetAsMappings(".*\\.so", "lib");
+  ASSERT_EQ(mappings.size(), 1u);
+  EXPECT_EQ(ToString(mappings[0]), "b");
+}
+
+TEST(ArchiveAssetBundleTest, OpensArchiveFiles) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  ASSERT_TRUE(fml::WriteAtomically(
+      temp_dir.fd(), ArchiveAssetBundle::kArchiveFileName,
+      fml::DataMapping(MakeArchive({{.name = "a", .contents = "contents"}}))));
+
+  std::unique_ptr<AssetResolver> bundle = std::make_unique<ArchiveAssetBundle>(
+      fml::OpenFileReadOnly(temp_dir.fd(),
+                            ArchiveAssetBundle::kArchiveFileName),
+      true);
+  ASSERT_TRUE(bundle->IsValid());
+  auto mapping = bundle->GetAsMapping("a");
+  ASSERT_NE(mapping, nullptr);
+  EXPECT_EQ(ToString(mapping), "contents");
+  EXPECT_TRUE(mapping->IsDontNeedSafe());
+}
+
+TEST(ArchiveAssetBundleTest, RejectsInvalidArchives) {
+  auto archive = MakeArchive({{.name = "a", .contents = "contents"}});
+
+  std::unique_ptr<AssetResolver> bundle = std::make_unique<ArchiveAssetBundle>(
+      std::make_shared<fml::DataMapping>(
+          std::vector<uint8_t>(archive.begin(), archive.begin() + 16)),
+      false);
+  EXPECT_FALSE(bundle->IsValid());
+
+  auto bad_magic = archive;
+  bad_magic[0] = 'X';
+  bundle = std::make_unique<ArchiveAssetBundle>(
+      std::make_shared<fml::DataMapping>(bad_magic), false);
+  EXPECT_FALSE(bundle->IsValid());
+
+  auto truncated_index = archive;
+  truncated_index.resize(sizeof(ArchiveAssetBundle::Header) + 4u);
+  bundle = std::make_unique<ArchiveAssetBundle>(
+      std::make_shared<fml::DataMapping>(truncated_index), false);
+  EXPECT_FALSE(bundle->IsValid());
+
+  // Entries pointing outside of the archive are not found.
+  auto truncated_data = archive;
+  truncated_data.resize(truncated_data.size() - 1u);
+  bundle = std::make_unique<ArchiveAssetBundle>(
+      std::make_shared<fml::DataMapping>(truncated_data), false);
+  ASSERT_TRUE(bundle->IsValid());
+  EXPECT_EQ(bundle->GetAsMapping("a"), nullptr);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -17,6 +17,7 @@
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/paths.h"
+#include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/shell/version/version.h"
 #include "openssl/sha.h"
@@ -86,7 +87,12 @@ bool PersistentCache::Purge() {
 
   std::promise<bool> removed;
   GetWorkerTaskRunner()->PostTask([&removed,
-                                   cache_directory = cache_directory_]() {
+                                   cache_directory = cache_directory_,
+                                   cache_file = cache_file_,
+                                   sksl_cache_file = sksl_cache_file_]() {
+    // Release the cache files so that they can be removed.
+    cache_file->Clear();
+    sksl_cache_file->Clear();
     if (cache_directory->is_valid()) {
       // Only remove files but not directories.
       FML_LOG(INFO) << "Purge persistent cache.";
@@ -110,6 +116,11 @@ namespace {
 
 constexpr char kEngineComponent[] = "flutter_engine";
 
+// The delay before stored objects are written, so that the objects compiled
+// over a few frames are written together.
+constexpr fml::TimeDelta kWriteBatchDelay =
+    fml::TimeDelta::FromMilliseconds(500);
+
 static void FreeOldCacheDirectory(const fml::UniqueFD& cache_base_dir) {
   fml::UniqueFD engine_dir =
       fml::OpenDirectoryReadOnly(cache_base_dir, kEngineComponent);
@@ -236,6 +247,10 @@ std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() const {
   // However, we'd like to continue visit the asset dir even if this persistent
   // cache is invalid.
   if (IsValid()) {
+    for (auto& entry : sksl_cache_file_->GetEntries()) {
+      result.push_back({std::move(entry.key), std::move(entry.value)});
+    }
+
     // In case `rewinddir` doesn't work reliably, load SkSLs from a freshly
     // opened directory (https://github.com/flutter/flutter/issues/65258).
     fml::UniqueFD fresh_dir =
@@ -279,7 +294,16 @@ PersistentCache::PersistentCache(bool read_only)
     : is_read_only_(read_only),
       cache_directory_(MakeCacheDirectory(cache_base_path_, read_only, false)),
       sksl_cache_directory_(
-          MakeCacheDirectory(cache_base_path_, read_only, true)) {
+          MakeCacheDirectory(cache_base_path_, read_only, true)),
+      cache_file_(std::make_shared<PersistentCacheFile>(cache_directory_,
+                                                        kCacheFileName,
+                                                        kMaxCacheFileSize,
+                                                        read_only)),
+      sksl_cache_file_(
+          std::make_shared<PersistentCacheFile>(cache_directory_,
+                                                kSkSLCacheFileName,
+                                                kMaxCacheFileSize,
+                                                read_only)) {
   if (!IsValid()) {
     FML_LOG(WARNING) << "Could not acquire the persistent cache directory. "
                         "Caching of GPU resources on disk is disabled.";
@@ -332,12 +356,16 @@ sk_sp<SkData> PersistentCache::load(const SkData& key) {
   if (!IsValid()) {
     return nullptr;
   }
+  auto result = cache_file_->Load(key);
+  if (result != nullptr) {
+    TRACE_EVENT0("flutter", "PersistentCacheLoadHit");
+    return result;
+  }
   auto file_name = SkKeyToFilePath(key);
   if (file_name.empty()) {
     return nullptr;
   }
-  auto result =
-      PersistentCache::LoadFile(*cache_directory_, file_name, false).value;
+  result = PersistentCache::LoadFile(*cache_directory_, file_name, false).value;
   if (result != nullptr) {
     TRACE_EVENT0("flutter", "PersistentCacheLoadHit");
   }
@@ -407,20 +435,28 @@ void PersistentCache::store(const SkData& key, const SkData& data) {
     return;
   }
 
-  auto file_name = SkKeyToFilePath(key);
-
-  if (file_name.empty()) {
+  if (key.data() == nullptr || key.size() == 0) {
     return;
   }
 
-  std::unique_ptr<fml::MallocMapping> mapping = BuildCacheObject(key, data);
-  if (!mapping) {
-    return;
+  const auto& file = cache_sksl_ ? sksl_cache_file_ : cache_file_;
+  if (file->Store(key, data)) {
+    ScheduleFlush(file);
   }
+}
 
-  PersistentCacheStore(GetWorkerTaskRunner(),
-                       cache_sksl_ ? sksl_cache_directory_ : cache_directory_,
-                       std::move(file_name), std::move(mapping));
+void PersistentCache::ScheduleFlush(
+    const std::shared_ptr<PersistentCacheFile>& file) const {
+  auto worker = GetWorkerTaskRunner();
+  if (!worker) {
+    FML_LOG(WARNING)
+        << "The persistent cache has no available workers. Performing the task "
+           "on the current thread. This slow operation is going to occur on a "
+           "frame workload.";
+    file->Flush();
+    return;
+  }
+  worker->PostDelayedTask([file]() { file->Flush(); }, kWriteBatchDelay);
 }
 
 void PersistentCache::DumpSkp(const SkData& data) {
@@ -454,6 +490,15 @@ void PersistentCache::RemoveWorkerTaskRunner(
   if (found != worker_task_runners_.end()) {
     worker_task_runners_.erase(found);
   }
+
+  // A flush scheduled on the worker may not run once the worker is gone.
+  if (task_runner) {
+    task_runner->PostTask(
+        [cache_file = cache_file_, sksl_cache_file = sksl_cache_file_]() {
+          cache_file->Flush();
+          sksl_cache_file->Flush();
+        });
+  }
 }
 
 fml::RefPtr<fml::TaskRunner> PersistentCache::GetWorkerTaskRunner() const {
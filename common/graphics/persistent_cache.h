@@ -10,6 +10,7 @@
 #include <set>
 
 #include "flutter/assets/asset_manager.h"
+#include "flutter/common/graphics/persistent_cache_file.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
 #include "flutter/fml/unique_fd.h"
@@ -132,6 +133,16 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   static constexpr char kSkSLSubdirName[] = "sksl";
   static constexpr char kAssetFileName[] = "io.flutter.shaders.json";
 
+  // The files in the cache directory that store the cached Skia objects and
+  // SkSLs. Caches from previous versions stored each object in its own file,
+  // these files are still read but no longer written.
+  static constexpr char kCacheFileName[] = "io.flutter.skia_cache";
+  static constexpr char kSkSLCacheFileName[] = "io.flutter.sksl_cache";
+
+  // The maximum size of the objects in each cache file. The least recently
+  // used objects are evicted beyond this size.
+  static constexpr size_t kMaxCacheFileSize = 16 * 1024 * 1024;
+
  private:
   static std::string cache_base_path_;
 
@@ -153,6 +164,8 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   const bool is_read_only_;
   const std::shared_ptr<fml::UniqueFD> cache_directory_;
   const std::shared_ptr<fml::UniqueFD> sksl_cache_directory_;
+  const std::shared_ptr<PersistentCacheFile> cache_file_;
+  const std::shared_ptr<PersistentCacheFile> sksl_cache_file_;
   mutable std::mutex worker_task_runners_mutex_;
   std::multiset<fml::RefPtr<fml::TaskRunner>> worker_task_runners_;
 
@@ -172,6 +185,9 @@ class PersistentCache : public GrContextOptions::PersistentCache {
 
   fml::RefPtr<fml::TaskRunner> GetWorkerTaskRunner() const;
 
+  // Writes the stored objects of |file| in a batch on the worker.
+  void ScheduleFlush(const std::shared_ptr<PersistentCacheFile>& file) const;
+
   friend class testing::ShellTest;
 
   FML_DISALLOW_COPY_AND_ASSIGN(PersistentCache);
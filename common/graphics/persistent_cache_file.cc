@@ -0,0 +1,369 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/common/graphics/persistent_cache_file.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+size_t GetRecordSize(size_t key_size, size_t value_size) {
+  return sizeof(PersistentCacheFile::RecordHeader) + key_size + value_size;
+}
+
+// Writes the record of a pair to |out| and returns the offset of the value in
+// the record.
+size_t WriteRecord(uint8_t* out,
+                   const std::string& key,
+                   const uint8_t* value,
+                   size_t value_size) {
+  const auto* key_bytes = reinterpret_cast<const uint8_t*>(key.data());
+  PersistentCacheFile::RecordHeader header;
+  header.key_size = key.size();
+  header.value_size = value_size;
+  header.checksum = PersistentCacheFile::ComputeChecksum(key_bytes, key.size(),
+                                                         value, value_size);
+  memcpy(out, &header, sizeof(header));
+  memcpy(out + sizeof(header), key_bytes, key.size());
+  memcpy(out + sizeof(header) + key.size(), value, value_size);
+  return sizeof(header) + key.size();
+}
+
+}  // namespace
+
+PersistentCacheFile::PersistentCacheFile(
+    std::shared_ptr<fml::UniqueFD> directory,
+    std::string file_name,
+    size_t max_size,
+    bool read_only)
+    : directory_(std::move(directory)),
+      file_name_(std::move(file_name)),
+      max_size_(max_size),
+      read_only_(read_only) {
+  if (directory_ && directory_->is_valid()) {
+    ReadFile();
+  }
+}
+
+PersistentCacheFile::~PersistentCacheFile() {
+  Flush();
+}
+
+void PersistentCacheFile::ReadFile() {
+  TRACE_EVENT0("flutter", "PersistentCacheFile::ReadFile");
+  auto file = fml::OpenFileReadOnly(*directory_, file_name_.c_str());
+  if (!file.is_valid()) {
+    return;
+  }
+  auto mapping = std::make_shared<fml::FileMapping>(file);
+  const uint8_t* data = mapping->GetMapping();
+  const size_t size = mapping->GetSize();
+  FileHeader file_header;
+  if (size >= sizeof(FileHeader)) {
+    memcpy(&file_header, data, sizeof(FileHeader));
+  }
+  if (size < sizeof(FileHeader) ||
+      file_header.signature != FileHeader::kSignature ||
+      file_header.version != FileHeader::kVersion1) {
+    FML_LOG(INFO) << "Persistent cache file header is corrupt: " << file_name_;
+    needs_rewrite_ = true;
+    return;
+  }
+
+  size_t offset = sizeof(FileHeader);
+  while (size - offset >= sizeof(RecordHeader)) {
+    RecordHeader header;
+    memcpy(&header, data + offset, sizeof(RecordHeader));
+    const size_t record_size =
+        GetRecordSize(header.key_size, header.value_size);
+    if (header.signature != RecordHeader::kSignature ||
+        record_size > size - offset) {
+      break;
+    }
+    const uint8_t* key = data + offset + sizeof(RecordHeader);
+    const uint8_t* value = key + header.key_size;
+    if (ComputeChecksum(key, header.key_size, value, header.value_size) !=
+        header.checksum) {
+      break;
+    }
+
+    // Later records of a key replace the earlier ones.
+    auto& entry = index_[std::string(reinterpret_cast<const char*>(key),
+                                     header.key_size)];
+    if (entry.last_use != 0) {
+      live_size_ -= GetRecordSize(header.key_size, entry.value_size);
+    }
+    entry.value_offset = value - data;
+    entry.value_size = header.value_size;
+    entry.last_use = ++use_counter_;
+    live_size_ += record_size;
+    offset += record_size;
+  }
+
+  if (offset != size) {
+    FML_LOG(INFO) << "Persistent cache file is corrupt after " << offset
+                  << " bytes: " << file_name_;
+    needs_rewrite_ = true;
+  }
+  file_size_ = offset;
+  mapping_ = std::move(mapping);
+}
+
+sk_sp<SkData> PersistentCacheFile::GetValue(const IndexEntry& entry) const {
+  if (entry.stored_value) {
+    return entry.stored_value;
+  }
+  return SkData::MakeWithCopy(mapping_->GetMapping() + entry.value_offset,
+                              entry.value_size);
+}
+
+sk_sp<SkData> PersistentCacheFile::Load(const SkData& key) {
+  std::scoped_lock lock(mutex_);
+  auto found = index_.find(
+      std::string(reinterpret_cast<const char*>(key.data()), key.size()));
+  if (found == index_.end()) {
+    return nullptr;
+  }
+  found->second.last_use = ++use_counter_;
+  return GetValue(found->second);
+}
+
+bool PersistentCacheFile::Store(const SkData& key, const SkData& value) {
+  if (read_only_) {
+    return false;
+  }
+  std::scoped_lock lock(mutex_);
+  std::string key_string(reinterpret_cast<const char*>(key.data()),
+                         key.size());
+  auto [found, inserted] = index_.try_emplace(key_string);
+  auto& entry = found->second;
+  entry.last_use = ++use_counter_;
+  if (!inserted) {
+    auto current = GetValue(entry);
+    if (current->equals(&value)) {
+      return false;
+    }
+    live_size_ -= GetRecordSize(key.size(), entry.value_size);
+  }
+  entry.stored_value = SkData::MakeWithCopy(value.data(), value.size());
+  entry.value_size = value.size();
+  live_size_ += GetRecordSize(key.size(), value.size());
+  if (std::find(pending_keys_.begin(), pending_keys_.end(), key_string) !=
+      pending_keys_.end()) {
+    return false;
+  }
+  pending_keys_.push_back(std::move(key_string));
+  return pending_keys_.size() == 1u;
+}
+
+bool PersistentCacheFile::Flush() {
+  if (read_only_) {
+    return true;
+  }
+  std::scoped_lock lock(mutex_);
+  if (pending_keys_.empty() && !needs_rewrite_) {
+    return true;
+  }
+  if (!directory_ || !directory_->is_valid()) {
+    return false;
+  }
+  TRACE_EVENT0("flutter", "PersistentCacheFile::Flush");
+
+  if (live_size_ > max_size_) {
+    Evict();
+  }
+
+  size_t pending_size = 0;
+  for (const auto& key : pending_keys_) {
+    auto found = index_.find(key);
+    if (found != index_.end()) {
+      pending_size += GetRecordSize(key.size(), found->second.value_size);
+    }
+  }
+  // Rewrite the file once less than half of it is taken by live pairs.
+  if (needs_rewrite_ || file_size_ == 0 ||
+      file_size_ + pending_size > 2 * (sizeof(FileHeader) + live_size_)) {
+    return Rewrite();
+  }
+  return Append();
+}
+
+void PersistentCacheFile::Evict() {
+  std::vector<std::pair<uint64_t, std::string>> uses;
+  uses.reserve(index_.size());
+  for (const auto& [key, entry] : index_) {
+    uses.emplace_back(entry.last_use, key);
+  }
+  std::sort(uses.begin(), uses.end());
+
+  // Leave some room so that the next stores don't evict again right away.
+  const size_t target_size = max_size_ / 4 * 3;
+  size_t evicted = 0;
+  for (const auto& [last_use, key] : uses) {
+    if (live_size_ <= target_size) {
+      break;
+    }
+    auto found = index_.find(key);
+    live_size_ -= GetRecordSize(key.size(), found->second.value_size);
+    index_.erase(found);
+    evicted++;
+  }
+  pending_keys_.erase(
+      std::remove_if(pending_keys_.begin(), pending_keys_.end(),
+                     [this](const std::string& key) {
+                       return index_.find(key) == index_.end();
+                     }),
+      pending_keys_.end());
+  FML_DLOG(INFO) << "Evicted " << evicted
+                 << " entries from the persistent cache file " << file_name_;
+  needs_rewrite_ = true;
+}
+
+bool PersistentCacheFile::Append() {
+  size_t append_size = 0;
+  for (const auto& key : pending_keys_) {
+    append_size += GetRecordSize(key.size(), index_[key].value_size);
+  }
+
+  auto file = fml::OpenFile(*directory_, file_name_.c_str(), false,
+                            fml::FilePermission::kReadWrite);
+  if (!file.is_valid() || !fml::TruncateFile(file, file_size_ + append_size)) {
+    FML_LOG(WARNING) << "Could not extend the persistent cache file.";
+    needs_rewrite_ = true;
+    return false;
+  }
+  {
+    fml::FileMapping region(
+        file, file_size_, append_size,
+        {fml::FileMapping::Protection::kRead,
+         fml::FileMapping::Protection::kWrite});
+    uint8_t* out = region.GetMutableMapping();
+    if (out == nullptr || region.GetSize() != append_size) {
+      FML_LOG(WARNING) << "Could not map the persistent cache file.";
+      needs_rewrite_ = true;
+      return false;
+    }
+    for (const auto& key : pending_keys_) {
+      const auto& value = index_[key].stored_value;
+      WriteRecord(out, key, value->bytes(), value->size());
+      out += GetRecordSize(key.size(), value->size());
+    }
+  }
+  // The appended values stay in memory, only the pairs of the file as it was
+  // opened are read from its mapping.
+  file_size_ += append_size;
+  pending_keys_.clear();
+  return true;
+}
+
+bool PersistentCacheFile::Rewrite() {
+  std::vector<std::pair<uint64_t, const std::string*>> uses;
+  uses.reserve(index_.size());
+  for (const auto& [key, entry] : index_) {
+    uses.emplace_back(entry.last_use, &key);
+  }
+  std::sort(uses.begin(), uses.end());
+
+  std::vector<uint8_t> buffer(sizeof(FileHeader) + live_size_);
+  FileHeader file_header;
+  memcpy(buffer.data(), &file_header, sizeof(FileHeader));
+  size_t offset = sizeof(FileHeader);
+  std::vector<std::pair<IndexEntry*, size_t>> value_offsets;
+  value_offsets.reserve(uses.size());
+  for (const auto& [last_use, key] : uses) {
+    auto& entry = index_[*key];
+    auto value = GetValue(entry);
+    value_offsets.emplace_back(
+        &entry, offset + WriteRecord(buffer.data() + offset, *key,
+                                     value->bytes(), value->size()));
+    offset += GetRecordSize(key->size(), value->size());
+  }
+  FML_DCHECK(offset == buffer.size());
+
+  // Release the mapping of the file before replacing it.
+  auto rewritten = std::make_shared<fml::DataMapping>(std::move(buffer));
+  mapping_ = rewritten;
+  for (auto& [entry, value_offset] : value_offsets) {
+    entry->value_offset = value_offset;
+    entry->stored_value = nullptr;
+  }
+  pending_keys_.clear();
+
+  if (!fml::WriteAtomically(*directory_, file_name_.c_str(), *rewritten)) {
+    FML_LOG(WARNING) << "Could not write the persistent cache file.";
+    needs_rewrite_ = true;
+    return false;
+  }
+  file_size_ = rewritten->GetSize();
+  needs_rewrite_ = false;
+
+  // Read the pairs from the file again rather than keeping them in memory.
+  auto file = fml::OpenFileReadOnly(*directory_, file_name_.c_str());
+  if (file.is_valid()) {
+    auto mapping = std::make_shared<fml::FileMapping>(file);
+    if (mapping->GetSize() == file_size_) {
+      mapping_ = std::move(mapping);
+    }
+  }
+  return true;
+}
+
+void PersistentCacheFile::Clear() {
+  std::scoped_lock lock(mutex_);
+  mapping_ = nullptr;
+  index_.clear();
+  pending_keys_.clear();
+  file_size_ = 0;
+  live_size_ = 0;
+  needs_rewrite_ = false;
+}
+
+std::vector<PersistentCacheFile::Entry> PersistentCacheFile::GetEntries()
+    const {
+  std::scoped_lock lock(mutex_);
+  std::vector<Entry> entries;
+  entries.reserve(index_.size());
+  for (const auto& [key, entry] : index_) {
+    entries.push_back({SkData::MakeWithCopy(key.data(), key.size()),
+                       GetValue(entry)});
+  }
+  return entries;
+}
+
+size_t PersistentCacheFile::GetEntryCount() const {
+  std::scoped_lock lock(mutex_);
+  return index_.size();
+}
+
+size_t PersistentCacheFile::GetLiveSize() const {
+  std::scoped_lock lock(mutex_);
+  return live_size_;
+}
+
+uint32_t PersistentCacheFile::ComputeChecksum(const uint8_t* key,
+                                              size_t key_size,
+                                              const uint8_t* value,
+                                              size_t value_size) {
+  // FNV-1a.
+  uint32_t hash = 0x811c9dc5u;
+  auto update = [&hash](const uint8_t* bytes, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+      hash ^= bytes[i];
+      hash *= 0x01000193u;
+    }
+  };
+  update(key, key_size);
+  update(value, value_size);
+  return hash;
+}
+
+}  // namespace flutter
@@ -0,0 +1,162 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_FILE_H_
+#define FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_FILE_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+#include "third_party/skia/include/core/SkData.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A cache of key-value pairs stored in a single append-only file.
+///
+///             The file is mapped once when the cache is opened and its
+///             records are indexed by key. Stored pairs are kept in memory
+///             until they are written in a batch by |Flush|. Each record has a
+///             checksum. A file that was partially written, for example
+///             because the process was killed during a flush, is truncated
+///             after its last intact record.
+///
+///             Once the records of the live pairs exceed the maximum size, the
+///             least recently used pairs are evicted and the file is rewritten.
+///             The file is also rewritten once most of it is taken by records
+///             of pairs that were stored again. The pairs are rewritten from
+///             the least to the most recently used, so that the order of the
+///             records carries the use of the pairs to the next run.
+///
+///             This class is thread-safe.
+///
+class PersistentCacheFile {
+ public:
+  struct Entry {
+    sk_sp<SkData> key;
+    sk_sp<SkData> value;
+  };
+
+  // Header at the start of the file.
+  struct FileHeader {
+    static const uint32_t kSignature = 0x46504346;  // "FCPF"
+    static const uint32_t kVersion1 = 1;
+
+    uint32_t signature = kSignature;
+    uint32_t version = kVersion1;
+  };
+
+  // Header of each record, followed by the key and the value.
+  struct RecordHeader {
+    static const uint32_t kSignature = 0x52435046;  // "FPCR"
+
+    uint32_t signature = kSignature;
+    uint32_t key_size = 0;
+    uint32_t value_size = 0;
+    // The checksum of the key followed by the value.
+    uint32_t checksum = 0;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Opens the cache file in |directory|, creating it on the first
+  ///             flush if it doesn't exist.
+  ///
+  /// @param[in]  directory  The directory of the file.
+  /// @param[in]  file_name  The name of the file.
+  /// @param[in]  max_size   The maximum size of the records of live pairs.
+  /// @param[in]  read_only  Whether stores are ignored.
+  ///
+  PersistentCacheFile(std::shared_ptr<fml::UniqueFD> directory,
+                      std::string file_name,
+                      size_t max_size,
+                      bool read_only);
+
+  ~PersistentCacheFile();
+
+  sk_sp<SkData> Load(const SkData& key);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Stores a pair in memory until the next flush.
+  ///
+  /// @return     Whether this is the first unwritten pair since the last
+  ///             flush, in which case the caller should schedule a flush.
+  ///
+  bool Store(const SkData& key, const SkData& value);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Writes the stored pairs to the file, evicting pairs and
+  ///             rewriting the file if needed.
+  ///
+  /// @return     Whether the file is up to date.
+  ///
+  bool Flush();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Forgets all pairs and releases the mapping of the file so
+  ///             that the file can be deleted.
+  ///
+  void Clear();
+
+  std::vector<Entry> GetEntries() const;
+
+  size_t GetEntryCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The size of the records of the live pairs.
+  ///
+  size_t GetLiveSize() const;
+
+  static uint32_t ComputeChecksum(const uint8_t* key,
+                                  size_t key_size,
+                                  const uint8_t* value,
+                                  size_t value_size);
+
+ private:
+  struct IndexEntry {
+    // The offset of the value in |mapping_|, unless the value is stored in
+    // memory.
+    size_t value_offset = 0;
+    size_t value_size = 0;
+    // The value of a pair stored since the file was mapped.
+    sk_sp<SkData> stored_value;
+    uint64_t last_use = 0;
+  };
+
+  const std::shared_ptr<fml::UniqueFD> directory_;
+  const std::string file_name_;
+  const size_t max_size_;
+  const bool read_only_;
+
+  mutable std::mutex mutex_;
+  std::shared_ptr<const fml::Mapping> mapping_;
+  std::unordered_map<std::string, IndexEntry> index_;
+  std::vector<std::string> pending_keys_;
+  // The size of the intact part of the file.
+  size_t file_size_ = 0;
+  size_t live_size_ = 0;
+  uint64_t use_counter_ = 0;
+  bool needs_rewrite_ = false;
+
+  void ReadFile();
+
+  sk_sp<SkData> GetValue(const IndexEntry& entry) const;
+
+  void Evict();
+
+  bool Append();
+
+  bool Rewrite();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PersistentCacheFile);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_FILE_H_
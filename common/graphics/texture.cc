@@ -95,4 +95,14 @@ std::shared_ptr<Texture> TextureRegistry::GetTexture(int64_t id) {
   return it != mapping_.end() ? it->second : nullptr;
 }
 
+bool TextureRegistry::MarkTextureFrameAvailable(int64_t id) {
+  auto it = mapping_.find(id);
+  if (it == mapping_.end()) {
+    return false;
+  }
+  it->second->frame_generation_++;
+  it->second->MarkNewFrameAvailable();
+  return true;
+}
+
 }  // namespace flutter
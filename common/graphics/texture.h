@@ -62,8 +62,18 @@ class Texture : public ContextListener {
 
   int64_t Id() { return id_; }
 
+  // The number of times the texture was marked as having a new frame through
+  // |TextureRegistry::MarkTextureFrameAvailable|. Painting the texture again
+  // at the same generation doesn't need to import a new image.
+  //
+  // Called from raster thread.
+  uint64_t FrameGeneration() const { return frame_generation_; }
+
  private:
+  friend class TextureRegistry;
+
   int64_t id_;
+  uint64_t frame_generation_ = 0;
   FML_DISALLOW_COPY_AND_ASSIGN(Texture);
 };
 
@@ -87,6 +97,12 @@ class TextureRegistry {
   // Called from raster thread.
   std::shared_ptr<Texture> GetTexture(int64_t id);
 
+  // Advances the frame generation of the texture and lets it know that it has
+  // a new frame. Returns false if no texture is registered with the id.
+  //
+  // Called from raster thread.
+  bool MarkTextureFrameAvailable(int64_t id);
+
   // Called from raster thread.
   void OnGrContextCreated();
 
@@ -38,7 +38,7 @@ class FrameTiming {
       kVsyncStart,  kBuildStart,   kBuildFinish,
       kRasterStart, kRasterFinish, kRasterFinishWallTime};
 
-  static constexpr int kStatisticsCount = kCount + 5;
+  static constexpr int kStatisticsCount = kCount + 6;
 
   fml::TimePoint Get(Phase phase) const { return data_[phase]; }
   fml::TimePoint Set(Phase phase, fml::TimePoint value) {
@@ -47,6 +47,10 @@ class FrameTiming {
 
   uint64_t GetFrameNumber() const { return frame_number_; }
   void SetFrameNumber(uint64_t frame_number) { frame_number_ = frame_number; }
+  fml::TimeDelta GetGPUDuration() const { return gpu_duration_; }
+  void SetGPUDuration(fml::TimeDelta gpu_duration) {
+    gpu_duration_ = gpu_duration;
+  }
   uint64_t GetLayerCacheCount() const { return layer_cache_count_; }
   uint64_t GetLayerCacheBytes() const { return layer_cache_bytes_; }
   uint64_t GetPictureCacheCount() const { return picture_cache_count_; }
@@ -68,6 +72,7 @@ class FrameTiming {
   size_t layer_cache_bytes_;
   size_t picture_cache_count_;
   size_t picture_cache_bytes_;
+  fml::TimeDelta gpu_duration_;
 };
 
 using TaskObserverAdd =
@@ -132,6 +137,21 @@ struct Settings {
   // the VM service isolate.
   std::vector<std::string> vmservice_snapshot_library_path;
 
+  // Path to a file recording the pages of the AOT snapshots that were resident
+  // once the first frame was rasterized. If the file exists, these pages are
+  // prefetched when the snapshots are mapped. Otherwise it is written after
+  // the first frame, for use by the next launch.
+  std::string snapshot_page_profile_path;
+
+  // Ask the kernel to back the AOT snapshot instructions with transparent huge
+  // pages where the mapping is suitably aligned.
+  bool enable_snapshot_huge_pages = false;
+
+  // The number of background isolates spawned in the isolate group of the
+  // root isolate during the first idle period, and kept alive to run the
+  // computations passed to `IsolatePool.run`. Zero spawns them on first use.
+  int warm_isolate_pool_size = 0;
+
   std::string application_kernel_asset;       // deprecated
   std::string application_kernel_list_asset;  // deprecated
   MappingsCallback application_kernels;
@@ -145,8 +165,16 @@ struct Settings {
   std::vector<std::string> trace_allowlist;
   std::optional<std::vector<std::string>> trace_skia_allowlist;
   bool trace_startup = false;
+  // Keep the most recent frame timings and late tasks in the flight recorder.
+  bool enable_flight_recorder = false;
+  // Collect the latency and run time statistics of the tasks of all task
+  // queues.
+  bool enable_task_queue_stats = false;
   bool trace_systrace = false;
   std::string trace_to_file;
+  // Buffer the trace events without arguments on the thread that records them
+  // and hand them to the timeline once the outermost event of the thread ends.
+  bool buffer_trace_events = false;
   bool enable_timeline_event_handler = true;
   bool dump_skp_on_shader_compilation = false;
   bool cache_sksl = false;
@@ -177,6 +205,10 @@ struct Settings {
   // Whether the Dart VM service should be enabled.
   bool enable_vm_service = false;
 
+  // Whether the startup of the Dart VM service is held back until the first
+  // frame has been rasterized, so that it doesn't slow down app startup.
+  bool defer_vm_service_startup = false;
+
   // Whether to publish the VM Service URL over mDNS.
   // On iOS 14 this prompts a local network permission dialog,
   // which cannot be accepted or dismissed in a CI environment.
@@ -203,10 +235,61 @@ struct Settings {
 
   bool use_asset_fonts = true;
 
+  // Parse the fonts declared in the font manifest on worker threads ahead of
+  // their first use instead of on the UI thread when they are first used.
+  bool preload_asset_fonts = false;
+
+  // Share the layouts of paragraphs with the same text, styles and width
+  // instead of laying out every paragraph that is built.
+  bool enable_paragraph_layout_cache = false;
+
   // Indicates whether the embedding started a prefetch of the default font
   // manager before creating the engine.
   bool prefetched_default_font_manager = false;
 
+  // Rasterize display lists that are about to be raster cached on worker
+  // threads ahead of the frame they are needed in.
+  bool enable_raster_cache_prerasterization = false;
+
+  // Draw display lists that aren't raster cached at the current transform,
+  // such as during a zoom animation, from their cached image at a slightly
+  // different scale.
+  bool enable_raster_cache_scaled_reuse = false;
+
+  // Paint unchanged layer subtrees from a recording made in the frame after
+  // they were first painted instead of painting every layer in them.
+  bool enable_retained_layer_subtrees = false;
+
+  // Let a third frame into the layer tree pipeline while recent frames took
+  // longer to rasterize than a vsync interval, trading a frame of latency for
+  // not missing frames on the UI thread.
+  bool enable_adaptive_pipeline_depth = false;
+
+  // Start building frames later in their vsync interval when the build and
+  // raster times of recent frames predict that they will still meet their
+  // target time, so that the frames include more recent input.
+  bool enable_predictive_frame_scheduling = false;
+
+  // Dispatch pointer data at most once per vsync after the first packet,
+  // merging the moves of each pointer received within a vsync, instead of
+  // using the dispatcher of the platform view.
+  bool enable_pointer_event_batching = false;
+
+  // Keep rasterizing on the raster thread while platform views are on screen,
+  // and hand the platform view updates of each frame to the platform thread,
+  // instead of merging the raster thread into the platform thread. Only used
+  // by hybrid composition on Android.
+  bool enable_platform_view_transactions = false;
+
+  // Begin frames as soon as they are requested instead of at the vsyncs of
+  // the platform. Meant for rendering offscreen as fast as possible, such as
+  // when generating images on a server.
+  bool enable_unpaced_frame_scheduling = false;
+
+  // The number of frames that may be built ahead of the frame being
+  // rasterized. Zero picks the default of the platform.
+  uint32_t max_frames_in_flight = 0;
+
   // Enable the rendering of colors outside of the sRGB gamut.
   bool enable_wide_gamut = false;
 
@@ -225,6 +308,38 @@ struct Settings {
   // must be available to the application.
   bool enable_vulkan_validation = false;
 
+  // Present Vulkan swapchain images in mailbox or FIFO relaxed mode when the
+  // surface supports it. This lowers latency at the cost of frames that are
+  // never displayed or that tear.
+  bool enable_vulkan_low_latency_present = false;
+
+  // The number of frames of animated images to decode on worker threads ahead
+  // of the frames the framework asks for. Zero decodes each frame on the IO
+  // thread when it is asked for.
+  size_t animated_image_decode_ahead_frames = 0u;
+
+  // Downscale decoded images that are a power of two multiple of their target
+  // size on the GPU while generating their mipmaps instead of on the CPU.
+  // Only used by Impeller.
+  bool enable_impeller_gpu_image_downscaling = false;
+
+  // If not empty, the render passes of a frame rendered by Impeller are
+  // recorded to a capture file at this path. The capture can be replayed with
+  // the `impeller_replay` tool.
+  std::string impeller_capture_path;
+
+  // The number of the frame to capture, starting from one for the first frame
+  // rasterized by the shell.
+  size_t impeller_capture_frame = 1u;
+
+  // If not empty, the layer trees of the first frames rasterized by the shell
+  // are recorded to a file at this path. The recording can be replayed
+  // headlessly with the `flutter_frame_replay` tool.
+  std::string frame_recording_path;
+
+  // The number of frames to record with |frame_recording_path|.
+  size_t frame_recording_count = 300u;
+
   // Data set by platform-specific embedders for use in font initialization.
   uint32_t font_initialization_data = 0;
 
@@ -284,6 +399,9 @@ struct Settings {
   // calls in this callback will cause applications to jank.
   LogMessageCallback log_message_callback;
   bool enable_software_rendering = false;
+  // Rasterize software frames in tiles on the concurrent worker threads, and
+  // only rasterize the tiles that changed since the previous frame.
+  bool enable_tiled_software_rendering = false;
   bool skia_deterministic_rendering_on_cpu = false;
   bool verbose_logging = false;
   std::string log_tag = "flutter";
@@ -295,6 +413,9 @@ struct Settings {
   bool icu_initialization_required = true;
   std::string icu_data_path;
   MappingCallback icu_mapper;
+  // Map the ICU data and initialize ICU when text is first laid out, or once
+  // a worker thread gets to it, instead of before the VM is created.
+  bool lazy_icu_initialization = false;
 
   // Assets settings
   fml::UniqueFD::element_type assets_dir =
@@ -3,6 +3,8 @@
 // found in the LICENSE file.
 
 #include "flutter/display_list/benchmarking/dl_benchmarks.h"
+#include "flutter/display_list/benchmarking/dl_complexity_gl.h"
+#include "flutter/display_list/benchmarking/dl_complexity_metal.h"
 #include "flutter/display_list/dl_builder.h"
 #include "flutter/display_list/dl_op_flags.h"
 #include "flutter/display_list/skia/dl_sk_canvas.h"
@@ -70,6 +72,18 @@ void AnnotateAttributes(unsigned attributes,
   }
 }
 
+// Annotates |state| with the complexity scores of |display_list| so that the
+// scores can be correlated with the measured times.
+void AnnotateComplexity(benchmark::State& state,
+                        const sk_sp<DisplayList>& display_list) {
+  state.counters["ComplexityGL"] =
+      DisplayListGLComplexityCalculator::GetInstance()->Compute(
+          display_list.get());
+  state.counters["ComplexityMetal"] =
+      DisplayListMetalComplexityCalculator::GetInstance()->Compute(
+          display_list.get());
+}
+
 // Constants chosen to produce benchmark results in the region of 1-50ms
 constexpr size_t kLinesToDraw = 10000;
 constexpr size_t kRectsToDraw = 5000;
@@ -109,6 +123,7 @@ void BM_DrawLine(benchmark::State& state,
   }
 
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list);
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -158,6 +173,7 @@ void BM_DrawRect(benchmark::State& state,
   }
 
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list);
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -204,6 +220,7 @@ void BM_DrawOval(benchmark::State& state,
     }
   }
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list);
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -252,6 +269,7 @@ void BM_DrawCircle(benchmark::State& state,
     }
   }
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list);
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -330,6 +348,7 @@ void BM_DrawRRect(benchmark::State& state,
     }
   }
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list);
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -412,6 +431,7 @@ void BM_DrawDRRect(benchmark::State& state,
     }
   }
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list);
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -465,6 +485,7 @@ void BM_DrawArc(benchmark::State& state,
   }
 
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list);
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -668,6 +689,7 @@ void BM_DrawPath(benchmark::State& state,
 
   builder.DrawPath(path, paint);
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list);
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -814,6 +836,7 @@ void BM_DrawVertices(benchmark::State& state,
   state.SetComplexityN(total_vertex_count);
 
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list);
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -911,6 +934,7 @@ void BM_DrawPoints(benchmark::State& state,
   builder.DrawPoints(mode, points.size(), points.data(), paint);
 
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list);
 
   for ([[maybe_unused]] auto _ : state) {
     canvas.DrawDisplayList(display_list);
@@ -989,6 +1013,7 @@ void BM_DrawImage(benchmark::State& state,
   }
 
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list);
 
   for ([[maybe_unused]] auto _ : state) {
     canvas.DrawDisplayList(display_list);
@@ -1075,6 +1100,7 @@ void BM_DrawImageRect(benchmark::State& state,
   }
 
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list);
 
   for ([[maybe_unused]] auto _ : state) {
     canvas.DrawDisplayList(display_list);
@@ -1162,6 +1188,7 @@ void BM_DrawImageNine(benchmark::State& state,
   }
 
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list);
 
   for ([[maybe_unused]] auto _ : state) {
     canvas.DrawDisplayList(display_list);
@@ -1208,6 +1235,7 @@ void BM_DrawTextBlob(benchmark::State& state,
   }
 
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list);
 
   for ([[maybe_unused]] auto _ : state) {
     canvas.DrawDisplayList(display_list);
@@ -1272,6 +1300,7 @@ void BM_DrawShadow(benchmark::State& state,
   // ever used in conjunction with elevation.
   builder.DrawShadow(path, SK_ColorBLUE, elevation, transparent_occluder, 1.0f);
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list);
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -1326,6 +1355,7 @@ void BM_SaveLayer(benchmark::State& state,
     }
   }
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list);
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
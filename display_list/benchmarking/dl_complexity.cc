@@ -4,6 +4,7 @@
 
 #include "flutter/display_list/benchmarking/dl_complexity.h"
 #include "flutter/display_list/benchmarking/dl_complexity_gl.h"
+#include "flutter/display_list/benchmarking/dl_complexity_impeller.h"
 #include "flutter/display_list/benchmarking/dl_complexity_metal.h"
 #include "flutter/display_list/display_list.h"
 
@@ -32,6 +33,13 @@ DisplayListComplexityCalculator* DisplayListComplexityCalculator::GetForBackend(
   }
 }
 
+DisplayListComplexityCalculator*
+DisplayListComplexityCalculator::GetForImpeller(
+    bool supports_framebuffer_fetch) {
+  return DisplayListImpellerComplexityCalculator::GetInstance(
+      supports_framebuffer_fetch);
+}
+
 DisplayListComplexityCalculator*
 DisplayListComplexityCalculator::GetForSoftware() {
   return DisplayListNaiveComplexityCalculator::GetInstance();
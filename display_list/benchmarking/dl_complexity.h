@@ -15,6 +15,8 @@ class DisplayListComplexityCalculator {
  public:
   static DisplayListComplexityCalculator* GetForSoftware();
   static DisplayListComplexityCalculator* GetForBackend(GrBackendApi backend);
+  static DisplayListComplexityCalculator* GetForImpeller(
+      bool supports_framebuffer_fetch);
 
   virtual ~DisplayListComplexityCalculator() = default;
 
@@ -0,0 +1,367 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/benchmarking/dl_complexity_impeller.h"
+
+#include "flutter/display_list/effects/dl_image_filter.h"
+
+// Unlike the GL and Metal calculators, the weightings in this file are not
+// yet fitted to device measurements. They are derived from the work Impeller
+// does for each op (render passes, CPU tessellation, stencil passes and
+// filter passes) and scaled so that filling a 1000x1000 area costs about
+// 0.05ms, and are meant to be refined with the results of the
+// dl_dispatcher_benchmarks suite run on real devices.
+//
+// See the comments in display_list_complexity_helper.h for details on the
+// scale of the scores.
+
+namespace flutter {
+
+namespace {
+
+// The fixed cost of encoding a draw.
+constexpr unsigned int kDrawCost = 20;
+
+// The area assumed for save layers and clips without bounds.
+constexpr SkScalar kUnboundedArea = 1000.0f * 1000.0f;
+
+// The cost of filling |area| pixels.
+unsigned int AreaComplexity(SkScalar area) {
+  return area / 100;
+}
+
+unsigned int AreaComplexity(const SkRect& rect) {
+  return AreaComplexity(rect.width() * rect.height());
+}
+
+}  // namespace
+
+DisplayListImpellerComplexityCalculator*
+DisplayListImpellerComplexityCalculator::GetInstance(
+    bool supports_framebuffer_fetch) {
+  static DisplayListImpellerComplexityCalculator* with_framebuffer_fetch =
+      new DisplayListImpellerComplexityCalculator(true);
+  static DisplayListImpellerComplexityCalculator* without_framebuffer_fetch =
+      new DisplayListImpellerComplexityCalculator(false);
+  return supports_framebuffer_fetch ? with_framebuffer_fetch
+                                    : without_framebuffer_fetch;
+}
+
+unsigned int
+DisplayListImpellerComplexityCalculator::ImpellerHelper::BatchedComplexity() {
+  if (draw_text_count_ == 0) {
+    return 0;
+  }
+  // Glyphs are rendered from an atlas which is updated once per frame, and
+  // each text run after that is drawn with a single draw call.
+  return 1000 + draw_text_count_ * 250;
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::AccumulateDraw(
+    const SkRect& bounds,
+    unsigned int geometry_complexity) {
+  const SkScalar area = bounds.width() * bounds.height();
+  unsigned int complexity =
+      kDrawCost + geometry_complexity + AreaComplexity(area);
+  if (blend_mode_ > DlBlendMode::kLastCoeffMode) {
+    // Advanced blends either read the destination from the framebuffer, or
+    // copy it into a texture and blend in a separate pass.
+    complexity += supports_framebuffer_fetch_
+                      ? AreaComplexity(area)
+                      : 4000 + 2 * AreaComplexity(area);
+  }
+  AccumulateComplexity(complexity);
+}
+
+unsigned int
+DisplayListImpellerComplexityCalculator::ImpellerHelper::PathComplexity(
+    const SkPath& path) {
+  // Curves are subdivided into lines before fills are tessellated and before
+  // strokes are extruded, so their cost dominates.
+  if (DrawStyle() == DlDrawStyle::kFill) {
+    return 200 + CalculatePathComplexity(path, 30, 120, 150, 200);
+  }
+  return 200 + CalculatePathComplexity(path, 50, 150, 180, 240);
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::saveLayer(
+    const SkRect* bounds,
+    const SaveLayerOptions options,
+    const DlImageFilter* backdrop) {
+  if (IsComplex()) {
+    return;
+  }
+  if (backdrop) {
+    // Flutter does not offer this operation so this value can only ever be
+    // non-null for a frame-wide builder which is not currently evaluated for
+    // complexity.
+    AccumulateComplexity(Ceiling());
+    return;
+  }
+  const SkScalar area =
+      bounds ? bounds->width() * bounds->height() : kUnboundedArea;
+
+  // Every layer is a render pass of its own whose texture is composited into
+  // the parent pass when restored. The cost of restoring is accounted for
+  // here.
+  unsigned int complexity = 2000 + AreaComplexity(area);
+  if (options.renders_with_attributes() && image_filter_) {
+    if (image_filter_->asBlur()) {
+      // Blurs downsample the layer and apply a pass per direction.
+      complexity += 8000 + 2 * AreaComplexity(area);
+    } else {
+      complexity += 2000 + AreaComplexity(area);
+    }
+  }
+  AccumulateComplexity(complexity);
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::clipRect(
+    const SkRect& rect,
+    DlCanvas::ClipOp clip_op,
+    bool is_aa) {
+  if (IsComplex()) {
+    return;
+  }
+  // Clips are drawn into the stencil buffer, and drawn again to restore the
+  // stencil buffer when the clip goes out of scope.
+  AccumulateComplexity(1000 + 2 * AreaComplexity(rect));
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::clipRRect(
+    const SkRRect& rrect,
+    DlCanvas::ClipOp clip_op,
+    bool is_aa) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateComplexity(1150 + 2 * AreaComplexity(rrect.rect()));
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::clipPath(
+    const SkPath& path,
+    DlCanvas::ClipOp clip_op,
+    bool is_aa) {
+  if (IsComplex()) {
+    return;
+  }
+  const SkScalar area =
+      path.isInverseFillType()
+          ? kUnboundedArea
+          : path.getBounds().width() * path.getBounds().height();
+  AccumulateComplexity(1000 +
+                       CalculatePathComplexity(path, 30, 120, 150, 200) +
+                       2 * AreaComplexity(area));
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawLine(
+    const SkPoint& p0,
+    const SkPoint& p1) {
+  if (IsComplex()) {
+    return;
+  }
+  // Lines are extruded into quads. Their coverage is negligible.
+  AccumulateDraw(SkRect::MakeEmpty(), 40);
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawRect(
+    const SkRect& rect) {
+  if (IsComplex()) {
+    return;
+  }
+  if (DrawStyle() == DlDrawStyle::kFill) {
+    AccumulateDraw(rect, 0);
+    return;
+  }
+  // Strokes only cover the perimeter.
+  AccumulateDraw(SkRect::MakeWH(2 * (rect.width() + rect.height()), 2), 80);
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawOval(
+    const SkRect& bounds) {
+  if (IsComplex()) {
+    return;
+  }
+  // Ovals are tessellated into a number of divisions that grows with their
+  // size.
+  const unsigned int divisions = (bounds.width() + bounds.height()) / 8;
+  if (DrawStyle() == DlDrawStyle::kFill) {
+    AccumulateDraw(bounds, 100 + divisions);
+    return;
+  }
+  AccumulateDraw(SkRect::MakeWH(2 * (bounds.width() + bounds.height()), 2),
+                 100 + 2 * divisions);
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawCircle(
+    const SkPoint& center,
+    SkScalar radius) {
+  drawOval(SkRect::MakeLTRB(center.x() - radius, center.y() - radius,
+                            center.x() + radius, center.y() + radius));
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawRRect(
+    const SkRRect& rrect) {
+  if (IsComplex()) {
+    return;
+  }
+  if (rrect.isRect()) {
+    drawRect(rrect.rect());
+    return;
+  }
+  // Rounded rects are tessellated as paths with four curves.
+  const SkRect& rect = rrect.rect();
+  if (DrawStyle() == DlDrawStyle::kFill) {
+    AccumulateDraw(rect, 150);
+    return;
+  }
+  AccumulateDraw(SkRect::MakeWH(2 * (rect.width() + rect.height()), 2), 300);
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawDRRect(
+    const SkRRect& outer,
+    const SkRRect& inner) {
+  if (IsComplex()) {
+    return;
+  }
+  // Both contours are tessellated together as a single path.
+  AccumulateDraw(outer.rect(), 600);
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawPath(
+    const SkPath& path) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateDraw(path.getBounds(), PathComplexity(path));
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawArc(
+    const SkRect& oval_bounds,
+    SkScalar start_degrees,
+    SkScalar sweep_degrees,
+    bool use_center) {
+  if (IsComplex()) {
+    return;
+  }
+  // Arcs are converted to paths of up to four conics.
+  AccumulateDraw(oval_bounds, 300);
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawPoints(
+    DlCanvas::PointMode mode,
+    uint32_t count,
+    const SkPoint points[]) {
+  if (IsComplex()) {
+    return;
+  }
+  // Every point or line segment is extruded into its own geometry.
+  AccumulateDraw(SkRect::MakeEmpty(), count * 30);
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawVertices(
+    const DlVertices* vertices,
+    DlBlendMode mode) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateDraw(vertices->bounds(), 100 + vertices->vertex_count() / 2);
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawImage(
+    const sk_sp<DlImage> image,
+    const SkPoint point,
+    DlImageSampling sampling,
+    bool render_with_attributes) {
+  if (IsComplex()) {
+    return;
+  }
+  ImageRect(image->dimensions(), image->isTextureBacked(),
+            render_with_attributes, false);
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::ImageRect(
+    const SkISize& size,
+    bool texture_backed,
+    bool render_with_attributes,
+    bool enforce_src_edges) {
+  if (IsComplex()) {
+    return;
+  }
+  unsigned int upload_complexity = 0;
+  if (!texture_backed) {
+    // Images that aren't textures yet are uploaded before they are drawn.
+    upload_complexity = AreaComplexity(size.area()) * 5;
+  }
+  AccumulateDraw(SkRect::Make(size), 30 + upload_complexity);
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawImageNine(
+    const sk_sp<DlImage> image,
+    const SkIRect& center,
+    const SkRect& dst,
+    DlFilterMode filter,
+    bool render_with_attributes) {
+  if (IsComplex()) {
+    return;
+  }
+  // Nine patches are drawn as nine image rects that share a texture.
+  AccumulateDraw(dst, 9 * kDrawCost);
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawDisplayList(
+    const sk_sp<DisplayList> display_list,
+    SkScalar opacity) {
+  if (IsComplex()) {
+    return;
+  }
+  ImpellerHelper helper(Ceiling() - CurrentComplexityScore(),
+                        supports_framebuffer_fetch_);
+  if (opacity < SK_Scalar1 && !display_list->can_apply_group_opacity()) {
+    helper.saveLayer(&display_list->bounds(), SaveLayerOptions::kWithAttributes,
+                     nullptr);
+  }
+  display_list->Dispatch(helper);
+  AccumulateComplexity(helper.ComplexityScore());
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawTextBlob(
+    const sk_sp<SkTextBlob> blob,
+    SkScalar x,
+    SkScalar y) {
+  if (IsComplex()) {
+    return;
+  }
+  draw_text_count_++;
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawTextFrame(
+    const std::shared_ptr<impeller::TextFrame>& text_frame,
+    SkScalar x,
+    SkScalar y) {
+  if (IsComplex()) {
+    return;
+  }
+  draw_text_count_++;
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawShadow(
+    const SkPath& path,
+    const DlColor color,
+    const SkScalar elevation,
+    bool transparent_occluder,
+    SkScalar dpr) {
+  if (IsComplex()) {
+    return;
+  }
+  // Shadows of rounded rects are drawn analytically. Other shadows are drawn
+  // as the path with a blur mask filter.
+  if (path.isRRect(nullptr) || path.isRect(nullptr) || path.isOval(nullptr)) {
+    AccumulateDraw(path.getBounds(), 200);
+    return;
+  }
+  AccumulateDraw(path.getBounds(), 8000 + PathComplexity(path));
+}
+
+}  // namespace flutter
@@ -0,0 +1,140 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_DISPLAY_LIST_BENCHMARKING_DL_COMPLEXITY_IMPELLER_H_
+#define FLUTTER_FLOW_DISPLAY_LIST_BENCHMARKING_DL_COMPLEXITY_IMPELLER_H_
+
+#include "flutter/display_list/benchmarking/dl_complexity_helper.h"
+
+namespace flutter {
+
+// Estimates the cost of rendering a DisplayList with Impeller.
+//
+// Unlike Skia, Impeller tessellates paths on the CPU every frame, renders
+// non-rectangular clips into the stencil buffer (and restores them with a
+// second stencil pass), renders every saveLayer into its own render pass and
+// implements blurs as multi-pass filters. Advanced blend modes are cheap on
+// devices that support framebuffer fetch but need an offscreen copy of the
+// destination on those that don't, which is why there is an instance of the
+// calculator for each.
+class DisplayListImpellerComplexityCalculator
+    : public DisplayListComplexityCalculator {
+ public:
+  static DisplayListImpellerComplexityCalculator* GetInstance(
+      bool supports_framebuffer_fetch);
+
+  unsigned int Compute(const DisplayList* display_list) override {
+    ImpellerHelper helper(ceiling_, supports_framebuffer_fetch_);
+    display_list->Dispatch(helper);
+    return helper.ComplexityScore();
+  }
+
+  bool ShouldBeCached(unsigned int complexity_score) override {
+    // Set cache threshold at 1ms
+    return complexity_score > 200000u;
+  }
+
+  void SetComplexityCeiling(unsigned int ceiling) override {
+    ceiling_ = ceiling;
+  }
+
+ private:
+  class ImpellerHelper : public ComplexityCalculatorHelper {
+   public:
+    ImpellerHelper(unsigned int ceiling, bool supports_framebuffer_fetch)
+        : ComplexityCalculatorHelper(ceiling),
+          supports_framebuffer_fetch_(supports_framebuffer_fetch) {}
+
+    void setBlendMode(DlBlendMode mode) override { blend_mode_ = mode; }
+    void setImageFilter(const DlImageFilter* filter) override {
+      image_filter_ = filter;
+    }
+
+    void saveLayer(const SkRect* bounds,
+                   const SaveLayerOptions options,
+                   const DlImageFilter* backdrop) override;
+
+    void clipRect(const SkRect& rect,
+                  DlCanvas::ClipOp clip_op,
+                  bool is_aa) override;
+    void clipRRect(const SkRRect& rrect,
+                   DlCanvas::ClipOp clip_op,
+                   bool is_aa) override;
+    void clipPath(const SkPath& path,
+                  DlCanvas::ClipOp clip_op,
+                  bool is_aa) override;
+
+    void drawLine(const SkPoint& p0, const SkPoint& p1) override;
+    void drawRect(const SkRect& rect) override;
+    void drawOval(const SkRect& bounds) override;
+    void drawCircle(const SkPoint& center, SkScalar radius) override;
+    void drawRRect(const SkRRect& rrect) override;
+    void drawDRRect(const SkRRect& outer, const SkRRect& inner) override;
+    void drawPath(const SkPath& path) override;
+    void drawArc(const SkRect& oval_bounds,
+                 SkScalar start_degrees,
+                 SkScalar sweep_degrees,
+                 bool use_center) override;
+    void drawPoints(DlCanvas::PointMode mode,
+                    uint32_t count,
+                    const SkPoint points[]) override;
+    void drawVertices(const DlVertices* vertices, DlBlendMode mode) override;
+    void drawImage(const sk_sp<DlImage> image,
+                   const SkPoint point,
+                   DlImageSampling sampling,
+                   bool render_with_attributes) override;
+    void drawImageNine(const sk_sp<DlImage> image,
+                       const SkIRect& center,
+                       const SkRect& dst,
+                       DlFilterMode filter,
+                       bool render_with_attributes) override;
+    void drawDisplayList(const sk_sp<DisplayList> display_list,
+                         SkScalar opacity) override;
+    void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                      SkScalar x,
+                      SkScalar y) override;
+    void drawTextFrame(const std::shared_ptr<impeller::TextFrame>& text_frame,
+                       SkScalar x,
+                       SkScalar y) override;
+    void drawShadow(const SkPath& path,
+                    const DlColor color,
+                    const SkScalar elevation,
+                    bool transparent_occluder,
+                    SkScalar dpr) override;
+
+   protected:
+    void ImageRect(const SkISize& size,
+                   bool texture_backed,
+                   bool render_with_attributes,
+                   bool enforce_src_edges) override;
+
+    unsigned int BatchedComplexity() override;
+
+   private:
+    const bool supports_framebuffer_fetch_;
+    DlBlendMode blend_mode_ = DlBlendMode::kSrcOver;
+    const DlImageFilter* image_filter_ = nullptr;
+    unsigned int draw_text_count_ = 0;
+
+    // Accumulates the cost of a draw covering |bounds| whose geometry costs
+    // |geometry_complexity| to generate.
+    void AccumulateDraw(const SkRect& bounds, unsigned int geometry_complexity);
+
+    // Returns the cost of tessellating |path| on the CPU with the current
+    // draw style.
+    unsigned int PathComplexity(const SkPath& path);
+  };
+
+  explicit DisplayListImpellerComplexityCalculator(
+      bool supports_framebuffer_fetch)
+      : supports_framebuffer_fetch_(supports_framebuffer_fetch),
+        ceiling_(std::numeric_limits<unsigned int>::max()) {}
+
+  const bool supports_framebuffer_fetch_;
+  unsigned int ceiling_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_DISPLAY_LIST_BENCHMARKING_DL_COMPLEXITY_IMPELLER_H_
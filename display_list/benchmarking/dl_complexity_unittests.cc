@@ -4,6 +4,7 @@
 
 #include "flutter/display_list/benchmarking/dl_complexity.h"
 #include "flutter/display_list/benchmarking/dl_complexity_gl.h"
+#include "flutter/display_list/benchmarking/dl_complexity_impeller.h"
 #include "flutter/display_list/benchmarking/dl_complexity_metal.h"
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_builder.h"
@@ -23,6 +24,8 @@ namespace {
 std::vector<DisplayListComplexityCalculator*> Calculators() {
   return {DisplayListMetalComplexityCalculator::GetInstance(),
           DisplayListGLComplexityCalculator::GetInstance(),
+          DisplayListImpellerComplexityCalculator::GetInstance(true),
+          DisplayListImpellerComplexityCalculator::GetInstance(false),
           DisplayListNaiveComplexityCalculator::GetInstance()};
 }
 
@@ -438,5 +441,59 @@ TEST(DisplayListComplexity, DrawAtlas) {
   }
 }
 
+TEST(DisplayListComplexity, ImpellerStencilClips) {
+  SkPath path;
+  path.moveTo(SkPoint::Make(0, 0));
+  path.cubicTo(SkPoint::Make(10, 10), SkPoint::Make(10, 20),
+               SkPoint::Make(20, 20));
+  path.close();
+
+  DisplayListBuilder builder_no_clip;
+  builder_no_clip.DrawRect(SkRect::MakeWH(20, 20), DlPaint());
+  auto display_list_no_clip = builder_no_clip.Build();
+
+  DisplayListBuilder builder_clip;
+  builder_clip.ClipPath(path);
+  builder_clip.DrawRect(SkRect::MakeWH(20, 20), DlPaint());
+  auto display_list_clip = builder_clip.Build();
+
+  auto calculator = DisplayListComplexityCalculator::GetForImpeller(true);
+  ASSERT_GT(calculator->Compute(display_list_clip.get()),
+            calculator->Compute(display_list_no_clip.get()));
+}
+
+TEST(DisplayListComplexity, ImpellerBlurredSaveLayers) {
+  const SkRect bounds = SkRect::MakeWH(100, 100);
+
+  DisplayListBuilder builder_plain;
+  builder_plain.SaveLayer(&bounds, nullptr);
+  builder_plain.Restore();
+  auto display_list_plain = builder_plain.Build();
+
+  DisplayListBuilder builder_blur;
+  DlPaint blur_paint;
+  blur_paint.setImageFilter(
+      DlBlurImageFilter::Make(5.0f, 5.0f, DlTileMode::kClamp));
+  builder_blur.SaveLayer(&bounds, &blur_paint);
+  builder_blur.Restore();
+  auto display_list_blur = builder_blur.Build();
+
+  auto calculator = DisplayListComplexityCalculator::GetForImpeller(true);
+  ASSERT_GT(calculator->Compute(display_list_blur.get()),
+            calculator->Compute(display_list_plain.get()));
+}
+
+TEST(DisplayListComplexity, ImpellerAdvancedBlendsWithoutFramebufferFetch) {
+  DisplayListBuilder builder;
+  builder.DrawRect(SkRect::MakeWH(100, 100),
+                   DlPaint().setBlendMode(DlBlendMode::kMultiply));
+  auto display_list = builder.Build();
+
+  ASSERT_GT(DisplayListComplexityCalculator::GetForImpeller(false)->Compute(
+                display_list.get()),
+            DisplayListComplexityCalculator::GetForImpeller(true)->Compute(
+                display_list.get()));
+}
+
 }  // namespace testing
 }  // namespace flutter
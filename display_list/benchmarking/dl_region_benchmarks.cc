@@ -5,9 +5,12 @@
 #include "flutter/benchmarking/benchmarking.h"
 
 #include "flutter/display_list/geometry/dl_region.h"
+#include "flutter/display_list/geometry/dl_rtree.h"
 #include "flutter/fml/logging.h"
 #include "third_party/skia/include/core/SkRegion.h"
 
+#include <algorithm>
+#include <cmath>
 #include <random>
 
 namespace {
@@ -253,6 +256,132 @@ void RunIntersectsSingleRectBenchmark(benchmark::State& state, int maxSize) {
   }
 }
 
+// Bounds that keep the coverage of |numRects| rects comparable to 2000 rects
+// in 4000x4000.
+SkIRect ScaledBounds(int numRects) {
+  int32_t size = 4000 * std::sqrt(numRects / 2000.0);
+  return SkIRect::MakeWH(size, size);
+}
+
+template <typename Region>
+void RunFromRectCountBenchmark(benchmark::State& state, int numRects) {
+  std::seed_seq seed{2, 1, 3};
+  std::mt19937 rng(seed);
+
+  auto rects = GenerateRects(rng, ScaledBounds(numRects), numRects, 100);
+
+  while (state.KeepRunning()) {
+    Region region(rects);
+  }
+}
+
+template <typename Region>
+void RunGetRectsRectCountBenchmark(benchmark::State& state, int numRects) {
+  std::seed_seq seed{2, 1, 3};
+  std::mt19937 rng(seed);
+
+  auto rects = GenerateRects(rng, ScaledBounds(numRects), numRects, 100);
+  Region region(rects);
+
+  while (state.KeepRunning()) {
+    auto vec2 = region.getRects();
+  }
+}
+
+void RunGetDebandedRectsRectCountBenchmark(benchmark::State& state,
+                                           int numRects) {
+  std::seed_seq seed{2, 1, 3};
+  std::mt19937 rng(seed);
+
+  auto rects = GenerateRects(rng, ScaledBounds(numRects), numRects, 100);
+  flutter::DlRegion region(rects);
+
+  while (state.KeepRunning()) {
+    auto vec2 = region.getRects(true);
+  }
+}
+
+template <typename Region>
+void RunRegionOpRectCountBenchmark(benchmark::State& state,
+                                   RegionOp op,
+                                   int numRects) {
+  std::seed_seq seed{2, 1, 3};
+  std::mt19937 rng(seed);
+
+  SkIRect bounds = ScaledBounds(numRects);
+  Region region1(GenerateRects(rng, bounds, numRects, 100));
+  Region region2(GenerateRects(rng, bounds, numRects, 100));
+
+  switch (op) {
+    case kUnion:
+      while (state.KeepRunning()) {
+        Region::unionRegions(region1, region2);
+      }
+      break;
+    case kIntersection:
+      while (state.KeepRunning()) {
+        Region::intersectRegions(region1, region2);
+      }
+      break;
+  }
+}
+
+std::vector<SkRect> GenerateRTreeRects(int numRects, bool scattered) {
+  std::seed_seq seed{2, 1, 3};
+  std::mt19937 rng(seed);
+
+  auto irects = GenerateRects(rng, ScaledBounds(numRects), numRects, 100);
+  if (!scattered) {
+    // Drawn from top to bottom, like a page layout.
+    std::sort(irects.begin(), irects.end(),
+              [](const SkIRect& a, const SkIRect& b) {
+                return a.fTop < b.fTop;
+              });
+  }
+  std::vector<SkRect> rects;
+  rects.reserve(irects.size());
+  for (const auto& rect : irects) {
+    rects.push_back(SkRect::Make(rect));
+  }
+  return rects;
+}
+
+void RunRTreeFromRectsBenchmark(benchmark::State& state,
+                                int numRects,
+                                bool scattered) {
+  auto rects = GenerateRTreeRects(numRects, scattered);
+
+  while (state.KeepRunning()) {
+    flutter::DlRTree rtree(rects.data(), rects.size());
+  }
+}
+
+// Searches with queries of a tenth of the size of the bounds, like the cull
+// rect of a zoomed in canvas.
+void RunRTreeSearchBenchmark(benchmark::State& state,
+                             int numRects,
+                             bool scattered) {
+  std::seed_seq seed{2, 1, 3};
+  std::mt19937 rng(seed);
+
+  auto rects = GenerateRTreeRects(numRects, scattered);
+  flutter::DlRTree rtree(rects.data(), rects.size());
+
+  SkIRect bounds = ScaledBounds(numRects);
+  std::vector<SkRect> queries;
+  for (int i = 0; i < 100; ++i) {
+    queries.push_back(SkRect::Make(RandomSubRect(rng, bounds, 0.1)));
+  }
+
+  std::vector<int> results;
+  while (state.KeepRunning()) {
+    for (const auto& query : queries) {
+      results.clear();
+      rtree.search(query, &results);
+    }
+  }
+}
+
 }  // namespace
 
 namespace flutter {
@@ -313,6 +442,53 @@ static void BM_SkRegion_IntersectsSingleRect(benchmark::State& state,
   RunIntersectsSingleRectBenchmark<SkRegionAdapter>(state, maxSize);
 }
 
+static void BM_DlRegion_FromRectCount(benchmark::State& state, int numRects) {
+  RunFromRectCountBenchmark<DlRegionAdapter>(state, numRects);
+}
+
+static void BM_SkRegion_FromRectCount(benchmark::State& state, int numRects) {
+  RunFromRectCountBenchmark<SkRegionAdapter>(state, numRects);
+}
+
+static void BM_DlRegion_GetRectsRectCount(benchmark::State& state,
+                                          int numRects) {
+  RunGetRectsRectCountBenchmark<DlRegionAdapter>(state, numRects);
+}
+
+static void BM_SkRegion_GetRectsRectCount(benchmark::State& state,
+                                          int numRects) {
+  RunGetRectsRectCountBenchmark<SkRegionAdapter>(state, numRects);
+}
+
+static void BM_DlRegion_GetDebandedRectsRectCount(benchmark::State& state,
+                                                  int numRects) {
+  RunGetDebandedRectsRectCountBenchmark(state, numRects);
+}
+
+static void BM_DlRegion_OperationRectCount(benchmark::State& state,
+                                           RegionOp op,
+                                           int numRects) {
+  RunRegionOpRectCountBenchmark<DlRegionAdapter>(state, op, numRects);
+}
+
+static void BM_SkRegion_OperationRectCount(benchmark::State& state,
+                                           RegionOp op,
+                                           int numRects) {
+  RunRegionOpRectCountBenchmark<SkRegionAdapter>(state, op, numRects);
+}
+
+static void BM_DlRTree_FromRects(benchmark::State& state,
+                                 int numRects,
+                                 bool scattered) {
+  RunRTreeFromRectsBenchmark(state, numRects, scattered);
+}
+
+static void BM_DlRTree_Search(benchmark::State& state,
+                              int numRects,
+                              bool scattered) {
+  RunRTreeSearchBenchmark(state, numRects, scattered);
+}
+
 const double kSizeFactorSmall = 0.3;
 
 BENCHMARK_CAPTURE(BM_DlRegion_IntersectsSingleRect, Tiny, 30)
@@ -709,4 +885,125 @@ BENCHMARK_CAPTURE(BM_DlRegion_GetRects, Large, 1500)
 BENCHMARK_CAPTURE(BM_SkRegion_GetRects, Large, 1500)
     ->Unit(benchmark::kMicrosecond);
 
-}  // namespace flutter
\ No newline at end of file
+BENCHMARK_CAPTURE(BM_DlRegion_FromRectCount, 1k, 1000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_FromRectCount, 1k, 1000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegion_FromRectCount, 10k, 10000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_FromRectCount, 10k, 10000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegion_FromRectCount, 100k, 100000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_FromRectCount, 100k, 100000)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_DlRegion_GetRectsRectCount, 1k, 1000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_GetRectsRectCount, 1k, 1000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegion_GetRectsRectCount, 10k, 10000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_GetRectsRectCount, 10k, 10000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegion_GetRectsRectCount, 100k, 100000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_GetRectsRectCount, 100k, 100000)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_DlRegion_GetDebandedRectsRectCount, 1k, 1000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegion_GetDebandedRectsRectCount, 10k, 10000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegion_GetDebandedRectsRectCount, 100k, 100000)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_DlRegion_OperationRectCount,
+                  Union_1k,
+                  RegionOp::kUnion,
+                  1000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_OperationRectCount,
+                  Union_1k,
+                  RegionOp::kUnion,
+                  1000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegion_OperationRectCount,
+                  Union_10k,
+                  RegionOp::kUnion,
+                  10000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_OperationRectCount,
+                  Union_10k,
+                  RegionOp::kUnion,
+                  10000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegion_OperationRectCount,
+                  Union_100k,
+                  RegionOp::kUnion,
+                  100000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_OperationRectCount,
+                  Union_100k,
+                  RegionOp::kUnion,
+                  100000)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_DlRegion_OperationRectCount,
+                  Intersection_1k,
+                  RegionOp::kIntersection,
+                  1000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_OperationRectCount,
+                  Intersection_1k,
+                  RegionOp::kIntersection,
+                  1000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegion_OperationRectCount,
+                  Intersection_10k,
+                  RegionOp::kIntersection,
+                  10000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_OperationRectCount,
+                  Intersection_10k,
+                  RegionOp::kIntersection,
+                  10000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegion_OperationRectCount,
+                  Intersection_100k,
+                  RegionOp::kIntersection,
+                  100000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_OperationRectCount,
+                  Intersection_100k,
+                  RegionOp::kIntersection,
+                  100000)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_DlRTree_FromRects, Ordered_1k, 1000, false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRTree_FromRects, Scattered_1k, 1000, true)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRTree_FromRects, Ordered_10k, 10000, false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRTree_FromRects, Scattered_10k, 10000, true)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRTree_FromRects, Ordered_100k, 100000, false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRTree_FromRects, Scattered_100k, 100000, true)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_DlRTree_Search, Ordered_1k, 1000, false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRTree_Search, Scattered_1k, 1000, true)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRTree_Search, Ordered_10k, 10000, false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRTree_Search, Scattered_10k, 10000, true)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRTree_Search, Ordered_100k, 100000, false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRTree_Search, Scattered_100k, 100000, true)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
@@ -2,7 +2,12 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
 #include <type_traits>
+#include <vector>
 
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_op_records.h"
@@ -10,6 +15,141 @@
 
 namespace flutter {
 
+namespace {
+
+// A free list of storage buffers for each power of two size between
+// |kMinPooledSize| and |kMaxPooledSize|.
+class DisplayListStoragePool {
+ public:
+  // The pool never keeps more than this many bytes for each size class.
+  static constexpr size_t kMaxBytesPerSizeClass = 256 * 1024;
+
+  static DisplayListStoragePool& GetInstance() {
+    // Buffers may be released during static destruction. Leak the pool.
+    static DisplayListStoragePool* pool = new DisplayListStoragePool();
+    return *pool;
+  }
+
+  // The size of the buffer that would be used to hold |count| bytes, or 0
+  // if buffers of that size are not pooled.
+  static size_t GetPooledSize(size_t count) {
+    if (count > DisplayListStorage::kMaxPooledSize) {
+      return 0;
+    }
+    size_t size = DisplayListStorage::kMinPooledSize;
+    while (size < count) {
+      size <<= 1;
+    }
+    return size;
+  }
+
+  uint8_t* Acquire(size_t size) {
+    {
+      std::scoped_lock lock(mutex_);
+      auto& free_list = free_lists_[GetSizeClass(size)];
+      if (!free_list.empty()) {
+        uint8_t* buffer = free_list.back();
+        free_list.pop_back();
+        return buffer;
+      }
+    }
+    return static_cast<uint8_t*>(std::malloc(size));
+  }
+
+  void Release(uint8_t* buffer, size_t size) {
+    {
+      std::scoped_lock lock(mutex_);
+      auto& free_list = free_lists_[GetSizeClass(size)];
+      if (free_list.size() < kMaxBytesPerSizeClass / size) {
+        free_list.push_back(buffer);
+        return;
+      }
+    }
+    std::free(buffer);
+  }
+
+  size_t GetBufferCount() const {
+    std::scoped_lock lock(mutex_);
+    size_t count = 0;
+    for (const auto& free_list : free_lists_) {
+      count += free_list.size();
+    }
+    return count;
+  }
+
+ private:
+  static constexpr size_t kSizeClassCount = 9;
+  static_assert(DisplayListStorage::kMinPooledSize << (kSizeClassCount - 1) ==
+                DisplayListStorage::kMaxPooledSize);
+
+  static size_t GetSizeClass(size_t size) {
+    size_t size_class = 0;
+    while ((DisplayListStorage::kMinPooledSize << size_class) < size) {
+      size_class++;
+    }
+    FML_DCHECK(size_class < kSizeClassCount);
+    return size_class;
+  }
+
+  mutable std::mutex mutex_;
+  std::vector<uint8_t*> free_lists_[kSizeClassCount];
+
+  DisplayListStoragePool() = default;
+};
+
+}  // namespace
+
+void DisplayListStorage::Deleter::operator()(uint8_t* p) {
+  if (DisplayListStoragePool::GetPooledSize(capacity) == capacity) {
+    DisplayListStoragePool::GetInstance().Release(p, capacity);
+  } else {
+    std::free(p);
+  }
+}
+
+DisplayListStorage::DisplayListStorage(
+    std::shared_ptr<const fml::Mapping> mapping,
+    size_t offset)
+    : mapping_(std::move(mapping)),
+      // Records are only ever read through the storage of a DisplayList.
+      mapped_(const_cast<uint8_t*>(mapping_->GetMapping()) + offset) {}
+
+void DisplayListStorage::realloc(size_t count) {
+  FML_DCHECK(!mapped_);
+  size_t old_capacity = capacity();
+  size_t pooled_size = DisplayListStoragePool::GetPooledSize(count);
+  bool was_pooled =
+      ptr_ && DisplayListStoragePool::GetPooledSize(old_capacity) ==
+                  old_capacity;
+  if (pooled_size == 0u && !was_pooled) {
+    // Large buffers keep growing and shrinking in place where possible.
+    ptr_.reset(static_cast<uint8_t*>(std::realloc(ptr_.release(), count)));
+    FML_CHECK(ptr_);
+    ptr_.get_deleter().capacity = count;
+    return;
+  }
+
+  size_t new_capacity = pooled_size == 0u ? count : pooled_size;
+  if (new_capacity == old_capacity) {
+    return;
+  }
+  uint8_t* buffer =
+      pooled_size == 0u
+          ? static_cast<uint8_t*>(std::malloc(new_capacity))
+          : DisplayListStoragePool::GetInstance().Acquire(new_capacity);
+  FML_CHECK(buffer);
+  if (ptr_) {
+    memcpy(buffer, ptr_.get(), std::min(old_capacity, new_capacity));
+  }
+  // Releases the old buffer to the pool if it came from there.
+  ptr_.reset(buffer);
+  ptr_.get_deleter().capacity = new_capacity;
+}
+
+size_t DisplayListStorage::GetPooledBufferCount() {
+  return DisplayListStoragePool::GetInstance().GetBufferCount();
+}
+
 const SaveLayerOptions SaveLayerOptions::kNoAttributes = SaveLayerOptions();
 const SaveLayerOptions SaveLayerOptions::kWithAttributes =
     kNoAttributes.with_renders_with_attributes();
@@ -20,6 +160,7 @@ DisplayList::DisplayList()
       nested_byte_count_(0),
       nested_op_count_(0),
       unique_id_(0),
+      content_hash_(kEmptyContentHash),
       bounds_({0, 0, 0, 0}),
       can_apply_group_opacity_(true),
       is_ui_thread_safe_(true),
@@ -30,6 +171,7 @@ DisplayList::DisplayList(DisplayListStorage&& storage,
                          unsigned int op_count,
                          size_t nested_byte_count,
                          unsigned int nested_op_count,
+                         uint64_t content_hash,
                          const SkRect& bounds,
                          bool can_apply_group_opacity,
                          bool is_ui_thread_safe,
@@ -41,6 +183,7 @@ DisplayList::DisplayList(DisplayListStorage&& storage,
       nested_byte_count_(nested_byte_count),
       nested_op_count_(nested_op_count),
       unique_id_(next_unique_id()),
+      content_hash_(content_hash),
       bounds_(bounds),
       can_apply_group_opacity_(can_apply_group_opacity),
       is_ui_thread_safe_(is_ui_thread_safe),
@@ -236,6 +379,82 @@ void DisplayList::DisposeOps(uint8_t* ptr, uint8_t* end) {
   }
 }
 
+namespace {
+
+// Whether the bytes of an op are hashed. They are for the ops that are bulk
+// compared, except for the save ops, whose restore index and options are
+// only filled in when the matching restore is recorded. The other ops are
+// only hashed by type and size.
+template <typename T>
+constexpr bool kHashesOpBytes =
+    std::is_same_v<decltype(&T::equals), decltype(&DLOp::equals)> &&
+    !std::is_base_of_v<SaveOpBase, T>;
+
+constexpr uint64_t kContentHashPrime = 0x100000001b3u;
+
+uint64_t HashWord(uint64_t hash, uint64_t word) {
+  return (hash ^ word) * kContentHashPrime;
+}
+
+uint64_t HashBytes(uint64_t hash, const uint8_t* ptr, size_t byte_count) {
+  // Op records are padded to a multiple of the pointer size, and the
+  // padding is zeroed by the builder.
+  FML_DCHECK(byte_count % sizeof(uint32_t) == 0);
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= byte_count; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, ptr + i, sizeof(word));
+    hash = HashWord(hash, word);
+  }
+  for (; i + sizeof(uint32_t) <= byte_count; i += sizeof(uint32_t)) {
+    uint32_t word;
+    memcpy(&word, ptr + i, sizeof(word));
+    hash = HashWord(hash, word);
+  }
+  return hash;
+}
+
+}  // namespace
+
+uint64_t DisplayList::HashOps(const uint8_t* ptr,
+                              const uint8_t* end,
+                              uint64_t hash) {
+  while (ptr < end) {
+    auto op = reinterpret_cast<const DLOp*>(ptr);
+    bool hash_bytes = false;
+    switch (op->type) {
+#define DL_OP_HASHES_BYTES(name)           \
+  case DisplayListOpType::k##name:         \
+    hash_bytes = kHashesOpBytes<name##Op>; \
+    break;
+
+      FOR_EACH_DISPLAY_LIST_OP(DL_OP_HASHES_BYTES)
+#ifdef IMPELLER_ENABLE_3D
+      DL_OP_HASHES_BYTES(SetSceneColorSource)
+#endif  // IMPELLER_ENABLE_3D
+
+#undef DL_OP_HASHES_BYTES
+
+      default:
+        FML_DCHECK(false);
+        break;
+    }
+    if (hash_bytes) {
+      hash = HashBytes(hash, ptr, op->size);
+    } else {
+      hash = HashWord(hash, (static_cast<uint64_t>(op->type) << 32) | op->size);
+      if (op->type == DisplayListOpType::kDrawDisplayList) {
+        // Nested DisplayLists that are equal have the same content hash.
+        auto nested = static_cast<const DrawDisplayListOp*>(op);
+        hash = HashWord(hash, nested->display_list->content_hash());
+      }
+    }
+    ptr += op->size;
+    FML_DCHECK(ptr <= end);
+  }
+  return hash;
+}
+
 static bool CompareOps(uint8_t* ptrA,
                        uint8_t* endA,
                        uint8_t* ptrB,
@@ -305,11 +524,243 @@ static bool CompareOps(uint8_t* ptrA,
   return true;
 }
 
+namespace {
+
+constexpr uint32_t kSerializationMagic = 0x54534c44;  // "DLST"
+
+struct SerializedDisplayListHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t byte_count;
+  uint32_t op_count;
+  uint32_t flags;
+  SkRect bounds;
+  // The number of R-Tree leaves that follow the records, or -1 if the
+  // DisplayList has no R-Tree.
+  int32_t rtree_leaf_count;
+  uint32_t reserved;
+};
+static_assert(sizeof(SerializedDisplayListHeader) % alignof(std::max_align_t) ==
+              0);
+
+enum SerializedDisplayListFlags : uint32_t {
+  kCanApplyGroupOpacity = 1 << 0,
+  kIsUIThreadSafe = 1 << 1,
+  kModifiesTransparentBlack = 1 << 2,
+};
+
+// Whether records of |type| hold nothing but plain values, so that they can
+// be copied to another process and dispatched there as they are.
+bool IsSelfContainedOp(DisplayListOpType type) {
+  switch (type) {
+    case DisplayListOpType::kSetAntiAlias:
+    case DisplayListOpType::kSetDither:
+    case DisplayListOpType::kSetInvertColors:
+    case DisplayListOpType::kSetStrokeCap:
+    case DisplayListOpType::kSetStrokeJoin:
+    case DisplayListOpType::kSetStyle:
+    case DisplayListOpType::kSetStrokeWidth:
+    case DisplayListOpType::kSetStrokeMiter:
+    case DisplayListOpType::kSetColor:
+    case DisplayListOpType::kSetBlendMode:
+    case DisplayListOpType::kClearPathEffect:
+    case DisplayListOpType::kClearColorFilter:
+    case DisplayListOpType::kClearColorSource:
+    case DisplayListOpType::kClearImageFilter:
+    case DisplayListOpType::kClearMaskFilter:
+    case DisplayListOpType::kSave:
+    case DisplayListOpType::kSaveLayer:
+    case DisplayListOpType::kSaveLayerBounds:
+    case DisplayListOpType::kRestore:
+    case DisplayListOpType::kTranslate:
+    case DisplayListOpType::kScale:
+    case DisplayListOpType::kRotate:
+    case DisplayListOpType::kSkew:
+    case DisplayListOpType::kTransform2DAffine:
+    case DisplayListOpType::kTransformFullPerspective:
+    case DisplayListOpType::kTransformReset:
+    case DisplayListOpType::kClipIntersectRect:
+    case DisplayListOpType::kClipIntersectRRect:
+    case DisplayListOpType::kClipDifferenceRect:
+    case DisplayListOpType::kClipDifferenceRRect:
+    case DisplayListOpType::kDrawPaint:
+    case DisplayListOpType::kDrawColor:
+    case DisplayListOpType::kDrawLine:
+    case DisplayListOpType::kDrawRect:
+    case DisplayListOpType::kDrawOval:
+    case DisplayListOpType::kDrawCircle:
+    case DisplayListOpType::kDrawRRect:
+    case DisplayListOpType::kDrawDRRect:
+    case DisplayListOpType::kDrawArc:
+    case DisplayListOpType::kDrawPoints:
+    case DisplayListOpType::kDrawLines:
+    case DisplayListOpType::kDrawPolygon:
+    case DisplayListOpType::kDrawVertices:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Checks that the |length| bytes of records at |ptr| are self contained
+// and that no record, or the data that follows it, extends past the end.
+bool ValidateSerializedOps(const uint8_t* ptr, size_t length) {
+  const uint8_t* end = ptr + length;
+  while (ptr < end) {
+    if (static_cast<size_t>(end - ptr) < sizeof(DLOp)) {
+      return false;
+    }
+    auto op = reinterpret_cast<const DLOp*>(ptr);
+    if (op->size < sizeof(DLOp) || op->size > static_cast<size_t>(end - ptr) ||
+        !IsSelfContainedOp(op->type)) {
+      return false;
+    }
+    switch (op->type) {
+      case DisplayListOpType::kDrawPoints:
+      case DisplayListOpType::kDrawLines:
+      case DisplayListOpType::kDrawPolygon: {
+        // These all share the layout of DrawPointsOp.
+        auto points_op = static_cast<const DrawPointsOp*>(op);
+        if (op->size < sizeof(DrawPointsOp) ||
+            points_op->count >
+                (op->size - sizeof(DrawPointsOp)) / sizeof(SkPoint)) {
+          return false;
+        }
+        break;
+      }
+      case DisplayListOpType::kDrawVertices: {
+        if (op->size < sizeof(DrawVerticesOp) + sizeof(DlVertices)) {
+          return false;
+        }
+        auto vertices = reinterpret_cast<const DlVertices*>(
+            static_cast<const DrawVerticesOp*>(op) + 1);
+        if (vertices->size() > op->size - sizeof(DrawVerticesOp)) {
+          return false;
+        }
+        break;
+      }
+      default:
+        break;
+    }
+    ptr += op->size;
+  }
+  return true;
+}
+
+}  // namespace
+
+std::unique_ptr<fml::Mapping> DisplayList::Serialize() const {
+  uint8_t* ptr = storage_.get();
+  uint8_t* end = ptr + byte_count_;
+  while (ptr < end) {
+    auto op = reinterpret_cast<const DLOp*>(ptr);
+    if (!IsSelfContainedOp(op->type)) {
+      return nullptr;
+    }
+    ptr += op->size;
+  }
+
+  const int leaf_count = rtree_ ? rtree_->leaf_count() : 0;
+  const size_t rects_offset = sizeof(SerializedDisplayListHeader) + byte_count_;
+  const size_t ids_offset = rects_offset + leaf_count * sizeof(SkRect);
+  std::vector<uint8_t> data(ids_offset + leaf_count * sizeof(int));
+
+  SerializedDisplayListHeader header = {
+      .magic = kSerializationMagic,
+      .version = kSerializationVersion,
+      .byte_count = byte_count_,
+      .op_count = op_count_,
+      .flags = (can_apply_group_opacity_ ? kCanApplyGroupOpacity : 0u) |
+               (is_ui_thread_safe_ ? kIsUIThreadSafe : 0u) |
+               (modifies_transparent_black_ ? kModifiesTransparentBlack : 0u),
+      .bounds = bounds_,
+      .rtree_leaf_count = rtree_ ? leaf_count : -1,
+      .reserved = 0u,
+  };
+  memcpy(data.data(), &header, sizeof(header));
+  if (byte_count_ > 0) {
+    memcpy(data.data() + sizeof(header), storage_.get(), byte_count_);
+  }
+  for (int i = 0; i < leaf_count; i++) {
+    const int id = rtree_->id(i);
+    memcpy(data.data() + rects_offset + i * sizeof(SkRect),
+           &rtree_->bounds(i), sizeof(SkRect));
+    memcpy(data.data() + ids_offset + i * sizeof(int), &id, sizeof(int));
+  }
+  return std::make_unique<fml::DataMapping>(std::move(data));
+}
+
+sk_sp<DisplayList> DisplayList::Deserialize(
+    const std::shared_ptr<const fml::Mapping>& data) {
+  if (!data || data->GetSize() < sizeof(SerializedDisplayListHeader)) {
+    FML_LOG(ERROR) << "Serialized DisplayList is too small.";
+    return nullptr;
+  }
+  SerializedDisplayListHeader header;
+  memcpy(&header, data->GetMapping(), sizeof(header));
+  if (header.magic != kSerializationMagic ||
+      header.version != kSerializationVersion) {
+    FML_LOG(ERROR) << "Serialized DisplayList has an unsupported format.";
+    return nullptr;
+  }
+  const size_t leaf_count =
+      header.rtree_leaf_count > 0 ? header.rtree_leaf_count : 0;
+  const size_t leaf_size = sizeof(SkRect) + sizeof(int);
+  if (header.byte_count > data->GetSize() - sizeof(header) ||
+      data->GetSize() - sizeof(header) - header.byte_count !=
+          leaf_count * leaf_size) {
+    FML_LOG(ERROR) << "Serialized DisplayList has an unexpected size.";
+    return nullptr;
+  }
+  const size_t rects_offset = sizeof(header) + header.byte_count;
+  const size_t ids_offset = rects_offset + leaf_count * sizeof(SkRect);
+
+  // Records are dispatched in place unless the mapping isn't aligned well
+  // enough for them, in which case they are copied into owned storage.
+  const uint8_t* records = data->GetMapping() + sizeof(header);
+  auto storage = [&]() {
+    if (reinterpret_cast<uintptr_t>(records) % alignof(std::max_align_t) ==
+        0) {
+      return DisplayListStorage(data, sizeof(header));
+    }
+    DisplayListStorage owned;
+    if (header.byte_count > 0) {
+      owned.realloc(header.byte_count);
+      memcpy(owned.get(), records, header.byte_count);
+    }
+    return owned;
+  }();
+  if (!ValidateSerializedOps(storage.get(), header.byte_count)) {
+    FML_LOG(ERROR) << "Serialized DisplayList has invalid records.";
+    return nullptr;
+  }
+
+  sk_sp<const DlRTree> rtree;
+  if (header.rtree_leaf_count >= 0) {
+    std::vector<SkRect> rects(leaf_count);
+    std::vector<int> ids(leaf_count);
+    memcpy(rects.data(), data->GetMapping() + rects_offset,
+           leaf_count * sizeof(SkRect));
+    memcpy(ids.data(), data->GetMapping() + ids_offset,
+           leaf_count * sizeof(int));
+    rtree = sk_make_sp<DlRTree>(rects.data(), leaf_count, ids.data());
+  }
+
+  const uint64_t content_hash = HashOps(
+      storage.get(), storage.get() + header.byte_count, kEmptyContentHash);
+  return sk_sp<DisplayList>(new DisplayList(
+      std::move(storage), header.byte_count, header.op_count, 0u, 0u,
+      content_hash, header.bounds, header.flags & kCanApplyGroupOpacity,
+      header.flags & kIsUIThreadSafe,
+      header.flags & kModifiesTransparentBlack, std::move(rtree)));
+}
+
 bool DisplayList::Equals(const DisplayList* other) const {
   if (this == other) {
     return true;
   }
-  if (byte_count_ != other->byte_count_ || op_count_ != other->op_count_) {
+  if (byte_count_ != other->byte_count_ || op_count_ != other->op_count_ ||
+      content_hash_ != other->content_hash_) {
     return false;
   }
   uint8_t* ptr = storage_.get();
@@ -11,6 +11,7 @@
 #include "flutter/display_list/dl_sampling_options.h"
 #include "flutter/display_list/geometry/dl_rtree.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
 
 // The Flutter DisplayList mechanism encapsulates a persistent sequence of
 // rendering operations.
@@ -203,24 +204,52 @@ class SaveLayerOptions {
   };
 };
 
-// Manages a buffer allocated with malloc.
+// Manages a buffer for the records of a DisplayList.
+//
+// Buffers of at most |kMaxPooledSize| bytes are rounded up to a power of two
+// and are handed back to a process wide pool when they are released. The next
+// DisplayListBuilder that needs a buffer of the same size class reuses them
+// instead of going back to malloc. Scrolling lists build and retire thousands
+// of small DisplayLists every frame, and these are usually retired on a
+// different thread than the one that built them. Larger buffers are resized
+// with realloc and are never pooled.
 class DisplayListStorage {
  public:
+  static constexpr size_t kMinPooledSize = 256;
+  static constexpr size_t kMaxPooledSize = 64 * 1024;
+
   DisplayListStorage() = default;
   DisplayListStorage(DisplayListStorage&&) = default;
 
-  uint8_t* get() const { return ptr_.get(); }
+  // Refers to records that start at |offset| in |mapping| instead of owning
+  // a buffer. The mapping is kept alive by the storage, which can't be
+  // resized.
+  DisplayListStorage(std::shared_ptr<const fml::Mapping> mapping,
+                     size_t offset);
 
-  void realloc(size_t count) {
-    ptr_.reset(static_cast<uint8_t*>(std::realloc(ptr_.release(), count)));
-    FML_CHECK(ptr_);
-  }
+  uint8_t* get() const { return mapped_ ? mapped_ : ptr_.get(); }
+
+  // The number of bytes available in the buffer. This is at least the count
+  // passed to the last call to |realloc|.
+  size_t capacity() const { return ptr_ ? ptr_.get_deleter().capacity : 0; }
+
+  // Resizes the buffer to hold at least |count| bytes. The contents that fit
+  // in the new buffer are preserved.
+  void realloc(size_t count);
+
+  // The number of released buffers waiting in the pool to be reused.
+  static size_t GetPooledBufferCount();
 
  private:
-  struct FreeDeleter {
-    void operator()(uint8_t* p) { std::free(p); }
+  struct Deleter {
+    // Only meaningful while the buffer is allocated.
+    size_t capacity;
+
+    void operator()(uint8_t* p);
   };
-  std::unique_ptr<uint8_t, FreeDeleter> ptr_;
+  std::unique_ptr<uint8_t, Deleter> ptr_;
+  std::shared_ptr<const fml::Mapping> mapping_;
+  uint8_t* mapped_ = nullptr;
 };
 
 class Culler;
@@ -257,6 +286,15 @@ class DisplayList : public SkRefCnt {
   bool has_rtree() const { return rtree_ != nullptr; }
   sk_sp<const DlRTree> rtree() const { return rtree_; }
 
+  /// @brief     A hash of the ops, computed while they are recorded.
+  ///
+  ///            DisplayLists that are |Equals| have the same content hash, so
+  ///            two pictures that were rebuilt with different contents can be
+  ///            told apart without comparing their ops. Images, text blobs and
+  ///            other shared objects are hashed by identity, the same way
+  ///            |Equals| compares them.
+  uint64_t content_hash() const { return content_hash_; }
+
   bool Equals(const DisplayList* other) const;
   bool Equals(const DisplayList& other) const { return Equals(&other); }
   bool Equals(const sk_sp<const DisplayList>& other) const {
@@ -279,12 +317,42 @@ class DisplayList : public SkRefCnt {
     return modifies_transparent_black_;
   }
 
+  /// @brief     The version of the format written by |Serialize|. Data in
+  ///            any other version is rejected by |Deserialize|.
+  static constexpr uint32_t kSerializationVersion = 1u;
+
+  /// @brief     Writes the records and R-Tree of this DisplayList into a
+  ///            versioned binary buffer that |Deserialize| can read back.
+  ///
+  /// Only DisplayLists whose records are self contained can be serialized.
+  /// Records that refer to objects outside of the DisplayList, such as
+  /// images, paths, text, nested DisplayLists and attribute objects like
+  /// filters and color sources, can't be, and nullptr is returned for any
+  /// DisplayList that contains them.
+  ///
+  /// The records are written as they are laid out in memory, so the data
+  /// can only be read by an engine of the same version built for the same
+  /// architecture.
+  std::unique_ptr<fml::Mapping> Serialize() const;
+
+  /// @brief     Reads a DisplayList that was written by |Serialize|.
+  ///
+  /// If the records in |data| are suitably aligned, which is the case for
+  /// file mappings, the DisplayList dispatches them directly from |data|
+  /// and keeps it alive instead of copying them.
+  ///
+  /// @return    The DisplayList, or nullptr if |data| is not a valid
+  ///            serialized DisplayList.
+  static sk_sp<DisplayList> Deserialize(
+      const std::shared_ptr<const fml::Mapping>& data);
+
  private:
   DisplayList(DisplayListStorage&& ptr,
               size_t byte_count,
               unsigned int op_count,
               size_t nested_byte_count,
               unsigned int nested_op_count,
+              uint64_t content_hash,
               const SkRect& bounds,
               bool can_apply_group_opacity,
               bool is_ui_thread_safe,
@@ -295,6 +363,16 @@ class DisplayList : public SkRefCnt {
 
   static void DisposeOps(uint8_t* ptr, uint8_t* end);
 
+  // The content hash of a DisplayList without any ops.
+  static constexpr uint64_t kEmptyContentHash = 0xcbf29ce484222325u;
+
+  // Folds the ops in [ptr, end) into the content hash |hash|. Hashing the ops
+  // of a DisplayList in several consecutive runs gives the same hash as
+  // hashing them at once.
+  static uint64_t HashOps(const uint8_t* ptr,
+                          const uint8_t* end,
+                          uint64_t hash);
+
   const DisplayListStorage storage_;
   const size_t byte_count_;
   const unsigned int op_count_;
@@ -303,6 +381,7 @@ class DisplayList : public SkRefCnt {
   const unsigned int nested_op_count_;
 
   const uint32_t unique_id_;
+  const uint64_t content_hash_;
   const SkRect bounds_;
 
   const bool can_apply_group_opacity_;
@@ -251,6 +251,128 @@ TEST_F(DisplayListTest, BuilderCanBeReused) {
   ASSERT_TRUE(dl->Equals(dl2));
 }
 
+TEST_F(DisplayListTest, StorageOfRetiredDisplayListIsReused) {
+  DisplayListStorage storage;
+  storage.realloc(100u);
+  EXPECT_EQ(storage.capacity(), DisplayListStorage::kMinPooledSize);
+  uint8_t* buffer = storage.get();
+  size_t pooled_count = DisplayListStorage::GetPooledBufferCount();
+  {
+    // Released to the pool with the DisplayList that owns it.
+    DisplayListStorage retired(std::move(storage));
+    EXPECT_EQ(storage.capacity(), 0u);
+  }
+  EXPECT_EQ(DisplayListStorage::GetPooledBufferCount(), pooled_count + 1);
+
+  DisplayListStorage recycled;
+  recycled.realloc(200u);
+  EXPECT_EQ(recycled.get(), buffer);
+  EXPECT_EQ(DisplayListStorage::GetPooledBufferCount(), pooled_count);
+}
+
+TEST_F(DisplayListTest, StoragePreservesContentsWhenResized) {
+  DisplayListStorage storage;
+  storage.realloc(100u);
+  for (size_t i = 0; i < 100u; i++) {
+    storage.get()[i] = static_cast<uint8_t>(i);
+  }
+  // Grow within the pooled sizes, out of them and shrink back into them.
+  for (size_t count : {1000u, 100000u, 200000u, 100u}) {
+    storage.realloc(count);
+    EXPECT_GE(storage.capacity(), count);
+    for (size_t i = 0; i < 100u; i++) {
+      ASSERT_EQ(storage.get()[i], static_cast<uint8_t>(i));
+    }
+  }
+}
+
+TEST_F(DisplayListTest, SerializedDisplayListsAreEqual) {
+  DisplayListBuilder builder(true);
+  builder.Save();
+  builder.Translate(10, 10);
+  builder.ClipRect({0, 0, 100, 100});
+  builder.DrawRect({0, 0, 10, 10}, DlPaint(DlColor::kRed()));
+  builder.Restore();
+  SkPoint points[] = {{20, 20}, {30, 30}, {40, 20}};
+  builder.DrawPoints(DlCanvas::PointMode::kPolygon, 3, points,
+                     DlPaint().setStrokeWidth(2));
+  builder.DrawCircle({50, 50}, 5, DlPaint(DlColor::kBlue()));
+  auto display_list = builder.Build();
+
+  std::shared_ptr<const fml::Mapping> data = display_list->Serialize();
+  ASSERT_NE(data, nullptr);
+  auto deserialized = DisplayList::Deserialize(data);
+  ASSERT_NE(deserialized, nullptr);
+  EXPECT_TRUE(deserialized->Equals(display_list));
+  EXPECT_EQ(deserialized->content_hash(), display_list->content_hash());
+  EXPECT_EQ(deserialized->bounds(), display_list->bounds());
+  EXPECT_EQ(deserialized->op_count(), display_list->op_count());
+  EXPECT_EQ(deserialized->can_apply_group_opacity(),
+            display_list->can_apply_group_opacity());
+  ASSERT_TRUE(deserialized->has_rtree());
+  EXPECT_EQ(deserialized->rtree()->leaf_count(),
+            display_list->rtree()->leaf_count());
+
+  // Records in a misaligned mapping are copied instead of read in place.
+  std::vector<uint8_t> misaligned(data->GetSize() + 1);
+  memcpy(misaligned.data() + 1, data->GetMapping(), data->GetSize());
+  auto copied = DisplayList::Deserialize(std::make_shared<fml::NonOwnedMapping>(
+      misaligned.data() + 1, data->GetSize()));
+  ASSERT_NE(copied, nullptr);
+  EXPECT_TRUE(copied->Equals(display_list));
+}
+
+TEST_F(DisplayListTest, DisplayListsReferringToObjectsAreNotSerialized) {
+  DisplayListBuilder builder;
+  builder.DrawImage(TestImage1, {0, 0}, DlImageSampling::kLinear);
+  EXPECT_EQ(builder.Build()->Serialize(), nullptr);
+
+  builder.DrawPath(kTestPath1, DlPaint());
+  EXPECT_EQ(builder.Build()->Serialize(), nullptr);
+}
+
+TEST_F(DisplayListTest, InvalidSerializedDisplayListsAreRejected) {
+  DisplayListBuilder builder;
+  builder.DrawRect({0, 0, 10, 10}, DlPaint());
+  auto serialized = builder.Build()->Serialize();
+  ASSERT_NE(serialized, nullptr);
+  std::vector<uint8_t> data(serialized->GetMapping(),
+                            serialized->GetMapping() + serialized->GetSize());
+
+  EXPECT_EQ(DisplayList::Deserialize(nullptr), nullptr);
+  // Truncated data.
+  EXPECT_EQ(DisplayList::Deserialize(std::make_shared<fml::NonOwnedMapping>(
+                data.data(), data.size() - 1)),
+            nullptr);
+  // Another format version.
+  std::vector<uint8_t> other_version = data;
+  other_version[4]++;
+  EXPECT_EQ(DisplayList::Deserialize(
+                std::make_shared<fml::DataMapping>(other_version)),
+            nullptr);
+  // The valid data is still accepted.
+  EXPECT_NE(DisplayList::Deserialize(std::make_shared<fml::DataMapping>(data)),
+            nullptr);
+}
+
+TEST_F(DisplayListTest, RebuildsFromRecycledStorageAreEqual) {
+  sk_sp<DisplayList> expected;
+  for (int i = 0; i < 10; i++) {
+    DisplayListBuilder builder(kTestBounds);
+    for (int j = 0; j < 20; j++) {
+      builder.DrawRect(kTestBounds, DlPaint(DlColor::kRed()));
+    }
+    auto dl = builder.Build();
+    if (!expected) {
+      expected = dl;
+    } else {
+      // All but the first DisplayList are retired at the end of their
+      // iteration, so the later ones are built in recycled storage.
+      ASSERT_TRUE(dl->Equals(expected));
+    }
+  }
+}
+
 TEST_F(DisplayListTest, SaveRestoreRestoresTransform) {
   SkRect cull_rect = SkRect::MakeLTRB(-10.0f, -10.0f, 500.0f, 500.0f);
   DisplayListBuilder builder(cull_rect);
@@ -3242,5 +3364,64 @@ TEST_F(DisplayListTest, NopOperationsOmittedFromRecords) {
             });
 }
 
+TEST_F(DisplayListTest, BuilderInternsEqualColorSources) {
+  const SkRect rect = SkRect::MakeLTRB(10, 10, 20, 20);
+  std::shared_ptr<const DlColorSource> copy = kTestSource2->shared();
+  ASSERT_NE(copy.get(), kTestSource2.get());
+  DlPaint paint = DlPaint().setColorSource(kTestSource2);
+  DlPaint copy_paint = DlPaint().setColorSource(copy);
+  DlPaint other_paint = DlPaint().setColorSource(kTestSource3);
+
+  DisplayListBuilder builder;
+  builder.DrawRect(rect, paint);
+  EXPECT_EQ(DisplayListBuilderTestingAttributes(builder).getColorSourcePtr(),
+            kTestSource2.get());
+  builder.DrawRect(rect, copy_paint);
+  builder.DrawRect(rect, other_paint);
+  builder.DrawRect(rect, copy_paint);
+  // The equal copy shares the color source that was set first.
+  EXPECT_EQ(DisplayListBuilderTestingAttributes(builder).getColorSourcePtr(),
+            kTestSource2.get());
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  DisplayListBuilder expected_builder;
+  expected_builder.DrawRect(rect, paint);
+  expected_builder.DrawRect(rect, paint);
+  expected_builder.DrawRect(rect, other_paint);
+  expected_builder.DrawRect(rect, paint);
+  EXPECT_TRUE(display_list->Equals(expected_builder.Build()));
+}
+
+TEST_F(DisplayListTest, EqualDisplayListsHaveTheSameContentHash) {
+  auto build = [](DlColor color, bool nested) {
+    DisplayListBuilder builder;
+    builder.Save();
+    builder.Translate(10, 10);
+    builder.DrawRect(SkRect::MakeLTRB(0, 0, 10, 10), DlPaint(color));
+    builder.Restore();
+    builder.DrawCircle({5, 5}, 5, DlPaint().setColorSource(kTestSource2));
+    if (nested) {
+      DisplayListBuilder nested_builder;
+      nested_builder.DrawOval(SkRect::MakeLTRB(0, 0, 10, 5), DlPaint(color));
+      builder.DrawDisplayList(nested_builder.Build());
+    }
+    return builder.Build();
+  };
+  sk_sp<DisplayList> display_list = build(DlColor::kRed(), false);
+  EXPECT_NE(display_list->content_hash(),
+            DisplayListBuilder().Build()->content_hash());
+  EXPECT_EQ(display_list->content_hash(),
+            build(DlColor::kRed(), false)->content_hash());
+  EXPECT_NE(display_list->content_hash(),
+            build(DlColor::kBlue(), false)->content_hash());
+
+  sk_sp<DisplayList> nested = build(DlColor::kRed(), true);
+  sk_sp<DisplayList> equal_nested = build(DlColor::kRed(), true);
+  ASSERT_TRUE(nested->Equals(equal_nested));
+  EXPECT_EQ(nested->content_hash(), equal_nested->content_hash());
+  EXPECT_NE(nested->content_hash(),
+            build(DlColor::kBlue(), true)->content_hash());
+}
+
 }  // namespace testing
 }  // namespace flutter
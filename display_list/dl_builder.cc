@@ -39,16 +39,29 @@ static constexpr inline bool is_power_of_two(int value) {
   return (value & (value - 1)) == 0;
 }
 
+void DisplayListBuilder::UpdateContentHash() {
+  uint8_t* ptr = storage_.get();
+  content_hash_ =
+      DisplayList::HashOps(ptr + hashed_bytes_, ptr + used_, content_hash_);
+  hashed_bytes_ = used_;
+}
+
 template <typename T, typename... Args>
 void* DisplayListBuilder::Push(size_t pod, int render_op_inc, Args&&... args) {
+  UpdateContentHash();
   size_t size = SkAlignPtr(sizeof(T) + pod);
   FML_DCHECK(size < (1 << 24));
   if (used_ + size > allocated_) {
     static_assert(is_power_of_two(DL_BUILDER_PAGE),
                   "This math needs updating for non-pow2.");
-    // Next greater multiple of DL_BUILDER_PAGE.
-    allocated_ = (used_ + size + DL_BUILDER_PAGE) & ~(DL_BUILDER_PAGE - 1);
-    storage_.realloc(allocated_);
+    size_t needed = used_ + size;
+    // Small buffers grow by their pooled size class, see DisplayListStorage.
+    if (needed > DisplayListStorage::kMaxPooledSize) {
+      // Next greater multiple of DL_BUILDER_PAGE.
+      needed = (needed + DL_BUILDER_PAGE) & ~(DL_BUILDER_PAGE - 1);
+    }
+    storage_.realloc(needed);
+    allocated_ = storage_.capacity();
     FML_DCHECK(storage_.get());
     memset(storage_.get() + used_, 0, allocated_ - used_);
   }
@@ -68,6 +81,8 @@ sk_sp<DisplayList> DisplayListBuilder::Build() {
     restore();
   }
 
+  UpdateContentHash();
+  uint64_t content_hash = content_hash_;
   size_t bytes = used_;
   int count = render_op_count_;
   size_t nested_bytes = nested_bytes_;
@@ -79,15 +94,21 @@ sk_sp<DisplayList> DisplayListBuilder::Build() {
   used_ = allocated_ = render_op_count_ = op_index_ = 0;
   nested_bytes_ = nested_op_count_ = 0;
   is_ui_thread_safe_ = true;
+  content_hash_ = DisplayList::kEmptyContentHash;
+  hashed_bytes_ = 0;
   storage_.realloc(bytes);
   layer_stack_.pop_back();
   layer_stack_.emplace_back();
   tracker_.reset();
   current_ = DlPaint();
+  color_sources_.Clear();
+  color_filters_.Clear();
+  image_filters_.Clear();
 
   return sk_sp<DisplayList>(new DisplayList(
-      std::move(storage_), bytes, count, nested_bytes, nested_count, bounds(),
-      compatible, is_safe, affects_transparency, rtree()));
+      std::move(storage_), bytes, count, nested_bytes, nested_count,
+      content_hash, bounds(), compatible, is_safe, affects_transparency,
+      rtree()));
 }
 
 DisplayListBuilder::DisplayListBuilder(const SkRect& cull_rect,
@@ -167,7 +188,7 @@ void DisplayListBuilder::onSetColorSource(const DlColorSource* source) {
     current_.setColorSource(nullptr);
     Push<ClearColorSourceOp>(0, 0);
   } else {
-    current_.setColorSource(source->shared());
+    current_.setColorSource(color_sources_.Intern(source));
     is_ui_thread_safe_ = is_ui_thread_safe_ && source->isUIThreadSafe();
     switch (source->type()) {
       case DlColorSourceType::kColor: {
@@ -233,7 +254,7 @@ void DisplayListBuilder::onSetImageFilter(const DlImageFilter* filter) {
     current_.setImageFilter(nullptr);
     Push<ClearImageFilterOp>(0, 0);
   } else {
-    current_.setImageFilter(filter->shared());
+    current_.setImageFilter(image_filters_.Intern(filter));
     switch (filter->type()) {
       case DlImageFilterType::kBlur: {
         const DlBlurImageFilter* blur_filter = filter->asBlur();
@@ -277,7 +298,7 @@ void DisplayListBuilder::onSetColorFilter(const DlColorFilter* filter) {
     current_.setColorFilter(nullptr);
     Push<ClearColorFilterOp>(0, 0);
   } else {
-    current_.setColorFilter(filter->shared());
+    current_.setColorFilter(color_filters_.Intern(filter));
     switch (filter->type()) {
       case DlColorFilterType::kBlend: {
         const DlBlendColorFilter* blend_filter = filter->asBlend();
@@ -365,15 +386,17 @@ void DisplayListBuilder::SetAttributesFromPaint(
     setStrokeCap(paint.getStrokeCap());
     setStrokeJoin(paint.getStrokeJoin());
   }
+  // The objects of the paint are interned before they are set, so that they
+  // are compared with the current attributes by pointer.
   if (flags.applies_shader()) {
-    setColorSource(paint.getColorSource().get());
+    setColorSource(color_sources_.Intern(paint.getColorSource()).get());
   }
   if (flags.applies_color_filter()) {
     setInvertColors(paint.isInvertColors());
-    setColorFilter(paint.getColorFilter().get());
+    setColorFilter(color_filters_.Intern(paint.getColorFilter()).get());
   }
   if (flags.applies_image_filter()) {
-    setImageFilter(paint.getImageFilter().get());
+    setImageFilter(image_filters_.Intern(paint.getImageFilter()).get());
   }
   if (flags.applies_path_effect()) {
     setPathEffect(paint.getPathEffect().get());
@@ -14,6 +14,7 @@
 #include "flutter/display_list/dl_sampling_options.h"
 #include "flutter/display_list/effects/dl_path_effect.h"
 #include "flutter/display_list/image/dl_image.h"
+#include "flutter/display_list/utils/dl_attribute_table.h"
 #include "flutter/display_list/utils/dl_bounds_accumulator.h"
 #include "flutter/display_list/utils/dl_comparable.h"
 #include "flutter/display_list/utils/dl_matrix_clip_tracker.h"
@@ -325,19 +326,19 @@ class DisplayListBuilder final : public virtual DlCanvas,
   }
   // |DlOpReceiver|
   void setColorSource(const DlColorSource* source) override {
-    if (NotEquals(current_.getColorSource(), source)) {
+    if (color_sources_.NotEqual(current_.getColorSourcePtr(), source)) {
       onSetColorSource(source);
     }
   }
   // |DlOpReceiver|
   void setImageFilter(const DlImageFilter* filter) override {
-    if (NotEquals(current_.getImageFilter(), filter)) {
+    if (image_filters_.NotEqual(current_.getImageFilterPtr(), filter)) {
       onSetImageFilter(filter);
     }
   }
   // |DlOpReceiver|
   void setColorFilter(const DlColorFilter* filter) override {
-    if (NotEquals(current_.getColorFilter(), filter)) {
+    if (color_filters_.NotEqual(current_.getColorFilterPtr(), filter)) {
       onSetColorFilter(filter);
     }
   }
@@ -503,6 +504,13 @@ class DisplayListBuilder final : public virtual DlCanvas,
 
   bool is_ui_thread_safe_ = true;
 
+  // The content hash of the ops before |hashed_bytes_|. The last op is only
+  // hashed once the next one is pushed, after its data has been written.
+  uint64_t content_hash_ = DisplayList::kEmptyContentHash;
+  size_t hashed_bytes_ = 0;
+
+  void UpdateContentHash();
+
   template <typename T, typename... Args>
   void* Push(size_t extra, int op_inc, Args&&... args);
 
@@ -783,6 +791,12 @@ class DisplayListBuilder final : public virtual DlCanvas,
   bool AccumulateBounds(SkRect& bounds);
 
   DlPaint current_;
+
+  // The color sources and filters of this builder, so that the current
+  // attributes are compared by pointer when they are set again.
+  DlAttributeTable<DlColorSource> color_sources_;
+  DlAttributeTable<DlColorFilter> color_filters_;
+  DlAttributeTable<DlImageFilter> image_filters_;
 };
 
 }  // namespace flutter
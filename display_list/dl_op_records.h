@@ -799,6 +799,17 @@ struct DrawVerticesOp final : DrawOpBase {
       ctx.receiver.drawVertices(vertices, mode);
     }
   }
+
+  // The vertices can't be bulk compared as their unique ID differs between
+  // copies of vertices with the same contents.
+  DisplayListCompare equals(const DrawVerticesOp* other) const {
+    const DlVertices* vertices = reinterpret_cast<const DlVertices*>(this + 1);
+    const DlVertices* other_vertices =
+        reinterpret_cast<const DlVertices*>(other + 1);
+    return (mode == other->mode && *vertices == *other_vertices)
+               ? DisplayListCompare::kEqual
+               : DisplayListCompare::kNotEqual;
+  }
 };
 
 // 4 byte header + 40 byte payload uses 44 bytes but is rounded up to 48 bytes
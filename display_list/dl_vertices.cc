@@ -4,6 +4,8 @@
 
 #include "flutter/display_list/dl_vertices.h"
 
+#include <atomic>
+
 #include "flutter/display_list/utils/dl_bounds_accumulator.h"
 #include "flutter/fml/logging.h"
 
@@ -103,7 +105,8 @@ DlVertices::DlVertices(DlVertexMode mode,
                        const SkRect* bounds)
     : mode_(mode),
       vertex_count_(std::max(unchecked_vertex_count, 0)),
-      index_count_(indices ? std::max(unchecked_index_count, 0) : 0) {
+      index_count_(indices ? std::max(unchecked_index_count, 0) : 0),
+      unique_id_(next_unique_id()) {
   bounds_ = bounds ? *bounds : compute_bounds(vertices, vertex_count_);
 
   char* pod = reinterpret_cast<char*>(this);
@@ -138,7 +141,9 @@ DlVertices::DlVertices(const DlVertices* other)
                  other->colors(),
                  other->index_count_,
                  other->indices(),
-                 &other->bounds_) {}
+                 &other->bounds_) {
+  unique_id_ = other->unique_id_;
+}
 
 DlVertices::DlVertices(DlVertexMode mode,
                        int unchecked_vertex_count,
@@ -146,7 +151,8 @@ DlVertices::DlVertices(DlVertexMode mode,
                        int unchecked_index_count)
     : mode_(mode),
       vertex_count_(std::max(unchecked_vertex_count, 0)),
-      index_count_(std::max(unchecked_index_count, 0)) {
+      index_count_(std::max(unchecked_index_count, 0)),
+      unique_id_(next_unique_id()) {
   char* pod = reinterpret_cast<char*>(this);
   size_t offset = sizeof(DlVertices);
 
@@ -176,6 +182,15 @@ DlVertices::DlVertices(DlVertexMode mode,
   FML_DCHECK((index_count_ != 0) == (indices() != nullptr));
 }
 
+uint32_t DlVertices::next_unique_id() {
+  static std::atomic<uint32_t> next_id{1};
+  uint32_t id;
+  do {
+    id = next_id.fetch_add(+1, std::memory_order_relaxed);
+  } while (id == 0);
+  return id;
+}
+
 bool DlVertices::operator==(DlVertices const& other) const {
   auto lists_equal = [](auto* a, auto* b, int count) {
     if (a == nullptr || b == nullptr) {
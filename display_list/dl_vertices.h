@@ -228,6 +228,12 @@ class DlVertices {
     return static_cast<const uint16_t*>(pod(indices_offset_));
   }
 
+  /// Returns an ID that is shared by this object and its copies, and by no
+  /// other vertices. The contents of a |DlVertices| object never change after
+  /// it is built, so renderers can use this ID to keep its data on the GPU
+  /// across frames. Never 0.
+  uint32_t unique_id() const { return unique_id_; }
+
   bool operator==(DlVertices const& other) const;
 
   bool operator!=(DlVertices const& other) const { return !(*this == other); }
@@ -271,6 +277,10 @@ class DlVertices {
 
   SkRect bounds_;
 
+  uint32_t unique_id_;
+
+  static uint32_t next_unique_id();
+
   const void* pod(int offset) const {
     if (offset <= 0) {
       return nullptr;
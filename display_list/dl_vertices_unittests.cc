@@ -6,6 +6,7 @@
 #include "flutter/display_list/dl_vertices.h"
 #include "flutter/display_list/testing/dl_test_equality.h"
 #include "flutter/display_list/utils/dl_comparable.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
 #include "gtest/gtest.h"
 
 namespace flutter {
@@ -977,5 +978,52 @@ TEST(DisplayListVertices, TestNotEquals) {
   }
 }
 
+class VerticesIdRecorder : public virtual DlOpReceiver,
+                           public IgnoreAttributeDispatchHelper,
+                           public IgnoreClipDispatchHelper,
+                           public IgnoreTransformDispatchHelper,
+                           public IgnoreDrawDispatchHelper {
+ public:
+  void drawVertices(const DlVertices* vertices, DlBlendMode mode) override {
+    ids.push_back(vertices->unique_id());
+  }
+
+  std::vector<uint32_t> ids;
+};
+
+TEST(DisplayListVertices, UniqueIdIsSharedByCopies) {
+  SkPoint coords[3] = {
+      SkPoint::Make(2, 3),
+      SkPoint::Make(5, 6),
+      SkPoint::Make(15, 20),
+  };
+
+  std::shared_ptr<const DlVertices> vertices1 = DlVertices::Make(
+      DlVertexMode::kTriangles, 3, coords, nullptr, nullptr);
+  std::shared_ptr<const DlVertices> vertices2 = DlVertices::Make(
+      DlVertexMode::kTriangles, 3, coords, nullptr, nullptr);
+  EXPECT_NE(vertices1->unique_id(), 0u);
+  EXPECT_NE(vertices2->unique_id(), 0u);
+  EXPECT_NE(vertices1->unique_id(), vertices2->unique_id());
+
+  DisplayListBuilder builder1;
+  builder1.DrawVertices(vertices1.get(), DlBlendMode::kSrcOver, DlPaint());
+  builder1.DrawVertices(vertices1.get(), DlBlendMode::kSrcOver, DlPaint());
+  auto display_list1 = builder1.Build();
+  DisplayListBuilder builder2;
+  builder2.DrawVertices(vertices2.get(), DlBlendMode::kSrcOver, DlPaint());
+  builder2.DrawVertices(vertices2.get(), DlBlendMode::kSrcOver, DlPaint());
+  auto display_list2 = builder2.Build();
+
+  VerticesIdRecorder recorder;
+  display_list1->Dispatch(recorder);
+  ASSERT_EQ(recorder.ids.size(), 2u);
+  EXPECT_EQ(recorder.ids[0], vertices1->unique_id());
+  EXPECT_EQ(recorder.ids[1], vertices1->unique_id());
+
+  // Display lists with equal vertices are equal regardless of their IDs.
+  EXPECT_TRUE(display_list1->Equals(display_list2));
+}
+
 }  // namespace testing
 }  // namespace flutter
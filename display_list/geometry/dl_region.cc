@@ -171,6 +171,17 @@ size_t DlRegion::unionLineSpans(std::vector<Span>& res,
     res.resize(min_size);
   }
 
+  // Spans that do not touch can be copied without merging them.
+  if ((end1 - 1)->right < begin2->left) {
+    std::copy(begin1, end1, res.begin());
+    std::copy(begin2, end2, res.begin() + (end1 - begin1));
+    return min_size;
+  } else if ((end2 - 1)->right < begin1->left) {
+    std::copy(begin2, end2, res.begin());
+    std::copy(begin1, end1, res.begin() + (end2 - begin2));
+    return min_size;
+  }
+
   OrderedSpanAccumulator accumulator(res);
 
   while (true) {
@@ -214,6 +225,10 @@ size_t DlRegion::intersectLineSpans(std::vector<Span>& res,
   const Span *begin2, *end2;
   b_buffer.getSpans(b_handle, begin2, end2);
 
+  if ((end1 - 1)->right <= begin2->left || (end2 - 1)->right <= begin1->left) {
+    return 0;
+  }
+
   // Worst case scenario, interleaved overlapping spans
   //   AAAA  BBBB  CCCC
   // XXX  YYYY  XXXX
@@ -252,26 +267,37 @@ void DlRegion::setRects(const std::vector<SkIRect>& unsorted_rects) {
   // setRects can only be called on empty regions.
   FML_DCHECK(lines_.empty());
 
-  size_t count = unsorted_rects.size();
-  std::vector<const SkIRect*> rects(count);
-  for (size_t i = 0; i < count; i++) {
-    rects[i] = &unsorted_rects[i];
-    bounds_.join(unsorted_rects[i]);
-  }
-  std::sort(rects.begin(), rects.end(), [](const SkIRect* a, const SkIRect* b) {
-    if (a->top() < b->top()) {
-      return true;
-    }
-    if (a->top() > b->top()) {
-      return false;
+  // Empty rects do not contribute to the region. Work on a copy of the
+  // remaining rects, rather than pointers to them, so that the sweep below
+  // walks contiguous memory.
+  std::vector<SkIRect> rects;
+  rects.reserve(unsorted_rects.size());
+  for (const auto& rect : unsorted_rects) {
+    if (!rect.isEmpty()) {
+      rects.push_back(rect);
+      bounds_.join(rect);
     }
-    return a->left() < b->left();
-  });
-
+  }
+  std::sort(rects.begin(), rects.end(),
+            [](const SkIRect& a, const SkIRect& b) {
+              if (a.top() < b.top()) {
+                return true;
+              }
+              if (a.top() > b.top()) {
+                return false;
+              }
+              return a.left() < b.left();
+            });
+
+  // The active rects are kept sorted by left in rects[0, active_end). This
+  // never overlaps the rects that have not been reached yet, which start at
+  // next_rect.
+  size_t count = rects.size();
   size_t active_end = 0;
   size_t next_rect = 0;
   int32_t cur_y = std::numeric_limits<int32_t>::min();
   SpanVec working_spans;
+  std::vector<SkIRect> incoming_rects;
 
 #ifdef DlRegion_DO_STATS
   size_t active_rect_count = 0;
@@ -284,9 +310,8 @@ void DlRegion::setRects(const std::vector<SkIRect>& unsorted_rects) {
     // First prune passed rects out of the active list
     size_t preserve_end = 0;
     for (size_t i = 0; i < active_end; i++) {
-      const SkIRect* r = rects[i];
-      if (r->bottom() > cur_y) {
-        rects[preserve_end++] = r;
+      if (rects[i].bottom() > cur_y) {
+        rects[preserve_end++] = rects[i];
       }
     }
     active_end = preserve_end;
@@ -298,32 +323,41 @@ void DlRegion::setRects(const std::vector<SkIRect>& unsorted_rects) {
         // No active rects and no more rects to bring in. We are done.
         break;
       }
-      cur_y = rects[next_rect]->top();
+      cur_y = rects[next_rect].top();
     }
 
-    // Next, insert any new rects we've reached into the active list
-    while (next_rect < count) {
-      const SkIRect* r = rects[next_rect];
-      if (r->isEmpty()) {
-        continue;
-      }
-      if (r->top() > cur_y) {
-        break;
-      }
-      // We now know that we will be inserting this rect into active list
-      next_rect++;
-      size_t insert_at = active_end++;
-      while (insert_at > 0) {
-        const SkIRect* ir = rects[insert_at - 1];
-        if (ir->left() <= r->left()) {
-          break;
+    // Next, insert any new rects we've reached into the active list. They
+    // are already sorted by left, so they are merged into the active list
+    // from the back in a single pass.
+    size_t incoming_end = next_rect;
+    while (incoming_end < count && rects[incoming_end].top() <= cur_y) {
+      incoming_end++;
+    }
+    if (incoming_end > next_rect) {
+      size_t incoming_count = incoming_end - next_rect;
+      if (active_end == 0) {
+        std::copy(rects.begin() + next_rect, rects.begin() + incoming_end,
+                  rects.begin());
+      } else {
+        incoming_rects.assign(rects.begin() + next_rect,
+                              rects.begin() + incoming_end);
+        size_t write = active_end + incoming_count;
+        size_t active = active_end;
+        size_t incoming = incoming_count;
+        while (incoming > 0) {
+          if (active > 0 &&
+              rects[active - 1].left() > incoming_rects[incoming - 1].left()) {
+            rects[--write] = rects[--active];
+          } else {
+            rects[--write] = incoming_rects[--incoming];
+          }
         }
-        rects[insert_at--] = ir;
       }
-      rects[insert_at] = r;
+      active_end += incoming_count;
+      next_rect = incoming_end;
     }
 
-    // We either preserved some rects in the active list or added more from
+  // We either preserved some rects in the active list or added more from
     // the remaining input rects, or we would have exited the loop above.
     FML_DCHECK(active_end != 0);
     working_spans.clear();
@@ -336,27 +370,27 @@ void DlRegion::setRects(const std::vector<SkIRect>& unsorted_rects) {
 
     // [start_x, end_x) always represents a valid span to be inserted
     // [cur_y, end_y) is the intersecting range over which all spans are valid
-    int32_t start_x = rects[0]->left();
-    int32_t end_x = rects[0]->right();
-    int32_t end_y = rects[0]->bottom();
+    int32_t start_x = rects[0].left();
+    int32_t end_x = rects[0].right();
+    int32_t end_y = rects[0].bottom();
     for (size_t i = 1; i < active_end; i++) {
-      const SkIRect* r = rects[i];
-      if (r->left() > end_x) {
+      const SkIRect& r = rects[i];
+      if (r.left() > end_x) {
         working_spans.emplace_back(start_x, end_x);
-        start_x = r->left();
-        end_x = r->right();
-      } else if (end_x < r->right()) {
-        end_x = r->right();
+        start_x = r.left();
+        end_x = r.right();
+      } else if (end_x < r.right()) {
+        end_x = r.right();
       }
-      if (end_y > r->bottom()) {
-        end_y = r->bottom();
+      if (end_y > r.bottom()) {
+        end_y = r.bottom();
       }
     }
     working_spans.emplace_back(start_x, end_x);
 
     // end_y must not pass by the top of the next input rect
-    if (next_rect < count && end_y > rects[next_rect]->top()) {
-      end_y = rects[next_rect]->top();
+    if (next_rect < count && end_y > rects[next_rect].top()) {
+      end_y = rects[next_rect].top();
     }
 
     // If all of the rules above work out, we should never collapse the
@@ -570,41 +604,58 @@ std::vector<SkIRect> DlRegion::getRects(bool deband) const {
   }
 
   size_t rect_count = 0;
-  size_t previous_span_end = 0;
   for (const auto& line : lines_) {
     rect_count += span_buffer_.getChunkSize(line.chunk_handle);
   }
   rects.reserve(rect_count);
 
+  if (!deband) {
+    for (const auto& line : lines_) {
+      const Span *span_begin, *span_end;
+      span_buffer_.getSpans(line.chunk_handle, span_begin, span_end);
+      for (const auto* span = span_begin; span < span_end; ++span) {
+        rects.push_back({span->left, line.top, span->right, line.bottom});
+      }
+    }
+    return rects;
+  }
+
+  // Rects ending at the bottom of the previous line, sorted by left. They
+  // are only added to the result once it is known that the current line
+  // does not continue them, which keeps the result grouped by the line the
+  // rects end at and sorted by left within each group.
+  std::vector<SkIRect> open_rects;
+  std::vector<SkIRect> next_open_rects;
   for (const auto& line : lines_) {
+    if (!open_rects.empty() && open_rects.front().bottom() != line.top) {
+      rects.insert(rects.end(), open_rects.begin(), open_rects.end());
+      open_rects.clear();
+    }
+    next_open_rects.clear();
+    auto open_it = open_rects.begin();
     const Span *span_begin, *span_end;
     span_buffer_.getSpans(line.chunk_handle, span_begin, span_end);
     for (const auto* span = span_begin; span < span_end; ++span) {
       SkIRect rect{span->left, line.top, span->right, line.bottom};
-      if (deband) {
-        auto iter = rects.begin() + previous_span_end;
-        // If there is rectangle previously in rects on which this one is a
-        // vertical continuation, remove the previous rectangle and expand
-        // this one vertically to cover the area.
-        while (iter != rects.begin()) {
-          --iter;
-          if (iter->bottom() < rect.top()) {
-            // Went all the way to previous span line.
-            break;
-          } else if (iter->left() == rect.left() &&
-                     iter->right() == rect.right()) {
-            FML_DCHECK(iter->bottom() == rect.top());
-            rect.fTop = iter->fTop;
-            rects.erase(iter);
-            --previous_span_end;
-            break;
-          }
+      while (open_it != open_rects.end() && open_it->left() < rect.left()) {
+        rects.push_back(*open_it++);
+      }
+      // If the previous line has a rect with the same horizontal extent then
+      // this rect is a vertical continuation of it.
+      if (open_it != open_rects.end() && open_it->left() == rect.left()) {
+        if (open_it->right() == rect.right()) {
+          rect.fTop = open_it->fTop;
+        } else {
+          rects.push_back(*open_it);
         }
+        ++open_it;
       }
-      rects.push_back(rect);
+      next_open_rects.push_back(rect);
     }
-    previous_span_end = rects.size();
+    rects.insert(rects.end(), open_it, open_rects.end());
+    std::swap(open_rects, next_open_rects);
   }
+  rects.insert(rects.end(), open_rects.begin(), open_rects.end());
   return rects;
 }
 
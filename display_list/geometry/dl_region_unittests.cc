@@ -151,6 +151,43 @@ TEST(DisplayListRegion, Deband) {
   EXPECT_EQ(rects_without_deband, expected_without_deband);
 }
 
+TEST(DisplayListRegion, DebandAcrossGap) {
+  DlRegion region({
+      SkIRect::MakeXYWH(0, 0, 50, 20),
+      SkIRect::MakeXYWH(0, 20, 30, 20),
+      SkIRect::MakeXYWH(0, 50, 50, 10),
+      SkIRect::MakeXYWH(0, 60, 50, 10),
+  });
+
+  // Rects are not merged across the gap between 40 and 50.
+  auto rects = region.getRects(true);
+  std::vector<SkIRect> expected{
+      SkIRect::MakeXYWH(0, 0, 50, 20),
+      SkIRect::MakeXYWH(0, 20, 30, 20),
+      SkIRect::MakeXYWH(0, 50, 50, 20),
+  };
+  EXPECT_EQ(rects, expected);
+}
+
+TEST(DisplayListRegion, EmptyRectsAreIgnored) {
+  DlRegion region({
+      SkIRect::MakeXYWH(0, 0, 0, 10),
+      SkIRect::MakeXYWH(0, 0, 10, 10),
+      SkIRect::MakeXYWH(5, 20, 10, 0),
+  });
+  EXPECT_EQ(region.bounds(), SkIRect::MakeXYWH(0, 0, 10, 10));
+  std::vector<SkIRect> expected{
+      SkIRect::MakeXYWH(0, 0, 10, 10),
+  };
+  EXPECT_EQ(region.getRects(), expected);
+
+  DlRegion empty_region({
+      SkIRect::MakeXYWH(0, 0, 0, 10),
+      SkIRect::MakeXYWH(5, 20, 10, 0),
+  });
+  EXPECT_TRUE(empty_region.isEmpty());
+}
+
 TEST(DisplayListRegion, Intersects1) {
   DlRegion region1({
       SkIRect::MakeXYWH(0, 0, 20, 20),
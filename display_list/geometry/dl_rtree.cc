@@ -5,10 +5,63 @@
 #include "flutter/display_list/geometry/dl_rtree.h"
 #include "flutter/display_list/geometry/dl_region.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
 #include "flutter/fml/logging.h"
 
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
 namespace flutter {
 
+namespace {
+
+// Returns a mask with bit i set if the i-th of 4 consecutive rectangles
+// given by their sides intersects the non-empty |query|. Unused children,
+// whose sides are inverted, never intersect it.
+uint32_t IntersectionMask4(const float left[],
+                           const float top[],
+                           const float right[],
+                           const float bottom[],
+                           const SkRect& query) {
+#if defined(__ARM_NEON)
+  uint32x4_t hits = vandq_u32(
+      vandq_u32(vcltq_f32(vld1q_f32(left), vdupq_n_f32(query.fRight)),
+                vcltq_f32(vdupq_n_f32(query.fLeft), vld1q_f32(right))),
+      vandq_u32(vcltq_f32(vld1q_f32(top), vdupq_n_f32(query.fBottom)),
+                vcltq_f32(vdupq_n_f32(query.fTop), vld1q_f32(bottom))));
+  const uint32x4_t bits = {1, 2, 4, 8};
+  uint32x4_t masked = vandq_u32(hits, bits);
+  uint32x2_t sum = vadd_u32(vget_low_u32(masked), vget_high_u32(masked));
+  return vget_lane_u32(vpadd_u32(sum, sum), 0);
+#elif defined(__SSE__)
+  __m128 hits = _mm_and_ps(
+      _mm_and_ps(_mm_cmplt_ps(_mm_loadu_ps(left), _mm_set1_ps(query.fRight)),
+                 _mm_cmplt_ps(_mm_set1_ps(query.fLeft), _mm_loadu_ps(right))),
+      _mm_and_ps(
+          _mm_cmplt_ps(_mm_loadu_ps(top), _mm_set1_ps(query.fBottom)),
+          _mm_cmplt_ps(_mm_set1_ps(query.fTop), _mm_loadu_ps(bottom))));
+  return _mm_movemask_ps(hits);
+#else
+  uint32_t mask = 0;
+  for (int i = 0; i < 4; i++) {
+    if (left[i] < query.fRight && query.fLeft < right[i] &&
+        top[i] < query.fBottom && query.fTop < bottom[i]) {
+      mask |= 1 << i;
+    }
+  }
+  return mask;
+#endif
+}
+
+}  // namespace
+
 DlRTree::DlRTree(const SkRect rects[],
                  int N,
                  const int ids[],
@@ -33,110 +86,219 @@ DlRTree::DlRTree(const SkRect rects[],
     }
   }
   leaf_count_ = leaf_count;
+  if (leaf_count == 0) {
+    return;
+  }
 
-  // Count the total number of nodes (leaf and internal) up front
-  // so we can resize the vector just once.
-  uint32_t total_node_count = leaf_count;
+  // Count the total number of branches up front so we can resize the
+  // vector just once.
+  uint32_t total_branch_count = 0;
   uint32_t gen_count = leaf_count;
-  while (gen_count > 1) {
-    uint32_t family_count = (gen_count + kMaxChildren - 1u) / kMaxChildren;
-    total_node_count += family_count;
-    gen_count = family_count;
-  }
+  do {
+    gen_count = (gen_count + kMaxChildren - 1u) / kMaxChildren;
+    total_branch_count += gen_count;
+  } while (gen_count > 1);
 
-  nodes_.resize(total_node_count);
+  nodes_.resize(leaf_count);
+  branches_.reserve(total_branch_count);
 
   // Now place only the tracked rectangles into the nodes array
-  // in the first leaf_count_ entries.
+  // in their original order.
+  std::vector<Entry> entries;
+  entries.reserve(leaf_count);
   int leaf_index = 0;
   int id = invalid_id;
   for (int i = 0; i < N; i++) {
     if (!rects[i].isEmpty()) {
       if (ids == nullptr || p(id = ids[i])) {
-        Node& node = nodes_[leaf_index++];
+        Node& node = nodes_[leaf_index];
         node.bounds = rects[i];
         node.id = id;
+        entries.push_back({rects[i], static_cast<uint32_t>(leaf_index)});
+        leaf_index++;
       }
     }
   }
   FML_DCHECK(leaf_index == leaf_count);
 
   // --- Implementation note ---
-  // Many R-Tree algorithms attempt to consolidate nearby rectangles
-  // into branches of the tree in order to maximize the benefit of
-  // bounds testing against whole sub-trees. The Skia code from which
-  // this was based, though, indicated that empirical tests against a
-  // browser client showed little gains in rendering performance while
-  // costing 17% performance in bulk loading the rects into the R-Tree:
-  // https://github.com/google/skia/blob/12b6bd042f7cdffb9012c90c3b4885601fc7be95/src/core/SkRTree.cpp#L96
+  // Grouping the rectangles in the order in which they were drawn works
+  // well for apps that perform a type of "page layout" with rendering
+  // proceeding in a linear fashion from top to bottom, and it costs
+  // nothing but a pass over the rectangles. But it produces branches that
+  // span most of the list when the drawing jumps around, such as on
+  // zoomable canvases with scattered operations. Such branches intersect
+  // nearly every query and cull nothing.
   //
-  // Given that this class will most often be used to track rendering
-  // operations that were drawn in an app that performs a type of
-  // "page layout" with rendering proceeding in a linear fashion from
-  // top to bottom (and left to right or right to left), the rectangles
-  // are likely nearly sorted when they are delivered to this constructor
-  // so leaving them in their original order should show similar results
-  // to what Skia found in their empirical browser tests.
+  // Since an R-Tree is built for every recorded picture, generations are
+  // still grouped in order when the resulting branches overlap little,
+  // and only otherwise sorted into tiles with the Sort-Tile-Recursive
+  // algorithm, which costs a few more passes over the rectangles.
   // ---
 
-  // Continually process the previous level (generation) of nodes,
-  // combining them into a new generation of parent groups each grouping
-  // at most |kMaxChildren| children and joining their bounds into its
-  // parent bounds.
-  // Each generation will end up reduced by a factor of up to kMaxChildren
-  // until there is just one node left, which is the root node of
-  // the R-Tree.
-  uint32_t gen_start = 0;
-  gen_count = leaf_count;
-  while (gen_count > 1) {
-    uint32_t gen_end = gen_start + gen_count;
-
-    uint32_t family_count = (gen_count + kMaxChildren - 1u) / kMaxChildren;
-    FML_DCHECK(gen_end + family_count <= total_node_count);
-
-    // D here is similar to the variable in a Bresenham line algorithm where
-    // we want to slowly move |family_count| steps along the minor axis as
-    // we move |gen_count| steps along the major axis.
-    //
-    // Each inner loop increments D by family_count.
-    // The inner loop executes a total of gen_count times.
-    // Every time D exceeds 0 we subtract gen_count and move to a new parent.
-    // All told we will increment D by family_count a total of gen_count times.
-    // All told we will decrement D by gen_count a total of family_count times.
-    // This leaves D back at its starting value.
-    //
-    // We could bias/balance where the extra children are placed by varying
-    // the initial count of D from 0 to (1 - family_count), but we aren't
-    // looking at this process aesthetically so we just use 0 as an initial
-    // value. Using 0 provides a "greedy" allocation of the extra children.
-    // Bresenham also uses double the size of the steps we use here also to
-    // have better rounding of when the minor axis steps occur, but again we
-    // don't care about the distribution of the extra children.
-    int D = 0;
-
-    uint32_t sibling_index = gen_start;
-    uint32_t parent_index = gen_end;
-    Node* parent = nullptr;
-    while (sibling_index < gen_end) {
-      if ((D += family_count) > 0) {
-        D -= gen_count;
-        FML_DCHECK(parent_index < gen_end + family_count);
-        parent = &nodes_[parent_index++];
-        parent->bounds.setEmpty();
-        parent->child.index = sibling_index;
-        parent->child.count = 0;
+  // Continually group the previous generation into a new generation of
+  // branches with at most |kMaxChildren| children each, until there is
+  // just one branch left, which is the root of the R-Tree.
+  bool children_are_leaves = true;
+  do {
+    BuildGeneration(entries, children_are_leaves);
+    children_are_leaves = false;
+  } while (entries.size() > 1);
+  FML_DCHECK(branches_.size() == total_branch_count);
+  bounds_ = entries.front().bounds;
+}
+
+void DlRTree::BuildGeneration(std::vector<Entry>& entries,
+                              bool children_are_leaves) {
+  const size_t count = entries.size();
+  const size_t branch_count = (count + kMaxChildren - 1) / kMaxChildren;
+
+  SkRect bounds;
+  std::vector<uint32_t> order(count);
+  if (HasCoherentOrder(entries, &bounds)) {
+    std::iota(order.begin(), order.end(), 0u);
+  } else {
+    SortIntoTiles(entries, bounds, order);
+  }
+
+  constexpr float kInfinity = std::numeric_limits<float>::infinity();
+  std::vector<Entry> parents;
+  parents.reserve(branch_count);
+  for (size_t start = 0; start < count; start += kMaxChildren) {
+    const uint32_t branch_index = branches_.size();
+    Branch& branch = branches_.emplace_back();
+    branch.count = std::min<size_t>(kMaxChildren, count - start);
+    branch.children_are_leaves = children_are_leaves;
+    for (int i = 0; i < kMaxChildren; i++) {
+      if (i < static_cast<int>(branch.count)) {
+        const Entry& entry = entries[order[start + i]];
+        branch.left[i] = entry.bounds.fLeft;
+        branch.top[i] = entry.bounds.fTop;
+        branch.right[i] = entry.bounds.fRight;
+        branch.bottom[i] = entry.bounds.fBottom;
+        branch.child[i] = entry.index;
+      } else {
+        branch.left[i] = kInfinity;
+        branch.top[i] = kInfinity;
+        branch.right[i] = -kInfinity;
+        branch.bottom[i] = -kInfinity;
+        branch.child[i] = 0;
       }
-      FML_DCHECK(parent != nullptr);
-      parent->bounds.join(nodes_[sibling_index++].bounds);
-      parent->child.count++;
     }
-    FML_DCHECK(D == 0);
-    FML_DCHECK(sibling_index == gen_end);
-    FML_DCHECK(parent_index == gen_end + family_count);
-    gen_start = gen_end;
-    gen_count = family_count;
+    // The unused children don't extend the bounds.
+    SkRect branch_bounds = SkRect::MakeLTRB(kInfinity, kInfinity, -kInfinity,
+                                            -kInfinity);
+    for (int i = 0; i < kMaxChildren; i++) {
+      branch_bounds.fLeft = std::min(branch_bounds.fLeft, branch.left[i]);
+      branch_bounds.fTop = std::min(branch_bounds.fTop, branch.top[i]);
+      branch_bounds.fRight = std::max(branch_bounds.fRight, branch.right[i]);
+      branch_bounds.fBottom =
+          std::max(branch_bounds.fBottom, branch.bottom[i]);
+    }
+    parents.push_back({branch_bounds, branch_index});
+  }
+  FML_DCHECK(parents.size() == branch_count);
+  entries.swap(parents);
+}
+
+bool DlRTree::HasCoherentOrder(const std::vector<Entry>& entries,
+                               SkRect* bounds) {
+  // The entries are not empty, so their bounds are joined without the
+  // checks of |SkRect::join|.
+  constexpr float kInfinity = std::numeric_limits<float>::infinity();
+  *bounds = SkRect::MakeLTRB(kInfinity, kInfinity, -kInfinity, -kInfinity);
+  double branch_area = 0;
+  for (size_t start = 0; start < entries.size(); start += kMaxChildren) {
+    SkRect branch_bounds = entries[start].bounds;
+    const size_t end = std::min(start + kMaxChildren, entries.size());
+    for (size_t i = start + 1; i < end; i++) {
+      const SkRect& entry_bounds = entries[i].bounds;
+      branch_bounds.fLeft = std::min(branch_bounds.fLeft, entry_bounds.fLeft);
+      branch_bounds.fTop = std::min(branch_bounds.fTop, entry_bounds.fTop);
+      branch_bounds.fRight =
+          std::max(branch_bounds.fRight, entry_bounds.fRight);
+      branch_bounds.fBottom =
+          std::max(branch_bounds.fBottom, entry_bounds.fBottom);
+    }
+    branch_area += static_cast<double>(branch_bounds.width()) *
+                   static_cast<double>(branch_bounds.height());
+    bounds->fLeft = std::min(bounds->fLeft, branch_bounds.fLeft);
+    bounds->fTop = std::min(bounds->fTop, branch_bounds.fTop);
+    bounds->fRight = std::max(bounds->fRight, branch_bounds.fRight);
+    bounds->fBottom = std::max(bounds->fBottom, branch_bounds.fBottom);
+  }
+  return branch_area <= kMaxCoherentOverlap *
+                            static_cast<double>(bounds->width()) *
+                            static_cast<double>(bounds->height());
+}
+
+void DlRTree::SortIntoTiles(const std::vector<Entry>& entries,
+                            const SkRect& bounds,
+                            std::vector<uint32_t>& order) {
+  const size_t count = entries.size();
+  const size_t branch_count = (count + kMaxChildren - 1) / kMaxChildren;
+
+  // Sort the entries into vertical slices of about the square root of the
+  // number of branches each, and each slice from top to bottom, so that
+  // every run of |kMaxChildren| entries is a tile of nearby rectangles.
+  // Rather than sorting each slice, all of the entries are sorted from top
+  // to bottom once and then distributed into their slices in that order.
+  const size_t slice_count = std::ceil(std::sqrt(branch_count));
+  const size_t slice_size =
+      (branch_count + slice_count - 1) / slice_count * kMaxChildren;
+  std::vector<uint32_t> sorted;
+  SortByCenter(entries, bounds, false, sorted);
+  std::vector<uint32_t> slices(count);
+  for (size_t rank = 0; rank < count; rank++) {
+    slices[sorted[rank]] = rank / slice_size;
+  }
+  SortByCenter(entries, bounds, true, sorted);
+  std::vector<uint32_t> slice_offsets(slice_count);
+  for (size_t slice = 0; slice < slice_count; slice++) {
+    slice_offsets[slice] = slice * slice_size;
+  }
+  for (uint32_t index : sorted) {
+    order[slice_offsets[slices[index]]++] = index;
+  }
+}
+
+void DlRTree::SortByCenter(const std::vector<Entry>& entries,
+                           const SkRect& bounds,
+                           bool vertical,
+                           std::vector<uint32_t>& sorted) {
+  // The tiles only need to be told apart, so the centers are quantized to a
+  // number of buckets on the order of the number of entries and sorted with
+  // a single counting sort, in a time linear in the number of entries.
+  const size_t count = entries.size();
+  const size_t bucket_count =
+      std::clamp<size_t>(count, kMinSortBuckets, kMaxSortBuckets);
+  const float min = vertical ? bounds.fTop : bounds.fLeft;
+  const float max = vertical ? bounds.fBottom : bounds.fRight;
+  // The sums of the sides of a rect are twice its center.
+  const float scale = bucket_count / (2 * (max - min));
+  auto bucket = [&](const SkRect& rect) -> size_t {
+    float center = vertical ? rect.fTop + rect.fBottom
+                            : rect.fLeft + rect.fRight;
+    float key = (center - 2 * min) * scale;
+    // Also catches NaN keys of rects or bounds with infinite sides.
+    if (!(key > 0)) {
+      return 0;
+    }
+    return key < bucket_count - 1 ? static_cast<size_t>(key)
+                                  : bucket_count - 1;
+  };
+
+  std::vector<uint32_t> offsets(bucket_count + 1);
+  for (const Entry& entry : entries) {
+    offsets[bucket(entry.bounds) + 1]++;
+  }
+  for (size_t i = 1; i < bucket_count; i++) {
+    offsets[i] += offsets[i - 1];
+  }
+  sorted.resize(count);
+  for (size_t i = 0; i < count; i++) {
+    sorted[offsets[bucket(entries[i].bounds)]++] = i;
   }
-  FML_DCHECK(gen_start + gen_count == total_node_count);
 }
 
 void DlRTree::search(const SkRect& query, std::vector<int>* results) const {
@@ -144,18 +306,18 @@ void DlRTree::search(const SkRect& query, std::vector<int>* results) const {
   if (query.isEmpty()) {
     return;
   }
-  if (nodes_.size() <= 0) {
+  if (branches_.empty()) {
     FML_DCHECK(leaf_count_ == 0);
     return;
   }
-  const Node& root = nodes_.back();
-  if (root.bounds.intersects(query)) {
-    if (nodes_.size() == 1) {
-      FML_DCHECK(leaf_count_ == 1);
-      // The root node is the only node and it is a leaf node
-      results->push_back(0);
-    } else {
-      search(root, query, results);
+  if (bounds_.intersects(query)) {
+    const size_t start = results->size();
+    search(branches_.back(), query, results);
+    // Nearby rectangles are grouped together rather than the ones that
+    // were drawn one after another, so the hits are put back in the order
+    // in which they were drawn.
+    if (!std::is_sorted(results->begin() + start, results->end())) {
+      std::sort(results->begin() + start, results->end());
     }
   }
 }
@@ -183,19 +345,23 @@ std::list<SkRect> DlRTree::searchAndConsolidateRects(const SkRect& query,
   return final_results;
 }
 
-void DlRTree::search(const Node& parent,
+void DlRTree::search(const Branch& parent,
                      const SkRect& query,
                      std::vector<int>* results) const {
   // Caller protects against empty query
-  int start = parent.child.index;
-  int end = start + parent.child.count;
-  for (int i = start; i < end; i++) {
-    const Node& node = nodes_[i];
-    if (node.bounds.intersects(query)) {
-      if (i < leaf_count_) {
-        results->push_back(i);
+  uint32_t mask = 0;
+  for (int lane = 0; lane < kMaxChildren; lane += 4) {
+    mask |= IntersectionMask4(&parent.left[lane], &parent.top[lane],
+                              &parent.right[lane], &parent.bottom[lane],
+                              query)
+            << lane;
+  }
+  for (uint32_t i = 0; mask != 0; i++, mask >>= 1) {
+    if (mask & 1) {
+      if (parent.children_are_leaves) {
+        results->push_back(parent.child[i]);
       } else {
-        search(node, query, results);
+        search(branches_[parent.child[i]], query, results);
       }
     }
   }
@@ -214,11 +380,7 @@ const DlRegion& DlRTree::region() const {
 }
 
 const SkRect& DlRTree::bounds() const {
-  if (!nodes_.empty()) {
-    return nodes_.back().bounds;
-  } else {
-    return empty_;
-  }
+  return bounds_;
 }
 
 }  // namespace flutter
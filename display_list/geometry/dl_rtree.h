@@ -5,6 +5,7 @@
 #ifndef FLUTTER_DISPLAY_LIST_GEOMETRY_DL_RTREE_H_
 #define FLUTTER_DISPLAY_LIST_GEOMETRY_DL_RTREE_H_
 
+#include <cstdint>
 #include <list>
 #include <optional>
 #include <vector>
@@ -19,6 +20,14 @@ namespace flutter {
 /// An R-Tree that stores a list of bounding rectangles with optional
 /// associated IDs.
 ///
+/// Rectangles that were drawn one after another are grouped together
+/// when they are near each other. Otherwise the tree is bulk loaded with
+/// the Sort-Tile-Recursive algorithm, which groups rectangles that are
+/// near each other regardless of the order in which they were drawn. The
+/// bounds of the children of each internal node are stored as arrays of
+/// each side so that they can be tested against a query several at a time
+/// with SIMD instructions.
+///
 /// The R-Tree can be searched in one of two ways:
 /// - Query for a list of hits among the original rectangles
 ///   @see |search|
@@ -27,19 +36,28 @@ namespace flutter {
 ///   @see |searchAndConsolidateRects|
 class DlRTree : public SkRefCnt {
  private:
-  static constexpr int kMaxChildren = 11;
+  // A multiple of the 4 lanes of the SIMD intersection test.
+  static constexpr int kMaxChildren = 8;
+  static_assert(kMaxChildren % 4 == 0);
 
-  // Leaf nodes at start of vector have an ID,
-  // Internal nodes after that have child index and count.
+  // The rectangles and IDs that were passed to the constructor, in their
+  // original order.
   struct Node {
     SkRect bounds;
-    union {
-      struct {
-        uint32_t index;
-        uint32_t count;
-      } child;
-      int id;
-    };
+    int id;
+  };
+
+  // An internal node of the tree. The children are leaf nodes in the lowest
+  // generation of branches and branches in the generations above. Unused
+  // slots have inverted infinite bounds that never intersect a query.
+  struct alignas(16) Branch {
+    float left[kMaxChildren];
+    float top[kMaxChildren];
+    float right[kMaxChildren];
+    float bottom[kMaxChildren];
+    uint32_t child[kMaxChildren];
+    uint32_t count;
+    bool children_are_leaves;
   };
 
  public:
@@ -72,11 +90,11 @@ class DlRTree : public SkRefCnt {
   ///
   /// Note that the indices are internal indices of the stored data
   /// and not the index of the rectangles or ids in the constructor.
-  /// The returned indices may not themselves be in numerical order,
-  /// but they will represent the rectangles and IDs in the order in
-  /// which they were passed into the constructor. The actual rectangle
-  /// and ID associated with each index can be retrieved using the
-  /// |DlRTree::id| and |DlRTree::bounds| methods.
+  /// The returned indices will be in numerical order and represent the
+  /// rectangles and IDs in the order in which they were passed into the
+  /// constructor. The actual rectangle and ID associated with each index
+  /// can be retrieved using the |DlRTree::id| and |DlRTree::bounds|
+  /// methods.
   void search(const SkRect& query, std::vector<int>* results) const;
 
   /// Return the ID for the indicated result of a query or
@@ -101,7 +119,8 @@ class DlRTree : public SkRefCnt {
 
   /// Returns the bytes used by the object and all of its node data.
   size_t bytes_used() const {
-    return sizeof(DlRTree) + sizeof(Node) * nodes_.size();
+    return sizeof(DlRTree) + sizeof(Node) * nodes_.size() +
+           sizeof(Branch) * branches_.size();
   }
 
   /// Returns the number of leaf nodes corresponding to non-empty
@@ -111,7 +130,7 @@ class DlRTree : public SkRefCnt {
 
   /// Return the total number of nodes used in the R-Tree, both leaf
   /// and internal consolidation nodes.
-  int node_count() const { return nodes_.size(); }
+  int node_count() const { return nodes_.size() + branches_.size(); }
 
   /// Finds the rects in the tree that intersect with the query rect.
   ///
@@ -138,11 +157,52 @@ class DlRTree : public SkRefCnt {
  private:
   static constexpr SkRect empty_ = SkRect::MakeEmpty();
 
-  void search(const Node& parent,
+  // An entry to group into the next generation of branches.
+  struct Entry {
+    SkRect bounds;
+    uint32_t index;
+  };
+
+  // Groups |entries| into new branches, in order or with the
+  // Sort-Tile-Recursive algorithm, and replaces them with entries for those
+  // branches.
+  void BuildGeneration(std::vector<Entry>& entries, bool children_are_leaves);
+
+  // Generations whose branches grouped in order add up to at most this
+  // many times the area of their bounds are not sorted into tiles.
+  static constexpr double kMaxCoherentOverlap = 2.0;
+
+  // Returns whether grouping |entries| in their original order produces
+  // branches that overlap little, and sets |bounds| to their bounds.
+  static bool HasCoherentOrder(const std::vector<Entry>& entries,
+                               SkRect* bounds);
+
+  // Sets |order| to the indices of |entries| in Sort-Tile-Recursive order,
+  // where every run of |kMaxChildren| entries is a tile of nearby entries.
+  static void SortIntoTiles(const std::vector<Entry>& entries,
+                            const SkRect& bounds,
+                            std::vector<uint32_t>& order);
+
+  // The range of the number of buckets the centers of the entries are
+  // sorted into by |SortByCenter|.
+  static constexpr size_t kMinSortBuckets = 64;
+  static constexpr size_t kMaxSortBuckets = 4096;
+
+  // Sets |sorted| to the indices of |entries| sorted by their horizontal or
+  // vertical center, approximately. Entries with close centers within
+  // |bounds| are kept in their original order.
+  static void SortByCenter(const std::vector<Entry>& entries,
+                           const SkRect& bounds,
+                           bool vertical,
+                           std::vector<uint32_t>& sorted);
+
+  void search(const Branch& parent,
               const SkRect& query,
               std::vector<int>* results) const;
 
   std::vector<Node> nodes_;
+  std::vector<Branch> branches_;
+  SkRect bounds_ = SkRect::MakeEmpty();
   int leaf_count_;
   int invalid_id_;
   mutable std::optional<DlRegion> region_;
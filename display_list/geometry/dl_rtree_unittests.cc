@@ -319,5 +319,38 @@ TEST(DisplayListRTree, Region) {
   EXPECT_EQ(rects.size(), expected_rects.size());
 }
 
+TEST(DisplayListRTree, ScatteredRects) {
+  // Rects of varying sizes spread over the whole area in an order that
+  // jumps around, as on a zoomable canvas.
+  const int N = 2000;
+  std::vector<SkRect> rects(N);
+  uint32_t seed = 1;
+  auto next = [&seed](int max) {
+    seed = seed * 1103515245 + 12345;
+    return static_cast<int>((seed >> 16) % max);
+  };
+  for (int i = 0; i < N; i++) {
+    rects[i] = SkRect::MakeXYWH(next(4000), next(4000), next(100) + 1,
+                                next(100) + 1);
+  }
+  DlRTree tree(rects.data(), N);
+  EXPECT_EQ(tree.leaf_count(), N);
+  std::vector<int> results;
+  for (int i = 0; i < 100; i++) {
+    auto query = SkRect::MakeXYWH(next(4000), next(4000), next(500) + 1,
+                                  next(500) + 1);
+    std::vector<int> expected;
+    for (int j = 0; j < N; j++) {
+      if (rects[j].intersects(query)) {
+        expected.push_back(j);
+      }
+    }
+    results.clear();
+    tree.search(query, &results);
+    // The hits are in the order in which the rects were passed in.
+    EXPECT_EQ(results, expected) << "query " << i;
+  }
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -32,6 +32,10 @@ SkIRect DlImage::bounds() const {
   return SkIRect::MakeSize(dimensions());
 }
 
+std::vector<DlImage::ImpellerTile> DlImage::impeller_tiles() const {
+  return {};
+}
+
 std::optional<std::string> DlImage::get_error() const {
   return std::nullopt;
 }
@@ -8,6 +8,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "third_party/skia/include/core/SkImage.h"
@@ -54,6 +55,30 @@ class DlImage : public SkRefCnt {
   ///
   virtual std::shared_ptr<impeller::Texture> impeller_texture() const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      A part of an Impeller image that is larger than a single
+  ///             texture can be.
+  ///
+  struct ImpellerTile {
+    /// The texture, which holds the pixels of the image in |texture_bounds|.
+    std::shared_ptr<impeller::Texture> texture;
+    /// The pixels held by the texture. These overlap the neighboring tiles by
+    /// a pixel, so that the tiles are filtered without seams.
+    SkIRect texture_bounds;
+    /// The pixels the tile is drawn for. These don't overlap between tiles.
+    SkIRect bounds;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      If this image is larger than an Impeller texture can be, the
+  ///             tiles the image is drawn from. The |impeller_texture| of such
+  ///             an image is a downscaled copy that fits in a texture, used by
+  ///             draws that can't be split into tiles.
+  ///
+  /// @return     The tiles of the image, or none if it isn't tiled.
+  ///
+  virtual std::vector<ImpellerTile> impeller_tiles() const;
+
   //----------------------------------------------------------------------------
   /// @brief      If the pixel format of this image ignores alpha, this returns
   ///             true. This method might conservatively return false when it
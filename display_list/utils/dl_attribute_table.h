@@ -0,0 +1,133 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_UTILS_DL_ATTRIBUTE_TABLE_H_
+#define FLUTTER_DISPLAY_LIST_UTILS_DL_ATTRIBUTE_TABLE_H_
+
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+// Interns the attribute objects (color sources, filters) set on a
+// |DisplayListBuilder|, so that equal attributes share one object.
+//
+// Every object set through a |shared_ptr| is remembered along with the
+// interned object that is equal to it. Once an object is known to the table,
+// finding out whether it is equal to another known object is a pointer
+// compare of their interned objects, instead of a deep compare of gradient
+// stops or filter parameters on every draw.
+//
+// The table holds references to at most |kMaxEntries| objects. Attributes
+// that don't fit are still handed back, but are not deduplicated.
+template <typename T>
+class DlAttributeTable {
+ public:
+  static constexpr size_t kMaxEntries = 16;
+
+  DlAttributeTable() = default;
+
+  // Returns the interned object equal to |object| if |object| is known to
+  // the table, or nullptr. Never deep compares.
+  const T* Find(const T* object) const {
+    const Entry* entry = FindEntry(object);
+    return entry ? entry->interned.get() : nullptr;
+  }
+
+  // Returns the interned object equal to |object|. The table retains |object|
+  // so that it can be found by pointer afterwards, and interns it when no
+  // equal object is interned yet.
+  std::shared_ptr<const T> Intern(const std::shared_ptr<const T>& object) {
+    if (!object) {
+      return nullptr;
+    }
+    const Entry* entry = FindEntry(object.get());
+    if (entry) {
+      return entry->interned;
+    }
+    std::shared_ptr<const T> interned = FindEqual(object.get());
+    if (entries_.size() < kMaxEntries) {
+      entries_.push_back({object, interned ? interned : object});
+    }
+    return interned ? interned : object;
+  }
+
+  // Returns the interned object equal to |object|, interning a shared copy
+  // of |object| when no equal object is interned yet. The table doesn't own
+  // |object|, so it can't be found by pointer afterwards unless it's the
+  // interned object itself.
+  std::shared_ptr<const T> Intern(const T* object) {
+    if (!object) {
+      return nullptr;
+    }
+    const Entry* entry = FindEntry(object);
+    if (entry) {
+      return entry->interned;
+    }
+    std::shared_ptr<const T> interned = FindEqual(object);
+    if (interned) {
+      return interned;
+    }
+    std::shared_ptr<const T> copy = object->shared();
+    if (entries_.size() < kMaxEntries) {
+      entries_.push_back({copy, copy});
+    }
+    return copy;
+  }
+
+  // Whether the attributes |a| and |b| differ, comparing pointers when both
+  // are known to the table.
+  bool NotEqual(const T* a, const T* b) const {
+    if (a == b) {
+      return false;
+    }
+    if (!a || !b) {
+      return true;
+    }
+    const T* interned_a = Find(a);
+    const T* interned_b = interned_a ? Find(b) : nullptr;
+    if (interned_b) {
+      return interned_a != interned_b;
+    }
+    return *a != *b;
+  }
+
+  size_t size() const { return entries_.size(); }
+
+  void Clear() { entries_.clear(); }
+
+ private:
+  struct Entry {
+    std::shared_ptr<const T> object;
+    std::shared_ptr<const T> interned;
+  };
+
+  const Entry* FindEntry(const T* object) const {
+    for (const Entry& entry : entries_) {
+      if (entry.object.get() == object) {
+        return &entry;
+      }
+    }
+    return nullptr;
+  }
+
+  std::shared_ptr<const T> FindEqual(const T* object) const {
+    for (const Entry& entry : entries_) {
+      if (entry.object == entry.interned && *entry.interned == *object) {
+        return entry.interned;
+      }
+    }
+    return nullptr;
+  }
+
+  std::vector<Entry> entries_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DlAttributeTable);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_UTILS_DL_ATTRIBUTE_TABLE_H_
@@ -63,6 +63,7 @@ void CompositorContext::BeginFrame(ScopedFrame& frame,
   if (enable_instrumentation) {
     raster_time_.Start();
   }
+  layer_raster_profiler_.BeginFrame();
 }
 
 void CompositorContext::EndFrame(ScopedFrame& frame,
@@ -11,6 +11,7 @@
 #include "flutter/common/graphics/texture.h"
 #include "flutter/flow/diff_context.h"
 #include "flutter/flow/embedded_views.h"
+#include "flutter/flow/layer_raster_profiler.h"
 #include "flutter/flow/layer_snapshot_store.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/stopwatch.h"
@@ -205,12 +206,26 @@ class CompositorContext {
 
   LayerSnapshotStore& snapshot_store() { return layer_snapshot_store_; }
 
+  LayerRasterProfiler& layer_raster_profiler() {
+    return layer_raster_profiler_;
+  }
+
+  // Whether container layers that are painted again in an unchanged layer
+  // subtree replay a recording of their children instead of painting them.
+  // See |ContainerLayer::PaintChildren|.
+  bool retain_unchanged_subtrees() const { return retain_unchanged_subtrees_; }
+  void set_retain_unchanged_subtrees(bool retain) {
+    retain_unchanged_subtrees_ = retain;
+  }
+
  private:
   RasterCache raster_cache_;
   std::shared_ptr<TextureRegistry> texture_registry_;
   Stopwatch raster_time_;
   Stopwatch ui_time_;
   LayerSnapshotStore layer_snapshot_store_;
+  LayerRasterProfiler layer_raster_profiler_;
+  bool retain_unchanged_subtrees_ = false;
 
   /// Only used by default constructor of `CompositorContext`.
   FixedRefreshRateUpdater fixed_refresh_rate_updater_;
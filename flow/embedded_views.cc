@@ -42,6 +42,10 @@ bool DisplayListEmbedderViewSlice::recording_ended() {
   return builder_ == nullptr;
 }
 
+const sk_sp<DisplayList>& DisplayListEmbedderViewSlice::display_list() const {
+  return display_list_;
+}
+
 void ExternalViewEmbedder::SubmitFrame(
     GrDirectContext* context,
     const std::shared_ptr<impeller::AiksContext>& aiks_context,
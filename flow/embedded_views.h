@@ -355,6 +355,8 @@ class DisplayListEmbedderViewSlice : public EmbedderViewSlice {
   void dispatch(DlOpReceiver& receiver);
   bool is_empty();
   bool recording_ended();
+  // The recorded display list. Only valid once the recording has ended.
+  const sk_sp<DisplayList>& display_list() const;
 
  private:
   std::unique_ptr<DisplayListBuilder> builder_;
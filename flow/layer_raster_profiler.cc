@@ -0,0 +1,122 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layer_raster_profiler.h"
+
+#include <algorithm>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+LayerRasterProfiler::LayerRasterProfiler(size_t sampling_interval)
+    : sampling_interval_(sampling_interval) {}
+
+LayerRasterProfiler::~LayerRasterProfiler() = default;
+
+void LayerRasterProfiler::SetSamplingInterval(size_t sampling_interval) {
+  sampling_interval_ = sampling_interval;
+}
+
+bool LayerRasterProfiler::BeginFrame() {
+  FML_DCHECK(active_layers_.empty());
+  frame_count_++;
+  sampling_frame_ =
+      sampling_interval_ > 0u && frame_count_ % sampling_interval_ == 0u;
+  if (sampling_frame_) {
+    sampled_frame_count_++;
+    if (entries_.size() > kMaxTrackedLayers) {
+      DropLeastRecentlySampledLayers();
+    }
+  }
+  return sampling_frame_;
+}
+
+void LayerRasterProfiler::BeginLayer(uint64_t layer_unique_id) {
+  active_layers_.push_back({
+      .layer_unique_id = layer_unique_id,
+      .start = fml::TimePoint::Now(),
+  });
+}
+
+void LayerRasterProfiler::EndLayer(Phase phase) {
+  FML_DCHECK(!active_layers_.empty());
+  const ActiveLayer layer = active_layers_.back();
+  active_layers_.pop_back();
+
+  const fml::TimeDelta elapsed = fml::TimePoint::Now() - layer.start;
+  if (!active_layers_.empty()) {
+    ActiveLayer& parent = active_layers_.back();
+    parent.children_time = parent.children_time + elapsed;
+  }
+  const fml::TimeDelta self_time = elapsed - layer.children_time;
+
+  Entry& entry = entries_[layer.layer_unique_id];
+  LayerStats& stats = entry.stats;
+  stats.layer_unique_id = layer.layer_unique_id;
+  if (entry.last_sampled_frame != sampled_frame_count_) {
+    entry.last_sampled_frame = sampled_frame_count_;
+    entry.frame_time = fml::TimeDelta::Zero();
+    stats.sample_count++;
+  }
+  switch (phase) {
+    case Phase::kPreroll:
+      stats.preroll_time = stats.preroll_time + self_time;
+      break;
+    case Phase::kPaint:
+      stats.paint_time = stats.paint_time + self_time;
+      break;
+  }
+  entry.frame_time = entry.frame_time + self_time;
+  stats.max_frame_time = std::max(stats.max_frame_time, entry.frame_time);
+}
+
+std::vector<LayerRasterProfiler::LayerStats> LayerRasterProfiler::GetHotLayers(
+    size_t max_count) const {
+  std::vector<LayerStats> layers;
+  layers.reserve(entries_.size());
+  for (const auto& [id, entry] : entries_) {
+    layers.push_back(entry.stats);
+  }
+  const auto hotter = [](const LayerStats& a, const LayerStats& b) {
+    return a.GetTotalTime() > b.GetTotalTime();
+  };
+  if (layers.size() > max_count) {
+    std::partial_sort(layers.begin(), layers.begin() + max_count, layers.end(),
+                      hotter);
+    layers.resize(max_count);
+  } else {
+    std::sort(layers.begin(), layers.end(), hotter);
+  }
+  return layers;
+}
+
+void LayerRasterProfiler::Reset() {
+  FML_DCHECK(active_layers_.empty());
+  entries_.clear();
+  sampled_frame_count_ = 0u;
+}
+
+void LayerRasterProfiler::DropLeastRecentlySampledLayers() {
+  std::vector<size_t> last_sampled_frames;
+  last_sampled_frames.reserve(entries_.size());
+  for (const auto& [id, entry] : entries_) {
+    last_sampled_frames.push_back(entry.last_sampled_frame);
+  }
+  // Keep the layers sampled at or after the frame the kMaxTrackedLayers-th
+  // most recently sampled layer was last sampled in.
+  auto cutoff = last_sampled_frames.end() - kMaxTrackedLayers;
+  std::nth_element(last_sampled_frames.begin(), cutoff,
+                   last_sampled_frames.end());
+  const size_t oldest_kept_frame = *cutoff;
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->second.last_sampled_frame < oldest_kept_frame) {
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+}  // namespace flutter
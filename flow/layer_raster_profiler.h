@@ -0,0 +1,139 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYER_RASTER_PROFILER_H_
+#define FLUTTER_FLOW_LAYER_RASTER_PROFILER_H_
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+/// Samples the time spent in the preroll and paint of each layer, identified
+/// by its unique id, every Nth frame.
+///
+/// Unlike the `LayerSnapshotStore`, no images are captured, so the profiler is
+/// cheap enough to stay enabled in profile builds. The times are self times:
+/// the time spent in the children of a layer is attributed to the children.
+/// Paint times measure recording the layer into the frame's canvas and
+/// preparing its raster cache entries, not the GPU work for it.
+///
+/// This class is not thread-safe, it is used on the raster thread.
+class LayerRasterProfiler {
+ public:
+  /// The number of frames between sampled frames by default.
+  static constexpr size_t kDefaultSamplingInterval = 60u;
+
+  /// The most layers whose statistics are retained. The layers that were
+  /// sampled least recently are dropped first.
+  static constexpr size_t kMaxTrackedLayers = 512u;
+
+  enum class Phase {
+    kPreroll,
+    kPaint,
+  };
+
+  struct LayerStats {
+    uint64_t layer_unique_id = 0u;
+    /// The number of frames in which the layer was sampled.
+    size_t sample_count = 0u;
+    fml::TimeDelta preroll_time;
+    fml::TimeDelta paint_time;
+    /// The longest preroll and paint time of the layer in a single frame.
+    fml::TimeDelta max_frame_time;
+
+    fml::TimeDelta GetTotalTime() const { return preroll_time + paint_time; }
+  };
+
+  /// Measures the preroll or paint of a layer for the lifetime of this object
+  /// if a profiler is given, which should only be the case in sampled frames.
+  class ScopedLayer {
+   public:
+    ScopedLayer(LayerRasterProfiler* profiler,
+                uint64_t layer_unique_id,
+                Phase phase)
+        : profiler_(profiler), phase_(phase) {
+      if (profiler_) {
+        profiler_->BeginLayer(layer_unique_id);
+      }
+    }
+
+    ~ScopedLayer() {
+      if (profiler_) {
+        profiler_->EndLayer(phase_);
+      }
+    }
+
+   private:
+    LayerRasterProfiler* const profiler_;
+    const Phase phase_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(ScopedLayer);
+  };
+
+  explicit LayerRasterProfiler(
+      size_t sampling_interval = kDefaultSamplingInterval);
+
+  ~LayerRasterProfiler();
+
+  /// Sets the number of frames between sampled frames. Zero disables
+  /// sampling.
+  void SetSamplingInterval(size_t sampling_interval);
+
+  size_t GetSamplingInterval() const { return sampling_interval_; }
+
+  /// Called at the start of every frame. Returns whether the frame is
+  /// sampled.
+  bool BeginFrame();
+
+  /// Whether the current frame is sampled.
+  bool IsSamplingFrame() const { return sampling_frame_; }
+
+  /// The number of frames sampled since the profiler was created or reset.
+  size_t GetSampledFrameCount() const { return sampled_frame_count_; }
+
+  void BeginLayer(uint64_t layer_unique_id);
+
+  void EndLayer(Phase phase);
+
+  /// Returns the statistics of up to `max_count` layers, in descending order
+  /// of their total time.
+  std::vector<LayerStats> GetHotLayers(size_t max_count) const;
+
+  /// Discards the statistics of all layers.
+  void Reset();
+
+ private:
+  struct Entry {
+    LayerStats stats;
+    size_t last_sampled_frame = 0u;
+    fml::TimeDelta frame_time;
+  };
+
+  struct ActiveLayer {
+    uint64_t layer_unique_id;
+    fml::TimePoint start;
+    fml::TimeDelta children_time;
+  };
+
+  size_t sampling_interval_;
+  size_t frame_count_ = 0u;
+  size_t sampled_frame_count_ = 0u;
+  bool sampling_frame_ = false;
+  std::vector<ActiveLayer> active_layers_;
+  std::unordered_map<uint64_t, Entry> entries_;
+
+  void DropLeastRecentlySampledLayers();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(LayerRasterProfiler);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYER_RASTER_PROFILER_H_
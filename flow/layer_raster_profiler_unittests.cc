@@ -0,0 +1,104 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layer_raster_profiler.h"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+using Phase = LayerRasterProfiler::Phase;
+
+TEST(LayerRasterProfilerTest, SamplesEveryNthFrame) {
+  LayerRasterProfiler profiler(3u);
+  std::vector<bool> sampled;
+  for (int i = 0; i < 6; i++) {
+    sampled.push_back(profiler.BeginFrame());
+    EXPECT_EQ(profiler.IsSamplingFrame(), sampled.back());
+  }
+  EXPECT_EQ(sampled,
+            std::vector<bool>({false, false, true, false, false, true}));
+  EXPECT_EQ(profiler.GetSampledFrameCount(), 2u);
+
+  profiler.SetSamplingInterval(0u);
+  for (int i = 0; i < 6; i++) {
+    EXPECT_FALSE(profiler.BeginFrame());
+  }
+}
+
+TEST(LayerRasterProfilerTest, AttributesSelfTimeToLayers) {
+  LayerRasterProfiler profiler(1u);
+  ASSERT_TRUE(profiler.BeginFrame());
+  {
+    LayerRasterProfiler::ScopedLayer parent(&profiler, 1u, Phase::kPaint);
+    {
+      LayerRasterProfiler::ScopedLayer child(&profiler, 2u, Phase::kPaint);
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+  }
+  {
+    LayerRasterProfiler::ScopedLayer child(&profiler, 2u, Phase::kPreroll);
+  }
+
+  auto layers = profiler.GetHotLayers(10u);
+  ASSERT_EQ(layers.size(), 2u);
+  // The time spent in the child isn't attributed to the parent.
+  EXPECT_EQ(layers[0].layer_unique_id, 2u);
+  EXPECT_GE(layers[0].paint_time.ToMilliseconds(), 20);
+  EXPECT_EQ(layers[0].sample_count, 1u);
+  EXPECT_EQ(layers[0].max_frame_time, layers[0].GetTotalTime());
+  EXPECT_EQ(layers[1].layer_unique_id, 1u);
+  EXPECT_LT(layers[1].paint_time, layers[0].paint_time);
+
+  EXPECT_EQ(profiler.GetHotLayers(1u).size(), 1u);
+
+  profiler.Reset();
+  EXPECT_TRUE(profiler.GetHotLayers(10u).empty());
+  EXPECT_EQ(profiler.GetSampledFrameCount(), 0u);
+}
+
+TEST(LayerRasterProfilerTest, CountsSamplesPerFrame) {
+  LayerRasterProfiler profiler(1u);
+  for (int i = 0; i < 3; i++) {
+    ASSERT_TRUE(profiler.BeginFrame());
+    {
+      LayerRasterProfiler::ScopedLayer layer(&profiler, 1u, Phase::kPreroll);
+    }
+    { LayerRasterProfiler::ScopedLayer layer(&profiler, 1u, Phase::kPaint); }
+  }
+  auto layers = profiler.GetHotLayers(10u);
+  ASSERT_EQ(layers.size(), 1u);
+  EXPECT_EQ(layers[0].sample_count, 3u);
+}
+
+TEST(LayerRasterProfilerTest, NullProfilerIsIgnored) {
+  LayerRasterProfiler::ScopedLayer layer(nullptr, 1u, Phase::kPaint);
+}
+
+TEST(LayerRasterProfilerTest, DropsLeastRecentlySampledLayers) {
+  LayerRasterProfiler profiler(1u);
+  const uint64_t layer_count = LayerRasterProfiler::kMaxTrackedLayers + 10u;
+  ASSERT_TRUE(profiler.BeginFrame());
+  for (uint64_t id = 1; id <= 10u; id++) {
+    LayerRasterProfiler::ScopedLayer layer(&profiler, id, Phase::kPaint);
+  }
+  ASSERT_TRUE(profiler.BeginFrame());
+  for (uint64_t id = 11; id <= layer_count; id++) {
+    LayerRasterProfiler::ScopedLayer layer(&profiler, id, Phase::kPaint);
+  }
+  ASSERT_EQ(profiler.GetHotLayers(layer_count).size(), layer_count);
+
+  ASSERT_TRUE(profiler.BeginFrame());
+  auto layers = profiler.GetHotLayers(layer_count);
+  ASSERT_EQ(layers.size(), LayerRasterProfiler::kMaxTrackedLayers);
+  for (const auto& stats : layers) {
+    EXPECT_GT(stats.layer_unique_id, 10u);
+  }
+}
+
+}  // namespace testing
+}  // namespace flutter
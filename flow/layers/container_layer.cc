@@ -6,6 +6,9 @@
 
 #include <optional>
 
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/fml/trace_event.h"
+
 namespace flutter {
 
 ContainerLayer::ContainerLayer() : child_paint_bounds_(SkRect::MakeEmpty()) {}
@@ -66,16 +69,17 @@ void ContainerLayer::DiffChildren(DiffContext* context,
 
   // old layers that don't match
   for (int i = old_children_top; i <= old_children_bottom; ++i) {
-    auto layer = prev_layers[i];
-    context->AddDamage(context->GetOldLayerPaintRegion(layer.get()));
+    context->AddDamage(context->GetOldLayerPaintRegion(prev_layers[i].get()));
   }
 
   for (int i = 0; i < static_cast<int>(layers_.size()); ++i) {
     if (i < new_children_top || i > new_children_bottom) {
       int i_prev =
           i < new_children_top ? i : prev_layers.size() - (layers_.size() - i);
-      auto layer = layers_[i];
-      auto prev_layer = prev_layers[i_prev];
+      // References avoid a reference count round trip per child, which adds
+      // up for wide trees.
+      const auto& layer = layers_[i];
+      const auto& prev_layer = prev_layers[i_prev];
       auto paint_region = context->GetOldLayerPaintRegion(prev_layer.get());
       if (layer == prev_layer && !paint_region.has_readback() &&
           !paint_region.has_texture()) {
@@ -97,14 +101,14 @@ void ContainerLayer::DiffChildren(DiffContext* context,
     } else {
       DiffContext::AutoSubtreeRestore subtree(context);
       context->MarkSubtreeDirty();
-      auto layer = layers_[i];
-      layer->Diff(context, nullptr);
+      layers_[i]->Diff(context, nullptr);
     }
   }
 }
 
 void ContainerLayer::Add(std::shared_ptr<Layer> layer) {
   layers_.emplace_back(std::move(layer));
+  retained_children_ = nullptr;
 }
 
 void ContainerLayer::Preroll(PrerollContext* context) {
@@ -136,6 +140,9 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
   bool child_has_platform_view = false;
   bool child_has_texture_layer = false;
   bool all_renderable_state_flags = LayerStateStack::kCallerCanApplyAnything;
+  size_t raster_cached_entry_count =
+      context->raster_cached_entries ? context->raster_cached_entries->size()
+                                     : 0u;
 
   for (auto& layer : layers_) {
     // Reset context->has_platform_view and context->has_texture_layer to false
@@ -148,7 +155,12 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
     // opt-in to applying state attributes during its |Preroll|
     context->renderable_state_flags = 0;
 
-    layer->Preroll(context);
+    {
+      LayerRasterProfiler::ScopedLayer profile(
+          context->layer_raster_profiler, layer->unique_id(),
+          LayerRasterProfiler::Phase::kPreroll);
+      layer->Preroll(context);
+    }
 
     all_renderable_state_flags &= context->renderable_state_flags;
     if (safe_intersection_test(child_paint_bounds, layer->paint_bounds())) {
@@ -165,6 +177,13 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
         child_has_texture_layer || context->has_texture_layer;
   }
 
+  bool child_has_raster_cache_item =
+      context->raster_cached_entries &&
+      context->raster_cached_entries->size() > raster_cached_entry_count;
+  children_can_be_retained_ = !child_has_platform_view &&
+                              !child_has_texture_layer &&
+                              !child_has_raster_cache_item;
+
   context->has_platform_view = child_has_platform_view;
   context->has_texture_layer = child_has_texture_layer;
   context->renderable_state_flags = all_renderable_state_flags;
@@ -185,13 +204,87 @@ void ContainerLayer::PaintChildren(PaintContext& context) const {
   auto restore = context.state_stack.applyState(
       child_paint_bounds(), children_renderable_state_flags());
 
+  if (PaintRetainedChildren(context)) {
+    return;
+  }
+
   // Intentionally not tracing here as there should be no self-time
   // and the trace event on this common function has a small overhead.
   for (auto& layer : layers_) {
     if (layer->needs_painting(context)) {
+      LayerRasterProfiler::ScopedLayer profile(
+          context.layer_raster_profiler, layer->unique_id(),
+          LayerRasterProfiler::Phase::kPaint);
       layer->Paint(context);
     }
   }
 }
 
+bool ContainerLayer::CanPaintRetainedChildren(
+    const PaintContext& context) const {
+  return context.retain_unchanged_subtrees && children_can_be_retained_ &&
+         !context.enable_leaf_layer_tracing &&
+         !context.state_stack.checkerboard_func() && !layers_.empty();
+}
+
+sk_sp<DisplayList> ContainerLayer::RecordChildren(
+    const PaintContext& context) const {
+  DisplayListBuilder builder(child_paint_bounds(), true);
+  // The recording is made without the clip of the current frame so that it
+  // can be replayed however the subtree ends up being culled in later frames.
+  LayerStateStack state_stack;
+  state_stack.set_delegate(&builder);
+  PaintContext recording_context = {
+      // clang-format off
+      .state_stack                   = state_stack,
+      .canvas                        = &builder,
+      .gr_context                    = context.gr_context,
+      .dst_color_space               = context.dst_color_space,
+      .view_embedder                 = context.view_embedder,
+      .raster_time                   = context.raster_time,
+      .ui_time                       = context.ui_time,
+      .texture_registry              = context.texture_registry,
+      .raster_cache                  = nullptr,
+      .impeller_enabled              = context.impeller_enabled,
+      .aiks_context                  = context.aiks_context,
+      // clang-format on
+  };
+  for (auto& layer : layers_) {
+    if (layer->needs_painting(recording_context)) {
+      layer->Paint(recording_context);
+    }
+  }
+  return builder.Build();
+}
+
+bool ContainerLayer::PaintRetainedChildren(PaintContext& context) const {
+  if (!CanPaintRetainedChildren(context)) {
+    return false;
+  }
+  // A layer is immutable once its tree has been built, so a layer painted in
+  // more than one frame is part of a retained subtree whose children paint
+  // the same content every time.
+  if (!painted_children_) {
+    painted_children_ = true;
+    return false;
+  }
+  if (!retained_children_) {
+    TRACE_EVENT0("flutter", "ContainerLayer::RecordChildren");
+    retained_children_ = RecordChildren(context);
+  }
+  // Attributes the children were meant to apply themselves have to be
+  // applied to the recording as a whole instead.
+  const auto& state_stack = context.state_stack;
+  if (state_stack.outstanding_color_filter() ||
+      state_stack.outstanding_image_filter()) {
+    return false;
+  }
+  SkScalar opacity = state_stack.outstanding_opacity();
+  if (opacity < SK_Scalar1 && !retained_children_->can_apply_group_opacity()) {
+    return false;
+  }
+  context.canvas->DrawDisplayList(retained_children_, opacity);
+  return true;
+}
+
 }  // namespace flutter
@@ -52,6 +52,19 @@ class ContainerLayer : public Layer {
   SkRect child_paint_bounds_;
   int children_renderable_state_flags_ = 0;
 
+  // Whether the children can be painted from |retained_children_|. Children
+  // whose output changes from frame to frame without the layer tree changing,
+  // such as textures, platform views, or raster cached layers, can't be.
+  bool children_can_be_retained_ = false;
+  mutable bool painted_children_ = false;
+  mutable sk_sp<DisplayList> retained_children_;
+
+  bool CanPaintRetainedChildren(const PaintContext& context) const;
+
+  sk_sp<DisplayList> RecordChildren(const PaintContext& context) const;
+
+  bool PaintRetainedChildren(PaintContext& context) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(ContainerLayer);
 };
 
@@ -169,6 +169,70 @@ TEST_F(ContainerLayerTest, Multiple) {
   EXPECT_TRUE(DisplayListsEQ_Verbose(display_list(), expected_builder.Build()));
 }
 
+TEST_F(ContainerLayerTest, RetainedChildrenAreReplayed) {
+  SkPath child_path1;
+  child_path1.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  SkPath child_path2;
+  child_path2.addRect(21.0f, 6.0f, 25.5f, 21.5f);
+  DlPaint child_paint1 = DlPaint(DlColor::kGray());
+  DlPaint child_paint2 = DlPaint(DlColor::kGreen());
+
+  auto mock_layer1 = std::make_shared<MockLayer>(child_path1, child_paint1);
+  auto mock_layer2 = std::make_shared<MockLayer>(child_path2, child_paint2);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer1);
+  layer->Add(mock_layer2);
+
+  layer->Preroll(preroll_context());
+  display_list_paint_context().retain_unchanged_subtrees = true;
+
+  DisplayListBuilder expected_children(layer->child_paint_bounds(), true);
+  expected_children.DrawPath(child_path1, child_paint1);
+  expected_children.DrawPath(child_path2, child_paint2);
+  auto children = expected_children.Build();
+
+  // The first time the layer is seen its children are painted directly.
+  layer->Paint(display_list_paint_context());
+  DisplayListBuilder expected_builder;
+  expected_builder.DrawPath(child_path1, child_paint1);
+  expected_builder.DrawPath(child_path2, child_paint2);
+  EXPECT_TRUE(DisplayListsEQ_Verbose(display_list(), expected_builder.Build()));
+
+  // After that they are recorded once and replayed.
+  for (int i = 0; i < 2; i++) {
+    reset_display_list();
+    layer->Preroll(preroll_context());
+    layer->Paint(display_list_paint_context());
+    DisplayListBuilder expected_replay;
+    expected_replay.DrawDisplayList(children);
+    EXPECT_TRUE(
+        DisplayListsEQ_Verbose(display_list(), expected_replay.Build()));
+  }
+}
+
+TEST_F(ContainerLayerTest, ChildrenWithTexturesAreNotRetained) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  DlPaint child_paint = DlPaint(DlColor::kGreen());
+
+  auto mock_layer = std::make_shared<MockLayer>(child_path, child_paint);
+  mock_layer->set_fake_has_texture_layer(true);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer);
+
+  display_list_paint_context().retain_unchanged_subtrees = true;
+  for (int i = 0; i < 3; i++) {
+    reset_display_list();
+    preroll_context()->has_texture_layer = false;
+    layer->Preroll(preroll_context());
+    layer->Paint(display_list_paint_context());
+    DisplayListBuilder expected_builder;
+    expected_builder.DrawPath(child_path, child_paint);
+    EXPECT_TRUE(
+        DisplayListsEQ_Verbose(display_list(), expected_builder.Build()));
+  }
+}
+
 TEST_F(ContainerLayerTest, MultipleWithEmpty) {
   SkPath child_path1;
   child_path1.addRect(5.0f, 6.0f, 20.5f, 21.5f);
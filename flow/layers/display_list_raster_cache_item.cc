@@ -46,6 +46,19 @@ static bool IsDisplayListWorthRasterizing(
   return complexity_calculator->ShouldBeCached(complexity_score);
 }
 
+static const auto* flow_type = "RasterCacheFlow::DisplayList";
+
+static DisplayListComplexityCalculator* GetComplexityCalculator(
+    const PrerollContext* context) {
+  if (context->complexity_calculator) {
+    return context->complexity_calculator;
+  }
+  GrDirectContext* gr_context = context->gr_context;
+  return gr_context ? DisplayListComplexityCalculator::GetForBackend(
+                          gr_context->backend())
+                    : DisplayListComplexityCalculator::GetForSoftware();
+}
+
 DisplayListRasterCacheItem::DisplayListRasterCacheItem(
     const sk_sp<DisplayList>& display_list,
     const SkPoint& offset,
@@ -71,10 +84,9 @@ std::unique_ptr<DisplayListRasterCacheItem> DisplayListRasterCacheItem::Make(
 void DisplayListRasterCacheItem::PrerollSetup(PrerollContext* context,
                                               const SkMatrix& matrix) {
   cache_state_ = CacheState::kNone;
+  draw_scaled_image_ = false;
   DisplayListComplexityCalculator* complexity_calculator =
-      context->gr_context ? DisplayListComplexityCalculator::GetForBackend(
-                                context->gr_context->backend())
-                          : DisplayListComplexityCalculator::GetForSoftware();
+      GetComplexityCalculator(context);
 
   if (!IsDisplayListWorthRasterizing(display_list(), will_change_, is_complex_,
                                      complexity_calculator)) {
@@ -108,6 +120,22 @@ void DisplayListRasterCacheItem::PrerollFinalize(PrerollContext* context,
   bool visible = !context->state_stack.content_culled(bounds);
   RasterCache::CacheInfo cache_info =
       raster_cache->MarkSeen(key_id_, matrix, visible);
+  if (visible && !cache_info.has_image &&
+      cache_info.accesses_since_visible == raster_cache->access_threshold()) {
+    // The display list will be cached on the next frame it is seen in. Start
+    // rasterizing it now so that frame doesn't have to.
+    RasterCache::Context r_context = {
+        // clang-format off
+        .gr_context         = context->gr_context,
+        .dst_color_space    = context->dst_color_space,
+        .matrix             = transformation_matrix_,
+        .logical_rect       = bounds,
+        .flow_type          = flow_type,
+        // clang-format on
+    };
+    raster_cache->PrerasterizeCacheEntry(key_id_, r_context, display_list_);
+  }
+  draw_scaled_image_ = cache_info.has_scaled_image;
   if (!visible ||
       cache_info.accesses_since_visible <= raster_cache->access_threshold()) {
     cache_state_ = kNone;
@@ -115,6 +143,11 @@ void DisplayListRasterCacheItem::PrerollFinalize(PrerollContext* context,
     if (cache_info.has_image) {
       context->renderable_state_flags |=
           LayerStateStack::kCallerCanApplyOpacity;
+    } else {
+      // Lets the cache weigh the cost of rasterizing this again against the
+      // memory the image uses when deciding what to evict.
+      raster_cost_ = GetComplexityCalculator(context)
+                         ->Compute(display_list_.get());
     }
     cache_state_ = kCurrent;
   }
@@ -132,15 +165,13 @@ bool DisplayListRasterCacheItem::Draw(const PaintContext& context,
   if (!context.raster_cache || !canvas) {
     return false;
   }
-  if (cache_state_ == CacheState::kCurrent) {
+  if (cache_state_ == CacheState::kCurrent || draw_scaled_image_) {
     return context.raster_cache->Draw(key_id_, *canvas, paint,
                                       context.rendering_above_platform_view);
   }
   return false;
 }
 
-static const auto* flow_type = "RasterCacheFlow::DisplayList";
-
 bool DisplayListRasterCacheItem::TryToPrepareRasterCache(
     const PaintContext& context,
     bool parent_cached) const {
@@ -171,6 +202,6 @@ bool DisplayListRasterCacheItem::TryToPrepareRasterCache(
       [display_list = display_list_](DlCanvas* canvas) {
         canvas->DrawDisplayList(display_list);
       },
-      display_list_->rtree());
+      display_list_->rtree(), raster_cost_);
 }
 }  // namespace flutter
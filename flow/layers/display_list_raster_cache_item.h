@@ -55,6 +55,12 @@ class DisplayListRasterCacheItem : public RasterCacheItem {
   SkPoint offset_;
   bool is_complex_;
   bool will_change_;
+  // The complexity score of the display list, computed when it is about to be
+  // rasterized into the cache.
+  unsigned int raster_cost_ = 0;
+  // Whether the display list is drawn from a cached image at a different
+  // scale while it isn't cached at the current one.
+  bool draw_scaled_image_ = false;
 };
 
 }  // namespace flutter
@@ -14,6 +14,7 @@
 #include "flutter/display_list/dl_canvas.h"
 #include "flutter/flow/diff_context.h"
 #include "flutter/flow/embedded_views.h"
+#include "flutter/flow/layer_raster_profiler.h"
 #include "flutter/flow/layer_snapshot_store.h"
 #include "flutter/flow/layers/layer_state_stack.h"
 #include "flutter/flow/raster_cache.h"
@@ -45,6 +46,7 @@ class DisplayListLayer;
 class PerformanceOverlayLayer;
 class TextureLayer;
 class RasterCacheItem;
+class DisplayListComplexityCalculator;
 
 static constexpr SkRect kGiantRect = SkRect::MakeLTRB(-1E9F, -1E9F, 1E9F, 1E9F);
 
@@ -84,6 +86,14 @@ struct PrerollContext {
   int renderable_state_flags = 0;
 
   std::vector<RasterCacheItem*>* raster_cached_entries;
+
+  // Estimates the cost of rasterizing display lists when deciding whether to
+  // cache them. When null, the calculator is chosen from the |gr_context|.
+  DisplayListComplexityCalculator* complexity_calculator = nullptr;
+
+  // The profiler that samples the preroll time of layers. Non-null only in
+  // frames that are sampled.
+  LayerRasterProfiler* layer_raster_profiler = nullptr;
 };
 
 struct PaintContext {
@@ -121,6 +131,14 @@ struct PaintContext {
   bool enable_leaf_layer_tracing = false;
   bool impeller_enabled = false;
   impeller::AiksContext* aiks_context;
+
+  // Whether container layers of unchanged subtrees may paint a recording of
+  // their children made in a previous frame.
+  bool retain_unchanged_subtrees = false;
+
+  // The profiler that samples the paint time of layers. Non-null only in
+  // frames that are sampled.
+  LayerRasterProfiler* layer_raster_profiler = nullptr;
 };
 
 // Represents a single composited layer. Created on the UI thread but then
@@ -4,6 +4,7 @@
 
 #include "flutter/flow/layers/layer_tree.h"
 
+#include "flutter/display_list/benchmarking/dl_complexity.h"
 #include "flutter/display_list/skia/dl_sk_canvas.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/frame_timings.h"
@@ -29,6 +30,28 @@ inline SkColorSpace* GetColorSpace(DlCanvas* canvas) {
   return canvas ? canvas->GetImageInfo().colorSpace() : nullptr;
 }
 
+inline LayerRasterProfiler* GetSamplingLayerRasterProfiler(
+    CompositorContext::ScopedFrame& frame) {
+  LayerRasterProfiler& profiler = frame.context().layer_raster_profiler();
+  return profiler.IsSamplingFrame() ? &profiler : nullptr;
+}
+
+// Returns the complexity calculator for the Impeller context of |frame|, or
+// nullptr if the frame is not rendered with Impeller.
+static DisplayListComplexityCalculator* GetImpellerComplexityCalculator(
+    CompositorContext::ScopedFrame& frame) {
+#if IMPELLER_SUPPORTS_RENDERING
+  if (frame.aiks_context()) {
+    return DisplayListComplexityCalculator::GetForImpeller(
+        frame.aiks_context()
+            ->GetContext()
+            ->GetCapabilities()
+            ->SupportsFramebufferFetch());
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+  return nullptr;
+}
+
 bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
                         bool ignore_raster_cache,
                         SkRect cull_rect) {
@@ -62,10 +85,17 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
       .texture_registry              = frame.context().texture_registry(),
       .impeller_enabled              = !frame.gr_context(),
       .raster_cached_entries         = &raster_cache_items_,
+      .complexity_calculator         = GetImpellerComplexityCalculator(frame),
+      .layer_raster_profiler         = GetSamplingLayerRasterProfiler(frame),
       // clang-format on
   };
 
-  root_layer_->Preroll(&context);
+  {
+    LayerRasterProfiler::ScopedLayer profile(
+        context.layer_raster_profiler, root_layer_->unique_id(),
+        LayerRasterProfiler::Phase::kPreroll);
+    root_layer_->Preroll(&context);
+  }
 
   return context.surface_needs_readback;
 }
@@ -142,6 +172,9 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
       .enable_leaf_layer_tracing     = enable_leaf_layer_tracing_,
       .impeller_enabled              = !!frame.aiks_context(),
       .aiks_context                  = frame.aiks_context(),
+      .retain_unchanged_subtrees     =
+          frame.context().retain_unchanged_subtrees(),
+      .layer_raster_profiler         = GetSamplingLayerRasterProfiler(frame),
       // clang-format on
   };
 
@@ -151,6 +184,9 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
   }
 
   if (root_layer_->needs_painting(context)) {
+    LayerRasterProfiler::ScopedLayer profile(
+        context.layer_raster_profiler, root_layer_->unique_id(),
+        LayerRasterProfiler::Phase::kPaint);
     root_layer_->Paint(context);
   }
 }
@@ -0,0 +1,131 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/flow/compositor_context.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/display_list_layer.h"
+#include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/layers/transform_layer.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr SkISize kFrameSize = SkISize::Make(1000, 1000);
+
+sk_sp<DisplayList> MakeLeafDisplayList() {
+  DisplayListBuilder builder;
+  builder.DrawRect(SkRect::MakeWH(20, 20), DlPaint(DlColor::kBlue()));
+  return builder.Build();
+}
+
+// Builds a tree of transform layers |depth| levels deep where every transform
+// layer has |fanout| children. The leaves are display list layers.
+//
+// If |old_layer| is provided, every layer of the new tree is a new instance
+// that replaces the corresponding layer of |old_layer|, which is what the
+// framework produces when every layer of the scene is rebuilt.
+std::shared_ptr<Layer> BuildSubtree(int depth,
+                                    int fanout,
+                                    const sk_sp<DisplayList>& display_list,
+                                    Layer* old_layer) {
+  if (depth == 0) {
+    auto leaf = std::make_shared<DisplayListLayer>(
+        SkPoint::Make(0, 0), display_list, false, false);
+    if (old_layer) {
+      leaf->AssignOldLayer(old_layer);
+    }
+    return leaf;
+  }
+  auto transform =
+      std::make_shared<TransformLayer>(SkMatrix::Translate(1.0f, 1.0f));
+  auto old_container = static_cast<ContainerLayer*>(old_layer);
+  for (int i = 0; i < fanout; i++) {
+    Layer* old_child =
+        old_container ? old_container->layers()[i].get() : nullptr;
+    transform->Add(BuildSubtree(depth - 1, fanout, display_list, old_child));
+  }
+  if (old_layer) {
+    transform->AssignOldLayer(old_layer);
+  }
+  return transform;
+}
+
+std::unique_ptr<LayerTree> BuildLayerTree(
+    int depth,
+    int fanout,
+    const sk_sp<DisplayList>& display_list,
+    const LayerTree* old_tree = nullptr) {
+  auto root = BuildSubtree(depth, fanout, display_list,
+                           old_tree ? old_tree->root_layer() : nullptr);
+  return std::make_unique<LayerTree>(LayerTree::Config{.root_layer = root},
+                                     kFrameSize);
+}
+
+}  // namespace
+
+static void BM_LayerTreePreroll(benchmark::State& state) {
+  auto depth = state.range(0);
+  auto fanout = state.range(1);
+  auto layer_tree = BuildLayerTree(depth, fanout, MakeLeafDisplayList());
+  CompositorContext compositor_context;
+  auto frame = compositor_context.AcquireFrame(
+      nullptr, nullptr, nullptr, SkMatrix::I(), false, true, nullptr, nullptr);
+  for ([[maybe_unused]] auto _ : state) {
+    layer_tree->Preroll(*frame);
+  }
+}
+
+static void BM_LayerTreeDiff(benchmark::State& state) {
+  auto depth = state.range(0);
+  auto fanout = state.range(1);
+  auto display_list = MakeLeafDisplayList();
+  auto old_tree = BuildLayerTree(depth, fanout, display_list);
+  auto layer_tree = BuildLayerTree(depth, fanout, display_list, old_tree.get());
+
+  // Record the paint regions of the old tree.
+  FrameDamage initial_damage;
+  initial_damage.ComputeClipRect(*old_tree, true, false);
+
+  for ([[maybe_unused]] auto _ : state) {
+    FrameDamage damage;
+    damage.SetPreviousLayerTree(old_tree.get());
+    damage.ComputeClipRect(*layer_tree, true, false);
+  }
+}
+
+// Deep trees: a single chain of layers.
+BENCHMARK(BM_LayerTreePreroll)
+    ->Args({100, 1})
+    ->Args({1000, 1})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_LayerTreeDiff)
+    ->Args({100, 1})
+    ->Args({1000, 1})
+    ->Unit(benchmark::kMicrosecond);
+
+// Wide trees: many siblings under the root.
+BENCHMARK(BM_LayerTreePreroll)
+    ->Args({1, 1000})
+    ->Args({1, 10000})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_LayerTreeDiff)
+    ->Args({1, 1000})
+    ->Args({1, 10000})
+    ->Unit(benchmark::kMicrosecond);
+
+// Bushy trees, such as the cells of a spreadsheet.
+BENCHMARK(BM_LayerTreePreroll)
+    ->Args({3, 10})
+    ->Args({4, 10})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_LayerTreeDiff)
+    ->Args({3, 10})
+    ->Args({4, 10})
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
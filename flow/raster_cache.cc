@@ -4,7 +4,10 @@
 
 #include "flutter/flow/raster_cache.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <mutex>
 #include <vector>
 
 #include "flutter/common/constants.h"
@@ -14,6 +17,7 @@
 #include "flutter/flow/paint_utils.h"
 #include "flutter/flow/raster_cache_util.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/metrics.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkColorSpace.h"
@@ -68,32 +72,61 @@ void RasterCacheResult::draw(DlCanvas& canvas,
   }
 }
 
-RasterCache::RasterCache(size_t access_threshold,
-                         size_t display_list_cache_limit_per_frame)
-    : access_threshold_(access_threshold),
-      display_list_cache_limit_per_frame_(display_list_cache_limit_per_frame),
-      checkerboard_images_(false) {}
+void RasterCacheResult::draw_scaled(DlCanvas& canvas,
+                                    const DlPaint* paint,
+                                    const SkMatrix& matrix) const {
+  DlAutoCanvasRestore auto_restore(&canvas, true);
 
-/// @note Procedure doesn't copy all closures.
-std::unique_ptr<RasterCacheResult> RasterCache::Rasterize(
-    const RasterCache::Context& context,
-    sk_sp<const DlRTree> rtree,
+  // The image was rasterized at an integral translation, which doesn't change
+  // where the content lies within the rounded out bounds of the image.
+  SkRect image_bounds =
+      RasterCacheUtil::GetRoundedOutDeviceBounds(logical_rect_, matrix);
+  SkRect src = RasterCacheUtil::GetDeviceBounds(logical_rect_, matrix)
+                   .makeOffset(-image_bounds.fLeft, -image_bounds.fTop);
+  SkRect dst = RasterCacheUtil::GetDeviceBounds(
+      logical_rect_,
+      RasterCacheUtil::GetIntegralTransCTM(canvas.GetTransform()));
+  canvas.TransformReset();
+  flow_.Step();
+  canvas.DrawImageRect(image_, src, dst, DlImageSampling::kLinear, paint);
+}
+
+struct RasterCache::PendingRasterization {
+  PendingRasterization(const SkRect& logical_rect,
+                       const char* flow_type,
+                       sk_sp<const DlRTree> rtree)
+      : logical_rect(logical_rect),
+        flow_type(flow_type),
+        rtree(std::move(rtree)) {}
+
+  const SkRect logical_rect;
+  const char* const flow_type;
+  const sk_sp<const DlRTree> rtree;
+
+  std::mutex mutex;
+  bool done = false;
+  sk_sp<DlImage> image;
+};
+
+static sk_sp<DlImage> RasterizeToImage(
+    GrDirectContext* gr_context,
+    sk_sp<SkColorSpace> dst_color_space,
+    const SkMatrix& ctm,
+    const SkRect& logical_rect,
     const std::function<void(DlCanvas*)>& draw_function,
-    const std::function<void(DlCanvas*, const SkRect& rect)>& draw_checkerboard)
-    const {
-  auto matrix = RasterCacheUtil::GetIntegralTransCTM(context.matrix);
+    const std::function<void(DlCanvas*, const SkRect& rect)>*
+        draw_checkerboard) {
+  auto matrix = RasterCacheUtil::GetIntegralTransCTM(ctm);
   SkRect dest_rect =
-      RasterCacheUtil::GetRoundedOutDeviceBounds(context.logical_rect, matrix);
+      RasterCacheUtil::GetRoundedOutDeviceBounds(logical_rect, matrix);
 
-  const SkImageInfo image_info =
-      SkImageInfo::MakeN32Premul(dest_rect.width(), dest_rect.height(),
-                                 sk_ref_sp(context.dst_color_space));
+  const SkImageInfo image_info = SkImageInfo::MakeN32Premul(
+      dest_rect.width(), dest_rect.height(), std::move(dst_color_space));
 
   sk_sp<SkSurface> surface =
-      context.gr_context
-          ? SkSurfaces::RenderTarget(context.gr_context, skgpu::Budgeted::kYes,
-                                     image_info)
-          : SkSurfaces::Raster(image_info);
+      gr_context ? SkSurfaces::RenderTarget(gr_context, skgpu::Budgeted::kYes,
+                                            image_info)
+                 : SkSurfaces::Raster(image_info);
 
   if (!surface) {
     return nullptr;
@@ -106,11 +139,35 @@ std::unique_ptr<RasterCacheResult> RasterCache::Rasterize(
   canvas.Transform(matrix);
   draw_function(&canvas);
 
-  if (checkerboard_images_) {
-    draw_checkerboard(&canvas, context.logical_rect);
+  if (draw_checkerboard) {
+    (*draw_checkerboard)(&canvas, logical_rect);
   }
 
-  auto image = DlImage::Make(surface->makeImageSnapshot());
+  return DlImage::Make(surface->makeImageSnapshot());
+}
+
+RasterCache::RasterCache(size_t access_threshold,
+                         size_t display_list_cache_limit_per_frame,
+                         size_t retained_bytes_limit)
+    : access_threshold_(access_threshold),
+      display_list_cache_limit_per_frame_(display_list_cache_limit_per_frame),
+      retained_bytes_limit_(retained_bytes_limit),
+      checkerboard_images_(false) {}
+
+/// @note Procedure doesn't copy all closures.
+std::unique_ptr<RasterCacheResult> RasterCache::Rasterize(
+    const RasterCache::Context& context,
+    sk_sp<const DlRTree> rtree,
+    const std::function<void(DlCanvas*)>& draw_function,
+    const std::function<void(DlCanvas*, const SkRect& rect)>& draw_checkerboard)
+    const {
+  auto image = RasterizeToImage(
+      context.gr_context, sk_ref_sp(context.dst_color_space), context.matrix,
+      context.logical_rect, draw_function,
+      checkerboard_images_ ? &draw_checkerboard : nullptr);
+  if (!image) {
+    return nullptr;
+  }
   return std::make_unique<RasterCacheResult>(
       image, context.logical_rect, context.flow_type, std::move(rtree));
 }
@@ -119,14 +176,31 @@ bool RasterCache::UpdateCacheEntry(
     const RasterCacheKeyID& id,
     const Context& raster_cache_context,
     const std::function<void(DlCanvas*)>& render_function,
-    sk_sp<const DlRTree> rtree) const {
+    sk_sp<const DlRTree> rtree,
+    unsigned int raster_cost) const {
   RasterCacheKey key = RasterCacheKey(id, raster_cache_context.matrix);
   Entry& entry = cache_[key];
+  if (!entry.image && entry.pending) {
+    std::scoped_lock lock(entry.pending->mutex);
+    if (!entry.pending->done) {
+      // Still being rasterized, the caller draws the content itself for now.
+      return false;
+    }
+    if (entry.pending->image) {
+      entry.image = std::make_unique<RasterCacheResult>(
+          std::move(entry.pending->image), entry.pending->logical_rect,
+          entry.pending->flow_type, entry.pending->rtree);
+      entry.raster_cost = raster_cost;
+    }
+  }
+  // A failed prerasterization falls back to rasterizing here.
+  entry.pending.reset();
   if (!entry.image) {
     void (*func)(DlCanvas*, const SkRect& rect) = DrawCheckerboard;
     entry.image = Rasterize(raster_cache_context, std::move(rtree),
                             render_function, func);
     if (entry.image != nullptr) {
+      entry.raster_cost = raster_cost;
       switch (id.type()) {
         case RasterCacheKeyType::kDisplayList: {
           display_list_cached_this_frame_++;
@@ -141,6 +215,93 @@ bool RasterCache::UpdateCacheEntry(
   return entry.image != nullptr;
 }
 
+void RasterCache::SetPrerasterizeTaskRunner(
+    std::shared_ptr<fml::BasicTaskRunner> task_runner) {
+  prerasterize_task_runner_ = std::move(task_runner);
+}
+
+bool RasterCache::PrerasterizeCacheEntry(
+    const RasterCacheKeyID& id,
+    const Context& raster_cache_context,
+    const sk_sp<DisplayList>& display_list) const {
+  if (!prerasterize_task_runner_ || !display_list ||
+      !display_list->isUIThreadSafe()) {
+    return false;
+  }
+  RasterCacheKey key = RasterCacheKey(id, raster_cache_context.matrix);
+  Entry& entry = cache_[key];
+  if (entry.image || entry.pending) {
+    return false;
+  }
+  TRACE_EVENT0("flutter", "RasterCache::PrerasterizeCacheEntry");
+  auto pending = std::make_shared<PendingRasterization>(
+      raster_cache_context.logical_rect, raster_cache_context.flow_type,
+      display_list->rtree());
+  entry.pending = pending;
+  prerasterize_task_runner_->PostTask(
+      [pending, display_list,
+       color_space = sk_ref_sp(raster_cache_context.dst_color_space),
+       matrix = raster_cache_context.matrix,
+       checkerboard = checkerboard_images_]() {
+        TRACE_EVENT0("flutter", "RasterCache::Prerasterize");
+        const std::function<void(DlCanvas*, const SkRect& rect)>
+            draw_checkerboard = DrawCheckerboard;
+        auto image = RasterizeToImage(
+            nullptr, color_space, matrix, pending->logical_rect,
+            [&display_list](DlCanvas* canvas) {
+              canvas->DrawDisplayList(display_list);
+            },
+            checkerboard ? &draw_checkerboard : nullptr);
+        std::scoped_lock lock(pending->mutex);
+        pending->image = std::move(image);
+        pending->done = true;
+      });
+  return true;
+}
+
+void RasterCache::SetReuseScaledImages(bool reuse_scaled_images) {
+  reuse_scaled_images_ = reuse_scaled_images;
+}
+
+// Returns how far apart in scale the transforms are, or a negative value if
+// they differ in more than scale or by more than
+// |RasterCacheUtil::kMaxScaledReuseFactor|.
+static SkScalar GetScaleDistance(const SkMatrix& a, const SkMatrix& b) {
+  if (!a.isScaleTranslate() || !b.isScaleTranslate()) {
+    return -1;
+  }
+  SkScalar scale_x = b.getScaleX() / a.getScaleX();
+  SkScalar scale_y = b.getScaleY() / a.getScaleY();
+  const SkScalar max_factor = RasterCacheUtil::kMaxScaledReuseFactor;
+  if (!(scale_x >= 1 / max_factor && scale_x <= max_factor) ||
+      !(scale_y >= 1 / max_factor && scale_y <= max_factor)) {
+    return -1;
+  }
+  return std::max(std::abs(std::log(scale_x)), std::abs(std::log(scale_y)));
+}
+
+RasterCacheKey::Map<RasterCache::Entry>::value_type*
+RasterCache::FindScaledEntry(const RasterCacheKey& key) const {
+  if (key.id().type() != RasterCacheKeyType::kDisplayList) {
+    return nullptr;
+  }
+  // Keys only hash their id, so all entries of an id are in one bucket.
+  RasterCacheKey::Map<Entry>::value_type* closest = nullptr;
+  SkScalar closest_distance = 0;
+  size_t bucket = cache_.bucket(key);
+  for (auto it = cache_.begin(bucket); it != cache_.end(bucket); ++it) {
+    if (!it->second.image || it->first.id() != key.id()) {
+      continue;
+    }
+    SkScalar distance = GetScaleDistance(it->first.matrix(), key.matrix());
+    if (distance >= 0 && (!closest || distance < closest_distance)) {
+      closest = &*it;
+      closest_distance = distance;
+    }
+  }
+  return closest;
+}
+
 RasterCache::CacheInfo RasterCache::MarkSeen(const RasterCacheKeyID& id,
                                              const SkMatrix& matrix,
                                              bool visible) const {
@@ -148,10 +309,22 @@ RasterCache::CacheInfo RasterCache::MarkSeen(const RasterCacheKeyID& id,
   Entry& entry = cache_[key];
   entry.encountered_this_frame = true;
   entry.visible_this_frame = visible;
+  entry.frames_since_seen = 0;
   if (visible || entry.accesses_since_visible > 0) {
     entry.accesses_since_visible++;
   }
-  return {entry.accesses_since_visible, entry.image != nullptr};
+  bool has_scaled_image = false;
+  if (reuse_scaled_images_ && visible && !entry.image) {
+    auto* scaled = FindScaledEntry(key);
+    if (scaled) {
+      // Keeps the image of the scaled entry while it is drawn in its place.
+      scaled->second.encountered_this_frame = true;
+      scaled->second.frames_since_seen = 0;
+      has_scaled_image = true;
+    }
+  }
+  return {entry.accesses_since_visible, entry.image != nullptr,
+          has_scaled_image};
 }
 
 int RasterCache::GetAccessCount(const RasterCacheKeyID& id,
@@ -179,16 +352,29 @@ bool RasterCache::Draw(const RasterCacheKeyID& id,
                        bool preserve_rtree) const {
   auto it = cache_.find(RasterCacheKey(id, canvas.GetTransform()));
   if (it == cache_.end()) {
+    FML_COUNTER_INCREMENT("flutter.raster_cache.misses");
     return false;
   }
 
   Entry& entry = it->second;
 
   if (entry.image) {
+    FML_COUNTER_INCREMENT("flutter.raster_cache.hits");
     entry.image->draw(canvas, paint, preserve_rtree);
     return true;
   }
 
+  // Drawing a scaled image in one piece would clobber the R-Tree.
+  if (reuse_scaled_images_ && !preserve_rtree) {
+    auto* scaled = FindScaledEntry(it->first);
+    if (scaled) {
+      FML_COUNTER_INCREMENT("flutter.raster_cache.scaled_hits");
+      scaled->second.image->draw_scaled(canvas, paint, scaled->first.matrix());
+      return true;
+    }
+  }
+
+  FML_COUNTER_INCREMENT("flutter.raster_cache.misses");
   return false;
 }
 
@@ -201,11 +387,15 @@ void RasterCache::BeginFrame() {
 void RasterCache::UpdateMetrics() {
   for (auto it = cache_.begin(); it != cache_.end(); ++it) {
     Entry& entry = it->second;
-    FML_DCHECK(entry.encountered_this_frame);
     if (entry.image) {
       RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
-      metrics.in_use_count++;
-      metrics.in_use_bytes += entry.image->image_bytes();
+      if (entry.encountered_this_frame) {
+        metrics.in_use_count++;
+        metrics.in_use_bytes += entry.image->image_bytes();
+      } else {
+        metrics.retained_count++;
+        metrics.retained_bytes += entry.image->image_bytes();
+      }
     }
     entry.encountered_this_frame = false;
   }
@@ -213,10 +403,42 @@ void RasterCache::UpdateMetrics() {
 
 void RasterCache::EvictUnusedCacheEntries() {
   std::vector<RasterCacheKey::Map<Entry>::iterator> dead;
+  std::vector<RasterCacheKey::Map<Entry>::iterator> retained;
+  size_t retained_bytes = 0;
 
   for (auto it = cache_.begin(); it != cache_.end(); ++it) {
     Entry& entry = it->second;
-    if (!entry.encountered_this_frame) {
+    if (entry.encountered_this_frame) {
+      continue;
+    }
+    entry.frames_since_seen++;
+    if (entry.image && entry.raster_cost > 0 &&
+        entry.frames_since_seen <= RasterCacheUtil::kMaxRetainedFrames) {
+      retained.push_back(it);
+      retained_bytes += entry.image->image_bytes();
+    } else {
+      dead.push_back(it);
+    }
+  }
+
+  if (retained_bytes > retained_bytes_limit_) {
+    // Prefer keeping the images that are the most expensive to rasterize again
+    // for the memory they use and that were used most recently.
+    auto priority = [](const Entry& entry) {
+      return entry.raster_cost /
+             (static_cast<double>(std::max<int64_t>(
+                  entry.image->image_bytes(), 1)) *
+              entry.frames_since_seen);
+    };
+    std::sort(retained.begin(), retained.end(),
+              [&priority](const auto& a, const auto& b) {
+                return priority(a->second) < priority(b->second);
+              });
+    for (auto it : retained) {
+      if (retained_bytes <= retained_bytes_limit_) {
+        break;
+      }
+      retained_bytes -= it->second.image->image_bytes();
       dead.push_back(it);
     }
   }
@@ -231,6 +453,16 @@ void RasterCache::EvictUnusedCacheEntries() {
   }
 }
 
+void RasterCache::EvictRetainedEntries() {
+  for (auto it = cache_.begin(); it != cache_.end();) {
+    if (it->second.frames_since_seen > 0) {
+      it = cache_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
 void RasterCache::EndFrame() {
   UpdateMetrics();
   TraceStatsToTimeline();
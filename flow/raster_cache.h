@@ -8,11 +8,13 @@
 #include <memory>
 #include <unordered_map>
 
+#include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_canvas.h"
 #include "flutter/flow/raster_cache_key.h"
 #include "flutter/flow/raster_cache_util.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkMatrix.h"
 #include "third_party/skia/include/core/SkRect.h"
@@ -37,6 +39,12 @@ class RasterCacheResult {
                     const DlPaint* paint,
                     bool preserve_rtree) const;
 
+  // Draws the image, which was rasterized with |matrix|, scaled to the device
+  // bounds of its content under the current transform of |canvas|.
+  virtual void draw_scaled(DlCanvas& canvas,
+                           const DlPaint* paint,
+                           const SkMatrix& matrix) const;
+
   virtual SkISize image_dimensions() const {
     return image_ ? image_->dimensions() : SkISize::Make(0, 0);
   };
@@ -78,15 +86,26 @@ struct RasterCacheMetrics {
    */
   size_t in_use_bytes = 0;
 
+  /**
+   * The number of cache entries with images kept in this frame despite not
+   * being used.
+   */
+  size_t retained_count = 0;
+
+  /**
+   * The size of all of the images kept in this frame despite not being used.
+   */
+  size_t retained_bytes = 0;
+
   /**
    * The total cache entries that had images during this frame.
    */
-  size_t total_count() const { return in_use_count; }
+  size_t total_count() const { return in_use_count + retained_count; }
 
   /**
    * The size of all of the cached images during this frame.
    */
-  size_t total_bytes() const { return in_use_bytes; }
+  size_t total_bytes() const { return in_use_bytes + retained_bytes; }
 };
 
 /**
@@ -104,7 +123,11 @@ struct RasterCacheMetrics {
  *         encountered by the current frame.
  * - Paint stage
  *   - RasterCache::EvictUnusedCacheEntries
- *       Evict cached images that are no longer used.
+ *       Evict cached images that are no longer used. Images of display lists
+ *       that weren't used this frame are kept for up to
+ *       `RasterCacheUtil::kMaxRetainedFrames` frames while they fit in the
+ *       retained bytes limit. When they don't, the images that are cheapest to
+ *       rasterize again for the memory they use are evicted first.
  *   - LayerTree::TryToPrepareRasterCache
  *       Create cache image for each cache entry if it does not exist.
  *   - LayerTree::Paint - for each layer in the tree:
@@ -112,6 +135,20 @@ struct RasterCacheMetrics {
  *       `RasterCache::Draw` will be used to draw those cache images.
  *   - RasterCache::EndFrame:
  *       Computes used counts and memory then reports cache metrics.
+ *
+ * If a prerasterize task runner is set, display lists that will cross the
+ * access threshold on the next frame are rasterized on that task runner
+ * during preroll instead of on the raster thread once they are needed. The
+ * result is swapped into the cache entry by the first
+ * `RasterCache::UpdateCacheEntry` that finds it completed. Until then the
+ * display list is drawn directly.
+ *
+ * If scaled images are reused, a display list whose entry at the current
+ * transform has no image yet is drawn by scaling the image of an entry with a
+ * transform that is only scaled differently, such as the image from before a
+ * zoom animation started. The entry at the current transform becomes cached
+ * as usual once the transform stops changing for long enough to cross the
+ * access threshold.
  */
 class RasterCache {
  public:
@@ -125,6 +162,9 @@ class RasterCache {
   struct CacheInfo {
     const size_t accesses_since_visible;
     const bool has_image;
+    // Whether the entry will be drawn from the image of an entry at a
+    // different scale, as it has no image itself.
+    const bool has_scaled_image = false;
   };
 
   std::unique_ptr<RasterCacheResult> Rasterize(
@@ -137,7 +177,9 @@ class RasterCache {
   explicit RasterCache(
       size_t access_threshold = 3,
       size_t picture_and_display_list_cache_limit_per_frame =
-          RasterCacheUtil::kDefaultPictureAndDisplayListCacheLimitPerFrame);
+          RasterCacheUtil::kDefaultPictureAndDisplayListCacheLimitPerFrame,
+      size_t retained_bytes_limit =
+          RasterCacheUtil::kDefaultRetainedBytesLimit);
 
   virtual ~RasterCache() = default;
 
@@ -162,6 +204,12 @@ class RasterCache {
 
   void EvictUnusedCacheEntries();
 
+  /**
+   * @brief Evict the images of all entries that were not used in the last
+   * frame. Used to respond to memory pressure.
+   */
+  void EvictRetainedEntries();
+
   void EndFrame();
 
   void Clear();
@@ -241,30 +289,84 @@ class RasterCache {
    */
   int GetAccessCount(const RasterCacheKeyID& id, const SkMatrix& matrix) const;
 
+  /**
+   * @brief Rasterize the entry if it doesn't have an image yet.
+   *
+   * @param raster_cost An estimate of the cost of rasterizing the entry, such
+   * as a `DisplayListComplexityCalculator` score. Only images of entries with a
+   * raster cost are kept while unused.
+   */
   bool UpdateCacheEntry(const RasterCacheKeyID& id,
                         const Context& raster_cache_context,
                         const std::function<void(DlCanvas*)>& render_function,
-                        sk_sp<const DlRTree> rtree = nullptr) const;
+                        sk_sp<const DlRTree> rtree = nullptr,
+                        unsigned int raster_cost = 0) const;
+
+  /**
+   * @brief Set the task runner display lists are rasterized on ahead of the
+   * frame they are needed in. Prerasterization is disabled if this is null,
+   * which is the default.
+   */
+  void SetPrerasterizeTaskRunner(
+      std::shared_ptr<fml::BasicTaskRunner> task_runner);
+
+  /**
+   * @brief Start rasterizing the display list of an entry on the prerasterize
+   * task runner.
+   *
+   * The rasterization uses a raster surface as GPU contexts cannot be used
+   * off of the raster thread. Display lists that are not UI thread safe
+   * reference texture backed images and are never prerasterized.
+   *
+   * @return true if a rasterization was started. False if prerasterization is
+   * disabled, the display list cannot be prerasterized, or the entry already
+   * has or is waiting for an image.
+   */
+  bool PrerasterizeCacheEntry(const RasterCacheKeyID& id,
+                              const Context& raster_cache_context,
+                              const sk_sp<DisplayList>& display_list) const;
+
+  /**
+   * @brief Set whether display lists without an image at the current
+   * transform are drawn from their image at a slightly different scale, up to
+   * `RasterCacheUtil::kMaxScaledReuseFactor`. Disabled by default.
+   */
+  void SetReuseScaledImages(bool reuse_scaled_images);
 
  private:
+  struct PendingRasterization;
+
   struct Entry {
     bool encountered_this_frame = false;
     bool visible_this_frame = false;
     size_t accesses_since_visible = 0;
+    size_t frames_since_seen = 0;
+    unsigned int raster_cost = 0;
     std::unique_ptr<RasterCacheResult> image;
+    std::shared_ptr<PendingRasterization> pending;
   };
 
   void UpdateMetrics();
 
+  // Returns the display list entry with an image that has the id of |key| and
+  // a transform that differs from that of |key| in scale only, by no more
+  // than `RasterCacheUtil::kMaxScaledReuseFactor`, or null. The entry closest
+  // in scale is returned when there are several.
+  RasterCacheKey::Map<Entry>::value_type* FindScaledEntry(
+      const RasterCacheKey& key) const;
+
   RasterCacheMetrics& GetMetricsForKind(RasterCacheKeyKind kind);
 
   const size_t access_threshold_;
   const size_t display_list_cache_limit_per_frame_;
+  const size_t retained_bytes_limit_;
   mutable size_t display_list_cached_this_frame_ = 0;
   RasterCacheMetrics layer_metrics_;
   RasterCacheMetrics picture_metrics_;
   mutable RasterCacheKey::Map<Entry> cache_;
   bool checkerboard_images_;
+  std::shared_ptr<fml::BasicTaskRunner> prerasterize_task_runner_;
+  bool reuse_scaled_images_ = false;
 
   void TraceStatsToTimeline() const;
 
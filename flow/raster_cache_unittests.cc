@@ -26,6 +26,29 @@
 namespace flutter {
 namespace testing {
 
+namespace {
+
+// Holds on to posted tasks until they are explicitly run.
+class ManualTaskRunner : public fml::BasicTaskRunner {
+ public:
+  void PostTask(const fml::closure& task) override { tasks_.push_back(task); }
+
+  size_t GetPendingTaskCount() const { return tasks_.size(); }
+
+  void RunPendingTasks() {
+    auto tasks = std::move(tasks_);
+    tasks_.clear();
+    for (const auto& task : tasks) {
+      task();
+    }
+  }
+
+ private:
+  std::vector<fml::closure> tasks_;
+};
+
+}  // namespace
+
 TEST(RasterCache, SimpleInitialization) {
   flutter::RasterCache cache;
   ASSERT_TRUE(true);
@@ -143,6 +166,147 @@ TEST(RasterCache, ThresholdIsRespectedForDisplayList) {
   ASSERT_TRUE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
 }
 
+TEST(RasterCache, PrerasterizesDisplayListBeforeThresholdIsReached) {
+  size_t threshold = 2;
+  flutter::RasterCache cache(threshold);
+  auto task_runner = std::make_shared<ManualTaskRunner>();
+  cache.SetPrerasterizeTaskRunner(task_runner);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list = GetSampleDisplayList();
+  ASSERT_TRUE(display_list->isUIThreadSafe());
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  cache.BeginFrame();
+
+  DisplayListRasterCacheItem display_list_item(display_list, SkPoint(), true,
+                                               false);
+
+  // 1st access.
+  ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+  ASSERT_EQ(task_runner->GetPendingTaskCount(), 0u);
+
+  cache.EndFrame();
+  cache.BeginFrame();
+
+  // 2nd access. The next access crosses the threshold so the display list is
+  // rasterized ahead of it.
+  ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+  ASSERT_EQ(task_runner->GetPendingTaskCount(), 1u);
+
+  cache.EndFrame();
+  cache.BeginFrame();
+
+  // 3rd access. The rasterization hasn't finished so the display list is
+  // drawn directly instead of being rasterized on this thread.
+  ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+  ASSERT_FALSE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+  ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 1u);
+
+  cache.EndFrame();
+  task_runner->RunPendingTasks();
+  cache.BeginFrame();
+
+  // 4th access. The finished rasterization is swapped in.
+  ASSERT_TRUE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+  ASSERT_TRUE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+  ASSERT_EQ(task_runner->GetPendingTaskCount(), 0u);
+
+  cache.EndFrame();
+  ASSERT_EQ(cache.picture_metrics().total_count(), 1u);
+}
+
+TEST(RasterCache, ReusesImagesAtSimilarScales) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetReuseScaledImages(true);
+
+  SkMatrix matrix = SkMatrix::I();
+  SkMatrix zoomed = SkMatrix::Scale(1.2, 1.2);
+  SkMatrix far_zoomed = SkMatrix::Scale(2, 2);
+
+  auto display_list = GetSampleDisplayList();
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item(display_list, SkPoint(), true,
+                                               false);
+
+  // Nothing is cached at any scale yet.
+  cache.BeginFrame();
+  dummy_canvas.SetTransform(zoomed);
+  ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, zoomed));
+  ASSERT_FALSE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+
+  dummy_canvas.SetTransform(matrix);
+  for (int i = 0; i < 2; i++) {
+    cache.BeginFrame();
+    RasterCacheItemPrerollAndTryToRasterCache(display_list_item,
+                                              preroll_context, paint_context,
+                                              matrix);
+    cache.EndFrame();
+  }
+  ASSERT_TRUE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+
+  // The zoomed entry has no image of its own yet, so the unzoomed image is
+  // drawn scaled up.
+  cache.BeginFrame();
+  dummy_canvas.SetTransform(zoomed);
+  ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, zoomed));
+  ASSERT_TRUE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+  cache.SetReuseScaledImages(false);
+  ASSERT_FALSE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+  cache.SetReuseScaledImages(true);
+  cache.EndFrame();
+
+  // Too far from the scale of any image.
+  cache.BeginFrame();
+  dummy_canvas.SetTransform(far_zoomed);
+  ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, far_zoomed));
+  ASSERT_FALSE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+}
+
 TEST(RasterCache, SetCheckboardCacheImages) {
   size_t threshold = 1;
   flutter::RasterCache cache(threshold);
@@ -261,7 +425,10 @@ TEST(RasterCache, PictureCacheLimitPerFrameIsRespectedWhenZeroForDisplayList) {
 
 TEST(RasterCache, EvictUnusedCacheEntries) {
   size_t threshold = 1;
-  flutter::RasterCache cache(threshold);
+  // Don't keep any images of unused entries.
+  flutter::RasterCache cache(
+      threshold,
+      RasterCacheUtil::kDefaultPictureAndDisplayListCacheLimitPerFrame, 0);
 
   SkMatrix matrix = SkMatrix::I();
 
@@ -359,6 +526,136 @@ TEST(RasterCache, EvictUnusedCacheEntries) {
   cache.EndFrame();
 }
 
+TEST(RasterCache, RetainsImagesOfBrieflyUnusedEntries) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list = GetSampleDisplayList();
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item(display_list, SkPoint(), true,
+                                               false);
+
+  for (int i = 0; i < 2; i++) {
+    cache.BeginFrame();
+    RasterCacheItemPrerollAndTryToRasterCache(
+        display_list_item, preroll_context, paint_context, matrix);
+    cache.EndFrame();
+  }
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+
+  // The entry isn't used in this frame but its image is kept.
+  cache.BeginFrame();
+  cache.EvictUnusedCacheEntries();
+  cache.EndFrame();
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+  ASSERT_EQ(cache.picture_metrics().in_use_count, 0u);
+  ASSERT_EQ(cache.picture_metrics().retained_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().total_bytes(), 25624u);
+
+  // It is drawn from the cache as soon as it is used again.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(cache.Draw(display_list_item.GetId().value(), dummy_canvas,
+                         &paint));
+  cache.EndFrame();
+  ASSERT_EQ(cache.picture_metrics().in_use_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().retained_count, 0u);
+
+  // Entries that go unused for too long are evicted.
+  for (size_t i = 0; i <= RasterCacheUtil::kMaxRetainedFrames; i++) {
+    ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+    cache.BeginFrame();
+    cache.EvictUnusedCacheEntries();
+    cache.EndFrame();
+  }
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 0u);
+  ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 0u);
+}
+
+TEST(RasterCache, EvictsCheapestRetainedImagesFirst) {
+  size_t threshold = 1;
+  // Only one of the images fits in the retained bytes limit.
+  flutter::RasterCache cache(
+      threshold,
+      RasterCacheUtil::kDefaultPictureAndDisplayListCacheLimitPerFrame,
+      25624u);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto cheap_display_list = GetSampleDisplayList();
+  DisplayListBuilder builder;
+  for (int i = 0; i < 20; i++) {
+    builder.DrawRect(SkRect::MakeXYWH(10, 10, 80, 80),
+                     DlPaint(DlColor::kRed()).setAlpha(128));
+  }
+  auto expensive_display_list = builder.Build();
+  ASSERT_EQ(cheap_display_list->bounds(), expensive_display_list->bounds());
+
+  MockCanvas dummy_canvas(1000, 1000);
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem cheap_item(cheap_display_list, SkPoint(), true,
+                                        false);
+  DisplayListRasterCacheItem expensive_item(expensive_display_list, SkPoint(),
+                                            true, false);
+
+  for (int i = 0; i < 2; i++) {
+    cache.BeginFrame();
+    RasterCacheItemPreroll(cheap_item, preroll_context, matrix);
+    RasterCacheItemPreroll(expensive_item, preroll_context, matrix);
+    cache.EvictUnusedCacheEntries();
+    RasterCacheItemTryToRasterCache(cheap_item, paint_context);
+    RasterCacheItemTryToRasterCache(expensive_item, paint_context);
+    cache.EndFrame();
+  }
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 51248u);
+
+  cache.BeginFrame();
+  cache.EvictUnusedCacheEntries();
+  cache.EndFrame();
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+  ASSERT_FALSE(cache.HasEntry(cheap_item.GetId().value(), matrix));
+  ASSERT_TRUE(cache.HasEntry(expensive_item.GetId().value(), matrix));
+
+  // Memory pressure evicts all of the unused images.
+  cache.EvictRetainedEntries();
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 0u);
+  ASSERT_FALSE(cache.HasEntry(expensive_item.GetId().value(), matrix));
+}
+
 TEST(RasterCache, ComputeDeviceRectBasedOnFractionalTranslation) {
   SkRect logical_rect = SkRect::MakeLTRB(0, 0, 300.2, 300.3);
   SkMatrix ctm = SkMatrix::MakeAll(2.0, 0, 0, 0, 2.0, 0, 0, 0, 1);
@@ -19,6 +19,20 @@ struct RasterCacheUtil {
   // the work across multiple frames.
   static constexpr int kDefaultPictureAndDisplayListCacheLimitPerFrame = 3;
 
+  // The default max number of bytes of cached images kept for entries that
+  // were not used in the current frame. Content that scrolls out of view and
+  // back again, such as carousel items, can then be drawn from the cache
+  // again instead of being rasterized again.
+  static constexpr size_t kDefaultRetainedBytesLimit = 32 * 1024 * 1024;
+
+  // The max number of consecutive frames an entry is kept for while unused.
+  static constexpr size_t kMaxRetainedFrames = 60;
+
+  // The largest factor by which the image of a display list is scaled up or
+  // down when it is drawn in place of an image of that display list at the
+  // current scale, while scaled images are reused.
+  static constexpr SkScalar kMaxScaledReuseFactor = 1.5f;
+
   // The ImageFilterLayer might cache the filtered output of this layer
   // if the layer remains stable (if it is not animating for instance).
   // If the ImageFilterLayer is not the same between rendered frames,
@@ -9,6 +9,7 @@
 #include <queue>
 
 #include "flutter/fml/memory/ref_counted.h"
+#include "flutter/fml/metrics.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/task_runner.h"
 #include "flutter/fml/trace_event.h"
@@ -21,11 +22,24 @@ namespace flutter {
 
 // A queue that holds Skia objects that must be destructed on the given task
 // runner.
+//
+// Objects are drained in chunks of at most |kMaxDrainCount| objects and
+// textures per task, so that releasing many objects at once, for example when
+// a large list of images is disposed, doesn't block the task runner for the
+// whole time. The other tasks of the task runner can run between the chunks.
+//
+// The number of objects and textures released is added to the
+// `flow.unref_queue.objects_drained` and `flow.unref_queue.textures_drained`
+// counters.
 template <class T>
 class UnrefQueue : public fml::RefCountedThreadSafe<UnrefQueue<T>> {
  public:
   using ResourceContext = T;
 
+  // The most objects, and separately textures, released by a single drain
+  // task.
+  static constexpr size_t kMaxDrainCount = 64u;
+
   void Unref(SkRefCnt* object) {
     if (drain_immediate_) {
       object->unref();
@@ -33,11 +47,7 @@ class UnrefQueue : public fml::RefCountedThreadSafe<UnrefQueue<T>> {
     }
     std::scoped_lock lock(mutex_);
     objects_.push_back(object);
-    if (!drain_pending_) {
-      drain_pending_ = true;
-      task_runner_->PostDelayedTask(
-          [strong = fml::Ref(this)]() { strong->Drain(); }, drain_delay_);
-    }
+    ScheduleDrainLocked();
   }
 
   void DeleteTexture(GrBackendTexture texture) {
@@ -45,18 +55,14 @@ class UnrefQueue : public fml::RefCountedThreadSafe<UnrefQueue<T>> {
     FML_DCHECK(!drain_immediate_);
     std::scoped_lock lock(mutex_);
     textures_.push_back(texture);
-    if (!drain_pending_) {
-      drain_pending_ = true;
-      task_runner_->PostDelayedTask(
-          [strong = fml::Ref(this)]() { strong->Drain(); }, drain_delay_);
-    }
+    ScheduleDrainLocked();
   }
 
-  // Usually, the drain is called automatically. However, during IO manager
+  // Usually, the queue is drained automatically. However, during IO manager
   // shutdown (when the platform side reference to the OpenGL context is about
-  // to go away), we may need to pre-emptively drain the unref queue. It is the
-  // responsibility of the caller to ensure that no further unrefs are queued
-  // after this call.
+  // to go away), we may need to pre-emptively drain the unref queue. This
+  // releases all queued objects at once. It is the responsibility of the caller
+  // to ensure that no further unrefs are queued after this call.
   void Drain() {
     TRACE_EVENT0("flutter", "SkiaUnrefQueue::Drain");
     std::deque<SkRefCnt*> skia_objects;
@@ -86,6 +92,47 @@ class UnrefQueue : public fml::RefCountedThreadSafe<UnrefQueue<T>> {
   // the queue altogether.
   bool drain_immediate_;
 
+  void ScheduleDrainLocked() {
+    if (!drain_pending_) {
+      drain_pending_ = true;
+      task_runner_->PostDelayedTask(
+          [strong = fml::Ref(this)]() { strong->DrainChunk(); }, drain_delay_);
+    }
+  }
+
+  // Releases up to |kMaxDrainCount| objects and textures, and posts a task to
+  // release the next chunk right away if any are left.
+  void DrainChunk() {
+    TRACE_EVENT0("flutter", "SkiaUnrefQueue::DrainChunk");
+    std::deque<SkRefCnt*> skia_objects;
+    std::deque<GrBackendTexture> textures;
+    {
+      std::scoped_lock lock(mutex_);
+      if (!drain_pending_) {
+        // Drained pre-emptively.
+        return;
+      }
+      MoveChunk(objects_, skia_objects);
+      MoveChunk(textures_, textures);
+      drain_pending_ = !objects_.empty() || !textures_.empty();
+      if (drain_pending_) {
+        task_runner_->PostTask(
+            [strong = fml::Ref(this)]() { strong->DrainChunk(); });
+      }
+    }
+    DoDrain(skia_objects, textures, context_);
+  }
+
+  template <class Item>
+  static void MoveChunk(std::deque<Item>& from, std::deque<Item>& to) {
+    if (from.size() <= kMaxDrainCount) {
+      from.swap(to);
+      return;
+    }
+    to.assign(from.begin(), from.begin() + kMaxDrainCount);
+    from.erase(from.begin(), from.begin() + kMaxDrainCount);
+  }
+
   // The `GrDirectContext* context` is only used for signaling Skia to
   // performDeferredCleanup. It can be nullptr when such signaling is not needed
   // (e.g., in unit tests).
@@ -117,6 +164,8 @@ class UnrefQueue : public fml::RefCountedThreadSafe<UnrefQueue<T>> {
   static void DoDrain(const std::deque<SkRefCnt*>& skia_objects,
                       const std::deque<GrBackendTexture>& textures,
                       sk_sp<ResourceContext> context) {
+    FML_COUNTER_ADD("flow.unref_queue.objects_drained", skia_objects.size());
+    FML_COUNTER_ADD("flow.unref_queue.textures_drained", textures.size());
     for (SkRefCnt* skia_object : skia_objects) {
       skia_object->unref();
     }
@@ -4,6 +4,7 @@
 
 #include "flutter/flow/skia_gpu_object.h"
 
+#include <atomic>
 #include <future>
 #include <utility>
 
@@ -97,6 +98,41 @@ TEST_F(SkiaGpuObjectTest, QueueSimple) {
   ASSERT_EQ(dtor_task_queue_id, unref_task_runner()->GetTaskQueueId());
 }
 
+TEST_F(SkiaGpuObjectTest, QueueDrainsInChunks) {
+  auto destroyed = std::make_shared<std::atomic<size_t>>(0u);
+  class CountedObject : public SkRefCnt {
+   public:
+    explicit CountedObject(std::shared_ptr<std::atomic<size_t>> destroyed)
+        : destroyed_(std::move(destroyed)) {}
+    ~CountedObject() override { (*destroyed_)++; }
+
+   private:
+    std::shared_ptr<std::atomic<size_t>> destroyed_;
+  };
+
+  const size_t count = SkiaUnrefQueue::kMaxDrainCount * 2 + 1;
+  std::promise<size_t> destroyed_after_first_chunk;
+  fml::AutoResetWaitableEvent latch;
+  unref_task_runner()->PostTask([&]() {
+    for (size_t i = 0; i < count; i++) {
+      unref_queue()->Unref(new CountedObject(destroyed));
+    }
+    // Runs after the first chunk was drained but before the next one.
+    unref_task_runner()->PostTask([&]() {
+      destroyed_after_first_chunk.set_value(destroyed->load());
+    });
+  });
+  ASSERT_EQ(destroyed_after_first_chunk.get_future().get(),
+            SkiaUnrefQueue::kMaxDrainCount);
+
+  // The remaining chunks are drained right after.
+  unref_task_runner()->PostTask([&]() { latch.Signal(); });
+  latch.Wait();
+  unref_task_runner()->PostTask([&]() { latch.Signal(); });
+  latch.Wait();
+  ASSERT_EQ(destroyed->load(), count);
+}
+
 TEST_F(SkiaGpuObjectTest, ObjectDestructor) {
   std::shared_ptr<fml::AutoResetWaitableEvent> latch =
       std::make_shared<fml::AutoResetWaitableEvent>();
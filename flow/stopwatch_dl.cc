@@ -19,7 +19,10 @@ static const size_t kMaxFrameMarkers = 8;
 
 void DlStopwatchVisualizer::Visualize(DlCanvas* canvas,
                                       const SkRect& rect) const {
-  auto painter = DlVertexPainter();
+  // The background, a bar per lap, the frame markers and the current frame
+  // marker.
+  auto painter =
+      DlVertexPainter(1u + stopwatch_.GetLapsCount() + kMaxFrameMarkers + 1u);
   DlPaint paint;
 
   // Establish the graph position.
@@ -45,6 +48,11 @@ void DlStopwatchVisualizer::Visualize(DlCanvas* canvas,
       auto const sample_unit_height =
           (1.0 - UnitHeight(stopwatch_.GetLap(i).ToMillisecondsF(),
                             max_unit_interval));
+      if (sample_unit_height >= 1.0) {
+        // Laps that took no time, such as those that weren't recorded yet,
+        // have no bar.
+        continue;
+      }
 
       auto const bar_width = width * sample_unit_width;
       auto const bar_height = height * sample_unit_height;
@@ -109,6 +117,11 @@ void DlStopwatchVisualizer::Visualize(DlCanvas* canvas,
   canvas->DrawVertices(painter.IntoVertices(), DlBlendMode::kSrcOver, paint);
 }
 
+DlVertexPainter::DlVertexPainter(size_t rect_count) {
+  vertices_.reserve(rect_count * 6u);
+  colors_.reserve(rect_count * 6u);
+}
+
 void DlVertexPainter::DrawRect(const SkRect& rect, const DlColor& color) {
   // Draw 6 vertices representing 2 triangles.
   auto const left = rect.x();
@@ -38,6 +38,10 @@ class DlStopwatchVisualizer : public StopwatchVisualizer {
 /// possible (i.e. not having to do triangle-math).
 class DlVertexPainter final {
  public:
+  /// Creates a painter with room for |rect_count| rectangles, so that the
+  /// buffer doesn't grow while the rectangles are drawn.
+  explicit DlVertexPainter(size_t rect_count = 0u);
+
   /// Draws a rectangle with the given color to a buffer.
   void DrawRect(const SkRect& rect, const DlColor& color);
 
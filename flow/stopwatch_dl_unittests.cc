@@ -3,11 +3,28 @@
 // found in the LICENSE file.
 
 #include "flutter/flow/stopwatch_dl.h"
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
 #include "gtest/gtest.h"
 
 namespace flutter {
 namespace testing {
 
+class VertexCounter : public virtual DlOpReceiver,
+                      public IgnoreAttributeDispatchHelper,
+                      public IgnoreClipDispatchHelper,
+                      public IgnoreTransformDispatchHelper,
+                      public IgnoreDrawDispatchHelper {
+ public:
+  void drawVertices(const DlVertices* vertices, DlBlendMode mode) override {
+    draw_count++;
+    vertex_count += vertices->vertex_count();
+  }
+
+  int draw_count = 0;
+  int vertex_count = 0;
+};
+
 static SkRect MakeRectFromVertices(SkPoint vertices[6]) {
   // "Combine" the vertices to form a rectangle.
   auto const left = std::min(vertices[0].x(), vertices[5].x());
@@ -69,5 +86,26 @@ TEST(DlVertexPainter, DrawRectIntoVertices) {
   EXPECT_EQ(colors[11], DlColor::kBlue());
 }
 
+TEST(DlStopwatchVisualizer, SkipsBarsOfEmptyLaps) {
+  FixedRefreshRateStopwatch stopwatch;
+  DlStopwatchVisualizer visualizer(stopwatch);
+  auto const rect = SkRect::MakeWH(120, 100);
+
+  auto count_vertices = [&]() {
+    DisplayListBuilder builder;
+    visualizer.Visualize(&builder, rect);
+    VertexCounter counter;
+    builder.Build()->Dispatch(counter);
+    EXPECT_EQ(counter.draw_count, 1);
+    return counter.vertex_count;
+  };
+
+  auto const empty_vertex_count = count_vertices();
+  stopwatch.SetLapTime(fml::TimeDelta::FromMilliseconds(8));
+  stopwatch.SetLapTime(fml::TimeDelta::FromMilliseconds(12));
+  // A bar is drawn for each of the two laps that were recorded.
+  EXPECT_EQ(count_vertices(), empty_vertex_count + 2 * 6);
+}
+
 }  // namespace testing
 }  // namespace flutter
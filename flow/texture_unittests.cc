@@ -97,6 +97,26 @@ TEST(TextureRegistryTest, RegisterTextureTwice) {
   ASSERT_TRUE(mock_texture2->unregistered());
 }
 
+TEST(TextureRegistryTest, MarkTextureFrameAvailableAdvancesGeneration) {
+  TextureRegistry registry;
+  auto mock_texture1 = std::make_shared<MockTexture>(0);
+  auto mock_texture2 = std::make_shared<MockTexture>(1);
+
+  registry.RegisterTexture(mock_texture1);
+  registry.RegisterTexture(mock_texture2);
+  ASSERT_EQ(mock_texture1->FrameGeneration(), 0u);
+  ASSERT_EQ(mock_texture2->FrameGeneration(), 0u);
+
+  ASSERT_TRUE(registry.MarkTextureFrameAvailable(0));
+  ASSERT_TRUE(registry.MarkTextureFrameAvailable(0));
+  ASSERT_EQ(mock_texture1->FrameGeneration(), 2u);
+  ASSERT_EQ(mock_texture2->FrameGeneration(), 0u);
+
+  ASSERT_FALSE(registry.MarkTextureFrameAvailable(2));
+  registry.UnregisterTexture(0);
+  ASSERT_FALSE(registry.MarkTextureFrameAvailable(0));
+}
+
 TEST(TextureRegistryTest, ReuseSameTextureSlot) {
   TextureRegistry registry;
   auto mock_texture1 = std::make_shared<MockTexture>(0);
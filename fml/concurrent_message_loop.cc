@@ -11,13 +11,25 @@
 
 namespace fml {
 
+namespace {
+
+// The loop and index of the worker running on the current thread, if any.
+thread_local const ConcurrentMessageLoop* tCurrentLoop = nullptr;
+thread_local size_t tCurrentWorkerIndex = 0u;
+
+}  // namespace
+
 ConcurrentMessageLoop::ConcurrentMessageLoop(size_t worker_count)
     : worker_count_(std::max<size_t>(worker_count, 1ul)) {
+  for (size_t i = 0; i < worker_count_; ++i) {
+    worker_queues_.emplace_back(std::make_unique<WorkerQueue>());
+  }
+
   for (size_t i = 0; i < worker_count_; ++i) {
     workers_.emplace_back([i, this]() {
       fml::Thread::SetCurrentThreadName(fml::Thread::ThreadConfig(
           std::string{"io.worker." + std::to_string(i + 1)}));
-      WorkerMain();
+      WorkerMain(i);
     });
   }
 
@@ -42,74 +54,127 @@ std::shared_ptr<ConcurrentTaskRunner> ConcurrentMessageLoop::GetTaskRunner() {
   return std::make_shared<ConcurrentTaskRunner>(weak_from_this());
 }
 
-void ConcurrentMessageLoop::PostTask(const fml::closure& task) {
+void ConcurrentMessageLoop::PostTask(const fml::closure& task,
+                                     ConcurrentTaskPriority priority) {
   if (!task) {
     return;
   }
 
-  std::unique_lock lock(tasks_mutex_);
-
   // Don't just drop tasks on the floor in case of shutdown.
   if (shutdown_) {
     FML_DLOG(WARNING)
         << "Tried to post a task to shutdown concurrent message "
            "loop. The task will be executed on the callers thread.";
-    lock.unlock();
     ExecuteTask(task);
     return;
   }
 
-  tasks_.push(task);
+  // Tasks posted by a worker stay on that worker unless other workers run out
+  // of tasks.
+  const size_t worker_index = tCurrentLoop == this
+                                  ? tCurrentWorkerIndex
+                                  : next_worker_index_++ % worker_count_;
+  pending_task_count_++;
+  {
+    auto& queue = *worker_queues_[worker_index];
+    std::scoped_lock lock(queue.mutex);
+    queue.tasks[static_cast<size_t>(priority)].push_back(task);
+  }
+
+  WakeIdleWorker();
+}
 
+void ConcurrentMessageLoop::WakeIdleWorker() {
+  // Workers only sleep after checking the pending tasks with the idle mutex
+  // held, so they are either waiting already or will see the new task.
+  if (idle_worker_count_ == 0u) {
+    return;
+  }
+  {
+    std::scoped_lock lock(idle_mutex_);
+  }
   // Unlock the mutex before notifying the condition variable because that mutex
   // has to be acquired on the other thread anyway. Waiting in this scope till
   // it is acquired there is a pessimization.
-  lock.unlock();
+  idle_condition_.notify_one();
+}
 
-  tasks_condition_.notify_one();
+fml::closure ConcurrentMessageLoop::TakeTask(size_t worker_index) {
+  for (size_t priority = 0; priority < kPriorityCount; ++priority) {
+    {
+      auto& queue = *worker_queues_[worker_index];
+      std::scoped_lock lock(queue.mutex);
+      auto& tasks = queue.tasks[priority];
+      if (!tasks.empty()) {
+        fml::closure task = std::move(tasks.front());
+        tasks.pop_front();
+        pending_task_count_--;
+        return task;
+      }
+    }
+    for (size_t i = 1; i < worker_count_; ++i) {
+      auto& queue = *worker_queues_[(worker_index + i) % worker_count_];
+      std::scoped_lock lock(queue.mutex);
+      auto& tasks = queue.tasks[priority];
+      if (!tasks.empty()) {
+        fml::closure task = std::move(tasks.back());
+        tasks.pop_back();
+        pending_task_count_--;
+        return task;
+      }
+    }
+  }
+  return nullptr;
 }
 
-void ConcurrentMessageLoop::WorkerMain() {
-  while (true) {
-    std::unique_lock lock(tasks_mutex_);
-    tasks_condition_.wait(lock, [&]() {
-      return !tasks_.empty() || shutdown_ || HasThreadTasksLocked();
-    });
+void ConcurrentMessageLoop::RunThreadTasks() {
+  if (thread_task_count_ == 0u) {
+    return;
+  }
+  std::vector<fml::closure> thread_tasks;
+  {
+    std::scoped_lock lock(idle_mutex_);
+    if (!HasThreadTasksLocked()) {
+      return;
+    }
+    thread_tasks = GetThreadTasksLocked();
+    FML_DCHECK(!HasThreadTasksLocked());
+  }
+  for (const auto& thread_task : thread_tasks) {
+    ExecuteTask(thread_task);
+  }
+}
 
-    // Shutdown cannot be read with the task mutex unlocked.
-    bool shutdown_now = shutdown_;
-    fml::closure task;
-    std::vector<fml::closure> thread_tasks;
+void ConcurrentMessageLoop::WorkerMain(size_t worker_index) {
+  tCurrentLoop = this;
+  tCurrentWorkerIndex = worker_index;
 
-    if (!tasks_.empty()) {
-      task = tasks_.front();
-      tasks_.pop();
-    }
+  while (true) {
+    RunThreadTasks();
 
-    if (HasThreadTasksLocked()) {
-      thread_tasks = GetThreadTasksLocked();
-      FML_DCHECK(!HasThreadTasksLocked());
+    if (shutdown_) {
+      break;
     }
 
-    // Don't hold onto the mutex while tasks are being executed as they could
+    // Don't hold onto any mutex while tasks are being executed as they could
     // themselves try to post more tasks to the message loop.
-    lock.unlock();
-
-    TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
-    // Execute the primary task we woke up for.
-    if (task) {
+    if (auto task = TakeTask(worker_index)) {
       ExecuteTask(task);
+      continue;
     }
 
-    // Execute any thread tasks.
-    for (const auto& thread_task : thread_tasks) {
-      ExecuteTask(thread_task);
-    }
+    std::unique_lock lock(idle_mutex_);
+    idle_worker_count_++;
+    idle_condition_.wait(lock, [&]() {
+      return pending_task_count_ > 0u || shutdown_ || HasThreadTasksLocked();
+    });
+    idle_worker_count_--;
+    lock.unlock();
 
-    if (shutdown_now) {
-      break;
-    }
+    TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
   }
+
+  tCurrentLoop = nullptr;
 }
 
 void ConcurrentMessageLoop::ExecuteTask(const fml::closure& task) {
@@ -117,9 +182,9 @@ void ConcurrentMessageLoop::ExecuteTask(const fml::closure& task) {
 }
 
 void ConcurrentMessageLoop::Terminate() {
-  std::scoped_lock lock(tasks_mutex_);
+  std::scoped_lock lock(idle_mutex_);
   shutdown_ = true;
-  tasks_condition_.notify_all();
+  idle_condition_.notify_all();
 }
 
 void ConcurrentMessageLoop::PostTaskToAllWorkers(const fml::closure& task) {
@@ -127,11 +192,32 @@ void ConcurrentMessageLoop::PostTaskToAllWorkers(const fml::closure& task) {
     return;
   }
 
-  std::scoped_lock lock(tasks_mutex_);
+  std::scoped_lock lock(idle_mutex_);
   for (const auto& worker_thread_id : worker_thread_ids_) {
-    thread_tasks_[worker_thread_id].emplace_back(task);
+    auto& thread_tasks = thread_tasks_[worker_thread_id];
+    if (thread_tasks.empty()) {
+      thread_task_count_++;
+    }
+    thread_tasks.emplace_back(task);
   }
-  tasks_condition_.notify_all();
+  idle_condition_.notify_all();
+}
+
+void ConcurrentMessageLoop::PostTaskToWorker(size_t worker_index,
+                                             const fml::closure& task) {
+  if (!task) {
+    return;
+  }
+  FML_DCHECK(worker_index < worker_count_);
+
+  std::scoped_lock lock(idle_mutex_);
+  auto& thread_tasks = thread_tasks_[worker_thread_ids_[worker_index]];
+  if (thread_tasks.empty()) {
+    thread_task_count_++;
+  }
+  thread_tasks.emplace_back(task);
+  // The worker may not be the one woken by a single notification.
+  idle_condition_.notify_all();
 }
 
 bool ConcurrentMessageLoop::HasThreadTasksLocked() const {
@@ -144,6 +230,7 @@ std::vector<fml::closure> ConcurrentMessageLoop::GetThreadTasksLocked() {
   std::vector<fml::closure> pending_tasks;
   std::swap(pending_tasks, found->second);
   thread_tasks_.erase(found);
+  thread_task_count_--;
   return pending_tasks;
 }
 
@@ -154,12 +241,17 @@ ConcurrentTaskRunner::ConcurrentTaskRunner(
 ConcurrentTaskRunner::~ConcurrentTaskRunner() = default;
 
 void ConcurrentTaskRunner::PostTask(const fml::closure& task) {
+  PostTask(task, ConcurrentTaskPriority::kNormal);
+}
+
+void ConcurrentTaskRunner::PostTask(const fml::closure& task,
+                                    ConcurrentTaskPriority priority) {
   if (!task) {
     return;
   }
 
   if (auto loop = weak_loop_.lock()) {
-    loop->PostTask(task);
+    loop->PostTask(task, priority);
     return;
   }
 
@@ -170,13 +262,7 @@ void ConcurrentTaskRunner::PostTask(const fml::closure& task) {
 }
 
 bool ConcurrentMessageLoop::RunsTasksOnCurrentThread() {
-  std::scoped_lock lock(tasks_mutex_);
-  for (const auto& worker_thread_id : worker_thread_ids_) {
-    if (worker_thread_id == std::this_thread::get_id()) {
-      return true;
-    }
-  }
-  return false;
+  return tCurrentLoop == this;
 }
 
 }  // namespace fml
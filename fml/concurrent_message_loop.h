@@ -5,10 +5,14 @@
 #ifndef FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 #define FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 
+#include <array>
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <map>
-#include <queue>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
@@ -18,6 +22,28 @@ namespace fml {
 
 class ConcurrentTaskRunner;
 
+//------------------------------------------------------------------------------
+/// @brief      The priorities of tasks posted to a concurrent message loop.
+///             Workers run all the tasks of a higher priority they can find
+///             before tasks of a lower priority.
+///
+enum class ConcurrentTaskPriority : size_t {
+  /// Work that a frame being produced waits for.
+  kHigh,
+  kNormal,
+  /// Speculative work, like decoding image frames ahead of their use.
+  kLow,
+};
+
+//------------------------------------------------------------------------------
+/// @brief      A pool of worker threads.
+///
+///             Every worker has its own queues of tasks. Tasks posted from a
+///             worker are queued on that worker and tasks posted from other
+///             threads are spread over the workers. Workers that run out of
+///             tasks steal tasks from the other workers before they sleep, so
+///             bursts of tasks don't all contend on a single lock.
+///
 class ConcurrentMessageLoop
     : public std::enable_shared_from_this<ConcurrentMessageLoop> {
  public:
@@ -34,6 +60,15 @@ class ConcurrentMessageLoop
 
   void PostTaskToAllWorkers(const fml::closure& task);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Run a task on the worker at the given index, which must be
+  ///             less than the worker count. This can be used to give
+  ///             individual workers different thread priorities or CPU
+  ///             affinities, like keeping some of them on the efficiency
+  ///             cores of a device.
+  ///
+  void PostTaskToWorker(size_t worker_index, const fml::closure& task);
+
   bool RunsTasksOnCurrentThread();
 
  protected:
@@ -43,18 +78,40 @@ class ConcurrentMessageLoop
  private:
   friend ConcurrentTaskRunner;
 
+  static constexpr size_t kPriorityCount = 3u;
+
+  struct WorkerQueue {
+    std::mutex mutex;
+    // The worker runs the oldest of its own tasks first. Other workers steal
+    // the newest ones.
+    std::array<std::deque<fml::closure>, kPriorityCount> tasks;
+  };
+
   size_t worker_count_ = 0;
+  std::vector<std::unique_ptr<WorkerQueue>> worker_queues_;
   std::vector<std::thread> workers_;
-  std::mutex tasks_mutex_;
-  std::condition_variable tasks_condition_;
-  std::queue<fml::closure> tasks_;
   std::vector<std::thread::id> worker_thread_ids_;
+  std::atomic<size_t> next_worker_index_ = 0u;
+  // Incremented before a task is queued and decremented after it is taken so
+  // workers never sleep while tasks are queued.
+  std::atomic<size_t> pending_task_count_ = 0u;
+  std::atomic<size_t> idle_worker_count_ = 0u;
+  std::atomic<size_t> thread_task_count_ = 0u;
+  std::atomic<bool> shutdown_ = false;
+  // Guards the thread tasks and the sleep of idle workers.
+  std::mutex idle_mutex_;
+  std::condition_variable idle_condition_;
   std::map<std::thread::id, std::vector<fml::closure>> thread_tasks_;
-  bool shutdown_ = false;
 
-  void WorkerMain();
+  void WorkerMain(size_t worker_index);
 
-  void PostTask(const fml::closure& task);
+  void PostTask(const fml::closure& task, ConcurrentTaskPriority priority);
+
+  fml::closure TakeTask(size_t worker_index);
+
+  void WakeIdleWorker();
+
+  void RunThreadTasks();
 
   bool HasThreadTasksLocked() const;
 
@@ -69,8 +126,11 @@ class ConcurrentTaskRunner : public BasicTaskRunner {
 
   virtual ~ConcurrentTaskRunner();
 
+  // |BasicTaskRunner|
   void PostTask(const fml::closure& task) override;
 
+  void PostTask(const fml::closure& task, ConcurrentTaskPriority priority);
+
  private:
   friend ConcurrentMessageLoop;
 
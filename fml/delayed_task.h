@@ -8,6 +8,7 @@
 #include <queue>
 
 #include "flutter/fml/closure.h"
+#include "flutter/fml/task_queue_stats.h"
 #include "flutter/fml/task_source_grade.h"
 #include "flutter/fml/time/time_point.h"
 
@@ -18,7 +19,8 @@ class DelayedTask {
   DelayedTask(size_t order,
               const fml::closure& task,
               fml::TimePoint target_time,
-              fml::TaskSourceGrade task_source_grade);
+              fml::TaskSourceGrade task_source_grade,
+              size_t poster = TaskQueueStats::kExternalPoster);
 
   DelayedTask(const DelayedTask& other);
 
@@ -30,6 +32,10 @@ class DelayedTask {
 
   fml::TaskSourceGrade GetTaskSourceGrade() const;
 
+  // The task queue of the thread the task was posted from, if task queue
+  // statistics were enabled when it was posted.
+  size_t GetPoster() const;
+
   bool operator>(const DelayedTask& other) const;
 
  private:
@@ -37,6 +43,7 @@ class DelayedTask {
   fml::closure task_;
   fml::TimePoint target_time_;
   fml::TaskSourceGrade task_source_grade_;
+  size_t poster_;
 };
 
 using DelayedTaskQueue = std::priority_queue<DelayedTask,
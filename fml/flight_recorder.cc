@@ -0,0 +1,105 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/flight_recorder.h"
+
+namespace fml {
+
+namespace {
+
+uint64_t PackHeader(const FlightRecorder::Event& event) {
+  return static_cast<uint64_t>(event.type) |
+         (static_cast<uint64_t>(event.detail) << 8) |
+         (static_cast<uint64_t>(event.id) << 32);
+}
+
+void UnpackHeader(uint64_t header, FlightRecorder::Event* event) {
+  event->type = static_cast<FlightRecorder::EventType>(header & 0xFF);
+  event->detail = static_cast<uint8_t>((header >> 8) & 0xFF);
+  event->id = static_cast<uint32_t>(header >> 32);
+}
+
+}  // namespace
+
+FlightRecorder& FlightRecorder::GetInstance() {
+  static FlightRecorder recorder;
+  return recorder;
+}
+
+FlightRecorder::FlightRecorder() = default;
+
+FlightRecorder::~FlightRecorder() = default;
+
+void FlightRecorder::Enable() {
+  is_enabled_.store(true, std::memory_order_relaxed);
+}
+
+void FlightRecorder::Record(const Event& event) {
+  if (!IsEnabled()) {
+    return;
+  }
+  const uint64_t index = next_index_.fetch_add(1, std::memory_order_relaxed);
+  Slot& slot = slots_[index & (kCapacity - 1)];
+  slot.sequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.header.store(PackHeader(event), std::memory_order_relaxed);
+  slot.start.store(event.start.ToEpochDelta().ToNanoseconds(),
+                   std::memory_order_relaxed);
+  slot.end.store(event.end.ToEpochDelta().ToNanoseconds(),
+                 std::memory_order_relaxed);
+  slot.sequence.store(index + 1, std::memory_order_release);
+}
+
+void FlightRecorder::RecordTaskLatency(uint32_t queue_id,
+                                       uint8_t task_source_grade,
+                                       fml::TimePoint target_time,
+                                       fml::TimePoint run_time) {
+  if (!IsEnabled() || run_time - target_time < kMinRecordedTaskLatency) {
+    return;
+  }
+  Record({
+      .type = EventType::kTaskLatency,
+      .detail = task_source_grade,
+      .id = queue_id,
+      .start = target_time,
+      .end = run_time,
+  });
+}
+
+std::vector<FlightRecorder::Event> FlightRecorder::GetEvents(
+    fml::TimeDelta window) const {
+  const uint64_t end_index = next_index_.load(std::memory_order_acquire);
+  const uint64_t begin_index =
+      end_index > kCapacity ? end_index - kCapacity : 0u;
+  const fml::TimePoint now = fml::TimePoint::Now();
+  const fml::TimePoint earliest_end = window < now.ToEpochDelta()
+                                          ? now - window
+                                          : fml::TimePoint::Min();
+
+  std::vector<Event> events;
+  events.reserve(end_index - begin_index);
+  for (uint64_t index = begin_index; index < end_index; index++) {
+    const Slot& slot = slots_[index & (kCapacity - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != index + 1) {
+      // Still being written, or already overwritten by a newer event.
+      continue;
+    }
+    Event event;
+    UnpackHeader(slot.header.load(std::memory_order_relaxed), &event);
+    event.start = fml::TimePoint::FromTicks(
+        slot.start.load(std::memory_order_relaxed));
+    event.end =
+        fml::TimePoint::FromTicks(slot.end.load(std::memory_order_relaxed));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != index + 1) {
+      continue;
+    }
+    if (event.end >= earliest_end) {
+      events.push_back(event);
+    }
+  }
+  return events;
+}
+
+}  // namespace fml
@@ -0,0 +1,123 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_FLIGHT_RECORDER_H_
+#define FLUTTER_FML_FLIGHT_RECORDER_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      Keeps the most recent frame and task queue events of the
+///             process in a fixed-size ring buffer, so that the moments
+///             before a jank can be looked at afterwards without tracing.
+///
+///             Recording is enabled with the `--enable-flight-recorder`
+///             switch. Events are recorded without locks or allocations, and
+///             recording does nothing but check a flag while disabled. The
+///             events are available through the `_flutter.getFlightRecord`
+///             service protocol extension.
+///
+class FlightRecorder {
+ public:
+  enum class EventType : uint8_t {
+    /// A frame, from the start of its vsync to the end of its rasterization.
+    kFrame,
+    /// The build phase of a frame on the UI thread.
+    kFrameBuild,
+    /// The rasterization of a frame on the raster thread.
+    kFrameRaster,
+    /// A task that ran late, from the time it was due to the time it ran.
+    /// The id is the task queue and the detail the task source grade.
+    kTaskLatency,
+  };
+
+  struct Event {
+    EventType type = EventType::kFrame;
+    uint8_t detail = 0;
+    /// The frame number or the task queue id.
+    uint32_t id = 0;
+    fml::TimePoint start;
+    fml::TimePoint end;
+  };
+
+  /// The number of events kept. Enough for the frames of more than ten
+  /// seconds at 60Hz along with the late tasks of those frames.
+  static constexpr size_t kCapacity = 4096u;
+
+  /// Tasks that ran less late than this are not recorded, so that the buffer
+  /// still covers several seconds on busy task queues.
+  static constexpr fml::TimeDelta kMinRecordedTaskLatency =
+      fml::TimeDelta::FromMilliseconds(1);
+
+  static FlightRecorder& GetInstance();
+
+  FlightRecorder();
+
+  ~FlightRecorder();
+
+  void Enable();
+
+  bool IsEnabled() const {
+    return is_enabled_.load(std::memory_order_relaxed);
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records an event, overwriting the oldest one if the buffer is
+  ///             full. Does nothing if the recorder isn't enabled. May be
+  ///             called on any thread.
+  ///
+  void Record(const Event& event);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records a task that ran at |run_time| but was due at
+  ///             |target_time|, if it ran at least `kMinRecordedTaskLatency`
+  ///             late.
+  ///
+  void RecordTaskLatency(uint32_t queue_id,
+                         uint8_t task_source_grade,
+                         fml::TimePoint target_time,
+                         fml::TimePoint run_time);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the recorded events that ended within |window| before
+  ///             now, oldest first. Events that are overwritten while they are
+  ///             read are skipped. May be called on any thread.
+  ///
+  std::vector<Event> GetEvents(
+      fml::TimeDelta window = fml::TimeDelta::Max()) const;
+
+ private:
+  static_assert((kCapacity & (kCapacity - 1)) == 0,
+                "The capacity must be a power of two.");
+
+  // The fields of an event, written and read as atomics so that a reader
+  // racing a writer sees a torn slot instead of undefined behavior. The
+  // sequence is zero while the slot is written, and one more than the index
+  // of the event once it is complete.
+  struct Slot {
+    std::atomic<uint64_t> sequence = 0;
+    std::atomic<uint64_t> header = 0;
+    std::atomic<int64_t> start = 0;
+    std::atomic<int64_t> end = 0;
+  };
+
+  std::atomic<bool> is_enabled_ = false;
+  std::atomic<uint64_t> next_index_ = 0;
+  std::array<Slot, kCapacity> slots_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FlightRecorder);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_FLIGHT_RECORDER_H_
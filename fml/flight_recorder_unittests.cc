@@ -0,0 +1,100 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/flight_recorder.h"
+
+#include <memory>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+namespace {
+
+FlightRecorder::Event MakeFrameEvent(uint32_t frame_number,
+                                     fml::TimePoint end) {
+  return {
+      .type = FlightRecorder::EventType::kFrame,
+      .id = frame_number,
+      .start = end - fml::TimeDelta::FromMilliseconds(16),
+      .end = end,
+  };
+}
+
+}  // namespace
+
+TEST(FlightRecorderTest, IgnoresEventsWhileDisabled) {
+  auto recorder = std::make_unique<FlightRecorder>();
+  recorder->Record(MakeFrameEvent(1, fml::TimePoint::Now()));
+  EXPECT_TRUE(recorder->GetEvents().empty());
+}
+
+TEST(FlightRecorderTest, ReturnsEventsOldestFirst) {
+  auto recorder = std::make_unique<FlightRecorder>();
+  recorder->Enable();
+  const auto now = fml::TimePoint::Now();
+  recorder->Record(MakeFrameEvent(1, now));
+  recorder->Record({
+      .type = FlightRecorder::EventType::kFrameRaster,
+      .id = 1,
+      .start = now,
+      .end = now + fml::TimeDelta::FromMilliseconds(4),
+  });
+
+  auto events = recorder->GetEvents();
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[0].type, FlightRecorder::EventType::kFrame);
+  EXPECT_EQ(events[0].id, 1u);
+  EXPECT_EQ(events[0].end, now);
+  EXPECT_EQ(events[1].type, FlightRecorder::EventType::kFrameRaster);
+  EXPECT_EQ(events[1].start, now);
+}
+
+TEST(FlightRecorderTest, KeepsOnlyTheMostRecentEvents) {
+  auto recorder = std::make_unique<FlightRecorder>();
+  recorder->Enable();
+  const auto now = fml::TimePoint::Now();
+  const uint32_t count = FlightRecorder::kCapacity + 10;
+  for (uint32_t i = 0; i < count; i++) {
+    recorder->Record(MakeFrameEvent(i, now));
+  }
+
+  auto events = recorder->GetEvents();
+  ASSERT_EQ(events.size(), FlightRecorder::kCapacity);
+  EXPECT_EQ(events.front().id, 10u);
+  EXPECT_EQ(events.back().id, count - 1);
+}
+
+TEST(FlightRecorderTest, FiltersEventsByWindow) {
+  auto recorder = std::make_unique<FlightRecorder>();
+  recorder->Enable();
+  const auto now = fml::TimePoint::Now();
+  recorder->Record(MakeFrameEvent(1, now - fml::TimeDelta::FromSeconds(20)));
+  recorder->Record(MakeFrameEvent(2, now));
+
+  auto events = recorder->GetEvents(fml::TimeDelta::FromSeconds(10));
+  ASSERT_EQ(events.size(), 1u);
+  EXPECT_EQ(events[0].id, 2u);
+}
+
+TEST(FlightRecorderTest, RecordsOnlyLateTasks) {
+  auto recorder = std::make_unique<FlightRecorder>();
+  recorder->Enable();
+  const auto now = fml::TimePoint::Now();
+  recorder->RecordTaskLatency(3, 0, now, now);
+  recorder->RecordTaskLatency(4, 1, now - fml::TimeDelta::FromMilliseconds(8),
+                              now);
+
+  auto events = recorder->GetEvents();
+  ASSERT_EQ(events.size(), 1u);
+  EXPECT_EQ(events[0].type, FlightRecorder::EventType::kTaskLatency);
+  EXPECT_EQ(events[0].id, 4u);
+  EXPECT_EQ(events[0].detail, 1u);
+  EXPECT_EQ(events[0].end - events[0].start,
+            fml::TimeDelta::FromMilliseconds(8));
+}
+
+}  // namespace testing
+}  // namespace fml
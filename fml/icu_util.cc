@@ -4,6 +4,7 @@
 
 #include "flutter/fml/icu_util.h"
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 
@@ -12,7 +13,10 @@
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/native_library.h"
 #include "flutter/fml/paths.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/icu/source/common/unicode/ubrk.h"
 #include "third_party/icu/source/common/unicode/udata.h"
+#include "third_party/icu/source/common/unicode/uloc.h"
 
 namespace fml {
 namespace icu {
@@ -93,6 +97,7 @@ class ICUContext {
 };
 
 void InitializeICUOnce(const std::string& icu_data_path) {
+  TRACE_EVENT0("flutter", "InitializeICU");
   static ICUContext* context = new ICUContext(icu_data_path);
   FML_CHECK(context->IsValid())
       << "Must be able to initialize the ICU context. Tried: " << icu_data_path;
@@ -116,5 +121,68 @@ void InitializeICUFromMapping(std::unique_ptr<Mapping> mapping) {
   });
 }
 
+namespace {
+
+std::mutex g_lazy_init_mutex;
+// Set by the lazy initializers. Kept after it runs, as it initializes ICU
+// at most once and callers racing with the first call must wait on it.
+std::function<void()> g_lazy_initializer;
+// Whether the lazy initializer has run, so that callers that run often don't
+// have to take the lock.
+std::atomic<bool> g_lazy_initializer_ran = false;
+
+void SetLazyInitializer(std::function<void()> initializer) {
+  std::scoped_lock lock(g_lazy_init_mutex);
+  if (!g_lazy_initializer) {
+    g_lazy_initializer = std::move(initializer);
+  }
+}
+
+}  // namespace
+
+void InitializeICULazily(const std::string& icu_data_path) {
+  SetLazyInitializer([icu_data_path]() { InitializeICU(icu_data_path); });
+}
+
+void InitializeICUFromMappingLazily(
+    std::function<std::unique_ptr<Mapping>(void)> mapper) {
+  SetLazyInitializer([mapper = std::move(mapper)]() {
+    std::call_once(g_icu_init_flag, [&mapper]() {
+      TRACE_EVENT0("flutter", "InitializeICUFromMapping");
+      InitializeICUFromMappingOnce(mapper());
+    });
+  });
+}
+
+void EnsureICUInitialized() {
+  if (g_lazy_initializer_ran.load(std::memory_order_acquire)) {
+    return;
+  }
+  std::function<void()> initializer;
+  {
+    std::scoped_lock lock(g_lazy_init_mutex);
+    initializer = g_lazy_initializer;
+  }
+  if (initializer) {
+    initializer();
+    g_lazy_initializer_ran.store(true, std::memory_order_release);
+  }
+}
+
+void WarmUpBreakIterators() {
+  TRACE_EVENT0("flutter", "WarmUpBreakIterators");
+  EnsureICUInitialized();
+  // Opening the iterators pages in their rules and fills the caches of ICU
+  // that laying out the first paragraph would otherwise fill.
+  for (UBreakIteratorType type : {UBRK_LINE, UBRK_WORD}) {
+    UErrorCode err_code = U_ZERO_ERROR;
+    UBreakIterator* iterator =
+        ubrk_open(type, uloc_getDefault(), nullptr, 0, &err_code);
+    if (U_SUCCESS(err_code)) {
+      ubrk_close(iterator);
+    }
+  }
+}
+
 }  // namespace icu
 }  // namespace fml
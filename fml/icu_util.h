@@ -5,6 +5,8 @@
 #ifndef FLUTTER_FML_ICU_UTIL_H_
 #define FLUTTER_FML_ICU_UTIL_H_
 
+#include <functional>
+#include <memory>
 #include <string>
 
 #include "flutter/fml/macros.h"
@@ -17,6 +19,26 @@ void InitializeICU(const std::string& icu_data_path = "");
 
 void InitializeICUFromMapping(std::unique_ptr<Mapping> mapping);
 
+// Like |InitializeICU|, but only records where the ICU data is. The data is
+// mapped and ICU is initialized on the first call to |EnsureICUInitialized|.
+void InitializeICULazily(const std::string& icu_data_path);
+
+// Like |InitializeICUFromMapping|, but the mapping is only created, and ICU
+// initialized with it, on the first call to |EnsureICUInitialized|.
+void InitializeICUFromMappingLazily(
+    std::function<std::unique_ptr<Mapping>(void)> mapper);
+
+// Initializes ICU with the data recorded by |InitializeICULazily| or
+// |InitializeICUFromMappingLazily|, if it hasn't been initialized yet. Code
+// that uses ICU APIs which load data must call this first, as ICU may be
+// initialized lazily. Does nothing if no lazy initialization was recorded.
+void EnsureICUInitialized();
+
+// Initializes ICU if needed and loads the data of the line and word break
+// iterators of the default locale, so that the first paragraph laid out
+// doesn't have to. Meant to be called on a background thread.
+void WarmUpBreakIterators();
+
 }  // namespace icu
 }  // namespace fml
 
@@ -41,6 +41,20 @@ std::unique_ptr<FileMapping> FileMapping::CreateReadOnly(
   return mapping;
 }
 
+std::unique_ptr<FileMapping> FileMapping::CreateReadOnly(
+    const fml::UniqueFD& fd,
+    size_t offset,
+    size_t length) {
+  auto mapping = std::make_unique<FileMapping>(
+      fd, offset, length, std::initializer_list<Protection>{Protection::kRead});
+
+  if (!mapping->IsValid()) {
+    return nullptr;
+  }
+
+  return mapping;
+}
+
 std::unique_ptr<FileMapping> FileMapping::CreateReadExecute(
     const std::string& path) {
   return CreateReadExecute(
@@ -66,6 +80,44 @@ std::unique_ptr<FileMapping> FileMapping::CreateReadExecute(
   return mapping;
 }
 
+// RangeMapping
+
+RangeMapping::RangeMapping(std::shared_ptr<const Mapping> parent,
+                           size_t offset,
+                           size_t length)
+    : parent_(std::move(parent)) {
+  if (!parent_ || parent_->GetMapping() == nullptr) {
+    return;
+  }
+  offset_ = std::min(offset, parent_->GetSize());
+  size_ = std::min(length, parent_->GetSize() - offset_);
+}
+
+RangeMapping::~RangeMapping() = default;
+
+size_t RangeMapping::GetSize() const {
+  return size_;
+}
+
+const uint8_t* RangeMapping::GetMapping() const {
+  if (!parent_ || parent_->GetMapping() == nullptr) {
+    return nullptr;
+  }
+  return parent_->GetMapping() + offset_;
+}
+
+bool RangeMapping::IsDontNeedSafe() const {
+  return parent_ && parent_->IsDontNeedSafe();
+}
+
+const std::shared_ptr<const Mapping>& RangeMapping::GetParent() const {
+  return parent_;
+}
+
+size_t RangeMapping::GetOffset() const {
+  return offset_;
+}
+
 // Data Mapping
 
 DataMapping::DataMapping(std::vector<uint8_t> data) : data_(std::move(data)) {}
@@ -6,6 +6,7 @@
 #define FLUTTER_FML_MAPPING_H_
 
 #include <initializer_list>
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
@@ -44,10 +45,36 @@ class FileMapping final : public Mapping {
     kExecute,
   };
 
+  // Hints about how the mapped pages of a file will be accessed.
+  enum class Advice {
+    // No particular access pattern.
+    kNormal,
+    // The pages will be read in order. They may be read ahead aggressively
+    // and released soon after they are accessed.
+    kSequential,
+    // The pages will be accessed in random order. Read-ahead is disabled.
+    kRandom,
+    // The pages will be accessed soon and should be read ahead of time.
+    kWillNeed,
+    // The pages won't be accessed soon and may be released. They are read
+    // from the file again on their next access. Only honored for mappings
+    // for which `IsDontNeedSafe` is true.
+    kDontNeed,
+  };
+
   explicit FileMapping(const fml::UniqueFD& fd,
                        std::initializer_list<Protection> protection = {
                            Protection::kRead});
 
+  // Maps |length| bytes of the file starting at |offset|. The range is
+  // clamped to the end of the file. The offset doesn't need to be aligned to
+  // pages.
+  FileMapping(const fml::UniqueFD& fd,
+              size_t offset,
+              size_t length,
+              std::initializer_list<Protection> protection = {
+                  Protection::kRead});
+
   ~FileMapping() override;
 
   static std::unique_ptr<FileMapping> CreateReadOnly(const std::string& path);
@@ -56,6 +83,11 @@ class FileMapping final : public Mapping {
       const fml::UniqueFD& base_fd,
       const std::string& sub_path = "");
 
+  static std::unique_ptr<FileMapping> CreateReadOnly(
+      const fml::UniqueFD& fd,
+      size_t offset,
+      size_t length);
+
   static std::unique_ptr<FileMapping> CreateReadExecute(
       const std::string& path);
 
@@ -76,11 +108,22 @@ class FileMapping final : public Mapping {
 
   bool IsValid() const;
 
+  // Gives the kernel a hint about the access of |length| bytes of the mapping
+  // starting at |offset|. The range is clamped to the end of the mapping and
+  // extended to whole pages. Returns whether the hint was accepted. Hints are
+  // not supported on all platforms.
+  bool Advise(Advice advice,
+              size_t offset = 0,
+              size_t length = std::numeric_limits<size_t>::max()) const;
+
  private:
   bool valid_ = false;
   size_t size_ = 0;
   uint8_t* mapping_ = nullptr;
   uint8_t* mutable_mapping_ = nullptr;
+  // The distance of |mapping_| from the start of the mapped pages when the
+  // mapped range of the file doesn't start on a page boundary.
+  size_t mapping_offset_ = 0;
 
 #if FML_OS_WIN
   fml::UniqueFD mapping_handle_;
@@ -89,6 +132,39 @@ class FileMapping final : public Mapping {
   FML_DISALLOW_COPY_AND_ASSIGN(FileMapping);
 };
 
+// A view of a range of another mapping. The view keeps the other mapping
+// alive, so that sections of a large mapping can be handed out independently.
+class RangeMapping final : public Mapping {
+ public:
+  // The range is clamped to the end of |parent|.
+  RangeMapping(std::shared_ptr<const Mapping> parent,
+               size_t offset,
+               size_t length);
+
+  ~RangeMapping() override;
+
+  // |Mapping|
+  size_t GetSize() const override;
+
+  // |Mapping|
+  const uint8_t* GetMapping() const override;
+
+  // |Mapping|
+  bool IsDontNeedSafe() const override;
+
+  const std::shared_ptr<const Mapping>& GetParent() const;
+
+  // The offset of the view in its parent.
+  size_t GetOffset() const;
+
+ private:
+  const std::shared_ptr<const Mapping> parent_;
+  size_t offset_ = 0;
+  size_t size_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RangeMapping);
+};
+
 class DataMapping final : public Mapping {
  public:
   explicit DataMapping(std::vector<uint8_t> data);
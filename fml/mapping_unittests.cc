@@ -3,6 +3,8 @@
 // found in the LICENSE file.
 
 #include "flutter/fml/mapping.h"
+
+#include "flutter/fml/file.h"
 #include "flutter/testing/testing.h"
 
 namespace fml {
@@ -67,4 +69,100 @@ TEST(MallocMapping, CopySizeZero) {
   ASSERT_EQ(0u, mapping.GetSize());
 }
 
+namespace {
+
+UniqueFD CreateFileOfSize(ScopedTemporaryDirectory& directory,
+                          size_t size) {
+  std::vector<uint8_t> data(size);
+  for (size_t i = 0; i < size; i++) {
+    data[i] = static_cast<uint8_t>(i % 251);
+  }
+  if (!WriteAtomically(directory.fd(), "mapping",
+                       DataMapping(std::move(data)))) {
+    return {};
+  }
+  return OpenFile(directory.fd(), "mapping", false, FilePermission::kRead);
+}
+
+}  // namespace
+
+TEST(FileMapping, MapsRangeAtUnalignedOffset) {
+  ScopedTemporaryDirectory directory;
+  auto file = CreateFileOfSize(directory, 3 * 65536);
+  ASSERT_TRUE(file.is_valid());
+
+  auto mapping = FileMapping::CreateReadOnly(file, 65536 + 7, 100);
+  ASSERT_NE(mapping, nullptr);
+  ASSERT_EQ(mapping->GetSize(), 100u);
+  EXPECT_EQ(mapping->GetMapping()[0], (65536 + 7) % 251);
+  EXPECT_EQ(mapping->GetMapping()[99], (65536 + 106) % 251);
+  EXPECT_TRUE(mapping->IsDontNeedSafe());
+}
+
+TEST(FileMapping, ClampsRangeToEndOfFile) {
+  ScopedTemporaryDirectory directory;
+  auto file = CreateFileOfSize(directory, 1000);
+  ASSERT_TRUE(file.is_valid());
+
+  auto mapping = FileMapping::CreateReadOnly(file, 900, 1000);
+  ASSERT_NE(mapping, nullptr);
+  EXPECT_EQ(mapping->GetSize(), 100u);
+  EXPECT_EQ(mapping->GetMapping()[0], 900 % 251);
+
+  auto empty = FileMapping::CreateReadOnly(file, 1000, 10);
+  ASSERT_NE(empty, nullptr);
+  EXPECT_EQ(empty->GetSize(), 0u);
+
+  EXPECT_EQ(FileMapping::CreateReadOnly(file, 1001, 10), nullptr);
+}
+
+#if !FML_OS_WIN
+TEST(FileMapping, AdvisesAccess) {
+  ScopedTemporaryDirectory directory;
+  auto file = CreateFileOfSize(directory, 65536);
+  ASSERT_TRUE(file.is_valid());
+
+  auto mapping = FileMapping::CreateReadOnly(file, 13, 65000);
+  ASSERT_NE(mapping, nullptr);
+  EXPECT_TRUE(mapping->Advise(FileMapping::Advice::kSequential));
+  EXPECT_TRUE(mapping->Advise(FileMapping::Advice::kWillNeed, 100, 5000));
+  EXPECT_TRUE(mapping->Advise(FileMapping::Advice::kDontNeed));
+  EXPECT_FALSE(mapping->Advise(FileMapping::Advice::kNormal, 65000));
+
+  // Released pages are read from the file again.
+  EXPECT_EQ(mapping->GetMapping()[0], 13u);
+}
+#endif  // !FML_OS_WIN
+
+TEST(RangeMapping, ViewsRangeOfParent) {
+  std::shared_ptr<const Mapping> parent =
+      std::make_shared<DataMapping>(std::string("Hello, World"));
+  RangeMapping view(parent, 7, 5);
+  ASSERT_EQ(view.GetSize(), 5u);
+  EXPECT_EQ(std::string(reinterpret_cast<const char*>(view.GetMapping()),
+                        view.GetSize()),
+            "World");
+  EXPECT_EQ(view.GetOffset(), 7u);
+  EXPECT_EQ(view.GetParent(), parent);
+  EXPECT_FALSE(view.IsDontNeedSafe());
+
+  EXPECT_EQ(RangeMapping(parent, 10, 100).GetSize(), 2u);
+  EXPECT_EQ(RangeMapping(parent, 100, 1).GetSize(), 0u);
+  EXPECT_EQ(RangeMapping(nullptr, 0, 1).GetMapping(), nullptr);
+}
+
+TEST(RangeMapping, KeepsParentAlive) {
+  std::weak_ptr<const Mapping> weak_parent;
+  std::unique_ptr<RangeMapping> view;
+  {
+    auto parent = std::make_shared<DataMapping>(std::string("abc"));
+    weak_parent = parent;
+    view = std::make_unique<RangeMapping>(parent, 1, 1);
+  }
+  EXPECT_FALSE(weak_parent.expired());
+  EXPECT_EQ(view->GetMapping()[0], 'b');
+  view.reset();
+  EXPECT_TRUE(weak_parent.expired());
+}
+
 }  // namespace fml
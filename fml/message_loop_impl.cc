@@ -123,7 +123,13 @@ void MessageLoopImpl::FlushTasks(FlushType type) {
     if (!invocation) {
       break;
     }
-    invocation();
+    if (task_queue_->IsStatsEnabled()) {
+      const auto start = fml::TimePoint::Now();
+      invocation();
+      task_queue_->RecordTaskRunTime(queue_id_, fml::TimePoint::Now() - start);
+    } else {
+      invocation();
+    }
     std::vector<fml::closure> observers =
         task_queue_->GetObserversToNotify(queue_id_);
     for (const auto& observer : observers) {
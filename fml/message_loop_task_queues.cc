@@ -11,7 +11,9 @@
 #include <memory>
 #include <optional>
 
+#include "flutter/fml/flight_recorder.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/message_loop.h"
 #include "flutter/fml/task_source.h"
 #include "flutter/fml/thread_local.h"
 
@@ -30,6 +32,14 @@ class TaskSourceGradeHolder {
   explicit TaskSourceGradeHolder(TaskSourceGrade task_source_grade_arg)
       : task_source_grade(task_source_grade_arg) {}
 };
+
+size_t GetCurrentPoster() {
+  if (!MessageLoop::IsInitializedForCurrentThread()) {
+    return TaskQueueStats::kExternalPoster;
+  }
+  return static_cast<size_t>(MessageLoop::GetCurrentTaskQueueId());
+}
+
 }  // namespace
 
 FML_THREAD_LOCAL ThreadLocalUniquePtr<TaskSourceGradeHolder>
@@ -48,7 +58,7 @@ MessageLoopTaskQueues* MessageLoopTaskQueues::GetInstance() {
 }
 
 TaskQueueId MessageLoopTaskQueues::CreateTaskQueue() {
-  std::lock_guard guard(queue_mutex_);
+  UniqueLock lock(*queue_mutex_);
   TaskQueueId loop_id = TaskQueueId(task_queue_id_counter_);
   ++task_queue_id_counter_;
   queue_entries_[loop_id] = std::make_unique<TaskQueueEntry>(loop_id);
@@ -56,7 +66,9 @@ TaskQueueId MessageLoopTaskQueues::CreateTaskQueue() {
 }
 
 MessageLoopTaskQueues::MessageLoopTaskQueues()
-    : task_queue_id_counter_(0), order_(0) {
+    : queue_mutex_(SharedMutex::Create()),
+      task_queue_id_counter_(0),
+      order_(0) {
   tls_task_source_grade.reset(
       new TaskSourceGradeHolder{TaskSourceGrade::kUnspecified});
 }
@@ -64,7 +76,7 @@ MessageLoopTaskQueues::MessageLoopTaskQueues()
 MessageLoopTaskQueues::~MessageLoopTaskQueues() = default;
 
 void MessageLoopTaskQueues::Dispose(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  UniqueLock lock(*queue_mutex_);
   const auto& queue_entry = queue_entries_.at(queue_id);
   FML_DCHECK(queue_entry->subsumed_by == _kUnmerged);
   auto& subsumed_set = queue_entry->owner_of;
@@ -76,7 +88,7 @@ void MessageLoopTaskQueues::Dispose(TaskQueueId queue_id) {
 }
 
 void MessageLoopTaskQueues::DisposeTasks(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  UniqueLock lock(*queue_mutex_);
   const auto& queue_entry = queue_entries_.at(queue_id);
   FML_DCHECK(queue_entry->subsumed_by == _kUnmerged);
   auto& subsumed_set = queue_entry->owner_of;
@@ -95,30 +107,69 @@ void MessageLoopTaskQueues::RegisterTask(
     const fml::closure& task,
     fml::TimePoint target_time,
     fml::TaskSourceGrade task_source_grade) {
-  std::lock_guard guard(queue_mutex_);
+  if (target_time <= fml::TimePoint::Now()) {
+    RegisterImmediateTask(queue_id, task, target_time, task_source_grade);
+    return;
+  }
+
+  const size_t poster =
+      IsStatsEnabled() ? GetCurrentPoster() : TaskQueueStats::kExternalPoster;
+  UniqueLock lock(*queue_mutex_);
   size_t order = order_++;
   const auto& queue_entry = queue_entries_.at(queue_id);
   queue_entry->task_source->RegisterTask(
-      {order, task, target_time, task_source_grade});
+      {order, task, target_time, task_source_grade, poster});
   TaskQueueId loop_to_wake = queue_id;
   if (queue_entry->subsumed_by != _kUnmerged) {
     loop_to_wake = queue_entry->subsumed_by;
   }
 
+  FlushImmediateTasksUnlocked(loop_to_wake);
   // This can happen when the secondary tasks are paused.
   if (HasPendingTasksUnlocked(loop_to_wake)) {
     WakeUpUnlocked(loop_to_wake, GetNextWakeTimeUnlocked(loop_to_wake));
   }
 }
 
+void MessageLoopTaskQueues::RegisterImmediateTask(
+    TaskQueueId queue_id,
+    const fml::closure& task,
+    fml::TimePoint target_time,
+    fml::TaskSourceGrade task_source_grade) {
+  // Producers only share the lock amongst themselves. Everything that reads
+  // or modifies the task heaps holds the lock exclusively and flushes the
+  // immediate tasks first.
+  const size_t poster =
+      IsStatsEnabled() ? GetCurrentPoster() : TaskQueueStats::kExternalPoster;
+  SharedLock lock(*queue_mutex_);
+  size_t order = order_++;
+  const auto& queue_entry = queue_entries_.at(queue_id);
+  if (!queue_entry->task_source->RegisterImmediateTask(
+          {order, task, target_time, task_source_grade, poster})) {
+    // The secondary tasks are paused. Resuming them will wake the loop.
+    return;
+  }
+  TaskQueueId loop_to_wake = queue_id;
+  if (queue_entry->subsumed_by != _kUnmerged) {
+    loop_to_wake = queue_entry->subsumed_by;
+  }
+
+  // The task is already due. Concurrent producers may only ever ask for a wake
+  // up that is also due, so none of them can postpone this one. The loop
+  // computes the next wake time when it gets the task to run.
+  WakeUpUnlocked(loop_to_wake, target_time);
+}
+
 bool MessageLoopTaskQueues::HasPendingTasks(TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  UniqueLock lock(*queue_mutex_);
+  FlushImmediateTasksUnlocked(queue_id);
   return HasPendingTasksUnlocked(queue_id);
 }
 
 fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
                                                      fml::TimePoint from_time) {
-  std::lock_guard guard(queue_mutex_);
+  UniqueLock lock(*queue_mutex_);
+  FlushImmediateTasksUnlocked(queue_id);
   if (!HasPendingTasksUnlocked(queue_id)) {
     return nullptr;
   }
@@ -134,9 +185,23 @@ fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
     return nullptr;
   }
   fml::closure invocation = top.task.GetTask();
-  queue_entries_.at(top.task_queue_id)
-      ->task_source->PopTask(top.task.GetTaskSourceGrade());
   const auto task_source_grade = top.task.GetTaskSourceGrade();
+  FlightRecorder::GetInstance().RecordTaskLatency(
+      static_cast<uint32_t>(static_cast<size_t>(top.task_queue_id)),
+      static_cast<uint8_t>(task_source_grade), top.task.GetTargetTime(),
+      from_time);
+  if (IsStatsEnabled()) {
+    // The loop may run several tasks for one |from_time|, so measure the
+    // latency of each from the time it actually gets to run.
+    queue_entries_.at(queue_id)->running_task = TaskQueueEntry::RunningTask{
+        .task_queue_id = top.task_queue_id,
+        .task_source_grade = task_source_grade,
+        .poster = top.task.GetPoster(),
+        .latency = fml::TimePoint::Now() - top.task.GetTargetTime(),
+    };
+  }
+  // Popping the task destroys |top.task|.
+  queue_entries_.at(top.task_queue_id)->task_source->PopTask(task_source_grade);
   tls_task_source_grade.reset(new TaskSourceGradeHolder{task_source_grade});
   return invocation;
 }
@@ -149,7 +214,8 @@ void MessageLoopTaskQueues::WakeUpUnlocked(TaskQueueId queue_id,
 }
 
 size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  UniqueLock lock(*queue_mutex_);
+  FlushImmediateTasksUnlocked(queue_id);
   const auto& queue_entry = queue_entries_.at(queue_id);
   if (queue_entry->subsumed_by != _kUnmerged) {
     return 0;
@@ -169,20 +235,20 @@ size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
 void MessageLoopTaskQueues::AddTaskObserver(TaskQueueId queue_id,
                                             intptr_t key,
                                             const fml::closure& callback) {
-  std::lock_guard guard(queue_mutex_);
+  UniqueLock lock(*queue_mutex_);
   FML_DCHECK(callback != nullptr) << "Observer callback must be non-null.";
   queue_entries_.at(queue_id)->task_observers[key] = callback;
 }
 
 void MessageLoopTaskQueues::RemoveTaskObserver(TaskQueueId queue_id,
                                                intptr_t key) {
-  std::lock_guard guard(queue_mutex_);
+  UniqueLock lock(*queue_mutex_);
   queue_entries_.at(queue_id)->task_observers.erase(key);
 }
 
 std::vector<fml::closure> MessageLoopTaskQueues::GetObserversToNotify(
     TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  UniqueLock lock(*queue_mutex_);
   std::vector<fml::closure> observers;
 
   if (queue_entries_.at(queue_id)->subsumed_by != _kUnmerged) {
@@ -205,7 +271,7 @@ std::vector<fml::closure> MessageLoopTaskQueues::GetObserversToNotify(
 
 void MessageLoopTaskQueues::SetWakeable(TaskQueueId queue_id,
                                         fml::Wakeable* wakeable) {
-  std::lock_guard guard(queue_mutex_);
+  UniqueLock lock(*queue_mutex_);
   FML_CHECK(!queue_entries_.at(queue_id)->wakeable)
       << "Wakeable can only be set once.";
   queue_entries_.at(queue_id)->wakeable = wakeable;
@@ -215,7 +281,7 @@ bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
   if (owner == subsumed) {
     return true;
   }
-  std::lock_guard guard(queue_mutex_);
+  UniqueLock lock(*queue_mutex_);
   auto& owner_entry = queue_entries_.at(owner);
   auto& subsumed_entry = queue_entries_.at(subsumed);
   auto& subsumed_set = owner_entry->owner_of;
@@ -255,6 +321,7 @@ bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
   owner_entry->owner_of.insert(subsumed);
   subsumed_entry->subsumed_by = owner;
 
+  FlushImmediateTasksUnlocked(owner);
   if (HasPendingTasksUnlocked(owner)) {
     WakeUpUnlocked(owner, GetNextWakeTimeUnlocked(owner));
   }
@@ -263,7 +330,7 @@ bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
 }
 
 bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner, TaskQueueId subsumed) {
-  std::lock_guard guard(queue_mutex_);
+  UniqueLock lock(*queue_mutex_);
   const auto& owner_entry = queue_entries_.at(owner);
   if (owner_entry->owner_of.empty()) {
     FML_LOG(WARNING)
@@ -294,6 +361,8 @@ bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner, TaskQueueId subsumed) {
   queue_entries_.at(subsumed)->subsumed_by = _kUnmerged;
   owner_entry->owner_of.erase(subsumed);
 
+  FlushImmediateTasksUnlocked(owner);
+  FlushImmediateTasksUnlocked(subsumed);
   if (HasPendingTasksUnlocked(owner)) {
     WakeUpUnlocked(owner, GetNextWakeTimeUnlocked(owner));
   }
@@ -307,7 +376,7 @@ bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner, TaskQueueId subsumed) {
 
 bool MessageLoopTaskQueues::Owns(TaskQueueId owner,
                                  TaskQueueId subsumed) const {
-  std::lock_guard guard(queue_mutex_);
+  UniqueLock lock(*queue_mutex_);
   if (owner == _kUnmerged || subsumed == _kUnmerged) {
     return false;
   }
@@ -317,24 +386,34 @@ bool MessageLoopTaskQueues::Owns(TaskQueueId owner,
 
 std::set<TaskQueueId> MessageLoopTaskQueues::GetSubsumedTaskQueueId(
     TaskQueueId owner) const {
-  std::lock_guard guard(queue_mutex_);
+  UniqueLock lock(*queue_mutex_);
   return queue_entries_.at(owner)->owner_of;
 }
 
 void MessageLoopTaskQueues::PauseSecondarySource(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  UniqueLock lock(*queue_mutex_);
   queue_entries_.at(queue_id)->task_source->PauseSecondary();
 }
 
 void MessageLoopTaskQueues::ResumeSecondarySource(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  UniqueLock lock(*queue_mutex_);
   queue_entries_.at(queue_id)->task_source->ResumeSecondary();
   // Schedule a wake as needed.
+  FlushImmediateTasksUnlocked(queue_id);
   if (HasPendingTasksUnlocked(queue_id)) {
     WakeUpUnlocked(queue_id, GetNextWakeTimeUnlocked(queue_id));
   }
 }
 
+void MessageLoopTaskQueues::FlushImmediateTasksUnlocked(
+    TaskQueueId queue_id) const {
+  const auto& entry = queue_entries_.at(queue_id);
+  entry->task_source->FlushImmediateTasks();
+  for (TaskQueueId subsumed : entry->owner_of) {
+    queue_entries_.at(subsumed)->task_source->FlushImmediateTasks();
+  }
+}
+
 // Subsumed queues will never have pending tasks.
 // Owning queues will consider both their and their subsumed tasks.
 bool MessageLoopTaskQueues::HasPendingTasksUnlocked(
@@ -398,4 +477,50 @@ TaskSource::TopTask MessageLoopTaskQueues::PeekNextTaskUnlocked(
   return top_task.value();
 }
 
+void MessageLoopTaskQueues::EnableStats() {
+  stats_enabled_.store(true, std::memory_order_relaxed);
+}
+
+void MessageLoopTaskQueues::RecordTaskRunTime(TaskQueueId queue_id,
+                                              fml::TimeDelta run_time) {
+  UniqueLock lock(*queue_mutex_);
+  auto running_entry = queue_entries_.find(queue_id);
+  if (running_entry == queue_entries_.end() ||
+      !running_entry->second->running_task.has_value()) {
+    return;
+  }
+  const auto task = running_entry->second->running_task.value();
+  running_entry->second->running_task.reset();
+  // The task may have disposed of the queue it came from.
+  auto task_entry = queue_entries_.find(task.task_queue_id);
+  if (task_entry == queue_entries_.end()) {
+    return;
+  }
+  TaskQueueStats& stats = task_entry->second->stats;
+  auto& grade_stats = stats.GetGradeStats(task.task_source_grade);
+  grade_stats.latency.Add(task.latency);
+  grade_stats.run_time.Add(run_time);
+  auto& poster_stats = stats.posters[task.poster];
+  poster_stats.count++;
+  poster_stats.total_latency = poster_stats.total_latency + task.latency;
+  poster_stats.total_run_time = poster_stats.total_run_time + run_time;
+}
+
+TaskQueueStats MessageLoopTaskQueues::GetStats(TaskQueueId queue_id) const {
+  UniqueLock lock(*queue_mutex_);
+  auto entry = queue_entries_.find(queue_id);
+  if (entry == queue_entries_.end()) {
+    return {};
+  }
+  return entry->second->stats;
+}
+
+void MessageLoopTaskQueues::ResetStats(TaskQueueId queue_id) {
+  UniqueLock lock(*queue_mutex_);
+  auto entry = queue_entries_.find(queue_id);
+  if (entry != queue_entries_.end()) {
+    entry->second->stats = {};
+  }
+}
+
 }  // namespace fml
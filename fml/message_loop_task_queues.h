@@ -5,9 +5,11 @@
 #ifndef FLUTTER_FML_MESSAGE_LOOP_TASK_QUEUES_H_
 #define FLUTTER_FML_MESSAGE_LOOP_TASK_QUEUES_H_
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <set>
 #include <vector>
 
@@ -17,6 +19,7 @@
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/synchronization/shared_mutex.h"
 #include "flutter/fml/task_queue_id.h"
+#include "flutter/fml/task_queue_stats.h"
 #include "flutter/fml/task_source.h"
 #include "flutter/fml/wakeable.h"
 
@@ -46,6 +49,20 @@ class TaskQueueEntry {
 
   TaskQueueId created_for;
 
+  /// The statistics of the tasks of this TaskQueue, kept only while
+  /// \p fml::MessageLoopTaskQueues::EnableStats is on.
+  TaskQueueStats stats;
+
+  /// The task that the loop of this TaskQueue is running, from this or from a
+  /// subsumed TaskQueue, whose run time is yet to be recorded in the stats.
+  struct RunningTask {
+    TaskQueueId task_queue_id = _kUnmerged;
+    TaskSourceGrade task_source_grade = TaskSourceGrade::kUnspecified;
+    size_t poster = TaskQueueStats::kExternalPoster;
+    fml::TimeDelta latency;
+  };
+  std::optional<RunningTask> running_task;
+
   explicit TaskQueueEntry(TaskQueueId created_for);
 
  private:
@@ -137,6 +154,26 @@ class MessageLoopTaskQueues {
 
   void ResumeSecondarySource(TaskQueueId queue_id);
 
+  // Stats.
+
+  /// Starts collecting the latency and the run time of the tasks of all the
+  /// task queues. This adds a lookup of the task queue of the posting thread
+  /// to every post, and a clock read and a lock after every task, so it is
+  /// only enabled by the `--enable-task-queue-stats` switch.
+  void EnableStats();
+
+  bool IsStatsEnabled() const {
+    return stats_enabled_.load(std::memory_order_relaxed);
+  }
+
+  /// Records the run time of the task last returned by \p GetNextTaskToRun
+  /// for \p queue_id. Called by the message loop after running the task.
+  void RecordTaskRunTime(TaskQueueId queue_id, fml::TimeDelta run_time);
+
+  TaskQueueStats GetStats(TaskQueueId queue_id) const;
+
+  void ResetStats(TaskQueueId queue_id);
+
  private:
   class MergedQueuesRunner;
 
@@ -144,21 +181,32 @@ class MessageLoopTaskQueues {
 
   ~MessageLoopTaskQueues();
 
+  void RegisterImmediateTask(TaskQueueId queue_id,
+                             const fml::closure& task,
+                             fml::TimePoint target_time,
+                             fml::TaskSourceGrade task_source_grade);
+
   void WakeUpUnlocked(TaskQueueId queue_id, fml::TimePoint time) const;
 
+  void FlushImmediateTasksUnlocked(TaskQueueId queue_id) const;
+
   bool HasPendingTasksUnlocked(TaskQueueId queue_id) const;
 
   TaskSource::TopTask PeekNextTaskUnlocked(TaskQueueId owner) const;
 
   fml::TimePoint GetNextWakeTimeUnlocked(TaskQueueId queue_id) const;
 
-  mutable std::mutex queue_mutex_;
+  // Held exclusively by everything but the registration of immediate tasks,
+  // which only needs to exclude the consumers of the task heaps.
+  std::unique_ptr<SharedMutex> queue_mutex_;
   std::map<TaskQueueId, std::unique_ptr<TaskQueueEntry>> queue_entries_;
 
   size_t task_queue_id_counter_;
 
   std::atomic_int order_;
 
+  std::atomic<bool> stats_enabled_ = false;
+
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(MessageLoopTaskQueues);
 };
 
@@ -66,5 +66,49 @@ static void BM_RegisterAndGetTasks(benchmark::State& state) {  // NOLINT
 
 BENCHMARK(BM_RegisterAndGetTasks);
 
+// Measures how posting scales with the number of threads that concurrently
+// post immediate tasks to a single task queue that is being drained.
+static void BM_RegisterTasksFromManyThreads(
+    benchmark::State& state) {  // NOLINT
+  const int num_producers = state.range(0);
+  const int num_tasks_per_producer = 1000;
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  const auto queue_id = task_queue->CreateTaskQueue();
+
+  while (state.KeepRunning()) {
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_producers; i++) {
+      threads.emplace_back([&task_queue, queue_id]() {
+        for (int j = 0; j < num_tasks_per_producer; j++) {
+          task_queue->RegisterTask(
+              queue_id, [] {}, fml::TimePoint::Now());
+        }
+      });
+    }
+
+    int num_invocations = 0;
+    while (num_invocations < num_producers * num_tasks_per_producer) {
+      fml::closure invocation =
+          task_queue->GetNextTaskToRun(queue_id, fml::TimePoint::Now());
+      if (invocation) {
+        num_invocations++;
+      }
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  task_queue->Dispose(queue_id);
+  state.SetItemsProcessed(state.iterations() * num_producers *
+                          num_tasks_per_producer);
+}
+
+BENCHMARK(BM_RegisterTasksFromManyThreads)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime();
+
 }  // namespace benchmarking
 }  // namespace fml
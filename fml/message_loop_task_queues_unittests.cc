@@ -10,6 +10,7 @@
 #include <cstdlib>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
@@ -451,5 +452,124 @@ TEST(MessageLoopTaskQueue, RegisterTaskWakesUpOwnerQueue) {
   ASSERT_EQ(time1, wakes[2]);
 }
 
+
+TEST(MessageLoopTaskQueue, ConcurrentImmediateTasksPreservePostingOrder) {
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queues->CreateTaskQueue();
+
+  constexpr size_t kThreadCount = 8;
+  constexpr size_t kThreadTaskCount = 500;
+
+  std::vector<std::vector<size_t>> ran(kThreadCount);
+  std::vector<std::thread> threads;
+  for (size_t thread = 0; thread < kThreadCount; thread++) {
+    threads.emplace_back([&, thread]() {
+      for (size_t i = 0; i < kThreadTaskCount; i++) {
+        task_queues->RegisterTask(
+            queue_id, [&ran, thread, i]() { ran[thread].push_back(i); },
+            ChronoTicksSinceEpoch());
+      }
+    });
+  }
+
+  // Drain the queue while the tasks are being posted.
+  size_t invocations = 0u;
+  while (invocations < kThreadCount * kThreadTaskCount) {
+    auto invocation =
+        task_queues->GetNextTaskToRun(queue_id, ChronoTicksSinceEpoch());
+    if (!invocation) {
+      std::this_thread::yield();
+      continue;
+    }
+    invocation();
+    invocations++;
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_FALSE(task_queues->HasPendingTasks(queue_id));
+  for (const auto& thread_ran : ran) {
+    ASSERT_EQ(thread_ran.size(), kThreadTaskCount);
+    for (size_t i = 0; i < thread_ran.size(); i++) {
+      ASSERT_EQ(thread_ran[i], i);
+    }
+  }
+}
+
+TEST(MessageLoopTaskQueue, ImmediateTasksRunBeforeLaterDelayedTasks) {
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queues->CreateTaskQueue();
+
+  std::vector<int> ran;
+  const auto now = ChronoTicksSinceEpoch();
+  task_queues->RegisterTask(
+      queue_id, [&ran]() { ran.push_back(2); },
+      now + fml::TimeDelta::FromMilliseconds(1));
+  task_queues->RegisterTask(
+      queue_id, [&ran]() { ran.push_back(1); }, now);
+  ASSERT_EQ(task_queues->GetNumPendingTasks(queue_id), 2u);
+
+  const auto later = now + fml::TimeDelta::FromMilliseconds(2);
+  while (auto invocation = task_queues->GetNextTaskToRun(queue_id, later)) {
+    invocation();
+  }
+  ASSERT_EQ(ran, (std::vector<int>{1, 2}));
+}
+
+TEST(MessageLoopTaskQueue, ImmediateSecondaryTasksDoNotWakeWhilePaused) {
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queues->CreateTaskQueue();
+
+  size_t wakes = 0u;
+  auto wakeable = std::make_unique<TestWakeable>(
+      [&wakes](fml::TimePoint wake_time) { wakes++; });
+  task_queues->SetWakeable(queue_id, wakeable.get());
+
+  task_queues->PauseSecondarySource(queue_id);
+  task_queues->RegisterTask(
+      queue_id, []() {}, ChronoTicksSinceEpoch(),
+      TaskSourceGrade::kDartMicroTasks);
+  ASSERT_EQ(wakes, 0u);
+  ASSERT_FALSE(task_queues->HasPendingTasks(queue_id));
+
+  task_queues->ResumeSecondarySource(queue_id);
+  ASSERT_EQ(wakes, 1u);
+  ASSERT_TRUE(task_queues->HasPendingTasks(queue_id));
+}
+
+TEST(MessageLoopTaskQueue, RecordsStatsOfTheTasksThatRan) {
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  task_queues->EnableStats();
+  auto queue_id = task_queues->CreateTaskQueue();
+
+  const auto now = ChronoTicksSinceEpoch();
+  task_queues->RegisterTask(
+      queue_id, []() {}, now - fml::TimeDelta::FromMilliseconds(4));
+  task_queues->RegisterTask(
+      queue_id, []() {}, now, TaskSourceGrade::kDartMicroTasks);
+  while (auto invocation = task_queues->GetNextTaskToRun(queue_id, now)) {
+    invocation();
+    task_queues->RecordTaskRunTime(queue_id,
+                                   fml::TimeDelta::FromMicroseconds(3));
+  }
+
+  auto stats = task_queues->GetStats(queue_id);
+  const auto& unspecified =
+      stats.GetGradeStats(TaskSourceGrade::kUnspecified);
+  ASSERT_EQ(unspecified.latency.count, 1u);
+  ASSERT_GE(unspecified.latency.max, fml::TimeDelta::FromMilliseconds(4));
+  ASSERT_EQ(unspecified.run_time.buckets[2], 1u);
+  ASSERT_EQ(stats.GetGradeStats(TaskSourceGrade::kDartMicroTasks)
+                .run_time.total,
+            fml::TimeDelta::FromMicroseconds(3));
+  ASSERT_EQ(stats.posters.size(), 1u);
+  ASSERT_EQ(stats.posters[TaskQueueStats::kExternalPoster].count, 2u);
+
+  task_queues->ResetStats(queue_id);
+  ASSERT_TRUE(task_queues->GetStats(queue_id).posters.empty());
+}
+
 }  // namespace testing
 }  // namespace fml
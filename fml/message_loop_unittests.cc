@@ -6,8 +6,12 @@
 
 #include "flutter/fml/message_loop.h"
 
+#include <atomic>
 #include <iostream>
+#include <set>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/concurrent_message_loop.h"
@@ -345,3 +349,100 @@ TEST(MessageLoop, CanCreateConcurrentMessageLoop) {
   latch.Wait();
   ASSERT_GE(thread_ids.size(), 1u);
 }
+
+TEST(MessageLoop, ConcurrentMessageLoopRunsHigherPriorityTasksFirst) {
+  auto loop = fml::ConcurrentMessageLoop::Create(1u);
+  auto task_runner = loop->GetTaskRunner();
+  fml::AutoResetWaitableEvent blocked;
+  fml::AutoResetWaitableEvent unblock;
+  task_runner->PostTask([&]() {
+    blocked.Signal();
+    unblock.Wait();
+  });
+  blocked.Wait();
+
+  std::vector<std::string> ran;
+  fml::CountDownLatch latch(3u);
+  task_runner->PostTask(
+      [&]() {
+        ran.push_back("low");
+        latch.CountDown();
+      },
+      fml::ConcurrentTaskPriority::kLow);
+  task_runner->PostTask([&]() {
+    ran.push_back("normal");
+    latch.CountDown();
+  });
+  task_runner->PostTask(
+      [&]() {
+        ran.push_back("high");
+        latch.CountDown();
+      },
+      fml::ConcurrentTaskPriority::kHigh);
+  unblock.Signal();
+  latch.Wait();
+  EXPECT_EQ(ran, (std::vector<std::string>{"high", "normal", "low"}));
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopWorkersStealTasks) {
+  auto loop = fml::ConcurrentMessageLoop::Create(2u);
+  auto task_runner = loop->GetTaskRunner();
+  fml::AutoResetWaitableEvent stolen_task_ran;
+  bool stolen = false;
+  fml::AutoResetWaitableEvent done;
+  task_runner->PostTask([&]() {
+    // This task is queued on the busy worker and has to be run by the other
+    // one.
+    task_runner->PostTask([&]() { stolen_task_ran.Signal(); });
+    stolen = !stolen_task_ran.WaitWithTimeout(fml::TimeDelta::FromSeconds(5));
+    done.Signal();
+  });
+  done.Wait();
+  EXPECT_TRUE(stolen);
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopRunsAllTasksOfBursts) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4u);
+  auto task_runner = loop->GetTaskRunner();
+  const size_t kCount = 1000u;
+  std::atomic<size_t> count = 0u;
+  // The tasks posting tasks also count down once they are done posting.
+  fml::CountDownLatch latch(kCount + kCount / 2u);
+  auto task = [&]() {
+    count++;
+    latch.CountDown();
+  };
+  for (size_t i = 0; i < kCount; ++i) {
+    if (i % 2 == 0) {
+      task_runner->PostTask(task);
+    } else {
+      // Half of the tasks are posted from workers.
+      task_runner->PostTask([&]() {
+        task_runner->PostTask(task);
+        latch.CountDown();
+      });
+    }
+  }
+  latch.Wait();
+  EXPECT_EQ(count, kCount);
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopPostsTasksToWorkers) {
+  auto loop = fml::ConcurrentMessageLoop::Create(3u);
+  std::mutex thread_ids_mutex;
+  std::set<std::thread::id> thread_ids;
+  fml::CountDownLatch latch(loop->GetWorkerCount());
+  for (size_t i = 0; i < loop->GetWorkerCount(); ++i) {
+    loop->PostTaskToWorker(i, [&]() {
+      EXPECT_TRUE(loop->RunsTasksOnCurrentThread());
+      {
+        std::scoped_lock lock(thread_ids_mutex);
+        thread_ids.insert(std::this_thread::get_id());
+      }
+      latch.CountDown();
+    });
+  }
+  latch.Wait();
+  EXPECT_EQ(thread_ids.size(), loop->GetWorkerCount());
+  EXPECT_FALSE(loop->RunsTasksOnCurrentThread());
+}
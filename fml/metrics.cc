@@ -0,0 +1,40 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/metrics.h"
+
+namespace fml {
+
+MetricsRegistry::MetricsRegistry() = default;
+
+MetricsRegistry::~MetricsRegistry() = default;
+
+MetricsRegistry& MetricsRegistry::GetInstance() {
+  // Counters may be updated by threads that outlive static destruction.
+  static MetricsRegistry* registry = new MetricsRegistry();
+  return *registry;
+}
+
+Counter* MetricsRegistry::GetCounter(std::string_view name) {
+  std::scoped_lock lock(mutex_);
+  auto found = counters_.find(name);
+  if (found == counters_.end()) {
+    found =
+        counters_.emplace(std::string(name), std::make_unique<Counter>()).first;
+  }
+  return found->second.get();
+}
+
+std::vector<std::pair<std::string, int64_t>>
+MetricsRegistry::GetCounterValues() const {
+  std::scoped_lock lock(mutex_);
+  std::vector<std::pair<std::string, int64_t>> values;
+  values.reserve(counters_.size());
+  for (const auto& [name, counter] : counters_) {
+    values.emplace_back(name, counter->GetValue());
+  }
+  return values;
+}
+
+}  // namespace fml
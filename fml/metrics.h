@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_METRICS_H_
+#define FLUTTER_FML_METRICS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+// Adds |delta| to the process-wide counter named |name|. The counter is looked
+// up once per call site, after which adding to it is a single relaxed atomic
+// addition.
+#define FML_COUNTER_ADD(name, delta)                            \
+  do {                                                          \
+    static ::fml::Counter* const __fml_counter =                \
+        ::fml::MetricsRegistry::GetInstance().GetCounter(name); \
+    __fml_counter->Add(static_cast<int64_t>(delta));            \
+  } while (0)
+
+#define FML_COUNTER_INCREMENT(name) FML_COUNTER_ADD(name, 1)
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      A counter that only grows for the lifetime of the process.
+///
+///             Counters are cheap enough to be updated in production builds.
+///             Consumers sample them periodically, for example once per frame,
+///             and report the differences between samples.
+///
+class Counter {
+ public:
+  Counter() = default;
+
+  void Add(int64_t delta) {
+    value_.fetch_add(delta, std::memory_order_relaxed);
+  }
+
+  int64_t GetValue() const { return value_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<int64_t> value_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(Counter);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      The counters of the process, by name.
+///
+///             Counter names are dot separated, starting with the subsystem
+///             that updates them, for example `impeller.draw_calls`.
+///
+///             This class is thread-safe.
+///
+class MetricsRegistry {
+ public:
+  static MetricsRegistry& GetInstance();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the counter named |name|, creating it if needed. The
+  ///             counter lives as long as the process.
+  ///
+  Counter* GetCounter(std::string_view name);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the names and values of all counters, sorted by name.
+  ///
+  std::vector<std::pair<std::string, int64_t>> GetCounterValues() const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::map<std::string, std::unique_ptr<Counter>, std::less<>> counters_;
+
+  MetricsRegistry();
+
+  ~MetricsRegistry();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(MetricsRegistry);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_METRICS_H_
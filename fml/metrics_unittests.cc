@@ -0,0 +1,59 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/metrics.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+namespace {
+
+int64_t GetValue(const std::string& name) {
+  for (const auto& [counter_name, value] :
+       MetricsRegistry::GetInstance().GetCounterValues()) {
+    if (counter_name == name) {
+      return value;
+    }
+  }
+  return -1;
+}
+
+}  // namespace
+
+TEST(MetricsTest, CountersAreSharedByName) {
+  auto& registry = MetricsRegistry::GetInstance();
+  auto* counter = registry.GetCounter("fml.test.shared");
+  EXPECT_EQ(registry.GetCounter("fml.test.shared"), counter);
+
+  const int64_t initial = counter->GetValue();
+  FML_COUNTER_ADD("fml.test.shared", 3);
+  FML_COUNTER_INCREMENT("fml.test.shared");
+  EXPECT_EQ(counter->GetValue(), initial + 4);
+  EXPECT_EQ(GetValue("fml.test.shared"), initial + 4);
+}
+
+TEST(MetricsTest, CountersCanBeUpdatedConcurrently) {
+  auto* counter = MetricsRegistry::GetInstance().GetCounter("fml.test.threads");
+  const int64_t initial = counter->GetValue();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([] {
+      for (int j = 0; j < 1000; j++) {
+        FML_COUNTER_INCREMENT("fml.test.threads");
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(counter->GetValue(), initial + 4000);
+}
+
+}  // namespace testing
+}  // namespace fml
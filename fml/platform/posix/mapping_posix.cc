@@ -9,6 +9,7 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <type_traits>
 
 #include "flutter/fml/build_config.h"
@@ -36,6 +37,26 @@ static int ToPosixProtectionFlags(
   return flags;
 }
 
+static int ToPosixAdvice(FileMapping::Advice advice) {
+  switch (advice) {
+    case FileMapping::Advice::kNormal:
+      return MADV_NORMAL;
+    case FileMapping::Advice::kSequential:
+      return MADV_SEQUENTIAL;
+    case FileMapping::Advice::kRandom:
+      return MADV_RANDOM;
+    case FileMapping::Advice::kWillNeed:
+      return MADV_WILLNEED;
+    case FileMapping::Advice::kDontNeed:
+      return MADV_DONTNEED;
+  }
+  return MADV_NORMAL;
+}
+
+static size_t GetPageSize() {
+  return static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+}
+
 static bool IsWritable(
     std::initializer_list<FileMapping::Protection> protection_flags) {
   for (auto protection : protection_flags) {
@@ -51,6 +72,15 @@ Mapping::Mapping() = default;
 Mapping::~Mapping() = default;
 
 FileMapping::FileMapping(const fml::UniqueFD& handle,
+                         std::initializer_list<Protection> protection)
+    : FileMapping(handle,
+                  0,
+                  std::numeric_limits<size_t>::max(),
+                  protection) {}
+
+FileMapping::FileMapping(const fml::UniqueFD& handle,
+                         size_t offset,
+                         size_t length,
                          std::initializer_list<Protection> protection) {
   if (!handle.is_valid()) {
     return;
@@ -62,23 +92,34 @@ FileMapping::FileMapping(const fml::UniqueFD& handle,
     return;
   }
 
-  if (stat_buffer.st_size == 0) {
+  const auto file_size = static_cast<size_t>(stat_buffer.st_size);
+  if (offset > file_size) {
+    return;
+  }
+
+  length = std::min(length, file_size - offset);
+  if (length == 0) {
     valid_ = true;
     return;
   }
 
   const auto is_writable = IsWritable(protection);
 
-  auto* mapping =
-      ::mmap(nullptr, stat_buffer.st_size, ToPosixProtectionFlags(protection),
-             is_writable ? MAP_SHARED : MAP_PRIVATE, handle.get(), 0);
+  // The offset of the mapped pages in the file must be page aligned.
+  const size_t mapping_offset = offset % GetPageSize();
+
+  auto* mapping = ::mmap(nullptr, length + mapping_offset,
+                         ToPosixProtectionFlags(protection),
+                         is_writable ? MAP_SHARED : MAP_PRIVATE, handle.get(),
+                         offset - mapping_offset);
 
   if (mapping == MAP_FAILED) {
     return;
   }
 
-  mapping_ = static_cast<uint8_t*>(mapping);
-  size_ = stat_buffer.st_size;
+  mapping_offset_ = mapping_offset;
+  mapping_ = static_cast<uint8_t*>(mapping) + mapping_offset_;
+  size_ = length;
   valid_ = true;
   if (is_writable) {
     mutable_mapping_ = mapping_;
@@ -87,7 +128,7 @@ FileMapping::FileMapping(const fml::UniqueFD& handle,
 
 FileMapping::~FileMapping() {
   if (mapping_ != nullptr) {
-    ::munmap(mapping_, size_);
+    ::munmap(mapping_ - mapping_offset_, size_ + mapping_offset_);
   }
 }
 
@@ -107,4 +148,20 @@ bool FileMapping::IsValid() const {
   return valid_;
 }
 
+bool FileMapping::Advise(Advice advice, size_t offset, size_t length) const {
+  if (mapping_ == nullptr || offset >= size_) {
+    return false;
+  }
+  if (advice == Advice::kDontNeed && !IsDontNeedSafe()) {
+    return false;
+  }
+  length = std::min(length, size_ - offset);
+  // The start of the mapped pages is page aligned, so rounding the start of
+  // the range down to a page boundary keeps it within the mapping.
+  const auto start = reinterpret_cast<uintptr_t>(mapping_ + offset);
+  const auto aligned_start = start - start % GetPageSize();
+  return ::madvise(reinterpret_cast<void*>(aligned_start),
+                   start + length - aligned_start, ToPosixAdvice(advice)) == 0;
+}
+
 }  // namespace fml
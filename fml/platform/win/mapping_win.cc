@@ -8,6 +8,7 @@
 #include <io.h>
 #include <windows.h>
 
+#include <algorithm>
 #include <type_traits>
 
 #include "flutter/fml/file.h"
@@ -42,18 +43,30 @@ static bool IsExecutable(
 
 FileMapping::FileMapping(const fml::UniqueFD& fd,
                          std::initializer_list<Protection> protections)
+    : FileMapping(fd, 0, std::numeric_limits<size_t>::max(), protections) {}
+
+FileMapping::FileMapping(const fml::UniqueFD& fd,
+                         size_t offset,
+                         size_t length,
+                         std::initializer_list<Protection> protections)
     : size_(0), mapping_(nullptr) {
   if (!fd.is_valid()) {
     return;
   }
 
-  const auto mapping_size = ::GetFileSize(fd.get(), nullptr);
+  const auto file_size = ::GetFileSize(fd.get(), nullptr);
 
-  if (mapping_size == INVALID_FILE_SIZE) {
+  if (file_size == INVALID_FILE_SIZE) {
     FML_DLOG(ERROR) << "Invalid file size. " << GetLastErrorMessage();
     return;
   }
 
+  if (offset > file_size) {
+    return;
+  }
+
+  const size_t mapping_size = std::min<size_t>(length, file_size - offset);
+
   if (mapping_size == 0) {
     valid_ = true;
     return;
@@ -84,8 +97,15 @@ FileMapping::FileMapping(const fml::UniqueFD& fd,
 
   const DWORD desired_access = read_only ? FILE_MAP_READ : FILE_MAP_WRITE;
 
+  // The offset of a view must be a multiple of the allocation granularity.
+  SYSTEM_INFO system_info;
+  ::GetSystemInfo(&system_info);
+  const size_t mapping_offset = offset % system_info.dwAllocationGranularity;
+  const auto view_offset = static_cast<DWORD>(offset - mapping_offset);
+
   auto mapping = reinterpret_cast<uint8_t*>(
-      MapViewOfFile(mapping_handle_.get(), desired_access, 0, 0, mapping_size));
+      MapViewOfFile(mapping_handle_.get(), desired_access, 0, view_offset,
+                    mapping_size + mapping_offset));
 
   if (mapping == nullptr) {
     FML_DLOG(ERROR) << "Could not set up file mapping. "
@@ -93,7 +113,8 @@ FileMapping::FileMapping(const fml::UniqueFD& fd,
     return;
   }
 
-  mapping_ = mapping;
+  mapping_offset_ = mapping_offset;
+  mapping_ = mapping + mapping_offset_;
   size_ = mapping_size;
   valid_ = true;
   if (IsWritable(protections)) {
@@ -103,7 +124,7 @@ FileMapping::FileMapping(const fml::UniqueFD& fd,
 
 FileMapping::~FileMapping() {
   if (mapping_ != nullptr) {
-    UnmapViewOfFile(mapping_);
+    UnmapViewOfFile(mapping_ - mapping_offset_);
   }
 }
 
@@ -123,4 +144,9 @@ bool FileMapping::IsValid() const {
   return valid_;
 }
 
+bool FileMapping::Advise(Advice advice, size_t offset, size_t length) const {
+  // Access hints for views of file mappings are not supported.
+  return false;
+}
+
 }  // namespace fml
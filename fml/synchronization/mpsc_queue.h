@@ -0,0 +1,100 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_SYNCHRONIZATION_MPSC_QUEUE_H_
+#define FLUTTER_FML_SYNCHRONIZATION_MPSC_QUEUE_H_
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+/// An unbounded, lock-free, multiple producer single consumer FIFO queue.
+///
+/// Any number of threads may call |Push| concurrently. Only one thread at a
+/// time may call |Pop|, |IsEmpty| or |Clear|.
+///
+/// Elements pushed by a producer become visible to the consumer once |Push|
+/// has returned on that producer. |Pop| may still return |std::nullopt| while
+/// a concurrent |Push| is in progress even though elements pushed after it
+/// have already completed. Callers that need to observe all completed pushes
+/// must make sure no push is in progress, for instance, by holding a lock that
+/// excludes producers.
+///
+/// This is a variant of the queue described by Dmitry Vyukov in
+/// https://www.1024cores.net/home/lock-free-algorithms/queues/non-intrusive-mpsc-node-based-queue
+template <class T>
+class MpscQueue {
+ public:
+  MpscQueue() : head_(&stub_), tail_(&stub_) {}
+
+  ~MpscQueue() {
+    Clear();
+    if (tail_ != &stub_) {
+      delete tail_;
+    }
+  }
+
+  /// Adds an element at the end of the queue. Thread safe.
+  void Push(T value) {
+    Node* node = new Node(std::move(value));
+    Node* previous = head_.exchange(node, std::memory_order_acq_rel);
+    previous->next.store(node, std::memory_order_release);
+  }
+
+  /// Removes the element at the front of the queue. May only be called by the
+  /// consumer.
+  std::optional<T> Pop() {
+    Node* tail = tail_;
+    Node* next = tail->next.load(std::memory_order_acquire);
+    if (next == nullptr) {
+      return std::nullopt;
+    }
+    // The value of the new tail has been consumed. It now acts as the stub.
+    std::optional<T> value = std::move(next->value);
+    next->value.reset();
+    tail_ = next;
+    if (tail != &stub_) {
+      delete tail;
+    }
+    return value;
+  }
+
+  /// Whether the queue has no elements visible to the consumer. May only be
+  /// called by the consumer.
+  bool IsEmpty() const {
+    return tail_->next.load(std::memory_order_acquire) == nullptr;
+  }
+
+  /// Drops all elements visible to the consumer. May only be called by the
+  /// consumer.
+  void Clear() {
+    while (Pop().has_value()) {
+    }
+  }
+
+ private:
+  struct Node {
+    Node() = default;
+
+    explicit Node(T p_value) : value(std::move(p_value)) {}
+
+    std::atomic<Node*> next = nullptr;
+    std::optional<T> value;
+  };
+
+  Node stub_;
+  std::atomic<Node*> head_;
+  // Only accessed by the consumer.
+  Node* tail_;
+
+  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(MpscQueue);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_SYNCHRONIZATION_MPSC_QUEUE_H_
@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/synchronization/mpsc_queue.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+
+namespace fml {
+namespace testing {
+
+TEST(MpscQueueTest, StartsEmpty) {
+  MpscQueue<int> queue;
+  ASSERT_TRUE(queue.IsEmpty());
+  ASSERT_FALSE(queue.Pop().has_value());
+}
+
+TEST(MpscQueueTest, PopsInPushOrder) {
+  MpscQueue<int> queue;
+  for (int i = 0; i < 10; i++) {
+    queue.Push(i);
+  }
+  ASSERT_FALSE(queue.IsEmpty());
+  for (int i = 0; i < 10; i++) {
+    auto value = queue.Pop();
+    ASSERT_TRUE(value.has_value());
+    ASSERT_EQ(value.value(), i);
+  }
+  ASSERT_TRUE(queue.IsEmpty());
+}
+
+TEST(MpscQueueTest, ClearDropsElements) {
+  auto element = std::make_shared<int>(42);
+  {
+    MpscQueue<std::shared_ptr<int>> queue;
+    queue.Push(element);
+    queue.Push(element);
+    ASSERT_EQ(element.use_count(), 3);
+    queue.Clear();
+    ASSERT_TRUE(queue.IsEmpty());
+    ASSERT_EQ(element.use_count(), 1);
+    queue.Push(element);
+  }
+  // The destructor drops the remaining elements.
+  ASSERT_EQ(element.use_count(), 1);
+}
+
+TEST(MpscQueueTest, PreservesPerProducerOrder) {
+  constexpr size_t kProducerCount = 8;
+  constexpr size_t kElementCount = 10000;
+
+  MpscQueue<std::pair<size_t, size_t>> queue;
+  std::vector<std::thread> producers;
+  for (size_t producer = 0; producer < kProducerCount; producer++) {
+    producers.emplace_back([&queue, producer]() {
+      for (size_t i = 0; i < kElementCount; i++) {
+        queue.Push({producer, i});
+      }
+    });
+  }
+
+  // Consume concurrently with the producers.
+  std::vector<size_t> next(kProducerCount, 0u);
+  size_t popped = 0u;
+  while (popped < kProducerCount * kElementCount) {
+    auto value = queue.Pop();
+    if (!value.has_value()) {
+      std::this_thread::yield();
+      continue;
+    }
+    ASSERT_EQ(value->second, next[value->first]);
+    next[value->first]++;
+    popped++;
+  }
+
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  ASSERT_TRUE(queue.IsEmpty());
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -0,0 +1,28 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/task_queue_stats.h"
+
+#include <algorithm>
+
+namespace fml {
+
+void TaskDurationHistogram::Add(fml::TimeDelta duration) {
+  buckets[GetBucketIndex(duration)]++;
+  count++;
+  total = total + duration;
+  max = std::max(max, duration);
+}
+
+size_t TaskDurationHistogram::GetBucketIndex(fml::TimeDelta duration) {
+  int64_t micros = duration.ToMicroseconds();
+  size_t index = 0u;
+  while (micros > 0 && index < kBucketCount - 1) {
+    micros >>= 1;
+    index++;
+  }
+  return index;
+}
+
+}  // namespace fml
@@ -0,0 +1,78 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TASK_QUEUE_STATS_H_
+#define FLUTTER_FML_TASK_QUEUE_STATS_H_
+
+#include <array>
+#include <cstdint>
+#include <map>
+
+#include "flutter/fml/task_source_grade.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      A histogram of durations with power of two buckets.
+///
+struct TaskDurationHistogram {
+  /// Bucket 0 counts the durations under 1us, and bucket i the durations in
+  /// [2^(i - 1), 2^i) microseconds. The last bucket also counts all longer
+  /// durations, and starts at about half a second.
+  static constexpr size_t kBucketCount = 21u;
+
+  std::array<uint64_t, kBucketCount> buckets = {};
+  uint64_t count = 0u;
+  fml::TimeDelta total;
+  fml::TimeDelta max;
+
+  void Add(fml::TimeDelta duration);
+
+  static size_t GetBucketIndex(fml::TimeDelta duration);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      The statistics of the tasks that ran from one task queue,
+///             collected by `MessageLoopTaskQueues` once enabled with
+///             `MessageLoopTaskQueues::EnableStats`.
+///
+///             The latency of a task is the time from when it was due to when
+///             it started running. For tasks posted without a delay, that is
+///             the time they waited in the queue.
+///
+struct TaskQueueStats {
+  /// The id of the poster of tasks that were posted from a thread without a
+  /// message loop.
+  static constexpr size_t kExternalPoster = static_cast<size_t>(-1);
+
+  struct GradeStats {
+    TaskDurationHistogram latency;
+    TaskDurationHistogram run_time;
+  };
+
+  struct PosterStats {
+    uint64_t count = 0u;
+    fml::TimeDelta total_latency;
+    fml::TimeDelta total_run_time;
+  };
+
+  /// Indexed by `TaskSourceGrade`.
+  std::array<GradeStats, 3> grades;
+  /// By the id of the task queue of the thread the tasks were posted from, or
+  /// `kExternalPoster`.
+  std::map<size_t, PosterStats> posters;
+
+  GradeStats& GetGradeStats(TaskSourceGrade grade) {
+    return grades[static_cast<size_t>(grade)];
+  }
+
+  const GradeStats& GetGradeStats(TaskSourceGrade grade) const {
+    return grades[static_cast<size_t>(grade)];
+  }
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TASK_QUEUE_STATS_H_
@@ -0,0 +1,40 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/task_queue_stats.h"
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(TaskDurationHistogramTest, BucketsDurationsByPowersOfTwo) {
+  using Histogram = TaskDurationHistogram;
+  EXPECT_EQ(Histogram::GetBucketIndex(fml::TimeDelta::Zero()), 0u);
+  EXPECT_EQ(Histogram::GetBucketIndex(fml::TimeDelta::FromNanoseconds(999)),
+            0u);
+  EXPECT_EQ(Histogram::GetBucketIndex(fml::TimeDelta::FromMicroseconds(1)),
+            1u);
+  EXPECT_EQ(Histogram::GetBucketIndex(fml::TimeDelta::FromMicroseconds(3)),
+            2u);
+  EXPECT_EQ(Histogram::GetBucketIndex(fml::TimeDelta::FromMicroseconds(4)),
+            3u);
+  EXPECT_EQ(Histogram::GetBucketIndex(fml::TimeDelta::FromSeconds(60)),
+            Histogram::kBucketCount - 1);
+}
+
+TEST(TaskDurationHistogramTest, TracksCountTotalAndMax) {
+  TaskDurationHistogram histogram;
+  histogram.Add(fml::TimeDelta::FromMicroseconds(10));
+  histogram.Add(fml::TimeDelta::FromMicroseconds(30));
+
+  EXPECT_EQ(histogram.count, 2u);
+  EXPECT_EQ(histogram.total, fml::TimeDelta::FromMicroseconds(40));
+  EXPECT_EQ(histogram.max, fml::TimeDelta::FromMicroseconds(30));
+  EXPECT_EQ(histogram.buckets[4], 1u);
+  EXPECT_EQ(histogram.buckets[5], 1u);
+}
+
+}  // namespace testing
+}  // namespace fml
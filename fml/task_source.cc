@@ -16,6 +16,7 @@ TaskSource::~TaskSource() {
 }
 
 void TaskSource::ShutDown() {
+  immediate_tasks_.Clear();
   primary_task_queue_ = {};
   secondary_task_queue_ = {};
 }
@@ -34,6 +35,18 @@ void TaskSource::RegisterTask(const DelayedTask& task) {
   }
 }
 
+bool TaskSource::RegisterImmediateTask(const DelayedTask& task) {
+  immediate_tasks_.Push(task);
+  return task.GetTaskSourceGrade() != TaskSourceGrade::kDartMicroTasks ||
+         secondary_pause_requests_ == 0;
+}
+
+void TaskSource::FlushImmediateTasks() {
+  while (auto task = immediate_tasks_.Pop()) {
+    RegisterTask(*task);
+  }
+}
+
 void TaskSource::PopTask(TaskSourceGrade grade) {
   switch (grade) {
     case TaskSourceGrade::kUserInteraction:
@@ -6,6 +6,7 @@
 #define FLUTTER_FML_TASK_SOURCE_H_
 
 #include "flutter/fml/delayed_task.h"
+#include "flutter/fml/synchronization/mpsc_queue.h"
 #include "flutter/fml/task_queue_id.h"
 #include "flutter/fml/task_source_grade.h"
 
@@ -26,6 +27,11 @@ class MessageLoopTaskQueues;
  * the user of the task dispatcher registers a task, the task is in-turn
  * registered with the `TaskSource` corresponding to the `TaskQueueID`.
  *
+ * Tasks that are ready to run when they are registered may instead be added
+ * to a lock-free queue of immediate tasks from multiple threads at once. These
+ * are moved into the task heaps by the task dispatcher before it looks at the
+ * heaps.
+ *
  * Processing Tasks
  * ----------------
  * Task dispatcher provides the event loop a way to acquire tasks to run via
@@ -51,6 +57,19 @@ class TaskSource {
   /// `TaskSourceGrade` of the `DelayedTask`.
   void RegisterTask(const DelayedTask& task);
 
+  /// Adds a task to the queue of immediate tasks. Unlike the other methods,
+  /// this may be called from multiple threads concurrently as long as no other
+  /// method is being called at the same time. The task is moved to its task
+  /// heap by the next call to `FlushImmediateTasks`.
+  ///
+  /// Returns false if the task is going to be held back because the secondary
+  /// heap is paused.
+  bool RegisterImmediateTask(const DelayedTask& task);
+
+  /// Moves the tasks added via `RegisterImmediateTask` to their corresponding
+  /// task heaps.
+  void FlushImmediateTasks();
+
   /// Pops the task heap corresponding to the `TaskSourceGrade`.
   void PopTask(TaskSourceGrade grade);
 
@@ -75,6 +94,7 @@ class TaskSource {
   const fml::TaskQueueId task_queue_id_;
   fml::DelayedTaskQueue primary_task_queue_;
   fml::DelayedTaskQueue secondary_task_queue_;
+  fml::MpscQueue<DelayedTask> immediate_tasks_;
   int secondary_pause_requests_ = 0;
 
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(TaskSource);
@@ -5,12 +5,18 @@
 #include "flutter/fml/trace_event.h"
 
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <unordered_set>
 #include <utility>
 
 #include "flutter/fml/ascii_trie.h"
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/macros.h"
 
 namespace fml {
 namespace tracing {
@@ -26,6 +32,105 @@ int64_t DefaultMicrosSource() {
 AsciiTrie gAllowlist;
 std::atomic<TimelineEventHandler> gTimelineEventHandler;
 std::atomic<TimelineMicrosSource> gTimelineMicrosSource = DefaultMicrosSource;
+std::atomic_bool gEventBufferingEnabled;
+
+inline void DispatchTimelineEvent(TimelineEventHandler handler,
+                                  const char* label,
+                                  int64_t timestamp0,
+                                  int64_t timestamp1_or_async_id,
+                                  intptr_t flow_id_count,
+                                  const int64_t* flow_ids,
+                                  Dart_Timeline_Event_Type type,
+                                  intptr_t argument_count,
+                                  const char** argument_names,
+                                  const char** argument_values) {
+  if (gAllowlist.Query(label)) {
+    handler(label, timestamp0, timestamp1_or_async_id, flow_id_count, flow_ids,
+            type, argument_count, argument_names, argument_values);
+  }
+}
+
+// Returns a copy of |label| that lives as long as the process. Labels are
+// usually string literals, so each thread remembers the copies of the labels
+// it last used by address and only takes the lock for new labels.
+const char* InternLabel(const char* label) {
+  thread_local std::array<std::pair<const char*, const char*>, 64> cache;
+  auto& slot = cache[(reinterpret_cast<uintptr_t>(label) >> 3) % cache.size()];
+  if (slot.first == label && std::strcmp(slot.second, label) == 0) {
+    return slot.second;
+  }
+  static std::mutex mutex;
+  static auto* labels = new std::unordered_set<std::string>();
+  std::scoped_lock lock(mutex);
+  slot = {label, labels->emplace(label).first->c_str()};
+  return slot.second;
+}
+
+// The events without arguments or flows recorded on a thread while buffering
+// is enabled.
+//
+// The timeline attributes events to the thread they are handed to it on, so
+// the buffer is only ever used and flushed by its own thread and needs no
+// synchronization. It is flushed once the outermost duration event of the
+// thread ends, which keeps the cost of the handler out of the durations being
+// measured, when it is full, and before an event that isn't buffered so that
+// the events of the thread stay in order.
+class ThreadEventBuffer {
+ public:
+  ThreadEventBuffer() = default;
+
+  ~ThreadEventBuffer() { Flush(); }
+
+  void Add(const char* label,
+           int64_t timestamp0,
+           int64_t timestamp1_or_async_id,
+           Dart_Timeline_Event_Type type) {
+    if (count_ == events_.size()) {
+      Flush();
+    }
+    events_[count_++] = {InternLabel(label), timestamp0, timestamp1_or_async_id,
+                         type};
+    if (type == Dart_Timeline_Event_Begin) {
+      depth_++;
+    } else if (type == Dart_Timeline_Event_End && depth_ > 0) {
+      depth_--;
+    }
+    if (depth_ == 0) {
+      Flush();
+    }
+  }
+
+  void Flush() {
+    TimelineEventHandler handler =
+        gTimelineEventHandler.load(std::memory_order_relaxed);
+    for (size_t i = 0; handler && i < count_; i++) {
+      const auto& event = events_[i];
+      DispatchTimelineEvent(handler, event.label, event.timestamp0,
+                            event.timestamp1_or_async_id, 0, nullptr,
+                            event.type, 0, nullptr, nullptr);
+    }
+    count_ = 0;
+  }
+
+ private:
+  struct Event {
+    const char* label;
+    int64_t timestamp0;
+    int64_t timestamp1_or_async_id;
+    Dart_Timeline_Event_Type type;
+  };
+
+  std::array<Event, 256> events_;
+  size_t count_ = 0;
+  size_t depth_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ThreadEventBuffer);
+};
+
+ThreadEventBuffer& GetThreadEventBuffer() {
+  thread_local ThreadEventBuffer buffer;
+  return buffer;
+}
 
 inline void FlutterTimelineEvent(const char* label,
                                  int64_t timestamp0,
@@ -38,10 +143,20 @@ inline void FlutterTimelineEvent(const char* label,
                                  const char** argument_values) {
   TimelineEventHandler handler =
       gTimelineEventHandler.load(std::memory_order_relaxed);
-  if (handler && gAllowlist.Query(label)) {
-    handler(label, timestamp0, timestamp1_or_async_id, flow_id_count, flow_ids,
-            type, argument_count, argument_names, argument_values);
+  if (!handler) {
+    return;
+  }
+  if (gEventBufferingEnabled.load(std::memory_order_relaxed)) {
+    auto& buffer = GetThreadEventBuffer();
+    if (flow_id_count == 0 && argument_count == 0) {
+      buffer.Add(label, timestamp0, timestamp1_or_async_id, type);
+      return;
+    }
+    buffer.Flush();
   }
+  DispatchTimelineEvent(handler, label, timestamp0, timestamp1_or_async_id,
+                        flow_id_count, flow_ids, type, argument_count,
+                        argument_names, argument_values);
 }
 }  // namespace
 
@@ -58,6 +173,14 @@ bool TraceHasTimelineEventHandler() {
       gTimelineEventHandler.load(std::memory_order_relaxed));
 }
 
+void TraceSetEventBufferingEnabled(bool enabled) {
+  gEventBufferingEnabled = enabled;
+}
+
+void TraceFlushThreadEvents() {
+  GetThreadEventBuffer().Flush();
+}
+
 int64_t TraceGetTimelineMicros() {
   return gTimelineMicrosSource.load()();
 }
@@ -376,6 +499,10 @@ bool TraceHasTimelineEventHandler() {
   return false;
 }
 
+void TraceSetEventBufferingEnabled(bool enabled) {}
+
+void TraceFlushThreadEvents() {}
+
 int64_t TraceGetTimelineMicros() {
   return -1;
 }
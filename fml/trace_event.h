@@ -230,6 +230,24 @@ void TraceSetTimelineEventHandler(TimelineEventHandler handler);
 
 bool TraceHasTimelineEventHandler();
 
+//------------------------------------------------------------------------------
+/// @brief      Sets whether the events without arguments or flows are
+///             buffered on the thread that records them instead of being
+///             handed to the timeline event handler right away.
+///
+///             The buffer of a thread is flushed, on that thread, once its
+///             outermost duration event ends, when it is full, and before an
+///             event with arguments or flows. The timestamps of the events are
+///             those of when they were recorded.
+///
+void TraceSetEventBufferingEnabled(bool enabled);
+
+//------------------------------------------------------------------------------
+/// @brief      Hands the events buffered on the calling thread to the timeline
+///             event handler.
+///
+void TraceFlushThreadEvents();
+
 void TraceSetTimelineMicrosSource(TimelineMicrosSource source);
 
 int64_t TraceGetTimelineMicros();
@@ -0,0 +1,100 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_event.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace tracing {
+namespace testing {
+
+#if FLUTTER_TIMELINE_ENABLED
+
+namespace {
+
+struct RecordedEvent {
+  std::string label;
+  int64_t timestamp;
+  Dart_Timeline_Event_Type type;
+};
+
+std::vector<RecordedEvent> gRecordedEvents;
+int64_t gMicros = 0;
+
+void RecordEvent(const char* label,
+                 int64_t timestamp0,
+                 int64_t timestamp1_or_async_id,
+                 intptr_t flow_id_count,
+                 const int64_t* flow_ids,
+                 Dart_Timeline_Event_Type type,
+                 intptr_t argument_count,
+                 const char** argument_names,
+                 const char** argument_values) {
+  gRecordedEvents.push_back({label, timestamp0, type});
+}
+
+int64_t GetMicros() {
+  return gMicros++;
+}
+
+class TraceEventBufferingTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    gRecordedEvents.clear();
+    gMicros = 0;
+    TraceSetTimelineMicrosSource(GetMicros);
+    TraceSetTimelineEventHandler(RecordEvent);
+    TraceSetEventBufferingEnabled(true);
+  }
+
+  void TearDown() override {
+    TraceFlushThreadEvents();
+    TraceSetEventBufferingEnabled(false);
+    TraceSetTimelineEventHandler(nullptr);
+  }
+};
+
+}  // namespace
+
+TEST_F(TraceEventBufferingTest, FlushesWhenOutermostEventEnds) {
+  {
+    TRACE_EVENT0("flutter", "Outer");
+    {
+      std::string name = "Inner";
+      TraceEvent0("flutter", name.c_str(), 0, nullptr);
+      TraceEventEnd(name.c_str());
+    }
+    EXPECT_TRUE(gRecordedEvents.empty());
+  }
+  ASSERT_EQ(gRecordedEvents.size(), 4u);
+  EXPECT_EQ(gRecordedEvents[0].label, "Outer");
+  EXPECT_EQ(gRecordedEvents[1].label, "Inner");
+  EXPECT_EQ(gRecordedEvents[2].label, "Inner");
+  EXPECT_EQ(gRecordedEvents[3].label, "Outer");
+  EXPECT_EQ(gRecordedEvents[3].type, Dart_Timeline_Event_End);
+  for (size_t i = 0; i < gRecordedEvents.size(); i++) {
+    EXPECT_EQ(gRecordedEvents[i].timestamp, static_cast<int64_t>(i));
+  }
+}
+
+TEST_F(TraceEventBufferingTest, KeepsOrderOfEventsWithArguments) {
+  {
+    TRACE_EVENT0("flutter", "Outer");
+    TRACE_EVENT_INSTANT1("flutter", "Instant", "key", "value");
+    ASSERT_EQ(gRecordedEvents.size(), 2u);
+    EXPECT_EQ(gRecordedEvents[0].label, "Outer");
+    EXPECT_EQ(gRecordedEvents[1].label, "Instant");
+  }
+  EXPECT_EQ(gRecordedEvents.size(), 3u);
+}
+
+#endif  // FLUTTER_TIMELINE_ENABLED
+
+}  // namespace testing
+}  // namespace tracing
+}  // namespace fml
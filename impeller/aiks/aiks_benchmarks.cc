@@ -0,0 +1,248 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include <functional>
+#include <memory>
+
+#include "flutter/fml/metrics.h"
+#include "flutter/testing/testing.h"
+#include "impeller/aiks/aiks_context.h"
+#include "impeller/aiks/canvas.h"
+#include "impeller/aiks/image_filter.h"
+#include "impeller/aiks/picture.h"
+#include "impeller/entity/render_target_cache.h"
+#include "impeller/geometry/path_builder.h"
+#include "impeller/playground/playground.h"
+#include "impeller/typographer/backends/skia/text_frame_skia.h"
+#include "impeller/typographer/backends/skia/typographer_context_skia.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkFont.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+#include "third_party/skia/include/core/SkTypeface.h"
+
+namespace impeller {
+
+// Renders recorded scenes with the EntityPass of the Aiks canvas on the
+// playground backends, without showing a window. Each scene stresses one kind
+// of Contents. Besides the CPU time of recording the commands of a frame, the
+// number of draw calls, pipeline switches and offscreen targets per frame are
+// reported, so that regressions can be told apart from changes in the work
+// done.
+
+namespace {
+
+constexpr ISize kFrameSize = {1024, 768};
+
+class BenchmarkPlayground final : public Playground {
+ public:
+  BenchmarkPlayground() : Playground(PlaygroundSwitches{}) {}
+
+  // |Playground|
+  std::unique_ptr<fml::Mapping> OpenAssetAsMapping(
+      std::string asset_name) const override {
+    return flutter::testing::OpenFixtureAsMapping(asset_name);
+  }
+
+  // |Playground|
+  std::string GetWindowTitle() const override { return "Aiks Benchmarks"; }
+};
+
+using SceneCallback = std::function<void(Canvas& canvas)>;
+
+void DrawPathScene(Canvas& canvas) {
+  Paint fill;
+  Paint stroke{.stroke_width = 3.0, .style = Paint::Style::kStroke};
+  for (int i = 0; i < 200; i++) {
+    const Scalar x = (i % 20) * 50.0f;
+    const Scalar y = (i / 20) * 75.0f;
+    auto path = PathBuilder{}
+                    .MoveTo({x, y + 40})
+                    .CubicCurveTo({x + 10, y - 20}, {x + 40, y + 90},
+                                  {x + 45, y + 10})
+                    .QuadraticCurveTo({x + 20, y + 70}, {x, y + 40})
+                    .Close()
+                    .TakePath();
+    fill.color = Color(i / 200.0f, 0.5, 1.0 - i / 200.0f, 1.0);
+    canvas.DrawPath(path, fill);
+    stroke.color = Color::Black();
+    canvas.DrawPath(path, stroke);
+  }
+}
+
+void DrawClipScene(Canvas& canvas) {
+  Paint paint{.color = Color::Blue()};
+  for (int i = 0; i < 50; i++) {
+    const Scalar x = (i % 10) * 100.0f;
+    const Scalar y = (i / 10) * 150.0f;
+    canvas.Save();
+    canvas.ClipRRect(Rect::MakeXYWH(x, y, 90, 140), 20);
+    canvas.ClipPath(
+        PathBuilder{}.AddCircle({x + 45, y + 70}, 50).TakePath(),
+        i % 2 ? Entity::ClipOperation::kIntersect
+              : Entity::ClipOperation::kDifference);
+    canvas.DrawRect(Rect::MakeXYWH(x, y, 100, 150), paint);
+    canvas.Restore();
+  }
+}
+
+void DrawFilterScene(Canvas& canvas) {
+  for (int i = 0; i < 12; i++) {
+    const Scalar x = (i % 4) * 250.0f;
+    const Scalar y = (i / 4) * 250.0f;
+    Paint layer_paint;
+    layer_paint.image_filter =
+        ImageFilter::MakeBlur(Sigma(5.0f + i), Sigma(5.0f + i),
+                              FilterContents::BlurStyle::kNormal,
+                              Entity::TileMode::kDecal);
+    canvas.SaveLayer(layer_paint, Rect::MakeXYWH(x, y, 240, 240));
+    canvas.DrawCircle({x + 120, y + 120}, 80, {.color = Color::Red()});
+    canvas.DrawRect(Rect::MakeXYWH(x + 20, y + 20, 100, 100),
+                    {.color = Color::Green()});
+    canvas.Restore();
+  }
+}
+
+void DrawNestedLayerScene(Canvas& canvas) {
+  // Overlapping draws keep the layers from being collapsed into their parents,
+  // so that every level queries the coverage of the levels below it.
+  for (int i = 0; i < 32; i++) {
+    const Scalar inset = i * 10.0f;
+    canvas.SaveLayer({.color = Color::White().WithAlpha(0.95)});
+    canvas.DrawRect(Rect::MakeLTRB(inset, inset, 1000 - inset, 750 - inset),
+                    {.color = Color(i / 32.0f, 0.5, 0.5, 1.0)});
+    canvas.DrawCircle({500, 375}, 350 - inset, {.color = Color::Blue()});
+  }
+  for (int i = 0; i < 32; i++) {
+    canvas.Restore();
+  }
+}
+
+std::shared_ptr<TextFrame> MakeTextFrame() {
+  auto mapping = flutter::testing::OpenFixtureAsMapping("Roboto-Regular.ttf");
+  if (!mapping) {
+    return nullptr;
+  }
+  auto data = SkData::MakeWithProc(
+      mapping->GetMapping(), mapping->GetSize(),
+      [](const void* ptr, void* context) {
+        delete reinterpret_cast<fml::Mapping*>(context);
+      },
+      mapping.get());
+  mapping.release();
+  SkFont font(SkTypeface::MakeFromData(data), 14);
+  auto blob = SkTextBlob::MakeFromString(
+      "The quick brown fox jumps over the lazy dog 0123456789", font);
+  return blob ? MakeTextFrameFromTextBlobSkia(blob) : nullptr;
+}
+
+void DrawTextScene(Canvas& canvas) {
+  static const std::shared_ptr<TextFrame> frame = MakeTextFrame();
+  if (!frame) {
+    return;
+  }
+  Paint paint;
+  for (int i = 0; i < 40; i++) {
+    paint.color = i % 2 ? Color::Black() : Color::Blue();
+    canvas.DrawTextFrame(frame, {10.0f + (i % 2) * 500.0f, 20.0f + i * 18.0f},
+                         paint);
+  }
+}
+
+int64_t GetCounterValue(std::string_view name) {
+  return fml::MetricsRegistry::GetInstance().GetCounter(name)->GetValue();
+}
+
+void BM_RenderScene(benchmark::State& state,
+                    PlaygroundBackend backend,
+                    const SceneCallback& scene) {
+  if (!Playground::SupportsBackend(backend)) {
+    state.SkipWithError("Backend isn't supported.");
+    return;
+  }
+  BenchmarkPlayground playground;
+  playground.SetupContext(backend);
+  auto context = playground.GetContext();
+  if (!context) {
+    state.SkipWithError("Could not create a context.");
+    return;
+  }
+  AiksContext aiks_context(context, TypographerContextSkia::Make());
+  if (!aiks_context.IsValid()) {
+    state.SkipWithError("Could not create an Aiks context.");
+    return;
+  }
+  RenderTargetCache render_target_allocator(context->GetResourceAllocator());
+  auto render_target = RenderTarget::CreateOffscreenMSAA(
+      *context, render_target_allocator, kFrameSize, "Benchmark");
+
+  const int64_t draw_calls = GetCounterValue("impeller.render_pass.draw_calls");
+  const int64_t pipeline_switches =
+      GetCounterValue("impeller.render_pass.pipeline_switches");
+  const int64_t offscreen_targets =
+      GetCounterValue("impeller.entity_pass.offscreen_targets");
+  int64_t frame_count = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    // Only the rendering of the entity pass is measured, not the recording.
+    state.PauseTiming();
+    aiks_context.GetContentContext().ResetTransientsBuffer();
+    Canvas canvas;
+    scene(canvas);
+    Picture picture = canvas.EndRecordingAsPicture();
+    state.ResumeTiming();
+
+    if (!aiks_context.Render(picture, render_target)) {
+      state.SkipWithError("Could not render the scene.");
+      break;
+    }
+    frame_count++;
+  }
+  if (frame_count == 0) {
+    return;
+  }
+
+  const auto per_frame = [frame_count](int64_t delta) {
+    return static_cast<double>(delta) / frame_count;
+  };
+  state.counters["DrawCalls"] = per_frame(
+      GetCounterValue("impeller.render_pass.draw_calls") - draw_calls);
+  state.counters["PipelineSwitches"] = per_frame(
+      GetCounterValue("impeller.render_pass.pipeline_switches") -
+      pipeline_switches);
+  state.counters["OffscreenTargets"] = per_frame(
+      GetCounterValue("impeller.entity_pass.offscreen_targets") -
+      offscreen_targets);
+}
+
+}  // namespace
+
+#define AIKS_SCENE_BENCHMARKS(backend_name, backend)                         \
+  BENCHMARK_CAPTURE(BM_RenderScene, path_##backend_name, backend,            \
+                    DrawPathScene)                                           \
+      ->Unit(benchmark::kMicrosecond);                                       \
+  BENCHMARK_CAPTURE(BM_RenderScene, clip_##backend_name, backend,            \
+                    DrawClipScene)                                           \
+      ->Unit(benchmark::kMicrosecond);                                       \
+  BENCHMARK_CAPTURE(BM_RenderScene, filter_##backend_name, backend,          \
+                    DrawFilterScene)                                         \
+      ->Unit(benchmark::kMicrosecond);                                       \
+  BENCHMARK_CAPTURE(BM_RenderScene, text_##backend_name, backend,            \
+                    DrawTextScene)                                           \
+      ->Unit(benchmark::kMicrosecond);                                       \
+  BENCHMARK_CAPTURE(BM_RenderScene, nested_layers_##backend_name, backend,   \
+                    DrawNestedLayerScene)                                    \
+      ->Unit(benchmark::kMicrosecond);
+
+#if IMPELLER_ENABLE_METAL
+AIKS_SCENE_BENCHMARKS(metal, PlaygroundBackend::kMetal)
+#endif  // IMPELLER_ENABLE_METAL
+#if IMPELLER_ENABLE_OPENGLES
+AIKS_SCENE_BENCHMARKS(opengles, PlaygroundBackend::kOpenGLES)
+#endif  // IMPELLER_ENABLE_OPENGLES
+#if IMPELLER_ENABLE_VULKAN
+AIKS_SCENE_BENCHMARKS(vulkan, PlaygroundBackend::kVulkan)
+#endif  // IMPELLER_ENABLE_VULKAN
+
+}  // namespace impeller
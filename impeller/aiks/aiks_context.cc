@@ -40,6 +40,13 @@ ContentContext& AiksContext::GetContentContext() const {
   return *content_context_;
 }
 
+void AiksContext::ClearCachedResources() {
+  if (!IsValid()) {
+    return;
+  }
+  content_context_->ClearCachedResources();
+}
+
 bool AiksContext::Render(const Picture& picture, RenderTarget& render_target) {
   if (!IsValid()) {
     return false;
@@ -41,6 +41,12 @@ class AiksContext {
 
   bool Render(const Picture& picture, RenderTarget& render_target);
 
+  /// Drop the resources cached for later frames, for example because the
+  /// system is running low on memory.
+  ///
+  /// @see |ContentContext::ClearCachedResources|
+  void ClearCachedResources();
+
  private:
   std::shared_ptr<Context> context_;
   std::unique_ptr<ContentContext> content_context_;
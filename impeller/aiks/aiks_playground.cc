@@ -47,6 +47,8 @@ bool AiksPlayground::OpenPlaygroundHere(AiksPlaygroundCallback callback) {
 
   return Playground::OpenPlaygroundHere(
       [this, &renderer, &callback](RenderTarget& render_target) -> bool {
+        // The previous frame was submitted by now.
+        renderer.GetContentContext().ResetTransientsBuffer();
         const std::optional<Picture>& picture = inspector_.RenderInspector(
             renderer, [&]() { return callback(renderer); });
 
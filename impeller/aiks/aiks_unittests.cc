@@ -2211,6 +2211,42 @@ TEST_P(AiksTest, OpacityPeepHoleApplicationTest) {
   ASSERT_TRUE(delegate->CanCollapseIntoParentPass(entity_pass.get()));
 }
 
+TEST_P(AiksTest, OpacityPeepholeAppliesToNonOverlappingChildren) {
+  Paint paint;
+  paint.color = Color::White().WithAlpha(0.5);
+  auto make_pass = [](size_t count) {
+    auto entity_pass = std::make_shared<EntityPass>();
+    // A column of rows that touch but don't overlap.
+    for (size_t i = 0; i < count; i++) {
+      Entity entity;
+      entity.SetContents(SolidColorContents::Make(
+          PathBuilder{}.AddRect(Rect::MakeXYWH(0, i * 10, 100, 10)).TakePath(),
+          Color::Red()));
+      entity_pass->AddEntity(entity);
+    }
+    return entity_pass;
+  };
+
+  auto entity_pass = make_pass(20);
+  auto delegate = std::make_shared<OpacityPeepholePassDelegate>(paint);
+  ASSERT_TRUE(delegate->CanCollapseIntoParentPass(entity_pass.get()));
+  entity_pass->IterateUntilSubpass([](Entity& entity) {
+    auto contents =
+        std::static_pointer_cast<SolidColorContents>(entity.GetContents());
+    EXPECT_EQ(contents->GetOpacityFactor(), 0.5);
+    return true;
+  });
+
+  // Any overlap requires the layer.
+  entity_pass = make_pass(20);
+  Entity overlapping;
+  overlapping.SetContents(SolidColorContents::Make(
+      PathBuilder{}.AddRect(Rect::MakeXYWH(50, 95, 10, 10)).TakePath(),
+      Color::Blue()));
+  entity_pass->AddEntity(overlapping);
+  ASSERT_FALSE(delegate->CanCollapseIntoParentPass(entity_pass.get()));
+}
+
 TEST_P(AiksTest, DrawPaintAbsorbsClears) {
   Canvas canvas;
   canvas.DrawPaint({.color = Color::Red(), .blend_mode = BlendMode::kSource});
@@ -2337,6 +2373,56 @@ TEST_P(AiksTest, ClipRectElidesNoOpClips) {
   ASSERT_EQ(render_pass->GetCommands().size(), 0llu);
 }
 
+TEST_P(AiksTest, PixelAlignedClipRectUsesScissor) {
+  Canvas canvas;
+  canvas.Save();
+  canvas.ClipRect(Rect(10, 10, 90, 90));
+  canvas.DrawRect(Rect(20, 20, 200, 200), {.color = Color::Red()});
+  canvas.Restore();
+  canvas.DrawRect(Rect(150, 150, 50, 50), {.color = Color::Blue()});
+
+  std::shared_ptr<ContextSpy> spy = ContextSpy::Make();
+  Picture picture = canvas.EndRecordingAsPicture();
+  std::shared_ptr<Context> real_context = GetContext();
+  std::shared_ptr<ContextMock> mock_context = spy->MakeContext(real_context);
+  AiksContext renderer(mock_context, nullptr);
+  std::shared_ptr<Image> image = picture.ToImage(renderer, {300, 300});
+
+  // Neither the clip nor its restore are drawn into the stencil.
+  ASSERT_EQ(spy->render_passes_.size(), 1llu);
+  std::shared_ptr<RenderPass> render_pass = spy->render_passes_[0];
+  const auto& commands = render_pass->GetCommands();
+  ASSERT_EQ(commands.size(), 2llu);
+  ASSERT_TRUE(commands[0].scissor.has_value());
+  ASSERT_EQ(commands[0].scissor.value(), IRect::MakeLTRB(10, 10, 100, 100));
+  ASSERT_EQ(commands[0].stencil_reference, 0u);
+  ASSERT_FALSE(commands[1].scissor.has_value());
+}
+
+TEST_P(AiksTest, UnalignedClipRectUsesStencil) {
+  Canvas canvas;
+  canvas.Save();
+  canvas.ClipRect(Rect(10.5, 10, 90, 90));
+  canvas.DrawRect(Rect(20, 20, 200, 200), {.color = Color::Red()});
+  canvas.Restore();
+
+  std::shared_ptr<ContextSpy> spy = ContextSpy::Make();
+  Picture picture = canvas.EndRecordingAsPicture();
+  std::shared_ptr<Context> real_context = GetContext();
+  std::shared_ptr<ContextMock> mock_context = spy->MakeContext(real_context);
+  AiksContext renderer(mock_context, nullptr);
+  std::shared_ptr<Image> image = picture.ToImage(renderer, {300, 300});
+
+  ASSERT_EQ(spy->render_passes_.size(), 1llu);
+  std::shared_ptr<RenderPass> render_pass = spy->render_passes_[0];
+  const auto& commands = render_pass->GetCommands();
+  ASSERT_GE(commands.size(), 2llu);
+  for (const auto& command : commands) {
+    ASSERT_FALSE(command.scissor.has_value());
+  }
+  ASSERT_EQ(commands[1].stencil_reference, 1u);
+}
+
 TEST_P(AiksTest, CollapsedDrawPaintInSubpass) {
   Canvas canvas;
   canvas.DrawPaint(
@@ -2775,6 +2861,25 @@ TEST_P(AiksTest, CanRenderMaskBlurHugeSigma) {
   ASSERT_TRUE(OpenPlaygroundHere(canvas.EndRecordingAsPicture()));
 }
 
+TEST_P(AiksTest, CanRenderMaskBlurredOvalsAndEllipticalRRects) {
+  Canvas canvas;
+  canvas.Scale(GetContentScale());
+  Paint paint = {
+      .color = Color::Black().WithAlpha(0.5),
+      .mask_blur_descriptor =
+          Paint::MaskBlurDescriptor{
+              .style = FilterContents::BlurStyle::kNormal,
+              .sigma = Sigma(8),
+          },
+  };
+  canvas.DrawOval(Rect::MakeXYWH(50, 50, 300, 150), paint);
+  canvas.DrawOval(Rect::MakeXYWH(400, 50, 100, 250), paint);
+  canvas.DrawRRect(Rect::MakeXYWH(50, 350, 300, 200), Size(80, 30), paint);
+  canvas.DrawRRect(Rect::MakeXYWH(400, 350, 150, 200), Size(20, 60), paint);
+
+  ASSERT_TRUE(OpenPlaygroundHere(canvas.EndRecordingAsPicture()));
+}
+
 TEST_P(AiksTest, CanRenderBackdropBlurInteractive) {
   auto callback = [&](AiksContext& renderer) -> std::optional<Picture> {
     auto [a, b] = IMPELLER_PLAYGROUND_LINE(Point(50, 50), Point(300, 200), 30,
@@ -2826,6 +2931,57 @@ TEST_P(AiksTest, CanRenderBackdropBlurHugeSigma) {
   ASSERT_TRUE(OpenPlaygroundHere(canvas.EndRecordingAsPicture()));
 }
 
+// Large enough to be blurred from a downsampled input.
+TEST_P(AiksTest, CanRenderDownsampledBackdropBlur) {
+  Canvas canvas;
+  canvas.Scale(GetContentScale());
+  for (int i = 0; i < 8; i++) {
+    canvas.DrawRect(Rect::MakeXYWH(40 + i * 60, 40, 30, 400),
+                    {.color = i % 2 ? Color::CornflowerBlue() : Color::Red()});
+  }
+  canvas.DrawCircle({300, 300}, 120, {.color = Color::GreenYellow()});
+  canvas.ClipRRect(Rect::MakeLTRB(80, 80, 480, 380), 20);
+  canvas.SaveLayer({.blend_mode = BlendMode::kSource}, std::nullopt,
+                   ImageFilter::MakeBlur(Sigma(60.0), Sigma(60.0),
+                                         FilterContents::BlurStyle::kNormal,
+                                         Entity::TileMode::kClamp));
+  canvas.Restore();
+
+  ASSERT_TRUE(OpenPlaygroundHere(canvas.EndRecordingAsPicture()));
+}
+
+TEST_P(AiksTest, CanRenderDownsampledDirectionalBlur) {
+  Canvas canvas;
+  canvas.Scale(GetContentScale());
+  canvas.DrawRect(Rect::MakeXYWH(100, 100, 400, 400),
+                  {.color = Color::CornflowerBlue(),
+                   .image_filter = ImageFilter::MakeBlur(
+                       Sigma(80.0), Sigma(2.0),
+                       FilterContents::BlurStyle::kNormal,
+                       Entity::TileMode::kDecal)});
+
+  ASSERT_TRUE(OpenPlaygroundHere(canvas.EndRecordingAsPicture()));
+}
+
+TEST_P(AiksTest, CanRenderBackdropBlurInSmallClip) {
+  Canvas canvas;
+  canvas.DrawPaint({.color = Color::White()});
+  for (int i = 0; i < 10; i++) {
+    auto color = i % 2 ? Color::CornflowerBlue() : Color::Red();
+    canvas.DrawCircle({50.0f + i * 60, 150}, 25, {.color = color});
+  }
+  // The clip is much smaller than the pass, so only the area around it should
+  // be read and blurred. Its edges should still blur in the content outside.
+  canvas.ClipRect(Rect::MakeXYWH(200, 100, 120, 100));
+  canvas.SaveLayer({.blend_mode = BlendMode::kSource}, std::nullopt,
+                   ImageFilter::MakeBlur(Sigma(20.0), Sigma(20.0),
+                                         FilterContents::BlurStyle::kNormal,
+                                         Entity::TileMode::kClamp));
+  canvas.Restore();
+
+  ASSERT_TRUE(OpenPlaygroundHere(canvas.EndRecordingAsPicture()));
+}
+
 TEST_P(AiksTest, CanRenderClippedBlur) {
   Canvas canvas;
   canvas.ClipRect(Rect::MakeXYWH(100, 150, 400, 400));
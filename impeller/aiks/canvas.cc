@@ -17,7 +17,10 @@
 #include "impeller/entity/contents/text_contents.h"
 #include "impeller/entity/contents/texture_contents.h"
 #include "impeller/entity/contents/vertices_contents.h"
+#include "impeller/entity/geometry/fill_path_geometry.h"
 #include "impeller/entity/geometry/geometry.h"
+#include "impeller/entity/geometry/point_field_geometry.h"
+#include "impeller/entity/geometry/rect_geometry.h"
 #include "impeller/geometry/path_builder.h"
 
 namespace impeller {
@@ -39,6 +42,7 @@ Canvas::~Canvas() = default;
 
 void Canvas::Initialize(std::optional<Rect> cull_rect) {
   initial_cull_rect_ = cull_rect;
+  arena_ = use_arena_ ? PictureArena::Create() : nullptr;
   base_pass_ = std::make_unique<EntityPass>();
   current_pass_ = base_pass_.get();
   xformation_stack_.emplace_back(CanvasStackEntry{.cull_rect = cull_rect});
@@ -50,6 +54,15 @@ void Canvas::Reset() {
   base_pass_ = nullptr;
   current_pass_ = nullptr;
   xformation_stack_ = {};
+  arena_ = nullptr;
+}
+
+void Canvas::SetUseArena(bool use_arena) {
+  if (use_arena_ == use_arena) {
+    return;
+  }
+  use_arena_ = use_arena;
+  arena_ = use_arena_ ? PictureArena::Create() : nullptr;
 }
 
 void Canvas::Save() {
@@ -175,7 +188,8 @@ void Canvas::DrawPath(const Path& path, const Paint& paint) {
   entity.SetTransformation(GetCurrentTransformation());
   entity.SetStencilDepth(GetStencilDepth());
   entity.SetBlendMode(paint.blend_mode);
-  entity.SetContents(paint.WithFilters(paint.CreateContentsForEntity(path)));
+  entity.SetContents(paint.WithFilters(
+      paint.CreateContentsForEntity(path, false, arena_.get())));
 
   GetCurrentPass().AddEntity(entity);
 }
@@ -185,13 +199,13 @@ void Canvas::DrawPaint(const Paint& paint) {
   entity.SetTransformation(GetCurrentTransformation());
   entity.SetStencilDepth(GetStencilDepth());
   entity.SetBlendMode(paint.blend_mode);
-  entity.SetContents(paint.CreateContentsForEntity({}, true));
+  entity.SetContents(paint.CreateContentsForEntity({}, true, arena_.get()));
 
   GetCurrentPass().AddEntity(entity);
 }
 
 bool Canvas::AttemptDrawBlurredRRect(const Rect& rect,
-                                     Scalar corner_radius,
+                                     Size corner_radii,
                                      const Paint& paint) {
   Paint new_paint = paint;
   if (new_paint.color_source.GetType() != ColorSource::Type::kColor ||
@@ -208,10 +222,11 @@ bool Canvas::AttemptDrawBlurredRRect(const Rect& rect,
   // For symmetrically mask blurred solid RRects, absorb the mask blur and use
   // a faster SDF approximation.
 
-  auto contents = std::make_shared<SolidRRectBlurContents>();
+  auto contents =
+      PictureArena::MakeShared<SolidRRectBlurContents>(arena_.get());
   contents->SetColor(new_paint.color);
   contents->SetSigma(new_paint.mask_blur_descriptor->sigma);
-  contents->SetRRect(rect, corner_radius);
+  contents->SetRRect(rect, corner_radii);
 
   new_paint.mask_blur_descriptor = std::nullopt;
 
@@ -232,7 +247,7 @@ void Canvas::DrawRect(Rect rect, const Paint& paint) {
     return;
   }
 
-  if (AttemptDrawBlurredRRect(rect, 0, paint)) {
+  if (AttemptDrawBlurredRRect(rect, {}, paint)) {
     return;
   }
 
@@ -240,27 +255,41 @@ void Canvas::DrawRect(Rect rect, const Paint& paint) {
   entity.SetTransformation(GetCurrentTransformation());
   entity.SetStencilDepth(GetStencilDepth());
   entity.SetBlendMode(paint.blend_mode);
-  entity.SetContents(paint.WithFilters(
-      paint.CreateContentsForGeometry(Geometry::MakeRect(rect))));
+  entity.SetContents(paint.WithFilters(paint.CreateContentsForGeometry(
+      PictureArena::MakeShared<RectGeometry>(arena_.get(), rect),
+      arena_.get())));
 
   GetCurrentPass().AddEntity(entity);
 }
 
 void Canvas::DrawRRect(Rect rect, Scalar corner_radius, const Paint& paint) {
-  if (AttemptDrawBlurredRRect(rect, corner_radius, paint)) {
+  DrawRRect(rect, Size(corner_radius, corner_radius), paint);
+}
+
+void Canvas::DrawRRect(Rect rect, Size corner_radii, const Paint& paint) {
+  if (corner_radii.width <= 0 || corner_radii.height <= 0) {
+    corner_radii = {};
+  }
+  if (AttemptDrawBlurredRRect(rect, corner_radii, paint)) {
     return;
   }
+  PathBuilder::RoundingRadii radii;
+  radii.top_left = Point(corner_radii);
+  radii.top_right = Point(corner_radii);
+  radii.bottom_left = Point(corner_radii);
+  radii.bottom_right = Point(corner_radii);
   auto path = PathBuilder{}
                   .SetConvexity(Convexity::kConvex)
-                  .AddRoundedRect(rect, corner_radius)
+                  .AddRoundedRect(rect, radii)
                   .TakePath();
   if (paint.style == Paint::Style::kFill) {
     Entity entity;
     entity.SetTransformation(GetCurrentTransformation());
     entity.SetStencilDepth(GetStencilDepth());
     entity.SetBlendMode(paint.blend_mode);
-    entity.SetContents(paint.WithFilters(
-        paint.CreateContentsForGeometry(Geometry::MakeFillPath(path))));
+    entity.SetContents(paint.WithFilters(paint.CreateContentsForGeometry(
+        PictureArena::MakeShared<FillPathGeometry>(arena_.get(), path),
+        arena_.get())));
 
     GetCurrentPass().AddEntity(entity);
     return;
@@ -270,8 +299,8 @@ void Canvas::DrawRRect(Rect rect, Scalar corner_radius, const Paint& paint) {
 
 void Canvas::DrawCircle(Point center, Scalar radius, const Paint& paint) {
   Size half_size(radius, radius);
-  if (AttemptDrawBlurredRRect(Rect(center - half_size, half_size * 2), radius,
-                              paint)) {
+  if (AttemptDrawBlurredRRect(Rect(center - half_size, half_size * 2),
+                              half_size, paint)) {
     return;
   }
   auto circle_path = PathBuilder{}
@@ -281,6 +310,21 @@ void Canvas::DrawCircle(Point center, Scalar radius, const Paint& paint) {
   DrawPath(circle_path, paint);
 }
 
+void Canvas::DrawOval(const Rect& rect, const Paint& paint) {
+  if (rect.size.width == rect.size.height) {
+    DrawCircle(rect.origin + rect.size * 0.5f, rect.size.width * 0.5f, paint);
+    return;
+  }
+  if (AttemptDrawBlurredRRect(rect, rect.size * 0.5f, paint)) {
+    return;
+  }
+  auto oval_path = PathBuilder{}
+                       .AddOval(rect)
+                       .SetConvexity(Convexity::kConvex)
+                       .TakePath();
+  DrawPath(oval_path, paint);
+}
+
 void Canvas::ClipPath(const Path& path, Entity::ClipOperation clip_op) {
   ClipGeometry(Geometry::MakeFillPath(path), clip_op);
   if (clip_op == Entity::ClipOperation::kIntersect) {
@@ -364,7 +408,7 @@ void Canvas::ClipRRect(const Rect& rect,
 
 void Canvas::ClipGeometry(std::unique_ptr<Geometry> geometry,
                           Entity::ClipOperation clip_op) {
-  auto contents = std::make_shared<ClipContents>();
+  auto contents = PictureArena::MakeShared<ClipContents>(arena_.get());
   contents->SetGeometry(std::move(geometry));
   contents->SetClipOperation(clip_op);
 
@@ -409,7 +453,8 @@ void Canvas::RestoreClip() {
   entity.SetTransformation(GetCurrentTransformation());
   // This path is empty because ClipRestoreContents just generates a quad that
   // takes up the full render target.
-  entity.SetContents(std::make_shared<ClipRestoreContents>());
+  entity.SetContents(
+      PictureArena::MakeShared<ClipRestoreContents>(arena_.get()));
   entity.SetStencilDepth(GetStencilDepth());
 
   GetCurrentPass().AddEntity(entity);
@@ -428,8 +473,10 @@ void Canvas::DrawPoints(std::vector<Point> points,
   entity.SetStencilDepth(GetStencilDepth());
   entity.SetBlendMode(paint.blend_mode);
   entity.SetContents(paint.WithFilters(paint.CreateContentsForGeometry(
-      Geometry::MakePointField(std::move(points), radius,
-                               /*round=*/point_style == PointStyle::kRound))));
+      PictureArena::MakeShared<PointFieldGeometry>(
+          arena_.get(), std::move(points), radius,
+          /*round=*/point_style == PointStyle::kRound),
+      arena_.get())));
 
   GetCurrentPass().AddEntity(entity);
 }
@@ -553,7 +600,7 @@ void Canvas::DrawTextFrame(const std::shared_ptr<TextFrame>& text_frame,
   entity.SetStencilDepth(GetStencilDepth());
   entity.SetBlendMode(paint.blend_mode);
 
-  auto text_contents = std::make_shared<TextContents>();
+  auto text_contents = PictureArena::MakeShared<TextContents>(arena_.get());
   text_contents->SetTextFrame(text_frame);
   text_contents->SetColor(paint.color);
 
@@ -15,6 +15,7 @@
 #include "impeller/aiks/image_filter.h"
 #include "impeller/aiks/paint.h"
 #include "impeller/aiks/picture.h"
+#include "impeller/aiks/picture_arena.h"
 #include "impeller/core/sampler_descriptor.h"
 #include "impeller/entity/entity_pass.h"
 #include "impeller/entity/geometry/geometry.h"
@@ -65,6 +66,16 @@ class Canvas {
 
   ~Canvas();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the objects of the draws recorded from now on are
+  ///             allocated from a |PictureArena|. Enabled by default.
+  ///
+  ///             Pictures that are retained across frames should be recorded
+  ///             without an arena, so that they don't hold on to the unused
+  ///             space of the arena's blocks.
+  ///
+  void SetUseArena(bool use_arena);
+
   void Save();
 
   void SaveLayer(const Paint& paint,
@@ -107,8 +118,12 @@ class Canvas {
 
   void DrawRRect(Rect rect, Scalar corner_radius, const Paint& paint);
 
+  void DrawRRect(Rect rect, Size corner_radii, const Paint& paint);
+
   void DrawCircle(Point center, Scalar radius, const Paint& paint);
 
+  void DrawOval(const Rect& rect, const Paint& paint);
+
   void DrawPoints(std::vector<Point>,
                   Scalar radius,
                   const Paint& paint,
@@ -164,6 +179,8 @@ class Canvas {
   EntityPass* current_pass_ = nullptr;
   std::deque<CanvasStackEntry> xformation_stack_;
   std::optional<Rect> initial_cull_rect_;
+  bool use_arena_ = true;
+  std::shared_ptr<PictureArena> arena_;
 
   void Initialize(std::optional<Rect> cull_rect);
 
@@ -186,7 +203,7 @@ class Canvas {
   void RestoreClip();
 
   bool AttemptDrawBlurredRRect(const Rect& rect,
-                               Scalar corner_radius,
+                               Size corner_radii,
                                const Paint& paint);
 
   FML_DISALLOW_COPY_AND_ASSIGN(Canvas);
@@ -2,8 +2,11 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <array>
+
 #include "flutter/testing/testing.h"
 #include "impeller/aiks/canvas.h"
+#include "impeller/aiks/picture_arena.h"
 #include "impeller/geometry/path_builder.h"
 
 // TODO(zanderso): https://github.com/flutter/flutter/issues/127701
@@ -336,6 +339,48 @@ TEST(AiksCanvasTest, PathClipDiffAgainstFullyCoveredCullRect) {
   ASSERT_EQ(canvas.GetCurrentLocalCullingBounds().value(), result_cull);
 }
 
+TEST(AiksCanvasTest, PictureArenaObjectsOutliveTheArenaHandle) {
+  std::weak_ptr<PictureArena> weak_arena;
+  std::shared_ptr<std::vector<int>> object;
+  {
+    auto arena = PictureArena::Create();
+    weak_arena = arena;
+    object = PictureArena::MakeShared<std::vector<int>>(arena.get(), 3, 7);
+    ASSERT_EQ(arena->GetBlockCount(), 1u);
+  }
+  ASSERT_FALSE(weak_arena.expired());
+  ASSERT_EQ(*object, std::vector<int>(3, 7));
+  object.reset();
+  ASSERT_TRUE(weak_arena.expired());
+}
+
+TEST(AiksCanvasTest, PictureArenaPacksSmallObjectsIntoBlocks) {
+  auto arena = PictureArena::Create();
+  std::vector<std::shared_ptr<Matrix>> matrices;
+  for (int i = 0; i < 100; i++) {
+    matrices.push_back(PictureArena::MakeShared<Matrix>(
+        arena.get(), Matrix::MakeTranslation({1.0f * i, 0, 0})));
+  }
+  ASSERT_EQ(arena->GetBlockCount(), 1u);
+  for (int i = 0; i < 100; i++) {
+    ASSERT_EQ(matrices[i]->m[12], 1.0f * i);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(matrices[i].get()) % alignof(Matrix),
+              0u);
+  }
+
+  auto large = PictureArena::MakeShared<std::array<uint8_t, 64 * 1024>>(
+      arena.get());
+  ASSERT_EQ(arena->GetBlockCount(), 2u);
+  PictureArena::MakeShared<Matrix>(arena.get());
+  ASSERT_EQ(arena->GetBlockCount(), 2u);
+}
+
+TEST(AiksCanvasTest, PictureArenaFallsBackToTheHeap) {
+  auto object = PictureArena::MakeShared<Matrix>(nullptr);
+  ASSERT_TRUE(object);
+  ASSERT_TRUE(object->IsIdentity());
+}
+
 }  // namespace testing
 }  // namespace impeller
 
@@ -74,10 +74,8 @@ MatrixColorFilter::~MatrixColorFilter() = default;
 std::shared_ptr<ColorFilterContents> MatrixColorFilter::WrapWithGPUColorFilter(
     std::shared_ptr<FilterInput> input,
     ColorFilterContents::AbsorbOpacity absorb_opacity) const {
-  auto filter =
-      ColorFilterContents::MakeColorMatrix({std::move(input)}, color_matrix_);
-  filter->SetAbsorbOpacity(absorb_opacity);
-  return filter;
+  return ColorFilterContents::MakeColorMatrix(std::move(input), color_matrix_,
+                                              absorb_opacity);
 }
 
 ColorFilter::ColorFilterProc MatrixColorFilter::GetCPUColorFilterProc() const {
@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "impeller/aiks/paint.h"
+#include "impeller/aiks/picture_arena.h"
 #include "impeller/core/sampler_descriptor.h"
 #include "impeller/entity/contents/conical_gradient_contents.h"
 #include "impeller/entity/contents/filters/color_filter_contents.h"
@@ -236,7 +237,13 @@ ColorSource::Type ColorSource::GetType() const {
 }
 
 std::shared_ptr<ColorSourceContents> ColorSource::GetContents(
-    const Paint& paint) const {
+    const Paint& paint,
+    PictureArena* arena) const {
+  if (arena && type_ == Type::kColor) {
+    auto contents = PictureArena::MakeShared<SolidColorContents>(arena);
+    contents->SetColor(paint.color);
+    return contents;
+  }
   return proc_(paint);
 }
 
@@ -22,6 +22,8 @@
 
 namespace impeller {
 
+class PictureArena;
+
 struct Paint;
 
 class ColorSource {
@@ -95,7 +97,13 @@ class ColorSource {
 
   Type GetType() const;
 
-  std::shared_ptr<ColorSourceContents> GetContents(const Paint& paint) const;
+  //----------------------------------------------------------------------------
+  /// @brief      Creates the contents of the color source. Solid colors are
+  ///             allocated from the arena when one is given.
+  ///
+  std::shared_ptr<ColorSourceContents> GetContents(
+      const Paint& paint,
+      PictureArena* arena = nullptr) const;
 
  private:
   Type type_ = Type::kColor;
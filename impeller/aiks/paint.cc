@@ -10,16 +10,26 @@
 #include "impeller/entity/contents/filters/color_filter_contents.h"
 #include "impeller/entity/contents/filters/filter_contents.h"
 #include "impeller/entity/contents/solid_color_contents.h"
+#include "impeller/entity/geometry/cover_geometry.h"
+#include "impeller/entity/geometry/fill_path_geometry.h"
 #include "impeller/entity/geometry/geometry.h"
 
 namespace impeller {
 
-std::shared_ptr<Contents> Paint::CreateContentsForEntity(const Path& path,
-                                                         bool cover) const {
-  std::unique_ptr<Geometry> geometry;
+std::shared_ptr<Contents> Paint::CreateContentsForEntity(
+    const Path& path,
+    bool cover,
+    PictureArena* arena) const {
+  std::shared_ptr<Geometry> geometry;
   switch (style) {
     case Style::kFill:
-      geometry = cover ? Geometry::MakeCover() : Geometry::MakeFillPath(path);
+      if (!arena) {
+        geometry = cover ? Geometry::MakeCover() : Geometry::MakeFillPath(path);
+      } else if (cover) {
+        geometry = PictureArena::MakeShared<CoverGeometry>(arena);
+      } else {
+        geometry = PictureArena::MakeShared<FillPathGeometry>(arena, path);
+      }
       break;
     case Style::kStroke:
       geometry =
@@ -28,12 +38,13 @@ std::shared_ptr<Contents> Paint::CreateContentsForEntity(const Path& path,
                                            stroke_cap, stroke_join);
       break;
   }
-  return CreateContentsForGeometry(std::move(geometry));
+  return CreateContentsForGeometry(std::move(geometry), arena);
 }
 
 std::shared_ptr<Contents> Paint::CreateContentsForGeometry(
-    std::shared_ptr<Geometry> geometry) const {
-  auto contents = color_source.GetContents(*this);
+    std::shared_ptr<Geometry> geometry,
+    PictureArena* arena) const {
+  auto contents = color_source.GetContents(*this, arena);
 
   // Attempt to apply the color filter on the CPU first.
   // Note: This is not just an optimization; some color sources rely on
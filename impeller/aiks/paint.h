@@ -10,6 +10,7 @@
 #include "impeller/aiks/color_filter.h"
 #include "impeller/aiks/color_source.h"
 #include "impeller/aiks/image_filter.h"
+#include "impeller/aiks/picture_arena.h"
 #include "impeller/entity/contents/contents.h"
 #include "impeller/entity/contents/filters/color_filter_contents.h"
 #include "impeller/entity/contents/filters/filter_contents.h"
@@ -86,11 +87,16 @@ struct Paint {
       std::shared_ptr<Contents> input,
       const Matrix& effect_transform = Matrix()) const;
 
-  std::shared_ptr<Contents> CreateContentsForEntity(const Path& path = {},
-                                                    bool cover = false) const;
+  /// @param[in]  arena  The arena to allocate fill geometry and solid color
+  ///                    contents from, if any. See |PictureArena|.
+  std::shared_ptr<Contents> CreateContentsForEntity(
+      const Path& path = {},
+      bool cover = false,
+      PictureArena* arena = nullptr) const;
 
   std::shared_ptr<Contents> CreateContentsForGeometry(
-      std::shared_ptr<Geometry> geometry) const;
+      std::shared_ptr<Geometry> geometry,
+      PictureArena* arena = nullptr) const;
 
   /// @brief   Whether this paint has a color filter that can apply opacity
   bool HasColorFilter() const;
@@ -4,6 +4,9 @@
 
 #include "impeller/aiks/paint_pass_delegate.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "impeller/core/formats.h"
 #include "impeller/core/sampler_descriptor.h"
 #include "impeller/entity/contents/contents.h"
@@ -14,6 +17,39 @@
 
 namespace impeller {
 
+namespace {
+
+/// Whether any two of the `coverages` overlap.
+///
+/// The rectangles are swept from top to bottom, and each one is only checked
+/// against the ones above it that haven't ended yet. Children of a layer are
+/// usually laid out in rows or columns, so few rectangles are checked against
+/// each other.
+bool ContainsOverlappingCoverage(std::vector<Rect> coverages) {
+  std::sort(coverages.begin(), coverages.end(),
+            [](const Rect& a, const Rect& b) {
+              return a.GetTop() < b.GetTop();
+            });
+  std::vector<Rect> active;
+  for (const auto& coverage : coverages) {
+    auto top = coverage.GetTop();
+    active.erase(std::remove_if(active.begin(), active.end(),
+                                [top](const Rect& other) {
+                                  return other.GetBottom() <= top;
+                                }),
+                 active.end());
+    for (const auto& other : active) {
+      if (other.IntersectsWithRect(coverage)) {
+        return true;
+      }
+    }
+    active.push_back(coverage);
+  }
+  return false;
+}
+
+}  // namespace
+
 /// PaintPassDelegate
 /// ----------------------------------------------
 
@@ -84,44 +120,28 @@ bool OpacityPeepholePassDelegate::CanCollapseIntoParentPass(
     return false;
   }
 
-  // Note: determing whether any coverage intersects has quadradic complexity in
-  // the number of rectangles, and depending on whether or not we cache at
-  // different levels of the entity tree may end up cubic. In the interest of
-  // proving whether or not this optimization is valuable, we only consider very
-  // simple peephole optimizations here - where there is a single drawing
-  // command wrapped in save layer. This would indicate something like an
-  // Opacity or FadeTransition wrapping a very simple widget, like in the
-  // CupertinoPicker.
-  if (entity_pass->GetElementCount() > 3) {
-    // Single paint command with a save layer would be:
-    // 1. clip
-    // 2. draw command
-    // 3. restore.
-    return false;
-  }
+  // The opacity can be applied to each entity instead of the layer as long as
+  // no two entities overlap, since then no pixel is blended more than once.
+  // This is the case for something like an Opacity or FadeTransition wrapping
+  // a widget, like the items in a CupertinoPicker or a list of cards, whose
+  // children are laid out next to each other.
   bool all_can_accept = true;
   std::vector<Rect> all_coverages;
+  all_coverages.reserve(entity_pass->GetElementCount());
   auto had_subpass = entity_pass->IterateUntilSubpass(
       [&all_coverages, &all_can_accept](Entity& entity) {
-        auto contents = entity.GetContents();
         if (!entity.CanInheritOpacity()) {
           all_can_accept = false;
           return false;
         }
-        auto maybe_coverage = contents->GetCoverage(entity);
+        auto maybe_coverage = entity.GetContents()->GetCoverage(entity);
         if (maybe_coverage.has_value()) {
-          auto coverage = maybe_coverage.value();
-          for (const auto& cv : all_coverages) {
-            if (cv.IntersectsWithRect(coverage)) {
-              all_can_accept = false;
-              return false;
-            }
-          }
-          all_coverages.push_back(coverage);
+          all_coverages.push_back(maybe_coverage.value());
         }
         return true;
       });
-  if (had_subpass || !all_can_accept) {
+  if (had_subpass || !all_can_accept ||
+      ContainsOverlappingCoverage(std::move(all_coverages))) {
     return false;
   }
   auto alpha = paint_.color.alpha;
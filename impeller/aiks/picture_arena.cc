@@ -0,0 +1,42 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/aiks/picture_arena.h"
+
+namespace impeller {
+
+std::shared_ptr<PictureArena> PictureArena::Create() {
+  return std::shared_ptr<PictureArena>(new PictureArena());
+}
+
+PictureArena::PictureArena() = default;
+
+PictureArena::~PictureArena() = default;
+
+size_t PictureArena::GetBlockCount() const {
+  return blocks_.size();
+}
+
+void* PictureArena::Allocate(size_t size, size_t alignment) {
+  if (size + alignment > kBlockSize) {
+    // Objects that don't fit in a block get one of their own. The current
+    // block stays in use for the objects that come after it.
+    auto& block = blocks_.emplace_back(new uint8_t[size + alignment]);
+    void* ptr = block.get();
+    size_t space = size + alignment;
+    return std::align(alignment, size, ptr, space);
+  }
+  void* ptr = cursor_;
+  if (!std::align(alignment, size, ptr, remaining_)) {
+    auto& block = blocks_.emplace_back(new uint8_t[kBlockSize]);
+    ptr = block.get();
+    remaining_ = kBlockSize;
+    ptr = std::align(alignment, size, ptr, remaining_);
+  }
+  cursor_ = static_cast<uint8_t*>(ptr) + size;
+  remaining_ -= size;
+  return ptr;
+}
+
+}  // namespace impeller
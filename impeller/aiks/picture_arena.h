@@ -0,0 +1,105 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A bump allocator for the contents and geometry objects that a
+///             |Canvas| records into a picture.
+///
+///             Recording a frame creates a handful of small objects per draw.
+///             Allocating them from large blocks instead of the heap replaces
+///             a malloc and free per object with a pointer bump, and keeps the
+///             objects of a picture close together in memory.
+///
+///             Memory is never reused. Each object keeps the arena alive
+///             through its control block, so the blocks are released once the
+///             canvas and every object allocated from the arena are gone.
+///             Objects may be released on any thread, but allocation is not
+///             thread safe and must happen on the recording thread.
+///
+class PictureArena final : public std::enable_shared_from_this<PictureArena> {
+ public:
+  static std::shared_ptr<PictureArena> Create();
+
+  ~PictureArena();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a shared object in the arena, or on the heap when no
+  ///             arena is given.
+  ///
+  template <class T, class... Args>
+  static std::shared_ptr<T> MakeShared(PictureArena* arena, Args&&... args) {
+    if (!arena) {
+      return std::make_shared<T>(std::forward<Args>(args)...);
+    }
+    return std::allocate_shared<T>(Allocator<T>(arena->shared_from_this()),
+                                   std::forward<Args>(args)...);
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of blocks allocated so far.
+  ///
+  size_t GetBlockCount() const;
+
+ private:
+  template <class T>
+  class Allocator {
+   public:
+    using value_type = T;
+
+    explicit Allocator(std::shared_ptr<PictureArena> arena)
+        : arena_(std::move(arena)) {}
+
+    template <class U>
+    Allocator(const Allocator<U>& other)  // NOLINT(google-explicit-constructor)
+        : arena_(other.arena_) {}
+
+    T* allocate(size_t count) {
+      return static_cast<T*>(arena_->Allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    void deallocate(T* ptr, size_t count) {}
+
+    template <class U>
+    bool operator==(const Allocator<U>& other) const {
+      return arena_ == other.arena_;
+    }
+
+    template <class U>
+    bool operator!=(const Allocator<U>& other) const {
+      return arena_ != other.arena_;
+    }
+
+   private:
+    template <class U>
+    friend class Allocator;
+
+    std::shared_ptr<PictureArena> arena_;
+  };
+
+  static constexpr size_t kBlockSize = 16 * 1024;
+
+  std::vector<std::unique_ptr<uint8_t[]>> blocks_;
+  void* cursor_ = nullptr;
+  size_t remaining_ = 0;
+
+  PictureArena();
+
+  void* Allocate(size_t size, size_t alignment);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PictureArena);
+};
+
+}  // namespace impeller
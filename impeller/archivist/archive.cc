@@ -4,9 +4,14 @@
 
 #include "impeller/archivist/archive.h"
 
+#include <condition_variable>
 #include <iterator>
+#include <mutex>
+#include <thread>
 
+#include "flutter/fml/closure.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
 #include "impeller/archivist/archive_class_registration.h"
 #include "impeller/archivist/archive_database.h"
 #include "impeller/archivist/archive_location.h"
@@ -14,10 +19,32 @@
 
 namespace impeller {
 
+struct Archive::Writer {
+  std::mutex mutex;
+  // Signaled when writes are queued or the writer must terminate.
+  std::condition_variable pending_cv;
+  // Signaled when the writer takes or finishes a batch.
+  std::condition_variable progress_cv;
+  std::vector<PendingWrite> pending;
+  bool writing = false;
+  bool terminate = false;
+  bool failed = false;
+  std::thread thread;
+};
+
 Archive::Archive(const std::string& path)
     : database_(std::make_unique<ArchiveDatabase>(path)) {}
 
 Archive::~Archive() {
+  if (writer_) {
+    {
+      std::scoped_lock lock(writer_->mutex);
+      writer_->terminate = true;
+    }
+    writer_->pending_cv.notify_one();
+    // The writes that are still pending are made before the thread exits.
+    writer_->thread.join();
+  }
   FML_DCHECK(transaction_count_ == 0)
       << "There must be no pending transactions";
 }
@@ -26,6 +53,105 @@ bool Archive::IsValid() const {
   return database_->IsValid();
 }
 
+bool Archive::EnqueueWrite(PendingWrite write) {
+  if (!IsValid()) {
+    return false;
+  }
+
+  if (!writer_) {
+    writer_ = std::make_unique<Writer>();
+    writer_->thread = std::thread([this]() { RunWriter(); });
+  }
+
+  {
+    std::unique_lock lock(writer_->mutex);
+    if (writer_->pending.size() >= kMaxPendingWrites) {
+      TRACE_EVENT0("impeller", "Archive::WaitForWriter");
+      writer_->progress_cv.wait(lock, [this]() {
+        return writer_->pending.size() < kMaxPendingWrites;
+      });
+    }
+    writer_->pending.push_back(std::move(write));
+  }
+  writer_->pending_cv.notify_one();
+  return true;
+}
+
+void Archive::WaitForPendingWrites() {
+  if (!writer_) {
+    return;
+  }
+  std::unique_lock lock(writer_->mutex);
+  writer_->progress_cv.wait(lock, [this]() {
+    return writer_->pending.empty() && !writer_->writing;
+  });
+}
+
+bool Archive::Flush() {
+  if (!writer_) {
+    return IsValid();
+  }
+  WaitForPendingWrites();
+  std::scoped_lock lock(writer_->mutex);
+  const bool succeeded = !writer_->failed;
+  writer_->failed = false;
+  return succeeded;
+}
+
+void Archive::RunWriter() {
+  while (true) {
+    std::vector<PendingWrite> batch;
+    {
+      std::unique_lock lock(writer_->mutex);
+      writer_->pending_cv.wait(lock, [this]() {
+        return writer_->terminate || !writer_->pending.empty();
+      });
+      if (writer_->pending.empty()) {
+        return;
+      }
+      batch.swap(writer_->pending);
+      writer_->writing = true;
+    }
+    writer_->progress_cv.notify_all();
+
+    const bool succeeded = WriteBatch(batch);
+
+    {
+      std::scoped_lock lock(writer_->mutex);
+      writer_->writing = false;
+      writer_->failed = writer_->failed || !succeeded;
+    }
+    writer_->progress_cv.notify_all();
+  }
+}
+
+bool Archive::WriteBatch(const std::vector<PendingWrite>& batch) {
+  TRACE_EVENT1("impeller", "Archive::WriteBatch", "count",
+               std::to_string(batch.size()).c_str());
+  {
+    auto transaction = database_->CreateTransaction(transaction_count_);
+    bool succeeded = true;
+    for (const auto& write : batch) {
+      if (!write()) {
+        succeeded = false;
+        break;
+      }
+    }
+    if (succeeded) {
+      transaction.MarkWritesAsReadyForCommit();
+      return true;
+    }
+  }
+
+  // The batch was rolled back. Make the writes in transactions of their own so
+  // that one failed write doesn't drop the others.
+  bool succeeded = true;
+  for (const auto& write : batch) {
+    succeeded = write() && succeeded;
+  }
+  return succeeded;
+}
+
 std::optional<int64_t /* row id */> Archive::ArchiveInstance(
     const ArchiveDef& definition,
     const Archivable& archivable) {
@@ -42,9 +168,12 @@ std::optional<int64_t /* row id */> Archive::ArchiveInstance(
     return std::nullopt;
   }
 
-  auto statement = registration->CreateInsertStatement();
+  auto statement = registration->AcquireInsertStatement();
+  fml::ScopedCleanupClosure recycle_statement([&]() {
+    registration->RecycleInsertStatement(std::move(statement));
+  });
 
-  if (!statement.IsValid() || !statement.Reset()) {
+  if (!statement->IsValid() || !statement->Reset()) {
     /*
      *  Must be able to reset the statement for a new write
      */
@@ -59,15 +188,15 @@ std::optional<int64_t /* row id */> Archive::ArchiveInstance(
    *  for its members to be references. It does not manage the lifetimes of
    *  anything.
    */
-  ArchiveLocation item(*this, statement, *registration, primary_key);
+  ArchiveLocation item(*this, *statement, *registration, primary_key);
 
   /*
    *  If the item provides its own primary key, we need to bind it now.
    * Otherwise, one will be automatically assigned to it.
    */
   if (primary_key.has_value() &&
-      !statement.WriteValue(ArchiveClassRegistration::kPrimaryKeyIndex,
-                            primary_key.value())) {
+      !statement->WriteValue(ArchiveClassRegistration::kPrimaryKeyIndex,
+                             primary_key.value())) {
     return std::nullopt;
   }
 
@@ -75,7 +204,7 @@ std::optional<int64_t /* row id */> Archive::ArchiveInstance(
     return std::nullopt;
   }
 
-  if (statement.Execute() != ArchiveStatement::Result::kDone) {
+  if (statement->Execute() != ArchiveStatement::Result::kDone) {
     return std::nullopt;
   }
 
@@ -21,6 +21,12 @@ class ArchiveDatabase;
 
 class Archive {
  public:
+  //----------------------------------------------------------------------------
+  /// The number of asynchronous writes that may wait for the background
+  /// writer before `WriteAsync` blocks.
+  ///
+  static constexpr size_t kMaxPendingWrites = 64u;
+
   Archive(const std::string& path);
 
   ~Archive();
@@ -31,13 +37,47 @@ class Archive {
             class = std::enable_if_t<std::is_base_of<Archivable, T>::value>>
   [[nodiscard]] bool Write(const T& archivable) {
     const ArchiveDef& def = T::kArchiveDefinition;
+    WaitForPendingWrites();
     return ArchiveInstance(def, archivable).has_value();
   }
 
+  //----------------------------------------------------------------------------
+  /// @brief      Writes the archivable on the background writer of the
+  ///             archive, so that the caller doesn't wait on the database.
+  ///             Writes are made in the order they were queued, and the ones
+  ///             queued while the writer is busy are committed together in
+  ///             one transaction. If `kMaxPendingWrites` writes are already
+  ///             waiting, this call blocks until the writer catches up.
+  ///
+  /// @param[in]  archivable  The archivable, which is owned by the archive
+  ///                         until it is written.
+  ///
+  /// @return     If the write was queued. Use `Flush` to find out if it
+  ///             succeeded.
+  ///
+  template <class T,
+            class = std::enable_if_t<std::is_base_of<Archivable, T>::value>>
+  [[nodiscard]] bool WriteAsync(T archivable) {
+    const ArchiveDef& def = T::kArchiveDefinition;
+    auto item = std::make_shared<T>(std::move(archivable));
+    return EnqueueWrite([this, &def, item]() {
+      return ArchiveInstance(def, *item).has_value();
+    });
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Waits until all writes queued with `WriteAsync` have been
+  ///             committed.
+  ///
+  /// @return     If all asynchronous writes since the last flush succeeded.
+  ///
+  bool Flush();
+
   template <class T,
             class = std::enable_if_t<std::is_base_of<Archivable, T>::value>>
   [[nodiscard]] bool Read(PrimaryKey name, T& archivable) {
     const ArchiveDef& def = T::kArchiveDefinition;
+    WaitForPendingWrites();
     return UnarchiveInstance(def, name, archivable);
   }
 
@@ -47,15 +87,31 @@ class Archive {
             class = std::enable_if_t<std::is_base_of<Archivable, T>::value>>
   [[nodiscard]] size_t Read(UnarchiveStep stepper) {
     const ArchiveDef& def = T::kArchiveDefinition;
+    WaitForPendingWrites();
     return UnarchiveInstances(def, stepper);
   }
 
  private:
+  using PendingWrite = std::function<bool(void)>;
+  struct Writer;
+
   std::unique_ptr<ArchiveDatabase> database_;
   int64_t transaction_count_ = 0;
+  // Created with the first asynchronous write. The database is only used by
+  // the writer thread while writes are pending, and callers wait for the
+  // pending writes to finish before using it on their own thread.
+  std::unique_ptr<Writer> writer_;
 
   friend class ArchiveLocation;
 
+  bool EnqueueWrite(PendingWrite write);
+
+  void WaitForPendingWrites();
+
+  void RunWriter();
+
+  bool WriteBatch(const std::vector<PendingWrite>& batch);
+
   std::optional<int64_t /* row id */> ArchiveInstance(
       const ArchiveDef& definition,
       const Archivable& archivable);
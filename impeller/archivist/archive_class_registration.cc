@@ -121,4 +121,20 @@ ArchiveStatement ArchiveClassRegistration::CreateInsertStatement() const {
   return database_.CreateStatement(stream.str());
 }
 
+std::unique_ptr<ArchiveStatement>
+ArchiveClassRegistration::AcquireInsertStatement() const {
+  if (insert_statement_) {
+    return std::move(insert_statement_);
+  }
+  return std::make_unique<ArchiveStatement>(CreateInsertStatement());
+}
+
+void ArchiveClassRegistration::RecycleInsertStatement(
+    std::unique_ptr<ArchiveStatement> statement) const {
+  if (insert_statement_ || !statement || !statement->IsValid()) {
+    return;
+  }
+  insert_statement_ = std::move(statement);
+}
+
 }  // namespace impeller
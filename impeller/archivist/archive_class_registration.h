@@ -5,6 +5,7 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <optional>
 
 #include "flutter/fml/macros.h"
@@ -29,6 +30,17 @@ class ArchiveClassRegistration {
 
   ArchiveStatement CreateQueryStatement(bool single) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the cached insert statement of the class, or a new
+  ///             one if the cached statement is used by an enclosing write of
+  ///             the same class. Return the statement with
+  ///             `RecycleInsertStatement` so that it is prepared only once.
+  ///
+  std::unique_ptr<ArchiveStatement> AcquireInsertStatement() const;
+
+  void RecycleInsertStatement(
+      std::unique_ptr<ArchiveStatement> statement) const;
+
  private:
   using MemberColumnMap = std::map<std::string, size_t>;
 
@@ -41,6 +53,7 @@ class ArchiveClassRegistration {
   ArchiveDatabase& database_;
   const ArchiveDef definition_;
   MemberColumnMap column_map_;
+  mutable std::unique_ptr<ArchiveStatement> insert_statement_;
   bool is_valid_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ArchiveClassRegistration);
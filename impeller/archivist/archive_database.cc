@@ -9,6 +9,7 @@
 #include <sstream>
 #include <string>
 
+#include "flutter/fml/logging.h"
 #include "impeller/archivist/archive.h"
 #include "impeller/archivist/archive_class_registration.h"
 #include "impeller/archivist/archive_statement.h"
@@ -30,6 +31,14 @@ struct ArchiveDatabase::Handle {
       return;
     }
 
+    // Readers don't block the writer, and commits only sync the log when it
+    // is checkpointed, which keeps frequent small transactions cheap.
+    if (::sqlite3_exec(db,
+                       "PRAGMA journal_mode=WAL; PRAGMA synchronous=NORMAL;",
+                       nullptr, nullptr, nullptr) != SQLITE_OK) {
+      FML_LOG(ERROR) << "Could not enable write-ahead logging for the archive.";
+    }
+
     handle_ = db;
   }
 
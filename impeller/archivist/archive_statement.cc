@@ -51,6 +51,8 @@ ArchiveStatement::ArchiveStatement(void* db, const std::string& statememt)
   }
 }
 
+ArchiveStatement::ArchiveStatement(ArchiveStatement&& other) = default;
+
 ArchiveStatement::~ArchiveStatement() = default;
 
 bool ArchiveStatement::IsValid() const {
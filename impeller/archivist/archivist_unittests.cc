@@ -182,6 +182,46 @@ TEST_F(ArchiveTest, ReadDataWithNames) {
   }
 }
 
+TEST_F(ArchiveTest, ReadAsyncWrittenData) {
+  Archive archive(GetArchiveFileName().c_str());
+  ASSERT_TRUE(archive.IsValid());
+
+  // More writes than may be pending, so that some of them wait for the
+  // writer.
+  size_t count = Archive::kMaxPendingWrites * 3;
+
+  std::vector<PrimaryKey::value_type> keys;
+  std::vector<uint64_t> values;
+
+  for (size_t i = 0; i < count; i++) {
+    Sample sample(i + 1);
+    keys.push_back(sample.GetPrimaryKey().value());
+    values.push_back(sample.GetSomeData());
+    ASSERT_TRUE(archive.WriteAsync(std::move(sample)));
+  }
+  ASSERT_TRUE(archive.Flush());
+
+  for (size_t i = 0; i < count; i++) {
+    Sample sample;
+    ASSERT_TRUE(archive.Read(keys[i], sample));
+    ASSERT_EQ(values[i], sample.GetSomeData());
+  }
+}
+
+TEST_F(ArchiveTest, SyncReadsWaitForAsyncWrites) {
+  Archive archive(GetArchiveFileName().c_str());
+  ASSERT_TRUE(archive.IsValid());
+
+  Sample sample(1988);
+  auto key = sample.GetPrimaryKey().value();
+  ASSERT_TRUE(archive.WriteAsync(std::move(sample)));
+
+  Sample other;
+  ASSERT_TRUE(archive.Read(key, other));
+  ASSERT_EQ(other.GetSomeData(), 1988u);
+  ASSERT_TRUE(archive.Flush());
+}
+
 TEST_F(ArchiveTest, CanReadWriteVectorOfArchivables) {
   Archive archive(GetArchiveFileName().c_str());
   ASSERT_TRUE(archive.IsValid());
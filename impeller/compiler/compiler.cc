@@ -146,6 +146,20 @@ static CompilerBackend CreateGLSLCompiler(const spirv_cross::ParsedIR& ir,
     }
   }
 
+  // Subpass inputs don't exist in GLSL. Read them from the framebuffer with
+  // EXT_shader_framebuffer_fetch instead, which is only used by backends that
+  // report support for framebuffer fetch. The input attachment index is
+  // assumed to match the color attachment location.
+  for (const auto& subpass_input :
+       gl_compiler->get_shader_resources().subpass_inputs) {
+    gl_compiler->remap_ext_framebuffer_fetch(
+        gl_compiler->get_decoration(subpass_input.id,
+                                    spv::DecorationInputAttachmentIndex),
+        gl_compiler->get_decoration(subpass_input.id,
+                                    spv::DecorationInputAttachmentIndex),
+        /*coherent=*/true);
+  }
+
   spirv_cross::CompilerGLSL::Options sl_options;
   sl_options.force_zero_initialized_variables = true;
   sl_options.vertex.fixup_clipspace = true;
@@ -251,6 +265,7 @@ Compiler::Compiler(const std::shared_ptr<const fml::Mapping>& source_mapping,
   // Make sure reflection is as effective as possible. The generated shaders
   // will be processed later by backend specific compilers.
   spirv_options.generate_debug_info = true;
+  spirv_options.optimization_level = source_options.optimization_level;
 
   switch (options_.source_language) {
     case SourceLanguage::kGLSL:
@@ -483,5 +498,12 @@ const Reflector* Compiler::GetReflector() const {
   return reflector_.get();
 }
 
+std::optional<ShaderStats> Compiler::GetShaderStats() const {
+  if (!IsValid()) {
+    return std::nullopt;
+  }
+  return ShaderStats::Compute(options_.type, *spirv_assembly_, *sl_mapping_);
+}
+
 }  // namespace compiler
 }  // namespace impeller
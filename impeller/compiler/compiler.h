@@ -5,6 +5,7 @@
 #pragma once
 
 #include <initializer_list>
+#include <optional>
 #include <sstream>
 #include <string>
 
@@ -12,6 +13,7 @@
 #include "flutter/fml/mapping.h"
 #include "impeller/compiler/include_dir.h"
 #include "impeller/compiler/reflector.h"
+#include "impeller/compiler/shader_stats.h"
 #include "impeller/compiler/source_options.h"
 #include "impeller/compiler/spirv_compiler.h"
 #include "impeller/compiler/types.h"
@@ -44,6 +46,8 @@ class Compiler {
 
   const Reflector* GetReflector() const;
 
+  std::optional<ShaderStats> GetShaderStats() const;
+
  private:
   SourceOptions options_;
   std::shared_ptr<fml::Mapping> spirv_assembly_;
@@ -2,10 +2,13 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <string>
+
 #include "flutter/testing/testing.h"
 #include "impeller/base/validation.h"
 #include "impeller/compiler/compiler.h"
 #include "impeller/compiler/compiler_test.h"
+#include "impeller/compiler/shader_stats.h"
 #include "impeller/compiler/source_options.h"
 #include "impeller/compiler/types.h"
 
@@ -25,6 +28,37 @@ TEST(CompilerTest, ShaderKindMatchingIsSuccessful) {
   ASSERT_EQ(SourceTypeFromFileName("hello.glsl"), SourceType::kUnknown);
 }
 
+TEST(CompilerTest, ShaderStatsCountFunctionInstructions) {
+  const uint32_t words[] = {
+      // Header.
+      spv::MagicNumber, 0x00010000, 0, 5, 0,
+      // OpDecorate %1 RelaxedPrecision.
+      (3 << spv::WordCountShift) | spv::OpDecorate, 1,
+      spv::DecorationRelaxedPrecision,
+      // OpFunction %2 %3 None %4.
+      (5 << spv::WordCountShift) | spv::OpFunction, 2, 3, 0, 4,
+      // OpLabel %5.
+      (2 << spv::WordCountShift) | spv::OpLabel, 5,
+      // OpReturn.
+      (1 << spv::WordCountShift) | spv::OpReturn,
+      // OpFunctionEnd.
+      (1 << spv::WordCountShift) | spv::OpFunctionEnd,
+  };
+  fml::NonOwnedMapping spirv(reinterpret_cast<const uint8_t*>(words),
+                             sizeof(words));
+  fml::NonOwnedMapping sl(reinterpret_cast<const uint8_t*>(words), 8u);
+
+  auto stats = ShaderStats::Compute(SourceType::kFragmentShader, spirv, sl);
+  ASSERT_TRUE(stats.has_value());
+  ASSERT_EQ(stats->spirv_size, sizeof(words));
+  ASSERT_EQ(stats->sl_size, 8u);
+  ASSERT_EQ(stats->instruction_count, 1u);
+  ASSERT_EQ(stats->relaxed_precision_count, 1u);
+  ASSERT_TRUE(stats->GetSuggestions().empty());
+
+  ASSERT_FALSE(ShaderStats::Compute(SourceType::kFragmentShader, sl, sl));
+}
+
 TEST_P(CompilerTest, CanCompile) {
   ASSERT_TRUE(CanCompileAndReflect("sample.vert"));
   ASSERT_TRUE(CanCompileAndReflect("sample.vert", SourceType::kVertexShader));
@@ -123,6 +157,22 @@ TEST_P(CompilerTest, UniformsHaveBindingAndSet) {
   ASSERT_EQ(vert_uniform_binding.binding, 17u);
 }
 
+TEST_P(CompilerTest, SubpassInputsUseFramebufferFetchOnGLES) {
+  if (!TargetPlatformIsOpenGL(GetParam())) {
+    GTEST_SKIP();
+  }
+
+  ASSERT_TRUE(CanCompileAndReflect("sample_framebuffer_fetch.frag",
+                                   SourceType::kFragmentShader));
+
+  auto shader = GetShaderFile("sample_framebuffer_fetch.frag", GetParam());
+  ASSERT_TRUE(shader);
+  std::string source(reinterpret_cast<const char*>(shader->GetMapping()),
+                     shader->GetSize());
+  ASSERT_NE(source.find("GL_EXT_shader_framebuffer_fetch"), std::string::npos);
+  ASSERT_EQ(source.find("subpassInput"), std::string::npos);
+}
+
 #define INSTANTIATE_TARGET_PLATFORM_TEST_SUITE_P(suite_name)              \
   INSTANTIATE_TEST_SUITE_P(                                               \
       suite_name, CompilerTest,                                           \
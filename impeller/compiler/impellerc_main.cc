@@ -76,6 +76,7 @@ bool Main(const fml::CommandLine& command_line) {
   options.gles_language_version = switches.gles_language_version;
   options.metal_version = switches.metal_version;
   options.use_half_textures = switches.use_half_textures;
+  options.optimization_level = switches.optimization_level.value();
 
   Reflector::Options reflector_options;
   reflector_options.target_platform = switches.target_platform;
@@ -238,6 +239,25 @@ bool Main(const fml::CommandLine& command_line) {
     }
   }
 
+  if (!switches.shader_stats_name.empty()) {
+    auto stats = compiler.GetShaderStats();
+    if (!stats.has_value()) {
+      std::cerr << "Could not compute shader stats." << std::endl;
+      return false;
+    }
+    auto shader_stats_name = std::filesystem::absolute(
+        std::filesystem::current_path() / switches.shader_stats_name.c_str());
+    if (!fml::WriteAtomically(
+            *switches.working_directory,
+            Utf8FromPath(shader_stats_name).c_str(),
+            *stats->CreateJsonMapping(reflector_options.shader_name,
+                                      switches.target_platform))) {
+      std::cerr << "Could not write shader stats to "
+                << switches.shader_stats_name << std::endl;
+      return false;
+    }
+  }
+
   return true;
 }
 
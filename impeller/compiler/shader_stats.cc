@@ -0,0 +1,97 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/compiler/shader_stats.h"
+
+#include "inja/inja.hpp"
+#include "spirv_cross.hpp"
+
+namespace impeller {
+namespace compiler {
+
+std::optional<ShaderStats> ShaderStats::Compute(SourceType type,
+                                                const fml::Mapping& spirv,
+                                                const fml::Mapping& sl) {
+  // The module starts with a header of five words, after which every
+  // instruction starts with a word containing its word count and opcode.
+  constexpr size_t kHeaderWordCount = 5u;
+  const auto* words = reinterpret_cast<const uint32_t*>(spirv.GetMapping());
+  const size_t word_count = spirv.GetSize() / sizeof(uint32_t);
+  if (word_count < kHeaderWordCount || words[0] != spv::MagicNumber) {
+    return std::nullopt;
+  }
+
+  ShaderStats stats;
+  stats.type = type;
+  stats.spirv_size = spirv.GetSize();
+  stats.sl_size = sl.GetSize();
+
+  bool in_function = false;
+  for (size_t i = kHeaderWordCount; i < word_count;) {
+    const uint32_t instruction_words = words[i] >> spv::WordCountShift;
+    const auto op = static_cast<spv::Op>(words[i] & spv::OpCodeMask);
+    if (instruction_words == 0u || i + instruction_words > word_count) {
+      return std::nullopt;
+    }
+    switch (op) {
+      case spv::OpFunction:
+        in_function = true;
+        break;
+      case spv::OpFunctionEnd:
+        in_function = false;
+        break;
+      case spv::OpLabel:
+      case spv::OpLine:
+      case spv::OpNoLine:
+        break;
+      case spv::OpDecorate:
+        if (instruction_words >= 3u &&
+            words[i + 2] == spv::DecorationRelaxedPrecision) {
+          stats.relaxed_precision_count++;
+        }
+        break;
+      default:
+        if (in_function) {
+          stats.instruction_count++;
+        }
+        break;
+    }
+    i += instruction_words;
+  }
+  return stats;
+}
+
+std::vector<std::string> ShaderStats::GetSuggestions() const {
+  std::vector<std::string> suggestions;
+  if (type == SourceType::kFragmentShader && relaxed_precision_count == 0u) {
+    suggestions.emplace_back(
+        "No values use mediump. Declaring `precision mediump float;` and "
+        "keeping only the values that need it at highp lowers register "
+        "pressure and ALU cost on mobile GPUs.");
+  }
+  return suggestions;
+}
+
+std::shared_ptr<fml::Mapping> ShaderStats::CreateJsonMapping(
+    const std::string& shader_name,
+    TargetPlatform platform) const {
+  nlohmann::json root;
+  root["shader_name"] = shader_name;
+  root["shader_type"] = SourceTypeToString(type);
+  root["target_platform"] = TargetPlatformToString(platform);
+  root["spirv_size"] = spirv_size;
+  root["sl_size"] = sl_size;
+  root["instruction_count"] = instruction_count;
+  root["relaxed_precision_count"] = relaxed_precision_count;
+  root["suggestions"] = GetSuggestions();
+
+  auto json_string = std::make_shared<std::string>(root.dump(2u));
+
+  return std::make_shared<fml::NonOwnedMapping>(
+      reinterpret_cast<const uint8_t*>(json_string->data()),
+      json_string->size(), [json_string](auto, auto) {});
+}
+
+}  // namespace compiler
+}  // namespace impeller
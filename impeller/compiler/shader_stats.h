@@ -0,0 +1,51 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/mapping.h"
+#include "impeller/compiler/types.h"
+
+namespace impeller {
+namespace compiler {
+
+//------------------------------------------------------------------------------
+/// @brief      Size and cost estimates of a compiled shader.
+///
+///             These are counted on the SPIR-V and don't account for what the
+///             drivers do with it. For register usage and cycle counts of
+///             specific GPUs, see the offline compiler reports in
+///             `impeller/tools/malioc.json`.
+///
+struct ShaderStats {
+  SourceType type = SourceType::kUnknown;
+  /// The size of the intermediate SPIR-V, including debug information.
+  size_t spirv_size = 0u;
+  /// The size of the shader as it is shipped for the target platform.
+  size_t sl_size = 0u;
+  /// The number of SPIR-V instructions in function bodies, not counting
+  /// labels and debug line information.
+  size_t instruction_count = 0u;
+  /// The number of results and variables decorated as relaxed precision,
+  /// which is what `mediump` compiles to.
+  size_t relaxed_precision_count = 0u;
+
+  static std::optional<ShaderStats> Compute(SourceType type,
+                                            const fml::Mapping& spirv,
+                                            const fml::Mapping& sl);
+
+  std::vector<std::string> GetSuggestions() const;
+
+  std::shared_ptr<fml::Mapping> CreateJsonMapping(
+      const std::string& shader_name,
+      TargetPlatform platform) const;
+};
+
+}  // namespace compiler
+}  // namespace impeller
@@ -33,6 +33,10 @@ struct SourceOptions {
   /// opengl semantics. Only used on metal targets.
   bool use_half_textures = false;
 
+  /// @brief The spirv-opt passes to run. SkSL targets are never optimized.
+  shaderc_optimization_level optimization_level =
+      shaderc_optimization_level::shaderc_optimization_level_performance;
+
   SourceOptions();
 
   ~SourceOptions();
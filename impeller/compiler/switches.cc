@@ -28,6 +28,14 @@ static const std::map<std::string, TargetPlatform> kKnownPlatforms = {
     {"runtime-stage-vulkan", TargetPlatform::kRuntimeStageVulkan},
 };
 
+static const std::map<std::string, shaderc_optimization_level>
+    kKnownOptimizationLevels = {
+        {"zero", shaderc_optimization_level::shaderc_optimization_level_zero},
+        {"size", shaderc_optimization_level::shaderc_optimization_level_size},
+        {"performance",
+         shaderc_optimization_level::shaderc_optimization_level_performance},
+};
+
 static const std::map<std::string, SourceType> kKnownSourceTypes = {
     {"vert", SourceType::kVertexShader},
     {"frag", SourceType::kFragmentShader},
@@ -75,6 +83,12 @@ void Switches::PrintHelp(std::ostream& stream) {
   stream << "[optional] --use-half-textures (force openGL semantics when "
             "targeting metal)"
          << std::endl;
+  stream << "[optional] --optimization-level={";
+  for (const auto& level : kKnownOptimizationLevels) {
+    stream << level.first << ", ";
+  }
+  stream << "} (default: performance)" << std::endl;
+  stream << "[optional] --shader-stats=<shader_stats_json_file>" << std::endl;
 }
 
 Switches::Switches() = default;
@@ -99,6 +113,20 @@ static TargetPlatform TargetPlatformFromCommandLine(
   return target;
 }
 
+static std::optional<shaderc_optimization_level>
+OptimizationLevelFromCommandLine(const fml::CommandLine& command_line) {
+  auto level_option =
+      command_line.GetOptionValueWithDefault("optimization-level", "");
+  if (level_option.empty()) {
+    return shaderc_optimization_level::shaderc_optimization_level_performance;
+  }
+  auto level_search = kKnownOptimizationLevels.find(level_option);
+  if (level_search == kKnownOptimizationLevels.end()) {
+    return std::nullopt;
+  }
+  return level_search->second;
+}
+
 static SourceType SourceTypeFromCommandLine(
     const fml::CommandLine& command_line) {
   auto source_type_option =
@@ -136,7 +164,10 @@ Switches::Switches(const fml::CommandLine& command_line)
           command_line.GetOptionValueWithDefault("metal-version", "1.2")),
       entry_point(
           command_line.GetOptionValueWithDefault("entry-point", "main")),
-      use_half_textures(command_line.HasOption("use-half-textures")) {
+      use_half_textures(command_line.HasOption("use-half-textures")),
+      optimization_level(OptimizationLevelFromCommandLine(command_line)),
+      shader_stats_name(
+          command_line.GetOptionValueWithDefault("shader-stats", "")) {
   auto language =
       command_line.GetOptionValueWithDefault("source-language", "glsl");
   std::transform(language.begin(), language.end(), language.begin(),
@@ -223,6 +254,11 @@ bool Switches::AreValid(std::ostream& explain) const {
     explain << "Spirv file name was empty." << std::endl;
     valid = false;
   }
+
+  if (!optimization_level.has_value()) {
+    explain << "Invalid optimization level." << std::endl;
+    valid = false;
+  }
   return valid;
 }
 
@@ -6,6 +6,7 @@
 
 #include <iostream>
 #include <memory>
+#include <optional>
 
 #include "flutter/fml/command_line.h"
 #include "flutter/fml/macros.h"
@@ -37,6 +38,9 @@ struct Switches {
   std::string metal_version = "";
   std::string entry_point = "";
   bool use_half_textures = false;
+  std::optional<shaderc_optimization_level> optimization_level =
+      shaderc_optimization_level::shaderc_optimization_level_performance;
+  std::string shader_stats_name = "";
 
   Switches();
 
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include <initializer_list>
+#include <sstream>
 #include <vector>
 
 #include "flutter/fml/command_line.h"
@@ -69,6 +70,26 @@ TEST(SwitchesTest, EntryPointCanBeSetForHLSL) {
   ASSERT_EQ(switches.entry_point, "CustomEntryPoint");
 }
 
+TEST(SwitchesTest, OptimizationLevelDefaultsToPerformance) {
+  Switches switches = MakeSwitchesDesktopGL({});
+  ASSERT_TRUE(switches.AreValid(std::cout));
+  ASSERT_EQ(switches.optimization_level,
+            shaderc_optimization_level::shaderc_optimization_level_performance);
+}
+
+TEST(SwitchesTest, OptimizationLevelCanBeSet) {
+  Switches switches = MakeSwitchesDesktopGL({"--optimization-level=size"});
+  ASSERT_TRUE(switches.AreValid(std::cout));
+  ASSERT_EQ(switches.optimization_level,
+            shaderc_optimization_level::shaderc_optimization_level_size);
+}
+
+TEST(SwitchesTest, InvalidOptimizationLevelIsRejected) {
+  Switches switches = MakeSwitchesDesktopGL({"--optimization-level=fast"});
+  std::stringstream explain;
+  ASSERT_FALSE(switches.AreValid(explain));
+}
+
 TEST(SwitchesTEst, ConvertToEntrypointName) {
   ASSERT_EQ(ConvertToEntrypointName("mandelbrot_unrolled"),
             "mandelbrot_unrolled");
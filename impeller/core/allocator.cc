@@ -60,8 +60,12 @@ std::shared_ptr<Texture> Allocator::CreateTexture(
 
 void Allocator::DidAcquireSurfaceFrame() {}
 
+bool Allocator::IsNearMemoryBudget() const {
+  return false;
+}
+
 uint16_t Allocator::MinimumBytesPerRow(PixelFormat format) const {
-  return BytesPerPixelForPixelFormat(format);
+  return BytesPerBlockForPixelFormat(format);
 }
 
 }  // namespace impeller
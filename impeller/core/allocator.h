@@ -51,6 +51,11 @@ class Allocator {
   /// allocation pools.
   virtual void DidAcquireSurfaceFrame();
 
+  /// @brief Whether the device memory in use is close to the budget the
+  /// system is expected to give this process. Resources kept around for reuse
+  /// should be released while this is the case.
+  virtual bool IsNearMemoryBudget() const;
+
  protected:
   Allocator();
 
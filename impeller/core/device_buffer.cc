@@ -39,6 +39,8 @@ std::shared_ptr<Texture> DeviceBuffer::AsTexture(
   return texture;
 }
 
+void DeviceBuffer::Flush(Range range) {}
+
 const DeviceBufferDescriptor& DeviceBuffer::GetDeviceBufferDescriptor() const {
   return desc_;
 }
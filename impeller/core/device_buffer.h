@@ -45,6 +45,14 @@ class DeviceBuffer : public Buffer,
 
   virtual uint8_t* OnGetContents() const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Make writes through the pointer returned by `OnGetContents`
+  ///             visible to the device. Not necessary after `CopyHostBuffer`.
+  ///
+  /// @param[in]  range  The range of the contents that was written.
+  ///
+  virtual void Flush(Range range);
+
  protected:
   const DeviceBufferDescriptor desc_;
 
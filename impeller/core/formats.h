@@ -91,6 +91,12 @@ constexpr const char* StorageModeToString(StorageMode mode) {
 ///             esoteric formats and use blit passes to convert to a
 ///             non-esoteric pass.
 ///
+///             Block compressed formats are prefixed with the name of their
+///             compression scheme. They store blocks of 4x4 pixels in a fixed
+///             number of bytes, can only be sampled from, and are only
+///             available if `Capabilities::SupportsCompressedPixelFormat`
+///             says so.
+///
 enum class PixelFormat {
   kUnknown,
   kA8UNormInt,
@@ -109,6 +115,13 @@ enum class PixelFormat {
   kS8UInt,
   kD24UnormS8Uint,
   kD32FloatS8UInt,
+  // Block compressed formats.
+  kETC2R8G8B8UNormInt,
+  kETC2R8G8B8A8UNormInt,
+  kASTC4x4UNormInt,
+  kBC1R8G8B8A8UNormInt,
+  kBC3R8G8B8A8UNormInt,
+  kBC7R8G8B8A8UNormInt,
 };
 
 constexpr const char* PixelFormatToString(PixelFormat format) {
@@ -145,6 +158,18 @@ constexpr const char* PixelFormatToString(PixelFormat format) {
       return "D24UnormS8Uint";
     case PixelFormat::kD32FloatS8UInt:
       return "D32FloatS8UInt";
+    case PixelFormat::kETC2R8G8B8UNormInt:
+      return "ETC2R8G8B8UNormInt";
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+      return "ETC2R8G8B8A8UNormInt";
+    case PixelFormat::kASTC4x4UNormInt:
+      return "ASTC4x4UNormInt";
+    case PixelFormat::kBC1R8G8B8A8UNormInt:
+      return "BC1R8G8B8A8UNormInt";
+    case PixelFormat::kBC3R8G8B8A8UNormInt:
+      return "BC3R8G8B8A8UNormInt";
+    case PixelFormat::kBC7R8G8B8A8UNormInt:
+      return "BC7R8G8B8A8UNormInt";
   }
   FML_UNREACHABLE();
 }
@@ -444,10 +469,61 @@ constexpr size_t BytesPerPixelForPixelFormat(PixelFormat format) {
       return 8u;
     case PixelFormat::kR32G32B32A32Float:
       return 16u;
+    case PixelFormat::kETC2R8G8B8UNormInt:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kASTC4x4UNormInt:
+    case PixelFormat::kBC1R8G8B8A8UNormInt:
+    case PixelFormat::kBC3R8G8B8A8UNormInt:
+    case PixelFormat::kBC7R8G8B8A8UNormInt:
+      // Pixels of block compressed formats aren't addressable on their own.
+      // Use |BytesPerBlockForPixelFormat| instead.
+      return 0u;
   }
   return 0u;
 }
 
+constexpr bool IsBlockCompressedPixelFormat(PixelFormat format) {
+  switch (format) {
+    case PixelFormat::kETC2R8G8B8UNormInt:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kASTC4x4UNormInt:
+    case PixelFormat::kBC1R8G8B8A8UNormInt:
+    case PixelFormat::kBC3R8G8B8A8UNormInt:
+    case PixelFormat::kBC7R8G8B8A8UNormInt:
+      return true;
+    default:
+      return false;
+  }
+}
+
+//------------------------------------------------------------------------------
+/// @brief      The width and height in pixels of the blocks of a block
+///             compressed pixel format. Pixel formats that aren't block
+///             compressed are treated as having blocks of a single pixel.
+///
+constexpr size_t BlockDimensionForPixelFormat(PixelFormat format) {
+  return IsBlockCompressedPixelFormat(format) ? 4u : 1u;
+}
+
+//------------------------------------------------------------------------------
+/// @brief      The number of bytes each block of a pixel format takes, see
+///             `BlockDimensionForPixelFormat`.
+///
+constexpr size_t BytesPerBlockForPixelFormat(PixelFormat format) {
+  switch (format) {
+    case PixelFormat::kETC2R8G8B8UNormInt:
+    case PixelFormat::kBC1R8G8B8A8UNormInt:
+      return 8u;
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kASTC4x4UNormInt:
+    case PixelFormat::kBC3R8G8B8A8UNormInt:
+    case PixelFormat::kBC7R8G8B8A8UNormInt:
+      return 16u;
+    default:
+      return BytesPerPixelForPixelFormat(format);
+  }
+}
+
 //------------------------------------------------------------------------------
 /// @brief      Describe the color attachment that will be used with this
 ///             pipeline.
@@ -15,12 +15,27 @@
 
 namespace impeller {
 
+// The minimum size of the device buffers of the arenas. Most frames fit into
+// a single one.
+constexpr size_t kArenaBufferSize = 1024u * 1024u;
+
 std::shared_ptr<HostBuffer> HostBuffer::Create() {
   return std::shared_ptr<HostBuffer>(new HostBuffer());
 }
 
+std::shared_ptr<HostBuffer> HostBuffer::Create(
+    std::shared_ptr<Allocator> allocator) {
+  if (!allocator) {
+    return nullptr;
+  }
+  return std::shared_ptr<HostBuffer>(new HostBuffer(std::move(allocator)));
+}
+
 HostBuffer::HostBuffer() = default;
 
+HostBuffer::HostBuffer(std::shared_ptr<Allocator> allocator)
+    : allocator_(std::move(allocator)) {}
+
 HostBuffer::~HostBuffer() = default;
 
 void HostBuffer::SetLabel(std::string label) {
@@ -30,6 +45,13 @@ void HostBuffer::SetLabel(std::string label) {
 BufferView HostBuffer::Emplace(const void* buffer,
                                size_t length,
                                size_t align) {
+  if (allocator_) {
+    return EmplaceInArena(length, align, [buffer, length](uint8_t* contents) {
+      if (buffer) {
+        ::memmove(contents, buffer, length);
+      }
+    });
+  }
   if (align == 0 || (GetLength() % align) == 0) {
     return Emplace(buffer, length);
   }
@@ -62,6 +84,9 @@ BufferView HostBuffer::Emplace(size_t length,
   if (!cb) {
     return {};
   }
+  if (allocator_) {
+    return EmplaceInArena(length, align, cb);
+  }
   auto old_length = GetLength();
   if (!Truncate(old_length + length)) {
     return {};
@@ -72,8 +97,58 @@ BufferView HostBuffer::Emplace(size_t length,
   return BufferView{shared_from_this(), GetBuffer(), Range{old_length, length}};
 }
 
+BufferView HostBuffer::EmplaceInArena(size_t length,
+                                      size_t align,
+                                      const EmplaceProc& cb) {
+  auto& arena = arenas_[arena_index_];
+  // Use the first buffer of the arena with enough space left. Device buffers
+  // are allocated with an alignment suitable for any use.
+  while (arena_buffer_index_ < arena.size()) {
+    auto offset = arena_buffer_offset_;
+    if (align > 0 && offset % align != 0) {
+      offset += align - (offset % align);
+    }
+    if (offset + length <=
+        arena[arena_buffer_index_]->GetDeviceBufferDescriptor().size) {
+      break;
+    }
+    arena_buffer_index_++;
+    arena_buffer_offset_ = 0u;
+  }
+
+  if (arena_buffer_index_ == arena.size()) {
+    DeviceBufferDescriptor desc;
+    desc.storage_mode = StorageMode::kHostVisible;
+    desc.size = std::max(length, kArenaBufferSize);
+    auto device_buffer = allocator_->CreateBuffer(desc);
+    if (!device_buffer || !device_buffer->OnGetContents()) {
+      return {};
+    }
+    if (!label_.empty()) {
+      device_buffer->SetLabel(label_);
+    }
+    arena.push_back(std::move(device_buffer));
+  }
+
+  auto& device_buffer = arena[arena_buffer_index_];
+  auto offset = arena_buffer_offset_;
+  if (align > 0 && offset % align != 0) {
+    offset += align - (offset % align);
+  }
+  arena_buffer_offset_ = offset + length;
+
+  auto contents = device_buffer->OnGetContents();
+  cb(contents + offset);
+  device_buffer->Flush(Range{offset, length});
+  return BufferView{device_buffer, contents, Range{offset, length}};
+}
+
 std::shared_ptr<const DeviceBuffer> HostBuffer::GetDeviceBuffer(
     Allocator& allocator) const {
+  // Views of arena allocations refer to the device buffers directly.
+  if (allocator_) {
+    return nullptr;
+  }
   if (generation_ == device_buffer_generation_) {
     return device_buffer_;
   }
@@ -88,6 +163,18 @@ std::shared_ptr<const DeviceBuffer> HostBuffer::GetDeviceBuffer(
 }
 
 void HostBuffer::Reset() {
+  if (allocator_) {
+    // Buffers of the current arena that were not needed this frame are
+    // released. They are at least a full cycle of arenas old.
+    auto& arena = arenas_[arena_index_];
+    if (arena_buffer_index_ + 1u < arena.size()) {
+      arena.resize(arena_buffer_index_ + 1u);
+    }
+    arena_index_ = (arena_index_ + 1u) % kHostBufferArenaSize;
+    arena_buffer_index_ = 0u;
+    arena_buffer_offset_ = 0u;
+    return;
+  }
   generation_ += 1;
   device_buffer_ = nullptr;
   bool did_truncate = Truncate(0);
@@ -95,6 +182,15 @@ void HostBuffer::Reset() {
 }
 
 size_t HostBuffer::GetSize() const {
+  if (allocator_) {
+    size_t size = 0u;
+    for (const auto& arena : arenas_) {
+      for (const auto& device_buffer : arena) {
+        size += device_buffer->GetDeviceBufferDescriptor().size;
+      }
+    }
+    return size;
+  }
   return GetReservedLength();
 }
 
@@ -5,9 +5,11 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <memory>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/base/allocation.h"
@@ -17,12 +19,39 @@
 
 namespace impeller {
 
+class Allocator;
+class DeviceBuffer;
+
 class HostBuffer final : public std::enable_shared_from_this<HostBuffer>,
                          public Allocation,
                          public Buffer {
  public:
+  //----------------------------------------------------------------------------
+  /// @brief      The number of arenas a host buffer created with an allocator
+  ///             cycles through. Must be larger than the number of frames the
+  ///             device can have in flight.
+  ///
+  static constexpr size_t kHostBufferArenaSize = 4u;
+
   static std::shared_ptr<HostBuffer> Create();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Create a host buffer that emplaces data directly into host
+  ///             visible device buffers allocated from the allocator. This
+  ///             avoids copying the data into a new device buffer when it is
+  ///             used.
+  ///
+  ///             The device buffers form a ring of `kHostBufferArenaSize`
+  ///             arenas. A reset moves on to the next arena and reuses the
+  ///             device buffers it was given before. The buffer must therefore
+  ///             be reset once per frame, and not more often, so that the
+  ///             device is done with an arena by the time it is reused.
+  ///
+  /// @param[in]  allocator  The allocator for the device buffers.
+  ///
+  static std::shared_ptr<HostBuffer> Create(
+      std::shared_ptr<Allocator> allocator);
+
   // |Buffer|
   virtual ~HostBuffer();
 
@@ -126,14 +155,28 @@ class HostBuffer final : public std::enable_shared_from_this<HostBuffer>,
   size_t generation_ = 1u;
   std::string label_;
 
+  // Only set for host buffers that emplace into device buffers directly.
+  std::shared_ptr<Allocator> allocator_;
+  std::array<std::vector<std::shared_ptr<DeviceBuffer>>, kHostBufferArenaSize>
+      arenas_;
+  size_t arena_index_ = 0u;
+  size_t arena_buffer_index_ = 0u;
+  size_t arena_buffer_offset_ = 0u;
+
   // |Buffer|
   std::shared_ptr<const DeviceBuffer> GetDeviceBuffer(
       Allocator& allocator) const override;
 
   [[nodiscard]] BufferView Emplace(const void* buffer, size_t length);
 
+  [[nodiscard]] BufferView EmplaceInArena(size_t length,
+                                          size_t align,
+                                          const EmplaceProc& cb);
+
   HostBuffer();
 
+  explicit HostBuffer(std::shared_ptr<Allocator> allocator);
+
   FML_DISALLOW_COPY_AND_ASSIGN(HostBuffer);
 };
 
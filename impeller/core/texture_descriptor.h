@@ -51,14 +51,19 @@ struct TextureDescriptor {
     if (!IsValid()) {
       return 0u;
     }
-    return size.Area() * BytesPerPixelForPixelFormat(format);
+    const auto block = BlockDimensionForPixelFormat(format);
+    return GetBytesPerRow() * ((size.height + block - 1) / block);
   }
 
+  /// The number of bytes in a row of pixels, or of blocks for block
+  /// compressed formats.
   constexpr size_t GetBytesPerRow() const {
     if (!IsValid()) {
       return 0u;
     }
-    return size.width * BytesPerPixelForPixelFormat(format);
+    const auto block = BlockDimensionForPixelFormat(format);
+    return ((size.width + block - 1) / block) *
+           BytesPerBlockForPixelFormat(format);
   }
 
   constexpr bool SamplingOptionsAreValid() const {
@@ -46,9 +46,14 @@ namespace impeller {
 
 DlDispatcher::DlDispatcher() = default;
 
-DlDispatcher::DlDispatcher(Rect cull_rect) : canvas_(cull_rect) {}
+DlDispatcher::DlDispatcher(Rect cull_rect, DlPictureCache* picture_cache)
+    : canvas_(cull_rect), picture_cache_(picture_cache) {}
 
-DlDispatcher::DlDispatcher(IRect cull_rect) : canvas_(cull_rect) {}
+DlDispatcher::DlDispatcher(IRect cull_rect, DlPictureCache* picture_cache)
+    : canvas_(cull_rect), picture_cache_(picture_cache) {}
+
+DlDispatcher::DlDispatcher(DlPictureCache* picture_cache)
+    : picture_cache_(picture_cache) {}
 
 DlDispatcher::~DlDispatcher() = default;
 
@@ -182,6 +187,19 @@ static Matrix ToMatrix(const SkMatrix& m) {
   };
 }
 
+// The scale from the pixels of an image to the pixels of its texture. Tiled
+// images are larger than their texture, see |DlImage::impeller_tiles|.
+static Vector2 GetTextureScale(const flutter::DlImage& image) {
+  auto texture = image.impeller_texture();
+  auto dimensions = image.dimensions();
+  if (!texture || dimensions.isEmpty()) {
+    return {1, 1};
+  }
+  auto size = texture->GetSize();
+  return {static_cast<Scalar>(size.width) / dimensions.width(),
+          static_cast<Scalar>(size.height) / dimensions.height()};
+}
+
 // |flutter::DlOpReceiver|
 void DlDispatcher::setAntiAlias(bool aa) {
   // Nothing to do because AA is implicit.
@@ -426,7 +444,10 @@ void DlDispatcher::setColorSource(const flutter::DlColorSource* source) {
       auto x_tile_mode = ToTileMode(image_color_source->horizontal_tile_mode());
       auto y_tile_mode = ToTileMode(image_color_source->vertical_tile_mode());
       auto desc = ToSamplerDescriptor(image_color_source->sampling());
-      auto matrix = ToMatrix(image_color_source->matrix());
+      auto texture_scale = GetTextureScale(*image_color_source->image());
+      auto matrix = ToMatrix(image_color_source->matrix()) *
+                    Matrix::MakeScale(Vector2(1.0f / texture_scale.x,
+                                              1.0f / texture_scale.y));
       paint_.color_source = ColorSource::MakeImage(texture, x_tile_mode,
                                                    y_tile_mode, desc, matrix);
       return;
@@ -810,16 +831,7 @@ void DlDispatcher::drawRect(const SkRect& rect) {
 
 // |flutter::DlOpReceiver|
 void DlDispatcher::drawOval(const SkRect& bounds) {
-  if (bounds.width() == bounds.height()) {
-    canvas_.DrawCircle(skia_conversions::ToPoint(bounds.center()),
-                       bounds.width() * 0.5, paint_);
-  } else {
-    auto path = PathBuilder{}
-                    .AddOval(skia_conversions::ToRect(bounds))
-                    .SetConvexity(Convexity::kConvex)
-                    .TakePath();
-    canvas_.DrawPath(path, paint_);
-  }
+  canvas_.DrawOval(skia_conversions::ToRect(bounds), paint_);
 }
 
 // |flutter::DlOpReceiver|
@@ -827,11 +839,35 @@ void DlDispatcher::drawCircle(const SkPoint& center, SkScalar radius) {
   canvas_.DrawCircle(skia_conversions::ToPoint(center), radius, paint_);
 }
 
+static Size ToSimpleRadii(const SkRRect& rrect) {
+  return Size(rrect.getSimpleRadii().fX, rrect.getSimpleRadii().fY);
+}
+
+// Draws rect, simple rrect and oval paths with the dedicated canvas calls,
+// which have fast paths for mask blurs.
+static void SimplifyOrDrawPath(Canvas& canvas,
+                               const SkPath& path,
+                               const Paint& paint) {
+  SkRect rect;
+  SkRRect rrect;
+  SkRect oval;
+  if (path.isRect(&rect)) {
+    canvas.DrawRect(skia_conversions::ToRect(rect), paint);
+  } else if (path.isRRect(&rrect) && rrect.isSimple()) {
+    canvas.DrawRRect(skia_conversions::ToRect(rrect.rect()),
+                     ToSimpleRadii(rrect), paint);
+  } else if (path.isOval(&oval)) {
+    canvas.DrawOval(skia_conversions::ToRect(oval), paint);
+  } else {
+    canvas.DrawPath(skia_conversions::ToPath(path), paint);
+  }
+}
+
 // |flutter::DlOpReceiver|
 void DlDispatcher::drawRRect(const SkRRect& rrect) {
   if (rrect.isSimple()) {
     canvas_.DrawRRect(skia_conversions::ToRect(rrect.rect()),
-                      rrect.getSimpleRadii().fX, paint_);
+                      ToSimpleRadii(rrect), paint_);
   } else {
     canvas_.DrawPath(skia_conversions::ToPath(rrect), paint_);
   }
@@ -847,20 +883,7 @@ void DlDispatcher::drawDRRect(const SkRRect& outer, const SkRRect& inner) {
 
 // |flutter::DlOpReceiver|
 void DlDispatcher::drawPath(const SkPath& path) {
-  SkRect rect;
-  SkRRect rrect;
-  SkRect oval;
-  if (path.isRect(&rect)) {
-    canvas_.DrawRect(skia_conversions::ToRect(rect), paint_);
-  } else if (path.isRRect(&rrect) && rrect.isSimple()) {
-    canvas_.DrawRRect(skia_conversions::ToRect(rrect.rect()),
-                      rrect.getSimpleRadii().fX, paint_);
-  } else if (path.isOval(&oval) && oval.width() == oval.height()) {
-    canvas_.DrawCircle(skia_conversions::ToPoint(oval.center()),
-                       oval.width() * 0.5, paint_);
-  } else {
-    canvas_.DrawPath(skia_conversions::ToPath(path), paint_);
-  }
+  SimplifyOrDrawPath(canvas_, path, paint_);
 }
 
 // |flutter::DlOpReceiver|
@@ -920,6 +943,38 @@ void DlDispatcher::drawVertices(const flutter::DlVertices* vertices,
   canvas_.DrawVertices(MakeVertices(vertices), ToBlendMode(dl_mode), paint_);
 }
 
+// Draws the part of each tile of an image that the source rect covers, so
+// that the image is drawn at its full resolution.
+static void DrawImageRectTiles(
+    Canvas& canvas,
+    const std::vector<flutter::DlImage::ImpellerTile>& tiles,
+    const Rect& src,
+    const Rect& dst,
+    const Paint& paint,
+    const SamplerDescriptor& sampler) {
+  if (src.IsEmpty()) {
+    return;
+  }
+  const auto scale = Vector2(dst.size.width / src.size.width,
+                             dst.size.height / src.size.height);
+  for (const auto& tile : tiles) {
+    auto tile_src =
+        src.Intersection(skia_conversions::ToRect(SkRect::Make(tile.bounds)));
+    if (!tile_src.has_value()) {
+      continue;
+    }
+    auto tile_dst = Rect::MakeXYWH(
+        dst.origin.x + (tile_src->origin.x - src.origin.x) * scale.x,
+        dst.origin.y + (tile_src->origin.y - src.origin.y) * scale.y,
+        tile_src->size.width * scale.x, tile_src->size.height * scale.y);
+    auto texture_origin =
+        Point(tile.texture_bounds.fLeft, tile.texture_bounds.fTop);
+    canvas.DrawImageRect(std::make_shared<Image>(tile.texture),
+                         tile_src->Shift(-texture_origin), tile_dst, paint,
+                         sampler);
+  }
+}
+
 // |flutter::DlOpReceiver|
 void DlDispatcher::drawImage(const sk_sp<flutter::DlImage> image,
                              const SkPoint point,
@@ -931,13 +986,14 @@ void DlDispatcher::drawImage(const sk_sp<flutter::DlImage> image,
 
   auto texture = image->impeller_texture();
   if (!texture) {
+    has_unresolved_images_ = true;
     return;
   }
 
-  const auto size = texture->GetSize();
-  const auto src = SkRect::MakeWH(size.width, size.height);
+  const auto size = image->dimensions();
+  const auto src = SkRect::Make(size);
   const auto dest =
-      SkRect::MakeXYWH(point.fX, point.fY, size.width, size.height);
+      SkRect::MakeXYWH(point.fX, point.fY, size.width(), size.height());
 
   drawImageRect(image,                      // image
                 src,                        // source rect
@@ -956,9 +1012,20 @@ void DlDispatcher::drawImageRect(
     flutter::DlImageSampling sampling,
     bool render_with_attributes,
     SrcRectConstraint constraint = SrcRectConstraint::kFast) {
+  if (!image->impeller_texture()) {
+    has_unresolved_images_ = true;
+  }
+  if (auto tiles = image->impeller_tiles(); !tiles.empty()) {
+    DrawImageRectTiles(canvas_, tiles, skia_conversions::ToRect(src),
+                       skia_conversions::ToRect(dst),
+                       render_with_attributes ? paint_ : Paint(),
+                       ToSamplerDescriptor(sampling));
+    return;
+  }
+  auto texture_scale = GetTextureScale(*image);
   canvas_.DrawImageRect(
       std::make_shared<Image>(image->impeller_texture()),  // image
-      skia_conversions::ToRect(src),                       // source rect
+      skia_conversions::ToRect(src).Scale(texture_scale),  // source rect
       skia_conversions::ToRect(dst),                       // destination rect
       render_with_attributes ? paint_ : Paint(),           // paint
       ToSamplerDescriptor(sampling)                        // sampling
@@ -971,10 +1038,14 @@ void DlDispatcher::drawImageNine(const sk_sp<flutter::DlImage> image,
                                  const SkRect& dst,
                                  flutter::DlFilterMode filter,
                                  bool render_with_attributes) {
+  if (!image->impeller_texture()) {
+    has_unresolved_images_ = true;
+  }
   NinePatchConverter converter = {};
   converter.DrawNinePatch(
       std::make_shared<Image>(image->impeller_texture()),
-      Rect::MakeLTRB(center.fLeft, center.fTop, center.fRight, center.fBottom),
+      Rect::MakeLTRB(center.fLeft, center.fTop, center.fRight, center.fBottom)
+          .Scale(GetTextureScale(*image)),
       skia_conversions::ToRect(dst), ToSamplerDescriptor(filter), &canvas_,
       &paint_);
 }
@@ -989,9 +1060,17 @@ void DlDispatcher::drawAtlas(const sk_sp<flutter::DlImage> atlas,
                              flutter::DlImageSampling sampling,
                              const SkRect* cull_rect,
                              bool render_with_attributes) {
+  if (!atlas->impeller_texture()) {
+    has_unresolved_images_ = true;
+  }
+  auto texture_scale = GetTextureScale(*atlas);
+  auto texture_rects = skia_conversions::ToRects(tex, count);
+  for (auto& rect : texture_rects) {
+    rect = rect.Scale(texture_scale);
+  }
   canvas_.DrawAtlas(std::make_shared<Image>(atlas->impeller_texture()),
                     skia_conversions::ToRSXForms(xform, count),
-                    skia_conversions::ToRects(tex, count),
+                    std::move(texture_rects),
                     ToColors(colors, count), ToBlendMode(mode),
                     ToSamplerDescriptor(sampling),
                     skia_conversions::ToRect(cull_rect), paint_);
@@ -1028,9 +1107,12 @@ void DlDispatcher::drawDisplayList(
     canvas_.SaveLayer(save_paint);
   }
 
-  // TODO(131445): Remove this restriction if we can correctly cull with
-  // perspective transforms.
-  if (display_list->has_rtree() && !initial_matrix_.HasPerspective()) {
+  if (DrawCachedDisplayList(*display_list)) {
+    // The display list was drawn using its cached picture.
+  } else if (display_list->has_rtree() && !initial_matrix_.HasPerspective()) {
+    // TODO(131445): Remove this restriction if we can correctly cull with
+    // perspective transforms.
+    //
     // The canvas remembers the screen-space culling bounds clipped by
     // the surface and the history of clip calls. DisplayList can cull
     // the ops based on a rectangle expressed in its "destination bounds"
@@ -1056,6 +1138,65 @@ void DlDispatcher::drawDisplayList(
   paint_ = saved_paint;
 }
 
+bool DlDispatcher::DrawCachedDisplayList(
+    const flutter::DisplayList& display_list) {
+  if (!picture_cache_) {
+    return false;
+  }
+  // Copied as the transform is reset below.
+  const Matrix transform = canvas_.GetCurrentTransformation();
+  if (transform.HasPerspective()) {
+    return false;
+  }
+  // Pictures are recorded without culling. Display lists that are partially
+  // culled are cheaper to dispatch than to draw in full.
+  auto cull_bounds = canvas_.GetCurrentLocalCullingBounds();
+  if (cull_bounds.has_value() &&
+      !cull_bounds->Contains(skia_conversions::ToRect(display_list.bounds()))) {
+    return false;
+  }
+
+  // Record pictures without the translation so that they can be reused when
+  // the display list moves. Some conversions, such as of shadows, depend on
+  // the rest of the transform.
+  Matrix basis = transform;
+  basis.m[12] = 0;
+  basis.m[13] = 0;
+  basis.m[14] = 0;
+
+  const Picture* picture =
+      picture_cache_->Find(display_list.unique_id(), basis);
+  Picture recorded_picture;
+  if (!picture) {
+    DlDispatcher dispatcher(picture_cache_);
+    // Cached pictures outlive the frame.
+    dispatcher.canvas_.SetUseArena(false);
+    dispatcher.canvas_.Transform(basis);
+    dispatcher.initial_matrix_ = basis;
+    display_list.Dispatch(dispatcher);
+    recorded_picture = dispatcher.EndRecordingAsPicture();
+    if (dispatcher.has_unresolved_images_) {
+      // Don't cache the picture until the images are available.
+      has_unresolved_images_ = true;
+      if (!DlPictureCache::CanCache(recorded_picture)) {
+        return false;
+      }
+      picture = &recorded_picture;
+    } else {
+      picture = &picture_cache_->Insert(display_list.unique_id(), basis,
+                                        std::move(recorded_picture));
+    }
+  }
+  if (!picture->pass) {
+    return false;
+  }
+
+  canvas_.ResetTransform();
+  canvas_.Translate(Vector3(transform.m[12], transform.m[13], transform.m[14]));
+  canvas_.DrawPicture(*picture);
+  return true;
+}
+
 // |flutter::DlOpReceiver|
 void DlDispatcher::drawTextBlob(const sk_sp<SkTextBlob> blob,
                                 SkScalar x,
@@ -1128,20 +1269,9 @@ void DlDispatcher::drawShadow(const SkPath& path,
   canvas_.PreConcat(
       Matrix::MakeTranslation(Vector2(0, -occluder_z * light_position.y)));
 
-  SkRect rect;
-  SkRRect rrect;
-  SkRect oval;
-  if (path.isRect(&rect)) {
-    canvas_.DrawRect(skia_conversions::ToRect(rect), paint);
-  } else if (path.isRRect(&rrect) && rrect.isSimple()) {
-    canvas_.DrawRRect(skia_conversions::ToRect(rrect.rect()),
-                      rrect.getSimpleRadii().fX, paint);
-  } else if (path.isOval(&oval) && oval.width() == oval.height()) {
-    canvas_.DrawCircle(skia_conversions::ToPoint(oval.center()),
-                       oval.width() * 0.5, paint);
-  } else {
-    canvas_.DrawPath(skia_conversions::ToPath(path), paint);
-  }
+  // Rects, rrects with equal corners and ovals are drawn with an analytic
+  // blur. Other shapes fall back to a mask blur of the path.
+  SimplifyOrDrawPath(canvas_, path, paint);
 
   canvas_.Restore();
 }
@@ -8,6 +8,7 @@
 #include "flutter/fml/macros.h"
 #include "impeller/aiks/canvas.h"
 #include "impeller/aiks/paint.h"
+#include "impeller/display_list/dl_picture_cache.h"
 
 namespace impeller {
 
@@ -15,9 +16,11 @@ class DlDispatcher final : public flutter::DlOpReceiver {
  public:
   DlDispatcher();
 
-  explicit DlDispatcher(Rect cull_rect);
+  explicit DlDispatcher(Rect cull_rect,
+                        DlPictureCache* picture_cache = nullptr);
 
-  explicit DlDispatcher(IRect cull_rect);
+  explicit DlDispatcher(IRect cull_rect,
+                        DlPictureCache* picture_cache = nullptr);
 
   ~DlDispatcher();
 
@@ -228,6 +231,21 @@ class DlDispatcher final : public flutter::DlOpReceiver {
   Paint paint_;
   Canvas canvas_;
   Matrix initial_matrix_;
+  DlPictureCache* picture_cache_ = nullptr;
+  bool has_unresolved_images_ = false;
+
+  explicit DlDispatcher(DlPictureCache* picture_cache);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Draw a nested display list using the picture it was converted
+  ///             to by a previous frame, recording and caching that picture
+  ///             if necessary.
+  ///
+  /// @return     Whether the display list was drawn. Display lists that are
+  ///             partially culled or that can't be cached must be dispatched
+  ///             instead.
+  ///
+  bool DrawCachedDisplayList(const flutter::DisplayList& display_list);
 
   FML_DISALLOW_COPY_AND_ASSIGN(DlDispatcher);
 };
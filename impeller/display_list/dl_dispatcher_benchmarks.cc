@@ -0,0 +1,510 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "flutter/display_list/benchmarking/dl_complexity.h"
+#include "flutter/display_list/benchmarking/dl_complexity_gl.h"
+#include "flutter/display_list/benchmarking/dl_complexity_metal.h"
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/effects/dl_image_filter.h"
+#include "flutter/fml/metrics.h"
+#include "flutter/testing/testing.h"
+#include "impeller/aiks/aiks_context.h"
+#include "impeller/display_list/dl_dispatcher.h"
+#include "impeller/entity/render_target_cache.h"
+#include "impeller/playground/playground.h"
+#include "impeller/typographer/backends/skia/typographer_context_skia.h"
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkRRect.h"
+
+namespace impeller {
+
+// Renders display lists through the |DlDispatcher| on the playground
+// backends. The op categories, op counts and geometry match those of the Skia
+// benchmarks in display_list/benchmarking/dl_benchmarks.cc so that the results
+// of both can be compared by name. The complexity scores the GL, Metal and
+// Impeller calculators assign to each display list are reported next to the
+// timings so the scores can be correlated with the measured costs.
+//
+// The timings cover the dispatch of the display list and the encoding and
+// submission of the frame. Frames are not waited upon, so the GPU time of a
+// frame is only measured insofar as the backend throttles submissions.
+
+namespace {
+
+using flutter::DisplayListBuilder;
+using flutter::DlPaint;
+
+constexpr size_t kLinesToDraw = 10000;
+constexpr size_t kRectsToDraw = 5000;
+constexpr size_t kOvalsToDraw = 1000;
+constexpr size_t kCirclesToDraw = 5000;
+constexpr size_t kRRectsToDraw = 5000;
+constexpr size_t kClipsToDraw = 500;
+constexpr size_t kFixedCanvasSize = 1024;
+
+class BenchmarkPlayground final : public Playground {
+ public:
+  BenchmarkPlayground() : Playground(PlaygroundSwitches{}) {}
+
+  // |Playground|
+  std::unique_ptr<fml::Mapping> OpenAssetAsMapping(
+      std::string asset_name) const override {
+    return flutter::testing::OpenFixtureAsMapping(asset_name);
+  }
+
+  // |Playground|
+  std::string GetWindowTitle() const override {
+    return "DisplayList Dispatcher Benchmarks";
+  }
+};
+
+int64_t GetCounterValue(std::string_view name) {
+  return fml::MetricsRegistry::GetInstance().GetCounter(name)->GetValue();
+}
+
+DlPaint GetPaintForRun(bool stroked) {
+  DlPaint paint;
+  paint.setDrawStyle(stroked ? flutter::DlDrawStyle::kStroke
+                             : flutter::DlDrawStyle::kFill);
+  paint.setStrokeWidth(1.0f);
+  paint.setAntiAlias(true);
+  return paint;
+}
+
+// Renders |display_list| into an offscreen target of |size| once per
+// iteration and annotates |state| with the complexity scores of the display
+// list and with the draw calls and pipeline switches issued per frame.
+void RenderDisplayList(benchmark::State& state,
+                       PlaygroundBackend backend,
+                       const sk_sp<flutter::DisplayList>& display_list,
+                       size_t size) {
+  if (!Playground::SupportsBackend(backend)) {
+    state.SkipWithError("Backend isn't supported.");
+    return;
+  }
+  BenchmarkPlayground playground;
+  playground.SetupContext(backend);
+  auto context = playground.GetContext();
+  if (!context) {
+    state.SkipWithError("Could not create a context.");
+    return;
+  }
+  AiksContext aiks_context(context, TypographerContextSkia::Make());
+  if (!aiks_context.IsValid()) {
+    state.SkipWithError("Could not create an Aiks context.");
+    return;
+  }
+  RenderTargetCache render_target_allocator(context->GetResourceAllocator());
+  const ISize target_size(size, size);
+  auto render_target = RenderTarget::CreateOffscreenMSAA(
+      *context, render_target_allocator, target_size, "Benchmark");
+
+  state.counters["ComplexityGL"] =
+      flutter::DisplayListGLComplexityCalculator::GetInstance()->Compute(
+          display_list.get());
+  state.counters["ComplexityMetal"] =
+      flutter::DisplayListMetalComplexityCalculator::GetInstance()->Compute(
+          display_list.get());
+  state.counters["ComplexityImpeller"] =
+      flutter::DisplayListComplexityCalculator::GetForImpeller(
+          context->GetCapabilities()->SupportsFramebufferFetch())
+          ->Compute(display_list.get());
+
+  const int64_t draw_calls = GetCounterValue("impeller.render_pass.draw_calls");
+  const int64_t pipeline_switches =
+      GetCounterValue("impeller.render_pass.pipeline_switches");
+  int64_t frame_count = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    aiks_context.GetContentContext().ResetTransientsBuffer();
+    DlDispatcher dispatcher(IRect::MakeSize(target_size));
+    display_list->Dispatch(dispatcher);
+    if (!aiks_context.Render(dispatcher.EndRecordingAsPicture(),
+                             render_target)) {
+      state.SkipWithError("Could not render the display list.");
+      break;
+    }
+    frame_count++;
+  }
+  if (frame_count == 0) {
+    return;
+  }
+
+  const auto per_frame = [frame_count](int64_t delta) {
+    return static_cast<double>(delta) / frame_count;
+  };
+  state.counters["GPUDrawCalls"] = per_frame(
+      GetCounterValue("impeller.render_pass.draw_calls") - draw_calls);
+  state.counters["PipelineSwitches"] = per_frame(
+      GetCounterValue("impeller.render_pass.pipeline_switches") -
+      pipeline_switches);
+}
+
+// Returns |n| points equally spaced out along the circumference of a circle
+// with radius |r| centered on |center|.
+std::vector<SkPoint> GetPolygonPoints(size_t n, SkPoint center, SkScalar r) {
+  std::vector<SkPoint> points;
+  points.reserve(n);
+  for (size_t i = 0; i < n; i++) {
+    const float angle = (2.0f * M_PI / n) * i;
+    points.push_back(SkPoint::Make(center.x() + r * std::cos(angle),
+                                   center.y() + r * std::sin(angle)));
+  }
+  return points;
+}
+
+// Adds |number| overlapping 20-sided polygons centered along a circle to
+// |path|, where the segments of each polygon are of the |type| verb.
+void MultiplyPath(SkPath& path,
+                  SkPath::Verb type,
+                  SkPoint center,
+                  size_t number,
+                  float radius) {
+  constexpr size_t kSides = 20;
+  for (SkPoint p : GetPolygonPoints(number, center, radius / 2.0f)) {
+    auto points = GetPolygonPoints(kSides, p, radius);
+    auto quad_controls = GetPolygonPoints(kSides * 2, p, radius * 0.8f);
+    auto inner = GetPolygonPoints(kSides * 3, p, radius * 0.8f);
+    auto outer = GetPolygonPoints(kSides * 3, p, radius * 1.2f);
+    path.moveTo(points[0]);
+    for (size_t i = 1; i <= kSides; i++) {
+      const SkPoint& end = points[i % kSides];
+      switch (type) {
+        case SkPath::Verb::kQuad_Verb:
+          path.quadTo(quad_controls[2 * i - 1], end);
+          break;
+        case SkPath::Verb::kCubic_Verb:
+          path.cubicTo(inner[3 * i - 2], outer[3 * i - 1], end);
+          break;
+        default:
+          path.lineTo(end);
+          break;
+      }
+    }
+    path.close();
+  }
+}
+
+}  // namespace
+
+void BM_DrawLine(benchmark::State& state,
+                 PlaygroundBackend backend,
+                 bool stroked) {
+  DisplayListBuilder builder;
+  DlPaint paint = GetPaintForRun(stroked);
+  size_t length = state.range(0);
+
+  state.counters["DrawCallCount"] = kLinesToDraw;
+  for (size_t i = 0; i < kLinesToDraw; i++) {
+    builder.DrawLine(SkPoint::Make(i % length, 0),
+                     SkPoint::Make(length - i % length, length), paint);
+  }
+  RenderDisplayList(state, backend, builder.Build(), length);
+}
+
+void BM_DrawRect(benchmark::State& state,
+                 PlaygroundBackend backend,
+                 bool stroked) {
+  DisplayListBuilder builder;
+  DlPaint paint = GetPaintForRun(stroked);
+  size_t length = state.range(0);
+  size_t canvas_size = length * 2;
+
+  SkRect rect = SkRect::MakeLTRB(0, 0, length, length);
+  state.counters["DrawCallCount"] = kRectsToDraw;
+  for (size_t i = 0; i < kRectsToDraw; i++) {
+    builder.DrawRect(rect, paint);
+    rect.offset(0.5f, 0.5f);
+    if (rect.right() > canvas_size) {
+      rect.offset(-canvas_size, 0);
+    }
+    if (rect.bottom() > canvas_size) {
+      rect.offset(0, -canvas_size);
+    }
+  }
+  RenderDisplayList(state, backend, builder.Build(), canvas_size);
+}
+
+void BM_DrawOval(benchmark::State& state,
+                 PlaygroundBackend backend,
+                 bool stroked) {
+  DisplayListBuilder builder;
+  DlPaint paint = GetPaintForRun(stroked);
+  size_t length = state.range(0);
+  size_t canvas_size = length * 2;
+
+  SkRect rect = SkRect::MakeXYWH(0, 0, length * 1.5f, length);
+  state.counters["DrawCallCount"] = kOvalsToDraw;
+  for (size_t i = 0; i < kOvalsToDraw; i++) {
+    builder.DrawOval(rect, paint);
+    rect.offset(0.5f, 0.5f);
+    if (rect.right() > canvas_size) {
+      rect.offset(-canvas_size, 0);
+    }
+    if (rect.bottom() > canvas_size) {
+      rect.offset(0, -canvas_size);
+    }
+  }
+  RenderDisplayList(state, backend, builder.Build(), canvas_size);
+}
+
+void BM_DrawCircle(benchmark::State& state,
+                   PlaygroundBackend backend,
+                   bool stroked) {
+  DisplayListBuilder builder;
+  DlPaint paint = GetPaintForRun(stroked);
+  size_t length = state.range(0);
+  size_t canvas_size = length * 2;
+
+  SkScalar radius = length / 2.0f;
+  SkPoint center = SkPoint::Make(radius, radius);
+  state.counters["DrawCallCount"] = kCirclesToDraw;
+  for (size_t i = 0; i < kCirclesToDraw; i++) {
+    builder.DrawCircle(center, radius, paint);
+    center.offset(0.5f, 0.5f);
+    if (center.x() + radius > canvas_size) {
+      center.set(radius, center.y());
+    }
+    if (center.y() + radius > canvas_size) {
+      center.set(center.x(), radius);
+    }
+  }
+  RenderDisplayList(state, backend, builder.Build(), canvas_size);
+}
+
+void BM_DrawRRect(benchmark::State& state,
+                  PlaygroundBackend backend,
+                  bool stroked) {
+  DisplayListBuilder builder;
+  DlPaint paint = GetPaintForRun(stroked);
+  size_t length = state.range(0);
+  size_t canvas_size = length * 2;
+
+  const SkScalar corner = 5.0f * length / 16.0f;
+  SkRRect rrect =
+      SkRRect::MakeRectXY(SkRect::MakeLTRB(0, 0, length, length), corner,
+                          corner);
+  state.counters["DrawCallCount"] = kRRectsToDraw;
+  for (size_t i = 0; i < kRRectsToDraw; i++) {
+    builder.DrawRRect(rrect, paint);
+    rrect.offset(0.5f, 0.5f);
+    if (rrect.rect().right() > canvas_size) {
+      rrect.offset(-canvas_size, 0);
+    }
+    if (rrect.rect().bottom() > canvas_size) {
+      rrect.offset(0, -canvas_size);
+    }
+  }
+  RenderDisplayList(state, backend, builder.Build(), canvas_size);
+}
+
+void BM_DrawPath(benchmark::State& state,
+                 PlaygroundBackend backend,
+                 bool stroked,
+                 SkPath::Verb type) {
+  DisplayListBuilder builder;
+  DlPaint paint = GetPaintForRun(stroked);
+  size_t length = kFixedCanvasSize;
+
+  SkPath path;
+  MultiplyPath(path, type, SkPoint::Make(length / 2.0f, length / 2.0f),
+               state.range(0), length * 0.25f);
+  state.SetComplexityN(state.range(0));
+  state.counters["VerbCount"] = path.countVerbs();
+  state.counters["DrawCallCount"] = 1;
+
+  builder.DrawPath(path, paint);
+  RenderDisplayList(state, backend, builder.Build(), length);
+}
+
+// Draws the same rects as |BM_SaveLayer| of the Skia benchmarks: N groups of
+// `save_depth` nested save layers.
+void BM_SaveLayer(benchmark::State& state,
+                  PlaygroundBackend backend,
+                  size_t save_depth) {
+  DisplayListBuilder builder;
+  DlPaint paint = GetPaintForRun(false);
+  size_t length = kFixedCanvasSize;
+  size_t save_layer_calls = state.range(0);
+
+  SkRect rect1 = SkRect::MakeLTRB(0, 0, 0.75f * length, 0.75f * length);
+  SkRect rect2 =
+      SkRect::MakeLTRB(0.25f * length, 0.25f * length, length, length);
+  state.counters["DrawCallCount_Varies"] = save_layer_calls * save_depth;
+  for (size_t i = 0; i < save_layer_calls; i++) {
+    for (size_t j = 0; j < save_depth; j++) {
+      builder.SaveLayer(nullptr, nullptr);
+      builder.DrawRect(rect1, paint);
+      builder.DrawRect(rect2, paint);
+    }
+    for (size_t j = 0; j < save_depth; j++) {
+      builder.Restore();
+    }
+  }
+  RenderDisplayList(state, backend, builder.Build(), length);
+}
+
+// Draws N blurred save layers of the requested sigma over a fixed canvas.
+// Blurs have no counterpart in the Skia benchmarks, but dominate the cost of
+// many Impeller frames.
+void BM_SaveLayerBlur(benchmark::State& state,
+                      PlaygroundBackend backend,
+                      float sigma) {
+  DisplayListBuilder builder;
+  DlPaint paint = GetPaintForRun(false);
+  size_t length = kFixedCanvasSize;
+  size_t save_layer_calls = state.range(0);
+  DlPaint layer_paint;
+  layer_paint.setImageFilter(flutter::DlBlurImageFilter::Make(
+      sigma, sigma, flutter::DlTileMode::kClamp));
+
+  SkRect rect = SkRect::MakeLTRB(0.25f * length, 0.25f * length,
+                                 0.75f * length, 0.75f * length);
+  state.counters["DrawCallCount"] = save_layer_calls;
+  for (size_t i = 0; i < save_layer_calls; i++) {
+    builder.SaveLayer(nullptr, &layer_paint);
+    builder.DrawRect(rect, paint);
+    builder.Restore();
+  }
+  RenderDisplayList(state, backend, builder.Build(), length);
+}
+
+// Draws `kClipsToDraw` rects, each clipped by a path with N cubic polygons.
+// Path clips are drawn to the stencil buffer by Impeller.
+void BM_ClipPath(benchmark::State& state, PlaygroundBackend backend) {
+  DisplayListBuilder builder;
+  DlPaint paint = GetPaintForRun(false);
+  size_t length = kFixedCanvasSize;
+
+  SkPath path;
+  MultiplyPath(path, SkPath::Verb::kCubic_Verb,
+               SkPoint::Make(length / 2.0f, length / 2.0f), state.range(0),
+               length * 0.25f);
+  state.SetComplexityN(state.range(0));
+  state.counters["VerbCount"] = path.countVerbs();
+  state.counters["DrawCallCount"] = kClipsToDraw;
+
+  SkRect rect = SkRect::MakeWH(length, length);
+  for (size_t i = 0; i < kClipsToDraw; i++) {
+    builder.Save();
+    builder.ClipPath(path, flutter::DlCanvas::ClipOp::kIntersect, true);
+    builder.DrawRect(rect, paint);
+    builder.Restore();
+  }
+  RenderDisplayList(state, backend, builder.Build(), length);
+}
+
+// clang-format off
+
+#define DISPATCHER_BENCHMARKS(BACKEND)                                     \
+  BENCHMARK_CAPTURE(BM_DrawLine, BACKEND,                                  \
+                    PlaygroundBackend::k##BACKEND, true)                   \
+      ->RangeMultiplier(2)                                                 \
+      ->Range(16, 2048)                                                    \
+      ->UseRealTime()                                                      \
+      ->Unit(benchmark::kMillisecond);                                     \
+  BENCHMARK_CAPTURE(BM_DrawRect, Fill/BACKEND,                             \
+                    PlaygroundBackend::k##BACKEND, false)                  \
+      ->RangeMultiplier(2)                                                 \
+      ->Range(16, 2048)                                                    \
+      ->UseRealTime()                                                      \
+      ->Unit(benchmark::kMillisecond);                                     \
+  BENCHMARK_CAPTURE(BM_DrawRect, Stroke/BACKEND,                           \
+                    PlaygroundBackend::k##BACKEND, true)                   \
+      ->RangeMultiplier(2)                                                 \
+      ->Range(16, 2048)                                                    \
+      ->UseRealTime()                                                      \
+      ->Unit(benchmark::kMillisecond);                                     \
+  BENCHMARK_CAPTURE(BM_DrawOval, Fill/BACKEND,                             \
+                    PlaygroundBackend::k##BACKEND, false)                  \
+      ->RangeMultiplier(2)                                                 \
+      ->Range(16, 2048)                                                    \
+      ->UseRealTime()                                                      \
+      ->Unit(benchmark::kMillisecond);                                     \
+  BENCHMARK_CAPTURE(BM_DrawCircle, Fill/BACKEND,                           \
+                    PlaygroundBackend::k##BACKEND, false)                  \
+      ->RangeMultiplier(2)                                                 \
+      ->Range(16, 2048)                                                    \
+      ->UseRealTime()                                                      \
+      ->Unit(benchmark::kMillisecond);                                     \
+  BENCHMARK_CAPTURE(BM_DrawRRect, Fill/BACKEND,                            \
+                    PlaygroundBackend::k##BACKEND, false)                  \
+      ->RangeMultiplier(2)                                                 \
+      ->Range(16, 256)                                                     \
+      ->UseRealTime()                                                      \
+      ->Unit(benchmark::kMillisecond);                                     \
+  BENCHMARK_CAPTURE(BM_DrawPath, Lines/BACKEND,                            \
+                    PlaygroundBackend::k##BACKEND, false,                  \
+                    SkPath::Verb::kLine_Verb)                              \
+      ->RangeMultiplier(2)                                                 \
+      ->Range(8, 512)                                                      \
+      ->UseRealTime()                                                      \
+      ->Unit(benchmark::kMillisecond)                                      \
+      ->Complexity();                                                      \
+  BENCHMARK_CAPTURE(BM_DrawPath, Quads/BACKEND,                            \
+                    PlaygroundBackend::k##BACKEND, false,                  \
+                    SkPath::Verb::kQuad_Verb)                              \
+      ->RangeMultiplier(2)                                                 \
+      ->Range(8, 512)                                                      \
+      ->UseRealTime()                                                      \
+      ->Unit(benchmark::kMillisecond)                                      \
+      ->Complexity();                                                      \
+  BENCHMARK_CAPTURE(BM_DrawPath, Cubics/BACKEND,                           \
+                    PlaygroundBackend::k##BACKEND, false,                  \
+                    SkPath::Verb::kCubic_Verb)                             \
+      ->RangeMultiplier(2)                                                 \
+      ->Range(8, 512)                                                      \
+      ->UseRealTime()                                                      \
+      ->Unit(benchmark::kMillisecond)                                      \
+      ->Complexity();                                                      \
+  BENCHMARK_CAPTURE(BM_SaveLayer, Depth 1/BACKEND,                         \
+                    PlaygroundBackend::k##BACKEND, 1)                      \
+      ->RangeMultiplier(2)                                                 \
+      ->Range(1, 128)                                                      \
+      ->UseRealTime()                                                      \
+      ->Unit(benchmark::kMillisecond);                                     \
+  BENCHMARK_CAPTURE(BM_SaveLayer, Depth 8/BACKEND,                         \
+                    PlaygroundBackend::k##BACKEND, 8)                      \
+      ->RangeMultiplier(2)                                                 \
+      ->Range(1, 128)                                                      \
+      ->UseRealTime()                                                      \
+      ->Unit(benchmark::kMillisecond);                                     \
+  BENCHMARK_CAPTURE(BM_SaveLayerBlur, Sigma 5/BACKEND,                     \
+                    PlaygroundBackend::k##BACKEND, 5.0f)                   \
+      ->RangeMultiplier(2)                                                 \
+      ->Range(1, 32)                                                       \
+      ->UseRealTime()                                                      \
+      ->Unit(benchmark::kMillisecond);                                     \
+  BENCHMARK_CAPTURE(BM_SaveLayerBlur, Sigma 40/BACKEND,                    \
+                    PlaygroundBackend::k##BACKEND, 40.0f)                  \
+      ->RangeMultiplier(2)                                                 \
+      ->Range(1, 32)                                                       \
+      ->UseRealTime()                                                      \
+      ->Unit(benchmark::kMillisecond);                                     \
+  BENCHMARK_CAPTURE(BM_ClipPath, BACKEND,                                  \
+                    PlaygroundBackend::k##BACKEND)                         \
+      ->RangeMultiplier(2)                                                 \
+      ->Range(1, 16)                                                       \
+      ->UseRealTime()                                                      \
+      ->Unit(benchmark::kMillisecond)                                      \
+      ->Complexity();
+
+// clang-format on
+
+#if IMPELLER_ENABLE_METAL
+DISPATCHER_BENCHMARKS(Metal)
+#endif  // IMPELLER_ENABLE_METAL
+#if IMPELLER_ENABLE_OPENGLES
+DISPATCHER_BENCHMARKS(OpenGLES)
+#endif  // IMPELLER_ENABLE_OPENGLES
+#if IMPELLER_ENABLE_VULKAN
+DISPATCHER_BENCHMARKS(Vulkan)
+#endif  // IMPELLER_ENABLE_VULKAN
+
+}  // namespace impeller
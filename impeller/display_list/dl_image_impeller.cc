@@ -18,6 +18,18 @@ sk_sp<DlImageImpeller> DlImageImpeller::Make(std::shared_ptr<Texture> texture,
       new DlImageImpeller(std::move(texture), owning_context));
 }
 
+sk_sp<DlImageImpeller> DlImageImpeller::MakeTiled(
+    std::shared_ptr<Texture> overview,
+    std::vector<ImpellerTile> tiles,
+    ISize dimensions,
+    OwningContext owning_context) {
+  if (!overview || tiles.empty()) {
+    return nullptr;
+  }
+  return sk_sp<DlImageImpeller>(new DlImageImpeller(
+      std::move(overview), std::move(tiles), dimensions, owning_context));
+}
+
 sk_sp<DlImageImpeller> DlImageImpeller::MakeFromYUVTextures(
     AiksContext* aiks_context,
     std::shared_ptr<Texture> y_texture,
@@ -30,12 +42,14 @@ sk_sp<DlImageImpeller> DlImageImpeller::MakeFromYUVTextures(
       std::move(y_texture), std::move(uv_texture), yuv_color_space);
   impeller::Entity entity;
   entity.SetBlendMode(impeller::BlendMode::kSource);
+  // The conversion covers every pixel of the snapshot, so there are no edges
+  // to antialias.
   auto snapshot = yuv_to_rgb_filter_contents->RenderToSnapshot(
       aiks_context->GetContentContext(),  // renderer
       entity,                             // entity
       std::nullopt,                       // coverage_limit
       std::nullopt,                       // sampler_descriptor
-      true,                               // msaa_enabled
+      false,                              // msaa_enabled
       "MakeYUVToRGBFilter Snapshot");     // label
   if (!snapshot.has_value()) {
     return nullptr;
@@ -47,6 +61,15 @@ DlImageImpeller::DlImageImpeller(std::shared_ptr<Texture> texture,
                                  OwningContext owning_context)
     : texture_(std::move(texture)), owning_context_(owning_context) {}
 
+DlImageImpeller::DlImageImpeller(std::shared_ptr<Texture> overview,
+                                 std::vector<ImpellerTile> tiles,
+                                 ISize dimensions,
+                                 OwningContext owning_context)
+    : texture_(std::move(overview)),
+      tiles_(std::move(tiles)),
+      dimensions_(dimensions),
+      owning_context_(owning_context) {}
+
 // |DlImage|
 DlImageImpeller::~DlImageImpeller() = default;
 
@@ -60,6 +83,12 @@ std::shared_ptr<impeller::Texture> DlImageImpeller::impeller_texture() const {
   return texture_;
 }
 
+// |DlImage|
+std::vector<DlImageImpeller::ImpellerTile> DlImageImpeller::impeller_tiles()
+    const {
+  return tiles_;
+}
+
 // |DlImage|
 bool DlImageImpeller::isOpaque() const {
   // Impeller doesn't currently implement opaque alpha types.
@@ -80,6 +109,9 @@ bool DlImageImpeller::isUIThreadSafe() const {
 
 // |DlImage|
 SkISize DlImageImpeller::dimensions() const {
+  if (dimensions_.has_value()) {
+    return SkISize::Make(dimensions_->width, dimensions_->height);
+  }
   const auto size = texture_ ? texture_->GetSize() : ISize{};
   return SkISize::Make(size.width, size.height);
 }
@@ -90,6 +122,9 @@ size_t DlImageImpeller::GetApproximateByteSize() const {
   if (texture_) {
     size += texture_->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
   }
+  for (const auto& tile : tiles_) {
+    size += tile.texture->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
+  }
   return size;
 }
 
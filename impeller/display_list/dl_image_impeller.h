@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <optional>
+#include <vector>
+
 #include "flutter/display_list/image/dl_image.h"
 #include "flutter/fml/macros.h"
 #include "impeller/core/texture.h"
@@ -18,6 +21,20 @@ class DlImageImpeller final : public flutter::DlImage {
       std::shared_ptr<Texture> texture,
       OwningContext owning_context = OwningContext::kIO);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Make an image that is too large for a single texture.
+  ///
+  /// @param[in]  overview    A downscaled copy of the whole image, which is
+  ///                         used where the image can't be drawn in tiles.
+  /// @param[in]  tiles       The tiles that cover the image at its full size.
+  /// @param[in]  dimensions  The full size of the image.
+  ///
+  static sk_sp<DlImageImpeller> MakeTiled(
+      std::shared_ptr<Texture> overview,
+      std::vector<ImpellerTile> tiles,
+      ISize dimensions,
+      OwningContext owning_context = OwningContext::kIO);
+
   static sk_sp<DlImageImpeller> MakeFromYUVTextures(
       AiksContext* aiks_context,
       std::shared_ptr<Texture> y_texture,
@@ -33,6 +50,9 @@ class DlImageImpeller final : public flutter::DlImage {
   // |DlImage|
   std::shared_ptr<impeller::Texture> impeller_texture() const override;
 
+  // |DlImage|
+  std::vector<ImpellerTile> impeller_tiles() const override;
+
   // |DlImage|
   bool isOpaque() const override;
 
@@ -53,11 +73,18 @@ class DlImageImpeller final : public flutter::DlImage {
 
  private:
   std::shared_ptr<Texture> texture_;
+  std::vector<ImpellerTile> tiles_;
+  std::optional<ISize> dimensions_;
   OwningContext owning_context_;
 
   explicit DlImageImpeller(std::shared_ptr<Texture> texture,
                            OwningContext owning_context = OwningContext::kIO);
 
+  DlImageImpeller(std::shared_ptr<Texture> overview,
+                  std::vector<ImpellerTile> tiles,
+                  ISize dimensions,
+                  OwningContext owning_context);
+
   FML_DISALLOW_COPY_AND_ASSIGN(DlImageImpeller);
 };
 
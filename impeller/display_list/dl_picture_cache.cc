@@ -0,0 +1,67 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/display_list/dl_picture_cache.h"
+
+namespace impeller {
+
+DlPictureCache::DlPictureCache() = default;
+
+DlPictureCache::~DlPictureCache() = default;
+
+bool DlPictureCache::CanCache(const Picture& picture) {
+  if (!picture.pass) {
+    return false;
+  }
+  // The opacity peephole of an enclosing save layer applies its opacity to
+  // the contents of the entities in the layer if there are no more than three
+  // of them. See |OpacityPeepholePassDelegate::CanCollapseIntoParentPass|.
+  return picture.pass->GetSubpassesDepth() == 1u &&
+         picture.pass->GetElementCount() > 3u;
+}
+
+const Picture* DlPictureCache::Find(uint32_t unique_id, const Matrix& basis) {
+  auto found = entries_.find(unique_id);
+  if (found == entries_.end() || found->second.basis != basis) {
+    return nullptr;
+  }
+  found->second.used_this_frame = true;
+  return &found->second.picture;
+}
+
+const Picture& DlPictureCache::Insert(uint32_t unique_id,
+                                      const Matrix& basis,
+                                      Picture picture) {
+  if (!CanCache(picture)) {
+    picture.pass.reset();
+  }
+  auto& entry = entries_[unique_id];
+  entry.basis = basis;
+  entry.picture = std::move(picture);
+  entry.used_this_frame = true;
+  return entry.picture;
+}
+
+void DlPictureCache::FinishFrame() {
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (!it->second.used_this_frame) {
+      it = entries_.erase(it);
+      continue;
+    }
+    it->second.used_this_frame = false;
+    ++it;
+  }
+}
+
+size_t DlPictureCache::GetPictureCount() const {
+  size_t count = 0u;
+  for (const auto& [unique_id, entry] : entries_) {
+    if (entry.picture.pass) {
+      count++;
+    }
+  }
+  return count;
+}
+
+}  // namespace impeller
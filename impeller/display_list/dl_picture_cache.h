@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "impeller/aiks/picture.h"
+#include "impeller/geometry/matrix.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Retains the pictures that display lists nested in a frame were
+///             converted to, so that display lists that are unchanged from
+///             the previous frame don't have to be dispatched again.
+///
+///             Display lists are immutable and identified by their unique id.
+///             Pictures are recorded without the translation of the
+///             transform they are drawn with, so a cached picture can still
+///             be used when the display list moves, such as while scrolling.
+///
+///             Pictures that aren't used for a frame are released when the
+///             frame is finished. The cache is not thread safe and must only
+///             be used on the thread frames are dispatched on.
+///
+class DlPictureCache {
+ public:
+  DlPictureCache();
+
+  ~DlPictureCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether a picture recorded for a display list can be reused
+  ///             by later frames.
+  ///
+  ///             The entities of a reused picture share their contents with
+  ///             the entities of every frame the picture was drawn in. Only
+  ///             pictures whose contents are never modified when the frame is
+  ///             rendered can be reused, that is those without save layers
+  ///             and with too many elements for the opacity of an enclosing
+  ///             save layer to be applied to their contents.
+  ///
+  static bool CanCache(const Picture& picture);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Find the picture recorded for a display list and mark it as
+  ///             used by the current frame.
+  ///
+  /// @param[in]  unique_id  The unique id of the display list.
+  /// @param[in]  basis      The transform the picture was recorded with.
+  ///
+  /// @return     The cached picture, or nullptr if there is none. The pass of
+  ///             the returned picture is null if the display list was found
+  ///             not to be cacheable.
+  ///
+  const Picture* Find(uint32_t unique_id, const Matrix& basis);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Retain a picture recorded for a display list. If the picture
+  ///             can't be cached, the display list is remembered as not
+  ///             cacheable instead.
+  ///
+  /// @return     The cached picture.
+  ///
+  const Picture& Insert(uint32_t unique_id,
+                        const Matrix& basis,
+                        Picture picture);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Release the pictures that weren't used by the current frame
+  ///             and start a new frame.
+  ///
+  void FinishFrame();
+
+  size_t GetPictureCount() const;
+
+ private:
+  struct Entry {
+    Matrix basis;
+    Picture picture;
+    bool used_this_frame = true;
+  };
+
+  std::unordered_map<uint32_t, Entry> entries_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DlPictureCache);
+};
+
+}  // namespace impeller
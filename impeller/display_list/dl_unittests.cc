@@ -943,6 +943,80 @@ TEST_P(DisplayListTest, TransparentShadowProducesCorrectColor) {
   ASSERT_EQ(rrect_blur->GetColor().alpha, 0);
 }
 
+static sk_sp<flutter::DisplayList> MakeRectsDisplayList(bool save_layer) {
+  flutter::DisplayListBuilder builder;
+  if (save_layer) {
+    builder.SaveLayer(nullptr, nullptr);
+  }
+  for (int i = 0; i < 4; i++) {
+    builder.DrawRect(SkRect::MakeXYWH(i * 10, 0, 5, 5),
+                     flutter::DlPaint(flutter::DlColor::kRed()));
+  }
+  if (save_layer) {
+    builder.Restore();
+  }
+  return builder.Build();
+}
+
+static std::vector<Entity> DispatchTranslated(
+    const sk_sp<flutter::DisplayList>& display_list,
+    Scalar dx,
+    DlPictureCache& picture_cache) {
+  DlDispatcher dispatcher(Rect::MakeLTRB(0, 0, 1000, 1000), &picture_cache);
+  dispatcher.translate(dx, 0);
+  dispatcher.drawDisplayList(display_list, 1.0f);
+  auto picture = dispatcher.EndRecordingAsPicture();
+  picture_cache.FinishFrame();
+
+  std::vector<Entity> entities;
+  picture.pass->IterateAllEntities([&entities](Entity& entity) {
+    entities.push_back(entity);
+    return true;
+  });
+  return entities;
+}
+
+TEST_P(DisplayListTest, DispatcherReusesCachedPicturesOfChildDisplayLists) {
+  DlPictureCache picture_cache;
+  auto display_list = MakeRectsDisplayList(false);
+
+  auto first_entities = DispatchTranslated(display_list, 10, picture_cache);
+  EXPECT_EQ(picture_cache.GetPictureCount(), 1u);
+  auto second_entities = DispatchTranslated(display_list, 20, picture_cache);
+  EXPECT_EQ(picture_cache.GetPictureCount(), 1u);
+
+  ASSERT_EQ(first_entities.size(), 4u);
+  ASSERT_EQ(second_entities.size(), 4u);
+  for (size_t i = 0; i < first_entities.size(); i++) {
+    EXPECT_EQ(first_entities[i].GetContents(),
+              second_entities[i].GetContents());
+    EXPECT_EQ(first_entities[i].GetTransformation(),
+              Matrix::MakeTranslation({10, 0}));
+    EXPECT_EQ(second_entities[i].GetTransformation(),
+              Matrix::MakeTranslation({20, 0}));
+  }
+
+  // Pictures that go unused for a frame are released.
+  DispatchTranslated(MakeRectsDisplayList(false), 0, picture_cache);
+  EXPECT_EQ(picture_cache.GetPictureCount(), 1u);
+  auto third_entities = DispatchTranslated(display_list, 10, picture_cache);
+  ASSERT_EQ(third_entities.size(), 4u);
+  EXPECT_NE(first_entities[0].GetContents(), third_entities[0].GetContents());
+}
+
+TEST_P(DisplayListTest, DispatcherDoesNotCacheChildDisplayListsWithLayers) {
+  DlPictureCache picture_cache;
+  auto display_list = MakeRectsDisplayList(true);
+
+  auto first_entities = DispatchTranslated(display_list, 10, picture_cache);
+  auto second_entities = DispatchTranslated(display_list, 10, picture_cache);
+  EXPECT_EQ(picture_cache.GetPictureCount(), 0u);
+
+  ASSERT_EQ(first_entities.size(), 4u);
+  ASSERT_EQ(second_entities.size(), 4u);
+  EXPECT_NE(first_entities[0].GetContents(), second_entities[0].GetContents());
+}
+
 // Draw a hexagon using triangle fan
 TEST_P(DisplayListTest, CanConvertTriangleFanToTriangles) {
   constexpr Scalar hexagon_radius = 125;
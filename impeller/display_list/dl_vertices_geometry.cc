@@ -58,8 +58,9 @@ std::shared_ptr<impeller::VerticesGeometry> MakeVertices(
           skia_conversions::ToPoint(vertices->texture_coordinates()[i]));
     }
   }
-  return std::make_shared<VerticesGeometry>(
-      positions, indices, texture_coordinates, colors, bounds, mode);
+  return std::make_shared<VerticesGeometry>(positions, indices,
+                                            texture_coordinates, colors, bounds,
+                                            mode, vertices->unique_id());
 }
 
 }  // namespace impeller
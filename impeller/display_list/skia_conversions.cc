@@ -121,6 +121,11 @@ Path ToPath(const SkPath& path, Point shift) {
   }
   builder.SetConvexity(path.isConvex() ? Convexity::kConvex
                                        : Convexity::kUnknown);
+  // Volatile paths change every frame, there is no use in caching anything
+  // derived from them.
+  if (!path.isVolatile() && shift.IsZero()) {
+    builder.SetGenerationID(path.getGenerationID());
+  }
   builder.Shift(shift);
   auto sk_bounds = path.getBounds().makeOutset(shift.x, shift.y);
   builder.SetBounds(ToRect(sk_bounds));
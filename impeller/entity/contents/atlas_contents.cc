@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <array>
 #include <optional>
 #include <unordered_map>
 #include <utility>
@@ -9,6 +10,8 @@
 #include "flutter/fml/macros.h"
 
 #include "impeller/core/formats.h"
+#include "impeller/core/host_buffer.h"
+#include "impeller/core/vertex_buffer.h"
 #include "impeller/entity/contents/atlas_contents.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/filters/blend_filter_contents.h"
@@ -23,7 +26,6 @@
 #include "impeller/geometry/color.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/sampler_library.h"
-#include "impeller/renderer/vertex_buffer_builder.h"
 
 namespace impeller {
 
@@ -65,6 +67,46 @@ void AtlasContents::SetCullRect(std::optional<Rect> cull_rect) {
   cull_rect_ = cull_rect;
 }
 
+namespace {
+
+/// The two triangles of a sprite, as indices into the corners returned by
+/// |Rect::GetPoints|.
+constexpr size_t kSpriteIndices[6] = {0, 1, 2, 1, 2, 3};
+
+/// Emplaces the vertices of |sprite_count| sprites, six per sprite, directly
+/// onto |host_buffer|. |write_sprite| is called with the index of each sprite
+/// and the location of its first vertex.
+template <typename VertexType, typename SpriteWriter>
+VertexBuffer EmplaceSpriteVertices(HostBuffer& host_buffer,
+                                   size_t sprite_count,
+                                   const SpriteWriter& write_sprite) {
+  const size_t vertex_count = sprite_count * 6;
+  auto buffer_view = host_buffer.Emplace(
+      vertex_count * sizeof(VertexType), alignof(VertexType),
+      [&](uint8_t* contents) {
+        auto vertices = reinterpret_cast<VertexType*>(contents);
+        for (size_t i = 0; i < sprite_count; i++) {
+          write_sprite(i, vertices + i * 6);
+        }
+      });
+  return {.vertex_buffer = buffer_view,
+          .vertex_count = vertex_count,
+          .index_type = IndexType::kNone};
+}
+
+/// Returns the texture coordinates of the corners of |sample_rect|, in the
+/// same order as |Rect::GetPoints|.
+std::array<Point, 4> GetSpriteTextureCoordinates(const Rect& sample_rect,
+                                                 const Size& texture_size) {
+  auto corners = sample_rect.GetPoints();
+  for (auto& corner : corners) {
+    corner = corner / texture_size;
+  }
+  return corners;
+}
+
+}  // namespace
+
 struct AtlasBlenderKey {
   Color color;
   Rect rect;
@@ -212,39 +254,28 @@ bool AtlasContents::Render(const ContentContext& renderer,
     return child_contents.Render(renderer, entity, pass);
   }
 
-  constexpr size_t indices[6] = {0, 1, 2, 1, 2, 3};
-  constexpr Scalar width[6] = {0, 1, 0, 1, 0, 1};
-  constexpr Scalar height[6] = {0, 0, 1, 0, 1, 1};
-
   if (blend_mode_ <= BlendMode::kModulate) {
     // Simple Porter-Duff blends can be accomplished without a subpass.
     using VS = PorterDuffBlendPipeline::VertexShader;
     using FS = PorterDuffBlendPipeline::FragmentShader;
 
-    VertexBufferBuilder<VS::PerVertexData> vtx_builder;
-    vtx_builder.Reserve(texture_coords_.size() * 6);
-    const auto texture_size = texture_->GetSize();
+    const Size texture_size(texture_->GetSize());
     auto& host_buffer = pass.GetTransientsBuffer();
 
-    for (size_t i = 0; i < texture_coords_.size(); i++) {
-      auto sample_rect = texture_coords_[i];
-      auto matrix = transforms_[i];
-      auto transformed_points =
-          Rect::MakeSize(sample_rect.size).GetTransformedPoints(matrix);
-      auto color = colors_[i].Premultiply();
-      for (size_t j = 0; j < 6; j++) {
-        VS::PerVertexData data;
-        data.vertices = transformed_points[indices[j]];
-        data.texture_coords =
-            (sample_rect.origin + Point(sample_rect.size.width * width[j],
-                                        sample_rect.size.height * height[j])) /
-            texture_size;
-        data.color = color;
-        vtx_builder.AppendVertex(data);
-      }
-    }
-
-    auto vtx_buffer = vtx_builder.CreateVertexBuffer(host_buffer);
+    auto vtx_buffer = EmplaceSpriteVertices<VS::PerVertexData>(
+        host_buffer, texture_coords_.size(),
+        [&](size_t i, VS::PerVertexData* vertices) {
+          const auto& sample_rect = texture_coords_[i];
+          auto positions = Rect::MakeSize(sample_rect.size)
+                               .GetTransformedPoints(transforms_[i]);
+          auto uvs = GetSpriteTextureCoordinates(sample_rect, texture_size);
+          auto color = colors_[i].Premultiply();
+          for (size_t j = 0; j < 6; j++) {
+            vertices[j].vertices = positions[kSpriteIndices[j]];
+            vertices[j].texture_coords = uvs[kSpriteIndices[j]];
+            vertices[j].color = color;
+          }
+        });
 
     Command cmd;
     DEBUG_COMMAND_INFO(
@@ -373,50 +404,39 @@ bool AtlasTextureContents::Render(const ContentContext& renderer,
     return true;
   }
 
-  std::vector<Rect> texture_coords;
-  std::vector<Matrix> transforms;
+  // Sprites can number in the thousands, so refer to their data instead of
+  // copying it.
+  const std::vector<Rect>* texture_coords = &parent_.GetTextureCoordinates();
+  const std::vector<Matrix>* transforms = &parent_.GetTransforms();
   if (subatlas_) {
-    texture_coords = use_destination_ ? subatlas_->result_texture_coords
-                                      : subatlas_->sub_texture_coords;
-    transforms = use_destination_ ? subatlas_->result_transforms
-                                  : subatlas_->sub_transforms;
-  } else {
-    texture_coords = parent_.GetTextureCoordinates();
-    transforms = parent_.GetTransforms();
-  }
-
-  const Size texture_size(texture->GetSize());
-  VertexBufferBuilder<VS::PerVertexData> vertex_builder;
-  vertex_builder.Reserve(texture_coords.size() * 6);
-  constexpr size_t indices[6] = {0, 1, 2, 1, 2, 3};
-  constexpr Scalar width[6] = {0, 1, 0, 1, 0, 1};
-  constexpr Scalar height[6] = {0, 0, 1, 0, 1, 1};
-  for (size_t i = 0; i < texture_coords.size(); i++) {
-    auto sample_rect = texture_coords[i];
-    auto matrix = transforms[i];
-    auto transformed_points =
-        Rect::MakeSize(sample_rect.size).GetTransformedPoints(matrix);
-
-    for (size_t j = 0; j < 6; j++) {
-      VS::PerVertexData data;
-      data.position = transformed_points[indices[j]];
-      data.texture_coords =
-          (sample_rect.origin + Point(sample_rect.size.width * width[j],
-                                      sample_rect.size.height * height[j])) /
-          texture_size;
-      vertex_builder.AppendVertex(data);
-    }
+    texture_coords = use_destination_ ? &subatlas_->result_texture_coords
+                                      : &subatlas_->sub_texture_coords;
+    transforms = use_destination_ ? &subatlas_->result_transforms
+                                  : &subatlas_->sub_transforms;
   }
 
-  if (!vertex_builder.HasVertices()) {
+  if (texture_coords->empty()) {
     return true;
   }
 
+  const Size texture_size(texture->GetSize());
+  auto& host_buffer = pass.GetTransientsBuffer();
+  auto vertex_buffer = EmplaceSpriteVertices<VS::PerVertexData>(
+      host_buffer, texture_coords->size(),
+      [&](size_t i, VS::PerVertexData* vertices) {
+        const auto& sample_rect = (*texture_coords)[i];
+        auto positions = Rect::MakeSize(sample_rect.size)
+                             .GetTransformedPoints((*transforms)[i]);
+        auto uvs = GetSpriteTextureCoordinates(sample_rect, texture_size);
+        for (size_t j = 0; j < 6; j++) {
+          vertices[j].position = positions[kSpriteIndices[j]];
+          vertices[j].texture_coords = uvs[kSpriteIndices[j]];
+        }
+      });
+
   Command cmd;
   DEBUG_COMMAND_INFO(cmd, "AtlasTexture");
 
-  auto& host_buffer = pass.GetTransientsBuffer();
-
   VS::FrameInfo frame_info;
   frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
                    entity.GetTransformation();
@@ -426,7 +446,7 @@ bool AtlasTextureContents::Render(const ContentContext& renderer,
   auto options = OptionsFromPassAndEntity(pass, entity);
   cmd.pipeline = renderer.GetTexturePipeline(options);
   cmd.stencil_reference = entity.GetStencilDepth();
-  cmd.BindVertices(vertex_builder.CreateVertexBuffer(host_buffer));
+  cmd.BindVertices(vertex_buffer);
   VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
   FS::BindTextureSampler(cmd, texture,
                          renderer.GetContext()->GetSamplerLibrary()->GetSampler(
@@ -466,45 +486,35 @@ bool AtlasColorContents::Render(const ContentContext& renderer,
   using VS = GeometryColorPipeline::VertexShader;
   using FS = GeometryColorPipeline::FragmentShader;
 
-  std::vector<Rect> texture_coords;
-  std::vector<Matrix> transforms;
-  std::vector<Color> colors;
+  const std::vector<Rect>* texture_coords = &parent_.GetTextureCoordinates();
+  const std::vector<Matrix>* transforms = &parent_.GetTransforms();
+  const std::vector<Color>* colors = &parent_.GetColors();
   if (subatlas_) {
-    texture_coords = subatlas_->sub_texture_coords;
-    colors = subatlas_->sub_colors;
-    transforms = subatlas_->sub_transforms;
-  } else {
-    texture_coords = parent_.GetTextureCoordinates();
-    transforms = parent_.GetTransforms();
-    colors = parent_.GetColors();
+    texture_coords = &subatlas_->sub_texture_coords;
+    transforms = &subatlas_->sub_transforms;
+    colors = &subatlas_->sub_colors;
   }
 
-  VertexBufferBuilder<VS::PerVertexData> vertex_builder;
-  vertex_builder.Reserve(texture_coords.size() * 6);
-  constexpr size_t indices[6] = {0, 1, 2, 1, 2, 3};
-  for (size_t i = 0; i < texture_coords.size(); i++) {
-    auto sample_rect = texture_coords[i];
-    auto matrix = transforms[i];
-    auto transformed_points =
-        Rect::MakeSize(sample_rect.size).GetTransformedPoints(matrix);
-
-    for (size_t j = 0; j < 6; j++) {
-      VS::PerVertexData data;
-      data.position = transformed_points[indices[j]];
-      data.color = colors[i].Premultiply();
-      vertex_builder.AppendVertex(data);
-    }
-  }
-
-  if (!vertex_builder.HasVertices()) {
+  if (texture_coords->empty()) {
     return true;
   }
 
+  auto& host_buffer = pass.GetTransientsBuffer();
+  auto vertex_buffer = EmplaceSpriteVertices<VS::PerVertexData>(
+      host_buffer, texture_coords->size(),
+      [&](size_t i, VS::PerVertexData* vertices) {
+        auto positions = Rect::MakeSize((*texture_coords)[i].size)
+                             .GetTransformedPoints((*transforms)[i]);
+        auto color = (*colors)[i].Premultiply();
+        for (size_t j = 0; j < 6; j++) {
+          vertices[j].position = positions[kSpriteIndices[j]];
+          vertices[j].color = color;
+        }
+      });
+
   Command cmd;
   DEBUG_COMMAND_INFO(cmd, "AtlasColors");
 
-  auto& host_buffer = pass.GetTransientsBuffer();
-
   VS::FrameInfo frame_info;
   frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
                    entity.GetTransformation();
@@ -516,7 +526,7 @@ bool AtlasColorContents::Render(const ContentContext& renderer,
   opts.blend_mode = BlendMode::kSourceOver;
   cmd.pipeline = renderer.GetGeometryColorPipeline(opts);
   cmd.stencil_reference = entity.GetStencilDepth();
-  cmd.BindVertices(vertex_builder.CreateVertexBuffer(host_buffer));
+  cmd.BindVertices(vertex_buffer);
   VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
   FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
   return pass.AddCommand(std::move(cmd));
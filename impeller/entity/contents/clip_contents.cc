@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <cmath>
 #include <optional>
 
 #include "fml/logging.h"
@@ -30,6 +31,33 @@ void ClipContents::SetClipOperation(Entity::ClipOperation clip_op) {
   clip_op_ = clip_op;
 }
 
+std::optional<Rect> ClipContents::GetScissorRect(const Entity& entity) const {
+  if (clip_op_ != Entity::ClipOperation::kIntersect || !geometry_) {
+    return std::nullopt;
+  }
+  const auto& transform = entity.GetTransformation();
+  if (!transform.IsTranslationScaleOnly()) {
+    return std::nullopt;
+  }
+  auto rect = geometry_->AsRect();
+  if (!rect.has_value()) {
+    return std::nullopt;
+  }
+  // A scissor can't clip partial pixels, which the stencil does when
+  // multisampling.
+  auto bounds = rect->TransformBounds(transform);
+  for (auto edge : bounds.GetLTRB()) {
+    if (std::abs(edge - std::round(edge)) > kEhCloseEnough) {
+      return std::nullopt;
+    }
+  }
+  return Rect::MakeLTRB(std::round(bounds.GetLeft()),   //
+                        std::round(bounds.GetTop()),    //
+                        std::round(bounds.GetRight()),  //
+                        std::round(bounds.GetBottom())  //
+  );
+}
+
 std::optional<Rect> ClipContents::GetCoverage(const Entity& entity) const {
   return std::nullopt;
 };
@@ -25,6 +25,15 @@ class ClipContents final : public Contents {
 
   void SetClipOperation(Entity::ClipOperation clip_op);
 
+  //----------------------------------------------------------------------------
+  /// @brief  The area this clip limits drawing to, if it is exactly a pixel
+  ///         aligned rectangle after the entity transform is applied.
+  ///
+  ///         Such clips can be applied with a scissor instead of being drawn
+  ///         into the stencil buffer, which also makes their restore a no-op.
+  ///
+  std::optional<Rect> GetScissorRect(const Entity& entity) const;
+
   // |Contents|
   std::optional<Rect> GetCoverage(const Entity& entity) const override;
 
@@ -8,9 +8,9 @@
 #include "impeller/entity/contents/clip_contents.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/gradient_generator.h"
+#include "impeller/entity/contents/gradient_texture_cache.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/geometry/geometry.h"
-#include "impeller/geometry/gradient.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/sampler_library.h"
 
@@ -135,9 +135,8 @@ bool ConicalGradientContents::RenderTexture(const ContentContext& renderer,
   using VS = ConicalGradientFillPipeline::VertexShader;
   using FS = ConicalGradientFillPipeline::FragmentShader;
 
-  auto gradient_data = CreateGradientBuffer(colors_, stops_);
-  auto gradient_texture =
-      CreateGradientTexture(gradient_data, renderer.GetContext());
+  auto gradient_texture = renderer.GetGradientTextureCache()->GetTexture(
+      colors_, stops_, renderer.GetContext());
   if (gradient_texture == nullptr) {
     return false;
   }
@@ -4,12 +4,19 @@
 
 #include "impeller/entity/contents/content_context.h"
 
+#include <algorithm>
 #include <memory>
 #include <sstream>
 
+#include "flutter/fml/trace_event.h"
 #include "impeller/base/strings.h"
 #include "impeller/core/formats.h"
+#include "impeller/entity/contents/filters/filter_snapshot_cache.h"
+#include "impeller/entity/contents/gradient_texture_cache.h"
+#include "impeller/entity/contents/text_vertex_cache.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/geometry/tessellation_cache.h"
+#include "impeller/entity/geometry/vertices_cache.h"
 #include "impeller/entity/render_target_cache.h"
 #include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/pipeline_library.h"
@@ -144,6 +151,46 @@ void ContentContextOptions::ApplyToPipelineDescriptor(
   desc.SetPolygonMode(wireframe ? PolygonMode::kLine : PolygonMode::kFill);
 }
 
+uint64_t ContentContextOptions::ToKey() const {
+  // Every field fits in a byte.
+  return static_cast<uint64_t>(sample_count) |
+         static_cast<uint64_t>(blend_mode) << 8 |
+         static_cast<uint64_t>(stencil_compare) << 16 |
+         static_cast<uint64_t>(stencil_operation) << 24 |
+         static_cast<uint64_t>(primitive_type) << 32 |
+         static_cast<uint64_t>(color_attachment_pixel_format) << 40 |
+         static_cast<uint64_t>(has_stencil_attachment) << 48 |
+         static_cast<uint64_t>(wireframe) << 56;
+}
+
+std::optional<ContentContextOptions> ContentContextOptions::FromKey(
+    uint64_t key) {
+  auto field = [key](size_t index) -> uint64_t {
+    return (key >> (index * 8u)) & 0xffu;
+  };
+  auto sample_count = field(0);
+  if ((sample_count != static_cast<uint64_t>(SampleCount::kCount1) &&
+       sample_count != static_cast<uint64_t>(SampleCount::kCount4)) ||
+      field(1) > static_cast<uint64_t>(BlendMode::kLast) ||
+      field(2) > static_cast<uint64_t>(CompareFunction::kGreaterEqual) ||
+      field(3) > static_cast<uint64_t>(StencilOperation::kDecrementWrap) ||
+      field(4) > static_cast<uint64_t>(PrimitiveType::kPoint) ||
+      field(5) > static_cast<uint64_t>(PixelFormat::kD32FloatS8UInt) ||
+      field(6) > 1u || field(7) > 1u) {
+    return std::nullopt;
+  }
+  return ContentContextOptions{
+      .sample_count = static_cast<SampleCount>(field(0)),
+      .blend_mode = static_cast<BlendMode>(field(1)),
+      .stencil_compare = static_cast<CompareFunction>(field(2)),
+      .stencil_operation = static_cast<StencilOperation>(field(3)),
+      .primitive_type = static_cast<PrimitiveType>(field(4)),
+      .color_attachment_pixel_format = static_cast<PixelFormat>(field(5)),
+      .has_stencil_attachment = field(6) == 1u,
+      .wireframe = field(7) == 1u,
+  };
+}
+
 template <typename PipelineT>
 static std::unique_ptr<PipelineT> CreateDefaultPipeline(
     const Context& context) {
@@ -167,6 +214,11 @@ ContentContext::ContentContext(
       lazy_glyph_atlas_(
           std::make_shared<LazyGlyphAtlas>(std::move(typographer_context))),
       tessellator_(std::make_shared<Tessellator>()),
+      tessellation_cache_(std::make_shared<TessellationCache>()),
+      gradient_texture_cache_(std::make_shared<GradientTextureCache>()),
+      text_vertex_cache_(std::make_shared<TextVertexCache>()),
+      vertices_cache_(std::make_shared<VerticesCache>()),
+      filter_snapshot_cache_(std::make_shared<FilterSnapshotCache>()),
 #if IMPELLER_ENABLE_3D
       scene_context_(std::make_shared<scene::SceneContext>(context_)),
 #endif  // IMPELLER_ENABLE_3D
@@ -175,6 +227,15 @@ ContentContext::ContentContext(
   if (!context_ || !context_->IsValid()) {
     return;
   }
+  // The OpenGL ES backend keeps buffer contents in host memory and uploads
+  // them as a whole when they change, so it gains nothing from sharing one
+  // buffer between passes.
+  if (context_->GetBackendType() != Context::BackendType::kOpenGLES) {
+    transients_buffer_ = HostBuffer::Create(context_->GetResourceAllocator());
+    if (transients_buffer_) {
+      transients_buffer_->SetLabel("ContentContext Transients");
+    }
+  }
   default_options_ = ContentContextOptions{
       .sample_count = SampleCount::kCount4,
       .color_attachment_pixel_format =
@@ -300,6 +361,8 @@ ContentContext::ContentContext(
       CreateDefaultPipeline<GlyphAtlasPipeline>(*context_);
   glyph_atlas_color_pipelines_[default_options_] =
       CreateDefaultPipeline<GlyphAtlasColorPipeline>(*context_);
+  glyph_atlas_sdf_pipelines_[default_options_] =
+      CreateDefaultPipeline<GlyphAtlasSdfPipeline>(*context_);
   geometry_color_pipelines_[default_options_] =
       CreateDefaultPipeline<GeometryColorPipeline>(*context_);
   yuv_to_rgb_filter_pipelines_[default_options_] =
@@ -323,6 +386,14 @@ ContentContext::ContentContext(
         UvComputeShaderPipeline::MakeDefaultPipelineDescriptor(*context_);
     uv_compute_pipelines_ =
         context_->GetPipelineLibrary()->GetPipeline(uv_pipeline_desc).Get();
+
+    auto convex_fill_pipeline_desc =
+        ConvexFillComputeShaderPipeline::MakeDefaultPipelineDescriptor(
+            *context_);
+    convex_fill_compute_pipelines_ =
+        context_->GetPipelineLibrary()
+            ->GetPipeline(convex_fill_pipeline_desc)
+            .Get();
   }
 
   /// Setup default clip pipeline.
@@ -349,7 +420,102 @@ ContentContext::ContentContext(
   clip_pipelines_[default_options_] =
       std::make_unique<ClipPipeline>(*context_, clip_pipeline_descriptor);
 
+  pipeline_manifest_ = context_->GetPipelineLibrary()->GetManifest();
+  EnqueuePipelineWarmUps();
+
   is_valid_ = true;
+
+  // The variants that were needed first in a previous launch likely are
+  // needed by the first frame.
+  WarmUpNextPipelineVariants();
+}
+
+void ContentContext::EnqueuePipelineWarmUps() {
+  TRACE_EVENT0("impeller", "ContentContext::EnqueuePipelineWarmUps");
+  PipelineWarmUpEnqueuers enqueuers;
+#ifdef IMPELLER_DEBUG
+  RegisterPipelineWarmUp(enqueuers, checkerboard_pipelines_);
+#endif  // IMPELLER_DEBUG
+  RegisterPipelineWarmUp(enqueuers, solid_fill_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, linear_gradient_fill_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, radial_gradient_fill_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, conical_gradient_fill_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, sweep_gradient_fill_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, linear_gradient_ssbo_fill_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, radial_gradient_ssbo_fill_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, conical_gradient_ssbo_fill_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, sweep_gradient_ssbo_fill_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, rrect_blur_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, texture_blend_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, texture_pipelines_);
+#ifdef IMPELLER_ENABLE_OPENGLES
+  RegisterPipelineWarmUp(enqueuers, texture_external_pipelines_);
+#endif  // IMPELLER_ENABLE_OPENGLES
+  RegisterPipelineWarmUp(enqueuers, position_uv_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, tiled_texture_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, gaussian_blur_noalpha_decal_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, gaussian_blur_noalpha_nodecal_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, border_mask_blur_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, morphology_filter_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, color_matrix_color_filter_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, linear_to_srgb_filter_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, srgb_to_linear_filter_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, clip_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, glyph_atlas_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, glyph_atlas_color_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, glyph_atlas_sdf_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, geometry_color_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, yuv_to_rgb_filter_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, porter_duff_blend_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, blend_color_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, blend_colorburn_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, blend_colordodge_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, blend_darken_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, blend_difference_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, blend_exclusion_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, blend_hardlight_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, blend_hue_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, blend_lighten_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, blend_luminosity_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, blend_multiply_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, blend_overlay_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, blend_saturation_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, blend_screen_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, blend_softlight_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, framebuffer_blend_color_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, framebuffer_blend_colorburn_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, framebuffer_blend_colordodge_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, framebuffer_blend_darken_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, framebuffer_blend_difference_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, framebuffer_blend_exclusion_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, framebuffer_blend_hardlight_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, framebuffer_blend_hue_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, framebuffer_blend_lighten_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, framebuffer_blend_luminosity_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, framebuffer_blend_multiply_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, framebuffer_blend_overlay_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, framebuffer_blend_saturation_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, framebuffer_blend_screen_pipelines_);
+  RegisterPipelineWarmUp(enqueuers, framebuffer_blend_softlight_pipelines_);
+
+  if (pipeline_manifest_) {
+    for (const auto& entry : pipeline_manifest_->GetEntries()) {
+      auto enqueuer = enqueuers.find(entry.prototype);
+      auto opts = ContentContextOptions::FromKey(entry.variant);
+      if (enqueuer != enqueuers.end() && opts.has_value()) {
+        enqueuer->second(opts.value());
+      }
+    }
+  }
+
+  // Blend modes are usually picked within a frame, so their variants are
+  // warmed up whether or not they were used before.
+  for (int i = 0; i <= static_cast<int>(Entity::kLastPipelineBlendMode); i++) {
+    auto opts = default_options_;
+    opts.blend_mode = static_cast<BlendMode>(i);
+    EnqueuePipelineWarmUp(solid_fill_pipelines_, opts);
+    EnqueuePipelineWarmUp(texture_pipelines_, opts);
+  }
 }
 
 ContentContext::~ContentContext() = default;
@@ -402,6 +568,7 @@ std::shared_ptr<Texture> ContentContext::MakeSubpass(
   if (!sub_renderpass) {
     return nullptr;
   }
+  sub_renderpass->SetTransientsBuffer(GetTransientsBuffer());
   sub_renderpass->SetLabel(SPrintF("%s RenderPass", label.c_str()));
 
   if (!subpass_callback(*this, *sub_renderpass)) {
@@ -425,6 +592,61 @@ std::shared_ptr<Tessellator> ContentContext::GetTessellator() const {
   return tessellator_;
 }
 
+std::shared_ptr<TessellationCache> ContentContext::GetTessellationCache()
+    const {
+  return tessellation_cache_;
+}
+
+std::shared_ptr<GradientTextureCache> ContentContext::GetGradientTextureCache()
+    const {
+  return gradient_texture_cache_;
+}
+
+std::shared_ptr<TextVertexCache> ContentContext::GetTextVertexCache() const {
+  return text_vertex_cache_;
+}
+
+std::shared_ptr<VerticesCache> ContentContext::GetVerticesCache() const {
+  return vertices_cache_;
+}
+
+std::shared_ptr<FilterSnapshotCache> ContentContext::GetFilterSnapshotCache()
+    const {
+  return filter_snapshot_cache_;
+}
+
+void ContentContext::ClearCachedResources() const {
+  tessellation_cache_->Clear();
+  gradient_texture_cache_->Clear();
+  text_vertex_cache_->Clear();
+  vertices_cache_->Clear();
+  filter_snapshot_cache_->Clear();
+  lazy_glyph_atlas_->ResetGlyphAtlasContexts();
+  render_target_cache_->Clear();
+}
+
+void ContentContext::ResetTransientsBuffer() const {
+  if (transients_buffer_) {
+    transients_buffer_->Reset();
+  }
+}
+
+bool ContentContext::WarmUpNextPipelineVariants() const {
+  auto& in_flight = pipeline_warm_ups_in_flight_;
+  auto finished = [](const auto& is_ready) { return is_ready(); };
+  in_flight.erase(std::remove_if(in_flight.begin(), in_flight.end(), finished),
+                  in_flight.end());
+  while (in_flight.size() < kMaxPipelineWarmUpsInFlight &&
+         !pending_pipeline_warm_ups_.empty()) {
+    auto warm_up = std::move(pending_pipeline_warm_ups_.front());
+    pending_pipeline_warm_ups_.pop_front();
+    if (auto is_ready = warm_up()) {
+      in_flight.push_back(std::move(is_ready));
+    }
+  }
+  return !pending_pipeline_warm_ups_.empty();
+}
+
 std::shared_ptr<Context> ContentContext::GetContext() const {
   return context_;
 }
@@ -437,4 +659,42 @@ void ContentContext::SetWireframe(bool wireframe) {
   wireframe_ = wireframe;
 }
 
+void ContentContext::SetReorderEntitiesForBatching(bool reorder) {
+  reorder_entities_for_batching_ = reorder;
+}
+
+bool ContentContext::ShouldReorderEntitiesForBatching() const {
+  return reorder_entities_for_batching_;
+}
+
+std::shared_ptr<Pipeline<PipelineDescriptor>>
+ContentContext::GetCachedRuntimeEffectPipeline(
+    const std::string& unique_entrypoint_name,
+    const ContentContextOptions& options,
+    const std::function<std::shared_ptr<Pipeline<PipelineDescriptor>>()>&
+        create_callback) const {
+  RuntimeEffectPipelineKey key{unique_entrypoint_name, options};
+  auto it = runtime_effect_pipelines_.find(key);
+  if (it != runtime_effect_pipelines_.end()) {
+    return it->second;
+  }
+  auto pipeline = create_callback();
+  if (pipeline) {
+    runtime_effect_pipelines_[std::move(key)] = pipeline;
+  }
+  return pipeline;
+}
+
+void ContentContext::ClearCachedRuntimeEffectPipeline(
+    const std::string& unique_entrypoint_name) const {
+  for (auto it = runtime_effect_pipelines_.begin();
+       it != runtime_effect_pipelines_.end();) {
+    if (it->first.unique_entrypoint_name == unique_entrypoint_name) {
+      it = runtime_effect_pipelines_.erase(it);
+    } else {
+      it++;
+    }
+  }
+}
+
 }  // namespace impeller
@@ -4,9 +4,13 @@
 
 #pragma once
 
+#include <deque>
+#include <functional>
 #include <memory>
 #include <optional>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/hash_combine.h"
@@ -14,9 +18,11 @@
 #include "flutter/fml/macros.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/formats.h"
+#include "impeller/core/host_buffer.h"
 #include "impeller/entity/entity.h"
 #include "impeller/renderer/capabilities.h"
 #include "impeller/renderer/pipeline.h"
+#include "impeller/renderer/pipeline_manifest.h"
 #include "impeller/renderer/render_target.h"
 #include "impeller/typographer/typographer_context.h"
 
@@ -33,10 +39,12 @@
 #include "impeller/entity/clip.vert.h"
 #include "impeller/entity/color_matrix_color_filter.frag.h"
 #include "impeller/entity/color_matrix_color_filter.vert.h"
+#include "impeller/entity/convex_fill.comp.h"
 #include "impeller/entity/conical_gradient_fill.frag.h"
 #include "impeller/entity/glyph_atlas.frag.h"
 #include "impeller/entity/glyph_atlas.vert.h"
 #include "impeller/entity/glyph_atlas_color.frag.h"
+#include "impeller/entity/glyph_atlas_sdf.frag.h"
 #include "impeller/entity/gradient_fill.vert.h"
 #include "impeller/entity/linear_gradient_fill.frag.h"
 #include "impeller/entity/linear_to_srgb_filter.frag.h"
@@ -180,6 +188,8 @@ using GlyphAtlasPipeline =
     RenderPipelineT<GlyphAtlasVertexShader, GlyphAtlasFragmentShader>;
 using GlyphAtlasColorPipeline =
     RenderPipelineT<GlyphAtlasVertexShader, GlyphAtlasColorFragmentShader>;
+using GlyphAtlasSdfPipeline =
+    RenderPipelineT<GlyphAtlasVertexShader, GlyphAtlasSdfFragmentShader>;
 using PorterDuffBlendPipeline =
     RenderPipelineT<PorterDuffBlendVertexShader, PorterDuffBlendFragmentShader>;
 // Instead of requiring new shaders for clips, the solid fill stages are used
@@ -282,6 +292,8 @@ using FramebufferBlendSoftLightPipeline =
 
 /// Geometry Pipelines
 using PointsComputeShaderPipeline = ComputePipelineBuilder<PointsComputeShader>;
+using ConvexFillComputeShaderPipeline =
+    ComputePipelineBuilder<ConvexFillComputeShader>;
 using UvComputeShaderPipeline = ComputePipelineBuilder<UvComputeShader>;
 
 #ifdef IMPELLER_ENABLE_OPENGLES
@@ -334,9 +346,22 @@ struct ContentContextOptions {
   };
 
   void ApplyToPipelineDescriptor(PipelineDescriptor& desc) const;
+
+  /// @brief  Packs the options into a key that is stable across launches so
+  ///         that the variant can be recorded in a `PipelineManifest`.
+  uint64_t ToKey() const;
+
+  /// @brief  The inverse of `ToKey`. Returns `std::nullopt` if the key does
+  ///         not describe a valid set of options.
+  static std::optional<ContentContextOptions> FromKey(uint64_t key);
 };
 
 class Tessellator;
+class TessellationCache;
+class GradientTextureCache;
+class TextVertexCache;
+class VerticesCache;
+class FilterSnapshotCache;
 class RenderTargetCache;
 
 class ContentContext {
@@ -355,6 +380,16 @@ class ContentContext {
 
   std::shared_ptr<Tessellator> GetTessellator() const;
 
+  std::shared_ptr<TessellationCache> GetTessellationCache() const;
+
+  std::shared_ptr<GradientTextureCache> GetGradientTextureCache() const;
+
+  std::shared_ptr<TextVertexCache> GetTextVertexCache() const;
+
+  std::shared_ptr<VerticesCache> GetVerticesCache() const;
+
+  std::shared_ptr<FilterSnapshotCache> GetFilterSnapshotCache() const;
+
 #ifdef IMPELLER_DEBUG
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetCheckerboardPipeline(
       ContentContextOptions opts) const {
@@ -495,6 +530,11 @@ class ContentContext {
     return GetPipeline(glyph_atlas_color_pipelines_, opts);
   }
 
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetGlyphAtlasSdfPipeline(
+      ContentContextOptions opts) const {
+    return GetPipeline(glyph_atlas_sdf_pipelines_, opts);
+  }
+
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetGeometryColorPipeline(
       ContentContextOptions opts) const {
     return GetPipeline(geometry_color_pipelines_, opts);
@@ -690,12 +730,28 @@ class ContentContext {
     return uv_compute_pipelines_;
   }
 
+  std::shared_ptr<Pipeline<ComputePipelineDescriptor>>
+  GetConvexFillComputePipeline() const {
+    FML_DCHECK(GetDeviceCapabilities().SupportsCompute());
+    return convex_fill_compute_pipelines_;
+  }
+
   std::shared_ptr<Context> GetContext() const;
 
   const Capabilities& GetDeviceCapabilities() const;
 
   void SetWireframe(bool wireframe);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether entity passes may render their entities out of order
+  ///             so that more of them can be batched. Defaults to false.
+  ///
+  /// @see        `EntityBatch::ComputeBatchingOrder`
+  ///
+  void SetReorderEntitiesForBatching(bool reorder);
+
+  bool ShouldReorderEntitiesForBatching() const;
+
   using SubpassCallback =
       std::function<bool(const ContentContext&, RenderPass&)>;
 
@@ -714,6 +770,76 @@ class ContentContext {
     return render_target_cache_;
   }
 
+  //----------------------------------------------------------------------------
+  /// @brief      The buffer that all render passes of a frame emplace their
+  ///             transient data into, or null if the backend doesn't map
+  ///             device memory for the host. Data is written to device memory
+  ///             directly, see `HostBuffer::Create(allocator)`.
+  ///
+  const std::shared_ptr<HostBuffer>& GetTransientsBuffer() const {
+    return transients_buffer_;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Must be called once per frame after the frame was submitted
+  ///             so that the transients buffer moves on to the next arena.
+  ///
+  void ResetTransientsBuffer() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drops the tessellations, gradient textures, text vertices,
+  ///             filter outputs, glyph atlases and render targets that are
+  ///             cached for later frames, for example because the system is
+  ///             running low on memory. They are recreated on demand.
+  ///             Pipelines are kept, as they are expensive to recreate and
+  ///             small in comparison.
+  ///
+  ///             Must only be called between frames.
+  ///
+  void ClearCachedResources() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Starts compiling the next pipeline variants that are warmed up
+  ///             ahead of their first use, once earlier warm up compiles have
+  ///             finished. Must be called once per frame after the frame was
+  ///             submitted, so that the compiles are started between frames
+  ///             and only a few of them compete with the compiles of the
+  ///             frames for the workers of the pipeline library.
+  ///
+  ///             The variants that were used during a previous launch are
+  ///             warmed up first, in the order they were first used. The
+  ///             variants of the pipeline blend modes of solid fills and
+  ///             textures follow, so that the first use of an uncommon blend
+  ///             mode doesn't block the raster thread on a compile.
+  ///
+  /// @return     Whether variants are still waiting to be warmed up.
+  ///
+  bool WarmUpNextPipelineVariants() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Gets the pipeline of the runtime effect with the unique
+  ///             fragment entrypoint name `unique_entrypoint_name` for the
+  ///             `options`, calling `create_callback` to create it the first
+  ///             time it is requested.
+  ///
+  ///             Runtime effects can't be variants of a prototype created
+  ///             eagerly, so the pipelines are cached here instead of looking
+  ///             them up by the full pipeline descriptor on every draw.
+  ///
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetCachedRuntimeEffectPipeline(
+      const std::string& unique_entrypoint_name,
+      const ContentContextOptions& options,
+      const std::function<std::shared_ptr<Pipeline<PipelineDescriptor>>()>&
+          create_callback) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drops the cached pipelines of the runtime effect with the
+  ///             unique fragment entrypoint name `unique_entrypoint_name`, for
+  ///             example because its shader was hot reloaded.
+  ///
+  void ClearCachedRuntimeEffectPipeline(
+      const std::string& unique_entrypoint_name) const;
+
  private:
   std::shared_ptr<Context> context_;
   std::shared_ptr<LazyGlyphAtlas> lazy_glyph_atlas_;
@@ -724,6 +850,32 @@ class ContentContext {
                                       ContentContextOptions::Hash,
                                       ContentContextOptions::Equal>;
 
+  struct RuntimeEffectPipelineKey {
+    std::string unique_entrypoint_name;
+    ContentContextOptions options;
+
+    struct Hash {
+      std::size_t operator()(const RuntimeEffectPipelineKey& key) const {
+        return fml::HashCombine(key.unique_entrypoint_name,
+                                ContentContextOptions::Hash{}(key.options));
+      }
+    };
+
+    struct Equal {
+      constexpr bool operator()(const RuntimeEffectPipelineKey& lhs,
+                                const RuntimeEffectPipelineKey& rhs) const {
+        return lhs.unique_entrypoint_name == rhs.unique_entrypoint_name &&
+               ContentContextOptions::Equal{}(lhs.options, rhs.options);
+      }
+    };
+  };
+
+  mutable std::unordered_map<RuntimeEffectPipelineKey,
+                             std::shared_ptr<Pipeline<PipelineDescriptor>>,
+                             RuntimeEffectPipelineKey::Hash,
+                             RuntimeEffectPipelineKey::Equal>
+      runtime_effect_pipelines_;
+
   // These are mutable because while the prototypes are created eagerly, any
   // variants requested from that are lazily created and cached in the variants
   // map.
@@ -767,6 +919,7 @@ class ContentContext {
   mutable Variants<ClipPipeline> clip_pipelines_;
   mutable Variants<GlyphAtlasPipeline> glyph_atlas_pipelines_;
   mutable Variants<GlyphAtlasColorPipeline> glyph_atlas_color_pipelines_;
+  mutable Variants<GlyphAtlasSdfPipeline> glyph_atlas_sdf_pipelines_;
   mutable Variants<GeometryColorPipeline> geometry_color_pipelines_;
   mutable Variants<YUVToRGBFilterPipeline> yuv_to_rgb_filter_pipelines_;
   mutable Variants<PorterDuffBlendPipeline> porter_duff_blend_pipelines_;
@@ -821,6 +974,8 @@ class ContentContext {
       point_field_compute_pipelines_;
   mutable std::shared_ptr<Pipeline<ComputePipelineDescriptor>>
       uv_compute_pipelines_;
+  mutable std::shared_ptr<Pipeline<ComputePipelineDescriptor>>
+      convex_fill_compute_pipelines_;
   // The values for the default context options must be cached on
   // initial creation. In the presence of wide gamut and platform views,
   // it is possible that secondary surfaces will have a different default
@@ -828,6 +983,79 @@ class ContentContext {
   // below to fail.
   ContentContextOptions default_options_;
 
+  /// Records the variants created by `GetPipeline`. Null if the backend does
+  /// not persist pipeline manifests.
+  std::shared_ptr<PipelineManifest> pipeline_manifest_;
+
+  /// Starts compiling a pipeline variant unless it was already created.
+  /// Returns a callable reporting whether the compile finished, or null if no
+  /// compile was started.
+  using PipelineWarmUp = std::function<std::function<bool()>()>;
+
+  /// The number of warm up compiles that may run at the same time.
+  static constexpr size_t kMaxPipelineWarmUpsInFlight = 4u;
+
+  /// Variants waiting to be compiled ahead of their first use, in the order
+  /// they are expected to be needed.
+  mutable std::deque<PipelineWarmUp> pending_pipeline_warm_ups_;
+  mutable std::vector<std::function<bool()>> pipeline_warm_ups_in_flight_;
+
+  using PipelineWarmUpEnqueuers =
+      std::unordered_map<std::string,
+                         std::function<void(ContentContextOptions)>>;
+
+  /// Queues the warm up of the variants that were recorded in the pipeline
+  /// manifest during a previous launch, in the order they were first used,
+  /// followed by the variants of uncommon blend modes. Pipelines added to
+  /// this class must be registered here to participate.
+  void EnqueuePipelineWarmUps();
+
+  template <class TypedPipeline>
+  void RegisterPipelineWarmUp(PipelineWarmUpEnqueuers& enqueuers,
+                              Variants<TypedPipeline>& container) {
+    auto prototype = container.find(default_options_);
+    if (prototype == container.end() || !prototype->second) {
+      return;
+    }
+    auto prototype_desc = prototype->second->GetDescriptor();
+    if (!prototype_desc.has_value()) {
+      return;
+    }
+    enqueuers[prototype_desc->GetLabel()] =
+        [this, &container](ContentContextOptions opts) {
+          EnqueuePipelineWarmUp(container, opts);
+        };
+  }
+
+  template <class TypedPipeline>
+  void EnqueuePipelineWarmUp(Variants<TypedPipeline>& container,
+                             ContentContextOptions opts) {
+    pending_pipeline_warm_ups_.push_back(
+        [this, &container, opts]() -> std::function<bool()> {
+          if (container.find(opts) != container.end()) {
+            return nullptr;
+          }
+          auto prototype = container.find(default_options_);
+          if (prototype == container.end() || !prototype->second) {
+            return nullptr;
+          }
+          auto prototype_desc = prototype->second->GetDescriptor();
+          if (!prototype_desc.has_value()) {
+            return nullptr;
+          }
+          // This mirrors what `GetPipeline` does but doesn't wait for the
+          // prototype to finish compiling.
+          auto desc = prototype_desc.value();
+          opts.ApplyToPipelineDescriptor(desc);
+          desc.SetLabel(
+              SPrintF("%s V#%zu", desc.GetLabel().c_str(), container.size()));
+          auto variant = std::make_unique<TypedPipeline>(*context_, desc);
+          auto* pipeline = variant.get();
+          container[opts] = std::move(variant);
+          return [pipeline]() { return pipeline->IsReady(); };
+        });
+  }
+
   template <class TypedPipeline>
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetPipeline(
       Variants<TypedPipeline>& container,
@@ -863,16 +1091,27 @@ class ContentContext {
     auto variant = std::make_unique<TypedPipeline>(std::move(variant_future));
     auto variant_pipeline = variant->WaitAndGet();
     container[opts] = std::move(variant);
+    if (pipeline_manifest_) {
+      pipeline_manifest_->Record(pipeline->GetDescriptor().GetLabel(),
+                                 opts.ToKey());
+    }
     return variant_pipeline;
   }
 
   bool is_valid_ = false;
   std::shared_ptr<Tessellator> tessellator_;
+  std::shared_ptr<TessellationCache> tessellation_cache_;
+  std::shared_ptr<GradientTextureCache> gradient_texture_cache_;
+  std::shared_ptr<TextVertexCache> text_vertex_cache_;
+  std::shared_ptr<VerticesCache> vertices_cache_;
+  std::shared_ptr<FilterSnapshotCache> filter_snapshot_cache_;
 #if IMPELLER_ENABLE_3D
   std::shared_ptr<scene::SceneContext> scene_context_;
 #endif  // IMPELLER_ENABLE_3D
   std::shared_ptr<RenderTargetAllocator> render_target_cache_;
+  std::shared_ptr<HostBuffer> transients_buffer_;
   bool wireframe_ = false;
+  bool reorder_entities_for_batching_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ContentContext);
 };
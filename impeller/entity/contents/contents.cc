@@ -127,6 +127,15 @@ const FilterContents* Contents::AsFilter() const {
   return nullptr;
 }
 
+std::optional<Contents::BatchedQuad> Contents::AsBatchedQuad(
+    const Entity& entity) const {
+  return std::nullopt;
+}
+
+bool Contents::IsAntialiasedWithoutMSAA(const Entity& entity) const {
+  return false;
+}
+
 bool Contents::ApplyColorFilter(
     const Contents::ColorFilterProc& color_filter_proc) {
   return false;
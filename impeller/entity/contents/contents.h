@@ -43,6 +43,22 @@ class Contents {
     std::optional<Rect> coverage = std::nullopt;
   };
 
+  /// A quad that may be drawn with the same command as other compatible quads.
+  /// See `EntityBatch`.
+  struct BatchedQuad {
+    /// The quad, before the entity transformation is applied.
+    Rect rect;
+    /// The premultiplied fill color of solid color quads.
+    Color color;
+    /// The texture sampled by textured quads. Null for solid color quads.
+    std::shared_ptr<Texture> texture;
+    /// The normalized texture coordinates of the corners of `rect`.
+    Rect texture_coords;
+    SamplerDescriptor sampler_descriptor;
+    Scalar alpha = 1.0;
+    bool stencil_enabled = true;
+  };
+
   using RenderProc = std::function<bool(const ContentContext& renderer,
                                         const Entity& entity,
                                         RenderPass& pass)>;
@@ -162,6 +178,21 @@ class Contents {
   ///
   virtual const FilterContents* AsFilter() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief Describe this Contents as a single quad, if that is all it draws,
+  ///        so that it can be batched with adjacent compatible entities.
+  ///        Returns `std::nullopt` if this Contents must render on its own.
+  ///
+  virtual std::optional<BatchedQuad> AsBatchedQuad(const Entity& entity) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief Whether the contents are antialiased just as well when rendered
+  ///        to a pass without multisampling, either analytically or because
+  ///        their edges don't need it. Passes made of such contents only are
+  ///        rendered without MSAA.
+  ///
+  virtual bool IsAntialiasedWithoutMSAA(const Entity& entity) const;
+
   //----------------------------------------------------------------------------
   /// @brief      If possible, applies a color filter to this contents inputs on
   ///             the CPU.
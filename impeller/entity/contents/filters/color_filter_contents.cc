@@ -5,6 +5,7 @@
 #include "impeller/entity/contents/filters/color_filter_contents.h"
 
 #include <utility>
+#include <variant>
 
 #include "impeller/base/validation.h"
 #include "impeller/entity/contents/filters/blend_filter_contents.h"
@@ -14,6 +15,63 @@
 
 namespace impeller {
 
+namespace {
+
+/// Returns the color matrix filter that produces `input`, if any.
+const ColorMatrixFilterContents* GetColorMatrixFilter(
+    const FilterInput::Ref& input) {
+  auto variant = input->GetInput();
+  const FilterContents* filter = nullptr;
+  if (auto filter_contents =
+          std::get_if<std::shared_ptr<FilterContents>>(&variant);
+      filter_contents && *filter_contents) {
+    filter = filter_contents->get();
+  } else if (auto contents = std::get_if<std::shared_ptr<Contents>>(&variant);
+             contents && *contents) {
+    filter = (*contents)->AsFilter();
+  }
+  return filter ? filter->AsColorMatrixFilter() : nullptr;
+}
+
+/// Whether every unpremultiplied color stays within the 0 to 1 range when
+/// transformed by `matrix`, so that the clamp after it has no effect.
+bool IsClampFree(const ColorMatrix& matrix) {
+  for (size_t row = 0; row < 4; row++) {
+    const Scalar* coefficients = &matrix.array[row * 5];
+    Scalar min = coefficients[4];
+    Scalar max = coefficients[4];
+    for (size_t i = 0; i < 4; i++) {
+      if (coefficients[i] < 0) {
+        min += coefficients[i];
+      } else {
+        max += coefficients[i];
+      }
+    }
+    if (min < 0 || max > 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// The matrix that transforms colors by `inner` and then by `outer`.
+ColorMatrix ComposeColorMatrices(const ColorMatrix& outer,
+                                 const ColorMatrix& inner) {
+  ColorMatrix result;
+  for (size_t row = 0; row < 4; row++) {
+    for (size_t column = 0; column < 5; column++) {
+      Scalar value = column == 4 ? outer.array[row * 5 + 4] : 0;
+      for (size_t i = 0; i < 4; i++) {
+        value += outer.array[row * 5 + i] * inner.array[i * 5 + column];
+      }
+      result.array[row * 5 + column] = value;
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
 std::shared_ptr<ColorFilterContents> ColorFilterContents::MakeBlend(
     BlendMode blend_mode,
     FilterInput::Vector inputs,
@@ -57,10 +115,20 @@ std::shared_ptr<ColorFilterContents> ColorFilterContents::MakeBlend(
 
 std::shared_ptr<ColorFilterContents> ColorFilterContents::MakeColorMatrix(
     FilterInput::Ref input,
-    const ColorMatrix& color_matrix) {
+    const ColorMatrix& color_matrix,
+    AbsorbOpacity absorb_opacity) {
   auto filter = std::make_shared<ColorMatrixFilterContents>();
+  if (const auto* inner = GetColorMatrixFilter(input);
+      inner && inner->GetInputs().size() == 1u &&
+      IsClampFree(inner->GetMatrix())) {
+    filter->SetInputs(inner->GetInputs());
+    filter->SetMatrix(ComposeColorMatrices(color_matrix, inner->GetMatrix()));
+    filter->SetAbsorbOpacity(inner->GetAbsorbOpacity());
+    return filter;
+  }
   filter->SetInputs({std::move(input)});
   filter->SetMatrix(color_matrix);
+  filter->SetAbsorbOpacity(absorb_opacity);
   return filter;
 }
 
@@ -21,9 +21,19 @@ class ColorFilterContents : public FilterContents {
       FilterInput::Vector inputs,
       std::optional<Color> foreground_color = std::nullopt);
 
+  /// @brief  Create a filter that transforms the colors of the input with
+  ///         a color matrix.
+  ///
+  ///         If the input is the output of another color matrix filter whose
+  ///         results never need clamping, the two matrices are composed into
+  ///         a single filter of that filter's input. This saves rendering
+  ///         the intermediate result to a texture. The inner filter then
+  ///         decides whether opacity is absorbed, since its output has none
+  ///         left to absorb.
   static std::shared_ptr<ColorFilterContents> MakeColorMatrix(
       FilterInput::Ref input,
-      const ColorMatrix& color_matrix);
+      const ColorMatrix& color_matrix,
+      AbsorbOpacity absorb_opacity = AbsorbOpacity::kNo);
 
   static std::shared_ptr<ColorFilterContents> MakeLinearToSrgbFilter(
       FilterInput::Ref input);
@@ -25,6 +25,15 @@ void ColorMatrixFilterContents::SetMatrix(const ColorMatrix& matrix) {
   matrix_ = matrix;
 }
 
+const ColorMatrix& ColorMatrixFilterContents::GetMatrix() const {
+  return matrix_;
+}
+
+const ColorMatrixFilterContents*
+ColorMatrixFilterContents::AsColorMatrixFilter() const {
+  return this;
+}
+
 std::optional<Entity> ColorMatrixFilterContents::RenderFilter(
     const FilterInput::Vector& inputs,
     const ContentContext& renderer,
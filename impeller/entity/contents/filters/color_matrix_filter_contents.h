@@ -22,6 +22,11 @@ class ColorMatrixFilterContents final : public ColorFilterContents {
 
   void SetMatrix(const ColorMatrix& matrix);
 
+  const ColorMatrix& GetMatrix() const;
+
+  // |FilterContents|
+  const ColorMatrixFilterContents* AsColorMatrixFilter() const override;
+
  private:
   // |FilterContents|
   std::optional<Entity> RenderFilter(
@@ -5,6 +5,7 @@
 #include "impeller/entity/contents/filters/filter_contents.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstddef>
 #include <memory>
@@ -16,6 +17,7 @@
 #include "impeller/core/formats.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/filters/border_mask_blur_filter_contents.h"
+#include "impeller/entity/contents/filters/filter_snapshot_cache.h"
 #include "impeller/entity/contents/filters/gaussian_blur_filter_contents.h"
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
 #include "impeller/entity/contents/filters/local_matrix_filter_contents.h"
@@ -55,8 +57,11 @@ std::shared_ptr<FilterContents> FilterContents::MakeGaussianBlur(
     Sigma sigma_y,
     BlurStyle blur_style,
     Entity::TileMode tile_mode) {
-  auto x_blur = MakeDirectionalGaussianBlur(
-      input, sigma_x, Point(1, 0), BlurStyle::kNormal, tile_mode, false, {});
+  // Each pass is told the sigma of the other so that it knows how much blur
+  // will be applied perpendicular to its own direction.
+  auto x_blur = MakeDirectionalGaussianBlur(input, sigma_x, Point(1, 0),
+                                            BlurStyle::kNormal, tile_mode,
+                                            false, sigma_y);
   auto y_blur = MakeDirectionalGaussianBlur(FilterInput::Make(x_blur), sigma_y,
                                             Point(0, 1), blur_style, tile_mode,
                                             true, sigma_x);
@@ -131,15 +136,29 @@ std::shared_ptr<FilterContents> FilterContents::MakeYUVToRGBFilter(
   return filter;
 }
 
-FilterContents::FilterContents() = default;
+FilterContents::FilterContents() {
+  InvalidateSnapshotCacheId();
+}
 
 FilterContents::~FilterContents() = default;
 
+void FilterContents::InvalidateSnapshotCacheId() {
+  static std::atomic<uint64_t> next_snapshot_cache_id = 1u;
+  snapshot_cache_id_ =
+      next_snapshot_cache_id.fetch_add(1u, std::memory_order_relaxed);
+}
+
 void FilterContents::SetInputs(FilterInput::Vector inputs) {
+  InvalidateSnapshotCacheId();
   inputs_ = std::move(inputs);
 }
 
+const FilterInput::Vector& FilterContents::GetInputs() const {
+  return inputs_;
+}
+
 void FilterContents::SetEffectTransform(const Matrix& effect_transform) {
+  InvalidateSnapshotCacheId();
   effect_transform_ = effect_transform;
 
   for (auto& input : inputs_) {
@@ -231,8 +250,45 @@ std::optional<Entity> FilterContents::GetEntity(
     return std::nullopt;
   }
 
-  return RenderFilter(inputs_, renderer, entity_with_local_transform,
-                      effect_transform_, coverage.value(), coverage_hint);
+  // Filters drawn again the same way, such as in pictures that are reused
+  // across frames, render the same output.
+  auto& snapshot_cache = *renderer.GetFilterSnapshotCache();
+  const FilterSnapshotCache::Key cache_key{
+      .filter_id = snapshot_cache_id_,
+      .transform = entity.GetTransformation(),
+      .coverage_hint = coverage_hint,
+  };
+  bool should_cache = false;
+  if (auto snapshot = snapshot_cache.Find(cache_key, &should_cache);
+      snapshot.has_value()) {
+    return Entity::FromSnapshot(snapshot, entity.GetBlendMode(),
+                                entity.GetStencilDepth());
+  }
+
+  auto result =
+      RenderFilter(inputs_, renderer, entity_with_local_transform,
+                   effect_transform_, coverage.value(), coverage_hint);
+  if (!should_cache || !result.has_value()) {
+    return result;
+  }
+
+  // Most filters output a texture, which is then snapshotted without a copy.
+  auto snapshot = result->GetContents()->RenderToSnapshot(
+      renderer,        // renderer
+      result.value(),  // entity
+      coverage_hint,   // coverage_limit
+      std::nullopt,    // sampler_descriptor
+      true,            // msaa_enabled
+      "Cached Filter Snapshot");  // label
+  if (!snapshot.has_value()) {
+    return result;
+  }
+  // The texture must not be recycled for other render targets while it is
+  // cached.
+  renderer.GetRenderTargetCache()->Detach(snapshot->texture);
+  snapshot_cache.Insert(cache_key, snapshot.value());
+  return Entity::FromSnapshot(snapshot, result->GetBlendMode(),
+                              result->GetStencilDepth());
 }
 
 std::optional<Snapshot> FilterContents::RenderToSnapshot(
@@ -263,6 +319,10 @@ const FilterContents* FilterContents::AsFilter() const {
   return this;
 }
 
+const ColorMatrixFilterContents* FilterContents::AsColorMatrixFilter() const {
+  return nullptr;
+}
+
 Matrix FilterContents::GetLocalTransform(const Matrix& parent_transform) const {
   return Matrix();
 }
@@ -289,6 +349,7 @@ bool FilterContents::IsLeaf() const {
 }
 
 void FilterContents::SetLeafInputs(const FilterInput::Vector& inputs) {
+  InvalidateSnapshotCacheId();
   if (IsLeaf()) {
     inputs_ = inputs;
     return;
@@ -299,6 +360,7 @@ void FilterContents::SetLeafInputs(const FilterInput::Vector& inputs) {
 }
 
 void FilterContents::SetRenderingMode(Entity::RenderingMode rendering_mode) {
+  InvalidateSnapshotCacheId();
   for (auto& input : inputs_) {
     input->SetRenderingMode(rendering_mode);
   }
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <variant>
@@ -16,6 +17,8 @@
 
 namespace impeller {
 
+class ColorMatrixFilterContents;
+
 class FilterContents : public Contents {
  public:
   enum class BlurStyle {
@@ -89,6 +92,8 @@ class FilterContents : public Contents {
   ///         particular filter's implementation.
   void SetInputs(FilterInput::Vector inputs);
 
+  const FilterInput::Vector& GetInputs() const;
+
   /// @brief  Sets the transform which gets appended to the effect of this
   ///         filter. Note that this is in addition to the entity's transform.
   ///
@@ -128,6 +133,10 @@ class FilterContents : public Contents {
   // |Contents|
   const FilterContents* AsFilter() const override;
 
+  /// @brief  Returns this filter if it is a `ColorMatrixFilterContents`, and
+  ///         nullptr otherwise.
+  virtual const ColorMatrixFilterContents* AsColorMatrixFilter() const;
+
   virtual Matrix GetLocalTransform(const Matrix& parent_transform) const;
 
   Matrix GetTransform(const Matrix& parent_transform) const;
@@ -176,8 +185,13 @@ class FilterContents : public Contents {
 
   std::optional<Rect> GetLocalCoverage(const Entity& local_entity) const;
 
+  /// @brief  Gives this filter a new id in the `FilterSnapshotCache`, so that
+  ///         outputs cached before the filter changed aren't used.
+  void InvalidateSnapshotCacheId();
+
   FilterInput::Vector inputs_;
   Matrix effect_transform_;
+  uint64_t snapshot_cache_id_ = 0u;
 
   FML_DISALLOW_COPY_AND_ASSIGN(FilterContents);
 };
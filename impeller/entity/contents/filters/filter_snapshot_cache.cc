@@ -0,0 +1,110 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/filters/filter_snapshot_cache.h"
+
+namespace impeller {
+
+FilterSnapshotCache::FilterSnapshotCache() = default;
+
+FilterSnapshotCache::~FilterSnapshotCache() = default;
+
+std::optional<Snapshot> FilterSnapshotCache::Find(const Key& key,
+                                                  bool* should_cache) {
+  *should_cache = false;
+  auto found = entries_by_filter_.find(key.filter_id);
+  if (found == entries_by_filter_.end()) {
+    entries_.push_front(Entry{.key = key, .first_frame = frame_count_});
+    entries_by_filter_[key.filter_id] = entries_.begin();
+    return std::nullopt;
+  }
+
+  auto entry = found->second;
+  entries_.splice(entries_.begin(), entries_, entry);
+  entry->used_this_frame = true;
+  if (!(entry->key == key)) {
+    // The filter is drawn differently, such as after it moved.
+    byte_size_ -= entry->byte_size;
+    *entry = Entry{.key = key, .first_frame = frame_count_};
+    return std::nullopt;
+  }
+  if (!entry->snapshot.has_value()) {
+    *should_cache = entry->first_frame < frame_count_;
+  }
+  return entry->snapshot;
+}
+
+void FilterSnapshotCache::Insert(const Key& key, const Snapshot& snapshot) {
+  auto found = entries_by_filter_.find(key.filter_id);
+  if (found == entries_by_filter_.end() || !(found->second->key == key) ||
+      !snapshot.texture) {
+    return;
+  }
+  const size_t byte_size =
+      snapshot.texture->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
+  if (byte_size > kMaxBytes) {
+    return;
+  }
+
+  auto entry = found->second;
+  byte_size_ -= entry->byte_size;
+  entry->snapshot = snapshot;
+  entry->byte_size = byte_size;
+  byte_size_ += byte_size;
+
+  // Evict the least recently used outputs other than this one.
+  auto it = entries_.end();
+  while (byte_size_ > kMaxBytes && it != entries_.begin()) {
+    auto oldest = std::prev(it);
+    if (oldest == entry || !oldest->snapshot.has_value()) {
+      it = oldest;
+      continue;
+    }
+    Erase(oldest);
+  }
+}
+
+void FilterSnapshotCache::FinishFrame() {
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    auto entry = it++;
+    if (!entry->used_this_frame) {
+      Erase(entry);
+      continue;
+    }
+    entry->used_this_frame = false;
+  }
+  frame_count_++;
+}
+
+uint64_t FilterSnapshotCache::GetFrameCount() const {
+  return frame_count_;
+}
+
+void FilterSnapshotCache::Clear() {
+  entries_by_filter_.clear();
+  entries_.clear();
+  byte_size_ = 0u;
+}
+
+size_t FilterSnapshotCache::GetSnapshotCount() const {
+  size_t count = 0u;
+  for (const auto& entry : entries_) {
+    if (entry.snapshot.has_value()) {
+      count++;
+    }
+  }
+  return count;
+}
+
+size_t FilterSnapshotCache::GetByteSize() const {
+  return byte_size_;
+}
+
+void FilterSnapshotCache::Erase(std::list<Entry>::iterator entry) {
+  byte_size_ -= entry->byte_size;
+  entries_by_filter_.erase(entry->key.filter_id);
+  entries_.erase(entry);
+}
+
+}  // namespace impeller
@@ -0,0 +1,123 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <optional>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "impeller/geometry/matrix.h"
+#include "impeller/geometry/rect.h"
+#include "impeller/renderer/snapshot.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Retains the output of filters whose contents are drawn again
+///             in later frames, so that a static filtered image costs one
+///             texture draw per frame instead of a filter pass.
+///
+///             The contents of pictures reused by the `DlPictureCache` are
+///             shared by every frame the picture is drawn in and never
+///             modified, so a `FilterContents` that is drawn again with the
+///             same transform and coverage hint renders the same output.
+///             Filters are identified by the id of their `FilterContents`,
+///             which changes whenever the filter or its inputs are set.
+///
+///             A filter is only cached the second frame it is drawn in, so
+///             that filters that are recorded for every frame don't use
+///             memory. Filters that aren't drawn for a frame are released
+///             when the frame is finished, and the least recently used ones
+///             when the cache is over budget.
+///
+///             The cache is not thread safe and must only be used on the
+///             thread frames are rendered on.
+///
+class FilterSnapshotCache {
+ public:
+  /// The most bytes of texture memory retained by the cache.
+  static constexpr size_t kMaxBytes = 32u * 1024u * 1024u;
+
+  struct Key {
+    uint64_t filter_id = 0u;
+    Matrix transform;
+    std::optional<Rect> coverage_hint;
+
+    bool operator==(const Key& other) const {
+      return filter_id == other.filter_id && transform == other.transform &&
+             coverage_hint == other.coverage_hint;
+    }
+  };
+
+  FilterSnapshotCache();
+
+  ~FilterSnapshotCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Find the output of a filter and mark it as used by the
+  ///             current frame.
+  ///
+  /// @param[in]  key           The filter and how it is drawn.
+  /// @param[out] should_cache  Set to whether the filter was drawn the same
+  ///                           way in an earlier frame without being cached,
+  ///                           in which case its output should be inserted.
+  ///
+  /// @return     The cached output, or std::nullopt if there is none.
+  ///
+  std::optional<Snapshot> Find(const Key& key, bool* should_cache);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Retain the output of a filter. Outputs larger than the
+  ///             budget are not retained.
+  ///
+  void Insert(const Key& key, const Snapshot& snapshot);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Release the outputs of the filters that weren't drawn in the
+  ///             current frame and start a new frame.
+  ///
+  void FinishFrame();
+
+  //----------------------------------------------------------------------------
+  /// @brief      A count of the frames finished so far, so that filter inputs
+  ///             can tell whether a snapshot they kept is from this frame.
+  ///
+  uint64_t GetFrameCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drop all cached outputs, for example because the system is
+  ///             running low on memory.
+  ///
+  void Clear();
+
+  size_t GetSnapshotCount() const;
+
+  size_t GetByteSize() const;
+
+ private:
+  struct Entry {
+    Key key;
+    /// The frame the filter was first drawn in with this key.
+    uint64_t first_frame = 0u;
+    bool used_this_frame = true;
+    std::optional<Snapshot> snapshot;
+    size_t byte_size = 0u;
+  };
+
+  /// Ordered from the most to the least recently used.
+  std::list<Entry> entries_;
+  /// Each filter has at most one entry, for the last way it was drawn in.
+  std::unordered_map<uint64_t, std::list<Entry>::iterator> entries_by_filter_;
+  size_t byte_size_ = 0u;
+  uint64_t frame_count_ = 0u;
+
+  void Erase(std::list<Entry>::iterator entry);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FilterSnapshotCache);
+};
+
+}  // namespace impeller
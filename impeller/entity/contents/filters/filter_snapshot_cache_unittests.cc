@@ -0,0 +1,114 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+
+#include "flutter/testing/testing.h"
+#include "impeller/core/texture_descriptor.h"
+#include "impeller/entity/contents/filters/filter_snapshot_cache.h"
+#include "impeller/renderer/testing/mocks.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+Snapshot MakeSnapshot(ISize size) {
+  return Snapshot{
+      .texture = std::make_shared<MockTexture>(TextureDescriptor{
+          .format = PixelFormat::kR8G8B8A8UNormInt,
+          .size = size,
+      }),
+  };
+}
+
+}  // namespace
+
+TEST(FilterSnapshotCacheTest, CachesFiltersDrawnInConsecutiveFrames) {
+  FilterSnapshotCache cache;
+  const FilterSnapshotCache::Key key{
+      .filter_id = 1u, .transform = Matrix::MakeTranslation({10, 20})};
+  bool should_cache = true;
+
+  ASSERT_FALSE(cache.Find(key, &should_cache).has_value());
+  ASSERT_FALSE(should_cache);
+  cache.FinishFrame();
+
+  ASSERT_FALSE(cache.Find(key, &should_cache).has_value());
+  ASSERT_TRUE(should_cache);
+  auto snapshot = MakeSnapshot(ISize(100, 100));
+  cache.Insert(key, snapshot);
+  ASSERT_EQ(cache.GetSnapshotCount(), 1u);
+  ASSERT_EQ(cache.GetByteSize(), 100u * 100u * 4u);
+  cache.FinishFrame();
+
+  auto found = cache.Find(key, &should_cache);
+  ASSERT_TRUE(found.has_value());
+  ASSERT_EQ(found->texture, snapshot.texture);
+  ASSERT_FALSE(should_cache);
+}
+
+TEST(FilterSnapshotCacheTest, DropsFiltersDrawnDifferently) {
+  FilterSnapshotCache cache;
+  FilterSnapshotCache::Key key{.filter_id = 1u};
+  bool should_cache = false;
+  cache.Find(key, &should_cache);
+  cache.FinishFrame();
+  cache.Find(key, &should_cache);
+  cache.Insert(key, MakeSnapshot(ISize(10, 10)));
+
+  key.coverage_hint = Rect::MakeXYWH(0, 0, 5, 5);
+  ASSERT_FALSE(cache.Find(key, &should_cache).has_value());
+  ASSERT_FALSE(should_cache);
+  ASSERT_EQ(cache.GetSnapshotCount(), 0u);
+  ASSERT_EQ(cache.GetByteSize(), 0u);
+}
+
+TEST(FilterSnapshotCacheTest, ReleasesFiltersNotDrawnInAFrame) {
+  FilterSnapshotCache cache;
+  const FilterSnapshotCache::Key key{.filter_id = 1u};
+  bool should_cache = false;
+  cache.Find(key, &should_cache);
+  cache.FinishFrame();
+  cache.Find(key, &should_cache);
+  cache.Insert(key, MakeSnapshot(ISize(10, 10)));
+  cache.FinishFrame();
+  ASSERT_EQ(cache.GetSnapshotCount(), 1u);
+
+  cache.FinishFrame();
+  ASSERT_EQ(cache.GetSnapshotCount(), 0u);
+  ASSERT_EQ(cache.GetByteSize(), 0u);
+}
+
+TEST(FilterSnapshotCacheTest, EvictsLeastRecentlyUsedSnapshotsOverBudget) {
+  FilterSnapshotCache cache;
+  // Each snapshot is a third of the budget.
+  const auto size = ISize(1024, 1024 * 8 / 3);
+  bool should_cache = false;
+  for (uint64_t id = 1u; id <= 4u; id++) {
+    cache.Find({.filter_id = id}, &should_cache);
+  }
+  cache.FinishFrame();
+  for (uint64_t id = 1u; id <= 4u; id++) {
+    cache.Find({.filter_id = id}, &should_cache);
+    ASSERT_TRUE(should_cache);
+    cache.Insert({.filter_id = id}, MakeSnapshot(size));
+  }
+
+  ASSERT_EQ(cache.GetSnapshotCount(), 3u);
+  ASSERT_LE(cache.GetByteSize(), FilterSnapshotCache::kMaxBytes);
+  ASSERT_FALSE(cache.Find({.filter_id = 1u}, &should_cache).has_value());
+  ASSERT_TRUE(cache.Find({.filter_id = 4u}, &should_cache).has_value());
+}
+
+TEST(FilterSnapshotCacheTest, CountsFinishedFrames) {
+  FilterSnapshotCache cache;
+  ASSERT_EQ(cache.GetFrameCount(), 0u);
+  cache.FinishFrame();
+  cache.FinishFrame();
+  ASSERT_EQ(cache.GetFrameCount(), 2u);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -58,6 +58,85 @@ void DirectionalGaussianBlurFilterContents::SetIsSecondPass(
   is_second_pass_ = is_second_pass;
 }
 
+int DirectionalGaussianBlurFilterContents::ComputeDownsampleLevels(
+    Scalar radius) {
+  int levels = 0;
+  while (levels < kMaxDownsampleLevels &&
+         radius / (2 << levels) >= kMinDownsampledRadius) {
+    levels++;
+  }
+  return levels;
+}
+
+/// Renders the snapshot into a texture half its size. Sampling at the corners
+/// of the source texels with linear filtering averages each 2x2 block of texels
+/// into a single texel.
+static std::optional<Snapshot> HalveSnapshot(const ContentContext& renderer,
+                                             const Snapshot& snapshot) {
+  using VS = TextureFillVertexShader;
+  using FS = TextureFillFragmentShader;
+
+  auto input_size = snapshot.texture->GetSize();
+  auto output_size = ISize(std::max<int64_t>(1, (input_size.width + 1) / 2),
+                           std::max<int64_t>(1, (input_size.height + 1) / 2));
+
+  ContentContext::SubpassCallback subpass_callback =
+      [&snapshot](const ContentContext& renderer, RenderPass& pass) {
+        auto& host_buffer = pass.GetTransientsBuffer();
+
+        VertexBufferBuilder<VS::PerVertexData> vtx_builder;
+        vtx_builder.AddVertices({
+            {Point(0, 0), Point(0, 0)},
+            {Point(1, 0), Point(1, 0)},
+            {Point(1, 1), Point(1, 1)},
+            {Point(0, 0), Point(0, 0)},
+            {Point(1, 1), Point(1, 1)},
+            {Point(0, 1), Point(0, 1)},
+        });
+
+        VS::FrameInfo frame_info;
+        frame_info.mvp = Matrix::MakeOrthographic(ISize(1, 1));
+        frame_info.texture_sampler_y_coord_scale =
+            snapshot.texture->GetYCoordScale();
+        frame_info.alpha = 1.0;
+
+        Command cmd;
+        DEBUG_COMMAND_INFO(cmd, "Gaussian Blur Downsample");
+        auto options = OptionsFromPass(pass);
+        options.blend_mode = BlendMode::kSource;
+        cmd.pipeline = renderer.GetTexturePipeline(options);
+        cmd.BindVertices(vtx_builder.CreateVertexBuffer(host_buffer));
+        VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+
+        SamplerDescriptor sampler_desc = snapshot.sampler_descriptor;
+        sampler_desc.min_filter = MinMagFilter::kLinear;
+        sampler_desc.mag_filter = MinMagFilter::kLinear;
+        sampler_desc.width_address_mode = SamplerAddressMode::kClampToEdge;
+        sampler_desc.height_address_mode = SamplerAddressMode::kClampToEdge;
+        FS::BindTextureSampler(
+            cmd, snapshot.texture,
+            renderer.GetContext()->GetSamplerLibrary()->GetSampler(
+                sampler_desc));
+
+        return pass.AddCommand(std::move(cmd));
+      };
+
+  auto out_texture = renderer.MakeSubpass("Gaussian Blur Downsample",
+                                          output_size, subpass_callback,
+                                          /*msaa_enabled=*/false);
+  if (!out_texture) {
+    return std::nullopt;
+  }
+
+  Snapshot result = snapshot;
+  result.texture = out_texture;
+  // The downsampled texture covers the same area as the input.
+  result.transform = snapshot.transform *
+                     Matrix::MakeScale(Vector2(input_size) /
+                                       Vector2(output_size));
+  return result;
+}
+
 std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
     const FilterInput::Vector& inputs,
     const ContentContext& renderer,
@@ -87,15 +166,15 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
 
   // Input 0 snapshot.
 
+  // Only the hinted area of the output is rendered, which reads at most the
+  // blur radius beyond it along the blur direction. For the second pass of a
+  // 2D blur, this limits the area rendered by the first pass.
   std::optional<Rect> expanded_coverage_hint;
   if (coverage_hint.has_value()) {
-    auto r =
-        Size(transformed_blur_radius_length, transformed_blur_radius_length)
-            .Abs();
-    expanded_coverage_hint =
-        is_second_pass_ ? coverage_hint
-                        : Rect(coverage_hint.value().origin - r,
-                               Size(coverage_hint.value().size + r * 2));
+    auto r = Size(std::abs(transformed_blur_radius.x),
+                  std::abs(transformed_blur_radius.y));
+    expanded_coverage_hint = Rect(coverage_hint.value().origin - r,
+                                  Size(coverage_hint.value().size + r * 2));
   }
   auto input_snapshot = inputs[0]->GetSnapshot("GaussianBlur", renderer, entity,
                                                expanded_coverage_hint);
@@ -117,6 +196,50 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
         entity.GetStencilDepth());  // No blur to render.
   }
 
+  //----------------------------------------------------------------------------
+  /// Downsample large blurs.
+  ///
+
+  // The blur samples the input every `sample_step` pixels.
+  auto sample_levels = ComputeDownsampleLevels(transformed_blur_radius_length);
+  if (sample_levels > 0) {
+    // Sampling the input more sparsely than its texels would skip over
+    // detail, so the input is halved until its texels are at least as large
+    // as the sample step. Halving the input also blurs it perpendicular to
+    // the blur direction, which must stay within the blur that the other
+    // pass applies (see `SetSecondarySigma`).
+    auto blur_direction = transformed_blur_radius.Normalize();
+    auto perpendicular_radius_length =
+        transform
+            .TransformDirection(Vector2(-blur_direction_.y, blur_direction_.x) *
+                                Radius{secondary_blur_sigma_}.radius)
+            .GetLength();
+    auto max_halvings = ComputeDownsampleLevels(perpendicular_radius_length);
+
+    auto texels_per_step = (1 << sample_levels) *
+                           input_snapshot->transform.Invert()
+                               .TransformDirection(blur_direction)
+                               .GetLength();
+    int halvings = 0;
+    while (texels_per_step > 1.5) {
+      if (halvings == max_halvings) {
+        // Sample the input densely enough to cover every texel.
+        sample_levels -=
+            static_cast<int>(std::ceil(std::log2(texels_per_step)));
+        break;
+      }
+      auto halved_snapshot = HalveSnapshot(renderer, input_snapshot.value());
+      if (!halved_snapshot.has_value()) {
+        return std::nullopt;
+      }
+      input_snapshot = std::move(halved_snapshot);
+      texels_per_step /= 2;
+      halvings++;
+    }
+    sample_levels = std::max(sample_levels, 0);
+  }
+  const Scalar sample_step = 1 << sample_levels;
+
   // A matrix that rotates the snapshot space such that the blur direction is
   // +X.
   auto texture_rotate = Matrix::MakeRotationZ(
@@ -135,6 +258,19 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
   pass_texture_rect.origin.x -= transformed_blur_radius_length;
   pass_texture_rect.size.width += transformed_blur_radius_length * 2;
 
+  // Don't render the parts of the output that go unused. This matters most
+  // for backdrop filters, whose input is the entire parent pass texture even
+  // when only a small area of it is filtered.
+  if (coverage_hint.has_value()) {
+    auto limited_pass_texture_rect = pass_texture_rect.Intersection(
+        coverage_hint->TransformBounds(texture_rotate));
+    if (!limited_pass_texture_rect.has_value() ||
+        limited_pass_texture_rect->IsEmpty()) {
+      return std::nullopt;
+    }
+    pass_texture_rect = limited_pass_texture_rect.value();
+  }
+
   // UV mapping.
 
   auto pass_uv_project = [&texture_rotate,
@@ -171,19 +307,21 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
     frame_info.texture_sampler_y_coord_scale =
         input_snapshot->texture->GetYCoordScale();
 
+    // The kernel is evaluated in units of the sample step.
     FS::BlurInfo frag_info;
-    auto r = Radius{transformed_blur_radius_length};
+    auto r = Radius{transformed_blur_radius_length / sample_step};
     frag_info.blur_sigma = Sigma{r}.sigma;
     frag_info.blur_radius = std::round(r.radius);
 
     // The blur direction is in input UV space.
     frag_info.blur_uv_offset =
         pass_transform.Invert().TransformDirection(Vector2(1, 0)).Normalize() /
-        Point(input_snapshot->GetCoverage().value().size);
+        Point(input_snapshot->GetCoverage().value().size) * sample_step;
 
     Command cmd;
-    DEBUG_COMMAND_INFO(cmd, SPrintF("Gaussian Blur Filter (Radius=%.2f)",
-                                    transformed_blur_radius_length));
+    DEBUG_COMMAND_INFO(cmd,
+                       SPrintF("Gaussian Blur Filter (Radius=%.2f, Step=%.0f)",
+                               transformed_blur_radius_length, sample_step));
     cmd.BindVertices(vtx_buffer);
 
     auto options = OptionsFromPass(pass);
@@ -250,7 +388,9 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
   }
 
   Vector2 scaled_size = pass_texture_rect.size * scale;
-  ISize floored_size = ISize(scaled_size.x, scaled_size.y);
+  // Small limited outputs may otherwise round down to nothing.
+  ISize floored_size = ISize(std::max(scaled_size.x, 1.0f),
+                             std::max(scaled_size.y, 1.0f));
 
   auto out_texture = renderer.MakeSubpass("Directional Gaussian Blur Filter",
                                           floored_size, subpass_callback);
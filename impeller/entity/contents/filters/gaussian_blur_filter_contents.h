@@ -13,6 +13,13 @@ namespace impeller {
 
 class DirectionalGaussianBlurFilterContents final : public FilterContents {
  public:
+  /// Blurs are never downsampled so far that fewer than this many pixels of
+  /// the downsampled input lie within the blur radius.
+  static constexpr Scalar kMinDownsampledRadius = 16.0;
+
+  /// The maximum number of times the input of a blur is halved.
+  static constexpr int kMaxDownsampleLevels = 4;
+
   DirectionalGaussianBlurFilterContents();
 
   ~DirectionalGaussianBlurFilterContents() override;
@@ -29,6 +36,17 @@ class DirectionalGaussianBlurFilterContents final : public FilterContents {
 
   void SetIsSecondPass(bool is_second_pass);
 
+  //----------------------------------------------------------------------------
+  /// @brief      The number of times the input of a blur with the given
+  ///             radius, in pixels, may be halved before it is blurred.
+  ///
+  ///             Large blurs are computed from a downsampled copy of their
+  ///             input, sampled at a proportionally coarser step. This keeps
+  ///             the cost of the blur roughly constant as the radius grows
+  ///             instead of linear in the radius.
+  ///
+  static int ComputeDownsampleLevels(Scalar radius);
+
   // |FilterContents|
   std::optional<Rect> GetFilterCoverage(
       const FilterInput::Vector& inputs,
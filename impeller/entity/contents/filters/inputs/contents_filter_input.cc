@@ -8,6 +8,8 @@
 #include <utility>
 
 #include "impeller/base/strings.h"
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/contents/filters/filter_snapshot_cache.h"
 
 namespace impeller {
 
@@ -29,7 +31,9 @@ std::optional<Snapshot> ContentsFilterInput::GetSnapshot(
   if (!coverage_limit.has_value() && entity.GetContents()) {
     coverage_limit = entity.GetContents()->GetCoverageHint();
   }
-  if (!snapshot_.has_value()) {
+  const uint64_t frame = renderer.GetFilterSnapshotCache()->GetFrameCount();
+  if (!snapshot_.has_value() || snapshot_frame_ != frame) {
+    snapshot_frame_ = frame;
     snapshot_ = contents_->RenderToSnapshot(
         renderer,        // renderer
         entity,          // entity
@@ -35,6 +35,10 @@ class ContentsFilterInput final : public FilterInput {
 
   std::shared_ptr<Contents> contents_;
   mutable std::optional<Snapshot> snapshot_;
+  // The frame of the `FilterSnapshotCache` the snapshot was rendered in. The
+  // contents may be drawn again by later frames, whose render targets may
+  // reuse the texture of the snapshot.
+  mutable uint64_t snapshot_frame_ = 0u;
   bool msaa_enabled_;
 
   friend FilterInput;
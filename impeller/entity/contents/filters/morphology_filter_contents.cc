@@ -57,7 +57,14 @@ std::optional<Entity> DirectionalMorphologyFilterContents::RenderFilter(
     return std::nullopt;
   }
 
-  if (radius_.radius < kEhCloseEnough) {
+  auto transform = entity.GetTransformation() * effect_transform.Basis();
+  auto transformed_radius =
+      transform.TransformDirection(direction_ * radius_.radius);
+  // The shader samples whole pixels on either side. A radius that rounds to
+  // no pixels, such as once the filtered content is scaled down, would only
+  // copy the input into a new texture.
+  auto pixel_radius = std::round(transformed_radius.GetLength());
+  if (radius_.radius < kEhCloseEnough || pixel_radius < 1) {
     return Entity::FromSnapshot(input_snapshot.value(), entity.GetBlendMode(),
                                 entity.GetStencilDepth());
   }
@@ -93,9 +100,6 @@ std::optional<Entity> DirectionalMorphologyFilterContents::RenderFilter(
     frame_info.texture_sampler_y_coord_scale =
         input_snapshot->texture->GetYCoordScale();
 
-    auto transform = entity.GetTransformation() * effect_transform.Basis();
-    auto transformed_radius =
-        transform.TransformDirection(direction_ * radius_.radius);
     auto transformed_texture_vertices =
         Rect(Size(input_snapshot->texture->GetSize()))
             .GetTransformedPoints(input_snapshot->transform);
@@ -107,7 +111,7 @@ std::optional<Entity> DirectionalMorphologyFilterContents::RenderFilter(
             transformed_texture_vertices[2]);
 
     FS::FragInfo frag_info;
-    frag_info.radius = std::round(transformed_radius.GetLength());
+    frag_info.radius = pixel_radius;
     frag_info.morph_type = static_cast<Scalar>(morph_type_);
     frag_info.uv_offset =
         input_snapshot->transform.Invert()
@@ -0,0 +1,64 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/gradient_texture_cache.h"
+
+#include "flutter/fml/hash_combine.h"
+#include "impeller/entity/contents/gradient_generator.h"
+#include "impeller/geometry/gradient.h"
+
+namespace impeller {
+
+std::size_t GradientTextureCache::Key::Hash::operator()(
+    const Key& key) const {
+  std::size_t hash = fml::HashCombine(key.colors.size(), key.stops.size());
+  for (const auto& color : key.colors) {
+    fml::HashCombineSeed(hash, color.red, color.green, color.blue,
+                         color.alpha);
+  }
+  for (const auto& stop : key.stops) {
+    fml::HashCombineSeed(hash, stop);
+  }
+  return hash;
+}
+
+GradientTextureCache::GradientTextureCache() = default;
+
+GradientTextureCache::~GradientTextureCache() = default;
+
+std::shared_ptr<Texture> GradientTextureCache::GetTexture(
+    const std::vector<Color>& colors,
+    const std::vector<Scalar>& stops,
+    const std::shared_ptr<Context>& context) {
+  Key key{.colors = colors, .stops = stops};
+  if (auto found = entries_by_key_.find(key); found != entries_by_key_.end()) {
+    entries_.splice(entries_.begin(), entries_, found->second);
+    return found->second->texture;
+  }
+
+  auto texture =
+      CreateGradientTexture(CreateGradientBuffer(colors, stops), context);
+  if (!texture) {
+    return nullptr;
+  }
+
+  while (entries_.size() >= kMaxEntryCount) {
+    entries_by_key_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+  entries_.push_front(Entry{.key = std::move(key), .texture = texture});
+  entries_by_key_[entries_.front().key] = entries_.begin();
+  return texture;
+}
+
+void GradientTextureCache::Clear() {
+  entries_by_key_.clear();
+  entries_.clear();
+}
+
+size_t GradientTextureCache::GetEntryCount() const {
+  return entries_.size();
+}
+
+}  // namespace impeller
@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/core/texture.h"
+#include "impeller/geometry/color.h"
+#include "impeller/geometry/scalar.h"
+
+namespace impeller {
+
+class Context;
+
+//------------------------------------------------------------------------------
+/// @brief      A least recently used cache of the color ramp textures of
+///             gradients, so that gradients that are drawn every frame don't
+///             create and upload a new texture each time.
+///
+///             Entries are keyed by the colors and stops of the gradient. The
+///             textures are never written to after they are created, so they
+///             may be used by any number of commands at once.
+///
+class GradientTextureCache {
+ public:
+  /// The most gradient textures retained by the cache.
+  static constexpr size_t kMaxEntryCount = 64u;
+
+  GradientTextureCache();
+
+  ~GradientTextureCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the texture of the gradient with the given colors and
+  ///             stops, creating it if it isn't cached. The texture is marked
+  ///             as the most recently used.
+  ///
+  /// @return     The texture, or nullptr if the gradient is invalid or the
+  ///             texture couldn't be created.
+  ///
+  std::shared_ptr<Texture> GetTexture(const std::vector<Color>& colors,
+                                      const std::vector<Scalar>& stops,
+                                      const std::shared_ptr<Context>& context);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drop all cached textures, for example because the system is
+  ///             running low on memory.
+  ///
+  void Clear();
+
+  size_t GetEntryCount() const;
+
+ private:
+  struct Key {
+    std::vector<Color> colors;
+    std::vector<Scalar> stops;
+
+    struct Hash {
+      std::size_t operator()(const Key& key) const;
+    };
+
+    struct Equal {
+      bool operator()(const Key& lhs, const Key& rhs) const {
+        return lhs.colors == rhs.colors && lhs.stops == rhs.stops;
+      }
+    };
+  };
+
+  struct Entry {
+    Key key;
+    std::shared_ptr<Texture> texture;
+  };
+
+  std::list<Entry> entries_;
+  std::unordered_map<Key, std::list<Entry>::iterator, Key::Hash, Key::Equal>
+      entries_by_key_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GradientTextureCache);
+};
+
+}  // namespace impeller
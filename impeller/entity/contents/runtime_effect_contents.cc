@@ -41,6 +41,110 @@ bool RuntimeEffectContents::CanInheritOpacity(const Entity& entity) const {
   return false;
 }
 
+static std::shared_ptr<const ShaderFunction> RegisterShader(
+    const Context& context,
+    RuntimeStage& runtime_stage) {
+  auto library = context.GetShaderLibrary();
+
+  std::promise<bool> promise;
+  auto future = promise.get_future();
+
+  library->RegisterFunction(
+      runtime_stage.GetEntrypoint(),
+      ToShaderStage(runtime_stage.GetShaderStage()),
+      runtime_stage.GetCodeMapping(),
+      fml::MakeCopyable([promise = std::move(promise)](bool result) mutable {
+        promise.set_value(result);
+      }));
+
+  if (!future.get()) {
+    VALIDATION_LOG << "Failed to build runtime effect (entry point: "
+                   << runtime_stage.GetEntrypoint() << ")";
+    return nullptr;
+  }
+
+  auto function = library->GetFunction(runtime_stage.GetEntrypoint(),
+                                       ShaderStage::kFragment);
+  if (!function) {
+    VALIDATION_LOG
+        << "Failed to fetch runtime effect function immediately after "
+           "registering it (entry point: "
+        << runtime_stage.GetEntrypoint() << ")";
+    return nullptr;
+  }
+
+  runtime_stage.SetClean();
+  return function;
+}
+
+static PipelineDescriptor MakePipelineDescriptor(
+    const Context& context,
+    const RuntimeStage& runtime_stage,
+    const ContentContextOptions& options) {
+  using VS = RuntimeEffectVertexShader;
+
+  auto library = context.GetShaderLibrary();
+  const auto& caps = context.GetCapabilities();
+  const auto color_attachment_format = caps->GetDefaultColorFormat();
+  const auto stencil_attachment_format = caps->GetDefaultStencilFormat();
+
+  PipelineDescriptor desc;
+  desc.SetLabel("Runtime Stage");
+  desc.AddStageEntrypoint(
+      library->GetFunction(VS::kEntrypointName, ShaderStage::kVertex));
+  desc.AddStageEntrypoint(library->GetFunction(runtime_stage.GetEntrypoint(),
+                                               ShaderStage::kFragment));
+  auto vertex_descriptor = std::make_shared<VertexDescriptor>();
+  vertex_descriptor->SetStageInputs(VS::kAllShaderStageInputs,
+                                    VS::kInterleavedBufferLayout);
+  desc.SetVertexDescriptor(std::move(vertex_descriptor));
+  desc.SetColorAttachmentDescriptor(
+      0u, {.format = color_attachment_format, .blending_enabled = true});
+
+  StencilAttachmentDescriptor stencil0;
+  stencil0.stencil_compare = CompareFunction::kEqual;
+  desc.SetStencilAttachmentDescriptors(stencil0);
+  desc.SetStencilPixelFormat(stencil_attachment_format);
+
+  options.ApplyToPipelineDescriptor(desc);
+  return desc;
+}
+
+PipelineFuture<PipelineDescriptor> RuntimeEffectContents::BootstrapShader(
+    const std::shared_ptr<Context>& context,
+    const std::shared_ptr<RuntimeStage>& runtime_stage) {
+  if (!context || !runtime_stage) {
+    return {};
+  }
+
+  auto function = context->GetShaderLibrary()->GetFunction(
+      runtime_stage->GetEntrypoint(), ShaderStage::kFragment);
+  if (function && runtime_stage->IsDirty()) {
+    // The function of a previous version of the stage must be replaced along
+    // with the pipelines that the content context cached for it, which only
+    // the next draw can do.
+    return {};
+  }
+  if (!function) {
+    function = RegisterShader(*context, *runtime_stage);
+    if (!function) {
+      return {};
+    }
+  }
+
+  // Warm up the variant most effects are drawn with: a cover or rect geometry
+  // drawn with source over into the default offscreen render target.
+  const auto& caps = context->GetCapabilities();
+  ContentContextOptions options;
+  options.sample_count = caps->SupportsOffscreenMSAA() ? SampleCount::kCount4
+                                                       : SampleCount::kCount1;
+  options.color_attachment_pixel_format = caps->GetDefaultColorFormat();
+  options.primitive_type = PrimitiveType::kTriangleStrip;
+
+  return context->GetPipelineLibrary()->GetPipeline(
+      MakePipelineDescriptor(*context, *runtime_stage, options));
+}
+
 bool RuntimeEffectContents::Render(const ContentContext& renderer,
                                    const Entity& entity,
                                    RenderPass& pass) const {
@@ -58,12 +162,14 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
   /// Get or register shader.
   ///
 
-  // TODO(113719): Register the shader function earlier.
+  // Shaders may be registered ahead of their first draw, see
+  // `RuntimeEffectContents::BootstrapShader`.
 
   std::shared_ptr<const ShaderFunction> function = library->GetFunction(
       runtime_stage_->GetEntrypoint(), ShaderStage::kFragment);
 
   if (function && runtime_stage_->IsDirty()) {
+    renderer.ClearCachedRuntimeEffectPipeline(runtime_stage_->GetEntrypoint());
     context->GetPipelineLibrary()->RemovePipelinesWithEntryPoint(function);
     library->UnregisterFunction(runtime_stage_->GetEntrypoint(),
                                 ShaderStage::kFragment);
@@ -72,34 +178,10 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
   }
 
   if (!function) {
-    std::promise<bool> promise;
-    auto future = promise.get_future();
-
-    library->RegisterFunction(
-        runtime_stage_->GetEntrypoint(),
-        ToShaderStage(runtime_stage_->GetShaderStage()),
-        runtime_stage_->GetCodeMapping(),
-        fml::MakeCopyable([promise = std::move(promise)](bool result) mutable {
-          promise.set_value(result);
-        }));
-
-    if (!future.get()) {
-      VALIDATION_LOG << "Failed to build runtime effect (entry point: "
-                     << runtime_stage_->GetEntrypoint() << ")";
-      return false;
-    }
-
-    function = library->GetFunction(runtime_stage_->GetEntrypoint(),
-                                    ShaderStage::kFragment);
+    function = RegisterShader(*context, *runtime_stage_);
     if (!function) {
-      VALIDATION_LOG
-          << "Failed to fetch runtime effect function immediately after "
-             "registering it (entry point: "
-          << runtime_stage_->GetEntrypoint() << ")";
       return false;
     }
-
-    runtime_stage_->SetClean();
   }
 
   //--------------------------------------------------------------------------
@@ -113,28 +195,7 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
   /// Get or create runtime stage pipeline.
   ///
 
-  const auto& caps = context->GetCapabilities();
-  const auto color_attachment_format = caps->GetDefaultColorFormat();
-  const auto stencil_attachment_format = caps->GetDefaultStencilFormat();
-
   using VS = RuntimeEffectVertexShader;
-  PipelineDescriptor desc;
-  desc.SetLabel("Runtime Stage");
-  desc.AddStageEntrypoint(
-      library->GetFunction(VS::kEntrypointName, ShaderStage::kVertex));
-  desc.AddStageEntrypoint(library->GetFunction(runtime_stage_->GetEntrypoint(),
-                                               ShaderStage::kFragment));
-  auto vertex_descriptor = std::make_shared<VertexDescriptor>();
-  vertex_descriptor->SetStageInputs(VS::kAllShaderStageInputs,
-                                    VS::kInterleavedBufferLayout);
-  desc.SetVertexDescriptor(std::move(vertex_descriptor));
-  desc.SetColorAttachmentDescriptor(
-      0u, {.format = color_attachment_format, .blending_enabled = true});
-
-  StencilAttachmentDescriptor stencil0;
-  stencil0.stencil_compare = CompareFunction::kEqual;
-  desc.SetStencilAttachmentDescriptors(stencil0);
-  desc.SetStencilPixelFormat(stencil_attachment_format);
 
   auto options = OptionsFromPassAndEntity(pass, entity);
   if (geometry_result.prevent_overdraw) {
@@ -142,9 +203,17 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
     options.stencil_operation = StencilOperation::kIncrementClamp;
   }
   options.primitive_type = geometry_result.type;
-  options.ApplyToPipelineDescriptor(desc);
 
-  auto pipeline = context->GetPipelineLibrary()->GetPipeline(desc).Get();
+  auto create_callback =
+      [&]() -> std::shared_ptr<Pipeline<PipelineDescriptor>> {
+    return context->GetPipelineLibrary()
+        ->GetPipeline(
+            MakePipelineDescriptor(*context, *runtime_stage_, options))
+        .Get();
+  };
+
+  auto pipeline = renderer.GetCachedRuntimeEffectPipeline(
+      runtime_stage_->GetEntrypoint(), options, create_callback);
   if (!pipeline) {
     VALIDATION_LOG << "Failed to get or create runtime effect pipeline.";
     return false;
@@ -171,12 +240,11 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
   size_t minimum_sampler_index = 100000000;
   size_t buffer_index = 0;
   size_t buffer_offset = 0;
-  for (auto uniform : runtime_stage_->GetUniforms()) {
-    // TODO(113715): Populate this metadata once GLES is able to handle
-    //               non-struct uniform names.
-    std::shared_ptr<ShaderMetadata> metadata =
-        std::make_shared<ShaderMetadata>();
-
+  // TODO(113715): Populate this metadata once GLES is able to handle
+  //               non-struct uniform names.
+  auto metadata = std::make_shared<ShaderMetadata>();
+  const auto& uniforms = runtime_stage_->GetUniforms();
+  for (const auto& uniform : uniforms) {
     switch (uniform.type) {
       case kSampledImage: {
         // Sampler uniforms are ordered in the IPLR according to their
@@ -225,11 +293,7 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
   }
 
   size_t sampler_index = 0;
-  for (auto uniform : runtime_stage_->GetUniforms()) {
-    // TODO(113715): Populate this metadata once GLES is able to handle
-    //               non-struct uniform names.
-    ShaderMetadata metadata;
-
+  for (const auto& uniform : uniforms) {
     switch (uniform.type) {
       case kSampledImage: {
         FML_DCHECK(sampler_index < texture_inputs_.size());
@@ -242,7 +306,7 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
         image_slot.name = uniform.name.c_str();
         image_slot.texture_index = uniform.location - minimum_sampler_index;
         image_slot.sampler_index = uniform.location - minimum_sampler_index;
-        cmd.BindResource(ShaderStage::kFragment, image_slot, metadata,
+        cmd.BindResource(ShaderStage::kFragment, image_slot, *metadata,
                          input.texture, sampler);
 
         sampler_index++;
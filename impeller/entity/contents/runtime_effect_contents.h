@@ -10,6 +10,8 @@
 
 #include "impeller/core/sampler_descriptor.h"
 #include "impeller/entity/contents/color_source_contents.h"
+#include "impeller/renderer/context.h"
+#include "impeller/renderer/pipeline.h"
 #include "impeller/runtime_stage/runtime_stage.h"
 
 namespace impeller {
@@ -21,6 +23,25 @@ class RuntimeEffectContents final : public ColorSourceContents {
     std::shared_ptr<Texture> texture;
   };
 
+  //----------------------------------------------------------------------------
+  /// @brief      Registers the shader of `runtime_stage` with the shader
+  ///             library of `context` and starts compiling the pipeline that
+  ///             draws it into offscreen render targets, so that the first
+  ///             draw of the effect doesn't compile them.
+  ///
+  ///             This must be called on the thread that draws runtime effects,
+  ///             and blocks until the shader is registered but not on the
+  ///             pipeline compile.
+  ///
+  /// @return     A future for the compiled pipeline, or an invalid future if
+  ///             the shader couldn't be registered or if the shader of a
+  ///             previous version of the stage is still registered, which
+  ///             only the next draw replaces.
+  ///
+  static PipelineFuture<PipelineDescriptor> BootstrapShader(
+      const std::shared_ptr<Context>& context,
+      const std::shared_ptr<RuntimeStage>& runtime_stage);
+
   void SetRuntimeStage(std::shared_ptr<RuntimeStage> runtime_stage);
 
   void SetUniformData(std::shared_ptr<std::vector<uint8_t>> uniform_data);
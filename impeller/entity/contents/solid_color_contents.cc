@@ -7,8 +7,11 @@
 #include "impeller/entity/contents/clip_contents.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/position_color.vert.h"
+#include "impeller/entity/vertices.frag.h"
 #include "impeller/geometry/path.h"
 #include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/vertex_buffer_builder.h"
 
 namespace impeller {
 
@@ -45,22 +48,86 @@ std::optional<Rect> SolidColorContents::GetCoverage(
   return geometry->GetCoverage(entity.GetTransformation());
 };
 
+// Rects drawn to passes without multisampling have their edges antialiased
+// with coverage ramps, which only blend right when drawn over the destination.
+static bool CanAntialiasRect(const Entity& entity) {
+  return entity.GetBlendMode() == BlendMode::kSourceOver &&
+         entity.GetTransformation().IsAffine();
+}
+
+static bool RenderAntialiasedRect(const ContentContext& renderer,
+                                  const Entity& entity,
+                                  RenderPass& pass,
+                                  const Rect& rect,
+                                  const Color& color) {
+  using VS = GeometryColorPipeline::VertexShader;
+  using FS = GeometryColorPipeline::FragmentShader;
+
+  VertexBufferBuilder<VS::PerVertexData> vertex_builder;
+  vertex_builder.Reserve(kAntialiasedQuadVertexCount);
+  AppendAntialiasedQuadVertices(
+      rect.GetTransformedPoints(entity.GetTransformation()), color,
+      vertex_builder);
+  if (vertex_builder.GetVertexCount() == 0u) {
+    return true;
+  }
+
+  auto& host_buffer = pass.GetTransientsBuffer();
+
+  Command cmd;
+  DEBUG_COMMAND_INFO(cmd, "Solid Fill (Antialiased Rect)");
+  cmd.stencil_reference = entity.GetStencilDepth();
+
+  auto options = OptionsFromPassAndEntity(pass, entity);
+  options.primitive_type = PrimitiveType::kTriangle;
+  cmd.pipeline = renderer.GetGeometryColorPipeline(options);
+  cmd.BindVertices(vertex_builder.CreateVertexBuffer(host_buffer));
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize());
+  VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+
+  FS::FragInfo frag_info;
+  frag_info.alpha = 1.0;
+  FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+
+  return pass.AddCommand(std::move(cmd));
+}
+
 bool SolidColorContents::Render(const ContentContext& renderer,
                                 const Entity& entity,
                                 RenderPass& pass) const {
   auto capture = entity.GetCapture().CreateChild("SolidColorContents");
 
+  if (pass.GetRenderTarget().GetSampleCount() == SampleCount::kCount1 &&
+      CanAntialiasRect(entity)) {
+    if (auto rect = GetGeometry()->AsRect(); rect.has_value()) {
+      return RenderAntialiasedRect(
+          renderer, entity, pass, rect.value(),
+          capture.AddColor("Color", GetColor()).Premultiply());
+    }
+  }
+
   using VS = SolidFillPipeline::VertexShader;
 
   Command cmd;
   DEBUG_COMMAND_INFO(cmd, "Solid Fill");
   cmd.stencil_reference = entity.GetStencilDepth();
 
-  auto geometry_result =
-      GetGeometry()->GetPositionBuffer(renderer, entity, pass);
-
   auto options = OptionsFromPassAndEntity(pass, entity);
-  if (geometry_result.prevent_overdraw) {
+
+  // Large paths are written into the stencil and covered, instead of being
+  // tessellated. The cover resets the stencil it touches.
+  auto stencil_cover_result =
+      GetGeometry()->GetStencilCoverBuffer(renderer, entity, pass);
+  auto geometry_result =
+      stencil_cover_result.has_value()
+          ? stencil_cover_result.value()
+          : GetGeometry()->GetPositionBuffer(renderer, entity, pass);
+  if (stencil_cover_result.has_value()) {
+    options.stencil_compare = CompareFunction::kNotEqual;
+    options.stencil_operation = StencilOperation::kSetToReferenceValue;
+  } else if (geometry_result.prevent_overdraw) {
     options.stencil_compare = CompareFunction::kEqual;
     options.stencil_operation = StencilOperation::kIncrementClamp;
   }
@@ -103,6 +170,33 @@ std::optional<Color> SolidColorContents::AsBackgroundColor(
              : std::optional<Color>();
 }
 
+std::optional<Contents::BatchedQuad> SolidColorContents::AsBatchedQuad(
+    const Entity& entity) const {
+  auto geometry = GetGeometry();
+  if (geometry == nullptr) {
+    return std::nullopt;
+  }
+  auto rect = geometry->AsRect();
+  if (!rect.has_value()) {
+    return std::nullopt;
+  }
+  return BatchedQuad{
+      .rect = rect.value(),
+      .color = GetColor().Premultiply(),
+  };
+}
+
+bool SolidColorContents::IsAntialiasedWithoutMSAA(const Entity& entity) const {
+  auto geometry = GetGeometry();
+  if (geometry == nullptr) {
+    return false;
+  }
+  auto rect = geometry->AsRect();
+  return rect.has_value() &&
+         (CanAntialiasRect(entity) ||
+          IsPixelAlignedRect(rect.value(), entity.GetTransformation()));
+}
+
 bool SolidColorContents::ApplyColorFilter(
     const ColorFilterProc& color_filter_proc) {
   color_ = color_filter_proc(color_);
@@ -51,6 +51,12 @@ class SolidColorContents final : public ColorSourceContents {
   std::optional<Color> AsBackgroundColor(const Entity& entity,
                                          ISize target_size) const override;
 
+  // |Contents|
+  std::optional<BatchedQuad> AsBatchedQuad(const Entity& entity) const override;
+
+  // |Contents|
+  bool IsAntialiasedWithoutMSAA(const Entity& entity) const override;
+
   // |Contents|
   [[nodiscard]] bool ApplyColorFilter(
       const ColorFilterProc& color_filter_proc) override;
@@ -22,8 +22,13 @@ SolidRRectBlurContents::~SolidRRectBlurContents() = default;
 
 void SolidRRectBlurContents::SetRRect(std::optional<Rect> rect,
                                       Scalar corner_radius) {
+  SetRRect(rect, Size(corner_radius, corner_radius));
+}
+
+void SolidRRectBlurContents::SetRRect(std::optional<Rect> rect,
+                                      Size corner_radii) {
   rect_ = rect;
-  corner_radius_ = corner_radius;
+  corner_radii_ = corner_radii;
 }
 
 void SolidRRectBlurContents::SetSigma(Sigma sigma) {
@@ -102,12 +107,12 @@ bool SolidRRectBlurContents::Render(const ContentContext& renderer,
   VS::BindFrameInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(frame_info));
 
   FS::FragInfo frag_info;
-  frag_info.color = color_;
+  frag_info.color = color_ * inherited_opacity_;
   frag_info.blur_sigma = blur_sigma;
   frag_info.rect_size = Point(positive_rect.size);
-  frag_info.corner_radius =
-      std::min(corner_radius_, std::min(positive_rect.size.width / 2.0f,
-                                        positive_rect.size.height / 2.0f));
+  frag_info.corner_radii =
+      Point(std::min(corner_radii_.width, positive_rect.size.width / 2.0f),
+            std::min(corner_radii_.height, positive_rect.size.height / 2.0f));
   FS::BindFragInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(frag_info));
 
   if (!pass.AddCommand(std::move(cmd))) {
@@ -117,4 +122,12 @@ bool SolidRRectBlurContents::Render(const ContentContext& renderer,
   return true;
 }
 
+bool SolidRRectBlurContents::CanInheritOpacity(const Entity& entity) const {
+  return true;
+}
+
+void SolidRRectBlurContents::SetInheritedOpacity(Scalar opacity) {
+  inherited_opacity_ = opacity;
+}
+
 }  // namespace impeller
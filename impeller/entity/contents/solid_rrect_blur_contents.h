@@ -19,8 +19,9 @@ class HostBuffer;
 struct VertexBuffer;
 
 /// @brief  Draws a fast solid color blur of an rounded rectangle. Only supports
-/// RRects with fully symmetrical radii. Also produces correct results for
-/// rectangles (corner_radius=0) and circles (corner_radius=width/2=height/2).
+/// RRects whose corners all have the same, possibly elliptical, radii. Also
+/// produces correct results for rectangles (corner_radii=0) and ovals
+/// (corner_radii=size/2).
 class SolidRRectBlurContents final : public Contents {
  public:
   SolidRRectBlurContents();
@@ -29,6 +30,8 @@ class SolidRRectBlurContents final : public Contents {
 
   void SetRRect(std::optional<Rect> rect, Scalar corner_radius = 0);
 
+  void SetRRect(std::optional<Rect> rect, Size corner_radii);
+
   void SetSigma(Sigma sigma);
 
   void SetColor(Color color);
@@ -43,12 +46,19 @@ class SolidRRectBlurContents final : public Contents {
               const Entity& entity,
               RenderPass& pass) const override;
 
+  // |Contents|
+  bool CanInheritOpacity(const Entity& entity) const override;
+
+  // |Contents|
+  void SetInheritedOpacity(Scalar opacity) override;
+
  private:
   std::optional<Rect> rect_;
-  Scalar corner_radius_;
+  Size corner_radii_;
   Sigma sigma_;
 
   Color color_;
+  Scalar inherited_opacity_ = 1.0f;
 
   FML_DISALLOW_COPY_AND_ASSIGN(SolidRRectBlurContents);
 };
@@ -4,6 +4,7 @@
 
 #include "impeller/entity/contents/text_contents.h"
 
+#include <algorithm>
 #include <cstring>
 #include <optional>
 #include <type_traits>
@@ -12,6 +13,7 @@
 #include "impeller/core/formats.h"
 #include "impeller/core/sampler_descriptor.h"
 #include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/contents/text_vertex_cache.h"
 #include "impeller/entity/entity.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/sampler_library.h"
@@ -64,6 +66,13 @@ std::optional<Rect> TextContents::GetCoverage(const Entity& entity) const {
   return frame_->GetBounds().TransformBounds(entity.GetTransformation());
 }
 
+bool TextContents::IsAntialiasedWithoutMSAA(const Entity& entity) const {
+  // The glyphs are rasterized antialiased into the atlas, and their quads
+  // cover the bounds of the rasterized glyphs, so there are no edges left for
+  // multisampling to smooth.
+  return true;
+}
+
 void TextContents::PopulateGlyphAtlas(
     const std::shared_ptr<LazyGlyphAtlas>& lazy_glyph_atlas,
     Scalar scale) {
@@ -79,7 +88,7 @@ bool TextContents::Render(const ContentContext& renderer,
     return true;
   }
 
-  auto type = frame_->GetAtlasType();
+  auto type = frame_->GetAtlasType(scale_);
   auto atlas =
       ResolveAtlas(*renderer.GetContext(), type, renderer.GetLazyGlyphAtlas());
 
@@ -93,10 +102,16 @@ bool TextContents::Render(const ContentContext& renderer,
   DEBUG_COMMAND_INFO(cmd, "TextFrame");
   auto opts = OptionsFromPassAndEntity(pass, entity);
   opts.primitive_type = PrimitiveType::kTriangle;
-  if (type == GlyphAtlas::Type::kAlphaBitmap) {
-    cmd.pipeline = renderer.GetGlyphAtlasPipeline(opts);
-  } else {
-    cmd.pipeline = renderer.GetGlyphAtlasColorPipeline(opts);
+  switch (type) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+      cmd.pipeline = renderer.GetGlyphAtlasPipeline(opts);
+      break;
+    case GlyphAtlas::Type::kColorBitmap:
+      cmd.pipeline = renderer.GetGlyphAtlasColorPipeline(opts);
+      break;
+    case GlyphAtlas::Type::kSignedDistanceField:
+      cmd.pipeline = renderer.GetGlyphAtlasSdfPipeline(opts);
+      break;
   }
   cmd.stencil_reference = entity.GetStencilDepth();
 
@@ -117,8 +132,9 @@ bool TextContents::Render(const ContentContext& renderer,
 
   VS::BindFrameInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(frame_info));
 
+  const bool is_sdf = type == GlyphAtlas::Type::kSignedDistanceField;
   SamplerDescriptor sampler_desc;
-  if (frame_info.is_translation_scale) {
+  if (frame_info.is_translation_scale && !is_sdf) {
     sampler_desc.min_filter = MinMagFilter::kNearest;
     sampler_desc.mag_filter = MinMagFilter::kNearest;
   } else {
@@ -127,17 +143,36 @@ bool TextContents::Render(const ContentContext& renderer,
     // on linear sampling to prevent crunchiness caused by the pixel grid not
     // being perfectly aligned.
     // The downside is that this slightly over-blurs rotated/skewed text.
+    // Distance fields are always interpolated, the edge stays sharp.
     sampler_desc.min_filter = MinMagFilter::kLinear;
     sampler_desc.mag_filter = MinMagFilter::kLinear;
   }
   sampler_desc.mip_filter = MipFilter::kNearest;
 
-  FS::BindGlyphAtlasSampler(
-      cmd,                  // command
-      atlas->GetTexture(),  // texture
-      renderer.GetContext()->GetSamplerLibrary()->GetSampler(
-          sampler_desc)  // sampler
-  );
+  auto sampler =
+      renderer.GetContext()->GetSamplerLibrary()->GetSampler(sampler_desc);
+  if (is_sdf) {
+    using SdfFS = GlyphAtlasSdfPipeline::FragmentShader;
+
+    // The glyph edge is anti-aliased over one screen pixel. Runs of smaller
+    // fonts are magnified less, so the widest edge of all runs is used.
+    Scalar atlas_pixels_per_screen_pixel = 0;
+    for (const TextRun& run : frame_->GetRuns()) {
+      atlas_pixels_per_screen_pixel = std::max(
+          atlas_pixels_per_screen_pixel,
+          TextFrame::GetAtlasScale(type, scale_,
+                                   run.GetFont().GetMetrics().point_size) /
+              scale_);
+    }
+    SdfFS::FragInfo frag_info;
+    frag_info.edge_width = 0.5 * atlas_pixels_per_screen_pixel /
+                           (2 * GlyphAtlas::kSignedDistanceFieldSpread);
+    SdfFS::BindFragInfo(cmd,
+                        pass.GetTransientsBuffer().EmplaceUniform(frag_info));
+    SdfFS::BindGlyphAtlasSampler(cmd, atlas->GetTexture(), sampler);
+  } else {
+    FS::BindGlyphAtlasSampler(cmd, atlas->GetTexture(), sampler);
+  }
 
   // Common vertex information for all glyphs.
   // All glyphs are given the same vertex information in the form of a
@@ -150,6 +185,15 @@ bool TextContents::Render(const ContentContext& renderer,
                                                 Point{0, 1}, Point{1, 0},
                                                 Point{0, 1}, Point{1, 1}};
 
+  // The vertices don't depend on the transform, offset or color of the text,
+  // so they are reused for as long as the frame is drawn from the same atlas.
+  const auto& vertex_cache = renderer.GetTextVertexCache();
+  auto vertex_buffer = vertex_cache->Find(frame_, atlas, scale_);
+  if (vertex_buffer.has_value()) {
+    cmd.BindVertices(vertex_buffer.value());
+    return pass.AddCommand(std::move(cmd));
+  }
+
   auto& host_buffer = pass.GetTransientsBuffer();
   size_t vertex_count = 0;
   for (const auto& run : frame_->GetRuns()) {
@@ -157,6 +201,7 @@ bool TextContents::Render(const ContentContext& renderer,
   }
   vertex_count *= 6;
 
+  bool complete = true;
   auto buffer_view = host_buffer.Emplace(
       vertex_count * sizeof(VS::PerVertexData), alignof(VS::PerVertexData),
       [&](uint8_t* contents) {
@@ -165,12 +210,17 @@ bool TextContents::Render(const ContentContext& renderer,
             reinterpret_cast<VS::PerVertexData*>(contents);
         for (const TextRun& run : frame_->GetRuns()) {
           const Font& font = run.GetFont();
-          Scalar rounded_scale = TextFrame::RoundScaledFontSize(
-              scale_, font.GetMetrics().point_size);
+          Scalar rounded_scale = TextFrame::GetAtlasScale(
+              type, scale_, font.GetMetrics().point_size);
+          // Glyphs in distance field atlases are padded by the spread.
+          const Scalar glyph_padding =
+              is_sdf ? GlyphAtlas::kSignedDistanceFieldSpread / rounded_scale
+                     : 0;
           const FontGlyphAtlas* font_atlas =
               atlas->GetFontGlyphAtlas(font, rounded_scale);
           if (!font_atlas) {
             VALIDATION_LOG << "Could not find font in the atlas.";
+            complete = false;
             continue;
           }
 
@@ -180,16 +230,18 @@ bool TextContents::Render(const ContentContext& renderer,
                 font_atlas->FindGlyphBounds(glyph_position.glyph);
             if (!maybe_atlas_glyph_bounds.has_value()) {
               VALIDATION_LOG << "Could not find glyph position in the atlas.";
+              complete = false;
               continue;
             }
             const Rect& atlas_glyph_bounds = maybe_atlas_glyph_bounds.value();
             vtx.atlas_glyph_bounds = Vector4(
                 atlas_glyph_bounds.origin.x, atlas_glyph_bounds.origin.y,
                 atlas_glyph_bounds.size.width, atlas_glyph_bounds.size.height);
-            vtx.glyph_bounds = Vector4(glyph_position.glyph.bounds.origin.x,
-                                       glyph_position.glyph.bounds.origin.y,
-                                       glyph_position.glyph.bounds.size.width,
-                                       glyph_position.glyph.bounds.size.height);
+            const Rect glyph_bounds =
+                glyph_position.glyph.bounds.Expand(glyph_padding);
+            vtx.glyph_bounds =
+                Vector4(glyph_bounds.origin.x, glyph_bounds.origin.y,
+                        glyph_bounds.size.width, glyph_bounds.size.height);
             vtx.glyph_position = glyph_position.position;
 
             for (const Point& point : unit_points) {
@@ -200,12 +252,21 @@ bool TextContents::Render(const ContentContext& renderer,
         }
       });
 
-  cmd.BindVertices({
-      .vertex_buffer = buffer_view,
-      .index_buffer = {},
-      .vertex_count = vertex_count,
-      .index_type = IndexType::kNone,
-  });
+  if (complete && buffer_view) {
+    vertex_buffer = vertex_cache->Insert(
+        frame_, atlas, scale_, *renderer.GetContext()->GetResourceAllocator(),
+        buffer_view.contents + buffer_view.range.offset,
+        buffer_view.range.length, vertex_count);
+  }
+  if (!vertex_buffer.has_value()) {
+    vertex_buffer = VertexBuffer{
+        .vertex_buffer = buffer_view,
+        .index_buffer = {},
+        .vertex_count = vertex_count,
+        .index_type = IndexType::kNone,
+    };
+  }
+  cmd.BindVertices(vertex_buffer.value());
 
   return pass.AddCommand(std::move(cmd));
 }
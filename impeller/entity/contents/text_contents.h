@@ -45,6 +45,9 @@ class TextContents final : public Contents {
   // |Contents|
   std::optional<Rect> GetCoverage(const Entity& entity) const override;
 
+  // |Contents|
+  bool IsAntialiasedWithoutMSAA(const Entity& entity) const override;
+
   // |Contents|
   void PopulateGlyphAtlas(
       const std::shared_ptr<LazyGlyphAtlas>& lazy_glyph_atlas,
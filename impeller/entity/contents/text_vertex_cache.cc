@@ -0,0 +1,136 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/text_vertex_cache.h"
+
+#include <iterator>
+
+#include "impeller/core/device_buffer.h"
+#include "impeller/core/device_buffer_descriptor.h"
+
+namespace impeller {
+
+TextVertexCache::TextVertexCache() = default;
+
+TextVertexCache::~TextVertexCache() = default;
+
+TextVertexCache::Key TextVertexCache::MakeKey(
+    const std::shared_ptr<TextFrame>& frame,
+    const std::shared_ptr<GlyphAtlas>& atlas,
+    Scalar scale) {
+  return Key{
+      .frame = frame.get(),
+      .atlas = atlas.get(),
+      .layout_version = atlas->GetLayoutVersion(),
+      .scale = scale,
+  };
+}
+
+std::list<TextVertexCache::Entry>::iterator TextVertexCache::FindEntry(
+    const Key& key) {
+  auto found = entries_by_key_.find(key);
+  if (found == entries_by_key_.end()) {
+    return entries_.end();
+  }
+  auto entry = found->second;
+  if (entry->frame.expired() || entry->atlas.expired()) {
+    Erase(entry);
+    return entries_.end();
+  }
+  return entry;
+}
+
+void TextVertexCache::Erase(std::list<Entry>::iterator entry) {
+  cached_bytes_ -= entry->bytes;
+  entries_by_key_.erase(entry->key);
+  entries_.erase(entry);
+}
+
+std::optional<VertexBuffer> TextVertexCache::Find(
+    const std::shared_ptr<TextFrame>& frame,
+    const std::shared_ptr<GlyphAtlas>& atlas,
+    Scalar scale) {
+  if (!frame || !atlas) {
+    return std::nullopt;
+  }
+  auto entry = FindEntry(MakeKey(frame, atlas, scale));
+  if (entry == entries_.end()) {
+    return std::nullopt;
+  }
+  entries_.splice(entries_.begin(), entries_, entry);
+  return entry->vertex_buffer;
+}
+
+std::optional<VertexBuffer> TextVertexCache::Insert(
+    const std::shared_ptr<TextFrame>& frame,
+    const std::shared_ptr<GlyphAtlas>& atlas,
+    Scalar scale,
+    Allocator& allocator,
+    const uint8_t* vertices,
+    size_t bytes,
+    size_t vertex_count) {
+  if (!frame || !atlas || vertex_count == 0u || bytes > kMaxEntryBytes) {
+    return std::nullopt;
+  }
+
+  const auto key = MakeKey(frame, atlas, scale);
+  auto entry = FindEntry(key);
+  if (entry == entries_.end()) {
+    // Remember the frame, and cache its vertices if it is drawn again.
+    while (entries_.size() >= kMaxEntryCount) {
+      Erase(std::prev(entries_.end()));
+    }
+    entries_.push_front(Entry{
+        .key = key,
+        .frame = frame,
+        .atlas = atlas,
+    });
+    entries_by_key_[key] = entries_.begin();
+    return std::nullopt;
+  }
+  entries_.splice(entries_.begin(), entries_, entry);
+  if (entry->vertex_buffer.has_value()) {
+    return entry->vertex_buffer;
+  }
+
+  DeviceBufferDescriptor desc;
+  desc.storage_mode = StorageMode::kHostVisible;
+  desc.size = bytes;
+  auto buffer = allocator.CreateBuffer(desc);
+  if (!buffer || !buffer->CopyHostBuffer(vertices, Range{0u, bytes}, 0u)) {
+    return std::nullopt;
+  }
+  buffer->SetLabel("Cached Glyph Vertices");
+
+  // Make room for the vertices, never evicting the entry being filled in,
+  // which is the most recently used.
+  while (entries_.size() > 1u && cached_bytes_ + bytes > kMaxCacheBytes) {
+    Erase(std::prev(entries_.end()));
+  }
+
+  VertexBuffer vertex_buffer;
+  vertex_buffer.vertex_buffer = buffer->AsBufferView();
+  vertex_buffer.vertex_count = vertex_count;
+  vertex_buffer.index_type = IndexType::kNone;
+  entry->vertex_buffer = vertex_buffer;
+  entry->bytes = bytes;
+  cached_bytes_ += bytes;
+  return vertex_buffer;
+}
+
+void TextVertexCache::Clear() {
+  entries_by_key_.clear();
+  entries_.clear();
+  cached_bytes_ = 0u;
+}
+
+size_t TextVertexCache::GetEntryCount() const {
+  return entries_.size();
+}
+
+size_t TextVertexCache::GetCachedBytes() const {
+  return cached_bytes_;
+}
+
+}  // namespace impeller
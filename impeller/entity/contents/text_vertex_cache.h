@@ -0,0 +1,154 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/macros.h"
+#include "impeller/core/allocator.h"
+#include "impeller/core/vertex_buffer.h"
+#include "impeller/geometry/scalar.h"
+#include "impeller/typographer/glyph_atlas.h"
+#include "impeller/typographer/text_frame.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A least recently used cache of the glyph vertices of text
+///             frames, kept in device buffers so that text that doesn't change
+///             between frames is neither laid out nor uploaded again.
+///
+///             The vertices only refer to the text frame and the location of
+///             its glyphs in the atlas. The transform, offset and color of the
+///             text are uniforms. An entry is valid as long as the frame and
+///             atlas are alive and no glyphs were evicted from the atlas since
+///             it was created.
+///
+///             A frame is only cached the second time its vertices are
+///             inserted, so text that changes every frame doesn't allocate a
+///             device buffer each time.
+///
+/// @see        `GlyphAtlas::GetLayoutVersion`
+///
+class TextVertexCache {
+ public:
+  /// The most bytes of vertex data retained by the cache.
+  static constexpr size_t kMaxCacheBytes = 4u * 1024u * 1024u;
+
+  /// Frames whose vertices take more bytes than this aren't cached.
+  static constexpr size_t kMaxEntryBytes = 256u * 1024u;
+
+  /// The most frames tracked by the cache, including those that were only
+  /// seen once.
+  static constexpr size_t kMaxEntryCount = 1024u;
+
+  TextVertexCache();
+
+  ~TextVertexCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Find the vertices of a text frame drawn from an atlas at a
+  ///             scale and mark them as the most recently used.
+  ///
+  /// @return     The vertex buffer, or std::nullopt if it isn't cached.
+  ///
+  std::optional<VertexBuffer> Find(const std::shared_ptr<TextFrame>& frame,
+                                   const std::shared_ptr<GlyphAtlas>& atlas,
+                                   Scalar scale);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Copy the vertices of a text frame to a device buffer and cache
+  ///             them if the frame was inserted before, evicting the least
+  ///             recently used entries if the cache grows too large.
+  ///
+  /// @param[in]  frame         The text frame.
+  /// @param[in]  atlas         The atlas the glyphs are drawn from.
+  /// @param[in]  scale         The scale the frame was added to the atlas at.
+  /// @param[in]  allocator     The allocator to create the device buffer
+  ///                           with.
+  /// @param[in]  vertices      The vertex data.
+  /// @param[in]  bytes         The number of bytes of vertex data.
+  /// @param[in]  vertex_count  The number of vertices.
+  ///
+  /// @return     The vertex buffer of the cached vertices, or std::nullopt if
+  ///             the frame was seen for the first time, or the vertices are
+  ///             too large to cache or couldn't be copied.
+  ///
+  std::optional<VertexBuffer> Insert(const std::shared_ptr<TextFrame>& frame,
+                                     const std::shared_ptr<GlyphAtlas>& atlas,
+                                     Scalar scale,
+                                     Allocator& allocator,
+                                     const uint8_t* vertices,
+                                     size_t bytes,
+                                     size_t vertex_count);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drop all cached vertices, for example because the system is
+  ///             running low on memory.
+  ///
+  void Clear();
+
+  size_t GetEntryCount() const;
+
+  size_t GetCachedBytes() const;
+
+ private:
+  struct Key {
+    const TextFrame* frame = nullptr;
+    const GlyphAtlas* atlas = nullptr;
+    uint64_t layout_version = 0u;
+    Scalar scale = 1.0f;
+
+    struct Hash {
+      std::size_t operator()(const Key& key) const {
+        return fml::HashCombine(key.frame, key.atlas, key.layout_version,
+                                key.scale);
+      }
+    };
+
+    struct Equal {
+      bool operator()(const Key& lhs, const Key& rhs) const {
+        return lhs.frame == rhs.frame && lhs.atlas == rhs.atlas &&
+               lhs.layout_version == rhs.layout_version &&
+               lhs.scale == rhs.scale;
+      }
+    };
+  };
+
+  struct Entry {
+    Key key;
+    // Guard against a new frame or atlas being allocated at the address of
+    // one that was destroyed.
+    std::weak_ptr<TextFrame> frame;
+    std::weak_ptr<GlyphAtlas> atlas;
+    // Unset until the frame is inserted a second time.
+    std::optional<VertexBuffer> vertex_buffer;
+    size_t bytes = 0u;
+  };
+
+  std::list<Entry> entries_;
+  std::unordered_map<Key, std::list<Entry>::iterator, Key::Hash, Key::Equal>
+      entries_by_key_;
+  size_t cached_bytes_ = 0u;
+
+  static Key MakeKey(const std::shared_ptr<TextFrame>& frame,
+                     const std::shared_ptr<GlyphAtlas>& atlas,
+                     Scalar scale);
+
+  // Returns the live entry for |key|, removing it if its frame or atlas was
+  // destroyed.
+  std::list<Entry>::iterator FindEntry(const Key& key);
+
+  void Erase(std::list<Entry>::iterator entry);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TextVertexCache);
+};
+
+}  // namespace impeller
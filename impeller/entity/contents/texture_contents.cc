@@ -11,6 +11,7 @@
 #include "impeller/core/formats.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/geometry/geometry.h"
 #include "impeller/entity/texture_fill.frag.h"
 #include "impeller/entity/texture_fill.vert.h"
 #include "impeller/entity/texture_fill_external.frag.h"
@@ -189,6 +190,30 @@ bool TextureContents::Render(const ContentContext& renderer,
   return true;
 }
 
+bool TextureContents::IsAntialiasedWithoutMSAA(const Entity& entity) const {
+  return IsPixelAlignedRect(destination_rect_, entity.GetTransformation());
+}
+
+std::optional<Contents::BatchedQuad> TextureContents::AsBatchedQuad(
+    const Entity& entity) const {
+  if (destination_rect_.size.IsEmpty() || source_rect_.IsEmpty() ||
+      texture_ == nullptr || texture_->GetSize().IsEmpty() ||
+      texture_->GetTextureDescriptor().type ==
+          TextureType::kTextureExternalOES) {
+    return std::nullopt;
+  }
+  return BatchedQuad{
+      .rect = destination_rect_,
+      .texture = texture_,
+      // Matches the half texel expansion in `Render`.
+      .texture_coords =
+          Rect::MakeSize(texture_->GetSize()).Project(source_rect_.Expand(0.5)),
+      .sampler_descriptor = sampler_descriptor_,
+      .alpha = GetOpacity(),
+      .stencil_enabled = stencil_enabled_,
+  };
+}
+
 void TextureContents::SetSourceRect(const Rect& source_rect) {
   source_rect_ = source_rect;
 }
@@ -67,6 +67,12 @@ class TextureContents final : public Contents {
               const Entity& entity,
               RenderPass& pass) const override;
 
+  // |Contents|
+  std::optional<BatchedQuad> AsBatchedQuad(const Entity& entity) const override;
+
+  // |Contents|
+  bool IsAntialiasedWithoutMSAA(const Entity& entity) const override;
+
   // |Contents|
   bool CanInheritOpacity(const Entity& entity) const override;
 
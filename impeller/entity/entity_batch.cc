@@ -0,0 +1,259 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/entity_batch.h"
+
+#include "impeller/base/strings.h"
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/geometry/geometry.h"
+#include "impeller/entity/position_color.vert.h"
+#include "impeller/entity/texture_fill.frag.h"
+#include "impeller/entity/texture_fill.vert.h"
+#include "impeller/entity/vertices.frag.h"
+#include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/sampler_library.h"
+#include "impeller/renderer/vertex_buffer_builder.h"
+
+namespace impeller {
+
+// Each quad is drawn as two triangles of a triangle list.
+static constexpr size_t kQuadIndices[6] = {0, 1, 2, 1, 2, 3};
+
+EntityBatch::EntityBatch() = default;
+
+EntityBatch::~EntityBatch() = default;
+
+std::optional<Contents::BatchedQuad> EntityBatch::GetBatchedQuad(
+    const Entity& entity) {
+  if (!entity.GetContents() ||
+      entity.GetBlendMode() > Entity::kLastPipelineBlendMode ||
+      !entity.GetTransformation().IsAffine()) {
+    return std::nullopt;
+  }
+  return entity.GetContents()->AsBatchedQuad(entity);
+}
+
+bool EntityBatch::Append(const Entity& entity) {
+  auto quad = GetBatchedQuad(entity);
+  if (!quad.has_value() || !CanAppend(entity, quad.value())) {
+    return false;
+  }
+  entities_.push_back(entity);
+  quads_.push_back(std::move(quad.value()));
+  return true;
+}
+
+bool EntityBatch::AreCompatible(const Entity& entity,
+                                const Contents::BatchedQuad& quad,
+                                const Entity& other_entity,
+                                const Contents::BatchedQuad& other_quad) {
+  if (entity.GetBlendMode() != other_entity.GetBlendMode() ||
+      entity.GetStencilDepth() != other_entity.GetStencilDepth() ||
+      quad.texture != other_quad.texture) {
+    return false;
+  }
+  if (!quad.texture) {
+    return true;
+  }
+  return quad.alpha == other_quad.alpha &&
+         quad.stencil_enabled == other_quad.stencil_enabled &&
+         quad.sampler_descriptor.IsEqual(other_quad.sampler_descriptor);
+}
+
+bool EntityBatch::CanAppend(const Entity& entity,
+                            const Contents::BatchedQuad& quad) const {
+  if (entities_.empty()) {
+    return true;
+  }
+  return AreCompatible(entity, quad, entities_.front(), quads_.front());
+}
+
+bool EntityBatch::Flush(const ContentContext& renderer, RenderPass& pass) {
+  bool result = true;
+  if (entities_.size() == 1u) {
+    // Nothing to merge with, draw it as usual.
+    result = entities_.front().Render(renderer, pass);
+  } else if (!entities_.empty()) {
+    result = quads_.front().texture ? RenderTextureQuads(renderer, pass)
+                                    : RenderSolidColorQuads(renderer, pass);
+  }
+  entities_.clear();
+  quads_.clear();
+  return result;
+}
+
+bool EntityBatch::IsEmpty() const {
+  return entities_.empty();
+}
+
+size_t EntityBatch::GetEntityCount() const {
+  return entities_.size();
+}
+
+std::vector<size_t> EntityBatch::ComputeBatchingOrder(
+    const std::vector<const Entity*>& entities) {
+  struct OrderedEntity {
+    size_t index = 0u;
+    const Entity* entity = nullptr;
+    std::optional<Contents::BatchedQuad> quad;
+    std::optional<Rect> coverage;
+    bool is_barrier = false;
+  };
+
+  std::vector<OrderedEntity> ordered;
+  ordered.reserve(entities.size());
+  for (size_t i = 0; i < entities.size(); i++) {
+    OrderedEntity item{.index = i, .entity = entities[i]};
+    if (item.entity) {
+      item.quad = GetBatchedQuad(*item.entity);
+      item.coverage = item.entity->GetCoverage();
+      // Clips change which pixels the following entities may draw to, and
+      // advanced blends read back everything drawn before them.
+      item.is_barrier =
+          item.entity->GetBlendMode() > Entity::kLastPipelineBlendMode ||
+          item.entity->GetStencilCoverage(std::nullopt).type !=
+              Contents::StencilCoverage::Type::kNoChange;
+    } else {
+      item.is_barrier = true;
+    }
+
+    auto insert_at = ordered.size();
+    if (!item.is_barrier && item.quad.has_value() &&
+        item.coverage.has_value()) {
+      // Look for the last entity this one can be batched with. It may only be
+      // moved ahead of the entities in between if it doesn't overlap any of
+      // them.
+      for (size_t distance = 0; distance < kMaxReorderDistance &&
+                                distance < ordered.size();
+           distance++) {
+        const auto& other = ordered[ordered.size() - distance - 1];
+        if (other.quad.has_value() &&
+            AreCompatible(*item.entity, item.quad.value(), *other.entity,
+                          other.quad.value())) {
+          insert_at = ordered.size() - distance;
+          break;
+        }
+        if (other.is_barrier || !other.coverage.has_value() ||
+            other.coverage->IntersectsWithRect(item.coverage.value())) {
+          break;
+        }
+      }
+    }
+    ordered.insert(ordered.begin() + insert_at, std::move(item));
+  }
+
+  std::vector<size_t> order;
+  order.reserve(ordered.size());
+  for (const auto& item : ordered) {
+    order.push_back(item.index);
+  }
+  return order;
+}
+
+bool EntityBatch::RenderSolidColorQuads(const ContentContext& renderer,
+                                        RenderPass& pass) const {
+  using VS = GeometryColorPipeline::VertexShader;
+  using FS = GeometryColorPipeline::FragmentShader;
+
+  // Without multisampling, the edges are antialiased with coverage ramps like
+  // `SolidColorContents` does for single rects.
+  const bool antialias =
+      pass.GetRenderTarget().GetSampleCount() == SampleCount::kCount1 &&
+      entities_.front().GetBlendMode() == BlendMode::kSourceOver;
+
+  // The entity transforms are applied here so that entities with different
+  // transforms can share a command.
+  VertexBufferBuilder<VS::PerVertexData> vertex_builder;
+  vertex_builder.Reserve(quads_.size() *
+                         (antialias ? kAntialiasedQuadVertexCount : 6));
+  for (size_t i = 0; i < quads_.size(); i++) {
+    auto points =
+        quads_[i].rect.GetTransformedPoints(entities_[i].GetTransformation());
+    if (antialias) {
+      AppendAntialiasedQuadVertices(points, quads_[i].color, vertex_builder);
+      continue;
+    }
+    for (auto index : kQuadIndices) {
+      VS::PerVertexData data;
+      data.position = points[index];
+      data.color = quads_[i].color;
+      vertex_builder.AppendVertex(data);
+    }
+  }
+  if (vertex_builder.GetVertexCount() == 0u) {
+    return true;
+  }
+
+  auto& host_buffer = pass.GetTransientsBuffer();
+  const auto& first_entity = entities_.front();
+
+  Command cmd;
+  DEBUG_COMMAND_INFO(cmd, SPrintF("Batched Solid Fill (%zu)", quads_.size()));
+
+  auto options = OptionsFromPassAndEntity(pass, first_entity);
+  options.primitive_type = PrimitiveType::kTriangle;
+  cmd.pipeline = renderer.GetGeometryColorPipeline(options);
+  cmd.stencil_reference = first_entity.GetStencilDepth();
+  cmd.BindVertices(vertex_builder.CreateVertexBuffer(host_buffer));
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize());
+  VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+
+  FS::FragInfo frag_info;
+  frag_info.alpha = 1.0;
+  FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+
+  return pass.AddCommand(std::move(cmd));
+}
+
+bool EntityBatch::RenderTextureQuads(const ContentContext& renderer,
+                                     RenderPass& pass) const {
+  using VS = TextureFillVertexShader;
+  using FS = TextureFillFragmentShader;
+
+  VertexBufferBuilder<VS::PerVertexData> vertex_builder;
+  vertex_builder.Reserve(quads_.size() * 6);
+  for (size_t i = 0; i < quads_.size(); i++) {
+    auto points =
+        quads_[i].rect.GetTransformedPoints(entities_[i].GetTransformation());
+    auto texture_coords = quads_[i].texture_coords.GetPoints();
+    for (auto index : kQuadIndices) {
+      vertex_builder.AppendVertex({points[index], texture_coords[index]});
+    }
+  }
+
+  auto& host_buffer = pass.GetTransientsBuffer();
+  const auto& first_entity = entities_.front();
+  const auto& first_quad = quads_.front();
+
+  Command cmd;
+  DEBUG_COMMAND_INFO(cmd,
+                     SPrintF("Batched Texture Fill (%zu)", quads_.size()));
+
+  auto options = OptionsFromPassAndEntity(pass, first_entity);
+  if (!first_quad.stencil_enabled) {
+    options.stencil_compare = CompareFunction::kAlways;
+  }
+  options.primitive_type = PrimitiveType::kTriangle;
+  cmd.pipeline = renderer.GetTexturePipeline(options);
+  cmd.stencil_reference = first_entity.GetStencilDepth();
+  cmd.BindVertices(vertex_builder.CreateVertexBuffer(host_buffer));
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize());
+  frame_info.texture_sampler_y_coord_scale =
+      first_quad.texture->GetYCoordScale();
+  frame_info.alpha = first_quad.alpha;
+  VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+
+  FS::BindTextureSampler(
+      cmd, first_quad.texture,
+      renderer.GetContext()->GetSamplerLibrary()->GetSampler(
+          first_quad.sampler_descriptor));
+
+  return pass.AddCommand(std::move(cmd));
+}
+
+}  // namespace impeller
@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/entity/contents/contents.h"
+#include "impeller/entity/entity.h"
+
+namespace impeller {
+
+class ContentContext;
+class RenderPass;
+
+//------------------------------------------------------------------------------
+/// @brief      Accumulates consecutive entities that render as simple quads so
+///             that they can be drawn with a single command.
+///
+///             Entities are only ever batched with the entities immediately
+///             preceding them and their quads are drawn in the order they were
+///             appended. Primitives within a draw are blended in order, so
+///             overlapping entities blend exactly as if drawn one at a time.
+///
+/// @see        `Contents::AsBatchedQuad`
+///
+class EntityBatch {
+ public:
+  EntityBatch();
+
+  ~EntityBatch();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Add an entity to the batch.
+  ///
+  /// @return     Whether the entity was added. Entities that don't render as a
+  ///             quad, or that can't be drawn with the same command as the
+  ///             entities already in the batch, are rejected. The batch must
+  ///             be flushed before rejected entities are rendered.
+  ///
+  bool Append(const Entity& entity);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Render all the entities in the batch to the pass and empty
+  ///             the batch.
+  ///
+  bool Flush(const ContentContext& renderer, RenderPass& pass);
+
+  bool IsEmpty() const;
+
+  size_t GetEntityCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Compute an order to render a sequence of entities in that
+  ///             places entities which can be batched next to each other.
+  ///
+  ///             An entity is only ever moved ahead of entities that its
+  ///             coverage doesn't intersect, so the rendered result is the
+  ///             same as when rendering the entities in their original order.
+  ///             Entities are never moved past clips, advanced blends or
+  ///             barriers.
+  ///
+  /// @param[in]  entities  The entities in their original order. Null entries
+  ///                       are barriers, such as subpasses, that must render
+  ///                       in place.
+  ///
+  /// @return     The indices of the entities in the order to render them in.
+  ///
+  static std::vector<size_t> ComputeBatchingOrder(
+      const std::vector<const Entity*>& entities);
+
+ private:
+  /// How far back an entity may be moved to join a compatible entity.
+  static constexpr size_t kMaxReorderDistance = 32u;
+
+  std::vector<Entity> entities_;
+  std::vector<Contents::BatchedQuad> quads_;
+
+  static std::optional<Contents::BatchedQuad> GetBatchedQuad(
+      const Entity& entity);
+
+  static bool AreCompatible(const Entity& entity,
+                            const Contents::BatchedQuad& quad,
+                            const Entity& other_entity,
+                            const Contents::BatchedQuad& other_quad);
+
+  bool CanAppend(const Entity& entity,
+                 const Contents::BatchedQuad& quad) const;
+
+  bool RenderSolidColorQuads(const ContentContext& renderer,
+                             RenderPass& pass) const;
+
+  bool RenderTextureQuads(const ContentContext& renderer,
+                          RenderPass& pass) const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(EntityBatch);
+};
+
+}  // namespace impeller
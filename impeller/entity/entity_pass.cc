@@ -6,6 +6,7 @@
 
 #include "impeller/entity/entity_pass.h"
 
+#include <cmath>
 #include <memory>
 #include <utility>
 #include <variant>
@@ -13,6 +14,7 @@
 #include "flutter/fml/closure.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/metrics.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/strings.h"
 #include "impeller/base/validation.h"
@@ -22,10 +24,12 @@
 #include "impeller/entity/contents/clip_contents.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/filters/color_filter_contents.h"
+#include "impeller/entity/contents/filters/filter_snapshot_cache.h"
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
 #include "impeller/entity/contents/framebuffer_blend_contents.h"
 #include "impeller/entity/contents/texture_contents.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/entity_batch.h"
 #include "impeller/entity/inline_pass_context.h"
 #include "impeller/geometry/color.h"
 #include "impeller/geometry/path_builder.h"
@@ -64,10 +68,12 @@ void EntityPass::SetDelegate(std::shared_ptr<EntityPassDelegate> delegate) {
     return;
   }
   delegate_ = std::move(delegate);
+  InvalidateCoverage();
 }
 
 void EntityPass::SetBoundsLimit(std::optional<Rect> bounds_limit) {
   bounds_limit_ = bounds_limit;
+  InvalidateCoverage();
 }
 
 std::optional<Rect> EntityPass::GetBoundsLimit() const {
@@ -80,14 +86,18 @@ void EntityPass::AddEntity(Entity entity) {
     entity.SetBlendMode(BlendMode::kSource);
   }
 
-  if (entity.GetBlendMode() > Entity::kLastPipelineBlendMode) {
-    advanced_blend_reads_from_pass_texture_ += 1;
-  }
   elements_.emplace_back(std::move(entity));
+  InvalidateCoverage();
 }
 
 void EntityPass::SetElements(std::vector<Element> elements) {
   elements_ = std::move(elements);
+  for (auto& element : elements_) {
+    if (auto subpass = std::get_if<std::unique_ptr<EntityPass>>(&element)) {
+      subpass->get()->superpass_ = this;
+    }
+  }
+  InvalidateCoverage();
 }
 
 size_t EntityPass::GetSubpassesDepth() const {
@@ -101,23 +111,22 @@ size_t EntityPass::GetSubpassesDepth() const {
   return max_subpass_depth + 1u;
 }
 
-std::optional<Rect> EntityPass::GetElementsCoverage(
-    std::optional<Rect> coverage_limit) const {
-  std::optional<Rect> result;
+const std::vector<EntityPass::ElementCoverage>&
+EntityPass::GetElementCoverages() const {
+  if (element_coverages_.has_value()) {
+    return *element_coverages_;
+  }
+
+  std::vector<ElementCoverage> coverages;
+  coverages.reserve(elements_.size());
   for (const auto& element : elements_) {
-    std::optional<Rect> coverage;
+    ElementCoverage& element_coverage = coverages.emplace_back();
 
     if (auto entity = std::get_if<Entity>(&element)) {
-      coverage = entity->GetCoverage();
-
-      // When the coverage limit is std::nullopt, that means there is no limit,
-      // as opposed to empty coverage.
-      if (coverage.has_value() && coverage_limit.has_value()) {
-        const auto* filter = entity->GetContents()->AsFilter();
-        if (!filter || filter->IsTranslationOnly()) {
-          coverage = coverage->Intersection(coverage_limit.value());
-        }
-      }
+      element_coverage.coverage = entity->GetCoverage();
+      const auto* filter = entity->GetContents()->AsFilter();
+      element_coverage.intersects_limit =
+          !filter || filter->IsTranslationOnly();
     } else if (auto subpass_ptr =
                    std::get_if<std::unique_ptr<EntityPass>>(&element)) {
       auto& subpass = *subpass_ptr->get();
@@ -134,18 +143,42 @@ std::optional<Rect> EntityPass::GetElementsCoverage(
       if (image_filter) {
         Entity subpass_entity;
         subpass_entity.SetTransformation(subpass.xformation_);
-        coverage = image_filter->GetCoverage(subpass_entity);
+        element_coverage.coverage = image_filter->GetCoverage(subpass_entity);
       } else {
-        coverage = unfiltered_coverage;
-      }
-
-      if (coverage.has_value() && coverage_limit.has_value() &&
-          (!image_filter || image_filter->IsTranslationOnly())) {
-        coverage = coverage->Intersection(coverage_limit.value());
+        element_coverage.coverage = unfiltered_coverage;
       }
+      element_coverage.intersects_limit =
+          !image_filter || image_filter->IsTranslationOnly();
     } else {
       FML_UNREACHABLE();
     }
+  }
+
+  element_coverages_ = std::move(coverages);
+  return *element_coverages_;
+}
+
+void EntityPass::InvalidateCoverage() {
+  // A memoized superpass implies memoized subpasses, so the walk can stop at
+  // the first pass that has nothing memoized.
+  for (EntityPass* pass = this; pass && pass->element_coverages_.has_value();
+       pass = pass->superpass_) {
+    pass->element_coverages_.reset();
+  }
+}
+
+std::optional<Rect> EntityPass::GetElementsCoverage(
+    std::optional<Rect> coverage_limit) const {
+  std::optional<Rect> result;
+  for (const ElementCoverage& element_coverage : GetElementCoverages()) {
+    std::optional<Rect> coverage = element_coverage.coverage;
+
+    // When the coverage limit is std::nullopt, that means there is no limit,
+    // as opposed to empty coverage.
+    if (coverage.has_value() && coverage_limit.has_value() &&
+        element_coverage.intersects_limit) {
+      coverage = coverage->Intersection(coverage_limit.value());
+    }
 
     if (!result.has_value() && coverage.has_value()) {
       result = coverage;
@@ -197,15 +230,9 @@ EntityPass* EntityPass::AddSubpass(std::unique_ptr<EntityPass> pass) {
   FML_DCHECK(pass->superpass_ == nullptr);
   pass->superpass_ = this;
 
-  if (pass->backdrop_filter_proc_) {
-    backdrop_filter_reads_from_pass_texture_ += 1;
-  }
-  if (pass->blend_mode_ > Entity::kLastPipelineBlendMode) {
-    advanced_blend_reads_from_pass_texture_ += 1;
-  }
-
   auto subpass_pointer = pass.get();
   elements_.emplace_back(std::move(pass));
+  InvalidateCoverage();
   return subpass_pointer;
 }
 
@@ -215,14 +242,60 @@ void EntityPass::AddSubpassInline(std::unique_ptr<EntityPass> pass) {
   }
   FML_DCHECK(pass->superpass_ == nullptr);
 
+  for (auto& element : pass->elements_) {
+    if (auto subpass = std::get_if<std::unique_ptr<EntityPass>>(&element)) {
+      subpass->get()->superpass_ = this;
+    }
+  }
   elements_.insert(elements_.end(),
                    std::make_move_iterator(pass->elements_.begin()),
                    std::make_move_iterator(pass->elements_.end()));
+  InvalidateCoverage();
+}
+
+// The number of clips applied with a scissor that contain entities at the
+// given stencil depth, not counting the clips below the stencil depth floor of
+// the pass.
+static size_t CountScissorClips(
+    const EntityPass::StencilCoverageStack& stencil_coverage_stack,
+    size_t stencil_depth_floor,
+    size_t stencil_depth) {
+  size_t count = 0u;
+  for (size_t i = stencil_depth_floor + 1;
+       i <= stencil_depth && i < stencil_coverage_stack.size(); i++) {
+    if (stencil_coverage_stack[i].is_scissor) {
+      count++;
+    }
+  }
+  return count;
+}
 
-  backdrop_filter_reads_from_pass_texture_ +=
-      pass->backdrop_filter_reads_from_pass_texture_;
-  advanced_blend_reads_from_pass_texture_ +=
-      pass->advanced_blend_reads_from_pass_texture_;
+// The scissor of the current clip in the coordinates of the pass, if any of
+// the clips above the stencil depth floor are applied with a scissor. The
+// current coverage is the intersection of all clips, so it is exact for those
+// and conservative for the ones applied with the stencil.
+static std::optional<IRect> GetScissor(
+    const EntityPass::StencilCoverageStack& stencil_coverage_stack,
+    size_t stencil_depth_floor,
+    Point global_pass_position,
+    ISize target_size) {
+  if (CountScissorClips(stencil_coverage_stack, stencil_depth_floor,
+                        stencil_coverage_stack.size() - 1) == 0u) {
+    return std::nullopt;
+  }
+  auto coverage = stencil_coverage_stack.back().coverage;
+  if (!coverage.has_value()) {
+    // Everything is clipped.
+    return IRect();
+  }
+  auto rect = coverage->Shift(-global_pass_position);
+  auto scissor =
+      IRect::MakeLTRB(static_cast<int64_t>(std::floor(rect.GetLeft())),   //
+                      static_cast<int64_t>(std::floor(rect.GetTop())),    //
+                      static_cast<int64_t>(std::ceil(rect.GetRight())),   //
+                      static_cast<int64_t>(std::ceil(rect.GetBottom()))  //
+      );
+  return scissor.Intersection(IRect::MakeSize(target_size)).value_or(IRect());
 }
 
 static RenderTarget::AttachmentConfig GetDefaultStencilConfig(bool readable) {
@@ -237,7 +310,9 @@ static RenderTarget::AttachmentConfig GetDefaultStencilConfig(bool readable) {
 static EntityPassTarget CreateRenderTarget(ContentContext& renderer,
                                            ISize size,
                                            bool readable,
-                                           const Color& clear_color) {
+                                           const Color& clear_color,
+                                           bool msaa = true) {
+  FML_COUNTER_INCREMENT("impeller.entity_pass.offscreen_targets");
   auto context = renderer.GetContext();
 
   /// All of the load/store actions are managed by `InlinePassContext` when
@@ -246,7 +321,7 @@ static EntityPassTarget CreateRenderTarget(ContentContext& renderer,
   /// changed for the lifetime of the textures.
 
   RenderTarget target;
-  if (context->GetCapabilities()->SupportsOffscreenMSAA()) {
+  if (context->GetCapabilities()->SupportsOffscreenMSAA() && msaa) {
     target = RenderTarget::CreateOffscreenMSAA(
         *context,                          // context
         *renderer.GetRenderTargetCache(),  // allocator
@@ -280,11 +355,78 @@ static EntityPassTarget CreateRenderTarget(ContentContext& renderer,
       target, renderer.GetDeviceCapabilities().SupportsReadFromResolve());
 }
 
+bool EntityPass::IsAntialiasedWithoutMSAA(Point pass_position) const {
+  if (backdrop_filter_proc_) {
+    return false;
+  }
+  // Entities are rendered relative to the pass position.
+  const auto pass_transform = Matrix::MakeTranslation(Vector3(-pass_position));
+  for (const auto& element : elements_) {
+    if (const auto& entity = std::get_if<Entity>(&element)) {
+      if (entity->GetBlendMode() > Entity::kLastPipelineBlendMode ||
+          !entity->GetContents()) {
+        return false;
+      }
+      Entity pass_entity = *entity;
+      pass_entity.SetTransformation(pass_transform *
+                                    entity->GetTransformation());
+      if (!entity->GetContents()->IsAntialiasedWithoutMSAA(pass_entity)) {
+        return false;
+      }
+      continue;
+    }
+    if (const auto& subpass_ptr =
+            std::get_if<std::unique_ptr<EntityPass>>(&element)) {
+      auto subpass = subpass_ptr->get();
+      if (subpass->delegate_->CanElide()) {
+        continue;
+      }
+      // Collapsed subpasses draw their elements straight into this pass.
+      if (!subpass->delegate_->CanCollapseIntoParentPass(subpass) ||
+          !subpass->IsAntialiasedWithoutMSAA(pass_position)) {
+        return false;
+      }
+      continue;
+    }
+    FML_UNREACHABLE();
+  }
+  return true;
+}
+
 uint32_t EntityPass::GetTotalPassReads(ContentContext& renderer) const {
-  return renderer.GetDeviceCapabilities().SupportsFramebufferFetch()
-             ? backdrop_filter_reads_from_pass_texture_
-             : backdrop_filter_reads_from_pass_texture_ +
-                   advanced_blend_reads_from_pass_texture_;
+  // Advanced blends are applied in place if the device can read from the
+  // framebuffer.
+  const bool advanced_blends_read =
+      !renderer.GetDeviceCapabilities().SupportsFramebufferFetch();
+
+  uint32_t reads = 0u;
+  for (const auto& element : elements_) {
+    if (const auto& entity = std::get_if<Entity>(&element)) {
+      if (advanced_blends_read &&
+          entity->GetBlendMode() > Entity::kLastPipelineBlendMode) {
+        reads++;
+      }
+      continue;
+    }
+    if (const auto& subpass_ptr =
+            std::get_if<std::unique_ptr<EntityPass>>(&element)) {
+      const auto& subpass = *subpass_ptr->get();
+      // Elided subpasses are skipped before they can end the current pass.
+      if (subpass.delegate_->CanElide()) {
+        continue;
+      }
+      if (subpass.backdrop_filter_proc_) {
+        reads++;
+      }
+      if (advanced_blends_read &&
+          subpass.blend_mode_ > Entity::kLastPipelineBlendMode) {
+        reads++;
+      }
+      continue;
+    }
+    FML_UNREACHABLE();
+  }
+  return reads;
 }
 
 bool EntityPass::Render(ContentContext& renderer,
@@ -308,6 +450,7 @@ bool EntityPass::Render(ContentContext& renderer,
 
   fml::ScopedCleanupClosure reset_state([&renderer]() {
     renderer.GetLazyGlyphAtlas()->ResetTextFrames();
+    renderer.GetFilterSnapshotCache()->FinishFrame();
     renderer.GetRenderTargetCache()->End();
   });
 
@@ -374,6 +517,7 @@ bool EntityPass::Render(ContentContext& renderer,
     } else {
       auto render_pass = command_buffer->CreateRenderPass(root_render_target);
       render_pass->SetLabel("EntityPass Root Render Pass");
+      render_pass->SetTransientsBuffer(renderer.GetTransientsBuffer());
 
       {
         auto size_rect = Rect::MakeSize(
@@ -525,21 +669,6 @@ EntityPass::EntityResult EntityPass::GetEntityForElement(
       return EntityPass::EntityResult::Skip();
     }
 
-    std::shared_ptr<Contents> subpass_backdrop_filter_contents = nullptr;
-    if (subpass->backdrop_filter_proc_) {
-      auto texture = pass_context.GetTexture();
-      // Render the backdrop texture before any of the pass elements.
-      const auto& proc = subpass->backdrop_filter_proc_;
-      subpass_backdrop_filter_contents =
-          proc(FilterInput::Make(std::move(texture)),
-               subpass->xformation_.Basis(), Entity::RenderingMode::kSubpass);
-
-      // The subpass will need to read from the current pass texture when
-      // rendering the backdrop, so if there's an active pass, end it prior to
-      // rendering the subpass.
-      pass_context.EndPass();
-    }
-
     if (stencil_coverage_stack.empty()) {
       // The current clip is empty. This means the pass texture won't be
       // visible, so skip it.
@@ -572,7 +701,7 @@ EntityPass::EntityResult EntityPass::GetEntityForElement(
     }
 
     auto subpass_coverage =
-        (subpass->flood_clip_ || subpass_backdrop_filter_contents)
+        (subpass->flood_clip_ || subpass->backdrop_filter_proc_)
             ? coverage_limit
             : GetSubpassCoverage(*subpass, coverage_limit);
     if (!subpass_coverage.has_value()) {
@@ -586,11 +715,31 @@ EntityPass::EntityResult EntityPass::GetEntityForElement(
       return EntityPass::EntityResult::Skip();
     }
 
+    // Only end the active pass for backdrop reads once it's known that the
+    // subpass will be drawn. Skipped subpasses shouldn't split the parent
+    // pass, since every extra pass costs a full store and load of the target.
+    std::shared_ptr<Contents> subpass_backdrop_filter_contents = nullptr;
+    if (subpass->backdrop_filter_proc_) {
+      auto texture = pass_context.GetTexture();
+      // Render the backdrop texture before any of the pass elements.
+      const auto& proc = subpass->backdrop_filter_proc_;
+      subpass_backdrop_filter_contents =
+          proc(FilterInput::Make(std::move(texture)),
+               subpass->xformation_.Basis(), Entity::RenderingMode::kSubpass);
+
+      // The subpass will need to read from the current pass texture when
+      // rendering the backdrop, so if there's an active pass, end it prior to
+      // rendering the subpass.
+      pass_context.EndPass();
+    }
+
     auto subpass_target = CreateRenderTarget(
         renderer,                                  // renderer
         subpass_size,                              // size
         subpass->GetTotalPassReads(renderer) > 0,  // readable
-        subpass->GetClearColor(subpass_size));     // clear_color
+        subpass->GetClearColor(subpass_size),      // clear_color
+        !subpass->IsAntialiasedWithoutMSAA(subpass_coverage->origin)  // msaa
+    );
 
     if (!subpass_target.IsValid()) {
       VALIDATION_LOG << "Subpass render target is invalid.";
@@ -673,8 +822,10 @@ bool EntityPass::OnRender(
   TRACE_EVENT0("impeller", "EntityPass::OnRender");
 
   auto context = renderer.GetContext();
-  InlinePassContext pass_context(
-      context, pass_target, GetTotalPassReads(renderer), collapsed_parent_pass);
+  InlinePassContext pass_context(context, pass_target,
+                                 GetTotalPassReads(renderer),
+                                 renderer.GetTransientsBuffer(),
+                                 collapsed_parent_pass);
   if (!pass_context.IsValid()) {
     VALIDATION_LOG << SPrintF("Pass context invalid (Depth=%d)", pass_depth);
     return false;
@@ -687,9 +838,38 @@ bool EntityPass::OnRender(
     pass_context.GetRenderPass(pass_depth);
   }
 
+  // Consecutive entities that render as simple quads are accumulated here and
+  // drawn together. The batch must be flushed before anything else is drawn
+  // and before the active render pass ends.
+  EntityBatch batch;
+  // The scissor of the rect clips applied without the stencil, in the
+  // coordinates of the render target. Batched entities share the scissor, so
+  // the batch must be flushed before it changes.
+  std::optional<IRect> scissor =
+      GetScissor(stencil_coverage_stack, stencil_depth_floor,
+                 global_pass_position,
+                 pass_target.GetRenderTarget().GetRenderTargetSize());
+  auto flush_batch = [&batch, &pass_context, &pass_depth, &renderer,
+                      &scissor]() {
+    if (batch.IsEmpty()) {
+      return true;
+    }
+    auto result = pass_context.GetRenderPass(pass_depth);
+    if (!result.pass) {
+      return false;
+    }
+    result.pass->SetDefaultScissor(scissor);
+    if (!batch.Flush(renderer, *result.pass)) {
+      VALIDATION_LOG << "Failed to render batched entities.";
+      return false;
+    }
+    return true;
+  };
+
   auto render_element = [&stencil_depth_floor, &pass_context, &pass_depth,
                          &renderer, &stencil_coverage_stack,
-                         &global_pass_position](Entity& element_entity) {
+                         &global_pass_position, &batch, &flush_batch,
+                         &scissor](Entity& element_entity) {
     auto result = pass_context.GetRenderPass(pass_depth);
 
     if (!result.pass) {
@@ -705,6 +885,7 @@ bool EntityPass::OnRender(
     // Also, it's not possible to blit the non-MSAA resolve texture of the
     // previous pass to MSAA textures (let alone a transient one).
     if (result.backdrop_texture) {
+      result.pass->SetDefaultScissor(std::nullopt);
       auto size_rect = Rect::MakeSize(result.pass->GetRenderTargetSize());
       auto msaa_backdrop_contents = TextureContents::MakeRect(size_rect);
       msaa_backdrop_contents->SetStencilEnabled(false);
@@ -749,9 +930,17 @@ bool EntityPass::OnRender(
         break;
       case Contents::StencilCoverage::Type::kAppend: {
         auto op = stencil_coverage_stack.back().coverage;
+        const bool is_scissor =
+            static_cast<ClipContents*>(element_entity.GetContents().get())
+                ->GetScissorRect(element_entity)
+                .has_value();
+        if (is_scissor && !flush_batch()) {
+          return false;
+        }
         stencil_coverage_stack.push_back(StencilCoverageLayer{
             .coverage = stencil_coverage.coverage,
-            .stencil_depth = element_entity.GetStencilDepth() + 1});
+            .stencil_depth = element_entity.GetStencilDepth() + 1,
+            .is_scissor = is_scissor});
         FML_DCHECK(stencil_coverage_stack.back().stencil_depth ==
                    stencil_coverage_stack.size() - 1);
 
@@ -760,6 +949,14 @@ bool EntityPass::OnRender(
           // screen is already being clipped, so skip it.
           return true;
         }
+        if (is_scissor) {
+          // The clip coverage is exactly the clip, so the scissor derived
+          // from it replaces the stencil draw.
+          scissor = GetScissor(stencil_coverage_stack, stencil_depth_floor,
+                               global_pass_position,
+                               result.pass->GetRenderTargetSize());
+          return true;
+        }
       } break;
       case Contents::StencilCoverage::Type::kRestore: {
         if (stencil_coverage_stack.back().stencil_depth <=
@@ -781,12 +978,35 @@ bool EntityPass::OnRender(
           // Make the coverage rectangle relative to the current pass.
           restore_coverage->origin -= global_pass_position;
         }
+        // Restores that only pop scissor clips don't need to touch the
+        // stencil.
+        bool restores_stencil = false;
+        bool restores_scissor = false;
+        for (size_t i = restoration_depth + 1;
+             i < stencil_coverage_stack.size(); i++) {
+          if (stencil_coverage_stack[i].is_scissor) {
+            restores_scissor = true;
+          } else {
+            restores_stencil = true;
+          }
+        }
+        if (restores_scissor && !flush_batch()) {
+          return false;
+        }
         stencil_coverage_stack.resize(restoration_depth + 1);
+        if (restores_scissor) {
+          scissor = GetScissor(stencil_coverage_stack, stencil_depth_floor,
+                               global_pass_position,
+                               result.pass->GetRenderTargetSize());
+        }
 
         if (!stencil_coverage_stack.back().coverage.has_value()) {
           // Running this restore op won't make anything renderable, so skip it.
           return true;
         }
+        if (!restores_stencil) {
+          return true;
+        }
 
         auto restore_contents = static_cast<ClipRestoreContents*>(
             element_entity.GetContents().get());
@@ -806,8 +1026,20 @@ bool EntityPass::OnRender(
     }
 #endif
 
-    element_entity.SetStencilDepth(element_entity.GetStencilDepth() -
-                                   stencil_depth_floor);
+    element_entity.SetStencilDepth(
+        element_entity.GetStencilDepth() - stencil_depth_floor -
+        CountScissorClips(stencil_coverage_stack, stencil_depth_floor,
+                          element_entity.GetStencilDepth()));
+    result.pass->SetDefaultScissor(scissor);
+    if (batch.Append(element_entity)) {
+      return true;
+    }
+    if (!flush_batch()) {
+      return false;
+    }
+    if (batch.Append(element_entity)) {
+      return true;
+    }
     if (!element_entity.Render(renderer, *result.pass)) {
       VALIDATION_LOG << "Failed to render entity.";
       return false;
@@ -834,11 +1066,23 @@ bool EntityPass::OnRender(
     render_element(backdrop_entity);
   }
 
+  std::vector<size_t> element_order;
+  if (renderer.ShouldReorderEntitiesForBatching()) {
+    std::vector<const Entity*> entities;
+    entities.reserve(elements_.size());
+    for (const auto& element : elements_) {
+      entities.push_back(std::get_if<Entity>(&element));
+    }
+    element_order = EntityBatch::ComputeBatchingOrder(entities);
+  }
+
   bool is_collapsing_clear_colors = !collapsed_parent_pass &&
                                     // Backdrop filters act as a entity before
                                     // everything and disrupt the optimization.
                                     !backdrop_filter_proc_;
-  for (const auto& element : elements_) {
+  for (size_t i = 0; i < elements_.size(); i++) {
+    const auto& element =
+        elements_[element_order.empty() ? i : element_order[i]];
     // Skip elements that are incorporated into the clear color.
     if (is_collapsing_clear_colors) {
       auto [entity_color, _] =
@@ -849,6 +1093,12 @@ bool EntityPass::OnRender(
       is_collapsing_clear_colors = false;
     }
 
+    // Subpasses may end the active render pass or draw into it directly.
+    if (std::holds_alternative<std::unique_ptr<EntityPass>>(element) &&
+        !flush_batch()) {
+      return false;
+    }
+
     EntityResult result =
         GetEntityForElement(element,                 // element
                             renderer,                // renderer
@@ -876,6 +1126,9 @@ bool EntityPass::OnRender(
     ///
 
     if (result.entity.GetBlendMode() > Entity::kLastPipelineBlendMode) {
+      if (!flush_batch()) {
+        return false;
+      }
       if (renderer.GetDeviceCapabilities().SupportsFramebufferFetch()) {
         auto src_contents = result.entity.GetContents();
         auto contents = std::make_shared<FramebufferBlendContents>();
@@ -932,6 +1185,10 @@ bool EntityPass::OnRender(
     }
   }
 
+  if (!flush_batch()) {
+    return false;
+  }
+
 #ifdef IMPELLER_DEBUG
   //--------------------------------------------------------------------------
   /// Draw debug checkerboard over offscreen textures.
@@ -965,6 +1222,7 @@ void EntityPass::IterateAllElements(
   if (!iterator) {
     return;
   }
+  InvalidateCoverage();
 
   for (auto& element : elements_) {
     if (!iterator(element)) {
@@ -981,6 +1239,7 @@ void EntityPass::IterateAllEntities(
   if (!iterator) {
     return;
   }
+  InvalidateCoverage();
 
   for (auto& element : elements_) {
     if (auto entity = std::get_if<Entity>(&element)) {
@@ -1024,6 +1283,7 @@ bool EntityPass::IterateUntilSubpass(
   if (!iterator) {
     return true;
   }
+  InvalidateCoverage();
 
   for (auto& element : elements_) {
     if (auto entity = std::get_if<Entity>(&element)) {
@@ -1059,10 +1319,6 @@ std::unique_ptr<EntityPass> EntityPass::Clone() const {
 
   auto pass = std::make_unique<EntityPass>();
   pass->SetElements(std::move(new_elements));
-  pass->backdrop_filter_reads_from_pass_texture_ =
-      backdrop_filter_reads_from_pass_texture_;
-  pass->advanced_blend_reads_from_pass_texture_ =
-      advanced_blend_reads_from_pass_texture_;
   pass->backdrop_filter_proc_ = backdrop_filter_proc_;
   pass->blend_mode_ = blend_mode_;
   pass->delegate_ = delegate_;
@@ -1074,6 +1330,7 @@ std::unique_ptr<EntityPass> EntityPass::Clone() const {
 
 void EntityPass::SetTransformation(Matrix xformation) {
   xformation_ = xformation;
+  InvalidateCoverage();
 }
 
 void EntityPass::SetStencilDepth(size_t stencil_depth) {
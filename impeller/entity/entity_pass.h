@@ -46,6 +46,9 @@ class EntityPass {
   struct StencilCoverageLayer {
     std::optional<Rect> coverage;
     size_t stencil_depth;
+    /// Whether the clip of this layer is applied with a scissor instead of the
+    /// stencil. Entities inside of it don't increment the stencil depth.
+    bool is_scissor = false;
   };
 
   using StencilCoverageStack = std::vector<StencilCoverageLayer>;
@@ -148,10 +151,33 @@ class EntityPass {
       const EntityPass& subpass,
       std::optional<Rect> coverage_limit) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief  Get the coverage of the elements of this pass, intersected with
+  ///         the coverage limit where that is safe.
+  ///
+  ///         The coverage of each element is computed once and reused until
+  ///         this pass or one of its subpasses is modified, so repeated
+  ///         queries don't walk the subpasses again.
+  ///
   std::optional<Rect> GetElementsCoverage(
       std::optional<Rect> coverage_limit) const;
 
  private:
+  struct ElementCoverage {
+    std::optional<Rect> coverage;
+    /// Whether the coverage can be intersected with a coverage limit. Filters
+    /// that transform the basis of their input can't be.
+    bool intersects_limit = true;
+  };
+
+  /// @brief  Get the unlimited coverage of each element, computing it if it
+  ///         isn't memoized.
+  const std::vector<ElementCoverage>& GetElementCoverages() const;
+
+  /// @brief  Drop the memoized coverage of this pass and of its superpasses,
+  ///         whose coverage depends on it.
+  void InvalidateCoverage();
+
   struct EntityResult {
     enum Status {
       /// The entity was successfully resolved and can be rendered.
@@ -259,6 +285,10 @@ class EntityPass {
   /// evaluated and recorded to an `EntityPassTarget` by the `OnRender` method.
   std::vector<Element> elements_;
 
+  /// The memoized coverage of `elements_`, in the same order. Every method
+  /// that allows modifying the elements drops it.
+  mutable std::optional<std::vector<ElementCoverage>> element_coverages_;
+
   EntityPass* superpass_ = nullptr;
   Matrix xformation_;
   size_t stencil_depth_ = 0u;
@@ -267,19 +297,23 @@ class EntityPass {
   bool enable_offscreen_debug_checkerboard_ = false;
   std::optional<Rect> bounds_limit_;
 
-  /// These values are incremented whenever something is added to the pass that
-  /// requires reading from the backdrop texture. Currently, this can happen in
-  /// the following scenarios:
-  ///   1. An entity with an "advanced blend" is added to the pass.
-  ///   2. A subpass with a backdrop filter is added to the pass.
-  /// These are tracked as separate values because we may ignore
-  /// blend_reads_from_pass_texture_ if the device supports framebuffer based
-  /// advanced blends.
-  uint32_t advanced_blend_reads_from_pass_texture_ = 0;
-  uint32_t backdrop_filter_reads_from_pass_texture_ = 0;
-
+  /// The number of times rendering this pass requires reading from the pass
+  /// texture, each of which ends the active render pass. This happens for:
+  ///   1. Entities with an "advanced blend", unless the device supports
+  ///      framebuffer based advanced blends.
+  ///   2. Subpasses with a backdrop filter or an "advanced blend" (with the
+  ///      same exception), unless the subpass will be elided.
+  /// The stencil attachment only needs to be stored by render passes that
+  /// have more render passes following them.
   uint32_t GetTotalPassReads(ContentContext& renderer) const;
 
+  /// Whether everything this pass draws is antialiased just as well without
+  /// multisampling, so that its target may skip MSAA. Subpasses that aren't
+  /// collapsed into this pass are composited with their own edges, and
+  /// clips, advanced blends and backdrop filters always need MSAA.
+  /// `pass_position` is the position of this pass in the root pass.
+  bool IsAntialiasedWithoutMSAA(Point pass_position) const;
+
   BackdropFilterProc backdrop_filter_proc_ = nullptr;
 
   std::shared_ptr<EntityPassDelegate> delegate_ =
@@ -31,6 +31,7 @@ bool EntityPlayground::OpenPlaygroundHere(EntityPass& entity_pass) {
   }
 
   auto callback = [&](RenderTarget& render_target) -> bool {
+    content_context.ResetTransientsBuffer();
     return entity_pass.Render(content_context, render_target);
   };
   return Playground::OpenPlaygroundHere(callback);
@@ -46,6 +47,7 @@ bool EntityPlayground::OpenPlaygroundHere(Entity entity) {
     return false;
   }
   SinglePassCallback callback = [&](RenderPass& pass) -> bool {
+    content_context.ResetTransientsBuffer();
     return entity.Render(content_context, pass);
   };
   return Playground::OpenPlaygroundHere(callback);
@@ -66,6 +68,7 @@ bool EntityPlayground::OpenPlaygroundHere(EntityPlaygroundCallback callback) {
       wireframe = !wireframe;
       content_context.SetWireframe(wireframe);
     }
+    content_context.ResetTransientsBuffer();
     return callback(content_context, pass);
   };
   return Playground::OpenPlaygroundHere(pass_callback);
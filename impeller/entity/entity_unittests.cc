@@ -3,9 +3,11 @@
 // found in the LICENSE file.
 
 #include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <memory>
 #include <optional>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -19,8 +21,11 @@
 #include "impeller/entity/contents/contents.h"
 #include "impeller/entity/contents/filters/blend_filter_contents.h"
 #include "impeller/entity/contents/filters/color_filter_contents.h"
+#include "impeller/entity/contents/filters/color_matrix_filter_contents.h"
 #include "impeller/entity/contents/filters/filter_contents.h"
+#include "impeller/entity/contents/filters/gaussian_blur_filter_contents.h"
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
+#include "impeller/entity/contents/gradient_texture_cache.h"
 #include "impeller/entity/contents/linear_gradient_contents.h"
 #include "impeller/entity/contents/radial_gradient_contents.h"
 #include "impeller/entity/contents/runtime_effect_contents.h"
@@ -28,10 +33,12 @@
 #include "impeller/entity/contents/solid_rrect_blur_contents.h"
 #include "impeller/entity/contents/sweep_gradient_contents.h"
 #include "impeller/entity/contents/text_contents.h"
+#include "impeller/entity/contents/text_vertex_cache.h"
 #include "impeller/entity/contents/texture_contents.h"
 #include "impeller/entity/contents/tiled_texture_contents.h"
 #include "impeller/entity/contents/vertices_contents.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/entity_batch.h"
 #include "impeller/entity/entity_pass.h"
 #include "impeller/entity/entity_pass_delegate.h"
 #include "impeller/entity/entity_playground.h"
@@ -194,6 +201,37 @@ TEST_P(EntityTest, EntityPassCoverageRespectsCoverageLimit) {
   }
 }
 
+TEST_P(EntityTest, EntityPassCoverageIsUpdatedWhenSubpassesChange) {
+  EntityPass pass;
+  auto* subpass = pass.AddSubpass(
+      CreatePassWithRectPath(Rect::MakeLTRB(0, 0, 100, 100), std::nullopt));
+  auto* nested_subpass = subpass->AddSubpass(CreatePassWithRectPath(
+      Rect::MakeLTRB(50, 50, 200, 200), std::nullopt));
+
+  auto coverage = pass.GetElementsCoverage(std::nullopt);
+  ASSERT_TRUE(coverage.has_value());
+  ASSERT_RECT_NEAR(coverage.value(), Rect::MakeLTRB(0, 0, 200, 200));
+
+  Entity entity;
+  entity.SetContents(SolidColorContents::Make(
+      PathBuilder{}.AddRect(Rect::MakeLTRB(300, 300, 400, 400)).TakePath(),
+      Color::Red()));
+  nested_subpass->AddEntity(entity);
+
+  coverage = pass.GetElementsCoverage(std::nullopt);
+  ASSERT_TRUE(coverage.has_value());
+  ASSERT_RECT_NEAR(coverage.value(), Rect::MakeLTRB(0, 0, 400, 400));
+
+  nested_subpass->SetBoundsLimit(Rect::MakeLTRB(0, 0, 150, 150));
+  coverage = pass.GetElementsCoverage(Rect::MakeLTRB(0, 0, 120, 120));
+  ASSERT_TRUE(coverage.has_value());
+  ASSERT_RECT_NEAR(coverage.value(), Rect::MakeLTRB(0, 0, 120, 120));
+
+  coverage = pass.GetElementsCoverage(std::nullopt);
+  ASSERT_TRUE(coverage.has_value());
+  ASSERT_RECT_NEAR(coverage.value(), Rect::MakeLTRB(0, 0, 150, 150));
+}
+
 TEST_P(EntityTest, FilterCoverageRespectsCropRect) {
   auto image = CreateTextureForFixture("boston.jpg");
   auto filter = ColorFilterContents::MakeBlend(BlendMode::kSoftLight,
@@ -1240,6 +1278,25 @@ TEST_P(EntityTest, MorphologyFilter) {
   ASSERT_TRUE(OpenPlaygroundHere(callback));
 }
 
+TEST_P(EntityTest, MorphologyFilterSkipsRadiusUnderOnePixel) {
+  auto boston = CreateTextureForFixture("boston.jpg");
+  auto filter = FilterContents::MakeDirectionalMorphology(
+      FilterInput::Make(boston), Radius{2}, Point(1, 0),
+      FilterContents::MorphType::kDilate);
+  ContentContext renderer(GetContext(), TypographerContextSkia::Make());
+  ASSERT_TRUE(renderer.IsValid());
+
+  // Scaled down, the radius rounds to no pixels and the input is passed
+  // through without rendering.
+  Entity entity;
+  entity.SetTransformation(Matrix::MakeScale(Vector2{0.2, 0.2}));
+  auto result = filter->GetEntity(renderer, entity, std::nullopt);
+  ASSERT_TRUE(result.has_value());
+  auto texture_contents =
+      std::static_pointer_cast<TextureContents>(result->GetContents());
+  ASSERT_EQ(texture_contents->GetTexture(), boston);
+}
+
 TEST_P(EntityTest, SetBlendMode) {
   Entity entity;
   ASSERT_EQ(entity.GetBlendMode(), BlendMode::kSourceOver);
@@ -1306,6 +1363,25 @@ TEST_P(EntityTest, SolidStrokeCoverageIsCorrect) {
   }
 }
 
+TEST_P(EntityTest, GaussianBlurDownsamplesLargeRadii) {
+  using Blur = DirectionalGaussianBlurFilterContents;
+  ASSERT_EQ(Blur::ComputeDownsampleLevels(0), 0);
+  ASSERT_EQ(Blur::ComputeDownsampleLevels(31), 0);
+  ASSERT_EQ(Blur::ComputeDownsampleLevels(32), 1);
+  ASSERT_EQ(Blur::ComputeDownsampleLevels(64), 2);
+  ASSERT_EQ(Blur::ComputeDownsampleLevels(100), 2);
+  ASSERT_EQ(Blur::ComputeDownsampleLevels(128), 3);
+  ASSERT_EQ(Blur::ComputeDownsampleLevels(1000), Blur::kMaxDownsampleLevels);
+
+  // Downsampling never takes fewer samples than a blur of the minimum radius.
+  for (Scalar radius = 1; radius < 2000; radius += 7) {
+    auto levels = Blur::ComputeDownsampleLevels(radius);
+    if (levels > 0) {
+      ASSERT_GE(radius / (1 << levels), Blur::kMinDownsampledRadius);
+    }
+  }
+}
+
 TEST_P(EntityTest, BorderMaskBlurCoverageIsCorrect) {
   auto fill = std::make_shared<SolidColorContents>();
   fill->SetGeometry(Geometry::MakeFillPath(
@@ -1688,6 +1764,59 @@ TEST_P(EntityTest, ClipContentsGetStencilCoverageIsCorrect) {
   }
 }
 
+TEST_P(EntityTest, ClipContentsScissorRectIsCorrect) {
+  auto make_clip = [](Rect rect, Entity::ClipOperation clip_op) {
+    auto clip = std::make_shared<ClipContents>();
+    clip->SetClipOperation(clip_op);
+    clip->SetGeometry(Geometry::MakeRect(rect));
+    return clip;
+  };
+
+  // Pixel aligned rects under translate and scale transforms.
+  {
+    auto clip = make_clip(Rect::MakeLTRB(5, 5, 25, 30),
+                          Entity::ClipOperation::kIntersect);
+    Entity entity;
+    entity.SetTransformation(Matrix::MakeTranslation({10, 20}) *
+                             Matrix::MakeScale({2, 2, 1}));
+    auto scissor = clip->GetScissorRect(entity);
+    ASSERT_TRUE(scissor.has_value());
+    ASSERT_RECT_NEAR(scissor.value(), Rect::MakeLTRB(20, 30, 60, 80));
+  }
+
+  // Rects with partially covered pixels.
+  {
+    auto clip = make_clip(Rect::MakeLTRB(0.5, 0, 10, 10),
+                          Entity::ClipOperation::kIntersect);
+    ASSERT_FALSE(clip->GetScissorRect(Entity{}).has_value());
+  }
+
+  // Rotated rects.
+  {
+    auto clip = make_clip(Rect::MakeLTRB(0, 0, 10, 10),
+                          Entity::ClipOperation::kIntersect);
+    Entity entity;
+    entity.SetTransformation(Matrix::MakeRotationZ(Degrees(45)));
+    ASSERT_FALSE(clip->GetScissorRect(entity).has_value());
+  }
+
+  // Difference clips.
+  {
+    auto clip = make_clip(Rect::MakeLTRB(0, 0, 10, 10),
+                          Entity::ClipOperation::kDifference);
+    ASSERT_FALSE(clip->GetScissorRect(Entity{}).has_value());
+  }
+
+  // Paths that aren't known to be rects.
+  {
+    auto clip = std::make_shared<ClipContents>();
+    clip->SetClipOperation(Entity::ClipOperation::kIntersect);
+    clip->SetGeometry(Geometry::MakeFillPath(
+        PathBuilder{}.AddRect(Rect::MakeLTRB(0, 0, 10, 10)).TakePath()));
+    ASSERT_FALSE(clip->GetScissorRect(Entity{}).has_value());
+  }
+}
+
 TEST_P(EntityTest, RRectShadowTest) {
   auto callback = [&](ContentContext& context, RenderPass& pass) {
     static Color color = Color::Red();
@@ -1767,6 +1896,51 @@ TEST_P(EntityTest, ColorMatrixFilterCoverageIsCorrect) {
   ASSERT_RECT_NEAR(actual.value(), expected);
 }
 
+TEST_P(EntityTest, NestedColorMatrixFiltersAreComposed) {
+  auto fill = std::make_shared<SolidColorContents>();
+  fill->SetGeometry(Geometry::MakeFillPath(
+      PathBuilder{}.AddRect(Rect::MakeXYWH(0, 0, 300, 400)).TakePath()));
+  fill->SetColor(Color::Coral());
+  auto input = FilterInput::Make(fill);
+
+  // Halves the color, which never needs clamping.
+  ColorMatrix halve = {
+      0.5, 0, 0, 0, 0,  //
+      0, 0.5, 0, 0, 0,  //
+      0, 0, 0.5, 0, 0,  //
+      0, 0, 0, 1, 0,    //
+  };
+  ColorMatrix swap_and_offset = {
+      0, 1, 0, 0, 0.25,  //
+      1, 0, 0, 0, 0,     //
+      0, 0, 1, 0, 0,     //
+      0, 0, 0, 1, 0,     //
+  };
+  auto inner = ColorFilterContents::MakeColorMatrix(
+      input, halve, ColorFilterContents::AbsorbOpacity::kYes);
+  std::shared_ptr<Contents> inner_contents = inner;
+  auto outer = ColorFilterContents::MakeColorMatrix(
+      FilterInput::Make(inner_contents), swap_and_offset);
+
+  const auto* composed = outer->AsColorMatrixFilter();
+  ASSERT_NE(composed, nullptr);
+  ASSERT_EQ(composed->GetInputs().size(), 1u);
+  ASSERT_EQ(composed->GetInputs()[0], input);
+  ASSERT_EQ(composed->GetAbsorbOpacity(),
+            ColorFilterContents::AbsorbOpacity::kYes);
+  auto color = Color(0.2, 0.4, 0.6, 0.8);
+  auto expected =
+      color.ApplyColorMatrix(halve).ApplyColorMatrix(swap_and_offset);
+  ASSERT_COLOR_NEAR(color.ApplyColorMatrix(composed->GetMatrix()), expected);
+
+  // The result of the swap needs clamping, so it isn't composed.
+  std::shared_ptr<FilterContents> outer_filter = outer;
+  auto clamped = ColorFilterContents::MakeColorMatrix(
+      FilterInput::Make(outer_filter), halve);
+  ASSERT_EQ(clamped->AsColorMatrixFilter()->GetInputs().size(), 1u);
+  ASSERT_NE(clamped->AsColorMatrixFilter()->GetInputs()[0], input);
+}
+
 TEST_P(EntityTest, ColorMatrixFilterEditable) {
   auto bay_bridge = CreateTextureForFixture("bay_bridge.jpg");
   ASSERT_TRUE(bay_bridge);
@@ -2309,6 +2483,96 @@ TEST_P(EntityTest, SolidColorContentsIsOpaque) {
   ASSERT_FALSE(contents.IsOpaque());
 }
 
+TEST_P(EntityTest, SolidColorRectsAreAntialiasedWithoutMSAA) {
+  SolidColorContents contents;
+  contents.SetColor(Color::CornflowerBlue());
+  contents.SetGeometry(Geometry::MakeRect(Rect::MakeXYWH(10.5, 10, 20, 20)));
+
+  Entity entity;
+  entity.SetTransformation(Matrix::MakeRotationZ(Degrees(30)));
+  ASSERT_TRUE(contents.IsAntialiasedWithoutMSAA(entity));
+
+  // Coverage can't be applied to the source for other blend modes, so only
+  // rects on pixel boundaries are left.
+  entity.SetBlendMode(BlendMode::kSource);
+  ASSERT_FALSE(contents.IsAntialiasedWithoutMSAA(entity));
+  entity.SetTransformation(Matrix::MakeTranslation({0.5, 0}));
+  ASSERT_TRUE(contents.IsAntialiasedWithoutMSAA(entity));
+
+  // Other geometry still needs multisampling.
+  contents.SetGeometry(Geometry::MakeFillPath(
+      PathBuilder{}.AddCircle({20, 20}, 10).TakePath()));
+  entity.SetBlendMode(BlendMode::kSourceOver);
+  ASSERT_FALSE(contents.IsAntialiasedWithoutMSAA(entity));
+}
+
+TEST_P(EntityTest, EntityBatchOnlyAcceptsCompatibleQuads) {
+  auto make_solid_entity = [](std::shared_ptr<Geometry> geometry,
+                              BlendMode blend_mode) {
+    auto contents = std::make_shared<SolidColorContents>();
+    contents->SetGeometry(std::move(geometry));
+    contents->SetColor(Color::CornflowerBlue());
+    Entity entity;
+    entity.SetContents(std::move(contents));
+    entity.SetBlendMode(blend_mode);
+    return entity;
+  };
+  std::shared_ptr<Geometry> rect = Geometry::MakeRect({100, 100, 100, 100});
+
+  EntityBatch batch;
+  ASSERT_TRUE(batch.Append(make_solid_entity(rect, BlendMode::kSourceOver)));
+  ASSERT_TRUE(batch.Append(make_solid_entity(rect, BlendMode::kSourceOver)));
+  ASSERT_FALSE(batch.Append(make_solid_entity(rect, BlendMode::kPlus)));
+  auto circle = PathBuilder{}.AddCircle({100, 100}, 50).TakePath();
+  ASSERT_FALSE(batch.Append(make_solid_entity(Geometry::MakeFillPath(circle),
+                                              BlendMode::kSourceOver)));
+  ASSERT_FALSE(batch.Append(make_solid_entity(rect, BlendMode::kMultiply)));
+
+  auto texture_contents =
+      TextureContents::MakeRect(Rect::MakeXYWH(100, 100, 100, 100));
+  texture_contents->SetTexture(CreateTextureForFixture("boston.jpg"));
+  texture_contents->SetSourceRect(Rect::MakeXYWH(0, 0, 100, 100));
+  Entity texture_entity;
+  texture_entity.SetContents(std::move(texture_contents));
+  ASSERT_FALSE(batch.Append(texture_entity));
+
+  ASSERT_EQ(batch.GetEntityCount(), 2u);
+}
+
+TEST_P(EntityTest, EntityBatchingOrderOnlyMovesEntitiesPastDisjointOnes) {
+  auto make_solid_entity = [](Rect rect) {
+    auto contents = std::make_shared<SolidColorContents>();
+    contents->SetGeometry(Geometry::MakeRect(rect));
+    contents->SetColor(Color::CornflowerBlue());
+    Entity entity;
+    entity.SetContents(std::move(contents));
+    return entity;
+  };
+  auto make_texture_entity = [this](Rect rect) {
+    auto contents = TextureContents::MakeRect(rect);
+    contents->SetTexture(CreateTextureForFixture("boston.jpg"));
+    contents->SetSourceRect(Rect::MakeXYWH(0, 0, 100, 100));
+    Entity entity;
+    entity.SetContents(std::move(contents));
+    return entity;
+  };
+
+  auto first = make_solid_entity(Rect::MakeXYWH(0, 0, 100, 100));
+  auto image = make_texture_entity(Rect::MakeXYWH(200, 0, 100, 100));
+  auto disjoint = make_solid_entity(Rect::MakeXYWH(0, 200, 100, 100));
+  auto overlapping = make_solid_entity(Rect::MakeXYWH(250, 50, 100, 100));
+
+  // The second solid entity is moved next to the first one.
+  ASSERT_EQ(EntityBatch::ComputeBatchingOrder({&first, &image, &disjoint}),
+            (std::vector<size_t>{0, 2, 1}));
+  // It must not be drawn before the image it overlaps.
+  ASSERT_EQ(EntityBatch::ComputeBatchingOrder({&first, &image, &overlapping}),
+            (std::vector<size_t>{0, 1, 2}));
+  // Nor can it be moved past a barrier.
+  ASSERT_EQ(EntityBatch::ComputeBatchingOrder({&first, nullptr, &disjoint}),
+            (std::vector<size_t>{0, 1, 2}));
+}
+
 TEST_P(EntityTest, ConicalGradientContentsIsOpaque) {
   ConicalGradientContents contents;
   contents.SetColors({Color::CornflowerBlue()});
@@ -2350,6 +2614,37 @@ TEST_P(EntityTest, SweepGradientContentsIsOpaque) {
   ASSERT_FALSE(contents.IsOpaque());
 }
 
+TEST_P(EntityTest, GradientTextureCacheReusesTextures) {
+  GradientTextureCache cache;
+  std::vector<Color> colors = {Color::Red(), Color::Green(), Color::Blue()};
+  std::vector<Scalar> stops = {0.0, 0.2, 1.0};
+  auto texture = cache.GetTexture(colors, stops, GetContext());
+  ASSERT_TRUE(texture);
+  ASSERT_EQ(cache.GetTexture(colors, stops, GetContext()), texture);
+  ASSERT_EQ(cache.GetEntryCount(), 1u);
+
+  // Different colors or stops are different entries.
+  auto other_stops = cache.GetTexture(colors, {0.0, 0.5, 1.0}, GetContext());
+  ASSERT_TRUE(other_stops);
+  ASSERT_NE(other_stops, texture);
+  colors[1] = Color::White();
+  auto other_colors = cache.GetTexture(colors, stops, GetContext());
+  ASSERT_TRUE(other_colors);
+  ASSERT_NE(other_colors, texture);
+  ASSERT_EQ(cache.GetEntryCount(), 3u);
+
+  // The least recently used entries are evicted first.
+  for (auto i = 0u; i < GradientTextureCache::kMaxEntryCount; i++) {
+    cache.GetTexture(colors, {0.0, (i + 1.0f) / 1000.0f, 1.0}, GetContext());
+    cache.GetTexture(colors, stops, GetContext());
+  }
+  ASSERT_EQ(cache.GetEntryCount(), GradientTextureCache::kMaxEntryCount);
+  ASSERT_EQ(cache.GetTexture(colors, stops, GetContext()), other_colors);
+  ASSERT_NE(cache.GetTexture({Color::Red(), Color::Green(), Color::Blue()},
+                             stops, GetContext()),
+            texture);
+}
+
 TEST_P(EntityTest, TiledTextureContentsIsOpaque) {
   auto bay_bridge = CreateTextureForFixture("bay_bridge.jpg");
   TiledTextureContents contents;
@@ -2441,6 +2736,137 @@ TEST_P(EntityTest, TextContentsCeilsGlyphScaleToDecimal) {
   ASSERT_EQ(TextFrame::RoundScaledFontSize(0.0f, 12), 0.0f);
 }
 
+TEST_P(EntityTest, TextVertexCacheKeepsVerticesOfFramesDrawnTwice) {
+  SkFont font;
+  font.setSize(30);
+  auto frame =
+      MakeTextFrameFromTextBlobSkia(SkTextBlob::MakeFromString("AB", font));
+  auto atlas = std::make_shared<GlyphAtlas>(GlyphAtlas::Type::kAlphaBitmap);
+  auto& allocator = *GetContext()->GetResourceAllocator();
+  std::vector<uint8_t> vertices(96u, 7u);
+
+  TextVertexCache cache;
+  auto insert = [&](const std::shared_ptr<GlyphAtlas>& glyph_atlas,
+                    Scalar scale) {
+    return cache.Insert(frame, glyph_atlas, scale, allocator, vertices.data(),
+                        vertices.size(), 12u);
+  };
+  ASSERT_FALSE(cache.Find(frame, atlas, 1.0f).has_value());
+
+  // The first time a frame is drawn, its vertices aren't kept.
+  ASSERT_FALSE(insert(atlas, 1.0f).has_value());
+  ASSERT_FALSE(cache.Find(frame, atlas, 1.0f).has_value());
+  ASSERT_EQ(cache.GetCachedBytes(), 0u);
+
+  auto inserted = insert(atlas, 1.0f);
+  ASSERT_TRUE(inserted.has_value());
+  ASSERT_EQ(inserted->vertex_count, 12u);
+  ASSERT_EQ(inserted->vertex_buffer.range.length, vertices.size());
+  ASSERT_EQ(cache.GetCachedBytes(), vertices.size());
+  auto found = cache.Find(frame, atlas, 1.0f);
+  ASSERT_TRUE(found.has_value());
+  ASSERT_EQ(found->vertex_buffer.buffer, inserted->vertex_buffer.buffer);
+
+  // Other scales and atlases are different entries.
+  ASSERT_FALSE(cache.Find(frame, atlas, 2.0f).has_value());
+  auto other_atlas =
+      std::make_shared<GlyphAtlas>(GlyphAtlas::Type::kAlphaBitmap);
+  ASSERT_FALSE(cache.Find(frame, other_atlas, 1.0f).has_value());
+  ASSERT_FALSE(insert(other_atlas, 1.0f).has_value());
+  ASSERT_EQ(cache.GetEntryCount(), 2u);
+  ASSERT_EQ(cache.GetCachedBytes(), vertices.size());
+}
+
+TEST_P(EntityTest, ContentContextWarmsUpBlendModeVariants) {
+  ContentContext content_context(GetContext(), TypographerContextSkia::Make());
+  ASSERT_TRUE(content_context.IsValid());
+
+  // A few variants are compiled at a time, until none are left.
+  size_t frame_count = 0u;
+  while (content_context.WarmUpNextPipelineVariants()) {
+    ASSERT_LT(++frame_count, 10000u);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  ContentContextOptions opts{
+      .sample_count = SampleCount::kCount4,
+      .color_attachment_pixel_format =
+          GetContext()->GetCapabilities()->GetDefaultColorFormat()};
+  for (int i = 0; i <= static_cast<int>(Entity::kLastPipelineBlendMode); i++) {
+    opts.blend_mode = static_cast<BlendMode>(i);
+    ASSERT_NE(content_context.GetSolidFillPipeline(opts), nullptr);
+    ASSERT_NE(content_context.GetTexturePipeline(opts), nullptr);
+  }
+}
+
+TEST_P(EntityTest, ContentContextCachesRuntimeEffectPipelines) {
+  ContentContext content_context(GetContext(), TypographerContextSkia::Make());
+  ASSERT_TRUE(content_context.IsValid());
+
+  ContentContextOptions opts;
+  auto pipeline = content_context.GetSolidFillPipeline(opts);
+  ASSERT_NE(pipeline, nullptr);
+
+  size_t create_count = 0u;
+  auto create_callback = [&]() {
+    create_count++;
+    return pipeline;
+  };
+  ASSERT_EQ(content_context.GetCachedRuntimeEffectPipeline("effect", opts,
+                                                           create_callback),
+            pipeline);
+  ASSERT_EQ(content_context.GetCachedRuntimeEffectPipeline("effect", opts,
+                                                           create_callback),
+            pipeline);
+  ASSERT_EQ(create_count, 1u);
+
+  // Other options and entrypoints are cached separately.
+  ContentContextOptions other_opts{.blend_mode = BlendMode::kSource};
+  content_context.GetCachedRuntimeEffectPipeline("effect", other_opts,
+                                                 create_callback);
+  content_context.GetCachedRuntimeEffectPipeline("other", opts,
+                                                 create_callback);
+  ASSERT_EQ(create_count, 3u);
+
+  // Cleared pipelines are created again.
+  content_context.ClearCachedRuntimeEffectPipeline("effect");
+  content_context.GetCachedRuntimeEffectPipeline("effect", opts,
+                                                 create_callback);
+  content_context.GetCachedRuntimeEffectPipeline("other", opts,
+                                                 create_callback);
+  ASSERT_EQ(create_count, 4u);
+}
+
+TEST_P(EntityTest, ContentContextOptionsKeyRoundTrips) {
+  ContentContextOptions defaults;
+  auto parsed = ContentContextOptions::FromKey(defaults.ToKey());
+  ASSERT_TRUE(parsed.has_value());
+  ASSERT_TRUE(ContentContextOptions::Equal{}(parsed.value(), defaults));
+
+  ContentContextOptions opts{
+      .sample_count = SampleCount::kCount4,
+      .blend_mode = BlendMode::kLuminosity,
+      .stencil_compare = CompareFunction::kGreaterEqual,
+      .stencil_operation = StencilOperation::kDecrementWrap,
+      .primitive_type = PrimitiveType::kTriangleStrip,
+      .color_attachment_pixel_format = PixelFormat::kB10G10R10A10XR,
+      .has_stencil_attachment = false,
+      .wireframe = true,
+  };
+  ASSERT_NE(opts.ToKey(), defaults.ToKey());
+  parsed = ContentContextOptions::FromKey(opts.ToKey());
+  ASSERT_TRUE(parsed.has_value());
+  ASSERT_TRUE(ContentContextOptions::Equal{}(parsed.value(), opts));
+
+  // Out of range fields are rejected.
+  ASSERT_FALSE(ContentContextOptions::FromKey(0u).has_value());
+  ASSERT_FALSE(ContentContextOptions::FromKey(defaults.ToKey() | (0xffu << 8))
+                   .has_value());
+  ASSERT_FALSE(
+      ContentContextOptions::FromKey(defaults.ToKey() | (uint64_t{2u} << 56))
+          .has_value());
+}
+
 }  // namespace testing
 }  // namespace impeller
 
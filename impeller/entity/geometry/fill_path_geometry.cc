@@ -4,6 +4,14 @@
 
 #include "impeller/entity/geometry/fill_path_geometry.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include "impeller/entity/geometry/tessellation_cache.h"
+#include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/compute_command.h"
+#include "impeller/tessellator/tessellator.h"
+
 namespace impeller {
 
 FillPathGeometry::FillPathGeometry(const Path& path,
@@ -16,13 +24,53 @@ GeometryResult FillPathGeometry::GetPositionBuffer(
     const ContentContext& renderer,
     const Entity& entity,
     RenderPass& pass) {
+  auto make_result = [&pass, &entity](const VertexBuffer& vertex_buffer) {
+    return GeometryResult{
+        .type = PrimitiveType::kTriangle,
+        .vertex_buffer = vertex_buffer,
+        .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                     entity.GetTransformation(),
+        .prevent_overdraw = false,
+    };
+  };
+
+  auto scale = entity.GetTransformation().GetMaxBasisLength();
+  const auto& cache = renderer.GetTessellationCache();
+  std::optional<TessellationCache::Key> cache_key;
+  if (path_.GetGenerationID() != 0u) {
+    scale = TessellationCache::QuantizeScale(scale);
+    cache_key = TessellationCache::Key{
+        .generation_id = path_.GetGenerationID(),
+        .fill_type = path_.GetFillType(),
+        .scale = scale,
+    };
+    if (auto cached = cache->Find(cache_key.value()); cached.has_value()) {
+      return make_result(cached.value());
+    }
+  }
+
+  if (auto result = GetPositionBufferGPU(renderer, entity, pass);
+      result.has_value()) {
+    return result.value();
+  }
+
   auto& host_buffer = pass.GetTransientsBuffer();
+  auto& allocator = *renderer.GetContext()->GetResourceAllocator();
   VertexBuffer vertex_buffer;
 
   if (path_.GetFillType() == FillType::kNonZero &&  //
       path_.IsConvex()) {
     auto [points, indices] = TessellateConvex(
-        path_.CreatePolyline(entity.GetTransformation().GetMaxBasisLength()));
+        renderer.GetTessellator()->CreateTempPolyline(path_, scale));
+
+    if (cache_key.has_value()) {
+      if (auto cached =
+              cache->Insert(cache_key.value(), allocator, points.data(),
+                            points.size(), indices.data(), indices.size());
+          cached.has_value()) {
+        return make_result(cached.value());
+      }
+    }
 
     vertex_buffer.vertex_buffer = host_buffer.Emplace(
         points.data(), points.size() * sizeof(Point), alignof(Point));
@@ -31,21 +79,26 @@ GeometryResult FillPathGeometry::GetPositionBuffer(
     vertex_buffer.vertex_count = indices.size();
     vertex_buffer.index_type = IndexType::k16bit;
 
-    return GeometryResult{
-        .type = PrimitiveType::kTriangle,
-        .vertex_buffer = vertex_buffer,
-        .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
-                     entity.GetTransformation(),
-        .prevent_overdraw = false,
-    };
+    return make_result(vertex_buffer);
   }
 
-  auto tesselation_result = renderer.GetTessellator()->Tessellate(
-      path_.GetFillType(),
-      path_.CreatePolyline(entity.GetTransformation().GetMaxBasisLength()),
-      [&vertex_buffer, &host_buffer](
+  const auto& tessellator = renderer.GetTessellator();
+  auto tesselation_result = tessellator->Tessellate(
+      path_.GetFillType(), tessellator->CreateTempPolyline(path_, scale),
+      [&vertex_buffer, &host_buffer, &cache, &cache_key, &allocator](
           const float* vertices, size_t vertices_count, const uint16_t* indices,
           size_t indices_count) {
+        if (cache_key.has_value()) {
+          static_assert(sizeof(Point) == 2 * sizeof(float));
+          if (auto cached = cache->Insert(
+                  cache_key.value(), allocator,
+                  reinterpret_cast<const Point*>(vertices), vertices_count / 2,
+                  indices, indices_count);
+              cached.has_value()) {
+            vertex_buffer = cached.value();
+            return true;
+          }
+        }
         vertex_buffer.vertex_buffer = host_buffer.Emplace(
             vertices, vertices_count * sizeof(float), alignof(float));
         vertex_buffer.index_buffer = host_buffer.Emplace(
@@ -57,13 +110,7 @@ GeometryResult FillPathGeometry::GetPositionBuffer(
   if (tesselation_result != Tessellator::Result::kSuccess) {
     return {};
   }
-  return GeometryResult{
-      .type = PrimitiveType::kTriangle,
-      .vertex_buffer = vertex_buffer,
-      .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
-                   entity.GetTransformation(),
-      .prevent_overdraw = false,
-  };
+  return make_result(vertex_buffer);
 }
 
 // |Geometry|
@@ -75,10 +122,17 @@ GeometryResult FillPathGeometry::GetPositionUVBuffer(
     RenderPass& pass) {
   using VS = TextureFillVertexShader;
 
+  if (auto result = GetPositionBufferGPU(renderer, entity, pass,
+                                         texture_coverage, effect_transform);
+      result.has_value()) {
+    return result.value();
+  }
+
   if (path_.GetFillType() == FillType::kNonZero &&  //
       path_.IsConvex()) {
-    auto [points, indices] = TessellateConvex(
-        path_.CreatePolyline(entity.GetTransformation().GetMaxBasisLength()));
+    auto [points, indices] =
+        TessellateConvex(renderer.GetTessellator()->CreateTempPolyline(
+            path_, entity.GetTransformation().GetMaxBasisLength()));
 
     VertexBufferBuilder<VS::PerVertexData> vertex_builder;
     vertex_builder.Reserve(points.size());
@@ -106,9 +160,11 @@ GeometryResult FillPathGeometry::GetPositionUVBuffer(
   }
 
   VertexBufferBuilder<VS::PerVertexData> vertex_builder;
-  auto tesselation_result = renderer.GetTessellator()->Tessellate(
+  const auto& tessellator = renderer.GetTessellator();
+  auto tesselation_result = tessellator->Tessellate(
       path_.GetFillType(),
-      path_.CreatePolyline(entity.GetTransformation().GetMaxBasisLength()),
+      tessellator->CreateTempPolyline(
+          path_, entity.GetTransformation().GetMaxBasisLength()),
       [&vertex_builder, &texture_coverage, &effect_transform](
           const float* vertices, size_t vertices_count, const uint16_t* indices,
           size_t indices_count) {
@@ -140,6 +196,314 @@ GeometryResult FillPathGeometry::GetPositionUVBuffer(
   };
 }
 
+std::optional<GeometryResult> FillPathGeometry::GetPositionBufferGPU(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass,
+    std::optional<Rect> texture_coverage,
+    std::optional<Matrix> effect_transform) const {
+  if (!renderer.GetDeviceCapabilities().SupportsCompute()) {
+    return std::nullopt;
+  }
+  // Every curve is triangulated as a fan from the start of the path. That is
+  // only correct for a single convex contour. Everything else is left to the
+  // CPU tessellator.
+  if (path_.GetFillType() != FillType::kNonZero || !path_.IsConvex() ||
+      path_.GetComponentCount(Path::ComponentType::kContour) > 1) {
+    return std::nullopt;
+  }
+
+  struct CurveRange {
+    uint32_t first_triangle;
+    uint32_t segment_count;
+  };
+
+  auto scale = entity.GetTransformation().GetMaxBasisLength();
+  auto component_count = path_.GetComponentCount();
+  std::vector<Point> curve_points;
+  curve_points.reserve(component_count * 4);
+  std::vector<CurveRange> curve_ranges;
+  curve_ranges.reserve(component_count);
+  uint32_t segment_count = 0;
+
+  auto append_curve = [&](const CubicPathComponent& cubic,
+                          size_t subdivisions) {
+    curve_points.push_back(cubic.p1);
+    curve_points.push_back(cubic.cp1);
+    curve_points.push_back(cubic.cp2);
+    curve_points.push_back(cubic.p2);
+    curve_ranges.push_back(
+        {segment_count, static_cast<uint32_t>(subdivisions)});
+    segment_count += subdivisions;
+  };
+  path_.EnumerateComponents(
+      [&](size_t index, const LinearPathComponent& linear) {
+        append_curve({linear.p1, linear.p1, linear.p2, linear.p2}, 1);
+      },
+      [&](size_t index, const QuadraticPathComponent& quad) {
+        append_curve(quad, ComputeCurveSubdivisions(scale, quad));
+      },
+      [&](size_t index, const CubicPathComponent& cubic) {
+        append_curve(cubic, ComputeCurveSubdivisions(scale, cubic));
+      },
+      [](size_t index, const ContourComponent& contour) {});
+
+  if (segment_count < kMinGPUSegmentCount) {
+    return std::nullopt;
+  }
+
+  auto total = segment_count * 3;
+  auto curve_count = curve_ranges.size();
+
+  auto cmd_buffer = renderer.GetContext()->CreateCommandBuffer();
+  auto compute_pass = cmd_buffer->CreateComputePass();
+  auto& host_buffer = compute_pass->GetTransientsBuffer();
+
+  auto curve_data = host_buffer.Emplace(curve_points.data(),
+                                        curve_points.size() * sizeof(Point),
+                                        DefaultUniformAlignment());
+  auto curve_range_data = host_buffer.Emplace(
+      curve_ranges.data(), curve_ranges.size() * sizeof(CurveRange),
+      DefaultUniformAlignment());
+
+  DeviceBufferDescriptor buffer_desc;
+  buffer_desc.size = total * sizeof(Point);
+  buffer_desc.storage_mode = StorageMode::kDevicePrivate;
+
+  auto geometry_buffer = renderer.GetContext()
+                             ->GetResourceAllocator()
+                             ->CreateBuffer(buffer_desc)
+                             ->AsBufferView();
+
+  BufferView output;
+  {
+    using CS = ConvexFillComputeShader;
+    ComputeCommand cmd;
+    DEBUG_COMMAND_INFO(cmd, "Convex Fill Geometry");
+    cmd.pipeline = renderer.GetConvexFillComputePipeline();
+
+    CS::FrameInfo frame_info;
+    frame_info.anchor = curve_points.front();
+    frame_info.count = curve_count;
+
+    CS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+    CS::BindCurveData(cmd, curve_data);
+    CS::BindCurveRanges(cmd, curve_range_data);
+    CS::BindGeometryData(cmd, geometry_buffer);
+
+    if (!compute_pass->AddCommand(std::move(cmd))) {
+      return GeometryResult{};
+    }
+    output = geometry_buffer;
+  }
+
+  if (texture_coverage.has_value() && effect_transform.has_value()) {
+    DeviceBufferDescriptor buffer_desc;
+    buffer_desc.size = total * sizeof(Vector4);
+    buffer_desc.storage_mode = StorageMode::kDevicePrivate;
+
+    auto geometry_uv_buffer = renderer.GetContext()
+                                  ->GetResourceAllocator()
+                                  ->CreateBuffer(buffer_desc)
+                                  ->AsBufferView();
+
+    using UV = UvComputeShader;
+
+    ComputeCommand cmd;
+    DEBUG_COMMAND_INFO(cmd, "UV Geometry");
+    cmd.pipeline = renderer.GetUvComputePipeline();
+
+    UV::FrameInfo frame_info;
+    frame_info.count = total;
+    frame_info.effect_transform = effect_transform.value();
+    frame_info.texture_origin = texture_coverage->origin;
+    frame_info.texture_size = Vector2(texture_coverage->size);
+
+    UV::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+    UV::BindGeometryData(cmd, geometry_buffer);
+    UV::BindGeometryUVData(cmd, geometry_uv_buffer);
+
+    if (!compute_pass->AddCommand(std::move(cmd))) {
+      return GeometryResult{};
+    }
+    output = geometry_uv_buffer;
+  }
+
+  // There are always more vertices than curves. The fill shader ignores the
+  // excess invocations.
+  compute_pass->SetGridSize(ISize(total, 1));
+  compute_pass->SetThreadGroupSize(ISize(total, 1));
+
+  if (!compute_pass->EncodeCommands() || !cmd_buffer->SubmitCommands()) {
+    return GeometryResult{};
+  }
+
+  return GeometryResult{
+      .type = PrimitiveType::kTriangle,
+      .vertex_buffer = {.vertex_buffer = output,
+                        .vertex_count = total,
+                        .index_type = IndexType::kNone},
+      .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                   entity.GetTransformation(),
+      .prevent_overdraw = false,
+  };
+}
+
+static size_t ClampCurveSubdivisions(Scalar subdivisions) {
+  if (!std::isfinite(subdivisions)) {
+    return 1;
+  }
+  return std::clamp<size_t>(std::ceil(subdivisions), 1,
+                            FillPathGeometry::kMaxCurveSubdivisions);
+}
+
+size_t FillPathGeometry::ComputeCurveSubdivisions(
+    Scalar scale_factor,
+    const QuadraticPathComponent& quad) {
+  // Wang's formula for a degree 2 curve: sqrt(2 * 1 / 8 * |dd| / tolerance).
+  auto tolerance = kDefaultCurveTolerance / scale_factor;
+  auto dd = (quad.p1 - quad.cp * 2 + quad.p2).GetLength();
+  return ClampCurveSubdivisions(std::sqrt(0.25f * dd / tolerance));
+}
+
+size_t FillPathGeometry::ComputeCurveSubdivisions(
+    Scalar scale_factor,
+    const CubicPathComponent& cubic) {
+  // Wang's formula for a degree 3 curve: sqrt(3 * 2 / 8 * |dd| / tolerance),
+  // where |dd| is the largest second difference of the control points.
+  auto tolerance = kDefaultCurveTolerance / scale_factor;
+  auto dd = std::max((cubic.p1 - cubic.cp1 * 2 + cubic.cp2).GetLength(),
+                     (cubic.cp1 - cubic.cp2 * 2 + cubic.p2).GetLength());
+  return ClampCurveSubdivisions(std::sqrt(0.75f * dd / tolerance));
+}
+
+void FillPathGeometry::CreateStencilFans(const Path::Polyline& polyline,
+                                         std::vector<Point>& positive,
+                                         std::vector<Point>& negative) {
+  for (size_t i = 0; i < polyline.contours.size(); i++) {
+    auto [start, end] = polyline.GetContourPointBounds(i);
+    if (end - start < 3) {
+      continue;
+    }
+    const Point& origin = polyline.points[start];
+    for (size_t j = start + 1; j + 1 < end; j++) {
+      const Point& a = polyline.points[j];
+      const Point& b = polyline.points[j + 1];
+      auto winding = (a - origin).Cross(b - origin);
+      if (winding == 0) {
+        continue;
+      }
+      auto& triangles = winding > 0 ? positive : negative;
+      triangles.push_back(origin);
+      triangles.push_back(a);
+      triangles.push_back(b);
+    }
+  }
+}
+
+// |Geometry|
+std::optional<GeometryResult> FillPathGeometry::GetStencilCoverBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) {
+  // Clips are stored in the stencil, so it can only be used to fill the path
+  // when no clip is active.
+  if (entity.GetStencilDepth() != 0u ||
+      !pass.GetRenderTarget().GetStencilAttachment().has_value()) {
+    return std::nullopt;
+  }
+  // Convex paths are cheap to triangulate.
+  if (path_.GetFillType() == FillType::kNonZero && path_.IsConvex()) {
+    return std::nullopt;
+  }
+
+  auto scale = entity.GetTransformation().GetMaxBasisLength();
+  if (path_.GetGenerationID() != 0u) {
+    scale = TessellationCache::QuantizeScale(scale);
+    // A cached tessellation is cheaper to draw than the stencil and cover.
+    auto cache_key = TessellationCache::Key{
+        .generation_id = path_.GetGenerationID(),
+        .fill_type = path_.GetFillType(),
+        .scale = scale,
+    };
+    if (renderer.GetTessellationCache()->Find(cache_key).has_value()) {
+      return std::nullopt;
+    }
+  }
+
+  const auto& polyline =
+      renderer.GetTessellator()->CreateTempPolyline(path_, scale);
+  if (polyline.points.size() < kMinStencilCoverPointCount) {
+    return std::nullopt;
+  }
+  auto bounds =
+      Rect::MakePointBounds(polyline.points.begin(), polyline.points.end());
+  if (!bounds.has_value()) {
+    return std::nullopt;
+  }
+
+  std::vector<Point> positive;
+  std::vector<Point> negative;
+  CreateStencilFans(polyline, positive, negative);
+
+  using VS = ClipPipeline::VertexShader;
+
+  auto& host_buffer = pass.GetTransientsBuffer();
+  auto mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+             entity.GetTransformation();
+  VS::FrameInfo info;
+  info.mvp = mvp;
+  auto frame_info = host_buffer.EmplaceUniform(info);
+
+  auto options = OptionsFromPass(pass);
+  options.blend_mode = BlendMode::kDestination;
+  options.stencil_compare = CompareFunction::kAlways;
+  options.primitive_type = PrimitiveType::kTriangle;
+
+  auto add_stencil_command = [&](const std::vector<Point>& triangles,
+                                 StencilOperation operation) {
+    if (triangles.empty()) {
+      return;
+    }
+    Command cmd;
+    DEBUG_COMMAND_INFO(cmd, "Stencil Path Fill");
+    cmd.stencil_reference = entity.GetStencilDepth();
+    options.stencil_operation = operation;
+    cmd.pipeline = renderer.GetClipPipeline(options);
+    cmd.BindVertices(VertexBuffer{
+        .vertex_buffer = host_buffer.Emplace(triangles.data(),
+                                             triangles.size() * sizeof(Point),
+                                             alignof(Point)),
+        .vertex_count = triangles.size(),
+        .index_type = IndexType::kNone,
+    });
+    VS::BindFrameInfo(cmd, frame_info);
+    pass.AddCommand(std::move(cmd));
+  };
+
+  if (path_.GetFillType() == FillType::kOdd) {
+    positive.insert(positive.end(), negative.begin(), negative.end());
+    add_stencil_command(positive, StencilOperation::kInvert);
+  } else {
+    add_stencil_command(positive, StencilOperation::kIncrementWrap);
+    add_stencil_command(negative, StencilOperation::kDecrementWrap);
+  }
+
+  auto cover = bounds->GetPoints();
+  return GeometryResult{
+      .type = PrimitiveType::kTriangleStrip,
+      .vertex_buffer =
+          VertexBuffer{
+              .vertex_buffer = host_buffer.Emplace(
+                  cover.data(), cover.size() * sizeof(Point), alignof(Point)),
+              .vertex_count = cover.size(),
+              .index_type = IndexType::kNone,
+          },
+      .transform = mvp,
+      .prevent_overdraw = false,
+  };
+}
+
 GeometryVertexType FillPathGeometry::GetVertexType() const {
   return GeometryVertexType::kPosition;
 }
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <optional>
+#include <vector>
 
 #include "impeller/entity/geometry/geometry.h"
 #include "impeller/geometry/rect.h"
@@ -19,6 +20,42 @@ class FillPathGeometry : public Geometry {
 
   ~FillPathGeometry();
 
+  /// The largest number of line segments a single curve is divided into when
+  /// it is tessellated on the GPU.
+  static constexpr size_t kMaxCurveSubdivisions = 1024;
+
+  /// Paths that flatten to fewer line segments than this are tessellated on
+  /// the CPU even when compute is available. Below this threshold the cost of
+  /// submitting the compute pass outweighs the CPU tessellation.
+  static constexpr size_t kMinGPUSegmentCount = 256;
+
+  /// Non-convex paths that flatten to at least this many points are filled
+  /// through the stencil instead of being tessellated on the CPU, when the
+  /// stencil isn't used for clipping.
+  static constexpr size_t kMinStencilCoverPointCount = 512;
+
+  /// @brief Split the polyline into triangle fans around the first point of
+  ///        each contour, whose windings add up to the winding of the path.
+  ///
+  ///        Counterclockwise triangles are added to `positive`, and clockwise
+  ///        ones to `negative`. Degenerate triangles are dropped.
+  static void CreateStencilFans(const Path::Polyline& polyline,
+                                std::vector<Point>& positive,
+                                std::vector<Point>& negative);
+
+  /// @brief Compute the number of line segments to divide a curve into when
+  ///        tessellating it on the GPU. This uses Wang's formula, which only
+  ///        depends on the control points and can be evaluated without
+  ///        flattening the curve.
+  ///
+  /// @return the number of line segments.
+  static size_t ComputeCurveSubdivisions(Scalar scale_factor,
+                                         const QuadraticPathComponent& quad);
+
+  /// @copydoc ComputeCurveSubdivisions
+  static size_t ComputeCurveSubdivisions(Scalar scale_factor,
+                                         const CubicPathComponent& cubic);
+
   // |Geometry|
   bool CoversArea(const Matrix& transform, const Rect& rect) const override;
 
@@ -28,6 +65,12 @@ class FillPathGeometry : public Geometry {
                                    const Entity& entity,
                                    RenderPass& pass) override;
 
+  // |Geometry|
+  std::optional<GeometryResult> GetStencilCoverBuffer(
+      const ContentContext& renderer,
+      const Entity& entity,
+      RenderPass& pass) override;
+
   // |Geometry|
   GeometryVertexType GetVertexType() const override;
 
@@ -41,6 +84,18 @@ class FillPathGeometry : public Geometry {
                                      const Entity& entity,
                                      RenderPass& pass) override;
 
+  /// @brief Flatten and triangulate the path in a compute pass.
+  ///
+  /// @return std::nullopt if the device doesn't support compute or if the path
+  ///         can't (or shouldn't) be tessellated on the GPU. Callers fall back
+  ///         to CPU tessellation in that case.
+  std::optional<GeometryResult> GetPositionBufferGPU(
+      const ContentContext& renderer,
+      const Entity& entity,
+      RenderPass& pass,
+      std::optional<Rect> texture_coverage = std::nullopt,
+      std::optional<Matrix> effect_transform = std::nullopt) const;
+
   Path path_;
   std::optional<Rect> inner_rect_;
 
@@ -4,6 +4,8 @@
 
 #include "impeller/entity/geometry/geometry.h"
 
+#include <algorithm>
+#include <cmath>
 #include <optional>
 
 #include "impeller/entity/geometry/cover_geometry.h"
@@ -17,7 +19,7 @@ namespace impeller {
 
 /// Given a convex polyline, create a triangle fan structure.
 std::pair<std::vector<Point>, std::vector<uint16_t>> TessellateConvex(
-    Path::Polyline polyline) {
+    const Path::Polyline& polyline) {
   std::vector<Point> output;
   std::vector<uint16_t> indices;
 
@@ -46,6 +48,67 @@ std::pair<std::vector<Point>, std::vector<uint16_t>> TessellateConvex(
   return std::make_pair(output, indices);
 }
 
+bool IsPixelAlignedRect(const Rect& rect, const Matrix& transform) {
+  if (!transform.IsTranslationScaleOnly()) {
+    return false;
+  }
+  for (auto value : rect.TransformBounds(transform).GetLTRB()) {
+    if (std::abs(value - std::round(value)) > kEhCloseEnough) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void AppendAntialiasedQuadVertices(
+    const std::array<Point, 4>& points,
+    const Color& color,
+    VertexBufferBuilder<GeometryColorPipeline::VertexShader::PerVertexData>&
+        vertex_builder) {
+  // The quad is made of the points `points[0] + u * s + v * t` for s and t in
+  // [0, 1].
+  const auto u = points[1] - points[0];
+  const auto v = points[2] - points[0];
+  const auto area = std::abs(u.Cross(v));
+  if (area < kEhCloseEnough) {
+    return;
+  }
+  // Half a pixel across the edges along v and u, in terms of s and t.
+  const auto ds = 0.5f * v.GetLength() / area;
+  const auto dt = 0.5f * u.GetLength() / area;
+  // Quads thinner than a pixel shrink to their center line, where their
+  // coverage is their width.
+  const auto inset_s = std::min(ds, 0.5f);
+  const auto inset_t = std::min(dt, 0.5f);
+  const auto coverage = std::min(0.5f / ds, 1.0f) * std::min(0.5f / dt, 1.0f);
+
+  const auto point_at = [&](Scalar s, Scalar t) {
+    return points[0] + u * s + v * t;
+  };
+  const std::array<Point, 4> outer = {
+      point_at(-ds, -dt), point_at(1 + ds, -dt),  //
+      point_at(-ds, 1 + dt), point_at(1 + ds, 1 + dt)};
+  const std::array<Point, 4> inner = {
+      point_at(inset_s, inset_t), point_at(1 - inset_s, inset_t),  //
+      point_at(inset_s, 1 - inset_t), point_at(1 - inset_s, 1 - inset_t)};
+  const auto inner_color = color * coverage;
+  const auto outer_color = Color::BlackTransparent();
+
+  for (auto index : {0, 1, 2, 1, 2, 3}) {
+    vertex_builder.AppendVertex({inner[index], inner_color});
+  }
+  // The ramps around the edges, in order around the quad.
+  static constexpr size_t kEdges[4][2] = {{0, 1}, {1, 3}, {3, 2}, {2, 0}};
+  for (const auto& [a, b] : kEdges) {
+    vertex_builder.AppendVertex({outer[a], outer_color});
+    vertex_builder.AppendVertex({outer[b], outer_color});
+    vertex_builder.AppendVertex({inner[a], inner_color});
+    vertex_builder.AppendVertex({outer[b], outer_color});
+    vertex_builder.AppendVertex({inner[b], inner_color});
+    vertex_builder.AppendVertex({inner[a], inner_color});
+  }
+}
+
 VertexBufferBuilder<TextureFillVertexShader::PerVertexData>
 ComputeUVGeometryCPU(
     VertexBufferBuilder<SolidFillVertexShader::PerVertexData>& input,
@@ -110,6 +173,13 @@ GeometryResult Geometry::GetPositionUVBuffer(Rect texture_coverage,
   return {};
 }
 
+std::optional<GeometryResult> Geometry::GetStencilCoverBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) {
+  return std::nullopt;
+}
+
 std::unique_ptr<Geometry> Geometry::MakeFillPath(
     const Path& path,
     std::optional<Rect> inner_rect) {
@@ -147,4 +217,8 @@ bool Geometry::CoversArea(const Matrix& transform, const Rect& rect) const {
   return false;
 }
 
+std::optional<Rect> Geometry::AsRect() const {
+  return std::nullopt;
+}
+
 }  // namespace impeller
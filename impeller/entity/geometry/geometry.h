@@ -49,7 +49,30 @@ GeometryResult ComputeUVGeometryForRect(Rect source_rect,
 /// @brief Given a polyline created from a convex filled path, perform a
 /// tessellation.
 std::pair<std::vector<Point>, std::vector<uint16_t>> TessellateConvex(
-    Path::Polyline polyline);
+    const Path::Polyline& polyline);
+
+/// @brief Whether `rect` transformed by `transform` is an axis aligned
+/// rectangle with its edges on pixel boundaries. Such rectangles render the
+/// same with and without multisampling.
+bool IsPixelAlignedRect(const Rect& rect, const Matrix& transform);
+
+/// The number of vertices `AppendAntialiasedQuadVertices` appends per quad.
+static constexpr size_t kAntialiasedQuadVertexCount = 30u;
+
+/// @brief Append the triangles of a quad to draw it antialiased without
+/// multisampling.
+///
+/// `points` are the corners of a parallelogram in pixels, in the order of
+/// `Rect::GetPoints`. The premultiplied `color` ramps down to transparent
+/// across one pixel centered on each of the edges, which is exact for axis
+/// aligned edges. Since the coverage is applied to the color, the vertices
+/// must be drawn with a blend mode that is linear in the source, such as
+/// `BlendMode::kSourceOver`.
+void AppendAntialiasedQuadVertices(
+    const std::array<Point, 4>& points,
+    const Color& color,
+    VertexBufferBuilder<GeometryColorPipeline::VertexShader::PerVertexData>&
+        vertex_builder);
 
 class Geometry {
  public:
@@ -86,6 +109,24 @@ class Geometry {
                                              const Entity& entity,
                                              RenderPass& pass);
 
+  //----------------------------------------------------------------------------
+  /// @brief    Records commands that write the geometry into the stencil, and
+  ///           returns a buffer covering it. This fills the geometry without
+  ///           triangulating it.
+  ///
+  ///           The cover must be drawn with `CompareFunction::kNotEqual` and
+  ///           `StencilOperation::kSetToReferenceValue`, using the stencil
+  ///           depth of the entity as the reference, which both draws the
+  ///           geometry and resets the stencil.
+  ///
+  /// @returns  `std::nullopt` if the geometry should be drawn with the buffer
+  ///           from `GetPositionBuffer` instead. No commands are recorded in
+  ///           that case.
+  virtual std::optional<GeometryResult> GetStencilCoverBuffer(
+      const ContentContext& renderer,
+      const Entity& entity,
+      RenderPass& pass);
+
   virtual GeometryVertexType GetVertexType() const = 0;
 
   virtual std::optional<Rect> GetCoverage(const Matrix& transform) const = 0;
@@ -101,6 +142,11 @@ class Geometry {
   ///           given `rect`. May return `false` in many undetected cases where
   ///           the transformed geometry does in fact cover the `rect`.
   virtual bool CoversArea(const Matrix& transform, const Rect& rect) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief    The rectangle this geometry fills, if it is exactly a rectangle.
+  ///
+  virtual std::optional<Rect> AsRect() const;
 };
 
 }  // namespace impeller
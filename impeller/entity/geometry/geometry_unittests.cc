@@ -2,13 +2,70 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 #include "flutter/testing/testing.h"
+#include "impeller/core/allocator.h"
+#include "impeller/core/device_buffer.h"
+#include "impeller/entity/geometry/fill_path_geometry.h"
 #include "impeller/entity/geometry/geometry.h"
+#include "impeller/entity/geometry/stroke_path_geometry.h"
+#include "impeller/entity/geometry/tessellation_cache.h"
+#include "impeller/entity/geometry/vertices_cache.h"
+#include "impeller/geometry/geometry_asserts.h"
 #include "impeller/geometry/path_builder.h"
 
 namespace impeller {
 namespace testing {
 
+namespace {
+
+class HostDeviceBuffer : public DeviceBuffer {
+ public:
+  explicit HostDeviceBuffer(const DeviceBufferDescriptor& desc)
+      : DeviceBuffer(desc), storage_(desc.size) {}
+
+  bool SetLabel(const std::string& label) override { return true; }
+
+  bool SetLabel(const std::string& label, Range range) override {
+    return true;
+  }
+
+  uint8_t* OnGetContents() const override {
+    return const_cast<uint8_t*>(storage_.data());
+  }
+
+  bool OnCopyHostBuffer(const uint8_t* source,
+                        Range source_range,
+                        size_t offset) override {
+    std::memcpy(storage_.data() + offset, source + source_range.offset,
+                source_range.length);
+    return true;
+  }
+
+ private:
+  std::vector<uint8_t> storage_;
+};
+
+class HostAllocator : public Allocator {
+ public:
+  ISize GetMaxTextureSizeSupported() const override { return {1024, 1024}; }
+
+  std::shared_ptr<DeviceBuffer> OnCreateBuffer(
+      const DeviceBufferDescriptor& desc) override {
+    return std::make_shared<HostDeviceBuffer>(desc);
+  }
+
+  std::shared_ptr<Texture> OnCreateTexture(
+      const TextureDescriptor& desc) override {
+    return nullptr;
+  }
+};
+
+}  // namespace
+
 TEST(EntityGeometryTest, RectGeometryCoversArea) {
   auto geometry = Geometry::MakeRect(Rect::MakeLTRB(0, 0, 100, 100));
   ASSERT_TRUE(geometry->CoversArea({}, Rect::MakeLTRB(0, 0, 100, 100)));
@@ -17,6 +74,69 @@ TEST(EntityGeometryTest, RectGeometryCoversArea) {
   ASSERT_TRUE(geometry->CoversArea({}, Rect()));
 }
 
+TEST(EntityGeometryTest, DetectsPixelAlignedRects) {
+  auto rect = Rect::MakeLTRB(10, 10, 20, 20);
+  ASSERT_TRUE(IsPixelAlignedRect(rect, {}));
+  ASSERT_TRUE(IsPixelAlignedRect(rect, Matrix::MakeTranslation({-3, 4})));
+  ASSERT_TRUE(IsPixelAlignedRect(Rect::MakeLTRB(0.5, 0.5, 1.5, 2.5),
+                                 Matrix::MakeScale({2, 2, 1})));
+  ASSERT_FALSE(IsPixelAlignedRect(rect, Matrix::MakeTranslation({0.5, 0})));
+  ASSERT_FALSE(IsPixelAlignedRect(rect, Matrix::MakeRotationZ(Degrees(90))));
+  ASSERT_FALSE(IsPixelAlignedRect(Rect::MakeLTRB(10, 10, 20, 20.25), {}));
+}
+
+TEST(EntityGeometryTest, AntialiasedQuadsRampAcrossEdges) {
+  using VS = GeometryColorPipeline::VertexShader;
+  const auto color = Color::CornflowerBlue().Premultiply();
+
+  VertexBufferBuilder<VS::PerVertexData> vertex_builder;
+  AppendAntialiasedQuadVertices(Rect::MakeLTRB(10, 10, 20, 30).GetPoints(),
+                                color, vertex_builder);
+  ASSERT_EQ(vertex_builder.GetVertexCount(), kAntialiasedQuadVertexCount);
+
+  // The color ramps down to transparent across a pixel centered on each edge.
+  std::vector<Point> inner;
+  std::vector<Point> outer;
+  vertex_builder.IterateVertices([&](VS::PerVertexData& vertex) {
+    if (vertex.color == Color::BlackTransparent()) {
+      outer.push_back(vertex.position);
+    } else {
+      ASSERT_COLOR_NEAR(vertex.color, color);
+      inner.push_back(vertex.position);
+    }
+  });
+  ASSERT_RECT_NEAR(Rect::MakePointBounds(inner.begin(), inner.end()).value(),
+                   Rect::MakeLTRB(10.5, 10.5, 19.5, 29.5));
+  ASSERT_RECT_NEAR(Rect::MakePointBounds(outer.begin(), outer.end()).value(),
+                   Rect::MakeLTRB(9.5, 9.5, 20.5, 30.5));
+}
+
+TEST(EntityGeometryTest, AntialiasedQuadsThinnerThanAPixelFadeOut) {
+  using VS = GeometryColorPipeline::VertexShader;
+  const auto color = Color::White();
+
+  VertexBufferBuilder<VS::PerVertexData> vertex_builder;
+  AppendAntialiasedQuadVertices(Rect::MakeLTRB(10, 10, 10.5, 30).GetPoints(),
+                                color, vertex_builder);
+  ASSERT_EQ(vertex_builder.GetVertexCount(), kAntialiasedQuadVertexCount);
+
+  std::vector<Point> inner;
+  vertex_builder.IterateVertices([&](VS::PerVertexData& vertex) {
+    if (!(vertex.color == Color::BlackTransparent())) {
+      ASSERT_COLOR_NEAR(vertex.color, color * 0.5);
+      inner.push_back(vertex.position);
+    }
+  });
+  ASSERT_RECT_NEAR(Rect::MakePointBounds(inner.begin(), inner.end()).value(),
+                   Rect::MakeLTRB(10.25, 10.5, 10.25, 29.5));
+
+  // Empty quads draw nothing.
+  VertexBufferBuilder<VS::PerVertexData> empty_builder;
+  AppendAntialiasedQuadVertices(Rect::MakeLTRB(10, 10, 10, 30).GetPoints(),
+                                color, empty_builder);
+  ASSERT_EQ(empty_builder.GetVertexCount(), 0u);
+}
+
 TEST(EntityGeometryTest, FillPathGeometryCoversArea) {
   auto path = PathBuilder{}.AddRect(Rect::MakeLTRB(0, 0, 100, 100)).TakePath();
   auto geometry = Geometry::MakeFillPath(
@@ -36,5 +156,259 @@ TEST(EntityGeometryTest, FillPathGeometryCoversAreaNoInnerRect) {
   ASSERT_FALSE(geometry->CoversArea({}, Rect()));
 }
 
+TEST(EntityGeometryTest, FillPathGeometryCurveSubdivisions) {
+  // Degenerate curves are never subdivided.
+  ASSERT_EQ(FillPathGeometry::ComputeCurveSubdivisions(
+                1.0, QuadraticPathComponent({0, 0}, {50, 50}, {100, 100})),
+            1u);
+  ASSERT_EQ(FillPathGeometry::ComputeCurveSubdivisions(
+                1.0, CubicPathComponent({0, 0}, {0, 0}, {0, 0}, {0, 0})),
+            1u);
+
+  QuadraticPathComponent quad({0, 0}, {50, 100}, {100, 0});
+  ASSERT_EQ(FillPathGeometry::ComputeCurveSubdivisions(1.0, quad), 23u);
+  // A larger scale reduces the tolerance and requires more segments.
+  ASSERT_EQ(FillPathGeometry::ComputeCurveSubdivisions(2.0, quad), 32u);
+
+  CubicPathComponent cubic({0, 0}, {0, 100}, {100, 100}, {100, 0});
+  ASSERT_EQ(FillPathGeometry::ComputeCurveSubdivisions(1.0, cubic), 33u);
+
+  // Huge curves are clamped.
+  CubicPathComponent huge({0, 0}, {0, 1e9}, {1e9, 1e9}, {1e9, 0});
+  ASSERT_EQ(FillPathGeometry::ComputeCurveSubdivisions(1.0, huge),
+            FillPathGeometry::kMaxCurveSubdivisions);
+}
+
+TEST(EntityGeometryTest, FillPathGeometryStencilFansFollowWinding) {
+  auto path = PathBuilder{}
+                  .MoveTo({0, 0})
+                  .LineTo({10, 0})
+                  .LineTo({10, 10})
+                  .LineTo({0, 10})
+                  .Close()
+                  .MoveTo({20, 0})
+                  .LineTo({20, 10})
+                  .LineTo({30, 10})
+                  .LineTo({30, 0})
+                  .Close()
+                  .TakePath();
+
+  std::vector<Point> positive;
+  std::vector<Point> negative;
+  FillPathGeometry::CreateStencilFans(path.CreatePolyline(1.0), positive,
+                                      negative);
+
+  // Each square is split into two triangles around its first point.
+  ASSERT_EQ(positive.size(), 6u);
+  ASSERT_EQ(negative.size(), 6u);
+  for (size_t i = 0; i < positive.size(); i += 3) {
+    EXPECT_EQ(positive[i], Point(0, 0));
+    EXPECT_EQ(negative[i], Point(20, 0));
+  }
+  EXPECT_EQ(positive[2], Point(10, 10));
+  EXPECT_EQ(negative[2], Point(30, 10));
+}
+
+TEST(EntityGeometryTest, StrokePathGeometryDetectsHairlines) {
+  ASSERT_TRUE(StrokePathGeometry::IsHairline(0.0, Matrix()));
+  ASSERT_TRUE(StrokePathGeometry::IsHairline(1.0, Matrix()));
+  ASSERT_FALSE(StrokePathGeometry::IsHairline(1.5, Matrix()));
+  ASSERT_TRUE(
+      StrokePathGeometry::IsHairline(2.0, Matrix::MakeScale({0.5, 0.5, 1})));
+  // The widest axis of the transform decides.
+  ASSERT_FALSE(
+      StrokePathGeometry::IsHairline(1.0, Matrix::MakeScale({2, 0.25, 1})));
+}
+
+TEST(EntityGeometryTest, StrokePathGeometryHairlinesAreLineLists) {
+  auto path = PathBuilder{}
+                  .MoveTo({0, 0})
+                  .LineTo({10, 0})
+                  .LineTo({10, 10})
+                  .AddRect(Rect::MakeLTRB(20, 20, 30, 30))
+                  .MoveTo({50, 50})
+                  .LineTo({50, 50})
+                  .TakePath();
+  auto polyline = path.CreatePolyline(1.0f);
+  auto get_positions = [](auto& builder) {
+    std::vector<Point> positions;
+    builder.IterateVertices([&positions](const auto& vertex) {
+      positions.push_back(vertex.position);
+    });
+    return positions;
+  };
+
+  auto butt = StrokePathGeometry::CreateHairlineVertices(polyline, 1.0f,
+                                                         Cap::kButt);
+  // Two segments for the open contour and four for the rect. The single point
+  // contour isn't drawn with butt caps.
+  auto positions = get_positions(butt);
+  ASSERT_EQ(positions.size(), 12u);
+  ASSERT_EQ(positions[0], Point(0, 0));
+  ASSERT_EQ(positions[1], Point(10, 0));
+  ASSERT_EQ(positions[2], Point(10, 0));
+  ASSERT_EQ(positions[3], Point(10, 10));
+  ASSERT_EQ(positions[11], Point(20, 20));
+
+  auto round = StrokePathGeometry::CreateHairlineVertices(polyline, 1.0f,
+                                                          Cap::kRound);
+  positions = get_positions(round);
+  ASSERT_EQ(positions.size(), 14u);
+  ASSERT_EQ(positions[12], Point(49.5, 50));
+  ASSERT_EQ(positions[13], Point(50.5, 50));
+}
+
+TEST(EntityGeometryTest, TessellationCacheQuantizesScaleUp) {
+  ASSERT_EQ(TessellationCache::QuantizeScale(1.0f), 1.0f);
+  ASSERT_EQ(TessellationCache::QuantizeScale(2.0f), 2.0f);
+  ASSERT_EQ(TessellationCache::QuantizeScale(0.5f), 0.5f);
+  for (auto scale : {0.3f, 1.01f, 1.5f, 3.7f}) {
+    auto quantized = TessellationCache::QuantizeScale(scale);
+    ASSERT_GE(quantized, scale);
+    ASSERT_LT(quantized, scale * 1.19f);
+  }
+  // Nearby scales share an entry.
+  ASSERT_EQ(TessellationCache::QuantizeScale(1.01f),
+            TessellationCache::QuantizeScale(1.1f));
+}
+
+TEST(EntityGeometryTest, TessellationCacheStoresTrianglesInDeviceBuffers) {
+  HostAllocator allocator;
+  TessellationCache cache;
+  TessellationCache::Key key{.generation_id = 1u};
+  ASSERT_FALSE(cache.Find(key).has_value());
+
+  std::vector<Point> points = {{0, 0}, {10, 0}, {10, 10}, {0, 10}};
+  std::vector<uint16_t> indices = {0, 1, 2, 0, 2, 3};
+  auto inserted = cache.Insert(key, allocator, points.data(), points.size(),
+                               indices.data(), indices.size());
+  ASSERT_TRUE(inserted.has_value());
+  ASSERT_EQ(inserted->vertex_count, 6u);
+  ASSERT_EQ(inserted->index_type, IndexType::k16bit);
+  ASSERT_EQ(inserted->vertex_buffer.range.length, 4u * sizeof(Point));
+  ASSERT_EQ(inserted->index_buffer.range.length, 6u * sizeof(uint16_t));
+  const auto* cached_indices = reinterpret_cast<const uint16_t*>(
+      inserted->index_buffer.contents + inserted->index_buffer.range.offset);
+  ASSERT_TRUE(std::equal(indices.begin(), indices.end(), cached_indices));
+
+  auto found = cache.Find(key);
+  ASSERT_TRUE(found.has_value());
+  ASSERT_EQ(found->vertex_buffer.buffer, inserted->vertex_buffer.buffer);
+
+  // Other scales and fill types are different entries.
+  ASSERT_FALSE(cache.Find({.generation_id = 1u, .scale = 2.0f}).has_value());
+  ASSERT_FALSE(cache.Find({.generation_id = 1u, .fill_type = FillType::kOdd})
+                   .has_value());
+}
+
+TEST(EntityGeometryTest, TessellationCacheEvictsLeastRecentlyUsedEntries) {
+  HostAllocator allocator;
+  TessellationCache cache;
+  // Each entry takes up just under kMaxEntryBytes.
+  std::vector<Point> points(
+      TessellationCache::kMaxEntryBytes / sizeof(Point) - 1);
+  std::vector<uint16_t> indices = {0, 1, 2};
+  auto insert = [&](uint32_t generation_id) {
+    return cache
+        .Insert({.generation_id = generation_id}, allocator, points.data(),
+                points.size(), indices.data(), indices.size())
+        .has_value();
+  };
+
+  const size_t max_entries =
+      TessellationCache::kMaxCacheBytes / TessellationCache::kMaxEntryBytes;
+  for (uint32_t i = 1; i <= max_entries; i++) {
+    ASSERT_TRUE(insert(i));
+  }
+  ASSERT_EQ(cache.GetEntryCount(), max_entries);
+  ASSERT_LE(cache.GetCachedBytes(), TessellationCache::kMaxCacheBytes);
+
+  // Using the oldest entry makes the second oldest one the next to go.
+  ASSERT_TRUE(cache.Find({.generation_id = 1u}).has_value());
+  ASSERT_TRUE(insert(max_entries + 1));
+  ASSERT_EQ(cache.GetEntryCount(), max_entries);
+  ASSERT_TRUE(cache.Find({.generation_id = 1u}).has_value());
+  ASSERT_FALSE(cache.Find({.generation_id = 2u}).has_value());
+
+  // Entries that are too large aren't cached at all.
+  std::vector<Point> huge(TessellationCache::kMaxEntryBytes / sizeof(Point));
+  ASSERT_FALSE(cache
+                   .Insert({.generation_id = 100u}, allocator, huge.data(),
+                           huge.size(), indices.data(), indices.size())
+                   .has_value());
+}
+
+TEST(EntityGeometryTest, TessellationCacheClearDropsAllEntries) {
+  HostAllocator allocator;
+  TessellationCache cache;
+  std::vector<Point> points = {{0, 0}, {10, 0}, {10, 10}};
+  std::vector<uint16_t> indices = {0, 1, 2};
+  ASSERT_TRUE(cache
+                  .Insert({.generation_id = 1u}, allocator, points.data(),
+                          points.size(), indices.data(), indices.size())
+                  .has_value());
+  ASSERT_EQ(cache.GetEntryCount(), 1u);
+
+  cache.Clear();
+  ASSERT_EQ(cache.GetEntryCount(), 0u);
+  ASSERT_EQ(cache.GetCachedBytes(), 0u);
+  ASSERT_FALSE(cache.Find({.generation_id = 1u}).has_value());
+}
+
+TEST(EntityGeometryTest, VerticesCacheStoresVertexDataInDeviceBuffers) {
+  HostAllocator allocator;
+  VerticesCache cache;
+  VerticesCache::Key key{.unique_id = 1u};
+  ASSERT_FALSE(cache.Find(key).has_value());
+
+  std::vector<Point> points = {{0, 0}, {10, 0}, {10, 10}, {0, 10}};
+  std::vector<uint16_t> indices = {0, 1, 2, 0, 2, 3};
+  auto inserted =
+      cache.Insert(key, allocator, points.data(), points.size() * sizeof(Point),
+                   points.size(), indices.data(), indices.size());
+  ASSERT_TRUE(inserted.has_value());
+  ASSERT_EQ(inserted->vertex_count, 6u);
+  ASSERT_EQ(inserted->index_type, IndexType::k16bit);
+  ASSERT_EQ(inserted->vertex_buffer.range.length, 4u * sizeof(Point));
+  ASSERT_EQ(inserted->index_buffer.range.length, 6u * sizeof(uint16_t));
+  const auto* cached_indices = reinterpret_cast<const uint16_t*>(
+      inserted->index_buffer.contents + inserted->index_buffer.range.offset);
+  ASSERT_TRUE(std::equal(indices.begin(), indices.end(), cached_indices));
+
+  auto found = cache.Find(key);
+  ASSERT_TRUE(found.has_value());
+  ASSERT_EQ(found->vertex_buffer.buffer, inserted->vertex_buffer.buffer);
+
+  // Other layouts and texture mappings are different entries.
+  ASSERT_FALSE(cache
+                   .Find({.unique_id = 1u,
+                          .layout = VerticesCache::Layout::kPositionUV})
+                   .has_value());
+  ASSERT_FALSE(cache
+                   .Find({.unique_id = 1u,
+                          .texture_coverage = Rect::MakeLTRB(0, 0, 5, 5)})
+                   .has_value());
+
+  // Vertices without indices are drawn in order.
+  auto unindexed =
+      cache.Insert({.unique_id = 2u}, allocator, points.data(),
+                   points.size() * sizeof(Point), points.size(), nullptr, 0u);
+  ASSERT_TRUE(unindexed.has_value());
+  ASSERT_EQ(unindexed->vertex_count, 4u);
+  ASSERT_EQ(unindexed->index_type, IndexType::kNone);
+  ASSERT_EQ(cache.GetEntryCount(), 2u);
+
+  cache.Clear();
+  ASSERT_EQ(cache.GetEntryCount(), 0u);
+  ASSERT_EQ(cache.GetCachedBytes(), 0u);
+}
+
+TEST(EntityGeometryTest, PathBuilderResetsGenerationIDAfterTakingPath) {
+  PathBuilder builder;
+  builder.AddRect(Rect::MakeLTRB(0, 0, 10, 10)).SetGenerationID(42u);
+  ASSERT_EQ(builder.TakePath().GetGenerationID(), 42u);
+  ASSERT_EQ(builder.TakePath().GetGenerationID(), 0u);
+}
+
 }  // namespace testing
 }  // namespace impeller
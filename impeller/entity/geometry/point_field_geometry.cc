@@ -23,19 +23,7 @@ GeometryResult PointFieldGeometry::GetPositionBuffer(
   if (renderer.GetDeviceCapabilities().SupportsCompute()) {
     return GetPositionBufferGPU(renderer, entity, pass);
   }
-  auto vtx_builder = GetPositionBufferCPU(renderer, entity, pass);
-  if (!vtx_builder.has_value()) {
-    return {};
-  }
-
-  auto& host_buffer = pass.GetTransientsBuffer();
-  return {
-      .type = PrimitiveType::kTriangle,
-      .vertex_buffer = vtx_builder->CreateVertexBuffer(host_buffer),
-      .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
-                   entity.GetTransformation(),
-      .prevent_overdraw = false,
-  };
+  return GetPositionBufferCPU(renderer, entity, pass);
 }
 
 GeometryResult PointFieldGeometry::GetPositionUVBuffer(
@@ -48,34 +36,52 @@ GeometryResult PointFieldGeometry::GetPositionUVBuffer(
     return GetPositionBufferGPU(renderer, entity, pass, texture_coverage,
                                 effect_transform);
   }
+  return GetPositionBufferCPU(renderer, entity, pass, texture_coverage,
+                              effect_transform);
+}
 
-  auto vtx_builder = GetPositionBufferCPU(renderer, entity, pass);
-  if (!vtx_builder.has_value()) {
-    return {};
-  }
-  auto uv_vtx_builder = ComputeUVGeometryCPU(
-      vtx_builder.value(), {0, 0}, texture_coverage.size, effect_transform);
+namespace {
 
-  auto& host_buffer = pass.GetTransientsBuffer();
-  return {
-      .type = PrimitiveType::kTriangle,
-      .vertex_buffer = uv_vtx_builder.CreateVertexBuffer(host_buffer),
-      .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
-                   entity.GetTransformation(),
-      .prevent_overdraw = false,
-  };
+/// Calls |write| with the position of every vertex of the triangles covering
+/// each of the |points|, whose shape is given by |angle_table|.
+template <typename VertexWriter>
+void GeneratePointTriangles(const std::vector<Point>& points,
+                            const std::vector<Point>& angle_table,
+                            const VertexWriter& write) {
+  for (const auto& center : points) {
+    auto origin = center + angle_table[0];
+    write(origin);
+
+    auto pt1 = center + angle_table[1];
+    write(pt1);
+
+    auto pt2 = center + angle_table[2];
+    write(pt2);
+
+    for (auto j = 3u; j < angle_table.size(); j++) {
+      write(origin);
+      write(pt2);
+
+      pt2 = center + angle_table[j];
+      write(pt2);
+    }
+  }
 }
 
-std::optional<VertexBufferBuilder<SolidFillVertexShader::PerVertexData>>
-PointFieldGeometry::GetPositionBufferCPU(const ContentContext& renderer,
-                                         const Entity& entity,
-                                         RenderPass& pass) {
+}  // namespace
+
+GeometryResult PointFieldGeometry::GetPositionBufferCPU(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass,
+    std::optional<Rect> texture_coverage,
+    std::optional<Matrix> effect_transform) {
   if (radius_ < 0.0) {
-    return std::nullopt;
+    return {};
   }
   auto determinant = entity.GetTransformation().GetDeterminant();
   if (determinant == 0) {
-    return std::nullopt;
+    return {};
   }
 
   Scalar min_size = 1.0f / sqrt(std::abs(determinant));
@@ -88,9 +94,6 @@ PointFieldGeometry::GetPositionBufferCPU(const ContentContext& renderer,
   auto radian_start = round_ ? 0.0f : 0.785398f;
   auto radian_step = k2Pi / vertices_per_geom;
 
-  VertexBufferBuilder<SolidFillVertexShader::PerVertexData> vtx_builder;
-  vtx_builder.Reserve(total);
-
   /// Precompute all relative points and angles for a fixed geometry size.
   auto elapsed_angle = radian_start;
   std::vector<Point> angle_table(vertices_per_geom);
@@ -99,27 +102,49 @@ PointFieldGeometry::GetPositionBufferCPU(const ContentContext& renderer,
     elapsed_angle += radian_step;
   }
 
-  for (auto i = 0u; i < points_.size(); i++) {
-    auto center = points_[i];
-
-    auto origin = center + angle_table[0];
-    vtx_builder.AppendVertex({origin});
-
-    auto pt1 = center + angle_table[1];
-    vtx_builder.AppendVertex({pt1});
-
-    auto pt2 = center + angle_table[2];
-    vtx_builder.AppendVertex({pt2});
-
-    for (auto j = 0u; j < vertices_per_geom - 3; j++) {
-      vtx_builder.AppendVertex({origin});
-      vtx_builder.AppendVertex({pt2});
-
-      pt2 = center + angle_table[j + 3];
-      vtx_builder.AppendVertex({pt2});
-    }
+  // The vertices are written directly into the transients buffer. Point
+  // fields can have millions of vertices, which makes building them in a
+  // |VertexBufferBuilder| first and copying them over noticeably slower.
+  auto& host_buffer = pass.GetTransientsBuffer();
+  BufferView vertex_buffer;
+  if (texture_coverage.has_value() && effect_transform.has_value()) {
+    using VS = TextureFillVertexShader;
+    vertex_buffer = host_buffer.Emplace(
+        total * sizeof(VS::PerVertexData), alignof(VS::PerVertexData),
+        [&](uint8_t* contents) {
+          auto vertices = reinterpret_cast<VS::PerVertexData*>(contents);
+          const auto& size = texture_coverage->size;
+          const auto& transform = effect_transform.value();
+          GeneratePointTriangles(
+              points_, angle_table, [&](const Point& position) {
+                vertices->position = position;
+                vertices->texture_coords = transform * position / size;
+                vertices++;
+              });
+        });
+  } else {
+    using VS = SolidFillVertexShader;
+    vertex_buffer = host_buffer.Emplace(
+        total * sizeof(VS::PerVertexData), alignof(VS::PerVertexData),
+        [&](uint8_t* contents) {
+          auto vertices = reinterpret_cast<VS::PerVertexData*>(contents);
+          GeneratePointTriangles(points_, angle_table,
+                                 [&](const Point& position) {
+                                   vertices->position = position;
+                                   vertices++;
+                                 });
+        });
   }
-  return vtx_builder;
+
+  return {
+      .type = PrimitiveType::kTriangle,
+      .vertex_buffer = {.vertex_buffer = vertex_buffer,
+                        .vertex_count = total,
+                        .index_type = IndexType::kNone},
+      .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                   entity.GetTransformation(),
+      .prevent_overdraw = false,
+  };
 }
 
 GeometryResult PointFieldGeometry::GetPositionBufferGPU(
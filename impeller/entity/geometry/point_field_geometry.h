@@ -42,10 +42,12 @@ class PointFieldGeometry : public Geometry {
       std::optional<Rect> texture_coverage = std::nullopt,
       std::optional<Matrix> effect_transform = std::nullopt);
 
-  std::optional<VertexBufferBuilder<SolidFillVertexShader::PerVertexData>>
-  GetPositionBufferCPU(const ContentContext& renderer,
-                       const Entity& entity,
-                       RenderPass& pass);
+  GeometryResult GetPositionBufferCPU(
+      const ContentContext& renderer,
+      const Entity& entity,
+      RenderPass& pass,
+      std::optional<Rect> texture_coverage = std::nullopt,
+      std::optional<Matrix> effect_transform = std::nullopt);
 
   std::vector<Point> points_;
   Scalar radius_;
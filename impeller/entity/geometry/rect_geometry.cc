@@ -55,4 +55,8 @@ bool RectGeometry::CoversArea(const Matrix& transform, const Rect& rect) const {
   return coverage.Contains(rect);
 }
 
+std::optional<Rect> RectGeometry::AsRect() const {
+  return rect_;
+}
+
 }  // namespace impeller
@@ -5,6 +5,7 @@
 #include "impeller/entity/geometry/stroke_path_geometry.h"
 
 #include "impeller/geometry/path_builder.h"
+#include "impeller/tessellator/tessellator.h"
 
 namespace impeller {
 
@@ -227,14 +228,13 @@ StrokePathGeometry::CapProc StrokePathGeometry::GetCapProc(Cap stroke_cap) {
 // static
 VertexBufferBuilder<SolidFillVertexShader::PerVertexData>
 StrokePathGeometry::CreateSolidStrokeVertices(
-    const Path& path,
+    const Path::Polyline& polyline,
     Scalar stroke_width,
     Scalar scaled_miter_limit,
     const StrokePathGeometry::JoinProc& join_proc,
     const StrokePathGeometry::CapProc& cap_proc,
     Scalar scale) {
   VertexBufferBuilder<VS::PerVertexData> vtx_builder;
-  auto polyline = path.CreatePolyline(scale);
 
   VS::PerVertexData vtx;
 
@@ -372,6 +372,76 @@ StrokePathGeometry::CreateSolidStrokeVertices(
   return vtx_builder;
 }
 
+// static
+bool StrokePathGeometry::IsHairline(Scalar stroke_width,
+                                    const Matrix& transform) {
+  return stroke_width * transform.GetMaxBasisLength() <= 1.0f;
+}
+
+// static
+VertexBufferBuilder<SolidFillVertexShader::PerVertexData>
+StrokePathGeometry::CreateHairlineVertices(const Path::Polyline& polyline,
+                                           Scalar dot_length,
+                                           Cap stroke_cap) {
+  VertexBufferBuilder<VS::PerVertexData> vtx_builder;
+  vtx_builder.Reserve(polyline.points.size() * 2);
+
+  VS::PerVertexData vtx;
+  for (size_t contour_i = 0; contour_i < polyline.contours.size();
+       contour_i++) {
+    size_t contour_start_point_i, contour_end_point_i;
+    std::tie(contour_start_point_i, contour_end_point_i) =
+        polyline.GetContourPointBounds(contour_i);
+
+    if (contour_end_point_i - contour_start_point_i == 1) {
+      if (stroke_cap != Cap::kButt) {
+        Point p = polyline.points[contour_start_point_i];
+        vtx.position = p - Point(dot_length * 0.5f, 0);
+        vtx_builder.AppendVertex(vtx);
+        vtx.position = p + Point(dot_length * 0.5f, 0);
+        vtx_builder.AppendVertex(vtx);
+      }
+      continue;
+    }
+
+    // Closed contours already end with the point they started at.
+    for (size_t point_i = contour_start_point_i + 1;
+         point_i < contour_end_point_i; point_i++) {
+      vtx.position = polyline.points[point_i - 1];
+      vtx_builder.AppendVertex(vtx);
+      vtx.position = polyline.points[point_i];
+      vtx_builder.AppendVertex(vtx);
+    }
+  }
+
+  return vtx_builder;
+}
+
+VertexBufferBuilder<SolidFillVertexShader::PerVertexData>
+StrokePathGeometry::CreateVertices(const ContentContext& renderer,
+                                   const Matrix& transform,
+                                   PrimitiveType& primitive_type) const {
+  Scalar min_size = 1.0f / sqrt(std::abs(transform.GetDeterminant()));
+  Scalar stroke_width = std::max(stroke_width_, min_size);
+
+  auto scale = transform.GetMaxBasisLength();
+  const auto& polyline =
+      renderer.GetTessellator()->CreateTempPolyline(path_, scale);
+
+  // Strokes no wider than a pixel don't need to be extruded, joined or
+  // capped. Rasterizing the polyline with line primitives covers the same
+  // pixels for a fraction of the vertices.
+  if (IsHairline(stroke_width_, transform)) {
+    primitive_type = PrimitiveType::kLine;
+    return CreateHairlineVertices(polyline, stroke_width, stroke_cap_);
+  }
+
+  primitive_type = PrimitiveType::kTriangleStrip;
+  return CreateSolidStrokeVertices(
+      polyline, stroke_width, miter_limit_ * stroke_width_ * 0.5,
+      GetJoinProc(stroke_join_), GetCapProc(stroke_cap_), scale);
+}
+
 GeometryResult StrokePathGeometry::GetPositionBuffer(
     const ContentContext& renderer,
     const Entity& entity,
@@ -384,17 +454,13 @@ GeometryResult StrokePathGeometry::GetPositionBuffer(
     return {};
   }
 
-  Scalar min_size = 1.0f / sqrt(std::abs(determinant));
-  Scalar stroke_width = std::max(stroke_width_, min_size);
-
   auto& host_buffer = pass.GetTransientsBuffer();
-  auto vertex_builder = CreateSolidStrokeVertices(
-      path_, stroke_width, miter_limit_ * stroke_width_ * 0.5,
-      GetJoinProc(stroke_join_), GetCapProc(stroke_cap_),
-      entity.GetTransformation().GetMaxBasisLength());
+  PrimitiveType primitive_type;
+  auto vertex_builder =
+      CreateVertices(renderer, entity.GetTransformation(), primitive_type);
 
   return GeometryResult{
-      .type = PrimitiveType::kTriangleStrip,
+      .type = primitive_type,
       .vertex_buffer = vertex_builder.CreateVertexBuffer(host_buffer),
       .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
                    entity.GetTransformation(),
@@ -416,19 +482,15 @@ GeometryResult StrokePathGeometry::GetPositionUVBuffer(
     return {};
   }
 
-  Scalar min_size = 1.0f / sqrt(std::abs(determinant));
-  Scalar stroke_width = std::max(stroke_width_, min_size);
-
   auto& host_buffer = pass.GetTransientsBuffer();
-  auto stroke_builder = CreateSolidStrokeVertices(
-      path_, stroke_width, miter_limit_ * stroke_width_ * 0.5,
-      GetJoinProc(stroke_join_), GetCapProc(stroke_cap_),
-      entity.GetTransformation().GetMaxBasisLength());
+  PrimitiveType primitive_type;
+  auto stroke_builder =
+      CreateVertices(renderer, entity.GetTransformation(), primitive_type);
   auto vertex_builder = ComputeUVGeometryCPU(
       stroke_builder, {0, 0}, texture_coverage.size, effect_transform);
 
   return GeometryResult{
-      .type = PrimitiveType::kTriangleStrip,
+      .type = primitive_type,
       .vertex_buffer = vertex_builder.CreateVertexBuffer(host_buffer),
       .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
                    entity.GetTransformation(),
@@ -27,6 +27,20 @@ class StrokePathGeometry : public Geometry {
 
   Join GetStrokeJoin() const;
 
+  /// @brief Whether a stroke of |stroke_width| drawn with |transform| is no
+  ///        wider than a device pixel, in which case it is drawn as a hairline
+  ///        with line primitives instead of an extruded triangle strip.
+  static bool IsHairline(Scalar stroke_width, const Matrix& transform);
+
+  /// @brief Create the line list of a hairline stroke of |polyline|. Joins
+  ///        are not needed at hairline widths and open contours are not
+  ///        capped. Contours of a single point are drawn as a line of
+  ///        |dot_length| unless |stroke_cap| is |Cap::kButt|.
+  static VertexBufferBuilder<SolidFillVertexShader::PerVertexData>
+  CreateHairlineVertices(const Path::Polyline& polyline,
+                         Scalar dot_length,
+                         Cap stroke_cap);
+
  private:
   using VS = SolidFillVertexShader;
 
@@ -71,13 +85,18 @@ class StrokePathGeometry : public Geometry {
       const Point& end_offset);
 
   static VertexBufferBuilder<SolidFillVertexShader::PerVertexData>
-  CreateSolidStrokeVertices(const Path& path,
+  CreateSolidStrokeVertices(const Path::Polyline& polyline,
                             Scalar stroke_width,
                             Scalar scaled_miter_limit,
                             const JoinProc& join_proc,
                             const CapProc& cap_proc,
                             Scalar scale);
 
+  VertexBufferBuilder<SolidFillVertexShader::PerVertexData> CreateVertices(
+      const ContentContext& renderer,
+      const Matrix& transform,
+      PrimitiveType& primitive_type) const;
+
   static StrokePathGeometry::JoinProc GetJoinProc(Join stroke_join);
 
   static StrokePathGeometry::CapProc GetCapProc(Cap stroke_cap);
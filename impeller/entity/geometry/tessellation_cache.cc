@@ -0,0 +1,109 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/geometry/tessellation_cache.h"
+
+#include <cmath>
+
+#include "impeller/core/device_buffer.h"
+#include "impeller/core/device_buffer_descriptor.h"
+
+namespace impeller {
+
+TessellationCache::TessellationCache() = default;
+
+TessellationCache::~TessellationCache() = default;
+
+Scalar TessellationCache::QuantizeScale(Scalar scale) {
+  if (!std::isfinite(scale) || scale <= 0) {
+    return scale;
+  }
+  // Quarter octaves. Flattening at up to 19% more than the requested scale
+  // adds a few segments to each curve.
+  return std::exp2(std::ceil(std::log2(scale) * 4.0f) / 4.0f);
+}
+
+std::optional<VertexBuffer> TessellationCache::Find(const Key& key) {
+  auto found = entries_by_key_.find(key);
+  if (found == entries_by_key_.end()) {
+    return std::nullopt;
+  }
+  entries_.splice(entries_.begin(), entries_, found->second);
+  return found->second->vertex_buffer;
+}
+
+std::optional<VertexBuffer> TessellationCache::Insert(const Key& key,
+                                                      Allocator& allocator,
+                                                      const Point* points,
+                                                      size_t point_count,
+                                                      const uint16_t* indices,
+                                                      size_t index_count) {
+  const auto vertex_bytes = point_count * sizeof(Point);
+  const auto index_bytes = index_count * sizeof(uint16_t);
+  const auto bytes = vertex_bytes + index_bytes;
+  if (point_count == 0u || index_count == 0u || bytes > kMaxEntryBytes) {
+    return std::nullopt;
+  }
+
+  DeviceBufferDescriptor desc;
+  desc.storage_mode = StorageMode::kHostVisible;
+  desc.size = bytes;
+  auto buffer = allocator.CreateBuffer(desc);
+  if (!buffer) {
+    return std::nullopt;
+  }
+  // The indices follow the vertices. The vertices are pairs of floats, so the
+  // indices stay aligned.
+  if (!buffer->CopyHostBuffer(reinterpret_cast<const uint8_t*>(points),
+                              Range{0u, vertex_bytes}, 0u) ||
+      !buffer->CopyHostBuffer(reinterpret_cast<const uint8_t*>(indices),
+                              Range{0u, index_bytes}, vertex_bytes)) {
+    return std::nullopt;
+  }
+  buffer->SetLabel("Cached Tessellation");
+
+  auto view = buffer->AsBufferView();
+  VertexBuffer vertex_buffer;
+  vertex_buffer.vertex_buffer = {view.buffer, view.contents,
+                                 Range{0u, vertex_bytes}};
+  vertex_buffer.index_buffer = {view.buffer, view.contents,
+                                Range{vertex_bytes, index_bytes}};
+  vertex_buffer.vertex_count = index_count;
+  vertex_buffer.index_type = IndexType::k16bit;
+
+  if (auto found = entries_by_key_.find(key); found != entries_by_key_.end()) {
+    cached_bytes_ -= found->second->bytes;
+    entries_.erase(found->second);
+    entries_by_key_.erase(found);
+  }
+  while (!entries_.empty() && cached_bytes_ + bytes > kMaxCacheBytes) {
+    cached_bytes_ -= entries_.back().bytes;
+    entries_by_key_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+  entries_.push_front(Entry{
+      .key = key,
+      .vertex_buffer = vertex_buffer,
+      .bytes = bytes,
+  });
+  entries_by_key_[key] = entries_.begin();
+  cached_bytes_ += bytes;
+  return vertex_buffer;
+}
+
+void TessellationCache::Clear() {
+  entries_by_key_.clear();
+  entries_.clear();
+  cached_bytes_ = 0u;
+}
+
+size_t TessellationCache::GetEntryCount() const {
+  return entries_.size();
+}
+
+size_t TessellationCache::GetCachedBytes() const {
+  return cached_bytes_;
+}
+
+}  // namespace impeller
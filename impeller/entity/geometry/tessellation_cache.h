@@ -0,0 +1,130 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <optional>
+#include <unordered_map>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/macros.h"
+#include "impeller/core/allocator.h"
+#include "impeller/core/vertex_buffer.h"
+#include "impeller/geometry/path.h"
+#include "impeller/geometry/scalar.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A least recently used cache of the triangles of filled paths,
+///             kept in device buffers so that paths that don't change between
+///             frames are neither tessellated nor uploaded again.
+///
+///             Only paths with a generation ID are cached. Paths with the same
+///             generation ID have the same components, so the triangles only
+///             depend on the fill type and the scale the path was flattened
+///             at.
+///
+/// @see        `Path::GetGenerationID`
+///
+class TessellationCache {
+ public:
+  /// The most bytes of vertex and index data retained by the cache.
+  static constexpr size_t kMaxCacheBytes = 4u * 1024u * 1024u;
+
+  /// Paths whose triangles take more bytes than this aren't cached.
+  static constexpr size_t kMaxEntryBytes = 256u * 1024u;
+
+  struct Key {
+    uint32_t generation_id = 0u;
+    FillType fill_type = FillType::kNonZero;
+    Scalar scale = 1.0f;
+
+    struct Hash {
+      std::size_t operator()(const Key& key) const {
+        return fml::HashCombine(key.generation_id,
+                                static_cast<int>(key.fill_type), key.scale);
+      }
+    };
+
+    struct Equal {
+      bool operator()(const Key& lhs, const Key& rhs) const {
+        return lhs.generation_id == rhs.generation_id &&
+               lhs.fill_type == rhs.fill_type && lhs.scale == rhs.scale;
+      }
+    };
+  };
+
+  TessellationCache();
+
+  ~TessellationCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Round a scale up to the scale paths are flattened at when
+  ///             they are cached. This lets paths whose transform scale
+  ///             changes slightly, such as during an animation, share their
+  ///             triangles without flattening them more coarsely than
+  ///             requested.
+  ///
+  static Scalar QuantizeScale(Scalar scale);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Find the triangles of a path and mark them as the most
+  ///             recently used.
+  ///
+  /// @return     The vertex buffer, or std::nullopt if it isn't cached.
+  ///
+  std::optional<VertexBuffer> Find(const Key& key);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Copy the triangles of a path to a device buffer and cache
+  ///             them, evicting the least recently used entries if the cache
+  ///             grows too large.
+  ///
+  /// @param[in]  key           The key of the path.
+  /// @param[in]  allocator     The allocator to create the device buffer
+  ///                           with.
+  /// @param[in]  points        The vertices of the triangles.
+  /// @param[in]  point_count   The number of vertices.
+  /// @param[in]  indices       The indices of the triangles.
+  /// @param[in]  index_count   The number of indices.
+  ///
+  /// @return     The vertex buffer of the cached triangles, or std::nullopt
+  ///             if they are too large to cache or couldn't be copied.
+  ///
+  std::optional<VertexBuffer> Insert(const Key& key,
+                                     Allocator& allocator,
+                                     const Point* points,
+                                     size_t point_count,
+                                     const uint16_t* indices,
+                                     size_t index_count);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drop all cached triangles, for example because the system is
+  ///             running low on memory.
+  ///
+  void Clear();
+
+  size_t GetEntryCount() const;
+
+  size_t GetCachedBytes() const;
+
+ private:
+  struct Entry {
+    Key key;
+    VertexBuffer vertex_buffer;
+    size_t bytes = 0u;
+  };
+
+  std::list<Entry> entries_;
+  std::unordered_map<Key, std::list<Entry>::iterator, Key::Hash, Key::Equal>
+      entries_by_key_;
+  size_t cached_bytes_ = 0u;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TessellationCache);
+};
+
+}  // namespace impeller
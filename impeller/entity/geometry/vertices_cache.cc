@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/geometry/vertices_cache.h"
+
+#include "impeller/core/device_buffer.h"
+#include "impeller/core/device_buffer_descriptor.h"
+
+namespace impeller {
+
+VerticesCache::VerticesCache() = default;
+
+VerticesCache::~VerticesCache() = default;
+
+std::optional<VertexBuffer> VerticesCache::Find(const Key& key) {
+  auto found = entries_by_key_.find(key);
+  if (found == entries_by_key_.end()) {
+    return std::nullopt;
+  }
+  entries_.splice(entries_.begin(), entries_, found->second);
+  return found->second->vertex_buffer;
+}
+
+std::optional<VertexBuffer> VerticesCache::Insert(const Key& key,
+                                                  Allocator& allocator,
+                                                  const void* vertices,
+                                                  size_t vertex_bytes,
+                                                  size_t vertex_count,
+                                                  const uint16_t* indices,
+                                                  size_t index_count) {
+  const auto index_bytes = index_count * sizeof(uint16_t);
+  const auto bytes = vertex_bytes + index_bytes;
+  if (vertex_count == 0u || bytes > kMaxEntryBytes) {
+    return std::nullopt;
+  }
+
+  DeviceBufferDescriptor desc;
+  desc.storage_mode = StorageMode::kHostVisible;
+  desc.size = bytes;
+  auto buffer = allocator.CreateBuffer(desc);
+  if (!buffer) {
+    return std::nullopt;
+  }
+  // The indices follow the vertices. Every vertex layout is made of floats,
+  // so the indices stay aligned.
+  if (!buffer->CopyHostBuffer(reinterpret_cast<const uint8_t*>(vertices),
+                              Range{0u, vertex_bytes}, 0u)) {
+    return std::nullopt;
+  }
+  if (index_count > 0u &&
+      !buffer->CopyHostBuffer(reinterpret_cast<const uint8_t*>(indices),
+                              Range{0u, index_bytes}, vertex_bytes)) {
+    return std::nullopt;
+  }
+  buffer->SetLabel("Cached Vertices");
+
+  auto view = buffer->AsBufferView();
+  VertexBuffer vertex_buffer;
+  vertex_buffer.vertex_buffer = {view.buffer, view.contents,
+                                 Range{0u, vertex_bytes}};
+  vertex_buffer.index_buffer = {view.buffer, view.contents,
+                                Range{vertex_bytes, index_bytes}};
+  vertex_buffer.vertex_count = index_count > 0u ? index_count : vertex_count;
+  vertex_buffer.index_type =
+      index_count > 0u ? IndexType::k16bit : IndexType::kNone;
+
+  if (auto found = entries_by_key_.find(key); found != entries_by_key_.end()) {
+    cached_bytes_ -= found->second->bytes;
+    entries_.erase(found->second);
+    entries_by_key_.erase(found);
+  }
+  while (!entries_.empty() && cached_bytes_ + bytes > kMaxCacheBytes) {
+    cached_bytes_ -= entries_.back().bytes;
+    entries_by_key_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+  entries_.push_front(Entry{
+      .key = key,
+      .vertex_buffer = vertex_buffer,
+      .bytes = bytes,
+  });
+  entries_by_key_[key] = entries_.begin();
+  cached_bytes_ += bytes;
+  return vertex_buffer;
+}
+
+void VerticesCache::Clear() {
+  entries_by_key_.clear();
+  entries_.clear();
+  cached_bytes_ = 0u;
+}
+
+size_t VerticesCache::GetEntryCount() const {
+  return entries_.size();
+}
+
+size_t VerticesCache::GetCachedBytes() const {
+  return cached_bytes_;
+}
+
+}  // namespace impeller
@@ -0,0 +1,137 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <optional>
+#include <unordered_map>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/macros.h"
+#include "impeller/core/allocator.h"
+#include "impeller/core/vertex_buffer.h"
+#include "impeller/geometry/matrix.h"
+#include "impeller/geometry/rect.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A least recently used cache of the vertex data of vertices
+///             objects, kept in device buffers so that meshes that are drawn
+///             in many frames are only uploaded once.
+///
+///             Only vertices with a unique ID are cached. The contents of
+///             vertices objects never change, so the vertex data only depends
+///             on the layout it is interleaved in and, for texture
+///             coordinates, on the texture they map to.
+///
+/// @see        `flutter::DlVertices::unique_id`
+///
+class VerticesCache {
+ public:
+  /// The most bytes of vertex and index data retained by the cache.
+  static constexpr size_t kMaxCacheBytes = 8u * 1024u * 1024u;
+
+  /// Vertices whose data take more bytes than this aren't cached.
+  static constexpr size_t kMaxEntryBytes = 1024u * 1024u;
+
+  enum class Layout {
+    kPosition,
+    kPositionColor,
+    kPositionUV,
+  };
+
+  struct Key {
+    uint32_t unique_id = 0u;
+    Layout layout = Layout::kPosition;
+    /// Only used by the `kPositionUV` layout.
+    Rect texture_coverage;
+    /// Only used by the `kPositionUV` layout.
+    Matrix effect_transform;
+
+    struct Hash {
+      std::size_t operator()(const Key& key) const {
+        return fml::HashCombine(key.unique_id, static_cast<int>(key.layout),
+                                key.texture_coverage.origin.x,
+                                key.texture_coverage.origin.y,
+                                key.texture_coverage.size.width,
+                                key.texture_coverage.size.height);
+      }
+    };
+
+    struct Equal {
+      bool operator()(const Key& lhs, const Key& rhs) const {
+        return lhs.unique_id == rhs.unique_id && lhs.layout == rhs.layout &&
+               lhs.texture_coverage == rhs.texture_coverage &&
+               lhs.effect_transform == rhs.effect_transform;
+      }
+    };
+  };
+
+  VerticesCache();
+
+  ~VerticesCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Find the vertex data of a vertices object and mark it as the
+  ///             most recently used.
+  ///
+  /// @return     The vertex buffer, or std::nullopt if it isn't cached.
+  ///
+  std::optional<VertexBuffer> Find(const Key& key);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Copy the vertex data of a vertices object to a device buffer
+  ///             and cache it, evicting the least recently used entries if
+  ///             the cache grows too large.
+  ///
+  /// @param[in]  key           The key of the vertices.
+  /// @param[in]  allocator     The allocator to create the device buffer
+  ///                           with.
+  /// @param[in]  vertices      The interleaved vertex data.
+  /// @param[in]  vertex_bytes  The size of the vertex data in bytes.
+  /// @param[in]  vertex_count  The number of vertices.
+  /// @param[in]  indices       The indices of the triangles, if any.
+  /// @param[in]  index_count   The number of indices, or 0 if the vertices
+  ///                           aren't indexed.
+  ///
+  /// @return     The vertex buffer of the cached data, or std::nullopt if it
+  ///             is too large to cache or couldn't be copied.
+  ///
+  std::optional<VertexBuffer> Insert(const Key& key,
+                                     Allocator& allocator,
+                                     const void* vertices,
+                                     size_t vertex_bytes,
+                                     size_t vertex_count,
+                                     const uint16_t* indices,
+                                     size_t index_count);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drop all cached vertex data, for example because the system
+  ///             is running low on memory.
+  ///
+  void Clear();
+
+  size_t GetEntryCount() const;
+
+  size_t GetCachedBytes() const;
+
+ private:
+  struct Entry {
+    Key key;
+    VertexBuffer vertex_buffer;
+    size_t bytes = 0u;
+  };
+
+  std::list<Entry> entries_;
+  std::unordered_map<Key, std::list<Entry>::iterator, Key::Hash, Key::Equal>
+      entries_by_key_;
+  size_t cached_bytes_ = 0u;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(VerticesCache);
+};
+
+}  // namespace impeller
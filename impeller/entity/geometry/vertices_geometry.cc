@@ -57,13 +57,15 @@ VerticesGeometry::VerticesGeometry(std::vector<Point> vertices,
                                    std::vector<Point> texture_coordinates,
                                    std::vector<Color> colors,
                                    Rect bounds,
-                                   VertexMode vertex_mode)
+                                   VertexMode vertex_mode,
+                                   uint32_t unique_id)
     : vertices_(std::move(vertices)),
       colors_(std::move(colors)),
       texture_coordinates_(std::move(texture_coordinates)),
       indices_(std::move(indices)),
       bounds_(bounds),
-      vertex_mode_(vertex_mode) {
+      vertex_mode_(vertex_mode),
+      unique_id_(unique_id) {
   NormalizeIndices();
 }
 
@@ -110,61 +112,117 @@ std::optional<Rect> VerticesGeometry::GetTextureCoordinateCoverge() const {
                                texture_coordinates_.end());
 }
 
-GeometryResult VerticesGeometry::GetPositionBuffer(
+std::optional<VerticesCache::Key> VerticesGeometry::GetCacheKey(
+    VerticesCache::Layout layout,
+    Rect texture_coverage,
+    Matrix effect_transform) const {
+  if (unique_id_ == 0u) {
+    return std::nullopt;
+  }
+  return VerticesCache::Key{
+      .unique_id = unique_id_,
+      .layout = layout,
+      .texture_coverage = texture_coverage,
+      .effect_transform = effect_transform,
+  };
+}
+
+std::optional<VertexBuffer> VerticesGeometry::CreateVertexBuffer(
     const ContentContext& renderer,
-    const Entity& entity,
-    RenderPass& pass) {
+    const std::optional<VerticesCache::Key>& cache_key,
+    const void* vertex_data,
+    size_t vertex_bytes) const {
+  auto& allocator = *renderer.GetContext()->GetResourceAllocator();
   auto index_count = indices_.size();
   auto vertex_count = vertices_.size();
 
-  size_t total_vtx_bytes = vertex_count * sizeof(float) * 2;
+  if (cache_key.has_value()) {
+    if (auto cached = renderer.GetVerticesCache()->Insert(
+            cache_key.value(), allocator, vertex_data, vertex_bytes,
+            vertex_count, indices_.data(), index_count);
+        cached.has_value()) {
+      return cached;
+    }
+  }
+
   size_t total_idx_bytes = index_count * sizeof(uint16_t);
 
   DeviceBufferDescriptor buffer_desc;
-  buffer_desc.size = total_vtx_bytes + total_idx_bytes;
+  buffer_desc.size = vertex_bytes + total_idx_bytes;
   buffer_desc.storage_mode = StorageMode::kHostVisible;
 
-  auto buffer =
-      renderer.GetContext()->GetResourceAllocator()->CreateBuffer(buffer_desc);
+  auto buffer = allocator.CreateBuffer(buffer_desc);
+  if (!buffer) {
+    return std::nullopt;
+  }
 
-  if (!buffer->CopyHostBuffer(
-          reinterpret_cast<const uint8_t*>(vertices_.data()),
-          Range{0, total_vtx_bytes}, 0)) {
-    return {};
+  if (!buffer->CopyHostBuffer(reinterpret_cast<const uint8_t*>(vertex_data),
+                              Range{0, vertex_bytes}, 0)) {
+    return std::nullopt;
   }
-  if (index_count > 0 &&
+  if (index_count > 0u &&
       !buffer->CopyHostBuffer(
-          reinterpret_cast<uint8_t*>(const_cast<uint16_t*>(indices_.data())),
-          Range{0, total_idx_bytes}, total_vtx_bytes)) {
-    return {};
+          reinterpret_cast<const uint8_t*>(indices_.data()),
+          Range{0, total_idx_bytes}, vertex_bytes)) {
+    return std::nullopt;
   }
 
+  return VertexBuffer{
+      .vertex_buffer = {.buffer = buffer, .range = Range{0, vertex_bytes}},
+      .index_buffer = {.buffer = buffer,
+                       .range = Range{vertex_bytes, total_idx_bytes}},
+      .vertex_count = index_count > 0 ? index_count : vertex_count,
+      .index_type = index_count > 0 ? IndexType::k16bit : IndexType::kNone,
+  };
+}
+
+GeometryResult VerticesGeometry::CreateResult(const VertexBuffer& vertex_buffer,
+                                              const Entity& entity,
+                                              RenderPass& pass) const {
   return GeometryResult{
       .type = GetPrimitiveType(),
-      .vertex_buffer =
-          {
-              .vertex_buffer = {.buffer = buffer,
-                                .range = Range{0, total_vtx_bytes}},
-              .index_buffer = {.buffer = buffer,
-                               .range =
-                                   Range{total_vtx_bytes, total_idx_bytes}},
-              .vertex_count = index_count > 0 ? index_count : vertex_count,
-              .index_type =
-                  index_count > 0 ? IndexType::k16bit : IndexType::kNone,
-          },
+      .vertex_buffer = vertex_buffer,
       .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
                    entity.GetTransformation(),
       .prevent_overdraw = false,
   };
 }
 
+GeometryResult VerticesGeometry::GetPositionBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) {
+  auto cache_key = GetCacheKey(VerticesCache::Layout::kPosition);
+  if (cache_key.has_value()) {
+    if (auto cached = renderer.GetVerticesCache()->Find(cache_key.value());
+        cached.has_value()) {
+      return CreateResult(cached.value(), entity, pass);
+    }
+  }
+
+  auto vertex_buffer =
+      CreateVertexBuffer(renderer, cache_key, vertices_.data(),
+                         vertices_.size() * sizeof(Point));
+  if (!vertex_buffer.has_value()) {
+    return {};
+  }
+  return CreateResult(vertex_buffer.value(), entity, pass);
+}
+
 GeometryResult VerticesGeometry::GetPositionColorBuffer(
     const ContentContext& renderer,
     const Entity& entity,
     RenderPass& pass) {
   using VS = GeometryColorPipeline::VertexShader;
 
-  auto index_count = indices_.size();
+  auto cache_key = GetCacheKey(VerticesCache::Layout::kPositionColor);
+  if (cache_key.has_value()) {
+    if (auto cached = renderer.GetVerticesCache()->Find(cache_key.value());
+        cached.has_value()) {
+      return CreateResult(cached.value(), entity, pass);
+    }
+  }
+
   auto vertex_count = vertices_.size();
 
   std::vector<VS::PerVertexData> vertex_data(vertex_count);
@@ -177,44 +235,13 @@ GeometryResult VerticesGeometry::GetPositionColorBuffer(
     }
   }
 
-  size_t total_vtx_bytes = vertex_data.size() * sizeof(VS::PerVertexData);
-  size_t total_idx_bytes = index_count * sizeof(uint16_t);
-
-  DeviceBufferDescriptor buffer_desc;
-  buffer_desc.size = total_vtx_bytes + total_idx_bytes;
-  buffer_desc.storage_mode = StorageMode::kHostVisible;
-
-  auto buffer =
-      renderer.GetContext()->GetResourceAllocator()->CreateBuffer(buffer_desc);
-
-  if (!buffer->CopyHostBuffer(reinterpret_cast<uint8_t*>(vertex_data.data()),
-                              Range{0, total_vtx_bytes}, 0)) {
+  auto vertex_buffer =
+      CreateVertexBuffer(renderer, cache_key, vertex_data.data(),
+                         vertex_data.size() * sizeof(VS::PerVertexData));
+  if (!vertex_buffer.has_value()) {
     return {};
   }
-  if (index_count > 0 &&
-      !buffer->CopyHostBuffer(
-          reinterpret_cast<uint8_t*>(const_cast<uint16_t*>(indices_.data())),
-          Range{0, total_idx_bytes}, total_vtx_bytes)) {
-    return {};
-  }
-
-  return GeometryResult{
-      .type = GetPrimitiveType(),
-      .vertex_buffer =
-          {
-              .vertex_buffer = {.buffer = buffer,
-                                .range = Range{0, total_vtx_bytes}},
-              .index_buffer = {.buffer = buffer,
-                               .range =
-                                   Range{total_vtx_bytes, total_idx_bytes}},
-              .vertex_count = index_count > 0 ? index_count : vertex_count,
-              .index_type =
-                  index_count > 0 ? IndexType::k16bit : IndexType::kNone,
-          },
-      .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
-                   entity.GetTransformation(),
-      .prevent_overdraw = false,
-  };
+  return CreateResult(vertex_buffer.value(), entity, pass);
 }
 
 GeometryResult VerticesGeometry::GetPositionUVBuffer(
@@ -225,7 +252,15 @@ GeometryResult VerticesGeometry::GetPositionUVBuffer(
     RenderPass& pass) {
   using VS = TexturePipeline::VertexShader;
 
-  auto index_count = indices_.size();
+  auto cache_key = GetCacheKey(VerticesCache::Layout::kPositionUV,
+                               texture_coverage, effect_transform);
+  if (cache_key.has_value()) {
+    if (auto cached = renderer.GetVerticesCache()->Find(cache_key.value());
+        cached.has_value()) {
+      return CreateResult(cached.value(), entity, pass);
+    }
+  }
+
   auto vertex_count = vertices_.size();
   auto size = texture_coverage.size;
   auto origin = texture_coverage.origin;
@@ -248,44 +283,13 @@ GeometryResult VerticesGeometry::GetPositionUVBuffer(
     }
   }
 
-  size_t total_vtx_bytes = vertex_data.size() * sizeof(VS::PerVertexData);
-  size_t total_idx_bytes = index_count * sizeof(uint16_t);
-
-  DeviceBufferDescriptor buffer_desc;
-  buffer_desc.size = total_vtx_bytes + total_idx_bytes;
-  buffer_desc.storage_mode = StorageMode::kHostVisible;
-
-  auto buffer =
-      renderer.GetContext()->GetResourceAllocator()->CreateBuffer(buffer_desc);
-
-  if (!buffer->CopyHostBuffer(reinterpret_cast<uint8_t*>(vertex_data.data()),
-                              Range{0, total_vtx_bytes}, 0)) {
-    return {};
-  }
-  if (index_count > 0u &&
-      !buffer->CopyHostBuffer(
-          reinterpret_cast<uint8_t*>(const_cast<uint16_t*>(indices_.data())),
-          Range{0, total_idx_bytes}, total_vtx_bytes)) {
+  auto vertex_buffer =
+      CreateVertexBuffer(renderer, cache_key, vertex_data.data(),
+                         vertex_data.size() * sizeof(VS::PerVertexData));
+  if (!vertex_buffer.has_value()) {
     return {};
   }
-
-  return GeometryResult{
-      .type = GetPrimitiveType(),
-      .vertex_buffer =
-          {
-              .vertex_buffer = {.buffer = buffer,
-                                .range = Range{0, total_vtx_bytes}},
-              .index_buffer = {.buffer = buffer,
-                               .range =
-                                   Range{total_vtx_bytes, total_idx_bytes}},
-              .vertex_count = index_count > 0 ? index_count : vertex_count,
-              .index_type =
-                  index_count > 0 ? IndexType::k16bit : IndexType::kNone,
-          },
-      .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
-                   entity.GetTransformation(),
-      .prevent_overdraw = false,
-  };
+  return CreateResult(vertex_buffer.value(), entity, pass);
 }
 
 GeometryVertexType VerticesGeometry::GetVertexType() const {
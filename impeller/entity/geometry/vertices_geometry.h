@@ -4,11 +4,18 @@
 
 #pragma once
 
+#include <optional>
+
 #include "impeller/entity/geometry/geometry.h"
+#include "impeller/entity/geometry/vertices_cache.h"
 
 namespace impeller {
 
 /// @brief A geometry that is created from a vertices object.
+///
+/// Geometries with a unique ID keep their vertex data in the vertices cache of
+/// the content context, so that vertices drawn in many frames are uploaded
+/// once. Geometries with the same unique ID must have the same contents.
 class VerticesGeometry : public Geometry {
  public:
   enum class VertexMode {
@@ -22,7 +29,8 @@ class VerticesGeometry : public Geometry {
                    std::vector<Point> texture_coordinates,
                    std::vector<Color> colors,
                    Rect bounds,
-                   VerticesGeometry::VertexMode vertex_mode);
+                   VerticesGeometry::VertexMode vertex_mode,
+                   uint32_t unique_id = 0u);
 
   ~VerticesGeometry();
 
@@ -59,6 +67,23 @@ class VerticesGeometry : public Geometry {
 
   PrimitiveType GetPrimitiveType() const;
 
+  std::optional<VerticesCache::Key> GetCacheKey(
+      VerticesCache::Layout layout,
+      Rect texture_coverage = {},
+      Matrix effect_transform = {}) const;
+
+  /// Copy the vertex data and the indices to a device buffer, which is cached
+  /// if there is a cache key.
+  std::optional<VertexBuffer> CreateVertexBuffer(
+      const ContentContext& renderer,
+      const std::optional<VerticesCache::Key>& cache_key,
+      const void* vertex_data,
+      size_t vertex_bytes) const;
+
+  GeometryResult CreateResult(const VertexBuffer& vertex_buffer,
+                              const Entity& entity,
+                              RenderPass& pass) const;
+
   std::vector<Point> vertices_;
   std::vector<Color> colors_;
   std::vector<Point> texture_coordinates_;
@@ -66,6 +91,7 @@ class VerticesGeometry : public Geometry {
   Rect bounds_;
   VerticesGeometry::VertexMode vertex_mode_ =
       VerticesGeometry::VertexMode::kTriangles;
+  uint32_t unique_id_ = 0u;
 };
 
 }  // namespace impeller
@@ -22,6 +22,7 @@ class InlinePassContext {
       std::shared_ptr<Context> context,
       EntityPassTarget& pass_target,
       uint32_t pass_texture_reads,
+      std::shared_ptr<HostBuffer> transients_buffer,
       std::optional<RenderPassResult> collapsed_parent_pass = std::nullopt);
   ~InlinePassContext();
 
@@ -37,6 +38,7 @@ class InlinePassContext {
  private:
   std::shared_ptr<Context> context_;
   EntityPassTarget& pass_target_;
+  std::shared_ptr<HostBuffer> transients_buffer_;
   std::shared_ptr<CommandBuffer> command_buffer_;
   std::shared_ptr<RenderPass> pass_;
   uint32_t pass_count_ = 0;
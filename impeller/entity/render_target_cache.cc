@@ -3,6 +3,9 @@
 // found in the LICENSE file.
 
 #include "impeller/entity/render_target_cache.h"
+
+#include <algorithm>
+
 #include "impeller/renderer/render_target.h"
 
 namespace impeller {
@@ -17,6 +20,13 @@ void RenderTargetCache::Start() {
 }
 
 void RenderTargetCache::End() {
+  if (GetAllocator()->IsNearMemoryBudget()) {
+    // Let the allocator have back the memory of the textures that aren't in
+    // use anymore, even if they would be used again next frame.
+    texture_data_.clear();
+    return;
+  }
+
   std::vector<TextureData> retain;
 
   for (const auto& td : texture_data_) {
@@ -27,6 +37,19 @@ void RenderTargetCache::End() {
   texture_data_.swap(retain);
 }
 
+void RenderTargetCache::Clear() {
+  texture_data_.clear();
+}
+
+void RenderTargetCache::Detach(const std::shared_ptr<Texture>& texture) {
+  texture_data_.erase(
+      std::remove_if(texture_data_.begin(), texture_data_.end(),
+                     [&texture](const TextureData& td) {
+                       return td.texture == texture;
+                     }),
+      texture_data_.end());
+}
+
 size_t RenderTargetCache::CachedTextureCount() const {
   return texture_data_.size();
 }
@@ -39,7 +62,10 @@ std::shared_ptr<Texture> RenderTargetCache::CreateTexture(
 
   for (auto& td : texture_data_) {
     const auto other_desc = td.texture->GetTextureDescriptor();
-    if (!td.used_this_frame && desc == other_desc) {
+    // A texture used earlier this frame is free once the cache holds the only
+    // reference to it.
+    const bool is_free = !td.used_this_frame || td.texture.use_count() == 1;
+    if (is_free && desc == other_desc) {
       td.used_this_frame = true;
       return td.texture;
     }
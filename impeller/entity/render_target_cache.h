@@ -11,7 +11,20 @@ namespace impeller {
 /// @brief An implementation of the [RenderTargetAllocator] that caches all
 ///        allocated texture data for one frame.
 ///
-///        Any textures unused after a frame are immediately discarded.
+///        Any textures unused after a frame are immediately discarded. The
+///        Vulkan allocator keeps the images backing discarded textures for a
+///        few more frames, so render targets that come and go between frames
+///        are still cheap to recreate.
+///
+///        Textures are also reused within a frame once nothing but the cache
+///        refers to them anymore. Render targets of passes whose lifetimes
+///        don't overlap, like the subpasses of successive filters, then share
+///        the same textures. The backends order the work of the passes that
+///        refer to the same texture, and keep textures referred to by work
+///        pending on the GPU alive.
+///
+///        Nothing is kept past the end of a frame while the allocator is near
+///        its memory budget.
 class RenderTargetCache : public RenderTargetAllocator {
  public:
   explicit RenderTargetCache(std::shared_ptr<Allocator> allocator);
@@ -24,6 +37,12 @@ class RenderTargetCache : public RenderTargetAllocator {
   // |RenderTargetAllocator|
   void End() override;
 
+  // |RenderTargetAllocator|
+  void Clear() override;
+
+  // |RenderTargetAllocator|
+  void Detach(const std::shared_ptr<Texture>& texture) override;
+
   // |RenderTargetAllocator|
   std::shared_ptr<Texture> CreateTexture(
       const TextureDescriptor& desc) override;
@@ -32,6 +32,10 @@ class TestAllocator : public Allocator {
       const TextureDescriptor& desc) override {
     return std::make_shared<MockTexture>(desc);
   };
+
+  bool IsNearMemoryBudget() const override { return is_near_memory_budget; }
+
+  bool is_near_memory_budget = false;
 };
 
 TEST(RenderTargetCacheTest, CachesUsedTexturesAcrossFrames) {
@@ -43,23 +47,121 @@ TEST(RenderTargetCacheTest, CachesUsedTexturesAcrossFrames) {
       .usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget)};
 
   render_target_cache.Start();
-  // Create two textures of the same exact size/shape. Both should be marked
-  // as used this frame, so the cached data set will contain two.
-  render_target_cache.CreateTexture(desc);
-  render_target_cache.CreateTexture(desc);
+  // Create two textures of the same exact size/shape that are alive at the
+  // same time. Both should be marked as used this frame, so the cached data
+  // set will contain two.
+  auto texture_a = render_target_cache.CreateTexture(desc);
+  auto texture_b = render_target_cache.CreateTexture(desc);
 
   ASSERT_EQ(render_target_cache.CachedTextureCount(), 2u);
 
+  texture_a.reset();
+  texture_b.reset();
   render_target_cache.End();
   render_target_cache.Start();
 
   // Next frame, only create one texture. The set will still contain two,
   // but one will be removed at the end of the frame.
-  render_target_cache.CreateTexture(desc);
+  auto texture_c = render_target_cache.CreateTexture(desc);
+  ASSERT_EQ(render_target_cache.CachedTextureCount(), 2u);
+
+  render_target_cache.End();
+  ASSERT_EQ(render_target_cache.CachedTextureCount(), 1u);
+}
+
+TEST(RenderTargetCacheTest, ReusesReleasedTexturesWithinFrame) {
+  auto allocator = std::make_shared<TestAllocator>();
+  auto render_target_cache = RenderTargetCache(allocator);
+  auto desc = TextureDescriptor{
+      .format = PixelFormat::kR8G8B8A8UNormInt,
+      .size = ISize(100, 100),
+      .usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget)};
+
+  render_target_cache.Start();
+  auto first = render_target_cache.CreateTexture(desc);
+  auto first_raw = first.get();
+  first.reset();
+
+  // The first texture is no longer referred to, so it is reused.
+  auto second = render_target_cache.CreateTexture(desc);
+  ASSERT_EQ(second.get(), first_raw);
+  ASSERT_EQ(render_target_cache.CachedTextureCount(), 1u);
+
+  // The second texture is still referred to, so a new one is created.
+  auto third = render_target_cache.CreateTexture(desc);
+  ASSERT_NE(third.get(), second.get());
+  ASSERT_EQ(render_target_cache.CachedTextureCount(), 2u);
+
+  render_target_cache.End();
   ASSERT_EQ(render_target_cache.CachedTextureCount(), 2u);
+}
+
+TEST(RenderTargetCacheTest, ClearDropsCachedTextures) {
+  auto allocator = std::make_shared<TestAllocator>();
+  auto render_target_cache = RenderTargetCache(allocator);
+  auto desc = TextureDescriptor{
+      .format = PixelFormat::kR8G8B8A8UNormInt,
+      .size = ISize(100, 100),
+      .usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget)};
+
+  render_target_cache.Start();
+  auto texture = render_target_cache.CreateTexture(desc);
+  texture.reset();
+  render_target_cache.End();
+  ASSERT_EQ(render_target_cache.CachedTextureCount(), 1u);
+
+  render_target_cache.Clear();
+  ASSERT_EQ(render_target_cache.CachedTextureCount(), 0u);
+
+  // Textures are cached again from the next frame on.
+  render_target_cache.Start();
+  auto next = render_target_cache.CreateTexture(desc);
+  ASSERT_NE(next, nullptr);
+  ASSERT_EQ(render_target_cache.CachedTextureCount(), 1u);
+}
+
+TEST(RenderTargetCacheTest, KeepsNothingNearMemoryBudget) {
+  auto allocator = std::make_shared<TestAllocator>();
+  auto render_target_cache = RenderTargetCache(allocator);
+  auto desc = TextureDescriptor{
+      .format = PixelFormat::kR8G8B8A8UNormInt,
+      .size = ISize(100, 100),
+      .usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget)};
 
+  render_target_cache.Start();
+  auto texture = render_target_cache.CreateTexture(desc);
+  allocator->is_near_memory_budget = true;
   render_target_cache.End();
+  ASSERT_EQ(render_target_cache.CachedTextureCount(), 0u);
+
+  // Textures still in use stay alive, but aren't recycled anymore.
+  render_target_cache.Start();
+  texture.reset();
+  EXPECT_TRUE(render_target_cache.CreateTexture(desc));
   ASSERT_EQ(render_target_cache.CachedTextureCount(), 1u);
+  render_target_cache.End();
+  ASSERT_EQ(render_target_cache.CachedTextureCount(), 0u);
+}
+
+TEST(RenderTargetCacheTest, DoesNotRecycleDetachedTextures) {
+  auto allocator = std::make_shared<TestAllocator>();
+  auto render_target_cache = RenderTargetCache(allocator);
+  auto desc = TextureDescriptor{
+      .format = PixelFormat::kR8G8B8A8UNormInt,
+      .size = ISize(100, 100),
+      .usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget)};
+
+  render_target_cache.Start();
+  auto detached = render_target_cache.CreateTexture(desc);
+  render_target_cache.Detach(detached);
+  ASSERT_EQ(render_target_cache.CachedTextureCount(), 0u);
+  render_target_cache.End();
+
+  // The detached texture is still in use by its owner next frame.
+  render_target_cache.Start();
+  auto next = render_target_cache.CreateTexture(desc);
+  ASSERT_NE(next, detached);
+  render_target_cache.End();
 }
 
 }  // namespace testing
@@ -9,7 +9,9 @@
 #include <impeller/texture.glsl>
 #include <impeller/types.glsl>
 
-#ifdef IMPELLER_TARGET_METAL
+#if defined(IMPELLER_TARGET_METAL) || defined(IMPELLER_TARGET_OPENGLES)
+// On OpenGL ES, impellerc reads subpass inputs with
+// EXT_shader_framebuffer_fetch.
 layout(set = 0,
        binding = 0,
        input_attachment_index = 0) uniform subpassInput uSub;
@@ -0,0 +1,32 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+precision mediump float;
+
+#include <impeller/types.glsl>
+
+// Renders glyphs from a signed distance field atlas. The edge of the glyph is
+// at a distance of 0.5 and is anti-aliased over the distance covered by one
+// screen pixel.
+
+uniform f16sampler2D glyph_atlas_sampler;
+
+uniform FragInfo {
+  // Half of the change in distance from one screen pixel to the next.
+  float edge_width;
+}
+frag_info;
+
+in highp vec2 v_uv;
+
+IMPELLER_MAYBE_FLAT in f16vec4 v_text_color;
+
+out f16vec4 frag_color;
+
+void main() {
+  float distance = texture(glyph_atlas_sampler, v_uv).a;
+  float16_t alpha = float16_t(smoothstep(0.5 - frag_info.edge_width,
+                                         0.5 + frag_info.edge_width, distance));
+  frag_color = v_text_color * alpha;
+}
@@ -10,8 +10,8 @@ precision highp float;
 uniform FragInfo {
   f16vec4 color;
   vec2 rect_size;
+  vec2 corner_radii;
   float blur_sigma;
-  float corner_radius;
 }
 frag_info;
 
@@ -22,22 +22,31 @@ out f16vec4 frag_color;
 const int kSampleCount = 4;
 
 float16_t RRectDistance(vec2 sample_position, vec2 half_size) {
-  vec2 space = abs(sample_position) - half_size + frag_info.corner_radius;
+  // Stretch the Y axis so that elliptical corners become circular. This isn't
+  // an exact distance for ovals, but it's only used for the antialiased edge.
+  float y_scale = frag_info.corner_radii.y > 0.0
+                      ? frag_info.corner_radii.x / frag_info.corner_radii.y
+                      : 1.0;
+  sample_position.y *= y_scale;
+  half_size.y *= y_scale;
+  float corner_radius = frag_info.corner_radii.x;
+
+  vec2 space = abs(sample_position) - half_size + corner_radius;
   return float16_t(length(max(space, 0.0)) + min(max(space.x, space.y), 0.0) -
-                   frag_info.corner_radius);
+                   corner_radius);
 }
 
 /// Closed form unidirectional rounded rect blur mask solution using the
 /// analytical Gaussian integral (with approximated erf).
 float RRectBlurX(vec2 sample_position, vec2 half_size) {
   // Compute the X direction distance field (not incorporating the Y distance)
-  // for the rounded rect.
-  float space =
-      min(0.0, half_size.y - frag_info.corner_radius - abs(sample_position.y));
-  float rrect_distance =
-      half_size.x - frag_info.corner_radius +
-      sqrt(max(0.0, frag_info.corner_radius * frag_info.corner_radius -
-                        space * space));
+  // for the rounded rect. The corners are elliptical, which also covers ovals
+  // with radii of half the rect size.
+  vec2 radii = frag_info.corner_radii;
+  float space = min(0.0, half_size.y - radii.y - abs(sample_position.y));
+  float corner_y = radii.y > 0.0 ? space / radii.y : 0.0;
+  float rrect_distance = half_size.x - radii.x +
+                         radii.x * sqrt(max(0.0, 1.0 - corner_y * corner_y));
 
   // Map the linear distance field to the approximate Gaussian integral.
   vec2 integral = IPVec2FastGaussianIntegral(
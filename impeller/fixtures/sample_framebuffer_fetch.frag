@@ -0,0 +1,13 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+layout(set = 0,
+       binding = 0,
+       input_attachment_index = 0) uniform subpassInput destination;
+
+out vec4 frag_color;
+
+void main() {
+  frag_color = subpassLoad(destination) * 0.5;
+}
@@ -4,8 +4,11 @@
 
 #include "flutter/benchmarking/benchmarking.h"
 
+#include "impeller/geometry/constants.h"
+#include "impeller/geometry/matrix.h"
 #include "impeller/geometry/path.h"
 #include "impeller/geometry/path_builder.h"
+#include "impeller/geometry/rect.h"
 #include "impeller/tessellator/tessellator.h"
 
 namespace impeller {
@@ -48,6 +51,79 @@ BENCHMARK_CAPTURE(BM_Polyline, cubic_polyline_tess, CreateCubic(), true);
 BENCHMARK_CAPTURE(BM_Polyline, quad_polyline, CreateQuadratic(), false);
 BENCHMARK_CAPTURE(BM_Polyline, quad_polyline_tess, CreateQuadratic(), true);
 
+// Like |BM_Polyline|, but flattens into the tessellator's reused storage, as
+// the path geometries do.
+static void BM_TempPolyline(benchmark::State& state, const Path& path) {
+  size_t point_count = 0u;
+  for ([[maybe_unused]] auto _ : state) {
+    point_count += tess.CreateTempPolyline(path, 1.0f).points.size();
+  }
+  state.counters["TotalPointCount"] = point_count;
+}
+
+BENCHMARK_CAPTURE(BM_TempPolyline, cubic_polyline, CreateCubic());
+BENCHMARK_CAPTURE(BM_TempPolyline, quad_polyline, CreateQuadratic());
+
+static Matrix CreateTranslateScale() {
+  return Matrix::MakeTranslation({100, 200}) * Matrix::MakeScale(Vector2{2, 3});
+}
+
+static Matrix CreateRotation() {
+  return Matrix::MakeTranslation({100, 200}) *
+         Matrix::MakeRotationZ(Radians{kPiOver4});
+}
+
+static Matrix CreatePerspective() {
+  return Matrix::MakePerspective(Radians{kPiOver4}, 1.0f, 1, 100) *
+         CreateRotation();
+}
+
+static void BM_MatrixMultiply(benchmark::State& state, Matrix matrix) {
+  Matrix result;
+  for ([[maybe_unused]] auto _ : state) {
+    result = result * matrix;
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+static void BM_MatrixInvert(benchmark::State& state, Matrix matrix) {
+  for ([[maybe_unused]] auto _ : state) {
+    auto inverse = matrix.Invert();
+    benchmark::DoNotOptimize(inverse);
+  }
+}
+
+static void BM_RectTransformBounds(benchmark::State& state, Matrix matrix) {
+  auto rect = Rect::MakeXYWH(10, 20, 300, 400);
+  for ([[maybe_unused]] auto _ : state) {
+    auto bounds = rect.TransformBounds(matrix);
+    benchmark::DoNotOptimize(bounds);
+  }
+}
+
+static void BM_RectUnionAndIntersection(benchmark::State& state) {
+  auto a = Rect::MakeXYWH(10, 20, 300, 400);
+  auto b = Rect::MakeXYWH(100, 200, 300, 400);
+  for ([[maybe_unused]] auto _ : state) {
+    auto union_rect = a.Union(b);
+    auto intersection = a.Intersection(b);
+    benchmark::DoNotOptimize(union_rect);
+    benchmark::DoNotOptimize(intersection);
+  }
+}
+
+BENCHMARK_CAPTURE(BM_MatrixMultiply, translate_scale, CreateTranslateScale());
+BENCHMARK_CAPTURE(BM_MatrixMultiply, perspective, CreatePerspective());
+BENCHMARK_CAPTURE(BM_MatrixInvert, translate_scale, CreateTranslateScale());
+BENCHMARK_CAPTURE(BM_MatrixInvert, rotation, CreateRotation());
+BENCHMARK_CAPTURE(BM_MatrixInvert, perspective, CreatePerspective());
+BENCHMARK_CAPTURE(BM_RectTransformBounds,
+                  translate_scale,
+                  CreateTranslateScale());
+BENCHMARK_CAPTURE(BM_RectTransformBounds, rotation, CreateRotation());
+BENCHMARK_CAPTURE(BM_RectTransformBounds, perspective, CreatePerspective());
+BENCHMARK(BM_RectUnionAndIntersection);
+
 namespace {
 Path CreateCubic() {
   return PathBuilder{}
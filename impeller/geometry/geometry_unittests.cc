@@ -5,6 +5,7 @@
 #include "gtest/gtest.h"
 #include "impeller/geometry/geometry_asserts.h"
 
+#include <algorithm>
 #include <limits>
 #include <sstream>
 #include <type_traits>
@@ -96,6 +97,14 @@ TEST(GeometryTest, InvertMultMatrix) {
   }
 }
 
+TEST(GeometryTest, InvertTranslationScaleMatrix) {
+  auto matrix = Matrix::MakeTranslation({100, -50, 4}) *
+                Matrix::MakeScale(Vector3{2, -4, 8});
+  ASSERT_TRUE(matrix.IsTranslationScaleOnly());
+  ASSERT_MATRIX_NEAR(matrix * matrix.Invert(), Matrix{});
+  ASSERT_MATRIX_NEAR(matrix.Invert() * matrix, Matrix{});
+}
+
 TEST(GeometryTest, MatrixBasis) {
   auto matrix = Matrix{1,  2,  3,  4,   //
                        5,  6,  7,  8,   //
@@ -1898,6 +1907,16 @@ TEST(GeometryTest, RectGetTransformedPoints) {
   ASSERT_POINT_NEAR(points[3], Point(410, 620));
 }
 
+TEST(GeometryTest, RectTransformBounds) {
+  Rect r = Rect::MakeLTRB(100, 200, 300, 400);
+  ASSERT_RECT_NEAR(r.TransformBounds(Matrix::MakeTranslation({10, 20}) *
+                                     Matrix::MakeScale(Vector2{-2, 3})),
+                   Rect::MakeLTRB(-590, 620, -190, 1220));
+  ASSERT_RECT_NEAR(
+      r.TransformBounds(Matrix::MakeRotationZ(Radians{kPiOver2})),
+      Rect::MakeLTRB(-400, 100, -200, 300));
+}
+
 TEST(GeometryTest, RectMakePointBounds) {
   {
     std::vector<Point> points{{1, 5}, {4, -1}, {0, 6}};
@@ -2185,6 +2204,111 @@ TEST(GeometryTest, PathPolylineDuplicatesAreRemovedForSameContour) {
   ASSERT_EQ(polyline.points[6], Point(0, 100));
 }
 
+TEST(GeometryTest, PathCreatePolylineReusesProvidedStorage) {
+  Path curves = PathBuilder{}
+                    .MoveTo({0, 0})
+                    .CubicCurveTo({0, 100}, {100, 100}, {100, 0})
+                    .QuadraticCurveTo({150, 100}, {200, 0})
+                    .LineTo({200, 0})  // Duplicate of the last curve point.
+                    .Close()
+                    .AddCircle({300, 300}, 50)
+                    .TakePath();
+  Path::Polyline expected = curves.CreatePolyline(2.0f);
+
+  Path::Polyline polyline;
+  curves.CreatePolyline(2.0f, polyline);
+  ASSERT_EQ(polyline.points, expected.points);
+  ASSERT_EQ(polyline.contours.size(), expected.contours.size());
+  for (size_t i = 0; i < expected.contours.size(); i++) {
+    ASSERT_EQ(polyline.contours[i].start_index,
+              expected.contours[i].start_index);
+    ASSERT_EQ(polyline.contours[i].is_closed, expected.contours[i].is_closed);
+    ASSERT_EQ(polyline.contours[i].components.size(),
+              expected.contours[i].components.size());
+  }
+
+  // Reusing the polyline for a smaller path discards the old contents but
+  // keeps the allocation.
+  auto capacity = polyline.points.capacity();
+  PathBuilder{}
+      .AddRect(Rect::MakeLTRB(50, 60, 70, 80))
+      .TakePath()
+      .CreatePolyline(1.0f, polyline);
+  ASSERT_EQ(polyline.contours.size(), 1u);
+  ASSERT_EQ(polyline.points.size(), 5u);
+  ASSERT_EQ(polyline.points[0], Point(50, 60));
+  ASSERT_EQ(polyline.points[4], Point(50, 60));
+  ASSERT_EQ(polyline.points.capacity(), capacity);
+}
+
+TEST(GeometryTest, PathBuilderDetectsConvexPaths) {
+  ASSERT_TRUE(PathBuilder{}.AddCircle({100, 100}, 50).TakePath().IsConvex());
+  ASSERT_TRUE(PathBuilder{}
+                  .AddRoundedRect(Rect::MakeXYWH(10, 10, 300, 200), 20)
+                  .TakePath()
+                  .IsConvex());
+  ASSERT_TRUE(PathBuilder{}
+                  .AddOval(Rect::MakeXYWH(0, 0, 300, 20))
+                  .TakePath()
+                  .IsConvex());
+  // Contours are implicitly closed when filled.
+  ASSERT_TRUE(PathBuilder{}
+                  .MoveTo({0, 0})
+                  .LineTo({100, 0})
+                  .LineTo({50, 50})
+                  .TakePath()
+                  .IsConvex());
+
+  // An L shape.
+  ASSERT_FALSE(PathBuilder{}
+                   .MoveTo({0, 0})
+                   .LineTo({100, 0})
+                   .LineTo({100, 50})
+                   .LineTo({50, 50})
+                   .LineTo({50, 100})
+                   .LineTo({0, 100})
+                   .Close()
+                   .TakePath()
+                   .IsConvex());
+  // A star turns the same way at every corner, but winds around twice.
+  ASSERT_FALSE(PathBuilder{}
+                   .MoveTo({50, 0})
+                   .LineTo({79, 90})
+                   .LineTo({2, 35})
+                   .LineTo({97, 35})
+                   .LineTo({21, 90})
+                   .Close()
+                   .TakePath()
+                   .IsConvex());
+  ASSERT_FALSE(PathBuilder{}
+                   .MoveTo({0, 0})
+                   .CubicCurveTo({100, 100}, {0, 100}, {100, 0})
+                   .Close()
+                   .TakePath()
+                   .IsConvex());
+  ASSERT_FALSE(PathBuilder{}
+                   .AddRect(Rect::MakeXYWH(0, 0, 10, 10))
+                   .AddRect(Rect::MakeXYWH(20, 0, 10, 10))
+                   .TakePath()
+                   .IsConvex());
+  ASSERT_FALSE(
+      PathBuilder{}.MoveTo({0, 0}).LineTo({100, 100}).TakePath().IsConvex());
+}
+
+TEST(GeometryTest, CubicPathComponentFillsSamePointsAsItsQuadratics) {
+  CubicPathComponent cubic({0, 0}, {0, 100}, {300, -100}, {200, 50});
+  std::vector<Point> expected;
+  for (const auto& quad : cubic.ToQuadraticPathComponents(.1)) {
+    quad.FillPointsForPolyline(expected, 1.0f);
+  }
+
+  std::vector<Point> points = {{-1, -1}};
+  cubic.FillPointsForPolyline(points, 1.0f);
+  ASSERT_EQ(points.size(), expected.size() + 1);
+  ASSERT_EQ(points[0], Point(-1, -1));
+  ASSERT_TRUE(std::equal(expected.begin(), expected.end(), points.begin() + 1));
+}
+
 TEST(GeometryTest, MatrixPrinting) {
   {
     std::stringstream stream;
@@ -95,6 +95,20 @@ Matrix Matrix::operator+(const Matrix& o) const {
 }
 
 Matrix Matrix::Invert() const {
+  if (IsTranslationScaleOnly()) {
+    // Most transforms in a frame only scale and translate. Their inverse
+    // doesn't need the cofactors of the general case.
+    const auto sx = 1.0f / m[0];
+    const auto sy = 1.0f / m[5];
+    const auto sz = 1.0f / m[10];
+    // clang-format off
+    return {sx,          0.0f,        0.0f,        0.0f,
+            0.0f,        sy,          0.0f,        0.0f,
+            0.0f,        0.0f,        sz,          0.0f,
+            -m[12] * sx, -m[13] * sy, -m[14] * sz, 1.0f};
+    // clang-format on
+  }
+
   Matrix tmp{
       m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] +
           m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10],
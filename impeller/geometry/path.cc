@@ -4,6 +4,7 @@
 
 #include "impeller/geometry/path.h"
 
+#include <cmath>
 #include <optional>
 #include <variant>
 
@@ -61,6 +62,14 @@ void Path::SetConvexity(Convexity value) {
   convexity_ = value;
 }
 
+uint32_t Path::GetGenerationID() const {
+  return generation_id_;
+}
+
+void Path::SetGenerationID(uint32_t generation_id) {
+  generation_id_ = generation_id;
+}
+
 void Path::Shift(Point shift) {
   size_t currentIndex = 0;
   for (const auto& component : components_) {
@@ -271,23 +280,31 @@ bool Path::UpdateContourComponentAtIndex(size_t index,
 
 Path::Polyline Path::CreatePolyline(Scalar scale) const {
   Polyline polyline;
+  CreatePolyline(scale, polyline);
+  return polyline;
+}
 
-  std::optional<Point> previous_contour_point;
-  auto collect_points = [&polyline, &previous_contour_point](
-                            const std::vector<Point>& collection) {
-    if (collection.empty()) {
-      return;
-    }
+void Path::CreatePolyline(Scalar scale, Polyline& polyline) const {
+  polyline.points.clear();
+  polyline.contours.clear();
 
-    for (const auto& point : collection) {
+  // Components append their points directly to the polyline. The points
+  // appended since |start| are then compacted in place to drop duplicates.
+  std::optional<Point> previous_contour_point;
+  auto collect_points = [&polyline, &previous_contour_point](size_t start) {
+    auto& points = polyline.points;
+    auto end = start;
+    for (auto i = start; i < points.size(); i++) {
+      const auto point = points[i];
       if (previous_contour_point.has_value() &&
           previous_contour_point.value() == point) {
         // Skip over duplicate points in the same contour.
         continue;
       }
       previous_contour_point = point;
-      polyline.points.push_back(point);
+      points[end++] = point;
     }
+    points.resize(end);
   };
 
   auto get_path_component = [this](size_t component_i) -> PathComponentVariant {
@@ -340,7 +357,7 @@ Path::Polyline Path::CreatePolyline(Scalar scale) const {
 
     auto& contour = polyline.contours.back();
     contour.end_direction = Vector2(0, 1);
-    contour.components = components;
+    contour.components = std::move(components);
     components.clear();
 
     size_t previous_index = previous_path_component_index.value();
@@ -370,7 +387,8 @@ Path::Polyline Path::CreatePolyline(Scalar scale) const {
             .component_start_index = polyline.points.size(),
             .is_curve = false,
         });
-        collect_points(linears_[component.index].CreatePolyline());
+        polyline.points.push_back(linears_[component.index].p2);
+        collect_points(components.back().component_start_index);
         previous_path_component_index = component_i;
         break;
       case ComponentType::kQuadratic:
@@ -378,7 +396,8 @@ Path::Polyline Path::CreatePolyline(Scalar scale) const {
             .component_start_index = polyline.points.size(),
             .is_curve = true,
         });
-        collect_points(quads_[component.index].CreatePolyline(scale));
+        quads_[component.index].FillPointsForPolyline(polyline.points, scale);
+        collect_points(components.back().component_start_index);
         previous_path_component_index = component_i;
         break;
       case ComponentType::kCubic:
@@ -386,7 +405,8 @@ Path::Polyline Path::CreatePolyline(Scalar scale) const {
             .component_start_index = polyline.points.size(),
             .is_curve = true,
         });
-        collect_points(cubics_[component.index].CreatePolyline(scale));
+        cubics_[component.index].FillPointsForPolyline(polyline.points, scale);
+        collect_points(components.back().component_start_index);
         previous_path_component_index = component_i;
         break;
       case ComponentType::kContour:
@@ -404,12 +424,12 @@ Path::Polyline Path::CreatePolyline(Scalar scale) const {
                                      .start_direction = start_direction,
                                      .components = components});
         previous_contour_point = std::nullopt;
-        collect_points({contour.destination});
+        polyline.points.push_back(contour.destination);
+        collect_points(polyline.contours.back().start_index);
         break;
     }
   }
   end_contour();
-  return polyline;
 }
 
 std::optional<Rect> Path::GetBoundingBox() const {
@@ -428,6 +448,144 @@ void Path::ComputeBounds() {
   computed_bounds_ = Rect{min.x, min.y, difference.x, difference.y};
 }
 
+namespace {
+
+/// Checks whether the closed polygon through a sequence of points is convex.
+///
+/// The control points of curves may be added as if they were vertices. A
+/// curve never crosses a line more often than its control polygon does, so
+/// the curves are convex whenever their control polygon is.
+class ConvexityChecker {
+ public:
+  void AddPoint(Point point) {
+    if (point_count_ > 0u && point == last_point_) {
+      return;
+    }
+    if (point_count_ == 0u) {
+      first_point_ = point;
+    } else {
+      AddEdge(point - last_point_);
+    }
+    last_point_ = point;
+    point_count_++;
+  }
+
+  bool IsConvex() {
+    if (point_count_ < 3u) {
+      // Points and lines don't cover any area. There is nothing gained from
+      // treating them as convex.
+      return false;
+    }
+    // Close the polygon, then turn back onto the first edge so that the
+    // corner at the first point is checked too.
+    if (last_point_ != first_point_) {
+      AddEdge(first_point_ - last_point_);
+    }
+    AddEdge(first_edge_);
+    return !is_concave_ && x_direction_changes_ <= 2u &&
+           y_direction_changes_ <= 2u;
+  }
+
+ private:
+  Point first_point_;
+  Point last_point_;
+  size_t point_count_ = 0u;
+  Vector2 first_edge_;
+  std::optional<Vector2> last_edge_;
+  int turn_sign_ = 0;
+  int x_sign_ = 0;
+  int y_sign_ = 0;
+  size_t x_direction_changes_ = 0u;
+  size_t y_direction_changes_ = 0u;
+  bool is_concave_ = false;
+
+  void AddEdge(Vector2 edge) {
+    if (!last_edge_.has_value()) {
+      first_edge_ = edge;
+    } else {
+      auto cross = last_edge_->Cross(edge);
+      if (std::abs(cross) >
+          kEhCloseEnough * last_edge_->GetLength() * edge.GetLength()) {
+        // Every corner of a convex polygon turns the same way.
+        auto sign = cross > 0 ? 1 : -1;
+        if (turn_sign_ != 0 && sign != turn_sign_) {
+          is_concave_ = true;
+        }
+        turn_sign_ = sign;
+      } else if (last_edge_->Dot(edge) < 0) {
+        // The polygon doubles back on itself.
+        is_concave_ = true;
+      }
+    }
+    last_edge_ = edge;
+    // Polygons that wind around more than once, such as stars, turn the same
+    // way at every corner too. Those change direction along each axis more
+    // than twice.
+    CountDirectionChange(edge.x, x_sign_, x_direction_changes_);
+    CountDirectionChange(edge.y, y_sign_, y_direction_changes_);
+  }
+
+  static void CountDirectionChange(Scalar delta, int& sign, size_t& changes) {
+    if (delta == 0) {
+      return;
+    }
+    auto new_sign = delta > 0 ? 1 : -1;
+    if (sign != 0 && new_sign != sign) {
+      changes++;
+    }
+    sign = new_sign;
+  }
+};
+
+}  // namespace
+
+void Path::ComputeConvexity() {
+  convexity_ = Convexity::kUnknown;
+
+  ConvexityChecker checker;
+  bool has_segments = false;
+  bool is_contour_ended = false;
+  for (const auto& component : components_) {
+    if (component.type == ComponentType::kContour) {
+      is_contour_ended = has_segments;
+      continue;
+    }
+    if (is_contour_ended) {
+      // Only paths with a single contour are detected as convex.
+      return;
+    }
+    has_segments = true;
+    switch (component.type) {
+      case ComponentType::kLinear: {
+        const auto& linear = linears_[component.index];
+        checker.AddPoint(linear.p1);
+        checker.AddPoint(linear.p2);
+        break;
+      }
+      case ComponentType::kQuadratic: {
+        const auto& quad = quads_[component.index];
+        checker.AddPoint(quad.p1);
+        checker.AddPoint(quad.cp);
+        checker.AddPoint(quad.p2);
+        break;
+      }
+      case ComponentType::kCubic: {
+        const auto& cubic = cubics_[component.index];
+        checker.AddPoint(cubic.p1);
+        checker.AddPoint(cubic.cp1);
+        checker.AddPoint(cubic.cp2);
+        checker.AddPoint(cubic.p2);
+        break;
+      }
+      case ComponentType::kContour:
+        break;
+    }
+  }
+  if (checker.IsConvex()) {
+    convexity_ = Convexity::kConvex;
+  }
+}
+
 std::optional<Rect> Path::GetTransformedBoundingBox(
     const Matrix& transform) const {
   auto bounds = GetBoundingBox();
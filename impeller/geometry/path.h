@@ -114,6 +114,11 @@ class Path {
 
   bool IsConvex() const;
 
+  /// An identifier of the components of the path, or zero if there is none.
+  /// Paths with the same non-zero generation ID have the same components, so
+  /// anything derived from the components alone may be cached by it.
+  uint32_t GetGenerationID() const;
+
   template <class T>
   using Applier = std::function<void(size_t index, const T& component)>;
   void EnumerateComponents(
@@ -140,6 +145,11 @@ class Path {
   /// the path. If the provided scale is 0, curves will revert to lines.
   Polyline CreatePolyline(Scalar scale) const;
 
+  /// Like |CreatePolyline|, but writes into a caller provided polyline so that
+  /// its storage may be reused across calls. Any previous contents of the
+  /// polyline are discarded.
+  void CreatePolyline(Scalar scale, Polyline& polyline) const;
+
   std::optional<Rect> GetBoundingBox() const;
 
   std::optional<Rect> GetTransformedBoundingBox(const Matrix& transform) const;
@@ -151,6 +161,8 @@ class Path {
 
   void SetConvexity(Convexity value);
 
+  void SetGenerationID(uint32_t generation_id);
+
   void SetFillType(FillType fill);
 
   void SetBounds(Rect rect);
@@ -169,6 +181,10 @@ class Path {
   /// with already computed bounds, such as an SkPath.
   void ComputeBounds();
 
+  /// @brief Called by `PathBuilder` to detect whether a path it built is a
+  ///        single convex contour, unless the builder was told its convexity.
+  void ComputeConvexity();
+
   void SetContourClosed(bool is_closed);
 
   void Shift(Point shift);
@@ -196,6 +212,7 @@ class Path {
 
   FillType fill_ = FillType::kNonZero;
   Convexity convexity_ = Convexity::kUnknown;
+  uint32_t generation_id_ = 0u;
   std::vector<ComponentIndexPair> components_;
   std::vector<LinearPathComponent> linears_;
   std::vector<QuadraticPathComponent> quads_;
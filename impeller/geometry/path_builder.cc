@@ -22,10 +22,16 @@ Path PathBuilder::TakePath(FillType fill) {
   auto path = prototype_;
   path.SetFillType(fill);
   path.SetConvexity(convexity_);
+  path.SetGenerationID(generation_id_);
+  if (convexity_ == Convexity::kUnknown) {
+    path.ComputeConvexity();
+  }
   if (!did_compute_bounds_) {
     path.ComputeBounds();
   }
   did_compute_bounds_ = false;
+  // Whatever is added to the builder next makes a different path.
+  generation_id_ = 0u;
   return path;
 }
 
@@ -113,6 +119,11 @@ PathBuilder& PathBuilder::SetConvexity(Convexity value) {
   return *this;
 }
 
+PathBuilder& PathBuilder::SetGenerationID(uint32_t generation_id) {
+  generation_id_ = generation_id;
+  return *this;
+}
+
 PathBuilder& PathBuilder::CubicCurveTo(Point controlPoint1,
                                        Point controlPoint2,
                                        Point point,
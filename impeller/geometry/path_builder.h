@@ -33,6 +33,13 @@ class PathBuilder {
 
   PathBuilder& SetConvexity(Convexity value);
 
+  /// @brief Identify the components of the path being built, such as by the
+  ///        generation ID of the path it is converted from. The ID must
+  ///        change whenever the components do.
+  ///
+  /// @see Path::GetGenerationID
+  PathBuilder& SetGenerationID(uint32_t generation_id);
+
   PathBuilder& MoveTo(Point point, bool relative = false);
 
   PathBuilder& Close();
@@ -140,7 +147,8 @@ class PathBuilder {
   Point subpath_start_;
   Point current_;
   Path prototype_;
-  Convexity convexity_;
+  Convexity convexity_ = Convexity::kUnknown;
+  uint32_t generation_id_ = 0u;
   bool did_compute_bounds_ = false;
 
   PathBuilder& AddRoundedRectTopLeft(Rect rect, RoundingRadii radii);
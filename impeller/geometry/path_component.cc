@@ -188,32 +188,17 @@ Point CubicPathComponent::SolveDerivative(Scalar time) const {
 }
 
 std::vector<Point> CubicPathComponent::CreatePolyline(Scalar scale) const {
-  auto quads = ToQuadraticPathComponents(.1);
   std::vector<Point> points;
-  for (const auto& quad : quads) {
-    quad.FillPointsForPolyline(points, scale);
-  }
+  FillPointsForPolyline(points, scale);
   return points;
 }
 
-inline QuadraticPathComponent CubicPathComponent::Lower() const {
-  return QuadraticPathComponent(3.0 * (cp1 - p1), 3.0 * (cp2 - cp1),
-                                3.0 * (p2 - cp2));
-}
-
-CubicPathComponent CubicPathComponent::Subsegment(Scalar t0, Scalar t1) const {
-  auto p0 = Solve(t0);
-  auto p3 = Solve(t1);
-  auto d = Lower();
-  auto scale = (t1 - t0) * (1.0 / 3.0);
-  auto p1 = p0 + scale * d.Solve(t0);
-  auto p2 = p3 - scale * d.Solve(t1);
-  return CubicPathComponent(p0, p1, p2, p3);
-}
-
-std::vector<QuadraticPathComponent>
-CubicPathComponent::ToQuadraticPathComponents(Scalar accuracy) const {
-  std::vector<QuadraticPathComponent> quads;
+// Invokes the callback with each of the quadratics approximating the cubic,
+// in order. See |CubicPathComponent::ToQuadraticPathComponents|.
+template <class Callback>
+static void VisitQuadraticPathComponents(const CubicPathComponent& cubic,
+                                         Scalar accuracy,
+                                         const Callback& callback) {
   // The maximum error, as a vector from the cubic to the best approximating
   // quadratic, is proportional to the third derivative, which is constant
   // across the segment. Thus, the error scales down as the third power of
@@ -226,8 +211,8 @@ CubicPathComponent::ToQuadraticPathComponents(Scalar accuracy) const {
   // This magic number is the square of 36 / sqrt(3).
   // See: http://caffeineowl.com/graphics/2d/vectorial/cubic2quad01.html
   auto max_hypot2 = 432.0 * accuracy * accuracy;
-  auto p1x2 = 3.0 * cp1 - p1;
-  auto p2x2 = 3.0 * cp2 - p2;
+  auto p1x2 = 3.0 * cubic.cp1 - cubic.p1;
+  auto p2x2 = 3.0 * cubic.cp2 - cubic.p2;
   auto p = p2x2 - p1x2;
   auto err = p.Dot(p);
   auto quad_count = std::max(1., ceil(pow(err / max_hypot2, 1. / 6.0)));
@@ -235,12 +220,42 @@ CubicPathComponent::ToQuadraticPathComponents(Scalar accuracy) const {
   for (size_t i = 0; i < quad_count; i++) {
     auto t0 = i / quad_count;
     auto t1 = (i + 1) / quad_count;
-    auto seg = Subsegment(t0, t1);
+    auto seg = cubic.Subsegment(t0, t1);
     auto p1x2 = 3.0 * seg.cp1 - seg.p1;
     auto p2x2 = 3.0 * seg.cp2 - seg.p2;
-    quads.emplace_back(
-        QuadraticPathComponent(seg.p1, ((p1x2 + p2x2) / 4.0), seg.p2));
+    callback(QuadraticPathComponent(seg.p1, ((p1x2 + p2x2) / 4.0), seg.p2));
   }
+}
+
+void CubicPathComponent::FillPointsForPolyline(std::vector<Point>& points,
+                                               Scalar scale_factor) const {
+  VisitQuadraticPathComponents(
+      *this, .1, [&points, scale_factor](const QuadraticPathComponent& quad) {
+        quad.FillPointsForPolyline(points, scale_factor);
+      });
+}
+
+inline QuadraticPathComponent CubicPathComponent::Lower() const {
+  return QuadraticPathComponent(3.0 * (cp1 - p1), 3.0 * (cp2 - cp1),
+                                3.0 * (p2 - cp2));
+}
+
+CubicPathComponent CubicPathComponent::Subsegment(Scalar t0, Scalar t1) const {
+  auto p0 = Solve(t0);
+  auto p3 = Solve(t1);
+  auto d = Lower();
+  auto scale = (t1 - t0) * (1.0 / 3.0);
+  auto p1 = p0 + scale * d.Solve(t0);
+  auto p2 = p3 - scale * d.Solve(t1);
+  return CubicPathComponent(p0, p1, p2, p3);
+}
+
+std::vector<QuadraticPathComponent>
+CubicPathComponent::ToQuadraticPathComponents(Scalar accuracy) const {
+  std::vector<QuadraticPathComponent> quads;
+  VisitQuadraticPathComponents(
+      *this, accuracy,
+      [&quads](const QuadraticPathComponent& quad) { quads.push_back(quad); });
   return quads;
 }
 
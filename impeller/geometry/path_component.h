@@ -123,6 +123,11 @@ struct CubicPathComponent {
   // See the note on QuadraticPathComponent::CreatePolyline for references.
   std::vector<Point> CreatePolyline(Scalar scale) const;
 
+  // Appends the points of the polyline to |points| without allocating
+  // intermediate storage for the quadratics.
+  void FillPointsForPolyline(std::vector<Point>& points,
+                             Scalar scale_factor) const;
+
   std::vector<Point> Extrema() const;
 
   std::vector<QuadraticPathComponent> ToQuadraticPathComponents(
@@ -202,6 +202,14 @@ struct TRect {
   /// @brief  Creates a new bounding box that contains this transformed
   ///         rectangle.
   constexpr TRect TransformBounds(const Matrix& transform) const {
+    if (transform.IsTranslationScaleOnly()) {
+      // The transformed rectangle is still axis aligned, so its bounds are
+      // those of any two opposing corners.
+      auto [left, top, right, bottom] = GetLTRB();
+      std::array<TPoint<T>, 2> points = {transform * TPoint(left, top),
+                                         transform * TPoint(right, bottom)};
+      return TRect::MakePointBounds(points.begin(), points.end()).value();
+    }
     auto points = GetTransformedPoints(transform);
     return TRect::MakePointBounds(points.begin(), points.end()).value();
   }
@@ -86,6 +86,10 @@ PlaygroundImplVK::PlaygroundImplVK(PlaygroundSwitches switches)
   context_settings.shader_libraries_data = ShaderLibraryMappingsForPlayground();
   context_settings.cache_directory = fml::paths::GetCachesDirectory();
   context_settings.enable_validation = switches_.enable_vulkan_validation;
+  context_settings.enable_parallel_pass_encoding =
+      switches_.enable_vulkan_parallel_pass_encoding;
+  context_settings.enable_secondary_command_buffers =
+      switches_.enable_vulkan_secondary_command_buffers;
 
   auto context_vk = ContextVK::Create(std::move(context_settings));
   if (!context_vk || !context_vk->IsValid()) {
@@ -19,6 +19,10 @@ PlaygroundSwitches::PlaygroundSwitches(const fml::CommandLine& args) {
     enable_playground = true;
   }
   enable_vulkan_validation = args.HasOption("enable_vulkan_validation");
+  enable_vulkan_parallel_pass_encoding =
+      args.HasOption("enable_vulkan_parallel_pass_encoding");
+  enable_vulkan_secondary_command_buffers =
+      args.HasOption("enable_vulkan_secondary_command_buffers");
 }
 
 }  // namespace impeller
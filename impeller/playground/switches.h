@@ -19,6 +19,8 @@ struct PlaygroundSwitches {
   // rendered in the playground.
   std::optional<std::chrono::milliseconds> timeout;
   bool enable_vulkan_validation = false;
+  bool enable_vulkan_parallel_pass_encoding = false;
+  bool enable_vulkan_secondary_command_buffers = false;
 
   PlaygroundSwitches();
 
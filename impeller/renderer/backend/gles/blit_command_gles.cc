@@ -23,7 +23,8 @@ static void DeleteFBO(const ProcTableGLES& gl, GLuint fbo, GLenum type) {
 static std::optional<GLuint> ConfigureFBO(
     const ProcTableGLES& gl,
     const std::shared_ptr<Texture>& texture,
-    GLenum fbo_type) {
+    GLenum fbo_type,
+    size_t mip_level = 0u) {
   auto handle = TextureGLES::Cast(texture.get())->GetGLHandle();
   if (!handle.has_value()) {
     return std::nullopt;
@@ -41,7 +42,7 @@ static std::optional<GLuint> ConfigureFBO(
   gl.BindFramebuffer(fbo_type, fbo);
 
   if (!TextureGLES::Cast(*texture).SetAsFramebufferAttachment(
-          fbo_type, fbo, TextureGLES::AttachmentPoint::kColor0)) {
+          fbo_type, fbo, TextureGLES::AttachmentPoint::kColor0, mip_level)) {
     VALIDATION_LOG << "Could not attach texture to framebuffer.";
     DeleteFBO(gl, fbo, fbo_type);
     return std::nullopt;
@@ -83,7 +84,8 @@ bool BlitCopyTextureToTextureCommandGLES::Encode(
   });
 
   {
-    auto read = ConfigureFBO(gl, source, GL_READ_FRAMEBUFFER);
+    auto read =
+        ConfigureFBO(gl, source, GL_READ_FRAMEBUFFER, source_mip_level);
     if (!read.has_value()) {
       return false;
     }
@@ -102,16 +104,24 @@ bool BlitCopyTextureToTextureCommandGLES::Encode(
   gl.Disable(GL_DEPTH_TEST);
   gl.Disable(GL_STENCIL_TEST);
 
-  gl.BlitFramebuffer(source_region.origin.x,     // srcX0
-                     source_region.origin.y,     // srcY0
-                     source_region.size.width,   // srcX1
-                     source_region.size.height,  // srcY1
-                     destination_origin.x,       // dstX0
-                     destination_origin.y,       // dstY0
-                     source_region.size.width,   // dstX1
-                     source_region.size.height,  // dstY1
-                     GL_COLOR_BUFFER_BIT,        // mask
-                     GL_NEAREST                  // filter
+  // Impeller's framebuffer coordinate system is top left origin, but OpenGL's
+  // is bottom left origin, so the regions are flipped vertically.
+  const auto source_height = source->GetSize().height;
+  const auto destination_height = destination->GetSize().height;
+  const auto source_bottom = source_height - source_region.GetBottom();
+  const auto destination_bottom =
+      destination_height - destination_origin.y - source_region.size.height;
+  gl.BlitFramebuffer(
+      source_region.GetLeft(),                          // srcX0
+      source_bottom,                                    // srcY0
+      source_region.GetRight(),                         // srcX1
+      source_bottom + source_region.size.height,        // srcY1
+      destination_origin.x,                             // dstX0
+      destination_bottom,                               // dstY0
+      destination_origin.x + source_region.size.width,  // dstX1
+      destination_bottom + source_region.size.height,   // dstY1
+      GL_COLOR_BUFFER_BIT,                              // mask
+      GL_NEAREST                                        // filter
   );
 
   return true;
@@ -102,6 +102,7 @@ bool BlitPassGLES::OnCopyTextureToTextureCommand(
     std::shared_ptr<Texture> destination,
     IRect source_region,
     IPoint destination_origin,
+    size_t source_mip_level,
     std::string label) {
   auto command = std::make_unique<BlitCopyTextureToTextureCommandGLES>();
   command->label = label;
@@ -109,6 +110,7 @@ bool BlitPassGLES::OnCopyTextureToTextureCommand(
   command->destination = std::move(destination);
   command->source_region = source_region;
   command->destination_origin = destination_origin;
+  command->source_mip_level = source_mip_level;
 
   commands_.emplace_back(std::move(command));
   return true;
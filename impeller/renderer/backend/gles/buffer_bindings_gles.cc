@@ -122,10 +122,11 @@ bool BufferBindingsGLES::ReadUniformsBindings(const ProcTableGLES& gl,
   return true;
 }
 
-bool BufferBindingsGLES::BindVertexAttributes(const ProcTableGLES& gl,
+bool BufferBindingsGLES::BindVertexAttributes(StateCacheGLES& state,
                                               size_t vertex_offset) const {
+  const auto& gl = state.GetProcTable();
   for (const auto& array : vertex_attrib_arrays_) {
-    gl.EnableVertexAttribArray(array.index);
+    state.EnableVertexAttribArray(array.index);
     gl.VertexAttribPointer(array.index,       // index
                            array.size,        // size (must be 1, 2, 3, or 4)
                            array.type,        // type
@@ -166,9 +167,10 @@ bool BufferBindingsGLES::BindUniformData(
   return true;
 }
 
-bool BufferBindingsGLES::UnbindVertexAttributes(const ProcTableGLES& gl) const {
+bool BufferBindingsGLES::UnbindVertexAttributes(
+    StateCacheGLES& state) const {
   for (const auto& array : vertex_attrib_arrays_) {
-    gl.DisableVertexAttribArray(array.index);
+    state.DisableVertexAttribArray(array.index);
   }
   return true;
 }
@@ -194,78 +196,66 @@ bool BufferBindingsGLES::BindUniformBuffer(const ProcTableGLES& gl,
     return false;
   }
 
-  for (const auto& member : metadata->members) {
-    if (member.type == ShaderType::kVoid) {
-      // Void types are used for padding. We are obviously not going to find
-      // mappings for these. Keep going.
-      continue;
+  for (auto& member : GetUniformMemberBindings(*metadata)) {
+    const auto* member_data = buffer_ptr + member.offset;
+
+    // When binding uniform arrays, the elements must be contiguous. The value
+    // last uploaded is kept without any of the padding needed by the other
+    // backends, so compare and copy each element separately.
+    const size_t value_length = member.size * member.element_count;
+    bool changed = member.last_value.size() != value_length;
+    for (size_t element_i = 0; !changed && element_i < member.element_count;
+         element_i++) {
+      changed = std::memcmp(member.last_value.data() + element_i * member.size,
+                            member_data + element_i * member.element_stride,
+                            member.size) != 0;
     }
-
-    size_t element_count = member.array_elements.value_or(1);
-
-    const auto member_key =
-        CreateUniformMemberKey(metadata->name, member.name, element_count > 1);
-    const auto location = uniform_locations_.find(member_key);
-    if (location == uniform_locations_.end()) {
-      // The list of uniform locations only contains "active" uniforms that are
-      // not optimized out. So this situation is expected to happen when unused
-      // uniforms are present in the shader.
+    if (!changed) {
       continue;
     }
-
-    size_t element_stride = member.byte_length / element_count;
+    member.last_value.resize(value_length);
+    for (size_t element_i = 0; element_i < member.element_count; element_i++) {
+      std::memcpy(member.last_value.data() + element_i * member.size,
+                  member_data + element_i * member.element_stride,
+                  member.size);
+    }
 
     auto* buffer_data =
-        reinterpret_cast<const GLfloat*>(buffer_ptr + member.offset);
-
-    std::vector<uint8_t> array_element_buffer;
-    if (element_count > 1) {
-      // When binding uniform arrays, the elements must be contiguous. Copy the
-      // uniforms to a temp buffer to eliminate any padding needed by the other
-      // backends.
-      array_element_buffer.resize(member.size * element_count);
-      for (size_t element_i = 0; element_i < element_count; element_i++) {
-        std::memcpy(array_element_buffer.data() + element_i * member.size,
-                    reinterpret_cast<const char*>(buffer_data) +
-                        element_i * element_stride,
-                    member.size);
-      }
-      buffer_data =
-          reinterpret_cast<const GLfloat*>(array_element_buffer.data());
-    }
+        reinterpret_cast<const GLfloat*>(member.last_value.data());
+    const auto element_count = member.element_count;
 
     switch (member.type) {
       case ShaderType::kFloat:
         switch (member.size) {
           case sizeof(Matrix):
-            gl.UniformMatrix4fv(location->second,  // location
-                                element_count,     // count
-                                GL_FALSE,          // normalize
-                                buffer_data        // data
+            gl.UniformMatrix4fv(member.location,  // location
+                                element_count,    // count
+                                GL_FALSE,         // normalize
+                                buffer_data       // data
             );
             continue;
           case sizeof(Vector4):
-            gl.Uniform4fv(location->second,  // location
-                          element_count,     // count
-                          buffer_data        // data
+            gl.Uniform4fv(member.location,  // location
+                          element_count,    // count
+                          buffer_data       // data
             );
             continue;
           case sizeof(Vector3):
-            gl.Uniform3fv(location->second,  // location
-                          element_count,     // count
-                          buffer_data        // data
+            gl.Uniform3fv(member.location,  // location
+                          element_count,    // count
+                          buffer_data       // data
             );
             continue;
           case sizeof(Vector2):
-            gl.Uniform2fv(location->second,  // location
-                          element_count,     // count
-                          buffer_data        // data
+            gl.Uniform2fv(member.location,  // location
+                          element_count,    // count
+                          buffer_data       // data
             );
             continue;
           case sizeof(Scalar):
-            gl.Uniform1fv(location->second,  // location
-                          element_count,     // count
-                          buffer_data        // data
+            gl.Uniform1fv(member.location,  // location
+                          element_count,    // count
+                          buffer_data       // data
             );
             continue;
         }
@@ -287,14 +277,56 @@ bool BufferBindingsGLES::BindUniformBuffer(const ProcTableGLES& gl,
       case ShaderType::kImage:
       case ShaderType::kSampledImage:
       case ShaderType::kSampler:
+        member.last_value.clear();
         VALIDATION_LOG << "Could not bind uniform buffer data for key: "
-                       << member_key;
+                       << member.key;
         return false;
     }
   }
   return true;
 }
 
+std::vector<BufferBindingsGLES::UniformMemberBinding>&
+BufferBindingsGLES::GetUniformMemberBindings(
+    const ShaderMetadata& metadata) const {
+  if (auto found = uniform_member_bindings_.find(metadata.name);
+      found != uniform_member_bindings_.end()) {
+    return found->second;
+  }
+
+  std::vector<UniformMemberBinding> bindings;
+  for (const auto& member : metadata.members) {
+    if (member.type == ShaderType::kVoid) {
+      // Void types are used for padding. We are obviously not going to find
+      // mappings for these. Keep going.
+      continue;
+    }
+
+    size_t element_count = member.array_elements.value_or(1);
+
+    auto member_key =
+        CreateUniformMemberKey(metadata.name, member.name, element_count > 1);
+    const auto location = uniform_locations_.find(member_key);
+    if (location == uniform_locations_.end()) {
+      // The list of uniform locations only contains "active" uniforms that are
+      // not optimized out. So this situation is expected to happen when unused
+      // uniforms are present in the shader.
+      continue;
+    }
+
+    UniformMemberBinding binding;
+    binding.key = std::move(member_key);
+    binding.location = location->second;
+    binding.type = member.type;
+    binding.offset = member.offset;
+    binding.size = member.size;
+    binding.element_count = element_count;
+    binding.element_stride = member.byte_length / element_count;
+    bindings.emplace_back(std::move(binding));
+  }
+  return uniform_member_bindings_[metadata.name] = std::move(bindings);
+}
+
 bool BufferBindingsGLES::BindTextures(const ProcTableGLES& gl,
                                       const Bindings& bindings,
                                       ShaderStage stage) const {
@@ -5,11 +5,14 @@
 #pragma once
 
 #include <map>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/backend/gles/gles.h"
 #include "impeller/renderer/backend/gles/proc_table_gles.h"
+#include "impeller/renderer/backend/gles/state_cache_gles.h"
 #include "impeller/renderer/command.h"
 #include "impeller/renderer/vertex_descriptor.h"
 
@@ -32,7 +35,7 @@ class BufferBindingsGLES {
 
   bool ReadUniformsBindings(const ProcTableGLES& gl, GLuint program);
 
-  bool BindVertexAttributes(const ProcTableGLES& gl,
+  bool BindVertexAttributes(StateCacheGLES& state,
                             size_t vertex_offset) const;
 
   bool BindUniformData(const ProcTableGLES& gl,
@@ -40,7 +43,7 @@ class BufferBindingsGLES {
                        const Bindings& vertex_bindings,
                        const Bindings& fragment_bindings) const;
 
-  bool UnbindVertexAttributes(const ProcTableGLES& gl) const;
+  bool UnbindVertexAttributes(StateCacheGLES& state) const;
 
  private:
   //----------------------------------------------------------------------------
@@ -57,6 +60,28 @@ class BufferBindingsGLES {
   std::vector<VertexAttribPointer> vertex_attrib_arrays_;
   std::map<std::string, GLint> uniform_locations_;
 
+  //----------------------------------------------------------------------------
+  /// @brief      An active uniform a member of a uniform struct is uploaded to,
+  ///             along with the value last uploaded to it. Uniform values are
+  ///             program state, so uploads of unchanged values are elided.
+  ///
+  struct UniformMemberBinding {
+    std::string key;
+    GLint location = -1;
+    ShaderType type = ShaderType::kUnknown;
+    size_t offset = 0u;
+    size_t size = 0u;
+    size_t element_count = 1u;
+    size_t element_stride = 0u;
+    std::vector<uint8_t> last_value;
+  };
+  // The uniform member bindings of each uniform struct, keyed by struct name.
+  mutable std::unordered_map<std::string, std::vector<UniformMemberBinding>>
+      uniform_member_bindings_;
+
+  std::vector<UniformMemberBinding>& GetUniformMemberBindings(
+      const ShaderMetadata& metadata) const;
+
   bool BindUniformBuffer(const ProcTableGLES& gl,
                          Allocator& transients_allocator,
                          const BufferResource& buffer) const;
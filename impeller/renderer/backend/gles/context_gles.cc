@@ -67,7 +67,9 @@ ContextGLES::ContextGLES(std::unique_ptr<ProcTableGLES> gl,
             .SetSupportsBufferToTextureBlits(false)
             .SetSupportsTextureToTextureBlits(
                 reactor_->GetProcTable().BlitFramebuffer.IsAvailable())
-            .SetSupportsFramebufferFetch(false)
+            .SetSupportsFramebufferFetch(reactor_->GetProcTable()
+                                             .GetDescription()
+                                             ->HasFramebufferFetchExtension())
             .SetDefaultColorFormat(PixelFormat::kR8G8B8A8UNormInt)
             .SetDefaultStencilFormat(PixelFormat::kS8UInt)
             .SetDefaultDepthStencilFormat(PixelFormat::kD24UnormS8Uint)
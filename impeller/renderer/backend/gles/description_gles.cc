@@ -168,4 +168,8 @@ bool DescriptionGLES::HasDebugExtension() const {
   return HasExtension("GL_KHR_debug");
 }
 
+bool DescriptionGLES::HasFramebufferFetchExtension() const {
+  return HasExtension("GL_EXT_shader_framebuffer_fetch");
+}
+
 }  // namespace impeller
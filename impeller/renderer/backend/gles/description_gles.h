@@ -30,6 +30,8 @@ class DescriptionGLES {
 
   bool HasDebugExtension() const;
 
+  bool HasFramebufferFetchExtension() const;
+
  private:
   Version gl_version_;
   Version sl_version_;
@@ -4,6 +4,7 @@
 
 #include "impeller/renderer/backend/gles/device_buffer_gles.h"
 
+#include <algorithm>
 #include <cstring>
 #include <memory>
 
@@ -52,11 +53,27 @@ bool DeviceBufferGLES::OnCopyHostBuffer(const uint8_t* source,
 
   std::memmove(backing_store_->GetBuffer() + offset,
                source + source_range.offset, source_range.length);
-  ++generation_;
+  MarkDirty(Range{offset, source_range.length});
 
   return true;
 }
 
+// |DeviceBuffer|
+void DeviceBufferGLES::Flush(Range range) {
+  MarkDirty(range);
+}
+
+void DeviceBufferGLES::MarkDirty(Range range) const {
+  if (!dirty_range_.has_value()) {
+    dirty_range_ = range;
+    return;
+  }
+  const auto start = std::min(dirty_range_->offset, range.offset);
+  const auto end = std::max(dirty_range_->offset + dirty_range_->length,
+                            range.offset + range.length);
+  dirty_range_ = Range{start, end - start};
+}
+
 static GLenum ToTarget(DeviceBufferGLES::BindingType type) {
   switch (type) {
     case DeviceBufferGLES::BindingType::kArrayBuffer:
@@ -82,13 +99,30 @@ bool DeviceBufferGLES::BindAndUploadDataIfNecessary(BindingType type) const {
 
   gl.BindBuffer(target_type, buffer.value());
 
-  if (upload_generation_ != generation_) {
+  if (!dirty_range_.has_value()) {
+    return true;
+  }
+
+  const auto length = backing_store_->GetLength();
+  const auto dirty_end =
+      std::min(dirty_range_->offset + dirty_range_->length, length);
+  if (!uploaded_ || (dirty_range_->offset == 0u && dirty_end == length)) {
+    // Respecifying the entire store orphans the previous one, so draws still
+    // reading from it don't stall the upload. Buffers that are updated after
+    // their first upload are hinted as dynamic.
     TRACE_EVENT1("impeller", "BufferData", "Bytes",
-                 std::to_string(backing_store_->GetLength()).c_str());
-    gl.BufferData(target_type, backing_store_->GetLength(),
-                  backing_store_->GetBuffer(), GL_STATIC_DRAW);
-    upload_generation_ = generation_;
+                 std::to_string(length).c_str());
+    gl.BufferData(target_type, length, backing_store_->GetBuffer(),
+                  uploaded_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+    uploaded_ = true;
+  } else if (dirty_range_->offset < dirty_end) {
+    TRACE_EVENT1("impeller", "BufferSubData", "Bytes",
+                 std::to_string(dirty_end - dirty_range_->offset).c_str());
+    gl.BufferSubData(target_type, dirty_range_->offset,
+                     dirty_end - dirty_range_->offset,
+                     backing_store_->GetBuffer() + dirty_range_->offset);
   }
+  dirty_range_.reset();
 
   return true;
 }
@@ -116,7 +150,7 @@ void DeviceBufferGLES::UpdateBufferData(
   if (update_buffer_data) {
     update_buffer_data(backing_store_->GetBuffer(),
                        backing_store_->GetLength());
-    ++generation_;
+    MarkDirty(Range{0u, backing_store_->GetLength()});
   }
 }
 
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 
 #include "flutter/fml/macros.h"
 #include "impeller/base/allocation.h"
@@ -41,8 +42,12 @@ class DeviceBufferGLES final
   ReactorGLES::Ref reactor_;
   HandleGLES handle_;
   mutable std::shared_ptr<Allocation> backing_store_;
-  mutable uint32_t generation_ = 0;
-  mutable uint32_t upload_generation_ = 0;
+  // The range of the backing store updated since the last upload. The entire
+  // backing store is uploaded the first time regardless.
+  mutable std::optional<Range> dirty_range_;
+  mutable bool uploaded_ = false;
+
+  void MarkDirty(Range range) const;
 
   // |DeviceBuffer|
   uint8_t* OnGetContents() const override;
@@ -52,6 +57,9 @@ class DeviceBufferGLES final
                         Range source_range,
                         size_t offset) override;
 
+  // |DeviceBuffer|
+  void Flush(Range range) override;
+
   // |DeviceBuffer|
   bool SetLabel(const std::string& label) override;
 
@@ -104,8 +104,9 @@ static bool LinkProgram(
   fml::ScopedCleanupClosure delete_frag_shader(
       [&gl, frag_shader]() { gl.DeleteShader(frag_shader); });
 
-  gl.ShaderSourceMapping(vert_shader, *vert_mapping);
-  gl.ShaderSourceMapping(frag_shader, *frag_mapping);
+  const auto& constants = descriptor.GetSpecializationConstants();
+  gl.ShaderSourceMapping(vert_shader, *vert_mapping, constants);
+  gl.ShaderSourceMapping(frag_shader, *frag_mapping, constants);
 
   gl.CompileShader(vert_shader);
   gl.CompileShader(frag_shader);
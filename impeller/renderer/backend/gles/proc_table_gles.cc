@@ -4,7 +4,10 @@
 
 #include "impeller/renderer/backend/gles/proc_table_gles.h"
 
+#include <algorithm>
+#include <iomanip>
 #include <sstream>
+#include <string_view>
 
 #include "impeller/base/allocation.h"
 #include "impeller/base/comparable.h"
@@ -122,12 +125,46 @@ bool ProcTableGLES::IsValid() const {
   return is_valid_;
 }
 
-void ProcTableGLES::ShaderSourceMapping(GLuint shader,
-                                        const fml::Mapping& mapping) const {
+void ProcTableGLES::ShaderSourceMapping(
+    GLuint shader,
+    const fml::Mapping& mapping,
+    const std::vector<Scalar>& defines) const {
+  if (defines.empty()) {
+    const GLchar* sources[] = {
+        reinterpret_cast<const GLchar*>(mapping.GetMapping())};
+    const GLint lengths[] = {static_cast<GLint>(mapping.GetSize())};
+    ShaderSource(shader, 1u, sources, lengths);
+    return;
+  }
+
+  // The defines must come after the `#version` directive, which has to be the
+  // first line of the source.
+  std::string_view source(reinterpret_cast<const char*>(mapping.GetMapping()),
+                          mapping.GetSize());
+  size_t version_length = 0u;
+  if (source.rfind("#version", 0u) == 0u) {
+    version_length = std::min(source.find('\n'), source.size());
+  }
+
+  std::stringstream stream;
+  stream << std::showpoint << std::setprecision(9) << std::endl;
+  for (size_t i = 0; i < defines.size(); i++) {
+    stream << "#define SPIRV_CROSS_CONSTANT_ID_" << i << " " << defines[i]
+           << std::endl;
+  }
+  const std::string define_source = stream.str();
+
   const GLchar* sources[] = {
-      reinterpret_cast<const GLchar*>(mapping.GetMapping())};
-  const GLint lengths[] = {static_cast<GLint>(mapping.GetSize())};
-  ShaderSource(shader, 1u, sources, lengths);
+      source.data(),
+      define_source.data(),
+      source.data() + version_length,
+  };
+  const GLint lengths[] = {
+      static_cast<GLint>(version_length),
+      static_cast<GLint>(define_source.size()),
+      static_cast<GLint>(source.size() - version_length),
+  };
+  ShaderSource(shader, 3u, sources, lengths);
 }
 
 const DescriptionGLES* ProcTableGLES::GetDescription() const {
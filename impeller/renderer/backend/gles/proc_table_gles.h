@@ -12,6 +12,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/trace_event.h"
+#include "impeller/geometry/scalar.h"
 #include "impeller/renderer/backend/gles/capabilities_gles.h"
 #include "impeller/renderer/backend/gles/description_gles.h"
 #include "impeller/renderer/backend/gles/gles.h"
@@ -94,6 +95,7 @@ struct GLProc {
   PROC(BlendEquationSeparate);               \
   PROC(BlendFuncSeparate);                   \
   PROC(BufferData);                          \
+  PROC(BufferSubData);                       \
   PROC(CheckFramebufferStatus);              \
   PROC(Clear);                               \
   PROC(ClearColor);                          \
@@ -120,6 +122,7 @@ struct GLProc {
   PROC(DrawElements);                        \
   PROC(Enable);                              \
   PROC(EnableVertexAttribArray);             \
+  PROC(Finish);                              \
   PROC(Flush);                               \
   PROC(FramebufferRenderbuffer);             \
   PROC(FramebufferTexture2D);                \
@@ -168,7 +171,11 @@ struct GLProc {
   PROC(Viewport);                            \
   PROC(ReadPixels);
 
-#define FOR_EACH_IMPELLER_GLES3_PROC(PROC) PROC(BlitFramebuffer);
+#define FOR_EACH_IMPELLER_GLES3_PROC(PROC) \
+  PROC(BlitFramebuffer);                   \
+  PROC(DeleteSync);                        \
+  PROC(FenceSync);                         \
+  PROC(WaitSync);
 
 #define FOR_EACH_IMPELLER_EXT_PROC(PROC) \
   PROC(DiscardFramebufferEXT);           \
@@ -203,7 +210,14 @@ class ProcTableGLES {
 
   bool IsValid() const;
 
-  void ShaderSourceMapping(GLuint shader, const fml::Mapping& mapping) const;
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the source of |shader| to |mapping|, defining the value
+  ///             `SPIRV_CROSS_CONSTANT_ID_N` as `defines[N]` for the
+  ///             specialization constants of the shader.
+  ///
+  void ShaderSourceMapping(GLuint shader,
+                           const fml::Mapping& mapping,
+                           const std::vector<Scalar>& defines = {}) const;
 
   const DescriptionGLES* GetDescription() const;
 
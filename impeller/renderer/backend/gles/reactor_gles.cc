@@ -39,6 +39,17 @@ bool ReactorGLES::RemoveWorker(WorkerID worker) {
   return workers_.erase(worker) == 1;
 }
 
+void ReactorGLES::SetUploadWorker(std::weak_ptr<UploadWorker> worker) {
+  Lock lock(workers_mutex_);
+  upload_worker_ = std::move(worker);
+}
+
+std::shared_ptr<ReactorGLES::UploadWorker> ReactorGLES::GetUploadWorker()
+    const {
+  Lock lock(workers_mutex_);
+  return upload_worker_.lock();
+}
+
 bool ReactorGLES::HasPendingOperations() const {
   Lock ops_lock(ops_mutex_);
   return !ops_.empty();
@@ -80,6 +91,22 @@ bool ReactorGLES::AddOperation(Operation operation) {
   return true;
 }
 
+bool ReactorGLES::AddUploadOperation(Operation operation) {
+  if (!operation) {
+    return false;
+  }
+  auto upload_worker = GetUploadWorker();
+  if (!upload_worker) {
+    return AddOperation(std::move(operation));
+  }
+  {
+    Lock ops_lock(ops_mutex_);
+    upload_ops_.emplace_back(std::move(operation));
+  }
+  upload_worker->OnUploadOperationsPending();
+  return true;
+}
+
 static std::optional<GLuint> CreateGLHandle(const ProcTableGLES& gl,
                                             HandleType type) {
   GLuint handle = GL_NONE;
@@ -104,6 +131,20 @@ static std::optional<GLuint> CreateGLHandle(const ProcTableGLES& gl,
   return std::nullopt;
 }
 
+static bool IsSharedBetweenContexts(HandleType type) {
+  switch (type) {
+    case HandleType::kTexture:
+    case HandleType::kBuffer:
+    case HandleType::kProgram:
+    case HandleType::kRenderBuffer:
+      return true;
+    case HandleType::kUnknown:
+    case HandleType::kFrameBuffer:
+      return false;
+  }
+  return false;
+}
+
 static bool CollectGLHandle(const ProcTableGLES& gl,
                             HandleType type,
                             GLuint handle) {
@@ -188,15 +229,85 @@ bool ReactorGLES::ReactOnce() {
     return false;
   }
   TRACE_EVENT0("impeller", __FUNCTION__);
-  return ConsolidateHandles() && FlushOps();
+  return WaitForUploads() && FlushOps();
 }
 
-bool ReactorGLES::ConsolidateHandles() {
+bool ReactorGLES::ReactToUploads() {
+  auto upload_worker = GetUploadWorker();
+  if (!IsValid() || !upload_worker ||
+      !upload_worker->CanReactorReactOnCurrentThreadNow(*this)) {
+    return false;
+  }
+  TRACE_EVENT0("impeller", "ReactorGLES::ReactToUploads");
+  Lock uploads_lock(uploads_mutex_);
+  if (!ConsolidateHandles(/*shared_only=*/true)) {
+    return false;
+  }
+  decltype(upload_ops_) ops;
+  {
+    Lock ops_lock(ops_mutex_);
+    std::swap(upload_ops_, ops);
+  }
+  if (ops.empty()) {
+    return true;
+  }
+  for (const auto& op : ops) {
+    TRACE_EVENT0("impeller", "ReactorGLES::UploadOperation");
+    op(*this);
+  }
+
+  // Make the uploads visible to the contexts of the other workers. Without
+  // fences, wait for the uploads on this thread instead.
+  const auto& gl = GetProcTable();
+  if (gl.FenceSync.IsAvailable() && gl.WaitSync.IsAvailable() &&
+      gl.DeleteSync.IsAvailable()) {
+    auto fence = gl.FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    gl.Flush();
+    Lock ops_lock(ops_mutex_);
+    upload_fences_.push_back(fence);
+  } else {
+    gl.Finish();
+  }
+  return true;
+}
+
+bool ReactorGLES::WaitForUploads() {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  decltype(upload_ops_) ops;
+  decltype(upload_fences_) fences;
+  {
+    // Wait for any batch of uploads being performed by the upload worker.
+    Lock uploads_lock(uploads_mutex_);
+    Lock ops_lock(ops_mutex_);
+    std::swap(upload_ops_, ops);
+    std::swap(upload_fences_, fences);
+  }
+  const auto& gl = GetProcTable();
+  for (auto fence : fences) {
+    gl.WaitSync(fence, 0, GL_TIMEOUT_IGNORED);
+    gl.DeleteSync(fence);
+  }
+  if (!ConsolidateHandles(/*shared_only=*/false)) {
+    return false;
+  }
+  // The operations that follow may depend on uploads the upload worker has
+  // not gotten to yet.
+  for (const auto& op : ops) {
+    TRACE_EVENT0("impeller", "ReactorGLES::UploadOperation");
+    op(*this);
+  }
+  return true;
+}
+
+bool ReactorGLES::ConsolidateHandles(bool shared_only) {
   TRACE_EVENT0("impeller", __FUNCTION__);
   const auto& gl = GetProcTable();
   WriterLock handles_lock(handles_mutex_);
   std::vector<HandleGLES> handles_to_delete;
   for (auto& handle : handles_) {
+    if (shared_only && !IsSharedBetweenContexts(handle.first.type)) {
+      continue;
+    }
     // Collect dead handles.
     if (handle.second.pending_collection) {
       // This could be false if the handle was created and collected without
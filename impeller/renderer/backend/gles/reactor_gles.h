@@ -28,6 +28,22 @@ class ReactorGLES {
         const ReactorGLES& reactor) const = 0;
   };
 
+  //----------------------------------------------------------------------------
+  /// @brief      A worker with a context of its own that shares objects with
+  ///             the contexts of the other workers. Upload operations are
+  ///             performed by this worker so that large uploads don't stall
+  ///             the operations of the other workers.
+  ///
+  class UploadWorker : public Worker {
+   public:
+    //--------------------------------------------------------------------------
+    /// @brief      Called on the thread that added upload operations. The
+    ///             worker must call `ReactToUploads` soon after on a thread
+    ///             it can react on.
+    ///
+    virtual void OnUploadOperationsPending() = 0;
+  };
+
   using Ref = std::shared_ptr<ReactorGLES>;
 
   ReactorGLES(std::unique_ptr<ProcTableGLES> gl);
@@ -40,6 +56,8 @@ class ReactorGLES {
 
   bool RemoveWorker(WorkerID);
 
+  void SetUploadWorker(std::weak_ptr<UploadWorker> worker);
+
   const ProcTableGLES& GetProcTable() const;
 
   std::optional<GLuint> GetGLHandle(const HandleGLES& handle) const;
@@ -53,8 +71,25 @@ class ReactorGLES {
   using Operation = std::function<void(const ReactorGLES& reactor)>;
   [[nodiscard]] bool AddOperation(Operation operation);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Adds an operation that only creates or updates the contents
+  ///             of shared objects like textures. It is performed by the
+  ///             upload worker if there is one, and its results are made
+  ///             visible to the other workers using a fence. Otherwise, or if
+  ///             the upload worker has not performed it yet the next time
+  ///             the other workers react, they perform it before their own
+  ///             operations.
+  ///
+  [[nodiscard]] bool AddUploadOperation(Operation operation);
+
   [[nodiscard]] bool React();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Performs the pending upload operations. May only be called
+  ///             by the upload worker.
+  ///
+  [[nodiscard]] bool ReactToUploads();
+
  private:
   struct LiveHandle {
     std::optional<GLuint> name;
@@ -73,6 +108,12 @@ class ReactorGLES {
 
   mutable Mutex ops_mutex_;
   std::vector<Operation> ops_ IPLR_GUARDED_BY(ops_mutex_);
+  std::vector<Operation> upload_ops_ IPLR_GUARDED_BY(ops_mutex_);
+  std::vector<GLsync> upload_fences_ IPLR_GUARDED_BY(ops_mutex_);
+
+  // Held while upload operations are performed so that the other workers
+  // never take the fences of a batch of uploads before it is complete.
+  Mutex uploads_mutex_;
 
   // Make sure the container is one where erasing items during iteration doesn't
   // invalidate other iterators.
@@ -86,6 +127,7 @@ class ReactorGLES {
   mutable Mutex workers_mutex_;
   mutable std::map<WorkerID, std::weak_ptr<Worker>> workers_
       IPLR_GUARDED_BY(workers_mutex_);
+  std::weak_ptr<UploadWorker> upload_worker_ IPLR_GUARDED_BY(workers_mutex_);
 
   bool can_set_debug_labels_ = false;
   bool is_valid_ = false;
@@ -96,7 +138,13 @@ class ReactorGLES {
 
   bool CanReactOnCurrentThread() const;
 
-  bool ConsolidateHandles();
+  std::shared_ptr<UploadWorker> GetUploadWorker() const;
+
+  // Only handles of objects shared between contexts are created and collected
+  // when |shared_only| is true.
+  bool ConsolidateHandles(bool shared_only);
+
+  bool WaitForUploads();
 
   bool FlushOps();
 
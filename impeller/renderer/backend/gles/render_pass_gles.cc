@@ -12,6 +12,7 @@
 #include "impeller/renderer/backend/gles/device_buffer_gles.h"
 #include "impeller/renderer/backend/gles/formats_gles.h"
 #include "impeller/renderer/backend/gles/pipeline_gles.h"
+#include "impeller/renderer/backend/gles/state_cache_gles.h"
 #include "impeller/renderer/backend/gles/texture_gles.h"
 
 namespace impeller {
@@ -36,22 +37,22 @@ void RenderPassGLES::OnSetLabel(std::string label) {
   label_ = std::move(label);
 }
 
-void ConfigureBlending(const ProcTableGLES& gl,
+void ConfigureBlending(StateCacheGLES& state,
                        const ColorAttachmentDescriptor* color) {
   if (color->blending_enabled) {
-    gl.Enable(GL_BLEND);
-    gl.BlendFuncSeparate(
+    state.Enable(GL_BLEND);
+    state.BlendFuncSeparate(
         ToBlendFactor(color->src_color_blend_factor),  // src color
         ToBlendFactor(color->dst_color_blend_factor),  // dst color
         ToBlendFactor(color->src_alpha_blend_factor),  // src alpha
         ToBlendFactor(color->dst_alpha_blend_factor)   // dst alpha
     );
-    gl.BlendEquationSeparate(
+    state.BlendEquationSeparate(
         ToBlendOperation(color->color_blend_op),  // mode color
         ToBlendOperation(color->alpha_blend_op)   // mode alpha
     );
   } else {
-    gl.Disable(GL_BLEND);
+    state.Disable(GL_BLEND);
   }
 
   {
@@ -63,53 +64,54 @@ void ConfigureBlending(const ProcTableGLES& gl,
                  : GL_FALSE;
     };
 
-    gl.ColorMask(is_set(color->write_mask, ColorWriteMask::kRed),    // red
-                 is_set(color->write_mask, ColorWriteMask::kGreen),  // green
-                 is_set(color->write_mask, ColorWriteMask::kBlue),   // blue
-                 is_set(color->write_mask, ColorWriteMask::kAlpha)   // alpha
+    state.ColorMask(is_set(color->write_mask, ColorWriteMask::kRed),    // red
+                    is_set(color->write_mask, ColorWriteMask::kGreen),  // green
+                    is_set(color->write_mask, ColorWriteMask::kBlue),   // blue
+                    is_set(color->write_mask, ColorWriteMask::kAlpha)   // alpha
     );
   }
 }
 
 void ConfigureStencil(GLenum face,
-                      const ProcTableGLES& gl,
+                      StateCacheGLES& state,
                       const StencilAttachmentDescriptor& stencil,
                       uint32_t stencil_reference) {
-  gl.StencilOpSeparate(
+  state.StencilOpSeparate(
       face,                                    // face
       ToStencilOp(stencil.stencil_failure),    // stencil fail
       ToStencilOp(stencil.depth_failure),      // depth fail
       ToStencilOp(stencil.depth_stencil_pass)  // depth stencil pass
   );
-  gl.StencilFuncSeparate(face,                                        // face
-                         ToCompareFunction(stencil.stencil_compare),  // func
-                         stencil_reference,                           // ref
-                         stencil.read_mask                            // mask
+  state.StencilFuncSeparate(
+      face,                                        // face
+      ToCompareFunction(stencil.stencil_compare),  // func
+      stencil_reference,                           // ref
+      stencil.read_mask                            // mask
   );
-  gl.StencilMaskSeparate(face, stencil.write_mask);
+  state.StencilMaskSeparate(face, stencil.write_mask);
 }
 
-void ConfigureStencil(const ProcTableGLES& gl,
+void ConfigureStencil(StateCacheGLES& state,
                       const PipelineDescriptor& pipeline,
                       uint32_t stencil_reference) {
   if (!pipeline.HasStencilAttachmentDescriptors()) {
-    gl.Disable(GL_STENCIL_TEST);
+    state.Disable(GL_STENCIL_TEST);
     return;
   }
 
-  gl.Enable(GL_STENCIL_TEST);
+  state.Enable(GL_STENCIL_TEST);
   const auto& front = pipeline.GetFrontStencilAttachmentDescriptor();
   const auto& back = pipeline.GetBackStencilAttachmentDescriptor();
 
   if (front.has_value() && back.has_value() && front == back) {
-    ConfigureStencil(GL_FRONT_AND_BACK, gl, *front, stencil_reference);
+    ConfigureStencil(GL_FRONT_AND_BACK, state, *front, stencil_reference);
     return;
   }
   if (front.has_value()) {
-    ConfigureStencil(GL_FRONT, gl, *front, stencil_reference);
+    ConfigureStencil(GL_FRONT, state, *front, stencil_reference);
   }
   if (back.has_value()) {
-    ConfigureStencil(GL_BACK, gl, *back, stencil_reference);
+    ConfigureStencil(GL_BACK, state, *back, stencil_reference);
   }
 }
 
@@ -151,6 +153,7 @@ struct RenderPassData {
   }
 
   const auto& gl = reactor.GetProcTable();
+  StateCacheGLES state(gl);
 
   fml::ScopedCleanupClosure pop_pass_debug_marker(
       [&gl]() { gl.PopDebugGroup(); });
@@ -224,15 +227,20 @@ struct RenderPassData {
     clear_bits |= GL_STENCIL_BUFFER_BIT;
   }
 
-  gl.Disable(GL_SCISSOR_TEST);
-  gl.Disable(GL_DEPTH_TEST);
-  gl.Disable(GL_STENCIL_TEST);
-  gl.Disable(GL_CULL_FACE);
-  gl.Disable(GL_BLEND);
-  gl.ColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+  state.Disable(GL_SCISSOR_TEST);
+  state.Disable(GL_DEPTH_TEST);
+  state.Disable(GL_STENCIL_TEST);
+  state.Disable(GL_CULL_FACE);
+  state.Disable(GL_BLEND);
+  state.ColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
 
   gl.Clear(clear_bits);
 
+  // The program and vertex attribute arrays of the last pipeline bound. They
+  // are only unbound when the next command uses a different pipeline, or once
+  // all commands are encoded.
+  const PipelineGLES* bound_pipeline = nullptr;
+
   for (const auto& command : commands) {
     if (command.instance_count != 1u) {
       VALIDATION_LOG << "GLES backend does not support instanced rendering.";
@@ -267,12 +275,13 @@ struct RenderPassData {
     //--------------------------------------------------------------------------
     /// Configure blending.
     ///
-    ConfigureBlending(gl, color_attachment);
+    ConfigureBlending(state, color_attachment);
 
     //--------------------------------------------------------------------------
     /// Setup stencil.
     ///
-    ConfigureStencil(gl, pipeline.GetDescriptor(), command.stencil_reference);
+    ConfigureStencil(state, pipeline.GetDescriptor(),
+                     command.stencil_reference);
 
     //--------------------------------------------------------------------------
     /// Configure depth.
@@ -280,11 +289,11 @@ struct RenderPassData {
     if (auto depth =
             pipeline.GetDescriptor().GetDepthStencilAttachmentDescriptor();
         depth.has_value()) {
-      gl.Enable(GL_DEPTH_TEST);
-      gl.DepthFunc(ToCompareFunction(depth->depth_compare));
-      gl.DepthMask(depth->depth_write_enabled ? GL_TRUE : GL_FALSE);
+      state.Enable(GL_DEPTH_TEST);
+      state.DepthFunc(ToCompareFunction(depth->depth_compare));
+      state.DepthMask(depth->depth_write_enabled ? GL_TRUE : GL_FALSE);
     } else {
-      gl.Disable(GL_DEPTH_TEST);
+      state.Disable(GL_DEPTH_TEST);
     }
 
     // Both the viewport and scissor are specified in framebuffer coordinates.
@@ -296,14 +305,15 @@ struct RenderPassData {
     /// Setup the viewport.
     ///
     const auto& viewport = command.viewport.value_or(pass_data.viewport);
-    gl.Viewport(viewport.rect.origin.x,  // x
-                target_size.height - viewport.rect.origin.y -
-                    viewport.rect.size.height,  // y
-                viewport.rect.size.width,       // width
-                viewport.rect.size.height       // height
+    state.Viewport(viewport.rect.origin.x,  // x
+                   target_size.height - viewport.rect.origin.y -
+                       viewport.rect.size.height,  // y
+                   viewport.rect.size.width,       // width
+                   viewport.rect.size.height       // height
     );
     if (pass_data.depth_attachment) {
-      gl.DepthRangef(viewport.depth_range.z_near, viewport.depth_range.z_far);
+      state.DepthRangef(viewport.depth_range.z_near,
+                        viewport.depth_range.z_far);
     }
 
     //--------------------------------------------------------------------------
@@ -311,15 +321,15 @@ struct RenderPassData {
     ///
     if (command.scissor.has_value()) {
       const auto& scissor = command.scissor.value();
-      gl.Enable(GL_SCISSOR_TEST);
-      gl.Scissor(
+      state.Enable(GL_SCISSOR_TEST);
+      state.Scissor(
           scissor.origin.x,                                             // x
           target_size.height - scissor.origin.y - scissor.size.height,  // y
           scissor.size.width,                                           // width
           scissor.size.height  // height
       );
     } else {
-      gl.Disable(GL_SCISSOR_TEST);
+      state.Disable(GL_SCISSOR_TEST);
     }
 
     //--------------------------------------------------------------------------
@@ -327,15 +337,15 @@ struct RenderPassData {
     ///
     switch (pipeline.GetDescriptor().GetCullMode()) {
       case CullMode::kNone:
-        gl.Disable(GL_CULL_FACE);
+        state.Disable(GL_CULL_FACE);
         break;
       case CullMode::kFrontFace:
-        gl.Enable(GL_CULL_FACE);
-        gl.CullFace(GL_FRONT);
+        state.Enable(GL_CULL_FACE);
+        state.CullFace(GL_FRONT);
         break;
       case CullMode::kBackFace:
-        gl.Enable(GL_CULL_FACE);
-        gl.CullFace(GL_BACK);
+        state.Enable(GL_CULL_FACE);
+        state.CullFace(GL_BACK);
         break;
     }
     //--------------------------------------------------------------------------
@@ -343,10 +353,10 @@ struct RenderPassData {
     ///
     switch (pipeline.GetDescriptor().GetWindingOrder()) {
       case WindingOrder::kClockwise:
-        gl.FrontFace(GL_CW);
+        state.FrontFace(GL_CW);
         break;
       case WindingOrder::kCounterClockwise:
-        gl.FrontFace(GL_CCW);
+        state.FrontFace(GL_CCW);
         break;
     }
 
@@ -378,10 +388,21 @@ struct RenderPassData {
       return false;
     }
 
+    //--------------------------------------------------------------------------
+    /// Unbind the vertex attribs of the previous pipeline, if different.
+    ///
+    if (bound_pipeline && bound_pipeline != &pipeline) {
+      if (!bound_pipeline->GetBufferBindings()->UnbindVertexAttributes(
+              state)) {
+        return false;
+      }
+    }
+    bound_pipeline = &pipeline;
+
     //--------------------------------------------------------------------------
     /// Bind the pipeline program.
     ///
-    if (!pipeline.BindProgram()) {
+    if (!pipeline.BindProgram(state)) {
       return false;
     }
 
@@ -389,7 +410,7 @@ struct RenderPassData {
     /// Bind vertex attribs.
     ///
     if (!vertex_desc_gles->BindVertexAttributes(
-            gl, vertex_buffer_view.range.offset)) {
+            state, vertex_buffer_view.range.offset)) {
       return false;
     }
 
@@ -438,18 +459,16 @@ struct RenderPassData {
                           index_buffer_view.range.offset))  // indices
       );
     }
+  }
 
-    //--------------------------------------------------------------------------
-    /// Unbind vertex attribs.
-    ///
-    if (!vertex_desc_gles->UnbindVertexAttributes(gl)) {
+  //----------------------------------------------------------------------------
+  /// Unbind the vertex attribs and program of the last pipeline.
+  ///
+  if (bound_pipeline) {
+    if (!bound_pipeline->GetBufferBindings()->UnbindVertexAttributes(state)) {
       return false;
     }
-
-    //--------------------------------------------------------------------------
-    /// Unbind the program pipeline.
-    ///
-    if (!pipeline.UnbindProgram()) {
+    if (!bound_pipeline->UnbindProgram(state)) {
       return false;
     }
   }
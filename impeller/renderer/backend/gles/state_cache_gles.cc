@@ -0,0 +1,179 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/gles/state_cache_gles.h"
+
+#include "flutter/fml/metrics.h"
+
+namespace impeller {
+
+StateCacheGLES::StateCacheGLES(const ProcTableGLES& gl) : gl_(gl) {}
+
+StateCacheGLES::~StateCacheGLES() {
+  FML_COUNTER_ADD("impeller.gles.state_calls_issued", issued_count_);
+  FML_COUNTER_ADD("impeller.gles.state_calls_elided", elided_count_);
+}
+
+std::optional<StateCacheGLES::Cap> StateCacheGLES::ToCap(GLenum cap) {
+  switch (cap) {
+    case GL_BLEND:
+      return Cap::kBlend;
+    case GL_CULL_FACE:
+      return Cap::kCullFace;
+    case GL_DEPTH_TEST:
+      return Cap::kDepthTest;
+    case GL_SCISSOR_TEST:
+      return Cap::kScissorTest;
+    case GL_STENCIL_TEST:
+      return Cap::kStencilTest;
+  }
+  return std::nullopt;
+}
+
+void StateCacheGLES::SetCap(GLenum cap, bool enabled) {
+  if (auto shadowed = ToCap(cap);
+      shadowed.has_value() &&
+      !Update(caps_[static_cast<size_t>(shadowed.value())], enabled)) {
+    return;
+  }
+  if (enabled) {
+    gl_.Enable(cap);
+  } else {
+    gl_.Disable(cap);
+  }
+}
+
+void StateCacheGLES::Enable(GLenum cap) {
+  SetCap(cap, true);
+}
+
+void StateCacheGLES::Disable(GLenum cap) {
+  SetCap(cap, false);
+}
+
+void StateCacheGLES::BlendFuncSeparate(GLenum src_color,
+                                       GLenum dst_color,
+                                       GLenum src_alpha,
+                                       GLenum dst_alpha) {
+  if (Update(blend_func_, {src_color, dst_color, src_alpha, dst_alpha})) {
+    gl_.BlendFuncSeparate(src_color, dst_color, src_alpha, dst_alpha);
+  }
+}
+
+void StateCacheGLES::BlendEquationSeparate(GLenum color, GLenum alpha) {
+  if (Update(blend_equation_, {color, alpha})) {
+    gl_.BlendEquationSeparate(color, alpha);
+  }
+}
+
+void StateCacheGLES::ColorMask(GLboolean red,
+                               GLboolean green,
+                               GLboolean blue,
+                               GLboolean alpha) {
+  if (Update(color_mask_, {red, green, blue, alpha})) {
+    gl_.ColorMask(red, green, blue, alpha);
+  }
+}
+
+void StateCacheGLES::StencilOpSeparate(GLenum face,
+                                       GLenum stencil_fail,
+                                       GLenum depth_fail,
+                                       GLenum depth_stencil_pass) {
+  if (UpdateStencil(face, &StencilFaceState::op,
+                    {stencil_fail, depth_fail, depth_stencil_pass})) {
+    gl_.StencilOpSeparate(face, stencil_fail, depth_fail, depth_stencil_pass);
+  }
+}
+
+void StateCacheGLES::StencilFuncSeparate(GLenum face,
+                                         GLenum func,
+                                         GLint ref,
+                                         GLuint mask) {
+  if (UpdateStencil(face, &StencilFaceState::func,
+                    {func, static_cast<GLuint>(ref), mask})) {
+    gl_.StencilFuncSeparate(face, func, ref, mask);
+  }
+}
+
+void StateCacheGLES::StencilMaskSeparate(GLenum face, GLuint mask) {
+  if (UpdateStencil(face, &StencilFaceState::write_mask, mask)) {
+    gl_.StencilMaskSeparate(face, mask);
+  }
+}
+
+void StateCacheGLES::DepthFunc(GLenum func) {
+  if (Update(depth_func_, func)) {
+    gl_.DepthFunc(func);
+  }
+}
+
+void StateCacheGLES::DepthMask(GLboolean mask) {
+  if (Update(depth_mask_, mask)) {
+    gl_.DepthMask(mask);
+  }
+}
+
+void StateCacheGLES::DepthRangef(GLfloat z_near, GLfloat z_far) {
+  if (Update(depth_range_, {z_near, z_far})) {
+    gl_.DepthRangef(z_near, z_far);
+  }
+}
+
+void StateCacheGLES::Viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+  if (Update(viewport_, {x, y, width, height})) {
+    gl_.Viewport(x, y, width, height);
+  }
+}
+
+void StateCacheGLES::Scissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+  if (Update(scissor_, {x, y, width, height})) {
+    gl_.Scissor(x, y, width, height);
+  }
+}
+
+void StateCacheGLES::CullFace(GLenum mode) {
+  if (Update(cull_face_, mode)) {
+    gl_.CullFace(mode);
+  }
+}
+
+void StateCacheGLES::FrontFace(GLenum mode) {
+  if (Update(front_face_, mode)) {
+    gl_.FrontFace(mode);
+  }
+}
+
+void StateCacheGLES::UseProgram(GLuint program) {
+  if (Update(program_, program)) {
+    gl_.UseProgram(program);
+  }
+}
+
+void StateCacheGLES::SetVertexAttribArray(GLuint index, bool enabled) {
+  if (index < kMaxShadowedVertexAttribs) {
+    if (known_vertex_attribs_[index] &&
+        enabled_vertex_attribs_[index] == enabled) {
+      elided_count_++;
+      return;
+    }
+    known_vertex_attribs_[index] = true;
+    enabled_vertex_attribs_[index] = enabled;
+    issued_count_++;
+  }
+  if (enabled) {
+    gl_.EnableVertexAttribArray(index);
+  } else {
+    gl_.DisableVertexAttribArray(index);
+  }
+}
+
+void StateCacheGLES::EnableVertexAttribArray(GLuint index) {
+  SetVertexAttribArray(index, true);
+}
+
+void StateCacheGLES::DisableVertexAttribArray(GLuint index) {
+  SetVertexAttribArray(index, false);
+}
+
+}  // namespace impeller
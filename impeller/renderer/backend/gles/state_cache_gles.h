@@ -0,0 +1,170 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <optional>
+
+#include "flutter/fml/macros.h"
+#include "impeller/renderer/backend/gles/proc_table_gles.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A shadow of the fixed function, program and vertex attribute
+///             array state of the current GL context, through which calls that
+///             would not change that state are elided.
+///
+///             The state is unknown until it is first set through the cache,
+///             so the first call for each piece of state is always issued. The
+///             cache must only be used while nothing else changes the state it
+///             shadows on the context, for example while encoding a render
+///             pass in the reactor.
+///
+///             The number of calls issued and elided is added to the
+///             `impeller.gles.state_calls_issued` and
+///             `impeller.gles.state_calls_elided` counters when the cache is
+///             destroyed.
+///
+class StateCacheGLES {
+ public:
+  explicit StateCacheGLES(const ProcTableGLES& gl);
+
+  ~StateCacheGLES();
+
+  const ProcTableGLES& GetProcTable() const { return gl_; }
+
+  void Enable(GLenum cap);
+
+  void Disable(GLenum cap);
+
+  void BlendFuncSeparate(GLenum src_color,
+                         GLenum dst_color,
+                         GLenum src_alpha,
+                         GLenum dst_alpha);
+
+  void BlendEquationSeparate(GLenum color, GLenum alpha);
+
+  void ColorMask(GLboolean red,
+                 GLboolean green,
+                 GLboolean blue,
+                 GLboolean alpha);
+
+  void StencilOpSeparate(GLenum face,
+                         GLenum stencil_fail,
+                         GLenum depth_fail,
+                         GLenum depth_stencil_pass);
+
+  void StencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask);
+
+  void StencilMaskSeparate(GLenum face, GLuint mask);
+
+  void DepthFunc(GLenum func);
+
+  void DepthMask(GLboolean mask);
+
+  void DepthRangef(GLfloat z_near, GLfloat z_far);
+
+  void Viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+  void Scissor(GLint x, GLint y, GLsizei width, GLsizei height);
+
+  void CullFace(GLenum mode);
+
+  void FrontFace(GLenum mode);
+
+  void UseProgram(GLuint program);
+
+  void EnableVertexAttribArray(GLuint index);
+
+  void DisableVertexAttribArray(GLuint index);
+
+ private:
+  // The capabilities whose enabled state is shadowed.
+  enum class Cap {
+    kBlend,
+    kCullFace,
+    kDepthTest,
+    kScissorTest,
+    kStencilTest,
+  };
+  static constexpr size_t kCapCount = 5u;
+
+  // Vertex attribute arrays at or above this index are not shadowed.
+  static constexpr GLuint kMaxShadowedVertexAttribs = 16u;
+
+  struct StencilFaceState {
+    std::optional<std::array<GLenum, 3>> op;
+    std::optional<std::array<GLuint, 3>> func;
+    std::optional<GLuint> write_mask;
+  };
+
+  const ProcTableGLES& gl_;
+  std::array<std::optional<bool>, kCapCount> caps_;
+  std::optional<std::array<GLenum, 4>> blend_func_;
+  std::optional<std::array<GLenum, 2>> blend_equation_;
+  std::optional<std::array<GLboolean, 4>> color_mask_;
+  StencilFaceState front_stencil_;
+  StencilFaceState back_stencil_;
+  std::optional<GLenum> depth_func_;
+  std::optional<GLboolean> depth_mask_;
+  std::optional<std::array<GLfloat, 2>> depth_range_;
+  std::optional<std::array<GLint, 4>> viewport_;
+  std::optional<std::array<GLint, 4>> scissor_;
+  std::optional<GLenum> cull_face_;
+  std::optional<GLenum> front_face_;
+  std::optional<GLuint> program_;
+  std::bitset<kMaxShadowedVertexAttribs> known_vertex_attribs_;
+  std::bitset<kMaxShadowedVertexAttribs> enabled_vertex_attribs_;
+  size_t issued_count_ = 0u;
+  size_t elided_count_ = 0u;
+
+  static std::optional<Cap> ToCap(GLenum cap);
+
+  void SetCap(GLenum cap, bool enabled);
+
+  void SetVertexAttribArray(GLuint index, bool enabled);
+
+  // Updates |state| with |value|. Returns whether the call setting it must be
+  // issued.
+  template <class T>
+  bool Update(std::optional<T>& state, const T& value) {
+    if (state.has_value() && state.value() == value) {
+      elided_count_++;
+      return false;
+    }
+    state = value;
+    issued_count_++;
+    return true;
+  }
+
+  // Updates the stencil state of |face|, which may be both faces, with
+  // |value|. Returns whether the call setting it must be issued.
+  template <class T>
+  bool UpdateStencil(GLenum face,
+                     std::optional<T> StencilFaceState::*member,
+                     const T& value) {
+    const bool front = face != GL_BACK;
+    const bool back = face != GL_FRONT;
+    if ((!front || front_stencil_.*member == value) &&
+        (!back || back_stencil_.*member == value)) {
+      elided_count_++;
+      return false;
+    }
+    if (front) {
+      front_stencil_.*member = value;
+    }
+    if (back) {
+      back_stencil_.*member = value;
+    }
+    issued_count_++;
+    return true;
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(StateCacheGLES);
+};
+
+}  // namespace impeller
@@ -6,8 +6,11 @@
 
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/config.h"
+#include "impeller/base/validation.h"
 #include "impeller/renderer/backend/gles/context_gles.h"
 #include "impeller/renderer/backend/gles/texture_gles.h"
+#include "impeller/renderer/blit_pass.h"
+#include "impeller/renderer/command_buffer.h"
 
 namespace impeller {
 
@@ -16,7 +19,8 @@ std::unique_ptr<Surface> SurfaceGLES::WrapFBO(
     SwapCallback swap_callback,
     GLuint fbo,
     PixelFormat color_format,
-    ISize fbo_size) {
+    ISize fbo_size,
+    std::optional<IRect> clip_rect) {
   TRACE_EVENT0("impeller", "SurfaceGLES::WrapOnScreenFBO");
 
   if (context == nullptr || !context->IsValid() || !swap_callback) {
@@ -60,6 +64,19 @@ std::unique_ptr<Surface> SurfaceGLES::WrapFBO(
   render_target_desc.SetColorAttachment(color0, 0u);
   render_target_desc.SetStencilAttachment(stencil0);
 
+  if (clip_rect.has_value() && !clip_rect->IsEmpty() &&
+      context->GetCapabilities()->SupportsTextureToTextureBlits()) {
+    RenderTargetAllocator allocator(context->GetResourceAllocator());
+    auto partial_target = RenderTarget::CreateOffscreen(
+        *context, allocator, clip_rect->size, "Partial Repaint");
+    if (partial_target.IsValid()) {
+      return std::unique_ptr<SurfaceGLES>(
+          new SurfaceGLES(std::move(swap_callback), partial_target, context,
+                          color0.texture, clip_rect->origin));
+    }
+    VALIDATION_LOG << "Could not create the partial repaint render target.";
+  }
+
   return std::unique_ptr<SurfaceGLES>(
       new SurfaceGLES(std::move(swap_callback), render_target_desc));
 }
@@ -68,11 +85,44 @@ SurfaceGLES::SurfaceGLES(SwapCallback swap_callback,
                          const RenderTarget& target_desc)
     : Surface(target_desc), swap_callback_(std::move(swap_callback)) {}
 
+SurfaceGLES::SurfaceGLES(SwapCallback swap_callback,
+                         const RenderTarget& target_desc,
+                         std::weak_ptr<Context> context,
+                         std::shared_ptr<Texture> blit_destination,
+                         IPoint blit_origin)
+    : Surface(target_desc),
+      swap_callback_(std::move(swap_callback)),
+      context_(std::move(context)),
+      blit_destination_(std::move(blit_destination)),
+      blit_origin_(blit_origin) {}
+
 // |Surface|
 SurfaceGLES::~SurfaceGLES() = default;
 
 // |Surface|
 bool SurfaceGLES::Present() const {
+  if (blit_destination_) {
+    auto context = context_.lock();
+    if (!context) {
+      return false;
+    }
+    auto command_buffer = context->CreateCommandBuffer();
+    if (!command_buffer) {
+      return false;
+    }
+    command_buffer->SetLabel("Partial Repaint Blit");
+    auto blit_pass = command_buffer->CreateBlitPass();
+    if (!blit_pass ||
+        !blit_pass->AddCopy(
+            GetTargetRenderPassDescriptor().GetRenderTargetTexture(),
+            blit_destination_, std::nullopt, blit_origin_) ||
+        !blit_pass->EncodeCommands(context->GetResourceAllocator()) ||
+        !command_buffer->SubmitCommands()) {
+      VALIDATION_LOG << "Could not blit the partial repaint into the "
+                        "framebuffer.";
+      return false;
+    }
+  }
   return swap_callback_ ? swap_callback_() : false;
 }
 
@@ -6,6 +6,7 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
 
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/backend/gles/gles.h"
@@ -18,21 +19,42 @@ class SurfaceGLES final : public Surface {
  public:
   using SwapCallback = std::function<bool(void)>;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Wraps the default framebuffer.
+  ///
+  /// @param[in]  clip_rect  If set, only this part of the framebuffer is
+  ///                        repainted. The surface then renders into a texture
+  ///                        of the size of the clip rect, which is blitted
+  ///                        into the framebuffer on present. Ignored if the
+  ///                        context can't blit between textures.
+  ///
   static std::unique_ptr<Surface> WrapFBO(
       const std::shared_ptr<Context>& context,
       SwapCallback swap_callback,
       GLuint fbo,
       PixelFormat color_format,
-      ISize fbo_size);
+      ISize fbo_size,
+      std::optional<IRect> clip_rect = std::nullopt);
 
   // |Surface|
   ~SurfaceGLES() override;
 
  private:
   SwapCallback swap_callback_;
+  std::weak_ptr<Context> context_;
+  // The framebuffer texture the render target is blitted into on present when
+  // repainting partially.
+  std::shared_ptr<Texture> blit_destination_;
+  IPoint blit_origin_;
 
   SurfaceGLES(SwapCallback swap_callback, const RenderTarget& target_desc);
 
+  SurfaceGLES(SwapCallback swap_callback,
+              const RenderTarget& target_desc,
+              std::weak_ptr<Context> context,
+              std::shared_ptr<Texture> blit_destination,
+              IPoint blit_origin);
+
   // |Surface|
   bool Present() const override;
 
@@ -126,6 +126,12 @@ struct TexImage2DData {
       case PixelFormat::kB10G10R10XRSRGB:
       case PixelFormat::kB10G10R10XR:
       case PixelFormat::kB10G10R10A10XR:
+      case PixelFormat::kETC2R8G8B8UNormInt:
+      case PixelFormat::kETC2R8G8B8A8UNormInt:
+      case PixelFormat::kASTC4x4UNormInt:
+      case PixelFormat::kBC1R8G8B8A8UNormInt:
+      case PixelFormat::kBC3R8G8B8A8UNormInt:
+      case PixelFormat::kBC7R8G8B8A8UNormInt:
         return;
     }
     is_valid_ = true;
@@ -175,6 +181,12 @@ struct TexImage2DData {
       case PixelFormat::kB10G10R10XRSRGB:
       case PixelFormat::kB10G10R10XR:
       case PixelFormat::kB10G10R10A10XR:
+      case PixelFormat::kETC2R8G8B8UNormInt:
+      case PixelFormat::kETC2R8G8B8A8UNormInt:
+      case PixelFormat::kASTC4x4UNormInt:
+      case PixelFormat::kBC1R8G8B8A8UNormInt:
+      case PixelFormat::kBC3R8G8B8A8UNormInt:
+      case PixelFormat::kBC7R8G8B8A8UNormInt:
         return;
     }
     is_valid_ = true;
@@ -296,7 +308,7 @@ bool TextureGLES::OnSetContents(std::shared_ptr<const fml::Mapping> mapping,
     }
   };
 
-  contents_initialized_ = reactor_->AddOperation(texture_upload);
+  contents_initialized_ = reactor_->AddUploadOperation(texture_upload);
   return contents_initialized_;
 }
 
@@ -329,6 +341,12 @@ static std::optional<GLenum> ToRenderBufferFormat(PixelFormat format) {
     case PixelFormat::kB10G10R10XRSRGB:
     case PixelFormat::kB10G10R10XR:
     case PixelFormat::kB10G10R10A10XR:
+    case PixelFormat::kETC2R8G8B8UNormInt:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kASTC4x4UNormInt:
+    case PixelFormat::kBC1R8G8B8A8UNormInt:
+    case PixelFormat::kBC3R8G8B8A8UNormInt:
+    case PixelFormat::kBC7R8G8B8A8UNormInt:
       return std::nullopt;
   }
   FML_UNREACHABLE();
@@ -484,7 +502,8 @@ static GLenum ToAttachmentPoint(TextureGLES::AttachmentPoint point) {
 
 bool TextureGLES::SetAsFramebufferAttachment(GLenum target,
                                              GLuint fbo,
-                                             AttachmentPoint point) const {
+                                             AttachmentPoint point,
+                                             size_t mip_level) const {
   if (!IsValid()) {
     return false;
   }
@@ -496,11 +515,11 @@ bool TextureGLES::SetAsFramebufferAttachment(GLenum target,
   const auto& gl = reactor_->GetProcTable();
   switch (type_) {
     case Type::kTexture:
-      gl.FramebufferTexture2D(target,                    // target
-                              ToAttachmentPoint(point),  // attachment
-                              GL_TEXTURE_2D,             // textarget
-                              handle.value(),            // texture
-                              0                          // level
+      gl.FramebufferTexture2D(target,                         // target
+                              ToAttachmentPoint(point),       // attachment
+                              GL_TEXTURE_2D,                  // textarget
+                              handle.value(),                 // texture
+                              static_cast<GLint>(mip_level)   // level
       );
       break;
     case Type::kRenderBuffer:
@@ -46,7 +46,8 @@ class TextureGLES final : public Texture,
   };
   [[nodiscard]] bool SetAsFramebufferAttachment(GLenum target,
                                                 GLuint fbo,
-                                                AttachmentPoint point) const;
+                                                AttachmentPoint point,
+                                                size_t mip_level = 0u) const;
 
   Type GetType() const;
 
@@ -203,8 +203,20 @@ std::shared_ptr<Texture> AllocatorMTL::OnCreateTexture(
     return nullptr;
   }
 
+  auto storage_mode = desc.storage_mode;
+  // Memoryless textures can only be used as attachments. The caller specified
+  // incorrect usage flags and is attempting to access a device transient
+  // texture in a shader. Back it with private storage instead, like the Vulkan
+  // backend does. See: https://github.com/flutter/flutter/issues/121633
+  constexpr auto kShaderUsage =
+      static_cast<TextureUsageMask>(TextureUsage::kShaderRead) |
+      static_cast<TextureUsageMask>(TextureUsage::kShaderWrite);
+  if (storage_mode == StorageMode::kDeviceTransient &&
+      (desc.usage & kShaderUsage)) {
+    storage_mode = StorageMode::kDevicePrivate;
+  }
   mtl_texture_desc.storageMode = ToMTLStorageMode(
-      desc.storage_mode, supports_memoryless_targets_, supports_uma_);
+      storage_mode, supports_memoryless_targets_, supports_uma_);
 
   if (@available(macOS 12.5, ios 15.0, *)) {
     if (desc.compression_type == CompressionType::kLossy &&
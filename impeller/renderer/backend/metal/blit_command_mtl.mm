@@ -39,7 +39,7 @@ bool BlitCopyTextureToTextureCommandMTL::Encode(
 
   [encoder copyFromTexture:source_mtl
                sourceSlice:0
-               sourceLevel:0
+               sourceLevel:source_mip_level
               sourceOrigin:source_origin_mtl
                 sourceSize:source_size_mtl
                  toTexture:destination_mtl
@@ -119,12 +119,11 @@ bool BlitCopyBufferToTextureCommandMTL::Encode(
   auto image_size = destination->GetTextureDescriptor().size;
   auto source_size_mtl = MTLSizeMake(image_size.width, image_size.height, 1);
 
-  auto destination_bytes_per_pixel =
-      BytesPerPixelForPixelFormat(destination->GetTextureDescriptor().format);
+  // For block compressed formats, these are the sizes of the rows of blocks.
   auto destination_bytes_per_row =
-      source_size_mtl.width * destination_bytes_per_pixel;
+      destination->GetTextureDescriptor().GetBytesPerRow();
   auto destination_bytes_per_image =
-      source_size_mtl.height * destination_bytes_per_row;
+      destination->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
 
   [encoder copyFromBuffer:source_mtl
              sourceOffset:source.range.offset
@@ -93,6 +93,7 @@ bool BlitPassMTL::OnCopyTextureToTextureCommand(
     std::shared_ptr<Texture> destination,
     IRect source_region,
     IPoint destination_origin,
+    size_t source_mip_level,
     std::string label) {
   auto command = std::make_unique<BlitCopyTextureToTextureCommandMTL>();
   command->label = label;
@@ -100,6 +101,7 @@ bool BlitPassMTL::OnCopyTextureToTextureCommand(
   command->destination = std::move(destination);
   command->source_region = source_region;
   command->destination_origin = destination_origin;
+  command->source_mip_level = source_mip_level;
 
   commands_.emplace_back(std::move(command));
   return true;
@@ -158,7 +158,35 @@ static CommandBuffer::Status ToCommitResult(MTLCommandBufferStatus status) {
   return CommandBufferMTL::Status::kError;
 }
 
+// Metal times whole command buffers, so the command buffer is reported as a
+// single pass.
+static void TraceGPUTime(const std::weak_ptr<const Context>& weak_context,
+                         id<MTLCommandBuffer> buffer) {
+  auto context = weak_context.lock();
+  if (!context || !context->GetGPUTracer()->IsSupported()) {
+    return;
+  }
+  auto tracer = context->GetGPUTracer();
+  const auto submission = tracer->WillSubmitCommandBuffer();
+  if (submission == 0u) {
+    return;
+  }
+  [buffer addCompletedHandler:^(id<MTLCommandBuffer> completed) {
+    std::vector<GPUTracer::PassTime> passes;
+    if (completed.status == MTLCommandBufferStatusCompleted &&
+        completed.GPUEndTime > completed.GPUStartTime) {
+      const auto label = completed.label ? completed.label.UTF8String : "";
+      passes.push_back(
+          {label, fml::TimeDelta::Zero(),
+           fml::TimeDelta::FromSecondsF(completed.GPUEndTime -
+                                        completed.GPUStartTime)});
+    }
+    tracer->DidCompleteCommandBuffer(submission, passes);
+  }];
+}
+
 bool CommandBufferMTL::OnSubmitCommands(CompletionCallback callback) {
+  TraceGPUTime(context_, buffer_);
   if (callback) {
     [buffer_
         addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
@@ -186,6 +214,7 @@ bool CommandBufferMTL::SubmitCommandsAsync(
   if (!context) {
     return false;
   }
+  TraceGPUTime(context_, buffer_);
   [buffer_ enqueue];
   auto buffer = buffer_;
   buffer_ = nil;
@@ -6,6 +6,7 @@
 
 #include <Foundation/Foundation.h>
 
+#include "flutter/fml/build_config.h"
 #include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/logging.h"
@@ -48,6 +49,30 @@ static bool DeviceSupportsComputeSubgroups(id<MTLDevice> device) {
   return supports_subgroups;
 }
 
+static bool DeviceSupportsMobileTextureCompression(id<MTLDevice> device) {
+  // ETC2 and ASTC are supported by all Apple GPUs, and by Apple silicon Macs.
+  if (@available(ios 13.0, tvos 13.0, macos 10.15, *)) {
+    return [device supportsFamily:MTLGPUFamilyApple2];
+  }
+#if FML_OS_IOS
+  return true;
+#else
+  return false;
+#endif  // FML_OS_IOS
+}
+
+static bool DeviceSupportsBCTextureCompression(id<MTLDevice> device) {
+  if (@available(ios 16.4, tvos 16.4, macos 11.0, *)) {
+    return device.supportsBCTextureCompression;
+  }
+#if FML_OS_IOS
+  return false;
+#else
+  // All Mac GPUs prior to Apple silicon support BC.
+  return true;
+#endif  // FML_OS_IOS
+}
+
 static std::unique_ptr<Capabilities> InferMetalCapabilities(
     id<MTLDevice> device,
     PixelFormat color_format) {
@@ -66,6 +91,12 @@ static std::unique_ptr<Capabilities> InferMetalCapabilities(
       .SetSupportsReadFromResolve(true)
       .SetSupportsReadFromOnscreenTexture(true)
       .SetSupportsDeviceTransientTextures(true)
+      .SetSupportsETC2TextureCompression(
+          DeviceSupportsMobileTextureCompression(device))
+      .SetSupportsASTCTextureCompression(
+          DeviceSupportsMobileTextureCompression(device))
+      .SetSupportsBCTextureCompression(
+          DeviceSupportsBCTextureCompression(device))
       .Build();
 }
 
@@ -121,7 +152,8 @@ ContextMTL::ContextMTL(
   // Setup the pipeline library.
   {
     pipeline_library_ =
-        std::shared_ptr<PipelineLibraryMTL>(new PipelineLibraryMTL(device_));
+        std::shared_ptr<PipelineLibraryMTL>(new PipelineLibraryMTL(
+            device_, raster_message_loop_->GetTaskRunner()));
   }
 
   // Setup the sampler library.
@@ -143,6 +175,9 @@ ContextMTL::ContextMTL(
   device_capabilities_ =
       InferMetalCapabilities(device_, PixelFormat::kB8G8R8A8UNormInt);
 
+  // Command buffers report the times the GPU started and ended executing them.
+  GetGPUTracer()->SetSupported(true);
+
   is_valid_ = true;
 }
 
@@ -45,6 +45,9 @@ class DeviceBufferMTL final : public DeviceBuffer,
                         Range source_range,
                         size_t offset) override;
 
+  // |DeviceBuffer|
+  void Flush(Range range) override;
+
   // |DeviceBuffer|
   bool SetLabel(const std::string& label) override;
 
@@ -23,6 +23,11 @@ id<MTLBuffer> DeviceBufferMTL::GetMTLBuffer() const {
 }
 
 uint8_t* DeviceBufferMTL::OnGetContents() const {
+#if !FML_OS_IOS
+  if (storage_mode_ == MTLStorageModeManaged) {
+    return reinterpret_cast<uint8_t*>(buffer_.contents);
+  }
+#endif
   if (storage_mode_ != MTLStorageModeShared) {
     return nullptr;
   }
@@ -78,6 +83,14 @@ std::shared_ptr<Texture> DeviceBufferMTL::AsTexture(
   return true;
 }
 
+void DeviceBufferMTL::Flush(Range range) {
+#if !FML_OS_IOS
+  if (storage_mode_ == MTLStorageModeManaged) {
+    [buffer_ didModifyRange:NSMakeRange(range.offset, range.length)];
+  }
+#endif
+}
+
 bool DeviceBufferMTL::SetLabel(const std::string& label) {
   if (label.empty()) {
     return false;
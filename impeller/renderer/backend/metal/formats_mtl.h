@@ -72,6 +72,12 @@ MTLPixelFormat SafeMTLPixelFormatBGR10_XR();
 /// Returns PixelFormat::kUnknown if MTLPixelFormatBGR10_XR isn't supported.
 MTLPixelFormat SafeMTLPixelFormatBGRA10_XR();
 
+/// Safe accessor for the pixel formats of block compressed formats.
+/// Returns MTLPixelFormatInvalid if the format isn't available on this OS
+/// version. Whether the device supports the format is a separate question,
+/// see |Capabilities::SupportsCompressedPixelFormat|.
+MTLPixelFormat SafeMTLPixelFormatForBlockCompressedFormat(PixelFormat format);
+
 constexpr MTLPixelFormat ToMTLPixelFormat(PixelFormat format) {
   switch (format) {
     case PixelFormat::kUnknown:
@@ -106,6 +112,13 @@ constexpr MTLPixelFormat ToMTLPixelFormat(PixelFormat format) {
       return SafeMTLPixelFormatBGR10_XR();
     case PixelFormat::kB10G10R10A10XR:
       return SafeMTLPixelFormatBGRA10_XR();
+    case PixelFormat::kETC2R8G8B8UNormInt:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kASTC4x4UNormInt:
+    case PixelFormat::kBC1R8G8B8A8UNormInt:
+    case PixelFormat::kBC3R8G8B8A8UNormInt:
+    case PixelFormat::kBC7R8G8B8A8UNormInt:
+      return SafeMTLPixelFormatForBlockCompressedFormat(format);
   }
   return MTLPixelFormatInvalid;
 };
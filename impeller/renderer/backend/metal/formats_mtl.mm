@@ -143,4 +143,42 @@ MTLPixelFormat SafeMTLPixelFormatBGRA10_XR() {
   }
 }
 
+MTLPixelFormat SafeMTLPixelFormatForBlockCompressedFormat(PixelFormat format) {
+  switch (format) {
+    case PixelFormat::kETC2R8G8B8UNormInt:
+      if (@available(iOS 8, macOS 11.0, *)) {
+        return MTLPixelFormatETC2_RGB8;
+      }
+      break;
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+      if (@available(iOS 8, macOS 11.0, *)) {
+        return MTLPixelFormatEAC_RGBA8;
+      }
+      break;
+    case PixelFormat::kASTC4x4UNormInt:
+      if (@available(iOS 8, macOS 11.0, *)) {
+        return MTLPixelFormatASTC_4x4_LDR;
+      }
+      break;
+    case PixelFormat::kBC1R8G8B8A8UNormInt:
+      if (@available(iOS 16.4, macOS 10.11, *)) {
+        return MTLPixelFormatBC1_RGBA;
+      }
+      break;
+    case PixelFormat::kBC3R8G8B8A8UNormInt:
+      if (@available(iOS 16.4, macOS 10.11, *)) {
+        return MTLPixelFormatBC3_RGBA;
+      }
+      break;
+    case PixelFormat::kBC7R8G8B8A8UNormInt:
+      if (@available(iOS 16.4, macOS 10.11, *)) {
+        return MTLPixelFormatBC7_RGBAUnorm;
+      }
+      break;
+    default:
+      break;
+  }
+  return MTLPixelFormatInvalid;
+}
+
 }  // namespace impeller
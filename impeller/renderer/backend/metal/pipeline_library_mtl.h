@@ -6,28 +6,67 @@
 
 #include <Metal/Metal.h>
 
+#include <atomic>
+#include <mutex>
+
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
+#include "impeller/base/backend_cast.h"
 #include "impeller/renderer/pipeline_library.h"
 
 namespace impeller {
 
 class ContextMTL;
 
-class PipelineLibraryMTL final : public PipelineLibrary {
+class PipelineLibraryMTL final
+    : public PipelineLibrary,
+      public BackendCast<PipelineLibraryMTL, PipelineLibrary> {
  public:
   PipelineLibraryMTL();
 
   // |PipelineLibrary|
   ~PipelineLibraryMTL() override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Opens the binary archive at |url|, creating an empty one if
+  ///             the file does not exist or was written by a different device
+  ///             or OS version.
+  ///
+  ///             Render pipelines created after this call are looked up in and
+  ///             added to the archive, which is periodically written back to
+  ///             |url| on a worker so that later launches don't have to
+  ///             compile them again. Binary archives need iOS 14 or macOS 11.
+  ///             On older versions this does nothing.
+  ///
+  void OpenBinaryArchive(NSURL* url);
+
+  void DidAcquireSurfaceFrame();
+
+  void PersistBinaryArchiveSync();
+
  private:
   friend ContextMTL;
 
+  // Frames between checks for pipelines to write back to the binary archive.
+  static constexpr size_t kFramesBetweenArchivePersists = 50u;
+
   id<MTLDevice> device_ = nullptr;
+  std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner_;
   PipelineMap pipelines_;
   ComputePipelineMap compute_pipelines_;
-
-  PipelineLibraryMTL(id<MTLDevice> device);
+  // An |id<MTLBinaryArchive>|, untyped as the protocol is not available on all
+  // supported OS versions.
+  id binary_archive_ = nil;
+  NSURL* binary_archive_url_ = nil;
+  std::mutex binary_archive_mutex_;
+  std::atomic_size_t unsaved_archive_pipelines_ = 0u;
+  size_t frames_acquired_ = 0u;
+
+  PipelineLibraryMTL(
+      id<MTLDevice> device,
+      std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner);
+
+  void AddToBinaryArchive(MTLRenderPipelineDescriptor* descriptor);
 
   // |PipelineLibrary|
   bool IsValid() const override;
@@ -8,7 +8,9 @@
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/container.h"
+#include "flutter/fml/logging.h"
 #include "impeller/base/promise.h"
+#include "impeller/base/validation.h"
 #include "impeller/renderer/backend/metal/compute_pipeline_mtl.h"
 #include "impeller/renderer/backend/metal/formats_mtl.h"
 #include "impeller/renderer/backend/metal/pipeline_mtl.h"
@@ -17,11 +19,100 @@
 
 namespace impeller {
 
-PipelineLibraryMTL::PipelineLibraryMTL(id<MTLDevice> device)
-    : device_(device) {}
+PipelineLibraryMTL::PipelineLibraryMTL(
+    id<MTLDevice> device,
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner)
+    : device_(device), worker_task_runner_(std::move(worker_task_runner)) {}
 
 PipelineLibraryMTL::~PipelineLibraryMTL() = default;
 
+void PipelineLibraryMTL::OpenBinaryArchive(NSURL* url) {
+  if (@available(iOS 14.0, macOS 11.0, *)) {
+    if (!IsValid() || url == nil) {
+      return;
+    }
+    auto descriptor = [[MTLBinaryArchiveDescriptor alloc] init];
+    if ([[NSFileManager defaultManager] fileExistsAtPath:url.path]) {
+      descriptor.url = url;
+    }
+    NSError* error = nil;
+    id<MTLBinaryArchive> archive =
+        [device_ newBinaryArchiveWithDescriptor:descriptor error:&error];
+    if (archive == nil && descriptor.url != nil) {
+      // The archive may be corrupt or incompatible with this device. Start
+      // over with an empty one.
+      FML_LOG(INFO) << "Could not open pipeline binary archive: "
+                    << error.localizedDescription.UTF8String
+                    << ". Starting with a fresh archive.";
+      descriptor.url = nil;
+      error = nil;
+      archive = [device_ newBinaryArchiveWithDescriptor:descriptor
+                                                  error:&error];
+    }
+    if (archive == nil) {
+      VALIDATION_LOG << "Could not create pipeline binary archive: "
+                     << error.localizedDescription.UTF8String;
+      return;
+    }
+    archive.label = @"Impeller Pipeline Archive";
+    std::scoped_lock lock(binary_archive_mutex_);
+    binary_archive_ = archive;
+    binary_archive_url_ = url;
+  }
+}
+
+void PipelineLibraryMTL::AddToBinaryArchive(
+    MTLRenderPipelineDescriptor* descriptor) {
+  if (@available(iOS 14.0, macOS 11.0, *)) {
+    std::scoped_lock lock(binary_archive_mutex_);
+    id<MTLBinaryArchive> archive = binary_archive_;
+    if (archive == nil) {
+      return;
+    }
+    // Pipelines that were found in the archive are added again. There is no
+    // way to tell them apart and this only costs one extra write per launch.
+    NSError* error = nil;
+    if (![archive addRenderPipelineFunctionsWithDescriptor:descriptor
+                                                     error:&error]) {
+      FML_LOG(ERROR) << "Could not add pipeline to binary archive: "
+                     << error.localizedDescription.UTF8String;
+      return;
+    }
+    unsaved_archive_pipelines_++;
+  }
+}
+
+void PipelineLibraryMTL::DidAcquireSurfaceFrame() {
+  if (++frames_acquired_ % kFramesBetweenArchivePersists != 0u ||
+      unsaved_archive_pipelines_ == 0u || !worker_task_runner_) {
+    return;
+  }
+  worker_task_runner_->PostTask([weak_this = weak_from_this()]() {
+    auto strong_this = weak_this.lock();
+    if (!strong_this) {
+      return;
+    }
+    PipelineLibraryMTL::Cast(*strong_this).PersistBinaryArchiveSync();
+  });
+}
+
+void PipelineLibraryMTL::PersistBinaryArchiveSync() {
+  if (@available(iOS 14.0, macOS 11.0, *)) {
+    std::scoped_lock lock(binary_archive_mutex_);
+    id<MTLBinaryArchive> archive = binary_archive_;
+    if (archive == nil || unsaved_archive_pipelines_ == 0u) {
+      return;
+    }
+    NSError* error = nil;
+    if (![archive serializeToURL:binary_archive_url_ error:&error]) {
+      VALIDATION_LOG << "Could not persist pipeline binary archive: "
+                     << error.localizedDescription.UTF8String;
+      return;
+    }
+    unsaved_archive_pipelines_ = 0u;
+  }
+}
+
 static MTLRenderPipelineDescriptor* GetMTLRenderPipelineDescriptor(
     const PipelineDescriptor& desc) {
   auto descriptor = [[MTLRenderPipelineDescriptor alloc] init];
@@ -107,6 +198,13 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryMTL::GetPipeline(
       PipelineFuture<PipelineDescriptor>{descriptor, promise->get_future()};
   pipelines_[descriptor] = pipeline_future;
   auto weak_this = weak_from_this();
+  auto mtl_descriptor = GetMTLRenderPipelineDescriptor(descriptor);
+  if (@available(iOS 14.0, macOS 11.0, *)) {
+    std::scoped_lock lock(binary_archive_mutex_);
+    if (binary_archive_ != nil) {
+      mtl_descriptor.binaryArchives = @[ binary_archive_ ];
+    }
+  }
 
   auto completion_handler =
       ^(id<MTLRenderPipelineState> _Nullable render_pipeline_state,
@@ -125,6 +223,9 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryMTL::GetPipeline(
           return;
         }
 
+        PipelineLibraryMTL::Cast(*strong_this)
+            .AddToBinaryArchive(mtl_descriptor);
+
         auto new_pipeline = std::shared_ptr<PipelineMTL>(new PipelineMTL(
             weak_this,
             descriptor,                                        //
@@ -133,19 +234,60 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryMTL::GetPipeline(
             ));
         promise->set_value(new_pipeline);
       };
-  auto mtl_descriptor = GetMTLRenderPipelineDescriptor(descriptor);
+  auto device = device_;
+  auto create_pipeline = ^{
 #if FML_OS_IOS
-  [device_ newRenderPipelineStateWithDescriptor:mtl_descriptor
-                              completionHandler:completion_handler];
+    [device newRenderPipelineStateWithDescriptor:mtl_descriptor
+                               completionHandler:completion_handler];
 #else   // FML_OS_IOS
-  // TODO(116919): Investigate and revert speculative fix to make MTL pipeline
-  //               state creation use a worker.
-  NSError* error = nil;
-  auto render_pipeline_state =
-      [device_ newRenderPipelineStateWithDescriptor:mtl_descriptor
-                                              error:&error];
-  completion_handler(render_pipeline_state, error);
+    // TODO(116919): Investigate and revert speculative fix to make MTL
+    //               pipeline state creation use a worker.
+    NSError* error = nil;
+    auto render_pipeline_state =
+        [device newRenderPipelineStateWithDescriptor:mtl_descriptor
+                                               error:&error];
+    completion_handler(render_pipeline_state, error);
 #endif  // FML_OS_IOS
+  };
+
+  const auto& constants = descriptor.GetSpecializationConstants();
+  if (constants.empty()) {
+    create_pipeline();
+    return pipeline_future;
+  }
+
+  // Specialize the vertex and then the fragment function before creating the
+  // pipeline with both.
+  auto vertex_function = descriptor.GetEntrypointForStage(ShaderStage::kVertex);
+  auto fragment_function =
+      descriptor.GetEntrypointForStage(ShaderStage::kFragment);
+  if (!vertex_function || !fragment_function) {
+    VALIDATION_LOG << "Could not find stage entrypoint functions to specialize "
+                      "in pipeline descriptor.";
+    promise->set_value(nullptr);
+    return pipeline_future;
+  }
+  ShaderFunctionMTL::Cast(*vertex_function)
+      .GetMTLFunctionSpecialized(
+          constants, [mtl_descriptor, fragment_function, constants, promise,
+                      create_pipeline](id<MTLFunction> vertex) {
+            if (vertex == nil) {
+              promise->set_value(nullptr);
+              return;
+            }
+            mtl_descriptor.vertexFunction = vertex;
+            ShaderFunctionMTL::Cast(*fragment_function)
+                .GetMTLFunctionSpecialized(
+                    constants, [mtl_descriptor, promise,
+                                create_pipeline](id<MTLFunction> fragment) {
+                      if (fragment == nil) {
+                        promise->set_value(nullptr);
+                        return;
+                      }
+                      mtl_descriptor.fragmentFunction = fragment;
+                      create_pipeline();
+                    });
+          });
   return pipeline_future;
 }
 
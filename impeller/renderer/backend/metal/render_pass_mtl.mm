@@ -4,6 +4,8 @@
 
 #include "impeller/renderer/backend/metal/render_pass_mtl.h"
 
+#include <array>
+
 #include "flutter/fml/closure.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/make_copyable.h"
@@ -215,94 +217,118 @@ struct PassBindingsCache {
     [encoder_ setDepthStencilState:depth_stencil_];
   }
 
+  void SetFrontFacingWinding(MTLWinding winding) {
+    if (winding_.has_value() && winding_.value() == winding) {
+      return;
+    }
+    winding_ = winding;
+    [encoder_ setFrontFacingWinding:winding];
+  }
+
+  void SetCullMode(MTLCullMode cull_mode) {
+    if (cull_mode_.has_value() && cull_mode_.value() == cull_mode) {
+      return;
+    }
+    cull_mode_ = cull_mode;
+    [encoder_ setCullMode:cull_mode];
+  }
+
+  void SetTriangleFillMode(MTLTriangleFillMode fill_mode) {
+    if (fill_mode_.has_value() && fill_mode_.value() == fill_mode) {
+      return;
+    }
+    fill_mode_ = fill_mode;
+    [encoder_ setTriangleFillMode:fill_mode];
+  }
+
+  void SetStencilReferenceValue(uint32_t reference) {
+    if (stencil_reference_.has_value() &&
+        stencil_reference_.value() == reference) {
+      return;
+    }
+    stencil_reference_ = reference;
+    [encoder_ setStencilReferenceValue:reference];
+  }
+
   bool SetBuffer(ShaderStage stage,
                  uint64_t index,
                  uint64_t offset,
                  id<MTLBuffer> buffer) {
-    auto& buffers_map = buffers_[stage];
-    auto found = buffers_map.find(index);
-    if (found != buffers_map.end() && found->second.buffer == buffer) {
-      // The right buffer is bound. Check if its offset needs to be updated.
-      if (found->second.offset == offset) {
-        // Buffer and its offset is identical. Nothing to do.
-        return true;
-      }
-
-      // Only the offset needs to be updated.
-      found->second.offset = offset;
+    auto* stage_bindings = GetStageBindings(stage);
+    if (!stage_bindings) {
+      VALIDATION_LOG << "Cannot bind buffer to unknown shader stage.";
+      return false;
+    }
+    if (index < kMaxCachedBindings) {
+      auto& bound = stage_bindings->buffers[index];
+      if (bound.buffer == buffer) {
+        // The right buffer is bound. Check if its offset needs to be updated.
+        if (bound.offset == offset) {
+          // Buffer and its offset is identical. Nothing to do.
+          return true;
+        }
 
-      switch (stage) {
-        case ShaderStage::kVertex:
+        // Only the offset needs to be updated.
+        bound.offset = offset;
+        if (stage == ShaderStage::kVertex) {
           [encoder_ setVertexBufferOffset:offset atIndex:index];
-          return true;
-        case ShaderStage::kFragment:
+        } else {
           [encoder_ setFragmentBufferOffset:offset atIndex:index];
-          return true;
-        default:
-          VALIDATION_LOG << "Cannot update buffer offset of an unknown stage.";
-          return false;
+        }
+        return true;
       }
-      return true;
+      bound = {buffer, static_cast<size_t>(offset)};
     }
-    buffers_map[index] = {buffer, static_cast<size_t>(offset)};
-    switch (stage) {
-      case ShaderStage::kVertex:
-        [encoder_ setVertexBuffer:buffer offset:offset atIndex:index];
-        return true;
-      case ShaderStage::kFragment:
-        [encoder_ setFragmentBuffer:buffer offset:offset atIndex:index];
-        return true;
-      default:
-        VALIDATION_LOG << "Cannot bind buffer to unknown shader stage.";
-        return false;
+    if (stage == ShaderStage::kVertex) {
+      [encoder_ setVertexBuffer:buffer offset:offset atIndex:index];
+    } else {
+      [encoder_ setFragmentBuffer:buffer offset:offset atIndex:index];
     }
-    return false;
+    return true;
   }
 
   bool SetTexture(ShaderStage stage, uint64_t index, id<MTLTexture> texture) {
-    auto& texture_map = textures_[stage];
-    auto found = texture_map.find(index);
-    if (found != texture_map.end() && found->second == texture) {
-      // Already bound.
-      return true;
+    auto* stage_bindings = GetStageBindings(stage);
+    if (!stage_bindings) {
+      VALIDATION_LOG << "Cannot bind texture to unknown shader stage.";
+      return false;
     }
-    texture_map[index] = texture;
-    switch (stage) {
-      case ShaderStage::kVertex:
-        [encoder_ setVertexTexture:texture atIndex:index];
-        return true;
-      case ShaderStage::kFragment:
-        [encoder_ setFragmentTexture:texture atIndex:index];
+    if (index < kMaxCachedBindings) {
+      if (stage_bindings->textures[index] == texture) {
+        // Already bound.
         return true;
-      default:
-        VALIDATION_LOG << "Cannot bind buffer to unknown shader stage.";
-        return false;
+      }
+      stage_bindings->textures[index] = texture;
     }
-    return false;
+    if (stage == ShaderStage::kVertex) {
+      [encoder_ setVertexTexture:texture atIndex:index];
+    } else {
+      [encoder_ setFragmentTexture:texture atIndex:index];
+    }
+    return true;
   }
 
   bool SetSampler(ShaderStage stage,
                   uint64_t index,
                   id<MTLSamplerState> sampler) {
-    auto& sampler_map = samplers_[stage];
-    auto found = sampler_map.find(index);
-    if (found != sampler_map.end() && found->second == sampler) {
-      // Already bound.
-      return true;
+    auto* stage_bindings = GetStageBindings(stage);
+    if (!stage_bindings) {
+      VALIDATION_LOG << "Cannot bind sampler to unknown shader stage.";
+      return false;
     }
-    sampler_map[index] = sampler;
-    switch (stage) {
-      case ShaderStage::kVertex:
-        [encoder_ setVertexSamplerState:sampler atIndex:index];
-        return true;
-      case ShaderStage::kFragment:
-        [encoder_ setFragmentSamplerState:sampler atIndex:index];
+    if (index < kMaxCachedBindings) {
+      if (stage_bindings->samplers[index] == sampler) {
+        // Already bound.
         return true;
-      default:
-        VALIDATION_LOG << "Cannot bind buffer to unknown shader stage.";
-        return false;
+      }
+      stage_bindings->samplers[index] = sampler;
     }
-    return false;
+    if (stage == ShaderStage::kVertex) {
+      [encoder_ setVertexSamplerState:sampler atIndex:index];
+    } else {
+      [encoder_ setFragmentSamplerState:sampler atIndex:index];
+    }
+    return true;
   }
 
   void SetViewport(const Viewport& viewport) {
@@ -336,22 +362,45 @@ struct PassBindingsCache {
   }
 
  private:
+  // Bindings at or above this index are set without being cached. This is the
+  // number of buffer and texture binding points of a stage on iOS, and covers
+  // the reserved vertex buffer index.
+  static constexpr size_t kMaxCachedBindings = 31u;
+
   struct BufferOffsetPair {
     id<MTLBuffer> buffer = nullptr;
     size_t offset = 0u;
   };
-  using BufferMap = std::map<uint64_t, BufferOffsetPair>;
-  using TextureMap = std::map<uint64_t, id<MTLTexture>>;
-  using SamplerMap = std::map<uint64_t, id<MTLSamplerState>>;
+
+  // Flat arrays keep the per-command lookups free of allocations.
+  struct StageBindings {
+    std::array<BufferOffsetPair, kMaxCachedBindings> buffers;
+    std::array<id<MTLTexture>, kMaxCachedBindings> textures;
+    std::array<id<MTLSamplerState>, kMaxCachedBindings> samplers;
+  };
 
   const id<MTLRenderCommandEncoder> encoder_;
   id<MTLRenderPipelineState> pipeline_ = nullptr;
   id<MTLDepthStencilState> depth_stencil_ = nullptr;
-  std::map<ShaderStage, BufferMap> buffers_;
-  std::map<ShaderStage, TextureMap> textures_;
-  std::map<ShaderStage, SamplerMap> samplers_;
+  StageBindings vertex_bindings_;
+  StageBindings fragment_bindings_;
   std::optional<Viewport> viewport_;
   std::optional<IRect> scissor_;
+  std::optional<MTLWinding> winding_;
+  std::optional<MTLCullMode> cull_mode_;
+  std::optional<MTLTriangleFillMode> fill_mode_;
+  std::optional<uint32_t> stencil_reference_;
+
+  StageBindings* GetStageBindings(ShaderStage stage) {
+    switch (stage) {
+      case ShaderStage::kVertex:
+        return &vertex_bindings_;
+      case ShaderStage::kFragment:
+        return &fragment_bindings_;
+      default:
+        return nullptr;
+    }
+  }
 };
 
 static bool Bind(PassBindingsCache& pass,
@@ -470,14 +519,14 @@ bool RenderPassMTL::EncodeCommands(const std::shared_ptr<Allocator>& allocator,
     pass_bindings.SetScissor(
         command.scissor.value_or(IRect::MakeSize(GetRenderTargetSize())));
 
-    [encoder setFrontFacingWinding:pipeline_desc.GetWindingOrder() ==
-                                           WindingOrder::kClockwise
-                                       ? MTLWindingClockwise
-                                       : MTLWindingCounterClockwise];
-    [encoder setCullMode:ToMTLCullMode(pipeline_desc.GetCullMode())];
-    [encoder setTriangleFillMode:ToMTLTriangleFillMode(
-                                     pipeline_desc.GetPolygonMode())];
-    [encoder setStencilReferenceValue:command.stencil_reference];
+    pass_bindings.SetFrontFacingWinding(
+        pipeline_desc.GetWindingOrder() == WindingOrder::kClockwise
+            ? MTLWindingClockwise
+            : MTLWindingCounterClockwise);
+    pass_bindings.SetCullMode(ToMTLCullMode(pipeline_desc.GetCullMode()));
+    pass_bindings.SetTriangleFillMode(
+        ToMTLTriangleFillMode(pipeline_desc.GetPolygonMode()));
+    pass_bindings.SetStencilReferenceValue(command.stencil_reference);
 
     if (!bind_stage_resources(command.vertex_bindings, ShaderStage::kVertex)) {
       return false;
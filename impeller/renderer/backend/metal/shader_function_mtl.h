@@ -6,8 +6,12 @@
 
 #include <Metal/Metal.h>
 
+#include <functional>
+#include <vector>
+
 #include "flutter/fml/macros.h"
 #include "impeller/base/backend_cast.h"
+#include "impeller/geometry/scalar.h"
 #include "impeller/renderer/shader_function.h"
 
 namespace impeller {
@@ -21,13 +25,27 @@ class ShaderFunctionMTL final
 
   id<MTLFunction> GetMTLFunction() const;
 
+  using CompileCallback = std::function<void(id<MTLFunction>)>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a variant of the function with its function constants
+  ///             set to |constants|, where the value at index `N` is used for
+  ///             `[[function_constant(N)]]`. The |callback| is invoked with
+  ///             the variant, or nil if it could not be created, possibly on
+  ///             another thread.
+  ///
+  void GetMTLFunctionSpecialized(const std::vector<Scalar>& constants,
+                                 const CompileCallback& callback) const;
+
  private:
   friend class ShaderLibraryMTL;
 
   id<MTLFunction> function_ = nullptr;
+  id<MTLLibrary> library_ = nullptr;
 
   ShaderFunctionMTL(UniqueID parent_library_id,
                     id<MTLFunction> function,
+                    id<MTLLibrary> library,
                     std::string name,
                     ShaderStage stage);
 
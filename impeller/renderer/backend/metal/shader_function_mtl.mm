@@ -4,14 +4,18 @@
 
 #include "impeller/renderer/backend/metal/shader_function_mtl.h"
 
+#include "impeller/base/validation.h"
+
 namespace impeller {
 
 ShaderFunctionMTL::ShaderFunctionMTL(UniqueID parent_library_id,
                                      id<MTLFunction> function,
+                                     id<MTLLibrary> library,
                                      std::string name,
                                      ShaderStage stage)
     : ShaderFunction(parent_library_id, std::move(name), stage),
-      function_(function) {}
+      function_(function),
+      library_(library) {}
 
 ShaderFunctionMTL::~ShaderFunctionMTL() = default;
 
@@ -19,4 +23,31 @@ id<MTLFunction> ShaderFunctionMTL::GetMTLFunction() const {
   return function_;
 }
 
+void ShaderFunctionMTL::GetMTLFunctionSpecialized(
+    const std::vector<Scalar>& constants,
+    const CompileCallback& callback) const {
+  if (constants.empty()) {
+    callback(function_);
+    return;
+  }
+  auto constant_values = [[MTLFunctionConstantValues alloc] init];
+  for (size_t i = 0; i < constants.size(); i++) {
+    Scalar value = constants[i];
+    [constant_values setConstantValue:&value type:MTLDataTypeFloat atIndex:i];
+  }
+  CompileCallback callback_copy = callback;
+  std::string name = GetName();
+  [library_ newFunctionWithName:function_.name
+                 constantValues:constant_values
+              completionHandler:^(id<MTLFunction> _Nullable function,
+                                  NSError* _Nullable error) {
+                if (function == nil) {
+                  VALIDATION_LOG << "Could not specialize function "
+                                 << name << ": "
+                                 << error.localizedDescription.UTF8String;
+                }
+                callback_copy(function);
+              }];
+}
+
 }  // namespace impeller
@@ -63,9 +63,11 @@ std::shared_ptr<const ShaderFunction> ShaderLibraryMTL::GetFunction(
       return found->second;
     }
 
+    id<MTLLibrary> library = nil;
     for (size_t i = 0, count = [libraries_ count]; i < count; i++) {
       function = [libraries_[i] newFunctionWithName:@(name.data())];
       if (function) {
+        library = libraries_[i];
         break;
       }
     }
@@ -81,7 +83,7 @@ std::shared_ptr<const ShaderFunction> ShaderLibraryMTL::GetFunction(
     }
 
     auto func = std::shared_ptr<ShaderFunctionMTL>(new ShaderFunctionMTL(
-        library_id_, function, {name.data(), name.size()}, stage));
+        library_id_, function, library, {name.data(), name.size()}, stage));
     functions_[key] = func;
 
     return func;
@@ -10,6 +10,7 @@
 #include "impeller/core/texture_descriptor.h"
 #include "impeller/renderer/backend/metal/context_mtl.h"
 #include "impeller/renderer/backend/metal/formats_mtl.h"
+#include "impeller/renderer/backend/metal/pipeline_library_mtl.h"
 #include "impeller/renderer/backend/metal/texture_mtl.h"
 #include "impeller/renderer/render_target.h"
 
@@ -129,6 +130,10 @@ std::unique_ptr<SurfaceMTL> SurfaceMTL::MakeFromTexture(
     id<MTLTexture> texture,
     std::optional<IRect> clip_rect,
     id<CAMetalDrawable> drawable) {
+  if (auto pipeline_library = context->GetPipelineLibrary()) {
+    PipelineLibraryMTL::Cast(*pipeline_library).DidAcquireSurfaceFrame();
+  }
+
   bool partial_repaint_blit_required = ShouldPerformPartialRepaint(clip_rect);
 
   // The returned render target is the texture that Impeller will render the
@@ -0,0 +1,160 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/allocation_pool_vk.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/allocation.h"
+#include "impeller/renderer/backend/vulkan/resource_manager_vk.h"
+
+namespace impeller {
+
+AllocationPoolVK::AllocationPoolVK(
+    std::weak_ptr<ResourceManagerVK> resource_manager)
+    : resource_manager_(std::move(resource_manager)) {}
+
+AllocationPoolVK::~AllocationPoolVK() {
+  Clear();
+}
+
+size_t AllocationPoolVK::GetBufferBucketSize(size_t size) {
+  if (size == 0u || size > kMaxPooledBufferSize) {
+    return 0u;
+  }
+  return Allocation::NextPowerOfTwoSize(size);
+}
+
+std::optional<AllocationPoolVK::PooledImage> AllocationPoolVK::TakeImage(
+    const TextureDescriptor& desc) {
+  Lock lock(mutex_);
+  for (auto it = images_.rbegin(); it != images_.rend(); ++it) {
+    if (it->desc == desc) {
+      PooledImage image = std::move(it->image);
+      images_.erase(std::next(it).base());
+      return image;
+    }
+  }
+  return std::nullopt;
+}
+
+void AllocationPoolVK::RecycleImage(const TextureDescriptor& desc,
+                                    PooledImage image) {
+  Lock lock(mutex_);
+  if (!is_open_ || images_.size() >= kMaxPooledImages) {
+    // Dropped once the lock is released.
+    return;
+  }
+  images_.push_back(ImageEntry{
+      .desc = desc,
+      .image = std::move(image),
+      .frame = frame_,
+  });
+}
+
+std::optional<AllocationPoolVK::PooledBuffer> AllocationPoolVK::TakeBuffer(
+    StorageMode mode,
+    size_t bucket_size) {
+  Lock lock(mutex_);
+  for (auto it = buffers_.rbegin(); it != buffers_.rend(); ++it) {
+    if (it->mode == mode && it->bucket_size == bucket_size) {
+      PooledBuffer buffer = std::move(it->buffer);
+      buffers_.erase(std::next(it).base());
+      return buffer;
+    }
+  }
+  return std::nullopt;
+}
+
+void AllocationPoolVK::RecycleBuffer(StorageMode mode,
+                                     size_t bucket_size,
+                                     PooledBuffer buffer) {
+  Lock lock(mutex_);
+  if (!is_open_ || buffers_.size() >= kMaxPooledBuffers) {
+    // Dropped once the lock is released.
+    return;
+  }
+  buffers_.push_back(BufferEntry{
+      .mode = mode,
+      .bucket_size = bucket_size,
+      .buffer = std::move(buffer),
+      .frame = frame_,
+  });
+}
+
+void AllocationPoolVK::DidAcquireSurfaceFrame() {
+  std::vector<ImageEntry> expired_images;
+  std::vector<BufferEntry> expired_buffers;
+  {
+    Lock lock(mutex_);
+    frame_++;
+    const auto is_expired = [frame = frame_](uint32_t entry_frame) {
+      return frame - entry_frame >= kMaxUnusedFrames;
+    };
+    // Entries are recycled in frame order, so the expired ones lead.
+    auto images_end = images_.begin();
+    while (images_end != images_.end() && is_expired(images_end->frame)) {
+      ++images_end;
+    }
+    std::move(images_.begin(), images_end, std::back_inserter(expired_images));
+    images_.erase(images_.begin(), images_end);
+
+    auto buffers_end = buffers_.begin();
+    while (buffers_end != buffers_.end() && is_expired(buffers_end->frame)) {
+      ++buffers_end;
+    }
+    std::move(buffers_.begin(), buffers_end,
+              std::back_inserter(expired_buffers));
+    buffers_.erase(buffers_.begin(), buffers_end);
+  }
+  Release(std::move(expired_images), std::move(expired_buffers));
+}
+
+void AllocationPoolVK::ReleaseAll() {
+  std::vector<ImageEntry> images;
+  std::vector<BufferEntry> buffers;
+  {
+    Lock lock(mutex_);
+    images.swap(images_);
+    buffers.swap(buffers_);
+  }
+  Release(std::move(images), std::move(buffers));
+}
+
+void AllocationPoolVK::Release(std::vector<ImageEntry> images,
+                               std::vector<BufferEntry> buffers) const {
+  if (images.empty() && buffers.empty()) {
+    return;
+  }
+  TRACE_EVENT0("impeller", "AllocationPoolVK::Release");
+  // Freeing allocations is not cheap. Leave that to the resource manager
+  // thread instead of the thread acquiring the frame.
+  UniqueResourceVKT<std::vector<ImageEntry>> released_images(
+      resource_manager_, std::move(images));
+  UniqueResourceVKT<std::vector<BufferEntry>> released_buffers(
+      resource_manager_, std::move(buffers));
+}
+
+void AllocationPoolVK::Clear() {
+  std::vector<ImageEntry> images;
+  std::vector<BufferEntry> buffers;
+  Lock lock(mutex_);
+  is_open_ = false;
+  images.swap(images_);
+  buffers.swap(buffers_);
+}
+
+size_t AllocationPoolVK::GetPooledImageCount() const {
+  Lock lock(mutex_);
+  return images_.size();
+}
+
+size_t AllocationPoolVK::GetPooledBufferCount() const {
+  Lock lock(mutex_);
+  return buffers_.size();
+}
+
+}  // namespace impeller
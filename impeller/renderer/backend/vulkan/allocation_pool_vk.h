@@ -0,0 +1,133 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
+#include "impeller/core/formats.h"
+#include "impeller/core/texture_descriptor.h"
+#include "impeller/renderer/backend/vulkan/vk.h"
+#include "impeller/renderer/backend/vulkan/vma.h"
+
+namespace impeller {
+
+class ResourceManagerVK;
+
+//------------------------------------------------------------------------------
+/// @brief      A thread safe pool of the images and buffers backing textures
+///             and device buffers that have been collected. New textures and
+///             buffers may be backed by these instead of new allocations.
+///
+///             Allocations are returned here by the |ResourceManagerVK| once
+///             the GPU is done with them. Images are matched by texture
+///             descriptor. Buffers are matched by storage mode and a power of
+///             two size bucket. Allocations that go unused for
+///             |kMaxUnusedFrames| frames are released.
+///
+///             The contents of pooled allocations are undefined.
+///
+class AllocationPoolVK final {
+ public:
+  /// The number of frames an allocation may sit in the pool before it is
+  /// released.
+  static constexpr uint32_t kMaxUnusedFrames = 4u;
+
+  /// The maximum number of images retained for reuse.
+  static constexpr size_t kMaxPooledImages = 32u;
+
+  /// The maximum number of buffers retained for reuse.
+  static constexpr size_t kMaxPooledBuffers = 64u;
+
+  /// Buffers larger than this are neither bucketed nor pooled.
+  static constexpr size_t kMaxPooledBufferSize = 4u * 1024u * 1024u;
+
+  struct PooledImage {
+    UniqueImageVMA image;
+    vk::UniqueImageView image_view;
+  };
+
+  struct PooledBuffer {
+    UniqueBufferVMA buffer;
+    VmaAllocationInfo info = {};
+  };
+
+  explicit AllocationPoolVK(std::weak_ptr<ResourceManagerVK> resource_manager);
+
+  ~AllocationPoolVK();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The size of the allocation backing a buffer of the given size
+  ///             so that it may be pooled.
+  ///
+  /// @return     The bucket size, or zero if buffers of this size aren't
+  ///             pooled.
+  ///
+  static size_t GetBufferBucketSize(size_t size);
+
+  std::optional<PooledImage> TakeImage(const TextureDescriptor& desc);
+
+  void RecycleImage(const TextureDescriptor& desc, PooledImage image);
+
+  std::optional<PooledBuffer> TakeBuffer(StorageMode mode, size_t bucket_size);
+
+  void RecycleBuffer(StorageMode mode, size_t bucket_size, PooledBuffer buffer);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Advance the frame count and release allocations that have
+  ///             gone unused for too long.
+  ///
+  void DidAcquireSurfaceFrame();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Release all pooled allocations, for example because device
+  ///             memory is running low. Unlike |Clear|, allocations recycled
+  ///             after this call are pooled again.
+  ///
+  void ReleaseAll();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Release all pooled allocations. Allocations recycled after
+  ///             this call are released immediately.
+  ///
+  /// @note       Must be called before the memory allocator is destroyed.
+  ///
+  void Clear();
+
+  size_t GetPooledImageCount() const;
+
+  size_t GetPooledBufferCount() const;
+
+ private:
+  struct ImageEntry {
+    TextureDescriptor desc;
+    PooledImage image;
+    uint32_t frame = 0u;
+  };
+
+  struct BufferEntry {
+    StorageMode mode = StorageMode::kHostVisible;
+    size_t bucket_size = 0u;
+    PooledBuffer buffer;
+    uint32_t frame = 0u;
+  };
+
+  void Release(std::vector<ImageEntry> images,
+               std::vector<BufferEntry> buffers) const;
+
+  std::weak_ptr<ResourceManagerVK> resource_manager_;
+  mutable Mutex mutex_;
+  bool is_open_ IPLR_GUARDED_BY(mutex_) = true;
+  uint32_t frame_ IPLR_GUARDED_BY(mutex_) = 0u;
+  std::vector<ImageEntry> images_ IPLR_GUARDED_BY(mutex_);
+  std::vector<BufferEntry> buffers_ IPLR_GUARDED_BY(mutex_);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AllocationPoolVK);
+};
+
+}  // namespace impeller
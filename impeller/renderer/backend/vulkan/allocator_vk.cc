@@ -7,6 +7,7 @@
 #include <memory>
 
 #include "flutter/fml/memory/ref_ptr.h"
+#include "flutter/fml/metrics.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/core/formats.h"
 #include "impeller/renderer/backend/vulkan/device_buffer_vk.h"
@@ -15,6 +16,11 @@
 
 namespace impeller {
 
+// The fraction of its budget the memory in use on a heap may reach before the
+// allocator is considered near its budget.
+static constexpr VkDeviceSize kNearMemoryBudgetNumerator = 9u;
+static constexpr VkDeviceSize kNearMemoryBudgetDenominator = 10u;
+
 static constexpr vk::Flags<vk::MemoryPropertyFlagBits>
 ToVKBufferMemoryPropertyFlags(StorageMode mode) {
   switch (mode) {
@@ -84,6 +90,7 @@ static PoolVMA CreateBufferPool(VmaAllocator allocator) {
 }
 
 AllocatorVK::AllocatorVK(std::weak_ptr<Context> context,
+                         std::weak_ptr<ResourceManagerVK> resource_manager,
                          uint32_t vulkan_api_version,
                          const vk::PhysicalDevice& physical_device,
                          const std::shared_ptr<DeviceHolder>& device_holder,
@@ -136,6 +143,12 @@ AllocatorVK::AllocatorVK(std::weak_ptr<Context> context,
   allocator_info.device = device_holder->GetDevice();
   allocator_info.instance = instance;
   allocator_info.pVulkanFunctions = &proc_table;
+  if (capabilities.HasOptionalDeviceExtension(
+          OptionalDeviceExtensionVK::kEXTMemoryBudget)) {
+    // Use the budgets reported by the driver, which account for the memory
+    // used by other processes, instead of a fixed fraction of the heap sizes.
+    allocator_info.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
+  }
 
   VmaAllocator allocator = {};
   auto result = vk::Result{::vmaCreateAllocator(&allocator_info, &allocator)};
@@ -146,12 +159,24 @@ AllocatorVK::AllocatorVK(std::weak_ptr<Context> context,
   staging_buffer_pool_.reset(CreateBufferPool(allocator));
   created_buffer_pool_ &= staging_buffer_pool_.is_valid();
   allocator_.reset(allocator);
+  allocation_pool_ =
+      std::make_shared<AllocationPoolVK>(std::move(resource_manager));
   supports_memoryless_textures_ =
       capabilities.SupportsDeviceTransientTextures();
   is_valid_ = true;
 }
 
-AllocatorVK::~AllocatorVK() = default;
+AllocatorVK::~AllocatorVK() {
+  if (allocation_pool_) {
+    // Pooled allocations must be freed before the VMA allocator.
+    allocation_pool_->Clear();
+  }
+}
+
+const std::shared_ptr<AllocationPoolVK>& AllocatorVK::GetAllocationPool()
+    const {
+  return allocation_pool_;
+}
 
 // |Allocator|
 bool AllocatorVK::IsValid() const {
@@ -225,9 +250,16 @@ static constexpr VmaMemoryUsage ToVMAMemoryUsage() {
   return VMA_MEMORY_USAGE_AUTO;
 }
 
+static constexpr VmaMemoryUsage ToVMATextureMemoryUsage(
+    bool is_transient_attachment) {
+  // Lazily allocated memory is never picked by |VMA_MEMORY_USAGE_AUTO|, it
+  // must be asked for explicitly.
+  return is_transient_attachment ? VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED
+                                 : ToVMAMemoryUsage();
+}
+
 static constexpr vk::Flags<vk::MemoryPropertyFlagBits>
-ToVKTextureMemoryPropertyFlags(StorageMode mode,
-                               bool supports_memoryless_textures) {
+ToVKTextureMemoryPropertyFlags(StorageMode mode, bool is_transient_attachment) {
   switch (mode) {
     case StorageMode::kHostVisible:
       return vk::MemoryPropertyFlagBits::eHostVisible |
@@ -235,7 +267,9 @@ ToVKTextureMemoryPropertyFlags(StorageMode mode,
     case StorageMode::kDevicePrivate:
       return vk::MemoryPropertyFlagBits::eDeviceLocal;
     case StorageMode::kDeviceTransient:
-      if (supports_memoryless_textures) {
+      // Lazily allocated memory may only back images with transient
+      // attachment usage.
+      if (is_transient_attachment) {
         return vk::MemoryPropertyFlagBits::eLazilyAllocated |
                vk::MemoryPropertyFlagBits::eDeviceLocal;
       }
@@ -260,6 +294,18 @@ static VmaAllocationCreateFlags ToVmaAllocationCreateFlags(StorageMode mode) {
 class AllocatedTextureSourceVK final : public TextureSourceVK {
  public:
   AllocatedTextureSourceVK(std::weak_ptr<ResourceManagerVK> resource_manager,
+                           std::weak_ptr<AllocationPoolVK> pool,
+                           const TextureDescriptor& desc,
+                           AllocationPoolVK::PooledImage image)
+      : TextureSourceVK(desc), resource_(std::move(resource_manager)) {
+    resource_.Swap(ImageResource(std::move(image.image),
+                                 std::move(image.image_view), desc,
+                                 std::move(pool)));
+    is_valid_ = true;
+  }
+
+  AllocatedTextureSourceVK(std::weak_ptr<ResourceManagerVK> resource_manager,
+                           std::weak_ptr<AllocationPoolVK> pool,
                            const TextureDescriptor& desc,
                            VmaAllocator allocator,
                            vk::Device device,
@@ -285,12 +331,19 @@ class AllocatedTextureSourceVK final : public TextureSourceVK {
                             supports_memoryless_textures);
     image_info.sharingMode = vk::SharingMode::eExclusive;
 
+    // Attachments that are never stored, such as MSAA color and stencil
+    // attachments, are given lazily allocated memory when the device has it.
+    // On tilers these never leave tile memory, so no memory is committed for
+    // them at all.
+    const bool is_transient_attachment =
+        !!(image_info.usage & vk::ImageUsageFlagBits::eTransientAttachment);
+
     VmaAllocationCreateInfo alloc_nfo = {};
 
-    alloc_nfo.usage = ToVMAMemoryUsage();
+    alloc_nfo.usage = ToVMATextureMemoryUsage(is_transient_attachment);
     alloc_nfo.preferredFlags =
         static_cast<VkMemoryPropertyFlags>(ToVKTextureMemoryPropertyFlags(
-            desc.storage_mode, supports_memoryless_textures));
+            desc.storage_mode, is_transient_attachment));
     alloc_nfo.flags = ToVmaAllocationCreateFlags(desc.storage_mode);
 
     auto create_info_native =
@@ -348,8 +401,9 @@ class AllocatedTextureSourceVK final : public TextureSourceVK {
                      << vk::to_string(result);
       return;
     }
-    resource_.Swap(ImageResource(ImageVMA{allocator, allocation, image},
-                                 std::move(image_view)));
+    resource_.Swap(ImageResource(
+        UniqueImageVMA{ImageVMA{allocator, allocation, image}},
+        std::move(image_view), desc, std::move(pool)));
     is_valid_ = true;
   }
 
@@ -367,15 +421,37 @@ class AllocatedTextureSourceVK final : public TextureSourceVK {
   struct ImageResource {
     UniqueImageVMA image;
     vk::UniqueImageView image_view;
+    TextureDescriptor desc;
+    // The pool the image is returned to when collected.
+    std::weak_ptr<AllocationPoolVK> pool;
 
     ImageResource() = default;
 
-    ImageResource(ImageVMA p_image, vk::UniqueImageView p_image_view)
-        : image(p_image), image_view(std::move(p_image_view)) {}
+    ImageResource(UniqueImageVMA p_image,
+                  vk::UniqueImageView p_image_view,
+                  const TextureDescriptor& p_desc,
+                  std::weak_ptr<AllocationPoolVK> p_pool)
+        : image(std::move(p_image)),
+          image_view(std::move(p_image_view)),
+          desc(p_desc),
+          pool(std::move(p_pool)) {}
 
     ImageResource(ImageResource&& o) {
       std::swap(image, o.image);
       std::swap(image_view, o.image_view);
+      std::swap(desc, o.desc);
+      std::swap(pool, o.pool);
+    }
+
+    ~ImageResource() {
+      if (!image.is_valid()) {
+        return;
+      }
+      if (auto strong_pool = pool.lock()) {
+        strong_pool->RecycleImage(
+            desc, AllocationPoolVK::PooledImage{std::move(image),
+                                                std::move(image_view)});
+      }
     }
 
     FML_DISALLOW_COPY_AND_ASSIGN(ImageResource);
@@ -402,28 +478,90 @@ std::shared_ptr<Texture> AllocatorVK::OnCreateTexture(
   if (!context) {
     return nullptr;
   }
+  const auto& resource_manager =
+      ContextVK::Cast(*context).GetResourceManager();
+  if (auto image = allocation_pool_->TakeImage(desc)) {
+    // The image may have been left in any layout, but the new texture source
+    // starts out undefined. That is always a valid layout to transition from
+    // and discards the old contents.
+    return std::make_shared<TextureVK>(
+        context_, std::make_shared<AllocatedTextureSourceVK>(
+                      resource_manager, allocation_pool_, desc,
+                      std::move(image.value())));
+  }
   auto source = std::make_shared<AllocatedTextureSourceVK>(
-      ContextVK::Cast(*context).GetResourceManager(),  //
-      desc,                                            //
-      allocator_.get(),                                //
-      device_holder->GetDevice(),                      //
-      supports_memoryless_textures_                    //
+      resource_manager,              //
+      allocation_pool_,              //
+      desc,                          //
+      allocator_.get(),              //
+      device_holder->GetDevice(),    //
+      supports_memoryless_textures_  //
   );
   if (!source->IsValid()) {
     return nullptr;
   }
+  FML_COUNTER_ADD("impeller.allocator_vk.texture_bytes",
+                  desc.GetByteSizeOfBaseMipLevel());
   return std::make_shared<TextureVK>(context_, std::move(source));
 }
 
+static bool IsNearHeapBudget(VmaAllocator allocator) {
+  const VkPhysicalDeviceMemoryProperties* memory_properties = nullptr;
+  ::vmaGetMemoryProperties(allocator, &memory_properties);
+  std::array<VmaBudget, VK_MAX_MEMORY_HEAPS> budgets = {};
+  ::vmaGetHeapBudgets(allocator, budgets.data());
+  for (uint32_t i = 0; i < memory_properties->memoryHeapCount; i++) {
+    const auto& budget = budgets[i];
+    if (budget.budget != 0u &&
+        budget.usage >= budget.budget / kNearMemoryBudgetDenominator *
+                            kNearMemoryBudgetNumerator) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void AllocatorVK::DidAcquireSurfaceFrame() {
   frame_count_++;
+  allocation_pool_->DidAcquireSurfaceFrame();
   raster_thread_id_ = std::this_thread::get_id();
+
+  // Advancing the frame index also refreshes the budgets reported by the
+  // driver.
+  ::vmaSetCurrentFrameIndex(allocator_.get(), frame_count_);
+  const bool is_near_memory_budget = IsNearHeapBudget(allocator_.get());
+  if (is_near_memory_budget) {
+    TRACE_EVENT0("impeller", "AllocatorVK::NearMemoryBudget");
+    allocation_pool_->ReleaseAll();
+  }
+  is_near_memory_budget_.store(is_near_memory_budget,
+                               std::memory_order_relaxed);
+}
+
+// |Allocator|
+bool AllocatorVK::IsNearMemoryBudget() const {
+  return is_near_memory_budget_.load(std::memory_order_relaxed);
 }
 
 // |Allocator|
 std::shared_ptr<DeviceBuffer> AllocatorVK::OnCreateBuffer(
     const DeviceBufferDescriptor& desc) {
   TRACE_EVENT0("impeller", "AllocatorVK::OnCreateBuffer");
+  const auto bucket_size = AllocationPoolVK::GetBufferBucketSize(desc.size);
+  if (bucket_size != 0u) {
+    if (auto pooled = allocation_pool_->TakeBuffer(desc.storage_mode,  //
+                                                   bucket_size         //
+                                                   )) {
+      return std::make_shared<DeviceBufferVK>(desc,                       //
+                                              context_,                   //
+                                              std::move(pooled->buffer),  //
+                                              pooled->info,               //
+                                              allocation_pool_,           //
+                                              bucket_size                 //
+      );
+    }
+  }
+
   vk::BufferCreateInfo buffer_info;
   buffer_info.usage = vk::BufferUsageFlagBits::eVertexBuffer |
                       vk::BufferUsageFlagBits::eIndexBuffer |
@@ -431,7 +569,9 @@ std::shared_ptr<DeviceBuffer> AllocatorVK::OnCreateBuffer(
                       vk::BufferUsageFlagBits::eStorageBuffer |
                       vk::BufferUsageFlagBits::eTransferSrc |
                       vk::BufferUsageFlagBits::eTransferDst;
-  buffer_info.size = desc.size;
+  // Pooled buffers are sized to their bucket so that they may back any buffer
+  // in it.
+  buffer_info.size = bucket_size != 0u ? bucket_size : desc.size;
   buffer_info.sharingMode = vk::SharingMode::eExclusive;
   auto buffer_info_native =
       static_cast<vk::BufferCreateInfo::NativeType>(buffer_info);
@@ -462,6 +602,7 @@ std::shared_ptr<DeviceBuffer> AllocatorVK::OnCreateBuffer(
                    << vk::to_string(result);
     return {};
   }
+  FML_COUNTER_ADD("impeller.allocator_vk.buffer_bytes", buffer_info.size);
 
   return std::make_shared<DeviceBufferVK>(
       desc,                                            //
@@ -469,7 +610,9 @@ std::shared_ptr<DeviceBuffer> AllocatorVK::OnCreateBuffer(
       UniqueBufferVMA{BufferVMA{allocator_.get(),      //
                                 buffer_allocation,     //
                                 vk::Buffer{buffer}}},  //
-      buffer_allocation_info                           //
+      buffer_allocation_info,                          //
+      allocation_pool_,                                //
+      bucket_size                                      //
   );
 }
 
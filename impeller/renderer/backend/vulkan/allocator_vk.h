@@ -7,26 +7,49 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_ptr.h"
 #include "impeller/core/allocator.h"
+#include "impeller/renderer/backend/vulkan/allocation_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/device_buffer_vk.h"
 #include "impeller/renderer/backend/vulkan/device_holder.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 
 #include <array>
+#include <atomic>
 #include <memory>
 
 namespace impeller {
 
+//------------------------------------------------------------------------------
+/// @brief      An allocator of Vulkan textures and device buffers backed by
+///             the Vulkan Memory Allocator.
+///
+///             The images and buffers backing collected textures and device
+///             buffers are kept in an |AllocationPoolVK| for a few frames and
+///             reused for new textures and buffers that match. Render targets
+///             discarded by the |RenderTargetCache| at the end of a frame are
+///             picked up here too.
+///
+///             Once the memory in use on any heap comes close to its budget,
+///             the pooled allocations are released every frame and the
+///             allocator reports |IsNearMemoryBudget| so that the render
+///             target caches stop holding on to textures too. The budgets
+///             come from `VK_EXT_memory_budget` where the device has it and
+///             are estimated from the heap sizes otherwise.
+///
 class AllocatorVK final : public Allocator {
  public:
   // |Allocator|
   ~AllocatorVK() override;
 
+  // visible for testing.
+  const std::shared_ptr<AllocationPoolVK>& GetAllocationPool() const;
+
  private:
   friend class ContextVK;
 
   UniqueAllocatorVMA allocator_;
   UniquePoolVMA staging_buffer_pool_;
+  std::shared_ptr<AllocationPoolVK> allocation_pool_;
   std::weak_ptr<Context> context_;
   std::weak_ptr<DeviceHolder> device_holder_;
   ISize max_texture_size_;
@@ -36,8 +59,10 @@ class AllocatorVK final : public Allocator {
   bool created_buffer_pool_ = true;
   uint32_t frame_count_ = 0;
   std::thread::id raster_thread_id_;
+  std::atomic<bool> is_near_memory_budget_ = false;
 
   AllocatorVK(std::weak_ptr<Context> context,
+              std::weak_ptr<ResourceManagerVK> resource_manager,
               uint32_t vulkan_api_version,
               const vk::PhysicalDevice& physical_device,
               const std::shared_ptr<DeviceHolder>& device_holder,
@@ -50,6 +75,9 @@ class AllocatorVK final : public Allocator {
   // |Allocator|
   void DidAcquireSurfaceFrame() override;
 
+  // |Allocator|
+  bool IsNearMemoryBudget() const override;
+
   // |Allocator|
   std::shared_ptr<DeviceBuffer> OnCreateBuffer(
       const DeviceBufferDescriptor& desc) override;
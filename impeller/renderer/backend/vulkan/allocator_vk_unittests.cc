@@ -0,0 +1,119 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include "flutter/testing/testing.h"
+#include "impeller/core/device_buffer.h"
+#include "impeller/renderer/backend/vulkan/allocator_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+size_t CountCalls(const std::vector<std::string>& called_functions,
+                  const std::string& name) {
+  return std::count(called_functions.begin(), called_functions.end(), name);
+}
+
+template <class Predicate>
+bool WaitFor(const Predicate& predicate) {
+  // Allocations are returned to the pool on the resource manager thread.
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (!predicate()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::yield();
+  }
+  return true;
+}
+
+const AllocationPoolVK& GetPool(const std::shared_ptr<Allocator>& allocator) {
+  return *static_cast<const AllocatorVK&>(*allocator).GetAllocationPool();
+}
+
+}  // namespace
+
+TEST(AllocatorVKTest, ReusesImagesOfCollectedTextures) {
+  auto const context = CreateMockVulkanContext();
+  auto called_functions = GetMockVulkanFunctions(context->GetDevice());
+  auto allocator = context->GetResourceAllocator();
+  const auto& pool = GetPool(allocator);
+
+  TextureDescriptor desc;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = {100, 100};
+  desc.usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget);
+
+  EXPECT_TRUE(allocator->CreateTexture(desc));
+  ASSERT_TRUE(WaitFor([&pool] { return pool.GetPooledImageCount() == 1u; }));
+  EXPECT_EQ(CountCalls(*called_functions, "vkCreateImage"), 1u);
+
+  auto reused = allocator->CreateTexture(desc);
+  ASSERT_TRUE(reused);
+  EXPECT_EQ(pool.GetPooledImageCount(), 0u);
+  EXPECT_EQ(CountCalls(*called_functions, "vkCreateImage"), 1u);
+
+  desc.size = {200, 200};
+  EXPECT_TRUE(allocator->CreateTexture(desc));
+  EXPECT_EQ(CountCalls(*called_functions, "vkCreateImage"), 2u);
+}
+
+TEST(AllocatorVKTest, ReusesBuffersInTheSameSizeBucket) {
+  auto const context = CreateMockVulkanContext();
+  auto called_functions = GetMockVulkanFunctions(context->GetDevice());
+  auto allocator = context->GetResourceAllocator();
+  const auto& pool = GetPool(allocator);
+
+  DeviceBufferDescriptor desc;
+  desc.size = 1000u;
+  desc.storage_mode = StorageMode::kDevicePrivate;
+
+  EXPECT_TRUE(allocator->CreateBuffer(desc));
+  ASSERT_TRUE(WaitFor([&pool] { return pool.GetPooledBufferCount() == 1u; }));
+
+  desc.size = 600u;
+  auto reused = allocator->CreateBuffer(desc);
+  ASSERT_TRUE(reused);
+  EXPECT_EQ(reused->GetDeviceBufferDescriptor().size, 600u);
+  EXPECT_EQ(CountCalls(*called_functions, "vkCreateBuffer"), 1u);
+  reused.reset();
+  ASSERT_TRUE(WaitFor([&pool] { return pool.GetPooledBufferCount() == 1u; }));
+
+  // Pooled buffers are released once they go unused for long enough.
+  for (auto i = 0u; i < AllocationPoolVK::kMaxUnusedFrames; i++) {
+    allocator->DidAcquireSurfaceFrame();
+  }
+  EXPECT_EQ(pool.GetPooledBufferCount(), 0u);
+  EXPECT_TRUE(allocator->CreateBuffer(desc));
+  EXPECT_EQ(CountCalls(*called_functions, "vkCreateBuffer"), 2u);
+}
+
+TEST(AllocatorVKTest, ReleaseAllKeepsPooling) {
+  auto const context = CreateMockVulkanContext();
+  auto allocator = context->GetResourceAllocator();
+  auto pool = static_cast<const AllocatorVK&>(*allocator).GetAllocationPool();
+  EXPECT_FALSE(allocator->IsNearMemoryBudget());
+
+  DeviceBufferDescriptor desc;
+  desc.size = 1000u;
+  desc.storage_mode = StorageMode::kDevicePrivate;
+
+  EXPECT_TRUE(allocator->CreateBuffer(desc));
+  ASSERT_TRUE(WaitFor([&pool] { return pool->GetPooledBufferCount() == 1u; }));
+  pool->ReleaseAll();
+  EXPECT_EQ(pool->GetPooledBufferCount(), 0u);
+
+  // Unlike a cleared pool, the pool takes recycled buffers again.
+  EXPECT_TRUE(allocator->CreateBuffer(desc));
+  ASSERT_TRUE(WaitFor([&pool] { return pool->GetPooledBufferCount() == 1u; }));
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -3,6 +3,8 @@
 // found in the LICENSE file.
 
 #include "impeller/renderer/backend/vulkan/android_hardware_buffer_texture_source_vk.h"
+#include "impeller/renderer/backend/vulkan/capabilities_vk.h"
+#include "impeller/renderer/backend/vulkan/sampler_library_vk.h"
 #include "impeller/renderer/backend/vulkan/texture_source_vk.h"
 
 #ifdef FML_OS_ANDROID
@@ -40,6 +42,41 @@ vk::ExternalFormatANDROID MakeExternalFormat(
   return external_format;
 }
 
+// Whether images of the format are YUV and must be sampled through a sampler
+// YCbCr conversion. External formats are always YUV.
+bool RequiresYUVConversion(vk::Format format) {
+  switch (format) {
+    case vk::Format::eUndefined:
+    case vk::Format::eG8B8R83Plane420Unorm:
+    case vk::Format::eG8B8R82Plane420Unorm:
+    case vk::Format::eG10X6B10X6R10X62Plane420Unorm3Pack16:
+    case vk::Format::eG16B16R162Plane420Unorm:
+      return true;
+    default:
+      return false;
+  }
+}
+
+YUVConversionDescriptorVK MakeYUVConversionDescriptor(
+    const vk::AndroidHardwareBufferFormatPropertiesANDROID& format_props) {
+  YUVConversionDescriptorVK desc;
+  desc.format = format_props.format;
+  if (format_props.format == vk::Format::eUndefined) {
+    desc.external_format = format_props.externalFormat;
+  }
+  desc.model = format_props.suggestedYcbcrModel;
+  desc.range = format_props.suggestedYcbcrRange;
+  desc.components = format_props.samplerYcbcrConversionComponents;
+  desc.x_chroma_offset = format_props.suggestedXChromaOffset;
+  desc.y_chroma_offset = format_props.suggestedYChromaOffset;
+  desc.chroma_filter =
+      (format_props.formatFeatures &
+       vk::FormatFeatureFlagBits::eSampledImageYcbcrConversionLinearFilter)
+          ? vk::Filter::eLinear
+          : vk::Filter::eNearest;
+  return desc;
+}
+
 // Returns -1 if not found.
 int FindMemoryTypeIndex(
     const vk::AndroidHardwareBufferPropertiesANDROID& props) {
@@ -59,16 +96,36 @@ int FindMemoryTypeIndex(
 
 AndroidHardwareBufferTextureSourceVK::AndroidHardwareBufferTextureSourceVK(
     TextureDescriptor desc,
-    const vk::Device& device,
+    const ContextVK& context,
     struct AHardwareBuffer* hardware_buffer,
     const AHardwareBuffer_Desc& hardware_buffer_desc)
-    : TextureSourceVK(desc), device_(device) {
+    : TextureSourceVK(desc), device_(context.GetDevice()) {
+  const vk::Device& device = device_;
   vk::AndroidHardwareBufferFormatPropertiesANDROID ahb_format_props;
   vk::AndroidHardwareBufferPropertiesANDROID ahb_props;
   if (!GetHardwareBufferProperties(device, hardware_buffer, &ahb_props,
                                    &ahb_format_props)) {
     return;
   }
+
+  // YUV buffers, such as decoded video frames, are sampled directly through
+  // a YUV conversion instead of being converted to RGB in a separate pass.
+  const bool is_yuv = RequiresYUVConversion(ahb_format_props.format);
+  if (is_yuv) {
+    if (!CapabilitiesVK::Cast(*context.GetCapabilities())
+             .SupportsYUVConversion()) {
+      FML_LOG(ERROR) << "YUV hardware buffers are not supported by the device.";
+      return;
+    }
+    yuv_conversion_ =
+        SamplerLibraryVK::Cast(*context.GetSamplerLibrary())
+            .GetYUVConversion(MakeYUVConversionDescriptor(ahb_format_props));
+    if (!yuv_conversion_) {
+      FML_LOG(ERROR) << "Could not create the YUV conversion.";
+      return;
+    }
+  }
+
   vk::ExternalFormatANDROID external_format =
       MakeExternalFormat(ahb_format_props);
   vk::ExternalMemoryImageCreateInfo external_memory_image_info;
@@ -83,11 +140,16 @@ AndroidHardwareBufferTextureSourceVK::AndroidHardwareBufferTextureSourceVK(
 
   vk::ImageCreateFlags image_create_flags;
   vk::ImageUsageFlags image_usage_flags;
-  if (hardware_buffer_desc.usage & AHARDWAREBUFFER_USAGE_GPU_SAMPLED_IMAGE) {
+  if (is_yuv) {
+    // YUV images may only be sampled.
+    image_usage_flags |= impeller::vk::ImageUsageFlagBits::eSampled;
+  } else if (hardware_buffer_desc.usage &
+             AHARDWAREBUFFER_USAGE_GPU_SAMPLED_IMAGE) {
     image_usage_flags |= impeller::vk::ImageUsageFlagBits::eSampled |
                          impeller::vk::ImageUsageFlagBits::eInputAttachment;
   }
-  if (hardware_buffer_desc.usage & AHARDWAREBUFFER_USAGE_GPU_COLOR_OUTPUT) {
+  if (!is_yuv &&
+      hardware_buffer_desc.usage & AHARDWAREBUFFER_USAGE_GPU_COLOR_OUTPUT) {
     image_usage_flags |= impeller::vk::ImageUsageFlagBits::eColorAttachment;
   }
   if (hardware_buffer_desc.usage & AHARDWAREBUFFER_USAGE_PROTECTED_CONTENT) {
@@ -161,6 +223,12 @@ AndroidHardwareBufferTextureSourceVK::AndroidHardwareBufferTextureSourceVK(
   view_info.image = image_;
   view_info.viewType = vk::ImageViewType::e2D;
   view_info.format = ToVKImageFormat(desc.format);
+  vk::SamplerYcbcrConversionInfo conversion_info;
+  if (yuv_conversion_) {
+    conversion_info.conversion = yuv_conversion_->GetConversion();
+    view_info.pNext = &conversion_info;
+    view_info.format = ahb_format_props.format;
+  }
   view_info.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
   view_info.subresourceRange.baseMipLevel = 0u;
   view_info.subresourceRange.baseArrayLayer = 0u;
@@ -198,6 +266,12 @@ vk::ImageView AndroidHardwareBufferTextureSourceVK::GetImageView() const {
   return image_view_.get();
 }
 
+// |TextureSourceVK|
+std::shared_ptr<YUVConversionVK>
+AndroidHardwareBufferTextureSourceVK::GetYUVConversion() const {
+  return yuv_conversion_;
+}
+
 }  // namespace impeller
 
 #endif
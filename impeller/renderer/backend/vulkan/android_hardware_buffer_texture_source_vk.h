@@ -11,6 +11,7 @@
 
 #include "flutter/fml/macros.h"
 #include "impeller/geometry/size.h"
+#include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/formats_vk.h"
 #include "impeller/renderer/backend/vulkan/texture_source_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
@@ -24,7 +25,7 @@ class AndroidHardwareBufferTextureSourceVK final : public TextureSourceVK {
  public:
   AndroidHardwareBufferTextureSourceVK(
       TextureDescriptor desc,
-      const vk::Device& device,
+      const ContextVK& context,
       struct AHardwareBuffer* hardware_buffer,
       const AHardwareBuffer_Desc& hardware_buffer_desc);
 
@@ -37,6 +38,9 @@ class AndroidHardwareBufferTextureSourceVK final : public TextureSourceVK {
   // |TextureSourceVK|
   vk::ImageView GetImageView() const override;
 
+  // |TextureSourceVK|
+  std::shared_ptr<YUVConversionVK> GetYUVConversion() const override;
+
   bool IsValid() const;
 
  private:
@@ -44,6 +48,7 @@ class AndroidHardwareBufferTextureSourceVK final : public TextureSourceVK {
   vk::Image image_ = VK_NULL_HANDLE;
   vk::UniqueImageView image_view_ = {};
   vk::DeviceMemory device_memory_ = VK_NULL_HANDLE;
+  std::shared_ptr<YUVConversionVK> yuv_conversion_;
 
   bool is_valid_ = false;
 
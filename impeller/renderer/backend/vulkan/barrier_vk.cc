@@ -4,4 +4,45 @@
 
 #include "impeller/renderer/backend/vulkan/barrier_vk.h"
 
-namespace impeller {}  // namespace impeller
+#include <algorithm>
+
+namespace impeller {
+
+BarrierBatchVK::BarrierBatchVK(vk::CommandBuffer cmd_buffer)
+    : cmd_buffer_(cmd_buffer) {}
+
+BarrierBatchVK::~BarrierBatchVK() = default;
+
+void BarrierBatchVK::Add(const vk::ImageMemoryBarrier& image_barrier,
+                         vk::PipelineStageFlags src_stage,
+                         vk::PipelineStageFlags dst_stage) {
+  // Transitions within a single barrier are unordered. The old layout of a
+  // second transition of the same image is only valid after the first one.
+  if (std::any_of(image_barriers_.begin(), image_barriers_.end(),
+                  [&image_barrier](const auto& pending) {
+                    return pending.image == image_barrier.image;
+                  })) {
+    Encode();
+  }
+  image_barriers_.push_back(image_barrier);
+  src_stage_ |= src_stage;
+  dst_stage_ |= dst_stage;
+}
+
+void BarrierBatchVK::Encode() {
+  if (image_barriers_.empty()) {
+    return;
+  }
+  cmd_buffer_.pipelineBarrier(src_stage_,       // src stage
+                              dst_stage_,       // dst stage
+                              {},               // dependency flags
+                              nullptr,          // memory barriers
+                              nullptr,          // buffer barriers
+                              image_barriers_   // image barriers
+  );
+  image_barriers_.clear();
+  src_stage_ = vk::PipelineStageFlagBits::eNone;
+  dst_stage_ = vk::PipelineStageFlagBits::eNone;
+}
+
+}  // namespace impeller
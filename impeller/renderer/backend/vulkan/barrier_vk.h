@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 
@@ -42,4 +44,41 @@ struct BarrierVK {
   vk::AccessFlags dst_access = vk::AccessFlagBits::eNone;
 };
 
+//------------------------------------------------------------------------------
+/// @brief      Collects the image layout transitions of a pass so that they
+///             are recorded with a single `vkCmdPipelineBarrier`.
+///
+///             The synchronization scopes of the recorded call are the union
+///             of the scopes of the collected barriers. A second transition of
+///             an image that is already pending is never merged with the
+///             first one, the pending transitions are recorded before it
+///             instead.
+///
+class BarrierBatchVK {
+ public:
+  explicit BarrierBatchVK(vk::CommandBuffer cmd_buffer);
+
+  ~BarrierBatchVK();
+
+  void Add(const vk::ImageMemoryBarrier& image_barrier,
+           vk::PipelineStageFlags src_stage,
+           vk::PipelineStageFlags dst_stage);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the pending transitions to the command buffer. Must
+  ///             be called before the images are used. Transitions that are
+  ///             never encoded are dropped, which is only acceptable when the
+  ///             command buffer is discarded.
+  ///
+  void Encode();
+
+ private:
+  const vk::CommandBuffer cmd_buffer_;
+  std::vector<vk::ImageMemoryBarrier> image_barriers_;
+  vk::PipelineStageFlags src_stage_ = vk::PipelineStageFlagBits::eNone;
+  vk::PipelineStageFlags dst_stage_ = vk::PipelineStageFlagBits::eNone;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(BarrierBatchVK);
+};
+
 }  // namespace impeller
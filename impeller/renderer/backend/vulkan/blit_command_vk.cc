@@ -55,15 +55,18 @@ bool BlitCopyTextureToTextureCommandVK::Encode(
   dst_barrier.dst_stage = vk::PipelineStageFlagBits::eFragmentShader |
                           vk::PipelineStageFlagBits::eTransfer;
 
-  if (!src.SetLayout(src_barrier) || !dst.SetLayout(dst_barrier)) {
+  BarrierBatchVK barriers(cmd_buffer);
+  if (!src.SetLayout(src_barrier, barriers) ||
+      !dst.SetLayout(dst_barrier, barriers)) {
     VALIDATION_LOG << "Could not complete layout transitions.";
     return false;
   }
+  barriers.Encode();
 
   vk::ImageCopy image_copy;
 
-  image_copy.setSrcSubresource(
-      vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, 0, 0, 1));
+  image_copy.setSrcSubresource(vk::ImageSubresourceLayers(
+      vk::ImageAspectFlagBits::eColor, source_mip_level, 0, 1));
   image_copy.setDstSubresource(
       vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, 0, 0, 1));
 
@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+
 #include "flutter/testing/testing.h"
 #include "impeller/renderer/backend/vulkan/blit_command_vk.h"
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
@@ -27,6 +29,24 @@ TEST(BlitCommandVkTest, BlitCopyTextureToTextureCommandVK) {
   EXPECT_TRUE(encoder->IsTracking(cmd.destination));
 }
 
+TEST(BlitCommandVkTest, BlitCopyTextureToTextureTransitionsInOneBarrier) {
+  auto context = CreateMockVulkanContext();
+  auto called_functions = GetMockVulkanFunctions(context->GetDevice());
+  auto encoder = std::make_unique<CommandEncoderFactoryVK>(context)->Create();
+  BlitCopyTextureToTextureCommandVK cmd;
+  cmd.source = context->GetResourceAllocator()->CreateTexture({
+      .size = ISize(100, 100),
+  });
+  cmd.destination = context->GetResourceAllocator()->CreateTexture({
+      .size = ISize(100, 100),
+  });
+  called_functions->clear();
+  EXPECT_TRUE(cmd.Encode(*encoder.get()));
+  EXPECT_EQ(std::count(called_functions->begin(), called_functions->end(),
+                       "vkCmdPipelineBarrier"),
+            1);
+}
+
 TEST(BlitCommandVkTest, BlitCopyTextureToBufferCommandVK) {
   auto context = CreateMockVulkanContext();
   auto encoder = std::make_unique<CommandEncoderFactoryVK>(context)->Create();
@@ -4,6 +4,7 @@
 
 #include "impeller/renderer/backend/vulkan/blit_pass_vk.h"
 
+#include "flutter/fml/closure.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/renderer/backend/vulkan/command_buffer_vk.h"
@@ -45,6 +46,10 @@ bool BlitPassVK::EncodeCommands(
     return false;
   }
 
+  encoder->BeginPassTimestamp(label_);
+  fml::ScopedCleanupClosure end_timestamp(
+      [&encoder]() { encoder->EndPassTimestamp(); });
+
   for (auto& command : commands_) {
     if (!command->Encode(*encoder)) {
       return false;
@@ -60,6 +65,7 @@ bool BlitPassVK::OnCopyTextureToTextureCommand(
     std::shared_ptr<Texture> destination,
     IRect source_region,
     IPoint destination_origin,
+    size_t source_mip_level,
     std::string label) {
   auto command = std::make_unique<BlitCopyTextureToTextureCommandVK>();
 
@@ -67,6 +73,7 @@ bool BlitPassVK::OnCopyTextureToTextureCommand(
   command->destination = std::move(destination);
   command->source_region = source_region;
   command->destination_origin = destination_origin;
+  command->source_mip_level = source_mip_level;
   command->label = std::move(label);
 
   commands_.push_back(std::move(command));
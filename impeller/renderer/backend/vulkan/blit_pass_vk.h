@@ -43,6 +43,7 @@ class BlitPassVK final : public BlitPass {
                                      std::shared_ptr<Texture> destination,
                                      IRect source_region,
                                      IPoint destination_origin,
+                                     size_t source_mip_level,
                                      std::string label) override;
 
   // |BlitPass|
@@ -156,6 +156,12 @@ static const char* GetDeviceExtensionName(OptionalDeviceExtensionVK ext) {
   switch (ext) {
     case OptionalDeviceExtensionVK::kEXTPipelineCreationFeedback:
       return VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME;
+    case OptionalDeviceExtensionVK::kKHRTimelineSemaphore:
+      return VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME;
+    case OptionalDeviceExtensionVK::kGOOGLEDisplayTiming:
+      return VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME;
+    case OptionalDeviceExtensionVK::kEXTMemoryBudget:
+      return VK_EXT_MEMORY_BUDGET_EXTENSION_NAME;
     case OptionalDeviceExtensionVK::kLast:
       return "Unknown";
   }
@@ -313,6 +319,13 @@ CapabilitiesVK::GetEnabledDeviceFeatures(
   // necessarily a big deal if we don't have this feature.
   required.fillModeNonSolid = device_features.fillModeNonSolid;
 
+  // Compressed textures are optional and only used if the device supports
+  // them, see |SupportsCompressedPixelFormat|.
+  required.textureCompressionETC2 = device_features.textureCompressionETC2;
+  required.textureCompressionASTC_LDR =
+      device_features.textureCompressionASTC_LDR;
+  required.textureCompressionBC = device_features.textureCompressionBC;
+
   return required;
 }
 
@@ -334,6 +347,32 @@ bool CapabilitiesVK::HasExtension(const std::string& ext) const {
   return false;
 }
 
+bool CapabilitiesVK::PhysicalDeviceSupportsTimelineSemaphores(
+    const vk::PhysicalDevice& physical_device) const {
+  auto exts = GetSupportedDeviceExtensions(physical_device);
+  if (!exts.has_value() ||
+      exts->find(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME) == exts->end()) {
+    return false;
+  }
+  using TimelineFeatures = vk::PhysicalDeviceTimelineSemaphoreFeatures;
+  auto features =
+      physical_device
+          .getFeatures2<vk::PhysicalDeviceFeatures2, TimelineFeatures>();
+  return features.get<TimelineFeatures>().timelineSemaphore;
+}
+
+bool CapabilitiesVK::PhysicalDeviceSupportsYUVConversion(
+    const vk::PhysicalDevice& physical_device) const {
+  // Sampler YCbCr conversions are core in Vulkan 1.1.
+  if (physical_device.getProperties().apiVersion < VK_API_VERSION_1_1) {
+    return false;
+  }
+  using YUVFeatures = vk::PhysicalDeviceSamplerYcbcrConversionFeatures;
+  auto features =
+      physical_device.getFeatures2<vk::PhysicalDeviceFeatures2, YUVFeatures>();
+  return features.get<YUVFeatures>().samplerYcbcrConversion;
+}
+
 void CapabilitiesVK::SetOffscreenFormat(PixelFormat pixel_format) const {
   default_color_format_ = pixel_format;
 }
@@ -386,6 +425,13 @@ bool CapabilitiesVK::SetPhysicalDevice(const vk::PhysicalDevice& device) {
     }
   }
 
+  supports_timeline_semaphores_ =
+      PhysicalDeviceSupportsTimelineSemaphores(device);
+  supports_yuv_conversion_ = PhysicalDeviceSupportsYUVConversion(device);
+
+  // These features are enabled by |GetEnabledDeviceFeatures| if supported.
+  compression_features_ = device.getFeatures();
+
   // Determine the optional device extensions this physical device supports.
   {
     optional_device_extensions_.clear();
@@ -404,6 +450,14 @@ bool CapabilitiesVK::SetPhysicalDevice(const vk::PhysicalDevice& device) {
   return true;
 }
 
+bool CapabilitiesVK::SupportsTimelineSemaphores() const {
+  return supports_timeline_semaphores_;
+}
+
+bool CapabilitiesVK::SupportsYUVConversion() const {
+  return supports_yuv_conversion_;
+}
+
 // |Capabilities|
 bool CapabilitiesVK::SupportsOffscreenMSAA() const {
   return true;
@@ -426,6 +480,10 @@ bool CapabilitiesVK::SupportsTextureToTextureBlits() const {
 
 // |Capabilities|
 bool CapabilitiesVK::SupportsFramebufferFetch() const {
+  // Reading the color attachment as an input attachment would need a self
+  // dependent subpass with a barrier before every read. Most passes are also
+  // multisampled, so it would need per-sample shading with subpassInputMS.
+  // Advanced blends blend from a copy of the pass texture instead.
   return false;
 }
 
@@ -460,6 +518,23 @@ bool CapabilitiesVK::SupportsDeviceTransientTextures() const {
   return supports_device_transient_textures_;
 }
 
+// |Capabilities|
+bool CapabilitiesVK::SupportsCompressedPixelFormat(PixelFormat format) const {
+  switch (format) {
+    case PixelFormat::kETC2R8G8B8UNormInt:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+      return compression_features_.textureCompressionETC2;
+    case PixelFormat::kASTC4x4UNormInt:
+      return compression_features_.textureCompressionASTC_LDR;
+    case PixelFormat::kBC1R8G8B8A8UNormInt:
+    case PixelFormat::kBC3R8G8B8A8UNormInt:
+    case PixelFormat::kBC7R8G8B8A8UNormInt:
+      return compression_features_.textureCompressionBC;
+    default:
+      return false;
+  }
+}
+
 // |Capabilities|
 PixelFormat CapabilitiesVK::GetDefaultColorFormat() const {
   return default_color_format_;
@@ -21,6 +21,12 @@ class ContextVK;
 enum class OptionalDeviceExtensionVK : uint32_t {
   // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VK_EXT_pipeline_creation_feedback.html
   kEXTPipelineCreationFeedback,
+  // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VK_KHR_timeline_semaphore.html
+  kKHRTimelineSemaphore,
+  // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VK_GOOGLE_display_timing.html
+  kGOOGLEDisplayTiming,
+  // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VK_EXT_memory_budget.html
+  kEXTMemoryBudget,
   kLast,
 };
 
@@ -50,9 +56,38 @@ class CapabilitiesVK final : public Capabilities,
   std::optional<vk::PhysicalDeviceFeatures> GetEnabledDeviceFeatures(
       const vk::PhysicalDevice& physical_device) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the physical device supports timeline semaphores. If
+  ///             it does, the `timelineSemaphore` feature must be enabled when
+  ///             creating the logical device.
+  ///
+  bool PhysicalDeviceSupportsTimelineSemaphores(
+      const vk::PhysicalDevice& physical_device) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the physical device can sample YUV images with a
+  ///             sampler YCbCr conversion. If it can, the
+  ///             `samplerYcbcrConversion` feature must be enabled when
+  ///             creating the logical device.
+  ///
+  bool PhysicalDeviceSupportsYUVConversion(
+      const vk::PhysicalDevice& physical_device) const;
+
   [[nodiscard]] bool SetPhysicalDevice(
       const vk::PhysicalDevice& physical_device);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether timeline semaphores may be used with the physical
+  ///             device. Set by |SetPhysicalDevice|.
+  ///
+  bool SupportsTimelineSemaphores() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether YUV images may be sampled with a |YUVConversionVK|.
+  ///             Set by |SetPhysicalDevice|.
+  ///
+  bool SupportsYUVConversion() const;
+
   const vk::PhysicalDeviceProperties& GetPhysicalDeviceProperties() const;
 
   void SetOffscreenFormat(PixelFormat pixel_format) const;
@@ -90,6 +125,9 @@ class CapabilitiesVK final : public Capabilities,
   // |Capabilities|
   bool SupportsDeviceTransientTextures() const override;
 
+  // |Capabilities|
+  bool SupportsCompressedPixelFormat(PixelFormat format) const override;
+
   // |Capabilities|
   PixelFormat GetDefaultColorFormat() const override;
 
@@ -109,6 +147,9 @@ class CapabilitiesVK final : public Capabilities,
   vk::PhysicalDeviceProperties device_properties_;
   bool supports_compute_subgroups_ = false;
   bool supports_device_transient_textures_ = false;
+  vk::PhysicalDeviceFeatures compression_features_;
+  bool supports_timeline_semaphores_ = false;
+  bool supports_yuv_conversion_ = false;
   bool is_valid_ = false;
 
   bool HasExtension(const std::string& ext) const;
@@ -8,12 +8,14 @@
 #include <utility>
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
 #include "impeller/renderer/backend/vulkan/blit_pass_vk.h"
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
 #include "impeller/renderer/backend/vulkan/compute_pass_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/formats_vk.h"
+#include "impeller/renderer/backend/vulkan/parallel_pass_encoder_vk.h"
 #include "impeller/renderer/backend/vulkan/render_pass_vk.h"
 #include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/render_target.h"
@@ -52,6 +54,14 @@ const std::shared_ptr<CommandEncoderVK>& CommandBufferVK::GetEncoder() {
 }
 
 bool CommandBufferVK::OnSubmitCommands(CompletionCallback callback) {
+  // Work submitted synchronously must not overtake render passes from this
+  // thread that are still being encoded on the workers.
+  if (auto context = context_.lock()) {
+    if (auto parallel_encoder =
+            ContextVK::Cast(*context).GetParallelPassEncoder()) {
+      parallel_encoder->Flush();
+    }
+  }
   if (!callback) {
     return encoder_->Submit();
   }
@@ -61,6 +71,68 @@ bool CommandBufferVK::OnSubmitCommands(CompletionCallback callback) {
   });
 }
 
+static ParallelPassEncoderVK::ResourceSet GetPassResources(
+    const RenderPass& render_pass) {
+  ParallelPassEncoderVK::ResourceSet resources;
+  render_pass.GetRenderTarget().IterateAllAttachments(
+      [&resources](const auto& attachment) -> bool {
+        if (attachment.texture) {
+          resources.insert(attachment.texture.get());
+        }
+        if (attachment.resolve_texture) {
+          resources.insert(attachment.resolve_texture.get());
+        }
+        return true;
+      });
+  for (const auto& command : render_pass.GetCommands()) {
+    for (const auto& [_, image] : command.vertex_bindings.sampled_images) {
+      resources.insert(image.texture.resource.get());
+    }
+    for (const auto& [_, image] : command.fragment_bindings.sampled_images) {
+      resources.insert(image.texture.resource.get());
+    }
+  }
+  return resources;
+}
+
+bool CommandBufferVK::SubmitCommandsAsync(
+    std::shared_ptr<RenderPass> render_pass) {
+  TRACE_EVENT0("impeller", "CommandBufferVK::SubmitCommandsAsync");
+  if (!IsValid() || !render_pass->IsValid()) {
+    return false;
+  }
+  auto context = context_.lock();
+  if (!context) {
+    return false;
+  }
+  auto parallel_encoder = ContextVK::Cast(*context).GetParallelPassEncoder();
+  if (!parallel_encoder) {
+    return CommandBuffer::SubmitCommandsAsync(std::move(render_pass));
+  }
+
+  // The command encoder is created lazily by the first call to `GetEncoder`,
+  // which for this command buffer happens on the worker that encodes the pass.
+  // The underlying vk::CommandBuffer is then allocated from that worker's
+  // thread local command pool, which keeps pool access externally
+  // synchronized.
+  auto resources = GetPassResources(*render_pass);
+  parallel_encoder->Enqueue(
+      std::move(resources),
+      [render_pass]() { return render_pass->EncodeCommands(); },
+      [command_buffer = shared_from_this()](bool encoded) {
+        if (!encoded) {
+          VALIDATION_LOG << "Failed to encode render pass on a worker.";
+          return;
+        }
+        const auto& encoder = command_buffer->GetEncoder();
+        if (!encoder || !encoder->Submit()) {
+          VALIDATION_LOG << "Failed to submit a render pass encoded on a "
+                            "worker.";
+        }
+      });
+  return true;
+}
+
 void CommandBufferVK::OnWaitUntilScheduled() {}
 
 std::shared_ptr<RenderPass> CommandBufferVK::OnCreateRenderPass(
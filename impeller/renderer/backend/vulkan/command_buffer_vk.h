@@ -43,6 +43,9 @@ class CommandBufferVK final
   // |CommandBuffer|
   bool OnSubmitCommands(CompletionCallback callback) override;
 
+  // |CommandBuffer|
+  bool SubmitCommandsAsync(std::shared_ptr<RenderPass> render_pass) override;
+
   // |CommandBuffer|
   void OnWaitUntilScheduled() override;
 
@@ -4,9 +4,13 @@
 
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
 
+#include <algorithm>
+#include <atomic>
+
 #include "flutter/fml/closure.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/device_buffer_vk.h"
 #include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
 #include "impeller/renderer/backend/vulkan/texture_vk.h"
 
@@ -16,12 +20,17 @@ class TrackedObjectsVK {
  public:
   explicit TrackedObjectsVK(
       const std::weak_ptr<const DeviceHolder>& device_holder,
-      const std::shared_ptr<CommandPoolVK>& pool)
-      : desc_pool_(device_holder) {
+      const std::shared_ptr<CommandPoolVK>& pool,
+      std::shared_ptr<DescriptorPoolRecyclerVK> desc_pool_recycler,
+      vk::CommandBufferLevel level = vk::CommandBufferLevel::ePrimary)
+      : desc_pool_(device_holder, std::move(desc_pool_recycler)),
+        level_(level),
+        tracking_id_(NextTrackingID()) {
     if (!pool) {
       return;
     }
-    auto buffer = pool->CreateGraphicsCommandBuffer();
+    auto buffer = IsSecondary() ? pool->CreateSecondaryCommandBuffer()
+                                : pool->CreateGraphicsCommandBuffer();
     if (!buffer) {
       return;
     }
@@ -34,44 +43,62 @@ class TrackedObjectsVK {
     if (!buffer_) {
       return;
     }
-    pool_->CollectGraphicsCommandBuffer(std::move(buffer_));
+    if (IsSecondary()) {
+      pool_->CollectSecondaryCommandBuffer(std::move(buffer_));
+    } else {
+      pool_->CollectGraphicsCommandBuffer(std::move(buffer_));
+    }
   }
 
   bool IsValid() const { return is_valid_; }
 
+  bool IsSecondary() const {
+    return level_ == vk::CommandBufferLevel::eSecondary;
+  }
+
+  void Track(std::shared_ptr<TrackedObjectsVK> secondary) {
+    if (!secondary) {
+      return;
+    }
+    tracked_secondaries_.push_back(std::move(secondary));
+  }
+
   void Track(std::shared_ptr<SharedObjectVK> object) {
-    if (!object) {
+    if (!object || !object->MarkTrackedBy(tracking_id_)) {
       return;
     }
-    tracked_objects_.insert(std::move(object));
+    tracked_objects_.push_back(std::move(object));
   }
 
   void Track(std::shared_ptr<const Buffer> buffer) {
-    if (!buffer) {
+    // Like everywhere else in this backend, all buffers are device buffers.
+    if (!buffer || !DeviceBufferVK::Cast(*buffer).MarkTrackedBy(tracking_id_)) {
       return;
     }
-    tracked_buffers_.insert(std::move(buffer));
+    tracked_buffers_.push_back(std::move(buffer));
   }
 
   bool IsTracking(const std::shared_ptr<const Buffer>& buffer) const {
     if (!buffer) {
       return false;
     }
-    return tracked_buffers_.find(buffer) != tracked_buffers_.end();
+    return std::find(tracked_buffers_.begin(), tracked_buffers_.end(),
+                     buffer) != tracked_buffers_.end();
   }
 
   void Track(std::shared_ptr<const TextureSourceVK> texture) {
-    if (!texture) {
+    if (!texture || !texture->MarkTrackedBy(tracking_id_)) {
       return;
     }
-    tracked_textures_.insert(std::move(texture));
+    tracked_textures_.push_back(std::move(texture));
   }
 
   bool IsTracking(const std::shared_ptr<const TextureSourceVK>& texture) const {
     if (!texture) {
       return false;
     }
-    return tracked_textures_.find(texture) != tracked_textures_.end();
+    return std::find(tracked_textures_.begin(), tracked_textures_.end(),
+                     texture) != tracked_textures_.end();
   }
 
   vk::CommandBuffer GetCommandBuffer() const { return *buffer_; }
@@ -80,14 +107,27 @@ class TrackedObjectsVK {
 
  private:
   DescriptorPoolVK desc_pool_;
+  const vk::CommandBufferLevel level_;
+  // Resources that have been retained by this command buffer carry this ID.
+  // They are retained once each, however many commands use them.
+  const uint64_t tracking_id_;
   // `shared_ptr` since command buffers have a link to the command pool.
   std::shared_ptr<CommandPoolVK> pool_;
   vk::UniqueCommandBuffer buffer_;
-  std::set<std::shared_ptr<SharedObjectVK>> tracked_objects_;
-  std::set<std::shared_ptr<const Buffer>> tracked_buffers_;
-  std::set<std::shared_ptr<const TextureSourceVK>> tracked_textures_;
+  std::vector<std::shared_ptr<SharedObjectVK>> tracked_objects_;
+  std::vector<std::shared_ptr<const Buffer>> tracked_buffers_;
+  std::vector<std::shared_ptr<const TextureSourceVK>> tracked_textures_;
+  // Secondary command buffers executed by this one, along with everything
+  // they reference.
+  std::vector<std::shared_ptr<TrackedObjectsVK>> tracked_secondaries_;
   bool is_valid_ = false;
 
+  static uint64_t NextTrackingID() {
+    // Zero is the ID of resources that haven't been tracked yet.
+    static std::atomic<uint64_t> next_tracking_id = 1u;
+    return next_tracking_id.fetch_add(1u, std::memory_order_relaxed);
+  }
+
   FML_DISALLOW_COPY_AND_ASSIGN(TrackedObjectsVK);
 };
 
@@ -100,6 +140,17 @@ void CommandEncoderFactoryVK::SetLabel(const std::string& label) {
 }
 
 std::shared_ptr<CommandEncoderVK> CommandEncoderFactoryVK::Create() {
+  return Create(vk::CommandBufferLevel::ePrimary, nullptr);
+}
+
+std::shared_ptr<CommandEncoderVK> CommandEncoderFactoryVK::CreateSecondary(
+    const vk::CommandBufferInheritanceInfo& inheritance_info) {
+  return Create(vk::CommandBufferLevel::eSecondary, &inheritance_info);
+}
+
+std::shared_ptr<CommandEncoderVK> CommandEncoderFactoryVK::Create(
+    vk::CommandBufferLevel level,
+    const vk::CommandBufferInheritanceInfo* inheritance_info) {
   auto context = context_.lock();
   if (!context) {
     return nullptr;
@@ -111,7 +162,8 @@ std::shared_ptr<CommandEncoderVK> CommandEncoderFactoryVK::Create() {
   }
 
   auto tracked_objects = std::make_shared<TrackedObjectsVK>(
-      context_vk.GetDeviceHolder(), tls_pool);
+      context_vk.GetDeviceHolder(), tls_pool,
+      context_vk.GetDescriptorPoolRecycler(), level);
   auto queue = context_vk.GetGraphicsQueue();
 
   if (!tracked_objects || !tracked_objects->IsValid() || !queue) {
@@ -120,6 +172,10 @@ std::shared_ptr<CommandEncoderVK> CommandEncoderFactoryVK::Create() {
 
   vk::CommandBufferBeginInfo begin_info;
   begin_info.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
+  if (inheritance_info) {
+    begin_info.flags |= vk::CommandBufferUsageFlagBits::eRenderPassContinue;
+    begin_info.pInheritanceInfo = inheritance_info;
+  }
   if (tracked_objects->GetCommandBuffer().begin(begin_info) !=
       vk::Result::eSuccess) {
     VALIDATION_LOG << "Could not begin command buffer.";
@@ -131,9 +187,21 @@ std::shared_ptr<CommandEncoderVK> CommandEncoderFactoryVK::Create() {
                             label_.value());
   }
 
-  return std::make_shared<CommandEncoderVK>(context_vk.GetDeviceHolder(),
-                                            tracked_objects, queue,
-                                            context_vk.GetFenceWaiter());
+  auto encoder = std::make_shared<CommandEncoderVK>(
+      context_vk.GetDeviceHolder(), tracked_objects, queue,
+      context_vk.GetFenceWaiter());
+
+  // Only primary command buffers are submitted, and passes recorded into
+  // secondary command buffers are measured by their primary.
+  auto gpu_tracer = context_vk.GetGPUTracerVK();
+  if (gpu_tracer && level == vk::CommandBufferLevel::ePrimary) {
+    encoder->pass_timestamps_ = gpu_tracer->CreatePassTimestamps();
+    if (encoder->pass_timestamps_) {
+      encoder->pass_timestamps_->Reset(tracked_objects->GetCommandBuffer());
+    }
+  }
+
+  return encoder;
 }
 
 CommandEncoderVK::CommandEncoderVK(
@@ -171,6 +239,11 @@ bool CommandEncoderVK::Submit(SubmitCallback callback) {
     Reset();
   });
 
+  if (tracked_objects_->IsSecondary()) {
+    VALIDATION_LOG << "Secondary command buffers cannot be submitted.";
+    return false;
+  }
+
   InsertDebugMarker("QueueSubmit");
 
   auto command_buffer = GetCommandBuffer();
@@ -180,36 +253,43 @@ bool CommandEncoderVK::Submit(SubmitCallback callback) {
     VALIDATION_LOG << "Failed to end command buffer: " << vk::to_string(status);
     return false;
   }
-  std::shared_ptr<const DeviceHolder> strong_device = device_holder_.lock();
-  if (!strong_device) {
-    VALIDATION_LOG << "Device lost.";
-    return false;
-  }
-  auto [fence_result, fence] = strong_device->GetDevice().createFenceUnique({});
-  if (fence_result != vk::Result::eSuccess) {
-    VALIDATION_LOG << "Failed to create fence: " << vk::to_string(fence_result);
-    return false;
-  }
-
   vk::SubmitInfo submit_info;
   std::vector<vk::CommandBuffer> buffers = {command_buffer};
   submit_info.setCommandBuffers(buffers);
-  status = queue_->Submit(submit_info, *fence);
-  if (status != vk::Result::eSuccess) {
-    VALIDATION_LOG << "Failed to submit queue: " << vk::to_string(status);
+
+  // The frame the command buffer belongs to, if its GPU time is measured.
+  uint64_t gpu_submission = 0u;
+  std::shared_ptr<GPUTracer> gpu_tracer;
+  if (pass_timestamps_) {
+    gpu_tracer = pass_timestamps_->GetTracer();
+    gpu_submission = gpu_tracer->WillSubmitCommandBuffer();
+  }
+
+  // The fence waiter tracks the submission with either a fence or its timeline
+  // semaphore.
+  if (!fence_waiter_->Submit(
+          *queue_, submit_info,
+          [callback, tracked_objects = std::move(tracked_objects_),
+           pass_timestamps = std::move(pass_timestamps_), gpu_tracer,
+           gpu_submission] {
+            if (gpu_submission != 0u) {
+              gpu_tracer->DidCompleteCommandBuffer(
+                  gpu_submission, pass_timestamps->GetPassTimes());
+            }
+            if (callback) {
+              callback(true);
+            }
+          })) {
+    if (gpu_submission != 0u) {
+      gpu_tracer->DidCompleteCommandBuffer(gpu_submission, {});
+    }
     return false;
   }
 
-  // Submit will proceed, call callback with true when it is done and do not
-  // call when `reset` is collected.
+  // Submit did proceed, the callback will be called with true when it is done.
+  // Do not call it when `reset` is collected.
   fail_callback = false;
-  return fence_waiter_->AddFence(
-      std::move(fence),
-      [callback, tracked_objects = std::move(tracked_objects_)] {
-        if (callback) {
-          callback(true);
-        }
-      });
+  return true;
 }
 
 vk::CommandBuffer CommandEncoderVK::GetCommandBuffer() const {
@@ -221,6 +301,7 @@ vk::CommandBuffer CommandEncoderVK::GetCommandBuffer() const {
 
 void CommandEncoderVK::Reset() {
   tracked_objects_.reset();
+  pass_timestamps_.reset();
 
   queue_ = nullptr;
   is_valid_ = false;
@@ -289,6 +370,50 @@ std::optional<vk::DescriptorSet> CommandEncoderVK::AllocateDescriptorSet(
       layout, command_count);
 }
 
+std::optional<vk::DescriptorSet> CommandEncoderVK::GetOrAllocateDescriptorSet(
+    const vk::DescriptorSetLayout& layout,
+    std::vector<vk::WriteDescriptorSet>& writes,
+    size_t command_count) {
+  if (!IsValid()) {
+    return std::nullopt;
+  }
+
+  return tracked_objects_->GetDescriptorPool().GetOrAllocateDescriptorSet(
+      layout, writes, command_count);
+}
+
+bool CommandEncoderVK::ExecuteCommands(
+    const std::vector<std::shared_ptr<CommandEncoderVK>>& secondaries) {
+  if (!IsValid()) {
+    return false;
+  }
+  std::vector<vk::CommandBuffer> buffers;
+  buffers.reserve(secondaries.size());
+  for (const auto& secondary : secondaries) {
+    if (!secondary || !secondary->IsValid() ||
+        !secondary->tracked_objects_->IsSecondary()) {
+      VALIDATION_LOG << "Only valid secondary command buffers may be executed.";
+      return false;
+    }
+    auto status = secondary->GetCommandBuffer().end();
+    if (status != vk::Result::eSuccess) {
+      VALIDATION_LOG << "Failed to end secondary command buffer: "
+                     << vk::to_string(status);
+      return false;
+    }
+    buffers.push_back(secondary->GetCommandBuffer());
+  }
+  if (buffers.empty()) {
+    return true;
+  }
+  GetCommandBuffer().executeCommands(buffers);
+  for (const auto& secondary : secondaries) {
+    tracked_objects_->Track(std::move(secondary->tracked_objects_));
+    secondary->Reset();
+  }
+  return true;
+}
+
 void CommandEncoderVK::PushDebugGroup(const char* label) const {
   if (!HasValidationLayers()) {
     return;
@@ -323,4 +448,16 @@ void CommandEncoderVK::InsertDebugMarker(const char* label) const {
   }
 }
 
+void CommandEncoderVK::BeginPassTimestamp(const std::string& label) const {
+  if (auto command_buffer = GetCommandBuffer(); pass_timestamps_) {
+    pass_timestamps_->BeginPass(command_buffer, label);
+  }
+}
+
+void CommandEncoderVK::EndPassTimestamp() const {
+  if (auto command_buffer = GetCommandBuffer(); pass_timestamps_) {
+    pass_timestamps_->EndPass(command_buffer);
+  }
+}
+
 }  // namespace impeller
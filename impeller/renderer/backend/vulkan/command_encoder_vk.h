@@ -6,7 +6,7 @@
 
 #include <functional>
 #include <optional>
-#include <set>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
@@ -33,12 +33,30 @@ class CommandEncoderFactoryVK {
 
   std::shared_ptr<CommandEncoderVK> Create();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Create an encoder for a secondary command buffer that
+  ///             continues the render pass described by the inheritance info.
+  ///
+  ///             Secondary encoders may not be submitted. They are handed to
+  ///             the |CommandEncoderVK::ExecuteCommands| of the primary
+  ///             encoder that began the render pass instead.
+  ///
+  /// @param[in]  inheritance_info  The render pass, subpass and framebuffer
+  ///                               the commands are recorded for.
+  ///
+  std::shared_ptr<CommandEncoderVK> CreateSecondary(
+      const vk::CommandBufferInheritanceInfo& inheritance_info);
+
   void SetLabel(const std::string& label);
 
  private:
   std::weak_ptr<const ContextVK> context_;
   std::optional<std::string> label_;
 
+  std::shared_ptr<CommandEncoderVK> Create(
+      vk::CommandBufferLevel level,
+      const vk::CommandBufferInheritanceInfo* inheritance_info);
+
   FML_DISALLOW_COPY_AND_ASSIGN(CommandEncoderFactoryVK);
 };
 
@@ -58,6 +76,17 @@ class CommandEncoderVK {
 
   bool Submit(SubmitCallback callback = {});
 
+  //----------------------------------------------------------------------------
+  /// @brief      End the given secondary encoders and record their execution,
+  ///             in order, into this encoder's command buffer.
+  ///
+  ///             The resources tracked by the secondary encoders are kept
+  ///             alive until this encoder's work completes. The secondary
+  ///             encoders are reset and may not be used afterwards.
+  ///
+  bool ExecuteCommands(
+      const std::vector<std::shared_ptr<CommandEncoderVK>>& secondaries);
+
   bool Track(std::shared_ptr<SharedObjectVK> object);
 
   bool Track(std::shared_ptr<const Buffer> buffer);
@@ -78,17 +107,33 @@ class CommandEncoderVK {
 
   void InsertDebugMarker(const char* label) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Write the timestamps measuring the GPU time of a pass, if the
+  ///             context measures it.
+  ///
+  void BeginPassTimestamp(const std::string& label) const;
+
+  void EndPassTimestamp() const;
+
   std::optional<vk::DescriptorSet> AllocateDescriptorSet(
       const vk::DescriptorSetLayout& layout,
       size_t command_count);
 
+  /// @see |DescriptorPoolVK::GetOrAllocateDescriptorSet|.
+  std::optional<vk::DescriptorSet> GetOrAllocateDescriptorSet(
+      const vk::DescriptorSetLayout& layout,
+      std::vector<vk::WriteDescriptorSet>& writes,
+      size_t command_count);
+
  private:
   friend class ContextVK;
+  friend class CommandEncoderFactoryVK;
 
   std::weak_ptr<const DeviceHolder> device_holder_;
   std::shared_ptr<TrackedObjectsVK> tracked_objects_;
   std::shared_ptr<QueueVK> queue_;
   const std::shared_ptr<FenceWaiterVK> fence_waiter_;
+  std::shared_ptr<PassTimestampsVK> pass_timestamps_;
   bool is_valid_ = true;
 
   void Reset();
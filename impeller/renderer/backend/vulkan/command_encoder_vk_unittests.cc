@@ -72,5 +72,82 @@ TEST(CommandEncoderVKTest, CleanupAfterSubmit) {
   EXPECT_TRUE(free_buffers < destroy_pool);
 }
 
+TEST(CommandEncoderVKTest, ExecutesSecondaryCommandBuffers) {
+  auto context = CreateMockVulkanContext();
+  CommandEncoderFactoryVK factory(context);
+  auto primary = factory.Create();
+  ASSERT_TRUE(primary);
+
+  std::vector<std::shared_ptr<CommandEncoderVK>> secondaries;
+  std::thread thread([&] {
+    // Secondary command buffers may be recorded on any thread.
+    CommandEncoderFactoryVK worker_factory(context);
+    secondaries.push_back(
+        worker_factory.CreateSecondary(vk::CommandBufferInheritanceInfo{}));
+  });
+  thread.join();
+  ASSERT_EQ(secondaries.size(), 1u);
+  ASSERT_TRUE(secondaries[0]);
+
+  // Secondaries are executed by a primary instead of being submitted.
+  EXPECT_FALSE(factory.CreateSecondary({})->Submit());
+
+  EXPECT_TRUE(primary->ExecuteCommands(secondaries));
+  EXPECT_FALSE(secondaries[0]->IsValid());
+  EXPECT_FALSE(primary->ExecuteCommands(secondaries));
+
+  auto called_functions = GetMockVulkanFunctions(context->GetDevice());
+  EXPECT_EQ(std::count(called_functions->begin(), called_functions->end(),
+                       "vkCmdExecuteCommands"),
+            1u);
+  EXPECT_TRUE(primary->Submit());
+}
+
+TEST(CommandEncoderVKTest, RetainsEachResourceOnce) {
+  auto context = CreateMockVulkanContext();
+  CommandEncoderFactoryVK factory(context);
+  auto encoder = factory.Create();
+  ASSERT_TRUE(encoder);
+  std::shared_ptr<const DeviceBuffer> buffer =
+      context->GetResourceAllocator()->CreateBuffer({.size = 1});
+  ASSERT_TRUE(buffer);
+  const auto use_count = buffer.use_count();
+
+  for (size_t i = 0u; i < 3u; i++) {
+    EXPECT_TRUE(encoder->Track(buffer));
+  }
+  EXPECT_TRUE(encoder->IsTracking(buffer));
+  EXPECT_EQ(buffer.use_count(), use_count + 1);
+
+  // Other command buffers retain the resource on their own.
+  auto other_encoder = factory.Create();
+  ASSERT_TRUE(other_encoder);
+  EXPECT_TRUE(other_encoder->Track(buffer));
+  EXPECT_TRUE(other_encoder->IsTracking(buffer));
+  EXPECT_EQ(buffer.use_count(), use_count + 2);
+}
+
+TEST(CommandEncoderVKTest, BatchedSubmissionsCompleteAfterFlush) {
+  auto context = CreateMockVulkanContext();
+  CommandEncoderFactoryVK factory(context);
+  auto fence_waiter = context->GetFenceWaiter();
+  fml::CountDownLatch latch(2u);
+
+  fence_waiter->BeginBatch();
+  for (size_t i = 0u; i < 2u; i++) {
+    auto encoder = factory.Create();
+    ASSERT_TRUE(encoder);
+    ASSERT_TRUE(encoder->Submit([&latch](bool success) {
+      EXPECT_TRUE(success);
+      latch.CountDown();
+    }));
+  }
+  EXPECT_TRUE(fence_waiter->FlushBatch());
+  latch.Wait();
+
+  // Flushing an empty batch is a no-op.
+  EXPECT_TRUE(fence_waiter->FlushBatch());
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -101,17 +101,34 @@ void CommandPoolVK::Reset() {
       buffer.release();
     }
     buffers_to_collect_.clear();
+    for (vk::UniqueCommandBuffer& buffer : secondary_buffers_to_collect_) {
+      buffer.release();
+    }
+    secondary_buffers_to_collect_.clear();
   }
 
   for (vk::UniqueCommandBuffer& buffer : recycled_buffers_) {
     buffer.release();
   }
   recycled_buffers_.clear();
+  for (vk::UniqueCommandBuffer& buffer : recycled_secondary_buffers_) {
+    buffer.release();
+  }
+  recycled_secondary_buffers_.clear();
 
   is_valid_ = false;
 }
 
 vk::UniqueCommandBuffer CommandPoolVK::CreateGraphicsCommandBuffer() {
+  return CreateCommandBuffer(vk::CommandBufferLevel::ePrimary);
+}
+
+vk::UniqueCommandBuffer CommandPoolVK::CreateSecondaryCommandBuffer() {
+  return CreateCommandBuffer(vk::CommandBufferLevel::eSecondary);
+}
+
+vk::UniqueCommandBuffer CommandPoolVK::CreateCommandBuffer(
+    vk::CommandBufferLevel level) {
   std::shared_ptr<const DeviceHolder> strong_device = device_holder_.lock();
   if (!strong_device) {
     return {};
@@ -122,16 +139,19 @@ vk::UniqueCommandBuffer CommandPoolVK::CreateGraphicsCommandBuffer() {
     GarbageCollectBuffersIfAble();
   }
 
-  if (!recycled_buffers_.empty()) {
-    vk::UniqueCommandBuffer result = std::move(recycled_buffers_.back());
-    recycled_buffers_.pop_back();
+  auto& recycled_buffers = level == vk::CommandBufferLevel::ePrimary
+                              ? recycled_buffers_
+                              : recycled_secondary_buffers_;
+  if (!recycled_buffers.empty()) {
+    vk::UniqueCommandBuffer result = std::move(recycled_buffers.back());
+    recycled_buffers.pop_back();
     return result;
   }
 
   vk::CommandBufferAllocateInfo alloc_info;
   alloc_info.commandPool = graphics_pool_.get();
   alloc_info.commandBufferCount = 1u;
-  alloc_info.level = vk::CommandBufferLevel::ePrimary;
+  alloc_info.level = level;
   auto [result, buffers] =
       strong_device->GetDevice().allocateCommandBuffersUnique(alloc_info);
   if (result != vk::Result::eSuccess) {
@@ -142,13 +162,27 @@ vk::UniqueCommandBuffer CommandPoolVK::CreateGraphicsCommandBuffer() {
 
 void CommandPoolVK::CollectGraphicsCommandBuffer(
     vk::UniqueCommandBuffer buffer) {
+  CollectCommandBuffer(std::move(buffer), vk::CommandBufferLevel::ePrimary);
+}
+
+void CommandPoolVK::CollectSecondaryCommandBuffer(
+    vk::UniqueCommandBuffer buffer) {
+  CollectCommandBuffer(std::move(buffer), vk::CommandBufferLevel::eSecondary);
+}
+
+void CommandPoolVK::CollectCommandBuffer(vk::UniqueCommandBuffer buffer,
+                                         vk::CommandBufferLevel level) {
   Lock lock(buffers_to_collect_mutex_);
   if (!graphics_pool_) {
     // If the command pool has already been destroyed, then its command buffers
     // have been freed and are now invalid.
     buffer.release();
   }
-  buffers_to_collect_.emplace_back(std::move(buffer));
+  if (level == vk::CommandBufferLevel::ePrimary) {
+    buffers_to_collect_.emplace_back(std::move(buffer));
+  } else {
+    secondary_buffers_to_collect_.emplace_back(std::move(buffer));
+  }
   GarbageCollectBuffersIfAble();
 }
 
@@ -163,6 +197,13 @@ void CommandPoolVK::GarbageCollectBuffersIfAble() {
   }
 
   buffers_to_collect_.clear();
+
+  for (auto& buffer : secondary_buffers_to_collect_) {
+    buffer->reset();
+    recycled_secondary_buffers_.emplace_back(std::move(buffer));
+  }
+
+  secondary_buffers_to_collect_.clear();
 }
 
 }  // namespace impeller
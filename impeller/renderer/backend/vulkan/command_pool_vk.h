@@ -69,6 +69,13 @@ class CommandPoolVK final {
   ///             a `{}` default instance (i.e. while being torn down).
   vk::UniqueCommandBuffer CreateGraphicsCommandBuffer();
 
+  /// @brief      Creates and returns a new secondary |vk::CommandBuffer|.
+  ///
+  /// Behaves like |CreateGraphicsCommandBuffer|, except that buffers are of
+  /// the secondary level and are recycled separately, by
+  /// |CollectSecondaryCommandBuffer|.
+  vk::UniqueCommandBuffer CreateSecondaryCommandBuffer();
+
   /// @brief      Collects the given |vk::CommandBuffer| for recycling.
   ///
   /// The given |vk::CommandBuffer| will be recycled (reused) in the future when
@@ -81,6 +88,12 @@ class CommandPoolVK final {
   /// @see        |GarbageCollectBuffersIfAble|
   void CollectGraphicsCommandBuffer(vk::UniqueCommandBuffer buffer);
 
+  /// @brief      Collects the given secondary |vk::CommandBuffer| for
+  ///             recycling.
+  ///
+  /// @see        |CollectGraphicsCommandBuffer|
+  void CollectSecondaryCommandBuffer(vk::UniqueCommandBuffer buffer);
+
  private:
   const std::thread::id owner_id_;
   std::weak_ptr<const DeviceHolder> device_holder_;
@@ -88,7 +101,10 @@ class CommandPoolVK final {
   Mutex buffers_to_collect_mutex_;
   std::vector<vk::UniqueCommandBuffer> buffers_to_collect_
       IPLR_GUARDED_BY(buffers_to_collect_mutex_);
+  std::vector<vk::UniqueCommandBuffer> secondary_buffers_to_collect_
+      IPLR_GUARDED_BY(buffers_to_collect_mutex_);
   std::vector<vk::UniqueCommandBuffer> recycled_buffers_;
+  std::vector<vk::UniqueCommandBuffer> recycled_secondary_buffers_;
   bool is_valid_ = false;
 
   /// @brief      Resets, releasing all |vk::CommandBuffer|s.
@@ -98,6 +114,11 @@ class CommandPoolVK final {
 
   explicit CommandPoolVK(const ContextVK* context);
 
+  vk::UniqueCommandBuffer CreateCommandBuffer(vk::CommandBufferLevel level);
+
+  void CollectCommandBuffer(vk::UniqueCommandBuffer buffer,
+                            vk::CommandBufferLevel level);
+
   /// @brief      Collects buffers for recycling if able.
   ///
   /// If any buffers have been returned through |CollectGraphicsCommandBuffer|,
@@ -33,9 +33,8 @@ void ComputePassVK::OnSetLabel(const std::string& label) {
 }
 
 static bool UpdateBindingLayouts(const Bindings& bindings,
-                                 const vk::CommandBuffer& buffer) {
+                                 BarrierBatchVK& barriers) {
   BarrierVK barrier;
-  barrier.cmd_buffer = buffer;
   barrier.src_access = vk::AccessFlagBits::eTransferWrite;
   barrier.src_stage = vk::PipelineStageFlagBits::eTransfer;
   barrier.dst_access = vk::AccessFlagBits::eShaderRead;
@@ -44,7 +43,7 @@ static bool UpdateBindingLayouts(const Bindings& bindings,
   barrier.new_layout = vk::ImageLayout::eShaderReadOnlyOptimal;
 
   for (const auto& [_, data] : bindings.sampled_images) {
-    if (!TextureVK::Cast(*data.texture.resource).SetLayout(barrier)) {
+    if (!TextureVK::Cast(*data.texture.resource).SetLayout(barrier, barriers)) {
       return false;
     }
   }
@@ -52,14 +51,14 @@ static bool UpdateBindingLayouts(const Bindings& bindings,
 }
 
 static bool UpdateBindingLayouts(const ComputeCommand& command,
-                                 const vk::CommandBuffer& buffer) {
-  return UpdateBindingLayouts(command.bindings, buffer);
+                                 BarrierBatchVK& barriers) {
+  return UpdateBindingLayouts(command.bindings, barriers);
 }
 
 static bool UpdateBindingLayouts(const std::vector<ComputeCommand>& commands,
-                                 const vk::CommandBuffer& buffer) {
+                                 BarrierBatchVK& barriers) {
   for (const auto& command : commands) {
-    if (!UpdateBindingLayouts(command, buffer)) {
+    if (!UpdateBindingLayouts(command, barriers)) {
       return false;
     }
   }
@@ -72,12 +71,6 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
                                           const ComputePipelineVK& pipeline,
                                           size_t command_count) {
   auto desc_set = pipeline.GetDescriptor().GetDescriptorSetLayouts();
-  auto vk_desc_set = encoder.AllocateDescriptorSet(
-      pipeline.GetDescriptorSetLayout(), command_count);
-  if (!vk_desc_set) {
-    return false;
-  }
-
   auto& allocator = *context.GetResourceAllocator();
 
   std::unordered_map<uint32_t, vk::DescriptorBufferInfo> buffers;
@@ -85,8 +78,7 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
   std::vector<vk::WriteDescriptorSet> writes;
   auto bind_images = [&encoder,     //
                       &images,      //
-                      &writes,      //
-                      &vk_desc_set  //
+                      &writes       //
   ](const Bindings& bindings) -> bool {
     for (const auto& [index, data] : bindings.sampled_images) {
       auto texture = data.texture.resource;
@@ -106,7 +98,6 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
       image_info.imageView = texture_vk.GetImageView();
 
       vk::WriteDescriptorSet write_set;
-      write_set.dstSet = vk_desc_set.value();
       write_set.dstBinding = slot.binding;
       write_set.descriptorCount = 1u;
       write_set.descriptorType = vk::DescriptorType::eCombinedImageSampler;
@@ -122,8 +113,7 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
                        &encoder,     //
                        &buffers,     //
                        &writes,      //
-                       &desc_set,    //
-                       &vk_desc_set  //
+                       &desc_set     //
   ](const Bindings& bindings) -> bool {
     for (const auto& [buffer_index, data] : bindings.buffers) {
       const auto& buffer_view = data.view.resource.buffer;
@@ -163,7 +153,6 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
       auto layout = *layout_it;
 
       vk::WriteDescriptorSet write_set;
-      write_set.dstSet = vk_desc_set.value();
       write_set.dstBinding = uniform.binding;
       write_set.descriptorCount = 1u;
       write_set.descriptorType = ToVKDescriptorType(layout.descriptor_type);
@@ -178,7 +167,13 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
     return false;
   }
 
-  context.GetDevice().updateDescriptorSets(writes, {});
+  // Commands in this encoder with identical bindings share a descriptor set
+  // which is only written once.
+  auto vk_desc_set = encoder.GetOrAllocateDescriptorSet(
+      pipeline.GetDescriptorSetLayout(), writes, command_count);
+  if (!vk_desc_set) {
+    return false;
+  }
 
   encoder.GetCommandBuffer().bindDescriptorSets(
       vk::PipelineBindPoint::eCompute,    // bind point
@@ -218,12 +213,17 @@ bool ComputePassVK::OnEncodeCommands(const Context& context,
   } else {
     pop_marker.Release();
   }
+  encoder->BeginPassTimestamp(label_);
+  fml::ScopedCleanupClosure end_timestamp(
+      [&encoder]() { encoder->EndPassTimestamp(); });
   auto cmd_buffer = encoder->GetCommandBuffer();
 
-  if (!UpdateBindingLayouts(commands_, cmd_buffer)) {
+  BarrierBatchVK barriers(cmd_buffer);
+  if (!UpdateBindingLayouts(commands_, barriers)) {
     VALIDATION_LOG << "Could not update binding layouts for compute pass.";
     return false;
   }
+  barriers.Encode();
 
   {
     TRACE_EVENT0("impeller", "EncodeComputePassCommands");
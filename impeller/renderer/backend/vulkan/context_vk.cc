@@ -26,7 +26,9 @@
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/debug_report_vk.h"
+#include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
+#include "impeller/renderer/backend/vulkan/parallel_pass_encoder_vk.h"
 #include "impeller/renderer/backend/vulkan/resource_manager_vk.h"
 #include "impeller/renderer/backend/vulkan/surface_context_vk.h"
 #include "impeller/renderer/capabilities.h"
@@ -111,10 +113,16 @@ uint64_t CalculateHash(void* ptr) {
 ContextVK::ContextVK() : hash_(CalculateHash(this)) {}
 
 ContextVK::~ContextVK() {
+  for (const auto& [_, encoder] : parallel_pass_encoders_) {
+    encoder->Flush();
+  }
   if (device_holder_ && device_holder_->device) {
     [[maybe_unused]] auto result = device_holder_->device->waitIdle();
   }
   CommandPoolVK::ClearAllPools(this);
+  if (descriptor_pool_recycler_) {
+    descriptor_pool_recycler_->Clear();
+  }
 }
 
 Context::BackendType ContextVK::GetBackendType() const {
@@ -310,6 +318,20 @@ void ContextVK::Setup(Settings settings) {
   device_info.setQueueCreateInfos(queue_create_infos);
   device_info.setPEnabledExtensionNames(enabled_device_extensions_c);
   device_info.setPEnabledFeatures(&enabled_features.value());
+
+  vk::PhysicalDeviceTimelineSemaphoreFeatures timeline_semaphore_features;
+  if (caps->PhysicalDeviceSupportsTimelineSemaphores(
+          device_holder->physical_device)) {
+    timeline_semaphore_features.timelineSemaphore = true;
+    device_info.setPNext(&timeline_semaphore_features);
+  }
+  vk::PhysicalDeviceSamplerYcbcrConversionFeatures yuv_conversion_features;
+  if (caps->PhysicalDeviceSupportsYUVConversion(
+          device_holder->physical_device)) {
+    yuv_conversion_features.samplerYcbcrConversion = true;
+    yuv_conversion_features.pNext = const_cast<void*>(device_info.pNext);
+    device_info.setPNext(&yuv_conversion_features);
+  }
   // Device layers are deprecated and ignored.
 
   {
@@ -327,11 +349,21 @@ void ContextVK::Setup(Settings settings) {
     return;
   }
 
+  //----------------------------------------------------------------------------
+  /// Create the resource manager.
+  ///
+  auto resource_manager = ResourceManagerVK::Create();
+  if (!resource_manager) {
+    VALIDATION_LOG << "Could not create resource manager.";
+    return;
+  }
+
   //----------------------------------------------------------------------------
   /// Create the allocator.
   ///
   auto allocator = std::shared_ptr<AllocatorVK>(new AllocatorVK(
       weak_from_this(),                //
+      resource_manager,                //
       application_info.apiVersion,     //
       device_holder->physical_device,  //
       device_holder,                   //
@@ -375,21 +407,19 @@ void ContextVK::Setup(Settings settings) {
   //----------------------------------------------------------------------------
   /// Create the fence waiter.
   ///
-  auto fence_waiter =
-      std::shared_ptr<FenceWaiterVK>(new FenceWaiterVK(device_holder));
+  auto fence_waiter = std::shared_ptr<FenceWaiterVK>(
+      new FenceWaiterVK(device_holder, resource_manager,
+                        caps->SupportsTimelineSemaphores()));
   if (!fence_waiter->IsValid()) {
     VALIDATION_LOG << "Could not create fence waiter.";
     return;
   }
 
   //----------------------------------------------------------------------------
-  /// Create the resource manager.
+  /// Create the descriptor pool recycler.
   ///
-  auto resource_manager = ResourceManagerVK::Create();
-  if (!resource_manager) {
-    VALIDATION_LOG << "Could not create resource manager.";
-    return;
-  }
+  auto descriptor_pool_recycler =
+      std::make_shared<DescriptorPoolRecyclerVK>(resource_manager);
 
   //----------------------------------------------------------------------------
   /// Fetch the queues.
@@ -404,6 +434,17 @@ void ContextVK::Setup(Settings settings) {
     return;
   }
 
+  //----------------------------------------------------------------------------
+  /// Measure the GPU time of passes if the graphics queue can.
+  ///
+  std::shared_ptr<GPUTracerVK> gpu_tracer_vk;
+  if (GPUTracerVK::IsSupported(device_holder->physical_device,
+                               graphics_queue->family)) {
+    gpu_tracer_vk = std::make_shared<GPUTracerVK>(
+        device_holder, GetGPUTracer(), device_holder->physical_device,
+        graphics_queue->family);
+  }
+
   VkPhysicalDeviceProperties physical_device_properties;
   dispatcher.vkGetPhysicalDeviceProperties(device_holder->physical_device,
                                            &physical_device_properties);
@@ -421,7 +462,12 @@ void ContextVK::Setup(Settings settings) {
   device_capabilities_ = std::move(caps);
   fence_waiter_ = std::move(fence_waiter);
   resource_manager_ = std::move(resource_manager);
+  descriptor_pool_recycler_ = std::move(descriptor_pool_recycler);
+  gpu_tracer_vk_ = std::move(gpu_tracer_vk);
   device_name_ = std::string(physical_device_properties.deviceName);
+  enable_parallel_pass_encoding_ = settings.enable_parallel_pass_encoding;
+  enable_secondary_command_buffers_ = settings.enable_secondary_command_buffers;
+  prefer_low_latency_present_mode_ = settings.prefer_low_latency_present_mode;
   is_valid_ = true;
 
   //----------------------------------------------------------------------------
@@ -480,7 +526,37 @@ ContextVK::GetConcurrentWorkerTaskRunner() const {
   return raster_message_loop_->GetTaskRunner();
 }
 
+std::shared_ptr<ParallelPassEncoderVK> ContextVK::GetParallelPassEncoder()
+    const {
+  if (!enable_parallel_pass_encoding_) {
+    return nullptr;
+  }
+  std::scoped_lock lock(parallel_pass_encoders_mutex_);
+  auto& encoder = parallel_pass_encoders_[std::this_thread::get_id()];
+  if (!encoder) {
+    encoder = ParallelPassEncoderVK::Create(GetConcurrentWorkerTaskRunner());
+  }
+  return encoder;
+}
+
 void ContextVK::Shutdown() {
+  {
+    // Make sure everything encoded on the workers has been submitted before
+    // the workers go away.
+    std::scoped_lock lock(parallel_pass_encoders_mutex_);
+    for (const auto& [_, encoder] : parallel_pass_encoders_) {
+      encoder->Flush();
+    }
+    parallel_pass_encoders_.clear();
+  }
+  if (fence_waiter_) {
+    fence_waiter_->FlushBatch();
+  }
+  // Record the pipelines used during this launch so that the next one can
+  // pre-warm them.
+  if (pipeline_library_) {
+    pipeline_library_->PersistPipelineCacheToDiskSync();
+  }
   raster_message_loop_->Terminate();
 }
 
@@ -508,6 +584,15 @@ std::shared_ptr<ResourceManagerVK> ContextVK::GetResourceManager() const {
   return resource_manager_;
 }
 
+std::shared_ptr<DescriptorPoolRecyclerVK> ContextVK::GetDescriptorPoolRecycler()
+    const {
+  return descriptor_pool_recycler_;
+}
+
+std::shared_ptr<GPUTracerVK> ContextVK::GetGPUTracerVK() const {
+  return gpu_tracer_vk_;
+}
+
 std::unique_ptr<CommandEncoderFactoryVK>
 ContextVK::CreateGraphicsCommandEncoderFactory() const {
   return std::make_unique<CommandEncoderFactoryVK>(weak_from_this());
@@ -5,6 +5,9 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 
 #include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
@@ -13,6 +16,7 @@
 #include "impeller/base/backend_cast.h"
 #include "impeller/core/formats.h"
 #include "impeller/renderer/backend/vulkan/device_holder.h"
+#include "impeller/renderer/backend/vulkan/gpu_tracer_vk.h"
 #include "impeller/renderer/backend/vulkan/pipeline_library_vk.h"
 #include "impeller/renderer/backend/vulkan/queue_vk.h"
 #include "impeller/renderer/backend/vulkan/sampler_library_vk.h"
@@ -27,7 +31,9 @@ bool HasValidationLayers();
 class CommandEncoderFactoryVK;
 class CommandEncoderVK;
 class DebugReportVK;
+class DescriptorPoolRecyclerVK;
 class FenceWaiterVK;
+class ParallelPassEncoderVK;
 class ResourceManagerVK;
 class SurfaceContextVK;
 
@@ -40,6 +46,15 @@ class ContextVK final : public Context,
     std::vector<std::shared_ptr<fml::Mapping>> shader_libraries_data;
     fml::UniqueFD cache_directory;
     bool enable_validation = false;
+    /// Encode render passes submitted via `SubmitCommandsAsync` on the
+    /// concurrent worker pool instead of on the submitting thread.
+    bool enable_parallel_pass_encoding = false;
+    /// Split render passes with many commands into chunks that are recorded
+    /// into secondary command buffers on the concurrent worker pool.
+    bool enable_secondary_command_buffers = false;
+    /// Present swapchain images in mailbox or FIFO relaxed mode when the
+    /// surface supports it, instead of always waiting for the next vsync.
+    bool prefer_low_latency_present_mode = false;
 
     Settings() = default;
 
@@ -140,6 +155,40 @@ class ContextVK final : public Context,
 
   std::shared_ptr<ResourceManagerVK> GetResourceManager() const;
 
+  std::shared_ptr<DescriptorPoolRecyclerVK> GetDescriptorPoolRecycler() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The timestamp queries measuring the GPU time of passes.
+  ///
+  /// @return     The tracer, or nullptr if the graphics queue doesn't support
+  ///             timestamp queries.
+  ///
+  std::shared_ptr<GPUTracerVK> GetGPUTracerVK() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the parallel pass encoder for the calling thread.
+  ///
+  /// @return     The encoder, or nullptr if parallel pass encoding is not
+  ///             enabled for this context.
+  ///
+  std::shared_ptr<ParallelPassEncoderVK> GetParallelPassEncoder() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether large render passes may be recorded into secondary
+  ///             command buffers on the concurrent worker pool.
+  ///
+  bool AreSecondaryCommandBuffersEnabled() const {
+    return enable_secondary_command_buffers_;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether swapchains should prefer a present mode that doesn't
+  ///             block on the vsync over FIFO.
+  ///
+  bool PrefersLowLatencyPresentMode() const {
+    return prefer_low_latency_present_mode_;
+  }
+
  private:
   struct DeviceHolderImpl : public DeviceHolder {
     // |DeviceHolder|
@@ -164,9 +213,18 @@ class ContextVK final : public Context,
   std::shared_ptr<const Capabilities> device_capabilities_;
   std::shared_ptr<FenceWaiterVK> fence_waiter_;
   std::shared_ptr<ResourceManagerVK> resource_manager_;
+  std::shared_ptr<DescriptorPoolRecyclerVK> descriptor_pool_recycler_;
+  std::shared_ptr<GPUTracerVK> gpu_tracer_vk_;
   std::string device_name_;
   std::shared_ptr<fml::ConcurrentMessageLoop> raster_message_loop_;
   bool sync_presentation_ = false;
+  bool enable_parallel_pass_encoding_ = false;
+  bool enable_secondary_command_buffers_ = false;
+  bool prefer_low_latency_present_mode_ = false;
+  mutable std::mutex parallel_pass_encoders_mutex_;
+  mutable std::unordered_map<std::thread::id,
+                             std::shared_ptr<ParallelPassEncoderVK>>
+      parallel_pass_encoders_;
   const uint64_t hash_;
 
   bool is_valid_ = false;
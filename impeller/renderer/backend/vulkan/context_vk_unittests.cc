@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "impeller/blobcat/blob_writer.h"
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
@@ -67,6 +68,40 @@ TEST(ContextVKTest, DeleteShaderFunctionAfterContext) {
                         "vkDestroyDevice") != functions->end());
 }
 
+TEST(ContextVKTest, CreatesShaderModulesOfLibrariesLazily) {
+  std::vector<uint8_t> data = {0x03, 0x02, 0x23, 0x07};
+  BlobWriter writer;
+  ASSERT_TRUE(writer.AddBlob(BlobShaderType::kFragment, "foobar",
+                             std::make_shared<fml::DataMapping>(data)));
+  ASSERT_TRUE(writer.AddBlob(BlobShaderType::kVertex, "foobar",
+                             std::make_shared<fml::DataMapping>(data)));
+  auto library_data = writer.CreateMapping();
+  ASSERT_TRUE(library_data);
+
+  auto context = CreateMockVulkanContext([&](ContextVK::Settings& settings) {
+    settings.shader_libraries_data = {library_data};
+  });
+  ASSERT_TRUE(context);
+  auto functions = GetMockVulkanFunctions(context->GetDevice());
+  auto module_count = [&functions]() {
+    return std::count(functions->begin(), functions->end(),
+                      "vkCreateShaderModule");
+  };
+  EXPECT_EQ(module_count(), 0);
+
+  auto shader_function = context->GetShaderLibrary()->GetFunction(
+      "foobar_fragment_main", ShaderStage::kFragment);
+  ASSERT_TRUE(shader_function);
+  EXPECT_EQ(module_count(), 1);
+
+  EXPECT_EQ(context->GetShaderLibrary()->GetFunction("foobar_fragment_main",
+                                                     ShaderStage::kFragment),
+            shader_function);
+  EXPECT_EQ(module_count(), 1);
+  EXPECT_FALSE(context->GetShaderLibrary()->GetFunction(
+      "missing_fragment_main", ShaderStage::kFragment));
+}
+
 TEST(ContextVKTest, DeletePipelineLibraryAfterContext) {
   std::shared_ptr<PipelineLibrary> pipeline_library;
   std::shared_ptr<std::vector<std::string>> functions;
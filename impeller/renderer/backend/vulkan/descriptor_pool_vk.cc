@@ -4,19 +4,168 @@
 
 #include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
 
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/allocation.h"
 #include "impeller/base/validation.h"
+#include "impeller/renderer/backend/vulkan/resource_manager_vk.h"
 
 namespace impeller {
 
+DescriptorSetKeyVK DescriptorSetKeyVK::Make(
+    const vk::DescriptorSetLayout& layout,
+    const std::vector<vk::WriteDescriptorSet>& writes) {
+  DescriptorSetKeyVK key;
+  key.layout = layout;
+  key.bindings.reserve(writes.size());
+  for (const auto& write : writes) {
+    FML_DCHECK(write.descriptorCount == 1u);
+    Binding binding;
+    binding.binding = write.dstBinding;
+    binding.type = write.descriptorType;
+    if (write.pImageInfo) {
+      binding.image_view = write.pImageInfo->imageView;
+      binding.sampler = write.pImageInfo->sampler;
+    }
+    if (write.pBufferInfo) {
+      binding.buffer = write.pBufferInfo->buffer;
+      binding.offset = write.pBufferInfo->offset;
+      binding.range = write.pBufferInfo->range;
+    }
+    key.bindings.push_back(binding);
+  }
+  return key;
+}
+
+std::size_t DescriptorSetKeyVK::Hash::operator()(
+    const DescriptorSetKeyVK& key) const {
+  auto seed = fml::HashCombine(static_cast<VkDescriptorSetLayout>(key.layout));
+  for (const auto& binding : key.bindings) {
+    fml::HashCombineSeed(seed,                                          //
+                         binding.binding,                               //
+                         static_cast<VkDescriptorType>(binding.type),   //
+                         static_cast<VkImageView>(binding.image_view),  //
+                         static_cast<VkSampler>(binding.sampler),       //
+                         static_cast<VkBuffer>(binding.buffer),         //
+                         binding.offset,                                //
+                         binding.range                                  //
+    );
+  }
+  return seed;
+}
+
+namespace {
+
+/// Pools that are waiting on the resource manager thread to be reset. This
+/// only happens once the command buffer using them has completed.
+class BackgroundDescriptorPoolVK final {
+ public:
+  BackgroundDescriptorPoolVK(
+      std::vector<DescriptorPoolRecyclerVK::SizedPool> pools,
+      std::weak_ptr<DescriptorPoolRecyclerVK> recycler)
+      : pools_(std::move(pools)), recycler_(std::move(recycler)) {}
+
+  BackgroundDescriptorPoolVK(BackgroundDescriptorPoolVK&& other) = default;
+
+  ~BackgroundDescriptorPoolVK() {
+    if (pools_.empty()) {
+      return;
+    }
+    auto recycler = recycler_.lock();
+    if (!recycler) {
+      return;
+    }
+    for (auto& pool : pools_) {
+      pool.pool.getOwner().resetDescriptorPool(pool.pool.get());
+    }
+    recycler->Recycle(std::move(pools_));
+  }
+
+ private:
+  std::vector<DescriptorPoolRecyclerVK::SizedPool> pools_;
+  std::weak_ptr<DescriptorPoolRecyclerVK> recycler_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(BackgroundDescriptorPoolVK);
+};
+
+}  // namespace
+
+DescriptorPoolRecyclerVK::DescriptorPoolRecyclerVK(
+    std::weak_ptr<ResourceManagerVK> resource_manager)
+    : resource_manager_(std::move(resource_manager)) {}
+
+DescriptorPoolRecyclerVK::~DescriptorPoolRecyclerVK() = default;
+
+std::optional<DescriptorPoolRecyclerVK::SizedPool>
+DescriptorPoolRecyclerVK::Take(uint32_t min_size) {
+  Lock lock(recycled_mutex_);
+  auto best = recycled_.end();
+  for (auto it = recycled_.begin(); it != recycled_.end(); ++it) {
+    if (it->size >= min_size &&
+        (best == recycled_.end() || it->size < best->size)) {
+      best = it;
+    }
+  }
+  if (best == recycled_.end()) {
+    return std::nullopt;
+  }
+  SizedPool pool = std::move(*best);
+  if (best != recycled_.end() - 1) {
+    *best = std::move(recycled_.back());
+  }
+  recycled_.pop_back();
+  return pool;
+}
+
+void DescriptorPoolRecyclerVK::Reclaim(std::vector<SizedPool> pools) {
+  if (pools.empty()) {
+    return;
+  }
+  UniqueResourceVKT<BackgroundDescriptorPoolVK> resource(
+      resource_manager_,
+      BackgroundDescriptorPoolVK(std::move(pools), weak_from_this()));
+}
+
+void DescriptorPoolRecyclerVK::Recycle(std::vector<SizedPool> pools) {
+  Lock lock(recycled_mutex_);
+  for (auto& pool : pools) {
+    if (recycled_.size() >= kMaxRecycledPools) {
+      break;
+    }
+    recycled_.push_back(std::move(pool));
+  }
+}
+
+void DescriptorPoolRecyclerVK::Clear() {
+  Lock lock(recycled_mutex_);
+  recycled_.clear();
+}
+
+size_t DescriptorPoolRecyclerVK::GetRecycledPoolCount() const {
+  Lock lock(recycled_mutex_);
+  return recycled_.size();
+}
+
 DescriptorPoolVK::DescriptorPoolVK(
-    const std::weak_ptr<const DeviceHolder>& device_holder)
-    : device_holder_(device_holder) {
+    const std::weak_ptr<const DeviceHolder>& device_holder,
+    std::shared_ptr<DescriptorPoolRecyclerVK> recycler)
+    : device_holder_(device_holder), recycler_(std::move(recycler)) {
   FML_DCHECK(device_holder.lock());
 }
 
-DescriptorPoolVK::~DescriptorPoolVK() = default;
+DescriptorPoolVK::~DescriptorPoolVK() {
+  if (!recycler_) {
+    return;
+  }
+  std::vector<DescriptorPoolRecyclerVK::SizedPool> pools;
+  pools.reserve(pools_.size());
+  while (!pools_.empty()) {
+    pools.push_back(std::move(pools_.front()));
+    pools_.pop();
+  }
+  recycler_->Reclaim(std::move(pools));
+}
 
 static vk::UniqueDescriptorPool CreatePool(const vk::Device& device,
                                            uint32_t pool_count) {
@@ -46,6 +195,36 @@ std::optional<vk::DescriptorSet> DescriptorPoolVK::AllocateDescriptorSet(
   return AllocateDescriptorSet(layout);
 }
 
+std::optional<vk::DescriptorSet> DescriptorPoolVK::GetOrAllocateDescriptorSet(
+    const vk::DescriptorSetLayout& layout,
+    std::vector<vk::WriteDescriptorSet>& writes,
+    size_t command_count) {
+  auto key = DescriptorSetKeyVK::Make(layout, writes);
+  auto found = cached_sets_.find(key);
+  if (found != cached_sets_.end()) {
+    return found->second;
+  }
+
+  auto set = AllocateDescriptorSet(layout, command_count);
+  if (!set) {
+    return std::nullopt;
+  }
+  std::shared_ptr<const DeviceHolder> strong_device = device_holder_.lock();
+  if (!strong_device) {
+    return std::nullopt;
+  }
+  for (auto& write : writes) {
+    write.dstSet = set.value();
+  }
+  strong_device->GetDevice().updateDescriptorSets(writes, {});
+  cached_sets_[std::move(key)] = set.value();
+  return set;
+}
+
+size_t DescriptorPoolVK::GetCachedDescriptorSetCount() const {
+  return cached_sets_.size();
+}
+
 std::optional<vk::DescriptorSet> DescriptorPoolVK::AllocateDescriptorSet(
     const vk::DescriptorSetLayout& layout) {
   auto pool = GetDescriptorPool();
@@ -76,11 +255,18 @@ std::optional<vk::DescriptorPool> DescriptorPoolVK::GetDescriptorPool() {
   if (pools_.empty()) {
     return GrowPool() ? GetDescriptorPool() : std::nullopt;
   }
-  return *pools_.back();
+  return *pools_.back().pool;
 }
 
 bool DescriptorPoolVK::GrowPool() {
   const auto new_pool_size = Allocation::NextPowerOfTwoSize(pool_size_ + 1u);
+  if (recycler_) {
+    if (auto recycled = recycler_->Take(new_pool_size)) {
+      pool_size_ = recycled->size;
+      pools_.push(std::move(recycled.value()));
+      return true;
+    }
+  }
   std::shared_ptr<const DeviceHolder> strong_device = device_holder_.lock();
   if (!strong_device) {
     return false;
@@ -90,7 +276,7 @@ bool DescriptorPoolVK::GrowPool() {
     return false;
   }
   pool_size_ = new_pool_size;
-  pools_.push(std::move(new_pool));
+  pools_.push({std::move(new_pool), new_pool_size});
   return true;
 }
 
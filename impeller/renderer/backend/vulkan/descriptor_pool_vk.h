@@ -4,15 +4,128 @@
 
 #pragma once
 
+#include <memory>
 #include <optional>
 #include <queue>
+#include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
 #include "impeller/renderer/backend/vulkan/device_holder.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 
 namespace impeller {
 
+class ResourceManagerVK;
+
+//------------------------------------------------------------------------------
+/// @brief      Identifies the contents of a descriptor set. Two sets with the
+///             same layout and the same resources bound at the same bindings
+///             are interchangeable.
+///
+struct DescriptorSetKeyVK {
+  struct Binding {
+    uint32_t binding = 0u;
+    vk::DescriptorType type = vk::DescriptorType::eUniformBuffer;
+    vk::ImageView image_view = {};
+    vk::Sampler sampler = {};
+    vk::Buffer buffer = {};
+    vk::DeviceSize offset = 0u;
+    vk::DeviceSize range = 0u;
+
+    bool operator==(const Binding& other) const {
+      return binding == other.binding && type == other.type &&
+             image_view == other.image_view && sampler == other.sampler &&
+             buffer == other.buffer && offset == other.offset &&
+             range == other.range;
+    }
+  };
+
+  vk::DescriptorSetLayout layout = {};
+  std::vector<Binding> bindings;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Create a key from the writes that would populate a set with
+  ///             the given layout. Only single descriptor writes of images and
+  ///             buffers are supported.
+  ///
+  static DescriptorSetKeyVK Make(
+      const vk::DescriptorSetLayout& layout,
+      const std::vector<vk::WriteDescriptorSet>& writes);
+
+  bool operator==(const DescriptorSetKeyVK& other) const {
+    return layout == other.layout && bindings == other.bindings;
+  }
+
+  struct Hash {
+    std::size_t operator()(const DescriptorSetKeyVK& key) const;
+  };
+};
+
+//------------------------------------------------------------------------------
+/// @brief      A thread safe collection of reset descriptor pools that may be
+///             reused by |DescriptorPoolVK|s instead of creating new pools.
+///
+///             Pools are returned here by the |ResourceManagerVK| once the
+///             command buffer that referenced them is done executing.
+///
+class DescriptorPoolRecyclerVK final
+    : public std::enable_shared_from_this<DescriptorPoolRecyclerVK> {
+ public:
+  /// The maximum number of pools that are retained for reuse. Pools recycled
+  /// past this limit are destroyed.
+  static constexpr size_t kMaxRecycledPools = 32u;
+
+  /// A pool along with the number of descriptors of each type it was sized
+  /// for.
+  struct SizedPool {
+    vk::UniqueDescriptorPool pool;
+    uint32_t size = 0u;
+  };
+
+  explicit DescriptorPoolRecyclerVK(
+      std::weak_ptr<ResourceManagerVK> resource_manager);
+
+  ~DescriptorPoolRecyclerVK();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Take a recycled pool that can hold at least |min_size|
+  ///             descriptors of each type.
+  ///
+  /// @return     The smallest such pool, or |std::nullopt| if there are none.
+  ///
+  std::optional<SizedPool> Take(uint32_t min_size);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Hand pools that may still be in use by the GPU to the resource
+  ///             manager. They are reset and made available to |Take| when the
+  ///             resource manager reclaims them.
+  ///
+  void Reclaim(std::vector<SizedPool> pools);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Make reset pools immediately available to |Take|.
+  ///
+  void Recycle(std::vector<SizedPool> pools);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Destroy all retained pools.
+  ///
+  /// @note       Must be called before the device is destroyed.
+  ///
+  void Clear();
+
+  size_t GetRecycledPoolCount() const;
+
+ private:
+  std::weak_ptr<ResourceManagerVK> resource_manager_;
+  mutable Mutex recycled_mutex_;
+  std::vector<SizedPool> recycled_ IPLR_GUARDED_BY(recycled_mutex_);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DescriptorPoolRecyclerVK);
+};
+
 //------------------------------------------------------------------------------
 /// @brief      A short-lived dynamically-sized descriptor pool. Descriptors
 ///             from this pool don't need to be freed individually. Instead, the
@@ -25,10 +138,16 @@ namespace impeller {
 ///             Encoders create pools as necessary as they have the same
 ///             threading and lifecycle restrictions.
 ///
+///             Descriptor sets that are written with the same bindings are
+///             only allocated and updated once per pool. When a recycler is
+///             given, the underlying Vulkan pools are reset and reused once
+///             the pool is collected instead of being destroyed.
+///
 class DescriptorPoolVK {
  public:
   explicit DescriptorPoolVK(
-      const std::weak_ptr<const DeviceHolder>& device_holder);
+      const std::weak_ptr<const DeviceHolder>& device_holder,
+      std::shared_ptr<DescriptorPoolRecyclerVK> recycler = nullptr);
 
   ~DescriptorPoolVK();
 
@@ -36,13 +155,38 @@ class DescriptorPoolVK {
       const vk::DescriptorSetLayout& layout,
       size_t command_count);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get a descriptor set with the given layout that is populated
+  ///             by the given writes.
+  ///
+  ///             If a set with identical bindings was already produced by this
+  ///             pool, it is returned as is. Otherwise, a new set is allocated
+  ///             and updated with the writes.
+  ///
+  /// @param[in]  layout         The layout of the descriptor set.
+  /// @param[in]  writes         The writes to apply to the set. The
+  ///                            destination set of each is filled in.
+  /// @param[in]  command_count  A sizing hint for the first pool.
+  ///
+  std::optional<vk::DescriptorSet> GetOrAllocateDescriptorSet(
+      const vk::DescriptorSetLayout& layout,
+      std::vector<vk::WriteDescriptorSet>& writes,
+      size_t command_count);
+
+  size_t GetCachedDescriptorSetCount() const;
+
  private:
   std::optional<vk::DescriptorSet> AllocateDescriptorSet(
       const vk::DescriptorSetLayout& layout);
 
   std::weak_ptr<const DeviceHolder> device_holder_;
+  std::shared_ptr<DescriptorPoolRecyclerVK> recycler_;
   uint32_t pool_size_ = 31u;
-  std::queue<vk::UniqueDescriptorPool> pools_;
+  std::queue<DescriptorPoolRecyclerVK::SizedPool> pools_;
+  std::unordered_map<DescriptorSetKeyVK,
+                     vk::DescriptorSet,
+                     DescriptorSetKeyVK::Hash>
+      cached_sets_;
 
   std::optional<vk::DescriptorPool> GetDescriptorPool();
 
@@ -0,0 +1,108 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include "flutter/testing/testing.h"
+#include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+size_t CountCalls(const std::vector<std::string>& called_functions,
+                  const std::string& name) {
+  return std::count(called_functions.begin(), called_functions.end(), name);
+}
+
+vk::WriteDescriptorSet MakeBufferWrite(const vk::DescriptorBufferInfo& info) {
+  vk::WriteDescriptorSet write;
+  write.dstBinding = 0u;
+  write.descriptorCount = 1u;
+  write.descriptorType = vk::DescriptorType::eUniformBuffer;
+  write.pBufferInfo = &info;
+  return write;
+}
+
+bool WaitForRecycledPools(const DescriptorPoolRecyclerVK& recycler,
+                          size_t count) {
+  // Pools are reset on the resource manager thread.
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (recycler.GetRecycledPoolCount() != count) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::yield();
+  }
+  return true;
+}
+
+}  // namespace
+
+TEST(DescriptorPoolVKTest, ReusesDescriptorSetsWithIdenticalBindings) {
+  auto const context = CreateMockVulkanContext();
+  auto called_functions = GetMockVulkanFunctions(context->GetDevice());
+  DescriptorPoolVK pool(context->GetDeviceHolder());
+
+  auto layout = vk::DescriptorSetLayout{};
+  vk::DescriptorBufferInfo info;
+  info.buffer = vk::Buffer{};
+  info.offset = 0u;
+  info.range = 64u;
+
+  std::vector<vk::WriteDescriptorSet> writes = {MakeBufferWrite(info)};
+  auto first = pool.GetOrAllocateDescriptorSet(layout, writes, 1u);
+  writes = {MakeBufferWrite(info)};
+  auto second = pool.GetOrAllocateDescriptorSet(layout, writes, 1u);
+
+  ASSERT_TRUE(first.has_value());
+  ASSERT_TRUE(second.has_value());
+  EXPECT_EQ(first.value(), second.value());
+  EXPECT_EQ(pool.GetCachedDescriptorSetCount(), 1u);
+  EXPECT_EQ(CountCalls(*called_functions, "vkAllocateDescriptorSets"), 1u);
+  EXPECT_EQ(CountCalls(*called_functions, "vkUpdateDescriptorSets"), 1u);
+
+  info.offset = 256u;
+  writes = {MakeBufferWrite(info)};
+  auto third = pool.GetOrAllocateDescriptorSet(layout, writes, 1u);
+
+  ASSERT_TRUE(third.has_value());
+  EXPECT_NE(first.value(), third.value());
+  EXPECT_EQ(writes[0].dstSet, third.value());
+  EXPECT_EQ(pool.GetCachedDescriptorSetCount(), 2u);
+  EXPECT_EQ(CountCalls(*called_functions, "vkAllocateDescriptorSets"), 2u);
+  EXPECT_EQ(CountCalls(*called_functions, "vkUpdateDescriptorSets"), 2u);
+}
+
+TEST(DescriptorPoolVKTest, RecyclesPoolsOnceReclaimed) {
+  auto const context = CreateMockVulkanContext();
+  auto called_functions = GetMockVulkanFunctions(context->GetDevice());
+  auto recycler = std::make_shared<DescriptorPoolRecyclerVK>(
+      context->GetResourceManager());
+
+  {
+    DescriptorPoolVK pool(context->GetDeviceHolder(), recycler);
+    EXPECT_TRUE(pool.AllocateDescriptorSet({}, 4u).has_value());
+  }
+  ASSERT_TRUE(WaitForRecycledPools(*recycler, 1u));
+  EXPECT_EQ(CountCalls(*called_functions, "vkCreateDescriptorPool"), 1u);
+  EXPECT_EQ(CountCalls(*called_functions, "vkResetDescriptorPool"), 1u);
+
+  {
+    DescriptorPoolVK pool(context->GetDeviceHolder(), recycler);
+    EXPECT_TRUE(pool.AllocateDescriptorSet({}, 4u).has_value());
+    EXPECT_EQ(recycler->GetRecycledPoolCount(), 0u);
+  }
+  ASSERT_TRUE(WaitForRecycledPools(*recycler, 1u));
+  EXPECT_EQ(CountCalls(*called_functions, "vkCreateDescriptorPool"), 1u);
+  EXPECT_EQ(CountCalls(*called_functions, "vkDestroyDescriptorPool"), 0u);
+  recycler->Clear();
+}
+
+}  // namespace testing
+}  // namespace impeller
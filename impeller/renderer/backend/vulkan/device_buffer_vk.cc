@@ -12,13 +12,18 @@ namespace impeller {
 DeviceBufferVK::DeviceBufferVK(DeviceBufferDescriptor desc,
                                std::weak_ptr<Context> context,
                                UniqueBufferVMA buffer,
-                               VmaAllocationInfo info)
+                               VmaAllocationInfo info,
+                               std::weak_ptr<AllocationPoolVK> pool,
+                               size_t bucket_size)
     : DeviceBuffer(desc),
       context_(std::move(context)),
       resource_(ContextVK::Cast(*context_.lock().get()).GetResourceManager(),
                 BufferResource{
-                    std::move(buffer),  //
-                    info                //
+                    std::move(buffer),   //
+                    info,                //
+                    desc.storage_mode,   //
+                    std::move(pool),     //
+                    bucket_size          //
                 }) {}
 
 DeviceBufferVK::~DeviceBufferVK() = default;
@@ -47,6 +52,12 @@ bool DeviceBufferVK::OnCopyHostBuffer(const uint8_t* source,
   return true;
 }
 
+void DeviceBufferVK::Flush(Range range) {
+  ::vmaFlushAllocation(resource_->buffer.get().allocator,
+                       resource_->buffer.get().allocation, range.offset,
+                       range.length);
+}
+
 bool DeviceBufferVK::SetLabel(const std::string& label) {
   auto context = context_.lock();
   if (!context || !resource_->buffer.is_valid()) {
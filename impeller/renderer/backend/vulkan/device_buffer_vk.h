@@ -10,19 +10,24 @@
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/backend_cast.h"
 #include "impeller/core/device_buffer.h"
+#include "impeller/renderer/backend/vulkan/allocation_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/resource_manager_vk.h"
+#include "impeller/renderer/backend/vulkan/tracked_resource_vk.h"
 #include "impeller/renderer/backend/vulkan/vma.h"
 
 namespace impeller {
 
 class DeviceBufferVK final : public DeviceBuffer,
+                             public TrackedResourceVK,
                              public BackendCast<DeviceBufferVK, Buffer> {
  public:
   DeviceBufferVK(DeviceBufferDescriptor desc,
                  std::weak_ptr<Context> context,
                  UniqueBufferVMA buffer,
-                 VmaAllocationInfo info);
+                 VmaAllocationInfo info,
+                 std::weak_ptr<AllocationPoolVK> pool = {},
+                 size_t bucket_size = 0u);
 
   // |DeviceBuffer|
   ~DeviceBufferVK() override;
@@ -35,15 +40,42 @@ class DeviceBufferVK final : public DeviceBuffer,
   struct BufferResource {
     UniqueBufferVMA buffer;
     VmaAllocationInfo info = {};
+    StorageMode storage_mode = StorageMode::kHostVisible;
+    // The pool the buffer is returned to when collected, if the bucket size
+    // is non-zero.
+    std::weak_ptr<AllocationPoolVK> pool;
+    size_t bucket_size = 0u;
 
     BufferResource() = default;
 
-    BufferResource(UniqueBufferVMA p_buffer, VmaAllocationInfo p_info)
-        : buffer(std::move(p_buffer)), info(p_info) {}
+    BufferResource(UniqueBufferVMA p_buffer,
+                   VmaAllocationInfo p_info,
+                   StorageMode p_storage_mode,
+                   std::weak_ptr<AllocationPoolVK> p_pool,
+                   size_t p_bucket_size)
+        : buffer(std::move(p_buffer)),
+          info(p_info),
+          storage_mode(p_storage_mode),
+          pool(std::move(p_pool)),
+          bucket_size(p_bucket_size) {}
 
     BufferResource(BufferResource&& o) {
       std::swap(o.buffer, buffer);
       std::swap(o.info, info);
+      std::swap(o.storage_mode, storage_mode);
+      std::swap(o.pool, pool);
+      std::swap(o.bucket_size, bucket_size);
+    }
+
+    ~BufferResource() {
+      if (!buffer.is_valid() || bucket_size == 0u) {
+        return;
+      }
+      if (auto strong_pool = pool.lock()) {
+        strong_pool->RecycleBuffer(
+            storage_mode, bucket_size,
+            AllocationPoolVK::PooledBuffer{std::move(buffer), info});
+      }
     }
 
     FML_DISALLOW_COPY_AND_ASSIGN(BufferResource);
@@ -60,6 +92,9 @@ class DeviceBufferVK final : public DeviceBuffer,
                         Range source_range,
                         size_t offset) override;
 
+  // |DeviceBuffer|
+  void Flush(Range range) override;
+
   // |DeviceBuffer|
   bool SetLabel(const std::string& label) override;
 
@@ -10,6 +10,7 @@
 #include "flutter/fml/thread.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
+#include "impeller/renderer/backend/vulkan/resource_manager_vk.h"
 
 namespace impeller {
 
@@ -44,8 +45,33 @@ class WaitSetEntry {
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(WaitSetEntry);
 };
 
-FenceWaiterVK::FenceWaiterVK(std::weak_ptr<DeviceHolder> device_holder)
-    : device_holder_(std::move(device_holder)) {
+static vk::UniqueSemaphore CreateTimelineSemaphore(const vk::Device& device) {
+  vk::StructureChain<vk::SemaphoreCreateInfo, vk::SemaphoreTypeCreateInfoKHR>
+      semaphore_info;
+  semaphore_info.get<vk::SemaphoreTypeCreateInfoKHR>()
+      .setSemaphoreType(vk::SemaphoreType::eTimeline)
+      .setInitialValue(0u);
+  auto [result, semaphore] =
+      device.createSemaphoreUnique(semaphore_info.get());
+  if (result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not create timeline semaphore: "
+                   << vk::to_string(result);
+    return {};
+  }
+  return std::move(semaphore);
+}
+
+FenceWaiterVK::FenceWaiterVK(std::weak_ptr<DeviceHolder> device_holder,
+                             std::weak_ptr<ResourceManagerVK> resource_manager,
+                             bool use_timeline_semaphore)
+    : device_holder_(std::move(device_holder)),
+      resource_manager_(std::move(resource_manager)) {
+  if (use_timeline_semaphore) {
+    if (auto strong_device = device_holder_.lock()) {
+      // Falls back to fences if the semaphore could not be created.
+      timeline_semaphore_ = CreateTimelineSemaphore(strong_device->GetDevice());
+    }
+  }
   waiter_thread_ = std::make_unique<std::thread>([&]() { Main(); });
   is_valid_ = true;
 }
@@ -75,6 +101,132 @@ bool FenceWaiterVK::AddFence(vk::UniqueFence fence,
   return true;
 }
 
+bool FenceWaiterVK::UsesTimelineSemaphore() const {
+  return !!timeline_semaphore_;
+}
+
+static bool CanBatch(const vk::SubmitInfo& submit_info) {
+  return submit_info.waitSemaphoreCount == 0u &&
+         submit_info.signalSemaphoreCount == 0u &&
+         submit_info.pNext == nullptr;
+}
+
+bool FenceWaiterVK::Submit(const QueueVK& queue,
+                           vk::SubmitInfo submit_info,
+                           const fml::closure& callback) {
+  TRACE_EVENT0("flutter", "FenceWaiterVK::Submit");
+  if (!IsValid() || !callback) {
+    return false;
+  }
+
+  std::scoped_lock batch_lock(batch_mutex_);
+  if (batching_) {
+    if (CanBatch(submit_info) &&
+        (batch_queue_ == nullptr || batch_queue_ == &queue)) {
+      batch_queue_ = &queue;
+      batch_command_buffers_.insert(
+          batch_command_buffers_.end(), submit_info.pCommandBuffers,
+          submit_info.pCommandBuffers + submit_info.commandBufferCount);
+      batch_callbacks_.push_back(callback);
+      return true;
+    }
+    if (!FlushBatchLocked()) {
+      return false;
+    }
+  }
+  return SubmitNow(queue, submit_info, callback);
+}
+
+void FenceWaiterVK::BeginBatch() {
+  std::scoped_lock batch_lock(batch_mutex_);
+  batching_ = true;
+}
+
+bool FenceWaiterVK::FlushBatch() {
+  std::scoped_lock batch_lock(batch_mutex_);
+  batching_ = false;
+  return FlushBatchLocked();
+}
+
+bool FenceWaiterVK::FlushBatchLocked() {
+  if (batch_command_buffers_.empty()) {
+    return true;
+  }
+  TRACE_EVENT0("flutter", "FenceWaiterVK::FlushBatch");
+  const auto* queue = batch_queue_;
+  auto command_buffers = std::move(batch_command_buffers_);
+  auto callbacks = std::move(batch_callbacks_);
+  batch_queue_ = nullptr;
+  batch_command_buffers_.clear();
+  batch_callbacks_.clear();
+
+  vk::SubmitInfo submit_info;
+  submit_info.setCommandBuffers(command_buffers);
+  // Like for a single submission, the callbacks are dropped without being
+  // invoked if the submission fails.
+  return SubmitNow(*queue, submit_info, [callbacks = std::move(callbacks)]() {
+    for (const auto& callback : callbacks) {
+      callback();
+    }
+  });
+}
+
+bool FenceWaiterVK::SubmitNow(const QueueVK& queue,
+                              vk::SubmitInfo submit_info,
+                              const fml::closure& callback) {
+  if (!timeline_semaphore_) {
+    auto device_holder = device_holder_.lock();
+    if (!device_holder) {
+      VALIDATION_LOG << "Device lost.";
+      return false;
+    }
+    auto [fence_result, fence] =
+        device_holder->GetDevice().createFenceUnique({});
+    if (fence_result != vk::Result::eSuccess) {
+      VALIDATION_LOG << "Failed to create fence: "
+                     << vk::to_string(fence_result);
+      return false;
+    }
+    auto status = queue.Submit(submit_info, *fence);
+    if (status != vk::Result::eSuccess) {
+      VALIDATION_LOG << "Failed to submit queue: " << vk::to_string(status);
+      return false;
+    }
+    return AddFence(std::move(fence), callback);
+  }
+
+  std::scoped_lock submit_lock(submit_mutex_);
+  const auto value = last_submitted_value_ + 1u;
+
+  // Binary semaphores the submission already signals ignore their values.
+  std::vector<vk::Semaphore> signal_semaphores(
+      submit_info.pSignalSemaphores,
+      submit_info.pSignalSemaphores + submit_info.signalSemaphoreCount);
+  std::vector<uint64_t> signal_values(signal_semaphores.size(), 0u);
+  signal_semaphores.push_back(*timeline_semaphore_);
+  signal_values.push_back(value);
+
+  vk::TimelineSemaphoreSubmitInfoKHR timeline_info;
+  timeline_info.setSignalSemaphoreValues(signal_values);
+  timeline_info.pNext = submit_info.pNext;
+  submit_info.setSignalSemaphores(signal_semaphores);
+  submit_info.pNext = &timeline_info;
+
+  auto status = queue.Submit(submit_info, {});
+  if (status != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Failed to submit queue: " << vk::to_string(status);
+    return false;
+  }
+  last_submitted_value_ = value;
+  {
+    std::scoped_lock lock(wait_set_mutex_);
+    timeline_entries_.push_back(
+        {value, fml::ScopedCleanupClosure{callback}});
+  }
+  wait_set_cv_.notify_one();
+  return true;
+}
+
 static std::vector<vk::Fence> GetFencesForWaitSet(const WaitSet& set) {
   std::vector<vk::Fence> fences;
   for (const auto& entry : set) {
@@ -89,6 +241,11 @@ void FenceWaiterVK::Main() {
   fml::Thread::SetCurrentThreadName(
       fml::Thread::ThreadConfig{"io.flutter.impeller.fence_waiter"});
 
+  if (timeline_semaphore_) {
+    TimelineMain();
+    return;
+  }
+
   using namespace std::literals::chrono_literals;
 
   while (true) {
@@ -167,12 +324,111 @@ void FenceWaiterVK::Main() {
 
     {
       TRACE_EVENT0("impeller", "ClearSignaledFences");
+      ResourceManagerVK::ScopedBatch batch(resource_manager_.lock());
       // Erase the erased entries which will invoke callbacks.
       erased_entries.clear();  // Bit redundant because of scope but hey.
     }
   }
 }
 
+void FenceWaiterVK::TimelineMain() {
+  using namespace std::literals::chrono_literals;
+
+  const auto semaphore = *timeline_semaphore_;
+  while (true) {
+    std::unique_lock lock(wait_set_mutex_);
+
+    wait_set_cv_.wait(lock, [&]() {
+      return !timeline_entries_.empty() || !wait_set_.empty() || terminate_;
+    });
+
+    if (terminate_) {
+      break;
+    }
+
+    // Fences may still be added directly. They are rare enough in this mode
+    // that polling them each time the waiter wakes up is fine.
+    const auto has_fences = !wait_set_.empty();
+
+    // Waiting for the most recent submission instead of the oldest one allows
+    // the callbacks of all the submissions in flight to be collected with a
+    // single wakeup.
+    const auto wait_value =
+        timeline_entries_.empty() ? 0u : timeline_entries_.back().value;
+
+    lock.unlock();
+
+    auto device_holder = device_holder_.lock();
+    if (!device_holder) {
+      break;
+    }
+    const auto& device = device_holder->GetDevice();
+
+    if (wait_value > 0u) {
+      vk::SemaphoreWaitInfoKHR wait_info;
+      wait_info.setSemaphores(semaphore);
+      wait_info.setValues(wait_value);
+      auto timeout = has_fences ? 1ms : 100ms;
+      auto result = device.waitSemaphoresKHR(
+          wait_info, std::chrono::nanoseconds{timeout}.count());
+      if (!(result == vk::Result::eSuccess ||
+            result == vk::Result::eTimeout)) {
+        VALIDATION_LOG << "Fence waiter encountered an unexpected error. "
+                          "Tearing down the waiter thread.";
+        break;
+      }
+    } else {
+      std::this_thread::sleep_for(1ms);
+    }
+
+    auto [counter_result, completed_value] =
+        device.getSemaphoreCounterValueKHR(semaphore);
+    if (counter_result != vk::Result::eSuccess) {
+      VALIDATION_LOG << "Could not read the timeline semaphore value. Tearing "
+                        "down the waiter thread.";
+      break;
+    }
+
+    WaitSet wait_set;
+    if (has_fences) {
+      std::scoped_lock wait_set_lock(wait_set_mutex_);
+      wait_set = wait_set_;
+    }
+    for (auto& entry : wait_set) {
+      entry->UpdateSignalledStatus(device);
+    }
+    wait_set.clear();
+
+    // Make sure the mutex is unlocked before the callbacks are invoked. These
+    // might touch allocators or add more work.
+    std::vector<TimelineEntry> completed_entries;
+    WaitSet erased_entries;
+    {
+      std::scoped_lock wait_set_lock(wait_set_mutex_);
+      while (!timeline_entries_.empty() &&
+             timeline_entries_.front().value <= completed_value) {
+        completed_entries.push_back(std::move(timeline_entries_.front()));
+        timeline_entries_.pop_front();
+      }
+      static auto is_signalled = [](const auto& entry) {
+        return entry->IsSignalled();
+      };
+      std::copy_if(wait_set_.begin(), wait_set_.end(),
+                   std::back_inserter(erased_entries), is_signalled);
+      wait_set_.erase(
+          std::remove_if(wait_set_.begin(), wait_set_.end(), is_signalled),
+          wait_set_.end());
+    }
+
+    {
+      TRACE_EVENT0("impeller", "ClearCompletedSubmissions");
+      ResourceManagerVK::ScopedBatch batch(resource_manager_.lock());
+      completed_entries.clear();
+      erased_entries.clear();
+    }
+  }
+}
+
 void FenceWaiterVK::Terminate() {
   {
     std::scoped_lock lock(wait_set_mutex_);
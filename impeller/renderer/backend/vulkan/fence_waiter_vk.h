@@ -5,6 +5,7 @@
 #pragma once
 
 #include <condition_variable>
+#include <deque>
 #include <memory>
 #include <thread>
 #include <vector>
@@ -13,16 +14,29 @@
 #include "flutter/fml/macros.h"
 #include "impeller/base/thread.h"
 #include "impeller/renderer/backend/vulkan/device_holder.h"
+#include "impeller/renderer/backend/vulkan/queue_vk.h"
 #include "impeller/renderer/backend/vulkan/shared_object_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 
 namespace impeller {
 
 class ContextVK;
+class ResourceManagerVK;
 class WaitSetEntry;
 
 using WaitSet = std::vector<std::shared_ptr<WaitSetEntry>>;
 
+//------------------------------------------------------------------------------
+/// @brief      Invokes callbacks once the GPU is done with the submissions
+///             they were registered for.
+///
+///             When the device supports timeline semaphores, every submission
+///             made via |Submit| signals the next value of a single timeline
+///             semaphore instead of a fence of its own. The waiter thread then
+///             only wakes up to collect batches of completed submissions. The
+///             resources released by the callbacks of a batch are handed to
+///             the resource manager all at once.
+///
 class FenceWaiterVK {
  public:
   ~FenceWaiterVK();
@@ -33,21 +47,90 @@ class FenceWaiterVK {
 
   bool AddFence(vk::UniqueFence fence, const fml::closure& callback);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether submissions are tracked by a timeline semaphore
+  ///             instead of by fences.
+  ///
+  bool UsesTimelineSemaphore() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Submit work to the queue and invoke the callback once the GPU
+  ///             is done with it.
+  ///
+  /// @param[in]  queue        The queue to submit to.
+  /// @param[in]  submit_info  The submission. The timeline semaphore signal
+  ///                          operation is appended to it as necessary.
+  /// @param[in]  callback     The callback. It is not invoked if the
+  ///                          submission fails.
+  ///
+  /// @return     If the work was submitted.
+  ///
+  bool Submit(const QueueVK& queue,
+              vk::SubmitInfo submit_info,
+              const fml::closure& callback);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Collects the command buffers of the following submissions
+  ///             into a single queue submission, made by |FlushBatch|.
+  ///
+  ///             Only submissions without semaphores or extension structures
+  ///             are collected. Any other submission, or a submission to
+  ///             another queue, flushes the batch first so that the GPU still
+  ///             sees all work in submission order. Nothing may wait for the
+  ///             completion of collected work before the batch is flushed.
+  ///
+  void BeginBatch();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Submits the collected command buffers and stops collecting.
+  ///
+  /// @return     If the collected work, if any, was submitted.
+  ///
+  bool FlushBatch();
+
  private:
   friend class ContextVK;
 
+  struct TimelineEntry {
+    uint64_t value = 0u;
+    fml::ScopedCleanupClosure callback;
+  };
+
   std::weak_ptr<DeviceHolder> device_holder_;
+  std::weak_ptr<ResourceManagerVK> resource_manager_;
+  vk::UniqueSemaphore timeline_semaphore_;
   std::unique_ptr<std::thread> waiter_thread_;
+  // Held while submitting so that timeline values are signaled by the queues
+  // in increasing order.
+  std::mutex submit_mutex_;
+  uint64_t last_submitted_value_ = 0u;
   std::mutex wait_set_mutex_;
   std::condition_variable wait_set_cv_;
   WaitSet wait_set_;
+  std::deque<TimelineEntry> timeline_entries_;
   bool terminate_ = false;
   bool is_valid_ = false;
+  // Held while submitting so that collected work is never overtaken.
+  std::mutex batch_mutex_;
+  bool batching_ = false;
+  const QueueVK* batch_queue_ = nullptr;
+  std::vector<vk::CommandBuffer> batch_command_buffers_;
+  std::vector<fml::closure> batch_callbacks_;
+
+  explicit FenceWaiterVK(std::weak_ptr<DeviceHolder> device_holder,
+                         std::weak_ptr<ResourceManagerVK> resource_manager = {},
+                         bool use_timeline_semaphore = false);
 
-  explicit FenceWaiterVK(std::weak_ptr<DeviceHolder> device_holder);
+  bool SubmitNow(const QueueVK& queue,
+                 vk::SubmitInfo submit_info,
+                 const fml::closure& callback);
+
+  bool FlushBatchLocked();
 
   void Main();
 
+  void TimelineMain();
+
   FML_DISALLOW_COPY_AND_ASSIGN(FenceWaiterVK);
 };
 
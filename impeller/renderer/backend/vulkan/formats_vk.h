@@ -159,6 +159,18 @@ constexpr vk::Format ToVKImageFormat(PixelFormat format) {
       return vk::Format::eS8Uint;
     case PixelFormat::kD24UnormS8Uint:
       return vk::Format::eD24UnormS8Uint;
+    case PixelFormat::kETC2R8G8B8UNormInt:
+      return vk::Format::eEtc2R8G8B8UnormBlock;
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+      return vk::Format::eEtc2R8G8B8A8UnormBlock;
+    case PixelFormat::kASTC4x4UNormInt:
+      return vk::Format::eAstc4x4UnormBlock;
+    case PixelFormat::kBC1R8G8B8A8UNormInt:
+      return vk::Format::eBc1RgbaUnormBlock;
+    case PixelFormat::kBC3R8G8B8A8UNormInt:
+      return vk::Format::eBc3UnormBlock;
+    case PixelFormat::kBC7R8G8B8A8UNormInt:
+      return vk::Format::eBc7UnormBlock;
     case PixelFormat::kD32FloatS8UInt:
       return vk::Format::eD32SfloatS8Uint;
     case PixelFormat::kR8UNormInt:
@@ -387,6 +399,12 @@ constexpr bool PixelFormatIsDepthStencil(PixelFormat format) {
     case PixelFormat::kB10G10R10XR:
     case PixelFormat::kB10G10R10XRSRGB:
     case PixelFormat::kB10G10R10A10XR:
+    case PixelFormat::kETC2R8G8B8UNormInt:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kASTC4x4UNormInt:
+    case PixelFormat::kBC1R8G8B8A8UNormInt:
+    case PixelFormat::kBC3R8G8B8A8UNormInt:
+    case PixelFormat::kBC7R8G8B8A8UNormInt:
       return false;
     case PixelFormat::kS8UInt:
     case PixelFormat::kD24UnormS8Uint:
@@ -418,6 +436,12 @@ constexpr AttachmentKind AttachmentKindFromFormat(PixelFormat format) {
     case PixelFormat::kB10G10R10XR:
     case PixelFormat::kB10G10R10XRSRGB:
     case PixelFormat::kB10G10R10A10XR:
+    case PixelFormat::kETC2R8G8B8UNormInt:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kASTC4x4UNormInt:
+    case PixelFormat::kBC1R8G8B8A8UNormInt:
+    case PixelFormat::kBC3R8G8B8A8UNormInt:
+    case PixelFormat::kBC7R8G8B8A8UNormInt:
       return AttachmentKind::kColor;
     case PixelFormat::kS8UInt:
       return AttachmentKind::kStencil;
@@ -577,6 +601,12 @@ constexpr vk::ImageAspectFlags ToVKImageAspectFlags(PixelFormat format) {
     case PixelFormat::kB10G10R10XR:
     case PixelFormat::kB10G10R10XRSRGB:
     case PixelFormat::kB10G10R10A10XR:
+    case PixelFormat::kETC2R8G8B8UNormInt:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kASTC4x4UNormInt:
+    case PixelFormat::kBC1R8G8B8A8UNormInt:
+    case PixelFormat::kBC3R8G8B8A8UNormInt:
+    case PixelFormat::kBC7R8G8B8A8UNormInt:
       return vk::ImageAspectFlagBits::eColor;
     case PixelFormat::kS8UInt:
       return vk::ImageAspectFlagBits::eStencil;
@@ -651,6 +681,12 @@ constexpr vk::ImageAspectFlags ToImageAspectFlags(PixelFormat format) {
     case PixelFormat::kB10G10R10XR:
     case PixelFormat::kB10G10R10XRSRGB:
     case PixelFormat::kB10G10R10A10XR:
+    case PixelFormat::kETC2R8G8B8UNormInt:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kASTC4x4UNormInt:
+    case PixelFormat::kBC1R8G8B8A8UNormInt:
+    case PixelFormat::kBC3R8G8B8A8UNormInt:
+    case PixelFormat::kBC7R8G8B8A8UNormInt:
       return vk::ImageAspectFlagBits::eColor;
     case PixelFormat::kS8UInt:
       return vk::ImageAspectFlagBits::eStencil;
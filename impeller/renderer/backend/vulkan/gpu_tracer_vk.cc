@@ -0,0 +1,153 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/gpu_tracer_vk.h"
+
+#include <utility>
+
+#include "impeller/base/validation.h"
+
+namespace impeller {
+
+PassTimestampsVK::PassTimestampsVK(std::shared_ptr<GPUTracerVK> tracer,
+                                   vk::UniqueQueryPool pool)
+    : tracer_(std::move(tracer)), pool_(std::move(pool)) {}
+
+PassTimestampsVK::~PassTimestampsVK() {
+  tracer_->RecyclePool(std::move(pool_));
+}
+
+void PassTimestampsVK::Reset(const vk::CommandBuffer& buffer) {
+  buffer.resetQueryPool(pool_.get(), 0u, kMaxPasses * 2u);
+  labels_.clear();
+  in_pass_ = false;
+}
+
+void PassTimestampsVK::BeginPass(const vk::CommandBuffer& buffer,
+                                 const std::string& label) {
+  if (in_pass_ || labels_.size() == kMaxPasses) {
+    return;
+  }
+  buffer.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, pool_.get(),
+                        static_cast<uint32_t>(labels_.size() * 2u));
+  labels_.push_back(label);
+  in_pass_ = true;
+}
+
+void PassTimestampsVK::EndPass(const vk::CommandBuffer& buffer) {
+  if (!in_pass_) {
+    return;
+  }
+  buffer.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, pool_.get(),
+                        static_cast<uint32_t>(labels_.size() * 2u - 1u));
+  in_pass_ = false;
+}
+
+const std::shared_ptr<GPUTracer>& PassTimestampsVK::GetTracer() const {
+  return tracer_->GetTracer();
+}
+
+std::vector<GPUTracer::PassTime> PassTimestampsVK::GetPassTimes() const {
+  std::vector<GPUTracer::PassTime> times;
+  auto device_holder = tracer_->device_holder_.lock();
+  // An unfinished pass has no end timestamp and is left out.
+  const size_t pass_count = labels_.size() - (in_pass_ ? 1u : 0u);
+  if (!device_holder || pass_count == 0u) {
+    return times;
+  }
+  std::vector<uint64_t> timestamps(pass_count * 2u);
+  auto result = device_holder->GetDevice().getQueryPoolResults(
+      pool_.get(), 0u, static_cast<uint32_t>(timestamps.size()),
+      timestamps.size() * sizeof(uint64_t), timestamps.data(),
+      sizeof(uint64_t), vk::QueryResultFlagBits::e64);
+  if (result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not read GPU timestamps: "
+                   << vk::to_string(result);
+    return times;
+  }
+  const auto to_delta = [&](uint64_t from, uint64_t to) {
+    const uint64_t ticks = (to - from) & tracer_->timestamp_mask_;
+    return fml::TimeDelta::FromNanoseconds(
+        static_cast<int64_t>(ticks * tracer_->timestamp_period_));
+  };
+  const uint64_t origin = timestamps[0];
+  times.reserve(pass_count);
+  for (size_t i = 0; i < pass_count; i++) {
+    times.push_back({labels_[i], to_delta(origin, timestamps[i * 2u]),
+                     to_delta(origin, timestamps[i * 2u + 1u])});
+  }
+  return times;
+}
+
+bool GPUTracerVK::IsSupported(const vk::PhysicalDevice& physical_device,
+                              size_t graphics_queue_family) {
+  const auto properties = physical_device.getProperties();
+  if (!properties.limits.timestampComputeAndGraphics ||
+      properties.limits.timestampPeriod <= 0.0f) {
+    return false;
+  }
+  const auto families = physical_device.getQueueFamilyProperties();
+  return graphics_queue_family < families.size() &&
+         families[graphics_queue_family].timestampValidBits > 0u;
+}
+
+GPUTracerVK::GPUTracerVK(std::weak_ptr<DeviceHolder> device_holder,
+                         std::shared_ptr<GPUTracer> tracer,
+                         const vk::PhysicalDevice& physical_device,
+                         size_t graphics_queue_family)
+    : device_holder_(std::move(device_holder)), tracer_(std::move(tracer)) {
+  timestamp_period_ = physical_device.getProperties().limits.timestampPeriod;
+  const auto valid_bits = physical_device.getQueueFamilyProperties()
+                              [graphics_queue_family]
+                                  .timestampValidBits;
+  timestamp_mask_ =
+      valid_bits >= 64u ? ~uint64_t{0} : (uint64_t{1} << valid_bits) - 1u;
+  tracer_->SetSupported(true);
+}
+
+GPUTracerVK::~GPUTracerVK() = default;
+
+const std::shared_ptr<GPUTracer>& GPUTracerVK::GetTracer() const {
+  return tracer_;
+}
+
+std::unique_ptr<PassTimestampsVK> GPUTracerVK::CreatePassTimestamps() {
+  vk::UniqueQueryPool pool;
+  {
+    Lock lock(pools_mutex_);
+    if (!pools_.empty()) {
+      pool = std::move(pools_.back());
+      pools_.pop_back();
+    }
+  }
+  if (!pool) {
+    auto device_holder = device_holder_.lock();
+    if (!device_holder) {
+      return nullptr;
+    }
+    vk::QueryPoolCreateInfo info;
+    info.queryType = vk::QueryType::eTimestamp;
+    info.queryCount = PassTimestampsVK::kMaxPasses * 2u;
+    auto [result, created] =
+        device_holder->GetDevice().createQueryPoolUnique(info);
+    if (result != vk::Result::eSuccess) {
+      VALIDATION_LOG << "Could not create a timestamp query pool: "
+                     << vk::to_string(result);
+      return nullptr;
+    }
+    pool = std::move(created);
+  }
+  return std::make_unique<PassTimestampsVK>(shared_from_this(),
+                                            std::move(pool));
+}
+
+void GPUTracerVK::RecyclePool(vk::UniqueQueryPool pool) {
+  if (!pool) {
+    return;
+  }
+  Lock lock(pools_mutex_);
+  pools_.push_back(std::move(pool));
+}
+
+}  // namespace impeller
@@ -0,0 +1,118 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
+#include "impeller/renderer/backend/vulkan/device_holder.h"
+#include "impeller/renderer/backend/vulkan/vk.h"
+#include "impeller/renderer/gpu_tracer.h"
+
+namespace impeller {
+
+class GPUTracerVK;
+
+//------------------------------------------------------------------------------
+/// @brief      The timestamp queries written around the passes of a primary
+///             command buffer.
+///
+///             The queries must not be collected before the GPU is done with
+///             the command buffer, after which the pool of the queries is
+///             recycled.
+///
+class PassTimestampsVK {
+ public:
+  PassTimestampsVK(std::shared_ptr<GPUTracerVK> tracer,
+                   vk::UniqueQueryPool pool);
+
+  ~PassTimestampsVK();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Resets the queries. Must be recorded at the start of the
+  ///             command buffer.
+  ///
+  void Reset(const vk::CommandBuffer& buffer);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Writes the timestamp of the start of a pass. Passes beyond
+  ///             the capacity of the queries, and passes nested in another,
+  ///             are not measured.
+  ///
+  void BeginPass(const vk::CommandBuffer& buffer, const std::string& label);
+
+  void EndPass(const vk::CommandBuffer& buffer);
+
+  const std::shared_ptr<GPUTracer>& GetTracer() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reads the timestamps of the passes of a completed command
+  ///             buffer.
+  ///
+  std::vector<GPUTracer::PassTime> GetPassTimes() const;
+
+  static constexpr uint32_t kMaxPasses = 32u;
+
+ private:
+  const std::shared_ptr<GPUTracerVK> tracer_;
+  vk::UniqueQueryPool pool_;
+  std::vector<std::string> labels_;
+  bool in_pass_ = false;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PassTimestampsVK);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Measures the GPU time of passes with timestamp queries and
+///             reports it to the |GPUTracer| of a context.
+///
+///             This class is thread-safe.
+///
+class GPUTracerVK : public std::enable_shared_from_this<GPUTracerVK> {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the graphics queue of the device supports timestamp
+  ///             queries.
+  ///
+  static bool IsSupported(const vk::PhysicalDevice& physical_device,
+                          size_t graphics_queue_family);
+
+  GPUTracerVK(std::weak_ptr<DeviceHolder> device_holder,
+              std::shared_ptr<GPUTracer> tracer,
+              const vk::PhysicalDevice& physical_device,
+              size_t graphics_queue_family);
+
+  ~GPUTracerVK();
+
+  const std::shared_ptr<GPUTracer>& GetTracer() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates the queries of a primary command buffer.
+  ///
+  /// @return     The queries, or nullptr if the query pool could not be
+  ///             created.
+  ///
+  std::unique_ptr<PassTimestampsVK> CreatePassTimestamps();
+
+ private:
+  friend class PassTimestampsVK;
+
+  const std::weak_ptr<DeviceHolder> device_holder_;
+  const std::shared_ptr<GPUTracer> tracer_;
+  // The duration of a timestamp tick in nanoseconds.
+  double timestamp_period_ = 0.0;
+  uint64_t timestamp_mask_ = 0u;
+  Mutex pools_mutex_;
+  std::vector<vk::UniqueQueryPool> pools_ IPLR_GUARDED_BY(pools_mutex_);
+
+  void RecyclePool(vk::UniqueQueryPool pool);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GPUTracerVK);
+};
+
+}  // namespace impeller
@@ -0,0 +1,123 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/parallel_pass_encoder_vk.h"
+
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+std::shared_ptr<ParallelPassEncoderVK> ParallelPassEncoderVK::Create(
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner) {
+  if (!worker_task_runner) {
+    return nullptr;
+  }
+  return std::shared_ptr<ParallelPassEncoderVK>(
+      new ParallelPassEncoderVK(std::move(worker_task_runner)));
+}
+
+ParallelPassEncoderVK::ParallelPassEncoderVK(
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner)
+    : worker_task_runner_(std::move(worker_task_runner)) {}
+
+ParallelPassEncoderVK::~ParallelPassEncoderVK() {
+  Flush();
+}
+
+void ParallelPassEncoderVK::Enqueue(ResourceSet resources,
+                                    EncodeProc encode,
+                                    SubmitProc submit) {
+  TRACE_EVENT0("impeller", "ParallelPassEncoderVK::Enqueue");
+  auto entry = std::make_shared<Entry>();
+  entry->resources = std::move(resources);
+  entry->encode = std::move(encode);
+  entry->submit = std::move(submit);
+
+  {
+    std::scoped_lock lock(mutex_);
+    entry->sequence = next_sequence_++;
+    for (const auto& pending : pending_) {
+      if (pending->is_encoded) {
+        continue;
+      }
+      for (const auto& resource : entry->resources) {
+        if (pending->resources.count(resource) > 0) {
+          entry->wait_for_previous = true;
+          break;
+        }
+      }
+      if (entry->wait_for_previous) {
+        break;
+      }
+    }
+    pending_.push_back(entry);
+  }
+
+  // Tasks are dequeued by the workers in FIFO order. An entry only ever waits
+  // on entries that were posted before it, which have therefore already been
+  // picked up by another worker (or have finished). This can't deadlock.
+  worker_task_runner_->PostTask(
+      [encoder = shared_from_this(), entry]() { encoder->Encode(entry); });
+}
+
+void ParallelPassEncoderVK::Encode(const std::shared_ptr<Entry>& entry) {
+  if (entry->wait_for_previous) {
+    TRACE_EVENT0("impeller", "ParallelPassEncoderVK::WaitForHazard");
+    std::unique_lock lock(mutex_);
+    cv_.wait(lock, [&]() { return AllEncodedBeforeLocked(entry->sequence); });
+  }
+
+  bool result = false;
+  {
+    TRACE_EVENT0("impeller", "ParallelPassEncoderVK::Encode");
+    result = entry->encode ? entry->encode() : false;
+  }
+
+  {
+    std::scoped_lock lock(mutex_);
+    entry->is_encoded = true;
+    entry->encode_succeeded = result;
+    // The encode callback may hold on to the pass and its resources. Release
+    // them as soon as possible.
+    entry->encode = nullptr;
+    DrainLocked();
+  }
+  cv_.notify_all();
+}
+
+bool ParallelPassEncoderVK::AllEncodedBeforeLocked(uint64_t sequence) const {
+  for (const auto& pending : pending_) {
+    if (pending->sequence >= sequence) {
+      return true;
+    }
+    if (!pending->is_encoded) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ParallelPassEncoderVK::DrainLocked() {
+  while (!pending_.empty() && pending_.front()->is_encoded) {
+    auto entry = std::move(pending_.front());
+    pending_.pop_front();
+    if (entry->submit) {
+      TRACE_EVENT0("impeller", "ParallelPassEncoderVK::Submit");
+      entry->submit(entry->encode_succeeded);
+    }
+  }
+}
+
+void ParallelPassEncoderVK::Flush() {
+  TRACE_EVENT0("impeller", "ParallelPassEncoderVK::Flush");
+  std::unique_lock lock(mutex_);
+  cv_.wait(lock, [&]() { return pending_.empty(); });
+}
+
+size_t ParallelPassEncoderVK::GetPendingCount() const {
+  std::scoped_lock lock(mutex_);
+  return pending_.size();
+}
+
+}  // namespace impeller
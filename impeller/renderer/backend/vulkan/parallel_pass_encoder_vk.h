@@ -0,0 +1,110 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/macros.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Encodes recorded passes on a concurrent worker pool and submits
+///             them in the order they were enqueued.
+///
+///             Each pass declares the set of resources (attachments and
+///             sampled textures) it touches. Passes that touch disjoint
+///             resources are encoded concurrently. A pass that touches a
+///             resource used by a pass that is still pending waits for every
+///             earlier pass to finish encoding first, so that image layout
+///             bookkeeping on shared textures is observed in submission order.
+///
+///             Submissions always happen in enqueue order regardless of which
+///             worker finishes first. Callers that need to submit work
+///             synchronously must call `Flush` first so that they don't
+///             overtake passes still being encoded.
+///
+///             One encoder is meant to be used per recording thread. All the
+///             methods are thread safe.
+///
+class ParallelPassEncoderVK final
+    : public std::enable_shared_from_this<ParallelPassEncoderVK> {
+ public:
+  /// Encodes the pass. Runs on a worker thread. Returns false on failure.
+  using EncodeProc = std::function<bool()>;
+
+  /// Submits the pass. Runs on whichever thread drains the queue, always in
+  /// enqueue order. The argument indicates whether encoding succeeded.
+  using SubmitProc = std::function<void(bool encoded)>;
+
+  /// An opaque identity for a resource touched by a pass (usually the address
+  /// of a texture).
+  using ResourceKey = const void*;
+
+  using ResourceSet = std::unordered_set<ResourceKey>;
+
+  static std::shared_ptr<ParallelPassEncoderVK> Create(
+      std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner);
+
+  ~ParallelPassEncoderVK();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Schedule a pass for encoding on a worker and for submission
+  ///             after all previously enqueued passes have been submitted.
+  ///
+  /// @param[in]  resources  The resources the pass reads from or writes to.
+  /// @param[in]  encode     The encoding callback.
+  /// @param[in]  submit     The submission callback.
+  ///
+  void Enqueue(ResourceSet resources, EncodeProc encode, SubmitProc submit);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Block until every enqueued pass has been encoded and
+  ///             submitted.
+  ///
+  void Flush();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of passes that have been enqueued but not yet
+  ///             submitted.
+  ///
+  size_t GetPendingCount() const;
+
+ private:
+  struct Entry {
+    uint64_t sequence = 0;
+    ResourceSet resources;
+    EncodeProc encode;
+    SubmitProc submit;
+    bool wait_for_previous = false;
+    bool is_encoded = false;
+    bool encode_succeeded = false;
+  };
+
+  const std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner_;
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::shared_ptr<Entry>> pending_;
+  uint64_t next_sequence_ = 0;
+
+  explicit ParallelPassEncoderVK(
+      std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner);
+
+  void Encode(const std::shared_ptr<Entry>& entry);
+
+  bool AllEncodedBeforeLocked(uint64_t sequence) const;
+
+  void DrainLocked();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ParallelPassEncoderVK);
+};
+
+}  // namespace impeller
@@ -0,0 +1,104 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "impeller/renderer/backend/vulkan/parallel_pass_encoder_vk.h"
+
+namespace impeller {
+namespace testing {
+
+TEST(ParallelPassEncoderVKTest, SubmitsInEnqueueOrder) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4u);
+  auto encoder = ParallelPassEncoderVK::Create(loop->GetTaskRunner());
+  ASSERT_TRUE(encoder);
+
+  std::mutex submitted_mutex;
+  std::vector<size_t> submitted;
+  int resources[16] = {};
+  for (size_t i = 0; i < 16; i++) {
+    encoder->Enqueue(
+        {&resources[i]},
+        [i]() {
+          // Make earlier passes finish encoding later.
+          std::this_thread::sleep_for(std::chrono::milliseconds(16 - i));
+          return true;
+        },
+        [&, i](bool encoded) {
+          ASSERT_TRUE(encoded);
+          std::scoped_lock lock(submitted_mutex);
+          submitted.push_back(i);
+        });
+  }
+  encoder->Flush();
+
+  ASSERT_EQ(encoder->GetPendingCount(), 0u);
+  ASSERT_EQ(submitted.size(), 16u);
+  for (size_t i = 0; i < submitted.size(); i++) {
+    EXPECT_EQ(submitted[i], i);
+  }
+}
+
+TEST(ParallelPassEncoderVKTest, SerializesPassesSharingResources) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4u);
+  auto encoder = ParallelPassEncoderVK::Create(loop->GetTaskRunner());
+  ASSERT_TRUE(encoder);
+
+  int shared_texture = 0;
+  std::atomic<int> active_encodes = 0;
+  std::atomic<bool> overlapped = false;
+  for (size_t i = 0; i < 8; i++) {
+    encoder->Enqueue(
+        {&shared_texture},
+        [&]() {
+          if (active_encodes.fetch_add(1) != 0) {
+            overlapped = true;
+          }
+          std::this_thread::sleep_for(std::chrono::milliseconds(2));
+          active_encodes.fetch_sub(1);
+          return true;
+        },
+        [](bool encoded) { ASSERT_TRUE(encoded); });
+  }
+  encoder->Flush();
+
+  EXPECT_FALSE(overlapped);
+}
+
+TEST(ParallelPassEncoderVKTest, ReportsEncodingFailures) {
+  auto loop = fml::ConcurrentMessageLoop::Create(2u);
+  auto encoder = ParallelPassEncoderVK::Create(loop->GetTaskRunner());
+  ASSERT_TRUE(encoder);
+
+  std::atomic<int> failures = 0;
+  encoder->Enqueue(
+      {}, []() { return false; },
+      [&](bool encoded) {
+        if (!encoded) {
+          failures++;
+        }
+      });
+  encoder->Enqueue(
+      {}, []() { return true; },
+      [&](bool encoded) {
+        if (!encoded) {
+          failures++;
+        }
+      });
+  encoder->Flush();
+
+  EXPECT_EQ(failures, 1);
+}
+
+TEST(ParallelPassEncoderVKTest, CreateFailsWithoutWorkers) {
+  EXPECT_EQ(ParallelPassEncoderVK::Create(nullptr), nullptr);
+}
+
+}  // namespace testing
+}  // namespace impeller
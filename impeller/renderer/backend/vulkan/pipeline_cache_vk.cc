@@ -6,6 +6,7 @@
 
 #include "impeller/renderer/backend/vulkan/pipeline_cache_vk.h"
 
+#include <cstring>
 #include <sstream>
 
 #include "flutter/fml/mapping.h"
@@ -16,6 +17,59 @@ namespace impeller {
 static constexpr const char* kPipelineCacheFileName =
     "flutter.impeller.vkcache";
 
+static constexpr const char* kPipelineManifestFileName =
+    "flutter.impeller.vkmanifest";
+
+// Bump this when the layout of the header or the manifest changes.
+static constexpr uint32_t kPipelineManifestVersion = 1u;
+
+// Prefixed to the serialized manifest. The manifest is discarded if the
+// device or driver changed since it was written as the pipelines it refers to
+// would have to be compiled from scratch anyway. This is compared bytewise and
+// must not contain any padding.
+struct PipelineManifestHeaderVK {
+  uint32_t version = 0u;
+  uint32_t vendor_id = 0u;
+  uint32_t device_id = 0u;
+  uint32_t driver_version = 0u;
+  uint8_t pipeline_cache_uuid[VK_UUID_SIZE] = {};
+
+  explicit PipelineManifestHeaderVK(const CapabilitiesVK& caps)
+      : version(kPipelineManifestVersion) {
+    const auto& props = caps.GetPhysicalDeviceProperties();
+    vendor_id = props.vendorID;
+    device_id = props.deviceID;
+    driver_version = props.driverVersion;
+    std::memcpy(pipeline_cache_uuid, props.pipelineCacheUUID,
+                sizeof(pipeline_cache_uuid));
+  }
+};
+
+static_assert(sizeof(PipelineManifestHeaderVK) ==
+              4 * sizeof(uint32_t) + VK_UUID_SIZE);
+
+static std::shared_ptr<PipelineManifest> OpenManifestFile(
+    const fml::UniqueFD& base_directory,
+    const CapabilitiesVK& caps) {
+  if (!base_directory.is_valid()) {
+    return nullptr;
+  }
+  auto mapping = fml::FileMapping::CreateReadOnly(base_directory,
+                                                  kPipelineManifestFileName);
+  if (!mapping || mapping->GetSize() < sizeof(PipelineManifestHeaderVK)) {
+    return nullptr;
+  }
+  PipelineManifestHeaderVK header(caps);
+  if (std::memcmp(mapping->GetMapping(), &header, sizeof(header)) != 0) {
+    FML_LOG(INFO) << "Pipeline manifest was written by a different device or "
+                     "driver. Starting with a fresh manifest.";
+    return nullptr;
+  }
+  return PipelineManifest::CreateFromMapping(fml::NonOwnedMapping(
+      mapping->GetMapping() + sizeof(header),
+      mapping->GetSize() - sizeof(header)));
+}
+
 static bool VerifyExistingCache(const fml::Mapping& mapping,
                                 const CapabilitiesVK& caps) {
   return true;
@@ -97,6 +151,11 @@ PipelineCacheVK::PipelineCacheVK(std::shared_ptr<const Capabilities> caps,
     }
   }
 
+  manifest_ = OpenManifestFile(cache_directory_, vk_caps);
+  if (!manifest_) {
+    manifest_ = std::make_shared<PipelineManifest>();
+  }
+
   is_valid_ = !!cache_;
 }
 
@@ -170,6 +229,7 @@ void PipelineCacheVK::PersistCacheToDisk() const {
   if (!cache_directory_.is_valid()) {
     return;
   }
+  PersistManifestToDisk();
   auto data = CopyPipelineCacheData();
   if (!data) {
     VALIDATION_LOG << "Could not copy pipeline cache data.";
@@ -187,6 +247,30 @@ void PipelineCacheVK::PersistCacheToDisk() const {
   }
 }
 
+const std::shared_ptr<PipelineManifest>& PipelineCacheVK::GetManifest() const {
+  return manifest_;
+}
+
+void PipelineCacheVK::PersistManifestToDisk() const {
+  if (!cache_directory_.is_valid() || !manifest_ || !caps_) {
+    return;
+  }
+  auto manifest_data = manifest_->Serialize();
+  if (!manifest_data) {
+    return;
+  }
+  PipelineManifestHeaderVK header(CapabilitiesVK::Cast(*caps_));
+  std::vector<uint8_t> data(sizeof(header) + manifest_data->GetSize());
+  std::memcpy(data.data(), &header, sizeof(header));
+  std::memcpy(data.data() + sizeof(header), manifest_data->GetMapping(),
+              manifest_data->GetSize());
+  fml::NonOwnedMapping mapping(data.data(), data.size());
+  if (!fml::WriteAtomically(cache_directory_, kPipelineManifestFileName,
+                            mapping)) {
+    VALIDATION_LOG << "Could not persist pipeline manifest to disk.";
+  }
+}
+
 const CapabilitiesVK* PipelineCacheVK::GetCapabilities() const {
   return CapabilitiesVK::Cast(caps_.get());
 }
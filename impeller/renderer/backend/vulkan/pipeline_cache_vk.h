@@ -8,6 +8,7 @@
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/backend/vulkan/capabilities_vk.h"
 #include "impeller/renderer/backend/vulkan/device_holder.h"
+#include "impeller/renderer/pipeline_manifest.h"
 
 namespace impeller {
 
@@ -31,13 +32,26 @@ class PipelineCacheVK {
 
   const CapabilitiesVK* GetCapabilities() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Persists both the pipeline cache and the pipeline manifest.
+  ///
   void PersistCacheToDisk() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The manifest of pipeline variants. If a manifest written by
+  ///             the same driver on the same device was found in the cache
+  ///             directory, it is pre-populated with its contents.
+  ///
+  const std::shared_ptr<PipelineManifest>& GetManifest() const;
+
+  void PersistManifestToDisk() const;
+
  private:
   const std::shared_ptr<const Capabilities> caps_;
   std::weak_ptr<DeviceHolder> device_holder_;
   const fml::UniqueFD cache_directory_;
   vk::UniquePipelineCache cache_;
+  std::shared_ptr<PipelineManifest> manifest_;
   bool is_valid_ = false;
 
   std::shared_ptr<fml::Mapping> CopyPipelineCacheData() const;
@@ -0,0 +1,63 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include "flutter/fml/file.h"
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/pipeline_cache_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+
+namespace impeller {
+namespace testing {
+
+static fml::UniqueFD OpenCacheDirectory(
+    const fml::ScopedTemporaryDirectory& temp_dir) {
+  return fml::OpenDirectory(temp_dir.path().c_str(), false,
+                            fml::FilePermission::kReadWrite);
+}
+
+TEST(PipelineCacheVKTest, PersistsManifestAcrossLaunches) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto context = CreateMockVulkanContext();
+
+  {
+    PipelineCacheVK cache(context->GetCapabilities(),
+                          context->GetDeviceHolder(),
+                          OpenCacheDirectory(temp_dir));
+    ASSERT_TRUE(cache.IsValid());
+    ASSERT_EQ(cache.GetManifest()->GetVariantCount(), 0u);
+    cache.GetManifest()->Record("SolidFill Pipeline", 42u);
+    cache.PersistManifestToDisk();
+  }
+
+  PipelineCacheVK cache(context->GetCapabilities(), context->GetDeviceHolder(),
+                        OpenCacheDirectory(temp_dir));
+  ASSERT_TRUE(cache.IsValid());
+  auto variants = cache.GetManifest()->GetVariants("SolidFill Pipeline");
+  ASSERT_EQ(variants.size(), 1u);
+  ASSERT_EQ(variants[0], 42u);
+}
+
+TEST(PipelineCacheVKTest, DiscardsManifestWithMismatchedHeader) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto context = CreateMockVulkanContext();
+
+  // Looks like a manifest but was not written by this device and driver.
+  std::string data(64u, '\0');
+  data += "impeller-pipeline-manifest 1\n2a SolidFill Pipeline\n";
+  ASSERT_TRUE(fml::WriteAtomically(
+      OpenCacheDirectory(temp_dir), "flutter.impeller.vkmanifest",
+      fml::NonOwnedMapping(reinterpret_cast<const uint8_t*>(data.data()),
+                           data.size())));
+
+  PipelineCacheVK cache(context->GetCapabilities(), context->GetDeviceHolder(),
+                        OpenCacheDirectory(temp_dir));
+  ASSERT_TRUE(cache.IsValid());
+  ASSERT_EQ(cache.GetManifest()->GetVariantCount(), 0u);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -8,6 +8,7 @@
 #include <optional>
 #include <sstream>
 
+#include "flutter/fml/closure.h"
 #include "flutter/fml/container.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/promise.h"
@@ -21,6 +22,35 @@
 
 namespace impeller {
 
+namespace {
+
+//------------------------------------------------------------------------------
+/// @brief      The creation of a pipeline, run once by either the worker it
+///             was posted to or the first thread that needs the pipeline
+///             before that worker got to it.
+///
+class PipelineCreationVK {
+ public:
+  explicit PipelineCreationVK(fml::closure create)
+      : create_(std::move(create)) {}
+
+  void Run() {
+    if (started_.test_and_set()) {
+      return;
+    }
+    create_();
+    create_ = nullptr;
+  }
+
+ private:
+  std::atomic_flag started_ = ATOMIC_FLAG_INIT;
+  fml::closure create_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PipelineCreationVK);
+};
+
+}  // namespace
+
 PipelineLibraryVK::PipelineLibraryVK(
     const std::shared_ptr<DeviceHolder>& device_holder,
     std::shared_ptr<const Capabilities> caps,
@@ -229,7 +259,8 @@ static void ReportPipelineCreationFeedback(
 }
 
 std::unique_ptr<PipelineVK> PipelineLibraryVK::CreatePipeline(
-    const PipelineDescriptor& desc) {
+    const PipelineDescriptor& desc,
+    const ImmutableSamplersVK& immutable_samplers) {
   TRACE_EVENT0("flutter", __FUNCTION__);
   vk::StructureChain<vk::GraphicsPipelineCreateInfo,
                      vk::PipelineCreationFeedbackCreateInfoEXT>
@@ -269,6 +300,24 @@ std::unique_ptr<PipelineVK> PipelineLibraryVK::CreatePipeline(
   //----------------------------------------------------------------------------
   /// Shader Stages
   ///
+  // All stages share the same specialization constants. Entries for
+  // constants a stage doesn't declare are ignored.
+  const auto& constants = desc.GetSpecializationConstants();
+  std::vector<vk::SpecializationMapEntry> specialization_map_entries;
+  specialization_map_entries.reserve(constants.size());
+  for (size_t i = 0; i < constants.size(); i++) {
+    vk::SpecializationMapEntry entry;
+    entry.constantID = i;
+    entry.offset = i * sizeof(Scalar);
+    entry.size = sizeof(Scalar);
+    specialization_map_entries.push_back(entry);
+  }
+  vk::SpecializationInfo specialization_info;
+  specialization_info.mapEntryCount = specialization_map_entries.size();
+  specialization_info.pMapEntries = specialization_map_entries.data();
+  specialization_info.dataSize = constants.size() * sizeof(Scalar);
+  specialization_info.pData = constants.data();
+
   std::vector<vk::PipelineShaderStageCreateInfo> shader_stages;
   for (const auto& entrypoint : desc.GetStageEntrypoints()) {
     auto stage = ToVKShaderStageFlagBits(entrypoint.first);
@@ -282,6 +331,9 @@ std::unique_ptr<PipelineVK> PipelineLibraryVK::CreatePipeline(
     info.setPName("main");
     info.setModule(
         ShaderFunctionVK::Cast(entrypoint.second.get())->GetModule());
+    if (!constants.empty()) {
+      info.setPSpecializationInfo(&specialization_info);
+    }
     shader_stages.push_back(info);
   }
   pipeline_info.setStages(shader_stages);
@@ -376,9 +428,18 @@ std::unique_ptr<PipelineVK> PipelineLibraryVK::CreatePipeline(
   /// Pipeline Layout a.k.a the descriptor sets and uniforms.
   ///
   std::vector<vk::DescriptorSetLayoutBinding> desc_bindings;
+  // Referenced by the bindings, so this may not be resized.
+  std::vector<vk::Sampler> samplers(immutable_samplers.size());
 
   for (auto layout : desc.GetVertexDescriptor()->GetDescriptorSetLayouts()) {
     auto vk_desc_layout = ToVKDescriptorSetLayoutBinding(layout);
+    for (size_t i = 0; i < immutable_samplers.size(); i++) {
+      if (layout.descriptor_type == DescriptorType::kSampledImage &&
+          immutable_samplers[i].binding == layout.binding) {
+        samplers[i] = immutable_samplers[i].yuv_conversion->GetSampler();
+        vk_desc_layout.setPImmutableSamplers(&samplers[i]);
+      }
+    }
     desc_bindings.push_back(vk_desc_layout);
   }
 
@@ -455,7 +516,8 @@ std::unique_ptr<PipelineVK> PipelineLibraryVK::CreatePipeline(
                                       std::move(pipeline),               //
                                       std::move(render_pass),            //
                                       std::move(pipeline_layout.value),  //
-                                      std::move(descs_layout)            //
+                                      std::move(descs_layout),           //
+                                      immutable_samplers                 //
   );
 }
 
@@ -581,13 +643,11 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryVK::GetPipeline(
 
   auto promise = std::make_shared<
       std::promise<std::shared_ptr<Pipeline<PipelineDescriptor>>>>();
-  auto pipeline_future =
-      PipelineFuture<PipelineDescriptor>{descriptor, promise->get_future()};
-  pipelines_[descriptor] = pipeline_future;
 
   auto weak_this = weak_from_this();
 
-  worker_task_runner_->PostTask([descriptor, weak_this, promise]() {
+  auto creation = std::make_shared<PipelineCreationVK>([descriptor, weak_this,
+                                                        promise]() {
     auto thiz = weak_this.lock();
     if (!thiz) {
       promise->set_value(nullptr);
@@ -606,6 +666,16 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryVK::GetPipeline(
     promise->set_value(std::move(pipeline));
   });
 
+  // Pipelines are created in the order they were requested, unless one is
+  // needed before it is ready, such as by the raster thread in the middle of
+  // a frame. Then it is created right away on the thread that needs it, even
+  // while the workers are still busy with the pipelines requested before it.
+  auto pipeline_future = PipelineFuture<PipelineDescriptor>{
+      descriptor, promise->get_future(), [creation]() { creation->Run(); }};
+  pipelines_[descriptor] = pipeline_future;
+
+  worker_task_runner_->PostTask([creation]() { creation->Run(); });
+
   return pipeline_future;
 }
 
@@ -627,13 +697,11 @@ PipelineFuture<ComputePipelineDescriptor> PipelineLibraryVK::GetPipeline(
 
   auto promise = std::make_shared<
       std::promise<std::shared_ptr<Pipeline<ComputePipelineDescriptor>>>>();
-  auto pipeline_future = PipelineFuture<ComputePipelineDescriptor>{
-      descriptor, promise->get_future()};
-  compute_pipelines_[descriptor] = pipeline_future;
 
   auto weak_this = weak_from_this();
 
-  worker_task_runner_->PostTask([descriptor, weak_this, promise]() {
+  auto creation = std::make_shared<PipelineCreationVK>([descriptor, weak_this,
+                                                        promise]() {
     auto self = weak_this.lock();
     if (!self) {
       promise->set_value(nullptr);
@@ -653,6 +721,12 @@ PipelineFuture<ComputePipelineDescriptor> PipelineLibraryVK::GetPipeline(
     promise->set_value(std::move(pipeline));
   });
 
+  auto pipeline_future = PipelineFuture<ComputePipelineDescriptor>{
+      descriptor, promise->get_future(), [creation]() { creation->Run(); }};
+  compute_pipelines_[descriptor] = pipeline_future;
+
+  worker_task_runner_->PostTask([creation]() { creation->Run(); });
+
   return pipeline_future;
 }
 
@@ -673,6 +747,17 @@ void PipelineLibraryVK::DidAcquireSurfaceFrame() {
   }
 }
 
+void PipelineLibraryVK::PersistPipelineCacheToDiskSync() {
+  if (pso_cache_) {
+    pso_cache_->PersistCacheToDisk();
+  }
+}
+
+// |PipelineLibrary|
+std::shared_ptr<PipelineManifest> PipelineLibraryVK::GetManifest() const {
+  return pso_cache_ ? pso_cache_->GetManifest() : nullptr;
+}
+
 void PipelineLibraryVK::PersistPipelineCacheToDisk() {
   worker_task_runner_->PostTask(
       [weak_cache = decltype(pso_cache_)::weak_type(pso_cache_)]() {
@@ -31,8 +31,12 @@ class PipelineLibraryVK final
 
   void DidAcquireSurfaceFrame();
 
+  // |PipelineLibrary|
+  std::shared_ptr<PipelineManifest> GetManifest() const override;
+
  private:
   friend ContextVK;
+  friend PipelineVK;
 
   std::weak_ptr<DeviceHolder> device_holder_;
   std::shared_ptr<PipelineCacheVK> pso_cache_;
@@ -66,13 +70,20 @@ class PipelineLibraryVK final
   void RemovePipelinesWithEntryPoint(
       std::shared_ptr<const ShaderFunction> function) override;
 
-  std::unique_ptr<PipelineVK> CreatePipeline(const PipelineDescriptor& desc);
+  std::unique_ptr<PipelineVK> CreatePipeline(
+      const PipelineDescriptor& desc,
+      const ImmutableSamplersVK& immutable_samplers = {});
 
   std::unique_ptr<ComputePipelineVK> CreateComputePipeline(
       const ComputePipelineDescriptor& desc);
 
   void PersistPipelineCacheToDisk();
 
+  // Unlike |PersistPipelineCacheToDisk|, this persists the cache on the
+  // calling thread. Used during shutdown when the workers may already be gone
+  // by the time a posted task would run.
+  void PersistPipelineCacheToDiskSync();
+
   FML_DISALLOW_COPY_AND_ASSIGN(PipelineLibraryVK);
 };
 
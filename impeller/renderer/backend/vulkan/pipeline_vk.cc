@@ -4,6 +4,9 @@
 
 #include "impeller/renderer/backend/vulkan/pipeline_vk.h"
 
+#include "impeller/base/validation.h"
+#include "impeller/renderer/backend/vulkan/pipeline_library_vk.h"
+
 namespace impeller {
 
 PipelineVK::PipelineVK(std::weak_ptr<DeviceHolder> device_holder,
@@ -12,17 +15,24 @@ PipelineVK::PipelineVK(std::weak_ptr<DeviceHolder> device_holder,
                        vk::UniquePipeline pipeline,
                        vk::UniqueRenderPass render_pass,
                        vk::UniquePipelineLayout layout,
-                       vk::UniqueDescriptorSetLayout descriptor_set_layout)
-    : Pipeline(std::move(library), desc),
+                       vk::UniqueDescriptorSetLayout descriptor_set_layout,
+                       ImmutableSamplersVK immutable_samplers)
+    : Pipeline(library, desc),
       device_holder_(std::move(device_holder)),
+      library_(std::move(library)),
       pipeline_(std::move(pipeline)),
       render_pass_(std::move(render_pass)),
       layout_(std::move(layout)),
-      descriptor_set_layout_(std::move(descriptor_set_layout)) {
+      descriptor_set_layout_(std::move(descriptor_set_layout)),
+      immutable_samplers_(std::move(immutable_samplers)) {
   is_valid_ = pipeline_ && render_pass_ && layout_ && descriptor_set_layout_;
 }
 
 PipelineVK::~PipelineVK() {
+  {
+    Lock lock(variants_mutex_);
+    variants_.clear();
+  }
   std::shared_ptr<DeviceHolder> device_holder = device_holder_.lock();
   if (device_holder) {
     descriptor_set_layout_.reset();
@@ -57,4 +67,28 @@ const vk::DescriptorSetLayout& PipelineVK::GetDescriptorSetLayout() const {
   return *descriptor_set_layout_;
 }
 
+std::shared_ptr<PipelineVK> PipelineVK::GetOrCreateVariant(
+    const ImmutableSamplersVK& immutable_samplers) const {
+  Lock lock(variants_mutex_);
+  for (const auto& [samplers, variant] : variants_) {
+    if (samplers == immutable_samplers) {
+      return variant;
+    }
+  }
+  auto library = library_.lock();
+  if (!library) {
+    return nullptr;
+  }
+  std::shared_ptr<PipelineVK> variant =
+      PipelineLibraryVK::Cast(*library).CreatePipeline(GetDescriptor(),
+                                                       immutable_samplers);
+  if (!variant || !variant->IsValid()) {
+    VALIDATION_LOG << "Could not create immutable sampler variant of pipeline: "
+                   << GetDescriptor().GetLabel();
+    return nullptr;
+  }
+  variants_.emplace_back(immutable_samplers, variant);
+  return variant;
+}
+
 }  // namespace impeller
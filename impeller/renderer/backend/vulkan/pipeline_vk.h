@@ -5,15 +5,31 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/base/backend_cast.h"
+#include "impeller/base/thread.h"
 #include "impeller/renderer/backend/vulkan/device_holder.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
+#include "impeller/renderer/backend/vulkan/yuv_conversion_vk.h"
 #include "impeller/renderer/pipeline.h"
 
 namespace impeller {
 
+/// A combined image sampler binding of a pipeline whose sampler is baked into
+/// the descriptor set layout. Used for sampling YUV images.
+struct ImmutableSamplerVK {
+  uint32_t binding = 0u;
+  std::shared_ptr<YUVConversionVK> yuv_conversion;
+
+  bool operator==(const ImmutableSamplerVK& other) const {
+    return binding == other.binding && yuv_conversion == other.yuv_conversion;
+  }
+};
+
+using ImmutableSamplersVK = std::vector<ImmutableSamplerVK>;
+
 class PipelineVK final
     : public Pipeline<PipelineDescriptor>,
       public BackendCast<PipelineVK, Pipeline<PipelineDescriptor>> {
@@ -24,7 +40,8 @@ class PipelineVK final
              vk::UniquePipeline pipeline,
              vk::UniqueRenderPass render_pass,
              vk::UniquePipelineLayout layout,
-             vk::UniqueDescriptorSetLayout descriptor_set_layout);
+             vk::UniqueDescriptorSetLayout descriptor_set_layout,
+             ImmutableSamplersVK immutable_samplers);
 
   // |Pipeline|
   ~PipelineVK() override;
@@ -37,14 +54,40 @@ class PipelineVK final
 
   const vk::DescriptorSetLayout& GetDescriptorSetLayout() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get a variant of this pipeline whose descriptor set layout
+  ///             has the given immutable samplers. Vulkan requires these for
+  ///             sampling images with a YUV conversion.
+  ///
+  ///             Variants are created synchronously the first time they are
+  ///             needed and are cached with this pipeline. Since conversions
+  ///             are shared by all images of the same format, a video stream
+  ///             only ever needs a single variant of each pipeline.
+  ///
+  /// @param[in]  immutable_samplers  The immutable samplers. Must not be
+  ///                                 empty.
+  ///
+  /// @return     The variant, or nullptr if it could not be created.
+  ///
+  std::shared_ptr<PipelineVK> GetOrCreateVariant(
+      const ImmutableSamplersVK& immutable_samplers) const;
+
  private:
   friend class PipelineLibraryVK;
 
+  using Variants = std::vector<
+      std::pair<ImmutableSamplersVK, std::shared_ptr<PipelineVK>>>;
+
   std::weak_ptr<DeviceHolder> device_holder_;
+  std::weak_ptr<PipelineLibrary> library_;
   vk::UniquePipeline pipeline_;
   vk::UniqueRenderPass render_pass_;
   vk::UniquePipelineLayout layout_;
   vk::UniqueDescriptorSetLayout descriptor_set_layout_;
+  // Kept alive for as long as the descriptor set layout references them.
+  const ImmutableSamplersVK immutable_samplers_;
+  mutable Mutex variants_mutex_;
+  mutable Variants variants_ IPLR_GUARDED_BY(variants_mutex_);
   bool is_valid_ = false;
 
   // |Pipeline|
@@ -4,11 +4,14 @@
 
 #include "impeller/renderer/backend/vulkan/render_pass_vk.h"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstdint>
 #include <vector>
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/formats.h"
@@ -69,7 +72,7 @@ static vk::AttachmentDescription CreateAttachmentDescription(
 static void SetTextureLayout(
     const Attachment& attachment,
     const vk::AttachmentDescription& attachment_desc,
-    const std::shared_ptr<CommandBufferVK>& command_buffer,
+    BarrierBatchVK& barriers,
     const std::shared_ptr<Texture> Attachment::*texture_ptr) {
   const auto& texture = attachment.*texture_ptr;
   if (!texture) {
@@ -80,7 +83,6 @@ static void SetTextureLayout(
   if (attachment_desc.initialLayout == vk::ImageLayout::eGeneral) {
     BarrierVK barrier;
     barrier.new_layout = vk::ImageLayout::eGeneral;
-    barrier.cmd_buffer = command_buffer->GetEncoder()->GetCommandBuffer();
     barrier.src_access = vk::AccessFlagBits::eShaderRead;
     barrier.src_stage = vk::PipelineStageFlagBits::eFragmentShader;
     barrier.dst_access = vk::AccessFlagBits::eColorAttachmentWrite |
@@ -88,7 +90,7 @@ static void SetTextureLayout(
     barrier.dst_stage = vk::PipelineStageFlagBits::eColorAttachmentOutput |
                         vk::PipelineStageFlagBits::eTransfer;
 
-    texture_vk.SetLayout(barrier);
+    texture_vk.SetLayout(barrier, barriers);
   }
 
   // Instead of transitioning layouts manually using barriers, we are going to
@@ -98,7 +100,7 @@ static void SetTextureLayout(
 
 SharedHandleVK<vk::RenderPass> RenderPassVK::CreateVKRenderPass(
     const ContextVK& context,
-    const std::shared_ptr<CommandBufferVK>& command_buffer) const {
+    BarrierBatchVK& barriers) const {
   std::vector<vk::AttachmentDescription> attachments;
 
   std::vector<vk::AttachmentReference> color_refs;
@@ -124,14 +126,14 @@ SharedHandleVK<vk::RenderPass> RenderPassVK::CreateVKRenderPass(
                                 vk::ImageLayout::eColorAttachmentOptimal};
     attachments.emplace_back(
         CreateAttachmentDescription(color, &Attachment::texture));
-    SetTextureLayout(color, attachments.back(), command_buffer,
+    SetTextureLayout(color, attachments.back(), barriers,
                      &Attachment::texture);
     if (color.resolve_texture) {
       resolve_refs[bind_point] = vk::AttachmentReference{
           static_cast<uint32_t>(attachments.size()), vk::ImageLayout::eGeneral};
       attachments.emplace_back(
           CreateAttachmentDescription(color, &Attachment::resolve_texture));
-      SetTextureLayout(color, attachments.back(), command_buffer,
+      SetTextureLayout(color, attachments.back(), barriers,
                        &Attachment::resolve_texture);
     }
   }
@@ -142,7 +144,7 @@ SharedHandleVK<vk::RenderPass> RenderPassVK::CreateVKRenderPass(
         vk::ImageLayout::eDepthStencilAttachmentOptimal};
     attachments.emplace_back(
         CreateAttachmentDescription(depth.value(), &Attachment::texture));
-    SetTextureLayout(depth.value(), attachments.back(), command_buffer,
+    SetTextureLayout(depth.value(), attachments.back(), barriers,
                      &Attachment::texture);
   }
 
@@ -153,7 +155,7 @@ SharedHandleVK<vk::RenderPass> RenderPassVK::CreateVKRenderPass(
         vk::ImageLayout::eDepthStencilAttachmentOptimal};
     attachments.emplace_back(
         CreateAttachmentDescription(stencil.value(), &Attachment::texture));
-    SetTextureLayout(stencil.value(), attachments.back(), command_buffer,
+    SetTextureLayout(stencil.value(), attachments.back(), barriers,
                      &Attachment::texture);
   }
 
@@ -285,11 +287,10 @@ SharedHandleVK<vk::Framebuffer> RenderPassVK::CreateVKFramebuffer(
 }
 
 static bool UpdateBindingLayouts(const Bindings& bindings,
-                                 const vk::CommandBuffer& buffer) {
+                                 BarrierBatchVK& barriers) {
   // All previous writes via a render or blit pass must be done before another
   // shader attempts to read the resource.
   BarrierVK barrier;
-  barrier.cmd_buffer = buffer;
   barrier.src_access = vk::AccessFlagBits::eColorAttachmentWrite |
                        vk::AccessFlagBits::eTransferWrite;
   barrier.src_stage = vk::PipelineStageFlagBits::eColorAttachmentOutput |
@@ -300,7 +301,7 @@ static bool UpdateBindingLayouts(const Bindings& bindings,
   barrier.new_layout = vk::ImageLayout::eShaderReadOnlyOptimal;
 
   for (const auto& [_, data] : bindings.sampled_images) {
-    if (!TextureVK::Cast(*data.texture.resource).SetLayout(barrier)) {
+    if (!TextureVK::Cast(*data.texture.resource).SetLayout(barrier, barriers)) {
       return false;
     }
   }
@@ -308,15 +309,15 @@ static bool UpdateBindingLayouts(const Bindings& bindings,
 }
 
 static bool UpdateBindingLayouts(const Command& command,
-                                 const vk::CommandBuffer& buffer) {
-  return UpdateBindingLayouts(command.vertex_bindings, buffer) &&
-         UpdateBindingLayouts(command.fragment_bindings, buffer);
+                                 BarrierBatchVK& barriers) {
+  return UpdateBindingLayouts(command.vertex_bindings, barriers) &&
+         UpdateBindingLayouts(command.fragment_bindings, barriers);
 }
 
 static bool UpdateBindingLayouts(const std::vector<Command>& commands,
-                                 const vk::CommandBuffer& buffer) {
+                                 BarrierBatchVK& barriers) {
   for (const auto& command : commands) {
-    if (!UpdateBindingLayouts(command, buffer)) {
+    if (!UpdateBindingLayouts(command, barriers)) {
       return false;
     }
   }
@@ -330,12 +331,6 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
                                           size_t command_count) {
   auto desc_set =
       pipeline.GetDescriptor().GetVertexDescriptor()->GetDescriptorSetLayouts();
-  auto vk_desc_set = encoder.AllocateDescriptorSet(
-      pipeline.GetDescriptorSetLayout(), command_count);
-  if (!vk_desc_set) {
-    return false;
-  }
-
   auto& allocator = *context.GetResourceAllocator();
 
   std::vector<vk::DescriptorImageInfo> images;
@@ -350,8 +345,7 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
 
   auto bind_images = [&encoder,     //
                       &images,      //
-                      &writes,      //
-                      &vk_desc_set  //
+                      &writes       //
   ](const Bindings& bindings) -> bool {
     for (const auto& [index, data] : bindings.sampled_images) {
       auto texture = data.texture.resource;
@@ -369,10 +363,15 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
       image_info.imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
       image_info.sampler = sampler.GetSampler();
       image_info.imageView = texture_vk.GetImageView();
+      // The sampler is immutable in the layout of the pipeline variant picked
+      // by |GetImmutableSamplers| and this is ignored, but it's kept in sync
+      // so that descriptor sets are shared correctly.
+      if (auto conversion = texture_vk.GetYUVConversion()) {
+        image_info.sampler = conversion->GetSampler();
+      }
       images.push_back(image_info);
 
       vk::WriteDescriptorSet write_set;
-      write_set.dstSet = vk_desc_set.value();
       write_set.dstBinding = slot.binding;
       write_set.descriptorCount = 1u;
       write_set.descriptorType = vk::DescriptorType::eCombinedImageSampler;
@@ -388,8 +387,7 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
                        &encoder,     //
                        &buffers,     //
                        &writes,      //
-                       &desc_set,    //
-                       &vk_desc_set  //
+                       &desc_set     //
   ](const Bindings& bindings) -> bool {
     for (const auto& [buffer_index, data] : bindings.buffers) {
       const auto& buffer_view = data.view.resource.buffer;
@@ -430,7 +428,6 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
       auto layout = *layout_it;
 
       vk::WriteDescriptorSet write_set;
-      write_set.dstSet = vk_desc_set.value();
       write_set.dstBinding = uniform.binding;
       write_set.descriptorCount = 1u;
       write_set.descriptorType = ToVKDescriptorType(layout.descriptor_type);
@@ -447,7 +444,13 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
     return false;
   }
 
-  context.GetDevice().updateDescriptorSets(writes, {});
+  // Commands in this encoder with identical bindings share a descriptor set
+  // which is only written once.
+  auto vk_desc_set = encoder.GetOrAllocateDescriptorSet(
+      pipeline.GetDescriptorSetLayout(), writes, command_count);
+  if (!vk_desc_set) {
+    return false;
+  }
 
   encoder.GetCommandBuffer().bindDescriptorSets(
       vk::PipelineBindPoint::eGraphics,   // bind point
@@ -459,6 +462,20 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
   return true;
 }
 
+// YUV images must be sampled with the immutable sampler of their conversion,
+// which requires a variant of the pipeline.
+static ImmutableSamplersVK GetImmutableSamplers(const Command& command) {
+  ImmutableSamplersVK immutable_samplers;
+  for (const auto& [_, data] : command.fragment_bindings.sampled_images) {
+    auto conversion =
+        TextureVK::Cast(*data.texture.resource).GetYUVConversion();
+    if (conversion) {
+      immutable_samplers.push_back({data.slot.binding, std::move(conversion)});
+    }
+  }
+  return immutable_samplers;
+}
+
 static void SetViewportAndScissor(const Command& command,
                                   const vk::CommandBuffer& cmd_buffer,
                                   PassBindingsCache& cmd_buffer_cache,
@@ -505,7 +522,17 @@ static bool EncodeCommand(const Context& context,
 
   const auto& cmd_buffer = encoder.GetCommandBuffer();
 
-  const auto& pipeline_vk = PipelineVK::Cast(*command.pipeline);
+  const PipelineVK* pipeline = &PipelineVK::Cast(*command.pipeline);
+  std::shared_ptr<PipelineVK> pipeline_variant;
+  if (auto immutable_samplers = GetImmutableSamplers(command);
+      !immutable_samplers.empty()) {
+    pipeline_variant = pipeline->GetOrCreateVariant(immutable_samplers);
+    if (!pipeline_variant) {
+      return false;
+    }
+    pipeline = pipeline_variant.get();
+  }
+  const auto& pipeline_vk = *pipeline;
 
   if (!AllocateAndBindDescriptorSets(ContextVK::Cast(context),  //
                                      command,                   //
@@ -594,6 +621,150 @@ static bool EncodeCommand(const Context& context,
   return true;
 }
 
+namespace {
+
+/// Passes with at least this many commands are split into chunks that are
+/// recorded into secondary command buffers concurrently.
+constexpr size_t kMinCommandsForSecondaryCommandBuffers = 2048u;
+
+/// The number of commands recorded into each secondary command buffer.
+constexpr size_t kCommandsPerSecondaryCommandBuffer = 512u;
+
+/// The chunks of a render pass that are recorded into secondary command
+/// buffers. Chunks are claimed by the encoding thread as well as by the
+/// concurrent workers, so recording makes progress even if every worker is
+/// busy (for instance, when the pass itself is being encoded on a worker).
+///
+/// Each chunk is recorded into a secondary command buffer allocated from the
+/// command pool of the thread that claimed it.
+struct SecondaryCommandRecordingVK {
+  std::weak_ptr<const ContextVK> context;
+  const std::vector<Command>* commands = nullptr;
+  vk::CommandBufferInheritanceInfo inheritance_info;
+  ISize target_size;
+  std::vector<std::shared_ptr<CommandEncoderVK>> encoders;
+  std::atomic<size_t> next_chunk = 0u;
+  std::atomic<size_t> remaining_chunks = 0u;
+  std::atomic<bool> failed = false;
+  fml::AutoResetWaitableEvent done;
+
+  void RecordAvailableChunks() {
+    while (true) {
+      const auto chunk = next_chunk.fetch_add(1u, std::memory_order_relaxed);
+      if (chunk >= encoders.size()) {
+        return;
+      }
+      if (!RecordChunk(chunk)) {
+        failed.store(true, std::memory_order_relaxed);
+      }
+      if (remaining_chunks.fetch_sub(1u, std::memory_order_acq_rel) == 1u) {
+        done.Signal();
+      }
+    }
+  }
+
+  bool RecordChunk(size_t chunk) {
+    TRACE_EVENT0("impeller", "RecordSecondaryCommandBuffer");
+    auto strong_context = context.lock();
+    if (!strong_context) {
+      return false;
+    }
+    auto encoder =
+        CommandEncoderFactoryVK(context).CreateSecondary(inheritance_info);
+    if (!encoder) {
+      return false;
+    }
+    // Secondary command buffers don't inherit any state.
+    PassBindingsCache bindings_cache;
+    const auto begin = chunk * kCommandsPerSecondaryCommandBuffer;
+    const auto end =
+        std::min(commands->size(), begin + kCommandsPerSecondaryCommandBuffer);
+    for (auto i = begin; i < end; i++) {
+      const auto& command = (*commands)[i];
+      if (!command.pipeline) {
+        continue;
+      }
+      if (!EncodeCommand(*strong_context, command, *encoder, bindings_cache,
+                         target_size, end - begin)) {
+        return false;
+      }
+    }
+    encoders[chunk] = std::move(encoder);
+    return true;
+  }
+};
+
+}  // namespace
+
+/// Host buffers create their device buffers lazily, which must not race
+/// between the threads that record a pass.
+static void ResolveDeviceBuffers(const Context& context,
+                                 const std::vector<Command>& commands) {
+  TRACE_EVENT0("impeller", "ResolveDeviceBuffers");
+  auto& allocator = *context.GetResourceAllocator();
+  const Buffer* last_resolved = nullptr;
+  auto resolve = [&](const BufferView& view) {
+    if (view.buffer && view.buffer.get() != last_resolved) {
+      view.buffer->GetDeviceBuffer(allocator);
+      last_resolved = view.buffer.get();
+    }
+  };
+  for (const auto& command : commands) {
+    resolve(command.GetVertexBuffer());
+    resolve(command.index_buffer);
+    for (const auto& [_, data] : command.vertex_bindings.buffers) {
+      resolve(data.view.resource);
+    }
+    for (const auto& [_, data] : command.fragment_bindings.buffers) {
+      resolve(data.view.resource);
+    }
+  }
+}
+
+static bool EncodeCommandsInSecondaryCommandBuffers(
+    const ContextVK& context,
+    const std::vector<Command>& commands,
+    CommandEncoderVK& encoder,
+    const vk::RenderPassBeginInfo& pass_info,
+    const ISize& target_size) {
+  TRACE_EVENT0("impeller", "EncodeCommandsInSecondaryCommandBuffers");
+  ResolveDeviceBuffers(context, commands);
+
+  auto recording = std::make_shared<SecondaryCommandRecordingVK>();
+  recording->context = context.weak_from_this();
+  recording->commands = &commands;
+  recording->inheritance_info.renderPass = pass_info.renderPass;
+  recording->inheritance_info.subpass = 0u;
+  recording->inheritance_info.framebuffer = pass_info.framebuffer;
+  recording->target_size = target_size;
+  const auto chunk_count =
+      (commands.size() + kCommandsPerSecondaryCommandBuffer - 1u) /
+      kCommandsPerSecondaryCommandBuffer;
+  recording->encoders.resize(chunk_count);
+  recording->remaining_chunks = chunk_count;
+
+  // The recording thread claims chunks too, so one less worker is needed.
+  auto worker_task_runner = context.GetConcurrentWorkerTaskRunner();
+  for (size_t i = 1u; i < chunk_count; i++) {
+    worker_task_runner->PostTask(
+        [recording]() { recording->RecordAvailableChunks(); });
+  }
+  recording->RecordAvailableChunks();
+  recording->done.Wait();
+
+  if (recording->failed.load(std::memory_order_relaxed)) {
+    VALIDATION_LOG << "Could not record secondary command buffers.";
+    return false;
+  }
+
+  auto cmd_buffer = encoder.GetCommandBuffer();
+  cmd_buffer.beginRenderPass(pass_info,
+                             vk::SubpassContents::eSecondaryCommandBuffers);
+  fml::ScopedCleanupClosure end_render_pass(
+      [cmd_buffer]() { cmd_buffer.endRenderPass(); });
+  return encoder.ExecuteCommands(recording->encoders);
+}
+
 bool RenderPassVK::OnEncodeCommands(const Context& context) const {
   TRACE_EVENT0("impeller", "RenderPassVK::OnEncodeCommands");
   if (!IsValid()) {
@@ -622,7 +793,11 @@ bool RenderPassVK::OnEncodeCommands(const Context& context) const {
 
   auto cmd_buffer = encoder->GetCommandBuffer();
 
-  if (!UpdateBindingLayouts(commands_, cmd_buffer)) {
+  // The layout transitions of the sampled images and of the attachments are
+  // recorded with a single barrier before the render pass begins.
+  BarrierBatchVK barriers(cmd_buffer);
+
+  if (!UpdateBindingLayouts(commands_, barriers)) {
     return false;
   }
 
@@ -635,11 +810,12 @@ bool RenderPassVK::OnEncodeCommands(const Context& context) const {
 
   const auto& target_size = render_target_.GetRenderTargetSize();
 
-  auto render_pass = CreateVKRenderPass(vk_context, command_buffer);
+  auto render_pass = CreateVKRenderPass(vk_context, barriers);
   if (!render_pass) {
     VALIDATION_LOG << "Could not create renderpass.";
     return false;
   }
+  barriers.Encode();
 
   auto framebuffer = CreateVKFramebuffer(vk_context, *render_pass);
   if (!framebuffer) {
@@ -661,6 +837,18 @@ bool RenderPassVK::OnEncodeCommands(const Context& context) const {
       static_cast<uint32_t>(target_size.height);
   pass_info.setClearValues(clear_values);
 
+  // The timestamps are written outside of the render pass, which may only
+  // execute secondary command buffers.
+  encoder->BeginPassTimestamp(debug_label_);
+  fml::ScopedCleanupClosure end_timestamp(
+      [&encoder]() { encoder->EndPassTimestamp(); });
+
+  if (vk_context.AreSecondaryCommandBuffersEnabled() &&
+      commands_.size() >= kMinCommandsForSecondaryCommandBuffers) {
+    return EncodeCommandsInSecondaryCommandBuffers(
+        vk_context, commands_, *encoder, pass_info, target_size);
+  }
+
   {
     TRACE_EVENT0("impeller", "EncodeRenderPassCommands");
     cmd_buffer.beginRenderPass(pass_info, vk::SubpassContents::eInline);
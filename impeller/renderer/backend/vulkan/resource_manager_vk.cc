@@ -4,12 +4,18 @@
 
 #include "impeller/renderer/backend/vulkan/resource_manager_vk.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include "flutter/fml/thread.h"
 #include "flutter/fml/trace_event.h"
 #include "fml/logging.h"
 
 namespace impeller {
 
+// The innermost batch on the current thread, if any.
+thread_local ResourceManagerVK::ScopedBatch* tls_reclaim_batch = nullptr;
+
 std::shared_ptr<ResourceManagerVK> ResourceManagerVK::Create() {
   // It will be tempting to refactor this to create the waiter thread in the
   // static method instead of the constructor. However, that causes the
@@ -68,6 +74,12 @@ void ResourceManagerVK::Reclaim(std::unique_ptr<ResourceVK> resource) {
   if (!resource) {
     return;
   }
+  for (auto batch = tls_reclaim_batch; batch; batch = batch->previous_) {
+    if (batch->manager_.get() == this) {
+      batch->resources_.emplace_back(std::move(resource));
+      return;
+    }
+  }
   {
     std::scoped_lock lock(reclaimables_mutex_);
     reclaimables_.emplace_back(std::move(resource));
@@ -75,6 +87,36 @@ void ResourceManagerVK::Reclaim(std::unique_ptr<ResourceVK> resource) {
   reclaimables_cv_.notify_one();
 }
 
+void ResourceManagerVK::ReclaimAll(Reclaimables resources) {
+  if (resources.empty()) {
+    return;
+  }
+  {
+    std::scoped_lock lock(reclaimables_mutex_);
+    if (reclaimables_.empty()) {
+      reclaimables_ = std::move(resources);
+    } else {
+      std::move(resources.begin(), resources.end(),
+                std::back_inserter(reclaimables_));
+    }
+  }
+  reclaimables_cv_.notify_one();
+}
+
+ResourceManagerVK::ScopedBatch::ScopedBatch(
+    std::shared_ptr<ResourceManagerVK> manager)
+    : manager_(std::move(manager)), previous_(tls_reclaim_batch) {
+  tls_reclaim_batch = this;
+}
+
+ResourceManagerVK::ScopedBatch::~ScopedBatch() {
+  FML_DCHECK(tls_reclaim_batch == this);
+  tls_reclaim_batch = previous_;
+  if (manager_) {
+    manager_->ReclaimAll(std::move(resources_));
+  }
+}
+
 void ResourceManagerVK::Terminate() {
   // The thread should not be terminated more than once.
   FML_DCHECK(!should_exit_);
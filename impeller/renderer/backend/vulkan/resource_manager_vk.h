@@ -64,6 +64,33 @@ class ResourceManagerVK final
   ///             handle to a resource, which will call this method.
   void Reclaim(std::unique_ptr<ResourceVK> resource);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Batches the resources reclaimed on the current thread while
+  ///             it is alive.
+  ///
+  /// The batched resources are handed to the manager all at once when the
+  /// batch is destroyed instead of waking up the manager thread for each of
+  /// them. This is useful when many resources are released together, for
+  /// instance, once the GPU is done with a set of command buffers.
+  ///
+  /// Batches may be nested. Resources reclaimed by a different manager are not
+  /// batched.
+  class ScopedBatch final {
+   public:
+    explicit ScopedBatch(std::shared_ptr<ResourceManagerVK> manager);
+
+    ~ScopedBatch();
+
+   private:
+    friend class ResourceManagerVK;
+
+    std::shared_ptr<ResourceManagerVK> manager_;
+    std::vector<std::unique_ptr<ResourceVK>> resources_;
+    ScopedBatch* previous_ = nullptr;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(ScopedBatch);
+  };
+
   //----------------------------------------------------------------------------
   /// @brief      Destroys the resource manager.
   ///
@@ -96,6 +123,8 @@ class ResourceManagerVK final
   /// collected when the resource manager is collected.
   void Terminate();
 
+  void ReclaimAll(Reclaimables resources);
+
   FML_DISALLOW_COPY_AND_ASSIGN(ResourceManagerVK);
 };
 
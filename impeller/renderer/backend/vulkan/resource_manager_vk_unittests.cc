@@ -34,7 +34,11 @@ class DeathRattle final {
   DeathRattle(DeathRattle&&) = default;
   DeathRattle& operator=(DeathRattle&&) = default;
 
-  ~DeathRattle() { callback_(); }
+  ~DeathRattle() {
+    if (callback_) {
+      callback_();
+    }
+  }
 
  private:
   std::function<void()> callback_;
@@ -59,6 +63,24 @@ TEST(ResourceManagerVKTest, ReclaimMovesAResourceAndDestroysIt) {
   waiter.Wait();
 }
 
+TEST(ResourceManagerVKTest, ScopedBatchDefersReclamation) {
+  auto const manager = ResourceManagerVK::Create();
+
+  auto waiter = fml::AutoResetWaitableEvent();
+  {
+    ResourceManagerVK::ScopedBatch batch(manager);
+    {
+      auto resource = UniqueResourceVKT<DeathRattle>(
+          manager, DeathRattle([&waiter]() { waiter.Signal(); }));
+    }
+
+    // Held by the batch, the manager thread hasn't seen it yet.
+    EXPECT_FALSE(waiter.IsSignaledForTest());
+  }
+
+  waiter.Wait();
+}
+
 // Regression test for https://github.com/flutter/flutter/issues/134482.
 TEST(ResourceManagerVKTest, TerminatesWhenOutOfScope) {
   // Originally, this shared_ptr was never destroyed, and the thread never
@@ -68,4 +68,23 @@ std::shared_ptr<const Sampler> SamplerLibraryVK::GetSampler(
   return sampler;
 }
 
+std::shared_ptr<YUVConversionVK> SamplerLibraryVK::GetYUVConversion(
+    const YUVConversionDescriptorVK& desc) {
+  Lock lock(conversions_mutex_);
+  auto found = conversions_.find(desc);
+  if (found != conversions_.end()) {
+    return found->second;
+  }
+  auto device_holder = device_holder_.lock();
+  if (!device_holder || !device_holder->GetDevice()) {
+    return nullptr;
+  }
+  auto conversion = YUVConversionVK::Create(device_holder->GetDevice(), desc);
+  if (!conversion) {
+    return nullptr;
+  }
+  conversions_[desc] = conversion;
+  return conversion;
+}
+
 }  // namespace impeller
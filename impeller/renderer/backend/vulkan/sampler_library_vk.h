@@ -4,12 +4,16 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include "flutter/fml/macros.h"
 #include "impeller/base/backend_cast.h"
 #include "impeller/base/comparable.h"
+#include "impeller/base/thread.h"
 #include "impeller/core/sampler_descriptor.h"
 #include "impeller/renderer/backend/vulkan/device_holder.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
+#include "impeller/renderer/backend/vulkan/yuv_conversion_vk.h"
 #include "impeller/renderer/sampler_library.h"
 
 namespace impeller {
@@ -21,11 +25,35 @@ class SamplerLibraryVK final
   // |SamplerLibrary|
   ~SamplerLibraryVK() override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get the YUV conversion, and the immutable sampler performing
+  ///             it, for images with the given description. Conversions are
+  ///             created once and shared by all images of the same format, so
+  ///             that pipelines sampling them may be reused too.
+  ///
+  ///             The device must have been created with the
+  ///             `samplerYcbcrConversion` feature enabled, see
+  ///             |CapabilitiesVK::SupportsYUVConversion|.
+  ///
+  /// @param[in]  desc  The description of the conversion.
+  ///
+  /// @return     The conversion, or nullptr if it could not be created.
+  ///
+  std::shared_ptr<YUVConversionVK> GetYUVConversion(
+      const YUVConversionDescriptorVK& desc);
+
  private:
   friend class ContextVK;
 
+  using YUVConversionMap =
+      std::unordered_map<YUVConversionDescriptorVK,
+                         std::shared_ptr<YUVConversionVK>,
+                         YUVConversionDescriptorVK::Hash>;
+
   std::weak_ptr<DeviceHolder> device_holder_;
   SamplerMap samplers_;
+  Mutex conversions_mutex_;
+  YUVConversionMap conversions_ IPLR_GUARDED_BY(conversions_mutex_);
 
   explicit SamplerLibraryVK(const std::weak_ptr<DeviceHolder>& device_holder);
 
@@ -24,6 +24,17 @@ static ShaderStage ToShaderStage(BlobShaderType type) {
   FML_UNREACHABLE();
 }
 
+static bool IsMappingSPIRV(const fml::Mapping& mapping) {
+  // https://registry.khronos.org/SPIR-V/specs/1.0/SPIRV.html#Magic
+  const uint32_t kSPIRVMagic = 0x07230203;
+  if (mapping.GetSize() < sizeof(kSPIRVMagic)) {
+    return false;
+  }
+  uint32_t magic = 0u;
+  ::memcpy(&magic, mapping.GetMapping(), sizeof(magic));
+  return magic == kSPIRVMagic;
+}
+
 static std::string VKShaderNameToShaderKeyName(const std::string& name,
                                                ShaderStage stage) {
   std::stringstream stream;
@@ -58,14 +69,20 @@ ShaderLibraryVK::ShaderLibraryVK(
     : device_holder_(std::move(device_holder)) {
   TRACE_EVENT0("impeller", "CreateShaderLibrary");
   bool success = true;
+  LazyFunctionMap lazy_functions;
   auto iterator = [&](auto type,         //
                       const auto& name,  //
                       const auto& code   //
                       ) -> bool {
-    if (!RegisterFunction(name, ToShaderStage(type), code)) {
+    if (!code || !IsMappingSPIRV(*code)) {
+      VALIDATION_LOG << "Shader " << name << " is not valid SPIRV.";
       success = false;
       return false;
     }
+    const auto stage = ToShaderStage(type);
+    lazy_functions.insert_or_assign(
+        ShaderKey{VKShaderNameToShaderKeyName(name, stage), stage},
+        LazyFunction{name, code});
     return true;
   };
   for (const auto& library_data : shader_libraries_data) {
@@ -81,6 +98,8 @@ ShaderLibraryVK::ShaderLibraryVK(
     VALIDATION_LOG << "Could not create shader modules for all shader blobs.";
     return;
   }
+  WriterLock lock(functions_mutex_);
+  lazy_functions_ = std::move(lazy_functions);
   is_valid_ = true;
 }
 
@@ -94,14 +113,31 @@ bool ShaderLibraryVK::IsValid() const {
 std::shared_ptr<const ShaderFunction> ShaderLibraryVK::GetFunction(
     std::string_view name,
     ShaderStage stage) {
-  ReaderLock lock(functions_mutex_);
-
   const auto key = ShaderKey{{name.data(), name.size()}, stage};
-  auto found = functions_.find(key);
-  if (found != functions_.end()) {
+  {
+    ReaderLock lock(functions_mutex_);
+    auto found = functions_.find(key);
+    if (found != functions_.end()) {
+      return found->second;
+    }
+  }
+
+  WriterLock lock(functions_mutex_);
+  // Another thread may have created the module while the lock was released.
+  if (auto found = functions_.find(key); found != functions_.end()) {
     return found->second;
   }
-  return nullptr;
+  auto lazy = lazy_functions_.find(key);
+  if (lazy == lazy_functions_.end()) {
+    return nullptr;
+  }
+  auto function = CreateFunction(lazy->second.name, stage, lazy->second.code);
+  if (!function) {
+    return nullptr;
+  }
+  lazy_functions_.erase(lazy);
+  functions_[key] = function;
+  return function;
 }
 
 // |ShaderLibrary|
@@ -115,28 +151,35 @@ void ShaderLibraryVK::RegisterFunction(std::string name,
   }
 }
 
-static bool IsMappingSPIRV(const fml::Mapping& mapping) {
-  // https://registry.khronos.org/SPIR-V/specs/1.0/SPIRV.html#Magic
-  const uint32_t kSPIRVMagic = 0x07230203;
-  if (mapping.GetSize() < sizeof(kSPIRVMagic)) {
+bool ShaderLibraryVK::RegisterFunction(
+    const std::string& name,
+    ShaderStage stage,
+    const std::shared_ptr<fml::Mapping>& code) {
+  auto function = CreateFunction(name, stage, code);
+  if (!function) {
     return false;
   }
-  uint32_t magic = 0u;
-  ::memcpy(&magic, mapping.GetMapping(), sizeof(magic));
-  return magic == kSPIRVMagic;
+
+  WriterLock lock(functions_mutex_);
+  const auto key = ShaderKey{VKShaderNameToShaderKeyName(name, stage), stage};
+  lazy_functions_.erase(key);
+  functions_[key] = std::move(function);
+
+  return true;
 }
 
-bool ShaderLibraryVK::RegisterFunction(
+std::shared_ptr<const ShaderFunction> ShaderLibraryVK::CreateFunction(
     const std::string& name,
     ShaderStage stage,
-    const std::shared_ptr<fml::Mapping>& code) {
+    const std::shared_ptr<fml::Mapping>& code) const {
+  TRACE_EVENT0("impeller", "ShaderLibraryVK::CreateFunction");
   if (!code) {
-    return false;
+    return nullptr;
   }
 
   if (!IsMappingSPIRV(*code)) {
     VALIDATION_LOG << "Shader is not valid SPIRV.";
-    return false;
+    return nullptr;
   }
 
   vk::ShaderModuleCreateInfo shader_module_info;
@@ -147,7 +190,7 @@ bool ShaderLibraryVK::RegisterFunction(
 
   auto device_holder = device_holder_.lock();
   if (!device_holder) {
-    return false;
+    return nullptr;
   }
   FML_DCHECK(device_holder->GetDevice());
   auto module =
@@ -156,7 +199,7 @@ bool ShaderLibraryVK::RegisterFunction(
   if (module.result != vk::Result::eSuccess) {
     VALIDATION_LOG << "Could not create shader module: "
                    << vk::to_string(module.result);
-    return false;
+    return nullptr;
   }
 
   const auto key_name = VKShaderNameToShaderKeyName(name, stage);
@@ -165,16 +208,13 @@ bool ShaderLibraryVK::RegisterFunction(
   ContextVK::SetDebugName(device_holder->GetDevice(), *shader_module,
                           "Shader " + name);
 
-  WriterLock lock(functions_mutex_);
-  functions_[ShaderKey{key_name, stage}] = std::shared_ptr<ShaderFunctionVK>(
+  return std::shared_ptr<ShaderFunctionVK>(
       new ShaderFunctionVK(device_holder_,
                            library_id_,              //
                            key_name,                 //
                            stage,                    //
                            std::move(shader_module)  //
                            ));
-
-  return true;
 }
 
 // |ShaderLibrary|
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include "flutter/fml/macros.h"
 #include "impeller/base/comparable.h"
 #include "impeller/base/thread.h"
@@ -24,10 +26,25 @@ class ShaderLibraryVK final : public ShaderLibrary {
 
  private:
   friend class ContextVK;
+
+  // A shader blob from the shader libraries whose module hasn't been created
+  // yet. The code points into the library payload and isn't copied.
+  struct LazyFunction {
+    std::string name;
+    std::shared_ptr<fml::Mapping> code;
+  };
+  using LazyFunctionMap = std::unordered_map<ShaderKey,
+                                             LazyFunction,
+                                             ShaderKey::Hash,
+                                             ShaderKey::Equal>;
+
   std::weak_ptr<DeviceHolder> device_holder_;
   const UniqueID library_id_;
   mutable RWMutex functions_mutex_;
   ShaderFunctionMap functions_ IPLR_GUARDED_BY(functions_mutex_);
+  // Shader modules are only created for the blobs that are looked up, the
+  // first time a pipeline needs them.
+  LazyFunctionMap lazy_functions_ IPLR_GUARDED_BY(functions_mutex_);
   bool is_valid_ = false;
 
   ShaderLibraryVK(
@@ -48,6 +65,11 @@ class ShaderLibraryVK final : public ShaderLibrary {
                         ShaderStage stage,
                         const std::shared_ptr<fml::Mapping>& code);
 
+  std::shared_ptr<const ShaderFunction> CreateFunction(
+      const std::string& name,
+      ShaderStage stage,
+      const std::shared_ptr<fml::Mapping>& code) const;
+
   // |ShaderLibrary|
   void UnregisterFunction(std::string name, ShaderStage stage) override;
 
@@ -7,11 +7,12 @@
 #include <memory>
 
 #include "flutter/fml/macros.h"
+#include "impeller/renderer/backend/vulkan/tracked_resource_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 
 namespace impeller {
 
-class SharedObjectVK {
+class SharedObjectVK : public TrackedResourceVK {
  public:
   virtual ~SharedObjectVK() = default;
 };
@@ -57,6 +57,8 @@ class SurfaceContextVK : public Context,
   // |Context|
   void SetSyncPresentation(bool value) override;
 
+  const std::shared_ptr<ContextVK>& GetParent() const;
+
   [[nodiscard]] bool SetWindowSurface(vk::UniqueSurfaceKHR surface);
 
   std::unique_ptr<Surface> AcquireNextSurface();
@@ -79,8 +79,13 @@ SurfaceVK::SurfaceVK(const RenderTarget& target, SwapCallback swap_callback)
 
 SurfaceVK::~SurfaceVK() = default;
 
+void SurfaceVK::SetPresentationTime(
+    std::optional<fml::TimePoint> presentation_time) {
+  presentation_time_ = presentation_time;
+}
+
 bool SurfaceVK::Present() const {
-  return swap_callback_ ? swap_callback_() : false;
+  return swap_callback_ ? swap_callback_(presentation_time_) : false;
 }
 
 }  // namespace impeller
@@ -5,8 +5,10 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_point.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/swapchain_image_vk.h"
 #include "impeller/renderer/surface.h"
@@ -15,7 +17,8 @@ namespace impeller {
 
 class SurfaceVK final : public Surface {
  public:
-  using SwapCallback = std::function<bool(void)>;
+  using SwapCallback = std::function<bool(
+      const std::optional<fml::TimePoint>& presentation_time)>;
 
   static std::unique_ptr<SurfaceVK> WrapSwapchainImage(
       const std::shared_ptr<Context>& context,
@@ -25,8 +28,17 @@ class SurfaceVK final : public Surface {
   // |Surface|
   ~SurfaceVK() override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the time at which the image should be displayed. The
+  ///             swapchain passes it to the presentation engine when
+  ///             `VK_GOOGLE_display_timing` is available, and ignores it
+  ///             otherwise.
+  ///
+  void SetPresentationTime(std::optional<fml::TimePoint> presentation_time);
+
  private:
   SwapCallback swap_callback_;
+  std::optional<fml::TimePoint> presentation_time_;
 
   SurfaceVK(const RenderTarget& target, SwapCallback swap_callback);
 
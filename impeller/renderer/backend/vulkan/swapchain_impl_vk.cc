@@ -4,9 +4,11 @@
 
 #include "impeller/renderer/backend/vulkan/swapchain_impl_vk.h"
 
+#include "impeller/renderer/backend/vulkan/capabilities_vk.h"
 #include "impeller/renderer/backend/vulkan/command_buffer_vk.h"
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
 #include "impeller/renderer/backend/vulkan/formats_vk.h"
 #include "impeller/renderer/backend/vulkan/surface_vk.h"
 #include "impeller/renderer/backend/vulkan/swapchain_image_vk.h"
@@ -111,6 +113,25 @@ static std::optional<vk::CompositeAlphaFlagBitsKHR> ChooseAlphaCompositionMode(
   return std::nullopt;
 }
 
+static vk::PresentModeKHR ChoosePresentMode(
+    const std::vector<vk::PresentModeKHR>& modes,
+    bool prefer_low_latency) {
+  // FIFO is the only mode that must be supported.
+  if (!prefer_low_latency) {
+    return vk::PresentModeKHR::eFifo;
+  }
+  // Mailbox replaces the queued image instead of waiting for the vsync, and
+  // FIFO relaxed presents a late image immediately instead of holding it for
+  // another refresh.
+  for (const auto mode :
+       {vk::PresentModeKHR::eMailbox, vk::PresentModeKHR::eFifoRelaxed}) {
+    if (std::find(modes.begin(), modes.end(), mode) != modes.end()) {
+      return mode;
+    }
+  }
+  return vk::PresentModeKHR::eFifo;
+}
+
 static std::optional<vk::Queue> ChoosePresentQueue(
     const vk::PhysicalDevice& physical_device,
     const vk::Device& device,
@@ -171,6 +192,14 @@ SwapchainImplVK::SwapchainImplVK(
   }
   vk_context.SetOffscreenFormat(ToPixelFormat(format.value().format));
 
+  auto [present_modes_result, present_modes] =
+      vk_context.GetPhysicalDevice().getSurfacePresentModesKHR(*surface);
+  if (present_modes_result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not get surface present modes: "
+                   << vk::to_string(present_modes_result);
+    return;
+  }
+
   const auto composite =
       ChooseAlphaCompositionMode(caps.supportedCompositeAlpha);
   if (!composite.has_value()) {
@@ -191,7 +220,8 @@ SwapchainImplVK::SwapchainImplVK(
   swapchain_info.surface = *surface;
   swapchain_info.imageFormat = format.value().format;
   swapchain_info.imageColorSpace = format.value().colorSpace;
-  swapchain_info.presentMode = vk::PresentModeKHR::eFifo;
+  swapchain_info.presentMode = ChoosePresentMode(
+      present_modes, vk_context.PrefersLowLatencyPresentMode());
   swapchain_info.imageExtent = vk::Extent2D{
       std::clamp(caps.currentExtent.width, caps.minImageExtent.width,
                  caps.maxImageExtent.width),
@@ -284,6 +314,10 @@ SwapchainImplVK::SwapchainImplVK(
   images_ = std::move(swapchain_images);
   synchronizers_ = std::move(synchronizers);
   current_frame_ = synchronizers_.size() - 1u;
+  supports_display_timing_ =
+      CapabilitiesVK::Cast(*vk_context.GetCapabilities())
+          .HasOptionalDeviceExtension(
+              OptionalDeviceExtensionVK::kGOOGLEDisplayTiming);
   is_valid_ = true;
   transform_if_changed_discard_swapchain_ = last_transform;
 }
@@ -401,18 +435,21 @@ SwapchainImplVK::AcquireResult SwapchainImplVK::AcquireNextDrawable() {
   return AcquireResult{SurfaceVK::WrapSwapchainImage(
       context_strong,  // context
       image,           // swapchain image
-      [weak_swapchain = weak_from_this(), image, image_index]() -> bool {
+      [weak_swapchain = weak_from_this(), image, image_index](
+          const std::optional<fml::TimePoint>& presentation_time) -> bool {
         auto swapchain = weak_swapchain.lock();
         if (!swapchain) {
           return false;
         }
-        return swapchain->Present(image, image_index);
+        return swapchain->Present(image, image_index, presentation_time);
       }  // swap callback
       )};
 }
 
-bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
-                              uint32_t index) {
+bool SwapchainImplVK::Present(
+    const std::shared_ptr<SwapchainImageVK>& image,
+    uint32_t index,
+    const std::optional<fml::TimePoint>& presentation_time) {
   auto context_strong = context_.lock();
   if (!context_strong) {
     return false;
@@ -436,8 +473,12 @@ bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
     BarrierVK barrier;
     barrier.new_layout = vk::ImageLayout::ePresentSrcKHR;
     barrier.cmd_buffer = vk_final_cmd_buffer;
-    barrier.src_access = vk::AccessFlagBits::eColorAttachmentWrite;
-    barrier.src_stage = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+    // The image is either rendered to directly or, during partial repaint, the
+    // damaged region is blitted into it.
+    barrier.src_access = vk::AccessFlagBits::eColorAttachmentWrite |
+                         vk::AccessFlagBits::eTransferWrite;
+    barrier.src_stage = vk::PipelineStageFlagBits::eColorAttachmentOutput |
+                        vk::PipelineStageFlagBits::eTransfer;
     barrier.dst_access = {};
     barrier.dst_stage = vk::PipelineStageFlagBits::eBottomOfPipe;
 
@@ -450,6 +491,14 @@ bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
     }
   }
 
+  //----------------------------------------------------------------------------
+  /// Submit the passes of the frame that were collected by the fence waiter
+  /// before the final command buffer.
+  ///
+  if (!context.GetFenceWaiter()->FlushBatch()) {
+    return false;
+  }
+
   //----------------------------------------------------------------------------
   /// Signal that the presentation semaphore is ready.
   ///
@@ -470,7 +519,22 @@ bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
     }
   }
 
-  auto task = [&, index, image, current_frame = current_frame_] {
+  //----------------------------------------------------------------------------
+  /// Ask the presentation engine not to display the image before the vsync it
+  /// was produced for. Images that finish early would otherwise be shown a
+  /// refresh too soon, and the frame after them a refresh too late.
+  ///
+  std::optional<vk::PresentTimeGOOGLE> present_time;
+  if (supports_display_timing_ && presentation_time.has_value()) {
+    present_time = vk::PresentTimeGOOGLE{
+        ++last_present_id_,  // present id
+        static_cast<uint64_t>(
+            presentation_time->ToEpochDelta().ToNanoseconds())  // desired time
+    };
+  }
+
+  auto task = [&, index, image, present_time,
+               current_frame = current_frame_] {
     auto context_strong = context_.lock();
     if (!context_strong) {
       return;
@@ -488,6 +552,12 @@ bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
     present_info.setImageIndices(indices);
     present_info.setWaitSemaphores(*sync->present_ready);
 
+    vk::PresentTimesInfoGOOGLE present_times_info;
+    if (present_time.has_value()) {
+      present_times_info.setTimes(*present_time);
+      present_info.setPNext(&present_times_info);
+    }
+
     switch (auto result = present_queue_.presentKHR(present_info)) {
       case vk::Result::eErrorOutOfDateKHR:
         // Caller will recreate the impl on acquisition, not submission.
@@ -5,9 +5,11 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <variant>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_point.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 #include "vulkan/vulkan_enums.hpp"
 
@@ -69,6 +71,8 @@ class SwapchainImplVK final
   std::vector<std::shared_ptr<SwapchainImageVK>> images_;
   std::vector<std::unique_ptr<FrameSynchronizer>> synchronizers_;
   size_t current_frame_ = 0u;
+  bool supports_display_timing_ = false;
+  uint32_t last_present_id_ = 0u;
   bool is_valid_ = false;
   size_t current_transform_poll_count_ = 0u;
   vk::SurfaceTransformFlagBitsKHR transform_if_changed_discard_swapchain_;
@@ -78,7 +82,9 @@ class SwapchainImplVK final
                   vk::SwapchainKHR old_swapchain,
                   vk::SurfaceTransformFlagBitsKHR last_transform);
 
-  bool Present(const std::shared_ptr<SwapchainImageVK>& image, uint32_t index);
+  bool Present(const std::shared_ptr<SwapchainImageVK>& image,
+               uint32_t index,
+               const std::optional<fml::TimePoint>& presentation_time);
 
   void WaitIdle() const;
 
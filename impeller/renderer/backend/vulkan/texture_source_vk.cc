@@ -14,6 +14,10 @@ const TextureDescriptor& TextureSourceVK::GetTextureDescriptor() const {
   return desc_;
 }
 
+std::shared_ptr<YUVConversionVK> TextureSourceVK::GetYUVConversion() const {
+  return nullptr;
+}
+
 vk::ImageLayout TextureSourceVK::GetLayout() const {
   ReaderLock lock(layout_mutex_);
   return layout_;
@@ -27,10 +31,11 @@ vk::ImageLayout TextureSourceVK::SetLayoutWithoutEncoding(
   return old_layout;
 }
 
-fml::Status TextureSourceVK::SetLayout(const BarrierVK& barrier) const {
+std::optional<vk::ImageMemoryBarrier> TextureSourceVK::TransitionLayout(
+    const BarrierVK& barrier) const {
   const auto old_layout = SetLayoutWithoutEncoding(barrier.new_layout);
   if (barrier.new_layout == old_layout) {
-    return {};
+    return std::nullopt;
   }
 
   vk::ImageMemoryBarrier image_barrier;
@@ -46,16 +51,33 @@ fml::Status TextureSourceVK::SetLayout(const BarrierVK& barrier) const {
   image_barrier.subresourceRange.levelCount = desc_.mip_count;
   image_barrier.subresourceRange.baseArrayLayer = 0u;
   image_barrier.subresourceRange.layerCount = ToArrayLayerCount(desc_.type);
+  return image_barrier;
+}
+
+fml::Status TextureSourceVK::SetLayout(const BarrierVK& barrier) const {
+  const auto transition = TransitionLayout(barrier);
+  if (!transition.has_value()) {
+    return {};
+  }
 
   barrier.cmd_buffer.pipelineBarrier(barrier.src_stage,  // src stage
                                      barrier.dst_stage,  // dst stage
                                      {},                 // dependency flags
                                      nullptr,            // memory barriers
                                      nullptr,            // buffer barriers
-                                     image_barrier       // image barriers
+                                     *transition         // image barriers
   );
 
   return {};
 }
 
+fml::Status TextureSourceVK::SetLayout(const BarrierVK& barrier,
+                                       BarrierBatchVK& batch) const {
+  const auto transition = TransitionLayout(barrier);
+  if (transition.has_value()) {
+    batch.Add(*transition, barrier.src_stage, barrier.dst_stage);
+  }
+  return {};
+}
+
 }  // namespace impeller
@@ -4,13 +4,17 @@
 
 #pragma once
 
+#include <optional>
+
 #include "flutter/fml/macros.h"
 #include "flutter/fml/status.h"
 #include "impeller/base/thread.h"
 #include "impeller/core/texture_descriptor.h"
 #include "impeller/renderer/backend/vulkan/barrier_vk.h"
 #include "impeller/renderer/backend/vulkan/formats_vk.h"
+#include "impeller/renderer/backend/vulkan/tracked_resource_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
+#include "impeller/renderer/backend/vulkan/yuv_conversion_vk.h"
 
 namespace impeller {
 
@@ -18,7 +22,7 @@ namespace impeller {
 ///
 /// This is intended to be used with an impeller::TextureVK. Example
 /// implementations represent swapchain images or uploaded textures.
-class TextureSourceVK {
+class TextureSourceVK : public TrackedResourceVK {
  public:
   virtual ~TextureSourceVK();
 
@@ -28,6 +32,12 @@ class TextureSourceVK {
 
   virtual vk::ImageView GetImageView() const = 0;
 
+  /// The YUV conversion the image view was created with, if any.
+  ///
+  /// Such images must be sampled with the immutable sampler of the
+  /// conversion.
+  virtual std::shared_ptr<YUVConversionVK> GetYUVConversion() const;
+
   /// Encodes the layout transition `barrier` to `barrier.cmd_buffer` for the
   /// image.
   ///
@@ -35,6 +45,10 @@ class TextureSourceVK {
   /// `barrier.new_layout`.
   fml::Status SetLayout(const BarrierVK& barrier) const;
 
+  /// Adds the layout transition `barrier` for the image to `batch` instead of
+  /// encoding it. `barrier.cmd_buffer` is ignored.
+  fml::Status SetLayout(const BarrierVK& barrier, BarrierBatchVK& batch) const;
+
   /// Store the layout of the image.
   ///
   /// This just is bookkeeping on the CPU, to actually set the layout use
@@ -56,6 +70,11 @@ class TextureSourceVK {
   explicit TextureSourceVK(TextureDescriptor desc);
 
  private:
+  // Updates the stored layout and returns the barrier for the transition, if
+  // the layout changes.
+  std::optional<vk::ImageMemoryBarrier> TransitionLayout(
+      const BarrierVK& barrier) const;
+
   mutable RWMutex layout_mutex_;
   mutable vk::ImageLayout layout_ IPLR_GUARDED_BY(layout_mutex_) =
       vk::ImageLayout::eUndefined;
@@ -132,6 +132,10 @@ vk::ImageView TextureVK::GetImageView() const {
   return source_->GetImageView();
 }
 
+std::shared_ptr<YUVConversionVK> TextureVK::GetYUVConversion() const {
+  return source_->GetYUVConversion();
+}
+
 std::shared_ptr<const TextureSourceVK> TextureVK::GetTextureSource() const {
   return source_;
 }
@@ -140,6 +144,11 @@ bool TextureVK::SetLayout(const BarrierVK& barrier) const {
   return source_ ? source_->SetLayout(barrier).ok() : false;
 }
 
+bool TextureVK::SetLayout(const BarrierVK& barrier,
+                          BarrierBatchVK& batch) const {
+  return source_ ? source_->SetLayout(barrier, batch).ok() : false;
+}
+
 vk::ImageLayout TextureVK::SetLayoutWithoutEncoding(
     vk::ImageLayout layout) const {
   return source_ ? source_->SetLayoutWithoutEncoding(layout)
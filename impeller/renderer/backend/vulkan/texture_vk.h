@@ -29,8 +29,12 @@ class TextureVK final : public Texture, public BackendCast<TextureVK, Texture> {
 
   vk::ImageView GetImageView() const;
 
+  std::shared_ptr<YUVConversionVK> GetYUVConversion() const;
+
   bool SetLayout(const BarrierVK& barrier) const;
 
+  bool SetLayout(const BarrierVK& barrier, BarrierBatchVK& batch) const;
+
   vk::ImageLayout SetLayoutWithoutEncoding(vk::ImageLayout layout) const;
 
   vk::ImageLayout GetLayout() const;
@@ -0,0 +1,56 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "flutter/fml/macros.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A resource that command buffers keep alive until the GPU is
+///             done with them.
+///
+///             The resource remembers the tracking ID of the last command
+///             buffer that retained it. When more commands in that command
+///             buffer use it, they find their own ID and skip the retain. This
+///             saves re-inserting the resource into the command buffer's
+///             tracking list and retaining it again.
+///
+class TrackedResourceVK {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Records that the command buffer with the tracking ID retains
+  ///             the resource.
+  ///
+  /// @return     Whether the command buffer still has to retain the resource.
+  ///
+  bool MarkTrackedBy(uint64_t tracking_id) const {
+    // Tracking IDs are unique per command buffer, so a command buffer can only
+    // read back its own ID after it stored that ID itself. Command buffers
+    // recorded concurrently may overwrite each other's ID. The worst that
+    // causes is a resource being retained twice, so relaxed ordering is
+    // enough.
+    if (last_tracking_id_.load(std::memory_order_relaxed) == tracking_id) {
+      return false;
+    }
+    last_tracking_id_.store(tracking_id, std::memory_order_relaxed);
+    return true;
+  }
+
+ protected:
+  TrackedResourceVK() = default;
+
+  ~TrackedResourceVK() = default;
+
+ private:
+  mutable std::atomic<uint64_t> last_tracking_id_ = 0u;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TrackedResourceVK);
+};
+
+}  // namespace impeller
@@ -0,0 +1,115 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/yuv_conversion_vk.h"
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/hash_combine.h"
+#include "impeller/base/validation.h"
+
+namespace impeller {
+
+std::size_t YUVConversionDescriptorVK::Hash::operator()(
+    const YUVConversionDescriptorVK& desc) const {
+  return fml::HashCombine(desc.format,              //
+                          desc.external_format,     //
+                          desc.model,               //
+                          desc.range,               //
+                          desc.components.r,        //
+                          desc.components.g,        //
+                          desc.components.b,        //
+                          desc.components.a,        //
+                          desc.x_chroma_offset,     //
+                          desc.y_chroma_offset,     //
+                          desc.chroma_filter        //
+  );
+}
+
+std::shared_ptr<YUVConversionVK> YUVConversionVK::Create(
+    const vk::Device& device,
+    const YUVConversionDescriptorVK& desc) {
+  vk::SamplerYcbcrConversionCreateInfo conversion_info;
+  conversion_info.format = desc.format;
+  conversion_info.ycbcrModel = desc.model;
+  conversion_info.ycbcrRange = desc.range;
+  conversion_info.components = desc.components;
+  conversion_info.xChromaOffset = desc.x_chroma_offset;
+  conversion_info.yChromaOffset = desc.y_chroma_offset;
+  conversion_info.chromaFilter = desc.chroma_filter;
+  conversion_info.forceExplicitReconstruction = false;
+
+#ifdef FML_OS_ANDROID
+  vk::ExternalFormatANDROID external_format;
+  external_format.externalFormat = desc.external_format;
+  if (desc.external_format != 0u) {
+    conversion_info.pNext = &external_format;
+  }
+#else
+  if (desc.external_format != 0u) {
+    VALIDATION_LOG << "External formats are only supported on Android.";
+    return nullptr;
+  }
+#endif  // FML_OS_ANDROID
+
+  auto conversion = device.createSamplerYcbcrConversionUnique(conversion_info);
+  if (conversion.result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not create YUV conversion: "
+                   << vk::to_string(conversion.result);
+    return nullptr;
+  }
+
+  vk::SamplerYcbcrConversionInfo sampler_conversion_info;
+  sampler_conversion_info.conversion = conversion.value.get();
+
+  // Samplers with a YUV conversion must clamp to the edge, and may only use a
+  // different filter than the chroma filter if the format supports separate
+  // reconstruction filters.
+  const auto sampler_info =
+      vk::SamplerCreateInfo()
+          .setPNext(&sampler_conversion_info)
+          .setMagFilter(desc.chroma_filter)
+          .setMinFilter(desc.chroma_filter)
+          .setAddressModeU(vk::SamplerAddressMode::eClampToEdge)
+          .setAddressModeV(vk::SamplerAddressMode::eClampToEdge)
+          .setAddressModeW(vk::SamplerAddressMode::eClampToEdge)
+          .setBorderColor(vk::BorderColor::eFloatTransparentBlack)
+          .setMipmapMode(vk::SamplerMipmapMode::eNearest);
+
+  auto sampler = device.createSamplerUnique(sampler_info);
+  if (sampler.result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not create YUV conversion sampler: "
+                   << vk::to_string(sampler.result);
+    return nullptr;
+  }
+
+  return std::shared_ptr<YUVConversionVK>(new YUVConversionVK(
+      desc, std::move(conversion.value), std::move(sampler.value)));
+}
+
+YUVConversionVK::YUVConversionVK(const YUVConversionDescriptorVK& desc,
+                                 vk::UniqueSamplerYcbcrConversion conversion,
+                                 vk::UniqueSampler sampler)
+    : desc_(desc),
+      conversion_(std::move(conversion)),
+      sampler_(std::move(sampler)) {}
+
+YUVConversionVK::~YUVConversionVK() {
+  // The sampler references the conversion.
+  sampler_.reset();
+  conversion_.reset();
+}
+
+const YUVConversionDescriptorVK& YUVConversionVK::GetDescriptor() const {
+  return desc_;
+}
+
+vk::SamplerYcbcrConversion YUVConversionVK::GetConversion() const {
+  return conversion_.get();
+}
+
+vk::Sampler YUVConversionVK::GetSampler() const {
+  return sampler_.get();
+}
+
+}  // namespace impeller
@@ -0,0 +1,85 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "impeller/renderer/backend/vulkan/vk.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Describes how the texels of a YUV image are converted to RGB by
+///             the sampler hardware.
+///
+///             Images with an Android external format set `format` to
+///             `vk::Format::eUndefined` and use `external_format` instead.
+///
+struct YUVConversionDescriptorVK {
+  vk::Format format = vk::Format::eUndefined;
+  uint64_t external_format = 0u;
+  vk::SamplerYcbcrModelConversion model =
+      vk::SamplerYcbcrModelConversion::eRgbIdentity;
+  vk::SamplerYcbcrRange range = vk::SamplerYcbcrRange::eItuFull;
+  vk::ComponentMapping components;
+  vk::ChromaLocation x_chroma_offset = vk::ChromaLocation::eCositedEven;
+  vk::ChromaLocation y_chroma_offset = vk::ChromaLocation::eCositedEven;
+  vk::Filter chroma_filter = vk::Filter::eNearest;
+
+  bool operator==(const YUVConversionDescriptorVK& other) const {
+    return format == other.format &&                    //
+           external_format == other.external_format &&  //
+           model == other.model &&                      //
+           range == other.range &&                      //
+           components == other.components &&            //
+           x_chroma_offset == other.x_chroma_offset &&  //
+           y_chroma_offset == other.y_chroma_offset &&  //
+           chroma_filter == other.chroma_filter;
+  }
+
+  struct Hash {
+    std::size_t operator()(const YUVConversionDescriptorVK& desc) const;
+  };
+};
+
+//------------------------------------------------------------------------------
+/// @brief      A sampler YCbCr conversion along with the sampler that performs
+///             it.
+///
+///             Image views of YUV images are created with the conversion and
+///             may only be sampled with the sampler here. Vulkan requires such
+///             samplers to be immutable in the descriptor set layout of the
+///             pipeline, see |PipelineVK::GetOrCreateVariant|.
+///
+///             Conversions are created and cached by the |SamplerLibraryVK|.
+///
+class YUVConversionVK final {
+ public:
+  static std::shared_ptr<YUVConversionVK> Create(
+      const vk::Device& device,
+      const YUVConversionDescriptorVK& desc);
+
+  ~YUVConversionVK();
+
+  const YUVConversionDescriptorVK& GetDescriptor() const;
+
+  vk::SamplerYcbcrConversion GetConversion() const;
+
+  vk::Sampler GetSampler() const;
+
+ private:
+  const YUVConversionDescriptorVK desc_;
+  vk::UniqueSamplerYcbcrConversion conversion_;
+  vk::UniqueSampler sampler_;
+
+  YUVConversionVK(const YUVConversionDescriptorVK& desc,
+                  vk::UniqueSamplerYcbcrConversion conversion,
+                  vk::UniqueSampler sampler);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(YUVConversionVK);
+};
+
+}  // namespace impeller
@@ -19,6 +19,7 @@ struct BlitCopyTextureToTextureCommand : public BlitCommand {
   std::shared_ptr<Texture> destination;
   IRect source_region;
   IPoint destination_origin;
+  size_t source_mip_level = 0u;
 };
 
 struct BlitCopyTextureToBufferCommand : public BlitCommand {
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "impeller/renderer/blit_pass.h"
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -73,7 +74,49 @@ bool BlitPass::AddCopy(std::shared_ptr<Texture> source,
 
   return OnCopyTextureToTextureCommand(
       std::move(source), std::move(destination), source_region.value(),
-      destination_origin, std::move(label));
+      destination_origin, /*source_mip_level=*/0u, std::move(label));
+}
+
+bool BlitPass::AddCopyFromMipLevel(std::shared_ptr<Texture> source,
+                                   size_t source_mip_level,
+                                   std::shared_ptr<Texture> destination,
+                                   std::string label) {
+  if (!source) {
+    VALIDATION_LOG << "Attempted to add a texture blit with no source.";
+    return false;
+  }
+  if (!destination) {
+    VALIDATION_LOG << "Attempted to add a texture blit with no destination.";
+    return false;
+  }
+
+  const auto& source_desc = source->GetTextureDescriptor();
+  const auto& destination_desc = destination->GetTextureDescriptor();
+  if (source_desc.sample_count != SampleCount::kCount1 ||
+      destination_desc.sample_count != SampleCount::kCount1) {
+    VALIDATION_LOG << "Mip levels of multisampled textures can't be blitted.";
+    return false;
+  }
+  if (source_mip_level >= source_desc.mip_count) {
+    VALIDATION_LOG << SPrintF(
+        "The source mip level (%zu) must be less than its mip count (%zu).",
+        source_mip_level, source_desc.mip_count);
+    return false;
+  }
+
+  const auto size = source_desc.size;
+  const auto level_size =
+      ISize(std::max<int64_t>(size.width >> source_mip_level, 1),
+            std::max<int64_t>(size.height >> source_mip_level, 1));
+  if (level_size != destination_desc.size) {
+    VALIDATION_LOG << "The destination must be the size of the source mip "
+                      "level for mip level blits.";
+    return false;
+  }
+
+  return OnCopyTextureToTextureCommand(
+      std::move(source), std::move(destination), IRect::MakeSize(level_size),
+      IPoint{}, source_mip_level, std::move(label));
 }
 
 bool BlitPass::AddCopy(std::shared_ptr<Texture> source,
@@ -125,10 +168,8 @@ bool BlitPass::AddCopy(BufferView source,
     return false;
   }
 
-  auto bytes_per_pixel =
-      BytesPerPixelForPixelFormat(destination->GetTextureDescriptor().format);
   auto bytes_per_image =
-      destination->GetTextureDescriptor().size.Area() * bytes_per_pixel;
+      destination->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
 
   if (source.range.length != bytes_per_image) {
     VALIDATION_LOG
@@ -60,6 +60,29 @@ class BlitPass {
                IPoint destination_origin = {},
                std::string label = "");
 
+  //----------------------------------------------------------------------------
+  /// @brief      Record a command to copy a mip level of one texture to the
+  ///             base mip level of another texture of the same size as that
+  ///             mip level. Together with `GenerateMipmap`, this downscales a
+  ///             texture by a power of two on the GPU.
+  ///             No work is encoded into the command buffer at this time.
+  ///
+  /// @param[in]  source            The texture to read for copying.
+  /// @param[in]  source_mip_level  The mip level of the source texture to
+  ///                               copy. It must have already been written
+  ///                               to, usually by `GenerateMipmap`.
+  /// @param[in]  destination       The texture to overwrite using the source
+  ///                               contents.
+  /// @param[in]  label             The optional debug label to give the
+  ///                               command.
+  ///
+  /// @return     If the command was valid for subsequent commitment.
+  ///
+  bool AddCopyFromMipLevel(std::shared_ptr<Texture> source,
+                           size_t source_mip_level,
+                           std::shared_ptr<Texture> destination,
+                           std::string label = "");
+
   //----------------------------------------------------------------------------
   /// @brief      Record a command to copy the contents of the buffer to
   ///             the texture.
@@ -138,6 +161,7 @@ class BlitPass {
       std::shared_ptr<Texture> destination,
       IRect source_region,
       IPoint destination_origin,
+      size_t source_mip_level,
       std::string label) = 0;
 
   virtual bool OnCopyTextureToBufferCommand(
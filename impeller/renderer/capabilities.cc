@@ -76,10 +76,28 @@ class StandardCapabilities final : public Capabilities {
     return default_depth_stencil_format_;
   }
 
+  // |Capabilities|
   bool SupportsDeviceTransientTextures() const override {
     return supports_device_transient_textures_;
   }
 
+  // |Capabilities|
+  bool SupportsCompressedPixelFormat(PixelFormat format) const override {
+    switch (format) {
+      case PixelFormat::kETC2R8G8B8UNormInt:
+      case PixelFormat::kETC2R8G8B8A8UNormInt:
+        return supports_etc2_texture_compression_;
+      case PixelFormat::kASTC4x4UNormInt:
+        return supports_astc_texture_compression_;
+      case PixelFormat::kBC1R8G8B8A8UNormInt:
+      case PixelFormat::kBC3R8G8B8A8UNormInt:
+      case PixelFormat::kBC7R8G8B8A8UNormInt:
+        return supports_bc_texture_compression_;
+      default:
+        return false;
+    }
+  }
+
  private:
   StandardCapabilities(bool supports_offscreen_msaa,
                        bool supports_ssbo,
@@ -92,6 +110,9 @@ class StandardCapabilities final : public Capabilities {
                        bool supports_read_from_resolve,
                        bool supports_decal_sampler_address_mode,
                        bool supports_device_transient_textures,
+                       bool supports_etc2_texture_compression,
+                       bool supports_astc_texture_compression,
+                       bool supports_bc_texture_compression,
                        PixelFormat default_color_format,
                        PixelFormat default_stencil_format,
                        PixelFormat default_depth_stencil_format)
@@ -108,6 +129,9 @@ class StandardCapabilities final : public Capabilities {
         supports_decal_sampler_address_mode_(
             supports_decal_sampler_address_mode),
         supports_device_transient_textures_(supports_device_transient_textures),
+        supports_etc2_texture_compression_(supports_etc2_texture_compression),
+        supports_astc_texture_compression_(supports_astc_texture_compression),
+        supports_bc_texture_compression_(supports_bc_texture_compression),
         default_color_format_(default_color_format),
         default_stencil_format_(default_stencil_format),
         default_depth_stencil_format_(default_depth_stencil_format) {}
@@ -125,6 +149,9 @@ class StandardCapabilities final : public Capabilities {
   bool supports_read_from_resolve_ = false;
   bool supports_decal_sampler_address_mode_ = false;
   bool supports_device_transient_textures_ = false;
+  bool supports_etc2_texture_compression_ = false;
+  bool supports_astc_texture_compression_ = false;
+  bool supports_bc_texture_compression_ = false;
   PixelFormat default_color_format_ = PixelFormat::kUnknown;
   PixelFormat default_stencil_format_ = PixelFormat::kUnknown;
   PixelFormat default_depth_stencil_format_ = PixelFormat::kUnknown;
@@ -217,6 +244,24 @@ CapabilitiesBuilder& CapabilitiesBuilder::SetSupportsDeviceTransientTextures(
   return *this;
 }
 
+CapabilitiesBuilder& CapabilitiesBuilder::SetSupportsETC2TextureCompression(
+    bool value) {
+  supports_etc2_texture_compression_ = value;
+  return *this;
+}
+
+CapabilitiesBuilder& CapabilitiesBuilder::SetSupportsASTCTextureCompression(
+    bool value) {
+  supports_astc_texture_compression_ = value;
+  return *this;
+}
+
+CapabilitiesBuilder& CapabilitiesBuilder::SetSupportsBCTextureCompression(
+    bool value) {
+  supports_bc_texture_compression_ = value;
+  return *this;
+}
+
 std::unique_ptr<Capabilities> CapabilitiesBuilder::Build() {
   return std::unique_ptr<StandardCapabilities>(new StandardCapabilities(  //
       supports_offscreen_msaa_,                                           //
@@ -230,6 +275,9 @@ std::unique_ptr<Capabilities> CapabilitiesBuilder::Build() {
       supports_read_from_resolve_,                                        //
       supports_decal_sampler_address_mode_,                               //
       supports_device_transient_textures_,                                //
+      supports_etc2_texture_compression_,                                 //
+      supports_astc_texture_compression_,                                 //
+      supports_bc_texture_compression_,                                   //
       default_color_format_.value_or(PixelFormat::kUnknown),              //
       default_stencil_format_.value_or(PixelFormat::kUnknown),            //
       default_depth_stencil_format_.value_or(PixelFormat::kUnknown)       //
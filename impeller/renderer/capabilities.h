@@ -87,6 +87,13 @@ class Capabilities {
   ///         This feature is especially useful for MSAA and stencils.
   virtual bool SupportsDeviceTransientTextures() const = 0;
 
+  /// @brief  Whether textures of the given block compressed `PixelFormat` may
+  ///         be created and sampled from. Always false for pixel formats that
+  ///         aren't block compressed.
+  ///
+  /// @see    `IsBlockCompressedPixelFormat`
+  virtual bool SupportsCompressedPixelFormat(PixelFormat format) const = 0;
+
   /// @brief  Returns a supported `PixelFormat` for textures that store
   ///         4-channel colors (red/green/blue/alpha).
   virtual PixelFormat GetDefaultColorFormat() const = 0;
@@ -143,6 +150,12 @@ class CapabilitiesBuilder {
 
   CapabilitiesBuilder& SetSupportsDeviceTransientTextures(bool value);
 
+  CapabilitiesBuilder& SetSupportsETC2TextureCompression(bool value);
+
+  CapabilitiesBuilder& SetSupportsASTCTextureCompression(bool value);
+
+  CapabilitiesBuilder& SetSupportsBCTextureCompression(bool value);
+
   std::unique_ptr<Capabilities> Build();
 
  private:
@@ -157,6 +170,9 @@ class CapabilitiesBuilder {
   bool supports_read_from_resolve_ = false;
   bool supports_decal_sampler_address_mode_ = false;
   bool supports_device_transient_textures_ = false;
+  bool supports_etc2_texture_compression_ = false;
+  bool supports_astc_texture_compression_ = false;
+  bool supports_bc_texture_compression_ = false;
   std::optional<PixelFormat> default_color_format_ = std::nullopt;
   std::optional<PixelFormat> default_stencil_format_ = std::nullopt;
   std::optional<PixelFormat> default_depth_stencil_format_ = std::nullopt;
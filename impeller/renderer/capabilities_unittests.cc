@@ -30,6 +30,24 @@ CAPABILITY_TEST(SupportsReadFromResolve, false);
 CAPABILITY_TEST(SupportsDecalSamplerAddressMode, false);
 CAPABILITY_TEST(SupportsDeviceTransientTextures, false);
 
+TEST(CapabilitiesTest, SupportsCompressedPixelFormat) {
+  auto defaults = CapabilitiesBuilder().Build();
+  ASSERT_FALSE(
+      defaults->SupportsCompressedPixelFormat(PixelFormat::kASTC4x4UNormInt));
+  auto mutated = CapabilitiesBuilder()
+                     .SetSupportsETC2TextureCompression(true)
+                     .SetSupportsBCTextureCompression(true)
+                     .Build();
+  ASSERT_TRUE(mutated->SupportsCompressedPixelFormat(
+      PixelFormat::kETC2R8G8B8A8UNormInt));
+  ASSERT_TRUE(mutated->SupportsCompressedPixelFormat(
+      PixelFormat::kBC7R8G8B8A8UNormInt));
+  ASSERT_FALSE(
+      mutated->SupportsCompressedPixelFormat(PixelFormat::kASTC4x4UNormInt));
+  ASSERT_FALSE(
+      mutated->SupportsCompressedPixelFormat(PixelFormat::kR8G8B8A8UNormInt));
+}
+
 TEST(CapabilitiesTest, DefaultColorFormat) {
   auto defaults = CapabilitiesBuilder().Build();
   ASSERT_EQ(defaults->GetDefaultColorFormat(), PixelFormat::kUnknown);
@@ -12,6 +12,8 @@
 #include "impeller/core/formats.h"
 #include "impeller/core/host_buffer.h"
 #include "impeller/renderer/capabilities.h"
+#include "impeller/renderer/frame_capture.h"
+#include "impeller/renderer/gpu_tracer.h"
 #include "impeller/renderer/pool.h"
 
 namespace impeller {
@@ -174,6 +176,20 @@ class Context {
   /// @brief Accessor for a pool of HostBuffers.
   Pool<HostBuffer>& GetHostBufferPool() const { return host_buffer_pool_; }
 
+  //----------------------------------------------------------------------------
+  /// @brief      The tracer of the GPU time of the command buffers of this
+  ///             context. It is only supported by backends that can measure
+  ///             GPU time.
+  ///
+  const std::shared_ptr<GPUTracer>& GetGPUTracer() const { return gpu_tracer_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      The recorder of the render passes encoded with this context.
+  ///
+  const std::shared_ptr<FrameCapture>& GetFrameCapture() const {
+    return frame_capture_;
+  }
+
   CaptureContext capture;
 
  protected:
@@ -181,6 +197,9 @@ class Context {
 
  private:
   mutable Pool<HostBuffer> host_buffer_pool_ = Pool<HostBuffer>(1'000'000);
+  const std::shared_ptr<GPUTracer> gpu_tracer_ = std::make_shared<GPUTracer>();
+  const std::shared_ptr<FrameCapture> frame_capture_ =
+      std::make_shared<FrameCapture>();
 
   FML_DISALLOW_COPY_AND_ASSIGN(Context);
 };
@@ -0,0 +1,523 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/frame_capture.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "impeller/base/validation.h"
+#include "impeller/core/allocator.h"
+#include "impeller/core/device_buffer.h"
+#include "impeller/renderer/context.h"
+#include "impeller/renderer/frame_capture_flatbuffers.h"
+#include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/shader_function.h"
+#include "impeller/renderer/vertex_descriptor.h"
+
+namespace impeller {
+
+namespace {
+
+// The start of the recorded range of a buffer is aligned so that the offsets
+// of the views into the range keep the alignment they had in the buffer.
+constexpr size_t kBufferRangeAlignment = 256u;
+
+template <class T>
+auto ToRaw(T value) {
+  return static_cast<std::underlying_type_t<T>>(value);
+}
+
+// The range of a buffer bound by the commands of a pass.
+struct BufferRange {
+  size_t begin = 0u;
+  size_t end = 0u;
+  int32_t index = -1;
+};
+
+void ForEachBufferView(const Bindings& bindings,
+                       const std::function<void(const BufferView&)>& visit) {
+  for (const auto& [_, buffer] : bindings.buffers) {
+    visit(buffer.view.resource);
+  }
+  if (bindings.vertex_buffer.view.resource) {
+    visit(bindings.vertex_buffer.view.resource);
+  }
+}
+
+void ForEachBufferView(const Command& command,
+                       const std::function<void(const BufferView&)>& visit) {
+  ForEachBufferView(command.vertex_bindings, visit);
+  ForEachBufferView(command.fragment_bindings, visit);
+  if (command.index_buffer) {
+    visit(command.index_buffer);
+  }
+}
+
+bool IsEqual(const fb::capture::ShaderMetadataT& recorded,
+             const ShaderMetadata& metadata) {
+  if (recorded.name != metadata.name ||
+      recorded.members.size() != metadata.members.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < metadata.members.size(); i++) {
+    const auto& a = *recorded.members[i];
+    const auto& b = metadata.members[i];
+    if (a.type != ToRaw(b.type) || a.name != b.name || a.offset != b.offset ||
+        a.size != b.size || a.byte_length != b.byte_length ||
+        a.has_array_elements != b.array_elements.has_value() ||
+        a.array_elements != b.array_elements.value_or(0u)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::unique_ptr<fb::capture::UniformSlotT> ToUniformSlot(
+    const ShaderUniformSlot& slot) {
+  auto result = std::make_unique<fb::capture::UniformSlotT>();
+  result->name = slot.name ? slot.name : "";
+  result->ext_res_0 = slot.ext_res_0;
+  result->set = slot.set;
+  result->binding = slot.binding;
+  return result;
+}
+
+std::unique_ptr<fb::capture::SamplerT> ToSampler(const Sampler* sampler) {
+  auto result = std::make_unique<fb::capture::SamplerT>();
+  const SamplerDescriptor desc =
+      sampler ? sampler->GetDescriptor() : SamplerDescriptor{};
+  result->label = desc.label;
+  result->min_filter = ToRaw(desc.min_filter);
+  result->mag_filter = ToRaw(desc.mag_filter);
+  result->mip_filter = ToRaw(desc.mip_filter);
+  result->width_address_mode = ToRaw(desc.width_address_mode);
+  result->height_address_mode = ToRaw(desc.height_address_mode);
+  result->depth_address_mode = ToRaw(desc.depth_address_mode);
+  return result;
+}
+
+}  // namespace
+
+struct FrameCapture::Recording {
+  fb::capture::FrameCaptureT capture;
+
+  // Recorded objects are retained until the recording is finished so that
+  // their addresses identify them.
+  std::unordered_map<const Texture*, int32_t> texture_indices;
+  std::vector<std::shared_ptr<const Texture>> textures;
+  std::unordered_map<const Pipeline<PipelineDescriptor>*, uint32_t>
+      pipeline_indices;
+  std::vector<std::shared_ptr<Pipeline<PipelineDescriptor>>> pipelines;
+
+  // The indices of the recorded shader metadata by their names, and of the
+  // recorded buffers by the hash of their contents.
+  std::unordered_multimap<std::string, int32_t> shader_metadata_indices;
+  std::unordered_multimap<size_t, int32_t> buffer_indices;
+
+  int32_t RecordTexture(const std::shared_ptr<const Texture>& texture) {
+    if (!texture) {
+      return -1;
+    }
+    auto found = texture_indices.find(texture.get());
+    if (found != texture_indices.end()) {
+      return found->second;
+    }
+    const auto& desc = texture->GetTextureDescriptor();
+    auto result = std::make_unique<fb::capture::TextureT>();
+    result->storage_mode = ToRaw(desc.storage_mode);
+    result->type = ToRaw(desc.type);
+    result->format = ToRaw(desc.format);
+    result->width = desc.size.width;
+    result->height = desc.size.height;
+    result->mip_count = desc.mip_count;
+    result->usage = desc.usage;
+    result->sample_count = ToRaw(desc.sample_count);
+    result->compression_type = ToRaw(desc.compression_type);
+
+    const auto index = static_cast<int32_t>(capture.textures.size());
+    capture.textures.emplace_back(std::move(result));
+    textures.push_back(texture);
+    texture_indices[texture.get()] = index;
+    return index;
+  }
+
+  int32_t RecordShaderMetadata(const ShaderMetadata* metadata) {
+    if (!metadata) {
+      return -1;
+    }
+    auto [begin, end] = shader_metadata_indices.equal_range(metadata->name);
+    for (auto it = begin; it != end; ++it) {
+      if (IsEqual(*capture.shader_metadata[it->second], *metadata)) {
+        return it->second;
+      }
+    }
+    auto result = std::make_unique<fb::capture::ShaderMetadataT>();
+    result->name = metadata->name;
+    for (const auto& member : metadata->members) {
+      auto recorded = std::make_unique<fb::capture::ShaderStructMemberT>();
+      recorded->type = ToRaw(member.type);
+      recorded->name = member.name;
+      recorded->offset = member.offset;
+      recorded->size = member.size;
+      recorded->byte_length = member.byte_length;
+      recorded->has_array_elements = member.array_elements.has_value();
+      recorded->array_elements = member.array_elements.value_or(0u);
+      result->members.emplace_back(std::move(recorded));
+    }
+
+    const auto index = static_cast<int32_t>(capture.shader_metadata.size());
+    capture.shader_metadata.emplace_back(std::move(result));
+    shader_metadata_indices.emplace(metadata->name, index);
+    return index;
+  }
+
+  int32_t RecordBuffer(const uint8_t* contents, size_t length) {
+    const auto hash =
+        contents ? std::hash<std::string_view>{}(std::string_view(
+                       reinterpret_cast<const char*>(contents), length))
+                 : 0u;
+    auto [begin, end] = buffer_indices.equal_range(hash);
+    for (auto it = begin; it != end; ++it) {
+      const auto& recorded = *capture.buffers[it->second];
+      if (recorded.length != length) {
+        continue;
+      }
+      if (!contents && recorded.contents.empty()) {
+        return it->second;
+      }
+      if (contents && recorded.contents.size() == length &&
+          std::memcmp(recorded.contents.data(), contents, length) == 0) {
+        return it->second;
+      }
+    }
+    auto result = std::make_unique<fb::capture::BufferT>();
+    result->length = length;
+    if (contents) {
+      result->contents.assign(contents, contents + length);
+    }
+
+    const auto index = static_cast<int32_t>(capture.buffers.size());
+    capture.buffers.emplace_back(std::move(result));
+    buffer_indices.emplace(hash, index);
+    return index;
+  }
+
+  uint32_t RecordPipeline(
+      const std::shared_ptr<Pipeline<PipelineDescriptor>>& pipeline) {
+    auto found = pipeline_indices.find(pipeline.get());
+    if (found != pipeline_indices.end()) {
+      return found->second;
+    }
+    const auto& desc = pipeline->GetDescriptor();
+    auto result = std::make_unique<fb::capture::PipelineT>();
+    result->label = desc.GetLabel();
+    result->sample_count = ToRaw(desc.GetSampleCount());
+    result->winding_order = ToRaw(desc.GetWindingOrder());
+    result->cull_mode = ToRaw(desc.GetCullMode());
+    result->primitive_type = ToRaw(desc.GetPrimitiveType());
+    result->polygon_mode = ToRaw(desc.GetPolygonMode());
+    for (const auto& [stage, function] : desc.GetStageEntrypoints()) {
+      if (!function) {
+        continue;
+      }
+      auto entrypoint = std::make_unique<fb::capture::StageEntrypointT>();
+      entrypoint->stage = ToRaw(stage);
+      entrypoint->name = function->GetName();
+      result->entrypoints.emplace_back(std::move(entrypoint));
+    }
+    for (const auto& [index, color] : desc.GetColorAttachmentDescriptors()) {
+      auto attachment =
+          std::make_unique<fb::capture::ColorAttachmentDescriptorT>();
+      attachment->index = index;
+      attachment->format = ToRaw(color.format);
+      attachment->blending_enabled = color.blending_enabled;
+      attachment->src_color_blend_factor = ToRaw(color.src_color_blend_factor);
+      attachment->color_blend_op = ToRaw(color.color_blend_op);
+      attachment->dst_color_blend_factor = ToRaw(color.dst_color_blend_factor);
+      attachment->src_alpha_blend_factor = ToRaw(color.src_alpha_blend_factor);
+      attachment->alpha_blend_op = ToRaw(color.alpha_blend_op);
+      attachment->dst_alpha_blend_factor = ToRaw(color.dst_alpha_blend_factor);
+      attachment->write_mask = color.write_mask;
+      result->color_attachments.emplace_back(std::move(attachment));
+    }
+    if (auto depth = desc.GetDepthStencilAttachmentDescriptor();
+        depth.has_value()) {
+      result->depth_attachment =
+          std::make_unique<fb::capture::DepthAttachmentDescriptorT>();
+      result->depth_attachment->depth_compare = ToRaw(depth->depth_compare);
+      result->depth_attachment->depth_write_enabled =
+          depth->depth_write_enabled;
+    }
+    auto to_stencil = [](const StencilAttachmentDescriptor& stencil) {
+      auto result =
+          std::make_unique<fb::capture::StencilAttachmentDescriptorT>();
+      result->stencil_compare = ToRaw(stencil.stencil_compare);
+      result->stencil_failure = ToRaw(stencil.stencil_failure);
+      result->depth_failure = ToRaw(stencil.depth_failure);
+      result->depth_stencil_pass = ToRaw(stencil.depth_stencil_pass);
+      result->read_mask = stencil.read_mask;
+      result->write_mask = stencil.write_mask;
+      return result;
+    };
+    if (auto front = desc.GetFrontStencilAttachmentDescriptor();
+        front.has_value()) {
+      result->front_stencil_attachment = to_stencil(front.value());
+    }
+    if (auto back = desc.GetBackStencilAttachmentDescriptor();
+        back.has_value()) {
+      result->back_stencil_attachment = to_stencil(back.value());
+    }
+    result->depth_pixel_format = ToRaw(desc.GetDepthPixelFormat());
+    result->stencil_pixel_format = ToRaw(desc.GetStencilPixelFormat());
+    if (const auto& vertex_descriptor = desc.GetVertexDescriptor()) {
+      for (const auto& input : vertex_descriptor->GetStageInputs()) {
+        auto recorded = std::make_unique<fb::capture::StageInputT>();
+        recorded->name = input.name ? input.name : "";
+        recorded->location = input.location;
+        recorded->set = input.set;
+        recorded->binding = input.binding;
+        recorded->type = ToRaw(input.type);
+        recorded->bit_width = input.bit_width;
+        recorded->vec_size = input.vec_size;
+        recorded->columns = input.columns;
+        recorded->offset = input.offset;
+        result->stage_inputs.emplace_back(std::move(recorded));
+      }
+      for (const auto& layout : vertex_descriptor->GetStageLayouts()) {
+        auto recorded = std::make_unique<fb::capture::StageLayoutT>();
+        recorded->stride = layout.stride;
+        recorded->binding = layout.binding;
+        result->stage_layouts.emplace_back(std::move(recorded));
+      }
+      for (const auto& layout : vertex_descriptor->GetDescriptorSetLayouts()) {
+        auto recorded = std::make_unique<fb::capture::DescriptorSetLayoutT>();
+        recorded->binding = layout.binding;
+        recorded->descriptor_type = ToRaw(layout.descriptor_type);
+        recorded->shader_stage = ToRaw(layout.shader_stage);
+        result->descriptor_set_layouts.emplace_back(std::move(recorded));
+      }
+    }
+
+    const auto index = static_cast<uint32_t>(capture.pipelines.size());
+    capture.pipelines.emplace_back(std::move(result));
+    pipelines.push_back(pipeline);
+    pipeline_indices[pipeline.get()] = index;
+    return index;
+  }
+
+  std::unique_ptr<fb::capture::AttachmentT> RecordAttachment(
+      size_t index,
+      const Attachment& attachment) {
+    auto result = std::make_unique<fb::capture::AttachmentT>();
+    result->index = index;
+    result->texture = RecordTexture(attachment.texture);
+    result->resolve_texture = RecordTexture(attachment.resolve_texture);
+    result->load_action = ToRaw(attachment.load_action);
+    result->store_action = ToRaw(attachment.store_action);
+    return result;
+  }
+};
+
+FrameCapture::FrameCapture() = default;
+
+FrameCapture::~FrameCapture() = default;
+
+void FrameCapture::Start() {
+  Lock lock(mutex_);
+  recording_ = std::make_unique<Recording>();
+  is_recording_ = true;
+}
+
+bool FrameCapture::IsRecording() const {
+  return is_recording_;
+}
+
+void FrameCapture::RecordRenderPass(const Context& context,
+                                    const RenderPass& pass) {
+  if (!is_recording_) {
+    return;
+  }
+  Lock lock(mutex_);
+  if (!recording_) {
+    return;
+  }
+  auto& recording = *recording_;
+  auto result = std::make_unique<fb::capture::RenderPassT>();
+  result->label = pass.GetLabel();
+
+  const auto& target = pass.GetRenderTarget();
+  for (const auto& [index, color] : target.GetColorAttachments()) {
+    auto attachment = recording.RecordAttachment(index, color);
+    attachment->clear_red = color.clear_color.red;
+    attachment->clear_green = color.clear_color.green;
+    attachment->clear_blue = color.clear_color.blue;
+    attachment->clear_alpha = color.clear_color.alpha;
+    result->color_attachments.emplace_back(std::move(attachment));
+  }
+  if (const auto& depth = target.GetDepthAttachment(); depth.has_value()) {
+    result->depth_attachment = recording.RecordAttachment(0u, depth.value());
+    result->depth_attachment->clear_depth = depth->clear_depth;
+  }
+  if (const auto& stencil = target.GetStencilAttachment();
+      stencil.has_value()) {
+    result->stencil_attachment =
+        recording.RecordAttachment(0u, stencil.value());
+    result->stencil_attachment->clear_stencil = stencil->clear_stencil;
+  }
+
+  // Record the range of each buffer that is bound by the commands of the pass
+  // once, instead of once per view.
+  std::unordered_map<const Buffer*, BufferRange> ranges;
+  std::unordered_map<const Buffer*, std::shared_ptr<const DeviceBuffer>>
+      device_buffers;
+  const auto& allocator = context.GetResourceAllocator();
+  for (const auto& command : pass.GetCommands()) {
+    ForEachBufferView(command, [&](const BufferView& view) {
+      auto [found, inserted] = ranges.try_emplace(
+          view.buffer.get(),
+          BufferRange{view.range.offset,
+                      view.range.offset + view.range.length});
+      if (inserted) {
+        if (allocator) {
+          device_buffers[view.buffer.get()] =
+              view.buffer->GetDeviceBuffer(*allocator);
+        }
+        return;
+      }
+      found->second.begin = std::min(found->second.begin, view.range.offset);
+      found->second.end =
+          std::max(found->second.end, view.range.offset + view.range.length);
+    });
+  }
+  for (auto& [buffer, range] : ranges) {
+    range.begin -= range.begin % kBufferRangeAlignment;
+    const auto& device_buffer = device_buffers[buffer];
+    const uint8_t* contents =
+        device_buffer ? device_buffer->OnGetContents() : nullptr;
+    if (contents && device_buffer->GetDeviceBufferDescriptor().size <
+                        range.end) {
+      contents = nullptr;
+    }
+    range.index = recording.RecordBuffer(
+        contents ? contents + range.begin : nullptr, range.end - range.begin);
+  }
+
+  auto to_buffer_binding = [&](size_t index, const ShaderUniformSlot& slot,
+                               const BufferResource& resource) {
+    auto binding = std::make_unique<fb::capture::BufferBindingT>();
+    binding->index = index;
+    binding->slot = ToUniformSlot(slot);
+    binding->metadata = recording.RecordShaderMetadata(resource.GetMetadata());
+    const auto& view = resource.resource;
+    if (view) {
+      const auto& range = ranges[view.buffer.get()];
+      binding->buffer = range.index;
+      binding->offset = view.range.offset - range.begin;
+      binding->length = view.range.length;
+    }
+    return binding;
+  };
+  auto to_bindings = [&](const Bindings& bindings) {
+    auto result = std::make_unique<fb::capture::BindingsT>();
+    for (const auto& [index, buffer] : bindings.buffers) {
+      result->buffers.emplace_back(
+          to_buffer_binding(index, buffer.slot, buffer.view));
+    }
+    for (const auto& [index, image] : bindings.sampled_images) {
+      auto binding = std::make_unique<fb::capture::SampledImageBindingT>();
+      binding->index = index;
+      binding->name = image.slot.name ? image.slot.name : "";
+      binding->texture_index = image.slot.texture_index;
+      binding->sampler_index = image.slot.sampler_index;
+      binding->binding = image.slot.binding;
+      binding->set = image.slot.set;
+      binding->metadata =
+          recording.RecordShaderMetadata(image.texture.GetMetadata());
+      binding->texture = recording.RecordTexture(image.texture.resource);
+      binding->sampler = ToSampler(image.sampler.resource.get());
+      result->sampled_images.emplace_back(std::move(binding));
+    }
+    if (bindings.vertex_buffer.view.resource) {
+      result->vertex_buffer =
+          to_buffer_binding(0u, bindings.vertex_buffer.slot,
+                            bindings.vertex_buffer.view);
+    }
+    return result;
+  };
+
+  for (const auto& command : pass.GetCommands()) {
+    if (!command) {
+      continue;
+    }
+    auto recorded = std::make_unique<fb::capture::CommandT>();
+#ifdef IMPELLER_DEBUG
+    recorded->label = command.label;
+#endif  // IMPELLER_DEBUG
+    recorded->pipeline = recording.RecordPipeline(command.pipeline);
+    recorded->vertex_bindings = to_bindings(command.vertex_bindings);
+    recorded->fragment_bindings = to_bindings(command.fragment_bindings);
+    if (command.index_buffer) {
+      const auto& range = ranges[command.index_buffer.buffer.get()];
+      recorded->index_buffer = range.index;
+      recorded->index_buffer_offset =
+          command.index_buffer.range.offset - range.begin;
+      recorded->index_buffer_length = command.index_buffer.range.length;
+    }
+    recorded->vertex_count = command.vertex_count;
+    recorded->index_type = ToRaw(command.index_type);
+    recorded->stencil_reference = command.stencil_reference;
+    recorded->base_vertex = command.base_vertex;
+    if (command.viewport.has_value()) {
+      const auto& viewport = command.viewport.value();
+      recorded->has_viewport = true;
+      recorded->viewport_x = viewport.rect.origin.x;
+      recorded->viewport_y = viewport.rect.origin.y;
+      recorded->viewport_width = viewport.rect.size.width;
+      recorded->viewport_height = viewport.rect.size.height;
+      recorded->viewport_z_near = viewport.depth_range.z_near;
+      recorded->viewport_z_far = viewport.depth_range.z_far;
+    }
+    if (command.scissor.has_value()) {
+      const auto& scissor = command.scissor.value();
+      recorded->has_scissor = true;
+      recorded->scissor_x = scissor.origin.x;
+      recorded->scissor_y = scissor.origin.y;
+      recorded->scissor_width = scissor.size.width;
+      recorded->scissor_height = scissor.size.height;
+    }
+    recorded->instance_count = command.instance_count;
+    result->commands.emplace_back(std::move(recorded));
+  }
+
+  recording.capture.render_passes.emplace_back(std::move(result));
+}
+
+std::shared_ptr<fml::Mapping> FrameCapture::Finish(const Context& context) {
+  std::unique_ptr<Recording> recording;
+  {
+    Lock lock(mutex_);
+    recording = std::move(recording_);
+    is_recording_ = false;
+  }
+  if (!recording) {
+    return nullptr;
+  }
+  auto& capture = recording->capture;
+  capture.backend = ToRaw(context.GetBackendType());
+  capture.gpu_model = context.DescribeGpuModel();
+
+  auto builder = std::make_shared<flatbuffers::FlatBufferBuilder>();
+  builder->Finish(fb::capture::FrameCapture::Pack(*builder, &capture),
+                  fb::capture::FrameCaptureIdentifier());
+  return std::make_shared<fml::NonOwnedMapping>(
+      builder->GetBufferPointer(), builder->GetSize(),
+      [builder](auto, auto) {});
+}
+
+}  // namespace impeller
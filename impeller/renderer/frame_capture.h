@@ -0,0 +1,72 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "impeller/base/thread.h"
+
+namespace impeller {
+
+class Context;
+class RenderPass;
+
+//------------------------------------------------------------------------------
+/// @brief      Records the render passes encoded with a context into a capture
+///             file that can be replayed on any backend by |FrameReplay|.
+///
+///             The capture contains the render targets, pipelines and commands
+///             of each pass, along with the contents of the ranges of the
+///             buffers bound by the commands. Textures that are not rendered to
+///             by a captured pass are recorded by their descriptors only, as
+///             reading back their contents would stall the frame.
+///
+///             Pipelines refer to their shaders by entrypoint name. Shaders
+///             that are not part of the shader library of the replaying context
+///             (such as runtime effects) can't be replayed.
+///
+///             This class is thread-safe.
+///
+class FrameCapture {
+ public:
+  FrameCapture();
+
+  ~FrameCapture();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Start recording the render passes that are encoded from now
+  ///             on. Any recording in progress is discarded.
+  ///
+  void Start();
+
+  bool IsRecording() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Record a render pass that is about to be encoded. Does
+  ///             nothing if no recording is in progress.
+  ///
+  void RecordRenderPass(const Context& context, const RenderPass& pass);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Stop recording and serialize the recorded render passes.
+  ///
+  /// @return     The capture file, or nullptr if no recording was in progress.
+  ///
+  std::shared_ptr<fml::Mapping> Finish(const Context& context);
+
+ private:
+  struct Recording;
+
+  std::atomic_bool is_recording_ = false;
+  Mutex mutex_;
+  std::unique_ptr<Recording> recording_ IPLR_GUARDED_BY(mutex_);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameCapture);
+};
+
+}  // namespace impeller
@@ -0,0 +1,129 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/testing/testing.h"
+#include "impeller/fixtures/box_fade.frag.h"
+#include "impeller/fixtures/box_fade.vert.h"
+#include "impeller/playground/playground_test.h"
+#include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/frame_capture.h"
+#include "impeller/renderer/frame_replay.h"
+#include "impeller/renderer/pipeline_builder.h"
+#include "impeller/renderer/pipeline_library.h"
+#include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/sampler_library.h"
+#include "impeller/renderer/vertex_buffer_builder.h"
+
+namespace impeller {
+namespace testing {
+
+using FrameCaptureTest = PlaygroundTest;
+INSTANTIATE_PLAYGROUND_SUITE(FrameCaptureTest);
+
+TEST_P(FrameCaptureTest, FinishWithoutStartReturnsNothing) {
+  auto context = GetContext();
+  ASSERT_TRUE(context);
+  ASSERT_FALSE(context->GetFrameCapture()->IsRecording());
+  ASSERT_EQ(context->GetFrameCapture()->Finish(*context), nullptr);
+}
+
+TEST_P(FrameCaptureTest, CanReplayCapturedRenderPass) {
+  using VS = BoxFadeVertexShader;
+  using FS = BoxFadeFragmentShader;
+  auto context = GetContext();
+  ASSERT_TRUE(context);
+  auto pipeline_desc =
+      PipelineBuilder<VS, FS>::MakeDefaultPipelineDescriptor(*context);
+  ASSERT_TRUE(pipeline_desc.has_value());
+  pipeline_desc->SetSampleCount(SampleCount::kCount1);
+  auto pipeline =
+      context->GetPipelineLibrary()->GetPipeline(pipeline_desc).Get();
+  ASSERT_TRUE(pipeline);
+
+  VertexBufferBuilder<VS::PerVertexData> vertex_builder;
+  vertex_builder.AddVertices({
+      {{100, 100, 0.0}, {0.0, 0.0}},
+      {{800, 100, 0.0}, {1.0, 0.0}},
+      {{800, 800, 0.0}, {1.0, 1.0}},
+      {{100, 100, 0.0}, {0.0, 0.0}},
+      {{800, 800, 0.0}, {1.0, 1.0}},
+      {{100, 800, 0.0}, {0.0, 1.0}},
+  });
+  auto vertex_buffer =
+      vertex_builder.CreateVertexBuffer(*context->GetResourceAllocator());
+  ASSERT_TRUE(vertex_buffer);
+  auto boston = CreateTextureForFixture("boston.jpg");
+  ASSERT_TRUE(boston);
+  auto sampler = context->GetSamplerLibrary()->GetSampler({});
+  ASSERT_TRUE(sampler);
+
+  TextureDescriptor texture_desc;
+  texture_desc.format = pipeline_desc->GetColorAttachmentDescriptor(0u)->format;
+  texture_desc.storage_mode = StorageMode::kDevicePrivate;
+  texture_desc.size = {400, 400};
+  texture_desc.usage =
+      static_cast<TextureUsageMask>(TextureUsage::kRenderTarget);
+  ColorAttachment color0;
+  color0.load_action = LoadAction::kClear;
+  color0.store_action = StoreAction::kStore;
+  color0.clear_color = Color::Red();
+  color0.texture = context->GetResourceAllocator()->CreateTexture(texture_desc);
+  ASSERT_TRUE(color0.IsValid());
+  RenderTarget target;
+  target.SetColorAttachment(color0, 0u);
+
+  auto frame_capture = context->GetFrameCapture();
+  frame_capture->Start();
+  ASSERT_TRUE(frame_capture->IsRecording());
+
+  auto command_buffer = context->CreateCommandBuffer();
+  ASSERT_TRUE(command_buffer);
+  auto pass = command_buffer->CreateRenderPass(target);
+  ASSERT_TRUE(pass && pass->IsValid());
+  pass->SetLabel("Box Pass");
+
+  Command cmd;
+  cmd.pipeline = pipeline;
+  cmd.BindVertices(vertex_buffer);
+  FS::FrameInfo frame_info;
+  frame_info.current_time = 1.0;
+  FS::BindFrameInfo(cmd,
+                    pass->GetTransientsBuffer().EmplaceUniform(frame_info));
+  FS::BindContents1(cmd, boston, sampler);
+  FS::BindContents2(cmd, boston, sampler);
+  VS::UniformBuffer uniforms;
+  uniforms.mvp = Matrix::MakeOrthographic(ISize{1024, 768});
+  VS::BindUniformBuffer(cmd,
+                        pass->GetTransientsBuffer().EmplaceUniform(uniforms));
+  ASSERT_TRUE(pass->AddCommand(std::move(cmd)));
+  ASSERT_TRUE(pass->EncodeCommands());
+  ASSERT_TRUE(command_buffer->SubmitCommands());
+
+  auto capture = frame_capture->Finish(*context);
+  ASSERT_TRUE(capture);
+  ASSERT_FALSE(frame_capture->IsRecording());
+
+  auto replay = FrameReplay::Create(context, *capture);
+  ASSERT_TRUE(replay);
+  ASSERT_EQ(replay->GetRenderPassCount(), 1u);
+  ASSERT_EQ(replay->GetCommandCount(), 1u);
+  ASSERT_EQ(replay->GetSkippedCommandCount(), 0u);
+
+  auto timings = replay->Replay();
+  ASSERT_TRUE(timings.has_value());
+  ASSERT_EQ(timings->size(), 1u);
+  ASSERT_EQ(timings->at(0).label, "Box Pass");
+  ASSERT_EQ(timings->at(0).command_count, 1u);
+}
+
+TEST_P(FrameCaptureTest, RejectsInvalidCapture) {
+  auto context = GetContext();
+  ASSERT_TRUE(context);
+  const uint8_t data[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+  fml::NonOwnedMapping mapping(data, sizeof(data));
+  ASSERT_EQ(FrameReplay::Create(context, mapping), nullptr);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -0,0 +1,553 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/frame_replay.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/time/time_point.h"
+#include "impeller/base/validation.h"
+#include "impeller/core/allocator.h"
+#include "impeller/core/device_buffer.h"
+#include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/frame_capture_flatbuffers.h"
+#include "impeller/renderer/pipeline_library.h"
+#include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/sampler_library.h"
+#include "impeller/renderer/shader_library.h"
+#include "impeller/renderer/vertex_descriptor.h"
+
+namespace impeller {
+
+namespace {
+
+template <class T, class U>
+bool IsValidIndex(const std::vector<T>& items, U index) {
+  return index >= 0 && static_cast<size_t>(index) < items.size();
+}
+
+StencilAttachmentDescriptor ToStencilAttachmentDescriptor(
+    const fb::capture::StencilAttachmentDescriptorT& stencil) {
+  StencilAttachmentDescriptor result;
+  result.stencil_compare =
+      static_cast<CompareFunction>(stencil.stencil_compare);
+  result.stencil_failure =
+      static_cast<StencilOperation>(stencil.stencil_failure);
+  result.depth_failure = static_cast<StencilOperation>(stencil.depth_failure);
+  result.depth_stencil_pass =
+      static_cast<StencilOperation>(stencil.depth_stencil_pass);
+  result.read_mask = stencil.read_mask;
+  result.write_mask = stencil.write_mask;
+  return result;
+}
+
+SamplerDescriptor ToSamplerDescriptor(const fb::capture::SamplerT& sampler) {
+  SamplerDescriptor result;
+  result.label = sampler.label;
+  result.min_filter = static_cast<MinMagFilter>(sampler.min_filter);
+  result.mag_filter = static_cast<MinMagFilter>(sampler.mag_filter);
+  result.mip_filter = static_cast<MipFilter>(sampler.mip_filter);
+  result.width_address_mode =
+      static_cast<SamplerAddressMode>(sampler.width_address_mode);
+  result.height_address_mode =
+      static_cast<SamplerAddressMode>(sampler.height_address_mode);
+  result.depth_address_mode =
+      static_cast<SamplerAddressMode>(sampler.depth_address_mode);
+  return result;
+}
+
+}  // namespace
+
+std::unique_ptr<FrameReplay> FrameReplay::Create(
+    std::shared_ptr<Context> context,
+    const fml::Mapping& capture) {
+  if (!context || !context->IsValid()) {
+    VALIDATION_LOG << "Cannot replay a capture without a valid context.";
+    return nullptr;
+  }
+  auto replay = std::unique_ptr<FrameReplay>(new FrameReplay(context));
+  if (!replay->Load(capture)) {
+    return nullptr;
+  }
+  return replay;
+}
+
+FrameReplay::FrameReplay(std::shared_ptr<Context> context)
+    : context_(std::move(context)) {}
+
+FrameReplay::~FrameReplay() = default;
+
+size_t FrameReplay::GetRenderPassCount() const {
+  return passes_.size();
+}
+
+size_t FrameReplay::GetCommandCount() const {
+  size_t count = 0u;
+  for (const auto& pass : passes_) {
+    count += pass.commands.size();
+  }
+  return count;
+}
+
+size_t FrameReplay::GetSkippedCommandCount() const {
+  return skipped_command_count_;
+}
+
+const char* FrameReplay::InternName(const std::string& name) {
+  return names_.emplace_back(name).c_str();
+}
+
+bool FrameReplay::Load(const fml::Mapping& capture) {
+  if (capture.GetMapping() == nullptr ||
+      !fb::capture::FrameCaptureBufferHasIdentifier(capture.GetMapping())) {
+    VALIDATION_LOG << "Invalid frame capture magic.";
+    return false;
+  }
+  flatbuffers::Verifier verifier(capture.GetMapping(), capture.GetSize());
+  if (!fb::capture::VerifyFrameCaptureBuffer(verifier)) {
+    VALIDATION_LOG << "Frame capture is corrupt.";
+    return false;
+  }
+  auto recorded = fb::capture::UnPackFrameCapture(capture.GetMapping());
+  if (!recorded) {
+    return false;
+  }
+  auto& allocator = *context_->GetResourceAllocator();
+
+  std::vector<std::shared_ptr<Texture>> textures;
+  for (const auto& texture : recorded->textures) {
+    TextureDescriptor desc;
+    desc.storage_mode = static_cast<StorageMode>(texture->storage_mode);
+    if (desc.storage_mode == StorageMode::kDeviceTransient &&
+        !context_->GetCapabilities()->SupportsDeviceTransientTextures()) {
+      desc.storage_mode = StorageMode::kDevicePrivate;
+    }
+    desc.type = static_cast<TextureType>(texture->type);
+    desc.format = static_cast<PixelFormat>(texture->format);
+    desc.size = ISize(texture->width, texture->height);
+    desc.mip_count = texture->mip_count;
+    desc.usage = texture->usage;
+    desc.sample_count = static_cast<SampleCount>(texture->sample_count);
+    desc.compression_type =
+        static_cast<CompressionType>(texture->compression_type);
+    auto result = allocator.CreateTexture(desc);
+    if (!result) {
+      VALIDATION_LOG << "Could not create a texture of the frame capture.";
+      return false;
+    }
+    textures.emplace_back(std::move(result));
+  }
+
+  std::vector<std::shared_ptr<DeviceBuffer>> buffers;
+  for (const auto& buffer : recorded->buffers) {
+    // The contents of buffers the device could not read back are unknown.
+    std::vector<uint8_t> contents = buffer->contents;
+    contents.resize(std::max<size_t>(buffer->length, 1u));
+    auto result = allocator.CreateBufferWithCopy(contents.data(),
+                                                 contents.size());
+    if (!result) {
+      VALIDATION_LOG << "Could not create a buffer of the frame capture.";
+      return false;
+    }
+    buffers.emplace_back(std::move(result));
+  }
+
+  for (const auto& metadata : recorded->shader_metadata) {
+    auto result = std::make_shared<ShaderMetadata>();
+    result->name = metadata->name;
+    for (const auto& member : metadata->members) {
+      ShaderStructMemberMetadata recorded_member;
+      recorded_member.type = static_cast<ShaderType>(member->type);
+      recorded_member.name = member->name;
+      recorded_member.offset = member->offset;
+      recorded_member.size = member->size;
+      recorded_member.byte_length = member->byte_length;
+      if (member->has_array_elements) {
+        recorded_member.array_elements = member->array_elements;
+      }
+      result->members.emplace_back(std::move(recorded_member));
+    }
+    shader_metadata_.emplace_back(std::move(result));
+  }
+
+  auto& shader_library = *context_->GetShaderLibrary();
+  std::vector<std::shared_ptr<Pipeline<PipelineDescriptor>>> pipelines;
+  for (const auto& pipeline : recorded->pipelines) {
+    PipelineDescriptor desc;
+    desc.SetLabel(pipeline->label);
+    desc.SetSampleCount(static_cast<SampleCount>(pipeline->sample_count));
+    desc.SetWindingOrder(static_cast<WindingOrder>(pipeline->winding_order));
+    desc.SetCullMode(static_cast<CullMode>(pipeline->cull_mode));
+    desc.SetPrimitiveType(
+        static_cast<PrimitiveType>(pipeline->primitive_type));
+    desc.SetPolygonMode(static_cast<PolygonMode>(pipeline->polygon_mode));
+    bool has_entrypoints = !pipeline->entrypoints.empty();
+    for (const auto& entrypoint : pipeline->entrypoints) {
+      auto function = shader_library.GetFunction(
+          entrypoint->name, static_cast<ShaderStage>(entrypoint->stage));
+      if (!function) {
+        FML_LOG(ERROR) << "The shader " << entrypoint->name
+                       << " of the frame capture is not in the shader "
+                          "library.";
+        has_entrypoints = false;
+        break;
+      }
+      desc.AddStageEntrypoint(std::move(function));
+    }
+    if (!has_entrypoints) {
+      pipelines.emplace_back(nullptr);
+      continue;
+    }
+    for (const auto& color : pipeline->color_attachments) {
+      ColorAttachmentDescriptor attachment;
+      attachment.format = static_cast<PixelFormat>(color->format);
+      attachment.blending_enabled = color->blending_enabled;
+      attachment.src_color_blend_factor =
+          static_cast<BlendFactor>(color->src_color_blend_factor);
+      attachment.color_blend_op =
+          static_cast<BlendOperation>(color->color_blend_op);
+      attachment.dst_color_blend_factor =
+          static_cast<BlendFactor>(color->dst_color_blend_factor);
+      attachment.src_alpha_blend_factor =
+          static_cast<BlendFactor>(color->src_alpha_blend_factor);
+      attachment.alpha_blend_op =
+          static_cast<BlendOperation>(color->alpha_blend_op);
+      attachment.dst_alpha_blend_factor =
+          static_cast<BlendFactor>(color->dst_alpha_blend_factor);
+      attachment.write_mask = color->write_mask;
+      desc.SetColorAttachmentDescriptor(color->index, attachment);
+    }
+    if (const auto& depth = pipeline->depth_attachment) {
+      DepthAttachmentDescriptor attachment;
+      attachment.depth_compare =
+          static_cast<CompareFunction>(depth->depth_compare);
+      attachment.depth_write_enabled = depth->depth_write_enabled;
+      desc.SetDepthStencilAttachmentDescriptor(attachment);
+    }
+    std::optional<StencilAttachmentDescriptor> front_stencil;
+    std::optional<StencilAttachmentDescriptor> back_stencil;
+    if (pipeline->front_stencil_attachment) {
+      front_stencil =
+          ToStencilAttachmentDescriptor(*pipeline->front_stencil_attachment);
+    }
+    if (pipeline->back_stencil_attachment) {
+      back_stencil =
+          ToStencilAttachmentDescriptor(*pipeline->back_stencil_attachment);
+    }
+    desc.SetStencilAttachmentDescriptors(front_stencil, back_stencil);
+    desc.SetDepthPixelFormat(
+        static_cast<PixelFormat>(pipeline->depth_pixel_format));
+    desc.SetStencilPixelFormat(
+        static_cast<PixelFormat>(pipeline->stencil_pixel_format));
+
+    std::vector<ShaderStageIOSlot> inputs;
+    for (const auto& input : pipeline->stage_inputs) {
+      inputs.push_back(ShaderStageIOSlot{
+          .name = InternName(input->name),
+          .location = input->location,
+          .set = input->set,
+          .binding = input->binding,
+          .type = static_cast<ShaderType>(input->type),
+          .bit_width = input->bit_width,
+          .vec_size = input->vec_size,
+          .columns = input->columns,
+          .offset = input->offset,
+      });
+    }
+    std::vector<ShaderStageBufferLayout> layouts;
+    for (const auto& layout : pipeline->stage_layouts) {
+      layouts.push_back(ShaderStageBufferLayout{
+          .stride = layout->stride,
+          .binding = layout->binding,
+      });
+    }
+    std::vector<DescriptorSetLayout> set_layouts;
+    for (const auto& layout : pipeline->descriptor_set_layouts) {
+      set_layouts.push_back(DescriptorSetLayout{
+          .binding = layout->binding,
+          .descriptor_type =
+              static_cast<DescriptorType>(layout->descriptor_type),
+          .shader_stage = static_cast<ShaderStage>(layout->shader_stage),
+      });
+    }
+    std::vector<const ShaderStageIOSlot*> input_pointers;
+    for (const auto& input : inputs) {
+      input_pointers.push_back(&input);
+    }
+    std::vector<const ShaderStageBufferLayout*> layout_pointers;
+    for (const auto& layout : layouts) {
+      layout_pointers.push_back(&layout);
+    }
+    auto vertex_descriptor = std::make_shared<VertexDescriptor>();
+    vertex_descriptor->SetStageInputs(input_pointers.data(),
+                                      input_pointers.size(),
+                                      layout_pointers.data(),
+                                      layout_pointers.size());
+    vertex_descriptor->RegisterDescriptorSetLayouts(set_layouts.data(),
+                                                    set_layouts.size());
+    desc.SetVertexDescriptor(std::move(vertex_descriptor));
+
+    auto result = context_->GetPipelineLibrary()->GetPipeline(desc).Get();
+    if (!result || !result->IsValid()) {
+      FML_LOG(ERROR) << "Could not create the pipeline " << pipeline->label
+                     << " of the frame capture.";
+      result = nullptr;
+    }
+    pipelines.emplace_back(std::move(result));
+  }
+
+  auto& sampler_library = *context_->GetSamplerLibrary();
+  auto to_buffer_view = [&](int32_t buffer, uint64_t offset,
+                            uint64_t length) -> std::optional<BufferView> {
+    if (!IsValidIndex(buffers, buffer) ||
+        offset + length > recorded->buffers[buffer]->length) {
+      return std::nullopt;
+    }
+    return BufferView{
+        .buffer = buffers[buffer],
+        .contents = nullptr,
+        .range = Range(offset, length),
+    };
+  };
+  auto to_buffer_binding = [&](const fb::capture::BufferBindingT& binding)
+      -> std::optional<BufferAndUniformSlot> {
+    auto view = to_buffer_view(binding.buffer, binding.offset, binding.length);
+    if (!view.has_value()) {
+      return std::nullopt;
+    }
+    ShaderUniformSlot slot = {};
+    if (const auto& recorded_slot = binding.slot) {
+      slot.name = InternName(recorded_slot->name);
+      slot.ext_res_0 = recorded_slot->ext_res_0;
+      slot.set = recorded_slot->set;
+      slot.binding = recorded_slot->binding;
+    }
+    if (IsValidIndex(shader_metadata_, binding.metadata)) {
+      return BufferAndUniformSlot{
+          .slot = slot,
+          .view = BufferResource(shader_metadata_[binding.metadata],
+                                 view.value()),
+      };
+    }
+    return BufferAndUniformSlot{
+        .slot = slot,
+        .view = BufferResource(nullptr, view.value()),
+    };
+  };
+  auto to_bindings = [&](const std::unique_ptr<fb::capture::BindingsT>&
+                             recorded_bindings,
+                         Bindings& bindings) {
+    if (!recorded_bindings) {
+      return true;
+    }
+    for (const auto& buffer : recorded_bindings->buffers) {
+      auto binding = to_buffer_binding(*buffer);
+      if (!binding.has_value()) {
+        return false;
+      }
+      bindings.buffers[buffer->index] = std::move(binding.value());
+    }
+    for (const auto& image : recorded_bindings->sampled_images) {
+      if (!IsValidIndex(textures, image->texture) || !image->sampler) {
+        return false;
+      }
+      auto sampler =
+          sampler_library.GetSampler(ToSamplerDescriptor(*image->sampler));
+      if (!sampler) {
+        return false;
+      }
+      const SampledImageSlot slot = {
+          .name = InternName(image->name),
+          .texture_index = image->texture_index,
+          .sampler_index = image->sampler_index,
+          .binding = image->binding,
+          .set = image->set,
+      };
+      std::shared_ptr<const Texture> texture = textures[image->texture];
+      if (IsValidIndex(shader_metadata_, image->metadata)) {
+        auto& metadata = shader_metadata_[image->metadata];
+        bindings.sampled_images[image->index] = TextureAndSampler{
+            .slot = slot,
+            .texture = TextureResource(metadata, std::move(texture)),
+            .sampler = SamplerResource(metadata, std::move(sampler)),
+        };
+      } else {
+        bindings.sampled_images[image->index] = TextureAndSampler{
+            .slot = slot,
+            .texture = TextureResource(nullptr, std::move(texture)),
+            .sampler = SamplerResource(nullptr, std::move(sampler)),
+        };
+      }
+    }
+    if (const auto& vertex_buffer = recorded_bindings->vertex_buffer) {
+      auto binding = to_buffer_binding(*vertex_buffer);
+      if (!binding.has_value()) {
+        return false;
+      }
+      bindings.vertex_buffer = std::move(binding.value());
+    }
+    return true;
+  };
+  auto get_texture = [&](int32_t index) -> std::shared_ptr<Texture> {
+    return IsValidIndex(textures, index) ? textures[index] : nullptr;
+  };
+  auto to_attachment = [&](const fb::capture::AttachmentT& recorded_attachment,
+                           Attachment& attachment) {
+    attachment.texture = get_texture(recorded_attachment.texture);
+    attachment.resolve_texture =
+        get_texture(recorded_attachment.resolve_texture);
+    attachment.load_action =
+        static_cast<LoadAction>(recorded_attachment.load_action);
+    attachment.store_action =
+        static_cast<StoreAction>(recorded_attachment.store_action);
+  };
+
+  for (const auto& recorded_pass : recorded->render_passes) {
+    Pass pass;
+    pass.label = recorded_pass->label;
+    for (const auto& recorded_color : recorded_pass->color_attachments) {
+      ColorAttachment color;
+      to_attachment(*recorded_color, color);
+      color.clear_color =
+          Color(recorded_color->clear_red, recorded_color->clear_green,
+                recorded_color->clear_blue, recorded_color->clear_alpha);
+      pass.target.SetColorAttachment(color, recorded_color->index);
+    }
+    if (const auto& recorded_depth = recorded_pass->depth_attachment) {
+      DepthAttachment depth;
+      to_attachment(*recorded_depth, depth);
+      depth.clear_depth = recorded_depth->clear_depth;
+      pass.target.SetDepthAttachment(depth);
+    }
+    if (const auto& recorded_stencil = recorded_pass->stencil_attachment) {
+      StencilAttachment stencil;
+      to_attachment(*recorded_stencil, stencil);
+      stencil.clear_stencil = recorded_stencil->clear_stencil;
+      pass.target.SetStencilAttachment(stencil);
+    }
+    if (!pass.target.IsValid()) {
+      VALIDATION_LOG << "The render target of the captured pass "
+                     << pass.label << " is invalid.";
+      return false;
+    }
+
+    for (const auto& recorded_command : recorded_pass->commands) {
+      if (!IsValidIndex(pipelines, recorded_command->pipeline) ||
+          !pipelines[recorded_command->pipeline]) {
+        skipped_command_count_++;
+        continue;
+      }
+      Command command;
+#ifdef IMPELLER_DEBUG
+      command.label = recorded_command->label;
+#endif  // IMPELLER_DEBUG
+      command.pipeline = pipelines[recorded_command->pipeline];
+      if (!to_bindings(recorded_command->vertex_bindings,
+                       command.vertex_bindings) ||
+          !to_bindings(recorded_command->fragment_bindings,
+                       command.fragment_bindings)) {
+        VALIDATION_LOG << "The bindings of a command of the captured pass "
+                       << pass.label << " are invalid.";
+        return false;
+      }
+      if (recorded_command->index_buffer >= 0) {
+        auto index_buffer =
+            to_buffer_view(recorded_command->index_buffer,
+                           recorded_command->index_buffer_offset,
+                           recorded_command->index_buffer_length);
+        if (!index_buffer.has_value()) {
+          VALIDATION_LOG << "The index buffer of a command of the captured "
+                            "pass "
+                         << pass.label << " is invalid.";
+          return false;
+        }
+        command.index_buffer = index_buffer.value();
+      }
+      command.vertex_count = recorded_command->vertex_count;
+      command.index_type = static_cast<IndexType>(recorded_command->index_type);
+      command.stencil_reference = recorded_command->stencil_reference;
+      command.base_vertex = recorded_command->base_vertex;
+      if (recorded_command->has_viewport) {
+        command.viewport = Viewport{
+            .rect = Rect::MakeXYWH(recorded_command->viewport_x,
+                                   recorded_command->viewport_y,
+                                   recorded_command->viewport_width,
+                                   recorded_command->viewport_height),
+            .depth_range =
+                DepthRange{
+                    .z_near = recorded_command->viewport_z_near,
+                    .z_far = recorded_command->viewport_z_far,
+                },
+        };
+      }
+      if (recorded_command->has_scissor) {
+        command.scissor = IRect::MakeXYWH(recorded_command->scissor_x,
+                                          recorded_command->scissor_y,
+                                          recorded_command->scissor_width,
+                                          recorded_command->scissor_height);
+      }
+      command.instance_count = recorded_command->instance_count;
+      pass.commands.emplace_back(std::move(command));
+    }
+    passes_.emplace_back(std::move(pass));
+  }
+  return true;
+}
+
+std::optional<std::vector<FrameReplay::PassTiming>> FrameReplay::Replay() {
+  std::vector<PassTiming> timings;
+  const auto& gpu_tracer = context_->GetGPUTracer();
+  for (const auto& pass : passes_) {
+    // Copy the commands ahead of time so that only encoding is measured.
+    std::vector<Command> commands = pass.commands;
+
+    PassTiming timing;
+    timing.label = pass.label;
+    timing.command_count = commands.size();
+
+    fml::AutoResetWaitableEvent completed;
+    fml::AutoResetWaitableEvent gpu_time_measured;
+    gpu_tracer->BeginFrame();
+    const auto encode_start = fml::TimePoint::Now();
+    auto command_buffer = context_->CreateCommandBuffer();
+    if (!command_buffer) {
+      gpu_tracer->EndFrame({});
+      return std::nullopt;
+    }
+    auto render_pass = command_buffer->CreateRenderPass(pass.target);
+    if (!render_pass) {
+      gpu_tracer->EndFrame({});
+      return std::nullopt;
+    }
+    render_pass->SetLabel(pass.label);
+    for (auto& command : commands) {
+      render_pass->AddCommand(std::move(command));
+    }
+    if (!render_pass->EncodeCommands() ||
+        !command_buffer->SubmitCommands(
+            [&completed](CommandBuffer::Status) { completed.Signal(); })) {
+      gpu_tracer->EndFrame({});
+      VALIDATION_LOG << "Could not replay the captured pass " << pass.label
+                     << ".";
+      return std::nullopt;
+    }
+    timing.encode_time = fml::TimePoint::Now() - encode_start;
+
+    const bool measures_gpu_time =
+        gpu_tracer->EndFrame([&](fml::TimeDelta gpu_time) {
+          timing.gpu_time = gpu_time;
+          gpu_time_measured.Signal();
+        });
+    completed.Wait();
+    if (measures_gpu_time) {
+      gpu_time_measured.Wait();
+    }
+    timings.emplace_back(std::move(timing));
+  }
+  return timings;
+}
+
+}  // namespace impeller
@@ -0,0 +1,96 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/time/time_delta.h"
+#include "impeller/renderer/command.h"
+#include "impeller/renderer/context.h"
+#include "impeller/renderer/render_target.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Replays the render passes recorded by |FrameCapture| with a
+///             context, which may be of a different backend than the one the
+///             capture was recorded with.
+///
+///             The resources of the capture are created once, when the replay
+///             is created, so that each replay only measures the encoding and
+///             execution of the passes.
+///
+class FrameReplay {
+ public:
+  struct PassTiming {
+    std::string label;
+    size_t command_count = 0u;
+    // The time taken to create, encode and submit the command buffer of the
+    // pass.
+    fml::TimeDelta encode_time;
+    // The time taken by the pass on the GPU, if the context can measure it.
+    std::optional<fml::TimeDelta> gpu_time;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Create a replay of a capture file.
+  ///
+  /// @return     The replay, or nullptr if the capture is invalid or its
+  ///             render targets can't be created.
+  ///
+  static std::unique_ptr<FrameReplay> Create(std::shared_ptr<Context> context,
+                                             const fml::Mapping& capture);
+
+  ~FrameReplay();
+
+  size_t GetRenderPassCount() const;
+
+  size_t GetCommandCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of commands of the capture that are not replayed
+  ///             because their pipelines can't be created with the context.
+  ///
+  size_t GetSkippedCommandCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Encode and submit each render pass of the capture in its own
+  ///             command buffer, waiting for it to complete before the next.
+  ///
+  /// @return     The timing of each pass, or std::nullopt if a pass could not
+  ///             be submitted.
+  ///
+  std::optional<std::vector<PassTiming>> Replay();
+
+ private:
+  struct Pass {
+    std::string label;
+    RenderTarget target;
+    std::vector<Command> commands;
+  };
+
+  const std::shared_ptr<Context> context_;
+  // The names referred to by the slots of the replayed commands and pipelines.
+  std::deque<std::string> names_;
+  std::vector<std::shared_ptr<const ShaderMetadata>> shader_metadata_;
+  std::vector<Pass> passes_;
+  size_t skipped_command_count_ = 0u;
+
+  explicit FrameReplay(std::shared_ptr<Context> context);
+
+  bool Load(const fml::Mapping& capture);
+
+  const char* InternName(const std::string& name);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameReplay);
+};
+
+}  // namespace impeller
@@ -0,0 +1,141 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/gpu_tracer.h"
+
+#include <utility>
+
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+GPUTracer::GPUTracer() = default;
+
+GPUTracer::~GPUTracer() = default;
+
+void GPUTracer::SetSupported(bool supported) {
+  is_supported_ = supported;
+}
+
+bool GPUTracer::IsSupported() const {
+  return is_supported_;
+}
+
+void GPUTracer::BeginFrame() {
+  if (!IsSupported()) {
+    return;
+  }
+  Lock lock(mutex_);
+  if (current_frame_ != 0) {
+    // The previous frame wasn't ended, so its GPU time isn't reported.
+    auto found = frames_.find(current_frame_);
+    if (found != frames_.end()) {
+      if (found->second.pending_command_buffers == 0) {
+        frames_.erase(found);
+      } else {
+        found->second.ended = true;
+      }
+    }
+  }
+  current_frame_ = ++last_frame_;
+  frames_[current_frame_] = {};
+}
+
+bool GPUTracer::EndFrame(FrameCallback callback) {
+  FrameCallback completed_callback;
+  fml::TimeDelta gpu_duration;
+  {
+    Lock lock(mutex_);
+    if (current_frame_ == 0) {
+      return false;
+    }
+    auto found = frames_.find(current_frame_);
+    current_frame_ = 0;
+    if (found == frames_.end()) {
+      return false;
+    }
+    auto& frame = found->second;
+    if (frame.pending_command_buffers > 0) {
+      frame.ended = true;
+      frame.callback = std::move(callback);
+      return true;
+    }
+    gpu_duration = frame.gpu_duration;
+    completed_callback = std::move(callback);
+    frames_.erase(found);
+  }
+  if (completed_callback) {
+    completed_callback(gpu_duration);
+  }
+  return true;
+}
+
+uint64_t GPUTracer::WillSubmitCommandBuffer() {
+  Lock lock(mutex_);
+  if (current_frame_ == 0) {
+    return 0;
+  }
+  frames_[current_frame_].pending_command_buffers++;
+  return current_frame_;
+}
+
+void GPUTracer::DidCompleteCommandBuffer(uint64_t submission,
+                                         const std::vector<PassTime>& passes) {
+  TracePasses(passes);
+  if (submission == 0) {
+    return;
+  }
+  FrameCallback callback;
+  fml::TimeDelta gpu_duration;
+  {
+    Lock lock(mutex_);
+    auto found = frames_.find(submission);
+    if (found == frames_.end()) {
+      return;
+    }
+    auto& frame = found->second;
+    if (!passes.empty()) {
+      frame.gpu_duration = frame.gpu_duration + passes.back().end;
+    }
+    if (--frame.pending_command_buffers > 0 || !frame.ended) {
+      return;
+    }
+    gpu_duration = frame.gpu_duration;
+    callback = std::move(frame.callback);
+    frames_.erase(found);
+  }
+  if (callback) {
+    callback(gpu_duration);
+  }
+}
+
+void GPUTracer::TracePasses(const std::vector<PassTime>& passes) const {
+  if (passes.empty() || !fml::tracing::TraceHasTimelineEventHandler()) {
+    return;
+  }
+  // GPU timestamps are not on the clock of the trace. The passes are placed
+  // so that the last of them ended just now.
+  const int64_t now = fml::tracing::TraceGetTimelineMicros();
+  if (now < 0) {
+    return;
+  }
+  const fml::TimeDelta end = passes.back().end;
+  for (const auto& pass : passes) {
+    const std::string name =
+        pass.label.empty() ? "GPU Pass" : "GPU " + pass.label;
+    fml::tracing::TraceTimelineEvent(
+        "impeller",                                 // category_group
+        name.c_str(),                               // name
+        now - (end - pass.start).ToMicroseconds(),  // timestamp_micros
+        now - (end - pass.end).ToMicroseconds(),    // identifier
+        0,                                          // flow_id_count
+        nullptr,                                    // flow_ids
+        Dart_Timeline_Event_Duration,               // type
+        {},                                         // c_names
+        {}                                          // values
+    );
+  }
+}
+
+}  // namespace impeller
@@ -0,0 +1,111 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "impeller/base/thread.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Collects the time the GPU spent on the passes of submitted
+///             command buffers.
+///
+///             Backends that can measure GPU time mark the tracer as supported
+///             and report every command buffer they submit to it once the GPU
+///             completes it. The passes of each command buffer are added to
+///             the trace, labeled by the labels of the passes.
+///
+///             The command buffers submitted between |BeginFrame| and
+///             |EndFrame| belong to that frame. Once all of them completed,
+///             the GPU time of the frame is handed to the callback given to
+///             |EndFrame|.
+///
+///             This class is thread-safe.
+///
+class GPUTracer {
+ public:
+  struct PassTime {
+    std::string label;
+    // The start and end of the pass on the GPU, relative to the start of the
+    // first pass of its command buffer.
+    fml::TimeDelta start;
+    fml::TimeDelta end;
+  };
+
+  using FrameCallback = std::function<void(fml::TimeDelta gpu_duration)>;
+
+  GPUTracer();
+
+  ~GPUTracer();
+
+  void SetSupported(bool supported);
+
+  bool IsSupported() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Starts a frame, ending the previous one without a callback if
+  ///             it wasn't ended.
+  ///
+  void BeginFrame();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Ends the current frame.
+  ///
+  /// @param[in]  callback  Invoked with the GPU time of the command buffers
+  ///                       of the frame once they have all completed. This may
+  ///                       be invoked on any thread, including this one.
+  ///
+  /// @return     Whether the callback will be invoked. It isn't if GPU time
+  ///             can't be measured or if no frame was started.
+  ///
+  bool EndFrame(FrameCallback callback);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Called by backends before a measured command buffer is
+  ///             submitted.
+  ///
+  /// @return     The identifier of the submission, to be handed to
+  ///             |DidCompleteCommandBuffer|.
+  ///
+  uint64_t WillSubmitCommandBuffer();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Called by backends once the GPU completed a command buffer,
+  ///             or once it is known that it won't, in which case |passes| is
+  ///             empty.
+  ///
+  void DidCompleteCommandBuffer(uint64_t submission,
+                                const std::vector<PassTime>& passes);
+
+ private:
+  struct Frame {
+    size_t pending_command_buffers = 0;
+    fml::TimeDelta gpu_duration;
+    bool ended = false;
+    FrameCallback callback;
+  };
+
+  std::atomic_bool is_supported_ = false;
+  mutable Mutex mutex_;
+  // The frame command buffers are currently submitted for, if any.
+  uint64_t current_frame_ IPLR_GUARDED_BY(mutex_) = 0;
+  uint64_t last_frame_ IPLR_GUARDED_BY(mutex_) = 0;
+  std::map<uint64_t, Frame> frames_ IPLR_GUARDED_BY(mutex_);
+
+  void TracePasses(const std::vector<PassTime>& passes) const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GPUTracer);
+};
+
+}  // namespace impeller
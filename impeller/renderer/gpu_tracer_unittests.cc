@@ -0,0 +1,59 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/testing/testing.h"
+#include "impeller/renderer/gpu_tracer.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+std::vector<GPUTracer::PassTime> MakePasses(int64_t duration_micros) {
+  return {{"Pass", fml::TimeDelta::Zero(),
+           fml::TimeDelta::FromMicroseconds(duration_micros)}};
+}
+
+}  // namespace
+
+TEST(GPUTracerTest, ReportsFramesOnceTheirCommandBuffersComplete) {
+  GPUTracer tracer;
+  tracer.SetSupported(true);
+
+  tracer.BeginFrame();
+  auto first = tracer.WillSubmitCommandBuffer();
+  auto second = tracer.WillSubmitCommandBuffer();
+  std::optional<fml::TimeDelta> reported;
+  ASSERT_TRUE(tracer.EndFrame(
+      [&reported](fml::TimeDelta duration) { reported = duration; }));
+
+  tracer.DidCompleteCommandBuffer(first, MakePasses(100));
+  EXPECT_FALSE(reported.has_value());
+  tracer.DidCompleteCommandBuffer(second, MakePasses(50));
+  ASSERT_TRUE(reported.has_value());
+  EXPECT_EQ(reported->ToMicroseconds(), 150);
+}
+
+TEST(GPUTracerTest, ReportsFramesWithoutCommandBuffersRightAway) {
+  GPUTracer tracer;
+  tracer.SetSupported(true);
+
+  tracer.BeginFrame();
+  std::optional<fml::TimeDelta> reported;
+  ASSERT_TRUE(tracer.EndFrame(
+      [&reported](fml::TimeDelta duration) { reported = duration; }));
+  ASSERT_TRUE(reported.has_value());
+  EXPECT_EQ(reported->ToMicroseconds(), 0);
+}
+
+TEST(GPUTracerTest, IgnoresFramesWhenUnsupported) {
+  GPUTracer tracer;
+
+  tracer.BeginFrame();
+  EXPECT_EQ(tracer.WillSubmitCommandBuffer(), 0u);
+  EXPECT_FALSE(tracer.EndFrame([](fml::TimeDelta) {}));
+}
+
+}  // namespace testing
+}  // namespace impeller
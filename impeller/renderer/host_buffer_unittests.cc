@@ -2,12 +2,67 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <vector>
+
 #include "flutter/testing/testing.h"
+#include "impeller/core/allocator.h"
+#include "impeller/core/device_buffer.h"
 #include "impeller/core/host_buffer.h"
 
 namespace impeller {
 namespace testing {
 
+class HostMemoryDeviceBuffer : public DeviceBuffer {
+ public:
+  explicit HostMemoryDeviceBuffer(const DeviceBufferDescriptor& desc)
+      : DeviceBuffer(desc), contents_(desc.size) {}
+
+  bool SetLabel(const std::string& label) override { return true; }
+
+  bool SetLabel(const std::string& label, Range range) override {
+    return true;
+  }
+
+  uint8_t* OnGetContents() const override {
+    return const_cast<uint8_t*>(contents_.data());
+  }
+
+  bool OnCopyHostBuffer(const uint8_t* source,
+                        Range source_range,
+                        size_t offset) override {
+    ::memmove(contents_.data() + offset, source + source_range.offset,
+              source_range.length);
+    return true;
+  }
+
+  void Flush(Range range) override { flushed_ranges.push_back(range); }
+
+  std::vector<Range> flushed_ranges;
+
+ private:
+  std::vector<uint8_t> contents_;
+};
+
+class HostMemoryAllocator : public Allocator {
+ public:
+  ISize GetMaxTextureSizeSupported() const override {
+    return ISize(1024, 1024);
+  }
+
+  std::shared_ptr<DeviceBuffer> OnCreateBuffer(
+      const DeviceBufferDescriptor& desc) override {
+    buffer_count++;
+    return std::make_shared<HostMemoryDeviceBuffer>(desc);
+  }
+
+  std::shared_ptr<Texture> OnCreateTexture(
+      const TextureDescriptor& desc) override {
+    return nullptr;
+  }
+
+  size_t buffer_count = 0u;
+};
+
 TEST(HostBufferTest, TestInitialization) {
   ASSERT_TRUE(HostBuffer::Create());
   // Newly allocated buffers don't touch the heap till they have to.
@@ -75,5 +130,86 @@ TEST(HostBufferTest, CanEmplaceWithAlignment) {
   }
 }
 
+TEST(HostBufferTest, EmplacesDirectlyIntoDeviceBuffers) {
+  auto allocator = std::make_shared<HostMemoryAllocator>();
+  auto buffer = HostBuffer::Create(allocator);
+  ASSERT_TRUE(buffer);
+
+  const uint32_t first = 0x01020304;
+  auto first_view = buffer->Emplace(first);
+  ASSERT_TRUE(first_view);
+  ASSERT_EQ(first_view.range, Range(0u, 4u));
+
+  struct alignas(16) Align16 {
+    uint8_t pad[16] = {7};
+  };
+  auto second_view = buffer->Emplace(Align16{});
+  ASSERT_TRUE(second_view);
+  ASSERT_EQ(second_view.range, Range(16u, 16u));
+
+  // Both views refer to the same device buffer, no copy is necessary.
+  ASSERT_EQ(allocator->buffer_count, 1u);
+  ASSERT_EQ(first_view.buffer, second_view.buffer);
+  auto device_buffer = std::static_pointer_cast<const HostMemoryDeviceBuffer>(
+      first_view.buffer);
+  ASSERT_EQ(device_buffer->GetDeviceBuffer(*allocator), device_buffer);
+  ASSERT_EQ(::memcmp(first_view.contents + first_view.range.offset, &first,
+                     sizeof(first)),
+            0);
+  ASSERT_EQ(second_view.contents[second_view.range.offset], 7u);
+  ASSERT_EQ(device_buffer->flushed_ranges.size(), 2u);
+  ASSERT_EQ(device_buffer->flushed_ranges[1], Range(16u, 16u));
+  ASSERT_EQ(buffer->GetLength(), 0u);
+}
+
+TEST(HostBufferTest, ReusesDeviceBuffersAfterAFullCycleOfResets) {
+  auto allocator = std::make_shared<HostMemoryAllocator>();
+  auto buffer = HostBuffer::Create(allocator);
+  ASSERT_TRUE(buffer);
+
+  std::vector<std::shared_ptr<const Buffer>> frame_buffers;
+  for (size_t i = 0; i < HostBuffer::kHostBufferArenaSize; i++) {
+    auto view = buffer->Emplace(uint32_t{0});
+    ASSERT_TRUE(view);
+    ASSERT_EQ(view.range.offset, 0u);
+    for (const auto& frame_buffer : frame_buffers) {
+      ASSERT_NE(frame_buffer, view.buffer);
+    }
+    frame_buffers.push_back(view.buffer);
+    buffer->Reset();
+  }
+  ASSERT_EQ(allocator->buffer_count, HostBuffer::kHostBufferArenaSize);
+
+  auto view = buffer->Emplace(uint32_t{0});
+  ASSERT_TRUE(view);
+  ASSERT_EQ(view.buffer, frame_buffers.front());
+  ASSERT_EQ(view.range.offset, 0u);
+  ASSERT_EQ(allocator->buffer_count, HostBuffer::kHostBufferArenaSize);
+}
+
+TEST(HostBufferTest, EmplacesLargeDataIntoBuffersOfItsOwn) {
+  auto allocator = std::make_shared<HostMemoryAllocator>();
+  auto buffer = HostBuffer::Create(allocator);
+  ASSERT_TRUE(buffer);
+
+  ASSERT_TRUE(buffer->Emplace(uint32_t{0}));
+  const size_t large_size = 4u * 1024u * 1024u;
+  auto view = buffer->Emplace(large_size, 0u, [](uint8_t* contents) {
+    contents[large_size - 1] = 1u;
+  });
+  ASSERT_TRUE(view);
+  ASSERT_EQ(view.range, Range(0u, large_size));
+  ASSERT_EQ(allocator->buffer_count, 2u);
+  ASSERT_EQ(buffer->GetSize(), 1024u * 1024u + large_size);
+
+  // Buffers that an arena didn't need by the time it is left are released.
+  for (size_t i = 0; i < HostBuffer::kHostBufferArenaSize; i++) {
+    buffer->Reset();
+  }
+  ASSERT_TRUE(buffer->Emplace(uint32_t{0}));
+  buffer->Reset();
+  ASSERT_EQ(buffer->GetSize(), 1024u * 1024u);
+}
+
 }  // namespace  testing
 }  // namespace impeller
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <functional>
 #include <future>
 
 #include "compute_pipeline_descriptor.h"
@@ -24,10 +25,24 @@ template <typename T>
 struct PipelineFuture {
   std::optional<T> descriptor;
   std::shared_future<std::shared_ptr<Pipeline<T>>> future;
-
-  const std::shared_ptr<Pipeline<T>> Get() const { return future.get(); }
+  // If set, creates the pipeline on the calling thread unless the library
+  // already started creating it. Called before waiting on a future that isn't
+  // ready, so that the wait doesn't include the pipelines queued before it.
+  std::function<void()> create_now;
+
+  const std::shared_ptr<Pipeline<T>> Get() const {
+    if (create_now && !IsReady()) {
+      create_now();
+    }
+    return future.get();
+  }
 
   bool IsValid() const { return future.valid(); }
+
+  bool IsReady() const {
+    return IsValid() && future.wait_for(std::chrono::seconds(0)) ==
+                            std::future_status::ready;
+  }
 };
 
 //------------------------------------------------------------------------------
@@ -118,6 +133,10 @@ class RenderPipelineT {
     return pipeline_future_.descriptor;
   }
 
+  /// Whether the pipeline finished compiling, so that `WaitAndGet` won't
+  /// block.
+  bool IsReady() const { return did_wait_ || pipeline_future_.IsReady(); }
+
  private:
   PipelineFuture<PipelineDescriptor> pipeline_future_;
   std::shared_ptr<Pipeline<PipelineDescriptor>> pipeline_;
@@ -2,9 +2,11 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <future>
 #include <unordered_set>
 
 #include "flutter/testing/testing.h"
+#include "impeller/renderer/pipeline.h"
 #include "impeller/renderer/pipeline_descriptor.h"
 
 namespace impeller {
@@ -23,5 +25,40 @@ TEST(PipelineDescriptorTest, PrimitiveTypeHashEquality) {
   ASSERT_NE(descA.GetHash(), descB.GetHash());
 }
 
+TEST(PipelineDescriptorTest, SpecializationConstantsHashEquality) {
+  PipelineDescriptor descA;
+  PipelineDescriptor descB;
+
+  descA.SetSpecializationConstants({1.0f, 0.0f});
+  descB.SetSpecializationConstants({1.0f, 0.0f});
+
+  ASSERT_TRUE(descA.IsEqual(descB));
+  ASSERT_EQ(descA.GetHash(), descB.GetHash());
+
+  descB.SetSpecializationConstants({1.0f, 1.0f});
+
+  ASSERT_FALSE(descA.IsEqual(descB));
+  ASSERT_NE(descA.GetHash(), descB.GetHash());
+}
+
+TEST(PipelineFutureTest, CreatesPipelinesThatAreNotReadyWhenWaitedOn) {
+  auto promise = std::make_shared<
+      std::promise<std::shared_ptr<Pipeline<PipelineDescriptor>>>>();
+  size_t create_count = 0u;
+  PipelineFuture<PipelineDescriptor> future{
+      PipelineDescriptor{}, promise->get_future(), [&]() {
+        create_count++;
+        promise->set_value(nullptr);
+      }};
+
+  ASSERT_FALSE(future.IsReady());
+  ASSERT_EQ(future.Get(), nullptr);
+  ASSERT_EQ(create_count, 1u);
+
+  // Pipelines that are ready aren't created again.
+  ASSERT_EQ(future.Get(), nullptr);
+  ASSERT_EQ(create_count, 1u);
+}
+
 }  // namespace  testing
 }  // namespace impeller
@@ -32,4 +32,8 @@ PipelineFuture<ComputePipelineDescriptor> PipelineLibrary::GetPipeline(
   return {descriptor, promise->get_future()};
 }
 
+std::shared_ptr<PipelineManifest> PipelineLibrary::GetManifest() const {
+  return nullptr;
+}
+
 }  // namespace impeller
@@ -10,6 +10,7 @@
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/pipeline.h"
 #include "impeller/renderer/pipeline_descriptor.h"
+#include "impeller/renderer/pipeline_manifest.h"
 
 namespace impeller {
 
@@ -47,6 +48,21 @@ class PipelineLibrary : public std::enable_shared_from_this<PipelineLibrary> {
   virtual void RemovePipelinesWithEntryPoint(
       std::shared_ptr<const ShaderFunction> function) = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The manifest of pipeline variants used by clients of this
+  ///             library.
+  ///
+  ///             Backends that persist their pipeline caches across launches
+  ///             return a manifest pre-populated with the variants recorded
+  ///             during the previous launch. Clients may use it to pre-warm
+  ///             those variants and should record new variants in it as they
+  ///             are created.
+  ///
+  /// @return     The manifest or nullptr if the backend does not persist
+  ///             pipeline manifests.
+  ///
+  virtual std::shared_ptr<PipelineManifest> GetManifest() const;
+
  protected:
   PipelineLibrary();
 
@@ -0,0 +1,104 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/pipeline_manifest.h"
+
+#include <sstream>
+
+namespace impeller {
+
+// The serialized form is line oriented. The first line is the header. Every
+// other line is a single variant, which is the hexadecimal variant key
+// followed by a space and the prototype label. Variants are written in the
+// order they were first recorded.
+static constexpr const char* kManifestHeader = "impeller-pipeline-manifest 1";
+
+PipelineManifest::PipelineManifest() = default;
+
+PipelineManifest::~PipelineManifest() = default;
+
+std::shared_ptr<PipelineManifest> PipelineManifest::CreateFromMapping(
+    const fml::Mapping& mapping) {
+  if (mapping.GetMapping() == nullptr) {
+    return nullptr;
+  }
+  std::istringstream stream(
+      std::string{reinterpret_cast<const char*>(mapping.GetMapping()),
+                  mapping.GetSize()});
+
+  std::string line;
+  if (!std::getline(stream, line) || line != kManifestHeader) {
+    return nullptr;
+  }
+
+  auto manifest = std::make_shared<PipelineManifest>();
+  while (std::getline(stream, line)) {
+    auto separator = line.find(' ');
+    if (separator == 0u || separator == std::string::npos ||
+        separator + 1 == line.size()) {
+      return nullptr;
+    }
+    VariantKey variant = 0;
+    std::istringstream key_stream(line.substr(0, separator));
+    key_stream >> std::hex >> variant;
+    if (key_stream.fail() || !key_stream.eof()) {
+      return nullptr;
+    }
+    manifest->Record(line.substr(separator + 1), variant);
+  }
+  return manifest;
+}
+
+bool PipelineManifest::Record(const std::string& prototype,
+                              VariantKey variant) {
+  // Labels are written out one per line.
+  if (prototype.empty() || prototype.find('\n') != std::string::npos) {
+    return false;
+  }
+  Lock lock(mutex_);
+  if (!variants_[prototype].insert(variant).second) {
+    return false;
+  }
+  entries_.push_back({prototype, variant});
+  return true;
+}
+
+std::vector<PipelineManifest::VariantKey> PipelineManifest::GetVariants(
+    const std::string& prototype) const {
+  std::vector<VariantKey> variants;
+  Lock lock(mutex_);
+  for (const auto& entry : entries_) {
+    if (entry.prototype == prototype) {
+      variants.push_back(entry.variant);
+    }
+  }
+  return variants;
+}
+
+std::vector<PipelineManifest::Entry> PipelineManifest::GetEntries() const {
+  Lock lock(mutex_);
+  return entries_;
+}
+
+size_t PipelineManifest::GetVariantCount() const {
+  Lock lock(mutex_);
+  return entries_.size();
+}
+
+std::shared_ptr<fml::Mapping> PipelineManifest::Serialize() const {
+  std::ostringstream stream;
+  stream << kManifestHeader << "\n";
+  {
+    Lock lock(mutex_);
+    for (const auto& entry : entries_) {
+      stream << std::hex << entry.variant << " " << entry.prototype << "\n";
+    }
+  }
+  auto data = std::make_shared<std::string>(stream.str());
+  return std::make_shared<fml::NonOwnedMapping>(
+      reinterpret_cast<const uint8_t*>(data->data()), data->size(),
+      [data](auto, auto) {});
+}
+
+}  // namespace impeller
@@ -0,0 +1,98 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "impeller/base/thread.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A record of the pipeline variants that were used by a client of
+///             a pipeline library.
+///
+///             Each entry is keyed by the label of the prototype pipeline the
+///             variant was derived from along with an opaque, client defined
+///             key that describes the variant. Backends that persist their
+///             pipeline caches across launches also persist the manifest so
+///             that clients can pre-warm exactly the variants that were used
+///             during the previous launch instead of creating them lazily on
+///             first use.
+///
+///             Variants are kept in the order they were first recorded, so
+///             that clients can warm up first the variants that were needed
+///             first.
+///
+///             All methods are thread safe.
+///
+class PipelineManifest {
+ public:
+  using VariantKey = uint64_t;
+
+  struct Entry {
+    std::string prototype;
+    VariantKey variant;
+  };
+
+  PipelineManifest();
+
+  ~PipelineManifest();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Create a manifest from a mapping previously obtained via
+  ///             `Serialize`.
+  ///
+  /// @return     The manifest or nullptr if the mapping could not be parsed.
+  ///
+  static std::shared_ptr<PipelineManifest> CreateFromMapping(
+      const fml::Mapping& mapping);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Record that a variant of the given prototype was used.
+  ///
+  /// @return     If the variant was not already present in the manifest.
+  ///
+  bool Record(const std::string& prototype, VariantKey variant);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get all the variants recorded for a given prototype, in the
+  ///             order they were first recorded.
+  ///
+  std::vector<VariantKey> GetVariants(const std::string& prototype) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get all the variants in the manifest, in the order they were
+  ///             first recorded.
+  ///
+  std::vector<Entry> GetEntries() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The total number of variants in the manifest.
+  ///
+  size_t GetVariantCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Serialize the manifest. The result is deterministic for a
+  ///             given sequence of entries.
+  ///
+  std::shared_ptr<fml::Mapping> Serialize() const;
+
+ private:
+  mutable Mutex mutex_;
+  std::map<std::string, std::set<VariantKey>> variants_
+      IPLR_GUARDED_BY(mutex_);
+  std::vector<Entry> entries_ IPLR_GUARDED_BY(mutex_);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PipelineManifest);
+};
+
+}  // namespace impeller
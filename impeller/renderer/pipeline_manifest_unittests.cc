@@ -0,0 +1,101 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "impeller/renderer/pipeline_manifest.h"
+
+namespace impeller {
+namespace testing {
+
+TEST(PipelineManifestTest, RecordsUniqueVariants) {
+  PipelineManifest manifest;
+  ASSERT_TRUE(manifest.Record("SolidFill Pipeline", 1u));
+  ASSERT_TRUE(manifest.Record("SolidFill Pipeline", 2u));
+  ASSERT_FALSE(manifest.Record("SolidFill Pipeline", 1u));
+  ASSERT_TRUE(manifest.Record("Texture Pipeline", 1u));
+  ASSERT_FALSE(manifest.Record("", 1u));
+  ASSERT_FALSE(manifest.Record("Bad\nLabel", 1u));
+
+  ASSERT_EQ(manifest.GetVariantCount(), 3u);
+  auto variants = manifest.GetVariants("SolidFill Pipeline");
+  ASSERT_EQ(variants.size(), 2u);
+  ASSERT_EQ(variants[0], 1u);
+  ASSERT_EQ(variants[1], 2u);
+  ASSERT_TRUE(manifest.GetVariants("Unknown Pipeline").empty());
+}
+
+TEST(PipelineManifestTest, KeepsVariantsInFirstUseOrder) {
+  PipelineManifest manifest;
+  manifest.Record("Texture Pipeline", 7u);
+  manifest.Record("SolidFill Pipeline", 3u);
+  manifest.Record("Texture Pipeline", 1u);
+  manifest.Record("Texture Pipeline", 7u);
+
+  auto entries = manifest.GetEntries();
+  ASSERT_EQ(entries.size(), 3u);
+  ASSERT_EQ(entries[0].prototype, "Texture Pipeline");
+  ASSERT_EQ(entries[0].variant, 7u);
+  ASSERT_EQ(entries[1].prototype, "SolidFill Pipeline");
+  ASSERT_EQ(entries[1].variant, 3u);
+  ASSERT_EQ(entries[2].prototype, "Texture Pipeline");
+  ASSERT_EQ(entries[2].variant, 1u);
+  ASSERT_EQ(manifest.GetVariants("Texture Pipeline"),
+            (std::vector<PipelineManifest::VariantKey>{7u, 1u}));
+
+  // The order survives serialization.
+  auto parsed = PipelineManifest::CreateFromMapping(*manifest.Serialize());
+  ASSERT_NE(parsed, nullptr);
+  auto parsed_entries = parsed->GetEntries();
+  ASSERT_EQ(parsed_entries.size(), 3u);
+  for (size_t i = 0; i < entries.size(); i++) {
+    ASSERT_EQ(parsed_entries[i].prototype, entries[i].prototype);
+    ASSERT_EQ(parsed_entries[i].variant, entries[i].variant);
+  }
+}
+
+TEST(PipelineManifestTest, SerializationRoundTrips) {
+  PipelineManifest manifest;
+  manifest.Record("SolidFill Pipeline", 0x0102030405060708u);
+  manifest.Record("SolidFill Pipeline", 0u);
+  manifest.Record("Texture Pipeline", 42u);
+
+  auto mapping = manifest.Serialize();
+  ASSERT_NE(mapping, nullptr);
+
+  auto parsed = PipelineManifest::CreateFromMapping(*mapping);
+  ASSERT_NE(parsed, nullptr);
+  ASSERT_EQ(parsed->GetVariantCount(), 3u);
+  ASSERT_EQ(parsed->GetVariants("SolidFill Pipeline"),
+            manifest.GetVariants("SolidFill Pipeline"));
+  ASSERT_EQ(parsed->GetVariants("Texture Pipeline"),
+            manifest.GetVariants("Texture Pipeline"));
+
+  // Serialization is deterministic.
+  auto reserialized = parsed->Serialize();
+  ASSERT_EQ(reserialized->GetSize(), mapping->GetSize());
+  ASSERT_EQ(::memcmp(reserialized->GetMapping(), mapping->GetMapping(),
+                     mapping->GetSize()),
+            0);
+}
+
+TEST(PipelineManifestTest, RejectsMalformedData) {
+  auto parse = [](const std::string& data) {
+    return PipelineManifest::CreateFromMapping(fml::NonOwnedMapping(
+        reinterpret_cast<const uint8_t*>(data.data()), data.size()));
+  };
+  ASSERT_NE(parse("impeller-pipeline-manifest 1\n"), nullptr);
+  ASSERT_EQ(parse(""), nullptr);
+  ASSERT_EQ(parse("impeller-pipeline-manifest 2\n"), nullptr);
+  ASSERT_EQ(parse("impeller-pipeline-manifest 1\nzz Pipeline\n"), nullptr);
+  ASSERT_EQ(parse("impeller-pipeline-manifest 1\n12\n"), nullptr);
+  ASSERT_EQ(parse("impeller-pipeline-manifest 1\n12 \n"), nullptr);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -4,6 +4,8 @@
 
 #include "impeller/renderer/render_pass.h"
 
+#include "flutter/fml/metrics.h"
+
 namespace impeller {
 
 RenderPass::RenderPass(std::weak_ptr<const Context> context,
@@ -18,7 +20,7 @@ RenderPass::RenderPass(std::weak_ptr<const Context> context,
 
 RenderPass::~RenderPass() {
   auto strong_context = context_.lock();
-  if (strong_context) {
+  if (strong_context && transients_buffer_is_pooled_) {
     strong_context->GetHostBufferPool().Recycle(transients_buffer_);
   }
 }
@@ -35,20 +37,56 @@ HostBuffer& RenderPass::GetTransientsBuffer() {
   return *transients_buffer_;
 }
 
+void RenderPass::SetTransientsBuffer(
+    std::shared_ptr<HostBuffer> transients_buffer) {
+  if (!transients_buffer) {
+    return;
+  }
+  auto strong_context = context_.lock();
+  if (strong_context && transients_buffer_is_pooled_) {
+    strong_context->GetHostBufferPool().Recycle(transients_buffer_);
+  }
+  transients_buffer_ = std::move(transients_buffer);
+  transients_buffer_is_pooled_ = false;
+}
+
 void RenderPass::SetLabel(std::string label) {
   if (label.empty()) {
     return;
   }
-  transients_buffer_->SetLabel(SPrintF("%s Transients", label.c_str()));
+  if (transients_buffer_is_pooled_) {
+    transients_buffer_->SetLabel(SPrintF("%s Transients", label.c_str()));
+  }
+  label_ = label;
   OnSetLabel(std::move(label));
 }
 
+const std::string& RenderPass::GetLabel() const {
+  return label_;
+}
+
+void RenderPass::SetDefaultScissor(std::optional<IRect> scissor) {
+  default_scissor_ = scissor;
+}
+
 bool RenderPass::AddCommand(Command&& command) {
   if (!command) {
     VALIDATION_LOG << "Attempted to add an invalid command to the render pass.";
     return false;
   }
 
+  if (default_scissor_.has_value()) {
+    auto scissor =
+        command.scissor.has_value()
+            ? command.scissor->Intersection(default_scissor_.value())
+            : default_scissor_;
+    if (!scissor.has_value() || scissor->IsEmpty()) {
+      // Nothing the command draws would be visible.
+      return true;
+    }
+    command.scissor = scissor;
+  }
+
   if (command.scissor.has_value()) {
     auto target_rect = IRect({}, render_target_.GetRenderTargetSize());
     if (!target_rect.Contains(command.scissor.value())) {
@@ -70,6 +108,10 @@ bool RenderPass::AddCommand(Command&& command) {
     return true;
   }
 
+  FML_COUNTER_INCREMENT("impeller.render_pass.draw_calls");
+  if (commands_.empty() || commands_.back().pipeline != command.pipeline) {
+    FML_COUNTER_INCREMENT("impeller.render_pass.pipeline_switches");
+  }
   commands_.emplace_back(std::move(command));
   return true;
 }
@@ -80,6 +122,9 @@ bool RenderPass::EncodeCommands() const {
   if (!context) {
     return false;
   }
+  if (context->GetFrameCapture()->IsRecording()) {
+    context->GetFrameCapture()->RecordRenderPass(*context, *this);
+  }
   return OnEncodeCommands(*context);
 }
 
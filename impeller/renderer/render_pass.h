@@ -36,8 +36,18 @@ class RenderPass {
 
   void SetLabel(std::string label);
 
+  const std::string& GetLabel() const;
+
   HostBuffer& GetTransientsBuffer();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Emplace transient data into a buffer shared with other passes
+  ///             instead of the one the pass got from the context's pool.
+  ///
+  /// @param[in]  transients_buffer  The buffer to use. Ignored if null.
+  ///
+  void SetTransientsBuffer(std::shared_ptr<HostBuffer> transients_buffer);
+
   //----------------------------------------------------------------------------
   /// @brief      Record a command for subsequent encoding to the underlying
   ///             command buffer. No work is encoded into the command buffer at
@@ -49,6 +59,17 @@ class RenderPass {
   ///
   bool AddCommand(Command&& command);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Set a scissor applied to the commands added after this call.
+  ///             Commands without a scissor of their own use it as is, the
+  ///             scissor of other commands is intersected with it. Commands
+  ///             whose scissor becomes empty are dropped.
+  ///
+  /// @param[in]  scissor  The scissor, which must lie within the render
+  ///                      target. If unset, commands are added unchanged.
+  ///
+  void SetDefaultScissor(std::optional<IRect> scissor);
+
   //----------------------------------------------------------------------------
   /// @brief      Encode the recorded commands to the underlying command buffer.
   ///
@@ -68,6 +89,7 @@ class RenderPass {
   const std::weak_ptr<const Context> context_;
   const RenderTarget render_target_;
   std::shared_ptr<HostBuffer> transients_buffer_;
+  bool transients_buffer_is_pooled_ = true;
   std::vector<Command> commands_;
 
   RenderPass(std::weak_ptr<const Context> context, const RenderTarget& target);
@@ -79,6 +101,9 @@ class RenderPass {
   virtual bool OnEncodeCommands(const Context& context) const = 0;
 
  private:
+  std::string label_;
+  std::optional<IRect> default_scissor_;
+
   FML_DISALLOW_COPY_AND_ASSIGN(RenderPass);
 };
 
@@ -22,6 +22,14 @@ void RenderTargetAllocator::Start() {}
 
 void RenderTargetAllocator::End() {}
 
+void RenderTargetAllocator::Clear() {}
+
+void RenderTargetAllocator::Detach(const std::shared_ptr<Texture>& texture) {}
+
+const std::shared_ptr<Allocator>& RenderTargetAllocator::GetAllocator() const {
+  return allocator_;
+}
+
 std::shared_ptr<Texture> RenderTargetAllocator::CreateTexture(
     const TextureDescriptor& desc) {
   return allocator_->CreateTexture(desc);
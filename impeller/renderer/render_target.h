@@ -41,6 +41,19 @@ class RenderTargetAllocator {
   ///        This may be used to deallocate any unused textures.
   virtual void End();
 
+  /// @brief Drop any textures retained for reuse by later frames, for example
+  ///        because the system is running low on memory. Must not be called
+  ///        between |Start| and |End|.
+  virtual void Clear();
+
+  /// @brief Stop recycling a texture created by |CreateTexture|, so that the
+  ///        caller may keep using it in later frames. Does nothing for
+  ///        textures that are not recycled.
+  virtual void Detach(const std::shared_ptr<Texture>& texture);
+
+ protected:
+  const std::shared_ptr<Allocator>& GetAllocator() const;
+
  private:
   std::shared_ptr<Allocator> allocator_;
 };
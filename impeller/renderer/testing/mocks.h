@@ -61,6 +61,7 @@ class MockBlitPass : public BlitPass {
                std::shared_ptr<Texture> destination,
                IRect source_region,
                IPoint destination_origin,
+               size_t source_mip_level,
                std::string label),
               (override));
 
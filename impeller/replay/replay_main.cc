@@ -0,0 +1,163 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/command_line.h"
+#include "flutter/fml/mapping.h"
+#include "impeller/playground/playground.h"
+#include "impeller/renderer/frame_replay.h"
+
+namespace impeller {
+
+namespace {
+
+// A playground that is only used to create a context with the shader
+// libraries of the engine, without a window.
+class ReplayPlayground final : public Playground {
+ public:
+  ReplayPlayground() : Playground(PlaygroundSwitches{}) {}
+
+  // |Playground|
+  std::unique_ptr<fml::Mapping> OpenAssetAsMapping(
+      std::string asset_name) const override {
+    return nullptr;
+  }
+
+  // |Playground|
+  std::string GetWindowTitle() const override { return "impeller_replay"; }
+};
+
+std::optional<PlaygroundBackend> ParseBackend(const std::string& name) {
+  if (name == "metal") {
+    return PlaygroundBackend::kMetal;
+  }
+  if (name == "opengles") {
+    return PlaygroundBackend::kOpenGLES;
+  }
+  if (name == "vulkan") {
+    return PlaygroundBackend::kVulkan;
+  }
+  return std::nullopt;
+}
+
+double MedianMilliseconds(std::vector<fml::TimeDelta> times) {
+  if (times.empty()) {
+    return 0.0;
+  }
+  auto middle = times.begin() + times.size() / 2;
+  std::nth_element(times.begin(), middle, times.end());
+  return middle->ToMillisecondsF();
+}
+
+void PrintUsage() {
+  std::cerr << "Usage: impeller_replay --capture=<path> "
+               "[--backend=metal|opengles|vulkan] [--iterations=<count>]"
+            << std::endl;
+}
+
+}  // namespace
+
+bool Main(const fml::CommandLine& command_line) {
+  std::string capture_path;
+  if (!command_line.GetOptionValue("capture", &capture_path)) {
+    PrintUsage();
+    return false;
+  }
+
+  std::string backend_name = "vulkan";
+  command_line.GetOptionValue("backend", &backend_name);
+  auto backend = ParseBackend(backend_name);
+  if (!backend.has_value() || !Playground::SupportsBackend(backend.value())) {
+    std::cerr << "Unsupported backend: " << backend_name << std::endl;
+    return false;
+  }
+
+  size_t iterations = 10u;
+  std::string iterations_value;
+  if (command_line.GetOptionValue("iterations", &iterations_value)) {
+    iterations = std::max(std::atoi(iterations_value.c_str()), 1);
+  }
+
+  auto capture = fml::FileMapping::CreateReadOnly(capture_path);
+  if (!capture) {
+    std::cerr << "Could not open the capture at " << capture_path << std::endl;
+    return false;
+  }
+
+  ReplayPlayground playground;
+  playground.SetupContext(backend.value());
+  auto context = playground.GetContext();
+  if (!context) {
+    std::cerr << "Could not create a " << backend_name << " context."
+              << std::endl;
+    return false;
+  }
+
+  auto replay = FrameReplay::Create(context, *capture);
+  if (!replay) {
+    std::cerr << "Could not load the capture at " << capture_path << std::endl;
+    return false;
+  }
+  std::cout << "Replaying " << replay->GetRenderPassCount()
+            << " render passes with " << replay->GetCommandCount()
+            << " commands on " << PlaygroundBackendToString(backend.value())
+            << "." << std::endl;
+  if (replay->GetSkippedCommandCount() > 0) {
+    std::cout << replay->GetSkippedCommandCount()
+              << " commands are skipped as their pipelines could not be "
+                 "created."
+              << std::endl;
+  }
+
+  std::vector<std::vector<fml::TimeDelta>> encode_times(
+      replay->GetRenderPassCount());
+  std::vector<std::vector<fml::TimeDelta>> gpu_times(
+      replay->GetRenderPassCount());
+  std::vector<FrameReplay::PassTiming> last_timings;
+  for (size_t i = 0; i < iterations; i++) {
+    auto timings = replay->Replay();
+    if (!timings.has_value()) {
+      std::cerr << "Could not replay the capture." << std::endl;
+      return false;
+    }
+    for (size_t pass = 0; pass < timings->size(); pass++) {
+      encode_times[pass].push_back(timings->at(pass).encode_time);
+      if (timings->at(pass).gpu_time.has_value()) {
+        gpu_times[pass].push_back(timings->at(pass).gpu_time.value());
+      }
+    }
+    last_timings = std::move(timings.value());
+  }
+
+  std::cout << "Median times over " << iterations << " iterations:"
+            << std::endl;
+  std::cout << std::fixed << std::setprecision(3);
+  for (size_t pass = 0; pass < last_timings.size(); pass++) {
+    const auto& timing = last_timings[pass];
+    std::cout << "  " << pass << " "
+              << (timing.label.empty() ? "(unlabeled)" : timing.label) << ": "
+              << timing.command_count << " commands, encode "
+              << MedianMilliseconds(encode_times[pass]) << " ms";
+    if (!gpu_times[pass].empty()) {
+      std::cout << ", GPU " << MedianMilliseconds(gpu_times[pass]) << " ms";
+    }
+    std::cout << std::endl;
+  }
+  return true;
+}
+
+}  // namespace impeller
+
+int main(int argc, char const* argv[]) {
+  return impeller::Main(fml::CommandLineFromPlatformOrArgcArgv(argc, argv))
+             ? EXIT_SUCCESS
+             : EXIT_FAILURE;
+}
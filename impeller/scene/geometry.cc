@@ -116,11 +116,66 @@ std::shared_ptr<Geometry> Geometry::MakeFromFlatbuffer(
       .vertex_count = mesh.indices()->count(),
       .index_type = index_type,
   };
-  return MakeVertexBuffer(std::move(vertex_buffer), is_skinned);
+
+  // Skinned vertices are moved by their joints, so their bind pose bounds
+  // can't be used for culling.
+  if (is_skinned) {
+    return MakeVertexBuffer(std::move(vertex_buffer), is_skinned);
+  }
+
+  const auto* vertices = mesh.vertices_as_UnskinnedVertexBuffer()->vertices();
+  GeometryBounds bounds;
+  for (size_t i = 0; i < vertices->size(); i++) {
+    const fb::Vec3& position = vertices->Get(i)->position();
+    Vector3 point(position.x(), position.y(), position.z());
+    bounds.min = i == 0 ? point : bounds.min.Min(point);
+    bounds.max = i == 0 ? point : bounds.max.Max(point);
+  }
+
+  auto result = std::make_shared<UnskinnedVertexBufferGeometry>();
+  result->SetVertexBuffer(std::move(vertex_buffer));
+  result->SetBounds(bounds);
+  return result;
 }
 
 void Geometry::SetJointsTexture(const std::shared_ptr<Texture>& texture) {}
 
+std::optional<GeometryBounds> Geometry::GetBounds() const {
+  return std::nullopt;
+}
+
+bool Geometry::IsOutsideOfView(const Matrix& transform) const {
+  auto bounds = GetBounds();
+  if (!bounds.has_value()) {
+    return false;
+  }
+
+  // The geometry is outside of the view if all corners of its bounds are
+  // outside of the same clip plane.
+  int outside_left = 0;
+  int outside_right = 0;
+  int outside_bottom = 0;
+  int outside_top = 0;
+  int outside_near = 0;
+  int outside_far = 0;
+  for (int i = 0; i < 8; i++) {
+    Vector4 corner(i & 1 ? bounds->max.x : bounds->min.x,
+                   i & 2 ? bounds->max.y : bounds->min.y,
+                   i & 4 ? bounds->max.z : bounds->min.z, 1);
+    Vector4 clip = transform * corner;
+    outside_left += clip.x < -clip.w;
+    outside_right += clip.x > clip.w;
+    outside_bottom += clip.y < -clip.w;
+    outside_top += clip.y > clip.w;
+    // Conservatively use the larger of the OpenGL and Metal/Vulkan depth
+    // ranges.
+    outside_near += clip.z < -clip.w;
+    outside_far += clip.z > clip.w;
+  }
+  return outside_left == 8 || outside_right == 8 || outside_bottom == 8 ||
+         outside_top == 8 || outside_near == 8 || outside_far == 8;
+}
+
 //------------------------------------------------------------------------------
 /// CuboidGeometry
 ///
@@ -173,6 +228,12 @@ void CuboidGeometry::BindToCommand(const SceneContext& scene_context,
   UnskinnedVertexShader::BindFrameInfo(command, buffer.EmplaceUniform(info));
 }
 
+// |Geometry|
+std::optional<GeometryBounds> CuboidGeometry::GetBounds() const {
+  // This matches the vertices in |GetVertexBuffer|.
+  return GeometryBounds{.min = Vector3(0, 0, 0), .max = Vector3(1, 1, 0)};
+}
+
 //------------------------------------------------------------------------------
 /// UnskinnedVertexBufferGeometry
 ///
@@ -186,6 +247,11 @@ void UnskinnedVertexBufferGeometry::SetVertexBuffer(
   vertex_buffer_ = std::move(vertex_buffer);
 }
 
+void UnskinnedVertexBufferGeometry::SetBounds(
+    std::optional<GeometryBounds> bounds) {
+  bounds_ = bounds;
+}
+
 // |Geometry|
 GeometryType UnskinnedVertexBufferGeometry::GetGeometryType() const {
   return GeometryType::kUnskinned;
@@ -211,6 +277,12 @@ void UnskinnedVertexBufferGeometry::BindToCommand(
   UnskinnedVertexShader::BindFrameInfo(command, buffer.EmplaceUniform(info));
 }
 
+// |Geometry|
+std::optional<GeometryBounds> UnskinnedVertexBufferGeometry::GetBounds()
+    const {
+  return bounds_;
+}
+
 //------------------------------------------------------------------------------
 /// SkinnedVertexBufferGeometry
 ///
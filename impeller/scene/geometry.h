@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 
 #include "flutter/fml/macros.h"
 #include "impeller/core/allocator.h"
@@ -24,6 +25,13 @@ namespace scene {
 class CuboidGeometry;
 class UnskinnedVertexBufferGeometry;
 
+/// An axis-aligned box containing all of the vertices of a geometry, in model
+/// space.
+struct GeometryBounds {
+  Vector3 min;
+  Vector3 max;
+};
+
 class Geometry {
  public:
   virtual ~Geometry();
@@ -47,6 +55,14 @@ class Geometry {
                              Command& command) const = 0;
 
   virtual void SetJointsTexture(const std::shared_ptr<Texture>& texture);
+
+  /// @brief  The bounds of the geometry in model space, or `std::nullopt` if
+  ///         they are not known. Geometry without bounds is never culled.
+  virtual std::optional<GeometryBounds> GetBounds() const;
+
+  /// @brief  Whether the geometry is entirely outside of the view volume when
+  ///         drawn with `transform`, which maps model space to clip space.
+  bool IsOutsideOfView(const Matrix& transform) const;
 };
 
 class CuboidGeometry final : public Geometry {
@@ -69,6 +85,9 @@ class CuboidGeometry final : public Geometry {
                      const Matrix& transform,
                      Command& command) const override;
 
+  // |Geometry|
+  std::optional<GeometryBounds> GetBounds() const override;
+
  private:
   Vector3 size_;
 
@@ -83,6 +102,8 @@ class UnskinnedVertexBufferGeometry final : public Geometry {
 
   void SetVertexBuffer(VertexBuffer vertex_buffer);
 
+  void SetBounds(std::optional<GeometryBounds> bounds);
+
   // |Geometry|
   GeometryType GetGeometryType() const override;
 
@@ -95,8 +116,12 @@ class UnskinnedVertexBufferGeometry final : public Geometry {
                      const Matrix& transform,
                      Command& command) const override;
 
+  // |Geometry|
+  std::optional<GeometryBounds> GetBounds() const override;
+
  private:
   VertexBuffer vertex_buffer_;
+  std::optional<GeometryBounds> bounds_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(UnskinnedVertexBufferGeometry);
 };
@@ -91,6 +91,11 @@ std::shared_ptr<CommandBuffer> SceneEncoder::BuildSceneCommandBuffer(
   }
 
   for (auto& command : commands_) {
+    // Skip geometry that would not be visible.
+    if (command.geometry->IsOutsideOfView(camera_transform *
+                                          command.transform)) {
+      continue;
+    }
     EncodeCommand(scene_context, camera_transform, *render_pass, command);
   }
 
@@ -34,6 +34,21 @@ namespace testing {
 using SceneTest = PlaygroundTest;
 INSTANTIATE_PLAYGROUND_SUITE(SceneTest);
 
+TEST(SceneGeometryTest, CuboidIsOutsideOfViewOnlyWhenNotVisible) {
+  auto cuboid = Geometry::MakeCuboid(Vector3(1, 1, 1));
+  auto view = Matrix::MakeOrthographic(ISize(100, 100));
+
+  EXPECT_FALSE(
+      cuboid->IsOutsideOfView(view * Matrix::MakeTranslation({50, 50, 0})));
+  // Partially visible.
+  EXPECT_FALSE(
+      cuboid->IsOutsideOfView(view * Matrix::MakeTranslation({99.5, 50, 0})));
+  EXPECT_TRUE(
+      cuboid->IsOutsideOfView(view * Matrix::MakeTranslation({200, 50, 0})));
+  EXPECT_TRUE(
+      cuboid->IsOutsideOfView(view * Matrix::MakeTranslation({50, -20, 0})));
+}
+
 TEST_P(SceneTest, CuboidUnlit) {
   auto scene_context = std::make_shared<SceneContext>(GetContext());
 
@@ -62,6 +62,22 @@ Skin::Skin(Skin&&) = default;
 
 Skin& Skin::operator=(Skin&&) = default;
 
+const Matrix& Skin::GetJointModelTransform(const Node* joint) {
+  // Compute a model space matrix for the joint by walking up the bones to the
+  // skeleton root. Bones shared by several joints are only visited once per
+  // call to |GetJointsTexture|.
+  auto found = joint_model_transforms_.find(joint);
+  if (found != joint_model_transforms_.end()) {
+    return found->second;
+  }
+  const Node* parent = joint->GetParent();
+  Matrix transform = joint->GetLocalTransform();
+  if (parent && parent->IsJoint()) {
+    transform = GetJointModelTransform(parent) * transform;
+  }
+  return joint_model_transforms_.emplace(joint, transform).first->second;
+}
+
 std::shared_ptr<Texture> Skin::GetJointsTexture(Allocator& allocator) {
   // Each joint has a matrix. 1 matrix = 16 floats. 1 pixel = 4 floats.
   // Therefore, each joint needs 4 pixels.
@@ -69,23 +85,28 @@ std::shared_ptr<Texture> Skin::GetJointsTexture(Allocator& allocator) {
   auto dimension_size = std::max(
       2u,
       Allocation::NextPowerOfTwoSize(std::ceil(std::sqrt(required_pixels))));
-
-  impeller::TextureDescriptor texture_descriptor;
-  texture_descriptor.storage_mode = impeller::StorageMode::kHostVisible;
-  texture_descriptor.format = PixelFormat::kR32G32B32A32Float;
-  texture_descriptor.size = {dimension_size, dimension_size};
-  texture_descriptor.mip_count = 1u;
-
-  auto result = allocator.CreateTexture(texture_descriptor);
-  result->SetLabel("Joints Texture");
-  if (!result) {
-    FML_LOG(ERROR) << "Could not create joint texture.";
-    return nullptr;
+  const ISize size = {dimension_size, dimension_size};
+
+  auto& result = joints_textures_[next_joints_texture_];
+  if (!result || result->GetSize() != size) {
+    impeller::TextureDescriptor texture_descriptor;
+    texture_descriptor.storage_mode = impeller::StorageMode::kHostVisible;
+    texture_descriptor.format = PixelFormat::kR32G32B32A32Float;
+    texture_descriptor.size = size;
+    texture_descriptor.mip_count = 1u;
+
+    result = allocator.CreateTexture(texture_descriptor);
+    if (!result) {
+      FML_LOG(ERROR) << "Could not create joint texture.";
+      return nullptr;
+    }
+    result->SetLabel("Joints Texture");
   }
+  next_joints_texture_ = (next_joints_texture_ + 1) % kJointsTextureCount;
 
-  std::vector<Matrix> joints;
-  joints.resize(result->GetSize().Area() / 4, Matrix());
-  FML_DCHECK(joints.size() >= joints_.size());
+  joint_matrices_.assign(size.Area() / 4, Matrix());
+  FML_DCHECK(joint_matrices_.size() >= joints_.size());
+  joint_model_transforms_.clear();
   for (size_t joint_i = 0; joint_i < joints_.size(); joint_i++) {
     const Node* joint = joints_[joint_i].get();
     if (!joint) {
@@ -93,13 +114,6 @@ std::shared_ptr<Texture> Skin::GetJointsTexture(Allocator& allocator) {
       continue;
     }
 
-    // Compute a model space matrix for the joint by walking up the bones to the
-    // skeleton root.
-    while (joint && joint->IsJoint()) {
-      joints[joint_i] = joint->GetLocalTransform() * joints[joint_i];
-      joint = joint->GetParent();
-    }
-
     // Get the joint transform relative to the default pose of the bone by
     // incorporating the joint's inverse bind matrix. The inverse bind matrix
     // transforms from model space to the default pose space of the joint. The
@@ -107,11 +121,12 @@ std::shared_ptr<Texture> Skin::GetJointsTexture(Allocator& allocator) {
     // the joint's default pose and the joint's current pose in the scene. This
     // is necessary because the skinned model's vertex positions (which _define_
     // the default pose) are all in model space.
-    joints[joint_i] = joints[joint_i] * inverse_bind_matrices_[joint_i];
+    joint_matrices_[joint_i] =
+        GetJointModelTransform(joint) * inverse_bind_matrices_[joint_i];
   }
 
-  if (!result->SetContents(reinterpret_cast<uint8_t*>(joints.data()),
-                           joints.size() * sizeof(Matrix))) {
+  if (!result->SetContents(reinterpret_cast<uint8_t*>(joint_matrices_.data()),
+                           joint_matrices_.size() * sizeof(Matrix))) {
     FML_LOG(ERROR) << "Could not set contents of joint texture.";
     return nullptr;
   }
@@ -4,8 +4,11 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <optional>
+#include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 
@@ -27,14 +30,33 @@ class Skin final {
   Skin(Skin&&);
   Skin& operator=(Skin&&);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Computes the current joint matrices and uploads them to a
+  ///             texture.
+  ///
+  ///             Textures are recycled round robin across
+  ///             `kJointsTextureCount` calls so that a texture is not
+  ///             overwritten while a frame still in flight samples it.
+  ///
   std::shared_ptr<Texture> GetJointsTexture(Allocator& allocator);
 
  private:
+  // Matches the number of frames the renderer keeps in flight.
+  static constexpr size_t kJointsTextureCount = 3u;
+
   Skin();
 
+  const Matrix& GetJointModelTransform(const Node* joint);
+
   std::vector<std::shared_ptr<Node>> joints_;
   std::vector<Matrix> inverse_bind_matrices_;
 
+  std::array<std::shared_ptr<Texture>, kJointsTextureCount> joints_textures_;
+  size_t next_joints_texture_ = 0u;
+  // Scratch storage reused across calls to |GetJointsTexture|.
+  std::vector<Matrix> joint_matrices_;
+  std::unordered_map<const Node*, Matrix> joint_model_transforms_;
+
   FML_DISALLOW_COPY_AND_ASSIGN(Skin);
 };
 
@@ -55,7 +55,7 @@ static int ToTessWindingRule(FillType fill_type) {
 Tessellator::Result Tessellator::Tessellate(
     FillType fill_type,
     const Path::Polyline& polyline,
-    const BuilderCallback& callback) const {
+    const BuilderCallback& callback) {
   if (!callback) {
     return Result::kInputError;
   }
@@ -111,17 +111,23 @@ Tessellator::Result Tessellator::Tessellate(
   auto elements = tessGetElements(tessellator);
   // libtess uses an int index internally due to usage of -1 as a sentinel
   // value.
-  std::vector<uint16_t> indices(elementItemCount);
+  indices_.resize(elementItemCount);
   for (int i = 0; i < elementItemCount; i++) {
-    indices[i] = static_cast<uint16_t>(elements[i]);
+    indices_[i] = static_cast<uint16_t>(elements[i]);
   }
-  if (!callback(vertices, vertexItemCount, indices.data(), elementItemCount)) {
+  if (!callback(vertices, vertexItemCount, indices_.data(), elementItemCount)) {
     return Result::kInputError;
   }
 
   return Result::kSuccess;
 }
 
+const Path::Polyline& Tessellator::CreateTempPolyline(const Path& path,
+                                                      Scalar scale) {
+  path.CreatePolyline(scale, polyline_);
+  return polyline_;
+}
+
 void DestroyTessellator(TESStesselator* tessellator) {
   if (tessellator != nullptr) {
     ::tessDeleteTess(tessellator);
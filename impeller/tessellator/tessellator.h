@@ -61,10 +61,26 @@ class Tessellator {
   ///
   Tessellator::Result Tessellate(FillType fill_type,
                                  const Path::Polyline& polyline,
-                                 const BuilderCallback& callback) const;
+                                 const BuilderCallback& callback);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates the polyline of a path in storage owned by the
+  ///             tessellator. The storage is reused by later calls so that
+  ///             flattening paths every frame doesn't allocate.
+  ///
+  /// @param[in]  path   The path to flatten.
+  /// @param[in]  scale  The scale the path will be transformed by. See
+  ///                    |Path::CreatePolyline|.
+  ///
+  /// @return     The polyline. It is only valid until the next call to this
+  ///             method.
+  ///
+  const Path::Polyline& CreateTempPolyline(const Path& path, Scalar scale);
 
  private:
   CTessellator c_tessellator_;
+  Path::Polyline polyline_;
+  std::vector<uint16_t> indices_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(Tessellator);
 };
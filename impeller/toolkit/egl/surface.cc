@@ -4,11 +4,58 @@
 
 #include "impeller/toolkit/egl/surface.h"
 
+#include <array>
+#include <sstream>
+#include <string>
+
 namespace impeller {
 namespace egl {
 
+static bool HasExtension(EGLDisplay display, const char* extension) {
+  const char* extensions = ::eglQueryString(display, EGL_EXTENSIONS);
+  if (extensions == nullptr) {
+    return false;
+  }
+  std::istringstream stream(extensions);
+  std::string name;
+  while (stream >> name) {
+    if (name == extension) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Converts |rect| to the EGL rectangle of |x, y, width, height| with the
+// origin at the bottom left of a surface of |size|.
+static std::array<EGLint, 4> ToEGLRect(const IRect& rect, const ISize& size) {
+  return {
+      static_cast<EGLint>(rect.GetLeft()),
+      static_cast<EGLint>(size.height - rect.GetBottom()),
+      static_cast<EGLint>(rect.size.width),
+      static_cast<EGLint>(rect.size.height),
+  };
+}
+
 Surface::Surface(EGLDisplay display, EGLSurface surface)
-    : display_(display), surface_(surface) {}
+    : display_(display), surface_(surface) {
+  if (surface_ == EGL_NO_SURFACE) {
+    return;
+  }
+  supports_buffer_age_ = HasExtension(display_, "EGL_EXT_buffer_age");
+  if (!supports_buffer_age_) {
+    return;
+  }
+  if (HasExtension(display_, "EGL_KHR_partial_update")) {
+    set_damage_region_ = reinterpret_cast<PFNEGLSETDAMAGEREGIONKHRPROC>(
+        ::eglGetProcAddress("eglSetDamageRegionKHR"));
+  }
+  if (HasExtension(display_, "EGL_KHR_swap_buffers_with_damage")) {
+    swap_buffers_with_damage_ =
+        reinterpret_cast<PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC>(
+            ::eglGetProcAddress("eglSwapBuffersWithDamageKHR"));
+  }
+}
 
 Surface::~Surface() {
   if (surface_ != EGL_NO_SURFACE) {
@@ -26,12 +73,82 @@ bool Surface::IsValid() const {
   return surface_ != EGL_NO_SURFACE;
 }
 
-bool Surface::Present() const {
-  const auto result = ::eglSwapBuffers(display_, surface_) == EGL_TRUE;
+bool Surface::SupportsPartialRepaint() const {
+  return supports_buffer_age_;
+}
+
+ISize Surface::GetSize() const {
+  EGLint width = 0;
+  EGLint height = 0;
+  if (::eglQuerySurface(display_, surface_, EGL_WIDTH, &width) != EGL_TRUE ||
+      ::eglQuerySurface(display_, surface_, EGL_HEIGHT, &height) != EGL_TRUE) {
+    IMPELLER_LOG_EGL_ERROR;
+    return {};
+  }
+  return ISize(width, height);
+}
+
+std::optional<IRect> Surface::GetExistingDamage() const {
+  if (!supports_buffer_age_) {
+    return std::nullopt;
+  }
+  EGLint age = 0;
+  if (::eglQuerySurface(display_, surface_, EGL_BUFFER_AGE_EXT, &age) !=
+      EGL_TRUE) {
+    IMPELLER_LOG_EGL_ERROR;
+    return std::nullopt;
+  }
+  // An age of zero means that the contents of the buffer are undefined. A
+  // buffer of age N was last presented N frames ago, so the frames presented
+  // after it have to be repainted.
+  if (age <= 0 || static_cast<size_t>(age - 1) > damage_history_.size()) {
+    return std::nullopt;
+  }
+  IRect damage;
+  for (EGLint i = 0; i < age - 1; i++) {
+    const auto& frame_damage = damage_history_[i];
+    if (!frame_damage.has_value()) {
+      return std::nullopt;
+    }
+    if (frame_damage->IsEmpty()) {
+      continue;
+    }
+    damage = damage.IsEmpty() ? *frame_damage : damage.Union(*frame_damage);
+  }
+  return damage;
+}
+
+void Surface::SetDamageRegion(const std::optional<IRect>& region) const {
+  if (set_damage_region_ == nullptr || !region.has_value()) {
+    return;
+  }
+  auto rect = ToEGLRect(*region, GetSize());
+  if (set_damage_region_(display_, surface_, rect.data(), 1) != EGL_TRUE) {
+    IMPELLER_LOG_EGL_ERROR;
+  }
+}
+
+bool Surface::Present(const std::optional<IRect>& damage) {
+  bool result = false;
+  if (swap_buffers_with_damage_ != nullptr && damage.has_value()) {
+    auto rect = ToEGLRect(*damage, GetSize());
+    result = swap_buffers_with_damage_(display_, surface_, rect.data(), 1) ==
+             EGL_TRUE;
+  } else {
+    result = ::eglSwapBuffers(display_, surface_) == EGL_TRUE;
+  }
   if (!result) {
     IMPELLER_LOG_EGL_ERROR;
+    damage_history_.clear();
+    return false;
+  }
+  if (supports_buffer_age_) {
+    damage_history_.push_front(damage);
+    if (damage_history_.size() > kMaxDamageHistory) {
+      damage_history_.pop_back();
+    }
   }
-  return result;
+  return true;
 }
 
 }  // namespace egl
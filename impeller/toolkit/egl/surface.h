@@ -4,12 +4,29 @@
 
 #pragma once
 
+#include <deque>
+#include <optional>
+
 #include "flutter/fml/macros.h"
+#include "impeller/geometry/rect.h"
 #include "impeller/toolkit/egl/egl.h"
 
 namespace impeller {
 namespace egl {
 
+//------------------------------------------------------------------------------
+/// @brief      An EGL surface.
+///
+///             For window surfaces on displays with `EGL_EXT_buffer_age`, the
+///             surface tracks the damage of the frames it presented, so that
+///             only the parts of a back buffer that are out of date have to
+///             be repainted. `EGL_KHR_partial_update` and
+///             `EGL_KHR_swap_buffers_with_damage` are used to tell the driver
+///             and the compositor about the damage when available.
+///
+///             Rectangles are in Impeller coordinates, with the origin at the
+///             top left of the surface.
+///
 class Surface {
  public:
   Surface(EGLDisplay display, EGLSurface surface);
@@ -20,11 +37,52 @@ class Surface {
 
   const EGLSurface& GetHandle() const;
 
-  bool Present() const;
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the contents of back buffers are tracked, so that
+  ///             frames can be repainted partially.
+  ///
+  bool SupportsPartialRepaint() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The part of the current back buffer that differs from the
+  ///             last presented frame. Must be called with the surface
+  ///             current.
+  ///
+  /// @return     The damage, which is empty if the back buffer holds the last
+  ///             presented frame, or `std::nullopt` if the whole buffer has to
+  ///             be repainted.
+  ///
+  std::optional<IRect> GetExistingDamage() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Limits the rendering into the back buffer to |region|. Must
+  ///             be called before rendering into the back buffer.
+  ///
+  void SetDamageRegion(const std::optional<IRect>& region) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Presents the back buffer.
+  ///
+  /// @param[in]  damage  The part of the frame that differs from the previous
+  ///                     frame, or `std::nullopt` if all of it may differ.
+  ///
+  bool Present(const std::optional<IRect>& damage = std::nullopt);
 
  private:
+  // The number of presented frames whose damage is tracked. Drivers rarely
+  // use more than triple buffering.
+  static constexpr size_t kMaxDamageHistory = 4u;
+
   EGLDisplay display_ = EGL_NO_DISPLAY;
   EGLSurface surface_ = EGL_NO_SURFACE;
+  bool supports_buffer_age_ = false;
+  PFNEGLSETDAMAGEREGIONKHRPROC set_damage_region_ = nullptr;
+  PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC swap_buffers_with_damage_ = nullptr;
+  // The damage of the most recently presented frames, newest first. Frames
+  // that may have differed everywhere have no damage rectangle.
+  std::deque<std::optional<IRect>> damage_history_;
+
+  ISize GetSize() const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(Surface);
 };
@@ -4,6 +4,7 @@
 
 #include "impeller/typographer/backends/skia/glyph_atlas_context_skia.h"
 
+#include "impeller/typographer/backends/skia/glyph_rasterization_skia.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 
 namespace impeller {
@@ -18,6 +19,17 @@ std::shared_ptr<SkBitmap> GlyphAtlasContextSkia::GetBitmap() const {
 
 void GlyphAtlasContextSkia::UpdateBitmap(std::shared_ptr<SkBitmap> bitmap) {
   bitmap_ = std::move(bitmap);
+  pending_rasterizations_.clear();
+}
+
+void GlyphAtlasContextSkia::AddPendingRasterization(
+    std::shared_ptr<GlyphRasterizationSkia> rasterization) {
+  pending_rasterizations_.push_back(std::move(rasterization));
+}
+
+std::vector<std::shared_ptr<GlyphRasterizationSkia>>
+GlyphAtlasContextSkia::TakePendingRasterizations() {
+  return std::move(pending_rasterizations_);
 }
 
 }  // namespace impeller
@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "impeller/base/backend_cast.h"
 #include "impeller/typographer/glyph_atlas.h"
 
@@ -11,6 +14,8 @@ class SkBitmap;
 
 namespace impeller {
 
+class GlyphRasterizationSkia;
+
 //------------------------------------------------------------------------------
 /// @brief      A container for caching a glyph atlas across frames.
 ///
@@ -26,10 +31,25 @@ class GlyphAtlasContextSkia
   /// @brief      Retrieve the previous (if any) SkBitmap instance.
   std::shared_ptr<SkBitmap> GetBitmap() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Replace the bitmap. Rasterizations pending for the previous
+  ///             bitmap are dropped.
   void UpdateBitmap(std::shared_ptr<SkBitmap> bitmap);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Track glyphs that are rasterized on worker threads and that
+  ///             still need to be copied into the current bitmap.
+  void AddPendingRasterization(
+      std::shared_ptr<GlyphRasterizationSkia> rasterization);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Remove and return all pending rasterizations.
+  std::vector<std::shared_ptr<GlyphRasterizationSkia>>
+  TakePendingRasterizations();
+
  private:
   std::shared_ptr<SkBitmap> bitmap_;
+  std::vector<std::shared_ptr<GlyphRasterizationSkia>> pending_rasterizations_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(GlyphAtlasContextSkia);
 };
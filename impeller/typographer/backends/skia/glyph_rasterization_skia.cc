@@ -0,0 +1,172 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/typographer/backends/skia/glyph_rasterization_skia.h"
+
+#include <algorithm>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/typographer/backends/skia/typeface_skia.h"
+#include "impeller/typographer/signed_distance_field.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkFont.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace impeller {
+
+GlyphRasterizationSkia::GlyphRasterizationSkia(
+    GlyphAtlas::Type type,
+    const std::vector<FontGlyphPair>& pairs,
+    const std::vector<Rect>& positions,
+    size_t glyphs_per_batch)
+    : type_(type), glyphs_per_batch_(std::max(glyphs_per_batch, size_t{1u})) {
+  FML_DCHECK(pairs.size() == positions.size());
+  entries_.reserve(pairs.size());
+  for (size_t i = 0; i < pairs.size(); i++) {
+    entries_.push_back(
+        {pairs[i].scaled_font, pairs[i].glyph, positions[i], SkBitmap{}});
+  }
+  remaining_batches_ = GetBatchCount();
+  if (remaining_batches_ == 0u) {
+    completion_event_.Signal();
+  }
+}
+
+GlyphRasterizationSkia::~GlyphRasterizationSkia() = default;
+
+void GlyphRasterizationSkia::DrawGlyph(SkCanvas* canvas,
+                                       const ScaledFont& scaled_font,
+                                       const Glyph& glyph,
+                                       const Rect& location,
+                                       bool has_color) {
+  const auto& metrics = scaled_font.font.GetMetrics();
+  const auto position = SkPoint::Make(location.origin.x / scaled_font.scale,
+                                      location.origin.y / scaled_font.scale);
+  SkGlyphID glyph_id = glyph.index;
+
+  SkFont sk_font(
+      TypefaceSkia::Cast(*scaled_font.font.GetTypeface()).GetSkiaTypeface(),
+      metrics.point_size, metrics.scaleX, metrics.skewX);
+  sk_font.setEdging(SkFont::Edging::kAntiAlias);
+  sk_font.setHinting(SkFontHinting::kSlight);
+  sk_font.setEmbolden(metrics.embolden);
+
+  auto glyph_color = has_color ? SK_ColorWHITE : SK_ColorBLACK;
+
+  SkPaint glyph_paint;
+  glyph_paint.setColor(glyph_color);
+  canvas->resetMatrix();
+  canvas->scale(scaled_font.scale, scaled_font.scale);
+  canvas->drawGlyphs(1u,         // count
+                     &glyph_id,  // glyphs
+                     &position,  // positions
+                     SkPoint::Make(-glyph.bounds.GetLeft(),
+                                   -glyph.bounds.GetTop()),  // origin
+                     sk_font,                                // font
+                     glyph_paint                             // paint
+  );
+}
+
+void GlyphRasterizationSkia::RasterizeGlyph(SkBitmap& bitmap,
+                                            SkCanvas* canvas,
+                                            const ScaledFont& scaled_font,
+                                            const Glyph& glyph,
+                                            const Rect& location,
+                                            GlyphAtlas::Type type) {
+  if (type != GlyphAtlas::Type::kSignedDistanceField) {
+    DrawGlyph(canvas, scaled_font, glyph, location,
+              type == GlyphAtlas::Type::kColorBitmap);
+    return;
+  }
+
+  // The spread around the glyph must start out blank.
+  const auto bounds = SkIRect::MakeXYWH(
+      static_cast<int32_t>(location.origin.x),
+      static_cast<int32_t>(location.origin.y),
+      static_cast<int32_t>(location.size.width),
+      static_cast<int32_t>(location.size.height));
+  bitmap.erase(SK_ColorTRANSPARENT, bounds);
+  DrawGlyph(canvas, scaled_font, glyph,
+            location.Expand(-GlyphAtlas::kSignedDistanceFieldSpread), false);
+
+  SkPixmap pixmap;
+  if (!bitmap.pixmap().extractSubset(&pixmap, bounds)) {
+    return;
+  }
+  ConvertToSignedDistanceField(pixmap.writable_addr8(0, 0),
+                               ISize(pixmap.width(), pixmap.height()),
+                               pixmap.rowBytes(),
+                               GlyphAtlas::kSignedDistanceFieldSpread);
+}
+
+size_t GlyphRasterizationSkia::GetBatchCount() const {
+  return (entries_.size() + glyphs_per_batch_ - 1) / glyphs_per_batch_;
+}
+
+void GlyphRasterizationSkia::RasterizeAvailableBatches() {
+  const auto batch_count = GetBatchCount();
+  while (true) {
+    auto batch = next_batch_.fetch_add(1u, std::memory_order_relaxed);
+    if (batch >= batch_count) {
+      return;
+    }
+    RasterizeBatch(batch);
+    if (remaining_batches_.fetch_sub(1u, std::memory_order_acq_rel) == 1u) {
+      completion_event_.Signal();
+    }
+  }
+}
+
+void GlyphRasterizationSkia::RasterizeBatch(size_t batch) {
+  TRACE_EVENT0("impeller", "GlyphRasterizationSkia::RasterizeBatch");
+  const bool has_color = type_ == GlyphAtlas::Type::kColorBitmap;
+  const auto begin = entries_.begin() + batch * glyphs_per_batch_;
+  const auto end = entries_.begin() +
+                   std::min(entries_.size(), (batch + 1) * glyphs_per_batch_);
+  for (auto it = begin; it != end; ++it) {
+    auto& entry = *it;
+    const auto size = ISize::Ceil(entry.location.size);
+    if (size.IsEmpty()) {
+      continue;
+    }
+    const auto image_info =
+        has_color ? SkImageInfo::MakeN32Premul(size.width, size.height)
+                  : SkImageInfo::MakeA8(size.width, size.height);
+    if (!entry.bitmap.tryAllocPixels(image_info)) {
+      continue;
+    }
+    entry.bitmap.eraseColor(SK_ColorTRANSPARENT);
+    auto surface = SkSurfaces::WrapPixels(entry.bitmap.pixmap());
+    if (!surface || !surface->getCanvas()) {
+      entry.bitmap.reset();
+      continue;
+    }
+    RasterizeGlyph(entry.bitmap, surface->getCanvas(), entry.scaled_font,
+                   entry.glyph, Rect::MakeSize(entry.location.size), type_);
+  }
+}
+
+bool GlyphRasterizationSkia::IsComplete() const {
+  return remaining_batches_.load(std::memory_order_acquire) == 0u;
+}
+
+void GlyphRasterizationSkia::Wait() {
+  completion_event_.Wait();
+}
+
+void GlyphRasterizationSkia::CopyToBitmap(SkBitmap& bitmap) const {
+  TRACE_EVENT0("impeller", "GlyphRasterizationSkia::CopyToBitmap");
+  FML_DCHECK(IsComplete());
+  for (const auto& entry : entries_) {
+    if (entry.bitmap.drawsNothing()) {
+      continue;
+    }
+    bitmap.writePixels(entry.bitmap.pixmap(),
+                       static_cast<int>(entry.location.origin.x),
+                       static_cast<int>(entry.location.origin.y));
+  }
+}
+
+}  // namespace impeller
@@ -0,0 +1,121 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "impeller/typographer/font_glyph_pair.h"
+#include "impeller/typographer/glyph_atlas.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+
+class SkCanvas;
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Glyphs that are rasterized into bitmaps of their own before
+///             being copied into the bitmap of a glyph atlas.
+///
+///             The glyphs are split into batches. Any number of threads may
+///             claim and rasterize batches concurrently. This allows the
+///             raster thread to hand off rasterization to worker threads and
+///             to only copy the results into the atlas bitmap, or to help the
+///             workers when it has to wait for the glyphs anyway.
+///
+class GlyphRasterizationSkia {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Create a rasterization for the given glyphs. The glyphs are
+  ///             copied, so the pairs do not need to outlive the result.
+  ///
+  /// @param[in]  type             The type of the destination atlas.
+  /// @param[in]  pairs            The glyphs to rasterize.
+  /// @param[in]  positions        The locations of the glyphs in the atlas.
+  ///                              Must have the same size as `pairs`.
+  /// @param[in]  glyphs_per_batch The number of glyphs claimed at a time.
+  ///
+  GlyphRasterizationSkia(GlyphAtlas::Type type,
+                         const std::vector<FontGlyphPair>& pairs,
+                         const std::vector<Rect>& positions,
+                         size_t glyphs_per_batch);
+
+  ~GlyphRasterizationSkia();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Draw a single glyph so that its origin is at the top left of
+  ///             the given location.
+  ///
+  static void DrawGlyph(SkCanvas* canvas,
+                        const ScaledFont& scaled_font,
+                        const Glyph& glyph,
+                        const Rect& location,
+                        bool has_color);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Draw a single glyph into the given location of a bitmap in
+  ///             the representation used by atlases of the given type.
+  ///
+  ///             For signed distance field atlases, the glyph is inset by the
+  ///             spread and the whole location is converted to a distance
+  ///             field afterwards.
+  ///
+  /// @param      bitmap    The bitmap the canvas draws into.
+  /// @param      canvas    A canvas drawing into the bitmap.
+  ///
+  static void RasterizeGlyph(SkBitmap& bitmap,
+                             SkCanvas* canvas,
+                             const ScaledFont& scaled_font,
+                             const Glyph& glyph,
+                             const Rect& location,
+                             GlyphAtlas::Type type);
+
+  size_t GetBatchCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Claim and rasterize batches until no unclaimed batches are
+  ///             left. Thread safe.
+  ///
+  void RasterizeAvailableBatches();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether all batches have been rasterized. Thread safe.
+  ///
+  bool IsComplete() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Block until all batches have been rasterized. Thread safe.
+  ///
+  void Wait();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Copy the rasterized glyphs into the atlas bitmap. May only be
+  ///             called once the rasterization is complete.
+  ///
+  void CopyToBitmap(SkBitmap& bitmap) const;
+
+ private:
+  struct Entry {
+    ScaledFont scaled_font;
+    Glyph glyph;
+    Rect location;
+    SkBitmap bitmap;
+  };
+
+  const GlyphAtlas::Type type_;
+  const size_t glyphs_per_batch_;
+  std::vector<Entry> entries_;
+  std::atomic_size_t next_batch_ = 0u;
+  std::atomic_size_t remaining_batches_;
+  fml::ManualResetWaitableEvent completion_event_;
+
+  void RasterizeBatch(size_t batch);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GlyphRasterizationSkia);
+};
+
+}  // namespace impeller
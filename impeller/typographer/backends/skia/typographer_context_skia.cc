@@ -12,12 +12,11 @@
 #include "impeller/base/allocation.h"
 #include "impeller/core/allocator.h"
 #include "impeller/typographer/backends/skia/glyph_atlas_context_skia.h"
-#include "impeller/typographer/backends/skia/typeface_skia.h"
+#include "impeller/typographer/backends/skia/glyph_rasterization_skia.h"
 #include "impeller/typographer/rectangle_packer.h"
 #include "impeller/typographer/typographer_context.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkCanvas.h"
-#include "third_party/skia/include/core/SkFont.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
 namespace impeller {
@@ -27,12 +26,38 @@ namespace impeller {
 //              https://github.com/flutter/flutter/issues/114563
 constexpr auto kPadding = 2;
 
+// The number of glyphs a worker claims at a time. Small batches keep all
+// workers busy when only a few glyphs are added.
+constexpr size_t kGlyphsPerRasterizationBatch = 8u;
+
+// Below this number of glyphs, handing them off to workers costs more than
+// drawing them directly. Only used when rasterization is not deferred.
+constexpr size_t kMinGlyphsForWorkerRasterization = 32u;
+
+// The number of updates that must not have used a glyph before it may be
+// evicted. Frames of the last few updates might still be in flight and
+// sample the glyph from the texture that is updated in place.
+constexpr uint64_t kMinGlyphEvictionAge = 3u;
+
 std::shared_ptr<TypographerContext> TypographerContextSkia::Make() {
   return std::make_shared<TypographerContextSkia>();
 }
 
+std::shared_ptr<TypographerContext> TypographerContextSkia::Make(
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner,
+    bool defer_rasterization) {
+  return std::make_shared<TypographerContextSkia>(std::move(worker_task_runner),
+                                                  defer_rasterization);
+}
+
 TypographerContextSkia::TypographerContextSkia() = default;
 
+TypographerContextSkia::TypographerContextSkia(
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner,
+    bool defer_rasterization)
+    : worker_task_runner_(std::move(worker_task_runner)),
+      defer_rasterization_(worker_task_runner_ && defer_rasterization) {}
+
 TypographerContextSkia::~TypographerContextSkia() = default;
 
 std::shared_ptr<GlyphAtlasContext>
@@ -40,8 +65,24 @@ TypographerContextSkia::CreateGlyphAtlasContext() const {
   return std::make_shared<GlyphAtlasContextSkia>();
 }
 
+// The size of the location of a glyph in an atlas of the given type, without
+// the padding between glyphs.
+static ISize ComputeGlyphSize(const FontGlyphPair& pair,
+                              GlyphAtlas::Type type) {
+  auto glyph_size =
+      ISize::Ceil(pair.glyph.bounds.size * pair.scaled_font.scale);
+  if (type == GlyphAtlas::Type::kSignedDistanceField) {
+    const auto spread =
+        static_cast<int64_t>(GlyphAtlas::kSignedDistanceFieldSpread);
+    glyph_size = ISize(glyph_size.width + 2 * spread,
+                       glyph_size.height + 2 * spread);
+  }
+  return glyph_size;
+}
+
 static size_t PairsFitInAtlasOfSize(
     const std::vector<FontGlyphPair>& pairs,
+    GlyphAtlas::Type type,
     const ISize& atlas_size,
     std::vector<Rect>& glyph_positions,
     const std::shared_ptr<RectanglePacker>& rect_packer) {
@@ -56,8 +97,7 @@ static size_t PairsFitInAtlasOfSize(
   for (auto it = pairs.begin(); it != pairs.end(); ++i, ++it) {
     const auto& pair = *it;
 
-    const auto glyph_size =
-        ISize::Ceil(pair.glyph.bounds.size * pair.scaled_font.scale);
+    const auto glyph_size = ComputeGlyphSize(pair, type);
     IPoint16 location_in_atlas;
     if (!rect_packer->addRect(glyph_size.width + kPadding,   //
                               glyph_size.height + kPadding,  //
@@ -94,8 +134,7 @@ static bool CanAppendToExistingAtlas(
   for (size_t i = 0; i < extra_pairs.size(); i++) {
     const FontGlyphPair& pair = extra_pairs[i];
 
-    const auto glyph_size =
-        ISize::Ceil(pair.glyph.bounds.size * pair.scaled_font.scale);
+    const auto glyph_size = ComputeGlyphSize(pair, atlas->GetType());
     IPoint16 location_in_atlas;
     if (!rect_packer->addRect(glyph_size.width + kPadding,   //
                               glyph_size.height + kPadding,  //
@@ -113,6 +152,52 @@ static bool CanAppendToExistingAtlas(
   return true;
 }
 
+static void FreeGlyphLocation(RectanglePacker& rect_packer,
+                              const Rect& location) {
+  rect_packer.freeRect(static_cast<int>(location.origin.x),
+                       static_cast<int>(location.origin.y),
+                       static_cast<int>(location.size.width) + kPadding,
+                       static_cast<int>(location.size.height) + kPadding);
+}
+
+// Makes room for the extra pairs by evicting the least recently used glyphs
+// from the atlas. Locations the extra pairs were given by a failed append are
+// released as well. Unless evicting all eligible glyphs, this stops once twice
+// the area of the extra pairs is free to leave some slack for fragmentation.
+//
+// Returns true if any glyph was evicted.
+static bool EvictColdGlyphs(GlyphAtlas& atlas,
+                            const std::vector<FontGlyphPair>& extra_pairs,
+                            std::vector<Rect>& glyph_positions,
+                            const std::shared_ptr<RectanglePacker>& rect_packer,
+                            bool evict_all) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  if (!rect_packer) {
+    return false;
+  }
+  for (const auto& position : glyph_positions) {
+    FreeGlyphLocation(*rect_packer, position);
+  }
+  glyph_positions.clear();
+
+  int64_t needed_area = 0;
+  for (const FontGlyphPair& pair : extra_pairs) {
+    const auto glyph_size = ComputeGlyphSize(pair, atlas.GetType());
+    needed_area += static_cast<int64_t>(glyph_size.width + kPadding) *
+                   (glyph_size.height + kPadding);
+  }
+  int64_t freed_area = 0;
+  return atlas.EvictGlyphs(
+             kMinGlyphEvictionAge,
+             [&](const Rect& location) {
+               FreeGlyphLocation(*rect_packer, location);
+               freed_area +=
+                   static_cast<int64_t>(location.size.width + kPadding) *
+                   (location.size.height + kPadding);
+               return evict_all || freed_area < 2 * needed_area;
+             }) > 0u;
+}
+
 static ISize OptimumAtlasSizeForFontGlyphPairs(
     const std::vector<FontGlyphPair>& pairs,
     std::vector<Rect>& glyph_positions,
@@ -124,16 +209,16 @@ static ISize OptimumAtlasSizeForFontGlyphPairs(
 
   TRACE_EVENT0("impeller", __FUNCTION__);
 
-  ISize current_size = type == GlyphAtlas::Type::kAlphaBitmap
-                           ? ISize(kMinAlphaBitmapSize, kMinAlphaBitmapSize)
-                           : ISize(kMinAtlasSize, kMinAtlasSize);
+  ISize current_size = type == GlyphAtlas::Type::kColorBitmap
+                           ? ISize(kMinAtlasSize, kMinAtlasSize)
+                           : ISize(kMinAlphaBitmapSize, kMinAlphaBitmapSize);
   size_t total_pairs = pairs.size() + 1;
   do {
     auto rect_packer = std::shared_ptr<RectanglePacker>(
         RectanglePacker::Factory(current_size.width, current_size.height));
 
-    auto remaining_pairs = PairsFitInAtlasOfSize(pairs, current_size,
-                                                 glyph_positions, rect_packer);
+    auto remaining_pairs = PairsFitInAtlasOfSize(
+        pairs, type, current_size, glyph_positions, rect_packer);
     if (remaining_pairs == 0) {
       atlas_context->UpdateRectPacker(rect_packer);
       return current_size;
@@ -152,39 +237,6 @@ static ISize OptimumAtlasSizeForFontGlyphPairs(
   return ISize{0, 0};
 }
 
-static void DrawGlyph(SkCanvas* canvas,
-                      const ScaledFont& scaled_font,
-                      const Glyph& glyph,
-                      const Rect& location,
-                      bool has_color) {
-  const auto& metrics = scaled_font.font.GetMetrics();
-  const auto position = SkPoint::Make(location.origin.x / scaled_font.scale,
-                                      location.origin.y / scaled_font.scale);
-  SkGlyphID glyph_id = glyph.index;
-
-  SkFont sk_font(
-      TypefaceSkia::Cast(*scaled_font.font.GetTypeface()).GetSkiaTypeface(),
-      metrics.point_size, metrics.scaleX, metrics.skewX);
-  sk_font.setEdging(SkFont::Edging::kAntiAlias);
-  sk_font.setHinting(SkFontHinting::kSlight);
-  sk_font.setEmbolden(metrics.embolden);
-
-  auto glyph_color = has_color ? SK_ColorWHITE : SK_ColorBLACK;
-
-  SkPaint glyph_paint;
-  glyph_paint.setColor(glyph_color);
-  canvas->resetMatrix();
-  canvas->scale(scaled_font.scale, scaled_font.scale);
-  canvas->drawGlyphs(1u,         // count
-                     &glyph_id,  // glyphs
-                     &position,  // positions
-                     SkPoint::Make(-glyph.bounds.GetLeft(),
-                                   -glyph.bounds.GetTop()),  // origin
-                     sk_font,                                // font
-                     glyph_paint                             // paint
-  );
-}
-
 static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
                               const std::shared_ptr<SkBitmap>& bitmap,
                               const std::vector<FontGlyphPair>& new_pairs) {
@@ -200,26 +252,26 @@ static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
     return false;
   }
 
-  bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
-
   for (const FontGlyphPair& pair : new_pairs) {
     auto pos = atlas.FindFontGlyphBounds(pair);
     if (!pos.has_value()) {
       continue;
     }
-    DrawGlyph(canvas, pair.scaled_font, pair.glyph, pos.value(), has_color);
+    GlyphRasterizationSkia::RasterizeGlyph(*bitmap, canvas, pair.scaled_font,
+                                           pair.glyph, pos.value(),
+                                           atlas.GetType());
   }
   return true;
 }
 
-static std::shared_ptr<SkBitmap> CreateAtlasBitmap(const GlyphAtlas& atlas,
-                                                   const ISize& atlas_size) {
-  TRACE_EVENT0("impeller", __FUNCTION__);
+static std::shared_ptr<SkBitmap> AllocateAtlasBitmap(GlyphAtlas::Type type,
+                                                     const ISize& atlas_size) {
   auto bitmap = std::make_shared<SkBitmap>();
   SkImageInfo image_info;
 
-  switch (atlas.GetType()) {
+  switch (type) {
     case GlyphAtlas::Type::kAlphaBitmap:
+    case GlyphAtlas::Type::kSignedDistanceField:
       image_info = SkImageInfo::MakeA8(atlas_size.width, atlas_size.height);
       break;
     case GlyphAtlas::Type::kColorBitmap:
@@ -231,6 +283,16 @@ static std::shared_ptr<SkBitmap> CreateAtlasBitmap(const GlyphAtlas& atlas,
   if (!bitmap->tryAllocPixels(image_info)) {
     return nullptr;
   }
+  return bitmap;
+}
+
+static std::shared_ptr<SkBitmap> CreateAtlasBitmap(const GlyphAtlas& atlas,
+                                                   const ISize& atlas_size) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  auto bitmap = AllocateAtlasBitmap(atlas.GetType(), atlas_size);
+  if (!bitmap) {
+    return nullptr;
+  }
 
   auto surface = SkSurfaces::WrapPixels(bitmap->pixmap());
   if (!surface) {
@@ -241,18 +303,55 @@ static std::shared_ptr<SkBitmap> CreateAtlasBitmap(const GlyphAtlas& atlas,
     return nullptr;
   }
 
-  bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
+  const auto type = atlas.GetType();
 
-  atlas.IterateGlyphs([canvas, has_color](const ScaledFont& scaled_font,
-                                          const Glyph& glyph,
-                                          const Rect& location) -> bool {
-    DrawGlyph(canvas, scaled_font, glyph, location, has_color);
+  atlas.IterateGlyphs([&bitmap, canvas, type](const ScaledFont& scaled_font,
+                                              const Glyph& glyph,
+                                              const Rect& location) -> bool {
+    GlyphRasterizationSkia::RasterizeGlyph(*bitmap, canvas, scaled_font, glyph,
+                                           location, type);
     return true;
   });
 
   return bitmap;
 }
 
+static SkIRect ToSkIRect(const Rect& rect) {
+  return SkIRect::MakeXYWH(static_cast<int32_t>(rect.origin.x),
+                           static_cast<int32_t>(rect.origin.y),
+                           static_cast<int32_t>(rect.size.width),
+                           static_cast<int32_t>(rect.size.height));
+}
+
+// Clears the padded locations of glyphs that replace evicted ones. Glyphs are
+// drawn over the previous contents.
+static void ClearGlyphLocations(SkBitmap& bitmap,
+                                const std::vector<Rect>& locations) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  for (const auto& location : locations) {
+    auto padded = ToSkIRect(location);
+    padded.fRight += kPadding;
+    padded.fBottom += kPadding;
+    bitmap.erase(SK_ColorTRANSPARENT, padded);
+  }
+}
+
+// Copies glyphs from the bitmap of a previous atlas. This is much cheaper than
+// rasterizing them again.
+static void CopyGlyphs(const SkBitmap& from,
+                       SkBitmap& to,
+                       const std::vector<std::pair<Rect, Rect>>& locations) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  for (const auto& [from_location, to_location] : locations) {
+    SkPixmap pixmap;
+    if (!from.pixmap().extractSubset(&pixmap, ToSkIRect(from_location))) {
+      continue;
+    }
+    to.writePixels(pixmap, static_cast<int>(to_location.origin.x),
+                   static_cast<int>(to_location.origin.y));
+  }
+}
+
 static bool UpdateGlyphTextureAtlas(std::shared_ptr<SkBitmap> bitmap,
                                     const std::shared_ptr<Texture>& texture) {
   TRACE_EVENT0("impeller", __FUNCTION__);
@@ -310,6 +409,97 @@ static std::shared_ptr<Texture> UploadGlyphTextureAtlas(
   return texture;
 }
 
+// Copies glyphs that finished rasterizing on the workers since the last update
+// into the atlas. Glyphs the workers have not started on yet are rasterized
+// now, so that workers that are busy with other tasks delay them by at most
+// one update.
+static bool ApplyPendingRasterizations(GlyphAtlasContextSkia& atlas_context,
+                                       const GlyphAtlas& atlas) {
+  auto pending = atlas_context.TakePendingRasterizations();
+  if (pending.empty() || !atlas.GetTexture()) {
+    return true;
+  }
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  auto bitmap = atlas_context.GetBitmap();
+  bool bitmap_updated = false;
+  for (auto& rasterization : pending) {
+    rasterization->RasterizeAvailableBatches();
+    if (!rasterization->IsComplete()) {
+      atlas_context.AddPendingRasterization(std::move(rasterization));
+      continue;
+    }
+    rasterization->CopyToBitmap(*bitmap);
+    bitmap_updated = true;
+  }
+  if (!bitmap_updated) {
+    return true;
+  }
+  return UpdateGlyphTextureAtlas(bitmap, atlas.GetTexture());
+}
+
+// Waits for the glyphs that are still being rasterized on the workers and
+// copies them into the bitmap. The texture is not updated.
+static void FinishPendingRasterizations(GlyphAtlasContextSkia& atlas_context) {
+  auto pending = atlas_context.TakePendingRasterizations();
+  if (pending.empty()) {
+    return;
+  }
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  auto bitmap = atlas_context.GetBitmap();
+  for (auto& rasterization : pending) {
+    rasterization->RasterizeAvailableBatches();
+    rasterization->Wait();
+    rasterization->CopyToBitmap(*bitmap);
+  }
+}
+
+bool TypographerContextSkia::ShouldRasterizeOnWorkers(
+    size_t glyph_count) const {
+  if (!worker_task_runner_ || glyph_count == 0u) {
+    return false;
+  }
+  return defer_rasterization_ ||
+         glyph_count >= kMinGlyphsForWorkerRasterization;
+}
+
+// Returns true if the glyphs are in the bitmap on return and false if they are
+// added to the bitmap by a later update.
+bool TypographerContextSkia::RasterizeOnWorkers(
+    GlyphAtlasContextSkia& atlas_context,
+    GlyphAtlas::Type type,
+    SkBitmap& bitmap,
+    const std::vector<FontGlyphPair>& pairs,
+    const std::vector<Rect>& positions) const {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  auto rasterization = std::make_shared<GlyphRasterizationSkia>(
+      type, pairs, positions, kGlyphsPerRasterizationBatch);
+
+  // Unless rasterization is deferred, this thread claims batches as well.
+  // Waiting on workers that are still busy with other tasks doesn't block
+  // the update because this thread takes over their batches.
+  size_t task_count = rasterization->GetBatchCount();
+  if (!defer_rasterization_) {
+    task_count--;
+  }
+  for (size_t i = 0; i < task_count; i++) {
+    worker_task_runner_->PostTask(
+        [rasterization]() { rasterization->RasterizeAvailableBatches(); });
+  }
+
+  if (defer_rasterization_) {
+    atlas_context.AddPendingRasterization(std::move(rasterization));
+    return false;
+  }
+
+  rasterization->RasterizeAvailableBatches();
+  {
+    TRACE_EVENT0("impeller", "WaitForGlyphRasterization");
+    rasterization->Wait();
+  }
+  rasterization->CopyToBitmap(bitmap);
+  return true;
+}
+
 std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
     Context& context,
     GlyphAtlas::Type type,
@@ -322,6 +512,10 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   auto& atlas_context_skia = GlyphAtlasContextSkia::Cast(*atlas_context);
   std::shared_ptr<GlyphAtlas> last_atlas = atlas_context->GetGlyphAtlas();
 
+  if (!ApplyPendingRasterizations(atlas_context_skia, *last_atlas)) {
+    return nullptr;
+  }
+
   if (font_glyph_map.empty()) {
     return last_atlas;
   }
@@ -330,22 +524,11 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   // Step 1: Determine if the atlas type and font glyph pairs are compatible
   //         with the current atlas and reuse if possible.
   // ---------------------------------------------------------------------------
+  last_atlas->IncrementGeneration();
   std::vector<FontGlyphPair> new_glyphs;
   for (const auto& font_value : font_glyph_map) {
-    const ScaledFont& scaled_font = font_value.first;
-    const FontGlyphAtlas* font_glyph_atlas =
-        last_atlas->GetFontGlyphAtlas(scaled_font.font, scaled_font.scale);
-    if (font_glyph_atlas) {
-      for (const Glyph& glyph : font_value.second) {
-        if (!font_glyph_atlas->FindGlyphBounds(glyph)) {
-          new_glyphs.emplace_back(scaled_font, glyph);
-        }
-      }
-    } else {
-      for (const Glyph& glyph : font_value.second) {
-        new_glyphs.emplace_back(scaled_font, glyph);
-      }
-    }
+    last_atlas->MarkGlyphsUsed(font_value.first, font_value.second,
+                               new_glyphs);
   }
   if (last_atlas->GetType() == type && new_glyphs.size() == 0) {
     return last_atlas;
@@ -354,13 +537,35 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   // ---------------------------------------------------------------------------
   // Step 2: Determine if the additional missing glyphs can be appended to the
   //         existing bitmap without recreating the atlas. This requires that
-  //         the type is identical.
+  //         the type is identical. If the atlas is full, glyphs that have not
+  //         been used for a while are evicted to make room.
   // ---------------------------------------------------------------------------
   std::vector<Rect> glyph_positions;
-  if (last_atlas->GetType() == type &&
+  bool can_append =
+      last_atlas->GetType() == type &&
       CanAppendToExistingAtlas(last_atlas, new_glyphs, glyph_positions,
                                atlas_context->GetAtlasSize(),
-                               atlas_context->GetRectPacker())) {
+                               atlas_context->GetRectPacker());
+  bool evicted = false;
+  if (!can_append && last_atlas->GetType() == type) {
+    // Evicted locations must not be overwritten by glyphs that are still
+    // being rasterized.
+    FinishPendingRasterizations(atlas_context_skia);
+    for (bool evict_all : {false, true}) {
+      if (!EvictColdGlyphs(*last_atlas, new_glyphs, glyph_positions,
+                           atlas_context->GetRectPacker(), evict_all)) {
+        break;
+      }
+      evicted = true;
+      if (CanAppendToExistingAtlas(last_atlas, new_glyphs, glyph_positions,
+                                   atlas_context->GetAtlasSize(),
+                                   atlas_context->GetRectPacker())) {
+        can_append = true;
+        break;
+      }
+    }
+  }
+  if (can_append) {
     // The old bitmap will be reused and only the additional glyphs will be
     // added.
 
@@ -376,14 +581,24 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
     // Step 4a: Draw new font-glyph pairs into the existing bitmap.
     // ---------------------------------------------------------------------------
     auto bitmap = atlas_context_skia.GetBitmap();
-    if (!UpdateAtlasBitmap(*last_atlas, bitmap, new_glyphs)) {
+    if (evicted) {
+      ClearGlyphLocations(*bitmap, glyph_positions);
+    }
+    bool glyphs_drawn = true;
+    if (ShouldRasterizeOnWorkers(new_glyphs.size())) {
+      glyphs_drawn = RasterizeOnWorkers(atlas_context_skia, type, *bitmap,
+                                        new_glyphs, glyph_positions);
+    } else if (!UpdateAtlasBitmap(*last_atlas, bitmap, new_glyphs)) {
       return nullptr;
     }
 
     // ---------------------------------------------------------------------------
-    // Step 5a: Update the existing texture with the updated bitmap.
+    // Step 5a: Update the existing texture with the updated bitmap. If the
+    // glyphs are drawn later and no evicted glyphs were cleared, the previous
+    // contents are still current.
     // ---------------------------------------------------------------------------
-    if (!UpdateGlyphTextureAtlas(bitmap, last_atlas->GetTexture())) {
+    if ((glyphs_drawn || evicted) &&
+        !UpdateGlyphTextureAtlas(bitmap, last_atlas->GetTexture())) {
       return nullptr;
     }
     return last_atlas;
@@ -433,13 +648,60 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   }
 
   // ---------------------------------------------------------------------------
-  // Step 6b: Draw font-glyph pairs in the correct spot in the atlas.
+  // Step 6b: Draw font-glyph pairs in the correct spot in the atlas. Glyphs
+  // that are in the previous atlas are copied from its bitmap instead.
   // ---------------------------------------------------------------------------
-  auto bitmap = CreateAtlasBitmap(*glyph_atlas, atlas_size);
-  if (!bitmap) {
-    return nullptr;
+  std::shared_ptr<SkBitmap> last_bitmap;
+  if (last_atlas->GetType() == type) {
+    FinishPendingRasterizations(atlas_context_skia);
+    last_bitmap = atlas_context_skia.GetBitmap();
+  }
+  std::vector<std::pair<Rect, Rect>> copied_locations;
+  std::vector<FontGlyphPair> drawn_pairs;
+  std::vector<Rect> drawn_positions;
+  for (size_t i = 0; i < font_glyph_pairs.size(); i++) {
+    std::optional<Rect> last_location;
+    if (last_bitmap) {
+      last_location = last_atlas->FindFontGlyphBounds(font_glyph_pairs[i]);
+    }
+    if (last_location.has_value()) {
+      copied_locations.emplace_back(last_location.value(),
+                                    glyph_positions[i]);
+    } else {
+      drawn_pairs.push_back(font_glyph_pairs[i]);
+      drawn_positions.push_back(glyph_positions[i]);
+    }
+  }
+
+  std::shared_ptr<SkBitmap> bitmap;
+  const bool rasterize_on_workers =
+      ShouldRasterizeOnWorkers(drawn_pairs.size());
+  if (rasterize_on_workers || !copied_locations.empty()) {
+    bitmap = AllocateAtlasBitmap(type, atlas_size);
+    if (!bitmap) {
+      return nullptr;
+    }
+    if (defer_rasterization_) {
+      // The locations of glyphs that are rasterized later must stay blank.
+      bitmap->eraseColor(SK_ColorTRANSPARENT);
+    }
+    if (last_bitmap) {
+      CopyGlyphs(*last_bitmap, *bitmap, copied_locations);
+    }
+    atlas_context_skia.UpdateBitmap(bitmap);
+    if (rasterize_on_workers) {
+      RasterizeOnWorkers(atlas_context_skia, type, *bitmap, drawn_pairs,
+                         drawn_positions);
+    } else if (!UpdateAtlasBitmap(*glyph_atlas, bitmap, drawn_pairs)) {
+      return nullptr;
+    }
+  } else {
+    bitmap = CreateAtlasBitmap(*glyph_atlas, atlas_size);
+    if (!bitmap) {
+      return nullptr;
+    }
+    atlas_context_skia.UpdateBitmap(bitmap);
   }
-  atlas_context_skia.UpdateBitmap(bitmap);
 
   // ---------------------------------------------------------------------------
   // Step 7b: Upload the atlas as a texture.
@@ -447,6 +709,7 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   PixelFormat format;
   switch (type) {
     case GlyphAtlas::Type::kAlphaBitmap:
+    case GlyphAtlas::Type::kSignedDistanceField:
       format = PixelFormat::kA8UNormInt;
       break;
     case GlyphAtlas::Type::kColorBitmap:
@@ -4,17 +4,45 @@
 
 #pragma once
 
+#include <memory>
+
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "impeller/typographer/typographer_context.h"
 
+class SkBitmap;
+
 namespace impeller {
 
+class GlyphAtlasContextSkia;
+
 class TypographerContextSkia : public TypographerContext {
  public:
   static std::shared_ptr<TypographerContext> Make();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Create a typographer context that rasterizes glyphs on the
+  ///             given worker task runner. Only copying the glyphs into the
+  ///             atlas and uploading the atlas happen on the calling thread.
+  ///
+  /// @param[in]  worker_task_runner  The task runner of the worker threads.
+  /// @param[in]  defer_rasterization If true, atlas updates do not wait for
+  ///                                 newly added glyphs to be rasterized.
+  ///                                 Their locations in the atlas stay blank
+  ///                                 until a later update. Glyphs the workers
+  ///                                 have not started on by the next update
+  ///                                 are rasterized by that update.
+  ///
+  static std::shared_ptr<TypographerContext> Make(
+      std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner,
+      bool defer_rasterization);
+
   TypographerContextSkia();
 
+  TypographerContextSkia(
+      std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner,
+      bool defer_rasterization);
+
   ~TypographerContextSkia() override;
 
   // |TypographerContext|
@@ -28,6 +56,17 @@ class TypographerContextSkia : public TypographerContext {
       const FontGlyphMap& font_glyph_map) const override;
 
  private:
+  std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner_;
+  bool defer_rasterization_ = false;
+
+  bool ShouldRasterizeOnWorkers(size_t glyph_count) const;
+
+  bool RasterizeOnWorkers(GlyphAtlasContextSkia& atlas_context,
+                          GlyphAtlas::Type type,
+                          SkBitmap& bitmap,
+                          const std::vector<FontGlyphPair>& pairs,
+                          const std::vector<Rect>& positions) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(TypographerContextSkia);
 };
 
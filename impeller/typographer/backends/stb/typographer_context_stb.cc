@@ -13,6 +13,7 @@
 #include "impeller/core/allocator.h"
 #include "impeller/typographer/backends/stb/glyph_atlas_context_stb.h"
 #include "impeller/typographer/font_glyph_pair.h"
+#include "impeller/typographer/signed_distance_field.h"
 #include "typeface_stb.h"
 
 #define DISABLE_COLOR_FONT_SUPPORT 1
@@ -39,10 +40,21 @@ TypographerContextSTB::CreateGlyphAtlasContext() const {
   return std::make_shared<GlyphAtlasContextSTB>();
 }
 
+// Pads the size of a glyph by the spread of signed distance field atlases.
+static ISize PadGlyphSize(ISize glyph_size, GlyphAtlas::Type type) {
+  if (type != GlyphAtlas::Type::kSignedDistanceField) {
+    return glyph_size;
+  }
+  const auto spread =
+      static_cast<int64_t>(GlyphAtlas::kSignedDistanceFieldSpread);
+  return ISize(glyph_size.width + 2 * spread, glyph_size.height + 2 * spread);
+}
+
 // Function returns the count of "remaining pairs" not packed into rect of given
 // size.
 static size_t PairsFitInAtlasOfSize(
     const std::vector<FontGlyphPair>& pairs,
+    GlyphAtlas::Type type,
     const ISize& atlas_size,
     std::vector<Rect>& glyph_positions,
     const std::shared_ptr<RectanglePacker>& rect_packer) {
@@ -77,7 +89,7 @@ static size_t PairsFitInAtlasOfSize(
       stbtt_GetGlyphBitmapBox(typeface_stb->GetFontInfo(), pair.glyph.index,
                               scale, scale, &x0, &y0, &x1, &y1);
 
-      glyph_size = ISize(x1 - x0, y1 - y0);
+      glyph_size = PadGlyphSize(ISize(x1 - x0, y1 - y0), type);
     }
 
     IPoint16 location_in_atlas;
@@ -136,7 +148,8 @@ static bool CanAppendToExistingAtlas(
       stbtt_GetGlyphBitmapBox(typeface_stb->GetFontInfo(), pair.glyph.index,
                               scale_x, scale_y, &x0, &y0, &x1, &y1);
 
-      glyph_size = ISize(x1 - x0, y1 - y0);
+      glyph_size = PadGlyphSize(ISize(x1 - x0, y1 - y0),
+                                atlas->GetType());
     }
 
     IPoint16 location_in_atlas;
@@ -167,16 +180,16 @@ static ISize OptimumAtlasSizeForFontGlyphPairs(
 
   TRACE_EVENT0("impeller", __FUNCTION__);
 
-  ISize current_size = type == GlyphAtlas::Type::kAlphaBitmap
-                           ? ISize(kMinAlphaBitmapSize, kMinAlphaBitmapSize)
-                           : ISize(kMinAtlasSize, kMinAtlasSize);
+  ISize current_size = type == GlyphAtlas::Type::kColorBitmap
+                           ? ISize(kMinAtlasSize, kMinAtlasSize)
+                           : ISize(kMinAlphaBitmapSize, kMinAlphaBitmapSize);
   size_t total_pairs = pairs.size() + 1;
   do {
     auto rect_packer = std::shared_ptr<RectanglePacker>(
         RectanglePacker::Factory(current_size.width, current_size.height));
 
-    auto remaining_pairs = PairsFitInAtlasOfSize(pairs, current_size,
-                                                 glyph_positions, rect_packer);
+    auto remaining_pairs = PairsFitInAtlasOfSize(
+        pairs, type, current_size, glyph_positions, rect_packer);
     if (remaining_pairs == 0) {
       atlas_context->UpdateRectPacker(rect_packer);
       return current_size;
@@ -270,21 +283,42 @@ static void DrawGlyph(BitmapSTB* bitmap,
   }
 }
 
+// Draws a glyph in the representation used by atlases of the given type. For
+// signed distance field atlases, the glyph is inset by the spread and the
+// whole location is converted to a distance field afterwards.
+static void RasterizeGlyph(BitmapSTB* bitmap,
+                           const ScaledFont& scaled_font,
+                           const Glyph& glyph,
+                           const Rect& location,
+                           GlyphAtlas::Type type) {
+  if (type != GlyphAtlas::Type::kSignedDistanceField) {
+    DrawGlyph(bitmap, scaled_font, glyph, location,
+              type == GlyphAtlas::Type::kColorBitmap);
+    return;
+  }
+  DrawGlyph(bitmap, scaled_font, glyph,
+            location.Expand(-GlyphAtlas::kSignedDistanceFieldSpread), false);
+  ConvertToSignedDistanceField(
+      bitmap->GetPixelAddress({static_cast<size_t>(location.origin.x),
+                               static_cast<size_t>(location.origin.y)}),
+      ISize(static_cast<int64_t>(location.size.width),
+            static_cast<int64_t>(location.size.height)),
+      bitmap->GetRowBytes(), GlyphAtlas::kSignedDistanceFieldSpread);
+}
+
 static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
                               const std::shared_ptr<BitmapSTB>& bitmap,
                               const std::vector<FontGlyphPair>& new_pairs) {
   TRACE_EVENT0("impeller", __FUNCTION__);
   FML_DCHECK(bitmap != nullptr);
 
-  bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
-
   for (const FontGlyphPair& pair : new_pairs) {
     auto pos = atlas.FindFontGlyphBounds(pair);
     if (!pos.has_value()) {
       continue;
     }
-    DrawGlyph(bitmap.get(), pair.scaled_font, pair.glyph, pos.value(),
-              has_color);
+    RasterizeGlyph(bitmap.get(), pair.scaled_font, pair.glyph, pos.value(),
+                   atlas.GetType());
   }
   return true;
 }
@@ -301,12 +335,12 @@ static std::shared_ptr<BitmapSTB> CreateAtlasBitmap(const GlyphAtlas& atlas,
   auto bitmap = std::make_shared<BitmapSTB>(atlas_size.width, atlas_size.height,
                                             bytes_per_pixel);
 
-  bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
+  const auto type = atlas.GetType();
 
-  atlas.IterateGlyphs([&bitmap, has_color](const ScaledFont& scaled_font,
-                                           const Glyph& glyph,
-                                           const Rect& location) -> bool {
-    DrawGlyph(bitmap.get(), scaled_font, glyph, location, has_color);
+  atlas.IterateGlyphs([&bitmap, type](const ScaledFont& scaled_font,
+                                      const Glyph& glyph,
+                                      const Rect& location) -> bool {
+    RasterizeGlyph(bitmap.get(), scaled_font, glyph, location, type);
     return true;
   });
 
@@ -512,6 +546,7 @@ std::shared_ptr<GlyphAtlas> TypographerContextSTB::CreateGlyphAtlas(
   PixelFormat format;
   switch (type) {
     case GlyphAtlas::Type::kAlphaBitmap:
+    case GlyphAtlas::Type::kSignedDistanceField:
       format = PixelFormat::kA8UNormInt;
       break;
     case GlyphAtlas::Type::kColorBitmap:
@@ -4,9 +4,12 @@
 
 #include "impeller/typographer/glyph_atlas.h"
 
+#include <algorithm>
 #include <numeric>
 #include <utility>
 
+#include "flutter/fml/logging.h"
+
 namespace impeller {
 
 GlyphAtlasContext::GlyphAtlasContext()
@@ -60,7 +63,8 @@ void GlyphAtlas::SetTexture(std::shared_ptr<Texture> texture) {
 
 void GlyphAtlas::AddTypefaceGlyphPosition(const FontGlyphPair& pair,
                                           Rect rect) {
-  font_atlas_map_[pair.scaled_font].positions_[pair.glyph] = rect;
+  font_atlas_map_[pair.scaled_font].positions_[pair.glyph] = {rect,
+                                                              generation_};
 }
 
 std::optional<Rect> GlyphAtlas::FindFontGlyphBounds(
@@ -100,7 +104,8 @@ size_t GlyphAtlas::IterateGlyphs(
   for (const auto& font_value : font_atlas_map_) {
     for (const auto& glyph_value : font_value.second.positions_) {
       count++;
-      if (!iterator(font_value.first, glyph_value.first, glyph_value.second)) {
+      if (!iterator(font_value.first, glyph_value.first,
+                    glyph_value.second.position)) {
         return count;
       }
     }
@@ -108,12 +113,95 @@ size_t GlyphAtlas::IterateGlyphs(
   return count;
 }
 
+void GlyphAtlas::IncrementGeneration() {
+  generation_++;
+}
+
+void GlyphAtlas::MarkGlyphsUsed(const ScaledFont& scaled_font,
+                                const std::unordered_set<Glyph>& glyphs,
+                                std::vector<FontGlyphPair>& missing) {
+  auto found = font_atlas_map_.find(scaled_font);
+  if (found == font_atlas_map_.end()) {
+    for (const Glyph& glyph : glyphs) {
+      missing.emplace_back(scaled_font, glyph);
+    }
+    return;
+  }
+  auto& positions = found->second.positions_;
+  for (const Glyph& glyph : glyphs) {
+    auto position = positions.find(glyph);
+    if (position == positions.end()) {
+      missing.emplace_back(scaled_font, glyph);
+    } else {
+      position->second.last_used = generation_;
+    }
+  }
+}
+
+size_t GlyphAtlas::EvictGlyphs(
+    uint64_t min_age,
+    const std::function<bool(const Rect& location)>& callback) {
+  FML_DCHECK(min_age > 0u);
+  if (!callback || generation_ < min_age) {
+    return 0u;
+  }
+  const uint64_t last_evictable = generation_ - min_age;
+
+  struct Candidate {
+    uint64_t last_used;
+    FontGlyphAtlas* font_atlas;
+    Glyph glyph;
+  };
+  std::vector<Candidate> candidates;
+  for (auto& font_value : font_atlas_map_) {
+    for (const auto& glyph_value : font_value.second.positions_) {
+      if (glyph_value.second.last_used <= last_evictable) {
+        candidates.push_back({glyph_value.second.last_used, &font_value.second,
+                              glyph_value.first});
+      }
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(),
+            [](const Candidate& a, const Candidate& b) {
+              return a.last_used < b.last_used;
+            });
+
+  size_t count = 0u;
+  for (const auto& candidate : candidates) {
+    auto& positions = candidate.font_atlas->positions_;
+    auto found = positions.find(candidate.glyph);
+    FML_DCHECK(found != positions.end());
+    auto location = found->second.position;
+    positions.erase(found);
+    count++;
+    if (!callback(location)) {
+      break;
+    }
+  }
+
+  for (auto it = font_atlas_map_.begin(); it != font_atlas_map_.end();) {
+    if (it->second.positions_.empty()) {
+      it = font_atlas_map_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  if (count > 0u) {
+    layout_version_++;
+  }
+  return count;
+}
+
+uint64_t GlyphAtlas::GetLayoutVersion() const {
+  return layout_version_;
+}
+
 std::optional<Rect> FontGlyphAtlas::FindGlyphBounds(const Glyph& glyph) const {
   const auto& found = positions_.find(glyph);
   if (found == positions_.end()) {
     return std::nullopt;
   }
-  return found->second;
+  return found->second.position;
 }
 
 }  // namespace impeller
@@ -8,6 +8,8 @@
 #include <memory>
 #include <optional>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/core/texture.h"
@@ -41,8 +43,29 @@ class GlyphAtlas {
     /// colors.
     ///
     kColorBitmap,
+
+    //--------------------------------------------------------------------------
+    /// The glyphs are represented at |kSignedDistanceFieldFontSize| using an
+    /// 8-bit signed distance field, with the edge of the glyph at half the
+    /// maximum value. The same glyph can be drawn at any larger size.
+    ///
+    kSignedDistanceField,
   };
 
+  //----------------------------------------------------------------------------
+  /// The font size, in atlas pixels, at which glyphs are represented in signed
+  /// distance field atlases. It is also the smallest size at which glyphs are
+  /// drawn from such atlases, so that they are only ever magnified.
+  ///
+  static constexpr Scalar kSignedDistanceFieldFontSize = 64.0f;
+
+  //----------------------------------------------------------------------------
+  /// The distance, in atlas pixels, over which the signed distance field
+  /// ramps from the outside to the inside of a glyph. Glyphs in signed
+  /// distance field atlases are padded by this amount on all sides.
+  ///
+  static constexpr Scalar kSignedDistanceFieldSpread = 8.0f;
+
   //----------------------------------------------------------------------------
   /// @brief      Create an empty glyph atlas.
   ///
@@ -127,9 +150,54 @@ class GlyphAtlas {
   ///
   const FontGlyphAtlas* GetFontGlyphAtlas(const Font& font, Scalar scale) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Start a new update of the atlas. Glyphs remember the last
+  ///             update that used them so that the least recently used glyphs
+  ///             can be evicted once the atlas is full.
+  ///
+  void IncrementGeneration();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Record that glyphs of a font are used by the current update.
+  ///
+  /// @param[in]  scaled_font  The font of the glyphs.
+  /// @param[in]  glyphs       The glyphs.
+  /// @param[out] missing      Pairs for the glyphs that are not in the atlas
+  ///                          are appended to this. They refer to
+  ///                          `scaled_font` and `glyphs`.
+  ///
+  void MarkGlyphsUsed(const ScaledFont& scaled_font,
+                      const std::unordered_set<Glyph>& glyphs,
+                      std::vector<FontGlyphPair>& missing);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Remove the glyphs that were not used by any of the last
+  ///             `min_age` updates, least recently used first.
+  ///
+  /// @param[in]  min_age   The number of updates, including the current one,
+  ///                       that a glyph must not have been used by. Must be
+  ///                       at least 1.
+  /// @param[in]  callback  Called with the location of each removed glyph.
+  ///                       Eviction stops once it returns false.
+  ///
+  /// @return     The number of glyphs removed.
+  ///
+  size_t EvictGlyphs(uint64_t min_age,
+                     const std::function<bool(const Rect& location)>& callback);
+
+  //----------------------------------------------------------------------------
+  /// @brief      A version that changes whenever glyphs are evicted from the
+  ///             atlas. The space of evicted glyphs is reused, so locations
+  ///             looked up in the atlas are only valid while the version is
+  ///             unchanged. Adding glyphs doesn't move the existing ones.
+  ///
+  uint64_t GetLayoutVersion() const;
+
  private:
   const Type type_;
   std::shared_ptr<Texture> texture_;
+  uint64_t generation_ = 0u;
+  uint64_t layout_version_ = 0u;
 
   std::unordered_map<ScaledFont, FontGlyphAtlas> font_atlas_map_;
 
@@ -192,7 +260,14 @@ class FontGlyphAtlas {
 
  private:
   friend class GlyphAtlas;
-  std::unordered_map<Glyph, Rect> positions_;
+
+  struct Entry {
+    Rect position;
+    // The generation of the last update of the atlas that used the glyph.
+    uint64_t last_used;
+  };
+
+  std::unordered_map<Glyph, Entry> positions_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(FontGlyphAtlas);
 };
@@ -4,6 +4,7 @@
 
 #include "impeller/typographer/lazy_glyph_atlas.h"
 
+#include "flutter/fml/metrics.h"
 #include "impeller/base/validation.h"
 #include "impeller/typographer/typographer_context.h"
 
@@ -19,25 +20,45 @@ LazyGlyphAtlas::LazyGlyphAtlas(
                          : nullptr),
       color_context_(typographer_context_
                          ? typographer_context_->CreateGlyphAtlasContext()
-                         : nullptr) {}
+                         : nullptr),
+      sdf_context_(typographer_context_
+                       ? typographer_context_->CreateGlyphAtlasContext()
+                       : nullptr) {}
 
 LazyGlyphAtlas::~LazyGlyphAtlas() = default;
 
 void LazyGlyphAtlas::AddTextFrame(const TextFrame& frame, Scalar scale) {
   FML_DCHECK(atlas_map_.empty());
-  if (frame.GetAtlasType() == GlyphAtlas::Type::kAlphaBitmap) {
-    frame.CollectUniqueFontGlyphPairs(alpha_glyph_map_, scale);
-  } else {
-    frame.CollectUniqueFontGlyphPairs(color_glyph_map_, scale);
+  switch (frame.GetAtlasType(scale)) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+      frame.CollectUniqueFontGlyphPairs(alpha_glyph_map_, scale);
+      break;
+    case GlyphAtlas::Type::kColorBitmap:
+      frame.CollectUniqueFontGlyphPairs(color_glyph_map_, scale);
+      break;
+    case GlyphAtlas::Type::kSignedDistanceField:
+      frame.CollectUniqueFontGlyphPairs(sdf_glyph_map_, scale);
+      break;
   }
 }
 
 void LazyGlyphAtlas::ResetTextFrames() {
   alpha_glyph_map_.clear();
   color_glyph_map_.clear();
+  sdf_glyph_map_.clear();
   atlas_map_.clear();
 }
 
+void LazyGlyphAtlas::ResetGlyphAtlasContexts() {
+  FML_DCHECK(atlas_map_.empty());
+  if (!typographer_context_) {
+    return;
+  }
+  alpha_context_ = typographer_context_->CreateGlyphAtlasContext();
+  color_context_ = typographer_context_->CreateGlyphAtlasContext();
+  sdf_context_ = typographer_context_->CreateGlyphAtlasContext();
+}
+
 std::shared_ptr<GlyphAtlas> LazyGlyphAtlas::CreateOrGetGlyphAtlas(
     Context& context,
     GlyphAtlas::Type type) const {
@@ -59,16 +80,32 @@ std::shared_ptr<GlyphAtlas> LazyGlyphAtlas::CreateOrGetGlyphAtlas(
     return nullptr;
   }
 
-  auto& glyph_map = type == GlyphAtlas::Type::kAlphaBitmap ? alpha_glyph_map_
-                                                           : color_glyph_map_;
-  auto atlas_context =
-      type == GlyphAtlas::Type::kAlphaBitmap ? alpha_context_ : color_context_;
-  auto atlas = typographer_context_->CreateGlyphAtlas(context, type,
-                                                      atlas_context, glyph_map);
+  const FontGlyphMap* glyph_map = nullptr;
+  std::shared_ptr<GlyphAtlasContext> atlas_context;
+  switch (type) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+      glyph_map = &alpha_glyph_map_;
+      atlas_context = alpha_context_;
+      break;
+    case GlyphAtlas::Type::kColorBitmap:
+      glyph_map = &color_glyph_map_;
+      atlas_context = color_context_;
+      break;
+    case GlyphAtlas::Type::kSignedDistanceField:
+      glyph_map = &sdf_glyph_map_;
+      atlas_context = sdf_context_;
+      break;
+  }
+  auto previous_atlas = atlas_context->GetGlyphAtlas();
+  auto atlas = typographer_context_->CreateGlyphAtlas(
+      context, type, atlas_context, *glyph_map);
   if (!atlas || !atlas->IsValid()) {
     VALIDATION_LOG << "Could not create valid atlas.";
     return nullptr;
   }
+  if (atlas != previous_atlas) {
+    FML_COUNTER_INCREMENT("impeller.typographer.glyph_atlas_rebuilds");
+  }
   atlas_map_[type] = atlas;
   return atlas;
 }
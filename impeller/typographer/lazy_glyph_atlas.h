@@ -25,6 +25,14 @@ class LazyGlyphAtlas {
 
   void ResetTextFrames();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Drop the glyph atlases retained for later frames, for example
+  ///             because the system is running low on memory. The atlases are
+  ///             recreated from scratch the next time glyphs are rendered.
+  ///             Must only be called between frames.
+  ///
+  void ResetGlyphAtlasContexts();
+
   std::shared_ptr<GlyphAtlas> CreateOrGetGlyphAtlas(
       Context& context,
       GlyphAtlas::Type type) const;
@@ -34,8 +42,10 @@ class LazyGlyphAtlas {
 
   FontGlyphMap alpha_glyph_map_;
   FontGlyphMap color_glyph_map_;
+  FontGlyphMap sdf_glyph_map_;
   std::shared_ptr<GlyphAtlasContext> alpha_context_;
   std::shared_ptr<GlyphAtlasContext> color_context_;
+  std::shared_ptr<GlyphAtlasContext> sdf_context_;
   mutable std::unordered_map<GlyphAtlas::Type, std::shared_ptr<GlyphAtlas>>
       atlas_map_;
 
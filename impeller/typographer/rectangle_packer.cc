@@ -13,6 +13,10 @@ namespace impeller {
 // Based, in part, on Jukka Jylanki's work at http://clb.demon.fi
 // and ported from Skia's implementation
 // https://github.com/google/skia/blob/b5de4b8ae95c877a9ecfad5eab0765bc22550301/src/gpu/RectanizerSkyline.cpp
+//
+// Freed rectangles are below the skyline and can't be tracked by it. They are
+// kept in a list of free rectangles instead, which is filled first using the
+// guillotine algorithm from the same work.
 class SkylineRectanglePacker final : public RectanglePacker {
  public:
   SkylineRectanglePacker(int w, int h) : RectanglePacker(w, h) {
@@ -25,10 +29,13 @@ class SkylineRectanglePacker final : public RectanglePacker {
     area_so_far_ = 0;
     skyline_.clear();
     skyline_.push_back(SkylineSegment{0, 0, this->width()});
+    free_rects_.clear();
   }
 
   bool addRect(int w, int h, IPoint16* loc) final;
 
+  void freeRect(int x, int y, int w, int h) final;
+
   float percentFull() const final {
     return area_so_far_ / ((float)this->width() * this->height());
   }
@@ -40,10 +47,26 @@ class SkylineRectanglePacker final : public RectanglePacker {
     int width_;
   };
 
+  struct FreeRect {
+    int x_;
+    int y_;
+    int width_;
+    int height_;
+  };
+
   std::vector<SkylineSegment> skyline_;
 
+  std::vector<FreeRect> free_rects_;
+
   int32_t area_so_far_;
 
+  // Place a width x height rectangle in the free rect that leaves the least
+  // area unused. The rest of the free rect is split in two along the shorter
+  // leftover axis.
+  bool addRectToFreeRects(int width, int height, IPoint16* loc);
+  // Merge free rects that share a full edge into one until none are left.
+  void mergeFreeRects();
+
   // Can a width x height rectangle fit in the free space represented by
   // the skyline segments >= 'skylineIndex'? If so, return true and fill in
   // 'y' with the y-location at which it fits (the x location is pulled from
@@ -60,6 +83,11 @@ bool SkylineRectanglePacker::addRect(int width, int height, IPoint16* loc) {
     return false;
   }
 
+  if (this->addRectToFreeRects(width, height, loc)) {
+    area_so_far_ += width * height;
+    return true;
+  }
+
   // find position for new rectangle
   int bestWidth = this->width() + 1;
   int bestX = 0;
@@ -93,6 +121,93 @@ bool SkylineRectanglePacker::addRect(int width, int height, IPoint16* loc) {
   return false;
 }
 
+void SkylineRectanglePacker::freeRect(int x, int y, int width, int height) {
+  if (width <= 0 || height <= 0) {
+    return;
+  }
+  FML_DCHECK(x >= 0 && x + width <= this->width());
+  FML_DCHECK(y >= 0 && y + height <= this->height());
+  free_rects_.push_back(FreeRect{x, y, width, height});
+  area_so_far_ -= width * height;
+  FML_DCHECK(area_so_far_ >= 0);
+  this->mergeFreeRects();
+}
+
+bool SkylineRectanglePacker::addRectToFreeRects(int width,
+                                                int height,
+                                                IPoint16* loc) {
+  int bestIndex = -1;
+  int bestLeftover = 0;
+  for (int i = 0; i < (int)free_rects_.size(); ++i) {
+    const FreeRect& rect = free_rects_[i];
+    if (rect.width_ < width || rect.height_ < height) {
+      continue;
+    }
+    int leftover = rect.width_ * rect.height_ - width * height;
+    if (bestIndex == -1 || leftover < bestLeftover) {
+      bestIndex = i;
+      bestLeftover = leftover;
+    }
+  }
+  if (bestIndex == -1) {
+    return false;
+  }
+
+  FreeRect rect = free_rects_[bestIndex];
+  free_rects_[bestIndex] = free_rects_.back();
+  free_rects_.pop_back();
+
+  loc->x_ = rect.x_;
+  loc->y_ = rect.y_;
+
+  int leftoverWidth = rect.width_ - width;
+  int leftoverHeight = rect.height_ - height;
+  FreeRect right;
+  FreeRect bottom;
+  if (leftoverWidth <= leftoverHeight) {
+    right = FreeRect{rect.x_ + width, rect.y_, leftoverWidth, height};
+    bottom = FreeRect{rect.x_, rect.y_ + height, rect.width_, leftoverHeight};
+  } else {
+    right = FreeRect{rect.x_ + width, rect.y_, leftoverWidth, rect.height_};
+    bottom = FreeRect{rect.x_, rect.y_ + height, width, leftoverHeight};
+  }
+  if (right.width_ > 0 && right.height_ > 0) {
+    free_rects_.push_back(right);
+  }
+  if (bottom.width_ > 0 && bottom.height_ > 0) {
+    free_rects_.push_back(bottom);
+  }
+  return true;
+}
+
+void SkylineRectanglePacker::mergeFreeRects() {
+  bool merged = true;
+  while (merged) {
+    merged = false;
+    for (size_t i = 0; i < free_rects_.size() && !merged; ++i) {
+      for (size_t j = i + 1; j < free_rects_.size(); ++j) {
+        FreeRect& a = free_rects_[i];
+        const FreeRect& b = free_rects_[j];
+        if (a.x_ == b.x_ && a.width_ == b.width_ &&
+            (a.y_ + a.height_ == b.y_ || b.y_ + b.height_ == a.y_)) {
+          a.y_ = std::min(a.y_, b.y_);
+          a.height_ += b.height_;
+        } else if (a.y_ == b.y_ && a.height_ == b.height_ &&
+                   (a.x_ + a.width_ == b.x_ || b.x_ + b.width_ == a.x_)) {
+          a.x_ = std::min(a.x_, b.x_);
+          a.width_ += b.width_;
+        } else {
+          continue;
+        }
+        free_rects_[j] = free_rects_.back();
+        free_rects_.pop_back();
+        merged = true;
+        break;
+      }
+    }
+  }
+}
+
 bool SkylineRectanglePacker::rectangleFits(int skylineIndex,
                                            int width,
                                            int height,
@@ -42,6 +42,17 @@ class RectanglePacker {
   ///
   virtual bool addRect(int width, int height, IPoint16* loc) = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief     Return the area of a previously added rectangle to the packer
+  ///            so that later rectangles can be placed there.
+  ///
+  /// @param[in]  x       The x position returned when the rect was added.
+  /// @param[in]  y       The y position returned when the rect was added.
+  /// @param[in]  width   The width the rect was added with.
+  /// @param[in]  height  The height the rect was added with.
+  ///
+  virtual void freeRect(int x, int y, int width, int height) = 0;
+
   //----------------------------------------------------------------------------
   /// @brief     Returns how much area has been filled with rectangles.
   ///
@@ -0,0 +1,131 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/typographer/signed_distance_field.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+static constexpr double kInfinity = 1e20;
+
+// Computes the squared distance transform of the |count| samples of |grid|
+// that are |stride| apart, in place, using the lower envelope of parabolas
+// described in "Distance Transforms of Sampled Functions" by Felzenszwalb and
+// Huttenlocher. The remaining arguments are scratch space for at least
+// |count| (|count| + 1 for |z|) elements.
+static void DistanceTransform(double* grid,
+                              size_t stride,
+                              size_t count,
+                              double* f,
+                              double* z,
+                              size_t* v) {
+  for (size_t q = 0; q < count; q++) {
+    f[q] = grid[q * stride];
+  }
+  size_t k = 0;
+  v[0] = 0;
+  z[0] = -kInfinity;
+  z[1] = kInfinity;
+  for (size_t q = 1; q < count; q++) {
+    // Drop the parabolas that the one at |q| hides. The first one is never
+    // dropped since |z[0]| is below any intersection.
+    const double p = static_cast<double>(q);
+    double s = 0;
+    while (true) {
+      const double r = static_cast<double>(v[k]);
+      s = ((f[q] + p * p) - (f[v[k]] + r * r)) / (2 * p - 2 * r);
+      if (s > z[k]) {
+        break;
+      }
+      k--;
+    }
+    k++;
+    v[k] = q;
+    z[k] = s;
+    z[k + 1] = kInfinity;
+  }
+  k = 0;
+  for (size_t q = 0; q < count; q++) {
+    while (z[k + 1] < static_cast<double>(q)) {
+      k++;
+    }
+    const double d = static_cast<double>(q) - static_cast<double>(v[k]);
+    grid[q * stride] = d * d + f[v[k]];
+  }
+}
+
+// Computes the squared distance transform of the grid in place, first along
+// the columns and then along the rows.
+static void DistanceTransform(std::vector<double>& grid,
+                              size_t width,
+                              size_t height) {
+  const size_t count = std::max(width, height);
+  std::vector<double> f(count);
+  std::vector<double> z(count + 1);
+  std::vector<size_t> v(count);
+  for (size_t x = 0; x < width; x++) {
+    DistanceTransform(grid.data() + x, width, height, f.data(), z.data(),
+                      v.data());
+  }
+  for (size_t y = 0; y < height; y++) {
+    DistanceTransform(grid.data() + y * width, 1u, width, f.data(), z.data(),
+                      v.data());
+  }
+}
+
+void ConvertToSignedDistanceField(uint8_t* pixels,
+                                  ISize size,
+                                  size_t row_bytes,
+                                  Scalar spread) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  if (size.IsEmpty() || spread <= 0) {
+    return;
+  }
+  const size_t width = static_cast<size_t>(size.width);
+  const size_t height = static_cast<size_t>(size.height);
+
+  // The squared distances of each pixel to the covered (outer) and uncovered
+  // (inner) area. Partially covered pixels start out at their distance to the
+  // edge they contain.
+  std::vector<double> outer(width * height);
+  std::vector<double> inner(width * height);
+  for (size_t y = 0; y < height; y++) {
+    const uint8_t* row = pixels + y * row_bytes;
+    for (size_t x = 0; x < width; x++) {
+      const size_t i = y * width + x;
+      if (row[x] == 255u) {
+        outer[i] = 0;
+        inner[i] = kInfinity;
+      } else if (row[x] == 0u) {
+        outer[i] = kInfinity;
+        inner[i] = 0;
+      } else {
+        const double d = 0.5 - row[x] / 255.0;
+        outer[i] = d > 0 ? d * d : 0;
+        inner[i] = d < 0 ? d * d : 0;
+      }
+    }
+  }
+
+  DistanceTransform(outer, width, height);
+  DistanceTransform(inner, width, height);
+
+  for (size_t y = 0; y < height; y++) {
+    uint8_t* row = pixels + y * row_bytes;
+    for (size_t x = 0; x < width; x++) {
+      const size_t i = y * width + x;
+      // Positive outside of the glyph.
+      const double distance = std::sqrt(outer[i]) - std::sqrt(inner[i]);
+      const double value = std::clamp(0.5 - distance / (2 * spread), 0.0, 1.0);
+      row[x] = static_cast<uint8_t>(std::round(value * 255));
+    }
+  }
+}
+
+}  // namespace impeller
@@ -0,0 +1,36 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "impeller/geometry/scalar.h"
+#include "impeller/geometry/size.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Converts an 8-bit coverage bitmap into a signed distance field
+///             in place.
+///
+///             Each pixel is replaced by its distance to the edge of the
+///             covered area, mapped so that the edge is at 128, pixels
+///             further than |spread| inside are 255 and pixels further than
+///             |spread| outside are 0. Partially covered pixels place the edge
+///             within the pixel. Distances are Euclidean distances between
+///             pixel centers.
+///
+/// @param      pixels     The first pixel of the bitmap.
+/// @param[in]  size       The size of the bitmap in pixels.
+/// @param[in]  row_bytes  The number of bytes between the starts of two rows.
+/// @param[in]  spread     The distance, in pixels, over which the field ramps.
+///
+void ConvertToSignedDistanceField(uint8_t* pixels,
+                                  ISize size,
+                                  size_t row_bytes,
+                                  Scalar spread);
+
+}  // namespace impeller
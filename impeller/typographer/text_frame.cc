@@ -30,6 +30,19 @@ GlyphAtlas::Type TextFrame::GetAtlasType() const {
                     : GlyphAtlas::Type::kAlphaBitmap;
 }
 
+GlyphAtlas::Type TextFrame::GetAtlasType(Scalar scale) const {
+  if (has_color_ || runs_.empty()) {
+    return GetAtlasType();
+  }
+  for (const TextRun& run : runs_) {
+    if (run.GetFont().GetMetrics().point_size * scale <
+        GlyphAtlas::kSignedDistanceFieldFontSize) {
+      return GlyphAtlas::Type::kAlphaBitmap;
+    }
+  }
+  return GlyphAtlas::Type::kSignedDistanceField;
+}
+
 bool TextFrame::MaybeHasOverlapping() const {
   if (runs_.size() > 1) {
     return true;
@@ -67,12 +80,23 @@ Scalar TextFrame::RoundScaledFontSize(Scalar scale, Scalar point_size) {
   return std::round(scale * 100) / 100;
 }
 
+// static
+Scalar TextFrame::GetAtlasScale(GlyphAtlas::Type type,
+                                Scalar scale,
+                                Scalar point_size) {
+  if (type == GlyphAtlas::Type::kSignedDistanceField && point_size > 0) {
+    scale = GlyphAtlas::kSignedDistanceFieldFontSize / point_size;
+  }
+  return RoundScaledFontSize(scale, point_size);
+}
+
 void TextFrame::CollectUniqueFontGlyphPairs(FontGlyphMap& glyph_map,
                                             Scalar scale) const {
+  const auto type = GetAtlasType(scale);
   for (const TextRun& run : GetRuns()) {
     const Font& font = run.GetFont();
     auto rounded_scale =
-        RoundScaledFontSize(scale, font.GetMetrics().point_size);
+        GetAtlasScale(type, scale, font.GetMetrics().point_size);
     auto& set = glyph_map[{font, rounded_scale}];
     for (const TextRun::GlyphPosition& glyph_position :
          run.GetGlyphPositions()) {
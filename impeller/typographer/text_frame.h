@@ -28,6 +28,18 @@ class TextFrame {
 
   static Scalar RoundScaledFontSize(Scalar scale, Scalar point_size);
 
+  //----------------------------------------------------------------------------
+  /// @brief      The scale at which glyphs of a font are represented in an
+  ///             atlas of the given type when drawn at |scale|.
+  ///
+  ///             Signed distance field atlases represent glyphs at
+  ///             |GlyphAtlas::kSignedDistanceFieldFontSize| independent of the
+  ///             scale they are drawn at.
+  ///
+  static Scalar GetAtlasScale(GlyphAtlas::Type type,
+                              Scalar scale,
+                              Scalar point_size);
+
   //----------------------------------------------------------------------------
   /// @brief      The conservative bounding box for this text frame.
   ///
@@ -64,6 +76,18 @@ class TextFrame {
   /// @brief      The type of atlas this run should be emplaced in.
   GlyphAtlas::Type GetAtlasType() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The type of atlas this run should be emplaced in when drawn
+  ///             at |scale|.
+  ///
+  ///             Frames without color glyphs whose fonts are all drawn at or
+  ///             above |GlyphAtlas::kSignedDistanceFieldFontSize| use a signed
+  ///             distance field atlas, so that they do not need to be
+  ///             rasterized again as their scale changes and do not take up
+  ///             atlas space proportional to their size.
+  ///
+  GlyphAtlas::Type GetAtlasType(Scalar scale) const;
+
   TextFrame& operator=(TextFrame&& other) = default;
 
   TextFrame(const TextFrame& other) = default;
@@ -2,12 +2,17 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/testing/testing.h"
 #include "impeller/playground/playground_test.h"
+#include "impeller/typographer/backends/skia/glyph_atlas_context_skia.h"
 #include "impeller/typographer/backends/skia/text_frame_skia.h"
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"
 #include "impeller/typographer/lazy_glyph_atlas.h"
 #include "impeller/typographer/rectangle_packer.h"
+#include "impeller/typographer/signed_distance_field.h"
+#include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkFontMgr.h"
 #include "third_party/skia/include/core/SkRect.h"
@@ -138,6 +143,75 @@ TEST_P(TypographerTest, LazyAtlasTracksColor) {
   ASSERT_FALSE(color_atlas == bitmap_atlas);
 }
 
+TEST_P(TypographerTest, LargeTextUsesSignedDistanceFieldAtlas) {
+  SkFont sk_font;
+  auto blob = SkTextBlob::MakeFromString("hello", sk_font);
+  ASSERT_TRUE(blob);
+  auto frame = MakeTextFrameFromTextBlobSkia(blob);
+  const auto point_size = sk_font.getSize();
+
+  ASSERT_EQ(frame->GetAtlasType(1.0f), GlyphAtlas::Type::kAlphaBitmap);
+  ASSERT_EQ(frame->GetAtlasType(10.0f),
+            GlyphAtlas::Type::kSignedDistanceField);
+
+  // The glyphs are shared by all scales above the threshold.
+  FontGlyphMap font_glyph_map;
+  frame->CollectUniqueFontGlyphPairs(font_glyph_map, 10.0f);
+  frame->CollectUniqueFontGlyphPairs(font_glyph_map, 20.0f);
+  ASSERT_EQ(font_glyph_map.size(), 1u);
+  ASSERT_EQ(font_glyph_map.begin()->first.scale,
+            TextFrame::GetAtlasScale(GlyphAtlas::Type::kSignedDistanceField,
+                                     10.0f, point_size));
+
+  LazyGlyphAtlas lazy_atlas(TypographerContextSkia::Make());
+  lazy_atlas.AddTextFrame(*frame, 10.0f);
+  auto atlas = lazy_atlas.CreateOrGetGlyphAtlas(
+      *GetContext(), GlyphAtlas::Type::kSignedDistanceField);
+  ASSERT_NE(atlas, nullptr);
+  ASSERT_NE(atlas->GetTexture(), nullptr);
+  ASSERT_EQ(atlas->GetType(), GlyphAtlas::Type::kSignedDistanceField);
+  ASSERT_EQ(atlas->GetTexture()->GetTextureDescriptor().format,
+            PixelFormat::kA8UNormInt);
+  ASSERT_EQ(atlas->GetGlyphCount(), 4llu);
+
+  // Glyphs are padded by the spread of the distance field.
+  atlas->IterateGlyphs([&](const ScaledFont& scaled_font, const Glyph& glyph,
+                           const Rect& rect) -> bool {
+    EXPECT_GE(rect.size.width,
+              glyph.bounds.size.width * scaled_font.scale +
+                  2 * GlyphAtlas::kSignedDistanceFieldSpread);
+    EXPECT_GE(rect.size.height,
+              glyph.bounds.size.height * scaled_font.scale +
+                  2 * GlyphAtlas::kSignedDistanceFieldSpread);
+    return true;
+  });
+}
+
+TEST_P(TypographerTest, SignedDistanceFieldHasEdgeAtHalfValue) {
+  constexpr size_t kSize = 16u;
+  std::array<uint8_t, kSize * kSize> pixels = {};
+  for (size_t y = 4; y < 12; y++) {
+    for (size_t x = 4; x < 12; x++) {
+      pixels[y * kSize + x] = 255u;
+    }
+  }
+
+  ConvertToSignedDistanceField(pixels.data(), ISize(kSize, kSize), kSize,
+                               4.0f);
+
+  // Far outside and far inside are clamped.
+  ASSERT_EQ(pixels[0], 0u);
+  ASSERT_EQ(pixels[8 * kSize + 8], 255u);
+  // The edge between the last uncovered and first covered pixel is centered
+  // on half the maximum value.
+  ASSERT_LT(pixels[8 * kSize + 3], 128u);
+  ASSERT_GE(pixels[8 * kSize + 4], 128u);
+  ASSERT_EQ(pixels[8 * kSize + 3] + pixels[8 * kSize + 4], 255);
+  // The field increases towards the inside.
+  ASSERT_LT(pixels[8 * kSize + 2], pixels[8 * kSize + 3]);
+  ASSERT_LT(pixels[8 * kSize + 4], pixels[8 * kSize + 5]);
+}
+
 TEST_P(TypographerTest, GlyphAtlasWithOddUniqueGlyphSize) {
   auto context = TypographerContextSkia::Make();
   auto atlas_context = context->CreateGlyphAtlasContext();
@@ -255,6 +329,114 @@ TEST_P(TypographerTest, GlyphAtlasTextureIsRecycledIfUnchanged) {
   ASSERT_EQ(old_packer, new_packer);
 }
 
+static SkIRect GetPixelBounds(const Rect& location) {
+  return SkRect::MakeLTRB(location.GetLeft(), location.GetTop(),
+                          location.GetRight(), location.GetBottom())
+      .roundOut();
+}
+
+static bool GlyphLocationHasCoverage(const SkBitmap& bitmap,
+                                     const Rect& location) {
+  auto rect = GetPixelBounds(location);
+  for (auto y = rect.top(); y < rect.bottom(); y++) {
+    for (auto x = rect.left(); x < rect.right(); x++) {
+      if (SkColorGetA(bitmap.getColor(x, y)) != 0) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+TEST_P(TypographerTest, GlyphAtlasRasterizedOnWorkersMatchesSynchronous) {
+  auto loop = fml::ConcurrentMessageLoop::Create(2u);
+  auto worker_context = TypographerContextSkia::Make(
+      loop->GetTaskRunner(), /*defer_rasterization=*/false);
+  auto context = TypographerContextSkia::Make();
+  auto worker_atlas_context = worker_context->CreateGlyphAtlasContext();
+  auto atlas_context = context->CreateGlyphAtlasContext();
+
+  SkFont sk_font;
+  auto blob = SkTextBlob::MakeFromString(
+      "QWERTYUIOPASDFGHJKLZXCVBNMqewrtyuiopasdfghjklzxcvbnm", sk_font);
+  ASSERT_TRUE(blob);
+  auto frame = MakeTextFrameFromTextBlobSkia(blob);
+
+  auto worker_atlas = CreateGlyphAtlas(
+      *GetContext(), worker_context.get(), GlyphAtlas::Type::kAlphaBitmap,
+      1.0f, worker_atlas_context, *frame);
+  auto atlas = CreateGlyphAtlas(*GetContext(), context.get(),
+                                GlyphAtlas::Type::kAlphaBitmap, 1.0f,
+                                atlas_context, *frame);
+  ASSERT_NE(worker_atlas, nullptr);
+  ASSERT_NE(atlas, nullptr);
+  ASSERT_EQ(worker_atlas->GetGlyphCount(), atlas->GetGlyphCount());
+
+  auto worker_bitmap =
+      GlyphAtlasContextSkia::Cast(*worker_atlas_context).GetBitmap();
+  auto bitmap = GlyphAtlasContextSkia::Cast(*atlas_context).GetBitmap();
+  ASSERT_NE(worker_bitmap, nullptr);
+  ASSERT_NE(bitmap, nullptr);
+
+  atlas->IterateGlyphs([&](const ScaledFont& scaled_font, const Glyph& glyph,
+                           const Rect& location) -> bool {
+    auto worker_location =
+        worker_atlas->FindFontGlyphBounds({scaled_font, glyph});
+    EXPECT_TRUE(worker_location.has_value());
+    EXPECT_EQ(worker_location.value(), location);
+    auto rect = GetPixelBounds(location);
+    for (auto y = rect.top(); y < rect.bottom(); y++) {
+      for (auto x = rect.left(); x < rect.right(); x++) {
+        EXPECT_EQ(worker_bitmap->getColor(x, y), bitmap->getColor(x, y));
+      }
+    }
+    return true;
+  });
+}
+
+TEST_P(TypographerTest, DeferredGlyphRasterizationFillsAtlasOnNextUpdate) {
+  // Keep the only worker busy so that it can't pick up any glyphs.
+  fml::AutoResetWaitableEvent unblock_worker;
+  auto loop = fml::ConcurrentMessageLoop::Create(1u);
+  loop->GetTaskRunner()->PostTask([&]() { unblock_worker.Wait(); });
+
+  auto context = TypographerContextSkia::Make(loop->GetTaskRunner(),
+                                              /*defer_rasterization=*/true);
+  auto atlas_context = context->CreateGlyphAtlasContext();
+  SkFont sk_font;
+  auto blob = SkTextBlob::MakeFromString("hello", sk_font);
+  ASSERT_TRUE(blob);
+  auto frame = MakeTextFrameFromTextBlobSkia(blob);
+
+  auto atlas = CreateGlyphAtlas(*GetContext(), context.get(),
+                                GlyphAtlas::Type::kAlphaBitmap, 1.0f,
+                                atlas_context, *frame);
+  ASSERT_NE(atlas, nullptr);
+  ASSERT_NE(atlas->GetTexture(), nullptr);
+  ASSERT_EQ(atlas->GetGlyphCount(), 4llu);
+
+  auto bitmap = GlyphAtlasContextSkia::Cast(*atlas_context).GetBitmap();
+  ASSERT_NE(bitmap, nullptr);
+  atlas->IterateGlyphs([&](const ScaledFont& scaled_font, const Glyph& glyph,
+                           const Rect& location) -> bool {
+    EXPECT_FALSE(GlyphLocationHasCoverage(*bitmap, location));
+    return true;
+  });
+
+  // The next update rasterizes the glyphs the workers haven't started on.
+  auto next_atlas = CreateGlyphAtlas(*GetContext(), context.get(),
+                                     GlyphAtlas::Type::kAlphaBitmap, 1.0f,
+                                     atlas_context, *frame);
+  ASSERT_EQ(next_atlas, atlas);
+  atlas->IterateGlyphs([&](const ScaledFont& scaled_font, const Glyph& glyph,
+                           const Rect& location) -> bool {
+    EXPECT_TRUE(GlyphLocationHasCoverage(*bitmap, location));
+    return true;
+  });
+
+  unblock_worker.Signal();
+}
+
 TEST_P(TypographerTest, GlyphAtlasTextureIsRecreatedIfTypeChanges) {
   auto context = TypographerContextSkia::Make();
   auto atlas_context = context->CreateGlyphAtlasContext();
@@ -289,6 +471,55 @@ TEST_P(TypographerTest, GlyphAtlasTextureIsRecreatedIfTypeChanges) {
   ASSERT_NE(old_packer, new_packer);
 }
 
+TEST_P(TypographerTest, GlyphAtlasEvictsLeastRecentlyUsedGlyphs) {
+  SkFont sk_font;
+  auto blob = SkTextBlob::MakeFromString("abc", sk_font);
+  ASSERT_TRUE(blob);
+  FontGlyphMap font_glyph_map;
+  MakeTextFrameFromTextBlobSkia(blob)->CollectUniqueFontGlyphPairs(
+      font_glyph_map, 1.0f);
+  ASSERT_EQ(font_glyph_map.size(), 1u);
+  const auto& [scaled_font, glyphs] = *font_glyph_map.begin();
+
+  GlyphAtlas atlas(GlyphAtlas::Type::kAlphaBitmap);
+  std::vector<FontGlyphPair> missing;
+  atlas.MarkGlyphsUsed(scaled_font, glyphs, missing);
+  ASSERT_EQ(missing.size(), 3u);
+  for (size_t i = 0; i < missing.size(); i++) {
+    atlas.AddTypefaceGlyphPosition(missing[i],
+                                   Rect::MakeXYWH(i * 10, 0, 10, 10));
+  }
+
+  // Only the first glyph is used by the following updates.
+  const std::unordered_set<Glyph> used_glyphs = {missing[0].glyph};
+  for (size_t i = 0; i < 3; i++) {
+    atlas.IncrementGeneration();
+    std::vector<FontGlyphPair> none_missing;
+    atlas.MarkGlyphsUsed(scaled_font, used_glyphs, none_missing);
+    ASSERT_TRUE(none_missing.empty());
+  }
+
+  auto evict_all = [](const Rect& location) { return true; };
+  const auto layout_version = atlas.GetLayoutVersion();
+  ASSERT_EQ(atlas.EvictGlyphs(4u, evict_all), 0u);
+  ASSERT_EQ(atlas.GetGlyphCount(), 3u);
+  ASSERT_EQ(atlas.GetLayoutVersion(), layout_version);
+
+  std::vector<Rect> evicted;
+  ASSERT_EQ(atlas.EvictGlyphs(3u,
+                              [&evicted](const Rect& location) {
+                                evicted.push_back(location);
+                                return true;
+                              }),
+            2u);
+  ASSERT_EQ(evicted.size(), 2u);
+  ASSERT_EQ(atlas.GetGlyphCount(), 1u);
+  ASSERT_NE(atlas.GetLayoutVersion(), layout_version);
+  ASSERT_TRUE(atlas.FindFontGlyphBounds(missing[0]).has_value());
+  ASSERT_FALSE(atlas.FindFontGlyphBounds(missing[1]).has_value());
+  ASSERT_FALSE(atlas.FindFontGlyphBounds(missing[2]).has_value());
+}
+
 TEST_P(TypographerTest, MaybeHasOverlapping) {
   sk_sp<SkFontMgr> font_mgr = SkFontMgr::RefDefault();
   sk_sp<SkTypeface> typeface =
@@ -349,6 +580,60 @@ TEST_P(TypographerTest, RectanglePackerAddsNonoverlapingRectangles) {
   ASSERT_EQ(packer->percentFull(), 0);
 }
 
+TEST_P(TypographerTest, RectanglePackerReusesFreedRectangles) {
+  auto packer = RectanglePacker::Factory(100, 100);
+  ASSERT_NE(packer, nullptr);
+
+  IPoint16 first_output = {-1, -1};
+  IPoint16 second_output = {-1, -1};
+  ASSERT_TRUE(packer->addRect(100, 50, &first_output));
+  ASSERT_TRUE(packer->addRect(100, 50, &second_output));
+  IPoint16 output;
+  ASSERT_FALSE(packer->addRect(10, 10, &output));
+
+  packer->freeRect(first_output.x(), first_output.y(), 100, 50);
+  ASSERT_TRUE(flutter::testing::NumberNear(packer->percentFull(), 0.5));
+
+  // Both halves of the freed rectangle can be used again.
+  const SkIRect freed_rect =
+      SkIRect::MakeXYWH(first_output.x(), first_output.y(), 100, 50);
+  IPoint16 left_output = {-1, -1};
+  IPoint16 right_output = {-1, -1};
+  ASSERT_TRUE(packer->addRect(50, 50, &left_output));
+  ASSERT_TRUE(packer->addRect(50, 50, &right_output));
+  const SkIRect left_rect =
+      SkIRect::MakeXYWH(left_output.x(), left_output.y(), 50, 50);
+  const SkIRect right_rect =
+      SkIRect::MakeXYWH(right_output.x(), right_output.y(), 50, 50);
+  ASSERT_TRUE(freed_rect.contains(left_rect));
+  ASSERT_TRUE(freed_rect.contains(right_rect));
+  ASSERT_FALSE(SkIRect::Intersects(left_rect, right_rect));
+  ASSERT_FALSE(packer->addRect(10, 10, &output));
+  ASSERT_TRUE(flutter::testing::NumberNear(packer->percentFull(), 1.0));
+}
+
+TEST_P(TypographerTest, RectanglePackerMergesAdjacentFreedRectangles) {
+  auto packer = RectanglePacker::Factory(100, 100);
+  ASSERT_NE(packer, nullptr);
+
+  IPoint16 left_output = {-1, -1};
+  IPoint16 right_output = {-1, -1};
+  IPoint16 output;
+  ASSERT_TRUE(packer->addRect(50, 100, &left_output));
+  ASSERT_TRUE(packer->addRect(50, 100, &right_output));
+  ASSERT_FALSE(packer->addRect(100, 100, &output));
+
+  packer->freeRect(left_output.x(), left_output.y(), 50, 100);
+  ASSERT_FALSE(packer->addRect(100, 100, &output));
+  packer->freeRect(right_output.x(), right_output.y(), 50, 100);
+  ASSERT_EQ(packer->percentFull(), 0);
+
+  // The freed halves are merged so the full area fits again.
+  ASSERT_TRUE(packer->addRect(100, 100, &output));
+  ASSERT_EQ(output.x(), 0);
+  ASSERT_EQ(output.y(), 0);
+}
+
 }  // namespace testing
 }  // namespace impeller
 
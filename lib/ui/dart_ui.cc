@@ -89,18 +89,26 @@ typedef CanvasPath Path;
   V(ImageDescriptor::initEncoded, 3)                                  \
   V(ImmutableBuffer::init, 3)                                         \
   V(ImmutableBuffer::initFromAsset, 3)                                \
+  V(ImmutableBuffer::initFromAssetRange, 5)                           \
   V(ImmutableBuffer::initFromFile, 3)                                 \
   V(ImageDescriptor::initRaw, 6)                                      \
+  V(Image::initTransferred, 2)                                        \
+  V(Image::disposeTransferred, 1)                                     \
   V(IsolateNameServerNatives::LookupPortByName, 1)                    \
   V(IsolateNameServerNatives::RegisterPortWithName, 2)                \
   V(IsolateNameServerNatives::RemovePortNameMapping, 1)               \
   V(NativeStringAttribute::initLocaleStringAttribute, 4)              \
   V(NativeStringAttribute::initSpellOutStringAttribute, 3)            \
+  V(Picture::initTransferred, 2)                                      \
+  V(Picture::disposeTransferred, 1)                                   \
   V(PlatformConfigurationNativeApi::DefaultRouteName, 0)              \
   V(PlatformConfigurationNativeApi::ScheduleFrame, 0)                 \
   V(PlatformConfigurationNativeApi::Render, 1)                        \
   V(PlatformConfigurationNativeApi::UpdateSemantics, 1)               \
   V(PlatformConfigurationNativeApi::SetNeedsReportTimings, 1)         \
+  V(PlatformConfigurationNativeApi::SetPreferredFrameRate, 1)         \
+  V(PlatformConfigurationNativeApi::SetNeedsIdleTasks, 1)             \
+  V(PlatformConfigurationNativeApi::GetEngineCounters, 0)             \
   V(PlatformConfigurationNativeApi::SetIsolateDebugName, 1)           \
   V(PlatformConfigurationNativeApi::RequestDartPerformanceMode, 1)    \
   V(PlatformConfigurationNativeApi::GetPersistentIsolateData, 0)      \
@@ -143,6 +151,7 @@ typedef CanvasPath Path;
   V(Canvas, drawAtlas, 10)                             \
   V(Canvas, drawCircle, 6)                             \
   V(Canvas, drawColor, 3)                              \
+  V(Canvas, drawCommands, 3)                           \
   V(Canvas, drawDRRect, 5)                             \
   V(Canvas, drawImage, 7)                              \
   V(Canvas, drawImageNine, 13)                         \
@@ -181,6 +190,7 @@ typedef CanvasPath Path;
   V(ColorFilter, initSrgbToLinearGamma, 1)             \
   V(EngineLayer, dispose, 1)                           \
   V(FragmentProgram, initFromAsset, 2)                 \
+  V(FragmentProgram, warmUp, 2)                        \
   V(ReusableFragmentShader, Dispose, 1)                \
   V(ReusableFragmentShader, SetImageSampler, 3)        \
   V(ReusableFragmentShader, ValidateSamplers, 1)       \
@@ -193,6 +203,7 @@ typedef CanvasPath Path;
   V(Image, height, 1)                                  \
   V(Image, toByteData, 3)                              \
   V(Image, colorSpace, 1)                              \
+  V(Image, transfer, 1)                                \
   V(ImageDescriptor, bytesPerPixel, 1)                 \
   V(ImageDescriptor, dispose, 1)                       \
   V(ImageDescriptor, height, 1)                        \
@@ -215,12 +226,15 @@ typedef CanvasPath Path;
   V(ParagraphBuilder, pushStyle, 16)                   \
   V(Paragraph, alphabeticBaseline, 1)                  \
   V(Paragraph, computeLineMetrics, 1)                  \
+  V(Paragraph, computeLineMetricsInto, 2)              \
   V(Paragraph, didExceedMaxLines, 1)                   \
   V(Paragraph, dispose, 1)                             \
   V(Paragraph, getLineBoundary, 2)                     \
   V(Paragraph, getPositionForOffset, 3)                \
+  V(Paragraph, getPositionsForOffsets, 3)              \
   V(Paragraph, getRectsForPlaceholders, 1)             \
   V(Paragraph, getRectsForRange, 5)                    \
+  V(Paragraph, getRectsForRanges, 5)                   \
   V(Paragraph, getWordBoundary, 2)                     \
   V(Paragraph, height, 1)                              \
   V(Paragraph, ideographicBaseline, 1)                 \
@@ -273,6 +287,7 @@ typedef CanvasPath Path;
   V(Picture, dispose, 1)                               \
   V(Picture, toImage, 4)                               \
   V(Picture, toImageSync, 4)                           \
+  V(Picture, transfer, 1)                              \
   V(SceneBuilder, addPerformanceOverlay, 6)            \
   V(SceneBuilder, addPicture, 5)                       \
   V(SceneBuilder, addPlatformView, 6)                  \
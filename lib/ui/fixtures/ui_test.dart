@@ -270,6 +270,17 @@ void platformMessagePortResponseTest() async {
   }
 }
 
+@pragma('vm:entry-point')
+Future<void> platformMessagePortLargeResponseTest() async {
+  ReceivePort receivePort = ReceivePort();
+  _callPlatformMessageResponseDartPort(receivePort.sendPort.nativePort);
+  List<dynamic> resultList = await receivePort.first;
+  Uint8List? bytes = resultList[1] as Uint8List?;
+  _finishCallResponse(bytes != null &&
+      bytes.length == 2000 &&
+      bytes.every((int byte) => byte == 7));
+}
+
 @pragma('vm:entry-point')
 void platformMessageResponseTest() {
   _callPlatformMessageResponseDart((ByteData? result) {
@@ -994,6 +1005,24 @@ void hooksTests() async {
     }
   });
 
+  await test('lay out paragraph on registered background isolate', () async {
+    ReceivePort receivePort = ReceivePort();
+    Isolate.spawn(_backgroundIsolateLayoutParagraph, <Object>[receivePort.sendPort, RootIsolateToken.instance!]);
+    final Object? height = await receivePort.first;
+    if (height is! double || height <= 0) {
+      throw Exception('Expected a paragraph laid out on a background isolate, got $height.');
+    }
+  });
+
+  await test('build paragraph without registering', () async {
+    ReceivePort receivePort = ReceivePort();
+    Isolate.spawn(_backgroundIsolateBuildParagraphWithoutRegistering, receivePort.sendPort);
+    bool didError = await receivePort.first as bool;
+    if (!didError) {
+      throw Exception('Expected an error when not registering a root isolate and building a paragraph.');
+    }
+  });
+
   _finish();
 }
 
@@ -1022,6 +1051,30 @@ void _backgroundIsolateSendWithoutRegistering(SendPort port) {
   port.send(didError);
 }
 
+/// Sends the height of a paragraph laid out on a background isolate registered
+/// with the root isolate of the token in [args] on the port in [args].
+void _backgroundIsolateLayoutParagraph(List<Object> args) {
+  final SendPort port = args[0] as SendPort;
+  PlatformDispatcher.instance.registerBackgroundIsolate(args[1] as RootIsolateToken);
+  final ParagraphBuilder builder = ParagraphBuilder(ParagraphStyle());
+  builder.addText('Hello background isolate!');
+  final Paragraph paragraph = builder.build();
+  paragraph.layout(const ParagraphConstraints(width: 100));
+  port.send(paragraph.height);
+}
+
+/// Sends `true` on [port] if building a paragraph throws an exception without
+/// calling [PlatformDispatcher.registerBackgroundIsolate].
+void _backgroundIsolateBuildParagraphWithoutRegistering(SendPort port) {
+  bool didError = false;
+  try {
+    ParagraphBuilder(ParagraphStyle());
+  } catch (_) {
+    didError = true;
+  }
+  port.send(didError);
+}
+
 typedef _Callback<T> = void Function(T result);
 typedef _Callbacker<T> = String? Function(_Callback<T?> callback);
 
@@ -278,6 +278,16 @@ void _reportTimings(List<int> timings) {
   PlatformDispatcher.instance._reportTimings(timings);
 }
 
+@pragma('vm:entry-point')
+void _runIdleTasks(int deadlineMicroseconds) {
+  PlatformDispatcher.instance._runIdleTasks(deadlineMicroseconds);
+}
+
+@pragma('vm:entry-point')
+void _prewarmIsolatePool(int size) {
+  IsolatePool._prewarm(size);
+}
+
 @pragma('vm:entry-point')
 void _drawFrame() {
   PlatformDispatcher.instance._drawFrame();
@@ -0,0 +1,177 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+part of dart.ui;
+
+/// Runs short computations on background isolates that are kept alive between
+/// computations.
+///
+/// Spawning an isolate for each computation, as [Isolate.run] does, delays
+/// the computation by the time it takes to start the isolate. The isolates of
+/// the pool are spawned once, in the isolate group of the isolate using the
+/// pool, and then wait for computations. Since they are in the same group,
+/// closures can be sent to them. The results of the computations are still
+/// copied back.
+///
+/// The engine can spawn the isolates of the pool of the root isolate ahead
+/// of their first use, during the first idle period of the root isolate. The
+/// number of isolates it spawns is set by the `--warm-isolate-pool-size`
+/// engine switch. Otherwise, isolates are spawned when they are first needed.
+///
+/// The isolates of the pool exit when the isolate that spawned them exits.
+abstract final class IsolatePool {
+  static final List<_PooledIsolate> _idle = <_PooledIsolate>[];
+
+  // The number of idle isolates the pool keeps, set when the pool is
+  // prewarmed.
+  static int _size = 0;
+  static int _spawning = 0;
+
+  /// Runs [computation] on an idle isolate of the pool, and returns its
+  /// result.
+  ///
+  /// If no isolate of the pool is idle, an isolate is spawned for the
+  /// computation. It is kept in the pool afterwards unless the pool already
+  /// holds as many idle isolates as it was prewarmed with.
+  ///
+  /// If [computation] throws, the returned future completes with the error
+  /// and the stack trace of the computation. The error is a [RemoteError] if
+  /// it can't be sent back.
+  static Future<R> run<R>(FutureOr<R> Function() computation) async {
+    final _PooledIsolate isolate =
+        _idle.isNotEmpty ? _idle.removeLast() : await _PooledIsolate.spawn();
+    try {
+      return await isolate.run(computation) as R;
+    } finally {
+      _release(isolate);
+    }
+  }
+
+  static void _prewarm(int size) {
+    _size = size;
+    for (int count = _idle.length + _spawning; count < size; count++) {
+      _spawning++;
+      _PooledIsolate.spawn().then(_release).whenComplete(() {
+        _spawning--;
+      });
+    }
+  }
+
+  static void _release(_PooledIsolate isolate) {
+    if (isolate._isAlive && _idle.length < math.max(_size, 1)) {
+      _idle.add(isolate);
+    } else {
+      isolate.close();
+    }
+  }
+}
+
+class _PooledIsolate {
+  _PooledIsolate._(this._responses);
+
+  final RawReceivePort _responses;
+  final Completer<void> _ready = Completer<void>();
+  late final SendPort _commands;
+  Completer<Object?>? _pending;
+  bool _isAlive = true;
+
+  static Future<_PooledIsolate> spawn() async {
+    final RawReceivePort responses = RawReceivePort();
+    final _PooledIsolate isolate = _PooledIsolate._(responses);
+    responses.handler = isolate._handleResponse;
+    try {
+      await Isolate.spawn<List<SendPort>>(
+        _pooledIsolateMain,
+        <SendPort>[responses.sendPort, Isolate.current.controlPort],
+        onExit: responses.sendPort,
+        debugName: 'IsolatePool',
+      );
+    } catch (_) {
+      responses.close();
+      rethrow;
+    }
+    await isolate._ready.future;
+    return isolate;
+  }
+
+  Future<Object?> run(FutureOr<Object?> Function() computation) {
+    assert(_pending == null);
+    if (!_isAlive) {
+      return Future<Object?>.error(
+          RemoteError('The pooled isolate has exited.', ''));
+    }
+    final Completer<Object?> completer = Completer<Object?>();
+    _commands.send(computation);
+    _pending = completer;
+    return completer.future;
+  }
+
+  void close() {
+    if (_isAlive) {
+      _commands.send(null);
+    }
+  }
+
+  void _handleResponse(Object? message) {
+    if (message is SendPort) {
+      _commands = message;
+      _ready.complete();
+      return;
+    }
+    if (message == null) {
+      // The pooled isolate exited.
+      _isAlive = false;
+      _responses.close();
+      IsolatePool._idle.remove(this);
+      final RemoteError error = RemoteError(
+          'The pooled isolate exited before completing the computation.', '');
+      if (!_ready.isCompleted) {
+        _ready.completeError(error);
+      }
+      _pending?.completeError(error);
+      _pending = null;
+      return;
+    }
+    final List<Object?> response = message as List<Object?>;
+    final Completer<Object?> completer = _pending!;
+    _pending = null;
+    if (response.length == 1) {
+      completer.complete(response[0]);
+    } else {
+      completer.completeError(
+          response[0]!, StackTrace.fromString(response[1]! as String));
+    }
+  }
+}
+
+void _pooledIsolateMain(List<SendPort> ports) {
+  final SendPort responses = ports[0];
+  final RawReceivePort commands = RawReceivePort();
+  commands.handler = (Object? message) {
+    if (message == null) {
+      // The pool closed this isolate or the isolate using the pool exited.
+      commands.close();
+    } else {
+      _runPooledComputation(message as FutureOr<Object?> Function(), responses);
+    }
+  };
+  Isolate(ports[1]).addOnExitListener(commands.sendPort);
+  responses.send(commands.sendPort);
+}
+
+Future<void> _runPooledComputation(
+    FutureOr<Object?> Function() computation, SendPort responses) async {
+  try {
+    final Object? result = await computation();
+    responses.send(<Object?>[result]);
+  } catch (error, stackTrace) {
+    final String trace = stackTrace.toString();
+    try {
+      responses.send(<Object?>[error, trace]);
+    } catch (_) {
+      responses.send(
+          <Object?>[RemoteError(error.toString(), trace), trace]);
+    }
+  }
+}
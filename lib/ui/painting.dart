@@ -1991,10 +1991,70 @@ base class _Image extends NativeFieldWrapperClass1 {
   @Native<Int32 Function(Pointer<Void>)>(symbol: 'Image::colorSpace')
   external int get colorSpace;
 
+  @Native<Int64 Function(Pointer<Void>)>(symbol: 'Image::transfer')
+  external int _transfer();
+
   @override
   String toString() => '[$width\u00D7$height]';
 }
 
+/// A handle to the pixels of an [Image] that can be sent to another isolate.
+///
+/// [Image]s are backed by native objects, which can't be sent between
+/// isolates. A [TransferableImage] can be sent with a [SendPort] to any isolate
+/// of the same isolate group, such as an isolate started with [Isolate.spawn]
+/// or the root isolate of an engine spawned from the same engine. The pixels
+/// are shared, not copied, and stay alive until the receiving isolate calls
+/// [materialize] or [dispose].
+///
+/// Isolates that aren't root isolates can pass the handle on, but can't
+/// [materialize] it.
+final class TransferableImage {
+  /// Creates a handle to the pixels of `image`.
+  ///
+  /// The `image` can still be used, and must still be disposed, independently
+  /// of the handle.
+  factory TransferableImage(Image image) {
+    assert(!image._disposed && !image._image._disposed);
+    final int token = image._image._transfer();
+    if (token == 0) {
+      throw StateError('Cannot transfer a disposed image.');
+    }
+    return TransferableImage._(token);
+  }
+
+  TransferableImage._(this._token);
+
+  final int _token;
+
+  /// Creates a new [Image] of the pixels in the current isolate.
+  ///
+  /// A handle can only be materialized once, by one isolate. Throws if the
+  /// handle was already materialized or disposed, or if it was created in
+  /// another isolate group.
+  Image materialize() {
+    final _Image image = _Image._();
+    if (!_initTransferred(image, _token)) {
+      throw StateError(
+        'Cannot materialize a TransferableImage more than once, after it was '
+        'disposed, or in another isolate group.'
+      );
+    }
+    return Image._(image, image.width, image.height);
+  }
+
+  @Native<Bool Function(Handle, Int64)>(symbol: 'Image::initTransferred')
+  external static bool _initTransferred(_Image outImage, int token);
+
+  /// Releases the pixels of a handle that will not be materialized.
+  ///
+  /// Does nothing if the handle was already materialized or disposed.
+  void dispose() => _disposeTransferred(_token);
+
+  @Native<Void Function(Int64)>(symbol: 'Image::disposeTransferred')
+  external static void _disposeTransferred(int token);
+}
+
 /// Callback signature for [decodeImageFromList].
 typedef ImageDecoderCallback = void Function(Image result);
 
@@ -4523,6 +4583,24 @@ base class FragmentProgram extends NativeFieldWrapperClass1 {
   @Native<Handle Function(Pointer<Void>, Handle)>(symbol: 'FragmentProgram::initFromAsset')
   external String _initFromAsset(String assetKey);
 
+  /// Compiles the GPU pipeline of this program ahead of its first use.
+  ///
+  /// Without this, the pipeline is compiled when a shader from this program is
+  /// first drawn, which may cause a dropped frame. Calling this while nothing
+  /// else is animating, for example during a splash screen, moves that work
+  /// out of the frames that draw the shader.
+  ///
+  /// The returned future completes once the pipeline is compiled, and
+  /// completes with an error if compiling it failed. When the pipeline is
+  /// compiled on first use regardless, as with the Skia backend, the future
+  /// completes right away.
+  Future<void> warmUp() {
+    return _futurize((_Callback<bool> callback) => _warmUp(callback));
+  }
+
+  @Native<Handle Function(Pointer<Void>, Handle)>(symbol: 'FragmentProgram::warmUp')
+  external String? _warmUp(_Callback<bool> callback);
+
   /// Returns a fresh instance of [FragmentShader].
   FragmentShader fragmentShader() => FragmentShader._(this, debugName: _debugName);
 }
@@ -5758,6 +5836,24 @@ abstract class Canvas {
   void drawShadow(Path path, Color color, double elevation, bool transparentOccluder);
 }
 
+// Must be kept in sync with CanvasCommand in canvas.cc.
+enum _CanvasCommand {
+  save,
+  restore,
+  translate,
+  scale,
+  rotate,
+  clipRect,
+  setPaint,
+  drawColor,
+  drawLine,
+  drawPaint,
+  drawRect,
+  drawRRect,
+  drawOval,
+  drawCircle,
+}
+
 base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
   _NativeCanvas(PictureRecorder recorder, [ Rect? cullRect ])  {
     if (recorder.isRecording) {
@@ -5777,12 +5873,89 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
   // garbage collected until PictureRecorder.endRecording is called.
   _NativePictureRecorder? _recorder;
 
+  // Calls that don't involve any objects are recorded into a command stream,
+  // which the engine replays in one call when the stream is full and before
+  // any other call on this canvas. Custom painters often make thousands of
+  // such calls per frame, and each of them would otherwise cross into the
+  // engine on its own. The binary format must match CommandReader in
+  // canvas.cc.
+  static const int _kCommandBufferBytes = 8192;
+  static const int _kWordBytes = 4;
+  static const int _kDoubleBytes = 8;
+  static const int _kSetPaintBytes = _kWordBytes + Paint._kDataByteCount;
+  ByteData? _commands;
+  int _commandBytes = 0;
+  // The paint data of the command stream, which starts with the default paint.
+  final Uint32List _commandPaint = Uint32List(Paint._kDataByteCount ~/ _kWordBytes);
+
+  void _flushCommands() {
+    if (_commandBytes == 0) {
+      return;
+    }
+    _drawCommands(_commands!, _commandBytes);
+    _commandBytes = 0;
+    _commandPaint.fillRange(0, _commandPaint.length, 0);
+  }
+
+  @Native<Void Function(Pointer<Void>, Handle, Int32)>(symbol: 'Canvas::drawCommands')
+  external void _drawCommands(ByteData commands, int byteCount);
+
+  // Makes room for a command with the given size of arguments, and records the
+  // command. Commands that draw also record the paint when it has changed.
+  void _addCommand(_CanvasCommand command, int argumentBytes, [Paint? paint]) {
+    final int bytes = _kWordBytes + argumentBytes + (paint == null ? 0 : _kSetPaintBytes);
+    if (_commandBytes + bytes > _kCommandBufferBytes) {
+      _flushCommands();
+    }
+    _commands ??= ByteData(_kCommandBufferBytes);
+    if (paint != null) {
+      _addPaint(paint._data);
+    }
+    _addWord(command.index);
+  }
+
+  void _addPaint(ByteData data) {
+    bool changed = false;
+    for (int i = 0; i < _commandPaint.length; i++) {
+      final int word = data.getUint32(i * _kWordBytes, _kFakeHostEndian);
+      if (word != _commandPaint[i]) {
+        _commandPaint[i] = word;
+        changed = true;
+      }
+    }
+    if (changed) {
+      _addWord(_CanvasCommand.setPaint.index);
+      for (final int word in _commandPaint) {
+        _addWord(word);
+      }
+    }
+  }
+
+  void _addWord(int value) {
+    _commands!.setUint32(_commandBytes, value, _kFakeHostEndian);
+    _commandBytes += _kWordBytes;
+  }
+
+  void _addDouble(double value) {
+    _commands!.setFloat64(_commandBytes, value, _kFakeHostEndian);
+    _commandBytes += _kDoubleBytes;
+  }
+
+  void _addRect(double left, double top, double right, double bottom) {
+    _addDouble(left);
+    _addDouble(top);
+    _addDouble(right);
+    _addDouble(bottom);
+  }
+
   @override
-  @Native<Void Function(Pointer<Void>)>(symbol: 'Canvas::save', isLeaf: true)
-  external void save();
+  void save() {
+    _addCommand(_CanvasCommand.save, 0);
+  }
 
   @override
   void saveLayer(Rect? bounds, Paint paint) {
+    _flushCommands();
     if (bounds == null) {
       _saveLayerWithoutBounds(paint._objects, paint._data);
     } else {
@@ -5798,40 +5971,63 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
   external void _saveLayer(double left, double top, double right, double bottom, List<Object?>? paintObjects, ByteData paintData);
 
   @override
-  @Native<Void Function(Pointer<Void>)>(symbol: 'Canvas::restore', isLeaf: true)
-  external void restore();
+  void restore() {
+    _addCommand(_CanvasCommand.restore, 0);
+  }
 
   @override
+  void restoreToCount(int count) {
+    _flushCommands();
+    _restoreToCount(count);
+  }
+
   @Native<Void Function(Pointer<Void>, Int32)>(symbol: 'Canvas::restoreToCount', isLeaf: true)
-  external void restoreToCount(int count);
+  external void _restoreToCount(int count);
 
   @override
+  int getSaveCount() {
+    _flushCommands();
+    return _getSaveCount();
+  }
+
   @Native<Int32 Function(Pointer<Void>)>(symbol: 'Canvas::getSaveCount', isLeaf: true)
-  external int getSaveCount();
+  external int _getSaveCount();
 
   @override
-  @Native<Void Function(Pointer<Void>, Double, Double)>(symbol: 'Canvas::translate', isLeaf: true)
-  external void translate(double dx, double dy);
+  void translate(double dx, double dy) {
+    _addCommand(_CanvasCommand.translate, 2 * _kDoubleBytes);
+    _addDouble(dx);
+    _addDouble(dy);
+  }
 
   @override
-  void scale(double sx, [double? sy]) => _scale(sx, sy ?? sx);
-
-  @Native<Void Function(Pointer<Void>, Double, Double)>(symbol: 'Canvas::scale', isLeaf: true)
-  external void _scale(double sx, double sy);
+  void scale(double sx, [double? sy]) {
+    _addCommand(_CanvasCommand.scale, 2 * _kDoubleBytes);
+    _addDouble(sx);
+    _addDouble(sy ?? sx);
+  }
 
   @override
-  @Native<Void Function(Pointer<Void>, Double)>(symbol: 'Canvas::rotate', isLeaf: true)
-  external void rotate(double radians);
+  void rotate(double radians) {
+    _addCommand(_CanvasCommand.rotate, _kDoubleBytes);
+    _addDouble(radians);
+  }
 
   @override
+  void skew(double sx, double sy) {
+    _flushCommands();
+    _skew(sx, sy);
+  }
+
   @Native<Void Function(Pointer<Void>, Double, Double)>(symbol: 'Canvas::skew', isLeaf: true)
-  external void skew(double sx, double sy);
+  external void _skew(double sx, double sy);
 
   @override
   void transform(Float64List matrix4) {
     if (matrix4.length != 16) {
       throw ArgumentError('"matrix4" must have 16 entries.');
     }
+    _flushCommands();
     _transform(matrix4);
   }
 
@@ -5841,6 +6037,7 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
   @override
   Float64List getTransform() {
     final Float64List matrix4 = Float64List(16);
+    _flushCommands();
     _getTransform(matrix4);
     return matrix4;
   }
@@ -5851,15 +6048,16 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
   @override
   void clipRect(Rect rect, { ClipOp clipOp = ClipOp.intersect, bool doAntiAlias = true }) {
     assert(_rectIsValid(rect));
-    _clipRect(rect.left, rect.top, rect.right, rect.bottom, clipOp.index, doAntiAlias);
+    _addCommand(_CanvasCommand.clipRect, 4 * _kDoubleBytes + 2 * _kWordBytes);
+    _addRect(rect.left, rect.top, rect.right, rect.bottom);
+    _addWord(clipOp.index);
+    _addWord(doAntiAlias ? 1 : 0);
   }
 
-  @Native<Void Function(Pointer<Void>, Double, Double, Double, Double, Int32, Bool)>(symbol: 'Canvas::clipRect', isLeaf: true)
-  external void _clipRect(double left, double top, double right, double bottom, int clipOp, bool doAntiAlias);
-
   @override
   void clipRRect(RRect rrect, {bool doAntiAlias = true}) {
     assert(_rrectIsValid(rrect));
+    _flushCommands();
     _clipRRect(rrect._getValue32(), doAntiAlias);
   }
 
@@ -5868,6 +6066,7 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
 
   @override
   void clipPath(Path path, {bool doAntiAlias = true}) {
+    _flushCommands();
     _clipPath(path as _NativePath, doAntiAlias);
   }
 
@@ -5877,6 +6076,7 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
   @override
   Rect getLocalClipBounds() {
     final Float64List bounds = Float64List(4);
+    _flushCommands();
     _getLocalClipBounds(bounds);
     return Rect.fromLTRB(bounds[0], bounds[1], bounds[2], bounds[3]);
   }
@@ -5887,6 +6087,7 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
   @override
   Rect getDestinationClipBounds() {
     final Float64List bounds = Float64List(4);
+    _flushCommands();
     _getDestinationClipBounds(bounds);
     return Rect.fromLTRB(bounds[0], bounds[1], bounds[2], bounds[3]);
   }
@@ -5896,16 +6097,21 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
 
   @override
   void drawColor(Color color, BlendMode blendMode) {
-    _drawColor(color.value, blendMode.index);
+    _addCommand(_CanvasCommand.drawColor, 2 * _kWordBytes);
+    _addWord(color.value);
+    _addWord(blendMode.index);
   }
 
-  @Native<Void Function(Pointer<Void>, Uint32, Int32)>(symbol: 'Canvas::drawColor', isLeaf: true)
-  external void _drawColor(int color, int blendMode);
-
   @override
   void drawLine(Offset p1, Offset p2, Paint paint) {
     assert(_offsetIsValid(p1));
     assert(_offsetIsValid(p2));
+    if (paint._objects == null) {
+      _addCommand(_CanvasCommand.drawLine, 4 * _kDoubleBytes, paint);
+      _addRect(p1.dx, p1.dy, p2.dx, p2.dy);
+      return;
+    }
+    _flushCommands();
     _drawLine(p1.dx, p1.dy, p2.dx, p2.dy, paint._objects, paint._data);
   }
 
@@ -5914,6 +6120,11 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
 
   @override
   void drawPaint(Paint paint) {
+    if (paint._objects == null) {
+      _addCommand(_CanvasCommand.drawPaint, 0, paint);
+      return;
+    }
+    _flushCommands();
     _drawPaint(paint._objects, paint._data);
   }
 
@@ -5923,6 +6134,12 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
   @override
   void drawRect(Rect rect, Paint paint) {
     assert(_rectIsValid(rect));
+    if (paint._objects == null) {
+      _addCommand(_CanvasCommand.drawRect, 4 * _kDoubleBytes, paint);
+      _addRect(rect.left, rect.top, rect.right, rect.bottom);
+      return;
+    }
+    _flushCommands();
     _drawRect(rect.left, rect.top, rect.right, rect.bottom, paint._objects, paint._data);
   }
 
@@ -5932,6 +6149,20 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
   @override
   void drawRRect(RRect rrect, Paint paint) {
     assert(_rrectIsValid(rrect));
+    if (paint._objects == null) {
+      _addCommand(_CanvasCommand.drawRRect, 12 * _kDoubleBytes, paint);
+      _addRect(rrect.left, rrect.top, rrect.right, rrect.bottom);
+      _addDouble(rrect.tlRadiusX);
+      _addDouble(rrect.tlRadiusY);
+      _addDouble(rrect.trRadiusX);
+      _addDouble(rrect.trRadiusY);
+      _addDouble(rrect.brRadiusX);
+      _addDouble(rrect.brRadiusY);
+      _addDouble(rrect.blRadiusX);
+      _addDouble(rrect.blRadiusY);
+      return;
+    }
+    _flushCommands();
     _drawRRect(rrect._getValue32(), paint._objects, paint._data);
   }
 
@@ -5942,6 +6173,7 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
   void drawDRRect(RRect outer, RRect inner, Paint paint) {
     assert(_rrectIsValid(outer));
     assert(_rrectIsValid(inner));
+    _flushCommands();
     _drawDRRect(outer._getValue32(), inner._getValue32(), paint._objects, paint._data);
   }
 
@@ -5951,6 +6183,12 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
   @override
   void drawOval(Rect rect, Paint paint) {
     assert(_rectIsValid(rect));
+    if (paint._objects == null) {
+      _addCommand(_CanvasCommand.drawOval, 4 * _kDoubleBytes, paint);
+      _addRect(rect.left, rect.top, rect.right, rect.bottom);
+      return;
+    }
+    _flushCommands();
     _drawOval(rect.left, rect.top, rect.right, rect.bottom, paint._objects, paint._data);
   }
 
@@ -5960,6 +6198,14 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
   @override
   void drawCircle(Offset c, double radius, Paint paint) {
     assert(_offsetIsValid(c));
+    if (paint._objects == null) {
+      _addCommand(_CanvasCommand.drawCircle, 3 * _kDoubleBytes, paint);
+      _addDouble(c.dx);
+      _addDouble(c.dy);
+      _addDouble(radius);
+      return;
+    }
+    _flushCommands();
     _drawCircle(c.dx, c.dy, radius, paint._objects, paint._data);
   }
 
@@ -5969,6 +6215,7 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
   @override
   void drawArc(Rect rect, double startAngle, double sweepAngle, bool useCenter, Paint paint) {
     assert(_rectIsValid(rect));
+    _flushCommands();
     _drawArc(rect.left, rect.top, rect.right, rect.bottom, startAngle, sweepAngle, useCenter, paint._objects, paint._data);
   }
 
@@ -5986,6 +6233,7 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
 
   @override
   void drawPath(Path path, Paint paint) {
+    _flushCommands();
     _drawPath(path as _NativePath, paint._objects, paint._data);
   }
 
@@ -5996,6 +6244,7 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
   void drawImage(Image image, Offset offset, Paint paint) {
     assert(!image.debugDisposed);
     assert(_offsetIsValid(offset));
+    _flushCommands();
     final String? error = _drawImage(image._image, offset.dx, offset.dy, paint._objects, paint._data, paint.filterQuality.index);
     if (error != null) {
       throw PictureRasterizationException._(error, stack: image._debugStack);
@@ -6010,6 +6259,7 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
     assert(!image.debugDisposed);
     assert(_rectIsValid(src));
     assert(_rectIsValid(dst));
+    _flushCommands();
     final String? error = _drawImageRect(image._image,
                                          src.left,
                                          src.top,
@@ -6047,6 +6297,7 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
     assert(!image.debugDisposed);
     assert(_rectIsValid(center));
     assert(_rectIsValid(dst));
+    _flushCommands();
     final String? error = _drawImageNine(image._image,
                                          center.left,
                                          center.top,
@@ -6082,6 +6333,7 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
   @override
   void drawPicture(Picture picture) {
     assert(!picture.debugDisposed);
+    _flushCommands();
     _drawPicture(picture as _NativePicture);
   }
 
@@ -6094,11 +6346,13 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
     assert(!nativeParagraph.debugDisposed);
     assert(_offsetIsValid(offset));
     assert(!nativeParagraph._needsLayout);
+    _flushCommands();
     nativeParagraph._paint(this, offset.dx, offset.dy);
   }
 
   @override
   void drawPoints(PointMode pointMode, List<Offset> points, Paint paint) {
+    _flushCommands();
     _drawPoints(paint._objects, paint._data, pointMode.index, _encodePointList(points));
   }
 
@@ -6107,6 +6361,7 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
     if (points.length % 2 != 0) {
       throw ArgumentError('"points" must have an even number of values.');
     }
+    _flushCommands();
     _drawPoints(paint._objects, paint._data, pointMode.index, points);
   }
 
@@ -6116,6 +6371,7 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
   @override
   void drawVertices(Vertices vertices, BlendMode blendMode, Paint paint) {
     assert(!vertices.debugDisposed);
+    _flushCommands();
     _drawVertices(vertices, blendMode.index, paint._objects, paint._data);
   }
 
@@ -6166,6 +6422,7 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
     final Float32List? cullRectBuffer = cullRect?._getValue32();
     final int qualityIndex = paint.filterQuality.index;
 
+    _flushCommands();
     final String? error = _drawAtlas(
       paint._objects, paint._data, qualityIndex, atlas._image, rstTransformBuffer, rectBuffer,
       colorBuffer, (blendMode ?? BlendMode.src).index, cullRectBuffer
@@ -6198,6 +6455,7 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
     }
     final int qualityIndex = paint.filterQuality.index;
 
+    _flushCommands();
     final String? error = _drawAtlas(
       paint._objects, paint._data, qualityIndex, atlas._image, rstTransforms, rects,
       colors, (blendMode ?? BlendMode.src).index, cullRect?._getValue32()
@@ -6222,6 +6480,7 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
 
   @override
   void drawShadow(Path path, Color color, double elevation, bool transparentOccluder) {
+    _flushCommands();
     _drawShadow(path as _NativePath, color.value, elevation, transparentOccluder);
   }
 
@@ -6370,6 +6629,68 @@ base class _NativePicture extends NativeFieldWrapperClass1 implements Picture {
   @override
   @Native<Uint64 Function(Pointer<Void>)>(symbol: 'Picture::GetAllocationSize', isLeaf: true)
   external int get approximateBytesUsed;
+
+  @Native<Int64 Function(Pointer<Void>)>(symbol: 'Picture::transfer')
+  external int _transfer();
+}
+
+/// A handle to the recorded graphical operations of a [Picture] that can be
+/// sent to another isolate.
+///
+/// [Picture]s are backed by native objects, which can't be sent between
+/// isolates. A [TransferablePicture] can be sent with a [SendPort] to any
+/// isolate of the same isolate group, such as an isolate started with
+/// [Isolate.spawn] or the root isolate of an engine spawned from the same
+/// engine. The operations are shared, not copied, and stay alive until the
+/// receiving isolate calls [materialize] or [dispose].
+///
+/// Isolates that aren't root isolates can pass the handle on, but can't
+/// [materialize] it.
+final class TransferablePicture {
+  /// Creates a handle to the operations of `picture`.
+  ///
+  /// The `picture` can still be used, and must still be disposed,
+  /// independently of the handle.
+  factory TransferablePicture(Picture picture) {
+    assert(!picture.debugDisposed);
+    final int token = (picture as _NativePicture)._transfer();
+    if (token == 0) {
+      throw StateError('Cannot transfer a disposed picture.');
+    }
+    return TransferablePicture._(token);
+  }
+
+  TransferablePicture._(this._token);
+
+  final int _token;
+
+  /// Creates a new [Picture] of the operations in the current isolate.
+  ///
+  /// A handle can only be materialized once, by one isolate. Throws if the
+  /// handle was already materialized or disposed, or if it was created in
+  /// another isolate group.
+  Picture materialize() {
+    final _NativePicture picture = _NativePicture._();
+    if (!_initTransferred(picture, _token)) {
+      throw StateError(
+        'Cannot materialize a TransferablePicture more than once, after it '
+        'was disposed, or in another isolate group.'
+      );
+    }
+    Picture.onCreate?.call(picture);
+    return picture;
+  }
+
+  @Native<Bool Function(Handle, Int64)>(symbol: 'Picture::initTransferred')
+  external static bool _initTransferred(_NativePicture outPicture, int token);
+
+  /// Releases the operations of a handle that will not be materialized.
+  ///
+  /// Does nothing if the handle was already materialized or disposed.
+  void dispose() => _disposeTransferred(_token);
+
+  @Native<Void Function(Int64)>(symbol: 'Picture::disposeTransferred')
+  external static void _disposeTransferred(int token);
 }
 
 /// Records a [Picture] containing a sequence of graphical operations.
@@ -6413,6 +6734,7 @@ base class _NativePictureRecorder extends NativeFieldWrapperClass1 implements Pi
     if (_canvas == null) {
       throw StateError('PictureRecorder did not start recording.');
     }
+    _canvas!._flushCommands();
     final _NativePicture picture = _NativePicture._();
     _endRecording(picture);
     _canvas!._recorder = null;
@@ -6665,6 +6987,33 @@ base class ImmutableBuffer extends NativeFieldWrapperClass1 {
     });
   }
 
+  /// Create a buffer from [length] bytes of the asset with key [assetKey],
+  /// starting at [offset].
+  ///
+  /// This avoids loading all of a large asset, such as a sprite sheet or a
+  /// font collection, when only part of it is needed.
+  ///
+  /// Throws an [Exception] if the asset does not exist, and a [RangeError] if
+  /// the range is not within the asset.
+  static Future<ImmutableBuffer> fromAssetRange(String assetKey, int offset, int length) {
+    RangeError.checkNotNegative(offset, 'offset');
+    RangeError.checkNotNegative(length, 'length');
+    // See [fromAsset].
+    final String encodedKey = Uri(path: Uri.encodeFull(assetKey)).path;
+    final ImmutableBuffer instance = ImmutableBuffer._(0);
+    return _futurize((_Callback<int> callback) {
+      return instance._initFromAssetRange(encodedKey, offset, length, callback);
+    }).then((int result) {
+      if (result == -1) {
+        throw Exception('Asset not found');
+      }
+      if (result == -2) {
+        throw RangeError('The range $offset..${offset + length} is not within the asset $assetKey.');
+      }
+      return instance.._length = result;
+    });
+  }
+
   /// Create a buffer from the file with [path].
   ///
   /// Throws an [Exception] if the asset does not exist.
@@ -6686,6 +7035,9 @@ base class ImmutableBuffer extends NativeFieldWrapperClass1 {
   @Native<Handle Function(Handle, Handle, Handle)>(symbol: 'ImmutableBuffer::initFromAsset')
   external String? _initFromAsset(String assetKey, _Callback<int> callback);
 
+  @Native<Handle Function(Handle, Handle, Int64, Int64, Handle)>(symbol: 'ImmutableBuffer::initFromAssetRange')
+  external String? _initFromAssetRange(String assetKey, int offset, int length, _Callback<int> callback);
+
   @Native<Handle Function(Handle, Handle, Handle)>(symbol: 'ImmutableBuffer::initFromFile')
   external String? _initFromFile(String assetKey, _Callback<int> callback);
 
@@ -5,6 +5,7 @@
 #include "flutter/lib/ui/painting/canvas.h"
 
 #include <cmath>
+#include <cstring>
 
 #include "flutter/display_list/dl_builder.h"
 #include "flutter/lib/ui/floating_point.h"
@@ -13,6 +14,7 @@
 #include "flutter/lib/ui/painting/paint.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/lib/ui/window/platform_configuration.h"
+#include "third_party/tonic/typed_data/dart_byte_data.h"
 
 using tonic::ToDart;
 
@@ -20,6 +22,69 @@ namespace flutter {
 
 IMPLEMENT_WRAPPERTYPEINFO(ui, Canvas);
 
+namespace {
+
+// Must be kept in sync with _CanvasCommand in painting.dart.
+enum class CanvasCommand : uint32_t {
+  kSave,
+  kRestore,
+  kTranslate,
+  kScale,
+  kRotate,
+  kClipRect,
+  kSetPaint,
+  kDrawColor,
+  kDrawLine,
+  kDrawPaint,
+  kDrawRect,
+  kDrawRRect,
+  kDrawOval,
+  kDrawCircle,
+};
+
+// Reads the values of a command stream. Opcodes, enums and the words of a
+// paint are 32 bit values and geometry is made of doubles, all in host byte
+// order and without any padding.
+class CommandReader {
+ public:
+  CommandReader(const uint8_t* data, size_t byte_count)
+      : data_(data), end_(data + byte_count) {}
+
+  bool AtEnd() const { return data_ == end_; }
+
+  bool ReadWords(uint32_t* words, size_t count) {
+    return Read(words, count * sizeof(uint32_t));
+  }
+
+  bool ReadWord(uint32_t& word) { return ReadWords(&word, 1); }
+
+  bool ReadScalars(SkScalar* scalars, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+      double value;
+      if (!Read(&value, sizeof(value))) {
+        return false;
+      }
+      scalars[i] = SafeNarrow(value);
+    }
+    return true;
+  }
+
+ private:
+  bool Read(void* destination, size_t byte_count) {
+    if (static_cast<size_t>(end_ - data_) < byte_count) {
+      return false;
+    }
+    memcpy(destination, data_, byte_count);
+    data_ += byte_count;
+    return true;
+  }
+
+  const uint8_t* data_;
+  const uint8_t* const end_;
+};
+
+}  // namespace
+
 void Canvas::Create(Dart_Handle wrapper,
                     PictureRecorder* recorder,
                     double left,
@@ -643,6 +708,152 @@ void Canvas::drawShadow(const CanvasPath* path,
   }
 }
 
+void Canvas::drawCommands(Dart_Handle commands_handle, int byte_count) {
+  bool valid = true;
+  {
+    // No Dart API can be called while the command stream is acquired.
+    tonic::DartByteData commands(commands_handle);
+    if (byte_count < 0 ||
+        static_cast<size_t>(byte_count) > commands.length_in_bytes()) {
+      valid = false;
+    } else if (display_list_builder_) {
+      valid = ReplayCommands(static_cast<const uint8_t*>(commands.data()),
+                             byte_count);
+    }
+  }
+  if (!valid) {
+    Dart_ThrowException(
+        ToDart("Canvas.drawCommands called with a malformed command stream."));
+  }
+}
+
+bool Canvas::ReplayCommands(const uint8_t* commands, size_t byte_count) {
+  CommandReader reader(commands, byte_count);
+  // All zeros is the data of a default Paint.
+  uint32_t paint_data[Paint::kDataWordCount] = {};
+  SkScalar values[12];
+  uint32_t words[2];
+  while (!reader.AtEnd()) {
+    uint32_t command;
+    if (!reader.ReadWord(command)) {
+      return false;
+    }
+    switch (static_cast<CanvasCommand>(command)) {
+      case CanvasCommand::kSave:
+        builder()->Save();
+        break;
+      case CanvasCommand::kRestore:
+        builder()->Restore();
+        break;
+      case CanvasCommand::kTranslate:
+        if (!reader.ReadScalars(values, 2)) {
+          return false;
+        }
+        builder()->Translate(values[0], values[1]);
+        break;
+      case CanvasCommand::kScale:
+        if (!reader.ReadScalars(values, 2)) {
+          return false;
+        }
+        builder()->Scale(values[0], values[1]);
+        break;
+      case CanvasCommand::kRotate:
+        if (!reader.ReadScalars(values, 1)) {
+          return false;
+        }
+        builder()->Rotate(values[0] * 180.0f / static_cast<float>(M_PI));
+        break;
+      case CanvasCommand::kClipRect:
+        if (!reader.ReadScalars(values, 4) || !reader.ReadWords(words, 2)) {
+          return false;
+        }
+        builder()->ClipRect(
+            SkRect::MakeLTRB(values[0], values[1], values[2], values[3]),
+            static_cast<DlCanvas::ClipOp>(words[0]), words[1] != 0);
+        break;
+      case CanvasCommand::kSetPaint:
+        if (!reader.ReadWords(paint_data, Paint::kDataWordCount)) {
+          return false;
+        }
+        break;
+      case CanvasCommand::kDrawColor:
+        if (!reader.ReadWords(words, 2)) {
+          return false;
+        }
+        builder()->DrawColor(words[0], static_cast<DlBlendMode>(words[1]));
+        break;
+      case CanvasCommand::kDrawLine: {
+        if (!reader.ReadScalars(values, 4)) {
+          return false;
+        }
+        DlPaint dl_paint;
+        Paint::paintWithoutObjects(dl_paint, paint_data, kDrawLineFlags);
+        builder()->DrawLine(SkPoint::Make(values[0], values[1]),
+                            SkPoint::Make(values[2], values[3]), dl_paint);
+        break;
+      }
+      case CanvasCommand::kDrawPaint: {
+        DlPaint dl_paint;
+        Paint::paintWithoutObjects(dl_paint, paint_data, kDrawPaintFlags);
+        builder()->DrawPaint(dl_paint);
+        break;
+      }
+      case CanvasCommand::kDrawRect: {
+        if (!reader.ReadScalars(values, 4)) {
+          return false;
+        }
+        DlPaint dl_paint;
+        Paint::paintWithoutObjects(dl_paint, paint_data, kDrawRectFlags);
+        builder()->DrawRect(
+            SkRect::MakeLTRB(values[0], values[1], values[2], values[3]),
+            dl_paint);
+        break;
+      }
+      case CanvasCommand::kDrawRRect: {
+        if (!reader.ReadScalars(values, 12)) {
+          return false;
+        }
+        SkVector radii[4] = {{values[4], values[5]},
+                             {values[6], values[7]},
+                             {values[8], values[9]},
+                             {values[10], values[11]}};
+        SkRRect rrect;
+        rrect.setRectRadii(
+            SkRect::MakeLTRB(values[0], values[1], values[2], values[3]),
+            radii);
+        DlPaint dl_paint;
+        Paint::paintWithoutObjects(dl_paint, paint_data, kDrawRRectFlags);
+        builder()->DrawRRect(rrect, dl_paint);
+        break;
+      }
+      case CanvasCommand::kDrawOval: {
+        if (!reader.ReadScalars(values, 4)) {
+          return false;
+        }
+        DlPaint dl_paint;
+        Paint::paintWithoutObjects(dl_paint, paint_data, kDrawOvalFlags);
+        builder()->DrawOval(
+            SkRect::MakeLTRB(values[0], values[1], values[2], values[3]),
+            dl_paint);
+        break;
+      }
+      case CanvasCommand::kDrawCircle: {
+        if (!reader.ReadScalars(values, 3)) {
+          return false;
+        }
+        DlPaint dl_paint;
+        Paint::paintWithoutObjects(dl_paint, paint_data, kDrawCircleFlags);
+        builder()->DrawCircle(SkPoint::Make(values[0], values[1]), values[2],
+                              dl_paint);
+        break;
+      }
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
 void Canvas::Invalidate() {
   display_list_builder_ = nullptr;
   if (dart_wrapper()) {
@@ -184,6 +184,11 @@ class Canvas : public RefCountedDartWrappable<Canvas>, DisplayListOpFlags {
                   double elevation,
                   bool transparentOccluder);
 
+  // Replays the first |byte_count| bytes of a command stream recorded by
+  // _NativeCanvas in painting.dart, so that a run of calls that don't
+  // involve any objects crosses into the engine only once.
+  void drawCommands(Dart_Handle commands_handle, int byte_count);
+
   void Invalidate();
 
   DisplayListBuilder* builder() { return display_list_builder_.get(); }
@@ -191,6 +196,8 @@ class Canvas : public RefCountedDartWrappable<Canvas>, DisplayListOpFlags {
  private:
   explicit Canvas(sk_sp<DisplayListBuilder> builder);
 
+  bool ReplayCommands(const uint8_t* commands, size_t byte_count);
+
   sk_sp<DisplayListBuilder> display_list_builder_;
 };
 
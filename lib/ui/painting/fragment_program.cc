@@ -9,17 +9,24 @@
 #include "flutter/lib/ui/painting/fragment_program.h"
 
 #include "flutter/assets/asset_manager.h"
+#include "flutter/fml/make_copyable.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/impeller/runtime_stage/runtime_stage.h"
 #include "flutter/lib/ui/dart_wrapper.h"
+#include "flutter/lib/ui/io_manager.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/lib/ui/window/platform_configuration.h"
+#if IMPELLER_SUPPORTS_RENDERING
+#include "flutter/impeller/entity/contents/runtime_effect_contents.h"
+#endif  // IMPELLER_SUPPORTS_RENDERING
 
 #include "third_party/skia/include/core/SkString.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_binding_macros.h"
 #include "third_party/tonic/dart_library_natives.h"
+#include "third_party/tonic/dart_persistent_value.h"
+#include "third_party/tonic/logging/dart_invoke.h"
 #include "third_party/tonic/typed_data/typed_list.h"
 
 namespace flutter {
@@ -95,6 +102,83 @@ std::string FragmentProgram::initFromAsset(const std::string& asset_name) {
   return "";
 }
 
+Dart_Handle FragmentProgram::warmUp(Dart_Handle callback_handle) {
+  if (Dart_IsNull(callback_handle) || !Dart_IsClosure(callback_handle)) {
+    return tonic::ToDart("Warm up callback was invalid");
+  }
+  if (!runtime_effect_) {
+    return tonic::ToDart("Fragment program was not initialized");
+  }
+
+  auto* dart_state = UIDartState::Current();
+  auto callback = std::make_unique<tonic::DartPersistentValue>(
+      dart_state, callback_handle);
+  auto ui_task_runner = dart_state->GetTaskRunners().GetUITaskRunner();
+
+  auto ui_task = fml::MakeCopyable(
+      [callback = std::move(callback)](bool success) mutable {
+        auto dart_state = callback->dart_state().lock();
+        if (!dart_state) {
+          // The root isolate could have died in the meantime.
+          return;
+        }
+        tonic::DartState::Scope scope(dart_state);
+        tonic::DartInvoke(callback->Get(),
+                          {success ? Dart_True() : Dart_Null()});
+
+        // The callback is associated with the Dart isolate and must be
+        // deleted on the UI thread.
+        callback.reset();
+      });
+
+#if IMPELLER_SUPPORTS_RENDERING
+  auto runtime_stage = runtime_effect_->runtime_stage();
+  if (dart_state->IsImpellerEnabled() && runtime_stage) {
+    TRACE_EVENT0("flutter", "FragmentProgram::warmUp");
+    auto io_task_runner = dart_state->GetTaskRunners().GetIOTaskRunner();
+    auto raster_task_runner =
+        dart_state->GetTaskRunners().GetRasterTaskRunner();
+
+    // The Impeller context is owned by the IO manager, the shader is
+    // registered on the raster thread that draws runtime effects, and the
+    // pipeline compile is waited for on a worker so that neither of them is
+    // blocked on it.
+    auto complete = [ui_task_runner, ui_task](bool success) {
+      ui_task_runner->PostTask([ui_task, success]() { ui_task(success); });
+    };
+    auto concurrent_runner = dart_state->GetConcurrentTaskRunner();
+    auto bootstrap = [runtime_stage, complete, concurrent_runner](
+                         const std::shared_ptr<impeller::Context>& context) {
+      auto future = impeller::RuntimeEffectContents::BootstrapShader(
+          context, runtime_stage);
+      if (!future.IsValid()) {
+        complete(false);
+        return;
+      }
+      concurrent_runner->PostTask([future, complete]() {
+        complete(future.Get() != nullptr);
+      });
+    };
+    io_task_runner->PostTask([io_manager = dart_state->GetIOManager(),
+                              raster_task_runner, bootstrap, complete]() {
+      auto context = io_manager ? io_manager->GetImpellerContext() : nullptr;
+      if (!context) {
+        complete(false);
+        return;
+      }
+      raster_task_runner->PostTask(
+          [bootstrap, context]() { bootstrap(context); });
+    });
+    return Dart_Null();
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
+  // Skia compiles the SkSL of the effect when the program is initialized and
+  // its GPU program on first use, so there is nothing to warm up.
+  ui_task_runner->PostTask([ui_task]() { ui_task(true); });
+  return Dart_Null();
+}
+
 std::shared_ptr<DlColorSource> FragmentProgram::MakeDlColorSource(
     std::shared_ptr<std::vector<uint8_t>> float_uniforms,
     const std::vector<std::shared_ptr<DlColorSource>>& children) {
@@ -30,6 +30,10 @@ class FragmentProgram : public RefCountedDartWrappable<FragmentProgram> {
 
   std::string initFromAsset(const std::string& asset_name);
 
+  /// Compiles the pipeline of the program ahead of its first draw, then
+  /// invokes `callback_handle` with true, or with null if it failed.
+  Dart_Handle warmUp(Dart_Handle callback_handle);
+
   fml::RefPtr<FragmentShader> shader(Dart_Handle shader,
                                      Dart_Handle uniforms_handle,
                                      Dart_Handle samplers);
@@ -11,6 +11,7 @@
 #include "flutter/lib/ui/painting/image_encoding_impeller.h"
 #endif
 #include "flutter/lib/ui/painting/image_encoding.h"
+#include "flutter/lib/ui/painting/transfer_registry.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_binding_macros.h"
@@ -50,4 +51,25 @@ int CanvasImage::colorSpace() {
   return -1;
 }
 
+int64_t CanvasImage::transfer() {
+  return TransferRegistry<DlImage>::Add(image_);
+}
+
+bool CanvasImage::initTransferred(Dart_Handle raw_image_handle,
+                                  int64_t token) {
+  UIDartState::ThrowIfUIOperationsProhibited();
+  auto image = TransferRegistry<DlImage>::Take(token);
+  if (!image) {
+    return false;
+  }
+  auto canvas_image = CanvasImage::Create();
+  canvas_image->set_image(std::move(image));
+  canvas_image->AssociateWithDartWrapper(raw_image_handle);
+  return true;
+}
+
+void CanvasImage::disposeTransferred(int64_t token) {
+  TransferRegistry<DlImage>::Take(token);
+}
+
 }  // namespace flutter
@@ -46,6 +46,16 @@ class CanvasImage final : public RefCountedDartWrappable<CanvasImage> {
 
   int colorSpace();
 
+  // Adds the image to the registry of transferable images and returns its
+  // token, or zero if the image was disposed.
+  int64_t transfer();
+
+  // Creates the image of a token returned by |transfer| in the isolate group
+  // of the current isolate. The token can't be used again.
+  static bool initTransferred(Dart_Handle raw_image_handle, int64_t token);
+
+  static void disposeTransferred(int64_t token);
+
  private:
   CanvasImage();
 
@@ -25,7 +25,8 @@ std::unique_ptr<ImageDecoder> ImageDecoder::Make(
         std::move(concurrent_task_runner),  //
         std::move(io_manager),              //
         settings.enable_wide_gamut,         //
-        gpu_disabled_switch);
+        gpu_disabled_switch,                //
+        settings.enable_impeller_gpu_image_downscaling);
   }
 #endif  // IMPELLER_SUPPORTS_RENDERING
   return std::make_unique<ImageDecoderSkia>(
@@ -4,20 +4,25 @@
 
 #include "flutter/lib/ui/painting/image_decoder_impeller.h"
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/impeller/aiks/aiks_context.h"
 #include "flutter/impeller/core/allocator.h"
 #include "flutter/impeller/core/texture.h"
 #include "flutter/impeller/display_list/dl_image_impeller.h"
 #include "flutter/impeller/renderer/command_buffer.h"
 #include "flutter/impeller/renderer/context.h"
 #include "flutter/lib/ui/painting/image_decoder_skia.h"
+#include "flutter/lib/ui/painting/image_generator_ktx2.h"
 #include "impeller/base/strings.h"
 #include "impeller/display_list/skia_conversions.h"
 #include "impeller/geometry/size.h"
+#include "impeller/typographer/backends/skia/typographer_context_skia.h"
 #include "third_party/skia/include/core/SkAlphaType.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkColorSpace.h"
@@ -29,6 +34,8 @@
 #include "third_party/skia/include/core/SkPoint.h"
 #include "third_party/skia/include/core/SkSamplingOptions.h"
 #include "third_party/skia/include/core/SkSize.h"
+#include "third_party/skia/include/core/SkYUVAInfo.h"
+#include "third_party/skia/include/core/SkYUVAPixmaps.h"
 
 namespace flutter {
 
@@ -117,10 +124,16 @@ ImageDecoderImpeller::ImageDecoderImpeller(
     std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
     const fml::WeakPtr<IOManager>& io_manager,
     bool supports_wide_gamut,
-    const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch)
+    const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch,
+    bool enable_gpu_downscaling)
     : ImageDecoder(runners, std::move(concurrent_task_runner), io_manager),
       supports_wide_gamut_(supports_wide_gamut),
-      gpu_disabled_switch_(gpu_disabled_switch) {
+      gpu_disabled_switch_(gpu_disabled_switch),
+      enable_gpu_downscaling_(enable_gpu_downscaling),
+      upload_batcher_(
+          fml::MakeRefCounted<ImageUploadBatcher>(runners.GetIOTaskRunner(),
+                                                  gpu_disabled_switch)),
+      yuv_conversion_context_(std::make_shared<YUVConversionContext>()) {
   std::promise<std::shared_ptr<impeller::Context>> context_promise;
   context_ = context_promise.get_future();
   runners_.GetIOTaskRunner()->PostTask(fml::MakeCopyable(
@@ -145,12 +158,31 @@ static SkAlphaType ChooseCompatibleAlphaType(SkAlphaType type) {
   return type;
 }
 
+static SkISize GetMipLevelSize(SkISize size, size_t mip_level) {
+  return SkISize::Make(std::max(size.width() >> mip_level, 1),
+                       std::max(size.height() >> mip_level, 1));
+}
+
+// Find the mip level of an image of the given size that is the target size, or
+// zero if there is none.
+static size_t GetMipLevelForTargetSize(SkISize size, SkISize target_size) {
+  const auto mip_count =
+      impeller::ISize(size.width(), size.height()).MipCount();
+  for (size_t mip_level = 1u; mip_level < mip_count; mip_level++) {
+    if (GetMipLevelSize(size, mip_level) == target_size) {
+      return mip_level;
+    }
+  }
+  return 0u;
+}
+
 DecompressResult ImageDecoderImpeller::DecompressTexture(
     ImageDescriptor* descriptor,
     SkISize target_size,
     impeller::ISize max_texture_size,
     bool supports_wide_gamut,
-    const std::shared_ptr<impeller::Allocator>& allocator) {
+    const std::shared_ptr<impeller::Allocator>& allocator,
+    bool allow_gpu_downscaling) {
   TRACE_EVENT0("impeller", __FUNCTION__);
   if (!descriptor) {
     std::string decode_error("Invalid descriptor (should never happen)");
@@ -169,6 +201,23 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
     decode_size = descriptor->get_scaled_dimensions(std::max(
         static_cast<float>(target_size.width()) / source_size.width(),
         static_cast<float>(target_size.height()) / source_size.height()));
+  } else if (!target_size.isEmpty()) {
+    // Raw pixels are converted and resized in a single pass.
+    decode_size = target_size;
+  }
+
+  // If the image is a power of two multiple of the target size, leave the
+  // resize to the GPU, which can produce it by generating mipmaps.
+  size_t mip_level = 0u;
+  const auto full_size =
+      descriptor->is_compressed() ? decode_size : source_size;
+  if (allow_gpu_downscaling && !target_size.isEmpty() &&
+      full_size.width() <= max_texture_size.width &&
+      full_size.height() <= max_texture_size.height) {
+    mip_level = GetMipLevelForTargetSize(full_size, target_size);
+    if (mip_level > 0u) {
+      decode_size = full_size;
+    }
   }
 
   //----------------------------------------------------------------------------
@@ -213,7 +262,13 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
   auto bitmap_allocator = std::make_shared<ImpellerAllocator>(allocator);
 
   if (descriptor->is_compressed()) {
-    if (!bitmap->tryAllocPixels(bitmap_allocator.get())) {
+    // If the codec can't decode at the target size, the decoded image is only
+    // read by the resize below. Keep it out of device memory so that it isn't
+    // allocated alongside the resized image.
+    const bool allocated = decode_size == target_size || mip_level > 0u
+                               ? bitmap->tryAllocPixels(bitmap_allocator.get())
+                               : bitmap->tryAllocPixels();
+    if (!allocated) {
       std::string decode_error(
           "Could not allocate intermediate for image decompression.");
       FML_DLOG(ERROR) << decode_error;
@@ -238,18 +293,28 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
       FML_DLOG(ERROR) << decode_error;
       return DecompressResult{.decode_error = decode_error};
     }
-    temp_bitmap->readPixels(bitmap->pixmap());
+    if (bitmap->dimensions() == source_size) {
+      temp_bitmap->readPixels(bitmap->pixmap());
+    } else {
+      TRACE_EVENT0("impeller", "DecodeScale");
+      if (!temp_bitmap->pixmap().scalePixels(
+              bitmap->pixmap(),
+              SkSamplingOptions(SkFilterMode::kLinear, SkMipmapMode::kNone))) {
+        FML_LOG(ERROR) << "Could not scale pixel data.";
+      }
+    }
     bitmap->setImmutable();
   }
 
-  if (bitmap->dimensions() == target_size) {
+  if (bitmap->dimensions() == target_size || mip_level > 0u) {
     auto buffer = bitmap_allocator->GetDeviceBuffer();
     if (!buffer) {
       return DecompressResult{.decode_error = "Unable to get device buffer"};
     }
     return DecompressResult{.device_buffer = buffer,
                             .sk_bitmap = bitmap,
-                            .image_info = bitmap->info()};
+                            .image_info = bitmap->info(),
+                            .mip_level = mip_level};
   }
 
   //----------------------------------------------------------------------------
@@ -284,11 +349,111 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
                           .image_info = scaled_bitmap->info()};
 }
 
+static std::optional<impeller::YUVColorSpace> ToYUVColorSpace(
+    SkYUVColorSpace yuv_color_space) {
+  switch (yuv_color_space) {
+    case kJPEG_Full_SkYUVColorSpace:
+      return impeller::YUVColorSpace::kBT601FullRange;
+    case kRec601_Limited_SkYUVColorSpace:
+      return impeller::YUVColorSpace::kBT601LimitedRange;
+    default:
+      return std::nullopt;
+  }
+}
+
+std::optional<DecompressYUVResult> ImageDecoderImpeller::DecompressYUVTexture(
+    ImageDescriptor* descriptor,
+    SkISize target_size,
+    impeller::ISize max_texture_size,
+    bool supports_wide_gamut,
+    const std::shared_ptr<impeller::Allocator>& allocator) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  if (!descriptor || !descriptor->is_compressed()) {
+    return std::nullopt;
+  }
+
+  // Planes are only decoded at the full size of the image, and the planes of
+  // wide gamut images would have to be converted to sRGB on the CPU anyway.
+  const auto& image_info = descriptor->image_info();
+  if (target_size != image_info.dimensions() ||
+      target_size.width() > max_texture_size.width ||
+      target_size.height() > max_texture_size.height ||
+      image_info.alphaType() != kOpaque_SkAlphaType ||
+      (supports_wide_gamut && IsWideGamut(image_info.colorSpace()))) {
+    return std::nullopt;
+  }
+
+  SkYUVAPixmapInfo::SupportedDataTypes supported_data_types;
+  supported_data_types.enableDataType(SkYUVAPixmapInfo::DataType::kUnorm8, 1);
+  SkYUVAPixmapInfo codec_info;
+  if (!descriptor->query_yuva_info(supported_data_types, &codec_info)) {
+    return std::nullopt;
+  }
+  const SkYUVAInfo& yuva_info = codec_info.yuvaInfo();
+  const auto yuv_color_space = ToYUVColorSpace(yuva_info.yuvColorSpace());
+  if (yuva_info.planeConfig() != SkYUVAInfo::PlaneConfig::kY_U_V ||
+      yuva_info.origin() != kTopLeft_SkEncodedOrigin ||
+      yuva_info.dimensions() != target_size || !yuv_color_space.has_value()) {
+    return std::nullopt;
+  }
+
+  // Decode into tightly packed planes so that the luma plane can be uploaded
+  // from the buffer as is.
+  const SkYUVAPixmapInfo plane_info(
+      yuva_info, SkYUVAPixmapInfo::DataType::kUnorm8, /*rowBytes=*/nullptr);
+  impeller::DeviceBufferDescriptor planes_descriptor;
+  planes_descriptor.storage_mode = impeller::StorageMode::kHostVisible;
+  planes_descriptor.size = plane_info.computeTotalBytes();
+  auto y_buffer = allocator->CreateBuffer(planes_descriptor);
+  if (!y_buffer) {
+    return std::nullopt;
+  }
+  auto pixmaps =
+      SkYUVAPixmaps::FromExternalMemory(plane_info, y_buffer->OnGetContents());
+  if (!pixmaps.isValid() || !descriptor->get_yuva_planes(pixmaps)) {
+    FML_DLOG(ERROR) << "Could not decompress image into YUV planes.";
+    return std::nullopt;
+  }
+
+  // The conversion samples the chroma planes from a single texture.
+  const SkPixmap& u_plane = pixmaps.plane(1);
+  const SkPixmap& v_plane = pixmaps.plane(2);
+  const SkISize uv_size = u_plane.dimensions();
+  if (v_plane.dimensions() != uv_size) {
+    return std::nullopt;
+  }
+  impeller::DeviceBufferDescriptor uv_descriptor;
+  uv_descriptor.storage_mode = impeller::StorageMode::kHostVisible;
+  uv_descriptor.size = uv_size.area() * 2u;
+  auto uv_buffer = allocator->CreateBuffer(uv_descriptor);
+  if (!uv_buffer) {
+    return std::nullopt;
+  }
+  uint8_t* uv = uv_buffer->OnGetContents();
+  for (int y = 0; y < uv_size.height(); y++) {
+    const uint8_t* u_row = u_plane.addr8(0, y);
+    const uint8_t* v_row = v_plane.addr8(0, y);
+    for (int x = 0; x < uv_size.width(); x++) {
+      *uv++ = u_row[x];
+      *uv++ = v_row[x];
+    }
+  }
+
+  return DecompressYUVResult{.y_buffer = std::move(y_buffer),
+                             .uv_buffer = std::move(uv_buffer),
+                             .y_size = pixmaps.plane(0).dimensions(),
+                             .uv_size = uv_size,
+                             .yuv_color_space = yuv_color_space.value()};
+}
+
+/// Creates the texture of a decoded image and encodes the blits that fill it.
 /// Only call this method if the GPU is available.
-static std::pair<sk_sp<DlImage>, std::string> UnsafeUploadTextureToPrivate(
+static std::pair<sk_sp<DlImage>, std::string> EncodeUploadTextureToPrivate(
     const std::shared_ptr<impeller::Context>& context,
     const std::shared_ptr<impeller::DeviceBuffer>& buffer,
-    const SkImageInfo& image_info) {
+    const SkImageInfo& image_info,
+    size_t mip_level,
+    impeller::BlitPass& blit_pass) {
   const auto pixel_format =
       impeller::skia_conversions::ToPixelFormat(image_info.colorType());
   if (!pixel_format) {
@@ -298,10 +463,11 @@ static std::pair<sk_sp<DlImage>, std::string> UnsafeUploadTextureToPrivate(
     return std::make_pair(nullptr, decode_error);
   }
 
+  const auto size = GetMipLevelSize(image_info.dimensions(), mip_level);
   impeller::TextureDescriptor texture_descriptor;
   texture_descriptor.storage_mode = impeller::StorageMode::kDevicePrivate;
   texture_descriptor.format = pixel_format.value();
-  texture_descriptor.size = {image_info.width(), image_info.height()};
+  texture_descriptor.size = {size.width(), size.height()};
   texture_descriptor.mip_count = texture_descriptor.size.MipCount();
   texture_descriptor.compression_type = impeller::CompressionType::kLossy;
 
@@ -316,6 +482,48 @@ static std::pair<sk_sp<DlImage>, std::string> UnsafeUploadTextureToPrivate(
   dest_texture->SetLabel(
       impeller::SPrintF("ui.Image(%p)", dest_texture.get()).c_str());
 
+  // Images that are downscaled on the GPU are uploaded at their decoded size
+  // and only the mip levels down to the target size are generated.
+  auto upload_texture = dest_texture;
+  if (mip_level > 0u) {
+    auto upload_descriptor = texture_descriptor;
+    upload_descriptor.size = {image_info.width(), image_info.height()};
+    upload_descriptor.mip_count = mip_level + 1u;
+    upload_descriptor.compression_type = impeller::CompressionType::kLossless;
+    upload_texture =
+        context->GetResourceAllocator()->CreateTexture(upload_descriptor);
+    if (!upload_texture) {
+      std::string decode_error("Could not create Impeller texture.");
+      FML_DLOG(ERROR) << decode_error;
+      return std::make_pair(nullptr, decode_error);
+    }
+    upload_texture->SetLabel("Decoded Image Downscale");
+  }
+
+  blit_pass.AddCopy(buffer->AsBufferView(), upload_texture);
+  if (mip_level > 0u) {
+    blit_pass.GenerateMipmap(upload_texture);
+    if (!blit_pass.AddCopyFromMipLevel(upload_texture, mip_level,
+                                       dest_texture)) {
+      std::string decode_error("Could not downscale image.");
+      FML_DLOG(ERROR) << decode_error;
+      return std::make_pair(nullptr, decode_error);
+    }
+  }
+  if (texture_descriptor.size.MipCount() > 1) {
+    blit_pass.GenerateMipmap(dest_texture);
+  }
+
+  return std::make_pair(
+      impeller::DlImageImpeller::Make(std::move(dest_texture)), std::string());
+}
+
+/// Only call this method if the GPU is available.
+static std::pair<sk_sp<DlImage>, std::string> UnsafeUploadTextureToPrivate(
+    const std::shared_ptr<impeller::Context>& context,
+    const std::shared_ptr<impeller::DeviceBuffer>& buffer,
+    const SkImageInfo& image_info,
+    size_t mip_level) {
   auto command_buffer = context->CreateCommandBuffer();
   if (!command_buffer) {
     std::string decode_error(
@@ -333,9 +541,11 @@ static std::pair<sk_sp<DlImage>, std::string> UnsafeUploadTextureToPrivate(
     return std::make_pair(nullptr, decode_error);
   }
   blit_pass->SetLabel("Mipmap Blit Pass");
-  blit_pass->AddCopy(buffer->AsBufferView(), dest_texture);
-  if (texture_descriptor.size.MipCount() > 1) {
-    blit_pass->GenerateMipmap(dest_texture);
+
+  auto result = EncodeUploadTextureToPrivate(context, buffer, image_info,
+                                             mip_level, *blit_pass);
+  if (!result.first) {
+    return result;
   }
 
   blit_pass->EncodeCommands(context->GetResourceAllocator());
@@ -345,8 +555,51 @@ static std::pair<sk_sp<DlImage>, std::string> UnsafeUploadTextureToPrivate(
     return std::make_pair(nullptr, decode_error);
   }
 
-  return std::make_pair(
-      impeller::DlImageImpeller::Make(std::move(dest_texture)), std::string());
+  return result;
+}
+
+void ImageDecoderImpeller::UploadTextureToPrivateBatched(
+    const std::shared_ptr<impeller::Context>& context,
+    const fml::RefPtr<ImageUploadBatcher>& batcher,
+    const DecompressResult& bitmap_result,
+    const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch,
+    const ImageResult& result) {
+  if (!context || !bitmap_result.device_buffer) {
+    result(nullptr, "No Impeller context is available");
+    return;
+  }
+  auto encoded = std::make_shared<std::pair<sk_sp<DlImage>, std::string>>();
+  batcher->Enqueue(
+      context,
+      {.encode =
+           [context, bitmap_result, encoded](impeller::BlitPass& blit_pass) {
+             *encoded = EncodeUploadTextureToPrivate(
+                 context, bitmap_result.device_buffer,
+                 bitmap_result.image_info, bitmap_result.mip_level, blit_pass);
+           },
+       .on_complete =
+           [context, bitmap_result, encoded, gpu_disabled_switch,
+            result](bool submitted) {
+             if (submitted) {
+               result(encoded->first, encoded->second);
+               return;
+             }
+             if (encoded->first) {
+               result(nullptr, "Failed to submit blit pass command buffer.");
+               return;
+             }
+             if (!encoded->second.empty()) {
+               result(nullptr, encoded->second);
+               return;
+             }
+             // The batch was dropped before this upload was encoded, such as
+             // when the GPU was disabled in the meantime.
+             auto [image, decode_error] = UploadTextureToPrivate(
+                 context, bitmap_result.device_buffer,
+                 bitmap_result.image_info, bitmap_result.sk_bitmap,
+                 gpu_disabled_switch, bitmap_result.mip_level);
+             result(image, decode_error);
+           }});
 }
 
 std::pair<sk_sp<DlImage>, std::string>
@@ -355,7 +608,8 @@ ImageDecoderImpeller::UploadTextureToPrivate(
     const std::shared_ptr<impeller::DeviceBuffer>& buffer,
     const SkImageInfo& image_info,
     const std::shared_ptr<SkBitmap>& bitmap,
-    const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch) {
+    const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch,
+    size_t mip_level) {
   TRACE_EVENT0("impeller", __FUNCTION__);
   if (!context) {
     return std::make_pair(nullptr, "No Impeller context is available");
@@ -367,15 +621,32 @@ ImageDecoderImpeller::UploadTextureToPrivate(
   std::pair<sk_sp<DlImage>, std::string> result;
   gpu_disabled_switch->Execute(
       fml::SyncSwitch::Handlers()
-          .SetIfFalse([&result, context, buffer, image_info] {
-            result = UnsafeUploadTextureToPrivate(context, buffer, image_info);
+          .SetIfFalse([&result, context, buffer, image_info, mip_level] {
+            result = UnsafeUploadTextureToPrivate(context, buffer, image_info,
+                                                  mip_level);
           })
-          .SetIfTrue([&result, context, bitmap, gpu_disabled_switch] {
+          .SetIfTrue([&result, context, bitmap, gpu_disabled_switch,
+                      mip_level] {
+            // The GPU can't downscale the image, so resize it here instead.
+            auto image_bitmap = bitmap;
+            if (mip_level > 0u) {
+              image_bitmap = std::make_shared<SkBitmap>();
+              if (!image_bitmap->tryAllocPixels(bitmap->info().makeDimensions(
+                      GetMipLevelSize(bitmap->dimensions(), mip_level))) ||
+                  !bitmap->pixmap().scalePixels(
+                      image_bitmap->pixmap(),
+                      SkSamplingOptions(SkFilterMode::kLinear,
+                                        SkMipmapMode::kNone))) {
+                result = std::make_pair(nullptr, "Could not downscale image.");
+                return;
+              }
+              image_bitmap->setImmutable();
+            }
             // create_mips is false because we already know the GPU is disabled.
-            result =
-                UploadTextureToStorage(context, bitmap, gpu_disabled_switch,
-                                       impeller::StorageMode::kHostVisible,
-                                       /*create_mips=*/false);
+            result = UploadTextureToStorage(
+                context, image_bitmap, gpu_disabled_switch,
+                impeller::StorageMode::kHostVisible,
+                /*create_mips=*/false);
           }));
   return result;
 }
@@ -474,6 +745,381 @@ ImageDecoderImpeller::UploadTextureToStorage(
                         std::string());
 }
 
+/// Only call this method if the GPU is available.
+static std::pair<sk_sp<DlImage>, std::string> UnsafeUploadYUVTexture(
+    impeller::AiksContext& aiks_context,
+    const DecompressYUVResult& yuv_result) {
+  const auto& context = aiks_context.GetContext();
+  const auto& allocator = context->GetResourceAllocator();
+
+  impeller::TextureDescriptor y_descriptor;
+  y_descriptor.storage_mode = impeller::StorageMode::kDevicePrivate;
+  y_descriptor.format = impeller::PixelFormat::kR8UNormInt;
+  y_descriptor.size = {yuv_result.y_size.width(), yuv_result.y_size.height()};
+  impeller::TextureDescriptor uv_descriptor;
+  uv_descriptor.storage_mode = impeller::StorageMode::kDevicePrivate;
+  uv_descriptor.format = impeller::PixelFormat::kR8G8UNormInt;
+  uv_descriptor.size = {yuv_result.uv_size.width(),
+                        yuv_result.uv_size.height()};
+  auto y_texture = allocator->CreateTexture(y_descriptor);
+  auto uv_texture = allocator->CreateTexture(uv_descriptor);
+  if (!y_texture || !uv_texture) {
+    std::string decode_error("Could not create Impeller texture.");
+    FML_DLOG(ERROR) << decode_error;
+    return std::make_pair(nullptr, decode_error);
+  }
+  y_texture->SetLabel("Decoded Image Y");
+  uv_texture->SetLabel("Decoded Image UV");
+
+  // The planes are uploaded, converted and copied into a mipmapped texture in
+  // separate command buffers, which the command queue runs in order.
+  auto upload_command_buffer = context->CreateCommandBuffer();
+  if (!upload_command_buffer) {
+    std::string decode_error("Could not create command buffer for upload.");
+    FML_DLOG(ERROR) << decode_error;
+    return std::make_pair(nullptr, decode_error);
+  }
+  upload_command_buffer->SetLabel("YUV Upload Command Buffer");
+  auto upload_pass = upload_command_buffer->CreateBlitPass();
+  if (!upload_pass) {
+    std::string decode_error("Could not create blit pass for upload.");
+    FML_DLOG(ERROR) << decode_error;
+    return std::make_pair(nullptr, decode_error);
+  }
+  upload_pass->SetLabel("YUV Upload Blit Pass");
+  auto y_view = yuv_result.y_buffer->AsBufferView();
+  y_view.range.length = y_descriptor.GetByteSizeOfBaseMipLevel();
+  if (!upload_pass->AddCopy(std::move(y_view), y_texture) ||
+      !upload_pass->AddCopy(yuv_result.uv_buffer->AsBufferView(),
+                            uv_texture)) {
+    std::string decode_error("Could not upload YUV planes.");
+    FML_DLOG(ERROR) << decode_error;
+    return std::make_pair(nullptr, decode_error);
+  }
+  upload_pass->EncodeCommands(allocator);
+  if (!upload_command_buffer->SubmitCommands()) {
+    std::string decode_error("Failed to submit blit pass command buffer.");
+    FML_DLOG(ERROR) << decode_error;
+    return std::make_pair(nullptr, decode_error);
+  }
+
+  auto rgb_image = impeller::DlImageImpeller::MakeFromYUVTextures(
+      &aiks_context, std::move(y_texture), std::move(uv_texture),
+      yuv_result.yuv_color_space);
+  if (!rgb_image) {
+    std::string decode_error("Could not convert YUV planes to RGB.");
+    FML_DLOG(ERROR) << decode_error;
+    return std::make_pair(nullptr, decode_error);
+  }
+  auto rgb_texture = rgb_image->impeller_texture();
+
+  impeller::TextureDescriptor texture_descriptor;
+  texture_descriptor.storage_mode = impeller::StorageMode::kDevicePrivate;
+  texture_descriptor.format = rgb_texture->GetTextureDescriptor().format;
+  texture_descriptor.size = y_descriptor.size;
+  texture_descriptor.mip_count = texture_descriptor.size.MipCount();
+  texture_descriptor.compression_type = impeller::CompressionType::kLossy;
+  auto dest_texture = allocator->CreateTexture(texture_descriptor);
+  if (!dest_texture) {
+    std::string decode_error("Could not create Impeller texture.");
+    FML_DLOG(ERROR) << decode_error;
+    return std::make_pair(nullptr, decode_error);
+  }
+  dest_texture->SetLabel(
+      impeller::SPrintF("ui.Image(%p)", dest_texture.get()).c_str());
+
+  auto command_buffer = context->CreateCommandBuffer();
+  if (!command_buffer) {
+    std::string decode_error(
+        "Could not create command buffer for mipmap generation.");
+    FML_DLOG(ERROR) << decode_error;
+    return std::make_pair(nullptr, decode_error);
+  }
+  command_buffer->SetLabel("Mipmap Command Buffer");
+  auto blit_pass = command_buffer->CreateBlitPass();
+  if (!blit_pass) {
+    std::string decode_error(
+        "Could not create blit pass for mipmap generation.");
+    FML_DLOG(ERROR) << decode_error;
+    return std::make_pair(nullptr, decode_error);
+  }
+  blit_pass->SetLabel("Mipmap Blit Pass");
+  blit_pass->AddCopy(std::move(rgb_texture), dest_texture);
+  if (texture_descriptor.mip_count > 1u) {
+    blit_pass->GenerateMipmap(dest_texture);
+  }
+  blit_pass->EncodeCommands(allocator);
+  if (!command_buffer->SubmitCommands()) {
+    std::string decode_error("Failed to submit blit pass command buffer.");
+    FML_DLOG(ERROR) << decode_error;
+    return std::make_pair(nullptr, decode_error);
+  }
+
+  // The render target of the conversion is only needed again for another
+  // image of the same size, which isn't worth keeping it around for.
+  aiks_context.ClearCachedResources();
+
+  return std::make_pair(
+      impeller::DlImageImpeller::Make(std::move(dest_texture)), std::string());
+}
+
+std::pair<sk_sp<DlImage>, std::string> ImageDecoderImpeller::UploadYUVTexture(
+    impeller::AiksContext& aiks_context,
+    const DecompressYUVResult& yuv_result,
+    const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  if (!aiks_context.IsValid()) {
+    return std::make_pair(nullptr, "No Impeller context is available");
+  }
+  std::pair<sk_sp<DlImage>, std::string> result =
+      std::make_pair(nullptr, "The GPU is disabled");
+  gpu_disabled_switch->Execute(
+      fml::SyncSwitch::Handlers().SetIfFalse([&result, &aiks_context,
+                                              &yuv_result] {
+        result = UnsafeUploadYUVTexture(aiks_context, yuv_result);
+      }));
+  return result;
+}
+
+static std::optional<impeller::PixelFormat> ToCompressedPixelFormat(
+    uint32_t vk_format) {
+  switch (vk_format) {
+    case KTX2ImageGenerator::kVkFormatETC2R8G8B8UNormBlock:
+      return impeller::PixelFormat::kETC2R8G8B8UNormInt;
+    case KTX2ImageGenerator::kVkFormatETC2R8G8B8A8UNormBlock:
+      return impeller::PixelFormat::kETC2R8G8B8A8UNormInt;
+    case KTX2ImageGenerator::kVkFormatASTC4x4UNormBlock:
+      return impeller::PixelFormat::kASTC4x4UNormInt;
+    case KTX2ImageGenerator::kVkFormatBC1RGBAUNormBlock:
+      return impeller::PixelFormat::kBC1R8G8B8A8UNormInt;
+    case KTX2ImageGenerator::kVkFormatBC3UNormBlock:
+      return impeller::PixelFormat::kBC3R8G8B8A8UNormInt;
+    case KTX2ImageGenerator::kVkFormatBC7UNormBlock:
+      return impeller::PixelFormat::kBC7R8G8B8A8UNormInt;
+    default:
+      return std::nullopt;
+  }
+}
+
+std::pair<sk_sp<DlImage>, std::string>
+ImageDecoderImpeller::UploadCompressedTexture(
+    const std::shared_ptr<impeller::Context>& context,
+    const ImageGenerator::CompressedImage& image,
+    const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  if (!context) {
+    return std::make_pair(nullptr, "No Impeller context is available");
+  }
+  const auto pixel_format = ToCompressedPixelFormat(image.vk_format);
+  if (!pixel_format.has_value() ||
+      !context->GetCapabilities()->SupportsCompressedPixelFormat(
+          pixel_format.value())) {
+    std::string decode_error(impeller::SPrintF(
+        "Unsupported compressed texture format (VkFormat=%u)",
+        image.vk_format));
+    FML_DLOG(ERROR) << decode_error;
+    return std::make_pair(nullptr, decode_error);
+  }
+
+  impeller::TextureDescriptor texture_descriptor;
+  texture_descriptor.format = pixel_format.value();
+  texture_descriptor.size = {image.dimensions.width(),
+                             image.dimensions.height()};
+  texture_descriptor.mip_count = 1u;
+  if (!image.data ||
+      image.data->size() != texture_descriptor.GetByteSizeOfBaseMipLevel()) {
+    return std::make_pair(nullptr, "Invalid compressed texture data.");
+  }
+
+  const bool upload_with_blits =
+      !kShouldUseMallocDeviceBuffer &&
+      context->GetCapabilities()->SupportsBufferToTextureBlits();
+
+  std::shared_ptr<impeller::Texture> texture;
+  std::string decode_error;
+  gpu_disabled_switch->Execute(
+      fml::SyncSwitch::Handlers()
+          .SetIfFalse([&] {
+            if (!upload_with_blits) {
+              return;
+            }
+            texture_descriptor.storage_mode =
+                impeller::StorageMode::kDevicePrivate;
+            texture = context->GetResourceAllocator()->CreateTexture(
+                texture_descriptor);
+            auto buffer = context->GetResourceAllocator()->CreateBufferWithCopy(
+                image.data->bytes(), image.data->size());
+            if (!texture || !buffer) {
+              decode_error = "Could not create Impeller texture.";
+              return;
+            }
+            auto command_buffer = context->CreateCommandBuffer();
+            if (!command_buffer) {
+              decode_error = "Could not create command buffer for upload.";
+              return;
+            }
+            command_buffer->SetLabel("Compressed Upload Command Buffer");
+            auto blit_pass = command_buffer->CreateBlitPass();
+            if (!blit_pass) {
+              decode_error = "Could not create blit pass for upload.";
+              return;
+            }
+            blit_pass->SetLabel("Compressed Upload Blit Pass");
+            blit_pass->AddCopy(buffer->AsBufferView(), texture);
+            blit_pass->EncodeCommands(context->GetResourceAllocator());
+            if (!command_buffer->SubmitCommands()) {
+              decode_error = "Failed to submit blit pass command buffer.";
+              return;
+            }
+          }));
+
+  if (!texture && decode_error.empty()) {
+    // Without blits, or while the GPU is disabled, copy the blocks into a
+    // texture the host can write to directly.
+    texture_descriptor.storage_mode =
+        upload_with_blits ? impeller::StorageMode::kHostVisible
+                          : impeller::StorageMode::kDevicePrivate;
+    texture =
+        context->GetResourceAllocator()->CreateTexture(texture_descriptor);
+    if (!texture) {
+      decode_error = "Could not create Impeller texture.";
+    } else {
+      auto data = image.data;
+      auto mapping = std::make_shared<fml::NonOwnedMapping>(
+          data->bytes(), data->size(),
+          [data](auto, auto) mutable { data.reset(); });
+      if (!texture->SetContents(mapping)) {
+        decode_error = "Could not copy contents into Impeller texture.";
+      }
+    }
+  }
+
+  if (!decode_error.empty()) {
+    FML_DLOG(ERROR) << decode_error;
+    return std::make_pair(nullptr, decode_error);
+  }
+
+  texture->SetLabel(impeller::SPrintF("ui.Image(%p)", texture.get()).c_str());
+  return std::make_pair(impeller::DlImageImpeller::Make(std::move(texture)),
+                        std::string());
+}
+
+SkISize ImageDecoderImpeller::GetTiledImageSize(SkISize target_size) {
+  const int64_t pixels =
+      static_cast<int64_t>(target_size.width()) * target_size.height();
+  if (pixels <= kMaxTiledImagePixels) {
+    return target_size;
+  }
+  const double scale = std::sqrt(static_cast<double>(kMaxTiledImagePixels) /
+                                 static_cast<double>(pixels));
+  return SkISize::Make(
+      std::max(1, static_cast<int>(target_size.width() * scale)),
+      std::max(1, static_cast<int>(target_size.height() * scale)));
+}
+
+std::vector<DlImage::ImpellerTile> ImageDecoderImpeller::ComputeImageTiles(
+    SkISize size,
+    impeller::ISize max_texture_size) {
+  // Each texture holds a pixel of the neighboring tiles on each side.
+  const int step_x = std::max(static_cast<int>(max_texture_size.width) - 2, 1);
+  const int step_y =
+      std::max(static_cast<int>(max_texture_size.height) - 2, 1);
+  const SkIRect image_bounds = SkIRect::MakeSize(size);
+  std::vector<DlImage::ImpellerTile> tiles;
+  for (int y = 0; y < size.height(); y += step_y) {
+    for (int x = 0; x < size.width(); x += step_x) {
+      SkIRect bounds =
+          SkIRect::MakeLTRB(x, y, std::min(x + step_x, size.width()),
+                            std::min(y + step_y, size.height()));
+      SkIRect texture_bounds = bounds.makeOutset(1, 1);
+      if (!texture_bounds.intersect(image_bounds)) {
+        continue;
+      }
+      tiles.push_back({
+          .texture = nullptr,
+          .texture_bounds = texture_bounds,
+          .bounds = bounds,
+      });
+    }
+  }
+  return tiles;
+}
+
+std::pair<sk_sp<DlImage>, std::string> ImageDecoderImpeller::UploadTiledTexture(
+    const std::shared_ptr<impeller::Context>& context,
+    const std::shared_ptr<SkBitmap>& bitmap,
+    const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  if (!context) {
+    return std::make_pair(nullptr, "No Impeller context is available");
+  }
+  if (!bitmap) {
+    return std::make_pair(nullptr, "No texture bitmap is available");
+  }
+  const auto max_texture_size =
+      context->GetResourceAllocator()->GetMaxTextureSizeSupported();
+  const auto size = bitmap->dimensions();
+
+  auto tiles = ComputeImageTiles(size, max_texture_size);
+  for (auto& tile : tiles) {
+    auto tile_bitmap = std::make_shared<SkBitmap>();
+    if (!tile_bitmap->tryAllocPixels(
+            bitmap->info().makeDimensions(tile.texture_bounds.size())) ||
+        !bitmap->readPixels(tile_bitmap->pixmap(), tile.texture_bounds.x(),
+                            tile.texture_bounds.y())) {
+      std::string decode_error("Could not copy the pixels of an image tile.");
+      FML_DLOG(ERROR) << decode_error;
+      return std::make_pair(nullptr, decode_error);
+    }
+    tile_bitmap->setImmutable();
+    auto [tile_image, decode_error] = UploadTextureToStorage(
+        context, std::move(tile_bitmap), gpu_disabled_switch,
+        impeller::StorageMode::kHostVisible, /*create_mips=*/true);
+    if (!tile_image) {
+      return std::make_pair(nullptr, decode_error);
+    }
+    tile.texture = tile_image->impeller_texture();
+  }
+
+  // Draws that can't be split into tiles use the image downscaled to fit into
+  // a texture.
+  const double scale =
+      std::min({1.0,
+                static_cast<double>(max_texture_size.width) / size.width(),
+                static_cast<double>(max_texture_size.height) / size.height()});
+  const auto overview_size =
+      SkISize::Make(std::max(1, static_cast<int>(size.width() * scale)),
+                    std::max(1, static_cast<int>(size.height() * scale)));
+  auto overview_bitmap = std::make_shared<SkBitmap>();
+  if (!overview_bitmap->tryAllocPixels(
+          bitmap->info().makeDimensions(overview_size))) {
+    std::string decode_error("Could not allocate the image overview.");
+    FML_DLOG(ERROR) << decode_error;
+    return std::make_pair(nullptr, decode_error);
+  }
+  {
+    TRACE_EVENT0("impeller", "DecodeScale");
+    if (!bitmap->pixmap().scalePixels(
+            overview_bitmap->pixmap(),
+            SkSamplingOptions(SkFilterMode::kLinear, SkMipmapMode::kNone))) {
+      FML_LOG(ERROR) << "Could not scale decoded bitmap data.";
+    }
+  }
+  overview_bitmap->setImmutable();
+  auto [overview, decode_error] = UploadTextureToStorage(
+      context, std::move(overview_bitmap), gpu_disabled_switch,
+      impeller::StorageMode::kHostVisible, /*create_mips=*/true);
+  if (!overview) {
+    return std::make_pair(nullptr, decode_error);
+  }
+
+  return std::make_pair(
+      impeller::DlImageImpeller::MakeTiled(
+          overview->impeller_texture(), std::move(tiles),
+          impeller::ISize(size.width(), size.height())),
+      std::string());
+}
+
 // |ImageDecoder|
 void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
                                   uint32_t target_width,
@@ -502,46 +1148,137 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
        io_runner = runners_.GetIOTaskRunner(),                    //
        result,
        supports_wide_gamut = supports_wide_gamut_,  //
-       gpu_disabled_switch = gpu_disabled_switch_]() {
+       gpu_disabled_switch = gpu_disabled_switch_,  //
+       enable_gpu_downscaling = enable_gpu_downscaling_,
+       upload_batcher = upload_batcher_,
+       yuv_conversion_context = yuv_conversion_context_,
+       concurrent_task_runner = concurrent_task_runner_]() {
         if (!context) {
           result(nullptr, "No Impeller context is available");
           return;
         }
+        // Block compressed images are uploaded as-is at their full size.
+        if (auto compressed = raw_descriptor->get_compressed_image();
+            compressed.has_value()) {
+          io_runner->PostTask([result, context, gpu_disabled_switch,
+                               compressed = std::move(compressed.value())]() {
+            auto [image, decode_error] = UploadCompressedTexture(
+                context, compressed, gpu_disabled_switch);
+            result(image, decode_error);
+          });
+          return;
+        }
+
         auto max_size_supported =
             context->GetResourceAllocator()->GetMaxTextureSizeSupported();
 
-        // Always decompress on the concurrent runner.
-        auto bitmap_result = DecompressTexture(
-            raw_descriptor, target_size, max_size_supported,
-            supports_wide_gamut, context->GetResourceAllocator());
-        if (!bitmap_result.device_buffer) {
-          result(nullptr, bitmap_result.decode_error);
-          return;
+        // Images that are larger than a texture keep their detail by being
+        // drawn in tiles. If the image can't be decoded at the tiled size,
+        // it is downscaled to fit into a texture instead.
+        if (!target_size.isEmpty() &&
+            (target_size.width() > max_size_supported.width ||
+             target_size.height() > max_size_supported.height)) {
+          const auto tiled_size = GetTiledImageSize(target_size);
+          auto tiled_result = DecompressTexture(
+              raw_descriptor, tiled_size,
+              impeller::ISize(tiled_size.width(), tiled_size.height()),
+              supports_wide_gamut, context->GetResourceAllocator());
+          if (tiled_result.sk_bitmap) {
+            io_runner->PostTask([result, context, gpu_disabled_switch,
+                                 bitmap = tiled_result.sk_bitmap]() {
+              auto [image, decode_error] =
+                  UploadTiledTexture(context, bitmap, gpu_disabled_switch);
+              result(image, decode_error);
+            });
+            return;
+          }
+          FML_LOG(ERROR) << "Could not decode a tiled image: "
+                         << tiled_result.decode_error;
         }
-        auto upload_texture_and_invoke_result = [result, context, bitmap_result,
-                                                 gpu_disabled_switch]() {
-          sk_sp<DlImage> image;
-          std::string decode_error;
-          if (!kShouldUseMallocDeviceBuffer &&
-              context->GetCapabilities()->SupportsBufferToTextureBlits()) {
-            std::tie(image, decode_error) = UploadTextureToPrivate(
-                context, bitmap_result.device_buffer, bitmap_result.image_info,
-                bitmap_result.sk_bitmap, gpu_disabled_switch);
-            result(image, decode_error);
-          } else {
-            std::tie(image, decode_error) = UploadTextureToStorage(
-                context, bitmap_result.sk_bitmap, gpu_disabled_switch,
-                impeller::StorageMode::kDevicePrivate,
-                /*create_mips=*/true);
-            result(image, decode_error);
+
+        // Images can only be downscaled on the GPU when they are uploaded
+        // with blits.
+        const auto& capabilities = context->GetCapabilities();
+        const bool upload_with_blits =
+            !kShouldUseMallocDeviceBuffer &&
+            capabilities->SupportsBufferToTextureBlits();
+        const bool allow_gpu_downscaling =
+            enable_gpu_downscaling && upload_with_blits &&
+            capabilities->SupportsTextureToTextureBlits();
+
+        auto decode_rgba = [raw_descriptor, context, target_size, io_runner,
+                            result, supports_wide_gamut, gpu_disabled_switch,
+                            upload_batcher, max_size_supported,
+                            upload_with_blits, allow_gpu_downscaling]() {
+          // Always decompress on the concurrent runner.
+          auto bitmap_result = DecompressTexture(
+              raw_descriptor, target_size, max_size_supported,
+              supports_wide_gamut, context->GetResourceAllocator(),
+              allow_gpu_downscaling);
+          if (!bitmap_result.device_buffer) {
+            result(nullptr, bitmap_result.decode_error);
+            return;
           }
+          auto upload_texture_and_invoke_result =
+              [result, context, bitmap_result, gpu_disabled_switch,
+               upload_with_blits, upload_batcher]() {
+                sk_sp<DlImage> image;
+                std::string decode_error;
+                if (upload_with_blits) {
+                  // Uploads that arrive together are submitted together.
+                  UploadTextureToPrivateBatched(context, upload_batcher,
+                                                bitmap_result,
+                                                gpu_disabled_switch, result);
+                } else {
+                  std::tie(image, decode_error) = UploadTextureToStorage(
+                      context, bitmap_result.sk_bitmap, gpu_disabled_switch,
+                      impeller::StorageMode::kDevicePrivate,
+                      /*create_mips=*/true);
+                  result(image, decode_error);
+                }
+              };
+          // TODO(jonahwilliams):
+          // https://github.com/flutter/flutter/issues/123058 Technically we
+          // don't need to post tasks to the io runner, but without this
+          // forced serialization we can end up overloading the GPU and/or
+          // competing with raster workloads.
+          io_runner->PostTask(upload_texture_and_invoke_result);
         };
-        // TODO(jonahwilliams):
-        // https://github.com/flutter/flutter/issues/123058 Technically we
-        // don't need to post tasks to the io runner, but without this
-        // forced serialization we can end up overloading the GPU and/or
-        // competing with raster workloads.
-        io_runner->PostTask(upload_texture_and_invoke_result);
+
+        // Opaque YUV images, such as most JPEGs, are decoded into planes and
+        // converted to RGB while they are uploaded.
+        if (upload_with_blits &&
+            capabilities->SupportsTextureToTextureBlits()) {
+          auto yuv_result = DecompressYUVTexture(
+              raw_descriptor, target_size, max_size_supported,
+              supports_wide_gamut, context->GetResourceAllocator());
+          if (yuv_result.has_value()) {
+            io_runner->PostTask([result, context, gpu_disabled_switch,
+                                 yuv_conversion_context, concurrent_task_runner,
+                                 decode_rgba,
+                                 yuv_result = std::move(yuv_result.value())]() {
+              auto& aiks_context = yuv_conversion_context->aiks_context;
+              if (!aiks_context) {
+                aiks_context = std::make_unique<impeller::AiksContext>(
+                    context, impeller::TypographerContextSkia::Make());
+              }
+              auto [image, decode_error] = UploadYUVTexture(
+                  *aiks_context, yuv_result, gpu_disabled_switch);
+              if (image) {
+                result(image, decode_error);
+                return;
+              }
+              // Decode the image again, into RGBA pixels that are uploaded
+              // without rendering.
+              FML_LOG(ERROR) << "Could not upload a YUV image: "
+                             << decode_error;
+              concurrent_task_runner->PostTask(decode_rgba);
+            });
+            return;
+          }
+        }
+
+        decode_rgba();
       });
 }
 
@@ -6,14 +6,19 @@
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_DECODER_IMPELLER_H_
 
 #include <future>
+#include <optional>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "flutter/lib/ui/painting/image_decoder.h"
+#include "flutter/lib/ui/painting/image_upload_batcher.h"
 #include "impeller/core/formats.h"
+#include "impeller/geometry/color.h"
 #include "impeller/geometry/size.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 
 namespace impeller {
+class AiksContext;
 class Context;
 class Allocator;
 class DeviceBuffer;
@@ -42,6 +47,20 @@ struct DecompressResult {
   std::shared_ptr<SkBitmap> sk_bitmap;
   SkImageInfo image_info;
   std::string decode_error;
+  // When non-zero, the image was decoded at a power of two multiple of the
+  // target size and this mip level of it is the target size. The image is
+  // downscaled to the target size on the GPU when it is uploaded.
+  size_t mip_level = 0u;
+};
+
+struct DecompressYUVResult {
+  // The luma plane, tightly packed at its start.
+  std::shared_ptr<impeller::DeviceBuffer> y_buffer;
+  // The chroma planes, interleaved into two channels.
+  std::shared_ptr<impeller::DeviceBuffer> uv_buffer;
+  SkISize y_size;
+  SkISize uv_size;
+  impeller::YUVColorSpace yuv_color_space;
 };
 
 class ImageDecoderImpeller final : public ImageDecoder {
@@ -51,7 +70,8 @@ class ImageDecoderImpeller final : public ImageDecoder {
       std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
       const fml::WeakPtr<IOManager>& io_manager,
       bool supports_wide_gamut,
-      const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch);
+      const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch,
+      bool enable_gpu_downscaling = false);
 
   ~ImageDecoderImpeller() override;
 
@@ -62,12 +82,37 @@ class ImageDecoderImpeller final : public ImageDecoder {
               const ImageResult& result) override;
 
   static DecompressResult DecompressTexture(
+      ImageDescriptor* descriptor,
+      SkISize target_size,
+      impeller::ISize max_texture_size,
+      bool supports_wide_gamut,
+      const std::shared_ptr<impeller::Allocator>& allocator,
+      bool allow_gpu_downscaling = false);
+
+  /// @brief Decode an image into its luma and chroma planes instead of RGBA
+  ///        pixels, which takes less time and less than half of the memory.
+  ///        Only opaque images that are stored as 8-bit YUV, such as most
+  ///        JPEGs, can be decoded this way, and only at their full size.
+  /// @return The planes, or std::nullopt if the image can't be decoded into
+  ///         planes at the target size.
+  static std::optional<DecompressYUVResult> DecompressYUVTexture(
       ImageDescriptor* descriptor,
       SkISize target_size,
       impeller::ISize max_texture_size,
       bool supports_wide_gamut,
       const std::shared_ptr<impeller::Allocator>& allocator);
 
+  /// @brief Create a device private texture from the planes of a YUV image,
+  ///        converting them to RGB on the GPU.
+  /// @param aiks_context The context to render the conversion with.
+  /// @param yuv_result   The decoded planes of the image.
+  /// @param gpu_disabled_switch Whether the GPU is available command encoding.
+  /// @return             A DlImage.
+  static std::pair<sk_sp<DlImage>, std::string> UploadYUVTexture(
+      impeller::AiksContext& aiks_context,
+      const DecompressYUVResult& yuv_result,
+      const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch);
+
   /// @brief Create a device private texture from the provided host buffer.
   ///        This method is only suported on the metal backend.
   /// @param context    The Impeller graphics context.
@@ -75,12 +120,42 @@ class ImageDecoderImpeller final : public ImageDecoder {
   /// @param image_info Format information about the particular image.
   /// @param bitmap      A bitmap containg the image to be uploaded.
   /// @param gpu_disabled_switch Whether the GPU is available command encoding.
+  /// @param mip_level  The mip level of the image to use as the image, see
+  ///                   `DecompressResult::mip_level`.
   /// @return           A DlImage.
   static std::pair<sk_sp<DlImage>, std::string> UploadTextureToPrivate(
       const std::shared_ptr<impeller::Context>& context,
       const std::shared_ptr<impeller::DeviceBuffer>& buffer,
       const SkImageInfo& image_info,
       const std::shared_ptr<SkBitmap>& bitmap,
+      const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch,
+      size_t mip_level = 0u);
+
+  /// @brief Like `UploadTextureToPrivate`, but encodes the upload into the
+  ///        next batch of the batcher instead of submitting it on its own.
+  ///        Must be called on the task runner of the batcher.
+  /// @param context    The Impeller graphics context.
+  /// @param batcher    The batcher to add the upload to.
+  /// @param bitmap_result The decoded image to be uploaded.
+  /// @param gpu_disabled_switch Whether the GPU is available command encoding.
+  /// @param result     Called with the image once the batch was submitted.
+  static void UploadTextureToPrivateBatched(
+      const std::shared_ptr<impeller::Context>& context,
+      const fml::RefPtr<ImageUploadBatcher>& batcher,
+      const DecompressResult& bitmap_result,
+      const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch,
+      const ImageResult& result);
+
+  /// @brief Create a device private texture from a block compressed image,
+  ///        without decoding it. Only the base mip level is uploaded.
+  /// @param context    The Impeller graphics context.
+  /// @param image      The compressed image to be uploaded.
+  /// @param gpu_disabled_switch Whether the GPU is available command encoding.
+  /// @return           A DlImage, or an error if the backend doesn't support
+  ///                   the compressed format.
+  static std::pair<sk_sp<DlImage>, std::string> UploadCompressedTexture(
+      const std::shared_ptr<impeller::Context>& context,
+      const ImageGenerator::CompressedImage& image,
       const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch);
 
   /// @brief Create a host visible texture from the provided bitmap.
@@ -98,11 +173,48 @@ class ImageDecoderImpeller final : public ImageDecoder {
       impeller::StorageMode storage_mode,
       bool create_mips = true);
 
+  /// Images that are larger than the max texture size are decoded with at
+  /// most this many pixels, about 128MB in RGBA, and drawn in tiles.
+  static constexpr int64_t kMaxTiledImagePixels = 32 * 1024 * 1024;
+
+  /// @brief The size to decode an image that is larger than the max texture
+  ///        size at. This is the target size, evenly downscaled to at most
+  ///        `kMaxTiledImagePixels` pixels.
+  static SkISize GetTiledImageSize(SkISize target_size);
+
+  /// @brief Split an image into tiles that fit into textures of the max
+  ///        texture size. The textures of the tiles overlap by a pixel.
+  /// @return The tiles, without textures.
+  static std::vector<DlImage::ImpellerTile> ComputeImageTiles(
+      SkISize size,
+      impeller::ISize max_texture_size);
+
+  /// @brief Create a tiled image from a bitmap that is larger than the max
+  ///        texture size, see `DlImage::impeller_tiles`.
+  /// @param context     The Impeller graphics context.
+  /// @param bitmap      A bitmap containg the image to be uploaded.
+  /// @param gpu_disabled_switch Whether the GPU is available for mipmap
+  /// creation.
+  /// @return            A DlImage.
+  static std::pair<sk_sp<DlImage>, std::string> UploadTiledTexture(
+      const std::shared_ptr<impeller::Context>& context,
+      const std::shared_ptr<SkBitmap>& bitmap,
+      const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch);
+
  private:
   using FutureContext = std::shared_future<std::shared_ptr<impeller::Context>>;
   FutureContext context_;
   const bool supports_wide_gamut_;
   std::shared_ptr<fml::SyncSwitch> gpu_disabled_switch_;
+  const bool enable_gpu_downscaling_;
+  fml::RefPtr<ImageUploadBatcher> upload_batcher_;
+  // The context that the planes of YUV images are converted to RGB with. It
+  // is created once the first such image is uploaded, and only used on the IO
+  // task runner.
+  struct YUVConversionContext {
+    std::unique_ptr<impeller::AiksContext> aiks_context;
+  };
+  std::shared_ptr<YUVConversionContext> yuv_conversion_context_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ImageDecoderImpeller);
 };
@@ -13,6 +13,7 @@
 #include "flutter/lib/ui/painting/image_decoder_impeller.h"
 #include "flutter/lib/ui/painting/image_decoder_no_gl_unittests.h"
 #include "flutter/lib/ui/painting/image_decoder_skia.h"
+#include "flutter/lib/ui/painting/image_upload_batcher.h"
 #include "flutter/lib/ui/painting/multi_frame_codec.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/runtime/dart_vm_lifecycle.h"
@@ -342,6 +343,56 @@ TEST_F(ImageDecoderFixtureTest, ImpellerUploadToSharedNoGpu) {
   ASSERT_EQ(result.second, "");
 }
 
+TEST_F(ImageDecoderFixtureTest, ImpellerUploadsAreBatched) {
+#if !IMPELLER_SUPPORTS_RENDERING
+  GTEST_SKIP() << "Impeller only test.";
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
+  auto context = std::make_shared<impeller::TestImpellerContext>();
+  auto gpu_disabled_switch = std::make_shared<fml::SyncSwitch>();
+  auto io_task_runner = CreateNewThread("io");
+
+  PostTaskSync(io_task_runner, [&]() {
+    auto batcher = fml::MakeRefCounted<ImageUploadBatcher>(io_task_runner,
+                                                           gpu_disabled_switch);
+    size_t completed = 0u;
+    for (size_t i = 0; i < 3; i++) {
+      batcher->Enqueue(context, {.encode = [](impeller::BlitPass&) {},
+                                 .on_complete =
+                                     [&completed](bool submitted) {
+                                       // The test context can't create
+                                       // command buffers.
+                                       EXPECT_FALSE(submitted);
+                                       completed++;
+                                     }});
+    }
+    ASSERT_EQ(batcher->GetPendingUploadCount(), 3u);
+    ASSERT_EQ(context->command_buffer_count_, 0u);
+
+    batcher->Flush();
+    ASSERT_EQ(batcher->GetPendingUploadCount(), 0u);
+    ASSERT_EQ(completed, 3u);
+    // All uploads of the batch share one command buffer.
+    ASSERT_EQ(context->command_buffer_count_, 1u);
+
+    // Nothing is encoded while the GPU is disabled.
+    gpu_disabled_switch->SetSwitch(true);
+    bool encoded = false;
+    batcher->Enqueue(context,
+                     {.encode = [&encoded](impeller::BlitPass&) {
+                        encoded = true;
+                      },
+                      .on_complete = [&completed](bool submitted) {
+                        EXPECT_FALSE(submitted);
+                        completed++;
+                      }});
+    batcher->Flush();
+    ASSERT_FALSE(encoded);
+    ASSERT_EQ(completed, 4u);
+    ASSERT_EQ(context->command_buffer_count_, 1u);
+  });
+}
+
 TEST_F(ImageDecoderFixtureTest, ImpellerNullColorspace) {
   auto info = SkImageInfo::Make(10, 10, SkColorType::kRGBA_8888_SkColorType,
                                 SkAlphaType::kPremul_SkAlphaType);
@@ -397,6 +448,113 @@ TEST_F(ImageDecoderFixtureTest, ImpellerPixelConversion32F) {
 #endif  // IMPELLER_SUPPORTS_RENDERING
 }
 
+TEST_F(ImageDecoderFixtureTest, ImpellerResizesPixelsWhileConverting) {
+  auto info = SkImageInfo::Make(10, 10, SkColorType::kRGBA_F32_SkColorType,
+                                SkAlphaType::kUnpremul_SkAlphaType);
+  SkBitmap bitmap;
+  bitmap.allocPixels(info, 10 * 16);
+  bitmap.eraseColor(SK_ColorRED);
+  auto data = SkData::MakeWithoutCopy(bitmap.getPixels(), 10 * 10 * 16);
+  auto image = SkImages::RasterFromBitmap(bitmap);
+  ASSERT_TRUE(image != nullptr);
+
+  auto descriptor = fml::MakeRefCounted<ImageDescriptor>(
+      std::move(data), image->imageInfo(), 10 * 16);
+
+#if IMPELLER_SUPPORTS_RENDERING
+  std::shared_ptr<impeller::Allocator> allocator =
+      std::make_shared<impeller::TestImpellerAllocator>();
+  auto decompressed = ImageDecoderImpeller::DecompressTexture(
+      descriptor.get(), SkISize::Make(5, 5), {100, 100},
+      /*supports_wide_gamut=*/false, allocator);
+
+  ASSERT_TRUE(decompressed.device_buffer);
+  ASSERT_EQ(decompressed.image_info.dimensions(), SkISize::Make(5, 5));
+  ASSERT_EQ(decompressed.image_info.colorType(), kRGBA_F16_SkColorType);
+  ASSERT_EQ(decompressed.device_buffer->GetDeviceBufferDescriptor().size,
+            5u * 5u * 8u);
+  ASSERT_EQ(decompressed.sk_bitmap->getColor(2, 2), SK_ColorRED);
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
+TEST(ImageDecoderTest, ImpellerSplitsLargeImagesIntoOverlappingTiles) {
+#if IMPELLER_SUPPORTS_RENDERING
+  auto tiles = ImageDecoderImpeller::ComputeImageTiles(SkISize::Make(250, 100),
+                                                       {102, 102});
+  // Each tile is drawn for up to 100x100 pixels.
+  ASSERT_EQ(tiles.size(), 3u);
+  EXPECT_EQ(tiles[0].bounds, SkIRect::MakeLTRB(0, 0, 100, 100));
+  EXPECT_EQ(tiles[0].texture_bounds, SkIRect::MakeLTRB(0, 0, 101, 100));
+  EXPECT_EQ(tiles[1].bounds, SkIRect::MakeLTRB(100, 0, 200, 100));
+  EXPECT_EQ(tiles[1].texture_bounds, SkIRect::MakeLTRB(99, 0, 201, 100));
+  EXPECT_EQ(tiles[2].bounds, SkIRect::MakeLTRB(200, 0, 250, 100));
+  EXPECT_EQ(tiles[2].texture_bounds, SkIRect::MakeLTRB(199, 0, 250, 100));
+  for (const auto& tile : tiles) {
+    EXPECT_LE(tile.texture_bounds.width(), 102);
+    EXPECT_LE(tile.texture_bounds.height(), 102);
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
+TEST(ImageDecoderTest, ImpellerLimitsThePixelsOfTiledImages) {
+#if IMPELLER_SUPPORTS_RENDERING
+  EXPECT_EQ(ImageDecoderImpeller::GetTiledImageSize(SkISize::Make(8000, 4000)),
+            SkISize::Make(8000, 4000));
+  auto size = ImageDecoderImpeller::GetTiledImageSize(
+      SkISize::Make(20000, 20000));
+  EXPECT_EQ(size.width(), size.height());
+  EXPECT_LE(static_cast<int64_t>(size.width()) * size.height(),
+            ImageDecoderImpeller::kMaxTiledImagePixels);
+  EXPECT_GT(size.width(), 5000);
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
+TEST_F(ImageDecoderFixtureTest, ImpellerLeavesPowerOfTwoResizesToTheGPU) {
+  auto info = SkImageInfo::Make(10, 10, SkColorType::kRGBA_8888_SkColorType,
+                                SkAlphaType::kPremul_SkAlphaType);
+  SkBitmap bitmap;
+  bitmap.allocPixels(info, 10 * 4);
+  bitmap.eraseColor(SK_ColorRED);
+  auto data = SkData::MakeWithoutCopy(bitmap.getPixels(), 10 * 10 * 4);
+  auto image = SkImages::RasterFromBitmap(bitmap);
+  ASSERT_TRUE(image != nullptr);
+
+  auto descriptor = fml::MakeRefCounted<ImageDescriptor>(
+      std::move(data), image->imageInfo(), 10 * 4);
+
+#if IMPELLER_SUPPORTS_RENDERING
+  std::shared_ptr<impeller::Allocator> allocator =
+      std::make_shared<impeller::TestImpellerAllocator>();
+
+  // 10x10 is two mip levels above 2x2.
+  auto downscaled = ImageDecoderImpeller::DecompressTexture(
+      descriptor.get(), SkISize::Make(2, 2), {100, 100},
+      /*supports_wide_gamut=*/false, allocator,
+      /*allow_gpu_downscaling=*/true);
+  ASSERT_TRUE(downscaled.device_buffer);
+  ASSERT_EQ(downscaled.mip_level, 2u);
+  ASSERT_EQ(downscaled.image_info.dimensions(), SkISize::Make(10, 10));
+
+  // 3x3 isn't a mip level of 10x10, so it's resized on the CPU.
+  auto resized = ImageDecoderImpeller::DecompressTexture(
+      descriptor.get(), SkISize::Make(3, 3), {100, 100},
+      /*supports_wide_gamut=*/false, allocator,
+      /*allow_gpu_downscaling=*/true);
+  ASSERT_TRUE(resized.device_buffer);
+  ASSERT_EQ(resized.mip_level, 0u);
+  ASSERT_EQ(resized.image_info.dimensions(), SkISize::Make(3, 3));
+
+  // Images larger than the largest texture can't be uploaded to be resized.
+  auto too_large = ImageDecoderImpeller::DecompressTexture(
+      descriptor.get(), SkISize::Make(5, 5), {8, 8},
+      /*supports_wide_gamut=*/false, allocator,
+      /*allow_gpu_downscaling=*/true);
+  ASSERT_TRUE(too_large.device_buffer);
+  ASSERT_EQ(too_large.mip_level, 0u);
+  ASSERT_EQ(too_large.image_info.dimensions(), SkISize::Make(5, 5));
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
 TEST_F(ImageDecoderFixtureTest, ImpellerWideGamutDisplayP3Opaque) {
   auto data = OpenFixtureAsSkData("DisplayP3Logo.jpg");
   auto image = SkImages::DeferredFromEncodedData(data);
@@ -476,6 +634,57 @@ TEST_F(ImageDecoderFixtureTest, ImpellerNonWideGamut) {
 #endif  // IMPELLER_SUPPORTS_RENDERING
 }
 
+TEST_F(ImageDecoderFixtureTest, ImpellerDecodesJPEGsIntoYUVPlanes) {
+  auto data = OpenFixtureAsSkData("DashInNooglerHat.jpg");
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+
+  auto descriptor = fml::MakeRefCounted<ImageDescriptor>(std::move(data),
+                                                         std::move(generator));
+
+#if IMPELLER_SUPPORTS_RENDERING
+  std::shared_ptr<impeller::Allocator> allocator =
+      std::make_shared<impeller::TestImpellerAllocator>();
+  auto result = ImageDecoderImpeller::DecompressYUVTexture(
+      descriptor.get(), SkISize::Make(3024, 4032), {4096, 4096},
+      /*supports_wide_gamut=*/false, allocator);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(result->y_size, SkISize::Make(3024, 4032));
+  EXPECT_EQ(result->uv_size, SkISize::Make(1512, 2016));
+  EXPECT_EQ(result->uv_buffer->GetDeviceBufferDescriptor().size,
+            1512u * 2016u * 2u);
+  EXPECT_EQ(result->yuv_color_space, impeller::YUVColorSpace::kBT601FullRange);
+
+  // Planes are only decoded at the full size of the image.
+  EXPECT_FALSE(ImageDecoderImpeller::DecompressYUVTexture(
+                   descriptor.get(), SkISize::Make(1512, 2016), {4096, 4096},
+                   /*supports_wide_gamut=*/false, allocator)
+                   .has_value());
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
+TEST_F(ImageDecoderFixtureTest, ImpellerDoesNotDecodeRotatedJPEGsIntoPlanes) {
+  auto data = OpenFixtureAsSkData("Horizontal.jpg");
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+
+  auto descriptor = fml::MakeRefCounted<ImageDescriptor>(std::move(data),
+                                                         std::move(generator));
+
+#if IMPELLER_SUPPORTS_RENDERING
+  std::shared_ptr<impeller::Allocator> allocator =
+      std::make_shared<impeller::TestImpellerAllocator>();
+  EXPECT_FALSE(ImageDecoderImpeller::DecompressYUVTexture(
+                   descriptor.get(), SkISize::Make(600, 200), {600, 200},
+                   /*supports_wide_gamut=*/false, allocator)
+                   .has_value());
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
 TEST_F(ImageDecoderFixtureTest, ExifDataIsRespectedOnDecode) {
   auto loop = fml::ConcurrentMessageLoop::Create();
   TaskRunners runners(GetCurrentTestName(),         // label
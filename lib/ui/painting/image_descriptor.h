@@ -106,6 +106,37 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
     return image_info_.dimensions();
   }
 
+  /// @brief  Gets the block compressed contents of this image, if it is
+  ///         backed by an `ImageGenerator` of a block compressed format.
+  /// @see    `ImageGenerator::GetCompressedImage`
+  std::optional<ImageGenerator::CompressedImage> get_compressed_image() const {
+    if (generator_) {
+      return generator_->GetCompressedImage();
+    }
+    return std::nullopt;
+  }
+
+  /// @brief  Whether this image can be decoded into separate YUVA planes.
+  /// @see    `ImageGenerator::QueryYUVAInfo`
+  bool query_yuva_info(
+      const SkYUVAPixmapInfo::SupportedDataTypes& supported_data_types,
+      SkYUVAPixmapInfo* info) const {
+    if (generator_) {
+      return generator_->QueryYUVAInfo(supported_data_types, info);
+    }
+    return false;
+  }
+
+  /// @brief  Gets the YUVA planes of this image, without transforming them
+  ///         based on the EXIF orientation tag.
+  /// @see    `ImageGenerator::GetYUVAPlanes`
+  bool get_yuva_planes(const SkYUVAPixmaps& pixmaps) const {
+    if (generator_) {
+      return generator_->GetYUVAPlanes(pixmaps);
+    }
+    return false;
+  }
+
   /// @brief  Gets pixels for this image transformed based on the EXIF
   ///         orientation tag, if applicable.
   bool get_pixels(const SkPixmap& pixmap) const;
@@ -4,9 +4,13 @@
 
 #include "flutter/lib/ui/painting/image_encoding_impeller.h"
 
+#include <mutex>
+#include <unordered_map>
+
 #include "flutter/lib/ui/painting/image.h"
 #include "impeller/core/device_buffer.h"
 #include "impeller/core/formats.h"
+#include "impeller/renderer/blit_pass.h"
 #include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/context.h"
 #include "third_party/skia/include/core/SkBitmap.h"
@@ -70,62 +74,137 @@ void DoConvertImageToRasterImpeller(
           }));
 }
 
+// Conversions of images owned by the raster context that are waiting for
+// the raster thread, by the context they are read back with.
+//
+// Apps often encode several images at once, for example when generating
+// thumbnails. Each of those would otherwise post its own task to the raster
+// thread and submit its own command buffer.
+class PendingRasterConversions {
+ public:
+  static PendingRasterConversions& GetInstance() {
+    static PendingRasterConversions* instance = new PendingRasterConversions();
+    return *instance;
+  }
+
+  // Returns whether |conversion| is the first one pending for |context|, in
+  // which case the caller must schedule a task that takes the conversions.
+  bool Add(const impeller::Context* context,
+           ImageEncodingImpeller::PendingConversion conversion) {
+    std::scoped_lock lock(mutex_);
+    auto& conversions = pending_[context];
+    conversions.push_back(std::move(conversion));
+    return conversions.size() == 1u;
+  }
+
+  std::vector<ImageEncodingImpeller::PendingConversion> Take(
+      const impeller::Context* context) {
+    std::scoped_lock lock(mutex_);
+    auto found = pending_.find(context);
+    if (found == pending_.end()) {
+      return {};
+    }
+    auto conversions = std::move(found->second);
+    pending_.erase(found);
+    return conversions;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<const impeller::Context*,
+                     std::vector<ImageEncodingImpeller::PendingConversion>>
+      pending_;
+
+  PendingRasterConversions() = default;
+};
+
 }  // namespace
 
 void ImageEncodingImpeller::ConvertDlImageToSkImage(
     const sk_sp<DlImage>& dl_image,
     std::function<void(sk_sp<SkImage>)> encode_task,
     const std::shared_ptr<impeller::Context>& impeller_context) {
-  auto texture = dl_image->impeller_texture();
+  std::vector<PendingConversion> conversions;
+  conversions.push_back({dl_image, std::move(encode_task)});
+  ConvertDlImagesToSkImages(std::move(conversions), impeller_context);
+}
 
+void ImageEncodingImpeller::ConvertDlImagesToSkImages(
+    std::vector<PendingConversion> conversions,
+    const std::shared_ptr<impeller::Context>& impeller_context) {
   if (impeller_context == nullptr) {
     FML_LOG(ERROR) << "Impeller context was null.";
-    encode_task(nullptr);
+    for (auto& conversion : conversions) {
+      conversion.encode_task(nullptr);
+    }
     return;
   }
 
-  if (texture == nullptr) {
-    FML_LOG(ERROR) << "Image was null.";
-    encode_task(nullptr);
-    return;
-  }
+  struct Readback {
+    std::shared_ptr<impeller::DeviceBuffer> buffer;
+    SkColorType color_type;
+    SkISize dimensions;
+    std::function<void(sk_sp<SkImage>)> encode_task;
+  };
+  std::vector<Readback> readbacks;
+  std::shared_ptr<impeller::CommandBuffer> command_buffer;
+  std::shared_ptr<impeller::BlitPass> pass;
 
-  auto dimensions = dl_image->dimensions();
-  auto color_type = ToSkColorType(texture->GetTextureDescriptor().format);
+  for (auto& conversion : conversions) {
+    auto texture = conversion.dl_image->impeller_texture();
 
-  if (dimensions.isEmpty()) {
-    FML_LOG(ERROR) << "Image dimensions were empty.";
-    encode_task(nullptr);
-    return;
+    if (texture == nullptr) {
+      FML_LOG(ERROR) << "Image was null.";
+      conversion.encode_task(nullptr);
+      continue;
+    }
+
+    auto dimensions = conversion.dl_image->dimensions();
+    auto color_type = ToSkColorType(texture->GetTextureDescriptor().format);
+
+    if (dimensions.isEmpty()) {
+      FML_LOG(ERROR) << "Image dimensions were empty.";
+      conversion.encode_task(nullptr);
+      continue;
+    }
+
+    if (!color_type.has_value()) {
+      FML_LOG(ERROR) << "Failed to get color type from pixel format.";
+      conversion.encode_task(nullptr);
+      continue;
+    }
+
+    impeller::DeviceBufferDescriptor buffer_desc;
+    buffer_desc.storage_mode = impeller::StorageMode::kHostVisible;
+    buffer_desc.size =
+        texture->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
+    auto buffer =
+        impeller_context->GetResourceAllocator()->CreateBuffer(buffer_desc);
+    if (!pass) {
+      command_buffer = impeller_context->CreateCommandBuffer();
+      command_buffer->SetLabel("BlitTextureToBuffer Command Buffer");
+      pass = command_buffer->CreateBlitPass();
+      pass->SetLabel("BlitTextureToBuffer Blit Pass");
+    }
+    pass->AddCopy(texture, buffer);
+    readbacks.push_back({buffer, color_type.value(), dimensions,
+                         std::move(conversion.encode_task)});
   }
 
-  if (!color_type.has_value()) {
-    FML_LOG(ERROR) << "Failed to get color type from pixel format.";
-    encode_task(nullptr);
+  if (!pass) {
     return;
   }
-
-  impeller::DeviceBufferDescriptor buffer_desc;
-  buffer_desc.storage_mode = impeller::StorageMode::kHostVisible;
-  buffer_desc.size =
-      texture->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
-  auto buffer =
-      impeller_context->GetResourceAllocator()->CreateBuffer(buffer_desc);
-  auto command_buffer = impeller_context->CreateCommandBuffer();
-  command_buffer->SetLabel("BlitTextureToBuffer Command Buffer");
-  auto pass = command_buffer->CreateBlitPass();
-  pass->SetLabel("BlitTextureToBuffer Blit Pass");
-  pass->AddCopy(texture, buffer);
   pass->EncodeCommands(impeller_context->GetResourceAllocator());
-  auto completion = [buffer, color_type = color_type.value(), dimensions,
-                     encode_task = std::move(encode_task)](
+  auto completion = [readbacks = std::move(readbacks)](
                         impeller::CommandBuffer::Status status) {
-    if (status != impeller::CommandBuffer::Status::kCompleted) {
-      encode_task(nullptr);
-      return;
+    for (const auto& readback : readbacks) {
+      if (status != impeller::CommandBuffer::Status::kCompleted) {
+        readback.encode_task(nullptr);
+        continue;
+      }
+      readback.encode_task(ConvertBufferToSkImage(
+          readback.buffer, readback.color_type, readback.dimensions));
     }
-    auto sk_image = ConvertBufferToSkImage(buffer, color_type, dimensions);
-    encode_task(sk_image);
   };
 
   if (!command_buffer->SubmitCommands(completion)) {
@@ -156,12 +235,26 @@ void ImageEncodingImpeller::ConvertImageToRaster(
     return;
   }
 
-  raster_task_runner->PostTask([dl_image, encode_task = std::move(encode_task),
-                                io_task_runner, is_gpu_disabled_sync_switch,
-                                impeller_context]() mutable {
-    DoConvertImageToRasterImpeller(dl_image, std::move(encode_task),
-                                   is_gpu_disabled_sync_switch,
-                                   impeller_context);
+  if (!PendingRasterConversions::GetInstance().Add(
+          impeller_context.get(), {dl_image, std::move(encode_task)})) {
+    // Already scheduled along with the conversions pending before it.
+    return;
+  }
+  raster_task_runner->PostTask([is_gpu_disabled_sync_switch,
+                                impeller_context]() {
+    auto conversions =
+        PendingRasterConversions::GetInstance().Take(impeller_context.get());
+    is_gpu_disabled_sync_switch->Execute(
+        fml::SyncSwitch::Handlers()
+            .SetIfTrue([&conversions] {
+              for (auto& conversion : conversions) {
+                conversion.encode_task(nullptr);
+              }
+            })
+            .SetIfFalse([&conversions, &impeller_context] {
+              ConvertDlImagesToSkImages(std::move(conversions),
+                                        impeller_context);
+            }));
   });
 }
 
@@ -5,6 +5,9 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_ENCODING_IMPELLER_H_
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_ENCODING_IMPELLER_H_
 
+#include <functional>
+#include <vector>
+
 #include "flutter/common/task_runners.h"
 #include "flutter/display_list/image/dl_image.h"
 #include "flutter/fml/synchronization/sync_switch.h"
@@ -19,6 +22,13 @@ class ImageEncodingImpeller {
  public:
   static int GetColorSpace(const std::shared_ptr<impeller::Texture>& texture);
 
+  /// A DlImage waiting to be converted to a SkImage, and the task to run
+  /// with the result.
+  struct PendingConversion {
+    sk_sp<DlImage> dl_image;
+    std::function<void(sk_sp<SkImage>)> encode_task;
+  };
+
   /// Converts a DlImage to a SkImage.
   /// This should be called from the thread that corresponds to
   /// `dl_image->owning_context()` when gpu access is guaranteed.
@@ -29,7 +39,17 @@ class ImageEncodingImpeller {
       std::function<void(sk_sp<SkImage>)> encode_task,
       const std::shared_ptr<impeller::Context>& impeller_context);
 
+  /// Converts several DlImages to SkImages, reading all of them back with a
+  /// single command buffer.
+  /// The same threading requirements as `ConvertDlImageToSkImage` apply to
+  /// every image.
+  static void ConvertDlImagesToSkImages(
+      std::vector<PendingConversion> conversions,
+      const std::shared_ptr<impeller::Context>& impeller_context);
+
   /// Converts a DlImage to a SkImage.
+  /// Images owned by the raster context that are waiting for the raster
+  /// thread at the same time are read back together.
   /// `encode_task` is executed with the resulting `SkImage`.
   static void ConvertImageToRaster(
       const sk_sp<DlImage>& dl_image,
@@ -275,6 +275,53 @@ TEST(ImageEncodingImpellerTest, ConvertDlImageToSkImage10XR) {
       context);
   EXPECT_TRUE(did_call);
 }
+
+TEST(ImageEncodingImpellerTest, ConvertDlImagesToSkImagesSharesCommandBuffer) {
+  auto context = std::make_shared<MockImpellerContext>();
+  auto command_buffer = std::make_shared<MockCommandBuffer>(context);
+  auto allocator = std::make_shared<MockAllocator>();
+  auto blit_pass = std::make_shared<MockBlitPass>();
+  std::vector<uint8_t> buffer(100 * 100 * 4);
+  impeller::DeviceBufferDescriptor device_buffer_desc;
+  device_buffer_desc.size = buffer.size();
+  auto device_buffer = std::make_shared<MockDeviceBuffer>(device_buffer_desc);
+  EXPECT_CALL(*allocator, OnCreateBuffer)
+      .Times(2)
+      .WillRepeatedly(Return(device_buffer));
+  EXPECT_CALL(*blit_pass, IsValid).WillRepeatedly(Return(true));
+  EXPECT_CALL(*command_buffer, IsValid).WillRepeatedly(Return(true));
+  EXPECT_CALL(*command_buffer, OnCreateBlitPass).WillOnce(Return(blit_pass));
+  EXPECT_CALL(*command_buffer, OnSubmitCommands(_))
+      .WillOnce(
+          DoAll(InvokeArgument<0>(impeller::CommandBuffer::Status::kCompleted),
+                Return(true)));
+  EXPECT_CALL(*context, GetResourceAllocator).WillRepeatedly(Return(allocator));
+  // Both images are read back with one command buffer.
+  EXPECT_CALL(*context, CreateCommandBuffer).WillOnce(Return(command_buffer));
+  EXPECT_CALL(*device_buffer, OnGetContents)
+      .WillRepeatedly(Return(buffer.data()));
+
+  std::vector<ImageEncodingImpeller::PendingConversion> conversions;
+  size_t call_count = 0u;
+  for (int i = 0; i < 2; i++) {
+    sk_sp<MockDlImage> image(new MockDlImage());
+    EXPECT_CALL(*image, dimensions)
+        .WillRepeatedly(Return(SkISize::Make(100, 100)));
+    impeller::TextureDescriptor desc;
+    desc.format = impeller::PixelFormat::kR8G8B8A8UNormInt;
+    auto texture = std::make_shared<MockTexture>(desc);
+    EXPECT_CALL(*image, impeller_texture).WillOnce(Return(texture));
+    conversions.push_back({image, [&call_count](const sk_sp<SkImage>& image) {
+                             call_count++;
+                             ASSERT_TRUE(image);
+                             EXPECT_EQ(kRGBA_8888_SkColorType,
+                                       image->colorType());
+                           }});
+  }
+  ImageEncodingImpeller::ConvertDlImagesToSkImages(std::move(conversions),
+                                                   context);
+  EXPECT_EQ(call_count, 2u);
+}
 #endif  // IMPELLER_SUPPORTS_RENDERING
 
 }  // namespace testing
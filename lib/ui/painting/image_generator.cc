@@ -16,6 +16,21 @@ namespace flutter {
 
 ImageGenerator::~ImageGenerator() = default;
 
+std::optional<ImageGenerator::CompressedImage>
+ImageGenerator::GetCompressedImage() {
+  return std::nullopt;
+}
+
+bool ImageGenerator::QueryYUVAInfo(
+    const SkYUVAPixmapInfo::SupportedDataTypes& supported_data_types,
+    SkYUVAPixmapInfo* info) const {
+  return false;
+}
+
+bool ImageGenerator::GetYUVAPlanes(const SkYUVAPixmaps& pixmaps) {
+  return false;
+}
+
 sk_sp<SkImage> ImageGenerator::GetImage() {
   SkImageInfo info = GetInfo();
 
@@ -188,6 +203,23 @@ bool BuiltinSkiaCodecImageGenerator::GetPixels(
   return SkPixmapUtils::Orient(output_pixmap, temp_pixmap, origin);
 }
 
+bool BuiltinSkiaCodecImageGenerator::QueryYUVAInfo(
+    const SkYUVAPixmapInfo::SupportedDataTypes& supported_data_types,
+    SkYUVAPixmapInfo* info) const {
+  return codec_->queryYUVAInfo(supported_data_types, info);
+}
+
+bool BuiltinSkiaCodecImageGenerator::GetYUVAPlanes(
+    const SkYUVAPixmaps& pixmaps) {
+  SkCodec::Result result = codec_->getYUVAPlanes(pixmaps);
+  if (result != SkCodec::kSuccess) {
+    FML_DLOG(WARNING) << "codec could not get YUVA planes. "
+                      << SkCodec::ResultToString(result);
+    return false;
+  }
+  return true;
+}
+
 std::unique_ptr<ImageGenerator> BuiltinSkiaCodecImageGenerator::MakeFromData(
     sk_sp<SkData> data) {
   auto codec = SkCodec::MakeFromData(std::move(data));
@@ -14,6 +14,7 @@
 #include "third_party/skia/include/core/SkImageGenerator.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkSize.h"
+#include "third_party/skia/include/core/SkYUVAPixmaps.h"
 
 namespace flutter {
 
@@ -51,6 +52,18 @@ class ImageGenerator {
     SkCodecAnimation::Blend blend_mode;
   };
 
+  /// @brief  A single frame image that is already encoded in a block
+  ///         compressed format that GPUs can sample from directly.
+  struct CompressedImage {
+    /// The `VkFormat` of the blocks. Compressed images use the Vulkan format
+    /// enumeration regardless of the rendering backend.
+    uint32_t vk_format = 0u;
+    /// The size of the image in pixels.
+    SkISize dimensions = SkISize::MakeEmpty();
+    /// The blocks of the base mip level, in row major order.
+    sk_sp<SkData> data;
+  };
+
   virtual ~ImageGenerator();
 
   /// @brief   Returns basic information about the contents of the encoded
@@ -135,6 +148,36 @@ class ImageGenerator {
       unsigned int frame_index = 0,
       std::optional<unsigned int> prior_frame = std::nullopt) = 0;
 
+  /// @brief   Get the contents of the image in a block compressed format, for
+  ///          image formats that can be uploaded to the GPU without being
+  ///          decoded. Generators of such images may not be able to decode
+  ///          them into pixels with `GetPixels` at all.
+  ///
+  /// @return  The compressed image, or std::nullopt if the image isn't in a
+  ///          block compressed format.
+  virtual std::optional<CompressedImage> GetCompressedImage();
+
+  /// @brief   Query whether the image can be decoded into separate YUVA
+  ///          planes, for image formats that store images as YUV such as
+  ///          JPEG. Planes are only decoded at the full size of the image and
+  ///          aren't transformed based on the EXIF orientation tag.
+  ///
+  /// @param[in]  supported_data_types  The plane data types that the caller
+  ///                                   can accept.
+  /// @param[out] info                  The layout of the planes, if the image
+  ///                                   can be decoded into planes.
+  /// @return  True if the image can be decoded with `GetYUVAPlanes`.
+  virtual bool QueryYUVAInfo(
+      const SkYUVAPixmapInfo::SupportedDataTypes& supported_data_types,
+      SkYUVAPixmapInfo* info) const;
+
+  /// @brief   Decode the image into YUVA planes of a layout returned by
+  ///          `QueryYUVAInfo`.
+  /// @param[in]  pixmaps  The planes to decode the image into.
+  /// @return  True if the image was successfully decoded.
+  /// @see     `QueryYUVAInfo`
+  virtual bool GetYUVAPlanes(const SkYUVAPixmaps& pixmaps);
+
   /// @brief   Creates an `SkImage` based on the current `ImageInfo` of this
   ///          `ImageGenerator`.
   /// @return  A new `SkImage` containing the decoded image data.
@@ -212,6 +255,14 @@ class BuiltinSkiaCodecImageGenerator : public ImageGenerator {
       unsigned int frame_index = 0,
       std::optional<unsigned int> prior_frame = std::nullopt) override;
 
+  // |ImageGenerator|
+  bool QueryYUVAInfo(
+      const SkYUVAPixmapInfo::SupportedDataTypes& supported_data_types,
+      SkYUVAPixmapInfo* info) const override;
+
+  // |ImageGenerator|
+  bool GetYUVAPlanes(const SkYUVAPixmaps& pixmaps) override;
+
   static std::unique_ptr<ImageGenerator> MakeFromData(sk_sp<SkData> data);
 
  private:
@@ -0,0 +1,147 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "image_generator_ktx2.h"
+
+#include <cstring>
+#include <limits>
+
+#include "flutter/fml/endianness.h"
+#include "flutter/fml/logging.h"
+#include "third_party/skia/include/core/SkAlphaType.h"
+#include "third_party/skia/include/core/SkColorType.h"
+#include "third_party/skia/include/core/SkImageInfo.h"
+
+namespace flutter {
+
+KTX2ImageGenerator::~KTX2ImageGenerator() = default;
+
+KTX2ImageGenerator::KTX2ImageGenerator(const SkImageInfo& image_info,
+                                       uint32_t vk_format,
+                                       sk_sp<SkData> base_level)
+    : image_info_(image_info),
+      vk_format_(vk_format),
+      base_level_(std::move(base_level)) {}
+
+const SkImageInfo& KTX2ImageGenerator::GetInfo() {
+  return image_info_;
+}
+
+unsigned int KTX2ImageGenerator::GetFrameCount() const {
+  return 1;
+}
+
+unsigned int KTX2ImageGenerator::GetPlayCount() const {
+  return 1;
+}
+
+const ImageGenerator::FrameInfo KTX2ImageGenerator::GetFrameInfo(
+    unsigned int frame_index) {
+  return {.required_frame = std::nullopt,
+          .duration = 0,
+          .disposal_method = SkCodecAnimation::DisposalMethod::kKeep};
+}
+
+SkISize KTX2ImageGenerator::GetScaledDimensions(float desired_scale) {
+  return image_info_.dimensions();
+}
+
+bool KTX2ImageGenerator::GetPixels(const SkImageInfo& info,
+                                   void* pixels,
+                                   size_t row_bytes,
+                                   unsigned int frame_index,
+                                   std::optional<unsigned int> prior_frame) {
+  // The blocks are only ever decompressed by the GPU.
+  return false;
+}
+
+std::optional<ImageGenerator::CompressedImage>
+KTX2ImageGenerator::GetCompressedImage() {
+  return CompressedImage{
+      .vk_format = vk_format_,
+      .dimensions = image_info_.dimensions(),
+      .data = base_level_,
+  };
+}
+
+size_t KTX2ImageGenerator::BytesPerBlock(uint32_t vk_format) {
+  switch (vk_format) {
+    case kVkFormatBC1RGBAUNormBlock:
+    case kVkFormatETC2R8G8B8UNormBlock:
+      return 8u;
+    case kVkFormatBC3UNormBlock:
+    case kVkFormatBC7UNormBlock:
+    case kVkFormatETC2R8G8B8A8UNormBlock:
+    case kVkFormatASTC4x4UNormBlock:
+      return 16u;
+    default:
+      return 0u;
+  }
+}
+
+std::unique_ptr<ImageGenerator> KTX2ImageGenerator::MakeFromData(
+    sk_sp<SkData> data) {
+  if (!data || data->size() < sizeof(Header)) {
+    return nullptr;
+  }
+
+  Header header;
+  memcpy(&header, data->data(), sizeof(Header));
+  if (memcmp(header.identifier, kKTX2Identifier, sizeof(kKTX2Identifier)) !=
+      0) {
+    return nullptr;
+  }
+
+  const auto vk_format = fml::LittleEndianToArch(header.vk_format);
+  const auto width = fml::LittleEndianToArch(header.pixel_width);
+  const auto height = fml::LittleEndianToArch(header.pixel_height);
+  const auto bytes_per_block = BytesPerBlock(vk_format);
+  if (bytes_per_block == 0u) {
+    FML_DLOG(ERROR) << "Unsupported KTX2 VkFormat " << vk_format << ".";
+    return nullptr;
+  }
+  if (width == 0u || height == 0u ||
+      width > static_cast<uint32_t>(std::numeric_limits<int>::max()) ||
+      height > static_cast<uint32_t>(std::numeric_limits<int>::max()) ||
+      fml::LittleEndianToArch(header.pixel_depth) != 0u ||
+      fml::LittleEndianToArch(header.layer_count) > 1u ||
+      fml::LittleEndianToArch(header.face_count) != 1u) {
+    FML_DLOG(ERROR) << "Only single 2D KTX2 images are supported.";
+    return nullptr;
+  }
+  if (fml::LittleEndianToArch(header.supercompression_scheme) != 0u) {
+    FML_DLOG(ERROR) << "Supercompressed KTX2 images are not supported.";
+    return nullptr;
+  }
+
+  // The level index immediately follows the header and starts with the base
+  // mip level.
+  LevelIndexEntry base_level;
+  if (data->size() < sizeof(Header) + sizeof(LevelIndexEntry)) {
+    return nullptr;
+  }
+  memcpy(&base_level, data->bytes() + sizeof(Header), sizeof(LevelIndexEntry));
+  const auto offset = fml::LittleEndianToArch(base_level.byte_offset);
+  const auto length = fml::LittleEndianToArch(base_level.byte_length);
+  const uint64_t expected_length = static_cast<uint64_t>((width + 3u) / 4u) *
+                                   ((height + 3u) / 4u) * bytes_per_block;
+  if (length != expected_length || offset > data->size() ||
+      length > data->size() - offset) {
+    FML_DLOG(ERROR) << "Invalid KTX2 base mip level.";
+    return nullptr;
+  }
+
+  // Formats without an alpha channel are opaque.
+  const bool is_opaque = vk_format == kVkFormatETC2R8G8B8UNormBlock;
+  auto image_info = SkImageInfo::Make(
+      width, height, kRGBA_8888_SkColorType,
+      is_opaque ? kOpaque_SkAlphaType : kPremul_SkAlphaType);
+
+  return std::unique_ptr<KTX2ImageGenerator>(new KTX2ImageGenerator(
+      image_info, vk_format,
+      SkData::MakeSubset(data.get(), static_cast<size_t>(offset),
+                         static_cast<size_t>(length))));
+}
+
+}  // namespace flutter
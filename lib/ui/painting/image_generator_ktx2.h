@@ -0,0 +1,114 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_KTX2_H_
+#define FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_KTX2_H_
+
+#include "image_generator.h"
+
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      An image generator for KTX 2.0 containers of block compressed
+///             (ETC2, ASTC or BC) images.
+///
+///             The blocks are handed to the GPU as-is through
+///             `GetCompressedImage`, so images of this generator are never
+///             decoded on the CPU and can't be resized.
+///
+///             Only single 2D images without supercompression are supported.
+///             Only the base mip level of the container is used. Like all
+///             textures, images with alpha must have premultiplied colors.
+///
+/// @see        https://registry.khronos.org/KTX/specs/2.0/ktxspec.v2.html
+///
+class KTX2ImageGenerator : public ImageGenerator {
+ public:
+  // VkFormat values of the supported formats.
+  static constexpr uint32_t kVkFormatBC1RGBAUNormBlock = 133u;
+  static constexpr uint32_t kVkFormatBC3UNormBlock = 137u;
+  static constexpr uint32_t kVkFormatBC7UNormBlock = 145u;
+  static constexpr uint32_t kVkFormatETC2R8G8B8UNormBlock = 147u;
+  static constexpr uint32_t kVkFormatETC2R8G8B8A8UNormBlock = 151u;
+  static constexpr uint32_t kVkFormatASTC4x4UNormBlock = 157u;
+
+  ~KTX2ImageGenerator();
+
+  // |ImageGenerator|
+  const SkImageInfo& GetInfo() override;
+
+  // |ImageGenerator|
+  unsigned int GetFrameCount() const override;
+
+  // |ImageGenerator|
+  unsigned int GetPlayCount() const override;
+
+  // |ImageGenerator|
+  const ImageGenerator::FrameInfo GetFrameInfo(
+      unsigned int frame_index) override;
+
+  // |ImageGenerator|
+  SkISize GetScaledDimensions(float desired_scale) override;
+
+  // |ImageGenerator|
+  bool GetPixels(const SkImageInfo& info,
+                 void* pixels,
+                 size_t row_bytes,
+                 unsigned int frame_index,
+                 std::optional<unsigned int> prior_frame) override;
+
+  // |ImageGenerator|
+  std::optional<CompressedImage> GetCompressedImage() override;
+
+  static std::unique_ptr<ImageGenerator> MakeFromData(sk_sp<SkData> data);
+
+ private:
+  static constexpr uint8_t kKTX2Identifier[12] = {
+      0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+  struct __attribute__((packed, aligned(1))) Header {
+    uint8_t identifier[12];
+    uint32_t vk_format;
+    uint32_t type_size;
+    uint32_t pixel_width;
+    uint32_t pixel_height;
+    uint32_t pixel_depth;
+    uint32_t layer_count;
+    uint32_t face_count;
+    uint32_t level_count;
+    uint32_t supercompression_scheme;
+    uint32_t dfd_byte_offset;
+    uint32_t dfd_byte_length;
+    uint32_t kvd_byte_offset;
+    uint32_t kvd_byte_length;
+    uint64_t sgd_byte_offset;
+    uint64_t sgd_byte_length;
+  };
+
+  struct __attribute__((packed, aligned(1))) LevelIndexEntry {
+    uint64_t byte_offset;
+    uint64_t byte_length;
+    uint64_t uncompressed_byte_length;
+  };
+
+  /// The number of bytes of each 4x4 block of a supported VkFormat, or 0 if
+  /// the format isn't supported.
+  static size_t BytesPerBlock(uint32_t vk_format);
+
+  KTX2ImageGenerator(const SkImageInfo& image_info,
+                     uint32_t vk_format,
+                     sk_sp<SkData> base_level);
+
+  const SkImageInfo image_info_;
+  const uint32_t vk_format_;
+  sk_sp<SkData> base_level_;
+
+  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(KTX2ImageGenerator);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_KTX2_H_
@@ -4,6 +4,8 @@
 
 #include "flutter/lib/ui/painting/image_generator_registry.h"
 
+#include <vector>
+
 #include "flutter/fml/mapping.h"
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/testing/testing.h"
@@ -42,6 +44,62 @@ TEST_F(ShellTest, CreateCompatibleReturnsBuiltinImageGeneratorForValidImage) {
   ASSERT_EQ(info.height(), 4032);
 }
 
+// Builds a KTX2 container of a single 8x8 ASTC 4x4 image.
+static std::vector<uint8_t> MakeKTX2Container(uint32_t supercompression) {
+  const uint8_t identifier[12] = {0xAB, 'K',  'T',  'X',  ' ', '2',
+                                  '0',  0xBB, '\r', '\n', 0x1A, '\n'};
+  std::vector<uint8_t> container(identifier, identifier + 12);
+  auto append = [&container](uint64_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; i++) {
+      container.push_back((value >> (i * 8)) & 0xFF);
+    }
+  };
+  append(157, 4);  // vkFormat: VK_FORMAT_ASTC_4x4_UNORM_BLOCK.
+  append(1, 4);    // typeSize.
+  append(8, 4);    // pixelWidth.
+  append(8, 4);    // pixelHeight.
+  append(0, 4);    // pixelDepth.
+  append(0, 4);    // layerCount.
+  append(1, 4);    // faceCount.
+  append(1, 4);    // levelCount.
+  append(supercompression, 4);
+  // The data format descriptor, key/value data and supercompression global
+  // data indices.
+  container.resize(container.size() + 4 * 4 + 8 * 2, 0);
+  // The level index.
+  append(104, 8);  // byteOffset.
+  append(64, 8);   // byteLength.
+  append(64, 8);   // uncompressedByteLength.
+  container.resize(104 + 64, 0x42);
+  return container;
+}
+
+TEST_F(ShellTest, CreateCompatibleReturnsCompressedImageForKTX2) {
+  auto container = MakeKTX2Container(0);
+  ImageGeneratorRegistry registry;
+  auto result = registry.CreateCompatibleGenerator(
+      SkData::MakeWithCopy(container.data(), container.size()));
+  ASSERT_NE(result, nullptr);
+  ASSERT_EQ(result->GetInfo().width(), 8);
+  ASSERT_EQ(result->GetInfo().height(), 8);
+  ASSERT_EQ(result->GetFrameCount(), 1u);
+
+  auto compressed = result->GetCompressedImage();
+  ASSERT_TRUE(compressed.has_value());
+  ASSERT_EQ(compressed->vk_format, 157u);
+  ASSERT_EQ(compressed->dimensions, SkISize::Make(8, 8));
+  ASSERT_EQ(compressed->data->size(), 64u);
+  ASSERT_EQ(compressed->data->bytes()[0], 0x42);
+}
+
+TEST_F(ShellTest, CreateCompatibleRejectsSupercompressedKTX2) {
+  auto container = MakeKTX2Container(2);
+  ImageGeneratorRegistry registry;
+  auto result = registry.CreateCompatibleGenerator(
+      SkData::MakeWithCopy(container.data(), container.size()));
+  ASSERT_EQ(result, nullptr);
+}
+
 TEST_F(ShellTest, CreateCompatibleReturnsNullptrForInvalidImage) {
   ImageGeneratorRegistry registry;
   auto result = registry.CreateCompatibleGenerator(SkData::MakeEmpty());
@@ -0,0 +1,101 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_upload_batcher.h"
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/impeller/renderer/blit_pass.h"
+#include "flutter/impeller/renderer/command_buffer.h"
+#include "flutter/impeller/renderer/context.h"
+
+namespace flutter {
+
+ImageUploadBatcher::ImageUploadBatcher(
+    fml::RefPtr<fml::TaskRunner> task_runner,
+    std::shared_ptr<const fml::SyncSwitch> gpu_disabled_switch,
+    fml::TimeDelta batch_window)
+    : task_runner_(std::move(task_runner)),
+      gpu_disabled_switch_(std::move(gpu_disabled_switch)),
+      batch_window_(batch_window) {}
+
+ImageUploadBatcher::~ImageUploadBatcher() = default;
+
+void ImageUploadBatcher::Enqueue(
+    const std::shared_ptr<impeller::Context>& context,
+    Upload upload) {
+  FML_DCHECK(task_runner_->RunsTasksOnCurrentThread());
+  if (!pending_uploads_.empty() && context_ != context) {
+    Flush();
+  }
+  context_ = context;
+  pending_uploads_.push_back(std::move(upload));
+
+  if (pending_uploads_.size() >= kMaxBatchSize) {
+    Flush();
+    return;
+  }
+  if (pending_uploads_.size() == 1u) {
+    task_runner_->PostDelayedTask(
+        [strong = fml::Ref(this), batch_id = batch_id_]() {
+          if (strong->batch_id_ == batch_id) {
+            strong->Flush();
+          }
+        },
+        batch_window_);
+  }
+}
+
+void ImageUploadBatcher::Flush() {
+  FML_DCHECK(task_runner_->RunsTasksOnCurrentThread());
+  batch_id_++;
+  if (pending_uploads_.empty()) {
+    return;
+  }
+  TRACE_EVENT1("flutter", "ImageUploadBatcher::Flush", "uploads",
+               std::to_string(pending_uploads_.size()).c_str());
+
+  std::vector<Upload> uploads;
+  uploads.swap(pending_uploads_);
+  auto context = std::move(context_);
+
+  bool submitted = false;
+  gpu_disabled_switch_->Execute(
+      fml::SyncSwitch::Handlers().SetIfFalse([&] {
+        if (!context) {
+          return;
+        }
+        auto command_buffer = context->CreateCommandBuffer();
+        if (!command_buffer) {
+          FML_DLOG(ERROR) << "Could not create command buffer for uploads.";
+          return;
+        }
+        command_buffer->SetLabel("Image Upload Command Buffer");
+        auto blit_pass = command_buffer->CreateBlitPass();
+        if (!blit_pass) {
+          FML_DLOG(ERROR) << "Could not create blit pass for uploads.";
+          return;
+        }
+        blit_pass->SetLabel("Image Upload Blit Pass");
+        for (const auto& upload : uploads) {
+          upload.encode(*blit_pass);
+        }
+        if (!blit_pass->EncodeCommands(context->GetResourceAllocator()) ||
+            !command_buffer->SubmitCommands()) {
+          FML_DLOG(ERROR) << "Failed to submit image upload command buffer.";
+          return;
+        }
+        submitted = true;
+      }));
+
+  for (const auto& upload : uploads) {
+    upload.on_complete(submitted);
+  }
+}
+
+size_t ImageUploadBatcher::GetPendingUploadCount() const {
+  return pending_uploads_.size();
+}
+
+}  // namespace flutter
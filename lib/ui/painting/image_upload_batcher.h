@@ -0,0 +1,99 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_UPLOAD_BATCHER_H_
+#define FLUTTER_LIB_UI_PAINTING_IMAGE_UPLOAD_BATCHER_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/ref_counted.h"
+#include "flutter/fml/synchronization/sync_switch.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace impeller {
+class BlitPass;
+class Context;
+}  // namespace impeller
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Coalesces the texture uploads of decoded images that arrive
+///             within a short window into a single blit pass, so that a burst
+///             of decoded images is submitted with one command buffer instead
+///             of one command buffer each.
+///
+///             All methods must be called on the task runner the batcher was
+///             created with, which is usually the IO task runner.
+///
+class ImageUploadBatcher
+    : public fml::RefCountedThreadSafe<ImageUploadBatcher> {
+ public:
+  /// How long the first upload of a batch waits for more uploads.
+  static constexpr fml::TimeDelta kDefaultBatchWindow =
+      fml::TimeDelta::FromMilliseconds(2);
+
+  /// The most uploads submitted together. Reaching it flushes the batch
+  /// immediately.
+  static constexpr size_t kMaxBatchSize = 16u;
+
+  struct Upload {
+    /// Encodes the upload into the blit pass shared by the batch. Called when
+    /// the batch is flushed. The upload is responsible for reporting its own
+    /// encoding errors.
+    std::function<void(impeller::BlitPass& blit_pass)> encode;
+    /// Called after the batch was flushed with whether the commands of the
+    /// batch were submitted. Uploads that weren't submitted, for instance
+    /// because the GPU was disabled in the meantime, may be retried by the
+    /// caller.
+    std::function<void(bool submitted)> on_complete;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Add an upload to the current batch, starting a new batch if
+  ///             there is none.
+  ///
+  /// @param[in]  context  The context to submit the batch with. All uploads of
+  ///                      a batch must use the same context.
+  /// @param[in]  upload   The upload.
+  ///
+  void Enqueue(const std::shared_ptr<impeller::Context>& context,
+               Upload upload);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Encode and submit all pending uploads now. Usually, batches
+  ///             are flushed automatically.
+  ///
+  void Flush();
+
+  size_t GetPendingUploadCount() const;
+
+ private:
+  const fml::RefPtr<fml::TaskRunner> task_runner_;
+  const std::shared_ptr<const fml::SyncSwitch> gpu_disabled_switch_;
+  const fml::TimeDelta batch_window_;
+  std::shared_ptr<impeller::Context> context_;
+  std::vector<Upload> pending_uploads_;
+  // Incremented by every flush so that delayed flushes of batches that were
+  // already flushed don't flush the next batch early.
+  size_t batch_id_ = 0u;
+
+  ImageUploadBatcher(fml::RefPtr<fml::TaskRunner> task_runner,
+                     std::shared_ptr<const fml::SyncSwitch> gpu_disabled_switch,
+                     fml::TimeDelta batch_window = kDefaultBatchWindow);
+
+  ~ImageUploadBatcher();
+
+  FML_FRIEND_REF_COUNTED_THREAD_SAFE(ImageUploadBatcher);
+  FML_FRIEND_MAKE_REF_COUNTED(ImageUploadBatcher);
+  FML_DISALLOW_COPY_AND_ASSIGN(ImageUploadBatcher);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_IMAGE_UPLOAD_BATCHER_H_
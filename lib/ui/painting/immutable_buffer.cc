@@ -4,6 +4,7 @@
 
 #include "flutter/lib/ui/painting/immutable_buffer.h"
 
+#include <algorithm>
 #include <cstring>
 
 #include "flutter/fml/file.h"
@@ -46,6 +47,29 @@ Dart_Handle ImmutableBuffer::init(Dart_Handle buffer_handle,
 Dart_Handle ImmutableBuffer::initFromAsset(Dart_Handle raw_buffer_handle,
                                            Dart_Handle asset_name_handle,
                                            Dart_Handle callback_handle) {
+  return InitFromAssetRange(raw_buffer_handle, asset_name_handle, 0,
+                            std::nullopt, callback_handle);
+}
+
+Dart_Handle ImmutableBuffer::initFromAssetRange(Dart_Handle raw_buffer_handle,
+                                                Dart_Handle asset_name_handle,
+                                                int64_t offset,
+                                                int64_t length,
+                                                Dart_Handle callback_handle) {
+  if (offset < 0 || length < 0) {
+    return tonic::ToDart("Offset and length must not be negative");
+  }
+  return InitFromAssetRange(raw_buffer_handle, asset_name_handle,
+                            static_cast<size_t>(offset),
+                            static_cast<size_t>(length), callback_handle);
+}
+
+Dart_Handle ImmutableBuffer::InitFromAssetRange(
+    Dart_Handle raw_buffer_handle,
+    Dart_Handle asset_name_handle,
+    size_t offset,
+    std::optional<size_t> length,
+    Dart_Handle callback_handle) {
   UIDartState::ThrowIfUIOperationsProhibited();
   if (!Dart_IsClosure(callback_handle)) {
     return tonic::ToDart("Callback must be a function");
@@ -75,7 +99,7 @@ Dart_Handle ImmutableBuffer::initFromAsset(Dart_Handle raw_buffer_handle,
 
   auto ui_task = fml::MakeCopyable(
       [buffer_callback_ptr, buffer_handle_ptr](const sk_sp<SkData>& sk_data,
-                                               size_t buffer_size) mutable {
+                                               int64_t buffer_size) mutable {
         std::unique_ptr<tonic::DartPersistentValue> buffer_handle(
             buffer_handle_ptr);
         std::unique_ptr<tonic::DartPersistentValue> buffer_callback(
@@ -88,8 +112,10 @@ Dart_Handle ImmutableBuffer::initFromAsset(Dart_Handle raw_buffer_handle,
         tonic::DartState::Scope scope(dart_state);
 
         if (!sk_data) {
-          // -1 is used as a sentinel that the file could not be opened.
-          tonic::DartInvoke(buffer_callback->Get(), {tonic::ToDart(-1)});
+          // -1 is used as a sentinel that the file could not be opened, and -2
+          // as a sentinel that the range is out of the bounds of the file.
+          tonic::DartInvoke(buffer_callback->Get(),
+                            {tonic::ToDart(buffer_size)});
           return;
         }
         auto buffer = fml::MakeRefCounted<ImmutableBuffer>(sk_data);
@@ -100,16 +126,23 @@ Dart_Handle ImmutableBuffer::initFromAsset(Dart_Handle raw_buffer_handle,
   dart_state->GetConcurrentTaskRunner()->PostTask(
       [asset_name = std::move(asset_name),
        asset_manager = std::move(asset_manager),
-       ui_task_runner = std::move(ui_task_runner), ui_task] {
+       ui_task_runner = std::move(ui_task_runner), ui_task, offset, length] {
         std::unique_ptr<fml::Mapping> mapping =
             asset_manager->GetAsMapping(asset_name);
 
         sk_sp<SkData> sk_data;
-        size_t buffer_size = 0;
+        int64_t buffer_size = -1;
         if (mapping != nullptr) {
-          buffer_size = mapping->GetSize();
-          const void* bytes = static_cast<const void*>(mapping->GetMapping());
-          sk_data = MakeSkDataWithCopy(bytes, buffer_size);
+          const auto size = mapping->GetSize();
+          const auto range_length =
+              length.value_or(size - std::min(offset, size));
+          if (offset > size || range_length > size - offset) {
+            buffer_size = -2;
+          } else {
+            buffer_size = range_length;
+            sk_data =
+                MakeSkDataFromMapping(std::move(mapping), offset, range_length);
+          }
         }
         ui_task_runner->PostTask(
             [sk_data = std::move(sk_data), ui_task = ui_task, buffer_size]() {
@@ -189,6 +222,25 @@ Dart_Handle ImmutableBuffer::initFromFile(Dart_Handle raw_buffer_handle,
   return Dart_Null();
 }
 
+sk_sp<SkData> ImmutableBuffer::MakeSkDataFromMapping(
+    std::unique_ptr<fml::Mapping> mapping,
+    size_t offset,
+    size_t length) {
+  // Mappings of files are not copied. Their pages are shared with the page
+  // cache and only faulted in as they are read, so wrapping them doesn't
+  // increase the memory footprint. Other mappings may be heap allocated and
+  // are copied so that they are freed on the thread they were allocated on.
+  if (!mapping->IsDontNeedSafe() || length == 0) {
+    return MakeSkDataWithCopy(mapping->GetMapping() + offset, length);
+  }
+  auto* raw_mapping = mapping.release();
+  SkData::ReleaseProc proc = [](const void* ptr, void* context) {
+    delete reinterpret_cast<fml::Mapping*>(context);
+  };
+  return SkData::MakeWithProc(raw_mapping->GetMapping() + offset, length, proc,
+                              raw_mapping);
+}
+
 #if FML_OS_ANDROID
 
 // Compressed image buffers are allocated on the UI thread but are deleted on a
@@ -6,8 +6,11 @@
 #define FLUTTER_LIB_UI_PAINTNIG_IMMUTABLE_BUFER_H_
 
 #include <cstdint>
+#include <memory>
+#include <optional>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/tonic/dart_library_natives.h"
@@ -56,6 +59,20 @@ class ImmutableBuffer : public RefCountedDartWrappable<ImmutableBuffer> {
                                    Dart_Handle asset_name_handle,
                                    Dart_Handle callback_handle);
 
+  /// Initializes a new ImmutableData from a range of the bytes of an asset
+  /// matching a provided asset string.
+  ///
+  /// The arguments are the same as those of `initFromAsset`, with the range
+  /// given as an offset and a length in bytes between the asset string and
+  /// the callback.
+  ///
+  /// Like with `initFromAsset`, assets that are memory mapped are not copied.
+  static Dart_Handle initFromAssetRange(Dart_Handle buffer_handle,
+                                        Dart_Handle asset_name_handle,
+                                        int64_t offset,
+                                        int64_t length,
+                                        Dart_Handle callback_handle);
+
   /// Initializes a new ImmutableData from an File path.
   ///
   /// The zero indexed argument is the caller that will be registered as the
@@ -96,6 +113,20 @@ class ImmutableBuffer : public RefCountedDartWrappable<ImmutableBuffer> {
 
   static sk_sp<SkData> MakeSkDataWithCopy(const void* data, size_t length);
 
+  /// Wraps a range of a mapping without copying it if the mapping is backed
+  /// by a file, and takes ownership of the mapping.
+  static sk_sp<SkData> MakeSkDataFromMapping(
+      std::unique_ptr<fml::Mapping> mapping,
+      size_t offset,
+      size_t length);
+
+  /// Loads the whole asset if `length` is std::nullopt.
+  static Dart_Handle InitFromAssetRange(Dart_Handle buffer_handle,
+                                        Dart_Handle asset_name_handle,
+                                        size_t offset,
+                                        std::optional<size_t> length,
+                                        Dart_Handle callback_handle);
+
   DEFINE_WRAPPERTYPEINFO();
   FML_FRIEND_MAKE_REF_COUNTED(ImmutableBuffer);
   FML_DISALLOW_COPY_AND_ASSIGN(ImmutableBuffer);
@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/display_list_image_gpu.h"
 #include "flutter/lib/ui/painting/image.h"
 #if IMPELLER_SUPPORTS_RENDERING
@@ -34,6 +35,10 @@ MultiFrameCodec::State::State(std::shared_ptr<ImageGenerator> generator)
                            ? -1
                            : generator_->GetPlayCount() - 1),
       is_impeller_enabled_(UIDartState::Current()->IsImpellerEnabled()),
+      decodeAheadFrames_(
+          UIDartState::Current()->GetAnimatedImageDecodeAheadFrames()),
+      concurrent_task_runner_(
+          UIDartState::Current()->GetConcurrentTaskRunner()),
       nextFrameIndex_(0) {}
 
 static void InvokeNextFrameCallback(
@@ -54,29 +59,40 @@ static void InvokeNextFrameCallback(
                      tonic::ToDart(decode_error)});
 }
 
-std::pair<sk_sp<DlImage>, std::string>
-MultiFrameCodec::State::GetNextFrameImage(
-    fml::WeakPtr<GrDirectContext> resourceContext,
-    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
-    const std::shared_ptr<impeller::Context>& impeller_context,
-    fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue) {
-  SkBitmap bitmap = SkBitmap();
+MultiFrameCodec::State::DecodedFrame
+MultiFrameCodec::State::DecodeNextFrame() {
+  TRACE_EVENT0("flutter", "MultiFrameCodec::State::DecodeNextFrame");
+  const int frameIndex = decodeFrameIndex_;
+  decodeFrameIndex_ = (decodeFrameIndex_ + 1) % frameCount_;
+
+  DecodedFrame frame;
   SkImageInfo info = generator_->GetInfo().makeColorType(kN32_SkColorType);
   if (info.alphaType() == kUnpremul_SkAlphaType) {
     SkImageInfo updated = info.makeAlphaType(kPremul_SkAlphaType);
     info = updated;
   }
-  if (!bitmap.tryAllocPixels(info)) {
+  // Reuse the pixels of a frame that has already been uploaded if nothing,
+  // such as |lastRequiredFrame_| or a texture that hasn't finished uploading,
+  // still references them.
+  SkBitmap& bitmap = frame.bitmap;
+  for (auto it = recycledBitmaps_.begin(); it != recycledBitmaps_.end(); ++it) {
+    if (it->pixelRef()->unique()) {
+      bitmap = std::move(*it);
+      recycledBitmaps_.erase(it);
+      break;
+    }
+  }
+  if (bitmap.drawsNothing() && !bitmap.tryAllocPixels(info)) {
     std::ostringstream ostr;
     ostr << "Failed to allocate memory for bitmap of size "
          << info.computeMinByteSize() << "B";
-    std::string decode_error = ostr.str();
-    FML_LOG(ERROR) << decode_error;
-    return std::make_pair(nullptr, decode_error);
+    frame.decode_error = ostr.str();
+    FML_LOG(ERROR) << frame.decode_error;
+    return frame;
   }
 
-  ImageGenerator::FrameInfo frameInfo =
-      generator_->GetFrameInfo(nextFrameIndex_);
+  ImageGenerator::FrameInfo frameInfo = generator_->GetFrameInfo(frameIndex);
+  frame.duration = frameInfo.duration;
 
   const int requiredFrameIndex =
       frameInfo.required_frame.value_or(SkCodec::kNoFrame);
@@ -87,7 +103,7 @@ MultiFrameCodec::State::GetNextFrameImage(
     // |requiredFrameIndex| is set to ex-frame or ex-ex-frame.
     if (!lastRequiredFrame_.has_value()) {
       FML_DLOG(INFO)
-          << "Frame " << nextFrameIndex_ << " depends on frame "
+          << "Frame " << frameIndex << " depends on frame "
           << requiredFrameIndex
           << " and no required frames are cached. Using blank slate instead.";
     } else {
@@ -103,12 +119,12 @@ MultiFrameCodec::State::GetNextFrameImage(
   // Write the new frame to the output buffer. The bitmap pixels as supplied
   // are already set in accordance with the previous frame's disposal policy.
   if (!generator_->GetPixels(info, bitmap.getPixels(), bitmap.rowBytes(),
-                             nextFrameIndex_, requiredFrameIndex)) {
+                             frameIndex, requiredFrameIndex)) {
     std::ostringstream ostr;
-    ostr << "Could not getPixels for frame " << nextFrameIndex_;
-    std::string decode_error = ostr.str();
-    FML_LOG(ERROR) << decode_error;
-    return std::make_pair(nullptr, decode_error);
+    ostr << "Could not getPixels for frame " << frameIndex;
+    frame.decode_error = ostr.str();
+    FML_LOG(ERROR) << frame.decode_error;
+    return frame;
   }
 
   const bool keep_current_frame =
@@ -133,7 +149,7 @@ MultiFrameCodec::State::GetNextFrameImage(
     // Replace the stored frame. The `lastRequiredFrame_` will get used as the
     // starting backdrop for the next frame.
     lastRequiredFrame_ = bitmap;
-    lastRequiredFrameIndex_ = nextFrameIndex_;
+    lastRequiredFrameIndex_ = frameIndex;
   }
 
   if (frameInfo.disposal_method ==
@@ -143,6 +159,79 @@ MultiFrameCodec::State::GetNextFrameImage(
     restoreBGColorRect_.reset();
   }
 
+  return frame;
+}
+
+MultiFrameCodec::State::DecodedFrame MultiFrameCodec::State::TakeNextFrame() {
+  {
+    std::scoped_lock lock(pendingFramesMutex_);
+    if (!pendingFrames_.empty()) {
+      auto frame = std::move(pendingFrames_.front());
+      pendingFrames_.pop_front();
+      return frame;
+    }
+  }
+  std::scoped_lock decode_lock(decodeMutex_);
+  {
+    // The frame may have been decoded ahead while waiting for the lock.
+    std::scoped_lock lock(pendingFramesMutex_);
+    if (!pendingFrames_.empty()) {
+      auto frame = std::move(pendingFrames_.front());
+      pendingFrames_.pop_front();
+      return frame;
+    }
+  }
+  return DecodeNextFrame();
+}
+
+void MultiFrameCodec::State::ScheduleDecodeAhead() {
+  if (decodeAheadFrames_ == 0u || !concurrent_task_runner_ ||
+      frameCount_ < 2) {
+    return;
+  }
+  {
+    std::scoped_lock lock(pendingFramesMutex_);
+    if (isDecodingAhead_ || pendingFrames_.size() >= decodeAheadFrames_) {
+      return;
+    }
+    isDecodingAhead_ = true;
+  }
+  // Decoding ahead is speculative and yields to other work on the workers.
+  concurrent_task_runner_->PostTask(
+      [weak_state = weak_from_this()]() {
+        if (auto state = weak_state.lock()) {
+          state->DecodeAhead();
+        }
+      },
+      fml::ConcurrentTaskPriority::kLow);
+}
+
+void MultiFrameCodec::State::DecodeAhead() {
+  TRACE_EVENT0("flutter", "MultiFrameCodec::State::DecodeAhead");
+  while (true) {
+    // The decode lock is released after each frame so that a frame Dart is
+    // waiting for can be taken without waiting for the frames after it.
+    std::scoped_lock decode_lock(decodeMutex_);
+    {
+      std::scoped_lock lock(pendingFramesMutex_);
+      if (pendingFrames_.size() >= decodeAheadFrames_) {
+        isDecodingAhead_ = false;
+        return;
+      }
+    }
+    auto frame = DecodeNextFrame();
+    std::scoped_lock lock(pendingFramesMutex_);
+    pendingFrames_.push_back(std::move(frame));
+  }
+}
+
+std::pair<sk_sp<DlImage>, std::string>
+MultiFrameCodec::State::UploadFrameImage(
+    const SkBitmap& bitmap,
+    fml::WeakPtr<GrDirectContext> resourceContext,
+    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
+    const std::shared_ptr<impeller::Context>& impeller_context,
+    fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue) {
 #if IMPELLER_SUPPORTS_RENDERING
   if (is_impeller_enabled_) {
     // This is safe regardless of whether the GPU is available or not because
@@ -193,16 +282,26 @@ void MultiFrameCodec::State::GetNextFrameAndInvokeCallback(
   fml::RefPtr<CanvasImage> image = nullptr;
   int duration = 0;
   sk_sp<DlImage> dlImage;
-  std::string decode_error;
-  std::tie(dlImage, decode_error) =
-      GetNextFrameImage(std::move(resourceContext), gpu_disable_sync_switch,
-                        impeller_context, std::move(unref_queue));
+  auto frame = TakeNextFrame();
+  // Start decoding the frames after this one while it is uploaded.
+  ScheduleDecodeAhead();
+  std::string decode_error = std::move(frame.decode_error);
+  if (decode_error.empty()) {
+    std::tie(dlImage, decode_error) =
+        UploadFrameImage(frame.bitmap, std::move(resourceContext),
+                         gpu_disable_sync_switch, impeller_context,
+                         std::move(unref_queue));
+  }
   if (dlImage) {
     image = CanvasImage::Create();
     image->set_image(dlImage);
-    ImageGenerator::FrameInfo frameInfo =
-        generator_->GetFrameInfo(nextFrameIndex_);
-    duration = frameInfo.duration;
+    duration = frame.duration;
+  }
+  if (decodeAheadFrames_ > 0u && !frame.bitmap.drawsNothing()) {
+    std::scoped_lock decode_lock(decodeMutex_);
+    if (recycledBitmaps_.size() < decodeAheadFrames_) {
+      recycledBitmaps_.push_back(std::move(frame.bitmap));
+    }
   }
   nextFrameIndex_ = (nextFrameIndex_ + 1) % frameCount_;
 
@@ -9,7 +9,10 @@
 #include "flutter/lib/ui/painting/codec.h"
 #include "flutter/lib/ui/painting/image_generator.h"
 
+#include <deque>
+#include <mutex>
 #include <utility>
+#include <vector>
 
 using tonic::DartPersistentValue;
 
@@ -34,24 +37,43 @@ class MultiFrameCodec : public Codec {
   // Captures the state shared between the IO and UI task runners.
   //
   // The state is initialized on the UI task runner when the Dart object is
-  // created. Decoding occurs on the IO task runner. Since it is possible for
-  // the UI object to be collected independently of the IO task runner work,
-  // it is not safe for this state to live directly on the MultiFrameCodec.
-  // Instead, the MultiFrameCodec creates this object when it is constructed,
-  // shares it with the IO task runner's decoding work, and sets the live_
-  // member to false when it is destructed.
-  struct State {
+  // created. Decoding occurs on the IO task runner, or ahead of time on the
+  // concurrent task runner. Since it is possible for the UI object to be
+  // collected independently of the IO task runner work, it is not safe for
+  // this state to live directly on the MultiFrameCodec. Instead, the
+  // MultiFrameCodec creates this object when it is constructed, shares it with
+  // the IO task runner's decoding work, and sets the live_ member to false when
+  // it is destructed.
+  struct State : public std::enable_shared_from_this<State> {
     explicit State(std::shared_ptr<ImageGenerator> generator);
 
     const std::shared_ptr<ImageGenerator> generator_;
     const int frameCount_;
     const int repetitionCount_;
     bool is_impeller_enabled_ = false;
+    // The number of frames to decode on the concurrent task runner ahead of
+    // the frames Dart asks for.
+    const size_t decodeAheadFrames_;
+    const std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner_;
 
     // The non-const members and functions below here are only read or written
-    // to on the IO thread. They are not safe to access or write on the UI
-    // thread.
+    // to on the IO thread, or with the mutexes guarding them held. They are
+    // not safe to access or write on the UI thread.
     int nextFrameIndex_;
+
+    // A frame whose pixels have been decoded but that hasn't been uploaded.
+    struct DecodedFrame {
+      SkBitmap bitmap;
+      int duration = 0;
+      std::string decode_error;
+    };
+
+    // Held while decoding a frame, which may happen on the IO thread or on
+    // the concurrent task runner. Guards the generator and the members below
+    // up to |pendingFramesMutex_|.
+    std::mutex decodeMutex_;
+    // The index of the next frame to decode.
+    int decodeFrameIndex_ = 0;
     // The last decoded frame that's required to decode any subsequent frames.
     std::optional<SkBitmap> lastRequiredFrame_;
     // The index of the last decoded required frame.
@@ -61,7 +83,32 @@ class MultiFrameCodec : public Codec {
     // method was kRestoreBGColor.
     std::optional<SkIRect> restoreBGColorRect_;
 
-    std::pair<sk_sp<DlImage>, std::string> GetNextFrameImage(
+    // The bitmaps of frames that have been uploaded, which are decoded into
+    // again once nothing else references their pixels.
+    std::vector<SkBitmap> recycledBitmaps_;
+
+    // Guards the members below.
+    std::mutex pendingFramesMutex_;
+    // The frames that have been decoded ahead of time, starting with the frame
+    // at |nextFrameIndex_|.
+    std::deque<DecodedFrame> pendingFrames_;
+    bool isDecodingAhead_ = false;
+
+    // Decode the frame at |decodeFrameIndex_|. |decodeMutex_| must be held.
+    DecodedFrame DecodeNextFrame();
+
+    // Take the frame at |nextFrameIndex_|, decoding it if it hasn't been
+    // decoded ahead of time.
+    DecodedFrame TakeNextFrame();
+
+    // Decode frames on the concurrent task runner until |decodeAheadFrames_|
+    // of them are pending.
+    void ScheduleDecodeAhead();
+
+    void DecodeAhead();
+
+    std::pair<sk_sp<DlImage>, std::string> UploadFrameImage(
+        const SkBitmap& bitmap,
         fml::WeakPtr<GrDirectContext> resourceContext,
         const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
         const std::shared_ptr<impeller::Context>& impeller_context,
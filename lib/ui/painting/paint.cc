@@ -35,7 +35,8 @@ constexpr int kMaskFilterBlurStyleIndex = 10;
 constexpr int kMaskFilterSigmaIndex = 11;
 constexpr int kInvertColorIndex = 12;
 constexpr int kDitherIndex = 13;
-constexpr size_t kDataByteCount = 56;  // 4 * (last index + 1)
+constexpr size_t kDataByteCount = 4 * Paint::kDataWordCount;
+static_assert(Paint::kDataWordCount == kDitherIndex + 1);
 
 // Indices for objects.
 constexpr int kShaderIndex = 0;
@@ -57,6 +58,21 @@ constexpr float kStrokeMiterLimitDefault = 4.0f;
 // Must be kept in sync with the MaskFilter private constants in painting.dart.
 enum MaskFilterType { kNull, kBlur };
 
+// Clears the objects of |paint| that apply to operations with the given
+// |flags|, for a Paint without objects.
+static void ClearObjects(DlPaint& paint,
+                         const DisplayListAttributeFlags& flags) {
+  if (flags.applies_shader()) {
+    paint.setColorSource(nullptr);
+  }
+  if (flags.applies_color_filter()) {
+    paint.setColorFilter(nullptr);
+  }
+  if (flags.applies_image_filter()) {
+    paint.setImageFilter(nullptr);
+  }
+}
+
 Paint::Paint(Dart_Handle paint_objects, Dart_Handle paint_data)
     : paint_objects_(paint_objects), paint_data_(paint_data) {}
 
@@ -69,19 +85,10 @@ const DlPaint* Paint::paint(DlPaint& paint,
   FML_CHECK(byte_data.length_in_bytes() == kDataByteCount);
 
   const uint32_t* uint_data = static_cast<const uint32_t*>(byte_data.data());
-  const float* float_data = static_cast<const float*>(byte_data.data());
 
   Dart_Handle values[kObjectCount];
   if (Dart_IsNull(paint_objects_)) {
-    if (flags.applies_shader()) {
-      paint.setColorSource(nullptr);
-    }
-    if (flags.applies_color_filter()) {
-      paint.setColorFilter(nullptr);
-    }
-    if (flags.applies_image_filter()) {
-      paint.setImageFilter(nullptr);
-    }
+    ClearObjects(paint, flags);
   } else {
     FML_DCHECK(Dart_IsList(paint_objects_));
     intptr_t length = 0;
@@ -131,23 +138,40 @@ const DlPaint* Paint::paint(DlPaint& paint,
     }
   }
 
+  applyData(paint, uint_data, flags);
+
+  return &paint;
+}
+
+void Paint::paintWithoutObjects(DlPaint& paint,
+                                const uint32_t* data,
+                                const DisplayListAttributeFlags& flags) {
+  ClearObjects(paint, flags);
+  applyData(paint, data, flags);
+}
+
+void Paint::applyData(DlPaint& paint,
+                      const uint32_t* data,
+                      const DisplayListAttributeFlags& flags) {
+  const float* float_data = reinterpret_cast<const float*>(data);
+
   if (flags.applies_anti_alias()) {
-    paint.setAntiAlias(uint_data[kIsAntiAliasIndex] == 0);
+    paint.setAntiAlias(data[kIsAntiAliasIndex] == 0);
   }
 
   if (flags.applies_alpha_or_color()) {
-    uint32_t encoded_color = uint_data[kColorIndex];
+    uint32_t encoded_color = data[kColorIndex];
     paint.setColor(encoded_color ^ kColorDefault);
   }
 
   if (flags.applies_blend()) {
-    uint32_t encoded_blend_mode = uint_data[kBlendModeIndex];
+    uint32_t encoded_blend_mode = data[kBlendModeIndex];
     uint32_t blend_mode = encoded_blend_mode ^ kBlendModeDefault;
     paint.setBlendMode(static_cast<DlBlendMode>(blend_mode));
   }
 
   if (flags.applies_style()) {
-    uint32_t style = uint_data[kStyleIndex];
+    uint32_t style = data[kStyleIndex];
     paint.setDrawStyle(static_cast<DlDrawStyle>(style));
   }
 
@@ -158,19 +182,19 @@ const DlPaint* Paint::paint(DlPaint& paint,
     float stroke_miter_limit = float_data[kStrokeMiterLimitIndex];
     paint.setStrokeMiter(stroke_miter_limit + kStrokeMiterLimitDefault);
 
-    uint32_t stroke_cap = uint_data[kStrokeCapIndex];
+    uint32_t stroke_cap = data[kStrokeCapIndex];
     paint.setStrokeCap(static_cast<DlStrokeCap>(stroke_cap));
 
-    uint32_t stroke_join = uint_data[kStrokeJoinIndex];
+    uint32_t stroke_join = data[kStrokeJoinIndex];
     paint.setStrokeJoin(static_cast<DlStrokeJoin>(stroke_join));
   }
 
   if (flags.applies_color_filter()) {
-    paint.setInvertColors(uint_data[kInvertColorIndex] != 0);
+    paint.setInvertColors(data[kInvertColorIndex] != 0);
   }
 
   if (flags.applies_dither()) {
-    paint.setDither(uint_data[kDitherIndex] != 0);
+    paint.setDither(data[kDitherIndex] != 0);
   }
 
   if (flags.applies_path_effect()) {
@@ -180,21 +204,19 @@ const DlPaint* Paint::paint(DlPaint& paint,
   }
 
   if (flags.applies_mask_filter()) {
-    switch (uint_data[kMaskFilterIndex]) {
+    switch (data[kMaskFilterIndex]) {
       case kNull:
         paint.setMaskFilter(nullptr);
         break;
       case kBlur:
         DlBlurStyle blur_style =
-            static_cast<DlBlurStyle>(uint_data[kMaskFilterBlurStyleIndex]);
+            static_cast<DlBlurStyle>(data[kMaskFilterBlurStyleIndex]);
         double sigma = float_data[kMaskFilterSigmaIndex];
         paint.setMaskFilter(
             DlBlurMaskFilter::Make(blur_style, SafeNarrow(sigma)));
         break;
     }
   }
-
-  return &paint;
 }
 
 void Paint::toDlPaint(DlPaint& paint) const {
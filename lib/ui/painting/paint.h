@@ -14,12 +14,23 @@ namespace flutter {
 
 class Paint {
  public:
+  // The number of 32 bit values in the data of a Paint.
+  static constexpr size_t kDataWordCount = 14;
+
   Paint() = default;
   Paint(Dart_Handle paint_objects, Dart_Handle paint_data);
 
   const DlPaint* paint(DlPaint& paint,
                        const DisplayListAttributeFlags& flags) const;
 
+  // Decodes the data of a Paint that has no objects, as laid out in the
+  // ByteData of the Dart Paint, into the attributes of |paint| that apply to
+  // operations with the given |flags|. Unlike |paint|, this doesn't need to
+  // call into the VM.
+  static void paintWithoutObjects(DlPaint& paint,
+                                  const uint32_t* data,
+                                  const DisplayListAttributeFlags& flags);
+
   void toDlPaint(DlPaint& paint) const;
 
   bool isNull() const { return Dart_IsNull(paint_data_); }
@@ -28,6 +39,10 @@ class Paint {
  private:
   friend struct tonic::DartConverter<Paint>;
 
+  static void applyData(DlPaint& paint,
+                        const uint32_t* data,
+                        const DisplayListAttributeFlags& flags);
+
   Dart_Handle paint_objects_;
   Dart_Handle paint_data_;
 };
@@ -10,6 +10,7 @@
 #include "flutter/fml/make_copyable.h"
 #include "flutter/lib/ui/painting/canvas.h"
 #include "flutter/lib/ui/painting/display_list_deferred_image_gpu_skia.h"
+#include "flutter/lib/ui/painting/transfer_registry.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #if IMPELLER_SUPPORTS_RENDERING
 #include "flutter/lib/ui/painting/display_list_deferred_image_gpu_impeller.h"
@@ -114,6 +115,24 @@ size_t Picture::GetAllocationSize() const {
   }
 }
 
+int64_t Picture::transfer() {
+  return TransferRegistry<DisplayList>::Add(display_list_);
+}
+
+bool Picture::initTransferred(Dart_Handle raw_picture_handle, int64_t token) {
+  UIDartState::ThrowIfUIOperationsProhibited();
+  auto display_list = TransferRegistry<DisplayList>::Take(token);
+  if (!display_list) {
+    return false;
+  }
+  Picture::Create(raw_picture_handle, std::move(display_list));
+  return true;
+}
+
+void Picture::disposeTransferred(int64_t token) {
+  TransferRegistry<DisplayList>::Take(token);
+}
+
 Dart_Handle Picture::RasterizeToImage(const sk_sp<DisplayList>& display_list,
                                       uint32_t width,
                                       uint32_t height,
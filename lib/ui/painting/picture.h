@@ -37,6 +37,16 @@ class Picture : public RefCountedDartWrappable<Picture> {
 
   size_t GetAllocationSize() const;
 
+  // Adds the display list to the registry of transferable pictures and
+  // returns its token, or zero if the picture was disposed.
+  int64_t transfer();
+
+  // Creates the picture of a token returned by |transfer| in the isolate
+  // group of the current isolate. The token can't be used again.
+  static bool initTransferred(Dart_Handle raw_picture_handle, int64_t token);
+
+  static void disposeTransferred(int64_t token);
+
   static void RasterizeToImageSync(sk_sp<DisplayList> display_list,
                                    uint32_t width,
                                    uint32_t height,
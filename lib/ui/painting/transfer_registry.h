@@ -0,0 +1,92 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_TRANSFER_REGISTRY_H_
+#define FLUTTER_LIB_UI_PAINTING_TRANSFER_REGISTRY_H_
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+
+#include "flutter/fml/macros.h"
+#include "third_party/dart/runtime/include/dart_api.h"
+#include "third_party/skia/include/core/SkRefCnt.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Holds the objects behind the transferable image and picture
+///             handles of `dart:ui` while they are sent between isolates.
+///
+///             Native objects can't be sent between isolates, so the Dart
+///             handles only carry a token. The object stays here, with a
+///             reference of its own, until an isolate of the same isolate
+///             group takes it back with the token. Objects are shared rather
+///             than copied, so their types must be safe to reference from
+///             any thread, like `DlImage` and `DisplayList`.
+///
+///             All methods may be called on any thread.
+///
+template <class T>
+class TransferRegistry {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Keeps a reference to the object for the isolate group of the
+  ///             current isolate.
+  ///
+  /// @return     The token to take the object back with, or zero if there is
+  ///             no object.
+  ///
+  static int64_t Add(sk_sp<T> object) {
+    if (!object) {
+      return 0;
+    }
+    TransferRegistry& registry = GetInstance();
+    std::scoped_lock lock(registry.mutex_);
+    int64_t token = ++registry.last_token_;
+    registry.entries_[token] = {Dart_CurrentIsolateGroup(), std::move(object)};
+    return token;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Removes the object of the token and returns it, if it was
+  ///             added in the isolate group of the current isolate. Every
+  ///             token can only be taken once.
+  ///
+  static sk_sp<T> Take(int64_t token) {
+    TransferRegistry& registry = GetInstance();
+    std::scoped_lock lock(registry.mutex_);
+    auto found = registry.entries_.find(token);
+    if (found == registry.entries_.end() ||
+        found->second.isolate_group != Dart_CurrentIsolateGroup()) {
+      return nullptr;
+    }
+    sk_sp<T> object = std::move(found->second.object);
+    registry.entries_.erase(found);
+    return object;
+  }
+
+ private:
+  struct Entry {
+    Dart_IsolateGroup isolate_group = nullptr;
+    sk_sp<T> object;
+  };
+
+  std::mutex mutex_;
+  int64_t last_token_ = 0;
+  std::map<int64_t, Entry> entries_;
+
+  TransferRegistry() = default;
+
+  static TransferRegistry& GetInstance() {
+    static TransferRegistry registry;
+    return registry;
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TransferRegistry);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_TRANSFER_REGISTRY_H_
@@ -23,6 +23,13 @@ typedef FrameCallback = void Function(Duration duration);
 /// {@endtemplate}
 typedef TimingsCallback = void Function(List<FrameTiming> timings);
 
+/// Signature for [PlatformDispatcher.scheduleIdleTask].
+///
+/// The `timeRemaining` is the time left in the idle period when the callback
+/// is invoked. Callbacks should return before it elapses, scheduling another
+/// idle task for the rest of their work if needed.
+typedef IdleTaskCallback = void Function(Duration timeRemaining);
+
 /// Signature for [PlatformDispatcher.onPointerDataPacket].
 typedef PointerDataPacketCallback = void Function(PointerDataPacket packet);
 
@@ -550,6 +557,71 @@ class PlatformDispatcher {
     _invoke1(onReportTimings, _onReportTimingsZone, frameTimings);
   }
 
+  /// The current values of the counters of the engine, by name.
+  ///
+  /// The engine counts events such as rasterized frames, draw calls, raster
+  /// cache hits and graphics memory allocations for the lifetime of the
+  /// process. The counters only grow, so the activity over a period of time,
+  /// such as a frame reported to [onReportTimings], is the difference between
+  /// the values read at its start and at its end.
+  ///
+  /// Like [onReportTimings], the counters are available in all build modes,
+  /// and updating them costs a single atomic addition. Reading them doesn't
+  /// wait for other threads. The names of the counters are not part of the
+  /// API and may change between engine versions.
+  Map<String, int> get engineCounters {
+    final List<Object?> counters = _getEngineCounters();
+    return <String, int>{
+      for (int i = 0; i < counters.length; i += 2)
+        counters[i]! as String: counters[i + 1]! as int,
+    };
+  }
+
+  @Native<Handle Function()>(symbol: 'PlatformConfigurationNativeApi::GetEngineCounters')
+  external static List<Object?> _getEngineCounters();
+
+  /// Schedules [callback] to run in an idle period of the UI thread.
+  ///
+  /// The engine reports idle periods between frames, once the frame has been
+  /// built and before the next one needs to start. Idle tasks run in the order
+  /// they were scheduled, as long as at least a millisecond of the period
+  /// remains. Tasks scheduled by an idle task run in a later idle period.
+  /// Idle periods are only reported while frames are being produced.
+  ///
+  /// This is suited to work that isn't needed by the next frame, such as
+  /// warming caches or bookkeeping, that would otherwise lengthen frames.
+  ///
+  /// The [callback] is invoked in the zone in which this method was called.
+  void scheduleIdleTask(IdleTaskCallback callback) {
+    _idleTasks.add(Zone.current.bindUnaryCallbackGuarded<Duration>(callback));
+    if (_idleTasks.length == 1) {
+      _setNeedsIdleTasks(true);
+    }
+  }
+
+  final collection.Queue<void Function(Duration)> _idleTasks =
+      collection.Queue<void Function(Duration)>();
+
+  @Native<Void Function(Bool)>(symbol: 'PlatformConfigurationNativeApi::SetNeedsIdleTasks')
+  external static void _setNeedsIdleTasks(bool value);
+
+  // Called from the engine, via hooks.dart
+  void _runIdleTasks(int deadlineMicroseconds) {
+    int remaining = _idleTasks.length;
+    while (remaining > 0) {
+      final Duration timeRemaining = Duration(
+          microseconds: deadlineMicroseconds - developer.Timeline.now);
+      if (timeRemaining < const Duration(milliseconds: 1)) {
+        break;
+      }
+      remaining--;
+      _idleTasks.removeFirst()(timeRemaining);
+    }
+    if (_idleTasks.isEmpty) {
+      _setNeedsIdleTasks(false);
+    }
+  }
+
   /// Sends a message to a platform-specific plugin.
   ///
   /// The `name` parameter determines which plugin receives the message. The
@@ -601,7 +673,8 @@ class PlatformDispatcher {
 
   /// Registers the current isolate with the isolate identified with by the
   /// [token]. This is required if platform channels are to be used on a
-  /// background isolate.
+  /// background isolate, and for building and laying out [Paragraph]s on a
+  /// background isolate with the fonts of the root isolate.
   void registerBackgroundIsolate(RootIsolateToken token) {
     DartPluginRegistrant.ensureInitialized();
     __registerBackgroundIsolate(token._token);
@@ -719,6 +792,25 @@ class PlatformDispatcher {
   @Native<Int Function(Int)>(symbol: 'PlatformConfigurationNativeApi::RequestDartPerformanceMode')
   external static int _requestDartPerformanceMode(int mode);
 
+  /// Hints the rate, in frames per second, at which the application currently
+  /// needs to produce frames.
+  ///
+  /// On displays with a variable refresh rate, the engine uses this to run the
+  /// display at a lower rate when the content does not need to update often,
+  /// which saves power, and at up to the maximum rate while animating. Passing
+  /// zero removes the hint, letting the engine use the maximum rate of the
+  /// display.
+  ///
+  /// The hint is ignored on platforms that do not support variable refresh
+  /// rates. It is currently only used on iOS.
+  void setPreferredFrameRate(double framesPerSecond) {
+    assert(framesPerSecond >= 0.0);
+    _setPreferredFrameRate(framesPerSecond);
+  }
+
+  @Native<Void Function(Double)>(symbol: 'PlatformConfigurationNativeApi::SetPreferredFrameRate')
+  external static void _setPreferredFrameRate(double framesPerSecond);
+
   /// The embedder can specify data that the isolate can request synchronously
   /// on launch. This accessor fetches that data.
   ///
@@ -1574,6 +1666,9 @@ enum _FrameTimingInfo {
   /// The number of bytes used to cache pictures during the frame.
   pictureCacheBytes,
 
+  /// The time in microseconds the GPU spent on the frame, or zero.
+  gpuDuration,
+
   /// The frame number of the frame.
   frameNumber,
 }
@@ -1597,7 +1692,8 @@ class FrameTiming {
   /// This constructor is used for unit test only. Real [FrameTiming]s should
   /// be retrieved from [PlatformDispatcher.onReportTimings].
   ///
-  /// If the [frameNumber] is not provided, it defaults to `-1`.
+  /// If the [frameNumber] is not provided, it defaults to `-1`. The
+  /// [gpuDuration] is in microseconds.
   factory FrameTiming({
     required int vsyncStart,
     required int buildStart,
@@ -1609,6 +1705,7 @@ class FrameTiming {
     int layerCacheBytes = 0,
     int pictureCacheCount = 0,
     int pictureCacheBytes = 0,
+    int gpuDuration = 0,
     int frameNumber = -1,
   }) {
     return FrameTiming._(<int>[
@@ -1622,6 +1719,7 @@ class FrameTiming {
       layerCacheBytes,
       pictureCacheCount,
       pictureCacheBytes,
+      gpuDuration,
       frameNumber,
     ]);
   }
@@ -1712,6 +1810,16 @@ class FrameTiming {
   /// See also [layerCacheCount], [layerCacheBytes], [pictureCacheCount] and [pictureCacheBytes].
   double get pictureCacheMegabytes => pictureCacheBytes / 1024.0 / 1024.0;
 
+  /// The duration the GPU spent executing the work of the frame.
+  ///
+  /// This is measured by the Impeller Metal and Vulkan backends, and is
+  /// [Duration.zero] with other backends. The GPU time of a frame is measured
+  /// after the frame is rasterized, so it is also [Duration.zero] if the
+  /// timings of the frame were reported before the GPU completed the frame.
+  ///
+  /// See also [rasterDuration], the time the raster thread spent on the frame.
+  Duration get gpuDuration => Duration(microseconds: _rawInfo(_FrameTimingInfo.gpuDuration));
+
   /// The frame key associated with this frame measurement.
   int get frameNumber => _data.last;
 
@@ -115,7 +115,7 @@ void SemanticsUpdateBuilder::updateNode(
   node.customAccessibilityActions = std::vector<int32_t>(
       localContextActions.data(),
       localContextActions.data() + localContextActions.num_elements());
-  nodes_[id] = node;
+  nodes_[id] = std::move(node);
 }
 
 void SemanticsUpdateBuilder::updateCustomAction(int id,
@@ -127,7 +127,7 @@ void SemanticsUpdateBuilder::updateCustomAction(int id,
   action.overrideId = overrideId;
   action.label = std::move(label);
   action.hint = std::move(hint);
-  actions_[id] = action;
+  actions_[id] = std::move(action);
 }
 
 void SemanticsUpdateBuilder::build(Dart_Handle semantics_update_handle) {
@@ -2947,6 +2947,23 @@ abstract class Paragraph {
   /// See [BoxHeightStyle] and [BoxWidthStyle] for full descriptions of each option.
   List<TextBox> getBoxesForRange(int start, int end, {BoxHeightStyle boxHeightStyle = BoxHeightStyle.tight, BoxWidthStyle boxWidthStyle = BoxWidthStyle.tight});
 
+  /// Writes the text boxes that enclose several text ranges into [boxes], and
+  /// returns the number of values the boxes take up.
+  ///
+  /// The [ranges] list holds the start and the end of each range. For each
+  /// range, [boxes] receives the number of boxes that enclose it, followed by
+  /// the left, top, right and bottom of each box and the [TextDirection.index]
+  /// of its direction. The boxes are the ones [getBoxesForRange] returns.
+  ///
+  /// Values that don't fit into [boxes] are not written. When the returned
+  /// number is larger than the length of [boxes], call this again with a
+  /// larger list.
+  ///
+  /// Unlike calling [getBoxesForRange] for each range, this makes a single
+  /// call into the engine and doesn't allocate, which suits selection and
+  /// text editing UIs that query many ranges every frame.
+  int getBoxesForRanges(Int32List ranges, Float32List boxes, {BoxHeightStyle boxHeightStyle = BoxHeightStyle.tight, BoxWidthStyle boxWidthStyle = BoxWidthStyle.tight});
+
   /// Returns a list of text boxes that enclose all placeholders in the paragraph.
   ///
   /// The order of the boxes are in the same order as passed in through
@@ -2959,6 +2976,14 @@ abstract class Paragraph {
   /// Returns the text position closest to the given offset.
   TextPosition getPositionForOffset(Offset offset);
 
+  /// Writes the text positions closest to several offsets into [positions].
+  ///
+  /// The [offsets] list holds the x and the y coordinate of each offset. For
+  /// each offset, [positions] receives the [TextPosition.offset] and the
+  /// [TextAffinity.index] of the position [getPositionForOffset] returns for
+  /// it. The [positions] list must be at least as long as [offsets].
+  void getPositionsForOffsets(Float32List offsets, Int32List positions);
+
   /// Returns the [TextRange] of the word at the given [TextPosition].
   ///
   /// Characters not part of a word, such as spaces, symbols, and punctuation,
@@ -2992,6 +3017,18 @@ abstract class Paragraph {
   /// to repeatedly call this. Instead, cache the results.
   List<LineMetrics> computeLineMetrics();
 
+  /// Writes the metrics of each laid out line into [metrics], and returns the
+  /// number of lines.
+  ///
+  /// For each line, [metrics] receives 9 values: [LineMetrics.hardBreak] as 1
+  /// or 0, followed by [LineMetrics.ascent], [LineMetrics.descent],
+  /// [LineMetrics.unscaledAscent], [LineMetrics.height], [LineMetrics.width],
+  /// [LineMetrics.left], [LineMetrics.baseline] and [LineMetrics.lineNumber].
+  /// Lines that don't fit into [metrics] are counted but not written.
+  ///
+  /// Not valid until after layout.
+  int computeLineMetricsInto(Float64List metrics);
+
   /// Release the resources used by this object. The object is no longer usable
   /// after this method is called.
   void dispose();
@@ -3080,6 +3117,15 @@ base class _NativeParagraph extends NativeFieldWrapperClass1 implements Paragrap
   @Native<Handle Function(Pointer<Void>, Uint32, Uint32, Uint32, Uint32)>(symbol: 'Paragraph::getRectsForRange')
   external Float32List _getBoxesForRange(int start, int end, int boxHeightStyle, int boxWidthStyle);
 
+  @override
+  int getBoxesForRanges(Int32List ranges, Float32List boxes, {BoxHeightStyle boxHeightStyle = BoxHeightStyle.tight, BoxWidthStyle boxWidthStyle = BoxWidthStyle.tight}) {
+    return _getBoxesForRanges(ranges, boxHeightStyle.index, boxWidthStyle.index, boxes);
+  }
+
+  // See paragraph.cc for the layout of the boxes.
+  @Native<Int32 Function(Pointer<Void>, Handle, Uint32, Uint32, Handle)>(symbol: 'Paragraph::getRectsForRanges')
+  external int _getBoxesForRanges(Int32List ranges, int boxHeightStyle, int boxWidthStyle, Float32List boxes);
+
   @override
   List<TextBox> getBoxesForPlaceholders() {
     return _decodeTextBoxes(_getBoxesForPlaceholders());
@@ -3097,6 +3143,15 @@ base class _NativeParagraph extends NativeFieldWrapperClass1 implements Paragrap
   @Native<Handle Function(Pointer<Void>, Double, Double)>(symbol: 'Paragraph::getPositionForOffset')
   external List<int> _getPositionForOffset(double dx, double dy);
 
+  @override
+  void getPositionsForOffsets(Float32List offsets, Int32List positions) {
+    assert(positions.length >= offsets.length);
+    _getPositionsForOffsets(offsets, positions);
+  }
+
+  @Native<Void Function(Pointer<Void>, Handle, Handle)>(symbol: 'Paragraph::getPositionsForOffsets')
+  external void _getPositionsForOffsets(Float32List offsets, Int32List positions);
+
   @override
   TextRange getWordBoundary(TextPosition position) {
     final int characterPosition;
@@ -3169,6 +3224,12 @@ base class _NativeParagraph extends NativeFieldWrapperClass1 implements Paragrap
   @Native<Handle Function(Pointer<Void>)>(symbol: 'Paragraph::computeLineMetrics')
   external Float64List _computeLineMetrics();
 
+  @override
+  int computeLineMetricsInto(Float64List metrics) => _computeLineMetricsInto(metrics);
+
+  @Native<Int32 Function(Pointer<Void>, Handle)>(symbol: 'Paragraph::computeLineMetricsInto')
+  external int _computeLineMetricsInto(Float64List metrics);
+
   @override
   void dispose() {
     assert(!_disposed);
@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkStream.h"
 #include "third_party/skia/include/core/SkString.h"
@@ -49,8 +50,10 @@ sk_sp<SkFontStyleSet> AssetManagerFontProvider::MatchFamily(
   return found->second;
 }
 
-void AssetManagerFontProvider::RegisterAsset(const std::string& family_name,
-                                             const std::string& asset) {
+void AssetManagerFontProvider::RegisterAsset(
+    const std::string& family_name,
+    const std::string& asset,
+    std::optional<SkFontStyle> style) {
   std::string canonical_name = CanonicalFamilyName(family_name);
   auto family_it = registered_families_.find(canonical_name);
 
@@ -62,7 +65,28 @@ void AssetManagerFontProvider::RegisterAsset(const std::string& family_name,
     family_it = registered_families_.emplace(value).first;
   }
 
-  family_it->second->registerAsset(asset);
+  family_it->second->registerAsset(asset, style);
+}
+
+void AssetManagerFontProvider::PreloadTypefaces(
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& task_runner) const {
+  if (!task_runner) {
+    return;
+  }
+  for (const auto& family_name : family_names_) {
+    auto found = registered_families_.find(CanonicalFamilyName(family_name));
+    FML_DCHECK(found != registered_families_.end());
+    sk_sp<AssetManagerFontStyleSet> style_set = found->second;
+    for (int i = 0; i < style_set->count(); i++) {
+      task_runner->PostTask(
+          [style_set, i]() {
+            TRACE_EVENT0("flutter",
+                         "AssetManagerFontProvider::PreloadTypeface");
+            style_set->createTypeface(i);
+          },
+          fml::ConcurrentTaskPriority::kLow);
+    }
+  }
 }
 
 AssetManagerFontStyleSet::AssetManagerFontStyleSet(
@@ -73,8 +97,10 @@ AssetManagerFontStyleSet::AssetManagerFontStyleSet(
 
 AssetManagerFontStyleSet::~AssetManagerFontStyleSet() = default;
 
-void AssetManagerFontStyleSet::registerAsset(const std::string& asset) {
-  assets_.emplace_back(asset);
+void AssetManagerFontStyleSet::registerAsset(
+    const std::string& asset,
+    std::optional<SkFontStyle> style) {
+  assets_.emplace_back(asset, style);
 }
 
 int AssetManagerFontStyleSet::count() {
@@ -86,9 +112,14 @@ void AssetManagerFontStyleSet::getStyle(int index,
                                         SkString* name) {
   FML_DCHECK(index < static_cast<int>(assets_.size()));
   if (style) {
-    sk_sp<SkTypeface> typeface(createTypeface(index));
-    if (typeface) {
-      *style = typeface->fontStyle();
+    // Avoid parsing fonts that are only matched by their declared style.
+    if (assets_[index].style.has_value()) {
+      *style = assets_[index].style.value();
+    } else {
+      sk_sp<SkTypeface> typeface(createTypeface(index));
+      if (typeface) {
+        *style = typeface->fontStyle();
+      }
     }
   }
   if (name) {
@@ -102,6 +133,7 @@ auto AssetManagerFontStyleSet::createTypeface(int i) -> CreateTypefaceRet {
     return nullptr;
   }
 
+  std::scoped_lock lock(typefaces_mutex_);
   TypefaceAsset& asset = assets_[index];
   if (!asset.typeface) {
     std::unique_ptr<fml::Mapping> asset_mapping =
@@ -133,8 +165,10 @@ auto AssetManagerFontStyleSet::matchStyle(const SkFontStyle& pattern)
   return matchStyleCSS3(pattern);
 }
 
-AssetManagerFontStyleSet::TypefaceAsset::TypefaceAsset(std::string a)
-    : asset(std::move(a)) {}
+AssetManagerFontStyleSet::TypefaceAsset::TypefaceAsset(
+    std::string a,
+    std::optional<SkFontStyle> s)
+    : asset(std::move(a)), style(s) {}
 
 AssetManagerFontStyleSet::TypefaceAsset::TypefaceAsset(
     const AssetManagerFontStyleSet::TypefaceAsset& other) = default;
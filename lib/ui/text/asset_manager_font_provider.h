@@ -6,11 +6,14 @@
 #define FLUTTER_LIB_UI_TEXT_ASSET_MANAGER_FONT_PROVIDER_H_
 
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "flutter/assets/asset_manager.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "third_party/skia/include/core/SkFontMgr.h"
 #include "third_party/skia/include/core/SkTypeface.h"
@@ -18,6 +21,14 @@
 
 namespace flutter {
 
+//------------------------------------------------------------------------------
+/// @brief      The fonts of a family declared in the font manifest.
+///
+///             Typefaces are only parsed when they are first created. Fonts
+///             whose style is declared in the manifest are matched without
+///             parsing the other fonts of the family. Typefaces may be created
+///             on any thread.
+///
 class AssetManagerFontStyleSet : public SkFontStyleSet {
  public:
   AssetManagerFontStyleSet(std::shared_ptr<AssetManager> asset_manager,
@@ -25,7 +36,8 @@ class AssetManagerFontStyleSet : public SkFontStyleSet {
 
   ~AssetManagerFontStyleSet() override;
 
-  void registerAsset(const std::string& asset);
+  void registerAsset(const std::string& asset,
+                     std::optional<SkFontStyle> style = std::nullopt);
 
   // |SkFontStyleSet|
   int count() override;
@@ -48,15 +60,20 @@ class AssetManagerFontStyleSet : public SkFontStyleSet {
   std::string family_name_;
 
   struct TypefaceAsset {
-    explicit TypefaceAsset(std::string a);
+    TypefaceAsset(std::string a, std::optional<SkFontStyle> s);
 
     TypefaceAsset(const TypefaceAsset& other);
 
     ~TypefaceAsset();
 
     std::string asset;
+    std::optional<SkFontStyle> style;
     sk_sp<SkTypeface> typeface;
   };
+  // Guards the typefaces of the assets, which may be created on worker
+  // threads while they are matched on the UI thread. The assets themselves
+  // are only registered before the set is used.
+  std::mutex typefaces_mutex_;
   std::vector<TypefaceAsset> assets_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(AssetManagerFontStyleSet);
@@ -69,7 +86,27 @@ class AssetManagerFontProvider : public txt::FontAssetProvider {
 
   ~AssetManagerFontProvider() override;
 
-  void RegisterAsset(const std::string& family_name, const std::string& asset);
+  //----------------------------------------------------------------------------
+  /// @brief      Add a font to a family.
+  ///
+  /// @param[in]  family_name  The name of the family.
+  /// @param[in]  asset        The name of the font asset.
+  /// @param[in]  style        The style of the font declared in the manifest,
+  ///                          if any. Fonts without a declared style are
+  ///                          parsed to find their style when their family is
+  ///                          matched.
+  ///
+  void RegisterAsset(const std::string& family_name,
+                     const std::string& asset,
+                     std::optional<SkFontStyle> style = std::nullopt);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Parse the typefaces of all registered fonts on worker
+  ///             threads, in the order they were registered, so that they are
+  ///             ready when they are first matched.
+  ///
+  void PreloadTypefaces(
+      const std::shared_ptr<fml::ConcurrentTaskRunner>& task_runner) const;
 
   // |FontAssetProvider|
   size_t GetFamilyCount() const override;
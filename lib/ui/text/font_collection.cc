@@ -5,6 +5,7 @@
 #include "flutter/lib/ui/text/font_collection.h"
 
 #include <mutex>
+#include <optional>
 
 #include "flutter/lib/ui/text/asset_manager_font_provider.h"
 #include "flutter/lib/ui/ui_dart_state.h"
@@ -25,6 +26,28 @@
 
 namespace flutter {
 
+namespace {
+
+// The style of a font with a declared weight or style. Fonts that declare
+// neither are parsed to find their style.
+std::optional<SkFontStyle> GetDeclaredFontStyle(const rapidjson::Value& font) {
+  auto weight = font.FindMember("weight");
+  auto style = font.FindMember("style");
+  const bool has_weight = weight != font.MemberEnd() && weight->value.IsInt();
+  const bool has_style = style != font.MemberEnd() && style->value.IsString();
+  if (!has_weight && !has_style) {
+    return std::nullopt;
+  }
+  const bool italic =
+      has_style && std::string(style->value.GetString()) == "italic";
+  return SkFontStyle(
+      has_weight ? weight->value.GetInt() : SkFontStyle::kNormal_Weight,
+      SkFontStyle::kNormal_Width,
+      italic ? SkFontStyle::kItalic_Slant : SkFontStyle::kUpright_Slant);
+}
+
+}  // namespace
+
 FontCollection::FontCollection()
     : collection_(std::make_shared<txt::FontCollection>()) {
   dynamic_font_manager_ = sk_make_sp<txt::DynamicFontManager>();
@@ -62,7 +85,8 @@ void FontCollection::SetupDefaultFontManager(
 //
 // Structure described in https://docs.flutter.dev/cookbook/design/fonts
 void FontCollection::RegisterFonts(
-    const std::shared_ptr<AssetManager>& asset_manager) {
+    const std::shared_ptr<AssetManager>& asset_manager,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& preload_task_runner) {
   std::unique_ptr<fml::Mapping> manifest_mapping =
       asset_manager->GetAsMapping("FontManifest.json");
   if (manifest_mapping == nullptr) {
@@ -110,12 +134,13 @@ void FontCollection::RegisterFonts(
         continue;
       }
 
-      // TODO(chinmaygarde): Handle weights and styles.
       font_provider->RegisterAsset(family_name->value.GetString(),
-                                   font_asset->value.GetString());
+                                   font_asset->value.GetString(),
+                                   GetDeclaredFontStyle(family_font));
     }
   }
 
+  font_provider->PreloadTypefaces(preload_task_runner);
   collection_->SetAssetFontManager(
       sk_make_sp<txt::AssetFontManager>(std::move(font_provider)));
 }
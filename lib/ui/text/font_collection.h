@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "flutter/assets/asset_manager.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_ptr.h"
 #include "third_party/tonic/typed_data/typed_list.h"
@@ -26,7 +27,18 @@ class FontCollection {
 
   void SetupDefaultFontManager(uint32_t font_initialization_data);
 
-  void RegisterFonts(const std::shared_ptr<AssetManager>& asset_manager);
+  //----------------------------------------------------------------------------
+  /// @brief      Register the fonts declared in the font manifest of the
+  ///             assets. Fonts are only parsed when they are first used.
+  ///
+  /// @param[in]  asset_manager        The assets.
+  /// @param[in]  preload_task_runner  If not null, the fonts are parsed on
+  ///                                  this runner ahead of their first use,
+  ///                                  in the order of the manifest.
+  ///
+  void RegisterFonts(const std::shared_ptr<AssetManager>& asset_manager,
+                     const std::shared_ptr<fml::ConcurrentTaskRunner>&
+                         preload_task_runner = nullptr);
 
   void RegisterTestFonts();
 
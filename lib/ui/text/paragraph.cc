@@ -12,6 +12,7 @@
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_binding_macros.h"
 #include "third_party/tonic/dart_library_natives.h"
+#include "third_party/tonic/typed_data/typed_list.h"
 
 namespace flutter {
 
@@ -100,6 +101,42 @@ tonic::Float32List Paragraph::getRectsForRange(unsigned start,
   return EncodeTextBoxes(boxes);
 }
 
+int Paragraph::getRectsForRanges(Dart_Handle ranges_handle,
+                                 unsigned boxHeightStyle,
+                                 unsigned boxWidthStyle,
+                                 Dart_Handle boxes_handle) {
+  tonic::Int32List ranges(ranges_handle);
+  tonic::Float32List boxes(boxes_handle);
+  // Layout:
+  // For each pair of start and end in |ranges|, the number of boxes of the
+  // range followed by its boxes, in groups of 5 as in |EncodeTextBoxes|.
+  // Values that don't fit into |boxes| are counted but not written.
+  intptr_t position = 0;
+  auto write = [&boxes, &position](float value) {
+    if (position < boxes.num_elements()) {
+      boxes[position] = value;
+    }
+    position++;
+  };
+  for (intptr_t i = 0; i + 1 < ranges.num_elements(); i += 2) {
+    std::vector<txt::Paragraph::TextBox> range_boxes =
+        m_paragraph->GetRectsForRange(
+            static_cast<unsigned>(ranges[i]),
+            static_cast<unsigned>(ranges[i + 1]),
+            static_cast<txt::Paragraph::RectHeightStyle>(boxHeightStyle),
+            static_cast<txt::Paragraph::RectWidthStyle>(boxWidthStyle));
+    write(range_boxes.size());
+    for (const txt::Paragraph::TextBox& box : range_boxes) {
+      write(box.rect.fLeft);
+      write(box.rect.fTop);
+      write(box.rect.fRight);
+      write(box.rect.fBottom);
+      write(static_cast<float>(box.direction));
+    }
+  }
+  return position;
+}
+
 tonic::Float32List Paragraph::getRectsForPlaceholders() {
   std::vector<txt::Paragraph::TextBox> boxes =
       m_paragraph->GetRectsForPlaceholders();
@@ -116,6 +153,23 @@ Dart_Handle Paragraph::getPositionForOffset(double dx, double dy) {
   return tonic::DartConverter<decltype(result)>::ToDart(result);
 }
 
+void Paragraph::getPositionsForOffsets(Dart_Handle offsets_handle,
+                                       Dart_Handle positions_handle) {
+  tonic::Float32List offsets(offsets_handle);
+  tonic::Int32List positions(positions_handle);
+  // Layout:
+  // For each pair of dx and dy in |offsets|, the position and the affinity
+  // of the closest position.
+  for (intptr_t i = 0;
+       i + 1 < offsets.num_elements() && i + 1 < positions.num_elements();
+       i += 2) {
+    txt::Paragraph::PositionWithAffinity pos =
+        m_paragraph->GetGlyphPositionAtCoordinate(offsets[i], offsets[i + 1]);
+    positions[i] = static_cast<int32_t>(pos.position);
+    positions[i + 1] = static_cast<int32_t>(pos.affinity);
+  }
+}
+
 Dart_Handle Paragraph::getWordBoundary(unsigned offset) {
   txt::Paragraph::Range<size_t> point = m_paragraph->GetWordBoundary(offset);
   std::vector<size_t> result = {point.start, point.end};
@@ -137,34 +191,50 @@ Dart_Handle Paragraph::getLineBoundary(unsigned offset) {
   return tonic::DartConverter<decltype(result)>::ToDart(result);
 }
 
+static constexpr size_t kLineMetricsValueCount = 9;
+
+static void EncodeLineMetrics(const txt::LineMetrics& line, double* values) {
+  values[0] = static_cast<double>(line.hard_break);
+  values[1] = line.ascent;
+  values[2] = line.descent;
+  values[3] = line.unscaled_ascent;
+  // We add then round to get the height. The
+  // definition of height here is different
+  // than the one in LibTxt.
+  values[4] = round(line.ascent + line.descent);
+  values[5] = line.width;
+  values[6] = line.left;
+  values[7] = line.baseline;
+  values[8] = static_cast<double>(line.line_number);
+}
+
 tonic::Float64List Paragraph::computeLineMetrics() {
   std::vector<txt::LineMetrics> metrics = m_paragraph->GetLineMetrics();
 
   // Layout:
   // boxes.size() groups of 9 which are the line metrics
   // properties
-  tonic::Float64List result(
-      Dart_NewTypedData(Dart_TypedData_kFloat64, metrics.size() * 9));
-  uint64_t position = 0;
+  tonic::Float64List result(Dart_NewTypedData(
+      Dart_TypedData_kFloat64, metrics.size() * kLineMetricsValueCount));
   for (uint64_t i = 0; i < metrics.size(); i++) {
-    const txt::LineMetrics& line = metrics[i];
-    result[position++] = static_cast<double>(line.hard_break);
-    result[position++] = line.ascent;
-    result[position++] = line.descent;
-    result[position++] = line.unscaled_ascent;
-    // We add then round to get the height. The
-    // definition of height here is different
-    // than the one in LibTxt.
-    result[position++] = round(line.ascent + line.descent);
-    result[position++] = line.width;
-    result[position++] = line.left;
-    result[position++] = line.baseline;
-    result[position++] = static_cast<double>(line.line_number);
+    EncodeLineMetrics(metrics[i], &result[i * kLineMetricsValueCount]);
   }
 
   return result;
 }
 
+int Paragraph::computeLineMetricsInto(Dart_Handle metrics_handle) {
+  std::vector<txt::LineMetrics> metrics = m_paragraph->GetLineMetrics();
+  tonic::Float64List result(metrics_handle);
+  // Same layout as |computeLineMetrics|. Lines that don't fit into |result|
+  // are counted but not written.
+  const size_t capacity = result.num_elements() / kLineMetricsValueCount;
+  for (size_t i = 0; i < metrics.size() && i < capacity; i++) {
+    EncodeLineMetrics(metrics[i], &result[i * kLineMetricsValueCount]);
+  }
+  return metrics.size();
+}
+
 void Paragraph::dispose() {
   m_paragraph.reset();
   ClearDartWrapper();
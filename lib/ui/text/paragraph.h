@@ -43,11 +43,18 @@ class Paragraph : public RefCountedDartWrappable<Paragraph> {
                                       unsigned end,
                                       unsigned boxHeightStyle,
                                       unsigned boxWidthStyle);
+  int getRectsForRanges(Dart_Handle ranges_handle,
+                        unsigned boxHeightStyle,
+                        unsigned boxWidthStyle,
+                        Dart_Handle boxes_handle);
   tonic::Float32List getRectsForPlaceholders();
   Dart_Handle getPositionForOffset(double dx, double dy);
+  void getPositionsForOffsets(Dart_Handle offsets_handle,
+                              Dart_Handle positions_handle);
   Dart_Handle getWordBoundary(unsigned offset);
   Dart_Handle getLineBoundary(unsigned offset);
   tonic::Float64List computeLineMetrics();
+  int computeLineMetricsInto(Dart_Handle metrics_handle);
 
   void dispose();
 
@@ -153,7 +153,14 @@ void ParagraphBuilder::Create(Dart_Handle wrapper,
                               const std::u16string& ellipsis,
                               const std::string& locale,
                               bool applyRoundingHack) {
-  UIDartState::ThrowIfUIOperationsProhibited();
+  // Background isolates lay out text with the fonts of the root isolate they
+  // are registered with.
+  if (!UIDartState::Current()->GetFontCollection()) {
+    Dart_EnterScope();
+    Dart_ThrowException(
+        tonic::ToDart("Paragraphs can only be built on the root isolate or on "
+                      "background isolates registered with a root isolate."));
+  }
   auto res = fml::MakeRefCounted<ParagraphBuilder>(
       encoded_handle, strutData, fontFamily, strutFontFamilies, fontSize,
       height, ellipsis, locale, applyRoundingHack);
@@ -295,14 +302,9 @@ ParagraphBuilder::ParagraphBuilder(
   }
   style.apply_rounding_hack = applyRoundingHack;
 
-  FontCollection& font_collection = UIDartState::Current()
-                                        ->platform_configuration()
-                                        ->client()
-                                        ->GetFontCollection();
-
   auto impeller_enabled = UIDartState::Current()->IsImpellerEnabled();
   m_paragraphBuilder = txt::ParagraphBuilder::CreateSkiaBuilder(
-      style, font_collection.GetFontCollection(), impeller_enabled);
+      style, UIDartState::Current()->GetFontCollection(), impeller_enabled);
 }
 
 ParagraphBuilder::~ParagraphBuilder() = default;
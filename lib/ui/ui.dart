@@ -17,7 +17,7 @@ import 'dart:convert';
 import 'dart:developer' as developer;
 import 'dart:ffi';
 import 'dart:io';
-import 'dart:isolate' show SendPort;
+import 'dart:isolate' show Isolate, RawReceivePort, RemoteError, SendPort;
 import 'dart:math' as math;
 import 'dart:nativewrappers';
 import 'dart:typed_data';
@@ -29,6 +29,7 @@ part 'geometry.dart';
 part 'hash_codes.dart';
 part 'hooks.dart';
 part 'isolate_name_server.dart';
+part 'isolate_pool.dart';
 part 'key.dart';
 part 'lerp.dart';
 part 'math.dart';
@@ -8,6 +8,7 @@
 #include <utility>
 
 #include "flutter/fml/message_loop.h"
+#include "flutter/lib/ui/text/font_collection.h"
 #include "flutter/lib/ui/window/platform_configuration.h"
 #include "flutter/lib/ui/window/platform_message.h"
 #include "third_party/tonic/converter/dart_converter.h"
@@ -40,7 +41,8 @@ UIDartState::Context::Context(
     std::string advisory_script_entrypoint,
     std::shared_ptr<VolatilePathTracker> volatile_path_tracker,
     std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
-    bool enable_impeller)
+    bool enable_impeller,
+    size_t animated_image_decode_ahead_frames)
     : task_runners(task_runners),
       snapshot_delegate(std::move(snapshot_delegate)),
       io_manager(std::move(io_manager)),
@@ -51,7 +53,8 @@ UIDartState::Context::Context(
       advisory_script_entrypoint(std::move(advisory_script_entrypoint)),
       volatile_path_tracker(std::move(volatile_path_tracker)),
       concurrent_task_runner(std::move(concurrent_task_runner)),
-      enable_impeller(enable_impeller) {}
+      enable_impeller(enable_impeller),
+      animated_image_decode_ahead_frames(animated_image_decode_ahead_frames) {}
 
 UIDartState::UIDartState(
     TaskObserverAdd add_callback,
@@ -85,6 +88,10 @@ bool UIDartState::IsImpellerEnabled() const {
   return context_.enable_impeller;
 }
 
+size_t UIDartState::GetAnimatedImageDecodeAheadFrames() const {
+  return context_.animated_image_decode_ahead_frames;
+}
+
 void UIDartState::DidSetIsolate() {
   main_port_ = Dart_GetMainPortId();
   std::ostringstream debug_name;
@@ -130,6 +137,21 @@ void UIDartState::SetPlatformMessageHandler(
   platform_message_handler_ = std::move(handler);
 }
 
+void UIDartState::SetFontCollection(
+    std::shared_ptr<txt::FontCollection> font_collection) {
+  FML_DCHECK(!IsRootIsolate());
+  font_collection_ = std::move(font_collection);
+}
+
+std::shared_ptr<txt::FontCollection> UIDartState::GetFontCollection() const {
+  if (platform_configuration_) {
+    return platform_configuration_->client()
+        ->GetFontCollection()
+        .GetFontCollection();
+  }
+  return font_collection_;
+}
+
 const TaskRunners& UIDartState::GetTaskRunners() const {
   return context_.task_runners;
 }
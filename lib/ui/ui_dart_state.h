@@ -26,6 +26,10 @@
 #include "third_party/tonic/dart_persistent_value.h"
 #include "third_party/tonic/dart_state.h"
 
+namespace txt {
+class FontCollection;
+}  // namespace txt
+
 namespace flutter {
 class FontSelector;
 class ImageGeneratorRegistry;
@@ -54,7 +58,8 @@ class UIDartState : public tonic::DartState {
             std::string advisory_script_entrypoint,
             std::shared_ptr<VolatilePathTracker> volatile_path_tracker,
             std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
-            bool enable_impeller);
+            bool enable_impeller,
+            size_t animated_image_decode_ahead_frames = 0u);
 
     /// The task runners used by the shell hosting this runtime controller. This
     /// may be used by the isolate to scheduled asynchronous texture uploads or
@@ -99,6 +104,10 @@ class UIDartState : public tonic::DartState {
 
     /// Whether Impeller is enabled or not.
     bool enable_impeller = false;
+
+    /// The number of frames of animated images to decode on the concurrent
+    /// task runner ahead of the frames the framework asks for.
+    size_t animated_image_decode_ahead_frames = 0u;
   };
 
   Dart_Port main_port() const { return main_port_; }
@@ -120,6 +129,14 @@ class UIDartState : public tonic::DartState {
 
   Dart_Handle HandlePlatformMessage(std::unique_ptr<PlatformMessage> message);
 
+  /// The fonts of the background isolate, created from the fonts of the root
+  /// isolate it was registered with.
+  void SetFontCollection(std::shared_ptr<txt::FontCollection> font_collection);
+
+  /// The fonts text is laid out with in this isolate. Returns null for
+  /// background isolates that are not registered with a root isolate.
+  std::shared_ptr<txt::FontCollection> GetFontCollection() const;
+
   const TaskRunners& GetTaskRunners() const;
 
   void ScheduleMicrotask(Dart_Handle handle);
@@ -163,6 +180,9 @@ class UIDartState : public tonic::DartState {
   /// Whether Impeller is enabled for this application.
   bool IsImpellerEnabled() const;
 
+  /// The number of frames of animated images to decode ahead of time.
+  size_t GetAnimatedImageDecodeAheadFrames() const;
+
  protected:
   UIDartState(TaskObserverAdd add_callback,
               TaskObserverRemove remove_callback,
@@ -191,6 +211,7 @@ class UIDartState : public tonic::DartState {
   std::string debug_name_;
   std::unique_ptr<PlatformConfiguration> platform_configuration_;
   std::weak_ptr<PlatformMessageHandler> platform_message_handler_;
+  std::shared_ptr<txt::FontCollection> font_collection_;
   tonic::DartMicrotaskQueue microtask_queue_;
   UnhandledExceptionCallback unhandled_exception_callback_;
   LogMessageCallback log_message_callback_;
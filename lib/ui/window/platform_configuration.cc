@@ -7,7 +7,9 @@
 #include <cstring>
 
 #include "flutter/common/constants.h"
+#include "flutter/fml/metrics.h"
 #include "flutter/lib/ui/compositing/scene.h"
+#include "flutter/lib/ui/text/font_collection.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/lib/ui/window/platform_message.h"
 #include "flutter/lib/ui/window/platform_message_response_dart.h"
@@ -23,8 +25,24 @@
 namespace flutter {
 namespace {
 
-Dart_Handle ToByteData(const fml::Mapping& buffer) {
-  return tonic::DartByteData::Create(buffer.GetMapping(), buffer.GetSize());
+void FreeFinalizer(void* isolate_callback_data, void* peer) {
+  free(peer);
+}
+
+// Hands the buffer of |buffer| over to Dart instead of copying it when it is
+// large enough to be an external typed data anyway.
+Dart_Handle ToByteData(fml::MallocMapping buffer) {
+  const size_t size = buffer.GetSize();
+  if (size < tonic::DartByteData::kExternalSizeThreshold) {
+    return tonic::DartByteData::Create(buffer.GetMapping(), size);
+  }
+  uint8_t* data = buffer.Release();
+  Dart_Handle byte_data = Dart_NewExternalTypedDataWithFinalizer(
+      Dart_TypedData_kByteData, data, size, data, size, FreeFinalizer);
+  if (Dart_IsError(byte_data)) {
+    free(data);
+  }
+  return byte_data;
 }
 
 }  // namespace
@@ -81,6 +99,11 @@ void PlatformConfiguration::DidCreateIsolate() {
                   Dart_GetField(library, tonic::ToDart("_drawFrame")));
   report_timings_.Set(tonic::DartState::Current(),
                       Dart_GetField(library, tonic::ToDart("_reportTimings")));
+  prewarm_isolate_pool_.Set(
+      tonic::DartState::Current(),
+      Dart_GetField(library, tonic::ToDart("_prewarmIsolatePool")));
+  run_idle_tasks_.Set(tonic::DartState::Current(),
+                      Dart_GetField(library, tonic::ToDart("_runIdleTasks")));
 }
 
 void PlatformConfiguration::AddView(int64_t view_id,
@@ -299,7 +322,7 @@ void PlatformConfiguration::DispatchPlatformMessage(
   }
   tonic::DartState::Scope scope(dart_state);
   Dart_Handle data_handle =
-      (message->hasData()) ? ToByteData(message->data()) : Dart_Null();
+      (message->hasData()) ? ToByteData(message->releaseData()) : Dart_Null();
   if (Dart_IsError(data_handle)) {
     FML_DLOG(WARNING)
         << "Dropping platform message because of a Dart error on channel: "
@@ -350,7 +373,7 @@ void PlatformConfiguration::DispatchSemanticsAction(int32_t node_id,
   tonic::DartState::Scope scope(dart_state);
 
   Dart_Handle args_handle =
-      (args.GetSize() <= 0) ? Dart_Null() : ToByteData(args);
+      (args.GetSize() <= 0) ? Dart_Null() : ToByteData(std::move(args));
 
   if (Dart_IsError(args_handle)) {
     return;
@@ -411,6 +434,31 @@ void PlatformConfiguration::ReportTimings(std::vector<int64_t> timings) {
                                                }));
 }
 
+void PlatformConfiguration::PrewarmIsolatePool(int size) {
+  std::shared_ptr<tonic::DartState> dart_state =
+      prewarm_isolate_pool_.dart_state().lock();
+  if (!dart_state) {
+    return;
+  }
+  tonic::DartState::Scope scope(dart_state);
+  tonic::CheckAndHandleError(tonic::DartInvoke(prewarm_isolate_pool_.Get(),
+                                               {tonic::ToDart(size)}));
+}
+
+void PlatformConfiguration::RunIdleTasks(fml::TimeDelta deadline) {
+  if (!needs_idle_tasks_) {
+    return;
+  }
+  std::shared_ptr<tonic::DartState> dart_state =
+      run_idle_tasks_.dart_state().lock();
+  if (!dart_state) {
+    return;
+  }
+  tonic::DartState::Scope scope(dart_state);
+  tonic::CheckAndHandleError(tonic::DartInvoke(
+      run_idle_tasks_.Get(), {tonic::ToDart(deadline.ToMicroseconds())}));
+}
+
 const ViewportMetrics* PlatformConfiguration::GetMetrics(int view_id) {
   auto found = metrics_.find(view_id);
   if (found != metrics_.end()) {
@@ -462,6 +510,31 @@ void PlatformConfigurationNativeApi::SetNeedsReportTimings(bool value) {
       ->SetNeedsReportTimings(value);
 }
 
+void PlatformConfigurationNativeApi::SetPreferredFrameRate(
+    double frames_per_second) {
+  UIDartState::ThrowIfUIOperationsProhibited();
+  UIDartState::Current()
+      ->platform_configuration()
+      ->client()
+      ->SetPreferredFrameRate(frames_per_second);
+}
+
+void PlatformConfigurationNativeApi::SetNeedsIdleTasks(bool value) {
+  UIDartState::ThrowIfUIOperationsProhibited();
+  UIDartState::Current()->platform_configuration()->SetNeedsIdleTasks(value);
+}
+
+Dart_Handle PlatformConfigurationNativeApi::GetEngineCounters() {
+  // The counters belong to the process, so this is allowed on any isolate.
+  auto counters = fml::MetricsRegistry::GetInstance().GetCounterValues();
+  Dart_Handle list = Dart_NewList(counters.size() * 2);
+  for (size_t i = 0; i < counters.size(); i++) {
+    Dart_ListSetAt(list, i * 2, tonic::ToDart(counters[i].first));
+    Dart_ListSetAt(list, i * 2 + 1, tonic::ToDart(counters[i].second));
+  }
+  return list;
+}
+
 namespace {
 Dart_Handle HandlePlatformMessage(
     UIDartState* dart_state,
@@ -629,6 +702,15 @@ void PlatformConfigurationNativeApi::RegisterBackgroundIsolate(
   auto weak_platform_message_handler =
       platform_message_handler->GetPlatformMessageHandler(root_isolate_token);
   dart_state->SetPlatformMessageHandler(weak_platform_message_handler);
+
+  // Text is laid out with the fonts of the root isolate but with a Skia font
+  // collection of the background isolate's own.
+  auto font_collection =
+      platform_message_handler->GetFontCollection(root_isolate_token).lock();
+  if (font_collection) {
+    dart_state->SetFontCollection(
+        font_collection->CreateBackgroundCollection());
+  }
 }
 
 void PlatformConfigurationNativeApi::SendChannelUpdate(const std::string& name,
@@ -21,6 +21,10 @@
 #include "third_party/tonic/dart_persistent_value.h"
 #include "third_party/tonic/typed_data/dart_byte_data.h"
 
+namespace txt {
+class FontCollection;
+}  // namespace txt
+
 namespace flutter {
 class FontCollection;
 class PlatformMessage;
@@ -150,6 +154,20 @@ class PlatformConfigurationClient {
   ///
   virtual void SetNeedsReportTimings(bool value) = 0;
 
+  //--------------------------------------------------------------------------
+  /// @brief      Hints the rate at which the application currently needs to
+  ///             produce frames, so that displays with a variable refresh rate
+  ///             may run at a lower rate and save power.
+  ///
+  ///             This option is engine counterpart of the
+  ///             `PlatformDispatcher.setPreferredFrameRate` in
+  ///             `platform_dispatcher.dart`.
+  ///
+  /// @param[in]  frames_per_second  The preferred frame rate, or zero to
+  ///                                remove the hint.
+  ///
+  virtual void SetPreferredFrameRate(double frames_per_second) = 0;
+
   //--------------------------------------------------------------------------
   /// @brief      The embedder can specify data that the isolate can request
   ///             synchronously on launch. This accessor fetches that data.
@@ -466,6 +484,31 @@ class PlatformConfiguration final {
   ///
   void ReportTimings(std::vector<int64_t> timings);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Spawns background isolates in the isolate group of the root
+  ///             isolate until `IsolatePool` holds `size` idle isolates.
+  ///
+  /// @param[in]  size  The number of isolates to keep warm.
+  ///
+  void PrewarmIsolatePool(int size);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Runs the callbacks scheduled with
+  ///             `PlatformDispatcher.scheduleIdleTask`, if any, until the
+  ///             deadline is near.
+  ///
+  /// @param[in]  deadline  The end of the idle period, in the clock of
+  ///                       `Dart_TimelineGetMicros`.
+  ///
+  void RunIdleTasks(fml::TimeDelta deadline);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Called by the framework when the first idle task is scheduled
+  ///             and once all the idle tasks have run, so that the engine only
+  ///             calls into Dart in idle periods when there is work to do.
+  ///
+  void SetNeedsIdleTasks(bool value) { needs_idle_tasks_ = value; }
+
   //----------------------------------------------------------------------------
   /// @brief      Retrieves the Window with the given ID managed by the
   ///             `PlatformConfiguration`.
@@ -517,6 +560,9 @@ class PlatformConfiguration final {
   tonic::DartPersistentValue begin_frame_;
   tonic::DartPersistentValue draw_frame_;
   tonic::DartPersistentValue report_timings_;
+  tonic::DartPersistentValue prewarm_isolate_pool_;
+  tonic::DartPersistentValue run_idle_tasks_;
+  bool needs_idle_tasks_ = false;
 
   // All current views' view metrics mapped from view IDs.
   std::unordered_map<int64_t, ViewportMetrics> metrics_;
@@ -539,6 +585,15 @@ class PlatformMessageHandlerStorage {
 
   virtual std::weak_ptr<PlatformMessageHandler> GetPlatformMessageHandler(
       int64_t root_isolate_token) const = 0;
+
+  /// The fonts of a root isolate that the background isolates registered with
+  /// it lay out text with.
+  virtual void SetFontCollection(
+      int64_t root_isolate_token,
+      std::weak_ptr<txt::FontCollection> font_collection) = 0;
+
+  virtual std::weak_ptr<txt::FontCollection> GetFontCollection(
+      int64_t root_isolate_token) const = 0;
 };
 
 //----------------------------------------------------------------------------
@@ -563,6 +618,16 @@ class PlatformConfigurationNativeApi {
 
   static void SetNeedsReportTimings(bool value);
 
+  static void SetPreferredFrameRate(double frames_per_second);
+
+  static void SetNeedsIdleTasks(bool value);
+
+  //--------------------------------------------------------------------------
+  /// @brief      Returns the names and values of the counters of the process
+  ///             as a list alternating names and values.
+  ///
+  static Dart_Handle GetEngineCounters();
+
   static Dart_Handle GetPersistentIsolateData();
 
   static Dart_Handle ComputePlatformResolvedLocale(
@@ -18,6 +18,14 @@
 
 namespace flutter {
 
+namespace {
+
+void MappingFinalizer(void* isolate_callback_data, void* peer) {
+  delete static_cast<fml::Mapping*>(peer);
+}
+
+}  // namespace
+
 PlatformMessageResponseDartPort::PlatformMessageResponseDartPort(
     Dart_Port send_port,
     int64_t identifier,
@@ -33,12 +41,24 @@ void PlatformMessageResponseDartPort::Complete(
       .type = Dart_CObject_kInt64,
   };
   response_identifier.value.as_int64 = identifier_;
-  Dart_CObject response_data = {
-      .type = Dart_CObject_kTypedData,
-  };
-  response_data.value.as_typed_data.type = Dart_TypedData_kUint8;
-  response_data.value.as_typed_data.length = data->GetSize();
-  response_data.value.as_typed_data.values = data->GetMapping();
+  Dart_CObject response_data;
+  const size_t size = data->GetSize();
+  if (size < tonic::DartByteData::kExternalSizeThreshold) {
+    response_data.type = Dart_CObject_kTypedData;
+    response_data.value.as_typed_data.type = Dart_TypedData_kUint8;
+    response_data.value.as_typed_data.length = size;
+    response_data.value.as_typed_data.values = data->GetMapping();
+  } else {
+    // Large responses are received without copying them, and the mapping is
+    // deleted once the receiving isolate collects them.
+    response_data.type = Dart_CObject_kExternalTypedData;
+    response_data.value.as_external_typed_data.type = Dart_TypedData_kUint8;
+    response_data.value.as_external_typed_data.length = size;
+    response_data.value.as_external_typed_data.data =
+        const_cast<uint8_t*>(data->GetMapping());
+    response_data.value.as_external_typed_data.peer = data.release();
+    response_data.value.as_external_typed_data.callback = MappingFinalizer;
+  }
 
   std::array<Dart_CObject*, 2> response_values = {&response_identifier,
                                                   &response_data};
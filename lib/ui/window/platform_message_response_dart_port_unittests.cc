@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <vector>
+
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/synchronization/waitable_event.h"
@@ -69,5 +71,61 @@ TEST_F(ShellTest, PlatformMessageResponseDartPort) {
   DestroyShell(std::move(shell), task_runners);
 }
 
+TEST_F(ShellTest, PlatformMessageResponseDartPortSendsLargeResponses) {
+  bool did_pass = false;
+  auto message_latch = std::make_shared<fml::AutoResetWaitableEvent>();
+  TaskRunners task_runners("test",                  // label
+                           GetCurrentTaskRunner(),  // platform
+                           CreateNewThread(),       // raster
+                           CreateNewThread(),       // ui
+                           CreateNewThread()        // io
+  );
+
+  auto nativeCallPlatformMessageResponseDartPort =
+      [ui_task_runner =
+           task_runners.GetUITaskRunner()](Dart_NativeArguments args) {
+        auto dart_state = std::make_shared<tonic::DartState>();
+        auto response = fml::MakeRefCounted<PlatformMessageResponseDartPort>(
+            tonic::DartConverter<int64_t>::FromDart(
+                Dart_GetNativeArgument(args, 0)),
+            123, "foobar");
+        // Responses this large are sent as external typed data.
+        auto mapping = std::make_unique<fml::DataMapping>(
+            std::vector<uint8_t>(2000, 7));
+        response->Complete(std::move(mapping));
+      };
+
+  AddNativeCallback(
+      "CallPlatformMessageResponseDartPort",
+      CREATE_NATIVE_ENTRY(nativeCallPlatformMessageResponseDartPort));
+
+  auto nativeFinishCallResponse = [message_latch,
+                                   &did_pass](Dart_NativeArguments args) {
+    did_pass =
+        tonic::DartConverter<bool>::FromDart(Dart_GetNativeArgument(args, 0));
+    message_latch->Signal();
+  };
+
+  AddNativeCallback("FinishCallResponse",
+                    CREATE_NATIVE_ENTRY(nativeFinishCallResponse));
+
+  Settings settings = CreateSettingsForFixture();
+
+  std::unique_ptr<Shell> shell = CreateShell(settings, task_runners);
+
+  ASSERT_TRUE(shell->IsSetup());
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("platformMessagePortLargeResponseTest");
+
+  shell->RunEngine(std::move(configuration), [](auto result) {
+    ASSERT_EQ(result, Engine::RunStatus::Success);
+  });
+
+  message_latch->Wait();
+
+  ASSERT_TRUE(did_pass);
+  DestroyShell(std::move(shell), task_runners);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -137,6 +137,30 @@ abstract class Picture {
   int get approximateBytesUsed;
 }
 
+// There are no background isolates on the web, and pictures can't be cloned,
+// so the handle shares the picture with the calling isolate.
+final class TransferablePicture {
+  TransferablePicture(Picture picture) : _picture = picture;
+
+  Picture? _picture;
+
+  Picture materialize() {
+    final Picture? picture = _picture;
+    if (picture == null) {
+      throw StateError(
+        'Cannot materialize a TransferablePicture more than once, or after it '
+        'was disposed.'
+      );
+    }
+    _picture = null;
+    return picture;
+  }
+
+  void dispose() {
+    _picture = null;
+  }
+}
+
 enum PathFillType {
   nonZero,
   evenOdd,
@@ -345,6 +345,31 @@ abstract class Image {
   String toString() => '[$width\u00D7$height]';
 }
 
+// There are no background isolates on the web, the handle keeps a clone of
+// the image in the calling isolate.
+final class TransferableImage {
+  TransferableImage(Image image) : _image = image.clone();
+
+  Image? _image;
+
+  Image materialize() {
+    final Image? image = _image;
+    if (image == null) {
+      throw StateError(
+        'Cannot materialize a TransferableImage more than once, or after it '
+        'was disposed.'
+      );
+    }
+    _image = null;
+    return image;
+  }
+
+  void dispose() {
+    _image?.dispose();
+    _image = null;
+  }
+}
+
 class ColorFilter implements ImageFilter {
   const factory ColorFilter.mode(Color color, BlendMode blendMode) = engine.EngineColorFilter.mode;
   const factory ColorFilter.matrix(List<double> matrix) = engine.EngineColorFilter.matrix;
@@ -777,6 +802,10 @@ class ImmutableBuffer {
     throw UnsupportedError('ImmutableBuffer.fromAsset is not supported on the web.');
   }
 
+  static Future<ImmutableBuffer> fromAssetRange(String assetKey, int offset, int length) async {
+    throw UnsupportedError('ImmutableBuffer.fromAssetRange is not supported on the web.');
+  }
+
   static Future<ImmutableBuffer> fromFilePath(String path) async {
     throw UnsupportedError('ImmutableBuffer.fromFilePath is not supported on the web.');
   }
@@ -862,6 +891,8 @@ abstract class FragmentProgram {
   }
 
   FragmentShader fragmentShader();
+
+  Future<void> warmUp();
 }
 
 abstract class FragmentShader implements Shader {
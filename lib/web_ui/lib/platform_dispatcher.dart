@@ -7,6 +7,7 @@ part of ui;
 typedef VoidCallback = void Function();
 typedef FrameCallback = void Function(Duration duration);
 typedef TimingsCallback = void Function(List<FrameTiming> timings);
+typedef IdleTaskCallback = void Function(Duration timeRemaining);
 typedef PointerDataPacketCallback = void Function(PointerDataPacket packet);
 typedef KeyDataCallback = bool Function(KeyData data);
 typedef SemanticsActionEventCallback = void Function(SemanticsActionEvent action);
@@ -55,6 +56,10 @@ abstract class PlatformDispatcher {
   TimingsCallback? get onReportTimings;
   set onReportTimings(TimingsCallback? callback);
 
+  void scheduleIdleTask(IdleTaskCallback callback);
+
+  Map<String, int> get engineCounters;
+
   void sendPlatformMessage(
       String name,
       ByteData? data,
@@ -76,6 +81,8 @@ abstract class PlatformDispatcher {
 
   void requestDartPerformanceMode(DartPerformanceMode mode) {}
 
+  void setPreferredFrameRate(double framesPerSecond) {}
+
   ByteData? getPersistentIsolateData() => null;
 
   void scheduleFrame();
@@ -164,6 +171,7 @@ enum _FrameTimingInfo {
   layerCacheBytes,
   pictureCacheCount,
   pictureCacheBytes,
+  gpuDuration,
   frameNumber,
 }
 
@@ -179,6 +187,7 @@ class FrameTiming {
     int layerCacheBytes = 0,
     int pictureCacheCount = 0,
     int pictureCacheBytes = 0,
+    int gpuDuration = 0,
     int frameNumber = 1,
   }) {
     return FrameTiming._(<int>[
@@ -192,6 +201,7 @@ class FrameTiming {
       layerCacheBytes,
       pictureCacheCount,
       pictureCacheBytes,
+      gpuDuration,
       frameNumber,
     ]);
   }
@@ -230,6 +240,8 @@ class FrameTiming {
 
   double get pictureCacheMegabytes => pictureCacheBytes / 1024.0 / 1024.0;
 
+  Duration get gpuDuration => Duration(microseconds: _rawInfo(_FrameTimingInfo.gpuDuration));
+
   int get frameNumber => _data.last;
 
   final List<int> _data;  // some elements in microseconds, some in bytes, some are counts
@@ -337,6 +337,9 @@ class CkFragmentProgram implements ui.FragmentProgram {
   ui.FragmentShader fragmentShader() {
     return CkFragmentShader(name, effect, floatCount, textureCount);
   }
+
+  @override
+  Future<void> warmUp() => Future<void>.value();
 }
 
 class CkFragmentShader implements ui.FragmentShader, CkShader {
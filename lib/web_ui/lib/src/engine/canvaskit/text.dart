@@ -628,6 +628,16 @@ class CkParagraph implements ui.Paragraph {
     return skRectsToTextBoxes(skRects);
   }
 
+  @override
+  int getBoxesForRanges(
+    Int32List ranges,
+    Float32List boxes, {
+    ui.BoxHeightStyle boxHeightStyle = ui.BoxHeightStyle.tight,
+    ui.BoxWidthStyle boxWidthStyle = ui.BoxWidthStyle.tight,
+  }) {
+    return writeBoxesForRanges(this, ranges, boxes, boxHeightStyle, boxWidthStyle);
+  }
+
   List<ui.TextBox> skRectsToTextBoxes(List<SkRectWithDirection> skRects) {
     assert(!_disposed, 'Paragraph has been disposed.');
     final List<ui.TextBox> result = <ui.TextBox>[];
@@ -658,6 +668,11 @@ class CkParagraph implements ui.Paragraph {
     return fromPositionWithAffinity(positionWithAffinity);
   }
 
+  @override
+  void getPositionsForOffsets(Float32List offsets, Int32List positions) {
+    writePositionsForOffsets(this, offsets, positions);
+  }
+
   @override
   ui.TextRange getWordBoundary(ui.TextPosition position) {
     assert(!_disposed, 'Paragraph has been disposed.');
@@ -728,6 +743,10 @@ class CkParagraph implements ui.Paragraph {
     return result;
   }
 
+  @override
+  int computeLineMetricsInto(Float64List metrics) => writeLineMetrics(this, metrics);
+
+
   bool _disposed = false;
 
   @override
@@ -295,6 +295,11 @@ class HtmlFragmentProgram implements ui.FragmentProgram {
   ui.FragmentShader fragmentShader() {
     throw UnsupportedError('FragmentProgram is not supported for the HTML renderer.');
   }
+
+  @override
+  Future<void> warmUp() {
+    throw UnsupportedError('FragmentProgram is not supported for the HTML renderer.');
+  }
 }
 
 class HtmlFragmentShader implements ui.FragmentShader {
@@ -351,6 +351,22 @@ class EnginePlatformDispatcher extends ui.PlatformDispatcher {
         _onReportTimings, _onReportTimingsZone, timings);
   }
 
+  /// The web engine doesn't report idle periods. Idle tasks run in a timer
+  /// task and are given the longest idle period browsers grant to idle
+  /// callbacks.
+  static const Duration _idleTaskTimeRemaining = Duration(milliseconds: 50);
+
+  @override
+  void scheduleIdleTask(ui.IdleTaskCallback callback) {
+    final void Function(Duration) zonedCallback =
+        Zone.current.bindUnaryCallbackGuarded<Duration>(callback);
+    Timer.run(() => zonedCallback(_idleTaskTimeRemaining));
+  }
+
+  /// The web engine doesn't keep counters.
+  @override
+  Map<String, int> get engineCounters => const <String, int>{};
+
   @override
   void sendPlatformMessage(
     String name,
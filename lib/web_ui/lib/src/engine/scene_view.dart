@@ -9,11 +9,13 @@ import 'package:ui/ui.dart' as ui;
 
 const String kCanvasContainerTag = 'flt-canvas-container';
 
-// This is an interface that renders a `ScenePicture` as a `DomImageBitmap`.
-// It is optionally asynchronous. It is required for the `EngineSceneView` to
-// composite pictures into the canvases in the DOM tree it builds.
+// This is an interface that renders `ScenePicture`s as `DomImageBitmap`s, in
+// the same order. It is optionally asynchronous. It is required for the
+// `EngineSceneView` to composite pictures into the canvases in the DOM tree it
+// builds. All the pictures of a scene are rendered in one call so that the
+// renderer can batch them.
 abstract class PictureRenderer {
-  FutureOr<DomImageBitmap> renderPicture(ScenePicture picture);
+  FutureOr<List<DomImageBitmap>> renderPictures(List<ScenePicture> pictures);
 }
 
 // This class builds a DOM tree that composites an `EngineScene`.
@@ -41,13 +43,17 @@ class EngineSceneView {
 
     scene.beginRender();
     final List<LayerSlice> slices = scene.rootLayer.slices;
-    final Iterable<Future<DomImageBitmap?>> renderFutures = slices.map(
-      (LayerSlice slice) async => switch (slice) {
-          PlatformViewSlice() => null,
-          PictureSlice() => pictureRenderer.renderPicture(slice.picture),
-        }
-    );
-    final List<DomImageBitmap?> renderedBitmaps = await Future.wait(renderFutures);
+    final List<ScenePicture> pictures = <ScenePicture>[
+      for (final LayerSlice slice in slices)
+        if (slice is PictureSlice) slice.picture,
+    ];
+    final List<DomImageBitmap> pictureBitmaps =
+      pictures.isEmpty ? <DomImageBitmap>[] : await pictureRenderer.renderPictures(pictures);
+    int pictureIndex = 0;
+    final List<DomImageBitmap?> renderedBitmaps = <DomImageBitmap?>[
+      for (final LayerSlice slice in slices)
+        slice is PictureSlice ? pictureBitmaps[pictureIndex++] : null,
+    ];
     final List<SliceContainer?> reusableContainers = List<SliceContainer?>.from(containers);
     final List<SliceContainer> newContainers = <SliceContainer>[];
     for (int i = 0; i < slices.length; i++) {
@@ -5,6 +5,7 @@
 import 'dart:convert';
 import 'dart:ffi';
 import 'dart:js_interop';
+import 'dart:typed_data';
 
 import 'package:ui/src/engine.dart';
 import 'package:ui/src/engine/skwasm/skwasm_impl.dart';
@@ -164,6 +165,16 @@ class SkwasmParagraph extends SkwasmObjectWrapper<RawParagraph> implements ui.Pa
     return boxes;
   }
 
+  @override
+  int getBoxesForRanges(
+    Int32List ranges,
+    Float32List boxes, {
+    ui.BoxHeightStyle boxHeightStyle = ui.BoxHeightStyle.tight,
+    ui.BoxWidthStyle boxWidthStyle = ui.BoxWidthStyle.tight,
+  }) {
+    return writeBoxesForRanges(this, ranges, boxes, boxHeightStyle, boxWidthStyle);
+  }
+
   @override
   ui.TextPosition getPositionForOffset(ui.Offset offset) => withStackScope((StackScope scope) {
     final Pointer<Int32> outAffinity = scope.allocInt32Array(1);
@@ -179,6 +190,11 @@ class SkwasmParagraph extends SkwasmObjectWrapper<RawParagraph> implements ui.Pa
     );
   });
 
+  @override
+  void getPositionsForOffsets(Float32List offsets, Int32List positions) {
+    writePositionsForOffsets(this, offsets, positions);
+  }
+
   @override
   ui.TextRange getWordBoundary(ui.TextPosition position) => withStackScope((StackScope scope) {
     final Pointer<Int32> outRange = scope.allocInt32Array(2);
@@ -214,6 +230,10 @@ class SkwasmParagraph extends SkwasmObjectWrapper<RawParagraph> implements ui.Pa
       (int index) => SkwasmLineMetrics._(paragraphGetLineMetricsAtIndex(handle, index))
     );
   }
+
+  @override
+  int computeLineMetricsInto(Float64List metrics) => writeLineMetrics(this, metrics);
+
 }
 
 void withScopedFontList(
@@ -466,6 +466,6 @@ class SkwasmPictureRenderer implements PictureRenderer {
   SkwasmSurface surface;
 
   @override
-  FutureOr<DomImageBitmap> renderPicture(ScenePicture picture) =>
-    surface.renderPicture(picture as SkwasmPicture);
+  FutureOr<List<DomImageBitmap>> renderPictures(List<ScenePicture> pictures) =>
+    surface.renderPictures(pictures.cast<SkwasmPicture>());
 }
@@ -219,6 +219,9 @@ class SkwasmFragmentProgram extends SkwasmObjectWrapper<RawRuntimeEffect> implem
   @override
   ui.FragmentShader fragmentShader() => SkwasmFragmentShader(this);
 
+  @override
+  Future<void> warmUp() => Future<void>.value();
+
   int get uniformSize => runtimeEffectGetUniformSize(handle);
 }
 
@@ -49,9 +49,23 @@ class SkwasmSurface {
   }
 
   Future<DomImageBitmap> renderPicture(SkwasmPicture picture) async {
-    final int callbackId = surfaceRenderPicture(handle, picture.handle);
-    final DomImageBitmap bitmap = (await _registerCallback(callbackId)) as DomImageBitmap;
-    return bitmap;
+    return (await renderPictures(<SkwasmPicture>[picture])).single;
+  }
+
+  /// Renders all of the [pictures] on the surface's worker in one batch, so
+  /// that a frame with several pictures only pays for a single round trip to
+  /// the worker.
+  Future<List<DomImageBitmap>> renderPictures(List<SkwasmPicture> pictures) async {
+    final int callbackId = withStackScope((StackScope scope) {
+      final Pointer<PictureHandle> pictureHandles =
+        scope.allocPointerArray(pictures.length).cast<PictureHandle>();
+      for (int i = 0; i < pictures.length; i++) {
+        pictureHandles[i] = pictures[i].handle;
+      }
+      return surfaceRenderPictures(handle, pictureHandles, pictures.length);
+    });
+    final JSArray bitmaps = (await _registerCallback(callbackId)) as JSArray;
+    return bitmaps.toDart.cast<DomImageBitmap>();
   }
 
   Future<ByteData> rasterizeImage(SkwasmImage image, ui.ImageByteFormat format) async {
@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+import 'dart:typed_data';
+
 import 'package:ui/ui.dart' as ui;
 
 import '../dom.dart';
@@ -200,11 +202,26 @@ class CanvasParagraph implements ui.Paragraph {
     return _layoutService.getBoxesForRange(start, end, boxHeightStyle, boxWidthStyle);
   }
 
+  @override
+  int getBoxesForRanges(
+    Int32List ranges,
+    Float32List boxes, {
+    ui.BoxHeightStyle boxHeightStyle = ui.BoxHeightStyle.tight,
+    ui.BoxWidthStyle boxWidthStyle = ui.BoxWidthStyle.tight,
+  }) {
+    return writeBoxesForRanges(this, ranges, boxes, boxHeightStyle, boxWidthStyle);
+  }
+
   @override
   ui.TextPosition getPositionForOffset(ui.Offset offset) {
     return _layoutService.getPositionForOffset(offset);
   }
 
+  @override
+  void getPositionsForOffsets(Float32List offsets, Int32List positions) {
+    writePositionsForOffsets(this, offsets, positions);
+  }
+
   @override
   ui.TextRange getWordBoundary(ui.TextPosition position) {
     final int characterPosition;
@@ -240,6 +257,10 @@ class CanvasParagraph implements ui.Paragraph {
     return lines.map((ParagraphLine line) => line.lineMetrics).toList();
   }
 
+  @override
+  int computeLineMetricsInto(Float64List metrics) => writeLineMetrics(this, metrics);
+
+
   bool _disposed = false;
 
   @override
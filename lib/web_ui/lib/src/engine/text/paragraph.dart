@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 import 'dart:math' as math;
+import 'dart:typed_data';
 
 import 'package:ui/ui.dart' as ui;
 import 'package:ui/ui_web/src/ui_web.dart' as ui_web;
@@ -738,6 +739,78 @@ class ParagraphPlaceholder {
   final ui.TextBaseline baseline;
 }
 
+/// Implements [ui.Paragraph.getBoxesForRanges] with
+/// [ui.Paragraph.getBoxesForRange], as the web renderers have no native call
+/// to save.
+int writeBoxesForRanges(
+  ui.Paragraph paragraph,
+  Int32List ranges,
+  Float32List boxes,
+  ui.BoxHeightStyle boxHeightStyle,
+  ui.BoxWidthStyle boxWidthStyle,
+) {
+  int position = 0;
+  void write(double value) {
+    if (position < boxes.length) {
+      boxes[position] = value;
+    }
+    position++;
+  }
+  for (int i = 0; i + 1 < ranges.length; i += 2) {
+    final List<ui.TextBox> rangeBoxes = paragraph.getBoxesForRange(
+      ranges[i],
+      ranges[i + 1],
+      boxHeightStyle: boxHeightStyle,
+      boxWidthStyle: boxWidthStyle,
+    );
+    write(rangeBoxes.length.toDouble());
+    for (final ui.TextBox box in rangeBoxes) {
+      write(box.left);
+      write(box.top);
+      write(box.right);
+      write(box.bottom);
+      write(box.direction.index.toDouble());
+    }
+  }
+  return position;
+}
+
+/// Implements [ui.Paragraph.getPositionsForOffsets] with
+/// [ui.Paragraph.getPositionForOffset].
+void writePositionsForOffsets(
+  ui.Paragraph paragraph,
+  Float32List offsets,
+  Int32List positions,
+) {
+  assert(positions.length >= offsets.length);
+  for (int i = 0; i + 1 < offsets.length && i + 1 < positions.length; i += 2) {
+    final ui.TextPosition position =
+        paragraph.getPositionForOffset(ui.Offset(offsets[i], offsets[i + 1]));
+    positions[i] = position.offset;
+    positions[i + 1] = position.affinity.index;
+  }
+}
+
+/// Implements [ui.Paragraph.computeLineMetricsInto] with
+/// [ui.Paragraph.computeLineMetrics].
+int writeLineMetrics(ui.Paragraph paragraph, Float64List metrics) {
+  final List<ui.LineMetrics> lines = paragraph.computeLineMetrics();
+  for (int i = 0; i < lines.length && (i + 1) * 9 <= metrics.length; i++) {
+    final ui.LineMetrics line = lines[i];
+    final int base = i * 9;
+    metrics[base] = line.hardBreak ? 1 : 0;
+    metrics[base + 1] = line.ascent;
+    metrics[base + 2] = line.descent;
+    metrics[base + 3] = line.unscaledAscent;
+    metrics[base + 4] = line.height;
+    metrics[base + 5] = line.width;
+    metrics[base + 6] = line.left;
+    metrics[base + 7] = line.baseline;
+    metrics[base + 8] = line.lineNumber.toDouble();
+  }
+  return lines.length;
+}
+
 /// Converts [fontWeight] to its CSS equivalent value.
 String? fontWeightToCss(ui.FontWeight? fontWeight) {
   if (fontWeight == null) {
@@ -690,11 +690,16 @@ abstract class Paragraph {
   List<TextBox> getBoxesForRange(int start, int end,
       {BoxHeightStyle boxHeightStyle = BoxHeightStyle.tight,
       BoxWidthStyle boxWidthStyle = BoxWidthStyle.tight});
+  int getBoxesForRanges(Int32List ranges, Float32List boxes,
+      {BoxHeightStyle boxHeightStyle = BoxHeightStyle.tight,
+      BoxWidthStyle boxWidthStyle = BoxWidthStyle.tight});
   TextPosition getPositionForOffset(Offset offset);
+  void getPositionsForOffsets(Float32List offsets, Int32List positions);
   TextRange getWordBoundary(TextPosition position);
   TextRange getLineBoundary(TextPosition position);
   List<TextBox> getBoxesForPlaceholders();
   List<LineMetrics> computeLineMetrics();
+  int computeLineMetricsInto(Float64List metrics);
   void dispose();
   bool get debugDisposed;
 }
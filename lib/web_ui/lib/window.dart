@@ -200,6 +200,14 @@ abstract final class IsolateNameServer {
   }
 }
 
+// There are no background isolates on the web, computations run on the
+// calling isolate.
+abstract final class IsolatePool {
+  static Future<R> run<R>(FutureOr<R> Function() computation) async {
+    return computation();
+  }
+}
+
 SingletonFlutterWindow get window => engine.window;
 
 class FrameData {
@@ -11,11 +11,15 @@ mergeInto(LibraryManager.library, {
     const handleToCanvasMap = new Map();
     const associatedObjectsMap = new Map();
     _skwasm_setAssociatedObjectOnThread = function(threadId, pointer, object) {
+      // The engine owns the texture sources it is handed, so they are
+      // transferred rather than cloned. Their decoded contents then only live
+      // on the worker that uploads them, and are never copied into wasm
+      // memory.
       PThread.pthreads[threadId].postMessage({
         skwasmMessage: 'setAssociatedObject',
         pointer,
         object,
-      });
+      }, [object]);
     };
     _skwasm_getAssociatedObject = function(pointer) {
       return associatedObjectsMap.get(pointer);
@@ -28,14 +32,16 @@ mergeInto(LibraryManager.library, {
         }
         switch (skwasmMessage) {
           case 'onRenderComplete':
-            _surface_onRenderComplete(data.surface, data.callbackId, data.imageBitmap);
+            _surface_onRenderComplete(data.surface, data.callbackId, data.imageBitmaps);
             return;
           case 'setAssociatedObject':
             associatedObjectsMap.set(data.pointer, data.object);
             return;
           case 'disposeAssociatedObject':
-            const object = { data };
-            if (object.close) {
+            // Closing video frames and image bitmaps releases their decoded
+            // contents right away instead of when they are garbage collected.
+            const object = associatedObjectsMap.get(data.pointer);
+            if (object && object.close) {
               object.close();
             }
             associatedObjectsMap.delete(data.pointer);
@@ -73,15 +79,22 @@ mergeInto(LibraryManager.library, {
       canvas.width = width;
       canvas.height = height;
     };
-    _skwasm_captureImageBitmap = async function(surfaceHandle, contextHandle, callbackId, width, height) {
+    _skwasm_captureImageBitmap = function(contextHandle, width, height, imagePromises) {
+      // The contents of the canvas are copied when `createImageBitmap` is
+      // called, so the next picture may be rendered before it resolves.
+      if (!imagePromises) imagePromises = Array();
       const canvas = handleToCanvasMap.get(contextHandle);
-      const imageBitmap = await createImageBitmap(canvas, 0, 0, width, height);
+      imagePromises.push(createImageBitmap(canvas, 0, 0, width, height));
+      return imagePromises;
+    };
+    _skwasm_postImageBitmaps = async function(surfaceHandle, callbackId, imagePromises) {
+      const imageBitmaps = imagePromises ? await Promise.all(imagePromises) : [];
       postMessage({
         skwasmMessage: 'onRenderComplete',
         surface: surfaceHandle,
         callbackId,
-        imageBitmap,
-      });
+        imageBitmaps,
+      }, imageBitmaps);
     };
     _skwasm_createGlTextureFromTextureSource = function(textureSource, width, height) {
       const glCtx = GL.currentContext.GLctx;
@@ -98,10 +111,10 @@ mergeInto(LibraryManager.library, {
       GL.textures[textureId] = newTexture;
       return textureId;
     };
-    _skwasm_disposeAssociatedObjectOnThread = function(threadId, object) {
+    _skwasm_disposeAssociatedObjectOnThread = function(threadId, pointer) {
       PThread.pthreads[threadId].postMessage({
         skwasmMessage: 'disposeAssociatedObject',
-        object,
+        pointer,
       });
     };
   },
@@ -119,6 +132,8 @@ mergeInto(LibraryManager.library, {
   skwasm_resizeCanvas__deps: ['$skwasm_support_setup'],
   skwasm_captureImageBitmap: function () {},
   skwasm_captureImageBitmap__deps: ['$skwasm_support_setup'],
+  skwasm_postImageBitmaps: function () {},
+  skwasm_postImageBitmaps__deps: ['$skwasm_support_setup'],
   skwasm_createGlTextureFromTextureSource: function () {},
   skwasm_createGlTextureFromTextureSource__deps: ['$skwasm_support_setup'],
 });
@@ -21,11 +21,13 @@ extern void skwasm_disposeAssociatedObjectOnThread(unsigned long threadId,
 extern void skwasm_registerMessageListener(pthread_t threadId);
 extern uint32_t skwasm_createOffscreenCanvas(int width, int height);
 extern void skwasm_resizeCanvas(uint32_t contextHandle, int width, int height);
-extern void skwasm_captureImageBitmap(Skwasm::Surface* surfaceHandle,
-                                      uint32_t contextHandle,
-                                      uint32_t bitmapId,
-                                      int width,
-                                      int height);
+extern SkwasmObject skwasm_captureImageBitmap(uint32_t contextHandle,
+                                              int width,
+                                              int height,
+                                              SkwasmObject imagePromises);
+extern void skwasm_postImageBitmaps(Skwasm::Surface* surfaceHandle,
+                                    uint32_t callbackId,
+                                    SkwasmObject imagePromises);
 extern unsigned int skwasm_createGlTextureFromTextureSource(
     SkwasmObject textureSource,
     int width,
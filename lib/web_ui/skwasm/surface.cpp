@@ -38,13 +38,19 @@ void Surface::dispose() {
 }
 
 // Main thread only
-uint32_t Surface::renderPicture(SkPicture* picture) {
+uint32_t Surface::renderPictures(SkPicture** pictures, int count) {
   assert(emscripten_is_main_browser_thread());
   uint32_t callbackId = ++_currentCallbackId;
-  picture->ref();
-  emscripten_dispatch_to_thread(_thread, EM_FUNC_SIG_VIII,
-                                reinterpret_cast<void*>(fRenderPicture),
-                                nullptr, this, picture, callbackId);
+  // The caller owns the array, so the worker gets its own copy. It releases
+  // the pictures and the copy once they are rendered.
+  SkPicture** picturesCopy = new SkPicture*[count];
+  for (int i = 0; i < count; i++) {
+    picturesCopy[i] = pictures[i];
+    pictures[i]->ref();
+  }
+  emscripten_dispatch_to_thread(_thread, EM_FUNC_SIG_VIIII,
+                                reinterpret_cast<void*>(fRenderPictures),
+                                nullptr, this, picturesCopy, count, callbackId);
   return callbackId;
 }
 
@@ -137,20 +143,39 @@ void Surface::_recreateSurface() {
 }
 
 // Worker thread only
-void Surface::_renderPicture(const SkPicture* picture, uint32_t callbackId) {
-  SkRect pictureRect = picture->cullRect();
-  SkIRect roundedOutRect;
-  pictureRect.roundOut(&roundedOutRect);
-  _resizeCanvasToFit(roundedOutRect.width(), roundedOutRect.height());
-  SkMatrix matrix =
-      SkMatrix::Translate(-roundedOutRect.fLeft, -roundedOutRect.fTop);
+void Surface::_renderPictures(SkPicture** pictures,
+                              int count,
+                              uint32_t callbackId) {
+  // Size the canvas for the largest picture up front, so that it isn't
+  // recreated part way through the batch.
+  int maxWidth = 0;
+  int maxHeight = 0;
+  for (int i = 0; i < count; i++) {
+    SkIRect roundedOutRect;
+    pictures[i]->cullRect().roundOut(&roundedOutRect);
+    maxWidth = std::max(maxWidth, roundedOutRect.width());
+    maxHeight = std::max(maxHeight, roundedOutRect.height());
+  }
+  _resizeCanvasToFit(maxWidth, maxHeight);
+
+  // Each bitmap is captured as soon as its picture is flushed, and all of
+  // them are sent back to the main thread in a single message.
+  SkwasmObject imagePromises = __builtin_wasm_ref_null_extern();
   makeCurrent(_glContext);
-  auto canvas = _surface->getCanvas();
-  canvas->drawColor(SK_ColorTRANSPARENT, SkBlendMode::kSrc);
-  canvas->drawPicture(sk_ref_sp<SkPicture>(picture), &matrix, nullptr);
-  _grContext->flush(_surface.get());
-  skwasm_captureImageBitmap(this, _glContext, callbackId,
-                            roundedOutRect.width(), roundedOutRect.height());
+  for (int i = 0; i < count; i++) {
+    SkIRect roundedOutRect;
+    pictures[i]->cullRect().roundOut(&roundedOutRect);
+    SkMatrix matrix =
+        SkMatrix::Translate(-roundedOutRect.fLeft, -roundedOutRect.fTop);
+    auto canvas = _surface->getCanvas();
+    canvas->drawColor(SK_ColorTRANSPARENT, SkBlendMode::kSrc);
+    canvas->drawPicture(sk_ref_sp<SkPicture>(pictures[i]), &matrix, nullptr);
+    _grContext->flush(_surface.get());
+    imagePromises =
+        skwasm_captureImageBitmap(_glContext, roundedOutRect.width(),
+                                  roundedOutRect.height(), imagePromises);
+  }
+  skwasm_postImageBitmaps(this, callbackId, imagePromises);
 }
 
 void Surface::_rasterizeImage(SkImage* image,
@@ -185,20 +210,25 @@ void Surface::_onRasterizeComplete(SkData* data, uint32_t callbackId) {
 }
 
 // Main thread only
-void Surface::onRenderComplete(uint32_t callbackId, SkwasmObject imageBitmap) {
+void Surface::onRenderComplete(uint32_t callbackId,
+                               SkwasmObject imageBitmaps) {
   assert(emscripten_is_main_browser_thread());
-  _callbackHandler(callbackId, nullptr, imageBitmap);
+  _callbackHandler(callbackId, nullptr, imageBitmaps);
 }
 
 void Surface::fDispose(Surface* surface) {
   surface->_dispose();
 }
 
-void Surface::fRenderPicture(Surface* surface,
-                             SkPicture* picture,
-                             uint32_t callbackId) {
-  surface->_renderPicture(picture, callbackId);
-  picture->unref();
+void Surface::fRenderPictures(Surface* surface,
+                              SkPicture** pictures,
+                              int count,
+                              uint32_t callbackId) {
+  surface->_renderPictures(pictures, count, callbackId);
+  for (int i = 0; i < count; i++) {
+    pictures[i]->unref();
+  }
+  delete[] pictures;
 }
 
 void Surface::fOnRasterizeComplete(Surface* surface,
@@ -233,9 +263,10 @@ SKWASM_EXPORT void surface_destroy(Surface* surface) {
   surface->dispose();
 }
 
-SKWASM_EXPORT uint32_t surface_renderPicture(Surface* surface,
-                                             SkPicture* picture) {
-  return surface->renderPicture(picture);
+SKWASM_EXPORT uint32_t surface_renderPictures(Surface* surface,
+                                              SkPicture** pictures,
+                                              int count) {
+  return surface->renderPictures(pictures, count);
 }
 
 SKWASM_EXPORT uint32_t surface_rasterizeImage(Surface* surface,
@@ -245,9 +276,9 @@ SKWASM_EXPORT uint32_t surface_rasterizeImage(Surface* surface,
 }
 
 // This is used by the skwasm JS support code to call back into C++ when the
-// we finish creating the image bitmap, which is an asynchronous operation.
+// we finish creating the image bitmaps, which is an asynchronous operation.
 SKWASM_EXPORT void surface_onRenderComplete(Surface* surface,
                                             uint32_t callbackId,
-                                            SkwasmObject imageBitmap) {
-  return surface->onRenderComplete(callbackId, imageBitmap);
+                                            SkwasmObject imageBitmaps) {
+  return surface->onRenderComplete(callbackId, imageBitmaps);
 }
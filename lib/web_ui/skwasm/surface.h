@@ -61,10 +61,10 @@ class Surface {
 
   // Main thread only
   void dispose();
-  uint32_t renderPicture(SkPicture* picture);
+  uint32_t renderPictures(SkPicture** pictures, int count);
   uint32_t rasterizeImage(SkImage* image, ImageByteFormat format);
   void setCallbackHandler(CallbackHandler* callbackHandler);
-  void onRenderComplete(uint32_t callbackId, SkwasmObject imageBitmap);
+  void onRenderComplete(uint32_t callbackId, SkwasmObject imageBitmaps);
 
   // Any thread
   std::unique_ptr<TextureSourceWrapper> createTextureSourceWrapper(
@@ -76,7 +76,7 @@ class Surface {
   void _dispose();
   void _resizeCanvasToFit(int width, int height);
   void _recreateSurface();
-  void _renderPicture(const SkPicture* picture, uint32_t callbackId);
+  void _renderPictures(SkPicture** pictures, int count, uint32_t callbackId);
   void _rasterizeImage(SkImage* image,
                        ImageByteFormat format,
                        uint32_t callbackId);
@@ -99,9 +99,10 @@ class Surface {
   pthread_t _thread;
 
   static void fDispose(Surface* surface);
-  static void fRenderPicture(Surface* surface,
-                             SkPicture* picture,
-                             uint32_t callbackId);
+  static void fRenderPictures(Surface* surface,
+                              SkPicture** pictures,
+                              int count,
+                              uint32_t callbackId);
   static void fOnRenderComplete(Surface* surface,
                                 uint32_t callbackId,
                                 SkwasmObject imageBitmap);
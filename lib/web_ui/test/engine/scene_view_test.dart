@@ -23,21 +23,30 @@ class StubPictureRenderer implements PictureRenderer {
       width: 500, height: 500
   );
 
+  final List<int> renderedPictureCounts = <int>[];
+
   @override
-  Future<DomImageBitmap> renderPicture(ScenePicture picture) async {
-    final ui.Rect cullRect = picture.cullRect;
-    final DomImageBitmap bitmap = (await createImageBitmap(
-      scratchCanvasElement as JSAny,
-      (x: 0, y: 0, width: cullRect.width.toInt(), height: cullRect.height.toInt())
-    ).toDart)! as DomImageBitmap;
-    return bitmap;
+  Future<List<DomImageBitmap>> renderPictures(List<ScenePicture> pictures) async {
+    renderedPictureCounts.add(pictures.length);
+    final List<DomImageBitmap> bitmaps = <DomImageBitmap>[];
+    for (final ScenePicture picture in pictures) {
+      final ui.Rect cullRect = picture.cullRect;
+      final DomImageBitmap bitmap = (await createImageBitmap(
+        scratchCanvasElement as JSAny,
+        (x: 0, y: 0, width: cullRect.width.toInt(), height: cullRect.height.toInt())
+      ).toDart)! as DomImageBitmap;
+      bitmaps.add(bitmap);
+    }
+    return bitmaps;
   }
 }
 
 void testMain() {
   late EngineSceneView sceneView;
+  late StubPictureRenderer stubPictureRenderer;
   setUp(() {
-    sceneView = EngineSceneView(StubPictureRenderer());
+    stubPictureRenderer = StubPictureRenderer();
+    sceneView = EngineSceneView(stubPictureRenderer);
   });
 
   test('SceneView places canvas according to device-pixel ratio', () async {
@@ -101,4 +110,27 @@ void testMain() {
 
     debugOverrideDevicePixelRatio(null);
   });
+
+  test('SceneView renders all pictures of a scene in one batch', () async {
+    final PlatformView platformView = PlatformView(
+      1,
+      const ui.Size(100, 120),
+      const PlatformViewStyling(
+        position: PlatformViewPosition.offset(ui.Offset(50, 80)),
+      )
+    );
+    final EngineRootLayer rootLayer = EngineRootLayer();
+    rootLayer.slices.add(PictureSlice(StubPicture(const ui.Rect.fromLTWH(0, 0, 10, 10))));
+    rootLayer.slices.add(PlatformViewSlice(<PlatformView>[platformView], null));
+    rootLayer.slices.add(PictureSlice(StubPicture(const ui.Rect.fromLTWH(0, 0, 20, 20))));
+    final EngineScene scene = EngineScene(rootLayer);
+    await sceneView.renderScene(scene);
+
+    expect(stubPictureRenderer.renderedPictureCounts, <int>[2]);
+    final List<DomElement> children = sceneView.sceneElement.children.toList();
+    expect(children.length, 3);
+    expect(children[0].tagName, equalsIgnoringCase('flt-canvas-container'));
+    expect(children[1].tagName, equalsIgnoringCase('flt-platform-view-slot'));
+    expect(children[2].tagName, equalsIgnoringCase('flt-canvas-container'));
+  });
 }
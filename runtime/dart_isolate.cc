@@ -20,6 +20,7 @@
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/runtime/dart_vm_lifecycle.h"
 #include "flutter/runtime/isolate_configuration.h"
+#include "flutter/runtime/startup_profiler.h"
 #include "fml/message_loop_task_queues.h"
 #include "fml/task_source.h"
 #include "fml/time/time_point.h"
@@ -112,16 +113,21 @@ std::weak_ptr<DartIsolate> DartIsolate::CreateRunningRootIsolate(
       isolate_configuration->IsNullSafetyEnabled(*isolate_snapshot));
   isolate_flags.SetIsDontNeedSafe(isolate_snapshot->IsDontNeedSafe());
 
-  auto isolate = CreateRootIsolate(settings,                           //
-                                   isolate_snapshot,                   //
-                                   std::move(platform_configuration),  //
-                                   isolate_flags,                      //
-                                   isolate_create_callback,            //
-                                   isolate_shutdown_callback,          //
-                                   context,                            //
-                                   spawning_isolate                    //
-                                   )
-                     .lock();
+  std::shared_ptr<DartIsolate> isolate;
+  {
+    StartupProfiler::ScopedPhase startup_phase(
+        "DartIsolate::CreateRootIsolate", "ui");
+    isolate = CreateRootIsolate(settings,                           //
+                                isolate_snapshot,                   //
+                                std::move(platform_configuration),  //
+                                isolate_flags,                      //
+                                isolate_create_callback,            //
+                                isolate_shutdown_callback,          //
+                                context,                            //
+                                spawning_isolate                    //
+                                )
+                  .lock();
+  }
 
   if (!isolate) {
     FML_LOG(ERROR) << "Could not create root isolate.";
@@ -140,9 +146,13 @@ std::weak_ptr<DartIsolate> DartIsolate::CreateRunningRootIsolate(
     return {};
   }
 
-  if (!isolate_configuration->PrepareIsolate(*isolate.get())) {
-    FML_LOG(ERROR) << "Could not prepare isolate.";
-    return {};
+  {
+    StartupProfiler::ScopedPhase startup_phase("DartIsolate::PrepareIsolate",
+                                               "ui");
+    if (!isolate_configuration->PrepareIsolate(*isolate.get())) {
+      FML_LOG(ERROR) << "Could not prepare isolate.";
+      return {};
+    }
   }
 
   if (isolate->GetPhase() != DartIsolate::Phase::Ready) {
@@ -162,11 +172,15 @@ std::weak_ptr<DartIsolate> DartIsolate::CreateRunningRootIsolate(
     root_isolate_create_callback();
   }
 
-  if (!isolate->RunFromLibrary(std::move(dart_entrypoint_library),  //
-                               std::move(dart_entrypoint),          //
-                               dart_entrypoint_args)) {
-    FML_LOG(ERROR) << "Could not run the run main Dart entrypoint.";
-    return {};
+  {
+    StartupProfiler::ScopedPhase startup_phase("DartIsolate::RunFromLibrary",
+                                               "ui");
+    if (!isolate->RunFromLibrary(std::move(dart_entrypoint_library),  //
+                                 std::move(dart_entrypoint),          //
+                                 dart_entrypoint_args)) {
+      FML_LOG(ERROR) << "Could not run the run main Dart entrypoint.";
+      return {};
+    }
   }
 
   if (settings.root_isolate_shutdown_callback) {
@@ -769,6 +783,17 @@ Dart_Isolate DartIsolate::DartCreateAndStartServiceIsolate(
     return nullptr;
   }
 
+  if (settings.defer_vm_service_startup) {
+    // The VM requests the service isolate on one of its worker threads, so
+    // waiting here keeps the service isolate from competing with the root
+    // isolate and the first frame for CPU time.
+    if (!DartServiceIsolate::WaitForDeferredStartup(
+            fml::TimeDelta::FromSeconds(10))) {
+      FML_LOG(INFO) << "No frame was rasterized before the deferred VM Service "
+                       "startup timed out. Starting the VM Service.";
+    }
+  }
+
   flags->load_vmservice_library = true;
 
 #if (FLUTTER_RUNTIME_MODE != FLUTTER_RUNTIME_MODE_DEBUG)
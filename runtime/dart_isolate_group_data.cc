@@ -83,4 +83,19 @@ DartIsolateGroupData::GetPlatformMessageHandler(
              : it->second;
 }
 
+void DartIsolateGroupData::SetFontCollection(
+    int64_t root_isolate_token,
+    std::weak_ptr<txt::FontCollection> font_collection) {
+  std::scoped_lock lock(font_collections_mutex_);
+  font_collections_[root_isolate_token] = std::move(font_collection);
+}
+
+std::weak_ptr<txt::FontCollection> DartIsolateGroupData::GetFontCollection(
+    int64_t root_isolate_token) const {
+  std::scoped_lock lock(font_collections_mutex_);
+  auto it = font_collections_.find(root_isolate_token);
+  return it == font_collections_.end() ? std::weak_ptr<txt::FontCollection>()
+                                       : it->second;
+}
+
 }  // namespace flutter
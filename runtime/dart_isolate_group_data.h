@@ -65,6 +65,15 @@ class DartIsolateGroupData : public PlatformMessageHandlerStorage {
   std::weak_ptr<PlatformMessageHandler> GetPlatformMessageHandler(
       int64_t root_isolate_token) const override;
 
+  // |PlatformMessageHandlerStorage|
+  void SetFontCollection(
+      int64_t root_isolate_token,
+      std::weak_ptr<txt::FontCollection> font_collection) override;
+
+  // |PlatformMessageHandlerStorage|
+  std::weak_ptr<txt::FontCollection> GetFontCollection(
+      int64_t root_isolate_token) const override;
+
  private:
   const Settings settings_;
   const fml::RefPtr<const DartSnapshot> isolate_snapshot_;
@@ -77,6 +86,8 @@ class DartIsolateGroupData : public PlatformMessageHandlerStorage {
   std::map<int64_t, std::weak_ptr<PlatformMessageHandler>>
       platform_message_handlers_;
   mutable std::mutex platform_message_handlers_mutex_;
+  std::map<int64_t, std::weak_ptr<txt::FontCollection>> font_collections_;
+  mutable std::mutex font_collections_mutex_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(DartIsolateGroupData);
 };
@@ -5,10 +5,12 @@
 #include "flutter/runtime/dart_service_isolate.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cstring>
 
 #include "flutter/fml/logging.h"
 #include "flutter/fml/posix_wrappers.h"
+#include "flutter/fml/trace_event.h"
 #include "flutter/runtime/embedder_resources.h"
 #include "third_party/dart/runtime/include/dart_api.h"
 #include "third_party/tonic/converter/dart_converter.h"
@@ -54,6 +56,12 @@ std::mutex DartServiceIsolate::callbacks_mutex_;
 std::set<std::unique_ptr<DartServiceIsolate::DartVMServiceServerStateCallback>>
     DartServiceIsolate::callbacks_;
 
+std::mutex DartServiceIsolate::deferred_startup_mutex_;
+
+std::condition_variable DartServiceIsolate::deferred_startup_released_cv_;
+
+bool DartServiceIsolate::deferred_startup_released_ = false;
+
 void DartServiceIsolate::NotifyServerState(Dart_NativeArguments args) {
   Dart_Handle exception = nullptr;
   std::string uri =
@@ -122,6 +130,25 @@ bool DartServiceIsolate::RemoveServerStatusCallback(
   return true;
 }
 
+bool DartServiceIsolate::WaitForDeferredStartup(fml::TimeDelta timeout) {
+  TRACE_EVENT0("flutter", "DartServiceIsolate::WaitForDeferredStartup");
+  std::unique_lock lock(deferred_startup_mutex_);
+  return deferred_startup_released_cv_.wait_for(
+      lock, std::chrono::nanoseconds(timeout.ToNanoseconds()),
+      []() { return deferred_startup_released_; });
+}
+
+void DartServiceIsolate::ReleaseDeferredStartup() {
+  {
+    std::scoped_lock lock(deferred_startup_mutex_);
+    if (deferred_startup_released_) {
+      return;
+    }
+    deferred_startup_released_ = true;
+  }
+  deferred_startup_released_cv_.notify_all();
+}
+
 void DartServiceIsolate::Shutdown(Dart_NativeArguments args) {
   // NO-OP.
 }
@@ -5,12 +5,14 @@
 #ifndef FLUTTER_RUNTIME_DART_SERVICE_ISOLATE_H_
 #define FLUTTER_RUNTIME_DART_SERVICE_ISOLATE_H_
 
+#include <condition_variable>
 #include <functional>
 #include <mutex>
 #include <set>
 #include <string>
 
 #include "flutter/fml/compiler_specific.h"
+#include "flutter/fml/time/time_delta.h"
 #include "third_party/dart/runtime/include/dart_api.h"
 
 namespace flutter {
@@ -95,6 +97,30 @@ class DartServiceIsolate {
   ///
   static bool RemoveServerStatusCallback(CallbackHandle handle);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Blocks the calling thread until `ReleaseDeferredStartup` is
+  ///             called or the timeout expires. Used to hold back the creation
+  ///             of the service isolate, which the VM requests on one of its
+  ///             own worker threads, until the application has started up.
+  ///
+  ///             This method is thread safe.
+  ///
+  /// @param[in]  timeout  The longest time to wait, so that the VM Service
+  ///                      still starts when no frame is ever rasterized.
+  ///
+  /// @return     If the startup was released before the timeout expired.
+  ///
+  static bool WaitForDeferredStartup(fml::TimeDelta timeout);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Lets the service isolate start up. Threads already waiting in
+  ///             `WaitForDeferredStartup` are woken up, and later waits return
+  ///             immediately.
+  ///
+  ///             This method is thread safe.
+  ///
+  static void ReleaseDeferredStartup();
+
  private:
   // Native entries.
   static void NotifyServerState(Dart_NativeArguments args);
@@ -102,6 +128,10 @@ class DartServiceIsolate {
 
   static std::mutex callbacks_mutex_;
   static std::set<std::unique_ptr<DartVMServiceServerStateCallback>> callbacks_;
+
+  static std::mutex deferred_startup_mutex_;
+  static std::condition_variable deferred_startup_released_cv_;
+  static bool deferred_startup_released_;
 };
 
 }  // namespace flutter
@@ -176,13 +176,45 @@ static std::shared_ptr<const fml::Mapping> ResolveIsolateInstructions(
 #endif  // DART_SNAPSHOT_STATIC_LINK
 }
 
+// Prepares the pages of freshly resolved snapshot mappings before the VM first
+// touches them, as requested by the settings.
+static void AdviseSnapshotPages(
+    const Settings& settings,
+    SnapshotPageProfile::Region data_region,
+    const std::shared_ptr<const fml::Mapping>& data,
+    SnapshotPageProfile::Region instructions_region,
+    const std::shared_ptr<const fml::Mapping>& instructions) {
+  if (settings.enable_snapshot_huge_pages && instructions) {
+    SnapshotPageProfile::AdviseHugePages(*instructions);
+  }
+  if (settings.snapshot_page_profile_path.empty()) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "DartSnapshot::PrefetchPages");
+  auto profile =
+      SnapshotPageProfile::ReadFromFile(settings.snapshot_page_profile_path);
+  if (!profile.has_value()) {
+    return;
+  }
+  if (data) {
+    profile->Prefetch(data_region, *data);
+  }
+  if (instructions) {
+    profile->Prefetch(instructions_region, *instructions);
+  }
+}
+
 fml::RefPtr<const DartSnapshot> DartSnapshot::VMSnapshotFromSettings(
     const Settings& settings) {
   TRACE_EVENT0("flutter", "DartSnapshot::VMSnapshotFromSettings");
-  auto snapshot =
-      fml::MakeRefCounted<DartSnapshot>(ResolveVMData(settings),         //
-                                        ResolveVMInstructions(settings)  //
-      );
+  auto data = ResolveVMData(settings);
+  auto instructions = ResolveVMInstructions(settings);
+  AdviseSnapshotPages(settings, SnapshotPageProfile::Region::kVMData, data,
+                      SnapshotPageProfile::Region::kVMInstructions,
+                      instructions);
+  auto snapshot = fml::MakeRefCounted<DartSnapshot>(std::move(data),         //
+                                                    std::move(instructions)  //
+  );
   if (snapshot->IsValid()) {
     return snapshot;
   }
@@ -192,10 +224,14 @@ fml::RefPtr<const DartSnapshot> DartSnapshot::VMSnapshotFromSettings(
 fml::RefPtr<const DartSnapshot> DartSnapshot::IsolateSnapshotFromSettings(
     const Settings& settings) {
   TRACE_EVENT0("flutter", "DartSnapshot::IsolateSnapshotFromSettings");
-  auto snapshot =
-      fml::MakeRefCounted<DartSnapshot>(ResolveIsolateData(settings),         //
-                                        ResolveIsolateInstructions(settings)  //
-      );
+  auto data = ResolveIsolateData(settings);
+  auto instructions = ResolveIsolateInstructions(settings);
+  AdviseSnapshotPages(settings, SnapshotPageProfile::Region::kIsolateData,
+                      data, SnapshotPageProfile::Region::kIsolateInstructions,
+                      instructions);
+  auto snapshot = fml::MakeRefCounted<DartSnapshot>(std::move(data),         //
+                                                    std::move(instructions)  //
+  );
   if (snapshot->IsValid()) {
     return snapshot;
   }
@@ -276,4 +312,16 @@ bool DartSnapshot::IsNullSafetyEnabled(const fml::Mapping* kernel) const {
   );
 }
 
+void DartSnapshot::RecordResidentPages(
+    SnapshotPageProfile* profile,
+    SnapshotPageProfile::Region data_region,
+    SnapshotPageProfile::Region instructions_region) const {
+  if (data_) {
+    profile->RecordResidentPages(data_region, *data_);
+  }
+  if (instructions_) {
+    profile->RecordResidentPages(instructions_region, *instructions_);
+  }
+}
+
 }  // namespace flutter
@@ -11,6 +11,7 @@
 #include "flutter/common/settings.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
+#include "flutter/runtime/snapshot_page_profile.h"
 
 namespace flutter {
 
@@ -168,6 +169,20 @@ class DartSnapshot : public fml::RefCountedThreadSafe<DartSnapshot> {
   bool IsNullSafetyEnabled(
       const fml::Mapping* application_kernel_mapping) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Records the pages of the heap and instructions mappings that
+  ///             are currently resident in |profile|, so that they can be
+  ///             prefetched when the snapshot is mapped in a later run.
+  ///
+  /// @param[in]  profile              The profile to record the pages in.
+  /// @param[in]  data_region          The region of the heap mapping.
+  /// @param[in]  instructions_region  The region of the instructions mapping.
+  ///
+  void RecordResidentPages(
+      SnapshotPageProfile* profile,
+      SnapshotPageProfile::Region data_region,
+      SnapshotPageProfile::Region instructions_region) const;
+
  private:
   std::shared_ptr<const fml::Mapping> data_;
   std::shared_ptr<const fml::Mapping> instructions_;
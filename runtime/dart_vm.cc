@@ -18,6 +18,7 @@
 #include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/dart_ui.h"
 #include "flutter/runtime/dart_isolate.h"
+#include "flutter/runtime/dart_service_isolate.h"
 #include "flutter/runtime/dart_vm_initializer.h"
 #include "flutter/runtime/ptrace_check.h"
 #include "third_party/dart/runtime/include/bin/dart_io_api.h"
@@ -519,6 +520,10 @@ DartVM::~DartVM() {
     Dart_ExitIsolate();
   }
 
+  // The VM waits for the service isolate during cleanup, which must not still
+  // be waiting for its deferred startup.
+  DartServiceIsolate::ReleaseDeferredStartup();
+
   DartVMInitializer::Cleanup();
 
   dart::bin::CleanupDartIo();
@@ -63,7 +63,8 @@ std::unique_ptr<RuntimeController> RuntimeController::Spawn(
       std::move(image_decoder),       std::move(image_generator_registry),
       std::move(advisory_script_uri), std::move(advisory_script_entrypoint),
       context_.volatile_path_tracker, context_.concurrent_task_runner,
-      context_.enable_impeller};
+      context_.enable_impeller,
+      context_.animated_image_decode_ahead_frames};
   auto result =
       std::make_unique<RuntimeController>(p_client,                      //
                                           vm_,                           //
@@ -243,6 +244,25 @@ bool RuntimeController::ReportTimings(std::vector<int64_t> timings) {
   return false;
 }
 
+bool RuntimeController::RunIdleTasks(fml::TimeDelta deadline) {
+  if (auto* platform_configuration = GetPlatformConfigurationIfAvailable()) {
+    platform_configuration->RunIdleTasks(deadline);
+    return true;
+  }
+
+  return false;
+}
+
+bool RuntimeController::PrewarmIsolatePool(int size) {
+  if (auto* platform_configuration = GetPlatformConfigurationIfAvailable()) {
+    TRACE_EVENT0("flutter", "RuntimeController::PrewarmIsolatePool");
+    platform_configuration->PrewarmIsolatePool(size);
+    return true;
+  }
+
+  return false;
+}
+
 bool RuntimeController::NotifyIdle(fml::TimeDelta deadline) {
   if (deadline - fml::TimeDelta::FromMicroseconds(Dart_TimelineGetMicros()) <
       fml::TimeDelta::FromMilliseconds(1)) {
@@ -388,6 +408,11 @@ void RuntimeController::SetNeedsReportTimings(bool value) {
   client_.SetNeedsReportTimings(value);
 }
 
+// |PlatformConfigurationClient|
+void RuntimeController::SetPreferredFrameRate(double frames_per_second) {
+  client_.SetPreferredFrameRate(frames_per_second);
+}
+
 // |PlatformConfigurationClient|
 std::shared_ptr<const fml::Mapping>
 RuntimeController::GetPersistentIsolateData() {
@@ -468,6 +493,10 @@ bool RuntimeController::LaunchRootIsolate(
   strong_root_isolate->GetIsolateGroupData().SetPlatformMessageHandler(
       strong_root_isolate->GetRootIsolateToken(),
       client_.GetPlatformMessageHandler());
+  // Enable laying out text in background isolates.
+  strong_root_isolate->GetIsolateGroupData().SetFontCollection(
+      strong_root_isolate->GetRootIsolateToken(),
+      client_.GetFontCollection().GetFontCollection());
 
   // The root isolate ivar is weak.
   root_isolate_ = strong_root_isolate;
@@ -329,6 +329,27 @@ class RuntimeController : public PlatformConfigurationClient {
   ///
   bool ReportTimings(std::vector<int64_t> timings);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Spawns background isolates in the isolate group of the root
+  ///             isolate ahead of their use by `IsolatePool.run`.
+  ///
+  /// @param[in]  size  The number of isolates to keep warm.
+  ///
+  /// @return     If the root isolate was available to spawn the isolates.
+  ///
+  bool PrewarmIsolatePool(int size);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Runs the idle tasks scheduled by the root isolate until the
+  ///             deadline is near.
+  ///
+  /// @param[in]  deadline  The end of the idle period, in the clock of
+  ///                       `Dart_TimelineGetMicros`.
+  ///
+  /// @return     If the root isolate was available to run the tasks.
+  ///
+  bool RunIdleTasks(fml::TimeDelta deadline);
+
   //----------------------------------------------------------------------------
   /// @brief      Notify the Dart VM that no frame workloads are expected on the
   ///             UI task runner till the specified deadline. The VM uses this
@@ -679,6 +700,9 @@ class RuntimeController : public PlatformConfigurationClient {
   // |PlatformConfigurationClient|
   void SetNeedsReportTimings(bool value) override;
 
+  // |PlatformConfigurationClient|
+  void SetPreferredFrameRate(double frames_per_second) override;
+
   // |PlatformConfigurationClient|
   std::unique_ptr<std::vector<std::string>> ComputePlatformResolvedLocale(
       const std::vector<std::string>& supported_locale_data) override;
@@ -45,6 +45,8 @@ class RuntimeDelegate {
 
   virtual void SetNeedsReportTimings(bool value) = 0;
 
+  virtual void SetPreferredFrameRate(double frames_per_second) = 0;
+
   virtual std::unique_ptr<std::vector<std::string>>
   ComputePlatformResolvedLocale(
       const std::vector<std::string>& supported_locale_data) = 0;
@@ -42,6 +42,14 @@ const std::string_view
         "_flutter.renderFrameWithRasterStats";
 const std::string_view ServiceProtocol::kReloadAssetFonts =
     "_flutter.reloadAssetFonts";
+const std::string_view ServiceProtocol::kGetStartupProfileExtensionName =
+    "_flutter.getStartupProfile";
+const std::string_view ServiceProtocol::kGetLayerRasterProfileExtensionName =
+    "_flutter.getLayerRasterProfile";
+const std::string_view ServiceProtocol::kGetFlightRecordExtensionName =
+    "_flutter.getFlightRecord";
+const std::string_view ServiceProtocol::kGetTaskQueueStatsExtensionName =
+    "_flutter.getTaskQueueStats";
 
 static constexpr std::string_view kViewIdPrefx = "_flutterView/";
 static constexpr std::string_view kListViewsExtensionName =
@@ -63,6 +71,10 @@ ServiceProtocol::ServiceProtocol()
           kEstimateRasterCacheMemoryExtensionName,
           kRenderFrameWithRasterStatsExtensionName,
           kReloadAssetFonts,
+          kGetStartupProfileExtensionName,
+          kGetLayerRasterProfileExtensionName,
+          kGetFlightRecordExtensionName,
+          kGetTaskQueueStatsExtensionName,
       }),
       handlers_mutex_(fml::SharedMutex::Create()) {}
 
@@ -31,6 +31,10 @@ class ServiceProtocol {
   static const std::string_view kEstimateRasterCacheMemoryExtensionName;
   static const std::string_view kRenderFrameWithRasterStatsExtensionName;
   static const std::string_view kReloadAssetFonts;
+  static const std::string_view kGetStartupProfileExtensionName;
+  static const std::string_view kGetLayerRasterProfileExtensionName;
+  static const std::string_view kGetFlightRecordExtensionName;
+  static const std::string_view kGetTaskQueueStatsExtensionName;
 
   class Handler {
    public:
@@ -0,0 +1,296 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/runtime/snapshot_page_profile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/paths.h"
+
+#if FML_OS_ANDROID || FML_OS_LINUX
+#include <link.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace flutter {
+
+namespace {
+
+constexpr char kProfileMagic[4] = {'F', 'S', 'P', 'P'};
+constexpr uint32_t kProfileVersion = 1u;
+
+size_t GetPageSize() {
+#if FML_OS_ANDROID || FML_OS_LINUX
+  return static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+#else
+  return 4096u;
+#endif
+}
+
+#if FML_OS_ANDROID || FML_OS_LINUX
+
+struct Extent {
+  uint8_t* start;
+  size_t size;
+};
+
+struct SegmentSearch {
+  uintptr_t address;
+  size_t size;
+};
+
+// Snapshots found through symbols have a size of zero. They extend no further
+// than the end of the loaded segment containing the symbol.
+std::optional<Extent> GetExtent(const fml::Mapping& mapping) {
+  auto* start = const_cast<uint8_t*>(mapping.GetMapping());
+  if (start == nullptr) {
+    return std::nullopt;
+  }
+  if (mapping.GetSize() > 0u) {
+    return Extent{start, mapping.GetSize()};
+  }
+  SegmentSearch search = {reinterpret_cast<uintptr_t>(start), 0u};
+  ::dl_iterate_phdr(
+      [](struct dl_phdr_info* info, size_t, void* data) -> int {
+        auto* search = static_cast<SegmentSearch*>(data);
+        for (size_t i = 0; i < info->dlpi_phnum; i++) {
+          const auto& header = info->dlpi_phdr[i];
+          if (header.p_type != PT_LOAD) {
+            continue;
+          }
+          const uintptr_t begin = info->dlpi_addr + header.p_vaddr;
+          const uintptr_t end = begin + header.p_memsz;
+          if (search->address >= begin && search->address < end) {
+            search->size = end - search->address;
+            return 1;
+          }
+        }
+        return 0;
+      },
+      &search);
+  if (search.size == 0u) {
+    return std::nullopt;
+  }
+  return Extent{start, search.size};
+}
+
+#endif  // FML_OS_ANDROID || FML_OS_LINUX
+
+template <typename T>
+void Append(std::vector<uint8_t>& buffer, const T& value) {
+  const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+bool Read(const uint8_t*& cursor, const uint8_t* end, T* value) {
+  if (static_cast<size_t>(end - cursor) < sizeof(T)) {
+    return false;
+  }
+  memcpy(value, cursor, sizeof(T));
+  cursor += sizeof(T);
+  return true;
+}
+
+}  // namespace
+
+SnapshotPageProfile::SnapshotPageProfile() : page_size_(GetPageSize()) {}
+
+SnapshotPageProfile::~SnapshotPageProfile() = default;
+
+std::optional<SnapshotPageProfile> SnapshotPageProfile::ReadFromFile(
+    const std::string& path) {
+  auto mapping = fml::FileMapping::CreateReadOnly(path);
+  if (!mapping) {
+    return std::nullopt;
+  }
+  return Deserialize(*mapping);
+}
+
+bool SnapshotPageProfile::WriteToFile(const std::string& path) const {
+  auto directory_path = fml::paths::GetDirectoryName(path);
+  auto file_name = path.substr(path.find_last_of("/\\") + 1);
+  auto directory =
+      fml::OpenDirectory(directory_path.empty() ? "." : directory_path.c_str(),
+                         false, fml::FilePermission::kReadWrite);
+  if (!directory.is_valid()) {
+    FML_LOG(ERROR) << "Could not open the directory of the snapshot page "
+                      "profile at "
+                   << path << ".";
+    return false;
+  }
+  return fml::WriteAtomically(directory, file_name.c_str(),
+                              fml::DataMapping(Serialize()));
+}
+
+std::optional<SnapshotPageProfile> SnapshotPageProfile::Deserialize(
+    const fml::Mapping& mapping) {
+  const uint8_t* cursor = mapping.GetMapping();
+  if (cursor == nullptr) {
+    return std::nullopt;
+  }
+  const uint8_t* end = cursor + mapping.GetSize();
+
+  char magic[sizeof(kProfileMagic)];
+  uint32_t version;
+  uint32_t page_size;
+  uint32_t region_count;
+  if (!Read(cursor, end, &magic) ||
+      memcmp(magic, kProfileMagic, sizeof(magic)) != 0 ||
+      !Read(cursor, end, &version) || version != kProfileVersion ||
+      !Read(cursor, end, &page_size) || !Read(cursor, end, &region_count)) {
+    return std::nullopt;
+  }
+
+  SnapshotPageProfile profile;
+  // A profile recorded with a different page size is of no use.
+  if (page_size != profile.page_size_) {
+    return std::nullopt;
+  }
+  for (uint32_t i = 0; i < region_count; i++) {
+    Region region;
+    RegionProfile region_profile;
+    uint32_t range_count;
+    if (!Read(cursor, end, &region) ||
+        !Read(cursor, end, &region_profile.size) ||
+        !Read(cursor, end, &range_count) ||
+        static_cast<size_t>(end - cursor) / sizeof(PageRange) < range_count) {
+      return std::nullopt;
+    }
+    region_profile.ranges.resize(range_count);
+    for (auto& range : region_profile.ranges) {
+      Read(cursor, end, &range);
+    }
+    profile.regions_[region] = std::move(region_profile);
+  }
+  return profile;
+}
+
+std::vector<uint8_t> SnapshotPageProfile::Serialize() const {
+  std::vector<uint8_t> buffer;
+  Append(buffer, kProfileMagic);
+  Append(buffer, kProfileVersion);
+  Append(buffer, static_cast<uint32_t>(page_size_));
+  Append(buffer, static_cast<uint32_t>(regions_.size()));
+  for (const auto& [region, region_profile] : regions_) {
+    Append(buffer, region);
+    Append(buffer, region_profile.size);
+    Append(buffer, static_cast<uint32_t>(region_profile.ranges.size()));
+    for (const auto& range : region_profile.ranges) {
+      Append(buffer, range);
+    }
+  }
+  return buffer;
+}
+
+bool SnapshotPageProfile::RecordResidentPages(Region region,
+                                              const fml::Mapping& mapping) {
+#if FML_OS_ANDROID || FML_OS_LINUX
+  auto extent = GetExtent(mapping);
+  if (!extent.has_value()) {
+    return false;
+  }
+  auto* base = reinterpret_cast<uint8_t*>(
+      reinterpret_cast<uintptr_t>(extent->start) & ~(page_size_ - 1u));
+  const size_t length = extent->start + extent->size - base;
+  std::vector<unsigned char> residency((length + page_size_ - 1u) /
+                                       page_size_);
+  if (::mincore(base, length, residency.data()) != 0) {
+    FML_DLOG(ERROR) << "Could not query the residency of snapshot pages.";
+    return false;
+  }
+
+  RegionProfile region_profile;
+  region_profile.size = extent->size;
+  for (size_t page = 0; page < residency.size(); page++) {
+    if ((residency[page] & 1u) == 0u) {
+      continue;
+    }
+    auto& ranges = region_profile.ranges;
+    if (!ranges.empty() &&
+        ranges.back().first_page + ranges.back().page_count == page) {
+      ranges.back().page_count++;
+    } else {
+      ranges.push_back({static_cast<uint32_t>(page), 1u});
+    }
+  }
+  regions_[region] = std::move(region_profile);
+  return true;
+#else
+  return false;
+#endif  // FML_OS_ANDROID || FML_OS_LINUX
+}
+
+size_t SnapshotPageProfile::Prefetch(Region region,
+                                     const fml::Mapping& mapping) const {
+#if FML_OS_ANDROID || FML_OS_LINUX
+  auto found = regions_.find(region);
+  if (found == regions_.end()) {
+    return 0u;
+  }
+  auto extent = GetExtent(mapping);
+  if (!extent.has_value() || extent->size != found->second.size) {
+    return 0u;
+  }
+  auto* base = reinterpret_cast<uint8_t*>(
+      reinterpret_cast<uintptr_t>(extent->start) & ~(page_size_ - 1u));
+  const size_t page_count =
+      (extent->start + extent->size - base + page_size_ - 1u) / page_size_;
+  size_t prefetched = 0u;
+  for (const auto& range : found->second.ranges) {
+    if (range.first_page >= page_count) {
+      break;
+    }
+    const size_t count =
+        std::min<size_t>(range.page_count, page_count - range.first_page);
+    if (::madvise(base + range.first_page * page_size_, count * page_size_,
+                  MADV_WILLNEED) == 0) {
+      prefetched += count * page_size_;
+    }
+  }
+  return prefetched;
+#else
+  return 0u;
+#endif  // FML_OS_ANDROID || FML_OS_LINUX
+}
+
+bool SnapshotPageProfile::AdviseHugePages(const fml::Mapping& mapping) {
+#if (FML_OS_ANDROID || FML_OS_LINUX) && defined(MADV_HUGEPAGE)
+  constexpr uintptr_t kHugePageSize = 2u * 1024u * 1024u;
+  auto extent = GetExtent(mapping);
+  if (!extent.has_value()) {
+    return false;
+  }
+  const auto start = reinterpret_cast<uintptr_t>(extent->start);
+  const uintptr_t begin = (start + kHugePageSize - 1u) & ~(kHugePageSize - 1u);
+  const uintptr_t end = (start + extent->size) & ~(kHugePageSize - 1u);
+  if (begin >= end) {
+    return false;
+  }
+  return ::madvise(reinterpret_cast<void*>(begin), end - begin,
+                   MADV_HUGEPAGE) == 0;
+#else
+  return false;
+#endif
+}
+
+size_t SnapshotPageProfile::GetRecordedPageCount(Region region) const {
+  auto found = regions_.find(region);
+  if (found == regions_.end()) {
+    return 0u;
+  }
+  size_t count = 0u;
+  for (const auto& range : found->second.ranges) {
+    count += range.page_count;
+  }
+  return count;
+}
+
+}  // namespace flutter
@@ -0,0 +1,101 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_RUNTIME_SNAPSHOT_PAGE_PROFILE_H_
+#define FLUTTER_RUNTIME_SNAPSHOT_PAGE_PROFILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/mapping.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      The pages of the Dart snapshot mappings that were resident in
+///             memory once a previous run of the application had started up.
+///
+///             Prefetching these pages when the snapshots are mapped replaces
+///             the page faults taken by the first execution of the snapshot
+///             with a few large reads issued ahead of time.
+///
+///             Page residency can only be queried on Linux and Android. On
+///             other platforms recording and prefetching do nothing.
+///
+class SnapshotPageProfile {
+ public:
+  enum class Region : uint32_t {
+    kVMData,
+    kVMInstructions,
+    kIsolateData,
+    kIsolateInstructions,
+  };
+
+  SnapshotPageProfile();
+
+  ~SnapshotPageProfile();
+
+  static std::optional<SnapshotPageProfile> ReadFromFile(
+      const std::string& path);
+
+  bool WriteToFile(const std::string& path) const;
+
+  static std::optional<SnapshotPageProfile> Deserialize(
+      const fml::Mapping& mapping);
+
+  std::vector<uint8_t> Serialize() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the pages of |mapping| that are currently resident as
+  ///             the pages of |region|.
+  ///
+  /// @return     Whether the residency of the pages could be queried.
+  ///
+  bool RecordResidentPages(Region region, const fml::Mapping& mapping);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Asks the kernel to read the recorded pages of |region| of
+  ///             |mapping| ahead of their use. Nothing is prefetched if the
+  ///             mapping has a different size than the one the profile was
+  ///             recorded for, for example after an update of the application.
+  ///
+  /// @return     The number of bytes that were prefetched.
+  ///
+  size_t Prefetch(Region region, const fml::Mapping& mapping) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Asks the kernel to back the parts of |mapping| that are
+  ///             aligned to huge pages with transparent huge pages, to reduce
+  ///             the TLB misses of executing the instructions. This only has
+  ///             an effect on kernels that support huge pages for file backed
+  ///             mappings.
+  ///
+  /// @return     Whether the advice was accepted.
+  ///
+  static bool AdviseHugePages(const fml::Mapping& mapping);
+
+  size_t GetRecordedPageCount(Region region) const;
+
+ private:
+  struct PageRange {
+    uint32_t first_page;
+    uint32_t page_count;
+  };
+
+  struct RegionProfile {
+    uint64_t size = 0;
+    std::vector<PageRange> ranges;
+  };
+
+  size_t page_size_;
+  std::map<Region, RegionProfile> regions_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_RUNTIME_SNAPSHOT_PAGE_PROFILE_H_
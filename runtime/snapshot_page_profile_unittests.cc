@@ -0,0 +1,72 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/runtime/snapshot_page_profile.h"
+
+#include "flutter/fml/build_config.h"
+#include "gtest/gtest.h"
+
+#if FML_OS_ANDROID || FML_OS_LINUX
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace flutter {
+namespace testing {
+
+using Region = SnapshotPageProfile::Region;
+
+TEST(SnapshotPageProfileTest, RejectsMalformedProfiles) {
+  const uint8_t garbage[] = {'F', 'S', 'P', 'X', 1, 0, 0, 0};
+  EXPECT_FALSE(SnapshotPageProfile::Deserialize(
+                   fml::NonOwnedMapping(garbage, sizeof(garbage)))
+                   .has_value());
+
+  // A truncated profile is rejected.
+  auto bytes = SnapshotPageProfile().Serialize();
+  bytes.pop_back();
+  EXPECT_FALSE(SnapshotPageProfile::Deserialize(
+                   fml::NonOwnedMapping(bytes.data(), bytes.size()))
+                   .has_value());
+}
+
+#if FML_OS_ANDROID || FML_OS_LINUX
+
+TEST(SnapshotPageProfileTest, RecordsAndPrefetchesResidentPages) {
+  const size_t page_size = ::sysconf(_SC_PAGESIZE);
+  const size_t size = 8 * page_size;
+  void* memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  ASSERT_NE(memory, MAP_FAILED);
+  auto* pages = static_cast<uint8_t*>(memory);
+  pages[1 * page_size] = 1;
+  pages[2 * page_size] = 1;
+  pages[5 * page_size] = 1;
+  fml::NonOwnedMapping mapping(pages, size);
+
+  SnapshotPageProfile profile;
+  ASSERT_TRUE(profile.RecordResidentPages(Region::kIsolateData, mapping));
+  EXPECT_EQ(profile.GetRecordedPageCount(Region::kIsolateData), 3u);
+  EXPECT_EQ(profile.GetRecordedPageCount(Region::kVMData), 0u);
+
+  auto bytes = profile.Serialize();
+  auto restored = SnapshotPageProfile::Deserialize(
+      fml::NonOwnedMapping(bytes.data(), bytes.size()));
+  ASSERT_TRUE(restored.has_value());
+  EXPECT_EQ(restored->GetRecordedPageCount(Region::kIsolateData), 3u);
+  EXPECT_EQ(restored->Prefetch(Region::kIsolateData, mapping),
+            3 * page_size);
+  EXPECT_EQ(restored->Prefetch(Region::kVMData, mapping), 0u);
+
+  // The profile doesn't apply to a snapshot of a different size.
+  fml::NonOwnedMapping smaller(pages, size - page_size);
+  EXPECT_EQ(restored->Prefetch(Region::kIsolateData, smaller), 0u);
+
+  ::munmap(memory, size);
+}
+
+#endif  // FML_OS_ANDROID || FML_OS_LINUX
+
+}  // namespace testing
+}  // namespace flutter
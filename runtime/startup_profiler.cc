@@ -0,0 +1,216 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#define RAPIDJSON_HAS_STDSTRING 1
+
+#include "flutter/runtime/startup_profiler.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "flutter/fml/build_config.h"
+
+#if defined(FML_OS_WIN)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+namespace flutter {
+
+StartupProfiler::ScopedPhase::ScopedPhase(std::string name, std::string thread)
+    : enabled_(StartupProfiler::GetInstance().IsRecording()) {
+  if (!enabled_) {
+    return;
+  }
+  name_ = std::move(name);
+  thread_ = std::move(thread);
+  start_cpu_time_ = GetCurrentThreadCPUTime();
+  start_ = fml::TimePoint::Now();
+}
+
+StartupProfiler::ScopedPhase::~ScopedPhase() {
+  if (!enabled_) {
+    return;
+  }
+  const auto end = fml::TimePoint::Now();
+  std::optional<fml::TimeDelta> cpu_time;
+  if (auto end_cpu_time = GetCurrentThreadCPUTime();
+      end_cpu_time.has_value() && start_cpu_time_.has_value()) {
+    cpu_time = end_cpu_time.value() - start_cpu_time_.value();
+  }
+  StartupProfiler::GetInstance().RecordPhase({
+      .name = std::move(name_),
+      .thread = std::move(thread_),
+      .start = start_,
+      .end = end,
+      .cpu_time = cpu_time,
+  });
+}
+
+StartupProfiler& StartupProfiler::GetInstance() {
+  static StartupProfiler profiler;
+  return profiler;
+}
+
+StartupProfiler::StartupProfiler() = default;
+
+StartupProfiler::~StartupProfiler() = default;
+
+void StartupProfiler::Enable() {
+  std::scoped_lock lock(mutex_);
+  if (!is_complete_) {
+    is_recording_ = true;
+  }
+}
+
+bool StartupProfiler::IsRecording() const {
+  return is_recording_;
+}
+
+void StartupProfiler::RecordPhase(Phase phase) {
+  std::scoped_lock lock(mutex_);
+  if (!is_recording_) {
+    return;
+  }
+  phases_.push_back(std::move(phase));
+}
+
+void StartupProfiler::Complete() {
+  std::scoped_lock lock(mutex_);
+  if (is_recording_) {
+    is_recording_ = false;
+    is_complete_ = true;
+  }
+}
+
+std::vector<StartupProfiler::Phase> StartupProfiler::GetPhases() const {
+  std::scoped_lock lock(mutex_);
+  return phases_;
+}
+
+void StartupProfiler::WriteReport(rapidjson::Document* response) const {
+  bool is_complete;
+  std::vector<Phase> phases;
+  {
+    std::scoped_lock lock(mutex_);
+    is_complete = is_complete_;
+    phases = phases_;
+  }
+  std::stable_sort(phases.begin(), phases.end(),
+                   [](const Phase& a, const Phase& b) {
+                     return a.start < b.start;
+                   });
+
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "StartupProfile", allocator);
+  response->AddMember("complete", is_complete, allocator);
+
+  fml::TimePoint origin;
+  fml::TimePoint end;
+  if (!phases.empty()) {
+    origin = phases.front().start;
+    end = phases.front().end;
+    for (const auto& phase : phases) {
+      end = std::max(end, phase.end);
+    }
+  }
+  response->AddMember<int64_t>("totalMicros",
+                               (end - origin).ToMicroseconds(), allocator);
+
+  rapidjson::Value phases_json(rapidjson::kArrayType);
+  for (const auto& phase : phases) {
+    rapidjson::Value phase_json(rapidjson::kObjectType);
+    phase_json.AddMember("name", rapidjson::Value(phase.name, allocator),
+                         allocator);
+    phase_json.AddMember("thread", rapidjson::Value(phase.thread, allocator),
+                         allocator);
+    phase_json.AddMember<int64_t>(
+        "startMicros", (phase.start - origin).ToMicroseconds(), allocator);
+    phase_json.AddMember<int64_t>(
+        "wallMicros", (phase.end - phase.start).ToMicroseconds(), allocator);
+    if (phase.cpu_time.has_value()) {
+      phase_json.AddMember<int64_t>(
+          "cpuMicros", phase.cpu_time->ToMicroseconds(), allocator);
+    }
+    phases_json.PushBack(phase_json, allocator);
+  }
+  response->AddMember("phases", phases_json, allocator);
+
+  // The time on the critical path that isn't covered by its phases was spent
+  // outside of the recorded phases, for example in the embedder.
+  rapidjson::Value critical_path_json(rapidjson::kArrayType);
+  fml::TimeDelta critical_path_time;
+  for (auto index : ComputeCriticalPath(phases)) {
+    critical_path_json.PushBack(static_cast<uint64_t>(index), allocator);
+    critical_path_time =
+        critical_path_time + (phases[index].end - phases[index].start);
+  }
+  response->AddMember("criticalPath", critical_path_json, allocator);
+  response->AddMember<int64_t>("criticalPathMicros",
+                               critical_path_time.ToMicroseconds(), allocator);
+}
+
+std::vector<size_t> StartupProfiler::ComputeCriticalPath(
+    const std::vector<Phase>& phases) {
+  // Of the phases ending at the same time, prefer the longest one.
+  auto ends_later = [&phases](size_t a, size_t b) {
+    if (phases[a].end != phases[b].end) {
+      return phases[a].end > phases[b].end;
+    }
+    return phases[a].start < phases[b].start;
+  };
+
+  std::vector<size_t> path;
+  std::optional<size_t> current;
+  for (size_t i = 0; i < phases.size(); i++) {
+    if (!current.has_value() || ends_later(i, current.value())) {
+      current = i;
+    }
+  }
+  while (current.has_value()) {
+    path.push_back(current.value());
+    const auto start = phases[current.value()].start;
+    current = std::nullopt;
+    for (size_t i = 0; i < phases.size(); i++) {
+      if (phases[i].end <= start && phases[i].start < start &&
+          (!current.has_value() || ends_later(i, current.value()))) {
+        current = i;
+      }
+    }
+  }
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+std::optional<fml::TimeDelta> StartupProfiler::GetCurrentThreadCPUTime() {
+#if defined(FML_OS_WIN)
+  FILETIME creation_time;
+  FILETIME exit_time;
+  FILETIME kernel_time;
+  FILETIME user_time;
+  if (!::GetThreadTimes(::GetCurrentThread(), &creation_time, &exit_time,
+                        &kernel_time, &user_time)) {
+    return std::nullopt;
+  }
+  auto to_ticks = [](const FILETIME& time) {
+    return (static_cast<int64_t>(time.dwHighDateTime) << 32) |
+           time.dwLowDateTime;
+  };
+  // FILETIME ticks are 100 nanoseconds.
+  return fml::TimeDelta::FromNanoseconds(
+      (to_ticks(kernel_time) + to_ticks(user_time)) * 100);
+#elif defined(CLOCK_THREAD_CPUTIME_ID)
+  struct timespec ts;
+  if (::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+    return std::nullopt;
+  }
+  return fml::TimeDelta::FromTimespec(ts);
+#else
+  return std::nullopt;
+#endif
+}
+
+}  // namespace flutter
@@ -0,0 +1,128 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_RUNTIME_STARTUP_PROFILER_H_
+#define FLUTTER_RUNTIME_STARTUP_PROFILER_H_
+
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+#include "rapidjson/document.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Records the phases of the startup of the first shell in the
+///             process, from the initialization of the engine to the first
+///             rasterized frame, with the thread, wall time and CPU time of
+///             each phase.
+///
+///             Recording is enabled with the `--trace-startup` switch. The
+///             report, including the critical path through the phases, is
+///             available through the `_flutter.getStartupProfile` service
+///             protocol extension, so that startup can be analyzed on devices
+///             without systrace.
+///
+class StartupProfiler {
+ public:
+  struct Phase {
+    std::string name;
+    /// The name of the task runner the phase ran on.
+    std::string thread;
+    fml::TimePoint start;
+    fml::TimePoint end;
+    /// The CPU time of the thread during the phase, if it could be measured.
+    std::optional<fml::TimeDelta> cpu_time;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records a phase from its construction to its destruction on
+  ///             the current thread. Does nothing if the profiler isn't
+  ///             recording.
+  ///
+  class ScopedPhase {
+   public:
+    ScopedPhase(std::string name, std::string thread);
+
+    ~ScopedPhase();
+
+   private:
+    const bool enabled_;
+    std::string name_;
+    std::string thread_;
+    fml::TimePoint start_;
+    std::optional<fml::TimeDelta> start_cpu_time_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(ScopedPhase);
+  };
+
+  static StartupProfiler& GetInstance();
+
+  StartupProfiler();
+
+  ~StartupProfiler();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Starts recording phases. Has no effect if the profiler is
+  ///             already recording or has completed its profile.
+  ///
+  void Enable();
+
+  bool IsRecording() const;
+
+  void RecordPhase(Phase phase);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Completes the profile. Phases recorded afterwards, such as
+  ///             those of shells spawned later, are ignored.
+  ///
+  void Complete();
+
+  std::vector<Phase> GetPhases() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Writes the report of the recorded phases to |response|.
+  ///
+  ///             Phase start times are relative to the start of the first
+  ///             phase. All times are in microseconds.
+  ///
+  void WriteReport(rapidjson::Document* response) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Computes the critical path through |phases|: the chain of
+  ///             phases ending with the last phase to end in which each phase
+  ///             is the last one to end before the next one starts. Phases
+  ///             that overlap a phase of the path ran concurrently with it and
+  ///             didn't delay the end of startup.
+  ///
+  /// @return     The indices of the phases in the critical path, in the order
+  ///             they ran.
+  ///
+  static std::vector<size_t> ComputeCriticalPath(
+      const std::vector<Phase>& phases);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The CPU time consumed by the current thread, if the platform
+  ///             can measure it.
+  ///
+  static std::optional<fml::TimeDelta> GetCurrentThreadCPUTime();
+
+ private:
+  std::atomic<bool> is_recording_ = false;
+  mutable std::mutex mutex_;
+  bool is_complete_ = false;
+  std::vector<Phase> phases_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(StartupProfiler);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_RUNTIME_STARTUP_PROFILER_H_
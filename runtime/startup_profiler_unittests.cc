@@ -0,0 +1,105 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/runtime/startup_profiler.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+StartupProfiler::Phase MakePhase(const std::string& name,
+                                 const std::string& thread,
+                                 int64_t start_micros,
+                                 int64_t end_micros) {
+  return {
+      .name = name,
+      .thread = thread,
+      .start = fml::TimePoint::FromEpochDelta(
+          fml::TimeDelta::FromMicroseconds(start_micros)),
+      .end = fml::TimePoint::FromEpochDelta(
+          fml::TimeDelta::FromMicroseconds(end_micros)),
+  };
+}
+
+}  // namespace
+
+TEST(StartupProfilerTest, CriticalPathSkipsConcurrentPhases) {
+  std::vector<StartupProfiler::Phase> phases = {
+      MakePhase("DartVM::Create", "platform", 0, 100),
+      MakePhase("Rasterizer::Create", "raster", 110, 130),
+      MakePhase("ShellIOManager::Create", "io", 110, 150),
+      MakePhase("Engine::Create", "ui", 120, 140),
+      MakePhase("DartIsolate::RunFromLibrary", "ui", 160, 300),
+      MakePhase("Rasterizer::Setup", "raster", 170, 250),
+      MakePhase("FirstFrame::Build", "ui", 310, 320),
+      MakePhase("FirstFrame::Raster", "raster", 325, 340),
+  };
+  EXPECT_EQ(StartupProfiler::ComputeCriticalPath(phases),
+            (std::vector<size_t>{0, 2, 4, 6, 7}));
+  EXPECT_TRUE(StartupProfiler::ComputeCriticalPath({}).empty());
+}
+
+TEST(StartupProfilerTest, RecordsPhasesUntilComplete) {
+  StartupProfiler profiler;
+  profiler.RecordPhase(MakePhase("Ignored", "platform", 0, 1));
+  EXPECT_FALSE(profiler.IsRecording());
+
+  profiler.Enable();
+  EXPECT_TRUE(profiler.IsRecording());
+  profiler.RecordPhase(MakePhase("DartVM::Create", "platform", 10, 20));
+  profiler.Complete();
+  EXPECT_FALSE(profiler.IsRecording());
+  profiler.RecordPhase(MakePhase("Ignored", "platform", 30, 40));
+
+  // A completed profile is not recorded again.
+  profiler.Enable();
+  EXPECT_FALSE(profiler.IsRecording());
+
+  auto phases = profiler.GetPhases();
+  ASSERT_EQ(phases.size(), 1u);
+  EXPECT_EQ(phases[0].name, "DartVM::Create");
+}
+
+TEST(StartupProfilerTest, WritesReport) {
+  StartupProfiler profiler;
+  profiler.Enable();
+  auto engine_phase = MakePhase("Engine::Create", "ui", 1120, 1140);
+  engine_phase.cpu_time = fml::TimeDelta::FromMicroseconds(15);
+  profiler.RecordPhase(engine_phase);
+  profiler.RecordPhase(MakePhase("DartVM::Create", "platform", 1000, 1100));
+  profiler.Complete();
+
+  rapidjson::Document report;
+  profiler.WriteReport(&report);
+  ASSERT_TRUE(report.IsObject());
+  EXPECT_STREQ(report["type"].GetString(), "StartupProfile");
+  EXPECT_TRUE(report["complete"].GetBool());
+  EXPECT_EQ(report["totalMicros"].GetInt64(), 140);
+  EXPECT_EQ(report["criticalPathMicros"].GetInt64(), 120);
+
+  const auto& phases = report["phases"];
+  ASSERT_EQ(phases.Size(), 2u);
+  EXPECT_STREQ(phases[0]["name"].GetString(), "DartVM::Create");
+  EXPECT_STREQ(phases[0]["thread"].GetString(), "platform");
+  EXPECT_EQ(phases[0]["startMicros"].GetInt64(), 0);
+  EXPECT_EQ(phases[0]["wallMicros"].GetInt64(), 100);
+  EXPECT_FALSE(phases[0].HasMember("cpuMicros"));
+  EXPECT_STREQ(phases[1]["name"].GetString(), "Engine::Create");
+  EXPECT_EQ(phases[1]["startMicros"].GetInt64(), 120);
+  EXPECT_EQ(phases[1]["cpuMicros"].GetInt64(), 15);
+
+  const auto& critical_path = report["criticalPath"];
+  ASSERT_EQ(critical_path.Size(), 2u);
+  EXPECT_EQ(critical_path[0].GetUint64(), 0u);
+  EXPECT_EQ(critical_path[1].GetUint64(), 1u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,7 +4,10 @@
 
 #include "flutter/shell/common/animator.h"
 
+#include <algorithm>
+
 #include "flutter/flow/frame_timings.h"
+#include "flutter/fml/make_copyable.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
@@ -23,24 +26,38 @@ constexpr fml::TimeDelta kNotifyIdleTaskWaitTime =
 
 Animator::Animator(Delegate& delegate,
                    const TaskRunners& task_runners,
-                   std::unique_ptr<VsyncWaiter> waiter)
+                   std::unique_ptr<VsyncWaiter> waiter,
+                   bool enable_predictive_frame_scheduling,
+                   uint32_t max_frames_in_flight)
     : delegate_(delegate),
       task_runners_(task_runners),
       waiter_(std::move(waiter)),
 #if SHELL_ENABLE_METAL
-      layer_tree_pipeline_(std::make_shared<LayerTreePipeline>(2)),
+      layer_tree_pipeline_(std::make_shared<LayerTreePipeline>(
+          2,
+          AdaptivePipelineDepth::kMaxDepth)),
 #else   // SHELL_ENABLE_METAL
       // TODO(dnfield): We should remove this logic and set the pipeline depth
       // back to 2 in this case. See
       // https://github.com/flutter/engine/pull/9132 for discussion.
-      layer_tree_pipeline_(std::make_shared<LayerTreePipeline>(
+      layer_tree_pipeline_(
           task_runners.GetPlatformTaskRunner() ==
                   task_runners.GetRasterTaskRunner()
-              ? 1
-              : 2)),
+              ? std::make_shared<LayerTreePipeline>(1)
+              : std::make_shared<LayerTreePipeline>(
+                    2,
+                    AdaptivePipelineDepth::kMaxDepth)),
 #endif  // SHELL_ENABLE_METAL
       pending_frame_semaphore_(1),
       weak_factory_(this) {
+  if (max_frames_in_flight > 0) {
+    layer_tree_pipeline_ = std::make_shared<LayerTreePipeline>(
+        max_frames_in_flight,
+        std::max(max_frames_in_flight, AdaptivePipelineDepth::kMaxDepth));
+  }
+  if (enable_predictive_frame_scheduling) {
+    frame_start_predictor_ = std::make_unique<FrameStartPredictor>();
+  }
 }
 
 Animator::~Animator() = default;
@@ -57,6 +74,46 @@ void Animator::EnqueueTraceFlowId(uint64_t trace_flow_id) {
       });
 }
 
+void Animator::RecordFrameTiming(const FrameTiming& timing) {
+  if (frame_start_predictor_) {
+    frame_start_predictor_->RecordFrame(timing);
+  }
+}
+
+void Animator::ScheduleBeginFrame(
+    std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) {
+  if (!frame_start_predictor_ || last_frame_was_queued_) {
+    BeginFrame(std::move(frame_timings_recorder));
+    return;
+  }
+  const fml::TimePoint vsync_start =
+      frame_timings_recorder->GetVsyncStartTime();
+  const fml::TimePoint build_start =
+      vsync_start + frame_start_predictor_->GetBuildStartDelay(
+                        frame_timings_recorder->GetVsyncTargetTime() -
+                        vsync_start);
+  if (build_start <= fml::TimePoint::Now()) {
+    BeginFrame(std::move(frame_timings_recorder));
+    return;
+  }
+
+  TRACE_EVENT0("flutter", "Animator::DelayBeginFrame");
+  // Input dispatched before the build starts is part of the frame, and the
+  // UI thread is idle until then.
+  if (has_rendered_) {
+    delegate_.OnAnimatorNotifyIdle(build_start.ToEpochDelta());
+  }
+  task_runners_.GetUITaskRunner()->PostTaskForTime(
+      fml::MakeCopyable(
+          [self = weak_factory_.GetWeakPtr(),
+           recorder = std::move(frame_timings_recorder)]() mutable {
+            if (self) {
+              self->BeginFrame(std::move(recorder));
+            }
+          }),
+      build_start);
+}
+
 void Animator::BeginFrame(
     std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) {
   TRACE_EVENT_ASYNC_END0("flutter", "Frame Request Pending",
@@ -173,6 +230,7 @@ void Animator::Render(std::unique_ptr<flutter::LayerTree> layer_tree,
     return;
   }
 
+  last_frame_was_queued_ = !result.is_first_item;
   if (!result.is_first_item) {
     // It has been successfully pushed to the pipeline but not as the first
     // item. Eventually the 'Rasterizer' will consume it, so we don't need to
@@ -251,7 +309,7 @@ void Animator::AwaitVSync() {
           if (self->CanReuseLastLayerTree()) {
             self->DrawLastLayerTree(std::move(frame_timings_recorder));
           } else {
-            self->BeginFrame(std::move(frame_timings_recorder));
+            self->ScheduleBeginFrame(std::move(frame_timings_recorder));
           }
         }
       });
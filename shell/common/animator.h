@@ -13,6 +13,7 @@
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/synchronization/semaphore.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/shell/common/frame_start_predictor.h"
 #include "flutter/shell/common/pipeline.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/vsync_waiter.h"
@@ -46,9 +47,19 @@ class Animator final {
         std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) = 0;
   };
 
+  //----------------------------------------------------------------------------
+  /// @param[in]  enable_predictive_frame_scheduling  Whether to start building
+  ///             frames after their vsync when the timings of recent frames
+  ///             predict that the frames will still meet their target time.
+  ///             See |FrameStartPredictor|.
+  /// @param[in]  max_frames_in_flight  The depth of the layer tree pipeline,
+  ///             or zero for the default depth.
+  ///
   Animator(Delegate& delegate,
            const TaskRunners& task_runners,
-           std::unique_ptr<VsyncWaiter> waiter);
+           std::unique_ptr<VsyncWaiter> waiter,
+           bool enable_predictive_frame_scheduling = false,
+           uint32_t max_frames_in_flight = 0);
 
   ~Animator();
 
@@ -82,7 +93,19 @@ class Animator final {
   // rendering.
   void EnqueueTraceFlowId(uint64_t trace_flow_id);
 
+  //--------------------------------------------------------------------------
+  /// @brief    Records the timings of a rasterized frame to predict when
+  ///           later frames should start building. Does nothing unless
+  ///           predictive frame scheduling is enabled.
+  ///
+  void RecordFrameTiming(const FrameTiming& timing);
+
  private:
+  // Calls |BeginFrame| now, or later in the vsync interval if recent frames
+  // predict that the frame will still meet its target time.
+  void ScheduleBeginFrame(
+      std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder);
+
   void BeginFrame(std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder);
 
   bool CanReuseLastLayerTree();
@@ -110,6 +133,10 @@ class Animator final {
   SkISize last_layer_tree_size_ = {0, 0};
   std::deque<uint64_t> trace_flow_ids_;
   bool has_rendered_ = false;
+  // Whether the last rendered frame had to wait for another frame in the
+  // pipeline, in which case its raster time doesn't predict when it is done.
+  bool last_frame_was_queued_ = false;
+  std::unique_ptr<FrameStartPredictor> frame_start_predictor_;
 
   fml::WeakPtrFactory<Animator> weak_factory_;
 
@@ -60,6 +60,9 @@ Engine::Engine(
       task_runners_(task_runners),
       weak_factory_(this) {
   pointer_data_dispatcher_ = dispatcher_maker(*this);
+  if (settings_.enable_paragraph_layout_cache) {
+    font_collection_->GetFontCollection()->EnableParagraphLayoutCache();
+  }
 }
 
 Engine::Engine(Delegate& delegate,
@@ -106,6 +109,7 @@ Engine::Engine(Delegate& delegate,
           std::move(volatile_path_tracker),        // volatile path tracker
           vm.GetConcurrentWorkerTaskRunner(),      // concurrent task runner
           settings_.enable_impeller,               // enable impeller
+          settings_.animated_image_decode_ahead_frames,  // decode ahead frames
       });
 }
 
@@ -157,6 +161,11 @@ void Engine::SetupDefaultFontManager() {
   font_collection_->SetupDefaultFontManager(settings_.font_initialization_data);
 }
 
+void Engine::SetDefaultFontManager(sk_sp<SkFontMgr> font_manager) {
+  font_collection_->GetFontCollection()->SetDefaultFontManager(
+      std::move(font_manager));
+}
+
 std::shared_ptr<AssetManager> Engine::GetAssetManager() {
   return asset_manager_;
 }
@@ -169,6 +178,10 @@ fml::WeakPtr<ImageGeneratorRegistry> Engine::GetImageGeneratorRegistry() {
   return image_generator_registry_.GetWeakPtr();
 }
 
+void Engine::RecordFrameTiming(const FrameTiming& timing) {
+  animator_->RecordFrameTiming(timing);
+}
+
 bool Engine::UpdateAssetManager(
     const std::shared_ptr<AssetManager>& new_asset_manager) {
   if (asset_manager_ == new_asset_manager) {
@@ -183,7 +196,13 @@ bool Engine::UpdateAssetManager(
 
   // Using libTXT as the text engine.
   if (settings_.use_asset_fonts) {
-    font_collection_->RegisterFonts(asset_manager_);
+    std::shared_ptr<fml::ConcurrentTaskRunner> preload_task_runner;
+    if (settings_.preload_asset_fonts && runtime_controller_ &&
+        runtime_controller_->GetDartVM()) {
+      preload_task_runner =
+          runtime_controller_->GetDartVM()->GetConcurrentWorkerTaskRunner();
+    }
+    font_collection_->RegisterFonts(asset_manager_, preload_task_runner);
   }
 
   if (settings_.use_test_fonts) {
@@ -264,7 +283,22 @@ void Engine::ReportTimings(std::vector<int64_t> timings) {
 }
 
 void Engine::NotifyIdle(fml::TimeDelta deadline) {
+  // Idle tasks run first, the VM only collects garbage if the rest of the
+  // period is long enough.
+  idle_task_queue_.RunTasks(fml::TimePoint::FromEpochDelta(deadline));
+  runtime_controller_->RunIdleTasks(deadline);
   runtime_controller_->NotifyIdle(deadline);
+  // Spawning the pool in the first idle period keeps it off the startup path
+  // while making the isolates ready before the application needs them.
+  if (!has_prewarmed_isolate_pool_ && settings_.warm_isolate_pool_size > 0) {
+    has_prewarmed_isolate_pool_ = runtime_controller_->PrewarmIsolatePool(
+        settings_.warm_isolate_pool_size);
+  }
+}
+
+void Engine::PostIdleTask(std::string name, IdleTaskQueue::Task task) {
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  idle_task_queue_.PostTask(std::move(name), std::move(task));
 }
 
 void Engine::NotifyDestroyed() {
@@ -509,6 +543,12 @@ void Engine::SetNeedsReportTimings(bool needs_reporting) {
   delegate_.SetNeedsReportTimings(needs_reporting);
 }
 
+void Engine::SetPreferredFrameRate(double frames_per_second) {
+  if (auto waiter = animator_->GetVsyncWaiter().lock()) {
+    waiter->SetPreferredFrameRate(frames_per_second);
+  }
+}
+
 FontCollection& Engine::GetFontCollection() {
   return *font_collection_;
 }
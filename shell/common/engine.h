@@ -27,6 +27,7 @@
 #include "flutter/runtime/runtime_delegate.h"
 #include "flutter/shell/common/animator.h"
 #include "flutter/shell/common/display_manager.h"
+#include "flutter/shell/common/idle_task_queue.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/pointer_data_dispatcher.h"
 #include "flutter/shell/common/rasterizer.h"
@@ -480,6 +481,14 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   ///
   void SetupDefaultFontManager();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the default font manager to one created ahead of time by
+  ///             `txt::GetDefaultFontManager`, for example on another thread.
+  ///
+  /// @param[in]  font_manager  The default font manager.
+  ///
+  void SetDefaultFontManager(sk_sp<SkFontMgr> font_manager);
+
   //----------------------------------------------------------------------------
   /// @brief      Updates the asset manager referenced by the root isolate of a
   ///             Flutter application. This happens implicitly in the call to
@@ -589,6 +598,23 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   ///
   void NotifyIdle(fml::TimeDelta deadline);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Posts a task that runs on the UI task runner in one of the
+  ///             idle periods the animator reports between frames, ahead of
+  ///             the idle tasks of the framework and of garbage collection.
+  ///             This moves work that isn't needed by the next frame out of
+  ///             the frame workload.
+  ///
+  ///             Tasks are given the deadline of the idle period and must not
+  ///             run past it. Longer work should be split into tasks that post
+  ///             the next task before returning. Tasks only run while frames
+  ///             are being produced.
+  ///
+  /// @param[in]  name  The name of the task in traces.
+  /// @param[in]  task  The task.
+  ///
+  void PostIdleTask(std::string name, IdleTaskQueue::Task task);
+
   //----------------------------------------------------------------------------
   /// @brief      Notifies the engine that the attached flutter view has been
   ///             destroyed.
@@ -851,6 +877,14 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   ///
   fml::WeakPtr<ImageGeneratorRegistry> GetImageGeneratorRegistry();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Records the timings of a rasterized frame so that the animator
+  ///             can predict when later frames should start building.
+  ///
+  /// @param[in]  timing  The timings of the rasterized frame.
+  ///
+  void RecordFrameTiming(const FrameTiming& timing);
+
   // |PointerDataDispatcher::Delegate|
   void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
                         uint64_t trace_flow_id) override;
@@ -997,6 +1031,9 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
 
   void SetNeedsReportTimings(bool value) override;
 
+  // |RuntimeDelegate|
+  void SetPreferredFrameRate(double frames_per_second) override;
+
   bool HandleLifecyclePlatformMessage(PlatformMessage* message);
 
   bool HandleNavigationPlatformMessage(
@@ -1031,6 +1068,8 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   const std::unique_ptr<ImageDecoder> image_decoder_;
   ImageGeneratorRegistry image_generator_registry_;
   TaskRunners task_runners_;
+  IdleTaskQueue idle_task_queue_;
+  bool has_prewarmed_isolate_pool_ = false;
   fml::WeakPtrFactory<Engine> weak_factory_;  // Must be the last member.
   FML_DISALLOW_COPY_AND_ASSIGN(Engine);
 };
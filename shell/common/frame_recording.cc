@@ -0,0 +1,1943 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_recording.h"
+
+#include <cstring>
+#include <type_traits>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_op_receiver.h"
+#include "flutter/fml/logging.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkRRect.h"
+#include "third_party/skia/include/core/SkSerialProcs.h"
+#include "third_party/skia/include/core/SkStream.h"
+#include "third_party/skia/include/encode/SkPngEncoder.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr uint32_t kFrameRecordingMagic = 0x43524646;  // "FFRC"
+constexpr uint32_t kFrameRecordingVersion = 1u;
+
+// The largest placeholder image that is created for an image that was
+// recorded without its pixels.
+constexpr uint32_t kMaxPlaceholderImageDimension = 16384u;
+
+// Every object is written in a chunk of its own, after the objects that it
+// refers to, so that a recording can be read front to back.
+enum class ChunkType : uint32_t {
+  kTypeface,
+  kTextBlob,
+  kImage,
+  kDisplayList,
+  kFrame,
+};
+
+// The records of a DisplayList chunk. They correspond to the methods of
+// DlOpReceiver, except for kSkipped, which stands in for a record that
+// couldn't be written.
+enum class RecordType : uint8_t {
+  kSetAntiAlias,
+  kSetDither,
+  kSetDrawStyle,
+  kSetColor,
+  kSetStrokeWidth,
+  kSetStrokeMiter,
+  kSetStrokeCap,
+  kSetStrokeJoin,
+  kSetColorSource,
+  kSetColorFilter,
+  kSetInvertColors,
+  kSetBlendMode,
+  kSetPathEffect,
+  kSetMaskFilter,
+  kSetImageFilter,
+  kSave,
+  kSaveLayer,
+  kRestore,
+  kTranslate,
+  kScale,
+  kRotate,
+  kSkew,
+  kTransform2DAffine,
+  kTransformFullPerspective,
+  kTransformReset,
+  kClipRect,
+  kClipRRect,
+  kClipPath,
+  kDrawColor,
+  kDrawPaint,
+  kDrawLine,
+  kDrawRect,
+  kDrawOval,
+  kDrawCircle,
+  kDrawRRect,
+  kDrawDRRect,
+  kDrawPath,
+  kDrawArc,
+  kDrawPoints,
+  kDrawVertices,
+  kDrawImage,
+  kDrawImageRect,
+  kDrawImageNine,
+  kDrawAtlas,
+  kDrawDisplayList,
+  kDrawTextBlob,
+  kDrawShadow,
+  kSkipped,
+};
+
+// Attribute objects are written as their type plus one, or as this value
+// for no object.
+constexpr uint8_t kNoAttribute = 0u;
+
+void WriteBytes(std::vector<uint8_t>& data, const void* bytes, size_t size) {
+  auto begin = static_cast<const uint8_t*>(bytes);
+  data.insert(data.end(), begin, begin + size);
+}
+
+template <typename T>
+void Write(std::vector<uint8_t>& data, const T& value) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  if constexpr (std::is_enum_v<T>) {
+    const auto raw = static_cast<uint32_t>(value);
+    WriteBytes(data, &raw, sizeof(raw));
+  } else {
+    WriteBytes(data, &value, sizeof(value));
+  }
+}
+
+void WriteRecordType(std::vector<uint8_t>& data, RecordType type) {
+  data.push_back(static_cast<uint8_t>(type));
+}
+
+void WriteMatrix(std::vector<uint8_t>& data, const SkMatrix& matrix) {
+  SkScalar values[9];
+  matrix.get9(values);
+  WriteBytes(data, values, sizeof(values));
+}
+
+void WriteRRect(std::vector<uint8_t>& data, const SkRRect& rrect) {
+  const size_t offset = data.size();
+  data.resize(offset + SkRRect::kSizeInMemory);
+  rrect.writeToMemory(data.data() + offset);
+}
+
+void WritePath(std::vector<uint8_t>& data, const SkPath& path) {
+  const size_t size = path.writeToMemory(nullptr);
+  Write<uint32_t>(data, size);
+  const size_t offset = data.size();
+  data.resize(offset + size);
+  path.writeToMemory(data.data() + offset);
+}
+
+class Reader {
+ public:
+  Reader(const uint8_t* data, size_t size) : ptr_(data), end_(data + size) {}
+
+  bool IsAtEnd() const { return ptr_ == end_; }
+
+  size_t GetRemaining() const { return end_ - ptr_; }
+
+  bool ReadBytes(void* bytes, size_t size) {
+    auto source = Take(size);
+    if (!source) {
+      return false;
+    }
+    memcpy(bytes, source, size);
+    return true;
+  }
+
+  template <typename T>
+  bool Read(T* value) {
+    static_assert(std::is_trivially_copyable_v<T> && !std::is_enum_v<T>);
+    return ReadBytes(value, sizeof(T));
+  }
+
+  bool ReadBool(bool* value) {
+    uint8_t raw;
+    if (!Read(&raw) || raw > 1u) {
+      return false;
+    }
+    *value = raw == 1u;
+    return true;
+  }
+
+  template <typename T>
+  bool ReadEnum(T* value, T last) {
+    uint32_t raw;
+    if (!Read(&raw) || raw > static_cast<uint32_t>(last)) {
+      return false;
+    }
+    *value = static_cast<T>(raw);
+    return true;
+  }
+
+  // Returns the next |size| bytes and skips past them, or nullptr if fewer
+  // bytes remain.
+  const uint8_t* Take(uint64_t size) {
+    if (size > GetRemaining()) {
+      return nullptr;
+    }
+    auto bytes = ptr_;
+    ptr_ += size;
+    return bytes;
+  }
+
+  bool ReadMatrix(SkMatrix* matrix) {
+    SkScalar values[9];
+    if (!ReadBytes(values, sizeof(values))) {
+      return false;
+    }
+    matrix->set9(values);
+    return true;
+  }
+
+  bool ReadRRect(SkRRect* rrect) {
+    auto bytes = Take(SkRRect::kSizeInMemory);
+    return bytes && rrect->readFromMemory(bytes, SkRRect::kSizeInMemory) ==
+                        SkRRect::kSizeInMemory;
+  }
+
+  bool ReadPath(SkPath* path) {
+    uint32_t size;
+    if (!Read(&size)) {
+      return false;
+    }
+    auto bytes = Take(size);
+    return bytes && path->readFromMemory(bytes, size) == size;
+  }
+
+  // Reads a count of elements of |element_size| bytes each, checking that
+  // that many elements remain.
+  bool ReadCount(uint32_t* count, size_t element_size) {
+    return Read(count) && *count <= GetRemaining() / element_size;
+  }
+
+ private:
+  const uint8_t* ptr_;
+  const uint8_t* end_;
+};
+
+bool WriteColorFilter(std::vector<uint8_t>& data, const DlColorFilter* filter) {
+  if (!filter) {
+    data.push_back(kNoAttribute);
+    return true;
+  }
+  data.push_back(static_cast<uint8_t>(filter->type()) + 1);
+  switch (filter->type()) {
+    case DlColorFilterType::kBlend:
+      Write(data, filter->asBlend()->color());
+      Write(data, filter->asBlend()->mode());
+      return true;
+    case DlColorFilterType::kMatrix: {
+      float matrix[20];
+      filter->asMatrix()->get_matrix(matrix);
+      WriteBytes(data, matrix, sizeof(matrix));
+      return true;
+    }
+    case DlColorFilterType::kSrgbToLinearGamma:
+    case DlColorFilterType::kLinearToSrgbGamma:
+      return true;
+  }
+  return false;
+}
+
+bool ReadColorFilter(Reader& reader,
+                     std::shared_ptr<const DlColorFilter>* filter) {
+  uint8_t tag;
+  if (!reader.Read(&tag)) {
+    return false;
+  }
+  if (tag == kNoAttribute) {
+    filter->reset();
+    return true;
+  }
+  switch (static_cast<DlColorFilterType>(tag - 1)) {
+    case DlColorFilterType::kBlend: {
+      DlColor color;
+      DlBlendMode mode;
+      if (!reader.Read(&color) ||
+          !reader.ReadEnum(&mode, DlBlendMode::kLastMode)) {
+        return false;
+      }
+      *filter = DlBlendColorFilter::Make(color, mode);
+      return true;
+    }
+    case DlColorFilterType::kMatrix: {
+      float matrix[20];
+      if (!reader.ReadBytes(matrix, sizeof(matrix))) {
+        return false;
+      }
+      *filter = DlMatrixColorFilter::Make(matrix);
+      return true;
+    }
+    case DlColorFilterType::kSrgbToLinearGamma:
+      *filter = DlSrgbToLinearGammaColorFilter::instance;
+      return true;
+    case DlColorFilterType::kLinearToSrgbGamma:
+      *filter = DlLinearToSrgbGammaColorFilter::instance;
+      return true;
+  }
+  return false;
+}
+
+bool WriteImageFilter(std::vector<uint8_t>& data, const DlImageFilter* filter) {
+  if (!filter) {
+    data.push_back(kNoAttribute);
+    return true;
+  }
+  data.push_back(static_cast<uint8_t>(filter->type()) + 1);
+  switch (filter->type()) {
+    case DlImageFilterType::kBlur:
+      Write(data, filter->asBlur()->sigma_x());
+      Write(data, filter->asBlur()->sigma_y());
+      Write(data, filter->asBlur()->tile_mode());
+      return true;
+    case DlImageFilterType::kDilate:
+      Write(data, filter->asDilate()->radius_x());
+      Write(data, filter->asDilate()->radius_y());
+      return true;
+    case DlImageFilterType::kErode:
+      Write(data, filter->asErode()->radius_x());
+      Write(data, filter->asErode()->radius_y());
+      return true;
+    case DlImageFilterType::kMatrix:
+      WriteMatrix(data, filter->asMatrix()->matrix());
+      Write(data, filter->asMatrix()->sampling());
+      return true;
+    case DlImageFilterType::kCompose:
+      return WriteImageFilter(data, filter->asCompose()->outer().get()) &&
+             WriteImageFilter(data, filter->asCompose()->inner().get());
+    case DlImageFilterType::kColorFilter:
+      return WriteColorFilter(data,
+                              filter->asColorFilter()->color_filter().get());
+    case DlImageFilterType::kLocalMatrix:
+      WriteMatrix(data, filter->asLocalMatrix()->matrix());
+      return WriteImageFilter(data,
+                              filter->asLocalMatrix()->image_filter().get());
+  }
+  return false;
+}
+
+bool ReadImageFilter(Reader& reader,
+                     std::shared_ptr<const DlImageFilter>* filter) {
+  uint8_t tag;
+  if (!reader.Read(&tag)) {
+    return false;
+  }
+  if (tag == kNoAttribute) {
+    filter->reset();
+    return true;
+  }
+  switch (static_cast<DlImageFilterType>(tag - 1)) {
+    case DlImageFilterType::kBlur: {
+      SkScalar sigma_x;
+      SkScalar sigma_y;
+      DlTileMode tile_mode;
+      if (!reader.Read(&sigma_x) || !reader.Read(&sigma_y) ||
+          !reader.ReadEnum(&tile_mode, DlTileMode::kDecal)) {
+        return false;
+      }
+      *filter = DlBlurImageFilter::Make(sigma_x, sigma_y, tile_mode);
+      return true;
+    }
+    case DlImageFilterType::kDilate:
+    case DlImageFilterType::kErode: {
+      SkScalar radius_x;
+      SkScalar radius_y;
+      if (!reader.Read(&radius_x) || !reader.Read(&radius_y)) {
+        return false;
+      }
+      *filter = tag - 1 == static_cast<uint8_t>(DlImageFilterType::kDilate)
+                    ? DlDilateImageFilter::Make(radius_x, radius_y)
+                    : DlErodeImageFilter::Make(radius_x, radius_y);
+      return true;
+    }
+    case DlImageFilterType::kMatrix: {
+      SkMatrix matrix;
+      DlImageSampling sampling;
+      if (!reader.ReadMatrix(&matrix) ||
+          !reader.ReadEnum(&sampling, DlImageSampling::kCubic)) {
+        return false;
+      }
+      *filter = DlMatrixImageFilter::Make(matrix, sampling);
+      return true;
+    }
+    case DlImageFilterType::kCompose: {
+      std::shared_ptr<const DlImageFilter> outer;
+      std::shared_ptr<const DlImageFilter> inner;
+      if (!ReadImageFilter(reader, &outer) ||
+          !ReadImageFilter(reader, &inner)) {
+        return false;
+      }
+      *filter = DlComposeImageFilter::Make(outer, inner);
+      return true;
+    }
+    case DlImageFilterType::kColorFilter: {
+      std::shared_ptr<const DlColorFilter> color_filter;
+      if (!ReadColorFilter(reader, &color_filter)) {
+        return false;
+      }
+      *filter = DlColorFilterImageFilter::Make(color_filter);
+      return true;
+    }
+    case DlImageFilterType::kLocalMatrix: {
+      SkMatrix matrix;
+      std::shared_ptr<const DlImageFilter> inner;
+      if (!reader.ReadMatrix(&matrix) || !ReadImageFilter(reader, &inner)) {
+        return false;
+      }
+      *filter = inner ? inner->makeWithLocalMatrix(matrix) : nullptr;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool WriteMaskFilter(std::vector<uint8_t>& data, const DlMaskFilter* filter) {
+  if (!filter) {
+    data.push_back(kNoAttribute);
+    return true;
+  }
+  data.push_back(static_cast<uint8_t>(filter->type()) + 1);
+  switch (filter->type()) {
+    case DlMaskFilterType::kBlur:
+      Write(data, filter->asBlur()->style());
+      Write(data, filter->asBlur()->sigma());
+      Write<uint8_t>(data, filter->asBlur()->respectCTM());
+      return true;
+  }
+  return false;
+}
+
+bool ReadMaskFilter(Reader& reader,
+                    std::shared_ptr<const DlMaskFilter>* filter) {
+  uint8_t tag;
+  if (!reader.Read(&tag)) {
+    return false;
+  }
+  if (tag == kNoAttribute) {
+    filter->reset();
+    return true;
+  }
+  switch (static_cast<DlMaskFilterType>(tag - 1)) {
+    case DlMaskFilterType::kBlur: {
+      DlBlurStyle style;
+      SkScalar sigma;
+      bool respect_ctm;
+      if (!reader.ReadEnum(&style, DlBlurStyle::kInner) ||
+          !reader.Read(&sigma) || !reader.ReadBool(&respect_ctm)) {
+        return false;
+      }
+      *filter = DlBlurMaskFilter::Make(style, sigma, respect_ctm);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool WritePathEffect(std::vector<uint8_t>& data, const DlPathEffect* effect) {
+  if (!effect) {
+    data.push_back(kNoAttribute);
+    return true;
+  }
+  data.push_back(static_cast<uint8_t>(effect->type()) + 1);
+  switch (effect->type()) {
+    case DlPathEffectType::kDash: {
+      auto dash = effect->asDash();
+      Write<uint32_t>(data, dash->count());
+      WriteBytes(data, dash->intervals(), dash->count() * sizeof(SkScalar));
+      Write(data, dash->phase());
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ReadPathEffect(Reader& reader,
+                    std::shared_ptr<const DlPathEffect>* effect) {
+  uint8_t tag;
+  if (!reader.Read(&tag)) {
+    return false;
+  }
+  if (tag == kNoAttribute) {
+    effect->reset();
+    return true;
+  }
+  switch (static_cast<DlPathEffectType>(tag - 1)) {
+    case DlPathEffectType::kDash: {
+      uint32_t count;
+      if (!reader.ReadCount(&count, sizeof(SkScalar))) {
+        return false;
+      }
+      std::vector<SkScalar> intervals(count);
+      SkScalar phase;
+      if (!reader.ReadBytes(intervals.data(), count * sizeof(SkScalar)) ||
+          !reader.Read(&phase)) {
+        return false;
+      }
+      *effect = DlDashPathEffect::Make(intervals.data(), count, phase);
+      return true;
+    }
+  }
+  return false;
+}
+
+void WriteGradient(std::vector<uint8_t>& data,
+                   const DlGradientColorSourceBase* gradient) {
+  Write<uint32_t>(data, gradient->stop_count());
+  WriteBytes(data, gradient->colors(),
+             gradient->stop_count() * sizeof(DlColor));
+  WriteBytes(data, gradient->stops(), gradient->stop_count() * sizeof(float));
+  Write(data, gradient->tile_mode());
+  WriteMatrix(data, gradient->matrix());
+}
+
+// The properties shared by all gradients.
+struct GradientProperties {
+  std::vector<DlColor> colors;
+  std::vector<float> stops;
+  DlTileMode tile_mode;
+  SkMatrix matrix;
+};
+
+bool ReadGradient(Reader& reader, GradientProperties* gradient) {
+  uint32_t stop_count;
+  if (!reader.ReadCount(&stop_count, sizeof(DlColor) + sizeof(float))) {
+    return false;
+  }
+  gradient->colors.resize(stop_count);
+  gradient->stops.resize(stop_count);
+  return reader.ReadBytes(gradient->colors.data(),
+                          stop_count * sizeof(DlColor)) &&
+         reader.ReadBytes(gradient->stops.data(),
+                          stop_count * sizeof(float)) &&
+         reader.ReadEnum(&gradient->tile_mode, DlTileMode::kDecal) &&
+         reader.ReadMatrix(&gradient->matrix);
+}
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+/// Writes the records of a DisplayList that is dispatched to it.
+///
+class FrameRecordingWriter::Encoder final : public DlOpReceiver {
+ public:
+  explicit Encoder(FrameRecordingWriter& writer) : writer_(writer) {}
+
+  const std::vector<uint8_t>& GetData() const { return data_; }
+
+  // |DlOpReceiver|
+  void setAntiAlias(bool aa) override {
+    WriteRecordType(data_, RecordType::kSetAntiAlias);
+    Write<uint8_t>(data_, aa);
+  }
+
+  // |DlOpReceiver|
+  void setDither(bool dither) override {
+    WriteRecordType(data_, RecordType::kSetDither);
+    Write<uint8_t>(data_, dither);
+  }
+
+  // |DlOpReceiver|
+  void setDrawStyle(DlDrawStyle style) override {
+    WriteRecordType(data_, RecordType::kSetDrawStyle);
+    Write(data_, style);
+  }
+
+  // |DlOpReceiver|
+  void setColor(DlColor color) override {
+    WriteRecordType(data_, RecordType::kSetColor);
+    Write(data_, color);
+  }
+
+  // |DlOpReceiver|
+  void setStrokeWidth(float width) override {
+    WriteRecordType(data_, RecordType::kSetStrokeWidth);
+    Write(data_, width);
+  }
+
+  // |DlOpReceiver|
+  void setStrokeMiter(float limit) override {
+    WriteRecordType(data_, RecordType::kSetStrokeMiter);
+    Write(data_, limit);
+  }
+
+  // |DlOpReceiver|
+  void setStrokeCap(DlStrokeCap cap) override {
+    WriteRecordType(data_, RecordType::kSetStrokeCap);
+    Write(data_, cap);
+  }
+
+  // |DlOpReceiver|
+  void setStrokeJoin(DlStrokeJoin join) override {
+    WriteRecordType(data_, RecordType::kSetStrokeJoin);
+    Write(data_, join);
+  }
+
+  // |DlOpReceiver|
+  void setColorSource(const DlColorSource* source) override {
+    std::vector<uint8_t> attribute;
+    if (!WriteColorSource(attribute, source)) {
+      WriteSkipped();
+      attribute = {kNoAttribute};
+    }
+    WriteRecordType(data_, RecordType::kSetColorSource);
+    WriteBytes(data_, attribute.data(), attribute.size());
+  }
+
+  // |DlOpReceiver|
+  void setColorFilter(const DlColorFilter* filter) override {
+    std::vector<uint8_t> attribute;
+    if (!WriteColorFilter(attribute, filter)) {
+      WriteSkipped();
+      attribute = {kNoAttribute};
+    }
+    WriteRecordType(data_, RecordType::kSetColorFilter);
+    WriteBytes(data_, attribute.data(), attribute.size());
+  }
+
+  // |DlOpReceiver|
+  void setInvertColors(bool invert) override {
+    WriteRecordType(data_, RecordType::kSetInvertColors);
+    Write<uint8_t>(data_, invert);
+  }
+
+  // |DlOpReceiver|
+  void setBlendMode(DlBlendMode mode) override {
+    WriteRecordType(data_, RecordType::kSetBlendMode);
+    Write(data_, mode);
+  }
+
+  // |DlOpReceiver|
+  void setPathEffect(const DlPathEffect* effect) override {
+    std::vector<uint8_t> attribute;
+    if (!WritePathEffect(attribute, effect)) {
+      WriteSkipped();
+      attribute = {kNoAttribute};
+    }
+    WriteRecordType(data_, RecordType::kSetPathEffect);
+    WriteBytes(data_, attribute.data(), attribute.size());
+  }
+
+  // |DlOpReceiver|
+  void setMaskFilter(const DlMaskFilter* filter) override {
+    std::vector<uint8_t> attribute;
+    if (!WriteMaskFilter(attribute, filter)) {
+      WriteSkipped();
+      attribute = {kNoAttribute};
+    }
+    WriteRecordType(data_, RecordType::kSetMaskFilter);
+    WriteBytes(data_, attribute.data(), attribute.size());
+  }
+
+  // |DlOpReceiver|
+  void setImageFilter(const DlImageFilter* filter) override {
+    WriteRecordType(data_, RecordType::kSetImageFilter);
+    WriteImageFilterOrSkip(filter);
+  }
+
+  // |DlOpReceiver|
+  void save() override { WriteRecordType(data_, RecordType::kSave); }
+
+  // |DlOpReceiver|
+  void saveLayer(const SkRect* bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop) override {
+    WriteRecordType(data_, RecordType::kSaveLayer);
+    Write<uint8_t>(data_, bounds != nullptr);
+    if (bounds) {
+      Write(data_, *bounds);
+    }
+    Write<uint8_t>(data_, options.renders_with_attributes());
+    WriteImageFilterOrSkip(backdrop);
+  }
+
+  // |DlOpReceiver|
+  void restore() override { WriteRecordType(data_, RecordType::kRestore); }
+
+  // |DlOpReceiver|
+  void translate(SkScalar tx, SkScalar ty) override {
+    WriteRecordType(data_, RecordType::kTranslate);
+    Write(data_, tx);
+    Write(data_, ty);
+  }
+
+  // |DlOpReceiver|
+  void scale(SkScalar sx, SkScalar sy) override {
+    WriteRecordType(data_, RecordType::kScale);
+    Write(data_, sx);
+    Write(data_, sy);
+  }
+
+  // |DlOpReceiver|
+  void rotate(SkScalar degrees) override {
+    WriteRecordType(data_, RecordType::kRotate);
+    Write(data_, degrees);
+  }
+
+  // |DlOpReceiver|
+  void skew(SkScalar sx, SkScalar sy) override {
+    WriteRecordType(data_, RecordType::kSkew);
+    Write(data_, sx);
+    Write(data_, sy);
+  }
+
+  // clang-format off
+
+  // |DlOpReceiver|
+  void transform2DAffine(SkScalar mxx, SkScalar mxy, SkScalar mxt,
+                         SkScalar myx, SkScalar myy, SkScalar myt) override {
+    WriteRecordType(data_, RecordType::kTransform2DAffine);
+    const SkScalar values[] = {mxx, mxy, mxt,
+                               myx, myy, myt};
+    WriteBytes(data_, values, sizeof(values));
+  }
+
+  // |DlOpReceiver|
+  void transformFullPerspective(
+      SkScalar mxx, SkScalar mxy, SkScalar mxz, SkScalar mxt,
+      SkScalar myx, SkScalar myy, SkScalar myz, SkScalar myt,
+      SkScalar mzx, SkScalar mzy, SkScalar mzz, SkScalar mzt,
+      SkScalar mwx, SkScalar mwy, SkScalar mwz, SkScalar mwt) override {
+    WriteRecordType(data_, RecordType::kTransformFullPerspective);
+    const SkScalar values[] = {mxx, mxy, mxz, mxt,
+                               myx, myy, myz, myt,
+                               mzx, mzy, mzz, mzt,
+                               mwx, mwy, mwz, mwt};
+    WriteBytes(data_, values, sizeof(values));
+  }
+
+  // clang-format on
+
+  // |DlOpReceiver|
+  void transformReset() override {
+    WriteRecordType(data_, RecordType::kTransformReset);
+  }
+
+  // |DlOpReceiver|
+  void clipRect(const SkRect& rect, ClipOp clip_op, bool is_aa) override {
+    WriteRecordType(data_, RecordType::kClipRect);
+    Write(data_, rect);
+    Write(data_, clip_op);
+    Write<uint8_t>(data_, is_aa);
+  }
+
+  // |DlOpReceiver|
+  void clipRRect(const SkRRect& rrect, ClipOp clip_op, bool is_aa) override {
+    WriteRecordType(data_, RecordType::kClipRRect);
+    WriteRRect(data_, rrect);
+    Write(data_, clip_op);
+    Write<uint8_t>(data_, is_aa);
+  }
+
+  // |DlOpReceiver|
+  void clipPath(const SkPath& path, ClipOp clip_op, bool is_aa) override {
+    WriteRecordType(data_, RecordType::kClipPath);
+    WritePath(data_, path);
+    Write(data_, clip_op);
+    Write<uint8_t>(data_, is_aa);
+  }
+
+  // |DlOpReceiver|
+  void drawColor(DlColor color, DlBlendMode mode) override {
+    WriteRecordType(data_, RecordType::kDrawColor);
+    Write(data_, color);
+    Write(data_, mode);
+  }
+
+  // |DlOpReceiver|
+  void drawPaint() override { WriteRecordType(data_, RecordType::kDrawPaint); }
+
+  // |DlOpReceiver|
+  void drawLine(const SkPoint& p0, const SkPoint& p1) override {
+    WriteRecordType(data_, RecordType::kDrawLine);
+    Write(data_, p0);
+    Write(data_, p1);
+  }
+
+  // |DlOpReceiver|
+  void drawRect(const SkRect& rect) override {
+    WriteRecordType(data_, RecordType::kDrawRect);
+    Write(data_, rect);
+  }
+
+  // |DlOpReceiver|
+  void drawOval(const SkRect& bounds) override {
+    WriteRecordType(data_, RecordType::kDrawOval);
+    Write(data_, bounds);
+  }
+
+  // |DlOpReceiver|
+  void drawCircle(const SkPoint& center, SkScalar radius) override {
+    WriteRecordType(data_, RecordType::kDrawCircle);
+    Write(data_, center);
+    Write(data_, radius);
+  }
+
+  // |DlOpReceiver|
+  void drawRRect(const SkRRect& rrect) override {
+    WriteRecordType(data_, RecordType::kDrawRRect);
+    WriteRRect(data_, rrect);
+  }
+
+  // |DlOpReceiver|
+  void drawDRRect(const SkRRect& outer, const SkRRect& inner) override {
+    WriteRecordType(data_, RecordType::kDrawDRRect);
+    WriteRRect(data_, outer);
+    WriteRRect(data_, inner);
+  }
+
+  // |DlOpReceiver|
+  void drawPath(const SkPath& path) override {
+    WriteRecordType(data_, RecordType::kDrawPath);
+    WritePath(data_, path);
+  }
+
+  // |DlOpReceiver|
+  void drawArc(const SkRect& oval_bounds,
+               SkScalar start_degrees,
+               SkScalar sweep_degrees,
+               bool use_center) override {
+    WriteRecordType(data_, RecordType::kDrawArc);
+    Write(data_, oval_bounds);
+    Write(data_, start_degrees);
+    Write(data_, sweep_degrees);
+    Write<uint8_t>(data_, use_center);
+  }
+
+  // |DlOpReceiver|
+  void drawPoints(PointMode mode,
+                  uint32_t count,
+                  const SkPoint points[]) override {
+    WriteRecordType(data_, RecordType::kDrawPoints);
+    Write(data_, mode);
+    Write(data_, count);
+    WriteBytes(data_, points, count * sizeof(SkPoint));
+  }
+
+  // |DlOpReceiver|
+  void drawVertices(const DlVertices* vertices, DlBlendMode mode) override {
+    WriteRecordType(data_, RecordType::kDrawVertices);
+    Write(data_, mode);
+    Write(data_, vertices->mode());
+    Write<uint32_t>(data_, vertices->vertex_count());
+    Write<uint32_t>(data_, vertices->index_count());
+    Write<uint8_t>(data_, vertices->texture_coordinates() != nullptr);
+    Write<uint8_t>(data_, vertices->colors() != nullptr);
+    WriteBytes(data_, vertices->vertices(),
+               vertices->vertex_count() * sizeof(SkPoint));
+    WriteBytes(data_, vertices->indices(),
+               vertices->index_count() * sizeof(uint16_t));
+    if (vertices->texture_coordinates()) {
+      WriteBytes(data_, vertices->texture_coordinates(),
+                 vertices->vertex_count() * sizeof(SkPoint));
+    }
+    if (vertices->colors()) {
+      WriteBytes(data_, vertices->colors(),
+                 vertices->vertex_count() * sizeof(DlColor));
+    }
+  }
+
+  // |DlOpReceiver|
+  void drawImage(const sk_sp<DlImage> image,
+                 const SkPoint point,
+                 DlImageSampling sampling,
+                 bool render_with_attributes) override {
+    const uint32_t index = writer_.WriteImage(image);
+    WriteRecordType(data_, RecordType::kDrawImage);
+    Write(data_, index);
+    Write(data_, point);
+    Write(data_, sampling);
+    Write<uint8_t>(data_, render_with_attributes);
+  }
+
+  // |DlOpReceiver|
+  void drawImageRect(const sk_sp<DlImage> image,
+                     const SkRect& src,
+                     const SkRect& dst,
+                     DlImageSampling sampling,
+                     bool render_with_attributes,
+                     SrcRectConstraint constraint) override {
+    const uint32_t index = writer_.WriteImage(image);
+    WriteRecordType(data_, RecordType::kDrawImageRect);
+    Write(data_, index);
+    Write(data_, src);
+    Write(data_, dst);
+    Write(data_, sampling);
+    Write<uint8_t>(data_, render_with_attributes);
+    Write(data_, constraint);
+  }
+
+  // |DlOpReceiver|
+  void drawImageNine(const sk_sp<DlImage> image,
+                     const SkIRect& center,
+                     const SkRect& dst,
+                     DlFilterMode filter,
+                     bool render_with_attributes) override {
+    const uint32_t index = writer_.WriteImage(image);
+    WriteRecordType(data_, RecordType::kDrawImageNine);
+    Write(data_, index);
+    Write(data_, center);
+    Write(data_, dst);
+    Write(data_, filter);
+    Write<uint8_t>(data_, render_with_attributes);
+  }
+
+  // |DlOpReceiver|
+  void drawAtlas(const sk_sp<DlImage> atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const DlColor colors[],
+                 int count,
+                 DlBlendMode mode,
+                 DlImageSampling sampling,
+                 const SkRect* cull_rect,
+                 bool render_with_attributes) override {
+    const uint32_t index = writer_.WriteImage(atlas);
+    WriteRecordType(data_, RecordType::kDrawAtlas);
+    Write(data_, index);
+    Write<uint32_t>(data_, count);
+    Write<uint8_t>(data_, colors != nullptr);
+    Write<uint8_t>(data_, cull_rect != nullptr);
+    WriteBytes(data_, xform, count * sizeof(SkRSXform));
+    WriteBytes(data_, tex, count * sizeof(SkRect));
+    if (colors) {
+      WriteBytes(data_, colors, count * sizeof(DlColor));
+    }
+    if (cull_rect) {
+      Write(data_, *cull_rect);
+    }
+    Write(data_, mode);
+    Write(data_, sampling);
+    Write<uint8_t>(data_, render_with_attributes);
+  }
+
+  // |DlOpReceiver|
+  void drawDisplayList(const sk_sp<DisplayList> display_list,
+                       SkScalar opacity) override {
+    const uint32_t index = writer_.WriteDisplayList(*display_list);
+    WriteRecordType(data_, RecordType::kDrawDisplayList);
+    Write(data_, index);
+    Write(data_, opacity);
+  }
+
+  // |DlOpReceiver|
+  void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                    SkScalar x,
+                    SkScalar y) override {
+    const uint32_t index = writer_.WriteTextBlob(blob);
+    WriteRecordType(data_, RecordType::kDrawTextBlob);
+    Write(data_, index);
+    Write(data_, x);
+    Write(data_, y);
+  }
+
+  // |DlOpReceiver|
+  void drawTextFrame(const std::shared_ptr<impeller::TextFrame>& text_frame,
+                     SkScalar x,
+                     SkScalar y) override {
+    // Text frames only exist for Impeller and can't be serialized.
+    WriteSkipped();
+  }
+
+  // |DlOpReceiver|
+  void drawShadow(const SkPath& path,
+                  const DlColor color,
+                  const SkScalar elevation,
+                  bool transparent_occluder,
+                  SkScalar dpr) override {
+    WriteRecordType(data_, RecordType::kDrawShadow);
+    WritePath(data_, path);
+    Write(data_, color);
+    Write(data_, elevation);
+    Write<uint8_t>(data_, transparent_occluder);
+    Write(data_, dpr);
+  }
+
+ private:
+  FrameRecordingWriter& writer_;
+  std::vector<uint8_t> data_;
+
+  void WriteSkipped() {
+    WriteRecordType(data_, RecordType::kSkipped);
+    writer_.skipped_record_count_++;
+  }
+
+  void WriteImageFilterOrSkip(const DlImageFilter* filter) {
+    std::vector<uint8_t> attribute;
+    if (!WriteImageFilter(attribute, filter)) {
+      writer_.skipped_record_count_++;
+      attribute = {kNoAttribute};
+    }
+    WriteBytes(data_, attribute.data(), attribute.size());
+  }
+
+  bool WriteColorSource(std::vector<uint8_t>& data,
+                        const DlColorSource* source) {
+    if (!source) {
+      data.push_back(kNoAttribute);
+      return true;
+    }
+    switch (source->type()) {
+      case DlColorSourceType::kColor:
+        data.push_back(static_cast<uint8_t>(source->type()) + 1);
+        Write(data, source->asColor()->color());
+        return true;
+      case DlColorSourceType::kImage: {
+        auto image_source = source->asImage();
+        data.push_back(static_cast<uint8_t>(source->type()) + 1);
+        Write(data, writer_.WriteImage(image_source->image()));
+        Write(data, image_source->horizontal_tile_mode());
+        Write(data, image_source->vertical_tile_mode());
+        Write(data, image_source->sampling());
+        WriteMatrix(data, image_source->matrix());
+        return true;
+      }
+      case DlColorSourceType::kLinearGradient: {
+        auto linear = source->asLinearGradient();
+        data.push_back(static_cast<uint8_t>(source->type()) + 1);
+        Write(data, linear->start_point());
+        Write(data, linear->end_point());
+        WriteGradient(data, linear);
+        return true;
+      }
+      case DlColorSourceType::kRadialGradient: {
+        auto radial = source->asRadialGradient();
+        data.push_back(static_cast<uint8_t>(source->type()) + 1);
+        Write(data, radial->center());
+        Write(data, radial->radius());
+        WriteGradient(data, radial);
+        return true;
+      }
+      case DlColorSourceType::kConicalGradient: {
+        auto conical = source->asConicalGradient();
+        data.push_back(static_cast<uint8_t>(source->type()) + 1);
+        Write(data, conical->start_center());
+        Write(data, conical->start_radius());
+        Write(data, conical->end_center());
+        Write(data, conical->end_radius());
+        WriteGradient(data, conical);
+        return true;
+      }
+      case DlColorSourceType::kSweepGradient: {
+        auto sweep = source->asSweepGradient();
+        data.push_back(static_cast<uint8_t>(source->type()) + 1);
+        Write(data, sweep->center());
+        Write(data, sweep->start());
+        Write(data, sweep->end());
+        WriteGradient(data, sweep);
+        return true;
+      }
+      default:
+        // Runtime effects refer to shaders that aren't part of the
+        // DisplayList, and scenes to their nodes.
+        return false;
+    }
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(Encoder);
+};
+
+FrameRecordingWriter::FrameRecordingWriter() {
+  Write(data_, kFrameRecordingMagic);
+  Write(data_, kFrameRecordingVersion);
+}
+
+FrameRecordingWriter::~FrameRecordingWriter() = default;
+
+void FrameRecordingWriter::AddFrame(const DisplayList& display_list,
+                                    const SkISize& frame_size,
+                                    float device_pixel_ratio,
+                                    fml::TimeDelta build_time,
+                                    fml::TimeDelta raster_time,
+                                    GrDirectContext* gr_context) {
+  gr_context_ = gr_context;
+  const uint32_t index = WriteDisplayList(display_list);
+  gr_context_ = nullptr;
+
+  std::vector<uint8_t> chunk;
+  Write(chunk, index);
+  Write(chunk, frame_size);
+  Write(chunk, device_pixel_ratio);
+  Write(chunk, build_time.ToMicroseconds());
+  Write(chunk, raster_time.ToMicroseconds());
+  WriteChunk(static_cast<uint32_t>(ChunkType::kFrame), chunk.data(),
+             chunk.size());
+  frame_count_++;
+}
+
+std::unique_ptr<fml::Mapping> FrameRecordingWriter::Finish() const {
+  return std::make_unique<fml::DataMapping>(data_);
+}
+
+uint32_t FrameRecordingWriter::WriteDisplayList(
+    const DisplayList& display_list) {
+  auto found = display_lists_.find(&display_list);
+  if (found != display_lists_.end()) {
+    return found->second;
+  }
+
+  // The DisplayLists nested in this one are written while it is dispatched.
+  Encoder encoder(*this);
+  display_list.Dispatch(encoder);
+
+  std::vector<uint8_t> chunk;
+  Write<uint8_t>(chunk, display_list.has_rtree());
+  WriteBytes(chunk, encoder.GetData().data(), encoder.GetData().size());
+  WriteChunk(static_cast<uint32_t>(ChunkType::kDisplayList), chunk.data(),
+             chunk.size());
+
+  const uint32_t index = display_lists_.size();
+  display_lists_[&display_list] = index;
+  retained_display_lists_.push_back(sk_ref_sp(&display_list));
+  return index;
+}
+
+uint32_t FrameRecordingWriter::WriteImage(const sk_sp<const DlImage>& image) {
+  auto found = images_.find(image.get());
+  if (found != images_.end()) {
+    return found->second;
+  }
+
+  sk_sp<SkData> encoded;
+  if (auto sk_image = image->skia_image()) {
+    encoded = SkPngEncoder::Encode(gr_context_, sk_image.get(), {});
+  }
+  if (!encoded) {
+    skipped_record_count_++;
+  }
+
+  std::vector<uint8_t> chunk;
+  Write<uint32_t>(chunk, image->width());
+  Write<uint32_t>(chunk, image->height());
+  if (encoded) {
+    WriteBytes(chunk, encoded->data(), encoded->size());
+  }
+  WriteChunk(static_cast<uint32_t>(ChunkType::kImage), chunk.data(),
+             chunk.size());
+
+  const uint32_t index = images_.size();
+  images_[image.get()] = index;
+  retained_images_.push_back(image);
+  return index;
+}
+
+uint32_t FrameRecordingWriter::WriteTextBlob(const sk_sp<SkTextBlob>& blob) {
+  auto found = text_blobs_.find(blob.get());
+  if (found != text_blobs_.end()) {
+    return found->second;
+  }
+
+  // Typefaces are written once in chunks of their own and referred to by
+  // their index from the blobs, as they hold the data of their fonts.
+  SkSerialProcs procs;
+  procs.fTypefaceProc = [](SkTypeface* typeface, void* ctx) {
+    const uint32_t index =
+        static_cast<FrameRecordingWriter*>(ctx)->WriteTypeface(typeface);
+    return SkData::MakeWithCopy(&index, sizeof(index));
+  };
+  procs.fTypefaceCtx = this;
+  auto data = blob->serialize(procs);
+  WriteChunk(static_cast<uint32_t>(ChunkType::kTextBlob), data->data(),
+             data->size());
+
+  const uint32_t index = text_blobs_.size();
+  text_blobs_[blob.get()] = index;
+  retained_text_blobs_.push_back(blob);
+  return index;
+}
+
+uint32_t FrameRecordingWriter::WriteTypeface(SkTypeface* typeface) {
+  auto found = typefaces_.find(typeface);
+  if (found != typefaces_.end()) {
+    return found->second;
+  }
+
+  auto data =
+      typeface->serialize(SkTypeface::SerializeBehavior::kDoIncludeData);
+  WriteChunk(static_cast<uint32_t>(ChunkType::kTypeface), data->data(),
+             data->size());
+
+  const uint32_t index = typefaces_.size();
+  typefaces_[typeface] = index;
+  retained_typefaces_.push_back(sk_ref_sp(typeface));
+  return index;
+}
+
+void FrameRecordingWriter::WriteChunk(uint32_t type,
+                                      const void* data,
+                                      size_t size) {
+  Write(data_, type);
+  Write<uint64_t>(data_, size);
+  WriteBytes(data_, data, size);
+}
+
+//------------------------------------------------------------------------------
+/// Reads the records of a DisplayList chunk into a DisplayListBuilder.
+///
+/// The attributes set by the records are tracked in a paint that is passed to
+/// the builder with each record that renders with attributes.
+///
+class FrameRecording::Decoder {
+ public:
+  Decoder(FrameRecording& recording, bool prepare_rtree)
+      : recording_(recording), builder_(prepare_rtree) {}
+
+  bool Decode(Reader& reader) {
+    while (!reader.IsAtEnd()) {
+      uint8_t type;
+      if (!reader.Read(&type) ||
+          type > static_cast<uint8_t>(RecordType::kSkipped) ||
+          !DecodeRecord(static_cast<RecordType>(type), reader)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  sk_sp<DisplayList> Build() { return builder_.Build(); }
+
+ private:
+  FrameRecording& recording_;
+  DisplayListBuilder builder_;
+  DlPaint paint_;
+
+  const DlPaint* PaintIf(bool render_with_attributes) const {
+    return render_with_attributes ? &paint_ : nullptr;
+  }
+
+  bool ReadImage(Reader& reader, sk_sp<DlImage>* image) {
+    uint32_t index;
+    if (!reader.Read(&index) || index >= recording_.images_.size()) {
+      return false;
+    }
+    *image = recording_.images_[index];
+    return true;
+  }
+
+  bool ReadColorSource(Reader& reader,
+                       std::shared_ptr<const DlColorSource>* source) {
+    uint8_t tag;
+    if (!reader.Read(&tag)) {
+      return false;
+    }
+    if (tag == kNoAttribute) {
+      source->reset();
+      return true;
+    }
+    GradientProperties gradient;
+    switch (static_cast<DlColorSourceType>(tag - 1)) {
+      case DlColorSourceType::kColor: {
+        DlColor color;
+        if (!reader.Read(&color)) {
+          return false;
+        }
+        *source = std::make_shared<DlColorColorSource>(color);
+        return true;
+      }
+      case DlColorSourceType::kImage: {
+        sk_sp<DlImage> image;
+        DlTileMode horizontal_tile_mode;
+        DlTileMode vertical_tile_mode;
+        DlImageSampling sampling;
+        SkMatrix matrix;
+        if (!ReadImage(reader, &image) ||
+            !reader.ReadEnum(&horizontal_tile_mode, DlTileMode::kDecal) ||
+            !reader.ReadEnum(&vertical_tile_mode, DlTileMode::kDecal) ||
+            !reader.ReadEnum(&sampling, DlImageSampling::kCubic) ||
+            !reader.ReadMatrix(&matrix)) {
+          return false;
+        }
+        *source = std::make_shared<DlImageColorSource>(
+            image, horizontal_tile_mode, vertical_tile_mode, sampling,
+            &matrix);
+        return true;
+      }
+      case DlColorSourceType::kLinearGradient: {
+        SkPoint start_point;
+        SkPoint end_point;
+        if (!reader.Read(&start_point) || !reader.Read(&end_point) ||
+            !ReadGradient(reader, &gradient)) {
+          return false;
+        }
+        *source = DlColorSource::MakeLinear(
+            start_point, end_point, gradient.colors.size(),
+            gradient.colors.data(), gradient.stops.data(), gradient.tile_mode,
+            &gradient.matrix);
+        return true;
+      }
+      case DlColorSourceType::kRadialGradient: {
+        SkPoint center;
+        SkScalar radius;
+        if (!reader.Read(&center) || !reader.Read(&radius) ||
+            !ReadGradient(reader, &gradient)) {
+          return false;
+        }
+        *source = DlColorSource::MakeRadial(
+            center, radius, gradient.colors.size(), gradient.colors.data(),
+            gradient.stops.data(), gradient.tile_mode, &gradient.matrix);
+        return true;
+      }
+      case DlColorSourceType::kConicalGradient: {
+        SkPoint start_center;
+        SkScalar start_radius;
+        SkPoint end_center;
+        SkScalar end_radius;
+        if (!reader.Read(&start_center) || !reader.Read(&start_radius) ||
+            !reader.Read(&end_center) || !reader.Read(&end_radius) ||
+            !ReadGradient(reader, &gradient)) {
+          return false;
+        }
+        *source = DlColorSource::MakeConical(
+            start_center, start_radius, end_center, end_radius,
+            gradient.colors.size(), gradient.colors.data(),
+            gradient.stops.data(), gradient.tile_mode, &gradient.matrix);
+        return true;
+      }
+      case DlColorSourceType::kSweepGradient: {
+        SkPoint center;
+        SkScalar start;
+        SkScalar end;
+        if (!reader.Read(&center) || !reader.Read(&start) ||
+            !reader.Read(&end) || !ReadGradient(reader, &gradient)) {
+          return false;
+        }
+        *source = DlColorSource::MakeSweep(
+            center, start, end, gradient.colors.size(), gradient.colors.data(),
+            gradient.stops.data(), gradient.tile_mode, &gradient.matrix);
+        return true;
+      }
+      default:
+        return false;
+    }
+  }
+
+  bool DecodeRecord(RecordType type, Reader& reader) {
+    switch (type) {
+      case RecordType::kSetAntiAlias: {
+        bool aa;
+        if (!reader.ReadBool(&aa)) {
+          return false;
+        }
+        paint_.setAntiAlias(aa);
+        return true;
+      }
+      case RecordType::kSetDither: {
+        bool dither;
+        if (!reader.ReadBool(&dither)) {
+          return false;
+        }
+        paint_.setDither(dither);
+        return true;
+      }
+      case RecordType::kSetDrawStyle: {
+        DlDrawStyle style;
+        if (!reader.ReadEnum(&style, DlDrawStyle::kLastStyle)) {
+          return false;
+        }
+        paint_.setDrawStyle(style);
+        return true;
+      }
+      case RecordType::kSetColor: {
+        DlColor color;
+        if (!reader.Read(&color)) {
+          return false;
+        }
+        paint_.setColor(color);
+        return true;
+      }
+      case RecordType::kSetStrokeWidth: {
+        float width;
+        if (!reader.Read(&width)) {
+          return false;
+        }
+        paint_.setStrokeWidth(width);
+        return true;
+      }
+      case RecordType::kSetStrokeMiter: {
+        float limit;
+        if (!reader.Read(&limit)) {
+          return false;
+        }
+        paint_.setStrokeMiter(limit);
+        return true;
+      }
+      case RecordType::kSetStrokeCap: {
+        DlStrokeCap cap;
+        if (!reader.ReadEnum(&cap, DlStrokeCap::kLastCap)) {
+          return false;
+        }
+        paint_.setStrokeCap(cap);
+        return true;
+      }
+      case RecordType::kSetStrokeJoin: {
+        DlStrokeJoin join;
+        if (!reader.ReadEnum(&join, DlStrokeJoin::kLastJoin)) {
+          return false;
+        }
+        paint_.setStrokeJoin(join);
+        return true;
+      }
+      case RecordType::kSetColorSource: {
+        std::shared_ptr<const DlColorSource> source;
+        if (!ReadColorSource(reader, &source)) {
+          return false;
+        }
+        paint_.setColorSource(source.get());
+        return true;
+      }
+      case RecordType::kSetColorFilter: {
+        std::shared_ptr<const DlColorFilter> filter;
+        if (!ReadColorFilter(reader, &filter)) {
+          return false;
+        }
+        paint_.setColorFilter(filter.get());
+        return true;
+      }
+      case RecordType::kSetInvertColors: {
+        bool invert;
+        if (!reader.ReadBool(&invert)) {
+          return false;
+        }
+        paint_.setInvertColors(invert);
+        return true;
+      }
+      case RecordType::kSetBlendMode: {
+        DlBlendMode mode;
+        if (!reader.ReadEnum(&mode, DlBlendMode::kLastMode)) {
+          return false;
+        }
+        paint_.setBlendMode(mode);
+        return true;
+      }
+      case RecordType::kSetPathEffect: {
+        std::shared_ptr<const DlPathEffect> effect;
+        if (!ReadPathEffect(reader, &effect)) {
+          return false;
+        }
+        paint_.setPathEffect(effect.get());
+        return true;
+      }
+      case RecordType::kSetMaskFilter: {
+        std::shared_ptr<const DlMaskFilter> filter;
+        if (!ReadMaskFilter(reader, &filter)) {
+          return false;
+        }
+        paint_.setMaskFilter(filter.get());
+        return true;
+      }
+      case RecordType::kSetImageFilter: {
+        std::shared_ptr<const DlImageFilter> filter;
+        if (!ReadImageFilter(reader, &filter)) {
+          return false;
+        }
+        paint_.setImageFilter(filter.get());
+        return true;
+      }
+      case RecordType::kSave:
+        builder_.Save();
+        return true;
+      case RecordType::kSaveLayer: {
+        bool has_bounds;
+        SkRect bounds;
+        bool render_with_attributes;
+        std::shared_ptr<const DlImageFilter> backdrop;
+        if (!reader.ReadBool(&has_bounds) ||
+            (has_bounds && !reader.Read(&bounds)) ||
+            !reader.ReadBool(&render_with_attributes) ||
+            !ReadImageFilter(reader, &backdrop)) {
+          return false;
+        }
+        builder_.SaveLayer(has_bounds ? &bounds : nullptr,
+                           PaintIf(render_with_attributes), backdrop.get());
+        return true;
+      }
+      case RecordType::kRestore:
+        builder_.Restore();
+        return true;
+      case RecordType::kTranslate:
+      case RecordType::kScale:
+      case RecordType::kSkew: {
+        SkScalar x;
+        SkScalar y;
+        if (!reader.Read(&x) || !reader.Read(&y)) {
+          return false;
+        }
+        if (type == RecordType::kTranslate) {
+          builder_.Translate(x, y);
+        } else if (type == RecordType::kScale) {
+          builder_.Scale(x, y);
+        } else {
+          builder_.Skew(x, y);
+        }
+        return true;
+      }
+      case RecordType::kRotate: {
+        SkScalar degrees;
+        if (!reader.Read(&degrees)) {
+          return false;
+        }
+        builder_.Rotate(degrees);
+        return true;
+      }
+      case RecordType::kTransform2DAffine: {
+        SkScalar m[6];
+        if (!reader.ReadBytes(m, sizeof(m))) {
+          return false;
+        }
+        builder_.Transform2DAffine(m[0], m[1], m[2], m[3], m[4], m[5]);
+        return true;
+      }
+      case RecordType::kTransformFullPerspective: {
+        SkScalar m[16];
+        if (!reader.ReadBytes(m, sizeof(m))) {
+          return false;
+        }
+        builder_.TransformFullPerspective(m[0], m[1], m[2], m[3],    //
+                                          m[4], m[5], m[6], m[7],    //
+                                          m[8], m[9], m[10], m[11],  //
+                                          m[12], m[13], m[14], m[15]);
+        return true;
+      }
+      case RecordType::kTransformReset:
+        builder_.TransformReset();
+        return true;
+      case RecordType::kClipRect: {
+        SkRect rect;
+        DlCanvas::ClipOp clip_op;
+        bool is_aa;
+        if (!reader.Read(&rect) ||
+            !reader.ReadEnum(&clip_op, DlCanvas::ClipOp::kIntersect) ||
+            !reader.ReadBool(&is_aa)) {
+          return false;
+        }
+        builder_.ClipRect(rect, clip_op, is_aa);
+        return true;
+      }
+      case RecordType::kClipRRect: {
+        SkRRect rrect;
+        DlCanvas::ClipOp clip_op;
+        bool is_aa;
+        if (!reader.ReadRRect(&rrect) ||
+            !reader.ReadEnum(&clip_op, DlCanvas::ClipOp::kIntersect) ||
+            !reader.ReadBool(&is_aa)) {
+          return false;
+        }
+        builder_.ClipRRect(rrect, clip_op, is_aa);
+        return true;
+      }
+      case RecordType::kClipPath: {
+        SkPath path;
+        DlCanvas::ClipOp clip_op;
+        bool is_aa;
+        if (!reader.ReadPath(&path) ||
+            !reader.ReadEnum(&clip_op, DlCanvas::ClipOp::kIntersect) ||
+            !reader.ReadBool(&is_aa)) {
+          return false;
+        }
+        builder_.ClipPath(path, clip_op, is_aa);
+        return true;
+      }
+      case RecordType::kDrawColor: {
+        DlColor color;
+        DlBlendMode mode;
+        if (!reader.Read(&color) ||
+            !reader.ReadEnum(&mode, DlBlendMode::kLastMode)) {
+          return false;
+        }
+        builder_.DrawColor(color, mode);
+        return true;
+      }
+      case RecordType::kDrawPaint:
+        builder_.DrawPaint(paint_);
+        return true;
+      case RecordType::kDrawLine: {
+        SkPoint p0;
+        SkPoint p1;
+        if (!reader.Read(&p0) || !reader.Read(&p1)) {
+          return false;
+        }
+        builder_.DrawLine(p0, p1, paint_);
+        return true;
+      }
+      case RecordType::kDrawRect:
+      case RecordType::kDrawOval: {
+        SkRect rect;
+        if (!reader.Read(&rect)) {
+          return false;
+        }
+        if (type == RecordType::kDrawRect) {
+          builder_.DrawRect(rect, paint_);
+        } else {
+          builder_.DrawOval(rect, paint_);
+        }
+        return true;
+      }
+      case RecordType::kDrawCircle: {
+        SkPoint center;
+        SkScalar radius;
+        if (!reader.Read(&center) || !reader.Read(&radius)) {
+          return false;
+        }
+        builder_.DrawCircle(center, radius, paint_);
+        return true;
+      }
+      case RecordType::kDrawRRect: {
+        SkRRect rrect;
+        if (!reader.ReadRRect(&rrect)) {
+          return false;
+        }
+        builder_.DrawRRect(rrect, paint_);
+        return true;
+      }
+      case RecordType::kDrawDRRect: {
+        SkRRect outer;
+        SkRRect inner;
+        if (!reader.ReadRRect(&outer) || !reader.ReadRRect(&inner)) {
+          return false;
+        }
+        builder_.DrawDRRect(outer, inner, paint_);
+        return true;
+      }
+      case RecordType::kDrawPath: {
+        SkPath path;
+        if (!reader.ReadPath(&path)) {
+          return false;
+        }
+        builder_.DrawPath(path, paint_);
+        return true;
+      }
+      case RecordType::kDrawArc: {
+        SkRect oval_bounds;
+        SkScalar start_degrees;
+        SkScalar sweep_degrees;
+        bool use_center;
+        if (!reader.Read(&oval_bounds) || !reader.Read(&start_degrees) ||
+            !reader.Read(&sweep_degrees) || !reader.ReadBool(&use_center)) {
+          return false;
+        }
+        builder_.DrawArc(oval_bounds, start_degrees, sweep_degrees, use_center,
+                         paint_);
+        return true;
+      }
+      case RecordType::kDrawPoints: {
+        DlCanvas::PointMode mode;
+        uint32_t count;
+        if (!reader.ReadEnum(&mode, DlCanvas::PointMode::kPolygon) ||
+            !reader.ReadCount(&count, sizeof(SkPoint))) {
+          return false;
+        }
+        std::vector<SkPoint> points(count);
+        if (!reader.ReadBytes(points.data(), count * sizeof(SkPoint))) {
+          return false;
+        }
+        builder_.DrawPoints(mode, count, points.data(), paint_);
+        return true;
+      }
+      case RecordType::kDrawVertices:
+        return DecodeVertices(reader);
+      case RecordType::kDrawImage: {
+        sk_sp<DlImage> image;
+        SkPoint point;
+        DlImageSampling sampling;
+        bool render_with_attributes;
+        if (!ReadImage(reader, &image) || !reader.Read(&point) ||
+            !reader.ReadEnum(&sampling, DlImageSampling::kCubic) ||
+            !reader.ReadBool(&render_with_attributes)) {
+          return false;
+        }
+        builder_.DrawImage(image, point, sampling,
+                           PaintIf(render_with_attributes));
+        return true;
+      }
+      case RecordType::kDrawImageRect: {
+        sk_sp<DlImage> image;
+        SkRect src;
+        SkRect dst;
+        DlImageSampling sampling;
+        bool render_with_attributes;
+        DlCanvas::SrcRectConstraint constraint;
+        if (!ReadImage(reader, &image) || !reader.Read(&src) ||
+            !reader.Read(&dst) ||
+            !reader.ReadEnum(&sampling, DlImageSampling::kCubic) ||
+            !reader.ReadBool(&render_with_attributes) ||
+            !reader.ReadEnum(&constraint,
+                             DlCanvas::SrcRectConstraint::kFast)) {
+          return false;
+        }
+        builder_.DrawImageRect(image, src, dst, sampling,
+                               PaintIf(render_with_attributes), constraint);
+        return true;
+      }
+      case RecordType::kDrawImageNine: {
+        sk_sp<DlImage> image;
+        SkIRect center;
+        SkRect dst;
+        DlFilterMode filter;
+        bool render_with_attributes;
+        if (!ReadImage(reader, &image) || !reader.Read(&center) ||
+            !reader.Read(&dst) ||
+            !reader.ReadEnum(&filter, DlFilterMode::kLast) ||
+            !reader.ReadBool(&render_with_attributes)) {
+          return false;
+        }
+        builder_.DrawImageNine(image, center, dst, filter,
+                               PaintIf(render_with_attributes));
+        return true;
+      }
+      case RecordType::kDrawAtlas:
+        return DecodeAtlas(reader);
+      case RecordType::kDrawDisplayList: {
+        uint32_t index;
+        SkScalar opacity;
+        if (!reader.Read(&index) ||
+            index >= recording_.display_lists_.size() ||
+            !reader.Read(&opacity)) {
+          return false;
+        }
+        builder_.DrawDisplayList(recording_.display_lists_[index], opacity);
+        return true;
+      }
+      case RecordType::kDrawTextBlob: {
+        uint32_t index;
+        SkScalar x;
+        SkScalar y;
+        if (!reader.Read(&index) || index >= recording_.text_blobs_.size() ||
+            !reader.Read(&x) || !reader.Read(&y)) {
+          return false;
+        }
+        builder_.DrawTextBlob(recording_.text_blobs_[index], x, y, paint_);
+        return true;
+      }
+      case RecordType::kDrawShadow: {
+        SkPath path;
+        DlColor color;
+        SkScalar elevation;
+        bool transparent_occluder;
+        SkScalar dpr;
+        if (!reader.ReadPath(&path) || !reader.Read(&color) ||
+            !reader.Read(&elevation) ||
+            !reader.ReadBool(&transparent_occluder) || !reader.Read(&dpr)) {
+          return false;
+        }
+        builder_.DrawShadow(path, color, elevation, transparent_occluder, dpr);
+        return true;
+      }
+      case RecordType::kSkipped:
+        recording_.skipped_record_count_++;
+        return true;
+    }
+    return false;
+  }
+
+  bool DecodeVertices(Reader& reader) {
+    DlBlendMode mode;
+    DlVertexMode vertex_mode;
+    uint32_t vertex_count;
+    uint32_t index_count;
+    bool has_texture_coordinates;
+    bool has_colors;
+    if (!reader.ReadEnum(&mode, DlBlendMode::kLastMode) ||
+        !reader.ReadEnum(&vertex_mode, DlVertexMode::kTriangleFan) ||
+        !reader.ReadCount(&vertex_count, sizeof(SkPoint)) ||
+        !reader.ReadCount(&index_count, sizeof(uint16_t)) ||
+        !reader.ReadBool(&has_texture_coordinates) ||
+        !reader.ReadBool(&has_colors)) {
+      return false;
+    }
+    std::vector<SkPoint> vertices(vertex_count);
+    std::vector<uint16_t> indices(index_count);
+    std::vector<SkPoint> texture_coordinates(
+        has_texture_coordinates ? vertex_count : 0);
+    std::vector<DlColor> colors(has_colors ? vertex_count : 0);
+    if (!reader.ReadBytes(vertices.data(), vertex_count * sizeof(SkPoint)) ||
+        !reader.ReadBytes(indices.data(), index_count * sizeof(uint16_t)) ||
+        !reader.ReadBytes(texture_coordinates.data(),
+                          texture_coordinates.size() * sizeof(SkPoint)) ||
+        !reader.ReadBytes(colors.data(), colors.size() * sizeof(DlColor))) {
+      return false;
+    }
+    auto dl_vertices = DlVertices::Make(
+        vertex_mode, vertex_count, vertices.data(),
+        has_texture_coordinates ? texture_coordinates.data() : nullptr,
+        has_colors ? colors.data() : nullptr, index_count,
+        index_count > 0 ? indices.data() : nullptr);
+    builder_.DrawVertices(dl_vertices, mode, paint_);
+    return true;
+  }
+
+  bool DecodeAtlas(Reader& reader) {
+    sk_sp<DlImage> atlas;
+    uint32_t count;
+    bool has_colors;
+    bool has_cull_rect;
+    if (!ReadImage(reader, &atlas) ||
+        !reader.ReadCount(&count, sizeof(SkRSXform) + sizeof(SkRect)) ||
+        !reader.ReadBool(&has_colors) || !reader.ReadBool(&has_cull_rect)) {
+      return false;
+    }
+    std::vector<SkRSXform> xform(count);
+    std::vector<SkRect> tex(count);
+    std::vector<DlColor> colors(has_colors ? count : 0);
+    SkRect cull_rect;
+    DlBlendMode mode;
+    DlImageSampling sampling;
+    bool render_with_attributes;
+    if (!reader.ReadBytes(xform.data(), count * sizeof(SkRSXform)) ||
+        !reader.ReadBytes(tex.data(), count * sizeof(SkRect)) ||
+        !reader.ReadBytes(colors.data(), colors.size() * sizeof(DlColor)) ||
+        (has_cull_rect && !reader.Read(&cull_rect)) ||
+        !reader.ReadEnum(&mode, DlBlendMode::kLastMode) ||
+        !reader.ReadEnum(&sampling, DlImageSampling::kCubic) ||
+        !reader.ReadBool(&render_with_attributes)) {
+      return false;
+    }
+    builder_.DrawAtlas(atlas, xform.data(), tex.data(),
+                       has_colors ? colors.data() : nullptr, count, mode,
+                       sampling, has_cull_rect ? &cull_rect : nullptr,
+                       PaintIf(render_with_attributes));
+    return true;
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(Decoder);
+};
+
+FrameRecording::FrameRecording() = default;
+
+FrameRecording::~FrameRecording() = default;
+
+std::unique_ptr<FrameRecording> FrameRecording::Load(
+    const fml::Mapping& data) {
+  Reader reader(data.GetMapping(), data.GetSize());
+  uint32_t magic;
+  uint32_t version;
+  if (!reader.Read(&magic) || !reader.Read(&version) ||
+      magic != kFrameRecordingMagic || version != kFrameRecordingVersion) {
+    FML_LOG(ERROR) << "Data is not a frame recording of this engine version.";
+    return nullptr;
+  }
+
+  std::unique_ptr<FrameRecording> recording(new FrameRecording());
+  while (!reader.IsAtEnd()) {
+    uint32_t type;
+    uint64_t size;
+    const uint8_t* chunk = nullptr;
+    if (!reader.Read(&type) || !reader.Read(&size) ||
+        !(chunk = reader.Take(size)) ||
+        !recording->ReadChunk(type, chunk, size)) {
+      FML_LOG(ERROR) << "Frame recording is malformed.";
+      return nullptr;
+    }
+  }
+  return recording;
+}
+
+bool FrameRecording::ReadChunk(uint32_t type,
+                               const uint8_t* data,
+                               size_t size) {
+  Reader reader(data, size);
+  switch (static_cast<ChunkType>(type)) {
+    case ChunkType::kTypeface: {
+      SkMemoryStream stream(data, size);
+      auto typeface = SkTypeface::MakeDeserialize(&stream);
+      if (!typeface) {
+        return false;
+      }
+      typefaces_.push_back(std::move(typeface));
+      return true;
+    }
+    case ChunkType::kTextBlob: {
+      SkDeserialProcs procs;
+      procs.fTypefaceProc = [](const void* data, size_t length,
+                               void* ctx) -> sk_sp<SkTypeface> {
+        auto typefaces = static_cast<std::vector<sk_sp<SkTypeface>>*>(ctx);
+        uint32_t index;
+        if (length != sizeof(index)) {
+          return nullptr;
+        }
+        memcpy(&index, data, sizeof(index));
+        return index < typefaces->size() ? typefaces->at(index) : nullptr;
+      };
+      procs.fTypefaceCtx = &typefaces_;
+      auto blob = SkTextBlob::Deserialize(data, size, procs);
+      if (!blob) {
+        return false;
+      }
+      text_blobs_.push_back(std::move(blob));
+      return true;
+    }
+    case ChunkType::kImage: {
+      uint32_t width;
+      uint32_t height;
+      if (!reader.Read(&width) || !reader.Read(&height)) {
+        return false;
+      }
+      sk_sp<SkImage> image;
+      if (!reader.IsAtEnd()) {
+        // Decode the image up front so that its decoding isn't measured as
+        // part of the first frame that draws it.
+        const size_t encoded_size = reader.GetRemaining();
+        auto encoded =
+            SkData::MakeWithCopy(reader.Take(encoded_size), encoded_size);
+        if (auto deferred = SkImages::DeferredFromEncodedData(encoded)) {
+          image = deferred->makeRasterImage();
+        }
+      } else if (width > 0 && height > 0 &&
+                 width <= kMaxPlaceholderImageDimension &&
+                 height <= kMaxPlaceholderImageDimension) {
+        SkBitmap bitmap;
+        bitmap.allocN32Pixels(width, height);
+        bitmap.eraseColor(SK_ColorGRAY);
+        bitmap.setImmutable();
+        image = SkImages::RasterFromBitmap(bitmap);
+      }
+      if (!image) {
+        return false;
+      }
+      images_.push_back(DlImage::Make(std::move(image)));
+      return true;
+    }
+    case ChunkType::kDisplayList: {
+      bool has_rtree;
+      if (!reader.ReadBool(&has_rtree)) {
+        return false;
+      }
+      Decoder decoder(*this, has_rtree);
+      if (!decoder.Decode(reader)) {
+        return false;
+      }
+      display_lists_.push_back(decoder.Build());
+      return true;
+    }
+    case ChunkType::kFrame: {
+      uint32_t index;
+      RecordedFrame frame;
+      int64_t build_micros;
+      int64_t raster_micros;
+      if (!reader.Read(&index) || index >= display_lists_.size() ||
+          !reader.Read(&frame.frame_size) ||
+          !reader.Read(&frame.device_pixel_ratio) ||
+          !reader.Read(&build_micros) || !reader.Read(&raster_micros) ||
+          !reader.IsAtEnd()) {
+        return false;
+      }
+      frame.display_list = display_lists_[index];
+      frame.build_time = fml::TimeDelta::FromMicroseconds(build_micros);
+      frame.raster_time = fml::TimeDelta::FromMicroseconds(raster_micros);
+      frames_.push_back(std::move(frame));
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace flutter
@@ -0,0 +1,161 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_FRAME_RECORDING_H_
+#define FLUTTER_SHELL_COMMON_FRAME_RECORDING_H_
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/time/time_delta.h"
+#include "third_party/skia/include/core/SkSize.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+#include "third_party/skia/include/core/SkTypeface.h"
+
+class GrDirectContext;
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// A frame of a |FrameRecording|.
+///
+struct RecordedFrame {
+  /// The layer tree of the frame, flattened into a DisplayList.
+  sk_sp<DisplayList> display_list;
+  SkISize frame_size;
+  float device_pixel_ratio = 1.0f;
+  /// The time the frame took to build and rasterize when it was recorded.
+  fml::TimeDelta build_time;
+  fml::TimeDelta raster_time;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Writes a sequence of frames into a frame recording that the
+///             `flutter_frame_replay` tool can replay through a |Rasterizer|.
+///
+/// Frames are added as their layer trees flattened into DisplayLists. The
+/// records of the DisplayLists are written one by one, together with the
+/// objects they refer to: paths, vertices and effects are written inline,
+/// while images, text blobs with their typefaces and nested DisplayLists are
+/// written once and referred to by index from every frame that uses them.
+/// Images are encoded as PNGs.
+///
+/// Records that can't be written are replaced by a placeholder that counts
+/// as a skipped record. These are Impeller text frames, runtime effects and
+/// scene color sources. Images that can't be read back, such as Impeller
+/// textures, are written with their size only and replay as gray images.
+///
+/// The format is tied to the engine version that wrote it.
+///
+class FrameRecordingWriter {
+ public:
+  FrameRecordingWriter();
+
+  ~FrameRecordingWriter();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Appends a frame to the recording.
+  ///
+  /// @param[in]  gr_context  The context used to read back texture backed
+  ///                         images, or nullptr.
+  ///
+  void AddFrame(const DisplayList& display_list,
+                const SkISize& frame_size,
+                float device_pixel_ratio,
+                fml::TimeDelta build_time,
+                fml::TimeDelta raster_time,
+                GrDirectContext* gr_context);
+
+  size_t GetFrameCount() const { return frame_count_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of records replaced by placeholders so far.
+  ///
+  size_t GetSkippedRecordCount() const { return skipped_record_count_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the recording of the frames added so far.
+  ///
+  std::unique_ptr<fml::Mapping> Finish() const;
+
+ private:
+  class Encoder;
+
+  std::vector<uint8_t> data_;
+  size_t frame_count_ = 0u;
+  size_t skipped_record_count_ = 0u;
+  GrDirectContext* gr_context_ = nullptr;
+
+  // The objects that have been written, by identity, and their indices. The
+  // objects are kept alive so that their addresses aren't reused by the
+  // objects of later frames.
+  std::unordered_map<const DisplayList*, uint32_t> display_lists_;
+  std::unordered_map<const DlImage*, uint32_t> images_;
+  std::unordered_map<const SkTextBlob*, uint32_t> text_blobs_;
+  std::unordered_map<const SkTypeface*, uint32_t> typefaces_;
+  std::vector<sk_sp<const DisplayList>> retained_display_lists_;
+  std::vector<sk_sp<const DlImage>> retained_images_;
+  std::vector<sk_sp<const SkTextBlob>> retained_text_blobs_;
+  std::vector<sk_sp<const SkTypeface>> retained_typefaces_;
+
+  uint32_t WriteDisplayList(const DisplayList& display_list);
+
+  uint32_t WriteImage(const sk_sp<const DlImage>& image);
+
+  uint32_t WriteTextBlob(const sk_sp<SkTextBlob>& blob);
+
+  uint32_t WriteTypeface(SkTypeface* typeface);
+
+  void WriteChunk(uint32_t type, const void* data, size_t size);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameRecordingWriter);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      The frames of a recording written by |FrameRecordingWriter|.
+///
+class FrameRecording {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Reads a recording written by |FrameRecordingWriter|.
+  ///
+  /// @return     The recording, or nullptr if |data| is not a valid frame
+  ///             recording.
+  ///
+  static std::unique_ptr<FrameRecording> Load(const fml::Mapping& data);
+
+  ~FrameRecording();
+
+  const std::vector<RecordedFrame>& GetFrames() const { return frames_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of records that were replaced by placeholders when
+  ///             the frames were recorded, and are missing from the frames.
+  ///
+  size_t GetSkippedRecordCount() const { return skipped_record_count_; }
+
+ private:
+  class Decoder;
+
+  std::vector<RecordedFrame> frames_;
+  size_t skipped_record_count_ = 0u;
+  std::vector<sk_sp<DisplayList>> display_lists_;
+  std::vector<sk_sp<DlImage>> images_;
+  std::vector<sk_sp<SkTextBlob>> text_blobs_;
+  std::vector<sk_sp<SkTypeface>> typefaces_;
+
+  FrameRecording();
+
+  bool ReadChunk(uint32_t type, const uint8_t* data, size_t size);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameRecording);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_FRAME_RECORDING_H_
@@ -0,0 +1,247 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_recording.h"
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/effects/dl_runtime_effect.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/effects/SkRuntimeEffect.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+std::unique_ptr<FrameRecording> RoundTrip(const FrameRecordingWriter& writer) {
+  auto data = writer.Finish();
+  EXPECT_NE(data, nullptr);
+  return data ? FrameRecording::Load(*data) : nullptr;
+}
+
+sk_sp<DlImage> MakeTestImage(int width, int height) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(width, height);
+  bitmap.eraseColor(SK_ColorBLUE);
+  bitmap.setImmutable();
+  return DlImage::Make(SkImages::RasterFromBitmap(bitmap));
+}
+
+}  // namespace
+
+TEST(FrameRecordingTest, RoundTripsFrameProperties) {
+  DisplayListBuilder builder;
+  builder.DrawRect(SkRect::MakeLTRB(10, 10, 20, 20), DlPaint());
+  auto display_list = builder.Build();
+
+  FrameRecordingWriter writer;
+  writer.AddFrame(*display_list, SkISize::Make(100, 200), 2.0f,
+                  fml::TimeDelta::FromMicroseconds(1500),
+                  fml::TimeDelta::FromMicroseconds(4200), nullptr);
+  ASSERT_EQ(writer.GetFrameCount(), 1u);
+
+  auto recording = RoundTrip(writer);
+  ASSERT_NE(recording, nullptr);
+  ASSERT_EQ(recording->GetFrames().size(), 1u);
+  const auto& frame = recording->GetFrames()[0];
+  EXPECT_EQ(frame.frame_size, SkISize::Make(100, 200));
+  EXPECT_EQ(frame.device_pixel_ratio, 2.0f);
+  EXPECT_EQ(frame.build_time.ToMicroseconds(), 1500);
+  EXPECT_EQ(frame.raster_time.ToMicroseconds(), 4200);
+  EXPECT_TRUE(frame.display_list->Equals(display_list));
+  EXPECT_EQ(recording->GetSkippedRecordCount(), 0u);
+}
+
+TEST(FrameRecordingTest, RoundTripsGeometryAndEffects) {
+  SkPath path;
+  path.moveTo(0, 0);
+  path.cubicTo(10, 40, 50, 20, 60, 60);
+  path.close();
+  const DlColor colors[] = {DlColor::kRed(), DlColor::kBlue()};
+  const float stops[] = {0.0f, 1.0f};
+
+  DisplayListBuilder builder;
+  DlPaint paint;
+  paint.setColor(DlColor::kGreen());
+  paint.setDrawStyle(DlDrawStyle::kStroke);
+  paint.setStrokeWidth(3.0f);
+  paint.setPathEffect(DlDashPathEffect::Make(stops, 2, 0.5f));
+  builder.DrawPath(path, paint);
+
+  builder.Save();
+  builder.Translate(5, 7);
+  builder.ClipRRect(SkRRect::MakeRectXY(SkRect::MakeWH(50, 50), 4, 4));
+  DlPaint layer_paint;
+  layer_paint.setImageFilter(DlComposeImageFilter::Make(
+      DlBlurImageFilter::Make(3, 3, DlTileMode::kDecal),
+      DlColorFilterImageFilter::Make(
+          DlBlendColorFilter::Make(DlColor::kCyan(), DlBlendMode::kModulate))));
+  builder.SaveLayer(nullptr, &layer_paint);
+  DlPaint gradient_paint;
+  gradient_paint.setColorSource(
+      DlColorSource::MakeLinear(SkPoint::Make(0, 0), SkPoint::Make(50, 50), 2,
+                                colors, stops, DlTileMode::kMirror));
+  gradient_paint.setMaskFilter(
+      DlBlurMaskFilter::Make(DlBlurStyle::kNormal, 2.0f));
+  builder.DrawCircle(SkPoint::Make(25, 25), 20, gradient_paint);
+  builder.Restore();
+  builder.Restore();
+
+  const SkPoint points[] = {{0, 0}, {10, 10}, {20, 0}};
+  builder.DrawPoints(DlCanvas::PointMode::kPolygon, 3, points, DlPaint());
+  auto vertices = DlVertices::Make(DlVertexMode::kTriangles, 3, points,
+                                   nullptr, colors);
+  builder.DrawVertices(vertices, DlBlendMode::kSrcOver, DlPaint());
+  builder.DrawShadow(path, DlColor::kBlack(), 4.0f, false, 2.0f);
+  auto display_list = builder.Build();
+
+  FrameRecordingWriter writer;
+  writer.AddFrame(*display_list, SkISize::Make(100, 100), 1.0f,
+                  fml::TimeDelta(), fml::TimeDelta(), nullptr);
+
+  auto recording = RoundTrip(writer);
+  ASSERT_NE(recording, nullptr);
+  ASSERT_EQ(recording->GetFrames().size(), 1u);
+  EXPECT_TRUE(recording->GetFrames()[0].display_list->Equals(display_list));
+  EXPECT_EQ(recording->GetSkippedRecordCount(), 0u);
+}
+
+TEST(FrameRecordingTest, WritesSharedObjectsOnce) {
+  auto image = MakeTestImage(12, 34);
+  DisplayListBuilder picture_builder;
+  picture_builder.DrawImage(image, SkPoint::Make(0, 0),
+                            DlImageSampling::kLinear);
+  auto picture = picture_builder.Build();
+
+  DisplayListBuilder builder1;
+  builder1.DrawDisplayList(picture);
+  auto frame1 = builder1.Build();
+  DisplayListBuilder builder2;
+  builder2.Translate(10, 10);
+  builder2.DrawDisplayList(picture, 0.5f);
+  builder2.DrawImage(image, SkPoint::Make(50, 50), DlImageSampling::kNearest);
+  auto frame2 = builder2.Build();
+
+  FrameRecordingWriter single_writer;
+  single_writer.AddFrame(*frame1, SkISize::Make(100, 100), 1.0f,
+                         fml::TimeDelta(), fml::TimeDelta(), nullptr);
+  const size_t single_frame_size = single_writer.Finish()->GetSize();
+
+  FrameRecordingWriter writer;
+  writer.AddFrame(*frame1, SkISize::Make(100, 100), 1.0f, fml::TimeDelta(),
+                  fml::TimeDelta(), nullptr);
+  writer.AddFrame(*frame2, SkISize::Make(100, 100), 1.0f, fml::TimeDelta(),
+                  fml::TimeDelta(), nullptr);
+  // The second frame refers to the picture and the image of the first
+  // instead of writing them again.
+  EXPECT_LT(writer.Finish()->GetSize(), single_frame_size * 2);
+
+  auto recording = RoundTrip(writer);
+  ASSERT_NE(recording, nullptr);
+  ASSERT_EQ(recording->GetFrames().size(), 2u);
+  const auto& replayed1 = recording->GetFrames()[0].display_list;
+  const auto& replayed2 = recording->GetFrames()[1].display_list;
+  EXPECT_EQ(replayed1->op_count(true), frame1->op_count(true));
+  EXPECT_EQ(replayed2->op_count(true), frame2->op_count(true));
+  EXPECT_EQ(replayed1->bounds(), frame1->bounds());
+  EXPECT_EQ(replayed2->bounds(), frame2->bounds());
+  EXPECT_EQ(recording->GetSkippedRecordCount(), 0u);
+}
+
+TEST(FrameRecordingTest, RoundTripsImagePixelsAsPng) {
+  auto image = MakeTestImage(12, 34);
+  DisplayListBuilder builder;
+  builder.DrawImageRect(image, SkRect::MakeWH(12, 34),
+                        SkRect::MakeWH(24, 68), DlImageSampling::kLinear);
+  auto display_list = builder.Build();
+
+  FrameRecordingWriter writer;
+  writer.AddFrame(*display_list, SkISize::Make(100, 100), 1.0f,
+                  fml::TimeDelta(), fml::TimeDelta(), nullptr);
+
+  auto recording = RoundTrip(writer);
+  ASSERT_NE(recording, nullptr);
+  ASSERT_EQ(recording->GetFrames().size(), 1u);
+
+  class ImageSpy : public IgnoreAttributeDispatchHelper,
+                   public IgnoreClipDispatchHelper,
+                   public IgnoreTransformDispatchHelper,
+                   public IgnoreDrawDispatchHelper {
+   public:
+    void drawImageRect(const sk_sp<DlImage> image,
+                       const SkRect& src,
+                       const SkRect& dst,
+                       DlImageSampling sampling,
+                       bool render_with_attributes,
+                       SrcRectConstraint constraint) override {
+      image_ = image;
+    }
+    sk_sp<DlImage> image_;
+  };
+  ImageSpy spy;
+  recording->GetFrames()[0].display_list->Dispatch(spy);
+  ASSERT_NE(spy.image_, nullptr);
+  EXPECT_EQ(spy.image_->dimensions(), SkISize::Make(12, 34));
+  EXPECT_FALSE(spy.image_->isTextureBacked());
+}
+
+TEST(FrameRecordingTest, SkipsRuntimeEffects) {
+  auto effect = DlRuntimeEffect::MakeSkia(
+      SkRuntimeEffect::MakeForShader(
+          SkString("vec4 main(vec2 p) { return vec4(1); }"))
+          .effect);
+  DlPaint paint;
+  paint.setColorSource(DlColorSource::MakeRuntimeEffect(
+      effect, {}, std::make_shared<std::vector<uint8_t>>()));
+  DisplayListBuilder builder;
+  builder.DrawRect(SkRect::MakeWH(10, 10), paint);
+  builder.DrawRect(SkRect::MakeLTRB(20, 20, 30, 30), DlPaint());
+  auto display_list = builder.Build();
+
+  FrameRecordingWriter writer;
+  writer.AddFrame(*display_list, SkISize::Make(100, 100), 1.0f,
+                  fml::TimeDelta(), fml::TimeDelta(), nullptr);
+  EXPECT_EQ(writer.GetSkippedRecordCount(), 1u);
+
+  auto recording = RoundTrip(writer);
+  ASSERT_NE(recording, nullptr);
+  ASSERT_EQ(recording->GetFrames().size(), 1u);
+  EXPECT_EQ(recording->GetSkippedRecordCount(), 1u);
+  // The rects are still drawn, without the shader.
+  EXPECT_EQ(recording->GetFrames()[0].display_list->bounds(),
+            display_list->bounds());
+}
+
+TEST(FrameRecordingTest, RejectsMalformedData) {
+  EXPECT_EQ(FrameRecording::Load(fml::DataMapping(std::vector<uint8_t>{})),
+            nullptr);
+  EXPECT_EQ(FrameRecording::Load(fml::DataMapping("not a frame recording")),
+            nullptr);
+
+  DisplayListBuilder builder;
+  builder.DrawRect(SkRect::MakeWH(10, 10), DlPaint());
+  auto display_list = builder.Build();
+  FrameRecordingWriter writer;
+  writer.AddFrame(*display_list, SkISize::Make(100, 100), 1.0f,
+                  fml::TimeDelta(), fml::TimeDelta(), nullptr);
+  auto data = writer.Finish();
+  ASSERT_NE(FrameRecording::Load(*data), nullptr);
+
+  std::vector<uint8_t> truncated(data->GetMapping(),
+                                 data->GetMapping() + data->GetSize() - 1);
+  EXPECT_EQ(FrameRecording::Load(fml::DataMapping(truncated)), nullptr);
+}
+
+TEST(FrameRecordingTest, EmptyRecordingHasNoFrames) {
+  FrameRecordingWriter writer;
+  auto recording = RoundTrip(writer);
+  ASSERT_NE(recording, nullptr);
+  EXPECT_TRUE(recording->GetFrames().empty());
+}
+
+}  // namespace testing
+}  // namespace flutter
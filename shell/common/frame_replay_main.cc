@@ -0,0 +1,362 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "flutter/flow/layers/display_list_layer.h"
+#include "flutter/flow/layers/layer_tree.h"
+#include "flutter/fml/command_line.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/shell/common/frame_recording.h"
+#include "flutter/shell/common/rasterizer.h"
+#include "flutter/shell/common/thread_host.h"
+#include "flutter/shell/gpu/gpu_surface_software.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+#if SHELL_ENABLE_GL
+#include "flutter/shell/gpu/gpu_surface_gl_skia.h"
+#include "flutter/testing/test_gl_surface.h"
+#endif  // SHELL_ENABLE_GL
+
+namespace flutter {
+
+namespace {
+
+// Collects the raster times of the frames drawn by a rasterizer that isn't
+// attached to a shell.
+class ReplayDelegate final : public Rasterizer::Delegate {
+ public:
+  explicit ReplayDelegate(const TaskRunners& task_runners)
+      : task_runners_(task_runners),
+        is_gpu_disabled_sync_switch_(std::make_shared<fml::SyncSwitch>()) {}
+
+  std::vector<fml::TimeDelta>& GetRasterTimes() { return raster_times_; }
+
+  // |Rasterizer::Delegate|
+  void OnFrameRasterized(const FrameTiming& frame_timing) override {
+    raster_times_.push_back(frame_timing.Get(FrameTiming::kRasterFinish) -
+                            frame_timing.Get(FrameTiming::kRasterStart));
+  }
+
+  // |Rasterizer::Delegate|
+  void OnFrameGPUTimeMeasured(uint64_t frame_number,
+                              fml::TimeDelta gpu_time) override {}
+
+  // |Rasterizer::Delegate|
+  fml::Milliseconds GetFrameBudget() override {
+    return fml::kDefaultFrameBudget;
+  }
+
+  // |Rasterizer::Delegate|
+  fml::TimePoint GetLatestFrameTargetTime() const override {
+    return fml::TimePoint::Now();
+  }
+
+  // |Rasterizer::Delegate|
+  const TaskRunners& GetTaskRunners() const override { return task_runners_; }
+
+  // |Rasterizer::Delegate|
+  const fml::RefPtr<fml::RasterThreadMerger> GetParentRasterThreadMerger()
+      const override {
+    return nullptr;
+  }
+
+  // |Rasterizer::Delegate|
+  std::shared_ptr<const fml::SyncSwitch> GetIsGpuDisabledSyncSwitch()
+      const override {
+    return is_gpu_disabled_sync_switch_;
+  }
+
+  // |Rasterizer::Delegate|
+  const Settings& GetSettings() const override { return settings_; }
+
+  // |Rasterizer::Delegate|
+  bool ShouldDiscardLayerTree(int64_t view_id,
+                              const flutter::LayerTree& tree) override {
+    return false;
+  }
+
+ private:
+  const TaskRunners& task_runners_;
+  Settings settings_;
+  std::shared_ptr<fml::SyncSwitch> is_gpu_disabled_sync_switch_;
+  std::vector<fml::TimeDelta> raster_times_;
+};
+
+// Renders into raster surfaces that are never presented.
+class SoftwareSurfaceDelegate final : public GPUSurfaceSoftwareDelegate {
+ public:
+  // |GPUSurfaceSoftwareDelegate|
+  sk_sp<SkSurface> AcquireBackingStore(const SkISize& size) override {
+    if (!backing_store_ || backing_store_->width() != size.width() ||
+        backing_store_->height() != size.height()) {
+      backing_store_ = SkSurfaces::Raster(
+          SkImageInfo::MakeN32Premul(size.width(), size.height()));
+    }
+    return backing_store_;
+  }
+
+  // |GPUSurfaceSoftwareDelegate|
+  bool PresentBackingStore(sk_sp<SkSurface> backing_store) override {
+    return true;
+  }
+
+ private:
+  sk_sp<SkSurface> backing_store_;
+};
+
+#if SHELL_ENABLE_GL
+// Renders into the offscreen framebuffer of a test GL surface.
+class GLSurfaceDelegate final : public GPUSurfaceGLDelegate {
+ public:
+  explicit GLSurfaceDelegate(const SkISize& size) : gl_surface_(size) {}
+
+  // |GPUSurfaceGLDelegate|
+  std::unique_ptr<GLContextResult> GLContextMakeCurrent() override {
+    return std::make_unique<GLContextDefaultResult>(gl_surface_.MakeCurrent());
+  }
+
+  // |GPUSurfaceGLDelegate|
+  bool GLContextClearCurrent() override { return gl_surface_.ClearCurrent(); }
+
+  // |GPUSurfaceGLDelegate|
+  bool GLContextPresent(const GLPresentInfo& present_info) override {
+    return gl_surface_.Present();
+  }
+
+  // |GPUSurfaceGLDelegate|
+  GLFBOInfo GLContextFBO(GLFrameInfo frame_info) const override {
+    return GLFBOInfo{
+        .fbo_id =
+            gl_surface_.GetFramebuffer(frame_info.width, frame_info.height),
+    };
+  }
+
+  // |GPUSurfaceGLDelegate|
+  GLProcResolver GetGLProcResolver() const override {
+    return [surface = &gl_surface_](const char* name) -> void* {
+      return surface->GetProcAddress(name);
+    };
+  }
+
+ private:
+  testing::TestGLSurface gl_surface_;
+};
+#endif  // SHELL_ENABLE_GL
+
+double MedianMilliseconds(std::vector<fml::TimeDelta> times) {
+  if (times.empty()) {
+    return 0.0;
+  }
+  auto middle = times.begin() + times.size() / 2;
+  std::nth_element(times.begin(), middle, times.end());
+  return middle->ToMillisecondsF();
+}
+
+void PrintUsage() {
+  std::cerr << "Usage: flutter_frame_replay --recording=<path> "
+               "[--backend=software|gl] [--iterations=<count>] "
+               "[--worst-frames=<count>]"
+            << std::endl;
+}
+
+// Draws |frame| with |rasterizer|. Must be called on the raster thread.
+bool DrawFrame(Rasterizer& rasterizer, const RecordedFrame& frame) {
+  auto root_layer = std::make_shared<DisplayListLayer>(
+      SkPoint::Make(0, 0), frame.display_list, /*is_complex=*/false,
+      /*will_change=*/false);
+  auto layer_tree = std::make_unique<LayerTree>(
+      LayerTree::Config{.root_layer = std::move(root_layer)},
+      frame.frame_size);
+
+  auto recorder = std::make_unique<FrameTimingsRecorder>();
+  const auto now = fml::TimePoint::Now();
+  recorder->RecordVsync(now, now + fml::TimeDelta::FromMillisecondsF(
+                                       fml::kDefaultFrameBudget.count()));
+  recorder->RecordBuildStart(now);
+  recorder->RecordBuildEnd(now);
+
+  auto pipeline = std::make_shared<LayerTreePipeline>(/*depth=*/1);
+  auto continuation = pipeline->Produce();
+  continuation.Complete(std::make_unique<LayerTreeItem>(
+      std::move(layer_tree), std::move(recorder), frame.device_pixel_ratio));
+  return rasterizer.Draw(pipeline) == RasterStatus::kSuccess;
+}
+
+}  // namespace
+
+bool Main(const fml::CommandLine& command_line) {
+  std::string recording_path;
+  if (!command_line.GetOptionValue("recording", &recording_path)) {
+    PrintUsage();
+    return false;
+  }
+
+  std::string backend = "software";
+  command_line.GetOptionValue("backend", &backend);
+  if (backend != "software"
+#if SHELL_ENABLE_GL
+      && backend != "gl"
+#endif  // SHELL_ENABLE_GL
+  ) {
+    std::cerr << "Unsupported backend: " << backend << std::endl;
+    return false;
+  }
+
+  size_t iterations = 10u;
+  std::string iterations_value;
+  if (command_line.GetOptionValue("iterations", &iterations_value)) {
+    iterations = std::max(std::atoi(iterations_value.c_str()), 1);
+  }
+
+  size_t worst_frame_count = 5u;
+  std::string worst_frames_value;
+  if (command_line.GetOptionValue("worst-frames", &worst_frames_value)) {
+    worst_frame_count = std::max(std::atoi(worst_frames_value.c_str()), 0);
+  }
+
+  auto data = fml::FileMapping::CreateReadOnly(recording_path);
+  if (!data) {
+    std::cerr << "Could not open the recording at " << recording_path
+              << std::endl;
+    return false;
+  }
+  auto recording = FrameRecording::Load(*data);
+  if (!recording || recording->GetFrames().empty()) {
+    std::cerr << "Could not load the recording at " << recording_path
+              << std::endl;
+    return false;
+  }
+  const auto& frames = recording->GetFrames();
+  std::cout << "Replaying " << frames.size() << " frames with the " << backend
+            << " backend." << std::endl;
+  if (recording->GetSkippedRecordCount() > 0) {
+    std::cout << recording->GetSkippedRecordCount()
+              << " records are missing from the frames as they could not be "
+                 "recorded."
+              << std::endl;
+  }
+
+  ThreadHost thread_host("io.flutter.frame_replay.",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("frame_replay",
+                           thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  ReplayDelegate delegate(task_runners);
+
+#if SHELL_ENABLE_GL
+  // The largest frame decides the size of the GL surface, so that it doesn't
+  // have to be recreated when the frame size changes.
+  SkISize surface_size = SkISize::MakeEmpty();
+  for (const auto& frame : frames) {
+    surface_size.set(
+        std::max(surface_size.width(), frame.frame_size.width()),
+        std::max(surface_size.height(), frame.frame_size.height()));
+  }
+#endif  // SHELL_ENABLE_GL
+
+  bool success = true;
+  std::vector<std::vector<fml::TimeDelta>> raster_times(frames.size());
+  fml::AutoResetWaitableEvent latch;
+  task_runners.GetRasterTaskRunner()->PostTask([&]() {
+    SoftwareSurfaceDelegate software_delegate;
+#if SHELL_ENABLE_GL
+    std::unique_ptr<GLSurfaceDelegate> gl_delegate;
+#endif  // SHELL_ENABLE_GL
+    std::unique_ptr<Surface> surface;
+    if (backend == "software") {
+      surface = std::make_unique<GPUSurfaceSoftware>(&software_delegate, true);
+    }
+#if SHELL_ENABLE_GL
+    if (backend == "gl") {
+      gl_delegate = std::make_unique<GLSurfaceDelegate>(surface_size);
+      surface = std::make_unique<GPUSurfaceGLSkia>(gl_delegate.get(), true);
+    }
+#endif  // SHELL_ENABLE_GL
+    if (!surface || !surface->IsValid()) {
+      std::cerr << "Could not create a " << backend << " surface."
+                << std::endl;
+      success = false;
+      latch.Signal();
+      return;
+    }
+
+    Rasterizer rasterizer(delegate);
+    rasterizer.Setup(std::move(surface));
+    for (size_t i = 0; i < iterations && success; i++) {
+      for (size_t frame = 0; frame < frames.size(); frame++) {
+        delegate.GetRasterTimes().clear();
+        if (!DrawFrame(rasterizer, frames[frame]) ||
+            delegate.GetRasterTimes().empty()) {
+          std::cerr << "Could not draw frame " << frame << "." << std::endl;
+          success = false;
+          break;
+        }
+        raster_times[frame].push_back(delegate.GetRasterTimes().back());
+      }
+    }
+    rasterizer.Teardown();
+    latch.Signal();
+  });
+  latch.Wait();
+  if (!success) {
+    return false;
+  }
+
+  std::vector<double> replayed(frames.size());
+  std::vector<fml::TimeDelta> recorded_times;
+  std::vector<fml::TimeDelta> replayed_times;
+  for (size_t frame = 0; frame < frames.size(); frame++) {
+    replayed[frame] = MedianMilliseconds(raster_times[frame]);
+    replayed_times.push_back(
+        fml::TimeDelta::FromMillisecondsF(replayed[frame]));
+    recorded_times.push_back(frames[frame].raster_time);
+  }
+
+  std::cout << std::fixed << std::setprecision(3);
+  std::cout << "Median raster time per frame over " << iterations
+            << " iterations: " << MedianMilliseconds(replayed_times)
+            << " ms replayed, " << MedianMilliseconds(recorded_times)
+            << " ms recorded." << std::endl;
+
+  std::vector<size_t> order(frames.size());
+  std::iota(order.begin(), order.end(), 0u);
+  std::sort(order.begin(), order.end(), [&replayed](size_t a, size_t b) {
+    return replayed[a] > replayed[b];
+  });
+  worst_frame_count = std::min(worst_frame_count, order.size());
+  if (worst_frame_count > 0) {
+    std::cout << "Slowest frames:" << std::endl;
+  }
+  for (size_t i = 0; i < worst_frame_count; i++) {
+    const auto& frame = frames[order[i]];
+    std::cout << "  " << order[i] << " (" << frame.frame_size.width() << "x"
+              << frame.frame_size.height() << ", "
+              << frame.display_list->op_count(true) << " ops): replayed "
+              << replayed[order[i]] << " ms, recorded "
+              << frame.raster_time.ToMillisecondsF() << " ms raster, "
+              << frame.build_time.ToMillisecondsF() << " ms build"
+              << std::endl;
+  }
+  return true;
+}
+
+}  // namespace flutter
+
+int main(int argc, char const* argv[]) {
+  return flutter::Main(fml::CommandLineFromPlatformOrArgcArgv(argc, argv))
+             ? EXIT_SUCCESS
+             : EXIT_FAILURE;
+}
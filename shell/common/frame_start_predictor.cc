@@ -0,0 +1,44 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_start_predictor.h"
+
+#include <algorithm>
+
+namespace flutter {
+
+FrameStartPredictor::FrameStartPredictor() = default;
+
+FrameStartPredictor::~FrameStartPredictor() = default;
+
+void FrameStartPredictor::RecordFrame(const FrameTiming& timing) {
+  build_durations_[next_frame_index_] =
+      timing.Get(FrameTiming::kBuildFinish) -
+      timing.Get(FrameTiming::kBuildStart);
+  raster_durations_[next_frame_index_] =
+      timing.Get(FrameTiming::kRasterFinish) -
+      timing.Get(FrameTiming::kRasterStart);
+  next_frame_index_ = (next_frame_index_ + 1u) % kWindowSize;
+  frame_count_ = std::min(frame_count_ + 1u, kWindowSize);
+}
+
+fml::TimeDelta FrameStartPredictor::GetBuildStartDelay(
+    fml::TimeDelta frame_interval) const {
+  if (frame_count_ < kMinFrameCount ||
+      frame_interval <= fml::TimeDelta::Zero()) {
+    return fml::TimeDelta::Zero();
+  }
+  const auto build_duration = *std::max_element(
+      build_durations_.begin(), build_durations_.begin() + frame_count_);
+  const auto raster_duration = *std::max_element(
+      raster_durations_.begin(), raster_durations_.begin() + frame_count_);
+  // Leave a quarter of the interval for frames that are slower than the
+  // recent ones.
+  const auto margin = frame_interval / 4;
+  const auto delay =
+      frame_interval - build_duration - raster_duration - margin;
+  return std::clamp(delay, fml::TimeDelta::Zero(), frame_interval / 2);
+}
+
+}  // namespace flutter
@@ -0,0 +1,61 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_FRAME_START_PREDICTOR_H_
+#define FLUTTER_SHELL_COMMON_FRAME_START_PREDICTOR_H_
+
+#include <array>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Predicts how long a frame can wait after its vsync before it
+///             starts building, from the build and raster times of recent
+///             frames.
+///
+///             Starting the build later lets the frame pick up input that
+///             arrives after the vsync, which lowers input-to-photon latency.
+///             The prediction leaves room for the slowest recent build and
+///             raster times plus a margin before the frame's target time, and
+///             never delays the build by more than half of the vsync interval.
+///
+class FrameStartPredictor {
+ public:
+  /// The number of recent frames predictions are made from.
+  static constexpr size_t kWindowSize = 30u;
+
+  /// The number of frames to record before builds are delayed.
+  static constexpr size_t kMinFrameCount = 10u;
+
+  FrameStartPredictor();
+
+  ~FrameStartPredictor();
+
+  void RecordFrame(const FrameTiming& timing);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The time to wait after the start of a vsync before building
+  ///             the frame of the vsync.
+  ///
+  /// @param[in]  frame_interval  The time from the start of the vsync to the
+  ///                             target time of the frame.
+  ///
+  fml::TimeDelta GetBuildStartDelay(fml::TimeDelta frame_interval) const;
+
+ private:
+  std::array<fml::TimeDelta, kWindowSize> build_durations_;
+  std::array<fml::TimeDelta, kWindowSize> raster_durations_;
+  size_t frame_count_ = 0u;
+  size_t next_frame_index_ = 0u;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameStartPredictor);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_FRAME_START_PREDICTOR_H_
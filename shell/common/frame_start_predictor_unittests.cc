@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_start_predictor.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+FrameTiming MakeFrameTiming(int64_t build_millis, int64_t raster_millis) {
+  const auto vsync_start = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromMilliseconds(1000));
+  const auto build_finish =
+      vsync_start + fml::TimeDelta::FromMilliseconds(build_millis);
+  FrameTiming timing;
+  timing.Set(FrameTiming::kVsyncStart, vsync_start);
+  timing.Set(FrameTiming::kBuildStart, vsync_start);
+  timing.Set(FrameTiming::kBuildFinish, build_finish);
+  timing.Set(FrameTiming::kRasterStart, build_finish);
+  timing.Set(FrameTiming::kRasterFinish,
+             build_finish + fml::TimeDelta::FromMilliseconds(raster_millis));
+  return timing;
+}
+
+}  // namespace
+
+TEST(FrameStartPredictorTest, DoesNotDelayBuildsWithoutHistory) {
+  FrameStartPredictor predictor;
+  const auto interval = fml::TimeDelta::FromMilliseconds(16);
+  EXPECT_EQ(predictor.GetBuildStartDelay(interval), fml::TimeDelta::Zero());
+
+  for (size_t i = 1; i < FrameStartPredictor::kMinFrameCount; i++) {
+    predictor.RecordFrame(MakeFrameTiming(1, 1));
+  }
+  EXPECT_EQ(predictor.GetBuildStartDelay(interval), fml::TimeDelta::Zero());
+
+  predictor.RecordFrame(MakeFrameTiming(1, 1));
+  EXPECT_GT(predictor.GetBuildStartDelay(interval), fml::TimeDelta::Zero());
+  EXPECT_EQ(predictor.GetBuildStartDelay(fml::TimeDelta::Zero()),
+            fml::TimeDelta::Zero());
+}
+
+TEST(FrameStartPredictorTest, LeavesRoomForTheSlowestRecentFrame) {
+  FrameStartPredictor predictor;
+  const auto interval = fml::TimeDelta::FromMilliseconds(16);
+  for (size_t i = 0; i < FrameStartPredictor::kWindowSize; i++) {
+    predictor.RecordFrame(MakeFrameTiming(2, 2));
+  }
+  // 16 - 2 - 2 - 16 / 4.
+  EXPECT_EQ(predictor.GetBuildStartDelay(interval),
+            fml::TimeDelta::FromMilliseconds(8));
+
+  predictor.RecordFrame(MakeFrameTiming(3, 3));
+  EXPECT_EQ(predictor.GetBuildStartDelay(interval),
+            fml::TimeDelta::FromMilliseconds(6));
+
+  // Frames that can't be on time start building right away.
+  predictor.RecordFrame(MakeFrameTiming(10, 10));
+  EXPECT_EQ(predictor.GetBuildStartDelay(interval), fml::TimeDelta::Zero());
+
+  // The slow frames are forgotten once they leave the window.
+  for (size_t i = 0; i < FrameStartPredictor::kWindowSize; i++) {
+    predictor.RecordFrame(MakeFrameTiming(2, 2));
+  }
+  EXPECT_EQ(predictor.GetBuildStartDelay(interval),
+            fml::TimeDelta::FromMilliseconds(8));
+}
+
+TEST(FrameStartPredictorTest, DelaysBuildsByAtMostHalfOfTheInterval) {
+  FrameStartPredictor predictor;
+  for (size_t i = 0; i < FrameStartPredictor::kWindowSize; i++) {
+    predictor.RecordFrame(MakeFrameTiming(0, 0));
+  }
+  EXPECT_EQ(
+      predictor.GetBuildStartDelay(fml::TimeDelta::FromMilliseconds(16)),
+      fml::TimeDelta::FromMilliseconds(8));
+}
+
+}  // namespace testing
+}  // namespace flutter
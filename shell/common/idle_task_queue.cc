@@ -0,0 +1,52 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/idle_task_queue.h"
+
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+IdleTaskQueue::IdleTaskQueue(std::function<fml::TimePoint()> clock)
+    : clock_(std::move(clock)) {}
+
+IdleTaskQueue::~IdleTaskQueue() = default;
+
+void IdleTaskQueue::PostTask(std::string name, Task task) {
+  tasks_.push_back({std::move(name), std::move(task)});
+}
+
+size_t IdleTaskQueue::RunTasks(fml::TimePoint deadline) {
+  // Tasks posted by the tasks below wait for the next idle period, so that a
+  // task reposting itself can't take over the period.
+  size_t remaining = tasks_.size();
+  size_t count = 0u;
+  while (remaining > 0u && deadline - clock_() >= kMinimumIdleTime) {
+    PendingTask pending = std::move(tasks_.front());
+    tasks_.pop_front();
+    remaining--;
+    {
+      TRACE_EVENT1("flutter", "IdleTaskQueue::RunTask", "name",
+                   pending.name.c_str());
+      pending.task(deadline);
+    }
+    count++;
+    const fml::TimeDelta overrun = clock_() - deadline;
+    if (overrun > fml::TimeDelta::Zero()) {
+      FML_DLOG(WARNING) << "The idle task " << pending.name << " overran its "
+                        << "deadline by " << overrun.ToMillisecondsF()
+                        << "ms.";
+    }
+  }
+  return count;
+}
+
+size_t IdleTaskQueue::GetPendingTaskCount() const {
+  return tasks_.size();
+}
+
+}  // namespace flutter
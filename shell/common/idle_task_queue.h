@@ -0,0 +1,77 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_IDLE_TASK_QUEUE_H_
+#define FLUTTER_SHELL_COMMON_IDLE_TASK_QUEUE_H_
+
+#include <deque>
+#include <functional>
+#include <string>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A queue of tasks run on the UI task runner in the idle periods
+///             the animator reports between frames.
+///
+///             Tasks run in the order they were posted, as long as enough of
+///             the idle period remains. Each task is given the deadline of the
+///             period and is expected to return before it, possibly after
+///             posting a task for the rest of its work. Tasks posted while the
+///             queue is running wait for the next idle period.
+///
+///             This class is not thread-safe and must only be used on the UI
+///             task runner.
+///
+class IdleTaskQueue {
+ public:
+  using Task = std::function<void(fml::TimePoint deadline)>;
+
+  /// The shortest part of an idle period that tasks are started in.
+  static constexpr fml::TimeDelta kMinimumIdleTime =
+      fml::TimeDelta::FromMilliseconds(1);
+
+  explicit IdleTaskQueue(
+      std::function<fml::TimePoint()> clock = &fml::TimePoint::Now);
+
+  ~IdleTaskQueue();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Enqueues a task for the next idle period.
+  ///
+  /// @param[in]  name  The name of the task in traces and in the warnings
+  ///                   about tasks that overran their deadline.
+  /// @param[in]  task  The task.
+  ///
+  void PostTask(std::string name, Task task);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Runs the pending tasks until less than |kMinimumIdleTime|
+  ///             remains before |deadline|.
+  ///
+  /// @return     The number of tasks that were run.
+  ///
+  size_t RunTasks(fml::TimePoint deadline);
+
+  size_t GetPendingTaskCount() const;
+
+ private:
+  struct PendingTask {
+    std::string name;
+    Task task;
+  };
+
+  const std::function<fml::TimePoint()> clock_;
+  std::deque<PendingTask> tasks_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(IdleTaskQueue);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_IDLE_TASK_QUEUE_H_
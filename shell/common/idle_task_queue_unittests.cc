@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/idle_task_queue.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+class FakeClock {
+ public:
+  fml::TimePoint Now() const { return now_; }
+
+  void Advance(fml::TimeDelta delta) { now_ = now_ + delta; }
+
+  std::function<fml::TimePoint()> AsFunction() {
+    return [this]() { return Now(); };
+  }
+
+ private:
+  fml::TimePoint now_ = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromSeconds(1));
+};
+
+}  // namespace
+
+TEST(IdleTaskQueueTest, RunsTasksInOrderWithinTheDeadline) {
+  FakeClock clock;
+  IdleTaskQueue queue(clock.AsFunction());
+  std::vector<int> ran;
+  std::vector<fml::TimePoint> deadlines;
+  const fml::TimePoint deadline =
+      clock.Now() + fml::TimeDelta::FromMilliseconds(10);
+  for (int i = 0; i < 3; i++) {
+    queue.PostTask("task", [&, i](fml::TimePoint task_deadline) {
+      ran.push_back(i);
+      deadlines.push_back(task_deadline);
+      clock.Advance(fml::TimeDelta::FromMilliseconds(5));
+    });
+  }
+
+  // No time is left for the third task.
+  EXPECT_EQ(queue.RunTasks(deadline), 2u);
+  EXPECT_EQ(ran, (std::vector<int>{0, 1}));
+  EXPECT_EQ(deadlines, (std::vector<fml::TimePoint>{deadline, deadline}));
+  EXPECT_EQ(queue.GetPendingTaskCount(), 1u);
+
+  EXPECT_EQ(queue.RunTasks(clock.Now() + fml::TimeDelta::FromMilliseconds(10)),
+            1u);
+  EXPECT_EQ(ran, (std::vector<int>{0, 1, 2}));
+  EXPECT_EQ(queue.GetPendingTaskCount(), 0u);
+}
+
+TEST(IdleTaskQueueTest, DoesNotRunTasksPastTheDeadline) {
+  FakeClock clock;
+  IdleTaskQueue queue(clock.AsFunction());
+  bool ran = false;
+  queue.PostTask("task", [&](fml::TimePoint) { ran = true; });
+
+  EXPECT_EQ(queue.RunTasks(clock.Now()), 0u);
+  EXPECT_EQ(queue.RunTasks(clock.Now() + IdleTaskQueue::kMinimumIdleTime / 2),
+            0u);
+  EXPECT_FALSE(ran);
+  EXPECT_EQ(queue.GetPendingTaskCount(), 1u);
+}
+
+TEST(IdleTaskQueueTest, TasksPostedWhileRunningWaitForTheNextPeriod) {
+  FakeClock clock;
+  IdleTaskQueue queue(clock.AsFunction());
+  int runs = 0;
+  std::function<void(fml::TimePoint)> task = [&](fml::TimePoint) {
+    runs++;
+    queue.PostTask("task", task);
+  };
+  queue.PostTask("task", task);
+
+  const fml::TimePoint deadline =
+      clock.Now() + fml::TimeDelta::FromMilliseconds(10);
+  EXPECT_EQ(queue.RunTasks(deadline), 1u);
+  EXPECT_EQ(runs, 1);
+  EXPECT_EQ(queue.RunTasks(deadline), 1u);
+  EXPECT_EQ(runs, 2);
+  EXPECT_EQ(queue.GetPendingTaskCount(), 1u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -7,6 +7,7 @@
 #include <memory>
 
 #include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/common/graphics/persistent_cache_file.h"
 #include "flutter/flow/layers/container_layer.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/fml/command_line.h"
@@ -199,5 +200,115 @@ TEST_F(PersistentCacheTest, PurgeAllowsFutureSkSLCache) {
   DestroyShell(std::move(shell));
 }
 
+static sk_sp<SkData> MakeData(const std::string& string) {
+  return SkData::MakeWithCopy(string.data(), string.size());
+}
+
+static std::shared_ptr<fml::UniqueFD> OpenCacheDirectory(
+    const fml::ScopedTemporaryDirectory& directory) {
+  return std::make_shared<fml::UniqueFD>(fml::OpenDirectory(
+      directory.path().c_str(), false, fml::FilePermission::kReadWrite));
+}
+
+TEST(PersistentCacheFileTest, WritesEntriesInBatches) {
+  fml::ScopedTemporaryDirectory base_dir;
+  auto directory = OpenCacheDirectory(base_dir);
+  {
+    PersistentCacheFile file(directory, "cache", 1024, false);
+    ASSERT_EQ(file.GetEntryCount(), 0u);
+    EXPECT_TRUE(file.Store(*MakeData("a"), *MakeData("x")));
+    EXPECT_FALSE(file.Store(*MakeData("b"), *MakeData("y")));
+    CheckTextSkData(file.Load(*MakeData("a")), "x");
+    EXPECT_EQ(file.Load(*MakeData("c")), nullptr);
+    ASSERT_TRUE(file.Flush());
+
+    // Appended to the file written by the first flush.
+    EXPECT_TRUE(file.Store(*MakeData("c"), *MakeData("z")));
+    EXPECT_FALSE(file.Store(*MakeData("a"), *MakeData("w")));
+    ASSERT_TRUE(file.Flush());
+    CheckTextSkData(file.Load(*MakeData("a")), "w");
+  }
+
+  PersistentCacheFile file(directory, "cache", 1024, false);
+  ASSERT_EQ(file.GetEntryCount(), 3u);
+  CheckTextSkData(file.Load(*MakeData("a")), "w");
+  CheckTextSkData(file.Load(*MakeData("b")), "y");
+  CheckTextSkData(file.Load(*MakeData("c")), "z");
+
+  // Storing an unchanged value doesn't need a flush.
+  EXPECT_FALSE(file.Store(*MakeData("b"), *MakeData("y")));
+}
+
+TEST(PersistentCacheFileTest, RecoversFromCorruptRecords) {
+  fml::ScopedTemporaryDirectory base_dir;
+  auto directory = OpenCacheDirectory(base_dir);
+  {
+    PersistentCacheFile file(directory, "cache", 1024, false);
+    file.Store(*MakeData("a"), *MakeData("x"));
+    file.Store(*MakeData("b"), *MakeData("y"));
+    ASSERT_TRUE(file.Flush());
+  }
+
+  // Corrupt the value of the last record.
+  {
+    auto mapping = fml::FileMapping::CreateReadOnly(base_dir.path() + "/cache");
+    ASSERT_NE(mapping, nullptr);
+    std::vector<uint8_t> bytes(mapping->GetMapping(),
+                               mapping->GetMapping() + mapping->GetSize());
+    bytes.back() ^= 0xFF;
+    ASSERT_TRUE(fml::WriteAtomically(*directory, "cache",
+                                     fml::DataMapping(std::move(bytes))));
+  }
+
+  {
+    PersistentCacheFile file(directory, "cache", 1024, false);
+    EXPECT_EQ(file.GetEntryCount(), 1u);
+    EXPECT_EQ(file.GetEntries().size(), 1u);
+    // The file is rewritten without the corrupt record.
+    ASSERT_TRUE(file.Flush());
+  }
+
+  PersistentCacheFile file(directory, "cache", 1024, false);
+  EXPECT_EQ(file.GetEntryCount(), 1u);
+  EXPECT_TRUE(file.Store(*MakeData("c"), *MakeData("z")));
+}
+
+TEST(PersistentCacheFileTest, EvictsLeastRecentlyUsedEntries) {
+  fml::ScopedTemporaryDirectory base_dir;
+  auto directory = OpenCacheDirectory(base_dir);
+  const std::string value(100, 'v');
+  const size_t record_size =
+      sizeof(PersistentCacheFile::RecordHeader) + 1 + value.size();
+  {
+    PersistentCacheFile file(directory, "cache", 3 * record_size, false);
+    file.Store(*MakeData("a"), *MakeData(value));
+    file.Store(*MakeData("b"), *MakeData(value));
+    file.Store(*MakeData("c"), *MakeData(value));
+    ASSERT_TRUE(file.Flush());
+    EXPECT_EQ(file.GetEntryCount(), 3u);
+
+    ASSERT_NE(file.Load(*MakeData("a")), nullptr);
+    file.Store(*MakeData("d"), *MakeData(value));
+    ASSERT_TRUE(file.Flush());
+    EXPECT_EQ(file.GetEntryCount(), 2u);
+    EXPECT_LE(file.GetLiveSize(), 3 * record_size);
+  }
+
+  PersistentCacheFile file(directory, "cache", 3 * record_size, false);
+  EXPECT_EQ(file.GetEntryCount(), 2u);
+  EXPECT_NE(file.Load(*MakeData("a")), nullptr);
+  EXPECT_NE(file.Load(*MakeData("d")), nullptr);
+}
+
+TEST(PersistentCacheFileTest, IgnoresStoresWhenReadOnly) {
+  fml::ScopedTemporaryDirectory base_dir;
+  auto directory = OpenCacheDirectory(base_dir);
+  PersistentCacheFile file(directory, "cache", 1024, true);
+  EXPECT_FALSE(file.Store(*MakeData("a"), *MakeData("x")));
+  EXPECT_EQ(file.Load(*MakeData("a")), nullptr);
+  EXPECT_TRUE(file.Flush());
+  EXPECT_FALSE(fml::FileExists(*directory, "cache"));
+}
+
 }  // namespace testing
 }  // namespace flutter
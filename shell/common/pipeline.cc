@@ -11,4 +11,26 @@ size_t GetNextPipelineTraceID() {
   return ++PipelineLastTraceID;
 }
 
+AdaptivePipelineDepth::AdaptivePipelineDepth() = default;
+
+uint32_t AdaptivePipelineDepth::RecordFrame(fml::TimeDelta raster_duration,
+                                            fml::TimeDelta frame_interval) {
+  // Frames rendered outside of a vsync have no interval to compare with.
+  if (frame_interval <= fml::TimeDelta::Zero()) {
+    return depth_;
+  }
+  const bool is_slow = raster_duration > frame_interval;
+  slow_frame_count_ -= slow_frames_[next_frame_index_] ? 1u : 0u;
+  slow_frame_count_ += is_slow ? 1u : 0u;
+  slow_frames_[next_frame_index_] = is_slow;
+  next_frame_index_ = (next_frame_index_ + 1u) % kWindowSize;
+
+  if (slow_frame_count_ >= kSlowFramesToDeepen) {
+    depth_ = kMaxDepth;
+  } else if (slow_frame_count_ == 0u) {
+    depth_ = kMinDepth;
+  }
+  return depth_;
+}
+
 }  // namespace flutter
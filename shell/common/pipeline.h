@@ -5,6 +5,9 @@
 #ifndef FLUTTER_SHELL_COMMON_PIPELINE_H_
 #define FLUTTER_SHELL_COMMON_PIPELINE_H_
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <deque>
 #include <memory>
 #include <mutex>
@@ -14,6 +17,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/synchronization/semaphore.h"
+#include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
@@ -35,7 +39,7 @@ enum class PipelineConsumeResult {
 size_t GetNextPipelineTraceID();
 
 /// A thread-safe queue of resources for a single consumer and a single
-/// producer, with a maximum queue depth.
+/// producer, with a queue depth that may be changed up to a maximum depth.
 ///
 /// Pipelines support two key operations: produce and consume.
 ///
@@ -126,19 +130,39 @@ class Pipeline {
     FML_DISALLOW_COPY_AND_ASSIGN(ProducerContinuation);
   };
 
-  explicit Pipeline(uint32_t depth)
-      : empty_(depth), available_(0), inflight_(0) {}
+  explicit Pipeline(uint32_t depth) : Pipeline(depth, depth) {}
+
+  Pipeline(uint32_t depth, uint32_t max_depth)
+      : max_depth_(std::max(depth, max_depth)),
+        depth_(depth),
+        empty_(max_depth_),
+        available_(0),
+        inflight_(0) {}
 
   ~Pipeline() = default;
 
   bool IsValid() const { return empty_.IsValid() && available_.IsValid(); }
 
+  uint32_t GetDepth() const { return depth_; }
+
+  uint32_t GetMaxDepth() const { return max_depth_; }
+
+  /// Changes the number of resources that may be in flight, up to the maximum
+  /// depth. Resources already in flight beyond a lowered depth are still
+  /// consumed.
+  void SetDepth(uint32_t depth) {
+    depth_ = std::clamp(depth, 1u, max_depth_);
+  }
+
   /// Creates a `ProducerContinuation` that a producer can use to add a
   /// resource to the queue.
   ///
   /// If the queue is already at its maximum depth, the `ProducerContinuation`
   /// is returned with success = false.
   ProducerContinuation Produce() {
+    if (inflight_ >= static_cast<int>(depth_.load())) {
+      return {};
+    }
     if (!empty_.TryWait()) {
       return {};
     }
@@ -211,6 +235,8 @@ class Pipeline {
   }
 
  private:
+  const uint32_t max_depth_;
+  std::atomic<uint32_t> depth_;
   fml::Semaphore empty_;
   fml::Semaphore available_;
   std::atomic<int> inflight_;
@@ -267,6 +293,52 @@ struct LayerTreeItem {
 
 using LayerTreePipeline = Pipeline<LayerTreeItem>;
 
+//------------------------------------------------------------------------------
+/// @brief      Picks the depth of the layer tree pipeline from the raster
+///             times of recent frames.
+///
+///             A pipeline of depth 2 lets the UI thread build a frame while
+///             the previous one is rasterized. When rasterizing frames
+///             sometimes takes longer than a vsync interval, the UI thread
+///             has to wait for the raster thread and misses frames itself.
+///             Allowing a third frame in flight absorbs those frames at the
+///             cost of a frame of latency, so the pipeline only gets deeper
+///             while slow frames are being rasterized and gets shallower
+///             again once there were none for a while.
+///
+class AdaptivePipelineDepth {
+ public:
+  static constexpr uint32_t kMinDepth = 2u;
+  static constexpr uint32_t kMaxDepth = 3u;
+  /// The number of recent frames the depth is picked from.
+  static constexpr size_t kWindowSize = 60u;
+  /// The number of slow frames within the window that deepen the pipeline.
+  static constexpr size_t kSlowFramesToDeepen = 2u;
+
+  AdaptivePipelineDepth();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the raster time of a frame.
+  ///
+  /// @param[in]  raster_duration  How long rasterizing the frame took.
+  /// @param[in]  frame_interval   The vsync interval the frame was built for.
+  ///
+  /// @return     The depth the pipeline should have now.
+  ///
+  uint32_t RecordFrame(fml::TimeDelta raster_duration,
+                       fml::TimeDelta frame_interval);
+
+  uint32_t GetDepth() const { return depth_; }
+
+ private:
+  std::array<bool, kWindowSize> slow_frames_ = {};
+  size_t next_frame_index_ = 0u;
+  size_t slow_frame_count_ = 0u;
+  uint32_t depth_ = kMinDepth;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AdaptivePipelineDepth);
+};
+
 }  // namespace flutter
 
 #endif  // FLUTTER_SHELL_COMMON_PIPELINE_H_
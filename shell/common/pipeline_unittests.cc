@@ -144,5 +144,66 @@ TEST(PipelineTest, ProduceIfEmptySuccessfulIfQueueIsEmpty) {
   ASSERT_EQ(consume_result_1, PipelineConsumeResult::Done);
 }
 
+TEST(PipelineTest, DepthCanBeChangedUpToTheMaxDepth) {
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(2, 3);
+  ASSERT_EQ(pipeline->GetDepth(), 2u);
+  ASSERT_EQ(pipeline->GetMaxDepth(), 3u);
+
+  Continuation continuation_1 = pipeline->Produce();
+  Continuation continuation_2 = pipeline->Produce();
+  ASSERT_TRUE(continuation_1);
+  ASSERT_TRUE(continuation_2);
+  ASSERT_FALSE(pipeline->Produce());
+
+  pipeline->SetDepth(4);
+  ASSERT_EQ(pipeline->GetDepth(), 3u);
+  Continuation continuation_3 = pipeline->Produce();
+  ASSERT_TRUE(continuation_3);
+  ASSERT_FALSE(pipeline->Produce());
+
+  ASSERT_TRUE(continuation_1.Complete(std::make_unique<int>(1)).success);
+  ASSERT_TRUE(continuation_2.Complete(std::make_unique<int>(2)).success);
+  ASSERT_TRUE(continuation_3.Complete(std::make_unique<int>(3)).success);
+
+  // Resources in flight beyond a lowered depth are still consumed.
+  pipeline->SetDepth(2);
+  ASSERT_EQ(pipeline->Consume([](std::unique_ptr<int> v) {}),
+            PipelineConsumeResult::MoreAvailable);
+  ASSERT_FALSE(pipeline->Produce());
+  ASSERT_EQ(pipeline->Consume([](std::unique_ptr<int> v) {}),
+            PipelineConsumeResult::MoreAvailable);
+  ASSERT_TRUE(pipeline->Produce());
+}
+
+TEST(PipelineTest, AdaptivePipelineDepthFollowsSlowFrames) {
+  const auto interval = fml::TimeDelta::FromMicroseconds(8333);
+  const auto fast = fml::TimeDelta::FromMilliseconds(4);
+  const auto slow = fml::TimeDelta::FromMilliseconds(12);
+  AdaptivePipelineDepth depth;
+  ASSERT_EQ(depth.GetDepth(), AdaptivePipelineDepth::kMinDepth);
+
+  // A single slow frame doesn't add latency.
+  ASSERT_EQ(depth.RecordFrame(slow, interval),
+            AdaptivePipelineDepth::kMinDepth);
+  ASSERT_EQ(depth.RecordFrame(fast, interval),
+            AdaptivePipelineDepth::kMinDepth);
+  ASSERT_EQ(depth.RecordFrame(slow, interval),
+            AdaptivePipelineDepth::kMaxDepth);
+
+  // Frames without a vsync interval are ignored.
+  ASSERT_EQ(depth.RecordFrame(fast, fml::TimeDelta::Zero()),
+            AdaptivePipelineDepth::kMaxDepth);
+
+  // The depth stays up while any slow frame is in the window.
+  for (size_t i = 0; i < AdaptivePipelineDepth::kWindowSize - 2u; i++) {
+    ASSERT_EQ(depth.RecordFrame(fast, interval),
+              AdaptivePipelineDepth::kMaxDepth);
+  }
+  ASSERT_EQ(depth.RecordFrame(fast, interval),
+            AdaptivePipelineDepth::kMaxDepth);
+  ASSERT_EQ(depth.RecordFrame(fast, interval),
+            AdaptivePipelineDepth::kMinDepth);
+}
+
 }  // namespace testing
 }  // namespace flutter
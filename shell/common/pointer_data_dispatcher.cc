@@ -4,6 +4,8 @@
 
 #include "flutter/shell/common/pointer_data_dispatcher.h"
 
+#include <algorithm>
+
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
@@ -15,6 +17,38 @@ SmoothPointerDataDispatcher::SmoothPointerDataDispatcher(Delegate& delegate)
     : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
 SmoothPointerDataDispatcher::~SmoothPointerDataDispatcher() = default;
 
+BatchingPointerDataDispatcher::BatchingPointerDataDispatcher(Delegate& delegate)
+    : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
+BatchingPointerDataDispatcher::~BatchingPointerDataDispatcher() = default;
+
+namespace {
+
+bool CanMerge(const PointerData& pending, const PointerData& event) {
+  if (pending.device != event.device || pending.change != event.change ||
+      pending.kind != event.kind || pending.buttons != event.buttons ||
+      pending.signal_kind != PointerData::SignalKind::kNone ||
+      event.signal_kind != PointerData::SignalKind::kNone ||
+      pending.synthesized != 0 || event.synthesized != 0) {
+    return false;
+  }
+  return event.change == PointerData::Change::kMove ||
+         event.change == PointerData::Change::kHover ||
+         event.change == PointerData::Change::kPanZoomUpdate;
+}
+
+// The positions, pan, scale and rotation of an event are absolute, so the
+// later event is kept with the deltas of both.
+PointerData Merge(const PointerData& pending, const PointerData& event) {
+  PointerData merged = event;
+  merged.physical_delta_x += pending.physical_delta_x;
+  merged.physical_delta_y += pending.physical_delta_y;
+  merged.pan_delta_x += pending.pan_delta_x;
+  merged.pan_delta_y += pending.pan_delta_y;
+  return merged;
+}
+
+}  // namespace
+
 void DefaultPointerDataDispatcher::DispatchPacket(
     std::unique_ptr<PointerDataPacket> packet,
     uint64_t trace_flow_id) {
@@ -48,6 +82,79 @@ void SmoothPointerDataDispatcher::DispatchPacket(
   ScheduleSecondaryVsyncCallback();
 }
 
+void BatchingPointerDataDispatcher::DispatchPacket(
+    std::unique_ptr<PointerDataPacket> packet,
+    uint64_t trace_flow_id) {
+  TRACE_EVENT0_WITH_FLOW_IDS("flutter",
+                             "BatchingPointerDataDispatcher::DispatchPacket",
+                             /*flow_id_count=*/1, &trace_flow_id);
+  TRACE_FLOW_STEP("flutter", "PointerEvent", trace_flow_id);
+
+  if (is_pointer_data_in_progress_) {
+    if (pending_events_.empty()) {
+      pending_trace_flow_id_ = trace_flow_id;
+    } else {
+      // The events of the packet are dispatched with the pending packet.
+      TRACE_FLOW_END("flutter", "PointerEvent", trace_flow_id);
+    }
+    AppendToPendingEvents(*packet);
+  } else {
+    FML_DCHECK(pending_events_.empty());
+    DefaultPointerDataDispatcher::DispatchPacket(std::move(packet),
+                                                 trace_flow_id);
+  }
+  is_pointer_data_in_progress_ = true;
+  ScheduleSecondaryVsyncCallback();
+}
+
+void BatchingPointerDataDispatcher::AppendToPendingEvents(
+    const PointerDataPacket& packet) {
+  const size_t count = packet.GetLength();
+  for (size_t i = 0; i < count; i++) {
+    const PointerData event = packet.GetPointerData(i);
+    // Only the last pending event of the device can be merged with, so that
+    // the events of every device stay in order.
+    auto last = std::find_if(
+        pending_events_.rbegin(), pending_events_.rend(),
+        [&event](const PointerData& pending) {
+          return pending.device == event.device;
+        });
+    if (last != pending_events_.rend() && CanMerge(*last, event)) {
+      *last = Merge(*last, event);
+    } else {
+      pending_events_.push_back(event);
+    }
+  }
+}
+
+void BatchingPointerDataDispatcher::ScheduleSecondaryVsyncCallback() {
+  delegate_.ScheduleSecondaryVsyncCallback(
+      reinterpret_cast<uintptr_t>(this),
+      [dispatcher = weak_factory_.GetWeakPtr()]() {
+        if (dispatcher && dispatcher->is_pointer_data_in_progress_) {
+          if (!dispatcher->pending_events_.empty()) {
+            dispatcher->DispatchPendingEvents();
+          } else {
+            dispatcher->is_pointer_data_in_progress_ = false;
+          }
+        }
+      });
+}
+
+void BatchingPointerDataDispatcher::DispatchPendingEvents() {
+  FML_DCHECK(!pending_events_.empty());
+  FML_DCHECK(is_pointer_data_in_progress_);
+  auto packet = std::make_unique<PointerDataPacket>(pending_events_.size());
+  for (size_t i = 0; i < pending_events_.size(); i++) {
+    packet->SetPointerData(i, pending_events_[i]);
+  }
+  pending_events_.clear();
+  DefaultPointerDataDispatcher::DispatchPacket(std::move(packet),
+                                               pending_trace_flow_id_);
+  pending_trace_flow_id_ = 0;
+  ScheduleSecondaryVsyncCallback();
+}
+
 void SmoothPointerDataDispatcher::ScheduleSecondaryVsyncCallback() {
   delegate_.ScheduleSecondaryVsyncCallback(
       reinterpret_cast<uintptr_t>(this),
@@ -163,6 +163,47 @@ class SmoothPointerDataDispatcher : public DefaultPointerDataDispatcher {
   FML_DISALLOW_COPY_AND_ASSIGN(SmoothPointerDataDispatcher);
 };
 
+//------------------------------------------------------------------------------
+/// A dispatcher that delivers at most one packet per VSYNC after the first
+/// packet, merging the moves of each pointer that arrive within one VSYNC.
+///
+/// Like `SmoothPointerDataDispatcher`, a packet that arrives while no pointer
+/// data dispatch is in progress is dispatched right away. Packets that arrive
+/// while a dispatch is in progress are appended to a pending packet that is
+/// dispatched at the next VSYNC. A move, hover or pan/zoom update that
+/// follows an event of the same kind from the same device in the pending
+/// packet replaces it, with the deltas of both events added up.
+///
+/// Input panels that sample faster than the display refreshes, like 240Hz
+/// touch panels on 60Hz displays, otherwise wake the UI thread and the
+/// framework several times per frame with moves that the frame only needs the
+/// last of. Resampling the merged events to the frame time is left to the
+/// framework, which keeps the events it needs to interpolate around the
+/// sample time.
+class BatchingPointerDataDispatcher : public DefaultPointerDataDispatcher {
+ public:
+  explicit BatchingPointerDataDispatcher(Delegate& delegate);
+
+  // |PointerDataDispatcer|
+  void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                      uint64_t trace_flow_id) override;
+
+  virtual ~BatchingPointerDataDispatcher();
+
+ private:
+  void AppendToPendingEvents(const PointerDataPacket& packet);
+  void DispatchPendingEvents();
+  void ScheduleSecondaryVsyncCallback();
+
+  std::vector<PointerData> pending_events_;
+  uint64_t pending_trace_flow_id_ = 0;
+  bool is_pointer_data_in_progress_ = false;
+
+  // WeakPtrFactory must be the last member.
+  fml::WeakPtrFactory<BatchingPointerDataDispatcher> weak_factory_;
+  FML_DISALLOW_COPY_AND_ASSIGN(BatchingPointerDataDispatcher);
+};
+
 //--------------------------------------------------------------------------
 /// @brief      Signature for constructing PointerDataDispatcher.
 ///
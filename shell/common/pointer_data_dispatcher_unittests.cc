@@ -0,0 +1,134 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pointer_data_dispatcher.h"
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+class FakePointerDataDispatcherDelegate
+    : public PointerDataDispatcher::Delegate {
+ public:
+  // |PointerDataDispatcher::Delegate|
+  void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                        uint64_t trace_flow_id) override {
+    std::vector<PointerData> events;
+    for (size_t i = 0; i < packet->GetLength(); i++) {
+      events.push_back(packet->GetPointerData(i));
+    }
+    dispatched_packets.push_back(std::move(events));
+  }
+
+  // |PointerDataDispatcher::Delegate|
+  void ScheduleSecondaryVsyncCallback(uintptr_t id,
+                                      const fml::closure& callback) override {
+    vsync_callback = callback;
+  }
+
+  void FireVsync() {
+    auto callback = std::move(vsync_callback);
+    vsync_callback = nullptr;
+    if (callback) {
+      callback();
+    }
+  }
+
+  std::vector<std::vector<PointerData>> dispatched_packets;
+  fml::closure vsync_callback;
+};
+
+PointerData MakeEvent(PointerData::Change change,
+                      int64_t device,
+                      double x,
+                      double delta_x) {
+  PointerData event;
+  event.Clear();
+  event.change = change;
+  event.device = device;
+  event.physical_x = x;
+  event.physical_delta_x = delta_x;
+  return event;
+}
+
+std::unique_ptr<PointerDataPacket> MakePacket(
+    const std::vector<PointerData>& events) {
+  auto packet = std::make_unique<PointerDataPacket>(events.size());
+  for (size_t i = 0; i < events.size(); i++) {
+    packet->SetPointerData(i, events[i]);
+  }
+  return packet;
+}
+
+}  // namespace
+
+TEST(BatchingPointerDataDispatcherTest, MergesMovesWithinOneVsync) {
+  using Change = PointerData::Change;
+  FakePointerDataDispatcherDelegate delegate;
+  BatchingPointerDataDispatcher dispatcher(delegate);
+
+  // The first packet is dispatched right away.
+  dispatcher.DispatchPacket(MakePacket({MakeEvent(Change::kDown, 0, 0, 0)}),
+                            1);
+  ASSERT_EQ(delegate.dispatched_packets.size(), 1u);
+
+  for (int i = 1; i <= 4; i++) {
+    dispatcher.DispatchPacket(
+        MakePacket({MakeEvent(Change::kMove, 0, i * 10, 10),
+                    MakeEvent(Change::kHover, 1, i, 1)}),
+        1 + i);
+  }
+  EXPECT_EQ(delegate.dispatched_packets.size(), 1u);
+
+  delegate.FireVsync();
+  ASSERT_EQ(delegate.dispatched_packets.size(), 2u);
+  const auto& merged = delegate.dispatched_packets[1];
+  ASSERT_EQ(merged.size(), 2u);
+  EXPECT_EQ(merged[0].device, 0);
+  EXPECT_EQ(merged[0].physical_x, 40);
+  EXPECT_EQ(merged[0].physical_delta_x, 40);
+  EXPECT_EQ(merged[1].device, 1);
+  EXPECT_EQ(merged[1].physical_x, 4);
+  EXPECT_EQ(merged[1].physical_delta_x, 4);
+
+  // Without new packets, the next vsync ends the dispatch in progress and the
+  // next packet is dispatched right away again.
+  delegate.FireVsync();
+  EXPECT_EQ(delegate.dispatched_packets.size(), 2u);
+  dispatcher.DispatchPacket(MakePacket({MakeEvent(Change::kUp, 0, 40, 0)}),
+                            6);
+  EXPECT_EQ(delegate.dispatched_packets.size(), 3u);
+}
+
+TEST(BatchingPointerDataDispatcherTest, KeepsTheOrderOfEachDevice) {
+  using Change = PointerData::Change;
+  FakePointerDataDispatcherDelegate delegate;
+  BatchingPointerDataDispatcher dispatcher(delegate);
+
+  dispatcher.DispatchPacket(MakePacket({MakeEvent(Change::kDown, 0, 0, 0)}),
+                            1);
+  dispatcher.DispatchPacket(MakePacket({MakeEvent(Change::kMove, 0, 1, 1),
+                                        MakeEvent(Change::kUp, 0, 1, 0),
+                                        MakeEvent(Change::kDown, 0, 2, 0),
+                                        MakeEvent(Change::kMove, 0, 3, 1)}),
+                            2);
+  delegate.FireVsync();
+
+  ASSERT_EQ(delegate.dispatched_packets.size(), 2u);
+  const auto& events = delegate.dispatched_packets[1];
+  ASSERT_EQ(events.size(), 4u);
+  EXPECT_EQ(events[0].change, Change::kMove);
+  EXPECT_EQ(events[1].change, Change::kUp);
+  EXPECT_EQ(events[2].change, Change::kDown);
+  EXPECT_EQ(events[3].change, Change::kMove);
+}
+
+}  // namespace testing
+}  // namespace flutter
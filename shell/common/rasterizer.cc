@@ -12,6 +12,9 @@
 #include "flutter/common/constants.h"
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/flow/layers/offscreen_surface.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/metrics.h"
+#include "flutter/fml/paths.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/shell/common/serialization_callbacks.h"
@@ -49,6 +52,11 @@ Rasterizer::Rasterizer(Delegate& delegate,
           SnapshotController::Make(*this, delegate.GetSettings())),
       weak_factory_(this) {
   FML_DCHECK(compositor_context_);
+  compositor_context_->set_retain_unchanged_subtrees(
+      delegate.GetSettings().enable_retained_layer_subtrees);
+  if (delegate.GetSettings().enable_adaptive_pipeline_depth) {
+    adaptive_pipeline_depth_ = std::make_unique<AdaptivePipelineDepth>();
+  }
 }
 
 Rasterizer::~Rasterizer() = default;
@@ -141,11 +149,18 @@ void Rasterizer::DisableThreadMergerIfNeeded() {
 }
 
 void Rasterizer::NotifyLowMemoryWarning() const {
+  compositor_context_->raster_cache().EvictRetainedEntries();
   if (!surface_) {
     FML_DLOG(INFO)
         << "Rasterizer::NotifyLowMemoryWarning called with no surface.";
     return;
   }
+#if IMPELLER_SUPPORTS_RENDERING
+  if (auto aiks_context = surface_->GetAiksContext()) {
+    aiks_context->ClearCachedResources();
+    return;
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
   auto context = surface_->GetContext();
   if (!context) {
     FML_DLOG(INFO)
@@ -231,6 +246,9 @@ RasterStatus Rasterizer::Draw(
   if (consume_result == PipelineConsumeResult::NoneAvailable) {
     return RasterStatus::kFailed;
   }
+  if (adaptive_pipeline_depth_) {
+    pipeline->SetDepth(adaptive_pipeline_depth_->GetDepth());
+  }
   // if the raster status is to resubmit the frame, we push the frame to the
   // front of the queue and also change the consume status to more available.
 
@@ -278,6 +296,29 @@ bool Rasterizer::ShouldResubmitFrame(const RasterStatus& raster_status) {
 }
 
 namespace {
+// Writes |data| to the file at |path| on the IO task runner, so that the
+// raster thread isn't blocked on the file system.
+void WriteFileOnIOThread(const TaskRunners& task_runners,
+                         const std::string& path,
+                         std::shared_ptr<fml::Mapping> data,
+                         const std::string& description) {
+  task_runners.GetIOTaskRunner()->PostTask(
+      [path, description, data = std::move(data)]() {
+        const auto directory_path = fml::paths::GetDirectoryName(path);
+        const auto directory = fml::OpenDirectory(
+            directory_path.empty() ? "." : directory_path.c_str(), false,
+            fml::FilePermission::kReadWrite);
+        const auto file_name = path.substr(path.find_last_of("/\\") + 1);
+        if (!directory.is_valid() ||
+            !fml::WriteAtomically(directory, file_name.c_str(), *data)) {
+          FML_LOG(ERROR) << "Could not write the " << description << " to "
+                         << path;
+          return;
+        }
+        FML_LOG(INFO) << "Wrote the " << description << " to " << path;
+      });
+}
+
 std::unique_ptr<SnapshotDelegate::GpuImageResult> MakeBitmapImage(
     const sk_sp<DisplayList>& display_list,
     const SkImageInfo& image_info) {
@@ -412,9 +453,24 @@ Rasterizer::DoDrawResult Rasterizer::DoDraw(
 
   RasterStatus raster_status =
       DrawToSurface(*frame_timings_recorder, *layer_tree, device_pixel_ratio);
+  switch (raster_status) {
+    case RasterStatus::kSuccess:
+      FML_COUNTER_INCREMENT("flutter.rasterizer.frames");
+      break;
+    case RasterStatus::kDiscarded:
+      FML_COUNTER_INCREMENT("flutter.rasterizer.discarded_frames");
+      break;
+    case RasterStatus::kResubmit:
+    case RasterStatus::kSkipAndRetry:
+      FML_COUNTER_INCREMENT("flutter.rasterizer.resubmitted_frames");
+      break;
+    default:
+      break;
+  }
   if (raster_status == RasterStatus::kSuccess) {
     last_layer_tree_ = std::move(layer_tree);
     last_device_pixel_ratio_ = device_pixel_ratio;
+    RecordFrame(*frame_timings_recorder);
   } else if (ShouldResubmitFrame(raster_status)) {
     return DoDrawResult{
         .raster_status = raster_status,
@@ -442,6 +498,14 @@ Rasterizer::DoDrawResult Rasterizer::DoDraw(
   // for Fuchsia to capture SceneUpdateContext::ExecutePaintTasks.
   delegate_.OnFrameRasterized(frame_timings_recorder->GetRecordedTime());
 
+  if (adaptive_pipeline_depth_) {
+    adaptive_pipeline_depth_->RecordFrame(
+        frame_timings_recorder->GetRasterEndTime() -
+            frame_timings_recorder->GetRasterStartTime(),
+        frame_timings_recorder->GetVsyncTargetTime() -
+            frame_timings_recorder->GetVsyncStartTime());
+  }
+
 // SceneDisplayLag events are disabled on Fuchsia.
 // see: https://github.com/flutter/flutter/issues/56598
 #if !defined(OS_FUCHSIA)
@@ -554,6 +618,24 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
 
   frame_timings_recorder.RecordRasterStart(fml::TimePoint::Now());
 
+#if IMPELLER_SUPPORTS_RENDERING
+  // The command buffers submitted until the frame is submitted are measured as
+  // the GPU time of the frame.
+  std::shared_ptr<impeller::GPUTracer> gpu_tracer;
+  std::shared_ptr<impeller::Context> impeller_context;
+  std::shared_ptr<impeller::FrameCapture> frame_capture;
+  if (auto aiks_context = surface_->GetAiksContext()) {
+    impeller_context = aiks_context->GetContext();
+    frame_capture = MaybeStartFrameCapture(*impeller_context);
+    gpu_tracer = impeller_context->GetGPUTracer();
+    if (gpu_tracer->IsSupported()) {
+      gpu_tracer->BeginFrame();
+    } else {
+      gpu_tracer.reset();
+    }
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
   // On Android, the external view embedder deletes surfaces in `BeginFrame`.
   //
   // Deleting a surface also clears the GL context. Therefore, acquire the
@@ -652,6 +734,27 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
       frame->Submit();
     }
 
+#if IMPELLER_SUPPORTS_RENDERING
+    if (gpu_tracer) {
+      auto raster_task_runner =
+          delegate_.GetTaskRunners().GetRasterTaskRunner();
+      gpu_tracer->EndFrame([frame_number =
+                                frame_timings_recorder.GetFrameNumber(),
+                            raster_task_runner, weak_this = GetWeakPtr()](
+                               fml::TimeDelta gpu_time) {
+        raster_task_runner->PostTask([frame_number, gpu_time, weak_this]() {
+          if (weak_this) {
+            weak_this->delegate_.OnFrameGPUTimeMeasured(frame_number,
+                                                        gpu_time);
+          }
+        });
+      });
+    }
+    if (frame_capture) {
+      FinishFrameCapture(*frame_capture, *impeller_context);
+    }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
     // Do not update raster cache metrics for kResubmit because that status
     // indicates that the frame was not actually painted.
     if (raster_status != RasterStatus::kResubmit) {
@@ -837,6 +940,73 @@ void Rasterizer::FireNextFrameCallbackIfPresent() {
   callback();
 }
 
+#if IMPELLER_SUPPORTS_RENDERING
+std::shared_ptr<impeller::FrameCapture> Rasterizer::MaybeStartFrameCapture(
+    const impeller::Context& context) {
+  const auto& settings = delegate_.GetSettings();
+  if (settings.impeller_capture_path.empty() || impeller_frame_captured_) {
+    return nullptr;
+  }
+  if (++impeller_frame_count_ < settings.impeller_capture_frame) {
+    return nullptr;
+  }
+  auto frame_capture = context.GetFrameCapture();
+  frame_capture->Start();
+  return frame_capture;
+}
+
+void Rasterizer::FinishFrameCapture(impeller::FrameCapture& frame_capture,
+                                    const impeller::Context& context) {
+  auto capture = frame_capture.Finish(context);
+  if (!capture) {
+    return;
+  }
+  impeller_frame_captured_ = true;
+  // Write the capture on the IO thread, as it holds the contents of the
+  // buffers of the frame.
+  WriteFileOnIOThread(delegate_.GetTaskRunners(),
+                      delegate_.GetSettings().impeller_capture_path,
+                      std::move(capture), "Impeller frame capture");
+}
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
+void Rasterizer::RecordFrame(
+    const FrameTimingsRecorder& frame_timings_recorder) {
+  const auto& settings = delegate_.GetSettings();
+  if (settings.frame_recording_path.empty() || frame_recording_written_) {
+    return;
+  }
+  if (!frame_recording_writer_) {
+    frame_recording_writer_ = std::make_unique<FrameRecordingWriter>();
+  }
+  const auto& frame_size = last_layer_tree_->frame_size();
+  auto display_list = last_layer_tree_->Flatten(
+      SkRect::Make(frame_size), compositor_context_->texture_registry(),
+      surface_->GetContext());
+  if (!display_list) {
+    return;
+  }
+  frame_recording_writer_->AddFrame(
+      *display_list, frame_size, last_device_pixel_ratio_,
+      frame_timings_recorder.GetBuildDuration(),
+      frame_timings_recorder.GetRasterEndTime() -
+          frame_timings_recorder.GetRasterStartTime(),
+      surface_->GetContext());
+  if (frame_recording_writer_->GetFrameCount() <
+      settings.frame_recording_count) {
+    return;
+  }
+  if (frame_recording_writer_->GetSkippedRecordCount() > 0) {
+    FML_LOG(INFO) << "The frame recording is missing "
+                  << frame_recording_writer_->GetSkippedRecordCount()
+                  << " records that can't be recorded.";
+  }
+  WriteFileOnIOThread(delegate_.GetTaskRunners(), settings.frame_recording_path,
+                      frame_recording_writer_->Finish(), "frame recording");
+  frame_recording_writer_.reset();
+  frame_recording_written_ = true;
+}
+
 void Rasterizer::SetResourceCacheMaxBytes(size_t max_bytes, bool from_user) {
   user_override_resource_cache_bytes_ |= from_user;
 
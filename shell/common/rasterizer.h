@@ -30,6 +30,7 @@
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"  // nogncheck
 #endif  // IMPELLER_SUPPORTS_RENDERING
 #include "flutter/lib/ui/snapshot_delegate.h"
+#include "flutter/shell/common/frame_recording.h"
 #include "flutter/shell/common/pipeline.h"
 #include "flutter/shell/common/snapshot_controller.h"
 #include "flutter/shell/common/snapshot_surface_producer.h"
@@ -94,6 +95,18 @@ class Rasterizer final : public SnapshotDelegate,
     ///
     virtual void OnFrameRasterized(const FrameTiming& frame_timing) = 0;
 
+    //--------------------------------------------------------------------------
+    /// @brief      Notifies the delegate of the time the GPU spent executing
+    ///             the work of a rasterized frame. This happens after
+    ///             |OnFrameRasterized| for the frame, once the GPU is done with
+    ///             it, and only for backends that measure GPU time.
+    ///
+    /// @param[in]  frame_number  The number of the rasterized frame.
+    /// @param[in]  gpu_time      The time the GPU spent on the frame.
+    ///
+    virtual void OnFrameGPUTimeMeasured(uint64_t frame_number,
+                                        fml::TimeDelta gpu_time) = 0;
+
     /// Time limit for a smooth frame.
     ///
     /// See: `DisplayManager::GetMainDisplayRefreshRate`.
@@ -595,6 +608,29 @@ class Rasterizer final : public SnapshotDelegate,
 
   void FireNextFrameCallbackIfPresent();
 
+#if IMPELLER_SUPPORTS_RENDERING
+  //----------------------------------------------------------------------------
+  /// @brief      Start recording the render passes of the frame if it is the
+  ///             frame to capture with `Settings::impeller_capture_path`.
+  ///
+  /// @return     The recorder of the frame, or nullptr if the frame isn't
+  ///             captured.
+  ///
+  std::shared_ptr<impeller::FrameCapture> MaybeStartFrameCapture(
+      const impeller::Context& context);
+
+  void FinishFrameCapture(impeller::FrameCapture& frame_capture,
+                          const impeller::Context& context);
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds the last layer tree to the frame recording if frames are
+  ///             recorded with `Settings::frame_recording_path`, and writes the
+  ///             recording once it holds `Settings::frame_recording_count`
+  ///             frames.
+  ///
+  void RecordFrame(const FrameTimingsRecorder& frame_timings_recorder);
+
   static bool ShouldResubmitFrame(const RasterStatus& raster_status);
 
   Delegate& delegate_;
@@ -612,6 +648,15 @@ class Rasterizer final : public SnapshotDelegate,
   fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger_;
   std::shared_ptr<ExternalViewEmbedder> external_view_embedder_;
   std::unique_ptr<SnapshotController> snapshot_controller_;
+  // Only set when the pipeline depth adapts to the raster times of frames.
+  std::unique_ptr<AdaptivePipelineDepth> adaptive_pipeline_depth_;
+  // The number of frames rasterized with Impeller, until the frame to capture
+  // has been captured.
+  size_t impeller_frame_count_ = 0u;
+  bool impeller_frame_captured_ = false;
+  // The frames recorded so far, until the recording has been written.
+  std::unique_ptr<FrameRecordingWriter> frame_recording_writer_;
+  bool frame_recording_written_ = false;
 
   // WeakPtrFactory must be the last member.
   fml::TaskRunnerAffineWeakPtrFactory<Rasterizer> weak_factory_;
@@ -39,6 +39,10 @@ class MockDelegate : public Rasterizer::Delegate {
               OnFrameRasterized,
               (const FrameTiming& frame_timing),
               (override));
+  MOCK_METHOD(void,
+              OnFrameGPUTimeMeasured,
+              (uint64_t frame_number, fml::TimeDelta gpu_time),
+              (override));
   MOCK_METHOD(fml::Milliseconds, GetFrameBudget, (), (override));
   MOCK_METHOD(fml::TimePoint, GetLatestFrameTargetTime, (), (const, override));
   MOCK_METHOD(const TaskRunners&, GetTaskRunners, (), (const, override));
@@ -7,6 +7,7 @@
 #include <sstream>
 #include <utility>
 
+#include "flutter/assets/archive_asset_bundle.h"
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/fml/file.h"
@@ -25,10 +26,20 @@ RunConfiguration RunConfiguration::InferFromSettings(
         fml::Duplicate(settings.assets_dir), true));
   }
 
+  auto assets_directory = fml::OpenDirectory(
+      settings.assets_path.c_str(), false, fml::FilePermission::kRead);
+
+  // Assets packed into an archive are found without opening files. The
+  // directory still resolves the assets that aren't packed.
+  if (fml::FileExists(assets_directory, ArchiveAssetBundle::kArchiveFileName)) {
+    asset_manager->PushBack(std::make_unique<ArchiveAssetBundle>(
+        fml::OpenFileReadOnly(assets_directory,
+                              ArchiveAssetBundle::kArchiveFileName),
+        true));
+  }
+
   asset_manager->PushBack(std::make_unique<DirectoryAssetBundle>(
-      fml::OpenDirectory(settings.assets_path.c_str(), false,
-                         fml::FilePermission::kRead),
-      true));
+      std::move(assets_directory), true));
 
   return {IsolateConfiguration::InferFromSettings(settings, asset_manager,
                                                   io_worker),
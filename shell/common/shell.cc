@@ -5,6 +5,8 @@
 #define RAPIDJSON_HAS_STDSTRING 1
 #include "flutter/shell/common/shell.h"
 
+#include <charconv>
+#include <map>
 #include <memory>
 #include <sstream>
 #include <utility>
@@ -15,18 +17,24 @@
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/fml/base32.h"
 #include "flutter/fml/file.h"
+#include "flutter/fml/flight_recorder.h"
 #include "flutter/fml/icu_util.h"
 #include "flutter/fml/log_settings.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/message_loop.h"
+#include "flutter/fml/message_loop_task_queues.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/runtime/dart_service_isolate.h"
 #include "flutter/runtime/dart_vm.h"
+#include "flutter/runtime/snapshot_page_profile.h"
+#include "flutter/runtime/startup_profiler.h"
 #include "flutter/shell/common/engine.h"
 #include "flutter/shell/common/skia_event_tracer_impl.h"
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/common/vsync_waiter.h"
+#include "flutter/shell/common/vsync_waiter_unpaced.h"
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
@@ -41,6 +49,7 @@
 #include "third_party/skia/include/core/SkGraphics.h"
 #include "third_party/skia/include/utils/SkBase64.h"
 #include "third_party/tonic/common/log.h"
+#include "txt/platform.h"
 
 namespace flutter {
 
@@ -110,6 +119,18 @@ void PerformInitializationTasks(Settings& settings) {
 
   static std::once_flag gShellSettingsInitialization = {};
   std::call_once(gShellSettingsInitialization, [&settings] {
+    if (settings.trace_startup) {
+      StartupProfiler::GetInstance().Enable();
+    }
+    if (settings.enable_flight_recorder) {
+      fml::FlightRecorder::GetInstance().Enable();
+    }
+    if (settings.enable_task_queue_stats) {
+      fml::MessageLoopTaskQueues::GetInstance()->EnableStats();
+    }
+    StartupProfiler::ScopedPhase startup_phase(
+        "Shell::PerformInitializationTasks", "platform");
+
     tonic::SetLogHandler(
         [](const char* message) { FML_LOG(ERROR) << message; });
 
@@ -121,6 +142,10 @@ void PerformInitializationTasks(Settings& settings) {
       fml::tracing::TraceSetAllowlist(settings.trace_allowlist);
     }
 
+    if (settings.buffer_trace_events) {
+      fml::tracing::TraceSetEventBufferingEnabled(true);
+    }
+
     if (!settings.skia_deterministic_rendering_on_cpu) {
       SkGraphics::Init();
     } else {
@@ -130,9 +155,17 @@ void PerformInitializationTasks(Settings& settings) {
 
     if (settings.icu_initialization_required) {
       if (!settings.icu_data_path.empty()) {
-        fml::icu::InitializeICU(settings.icu_data_path);
+        if (settings.lazy_icu_initialization) {
+          fml::icu::InitializeICULazily(settings.icu_data_path);
+        } else {
+          fml::icu::InitializeICU(settings.icu_data_path);
+        }
       } else if (settings.icu_mapper) {
-        fml::icu::InitializeICUFromMapping(settings.icu_mapper());
+        if (settings.lazy_icu_initialization) {
+          fml::icu::InitializeICUFromMappingLazily(settings.icu_mapper);
+        } else {
+          fml::icu::InitializeICUFromMapping(settings.icu_mapper());
+        }
       } else {
         FML_DLOG(WARNING) << "Skipping ICU initialization in the shell.";
       }
@@ -159,11 +192,23 @@ std::unique_ptr<Shell> Shell::Create(
   // Always use the `vm_snapshot` and `isolate_snapshot` provided by the
   // settings to launch the VM.  If the VM is already running, the snapshot
   // arguments are ignored.
-  auto vm_snapshot = DartSnapshot::VMSnapshotFromSettings(settings);
-  auto isolate_snapshot = DartSnapshot::IsolateSnapshotFromSettings(settings);
-  auto vm = DartVMRef::Create(settings, vm_snapshot, isolate_snapshot);
+  fml::RefPtr<const DartSnapshot> isolate_snapshot;
+  auto vm = [&settings, &isolate_snapshot] {
+    StartupProfiler::ScopedPhase startup_phase("DartVM::Create", "platform");
+    auto vm_snapshot = DartSnapshot::VMSnapshotFromSettings(settings);
+    isolate_snapshot = DartSnapshot::IsolateSnapshotFromSettings(settings);
+    return DartVMRef::Create(settings, vm_snapshot, isolate_snapshot);
+  }();
   FML_CHECK(vm) << "Must be able to initialize the VM.";
 
+  if (settings.icu_initialization_required &&
+      settings.lazy_icu_initialization) {
+    // Get ICU ready before the first paragraph needs it, without holding up
+    // the first frame.
+    vm->GetConcurrentWorkerTaskRunner()->PostTask(
+        []() { fml::icu::WarmUpBreakIterators(); });
+  }
+
   // If the settings did not specify an `isolate_snapshot`, fall back to the
   // one the VM was launched with.
   if (!isolate_snapshot) {
@@ -212,8 +257,29 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                     !settings.skia_deterministic_rendering_on_cpu),
                 is_gpu_disabled));
 
+  // The default font manager doesn't depend on any of the subsystems. Create
+  // it on a worker while they are set up, instead of on the UI thread between
+  // setting up the engine and running it.
+  if (!settings.prefetched_default_font_manager) {
+    auto font_manager_promise =
+        std::make_shared<std::promise<sk_sp<SkFontMgr>>>();
+    shell->default_font_manager_ = font_manager_promise->get_future().share();
+    shell->GetConcurrentWorkerTaskRunner()->PostTask(
+        [font_manager_promise,
+         font_initialization_data = settings.font_initialization_data] {
+          TRACE_EVENT0("flutter", "Shell::CreateDefaultFontManager");
+          font_manager_promise->set_value(
+              txt::GetDefaultFontManager(font_initialization_data));
+        });
+  }
+
   // Create the platform view on the platform thread (this thread).
-  auto platform_view = on_create_platform_view(*shell.get());
+  std::unique_ptr<PlatformView> platform_view;
+  {
+    StartupProfiler::ScopedPhase startup_phase("PlatformView::Create",
+                                               "platform");
+    platform_view = on_create_platform_view(*shell.get());
+  }
   if (!platform_view || !platform_view->GetWeakPtr()) {
     return nullptr;
   }
@@ -233,15 +299,31 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
        impeller_context = platform_view->GetImpellerContext()  //
   ]() {
         TRACE_EVENT0("flutter", "ShellSetupGPUSubsystem");
+        StartupProfiler::ScopedPhase startup_phase("Rasterizer::Create",
+                                                   "raster");
         std::unique_ptr<Rasterizer> rasterizer(on_create_rasterizer(*shell));
         rasterizer->SetImpellerContext(impeller_context);
+        if (shell->GetSettings().enable_raster_cache_prerasterization) {
+          rasterizer->compositor_context()
+              ->raster_cache()
+              .SetPrerasterizeTaskRunner(
+                  shell->GetConcurrentWorkerTaskRunner());
+        }
+        rasterizer->compositor_context()->raster_cache().SetReuseScaledImages(
+            shell->GetSettings().enable_raster_cache_scaled_reuse);
         snapshot_delegate_promise.set_value(rasterizer->GetSnapshotDelegate());
         rasterizer_promise.set_value(std::move(rasterizer));
       });
 
   // Ask the platform view for the vsync waiter. This will be used by the engine
   // to create the animator.
-  auto vsync_waiter = platform_view->CreateVSyncWaiter();
+  // Unpaced frames don't wait for the vsyncs of the platform.
+  std::unique_ptr<VsyncWaiter> vsync_waiter;
+  if (shell->GetSettings().enable_unpaced_frame_scheduling) {
+    vsync_waiter = std::make_unique<VsyncWaiterUnpaced>(task_runners);
+  } else {
+    vsync_waiter = platform_view->CreateVSyncWaiter();
+  }
   if (!vsync_waiter) {
     return nullptr;
   }
@@ -272,6 +354,8 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
        is_backgrounded_sync_switch = shell->GetIsGpuDisabledSyncSwitch()  //
   ]() {
         TRACE_EVENT0("flutter", "ShellSetupIOSubsystem");
+        StartupProfiler::ScopedPhase startup_phase("ShellIOManager::Create",
+                                                   "io");
         std::shared_ptr<ShellIOManager> io_manager;
         if (parent_io_manager) {
           io_manager = parent_io_manager;
@@ -291,6 +375,11 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   // Send dispatcher_maker to the engine constructor because shell won't have
   // platform_view set until Shell::Setup is called later.
   auto dispatcher_maker = platform_view->GetDispatcherMaker();
+  if (shell->GetSettings().enable_pointer_event_batching) {
+    dispatcher_maker = [](PointerDataDispatcher::Delegate& delegate) {
+      return std::make_unique<BatchingPointerDataDispatcher>(delegate);
+    };
+  }
 
   // Create the engine on the UI thread.
   std::promise<std::unique_ptr<Engine>> engine_promise;
@@ -308,12 +397,15 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                          &unref_queue_future,                             //
                          &on_create_engine]() mutable {
         TRACE_EVENT0("flutter", "ShellSetupUISubsystem");
+        StartupProfiler::ScopedPhase startup_phase("Engine::Create", "ui");
         const auto& task_runners = shell->GetTaskRunners();
 
         // The animator is owned by the UI thread but it gets its vsync pulses
         // from the platform.
-        auto animator = std::make_unique<Animator>(*shell, task_runners,
-                                                   std::move(vsync_waiter));
+        auto animator = std::make_unique<Animator>(
+            *shell, task_runners, std::move(vsync_waiter),
+            shell->GetSettings().enable_predictive_frame_scheduling,
+            shell->GetSettings().max_frames_in_flight);
 
         engine_promise.set_value(
             on_create_engine(*shell,                          //
@@ -486,6 +578,26 @@ Shell::Shell(DartVMRef vm,
       task_runners_.GetPlatformTaskRunner(),
       std::bind(&Shell::OnServiceProtocolReloadAssetFonts, this,
                 std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetStartupProfileExtensionName] = {
+          task_runners_.GetUITaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetStartupProfile, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetLayerRasterProfileExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetLayerRasterProfile, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  // The flight recorder can be read on any thread. Reading it on the IO
+  // thread keeps the report available while the UI or raster thread janks.
+  service_protocol_handlers_[ServiceProtocol::kGetFlightRecordExtensionName] =
+      {task_runners_.GetIOTaskRunner(),
+       std::bind(&Shell::OnServiceProtocolGetFlightRecord, this,
+                 std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_[ServiceProtocol::kGetTaskQueueStatsExtensionName] =
+      {task_runners_.GetIOTaskRunner(),
+       std::bind(&Shell::OnServiceProtocolGetTaskQueueStats, this,
+                 std::placeholders::_1, std::placeholders::_2)};
 }
 
 Shell::~Shell() {
@@ -717,14 +829,17 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
   weak_platform_view_ = platform_view_->GetWeakPtr();
 
   engine_->AddView(kFlutterImplicitViewId, ViewportMetrics{});
-  // Setup the time-consuming default font manager right after engine created.
-  if (!settings_.prefetched_default_font_manager) {
-    fml::TaskRunner::RunNowOrPostTask(task_runners_.GetUITaskRunner(),
-                                      [engine = weak_engine_] {
-                                        if (engine) {
-                                          engine->SetupDefaultFontManager();
-                                        }
-                                      });
+  // Install the time-consuming default font manager right after engine
+  // created. It is usually ready by now.
+  if (default_font_manager_.valid()) {
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetUITaskRunner(),
+        [engine = weak_engine_, font_manager = default_font_manager_] {
+          if (engine) {
+            TRACE_EVENT0("flutter", "Shell::WaitForDefaultFontManager");
+            engine->SetDefaultFontManager(font_manager.get());
+          }
+        });
   }
 
   is_set_up_ = true;
@@ -819,6 +934,8 @@ void Shell::OnPlatformViewCreated(std::unique_ptr<Surface> surface) {
           // Enables the thread merger which may be used by the external view
           // embedder.
           rasterizer->EnableThreadMergerIfNeeded();
+          StartupProfiler::ScopedPhase startup_phase("Rasterizer::Setup",
+                                                     "raster");
           rasterizer->Setup(std::move(surface));
         }
 
@@ -1128,22 +1245,42 @@ void Shell::OnPlatformViewMarkTextureFrameAvailable(int64_t texture_id) {
   FML_DCHECK(is_set_up_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
-  // Tell the rasterizer that one of its textures has a new frame available.
+  {
+    std::scoped_lock lock(pending_texture_frames_->mutex);
+    bool was_empty = pending_texture_frames_->texture_ids.empty();
+    pending_texture_frames_->texture_ids.insert(texture_id);
+    if (!was_empty) {
+      // The task that tells the rasterizer and the frame request are already
+      // on their way.
+      return;
+    }
+  }
+
+  // Tell the rasterizer that its textures have new frames available.
   task_runners_.GetRasterTaskRunner()->PostTask(
-      [rasterizer = rasterizer_->GetWeakPtr(), texture_id]() {
-        auto registry = rasterizer->GetTextureRegistry();
+      [rasterizer = rasterizer_->GetWeakPtr(),
+       pending = pending_texture_frames_]() {
+        std::set<int64_t> texture_ids;
+        {
+          std::scoped_lock lock(pending->mutex);
+          texture_ids.swap(pending->texture_ids);
+        }
 
-        if (!registry) {
+        if (!rasterizer) {
           return;
         }
 
-        auto texture = registry->GetTexture(texture_id);
+        auto registry = rasterizer->GetTextureRegistry();
 
-        if (!texture) {
+        if (!registry) {
           return;
         }
 
-        texture->MarkNewFrameAvailable();
+        TRACE_EVENT1("flutter", "Shell::MarkTextureFramesAvailable", "count",
+                     std::to_string(texture_ids.size()).c_str());
+        for (int64_t id : texture_ids) {
+          registry->MarkTextureFrameAvailable(id);
+        }
       });
 
   // Schedule a new frame without having to rebuild the layer tree.
@@ -1261,9 +1398,9 @@ void Shell::OnEngineUpdateSemantics(SemanticsNodeUpdates update,
 
   task_runners_.GetPlatformTaskRunner()->PostTask(
       [view = platform_view_->GetWeakPtr(), update = std::move(update),
-       actions = std::move(actions)] {
+       actions = std::move(actions)]() mutable {
         if (view) {
-          view->UpdateSemantics(update, actions);
+          view->UpdateSemantics(std::move(update), std::move(actions));
         }
       });
 }
@@ -1518,6 +1655,78 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
     settings_.frame_rasterized_callback(timing);
   }
 
+  if (settings_.enable_predictive_frame_scheduling) {
+    task_runners_.GetUITaskRunner()->PostTask(
+        [engine = weak_engine_, timing]() {
+          if (engine) {
+            engine->RecordFrameTiming(timing);
+          }
+        });
+  }
+
+  auto& flight_recorder = fml::FlightRecorder::GetInstance();
+  if (flight_recorder.IsEnabled()) {
+    const auto frame_number = static_cast<uint32_t>(timing.GetFrameNumber());
+    flight_recorder.Record({
+        .type = fml::FlightRecorder::EventType::kFrame,
+        .id = frame_number,
+        .start = timing.Get(FrameTiming::kVsyncStart),
+        .end = timing.Get(FrameTiming::kRasterFinish),
+    });
+    flight_recorder.Record({
+        .type = fml::FlightRecorder::EventType::kFrameBuild,
+        .id = frame_number,
+        .start = timing.Get(FrameTiming::kBuildStart),
+        .end = timing.Get(FrameTiming::kBuildFinish),
+    });
+    flight_recorder.Record({
+        .type = fml::FlightRecorder::EventType::kFrameRaster,
+        .id = frame_number,
+        .start = timing.Get(FrameTiming::kRasterStart),
+        .end = timing.Get(FrameTiming::kRasterFinish),
+    });
+  }
+
+  // The first frame completes the startup profile.
+  auto& startup_profiler = StartupProfiler::GetInstance();
+  if (startup_profiler.IsRecording()) {
+    startup_profiler.RecordPhase({
+        .name = "FirstFrame::Build",
+        .thread = "ui",
+        .start = timing.Get(FrameTiming::kBuildStart),
+        .end = timing.Get(FrameTiming::kBuildFinish),
+    });
+    startup_profiler.RecordPhase({
+        .name = "FirstFrame::Raster",
+        .thread = "raster",
+        .start = timing.Get(FrameTiming::kRasterStart),
+        .end = timing.Get(FrameTiming::kRasterFinish),
+    });
+    startup_profiler.Complete();
+  }
+
+  if (!has_recorded_snapshot_page_profile_ &&
+      !settings_.snapshot_page_profile_path.empty()) {
+    has_recorded_snapshot_page_profile_ = true;
+    vm_->GetConcurrentWorkerTaskRunner()->PostTask(
+        [vm_data = vm_->GetVMData(),
+         path = settings_.snapshot_page_profile_path]() {
+          // A profile from a previous run was already prefetched.
+          if (SnapshotPageProfile::ReadFromFile(path).has_value()) {
+            return;
+          }
+          TRACE_EVENT0("flutter", "Shell::RecordSnapshotPageProfile");
+          SnapshotPageProfile profile;
+          vm_data->GetVMSnapshot().RecordResidentPages(
+              &profile, SnapshotPageProfile::Region::kVMData,
+              SnapshotPageProfile::Region::kVMInstructions);
+          vm_data->GetIsolateSnapshot()->RecordResidentPages(
+              &profile, SnapshotPageProfile::Region::kIsolateData,
+              SnapshotPageProfile::Region::kIsolateInstructions);
+          profile.WriteToFile(path);
+        });
+  }
+
   if (!needs_report_timings_) {
     return;
   }
@@ -1532,6 +1741,7 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
   unreported_timings_.push_back(timing.GetLayerCacheBytes());
   unreported_timings_.push_back(timing.GetPictureCacheCount());
   unreported_timings_.push_back(timing.GetPictureCacheBytes());
+  unreported_timings_.push_back(timing.GetGPUDuration().ToMicroseconds());
   unreported_timings_.push_back(timing.GetFrameNumber());
   FML_DCHECK(unreported_timings_.size() ==
              old_count + FrameTiming::kStatisticsCount);
@@ -1549,6 +1759,9 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
   // threshold to 100ms because performance overhead isn't that critical in
   // those cases.
   if (!first_frame_rasterized_ || UnreportedFramesCount() >= 100) {
+    if (!first_frame_rasterized_ && settings_.defer_vm_service_startup) {
+      DartServiceIsolate::ReleaseDeferredStartup();
+    }
     first_frame_rasterized_ = true;
     ReportTimings();
   } else if (!frame_timings_report_scheduled_) {
@@ -1576,6 +1789,23 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
   }
 }
 
+void Shell::OnFrameGPUTimeMeasured(uint64_t frame_number,
+                                   fml::TimeDelta gpu_time) {
+  FML_DCHECK(is_set_up_);
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+
+  // The GPU time of a frame is only reported if it is measured before the
+  // timings of the frame are.
+  constexpr size_t kStride = FrameTiming::kStatisticsCount;
+  for (size_t end = unreported_timings_.size(); end >= kStride;
+       end -= kStride) {
+    if (static_cast<uint64_t>(unreported_timings_[end - 1]) == frame_number) {
+      unreported_timings_[end - 2] = gpu_time.ToMicroseconds();
+      return;
+    }
+  }
+}
+
 fml::Milliseconds Shell::GetFrameBudget() {
   double display_refresh_rate = display_manager_->GetMainDisplayRefreshRate();
   if (display_refresh_rate > 0) {
@@ -2053,6 +2283,263 @@ bool Shell::OnServiceProtocolReloadAssetFonts(
   return true;
 }
 
+bool Shell::OnServiceProtocolGetStartupProfile(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  StartupProfiler::GetInstance().WriteReport(response);
+  return true;
+}
+
+// Parses the optional parameter |name| into |value|. Returns false if the
+// parameter is present but not a non-negative integer.
+static bool ParseOptionalSizeParameter(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    std::string_view name,
+    size_t* value) {
+  auto found = params.find(name);
+  if (found == params.end()) {
+    return true;
+  }
+  const std::string_view text = found->second;
+  const auto result =
+      std::from_chars(text.data(), text.data() + text.size(), *value);
+  return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+bool Shell::OnServiceProtocolGetLayerRasterProfile(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  size_t count = 20u;
+  size_t sampling_interval = 0u;
+  const bool has_sampling_interval = params.count("samplingInterval") > 0;
+  if (!ParseOptionalSizeParameter(params, "count", &count) ||
+      !ParseOptionalSizeParameter(params, "samplingInterval",
+                                  &sampling_interval)) {
+    ServiceProtocolParameterError(
+        response, "'count' and 'samplingInterval' must be integers.");
+    return false;
+  }
+
+  LayerRasterProfiler& profiler =
+      rasterizer_->compositor_context()->layer_raster_profiler();
+  if (has_sampling_interval) {
+    profiler.SetSamplingInterval(sampling_interval);
+  }
+
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "LayerRasterProfile", allocator);
+  response->AddMember<uint64_t>("samplingInterval",
+                                profiler.GetSamplingInterval(), allocator);
+  response->AddMember<uint64_t>("sampledFrames",
+                                profiler.GetSampledFrameCount(), allocator);
+
+  rapidjson::Value layers;
+  layers.SetArray();
+  for (const auto& stats : profiler.GetHotLayers(count)) {
+    rapidjson::Value layer;
+    layer.SetObject();
+    layer.AddMember<uint64_t>("layerUniqueId", stats.layer_unique_id,
+                              allocator);
+    layer.AddMember<uint64_t>("samples", stats.sample_count, allocator);
+    layer.AddMember<int64_t>("prerollMicros",
+                             stats.preroll_time.ToMicroseconds(), allocator);
+    layer.AddMember<int64_t>("paintMicros", stats.paint_time.ToMicroseconds(),
+                             allocator);
+    layer.AddMember<int64_t>("maxFrameMicros",
+                             stats.max_frame_time.ToMicroseconds(), allocator);
+    layers.PushBack(layer, allocator);
+  }
+  response->AddMember("layers", layers, allocator);
+
+  if (params.count("reset") > 0 && params.at("reset") == "true") {
+    profiler.Reset();
+  }
+  return true;
+}
+
+static const char* FlightRecorderEventTypeName(
+    fml::FlightRecorder::EventType type) {
+  switch (type) {
+    case fml::FlightRecorder::EventType::kFrame:
+      return "frame";
+    case fml::FlightRecorder::EventType::kFrameBuild:
+      return "build";
+    case fml::FlightRecorder::EventType::kFrameRaster:
+      return "raster";
+    case fml::FlightRecorder::EventType::kTaskLatency:
+      return "taskLatency";
+  }
+  return "unknown";
+}
+
+bool Shell::OnServiceProtocolGetFlightRecord(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetIOTaskRunner()->RunsTasksOnCurrentThread());
+  size_t window_millis = 0u;
+  if (!ParseOptionalSizeParameter(params, "windowMillis", &window_millis)) {
+    ServiceProtocolParameterError(response,
+                                  "'windowMillis' must be an integer.");
+    return false;
+  }
+
+  const auto& recorder = fml::FlightRecorder::GetInstance();
+  const auto events = recorder.GetEvents(
+      params.count("windowMillis") > 0
+          ? fml::TimeDelta::FromMilliseconds(window_millis)
+          : fml::TimeDelta::Max());
+
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "FlightRecord", allocator);
+  response->AddMember("enabled", recorder.IsEnabled(), allocator);
+  // Event times are in microseconds on the clock of the timeline.
+  rapidjson::Value records;
+  records.SetArray();
+  for (const auto& event : events) {
+    rapidjson::Value record;
+    record.SetObject();
+    const char* type = FlightRecorderEventTypeName(event.type);
+    record.AddMember("type", rapidjson::StringRef(type), allocator);
+    if (event.type == fml::FlightRecorder::EventType::kTaskLatency) {
+      record.AddMember<uint64_t>("queueId", event.id, allocator);
+      record.AddMember<uint64_t>("taskSourceGrade", event.detail, allocator);
+    } else {
+      record.AddMember<uint64_t>("frameNumber", event.id, allocator);
+    }
+    record.AddMember<int64_t>("startMicros",
+                              event.start.ToEpochDelta().ToMicroseconds(),
+                              allocator);
+    record.AddMember<int64_t>("endMicros",
+                              event.end.ToEpochDelta().ToMicroseconds(),
+                              allocator);
+    records.PushBack(record, allocator);
+  }
+  response->AddMember("events", records, allocator);
+  return true;
+}
+
+static rapidjson::Value TaskDurationHistogramToJson(
+    const fml::TaskDurationHistogram& histogram,
+    rapidjson::Document::AllocatorType& allocator) {
+  rapidjson::Value json;
+  json.SetObject();
+  json.AddMember<uint64_t>("count", histogram.count, allocator);
+  json.AddMember<int64_t>("totalMicros", histogram.total.ToMicroseconds(),
+                          allocator);
+  json.AddMember<int64_t>("maxMicros", histogram.max.ToMicroseconds(),
+                          allocator);
+  // Bucket 0 counts the tasks under 1us, and bucket i the tasks in
+  // [2^(i - 1), 2^i) microseconds.
+  rapidjson::Value buckets;
+  buckets.SetArray();
+  for (uint64_t bucket : histogram.buckets) {
+    buckets.PushBack(bucket, allocator);
+  }
+  json.AddMember("buckets", buckets, allocator);
+  return json;
+}
+
+bool Shell::OnServiceProtocolGetTaskQueueStats(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetIOTaskRunner()->RunsTasksOnCurrentThread());
+  const bool reset = params.count("reset") > 0 && params.at("reset") == "true";
+
+  // Several of the task runners may share a task queue, which is then
+  // reported once under the name of the first of them.
+  std::vector<std::pair<const char*, fml::TaskQueueId>> queues;
+  std::map<size_t, const char*> queue_names;
+  const std::pair<const char*, fml::RefPtr<fml::TaskRunner>> runners[] = {
+      {"platform", task_runners_.GetPlatformTaskRunner()},
+      {"ui", task_runners_.GetUITaskRunner()},
+      {"raster", task_runners_.GetRasterTaskRunner()},
+      {"io", task_runners_.GetIOTaskRunner()},
+  };
+  for (const auto& [name, runner] : runners) {
+    if (!runner) {
+      continue;
+    }
+    const auto queue_id = runner->GetTaskQueueId();
+    if (queue_names.emplace(static_cast<size_t>(queue_id), name).second) {
+      queues.emplace_back(name, queue_id);
+    }
+  }
+
+  auto* task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "TaskQueueStats", allocator);
+  response->AddMember("enabled", task_queues->IsStatsEnabled(), allocator);
+  rapidjson::Value queues_json;
+  queues_json.SetArray();
+  for (const auto& [name, queue_id] : queues) {
+    const auto stats = task_queues->GetStats(queue_id);
+    if (reset) {
+      task_queues->ResetStats(queue_id);
+    }
+    rapidjson::Value queue_json;
+    queue_json.SetObject();
+    queue_json.AddMember("name", rapidjson::StringRef(name), allocator);
+    queue_json.AddMember<uint64_t>("queueId", static_cast<size_t>(queue_id),
+                                   allocator);
+
+    rapidjson::Value grades;
+    grades.SetArray();
+    for (size_t grade = 0; grade < stats.grades.size(); grade++) {
+      rapidjson::Value grade_json;
+      grade_json.SetObject();
+      grade_json.AddMember<uint64_t>("taskSourceGrade", grade, allocator);
+      grade_json.AddMember(
+          "latency",
+          TaskDurationHistogramToJson(stats.grades[grade].latency, allocator),
+          allocator);
+      grade_json.AddMember(
+          "runTime",
+          TaskDurationHistogramToJson(stats.grades[grade].run_time, allocator),
+          allocator);
+      grades.PushBack(grade_json, allocator);
+    }
+    queue_json.AddMember("grades", grades, allocator);
+
+    // Posters are named after the queues of this shell when possible, and
+    // after their queue id otherwise.
+    rapidjson::Value posters;
+    posters.SetArray();
+    for (const auto& [poster, poster_stats] : stats.posters) {
+      rapidjson::Value poster_json;
+      poster_json.SetObject();
+      if (poster == fml::TaskQueueStats::kExternalPoster) {
+        poster_json.AddMember("poster", "external", allocator);
+      } else if (auto found = queue_names.find(poster);
+                 found != queue_names.end()) {
+        poster_json.AddMember("poster", rapidjson::StringRef(found->second),
+                              allocator);
+      } else {
+        const auto poster_name = "queue" + std::to_string(poster);
+        poster_json.AddMember(
+            "poster", rapidjson::Value(poster_name.c_str(), allocator),
+            allocator);
+      }
+      poster_json.AddMember<uint64_t>("count", poster_stats.count, allocator);
+      poster_json.AddMember<int64_t>(
+          "latencyMicros", poster_stats.total_latency.ToMicroseconds(),
+          allocator);
+      poster_json.AddMember<int64_t>(
+          "runTimeMicros", poster_stats.total_run_time.ToMicroseconds(),
+          allocator);
+      posters.PushBack(poster_json, allocator);
+    }
+    queue_json.AddMember("posters", posters, allocator);
+    queues_json.PushBack(queue_json, allocator);
+  }
+  response->AddMember("queues", queues_json, allocator);
+  return true;
+}
+
 void Shell::AddView(int64_t view_id, const ViewportMetrics& viewport_metrics) {
   TRACE_EVENT0("flutter", "Shell::AddView");
   FML_DCHECK(is_set_up_);
@@ -6,6 +6,7 @@
 #define SHELL_COMMON_SHELL_H_
 
 #include <functional>
+#include <future>
 #include <mutex>
 #include <string_view>
 #include <unordered_map>
@@ -449,6 +450,17 @@ class Shell final : public PlatformView::Delegate,
   /// messages per second indefinitely.
   std::mutex misbehaving_message_channels_mutex_;
   std::set<std::string> misbehaving_message_channels_;
+
+  /// The textures marked as having a new frame available on the platform
+  /// thread that the raster thread hasn't been told about yet. All the marks
+  /// made before the raster thread drains them share one raster task and one
+  /// frame request.
+  struct PendingTextureFrames {
+    std::mutex mutex;
+    std::set<int64_t> texture_ids;
+  };
+  const std::shared_ptr<PendingTextureFrames> pending_texture_frames_ =
+      std::make_shared<PendingTextureFrames>();
   const TaskRunners task_runners_;
   const fml::RefPtr<fml::RasterThreadMerger> parent_raster_thread_merger_;
   std::shared_ptr<ResourceCacheLimitCalculator>
@@ -466,6 +478,9 @@ class Shell final : public PlatformView::Delegate,
   std::shared_ptr<VolatilePathTracker> volatile_path_tracker_;
   std::shared_ptr<PlatformMessageHandler> platform_message_handler_;
   std::atomic<bool> route_messages_through_platform_thread_ = false;
+  // The default font manager, created on a worker while the subsystems of the
+  // shell are set up unless the embedder prefetched it.
+  std::shared_future<sk_sp<SkFontMgr>> default_font_manager_;
 
   fml::WeakPtr<Engine> weak_engine_;  // to be shared across threads
   fml::TaskRunnerAffineWeakPtr<Rasterizer>
@@ -496,6 +511,10 @@ class Shell final : public PlatformView::Delegate,
   // ui.PlatformDispatcher.onReportTimings.
   bool frame_timings_report_scheduled_ = false;
 
+  // Whether the snapshot page profile has been considered after the first
+  // rasterized frame. Only accessed on the raster thread.
+  bool has_recorded_snapshot_page_profile_ = false;
+
   // Vector of FrameTiming::kCount * n timestamps for n frames whose timings
   // have not been reported yet. Vector of ints instead of FrameTiming is stored
   // here for easier conversions to Dart objects.
@@ -690,6 +709,10 @@ class Shell final : public PlatformView::Delegate,
   // |Rasterizer::Delegate|
   void OnFrameRasterized(const FrameTiming&) override;
 
+  // |Rasterizer::Delegate|
+  void OnFrameGPUTimeMeasured(uint64_t frame_number,
+                              fml::TimeDelta gpu_time) override;
+
   // |Rasterizer::Delegate|
   fml::Milliseconds GetFrameBudget() override;
 
@@ -773,6 +796,43 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  //
+  // Reports the phases of the startup of the process recorded with
+  // `--trace-startup` and their critical path.
+  bool OnServiceProtocolGetStartupProfile(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Reports the layers with the most preroll and paint time in the frames
+  // sampled by the `LayerRasterProfiler`. Accepts the optional `count`
+  // (number of layers to report), `samplingInterval` (frames between samples,
+  // zero to stop sampling) and `reset` (discard the statistics after
+  // reporting them) parameters.
+  bool OnServiceProtocolGetLayerRasterProfile(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Reports the events kept by the flight recorder enabled with
+  // `--enable-flight-recorder`. Accepts the optional `windowMillis` parameter
+  // to only report the events that ended within that many milliseconds.
+  bool OnServiceProtocolGetFlightRecord(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Reports the task statistics of the task queues of this shell, collected
+  // with `--enable-task-queue-stats`. Accepts the optional `reset` parameter
+  // to clear the statistics once they are reported.
+  bool OnServiceProtocolGetTaskQueueStats(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
   // Send a system font change notification.
   void SendFontChangeNotification();
 
@@ -3862,6 +3862,35 @@ TEST_F(ShellTest, PrefetchDefaultFontManager) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, CreatesDefaultFontManagerWhileSettingUpShell) {
+  auto get_font_manager_count = [this](Shell* shell) {
+    fml::AutoResetWaitableEvent latch;
+    size_t font_manager_count;
+    fml::TaskRunner::RunNowOrPostTask(
+        shell->GetTaskRunners().GetUITaskRunner(),
+        [this, shell, &latch, &font_manager_count]() {
+          font_manager_count = GetFontCollection(shell)->GetFontManagersCount();
+          latch.Signal();
+        });
+    latch.Wait();
+    return font_manager_count;
+  };
+
+  auto prefetched_settings = CreateSettingsForFixture();
+  prefetched_settings.prefetched_default_font_manager = true;
+  auto prefetched_shell = CreateShell(prefetched_settings);
+  size_t font_manager_count_without_default =
+      get_font_manager_count(prefetched_shell.get());
+  DestroyShell(std::move(prefetched_shell));
+
+  // Without prefetching, the default font manager created on a worker is
+  // installed before the engine runs.
+  auto shell = CreateShell(CreateSettingsForFixture());
+  ASSERT_EQ(get_font_manager_count(shell.get()),
+            font_manager_count_without_default + 1);
+  DestroyShell(std::move(shell));
+}
+
 TEST_F(ShellTest, OnPlatformViewCreatedWhenUIThreadIsBusy) {
   // This test will deadlock if the threading logic in
   // Shell::OnCreatePlatformView is wrong.
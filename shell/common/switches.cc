@@ -242,6 +242,9 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
       // See https://github.com/dart-lang/sdk/issues/50233
       !command_line.HasOption(FlagForSwitch(Switch::DisableObservatory));
 
+  settings.defer_vm_service_startup =
+      command_line.HasOption(FlagForSwitch(Switch::DeferVMServiceStartup));
+
   // Enable mDNS VM Service Publication
   settings.enable_vm_service_publication =
       !command_line.HasOption(
@@ -319,12 +322,21 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.enable_software_rendering =
       command_line.HasOption(FlagForSwitch(Switch::EnableSoftwareRendering));
 
+  settings.enable_tiled_software_rendering = command_line.HasOption(
+      FlagForSwitch(Switch::EnableTiledSoftwareRendering));
+
   settings.endless_trace_buffer =
       command_line.HasOption(FlagForSwitch(Switch::EndlessTraceBuffer));
 
   settings.trace_startup =
       command_line.HasOption(FlagForSwitch(Switch::TraceStartup));
 
+  settings.enable_flight_recorder =
+      command_line.HasOption(FlagForSwitch(Switch::EnableFlightRecorder));
+
+  settings.enable_task_queue_stats =
+      command_line.HasOption(FlagForSwitch(Switch::EnableTaskQueueStats));
+
   settings.enable_serial_gc =
       command_line.HasOption(FlagForSwitch(Switch::EnableSerialGC));
 
@@ -357,6 +369,9 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   command_line.GetOptionValue(FlagForSwitch(Switch::TraceToFile),
                               &settings.trace_to_file);
 
+  settings.buffer_trace_events =
+      command_line.HasOption(FlagForSwitch(Switch::BufferTraceEvents));
+
   settings.skia_deterministic_rendering_on_cpu =
       command_line.HasOption(FlagForSwitch(Switch::SkiaDeterministicRendering));
 
@@ -445,6 +460,12 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
       command_line.HasOption(FlagForSwitch(Switch::UseTestFonts));
   settings.use_asset_fonts =
       !command_line.HasOption(FlagForSwitch(Switch::DisableAssetFonts));
+  settings.preload_asset_fonts =
+      command_line.HasOption(FlagForSwitch(Switch::PreloadAssetFonts));
+  settings.lazy_icu_initialization =
+      command_line.HasOption(FlagForSwitch(Switch::LazyICUInitialization));
+  settings.enable_paragraph_layout_cache =
+      command_line.HasOption(FlagForSwitch(Switch::EnableParagraphLayoutCache));
 
   {
     std::string enable_impeller_value;
@@ -467,6 +488,76 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
 
   settings.enable_vulkan_validation =
       command_line.HasOption(FlagForSwitch(Switch::EnableVulkanValidation));
+  settings.enable_vulkan_low_latency_present = command_line.HasOption(
+      FlagForSwitch(Switch::EnableVulkanLowLatencyPresent));
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::AnimatedImageDecodeAheadFrames))) {
+    if (!GetSwitchValue(command_line, Switch::AnimatedImageDecodeAheadFrames,
+                        &settings.animated_image_decode_ahead_frames)) {
+      FML_LOG(INFO) << "Animated image decode ahead frames specified was "
+                       "malformed. Will default to "
+                    << settings.animated_image_decode_ahead_frames;
+    }
+  }
+
+  settings.enable_impeller_gpu_image_downscaling = command_line.HasOption(
+      FlagForSwitch(Switch::EnableImpellerGpuImageDownscaling));
+
+  command_line.GetOptionValue(FlagForSwitch(Switch::ImpellerCapturePath),
+                              &settings.impeller_capture_path);
+
+  if (command_line.HasOption(FlagForSwitch(Switch::ImpellerCaptureFrame))) {
+    if (!GetSwitchValue(command_line, Switch::ImpellerCaptureFrame,
+                        &settings.impeller_capture_frame)) {
+      FML_LOG(INFO) << "Impeller capture frame specified was malformed. Will "
+                       "default to "
+                    << settings.impeller_capture_frame;
+    }
+  }
+
+  command_line.GetOptionValue(FlagForSwitch(Switch::FrameRecordingPath),
+                              &settings.frame_recording_path);
+
+  if (command_line.HasOption(FlagForSwitch(Switch::FrameRecordingCount))) {
+    if (!GetSwitchValue(command_line, Switch::FrameRecordingCount,
+                        &settings.frame_recording_count)) {
+      FML_LOG(INFO) << "Frame recording count specified was malformed. Will "
+                       "default to "
+                    << settings.frame_recording_count;
+    }
+  }
+
+  settings.enable_raster_cache_prerasterization = command_line.HasOption(
+      FlagForSwitch(Switch::EnableRasterCachePrerasterization));
+
+  settings.enable_raster_cache_scaled_reuse = command_line.HasOption(
+      FlagForSwitch(Switch::EnableRasterCacheScaledReuse));
+
+  settings.enable_retained_layer_subtrees = command_line.HasOption(
+      FlagForSwitch(Switch::EnableRetainedLayerSubtrees));
+
+  settings.enable_adaptive_pipeline_depth = command_line.HasOption(
+      FlagForSwitch(Switch::EnableAdaptivePipelineDepth));
+
+  settings.enable_predictive_frame_scheduling = command_line.HasOption(
+      FlagForSwitch(Switch::EnablePredictiveFrameScheduling));
+
+  settings.enable_pointer_event_batching = command_line.HasOption(
+      FlagForSwitch(Switch::EnablePointerEventBatching));
+
+  settings.enable_platform_view_transactions = command_line.HasOption(
+      FlagForSwitch(Switch::EnablePlatformViewTransactions));
+
+  settings.enable_unpaced_frame_scheduling = command_line.HasOption(
+      FlagForSwitch(Switch::EnableUnpacedFrameScheduling));
+
+  if (command_line.HasOption(FlagForSwitch(Switch::MaxFramesInFlight))) {
+    std::string max_frames_in_flight;
+    command_line.GetOptionValue(FlagForSwitch(Switch::MaxFramesInFlight),
+                                &max_frames_in_flight);
+    settings.max_frames_in_flight = std::stoi(max_frames_in_flight);
+  }
 
   settings.enable_embedder_api =
       command_line.HasOption(FlagForSwitch(Switch::EnableEmbedderAPI));
@@ -474,6 +565,19 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.prefetched_default_font_manager = command_line.HasOption(
       FlagForSwitch(Switch::PrefetchedDefaultFontManager));
 
+  command_line.GetOptionValue(FlagForSwitch(Switch::SnapshotPageProfilePath),
+                              &settings.snapshot_page_profile_path);
+
+  settings.enable_snapshot_huge_pages = command_line.HasOption(
+      FlagForSwitch(Switch::EnableSnapshotHugePages));
+
+  if (command_line.HasOption(FlagForSwitch(Switch::WarmIsolatePoolSize))) {
+    std::string warm_isolate_pool_size;
+    command_line.GetOptionValue(FlagForSwitch(Switch::WarmIsolatePoolSize),
+                                &warm_isolate_pool_size);
+    settings.warm_isolate_pool_size = std::stoi(warm_isolate_pool_size);
+  }
+
   std::string all_dart_flags;
   if (command_line.GetOptionValue(FlagForSwitch(Switch::DartFlags),
                                   &all_dart_flags)) {
@@ -106,6 +106,11 @@ DEF_SWITCH(DisableObservatory,
            "(deprecated) Disable the Dart VM Service. The Dart VM Service is "
            "never available "
            "in release mode.")
+DEF_SWITCH(DeferVMServiceStartup,
+           "defer-vm-service-startup",
+           "Start the Dart VM Service after the first frame has been "
+           "rasterized instead of during app startup. The VM Service starts "
+           "after a timeout when no frame is rasterized.")
 DEF_SWITCH(DisableVMServicePublication,
            "disable-vm-service-publication",
            "Disable mDNS Dart VM Service publication.")
@@ -133,6 +138,12 @@ DEF_SWITCH(EnableSoftwareRendering,
            "Enable rendering using the Skia software backend. This is useful "
            "when testing Flutter on emulators. By default, Flutter will "
            "attempt to either use OpenGL, Metal, or Vulkan.")
+DEF_SWITCH(EnableTiledSoftwareRendering,
+           "enable-tiled-software-rendering",
+           "Rasterize software rendered frames in tiles on the concurrent "
+           "worker threads, and only rasterize the tiles that changed since "
+           "the previous frame. This is useful on devices without a GPU that "
+           "have several CPU cores.")
 DEF_SWITCH(Route,
            "route",
            "Start app with an specific route defined on the framework")
@@ -162,6 +173,16 @@ DEF_SWITCH(TraceStartup,
            "trace-startup",
            "Trace early application lifecycle. Automatically switches to an "
            "endless trace buffer.")
+DEF_SWITCH(EnableFlightRecorder,
+           "enable-flight-recorder",
+           "Keep the timings of the most recent frames and the tasks that ran "
+           "late in a fixed-size buffer that is available through the "
+           "_flutter.getFlightRecord service protocol extension.")
+DEF_SWITCH(EnableTaskQueueStats,
+           "enable-task-queue-stats",
+           "Collect histograms of the latency and the run time of the tasks of "
+           "each task queue, available through the "
+           "_flutter.getTaskQueueStats service protocol extension.")
 DEF_SWITCH(TraceSkia,
            "trace-skia",
            "Trace Skia calls. This is useful when debugging the GPU threed."
@@ -202,6 +223,12 @@ DEF_SWITCH(TraceToFile,
            "Write the timeline trace to a file at the specified path. The file "
            "will be in Perfetto's proto format; it will be possible to load "
            "the file into Perfetto's trace viewer.")
+DEF_SWITCH(BufferTraceEvents,
+           "buffer-trace-events",
+           "Buffer the trace events without arguments on the thread that "
+           "records them and add them to the timeline once the outermost "
+           "trace event of the thread ends. This makes tracing cheaper within "
+           "the traced durations.")
 DEF_SWITCH(UseTestFonts,
            "use-test-fonts",
            "Running tests that layout and measure text will not yield "
@@ -275,6 +302,108 @@ DEF_SWITCH(EnableVulkanValidation,
            "Enable loading Vulkan validation layers. The layers must be "
            "available to the application and loadable. On non-Vulkan backends, "
            "this flag does nothing.")
+DEF_SWITCH(EnableVulkanLowLatencyPresent,
+           "enable-vulkan-low-latency-present",
+           "Present Vulkan swapchain images in mailbox or FIFO relaxed mode "
+           "when the surface supports it, instead of waiting for the vsync. "
+           "On non-Vulkan backends, this flag does nothing.")
+DEF_SWITCH(AnimatedImageDecodeAheadFrames,
+           "animated-image-decode-ahead-frames",
+           "The number of frames of animated images to decode on worker "
+           "threads ahead of the frames the framework asks for.")
+DEF_SWITCH(EnableImpellerGpuImageDownscaling,
+           "enable-impeller-gpu-image-downscaling",
+           "Downscale decoded images that are a power of two multiple of their "
+           "target size on the GPU instead of on IO worker threads. Only used "
+           "by Impeller.")
+DEF_SWITCH(ImpellerCapturePath,
+           "impeller-capture-path",
+           "Record the render passes of a frame rendered by Impeller to a "
+           "capture file at this path, which can be replayed with the "
+           "impeller_replay tool.")
+DEF_SWITCH(ImpellerCaptureFrame,
+           "impeller-capture-frame",
+           "The number of the frame to capture with --impeller-capture-path, "
+           "starting from 1 for the first frame. Defaults to 1.")
+DEF_SWITCH(FrameRecordingPath,
+           "frame-recording-path",
+           "Record the layer trees of the first frames rasterized to a file at "
+           "this path, which can be replayed with the flutter_frame_replay "
+           "tool.")
+DEF_SWITCH(FrameRecordingCount,
+           "frame-recording-count",
+           "The number of frames to record with --frame-recording-path. "
+           "Defaults to 300.")
+DEF_SWITCH(EnableRasterCachePrerasterization,
+           "enable-raster-cache-prerasterization",
+           "Rasterize display lists that are about to be raster cached on "
+           "worker threads ahead of the frame they are needed in instead of "
+           "on the raster thread.")
+DEF_SWITCH(EnableRasterCacheScaledReuse,
+           "enable-raster-cache-scaled-reuse",
+           "Draw display lists that aren't raster cached at their current "
+           "transform, such as during zoom animations, by scaling their cached "
+           "image at a slightly different scale instead of drawing them "
+           "directly.")
+DEF_SWITCH(LazyICUInitialization,
+           "lazy-icu-initialization",
+           "Map the ICU data and initialize ICU on a worker thread, or when "
+           "text is first laid out, instead of before the Dart VM is "
+           "created.")
+DEF_SWITCH(PreloadAssetFonts,
+           "preload-asset-fonts",
+           "Parse the fonts declared in the font manifest on worker threads "
+           "ahead of their first use.")
+DEF_SWITCH(EnableParagraphLayoutCache,
+           "enable-paragraph-layout-cache",
+           "Share the layouts of paragraphs with the same text, styles and "
+           "width instead of laying out every paragraph that is built.")
+DEF_SWITCH(EnableRetainedLayerSubtrees,
+           "enable-retained-layer-subtrees",
+           "Paint layer subtrees that are retained from the previous frame by "
+           "replaying a recording of them instead of painting each layer.")
+DEF_SWITCH(EnableAdaptivePipelineDepth,
+           "enable-adaptive-pipeline-depth",
+           "Let a third frame into the frame pipeline while frames take longer "
+           "to rasterize than a vsync interval, at the cost of a frame of "
+           "latency.")
+DEF_SWITCH(EnablePredictiveFrameScheduling,
+           "enable-predictive-frame-scheduling",
+           "Start building frames later in their vsync interval when recent "
+           "frames predict that they will still be on time, to lower input "
+           "latency.")
+DEF_SWITCH(EnablePointerEventBatching,
+           "enable-pointer-event-batching",
+           "Dispatch pointer events at most once per vsync, merging the moves "
+           "of each pointer received within a vsync.")
+DEF_SWITCH(EnablePlatformViewTransactions,
+           "enable-platform-view-transactions",
+           "Keep rasterizing on the raster thread while hybrid composition "
+           "platform views are on screen, and hand their updates to the "
+           "platform thread, instead of merging the two threads. Android "
+           "only.")
+DEF_SWITCH(EnableUnpacedFrameScheduling,
+           "enable-unpaced-frame-scheduling",
+           "Begin frames as soon as they are requested instead of at the "
+           "vsyncs of the platform, to render offscreen as fast as possible.")
+DEF_SWITCH(MaxFramesInFlight,
+           "max-frames-in-flight",
+           "The number of frames that may be built ahead of the frame being "
+           "rasterized.")
+DEF_SWITCH(SnapshotPageProfilePath,
+           "snapshot-page-profile-path",
+           "The path of a file recording the AOT snapshot pages used during "
+           "startup. The pages are prefetched if the file exists, otherwise "
+           "the file is written once the first frame is rasterized.")
+DEF_SWITCH(EnableSnapshotHugePages,
+           "enable-snapshot-huge-pages",
+           "Ask the kernel to map the AOT snapshot instructions with "
+           "transparent huge pages where possible.")
+DEF_SWITCH(WarmIsolatePoolSize,
+           "warm-isolate-pool-size",
+           "The number of background isolates spawned once the root isolate "
+           "is idle and kept alive to run computations passed to "
+           "IsolatePool.run.")
 DEF_SWITCH(LeakVM,
            "leak-vm",
            "When the last shell shuts down, the shared VM is leaked by default "
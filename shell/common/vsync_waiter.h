@@ -35,6 +35,13 @@ class VsyncWaiter : public std::enable_shared_from_this<VsyncWaiter> {
   /// |Animator::ScheduleMaybeClearTraceFlowIds|.
   void ScheduleSecondaryCallback(uintptr_t id, const fml::closure& callback);
 
+  /// Hints the rate at which the application currently needs to produce
+  /// frames, or removes the hint if |frames_per_second| is zero. Backends
+  /// driving displays with a variable refresh rate may use it to lower the
+  /// rate of vsync events. Called on the UI thread. The default
+  /// implementation ignores the hint.
+  virtual void SetPreferredFrameRate(double frames_per_second) {}
+
  protected:
   // On some backends, the |FireCallback| needs to be made from a static C
   // method.
@@ -1,10 +1,13 @@
 #define FML_USED_ON_EMBEDDER
 
 #include <initializer_list>
+#include <vector>
 
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
+#include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/shell/common/switches.h"
+#include "flutter/shell/common/vsync_waiter_unpaced.h"
 
 #include "gtest/gtest.h"
 #include "thread_host.h"
@@ -43,5 +46,34 @@ TEST(VsyncWaiterTest, NoUnneededAwaitVsync) {
   EXPECT_EQ(vsync_waiter.await_vsync_call_count_, 1);
 }
 
+TEST(VsyncWaiterTest, UnpacedVsyncsAreSpacedByTheMinimumInterval) {
+  ThreadHost thread_host("io.flutter.test.vsync_waiter_unpaced.",
+                         ThreadHost::Type::kUi);
+  auto task_runner = thread_host.ui_thread->GetTaskRunner();
+  const TaskRunners task_runners("vsync_waiter_unpaced", task_runner,
+                                 task_runner, task_runner, task_runner);
+  std::shared_ptr<VsyncWaiter> vsync_waiter =
+      std::make_shared<VsyncWaiterUnpaced>(task_runners);
+
+  std::vector<fml::TimePoint> frame_start_times;
+  fml::AutoResetWaitableEvent latch;
+  task_runner->PostTask([&]() {
+    vsync_waiter->AsyncWaitForVsync(
+        [&](std::unique_ptr<FrameTimingsRecorder> recorder) {
+          frame_start_times.push_back(recorder->GetVsyncStartTime());
+          vsync_waiter->AsyncWaitForVsync(
+              [&](std::unique_ptr<FrameTimingsRecorder> recorder) {
+                frame_start_times.push_back(recorder->GetVsyncStartTime());
+                latch.Signal();
+              });
+        });
+  });
+  latch.Wait();
+
+  ASSERT_EQ(frame_start_times.size(), 2u);
+  EXPECT_GE(frame_start_times[1] - frame_start_times[0],
+            VsyncWaiterUnpaced::kMinInterval);
+}
+
 }  // namespace testing
 }  // namespace flutter
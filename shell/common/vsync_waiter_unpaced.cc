@@ -0,0 +1,51 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/vsync_waiter_unpaced.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+// The frame budget reported to the framework. Nothing waits for it, but frame
+// timings and idle notifications are computed relative to it.
+constexpr fml::TimeDelta kFrameBudget = fml::TimeDelta::FromSecondsF(1.0 / 60);
+
+}  // namespace
+
+VsyncWaiterUnpaced::VsyncWaiterUnpaced(const TaskRunners& task_runners)
+    : VsyncWaiter(task_runners) {}
+
+VsyncWaiterUnpaced::~VsyncWaiterUnpaced() = default;
+
+// |VsyncWaiter|
+void VsyncWaiterUnpaced::AwaitVSync() {
+  const fml::TimePoint frame_start_time =
+      std::max(fml::TimePoint::Now(), last_vsync_time_ + kMinInterval);
+  const fml::TimePoint frame_target_time = frame_start_time + kFrameBudget;
+  last_vsync_time_ = frame_start_time;
+
+  TRACE_EVENT2_INT("flutter", "PlatformVsync", "frame_start_time",
+                   frame_start_time.ToEpochDelta().ToMicroseconds(),
+                   "frame_target_time",
+                   frame_target_time.ToEpochDelta().ToMicroseconds());
+
+  std::weak_ptr<VsyncWaiterUnpaced> weak_this =
+      std::static_pointer_cast<VsyncWaiterUnpaced>(shared_from_this());
+
+  task_runners_.GetUITaskRunner()->PostTaskForTime(
+      [frame_start_time, frame_target_time, weak_this]() {
+        if (auto vsync_waiter = weak_this.lock()) {
+          vsync_waiter->FireCallback(frame_start_time, frame_target_time);
+        }
+      },
+      frame_start_time);
+}
+
+}  // namespace flutter
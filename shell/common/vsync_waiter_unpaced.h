@@ -0,0 +1,40 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_VSYNC_WAITER_UNPACED_H_
+#define FLUTTER_SHELL_COMMON_VSYNC_WAITER_UNPACED_H_
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_point.h"
+#include "flutter/shell/common/vsync_waiter.h"
+
+namespace flutter {
+
+/// A |VsyncWaiter| that fires as soon as the UI thread gets to it, for
+/// rendering offscreen as fast as the engine can produce frames.
+///
+/// While the frame pipeline is full, the animator keeps asking for vsyncs
+/// until a frame has been rasterized. To not spin the UI thread meanwhile,
+/// vsyncs are at least |kMinInterval| apart.
+class VsyncWaiterUnpaced final : public VsyncWaiter {
+ public:
+  static constexpr fml::TimeDelta kMinInterval =
+      fml::TimeDelta::FromMilliseconds(1);
+
+  explicit VsyncWaiterUnpaced(const TaskRunners& task_runners);
+
+  ~VsyncWaiterUnpaced() override;
+
+ private:
+  fml::TimePoint last_vsync_time_;
+
+  // |VsyncWaiter|
+  void AwaitVSync() override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(VsyncWaiterUnpaced);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_VSYNC_WAITER_UNPACED_H_
@@ -14,7 +14,8 @@ namespace flutter {
 
 GPUSurfaceGLImpeller::GPUSurfaceGLImpeller(
     GPUSurfaceGLDelegate* delegate,
-    std::shared_ptr<impeller::Context> context)
+    std::shared_ptr<impeller::Context> context,
+    std::shared_ptr<impeller::AiksContext> aiks_context)
     : weak_factory_(this) {
   if (delegate == nullptr) {
     return;
@@ -29,8 +30,10 @@ GPUSurfaceGLImpeller::GPUSurfaceGLImpeller(
     return;
   }
 
-  auto aiks_context = std::make_shared<impeller::AiksContext>(
-      context, impeller::TypographerContextSkia::Make());
+  if (!aiks_context || aiks_context->GetContext() != context) {
+    aiks_context = std::make_shared<impeller::AiksContext>(
+        context, impeller::TypographerContextSkia::Make());
+  }
 
   if (!aiks_context->IsValid()) {
     return;
@@ -40,6 +43,7 @@ GPUSurfaceGLImpeller::GPUSurfaceGLImpeller(
   impeller_context_ = std::move(context);
   impeller_renderer_ = std::move(renderer);
   aiks_context_ = std::move(aiks_context);
+  picture_cache_ = std::make_shared<impeller::DlPictureCache>();
   is_valid_ = true;
 }
 
@@ -59,22 +63,6 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGLImpeller::AcquireFrame(
     return nullptr;
   }
 
-  auto swap_callback = [weak = weak_factory_.GetWeakPtr(),
-                        delegate = delegate_]() -> bool {
-    if (weak) {
-      GLPresentInfo present_info = {
-          .fbo_id = 0u,
-          .frame_damage = std::nullopt,
-          // TODO (https://github.com/flutter/flutter/issues/105597): wire-up
-          // presentation time to impeller backend.
-          .presentation_time = std::nullopt,
-          .buffer_damage = std::nullopt,
-      };
-      delegate->GLContextPresent(present_info);
-    }
-    return true;
-  };
-
   auto context_switch = delegate_->GLContextMakeCurrent();
   if (!context_switch->GetResult()) {
     FML_LOG(ERROR)
@@ -85,18 +73,27 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGLImpeller::AcquireFrame(
   GLFrameInfo frame_info = {static_cast<uint32_t>(size.width()),
                             static_cast<uint32_t>(size.height())};
   const GLFBOInfo fbo_info = delegate_->GLContextFBO(frame_info);
-  auto surface = impeller::SurfaceGLES::WrapFBO(
-      impeller_context_,                            // context
-      swap_callback,                                // swap_callback
-      fbo_info.fbo_id,                              // fbo
-      impeller::PixelFormat::kR8G8B8A8UNormInt,     // color_format
-      impeller::ISize{size.width(), size.height()}  // fbo_size
-  );
+
+  SurfaceFrame::FramebufferInfo framebuffer_info =
+      delegate_->GLContextFramebufferInfo();
+  if (!framebuffer_info.existing_damage.has_value()) {
+    framebuffer_info.existing_damage = fbo_info.existing_damage;
+  }
+  // Partially repainted frames are rendered into a texture that is blitted
+  // into the framebuffer.
+  if (!impeller_context_->GetCapabilities()->SupportsTextureToTextureBlits()) {
+    framebuffer_info.supports_partial_repaint = false;
+  }
 
   SurfaceFrame::SubmitCallback submit_callback =
-      fml::MakeCopyable([renderer = impeller_renderer_,  //
-                         aiks_context = aiks_context_,   //
-                         surface = std::move(surface)    //
+      fml::MakeCopyable([weak = weak_factory_.GetWeakPtr(),  //
+                         delegate = delegate_,                //
+                         context = impeller_context_,         //
+                         renderer = impeller_renderer_,       //
+                         aiks_context = aiks_context_,        //
+                         picture_cache = picture_cache_,      //
+                         fbo_id = fbo_info.fbo_id,            //
+                         size                                 //
   ](SurfaceFrame& surface_frame, DlCanvas* canvas) mutable -> bool {
         if (!aiks_context) {
           return false;
@@ -108,31 +105,80 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGLImpeller::AcquireFrame(
           return false;
         }
 
+        const auto& submit_info = surface_frame.submit_info();
+        auto swap_callback = [weak, delegate, fbo_id,
+                              frame_damage = submit_info.frame_damage,
+                              buffer_damage =
+                                  submit_info.buffer_damage]() -> bool {
+          if (weak) {
+            GLPresentInfo present_info = {
+                .fbo_id = fbo_id,
+                .frame_damage = frame_damage,
+                // TODO (https://github.com/flutter/flutter/issues/105597):
+                // wire-up presentation time to impeller backend.
+                .presentation_time = std::nullopt,
+                .buffer_damage = buffer_damage,
+            };
+            delegate->GLContextPresent(present_info);
+          }
+          return true;
+        };
+
+        std::optional<impeller::IRect> clip_rect;
+        if (submit_info.buffer_damage.has_value()) {
+          const auto& buffer_damage = submit_info.buffer_damage;
+          clip_rect = impeller::IRect::MakeXYWH(
+              buffer_damage->x(), buffer_damage->y(), buffer_damage->width(),
+              buffer_damage->height());
+          delegate->GLContextSetDamageRegion(buffer_damage);
+        }
+
+        auto surface = impeller::SurfaceGLES::WrapFBO(
+            context,                                       // context
+            swap_callback,                                 // swap_callback
+            fbo_id,                                        // fbo
+            impeller::PixelFormat::kR8G8B8A8UNormInt,      // color_format
+            impeller::ISize{size.width(), size.height()},  // fbo_size
+            clip_rect                                      // clip_rect
+        );
+        if (!surface) {
+          return false;
+        }
+
+        if (clip_rect && clip_rect->IsEmpty()) {
+          // Nothing changed, so the framebuffer only has to be presented.
+          return surface->Present();
+        }
+
         auto cull_rect =
             surface->GetTargetRenderPassDescriptor().GetRenderTargetSize();
         impeller::Rect dl_cull_rect = impeller::Rect::MakeSize(cull_rect);
-        impeller::DlDispatcher impeller_dispatcher(dl_cull_rect);
+        impeller::DlDispatcher impeller_dispatcher(dl_cull_rect,
+                                                   picture_cache.get());
         display_list->Dispatch(
             impeller_dispatcher,
             SkIRect::MakeWH(cull_rect.width, cull_rect.height));
         auto picture = impeller_dispatcher.EndRecordingAsPicture();
+        picture_cache->FinishFrame();
 
-        return renderer->Render(
+        bool render_result = renderer->Render(
             std::move(surface),
             fml::MakeCopyable(
                 [aiks_context, picture = std::move(picture)](
                     impeller::RenderTarget& render_target) -> bool {
                   return aiks_context->Render(picture, render_target);
                 }));
+        aiks_context->GetContentContext().WarmUpNextPipelineVariants();
+        return render_result;
       });
 
   return std::make_unique<SurfaceFrame>(
-      nullptr,                                // surface
-      delegate_->GLContextFramebufferInfo(),  // framebuffer info
-      submit_callback,                        // submit callback
-      size,                                   // frame size
-      std::move(context_switch),              // context result
-      true                                    // display list fallback
+      nullptr,                    // surface
+      framebuffer_info,           // framebuffer info
+      submit_callback,            // submit callback
+      size,                       // frame size
+      std::move(context_switch),  // context result
+      true                        // display list fallback
   );
 }
 
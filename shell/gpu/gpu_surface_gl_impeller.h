@@ -10,6 +10,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/impeller/aiks/aiks_context.h"
+#include "flutter/impeller/display_list/dl_picture_cache.h"
 #include "flutter/impeller/renderer/context.h"
 #include "flutter/shell/gpu/gpu_surface_gl_delegate.h"
 
@@ -17,8 +18,22 @@ namespace flutter {
 
 class GPUSurfaceGLImpeller final : public Surface {
  public:
-  explicit GPUSurfaceGLImpeller(GPUSurfaceGLDelegate* delegate,
-                                std::shared_ptr<impeller::Context> context);
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a surface that renders with |context|.
+  ///
+  /// @param[in]  delegate      The delegate for the on-screen render target.
+  /// @param[in]  context       The Impeller context to render with.
+  /// @param[in]  aiks_context  An Aiks context created for |context| by
+  ///                           another surface, whose pipelines, glyph atlases
+  ///                           and render target cache this surface reuses.
+  ///                           The surfaces must render on the same thread. If
+  ///                           `nullptr` or created for a different context, a
+  ///                           new Aiks context is created.
+  ///
+  GPUSurfaceGLImpeller(
+      GPUSurfaceGLDelegate* delegate,
+      std::shared_ptr<impeller::Context> context,
+      std::shared_ptr<impeller::AiksContext> aiks_context = nullptr);
 
   // |Surface|
   ~GPUSurfaceGLImpeller() override;
@@ -31,6 +46,7 @@ class GPUSurfaceGLImpeller final : public Surface {
   std::shared_ptr<impeller::Context> impeller_context_;
   std::shared_ptr<impeller::Renderer> impeller_renderer_;
   std::shared_ptr<impeller::AiksContext> aiks_context_;
+  std::shared_ptr<impeller::DlPictureCache> picture_cache_;
   bool is_valid_ = false;
   fml::WeakPtrFactory<GPUSurfaceGLImpeller> weak_factory_;
 
@@ -38,6 +38,7 @@ GPUSurfaceMetalImpeller::GPUSurfaceMetalImpeller(GPUSurfaceMetalDelegate* delega
       aiks_context_(
           std::make_shared<impeller::AiksContext>(impeller_renderer_ ? context : nullptr,
                                                   impeller::TypographerContextSkia::Make())),
+      picture_cache_(std::make_shared<impeller::DlPictureCache>()),
       render_to_surface_(render_to_surface) {
   // If this preference is explicitly set, we allow for disabling partial repaint.
   NSNumber* disablePartialRepaint =
@@ -105,11 +106,12 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetalImpeller::AcquireFrameFromCAMetalLa
 
   id<MTLTexture> last_texture = static_cast<id<MTLTexture>>(last_texture_);
   SurfaceFrame::SubmitCallback submit_callback =
-      fml::MakeCopyable([this,                           //
-                         renderer = impeller_renderer_,  //
-                         aiks_context = aiks_context_,   //
-                         drawable,                       //
-                         last_texture                    //
+      fml::MakeCopyable([this,                            //
+                         renderer = impeller_renderer_,   //
+                         aiks_context = aiks_context_,    //
+                         picture_cache = picture_cache_,  //
+                         drawable,                        //
+                         last_texture                     //
   ](SurfaceFrame& surface_frame, DlCanvas* canvas) mutable -> bool {
         if (!aiks_context) {
           return false;
@@ -152,16 +154,20 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetalImpeller::AcquireFrameFromCAMetalLa
 
         impeller::IRect cull_rect = surface->coverage();
         SkIRect sk_cull_rect = SkIRect::MakeWH(cull_rect.size.width, cull_rect.size.height);
-        impeller::DlDispatcher impeller_dispatcher(cull_rect);
+        impeller::DlDispatcher impeller_dispatcher(cull_rect, picture_cache.get());
         display_list->Dispatch(impeller_dispatcher, sk_cull_rect);
         auto picture = impeller_dispatcher.EndRecordingAsPicture();
+        picture_cache->FinishFrame();
 
-        return renderer->Render(
+        bool render_result = renderer->Render(
             std::move(surface),
             fml::MakeCopyable([aiks_context, picture = std::move(picture)](
                                   impeller::RenderTarget& render_target) -> bool {
               return aiks_context->Render(picture, render_target);
             }));
+        aiks_context->GetContentContext().ResetTransientsBuffer();
+        aiks_context->GetContentContext().WarmUpNextPipelineVariants();
+        return render_result;
       });
 
   SurfaceFrame::FramebufferInfo framebuffer_info;
@@ -202,12 +208,13 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetalImpeller::AcquireFrameFromMTLTextur
   }
 
   SurfaceFrame::SubmitCallback submit_callback =
-      fml::MakeCopyable([this,                           //
-                         renderer = impeller_renderer_,  //
-                         aiks_context = aiks_context_,   //
-                         texture_info,                   //
-                         mtl_texture,                    //
-                         delegate = delegate_            //
+      fml::MakeCopyable([this,                            //
+                         renderer = impeller_renderer_,   //
+                         aiks_context = aiks_context_,    //
+                         picture_cache = picture_cache_,  //
+                         texture_info,                    //
+                         mtl_texture,                     //
+                         delegate = delegate_             //
   ](SurfaceFrame& surface_frame, DlCanvas* canvas) mutable -> bool {
         if (!aiks_context) {
           return false;
@@ -250,9 +257,10 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetalImpeller::AcquireFrameFromMTLTextur
 
         impeller::IRect cull_rect = surface->coverage();
         SkIRect sk_cull_rect = SkIRect::MakeWH(cull_rect.size.width, cull_rect.size.height);
-        impeller::DlDispatcher impeller_dispatcher(cull_rect);
+        impeller::DlDispatcher impeller_dispatcher(cull_rect, picture_cache.get());
         display_list->Dispatch(impeller_dispatcher, sk_cull_rect);
         auto picture = impeller_dispatcher.EndRecordingAsPicture();
+        picture_cache->FinishFrame();
 
         bool render_result =
             renderer->Render(std::move(surface),
@@ -260,6 +268,8 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetalImpeller::AcquireFrameFromMTLTextur
                                                    impeller::RenderTarget& render_target) -> bool {
                                return aiks_context->Render(picture, render_target);
                              }));
+        aiks_context->GetContentContext().ResetTransientsBuffer();
+        aiks_context->GetContentContext().WarmUpNextPipelineVariants();
         if (!render_result) {
           FML_LOG(ERROR) << "Failed to render Impeller frame";
           return false;
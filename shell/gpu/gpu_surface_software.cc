@@ -4,18 +4,104 @@
 
 #include "flutter/shell/gpu/gpu_surface_software.h"
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <vector>
 
+#include "flutter/display_list/skia/dl_sk_dispatcher.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
 
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPixmap.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter {
 
-GPUSurfaceSoftware::GPUSurfaceSoftware(GPUSurfaceSoftwareDelegate* delegate,
-                                       bool render_to_surface)
+namespace {
+
+// The size of the square tiles that tiled frames are rasterized in.
+constexpr int kTileSize = 256;
+
+// Finds backdrop filters, which read pixels across tile edges.
+class BackdropFilterFinder : public IgnoreAttributeDispatchHelper,
+                             public IgnoreClipDispatchHelper,
+                             public IgnoreTransformDispatchHelper,
+                             public IgnoreDrawDispatchHelper {
+ public:
+  void saveLayer(const SkRect* bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop) override {
+    found_ = found_ || backdrop != nullptr;
+  }
+
+  bool found() const { return found_; }
+
+ private:
+  bool found_ = false;
+};
+
+// The tiles of a frame, which the workers and the raster thread take turns
+// rasterizing. Workers that only get to the job after all tiles have been
+// taken leave without touching the frame.
+struct TileJob {
+  TileJob(sk_sp<DisplayList> p_display_list,
+          sk_sp<SkSurface> p_backing_store,
+          const SkPixmap& p_pixmap,
+          std::vector<SkIRect> p_tiles)
+      : display_list(std::move(p_display_list)),
+        backing_store(std::move(p_backing_store)),
+        pixmap(p_pixmap),
+        tiles(std::move(p_tiles)),
+        rasterized(tiles.size()) {}
+
+  const sk_sp<DisplayList> display_list;
+  // Keeps the pixels alive.
+  const sk_sp<SkSurface> backing_store;
+  const SkPixmap pixmap;
+  const std::vector<SkIRect> tiles;
+  std::atomic<size_t> next_tile = 0;
+  fml::CountDownLatch rasterized;
+
+  void RasterizeRemainingTiles() {
+    for (size_t index = next_tile++; index < tiles.size();
+         index = next_tile++) {
+      RasterizeTile(tiles[index]);
+      rasterized.CountDown();
+    }
+  }
+
+  void RasterizeTile(const SkIRect& tile) {
+    TRACE_EVENT0("flutter", "GPUSurfaceSoftware::RasterizeTile");
+    SkPixmap tile_pixmap;
+    if (!pixmap.extractSubset(&tile_pixmap, tile)) {
+      return;
+    }
+    auto canvas = SkCanvas::MakeRasterDirect(
+        tile_pixmap.info(), tile_pixmap.writable_addr(),
+        tile_pixmap.rowBytes(), &backing_store->props());
+    if (!canvas) {
+      return;
+    }
+    canvas->translate(-tile.x(), -tile.y());
+    DlSkCanvasDispatcher dispatcher(canvas.get());
+    // Only the ops whose bounds intersect the tile are dispatched.
+    display_list->Dispatch(dispatcher, tile);
+  }
+};
+
+}  // namespace
+
+GPUSurfaceSoftware::GPUSurfaceSoftware(
+    GPUSurfaceSoftwareDelegate* delegate,
+    bool render_to_surface,
+    std::shared_ptr<fml::ConcurrentMessageLoop> tile_loop)
     : delegate_(delegate),
       render_to_surface_(render_to_surface),
+      tile_loop_(std::move(tile_loop)),
       weak_factory_(this) {}
 
 GPUSurfaceSoftware::~GPUSurfaceSoftware() = default;
@@ -58,6 +144,10 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
     return nullptr;
   }
 
+  if (tile_loop_) {
+    return AcquireTiledFrame(std::move(backing_store), logical_size);
+  }
+
   // If the surface has been scaled, we need to apply the inverse scaling to the
   // underlying canvas so that coordinates are mapped to the same spot
   // irrespective of surface scaling.
@@ -81,6 +171,112 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
                                         on_submit, logical_size);
 }
 
+std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireTiledFrame(
+    sk_sp<SkSurface> backing_store,
+    const SkISize& logical_size) {
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  framebuffer_info.supports_readback = true;
+  framebuffer_info.supports_partial_repaint = true;
+  if (backing_store == last_presented_backing_store_) {
+    // The backing store still has the last frame, so only the damage of this
+    // frame has to be rasterized.
+    framebuffer_info.existing_damage = SkIRect::MakeEmpty();
+  }
+
+  SurfaceFrame::SubmitCallback on_submit =
+      [self = weak_factory_.GetWeakPtr(), backing_store](
+          SurfaceFrame& surface_frame, DlCanvas* canvas) -> bool {
+    // If the surface itself went away, there is nothing more to do.
+    if (!self || !self->IsValid()) {
+      return false;
+    }
+
+    auto display_list = surface_frame.BuildDisplayList();
+    if (!display_list) {
+      FML_LOG(ERROR) << "Could not build display list for surface frame.";
+      return false;
+    }
+
+    // The contents of the backing store are unknown until it is presented.
+    self->last_presented_backing_store_ = nullptr;
+    if (!self->RasterizeTiles(display_list, backing_store,
+                              surface_frame.submit_info().buffer_damage)) {
+      return false;
+    }
+    if (!self->delegate_->PresentBackingStore(backing_store)) {
+      return false;
+    }
+    self->last_presented_backing_store_ = backing_store;
+    return true;
+  };
+
+  return std::make_unique<SurfaceFrame>(
+      nullptr,           // surface
+      framebuffer_info,  // framebuffer info
+      on_submit,         // submit callback
+      logical_size,      // frame size
+      nullptr,           // context result
+      true               // display list fallback
+  );
+}
+
+bool GPUSurfaceSoftware::RasterizeTiles(
+    const sk_sp<DisplayList>& display_list,
+    const sk_sp<SkSurface>& backing_store,
+    const std::optional<SkIRect>& damage) {
+  TRACE_EVENT0("flutter", "GPUSurfaceSoftware::RasterizeTiles");
+  SkPixmap pixmap;
+  if (!backing_store->peekPixels(&pixmap)) {
+    FML_LOG(ERROR) << "Could not peek the pixels of the backing store.";
+    return false;
+  }
+
+  SkIRect dirty_rect = pixmap.bounds();
+  if (dirty_rect.isEmpty() ||
+      (damage.has_value() && !dirty_rect.intersect(damage.value()))) {
+    // Nothing changed since the frame in the backing store.
+    return true;
+  }
+  // The tiles are drawn into the pixels directly rather than through the
+  // canvas of the backing store.
+  backing_store->notifyContentWillChange(SkSurface::kRetain_ContentChangeMode);
+
+  std::vector<SkIRect> tiles;
+  BackdropFilterFinder backdrop_filter_finder;
+  display_list->Dispatch(backdrop_filter_finder);
+  if (backdrop_filter_finder.found()) {
+    // A backdrop filter would only see the pixels of its own tile.
+    tiles.push_back(dirty_rect);
+  } else {
+    for (int y = dirty_rect.top() / kTileSize * kTileSize;
+         y < dirty_rect.bottom(); y += kTileSize) {
+      for (int x = dirty_rect.left() / kTileSize * kTileSize;
+           x < dirty_rect.right(); x += kTileSize) {
+        SkIRect tile = SkIRect::MakeXYWH(x, y, kTileSize, kTileSize);
+        if (tile.intersect(dirty_rect)) {
+          tiles.push_back(tile);
+        }
+      }
+    }
+  }
+
+  auto job = std::make_shared<TileJob>(display_list, backing_store, pixmap,
+                                       std::move(tiles));
+  // The raster thread rasterizes tiles too, so one worker less is needed.
+  const size_t worker_count =
+      std::min(tile_loop_->GetWorkerCount(), job->tiles.size() - 1);
+  auto task_runner = tile_loop_->GetTaskRunner();
+  for (size_t i = 0; i < worker_count; i++) {
+    task_runner->PostTask([job]() { job->RasterizeRemainingTiles(); },
+                          fml::ConcurrentTaskPriority::kHigh);
+  }
+  job->RasterizeRemainingTiles();
+  // Only waits for the tiles that workers are still rasterizing, not for
+  // workers that are busy with other tasks.
+  job->rasterized.Wait();
+  return true;
+}
+
 // |Surface|
 SkMatrix GPUSurfaceSoftware::GetRootTransformation() const {
   // This backend does not currently support root surface transformations. Just
@@ -5,7 +5,12 @@
 #ifndef FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_H_
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_H_
 
+#include <memory>
+#include <optional>
+
+#include "flutter/display_list/display_list.h"
 #include "flutter/flow/surface.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/shell/gpu/gpu_surface_software_delegate.h"
@@ -14,8 +19,26 @@ namespace flutter {
 
 class GPUSurfaceSoftware : public Surface {
  public:
-  GPUSurfaceSoftware(GPUSurfaceSoftwareDelegate* delegate,
-                     bool render_to_surface);
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a surface that rasterizes frames on the CPU into the
+  ///             backing stores of the delegate.
+  ///
+  /// @param[in]  delegate           The delegate that provides and presents
+  ///                                the backing stores.
+  /// @param[in]  render_to_surface  Whether frames are rendered to this
+  ///                                surface at all.
+  /// @param[in]  tile_loop          If not null, frames are recorded and then
+  ///                                rasterized in tiles by the workers of this
+  ///                                loop and the raster thread. Tiled frames
+  ///                                support partial repaint, which assumes
+  ///                                that the delegate leaves the contents of
+  ///                                a backing store alone when it returns the
+  ///                                same backing store again.
+  ///
+  GPUSurfaceSoftware(
+      GPUSurfaceSoftwareDelegate* delegate,
+      bool render_to_surface,
+      std::shared_ptr<fml::ConcurrentMessageLoop> tile_loop = nullptr);
 
   ~GPUSurfaceSoftware() override;
 
@@ -38,7 +61,20 @@ class GPUSurfaceSoftware : public Surface {
   // hack to make avoid allocating resources for the root surface when an
   // external view embedder is present.
   const bool render_to_surface_;
+  const std::shared_ptr<fml::ConcurrentMessageLoop> tile_loop_;
+  // The backing store that the last tiled frame was presented from. Only the
+  // damage of the next frame has to be rasterized if it is returned again.
+  sk_sp<SkSurface> last_presented_backing_store_;
   fml::TaskRunnerAffineWeakPtrFactory<GPUSurfaceSoftware> weak_factory_;
+
+  std::unique_ptr<SurfaceFrame> AcquireTiledFrame(
+      sk_sp<SkSurface> backing_store,
+      const SkISize& logical_size);
+
+  bool RasterizeTiles(const sk_sp<DisplayList>& display_list,
+                      const sk_sp<SkSurface>& backing_store,
+                      const std::optional<SkIRect>& damage);
+
   FML_DISALLOW_COPY_AND_ASSIGN(GPUSurfaceSoftware);
 };
 
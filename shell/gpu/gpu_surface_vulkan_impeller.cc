@@ -5,8 +5,15 @@
 #include "flutter/shell/gpu/gpu_surface_vulkan_impeller.h"
 
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/trace_event.h"
 #include "impeller/display_list/dl_dispatcher.h"
+#include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
 #include "impeller/renderer/backend/vulkan/surface_context_vk.h"
+#include "impeller/renderer/backend/vulkan/surface_vk.h"
+#include "impeller/renderer/backend/vulkan/texture_vk.h"
+#include "impeller/renderer/blit_pass.h"
+#include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/renderer.h"
 #include "impeller/renderer/surface.h"
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"
@@ -24,8 +31,15 @@ GPUSurfaceVulkanImpeller::GPUSurfaceVulkanImpeller(
     return;
   }
 
+  // Glyphs are rasterized on the same workers that build pipelines and
+  // encode command buffers.
+  auto worker_task_runner = impeller::SurfaceContextVK::Cast(*context)
+                                .GetParent()
+                                ->GetConcurrentWorkerTaskRunner();
   auto aiks_context = std::make_shared<impeller::AiksContext>(
-      context, impeller::TypographerContextSkia::Make());
+      context, impeller::TypographerContextSkia::Make(
+                   std::move(worker_task_runner),
+                   /*defer_rasterization=*/false));
   if (!aiks_context->IsValid()) {
     return;
   }
@@ -33,6 +47,7 @@ GPUSurfaceVulkanImpeller::GPUSurfaceVulkanImpeller(
   impeller_context_ = std::move(context);
   impeller_renderer_ = std::move(renderer);
   aiks_context_ = std::move(aiks_context);
+  picture_cache_ = std::make_shared<impeller::DlPictureCache>();
   is_valid_ = true;
 }
 
@@ -59,11 +74,34 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkanImpeller::AcquireFrame(
 
   auto& context_vk = impeller::SurfaceContextVK::Cast(*impeller_context_);
   std::unique_ptr<impeller::Surface> surface = context_vk.AcquireNextSurface();
+  if (!surface) {
+    FML_LOG(ERROR) << "Could not acquire the next Vulkan surface.";
+    return nullptr;
+  }
+
+  // Swapchain images are recreated when the surface is resized. Damage
+  // accumulated for the old images no longer applies.
+  if (size != damage_size_) {
+    damage_.clear();
+    damage_size_ = size;
+  }
+
+  // The swapchain image retains the contents it had when it was last presented.
+  // Damage is tracked per swapchain image so that only the region that lags
+  // behind the front buffer needs to be repainted.
+  uintptr_t swapchain_image = reinterpret_cast<uintptr_t>(
+      impeller::TextureVK::Cast(
+          *surface->GetTargetRenderPassDescriptor().GetRenderTargetTexture())
+          .GetTextureSource()
+          .get());
 
   SurfaceFrame::SubmitCallback submit_callback =
-      fml::MakeCopyable([renderer = impeller_renderer_,  //
-                         aiks_context = aiks_context_,   //
-                         surface = std::move(surface)    //
+      fml::MakeCopyable([this,                            //
+                         renderer = impeller_renderer_,   //
+                         aiks_context = aiks_context_,    //
+                         picture_cache = picture_cache_,  //
+                         surface = std::move(surface),    //
+                         swapchain_image                  //
   ](SurfaceFrame& surface_frame, DlCanvas* canvas) mutable -> bool {
         if (!aiks_context) {
           return false;
@@ -75,32 +113,138 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkanImpeller::AcquireFrame(
           return false;
         }
 
+        for (auto& entry : damage_) {
+          if (entry.first != swapchain_image) {
+            // Accumulate damage for other swapchain images.
+            if (surface_frame.submit_info().frame_damage) {
+              entry.second.join(*surface_frame.submit_info().frame_damage);
+            }
+          }
+        }
+        // Reset accumulated damage for the current swapchain image.
+        damage_[swapchain_image] = SkIRect::MakeEmpty();
+
+        // The swapchain only hands out swapchain image surfaces.
+        static_cast<impeller::SurfaceVK&>(*surface).SetPresentationTime(
+            surface_frame.submit_info().presentation_time);
+
+        std::optional<impeller::IRect> clip_rect;
+        if (surface_frame.submit_info().buffer_damage.has_value()) {
+          auto buffer_damage = surface_frame.submit_info().buffer_damage;
+          clip_rect = impeller::IRect::MakeXYWH(
+              buffer_damage->x(), buffer_damage->y(), buffer_damage->width(),
+              buffer_damage->height());
+        }
+
+        if (clip_rect &&
+            (clip_rect->size.width <= 0 || clip_rect->size.height <= 0)) {
+          // Nothing changed. The swapchain image already holds the contents
+          // of the frame.
+          return surface->Present();
+        }
+
         auto cull_rect =
             surface->GetTargetRenderPassDescriptor().GetRenderTargetSize();
+        if (clip_rect.has_value()) {
+          cull_rect = clip_rect->size;
+        }
         impeller::Rect dl_cull_rect = impeller::Rect::MakeSize(cull_rect);
-        impeller::DlDispatcher impeller_dispatcher(dl_cull_rect);
+        impeller::DlDispatcher impeller_dispatcher(dl_cull_rect,
+                                                   picture_cache.get());
         display_list->Dispatch(
             impeller_dispatcher,
             SkIRect::MakeWH(cull_rect.width, cull_rect.height));
         auto picture = impeller_dispatcher.EndRecordingAsPicture();
+        picture_cache->FinishFrame();
 
-        return renderer->Render(
+        // The passes of the frame are submitted to the queue together. The
+        // swapchain flushes them before it presents.
+        auto fence_waiter =
+            impeller::SurfaceContextVK::Cast(*aiks_context->GetContext())
+                .GetParent()
+                ->GetFenceWaiter();
+        fence_waiter->BeginBatch();
+        bool render_result = renderer->Render(
             std::move(surface),
             fml::MakeCopyable(
-                [aiks_context, picture = std::move(picture)](
+                [aiks_context, picture = std::move(picture), clip_rect](
                     impeller::RenderTarget& render_target) -> bool {
-                  return aiks_context->Render(picture, render_target);
+                  if (!clip_rect.has_value()) {
+                    return aiks_context->Render(picture, render_target);
+                  }
+                  return RenderPartialRepaint(*aiks_context, picture,
+                                              render_target, *clip_rect);
                 }));
+        // Nothing is left in the batch unless the frame failed to present.
+        fence_waiter->FlushBatch();
+        aiks_context->GetContentContext().ResetTransientsBuffer();
+        aiks_context->GetContentContext().WarmUpNextPipelineVariants();
+        return render_result;
       });
 
+  // Provide accumulated damage to rasterizer (area in current swapchain image
+  // that lags behind front buffer).
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  auto found = damage_.find(swapchain_image);
+  if (found != damage_.end()) {
+    framebuffer_info.existing_damage = found->second;
+  }
+  framebuffer_info.supports_partial_repaint = true;
+
   return std::make_unique<SurfaceFrame>(
-      nullptr,                          // surface
-      SurfaceFrame::FramebufferInfo{},  // framebuffer info
-      submit_callback,                  // submit callback
-      size,                             // frame size
-      nullptr,                          // context result
-      true                              // display list fallback
+      nullptr,           // surface
+      framebuffer_info,  // framebuffer info
+      submit_callback,   // submit callback
+      size,              // frame size
+      nullptr,           // context result
+      true               // display list fallback
+  );
+}
+
+bool GPUSurfaceVulkanImpeller::RenderPartialRepaint(
+    impeller::AiksContext& aiks_context,
+    const impeller::Picture& picture,
+    impeller::RenderTarget& render_target,
+    impeller::IRect clip_rect) {
+  TRACE_EVENT0("flutter", "GPUSurfaceVulkanImpeller::RenderPartialRepaint");
+  auto context = aiks_context.GetContext();
+  auto onscreen = render_target.GetRenderTargetTexture();
+  if (!context || !onscreen) {
+    return false;
+  }
+
+  // compositor_context.cc offsets the rendering by the clip origin. Render
+  // into an intermediate target the size of the clip. This has the same effect
+  // as clipping the rendering but also creates smaller intermediate passes.
+  auto offscreen = impeller::RenderTarget::CreateOffscreenMSAA(
+      *context,                                                  // context
+      *aiks_context.GetContentContext().GetRenderTargetCache(),  // allocator
+      clip_rect.size,                                            // size
+      "Partial Repaint",                                         // label
+      impeller::RenderTarget::kDefaultColorAttachmentConfigMSAA,  // color
+      std::nullopt                                               // stencil
   );
+  if (!offscreen.IsValid() || !aiks_context.Render(picture, offscreen)) {
+    return false;
+  }
+
+  // Copy the damaged region into the swapchain image. Everything outside the
+  // clip is left untouched from the last time this image was presented.
+  auto command_buffer = context->CreateCommandBuffer();
+  if (!command_buffer) {
+    return false;
+  }
+  command_buffer->SetLabel("Partial Repaint Blit");
+  auto blit_pass = command_buffer->CreateBlitPass();
+  if (!blit_pass) {
+    return false;
+  }
+  blit_pass->AddCopy(offscreen.GetRenderTargetTexture(), onscreen,
+                     std::nullopt, clip_rect.origin);
+  if (!blit_pass->EncodeCommands(context->GetResourceAllocator())) {
+    return false;
+  }
+  return command_buffer->SubmitCommands();
 }
 
 // |Surface|
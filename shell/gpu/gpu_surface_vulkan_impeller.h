@@ -4,11 +4,15 @@
 
 #pragma once
 
+#include <map>
+
 #include "flutter/common/graphics/gl_context_switch.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/impeller/aiks/aiks_context.h"
+#include "flutter/impeller/display_list/dl_picture_cache.h"
+#include "flutter/impeller/aiks/picture.h"
 #include "flutter/impeller/renderer/context.h"
 #include "flutter/shell/gpu/gpu_surface_vulkan_delegate.h"
 
@@ -28,7 +32,23 @@ class GPUSurfaceVulkanImpeller final : public Surface {
   std::shared_ptr<impeller::Context> impeller_context_;
   std::shared_ptr<impeller::Renderer> impeller_renderer_;
   std::shared_ptr<impeller::AiksContext> aiks_context_;
+  std::shared_ptr<impeller::DlPictureCache> picture_cache_;
   bool is_valid_ = false;
+  // Accumulated damage for each swapchain image (keyed by the texture
+  // source that wraps the image).
+  std::map<uintptr_t, SkIRect> damage_;
+  // The frame size the accumulated damage applies to.
+  SkISize damage_size_ = SkISize::MakeEmpty();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Render the picture into an intermediate target the size of
+  ///             the clip and copy the result into the render target at the
+  ///             clip origin. The rest of the render target is not touched.
+  ///
+  static bool RenderPartialRepaint(impeller::AiksContext& aiks_context,
+                                   const impeller::Picture& picture,
+                                   impeller::RenderTarget& render_target,
+                                   impeller::IRect clip_rect);
 
   // |Surface|
   std::unique_ptr<SurfaceFrame> AcquireFrame(const SkISize& size) override;
@@ -17,11 +17,111 @@ typedef void (*AChoreographer_postFrameCallback_FPN)(
     AChoreographer* choreographer,
     AChoreographer_frameCallback callback,
     void* data);
+// Only available on API 30+
+typedef void (*AChoreographer_refreshRateCallback)(int64_t vsyncPeriodNanos,
+                                                   void* data);
+typedef void (*AChoreographer_registerRefreshRateCallback_FPN)(
+    AChoreographer* choreographer,
+    AChoreographer_refreshRateCallback callback,
+    void* data);
+// Only available on API 33+
+typedef void AChoreographerFrameCallbackData;
+typedef void (*AChoreographer_vsyncCallback)(
+    const AChoreographerFrameCallbackData* callbackData,
+    void* data);
+typedef int (*AChoreographer_postVsyncCallback_FPN)(
+    AChoreographer* choreographer,
+    AChoreographer_vsyncCallback callback,
+    void* data);
+typedef int64_t (*AChoreographerFrameCallbackData_getFrameTimeNanos_FPN)(
+    const AChoreographerFrameCallbackData* data);
+typedef size_t (*AChoreographerFrameCallbackData_getPreferredIndex_FPN)(
+    const AChoreographerFrameCallbackData* data);
+typedef int64_t (*AChoreographerFrameCallbackData_getTimelineNanos_FPN)(
+    const AChoreographerFrameCallbackData* data,
+    size_t index);
 static AChoreographer_getInstance_FPN AChoreographer_getInstance;
 static AChoreographer_postFrameCallback_FPN AChoreographer_postFrameCallback;
+static AChoreographer_registerRefreshRateCallback_FPN
+    AChoreographer_registerRefreshRateCallback;
+static AChoreographer_postVsyncCallback_FPN AChoreographer_postVsyncCallback;
+static AChoreographerFrameCallbackData_getFrameTimeNanos_FPN
+    AChoreographerFrameCallbackData_getFrameTimeNanos;
+static AChoreographerFrameCallbackData_getPreferredIndex_FPN
+    AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex;
+static AChoreographerFrameCallbackData_getTimelineNanos_FPN
+    AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos;
+static AChoreographerFrameCallbackData_getTimelineNanos_FPN
+    AChoreographerFrameCallbackData_getExpectedPresentationTimeNanos;
+static bool g_supports_vsync_callback = false;
 
 namespace flutter {
 
+namespace {
+
+// The callback of a pending |AndroidChoreographer::PostVsyncCallback|.
+struct PendingVsyncCallback {
+  AndroidChoreographer::OnVsyncCallback callback;
+  void* data;
+};
+
+void OnVsync(const AChoreographerFrameCallbackData* callback_data,
+             void* data) {
+  auto* pending = reinterpret_cast<PendingVsyncCallback*>(data);
+  const size_t index =
+      AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex(
+          callback_data);
+  AndroidChoreographer::FrameTimeline timeline;
+  timeline.frame_time_nanos =
+      AChoreographerFrameCallbackData_getFrameTimeNanos(callback_data);
+  timeline.deadline_nanos =
+      AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos(
+          callback_data, index);
+  timeline.expected_presentation_time_nanos =
+      AChoreographerFrameCallbackData_getExpectedPresentationTimeNanos(
+          callback_data, index);
+  pending->callback(timeline, pending->data);
+  delete pending;
+}
+
+// Resolves the functions used by |AndroidChoreographer::PostVsyncCallback|.
+// Returns whether all of them are available.
+bool ResolveVsyncCallbackFunctions(
+    const fml::RefPtr<fml::NativeLibrary>& libandroid) {
+  auto post_vsync_callback_fn =
+      libandroid->ResolveFunction<AChoreographer_postVsyncCallback_FPN>(
+          "AChoreographer_postVsyncCallback");
+  auto get_frame_time_fn = libandroid->ResolveFunction<
+      AChoreographerFrameCallbackData_getFrameTimeNanos_FPN>(
+      "AChoreographerFrameCallbackData_getFrameTimeNanos");
+  auto get_preferred_index_fn = libandroid->ResolveFunction<
+      AChoreographerFrameCallbackData_getPreferredIndex_FPN>(
+      "AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex");
+  auto get_deadline_fn = libandroid->ResolveFunction<
+      AChoreographerFrameCallbackData_getTimelineNanos_FPN>(
+      "AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos");
+  auto get_expected_presentation_time_fn = libandroid->ResolveFunction<
+      AChoreographerFrameCallbackData_getTimelineNanos_FPN>(
+      "AChoreographerFrameCallbackData_"
+      "getFrameTimelineExpectedPresentationTimeNanos");
+  if (!post_vsync_callback_fn || !get_frame_time_fn ||
+      !get_preferred_index_fn || !get_deadline_fn ||
+      !get_expected_presentation_time_fn) {
+    return false;
+  }
+  AChoreographer_postVsyncCallback = post_vsync_callback_fn.value();
+  AChoreographerFrameCallbackData_getFrameTimeNanos = get_frame_time_fn.value();
+  AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex =
+      get_preferred_index_fn.value();
+  AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos =
+      get_deadline_fn.value();
+  AChoreographerFrameCallbackData_getExpectedPresentationTimeNanos =
+      get_expected_presentation_time_fn.value();
+  return true;
+}
+
+}  // namespace
+
 bool AndroidChoreographer::ShouldUseNDKChoreographer() {
   static std::optional<bool> use_ndk_choreographer;
   if (use_ndk_choreographer) {
@@ -45,6 +145,14 @@ bool AndroidChoreographer::ShouldUseNDKChoreographer() {
   if (get_instance_fn && post_frame_callback_fn) {
     AChoreographer_getInstance = get_instance_fn.value();
     AChoreographer_postFrameCallback = post_frame_callback_fn.value();
+    auto register_refresh_rate_callback_fn = libandroid->ResolveFunction<
+        AChoreographer_registerRefreshRateCallback_FPN>(
+        "AChoreographer_registerRefreshRateCallback");
+    if (register_refresh_rate_callback_fn) {
+      AChoreographer_registerRefreshRateCallback =
+          register_refresh_rate_callback_fn.value();
+    }
+    g_supports_vsync_callback = ResolveVsyncCallbackFunctions(libandroid);
     use_ndk_choreographer = true;
   } else {
     use_ndk_choreographer = false;
@@ -58,4 +166,27 @@ void AndroidChoreographer::PostFrameCallback(OnFrameCallback callback,
   AChoreographer_postFrameCallback(choreographer, callback, data);
 }
 
+bool AndroidChoreographer::SupportsVsyncCallback() {
+  return g_supports_vsync_callback;
+}
+
+void AndroidChoreographer::PostVsyncCallback(OnVsyncCallback callback,
+                                             void* data) {
+  FML_DCHECK(g_supports_vsync_callback);
+  AChoreographer* choreographer = AChoreographer_getInstance();
+  AChoreographer_postVsyncCallback(choreographer, &OnVsync,
+                                   new PendingVsyncCallback{callback, data});
+}
+
+bool AndroidChoreographer::RegisterRefreshRateCallback(
+    OnRefreshRateCallback callback,
+    void* data) {
+  if (!AChoreographer_registerRefreshRateCallback) {
+    return false;
+  }
+  AChoreographer* choreographer = AChoreographer_getInstance();
+  AChoreographer_registerRefreshRateCallback(choreographer, callback, data);
+  return true;
+}
+
 }  // namespace flutter
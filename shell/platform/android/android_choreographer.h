@@ -18,10 +18,39 @@ namespace flutter {
 ///
 class AndroidChoreographer {
  public:
+  /// The timing of a frame as reported by the choreographer, in nanoseconds
+  /// on the monotonic clock.
+  struct FrameTimeline {
+    int64_t frame_time_nanos = 0;
+    /// The time by which the frame must be submitted to be presented on time.
+    int64_t deadline_nanos = 0;
+    int64_t expected_presentation_time_nanos = 0;
+  };
+
   typedef void (*OnFrameCallback)(int64_t frame_time_nanos, void* data);
+  typedef void (*OnVsyncCallback)(const FrameTimeline& timeline, void* data);
+  typedef void (*OnRefreshRateCallback)(int64_t vsync_period_nanos,
+                                        void* data);
+
   static bool ShouldUseNDKChoreographer();
   static void PostFrameCallback(OnFrameCallback callback, void* data);
 
+  /// Whether |PostVsyncCallback| may be used, which requires API 33. Must only
+  /// be called once |ShouldUseNDKChoreographer| returned true.
+  static bool SupportsVsyncCallback();
+
+  /// Like |PostFrameCallback|, but the callback also receives the deadline and
+  /// expected presentation time of the frame timeline preferred by the
+  /// platform.
+  static void PostVsyncCallback(OnVsyncCallback callback, void* data);
+
+  /// Registers a callback invoked on the calling thread whenever the refresh
+  /// rate of the display changes. The calling thread must have a looper.
+  ///
+  /// @return Whether the callback could be registered, which requires API 30.
+  static bool RegisterRefreshRateCallback(OnRefreshRateCallback callback,
+                                          void* data);
+
   FML_DISALLOW_COPY_AND_ASSIGN(AndroidChoreographer);
 };
 
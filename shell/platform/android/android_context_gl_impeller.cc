@@ -4,12 +4,17 @@
 
 #include "flutter/shell/platform/android/android_context_gl_impeller.h"
 
+#include <atomic>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
 #include "flutter/impeller/renderer/backend/gles/context_gles.h"
 #include "flutter/impeller/renderer/backend/gles/proc_table_gles.h"
 #include "flutter/impeller/renderer/backend/gles/reactor_gles.h"
 #include "flutter/impeller/toolkit/egl/context.h"
 #include "flutter/impeller/toolkit/egl/surface.h"
 #include "impeller/entity/gles/entity_shaders_gles.h"
+#include "impeller/entity/gles/framebuffer_blend_shaders_gles.h"
 
 #if IMPELLER_ENABLE_3D
 #include "impeller/scene/shaders/gles/scene_shaders_gles.h"  // nogcncheck
@@ -47,7 +52,74 @@ class AndroidContextGLImpeller::ReactorWorker final
   FML_DISALLOW_COPY_AND_ASSIGN(ReactorWorker);
 };
 
-static std::shared_ptr<impeller::Context> CreateImpellerContext(
+//------------------------------------------------------------------------------
+/// @brief      Performs texture uploads on a thread of its own, with a context
+///             that shares objects with the onscreen and offscreen contexts.
+///
+class AndroidContextGLImpeller::UploadWorker final
+    : public impeller::ReactorGLES::UploadWorker {
+ public:
+  UploadWorker(std::unique_ptr<impeller::egl::Context> context,
+               std::unique_ptr<impeller::egl::Surface> surface)
+      : thread_("io.flutter.impeller.upload"),
+        context_(std::move(context)),
+        surface_(std::move(surface)) {
+    thread_.GetTaskRunner()->PostTask(
+        [this]() { is_current_ = context_->MakeCurrent(*surface_); });
+  }
+
+  // |impeller::ReactorGLES::UploadWorker|
+  ~UploadWorker() override {
+    // Tasks refer to the worker without owning it, so the thread must have
+    // run all of them before the worker is gone.
+    fml::AutoResetWaitableEvent latch;
+    thread_.GetTaskRunner()->PostTask([this, &latch]() {
+      if (is_current_) {
+        context_->ClearCurrent();
+        is_current_ = false;
+      }
+      latch.Signal();
+    });
+    latch.Wait();
+    thread_.Join();
+  }
+
+  void SetReactor(std::weak_ptr<impeller::ReactorGLES> reactor) {
+    reactor_ = std::move(reactor);
+  }
+
+  // |impeller::ReactorGLES::Worker|
+  bool CanReactorReactOnCurrentThreadNow(
+      const impeller::ReactorGLES& reactor) const override {
+    return thread_.GetTaskRunner()->RunsTasksOnCurrentThread() && is_current_;
+  }
+
+  // |impeller::ReactorGLES::UploadWorker|
+  void OnUploadOperationsPending() override {
+    if (upload_scheduled_.exchange(true)) {
+      return;
+    }
+    thread_.GetTaskRunner()->PostTask([this]() {
+      upload_scheduled_ = false;
+      if (auto reactor = reactor_.lock()) {
+        [[maybe_unused]] auto result = reactor->ReactToUploads();
+      }
+    });
+  }
+
+ private:
+  fml::Thread thread_;
+  std::unique_ptr<impeller::egl::Context> context_;
+  std::unique_ptr<impeller::egl::Surface> surface_;
+  std::weak_ptr<impeller::ReactorGLES> reactor_;
+  std::atomic_bool upload_scheduled_ = false;
+  // Only accessed on the upload thread.
+  bool is_current_ = false;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(UploadWorker);
+};
+
+static std::shared_ptr<impeller::ContextGLES> CreateImpellerContext(
     const std::shared_ptr<impeller::ReactorGLES::Worker>& worker) {
   auto proc_table = std::make_unique<impeller::ProcTableGLES>(
       impeller::egl::CreateProcAddressResolver());
@@ -60,6 +132,9 @@ static std::shared_ptr<impeller::Context> CreateImpellerContext(
   std::vector<std::shared_ptr<fml::Mapping>> shader_mappings = {
     std::make_shared<fml::NonOwnedMapping>(impeller_entity_shaders_gles_data,
                                            impeller_entity_shaders_gles_length),
+    std::make_shared<fml::NonOwnedMapping>(
+        impeller_framebuffer_blend_shaders_gles_data,
+        impeller_framebuffer_blend_shaders_gles_length),
 #if IMPELLER_ENABLE_3D
     std::make_shared<fml::NonOwnedMapping>(impeller_scene_shaders_gles_data,
                                            impeller_scene_shaders_gles_length),
@@ -134,6 +209,13 @@ AndroidContextGLImpeller::AndroidContextGLImpeller(
     return;
   }
 
+  // The upload context is optional. Without it, uploads are performed by the
+  // reactor workers of the other contexts as before.
+  auto upload_context =
+      display_->CreateContext(*offscreen_config, onscreen_context.get());
+  auto upload_surface =
+      display_->CreatePixelBufferSurface(*offscreen_config, 1u, 1u);
+
   // Creating the impeller::Context requires a current context, which requires
   // some surface.
   auto offscreen_surface =
@@ -172,6 +254,16 @@ AndroidContextGLImpeller::AndroidContextGLImpeller(
     FML_DLOG(ERROR) << "Could not add lifecycle listeners";
   }
 
+  if (upload_context && upload_surface) {
+    upload_worker_ = std::make_shared<UploadWorker>(std::move(upload_context),
+                                                    std::move(upload_surface));
+    upload_worker_->SetReactor(impeller_context->GetReactor());
+    impeller_context->GetReactor()->SetUploadWorker(upload_worker_);
+  } else {
+    FML_DLOG(ERROR) << "Could not create upload context. Textures will be "
+                       "uploaded on the raster and IO threads.";
+  }
+
   onscreen_config_ = std::move(onscreen_config);
   offscreen_config_ = std::move(offscreen_config);
   onscreen_context_ = std::move(onscreen_context);
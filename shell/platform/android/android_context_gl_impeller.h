@@ -31,6 +31,7 @@ class AndroidContextGLImpeller : public AndroidContext {
 
  private:
   class ReactorWorker;
+  class UploadWorker;
 
   std::shared_ptr<ReactorWorker> reactor_worker_;
   std::unique_ptr<impeller::egl::Display> display_;
@@ -38,6 +39,7 @@ class AndroidContextGLImpeller : public AndroidContext {
   std::unique_ptr<impeller::egl::Config> offscreen_config_;
   std::unique_ptr<impeller::egl::Context> onscreen_context_;
   std::unique_ptr<impeller::egl::Context> offscreen_context_;
+  std::shared_ptr<UploadWorker> upload_worker_;
   bool is_valid_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(AndroidContextGLImpeller);
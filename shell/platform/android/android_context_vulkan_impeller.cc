@@ -17,7 +17,8 @@ namespace flutter {
 
 static std::shared_ptr<impeller::Context> CreateImpellerContext(
     const fml::RefPtr<vulkan::VulkanProcTable>& proc_table,
-    bool enable_vulkan_validation) {
+    bool enable_vulkan_validation,
+    bool enable_low_latency_present) {
   std::vector<std::shared_ptr<fml::Mapping>> shader_mappings = {
     std::make_shared<fml::NonOwnedMapping>(impeller_entity_shaders_vk_data,
                                            impeller_entity_shaders_vk_length),
@@ -37,6 +38,7 @@ static std::shared_ptr<impeller::Context> CreateImpellerContext(
   settings.shader_libraries_data = std::move(shader_mappings);
   settings.cache_directory = fml::paths::GetCachesDirectory();
   settings.enable_validation = enable_vulkan_validation;
+  settings.prefer_low_latency_present_mode = enable_low_latency_present;
 
   auto context = impeller::ContextVK::Create(std::move(settings));
 
@@ -52,10 +54,12 @@ static std::shared_ptr<impeller::Context> CreateImpellerContext(
 }
 
 AndroidContextVulkanImpeller::AndroidContextVulkanImpeller(
-    bool enable_validation)
+    bool enable_validation,
+    bool enable_low_latency_present)
     : AndroidContext(AndroidRenderingAPI::kVulkan),
       proc_table_(fml::MakeRefCounted<vulkan::VulkanProcTable>()) {
-  auto impeller_context = CreateImpellerContext(proc_table_, enable_validation);
+  auto impeller_context = CreateImpellerContext(proc_table_, enable_validation,
+                                                enable_low_latency_present);
   SetImpellerContext(impeller_context);
   is_valid_ =
       proc_table_->HasAcquiredMandatoryProcAddresses() && impeller_context;
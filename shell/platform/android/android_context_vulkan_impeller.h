@@ -14,7 +14,8 @@ namespace flutter {
 
 class AndroidContextVulkanImpeller : public AndroidContext {
  public:
-  AndroidContextVulkanImpeller(bool enable_validation);
+  AndroidContextVulkanImpeller(bool enable_validation,
+                               bool enable_low_latency_present = false);
 
   ~AndroidContextVulkanImpeller();
 
@@ -4,21 +4,19 @@
 
 #include "flutter/shell/platform/android/android_display.h"
 
+#include "flutter/shell/platform/android/vsync_waiter_android.h"
+
 namespace flutter {
 
 AndroidDisplay::AndroidDisplay(
     std::shared_ptr<PlatformViewAndroidJNI> jni_facade)
-    : Display(0,
-              jni_facade->GetDisplayRefreshRate(),
-              jni_facade->GetDisplayWidth(),
-              jni_facade->GetDisplayHeight(),
-              jni_facade->GetDisplayDensity()),
+    : VariableRefreshRateDisplay(0,
+                                 VsyncWaiterAndroid::GetRefreshRateReporter(),
+                                 jni_facade->GetDisplayWidth(),
+                                 jni_facade->GetDisplayHeight(),
+                                 jni_facade->GetDisplayDensity()),
       jni_facade_(std::move(jni_facade)) {}
 
-double AndroidDisplay::GetRefreshRate() const {
-  return jni_facade_->GetDisplayRefreshRate();
-}
-
 double AndroidDisplay::GetWidth() const {
   return jni_facade_->GetDisplayWidth();
 }
@@ -8,20 +8,19 @@
 #include <cstdint>
 
 #include "flutter/fml/macros.h"
-#include "flutter/shell/common/display.h"
+#include "flutter/shell/common/variable_refresh_rate_display.h"
 #include "flutter/shell/platform/android/jni/platform_view_android_jni.h"
 
 namespace flutter {
 
 /// A |Display| that listens to refresh rate changes.
-class AndroidDisplay : public Display {
+/// A display whose refresh rate is kept up to date by the vsync waiter, see
+/// |VsyncWaiterAndroid::GetRefreshRateReporter|.
+class AndroidDisplay : public VariableRefreshRateDisplay {
  public:
   AndroidDisplay(std::shared_ptr<PlatformViewAndroidJNI> jni_facade);
   ~AndroidDisplay() = default;
 
-  // |Display|
-  double GetRefreshRate() const override;
-
   // |Display|
   virtual double GetWidth() const override;
 
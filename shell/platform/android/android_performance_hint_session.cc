@@ -0,0 +1,111 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/android_performance_hint_session.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+int32_t GetThreadId(const fml::RefPtr<fml::TaskRunner>& task_runner) {
+  int32_t thread_id = 0;
+  fml::AutoResetWaitableEvent latch;
+  fml::TaskRunner::RunNowOrPostTask(task_runner, [&thread_id, &latch]() {
+    thread_id = gettid();
+    latch.Signal();
+  });
+  latch.Wait();
+  return thread_id;
+}
+
+}  // namespace
+
+std::unique_ptr<AndroidPerformanceHintSession>
+AndroidPerformanceHintSession::Create(const TaskRunners& task_runners,
+                                      fml::TimeDelta target_work_duration) {
+  if (!NDKHelpers::PerformanceHintSupported()) {
+    return nullptr;
+  }
+  APerformanceHintManager* manager = NDKHelpers::APerformanceHint_getManager();
+  if (manager == nullptr) {
+    return nullptr;
+  }
+  std::vector<int32_t> thread_ids = {
+      GetThreadId(task_runners.GetUITaskRunner()),
+      GetThreadId(task_runners.GetRasterTaskRunner()),
+      GetThreadId(task_runners.GetIOTaskRunner()),
+  };
+  // The task runners can share threads.
+  std::sort(thread_ids.begin(), thread_ids.end());
+  thread_ids.erase(std::unique(thread_ids.begin(), thread_ids.end()),
+                   thread_ids.end());
+
+  const int64_t target_work_duration_nanos =
+      target_work_duration.ToNanoseconds();
+  APerformanceHintSession* session = NDKHelpers::APerformanceHint_createSession(
+      manager, thread_ids.data(), thread_ids.size(),
+      target_work_duration_nanos);
+  if (session == nullptr) {
+    FML_LOG(ERROR) << "Could not create a performance hint session.";
+    return nullptr;
+  }
+  return std::unique_ptr<AndroidPerformanceHintSession>(
+      new AndroidPerformanceHintSession(session, target_work_duration_nanos));
+}
+
+AndroidPerformanceHintSession::AndroidPerformanceHintSession(
+    APerformanceHintSession* session,
+    int64_t target_work_duration_nanos)
+    : session_(session),
+      target_work_duration_nanos_(target_work_duration_nanos) {}
+
+AndroidPerformanceHintSession::~AndroidPerformanceHintSession() {
+  NDKHelpers::APerformanceHint_closeSession(session_);
+}
+
+void AndroidPerformanceHintSession::ReportFrameTiming(
+    const FrameTiming& timing,
+    fml::TimeDelta target_work_duration) {
+  TRACE_EVENT0("flutter", "AndroidPerformanceHintSession::ReportFrameTiming");
+  const int64_t target_work_duration_nanos =
+      target_work_duration.ToNanoseconds();
+  if (target_work_duration_nanos > 0 &&
+      target_work_duration_nanos != target_work_duration_nanos_) {
+    // The refresh rate of the display changed.
+    if (NDKHelpers::APerformanceHint_updateTargetWorkDuration(
+            session_, target_work_duration_nanos) == 0) {
+      target_work_duration_nanos_ = target_work_duration_nanos;
+    }
+  }
+  const int64_t actual_work_duration_nanos =
+      GetActualWorkDuration(timing).ToNanoseconds();
+  if (actual_work_duration_nanos <= 0) {
+    return;
+  }
+  NDKHelpers::APerformanceHint_reportActualWorkDuration(
+      session_, actual_work_duration_nanos);
+}
+
+fml::TimeDelta AndroidPerformanceHintSession::GetActualWorkDuration(
+    const FrameTiming& timing) {
+  const fml::TimeDelta build_duration =
+      timing.Get(FrameTiming::kBuildFinish) -
+      timing.Get(FrameTiming::kBuildStart);
+  const fml::TimeDelta raster_duration =
+      timing.Get(FrameTiming::kRasterFinish) -
+      timing.Get(FrameTiming::kRasterStart);
+  return std::max(build_duration, raster_duration);
+}
+
+}  // namespace flutter
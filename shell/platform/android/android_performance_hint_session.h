@@ -0,0 +1,78 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_PERFORMANCE_HINT_SESSION_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_PERFORMANCE_HINT_SESSION_H_
+
+#include <memory>
+
+#include "flutter/common/settings.h"
+#include "flutter/common/task_runners.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/shell/platform/android/ndk_helpers.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A performance hint session of the Android Dynamic Performance
+///             Framework for the UI, raster and IO threads of an engine.
+///
+///             The durations of the work done for each frame are reported to
+///             the session along with the frame budget, so that the CPU
+///             governor raises the clocks of these threads as soon as frames
+///             are at risk of missing their deadline, instead of ramping up
+///             slowly after frames have been dropped.
+///
+///             Performance hint sessions are available from API level 33.
+///
+class AndroidPerformanceHintSession {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a session for the UI, raster and IO threads of the
+  ///             task runners. Must be called on the platform thread, and
+  ///             waits for the other threads to report their thread ids.
+  ///
+  /// @return     The session, or nullptr if performance hint sessions are not
+  ///             supported by the device.
+  ///
+  static std::unique_ptr<AndroidPerformanceHintSession> Create(
+      const TaskRunners& task_runners,
+      fml::TimeDelta target_work_duration);
+
+  ~AndroidPerformanceHintSession();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reports the work done for a rasterized frame. Must be called
+  ///             on the raster thread.
+  ///
+  /// @param[in]  timing                The timing of the frame.
+  /// @param[in]  target_work_duration  The frame budget of the display.
+  ///
+  void ReportFrameTiming(const FrameTiming& timing,
+                         fml::TimeDelta target_work_duration);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The duration of the work done for a frame, as compared with
+  ///             the frame budget.
+  ///
+  ///             The UI and raster threads work on consecutive frames in
+  ///             parallel, so the frame rate is bounded by the slower of the
+  ///             two phases rather than by their sum.
+  ///
+  static fml::TimeDelta GetActualWorkDuration(const FrameTiming& timing);
+
+ private:
+  APerformanceHintSession* session_;
+  int64_t target_work_duration_nanos_;
+
+  AndroidPerformanceHintSession(APerformanceHintSession* session,
+                                int64_t target_work_duration_nanos);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AndroidPerformanceHintSession);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_PERFORMANCE_HINT_SESSION_H_
@@ -0,0 +1,51 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/android_performance_hint_session.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+FrameTiming MakeFrameTiming(int64_t build_micros, int64_t raster_micros) {
+  const fml::TimePoint vsync =
+      fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromSeconds(1));
+  const fml::TimePoint build_finish =
+      vsync + fml::TimeDelta::FromMicroseconds(build_micros);
+  const fml::TimePoint raster_start =
+      build_finish + fml::TimeDelta::FromMicroseconds(100);
+  FrameTiming timing;
+  timing.Set(FrameTiming::kVsyncStart, vsync);
+  timing.Set(FrameTiming::kBuildStart, vsync);
+  timing.Set(FrameTiming::kBuildFinish, build_finish);
+  timing.Set(FrameTiming::kRasterStart, raster_start);
+  timing.Set(FrameTiming::kRasterFinish,
+             raster_start + fml::TimeDelta::FromMicroseconds(raster_micros));
+  return timing;
+}
+
+}  // namespace
+
+TEST(AndroidPerformanceHintSession, ActualWorkIsTheSlowerPhase) {
+  EXPECT_EQ(AndroidPerformanceHintSession::GetActualWorkDuration(
+                MakeFrameTiming(4000, 9000))
+                .ToMicroseconds(),
+            9000);
+  EXPECT_EQ(AndroidPerformanceHintSession::GetActualWorkDuration(
+                MakeFrameTiming(12000, 3000))
+                .ToMicroseconds(),
+            12000);
+}
+
+TEST(AndroidPerformanceHintSession, ActualWorkOfAnEmptyFrameIsZero) {
+  EXPECT_EQ(AndroidPerformanceHintSession::GetActualWorkDuration(FrameTiming())
+                .ToNanoseconds(),
+            0);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -27,8 +27,10 @@
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/shell/platform/android/android_display.h"
 #include "flutter/shell/platform/android/android_image_generator.h"
+#include "flutter/shell/platform/android/android_performance_hint_session.h"
 #include "flutter/shell/platform/android/context/android_context.h"
 #include "flutter/shell/platform/android/platform_view_android.h"
+#include "flutter/shell/platform/android/vsync_waiter_android.h"
 
 namespace flutter {
 
@@ -71,6 +73,16 @@ static void AndroidPlatformThreadConfigSetter(
       }
   }
 }
+
+static fml::TimeDelta GetFrameBudget() {
+  double refresh_rate =
+      VsyncWaiterAndroid::GetRefreshRateReporter()->GetRefreshRate();
+  fml::Milliseconds frame_budget =
+      refresh_rate > 0 ? fml::RefreshRateToFrameBudget(refresh_rate)
+                       : fml::kDefaultFrameBudget;
+  return fml::TimeDelta::FromMillisecondsF(frame_budget.count());
+}
+
 static PlatformData GetDefaultPlatformData() {
   PlatformData platform_data;
   platform_data.lifecycle_state = "AppLifecycleState.detached";
@@ -143,10 +155,28 @@ AndroidShellHolder::AndroidShellHolder(
                                     io_runner         // io
   );
 
+  // Report the work of every frame to a performance hint session, so that
+  // the CPU governor speeds up the engine threads before frames are dropped.
+  flutter::Settings shell_settings = settings_;
+  std::shared_ptr<AndroidPerformanceHintSession> performance_hint_session =
+      AndroidPerformanceHintSession::Create(task_runners, GetFrameBudget());
+  if (performance_hint_session) {
+    shell_settings.frame_rasterized_callback =
+        [performance_hint_session,
+         callback = settings_.frame_rasterized_callback](
+            const FrameTiming& timing) {
+          performance_hint_session->ReportFrameTiming(timing,
+                                                      GetFrameBudget());
+          if (callback) {
+            callback(timing);
+          }
+        };
+  }
+
   shell_ =
       Shell::Create(GetDefaultPlatformData(),  // window data
                     task_runners,              // task runners
-                    settings_,                 // settings
+                    shell_settings,            // settings
                     on_create_platform_view,   // platform view create callback
                     on_create_rasterizer       // rasterizer create callback
       );
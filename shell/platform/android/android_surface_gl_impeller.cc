@@ -10,6 +10,26 @@
 
 namespace flutter {
 
+namespace {
+
+std::optional<SkIRect> ToSkIRect(const std::optional<impeller::IRect>& rect) {
+  if (!rect.has_value()) {
+    return std::nullopt;
+  }
+  return SkIRect::MakeXYWH(rect->origin.x, rect->origin.y, rect->size.width,
+                           rect->size.height);
+}
+
+std::optional<impeller::IRect> ToIRect(const std::optional<SkIRect>& rect) {
+  if (!rect.has_value()) {
+    return std::nullopt;
+  }
+  return impeller::IRect::MakeXYWH(rect->x(), rect->y(), rect->width(),
+                                   rect->height());
+}
+
+}  // namespace
+
 AndroidSurfaceGLImpeller::AndroidSurfaceGLImpeller(
     const std::shared_ptr<AndroidContextGLImpeller>& android_context)
     : android_context_(android_context) {
@@ -35,13 +55,17 @@ bool AndroidSurfaceGLImpeller::IsValid() const {
 // |AndroidSurface|
 std::unique_ptr<Surface> AndroidSurfaceGLImpeller::CreateGPUSurface(
     GrDirectContext* gr_context) {
-  auto surface = std::make_unique<GPUSurfaceGLImpeller>(
-      this,                                   // delegate
-      android_context_->GetImpellerContext()  // context
+  std::unique_ptr<Surface> surface = std::make_unique<GPUSurfaceGLImpeller>(
+      this,                                    // delegate
+      android_context_->GetImpellerContext(),  // context
+      android_context_->GetMainAiksContext()   // aiks context
   );
   if (!surface->IsValid()) {
     return nullptr;
   }
+  if (!android_context_->GetMainAiksContext()) {
+    android_context_->SetMainAiksContext(surface->GetAiksContext());
+  }
   return surface;
 }
 
@@ -117,14 +141,25 @@ SurfaceFrame::FramebufferInfo
 AndroidSurfaceGLImpeller::GLContextFramebufferInfo() const {
   auto info = SurfaceFrame::FramebufferInfo{};
   info.supports_readback = true;
-  info.supports_partial_repaint = false;
+  if (onscreen_surface_ && onscreen_surface_->SupportsPartialRepaint()) {
+    info.supports_partial_repaint = true;
+    info.existing_damage = ToSkIRect(onscreen_surface_->GetExistingDamage());
+    // Tile based GPUs repaint whole tiles, and some drivers need damage
+    // regions aligned to 4 pixels. See
+    // https://github.com/flutter/flutter/issues/97482.
+    info.horizontal_clip_alignment = 32;
+    info.vertical_clip_alignment = 32;
+  }
   return info;
 }
 
 // |GPUSurfaceGLDelegate|
 void AndroidSurfaceGLImpeller::GLContextSetDamageRegion(
     const std::optional<SkIRect>& region) {
-  // Not supported.
+  if (!onscreen_surface_) {
+    return;
+  }
+  onscreen_surface_->SetDamageRegion(ToIRect(region));
 }
 
 // |GPUSurfaceGLDelegate|
@@ -135,14 +170,20 @@ bool AndroidSurfaceGLImpeller::GLContextPresent(
   if (!onscreen_surface_) {
     return false;
   }
-  return onscreen_surface_->Present();
+  return onscreen_surface_->Present(ToIRect(present_info.frame_damage));
 }
 
 // |GPUSurfaceGLDelegate|
 GLFBOInfo AndroidSurfaceGLImpeller::GLContextFBO(GLFrameInfo frame_info) const {
   // FBO0 is the default window bound framebuffer in EGL environments.
+  const bool partial_repaint_enabled =
+      onscreen_surface_ && onscreen_surface_->SupportsPartialRepaint();
   return GLFBOInfo{
       .fbo_id = 0,
+      .partial_repaint_enabled = partial_repaint_enabled,
+      .existing_damage = partial_repaint_enabled
+                             ? ToSkIRect(onscreen_surface_->GetExistingDamage())
+                             : std::nullopt,
   };
 }
 
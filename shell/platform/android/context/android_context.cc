@@ -4,6 +4,8 @@
 
 #include "flutter/shell/platform/android/context/android_context.h"
 
+#include "flutter/impeller/aiks/aiks_context.h"
+
 namespace flutter {
 
 AndroidContext::AndroidContext(AndroidRenderingAPI rendering_api)
@@ -36,6 +38,16 @@ std::shared_ptr<impeller::Context> AndroidContext::GetImpellerContext() const {
   return impeller_context_;
 }
 
+void AndroidContext::SetMainAiksContext(
+    const std::shared_ptr<impeller::AiksContext>& aiks_context) {
+  main_aiks_context_ = aiks_context;
+}
+
+std::shared_ptr<impeller::AiksContext> AndroidContext::GetMainAiksContext()
+    const {
+  return main_aiks_context_;
+}
+
 void AndroidContext::SetImpellerContext(
     const std::shared_ptr<impeller::Context>& context) {
   impeller_context_ = context;
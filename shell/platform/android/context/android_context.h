@@ -10,6 +10,10 @@
 #include "flutter/impeller/renderer/context.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 
+namespace impeller {
+class AiksContext;
+}  // namespace impeller
+
 namespace flutter {
 
 enum class AndroidRenderingAPI {
@@ -65,6 +69,28 @@ class AndroidContext {
   ///
   std::shared_ptr<impeller::Context> GetImpellerContext() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Setter for the Aiks context to be used by subsequent
+  ///             AndroidSurfaces rendering with the Impeller context.
+  /// @details    This lets the surfaces of engines spawned from the same shell
+  ///             share pipelines, glyph atlases and render targets, which
+  ///             makes each additional engine much cheaper to start. They all
+  ///             render on the same raster thread.
+  ///
+  ///             The first AndroidSurface should set this for the
+  ///             AndroidContext if the AndroidContext does not yet have an
+  ///             Aiks context to share via GetMainAiksContext.
+  ///
+  void SetMainAiksContext(
+      const std::shared_ptr<impeller::AiksContext>& aiks_context);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Accessor for the Aiks context shared by AndroidSurfaces.
+  /// @returns    `nullptr` when no Aiks context has been set yet by its
+  ///             AndroidSurface via SetMainAiksContext.
+  ///
+  std::shared_ptr<impeller::AiksContext> GetMainAiksContext() const;
+
  protected:
   /// Intended to be called from a subclass constructor after setup work for the
   /// context has completed.
@@ -78,6 +104,8 @@ class AndroidContext {
 
   std::shared_ptr<impeller::Context> impeller_context_;
 
+  std::shared_ptr<impeller::AiksContext> main_aiks_context_;
+
   FML_DISALLOW_COPY_AND_ASSIGN(AndroidContext);
 };
 
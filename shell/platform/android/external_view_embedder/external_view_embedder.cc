@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "flutter/shell/platform/android/external_view_embedder/external_view_embedder.h"
+#include "flutter/fml/logging.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/fml/trace_event.h"
 
@@ -12,13 +13,22 @@ AndroidExternalViewEmbedder::AndroidExternalViewEmbedder(
     const AndroidContext& android_context,
     std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
     std::shared_ptr<AndroidSurfaceFactory> surface_factory,
-    const TaskRunners& task_runners)
+    const TaskRunners& task_runners,
+    bool use_platform_view_transactions)
     : ExternalViewEmbedder(),
       android_context_(android_context),
       jni_facade_(std::move(jni_facade)),
       surface_factory_(std::move(surface_factory)),
-      surface_pool_(std::make_unique<SurfacePool>()),
-      task_runners_(task_runners) {}
+      surface_pool_(use_platform_view_transactions
+                        ? std::make_unique<SurfacePool>(
+                              task_runners.GetPlatformTaskRunner())
+                        : std::make_unique<SurfacePool>()),
+      task_runners_(task_runners),
+      transaction_queue_(use_platform_view_transactions
+                             ? std::make_unique<PlatformViewTransactionQueue>(
+                                   task_runners.GetPlatformTaskRunner(),
+                                   jni_facade_)
+                             : nullptr) {}
 
 // |ExternalViewEmbedder|
 void AndroidExternalViewEmbedder::PrerollCompositeEmbeddedView(
@@ -69,6 +79,9 @@ void AndroidExternalViewEmbedder::SubmitFrame(
   TRACE_EVENT0("flutter", "AndroidExternalViewEmbedder::SubmitFrame");
 
   if (!FrameHasPlatformLayers()) {
+    if (previous_frame_view_count_ > 0) {
+      WaitForPreviousTransaction();
+    }
     frame->Submit();
     return;
   }
@@ -147,6 +160,7 @@ void AndroidExternalViewEmbedder::SubmitFrame(
   // `PostPrerollAction` that this frame must be resubmitted.
   auto should_submit_current_frame = previous_frame_view_count_ > 0;
   if (should_submit_current_frame) {
+    WaitForPreviousTransaction();
     frame->Submit();
   }
 
@@ -155,7 +169,7 @@ void AndroidExternalViewEmbedder::SubmitFrame(
     const EmbeddedViewParams& params = view_params_.at(view_id);
     // Display the platform view. If it's already displayed, then it's
     // just positioned and sized.
-    jni_facade_->FlutterViewOnDisplayPlatformView(
+    DisplayPlatformView(
         view_id,             //
         view_rect.x(),       //
         view_rect.y(),       //
@@ -195,11 +209,11 @@ AndroidExternalViewEmbedder::CreateSurfaceIfNeeded(GrDirectContext* context,
       layer->surface->AcquireFrame(frame_size_);
   // Display the overlay surface. If it's already displayed, then it's
   // just positioned and sized.
-  jni_facade_->FlutterViewDisplayOverlaySurface(layer->id,     //
-                                                rect.x(),      //
-                                                rect.y(),      //
-                                                rect.width(),  //
-                                                rect.height()  //
+  DisplayOverlaySurface(layer->id,     //
+                        rect.x(),      //
+                        rect.y(),      //
+                        rect.width(),  //
+                        rect.height()  //
   );
   DlCanvas* overlay_canvas = frame->Canvas();
   overlay_canvas->Clear(DlColor::kTransparent());
@@ -216,6 +230,14 @@ PostPrerollResult AndroidExternalViewEmbedder::PostPrerollAction(
   if (!FrameHasPlatformLayers()) {
     return PostPrerollResult::kSuccess;
   }
+  if (transaction_queue_) {
+    // The frame is resubmitted once the surface switch has been applied on
+    // the platform thread, which `SubmitFrame` waits for.
+    if (previous_frame_view_count_ == 0) {
+      return PostPrerollResult::kResubmitFrame;
+    }
+    return PostPrerollResult::kSuccess;
+  }
   if (!raster_thread_merger->IsMerged()) {
     // The raster thread merger may be disabled if the rasterizer is being
     // created or teared down.
@@ -242,6 +264,50 @@ bool AndroidExternalViewEmbedder::FrameHasPlatformLayers() {
   return !composition_order_.empty();
 }
 
+void AndroidExternalViewEmbedder::WaitForPreviousTransaction() {
+  if (!transaction_queue_) {
+    return;
+  }
+  // The images of the surfaces are acquired when a transaction is applied, so
+  // the transaction of the previous frame must be applied before the surfaces
+  // of this frame are submitted.
+  if (!transaction_queue_->WaitForFence(kTransactionFenceTimeout)) {
+    FML_DLOG(WARNING) << "The platform thread didn't apply the platform views "
+                         "of the previous frame in time.";
+  }
+}
+
+void AndroidExternalViewEmbedder::DisplayPlatformView(
+    int view_id,
+    int x,
+    int y,
+    int width,
+    int height,
+    int view_width,
+    int view_height,
+    const MutatorsStack& mutators_stack) {
+  if (transaction_) {
+    transaction_->DisplayPlatformView(view_id, x, y, width, height, view_width,
+                                      view_height, mutators_stack);
+    return;
+  }
+  jni_facade_->FlutterViewOnDisplayPlatformView(
+      view_id, x, y, width, height, view_width, view_height, mutators_stack);
+}
+
+void AndroidExternalViewEmbedder::DisplayOverlaySurface(int surface_id,
+                                                        int x,
+                                                        int y,
+                                                        int width,
+                                                        int height) {
+  if (transaction_) {
+    transaction_->DisplayOverlaySurface(surface_id, x, y, width, height);
+    return;
+  }
+  jni_facade_->FlutterViewDisplayOverlaySurface(surface_id, x, y, width,
+                                                height);
+}
+
 // |ExternalViewEmbedder|
 DlCanvas* AndroidExternalViewEmbedder::GetRootCanvas() {
   // On Android, the root surface is created from the on-screen render target.
@@ -269,8 +335,11 @@ void AndroidExternalViewEmbedder::BeginFrame(
     DestroySurfaces();
   }
   surface_pool_->SetFrameSize(frame_size);
-  // JNI method must be called on the platform thread.
-  if (raster_thread_merger->IsOnPlatformThread()) {
+  if (transaction_queue_) {
+    // The transaction begins and ends the frame on the platform thread.
+    transaction_ = std::make_unique<PlatformViewTransaction>();
+  } else if (raster_thread_merger->IsOnPlatformThread()) {
+    // JNI method must be called on the platform thread.
     jni_facade_->FlutterViewBeginFrame();
   }
 
@@ -288,19 +357,30 @@ void AndroidExternalViewEmbedder::EndFrame(
     bool should_resubmit_frame,
     fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger) {
   surface_pool_->RecycleLayers();
-  // JNI method must be called on the platform thread.
-  if (raster_thread_merger->IsOnPlatformThread()) {
+  if (transaction_queue_) {
+    // Frames without platform views only need to be applied to hide the
+    // platform views of the previous frame.
+    if (transaction_ &&
+        (FrameHasPlatformLayers() || previous_frame_view_count_ > 0)) {
+      transaction_queue_->Commit(std::move(transaction_));
+    }
+    transaction_.reset();
+  } else if (raster_thread_merger->IsOnPlatformThread()) {
+    // JNI method must be called on the platform thread.
     jni_facade_->FlutterViewEndFrame();
   }
 }
 
 // |ExternalViewEmbedder|
 bool AndroidExternalViewEmbedder::SupportsDynamicThreadMerging() {
-  return true;
+  return transaction_queue_ == nullptr;
 }
 
 // |ExternalViewEmbedder|
 void AndroidExternalViewEmbedder::Teardown() {
+  if (transaction_queue_) {
+    transaction_queue_->Reset();
+  }
   DestroySurfaces();
 }
 
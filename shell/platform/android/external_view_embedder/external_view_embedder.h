@@ -10,6 +10,7 @@
 #include "flutter/common/task_runners.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/shell/platform/android/context/android_context.h"
+#include "flutter/shell/platform/android/external_view_embedder/platform_view_transaction.h"
 #include "flutter/shell/platform/android/external_view_embedder/surface_pool.h"
 #include "flutter/shell/platform/android/jni/platform_view_android_jni.h"
 #include "flutter/shell/platform/android/surface/android_surface.h"
@@ -26,13 +27,20 @@ namespace flutter {
 /// that render above (by Z order) the Android view corresponding to
 /// |flutter::PlatformViewLayer|.
 ///
+/// By default, the raster thread is merged into the platform thread while
+/// platform views are on screen, so that the Java methods are called in step
+/// with rasterization. With platform view transactions, the raster thread
+/// keeps running on its own instead, and the Java calls of each frame are
+/// handed to the platform thread as a |PlatformViewTransaction|.
+///
 class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
  public:
   AndroidExternalViewEmbedder(
       const AndroidContext& android_context,
       std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
       std::shared_ptr<AndroidSurfaceFactory> surface_factory,
-      const TaskRunners& task_runners);
+      const TaskRunners& task_runners,
+      bool use_platform_view_transactions = false);
 
   // |ExternalViewEmbedder|
   void PrerollCompositeEmbeddedView(
@@ -85,6 +93,12 @@ class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
   // where the platform view might be momentarily off the screen.
   static const int kDefaultMergedLeaseDuration = 10;
 
+  // The longest time the raster thread waits for the platform thread to apply
+  // the transaction of the previous frame. The platform thread may be blocked
+  // on the raster thread, for example while the surface is destroyed.
+  static constexpr fml::TimeDelta kTransactionFenceTimeout =
+      fml::TimeDelta::FromMilliseconds(100);
+
   // Provides metadata to the Android surfaces.
   const AndroidContext& android_context_;
 
@@ -123,6 +137,13 @@ class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
   // The number of platform views in the previous frame.
   int64_t previous_frame_view_count_;
 
+  // Hands the transactions to the platform thread, or null if the raster
+  // thread is merged into the platform thread instead.
+  const std::unique_ptr<PlatformViewTransactionQueue> transaction_queue_;
+
+  // The transaction of the current frame, if transactions are used.
+  std::unique_ptr<PlatformViewTransaction> transaction_;
+
   // Destroys the surfaces created from the surface factory.
   // This method schedules a task on the platform thread, and waits for
   // the task until it completes.
@@ -134,6 +155,28 @@ class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
   // Whether the layer tree in the current frame has platform layers.
   bool FrameHasPlatformLayers();
 
+  // Waits until the transaction of the previous frame has been applied, if
+  // transactions are used.
+  void WaitForPreviousTransaction();
+
+  // Displays a platform view, or records it in the transaction of the frame.
+  void DisplayPlatformView(int view_id,
+                           int x,
+                           int y,
+                           int width,
+                           int height,
+                           int view_width,
+                           int view_height,
+                           const MutatorsStack& mutators_stack);
+
+  // Displays an overlay surface, or records it in the transaction of the
+  // frame.
+  void DisplayOverlaySurface(int surface_id,
+                             int x,
+                             int y,
+                             int width,
+                             int height);
+
   // Creates a Surface when needed or recycles an existing one.
   // Finally, draws the picture on the frame's canvas.
   std::unique_ptr<SurfaceFrame> CreateSurfaceIfNeeded(GrDirectContext* context,
@@ -11,6 +11,7 @@
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/raster_thread_merger.h"
+#include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/fml/thread.h"
 #include "flutter/shell/platform/android/jni/jni_mock.h"
 #include "flutter/shell/platform/android/surface/android_surface.h"
@@ -934,6 +935,67 @@ TEST(AndroidExternalViewEmbedder, SupportsDynamicThreadMerging) {
   ASSERT_TRUE(embedder->SupportsDynamicThreadMerging());
 }
 
+TEST(AndroidExternalViewEmbedder,
+     DoesNotSupportDynamicThreadMergingWithPlatformViewTransactions) {
+  auto jni_mock = std::make_shared<JNIMock>();
+  auto android_context = AndroidContext(AndroidRenderingAPI::kSoftware);
+  auto embedder = std::make_unique<AndroidExternalViewEmbedder>(
+      android_context, jni_mock, nullptr, GetTaskRunnersForFixture(),
+      /*use_platform_view_transactions=*/true);
+  ASSERT_FALSE(embedder->SupportsDynamicThreadMerging());
+}
+
+TEST(AndroidExternalViewEmbedder,
+     PlatformViewTransactionIsAppliedOnThePlatformThread) {
+  auto jni_mock = std::make_shared<JNIMock>();
+  auto android_context = AndroidContext(AndroidRenderingAPI::kSoftware);
+
+  fml::Thread platform_thread("platform");
+  auto raster_thread_merger = GetThreadMergerFromRasterThread(&platform_thread);
+  auto task_runners = TaskRunners(/*label=*/"test",
+                                  /*platform=*/platform_thread.GetTaskRunner(),
+                                  /*raster=*/fml::MessageLoop::GetCurrent()
+                                      .GetTaskRunner(),
+                                  /*ui=*/nullptr,
+                                  /*io=*/nullptr);
+  auto embedder = std::make_unique<AndroidExternalViewEmbedder>(
+      android_context, jni_mock, nullptr, task_runners,
+      /*use_platform_view_transactions=*/true);
+
+  // Nothing is called on the raster thread while the frame is built.
+  EXPECT_CALL(*jni_mock, FlutterViewBeginFrame()).Times(0);
+  embedder->BeginFrame(SkISize::Make(10, 20), nullptr, 1.0,
+                       raster_thread_merger);
+
+  SkMatrix matrix;
+  MutatorsStack stack;
+  embedder->PrerollCompositeEmbeddedView(
+      0, std::make_unique<EmbeddedViewParams>(matrix, SkSize::Make(5, 5),
+                                              stack));
+
+  // The frame is resubmitted once the first platform view shows up, but the
+  // threads are never merged.
+  ASSERT_EQ(PostPrerollResult::kResubmitFrame,
+            embedder->PostPrerollAction(raster_thread_merger));
+  ASSERT_FALSE(raster_thread_merger->IsMerged());
+  ::testing::Mock::VerifyAndClearExpectations(jni_mock.get());
+
+  fml::AutoResetWaitableEvent latch;
+  platform_thread.GetTaskRunner()->PostTask([&latch]() { latch.Wait(); });
+
+  ::testing::InSequence sequence;
+  EXPECT_CALL(*jni_mock, FlutterViewBeginFrame());
+  EXPECT_CALL(*jni_mock, FlutterViewEndFrame());
+  embedder->EndFrame(/*should_resubmit_frame=*/true, raster_thread_merger);
+
+  // The transaction waits for the platform thread.
+  latch.Signal();
+  fml::AutoResetWaitableEvent applied;
+  platform_thread.GetTaskRunner()->PostTask([&applied]() { applied.Signal(); });
+  applied.Wait();
+  ASSERT_FALSE(raster_thread_merger->IsMerged());
+}
+
 TEST(AndroidExternalViewEmbedder, DisableThreadMerger) {
   auto jni_mock = std::make_shared<JNIMock>();
   auto android_context = AndroidContext(AndroidRenderingAPI::kSoftware);
@@ -0,0 +1,149 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/external_view_embedder/platform_view_transaction.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+PlatformViewTransaction::PlatformViewTransaction() = default;
+
+PlatformViewTransaction::~PlatformViewTransaction() = default;
+
+void PlatformViewTransaction::DisplayPlatformView(
+    int view_id,
+    int x,
+    int y,
+    int width,
+    int height,
+    int view_width,
+    int view_height,
+    const MutatorsStack& mutators_stack) {
+  updates_.push_back({
+      .type = Update::Type::kPlatformView,
+      .id = view_id,
+      .rect = SkIRect::MakeXYWH(x, y, width, height),
+      .view_size = SkISize::Make(view_width, view_height),
+      .mutators_stack = mutators_stack,
+  });
+}
+
+void PlatformViewTransaction::DisplayOverlaySurface(int surface_id,
+                                                    int x,
+                                                    int y,
+                                                    int width,
+                                                    int height) {
+  updates_.push_back({
+      .type = Update::Type::kOverlaySurface,
+      .id = surface_id,
+      .rect = SkIRect::MakeXYWH(x, y, width, height),
+  });
+}
+
+void PlatformViewTransaction::Apply(PlatformViewAndroidJNI& jni_facade) const {
+  TRACE_EVENT0("flutter", "PlatformViewTransaction::Apply");
+  jni_facade.FlutterViewBeginFrame();
+  for (const Update& update : updates_) {
+    switch (update.type) {
+      case Update::Type::kPlatformView:
+        jni_facade.FlutterViewOnDisplayPlatformView(
+            update.id,                  //
+            update.rect.x(),            //
+            update.rect.y(),            //
+            update.rect.width(),        //
+            update.rect.height(),       //
+            update.view_size.width(),   //
+            update.view_size.height(),  //
+            update.mutators_stack       //
+        );
+        break;
+      case Update::Type::kOverlaySurface:
+        jni_facade.FlutterViewDisplayOverlaySurface(update.id,            //
+                                                    update.rect.x(),      //
+                                                    update.rect.y(),      //
+                                                    update.rect.width(),  //
+                                                    update.rect.height()  //
+        );
+        break;
+    }
+  }
+  jni_facade.FlutterViewEndFrame();
+}
+
+struct PlatformViewTransactionQueue::State {
+  // The number of transactions committed on the raster thread.
+  uint64_t committed = 0;
+  // The number of the last transaction that was applied or dropped.
+  std::atomic<uint64_t> applied = 0;
+  // Transactions committed before the last reset are dropped.
+  std::atomic<uint64_t> generation = 0;
+
+  // Only used when the raster thread waits on the fence.
+  std::mutex mutex;
+  std::condition_variable applied_changed;
+
+  void SetApplied(uint64_t transaction_number) {
+    {
+      std::scoped_lock lock(mutex);
+      if (applied.load() < transaction_number) {
+        applied.store(transaction_number, std::memory_order_release);
+      }
+    }
+    applied_changed.notify_all();
+  }
+};
+
+PlatformViewTransactionQueue::PlatformViewTransactionQueue(
+    fml::RefPtr<fml::TaskRunner> platform_task_runner,
+    std::shared_ptr<PlatformViewAndroidJNI> jni_facade)
+    : platform_task_runner_(std::move(platform_task_runner)),
+      jni_facade_(std::move(jni_facade)),
+      state_(std::make_shared<State>()) {}
+
+PlatformViewTransactionQueue::~PlatformViewTransactionQueue() {
+  Reset();
+}
+
+void PlatformViewTransactionQueue::Commit(
+    std::unique_ptr<PlatformViewTransaction> transaction) {
+  TRACE_EVENT0("flutter", "PlatformViewTransactionQueue::Commit");
+  const uint64_t transaction_number = ++state_->committed;
+  fml::TaskRunner::RunNowOrPostTask(
+      platform_task_runner_,
+      [state = state_, jni_facade = jni_facade_,
+       transaction = std::shared_ptr<PlatformViewTransaction>(
+           std::move(transaction)),
+       generation = state_->generation.load(), transaction_number]() {
+        if (state->generation.load() != generation) {
+          return;
+        }
+        transaction->Apply(*jni_facade);
+        state->SetApplied(transaction_number);
+      });
+}
+
+bool PlatformViewTransactionQueue::WaitForFence(fml::TimeDelta timeout) {
+  const uint64_t committed = state_->committed;
+  if (state_->applied.load(std::memory_order_acquire) >= committed) {
+    return true;
+  }
+  TRACE_EVENT0("flutter", "PlatformViewTransactionQueue::WaitForFence");
+  std::unique_lock lock(state_->mutex);
+  return state_->applied_changed.wait_for(
+      lock, std::chrono::nanoseconds(timeout.ToNanoseconds()),
+      [&]() { return state_->applied.load() >= committed; });
+}
+
+void PlatformViewTransactionQueue::Reset() {
+  ++state_->generation;
+  state_->SetApplied(state_->committed);
+}
+
+}  // namespace flutter
@@ -0,0 +1,136 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_EXTERNAL_VIEW_EMBEDDER_PLATFORM_VIEW_TRANSACTION_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_EXTERNAL_VIEW_EMBEDDER_PLATFORM_VIEW_TRANSACTION_H_
+
+#include <memory>
+#include <vector>
+
+#include "flutter/flow/embedded_views.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/shell/platform/android/jni/platform_view_android_jni.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// The updates to the platform views and overlay surfaces of a frame, recorded
+/// on the raster thread and applied to the Java side on the platform thread.
+///
+/// A transaction describes all platform views and overlay surfaces of its
+/// frame. Views and surfaces that aren't displayed by a transaction are hidden
+/// when it is applied.
+///
+class PlatformViewTransaction {
+ public:
+  PlatformViewTransaction();
+
+  ~PlatformViewTransaction();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records a call to
+  ///             |PlatformViewAndroidJNI::FlutterViewOnDisplayPlatformView|.
+  ///
+  void DisplayPlatformView(int view_id,
+                           int x,
+                           int y,
+                           int width,
+                           int height,
+                           int view_width,
+                           int view_height,
+                           const MutatorsStack& mutators_stack);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records a call to
+  ///             |PlatformViewAndroidJNI::FlutterViewDisplayOverlaySurface|.
+  ///
+  void DisplayOverlaySurface(int surface_id,
+                             int x,
+                             int y,
+                             int width,
+                             int height);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Applies the updates in the order they were recorded, as one
+  ///             frame of the Java side. Must be called on the platform
+  ///             thread.
+  ///
+  void Apply(PlatformViewAndroidJNI& jni_facade) const;
+
+ private:
+  struct Update {
+    enum class Type { kPlatformView, kOverlaySurface };
+    Type type;
+    int id;
+    SkIRect rect;
+    SkISize view_size;
+    MutatorsStack mutators_stack;
+  };
+
+  std::vector<Update> updates_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PlatformViewTransaction);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Hands transactions from the raster thread to the platform
+///             thread, so that the raster thread keeps running on its own
+///             while platform views are on screen.
+///
+///             The overlay surfaces and the Flutter surface acquire their
+///             latest image when a transaction is applied. Before submitting
+///             the surfaces of a frame, the raster thread waits on the fence
+///             of the previous transaction, so that the images of a frame are
+///             never shown with the platform view positions of an older one.
+///             The fence doesn't wait when the previous transaction has
+///             already been applied, which is the common case as the platform
+///             thread only has to make a few calls to Java per frame.
+///
+class PlatformViewTransactionQueue {
+ public:
+  PlatformViewTransactionQueue(
+      fml::RefPtr<fml::TaskRunner> platform_task_runner,
+      std::shared_ptr<PlatformViewAndroidJNI> jni_facade);
+
+  ~PlatformViewTransactionQueue();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Schedules the transaction to be applied on the platform
+  ///             thread.
+  ///
+  void Commit(std::unique_ptr<PlatformViewTransaction> transaction);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Waits until all committed transactions have been applied.
+  ///
+  /// @param[in]  timeout  The longest time to wait. The platform thread may
+  ///                      itself be waiting on the raster thread, so the wait
+  ///                      gives up after the timeout.
+  ///
+  /// @return     Whether all transactions have been applied.
+  ///
+  bool WaitForFence(fml::TimeDelta timeout);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drops transactions that haven't been applied yet, and makes
+  ///             the fence pass.
+  ///
+  void Reset();
+
+ private:
+  struct State;
+
+  const fml::RefPtr<fml::TaskRunner> platform_task_runner_;
+  const std::shared_ptr<PlatformViewAndroidJNI> jni_facade_;
+  // Shared with the tasks on the platform thread, which can outlive the queue.
+  const std::shared_ptr<State> state_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PlatformViewTransactionQueue);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_EXTERNAL_VIEW_EMBEDDER_PLATFORM_VIEW_TRANSACTION_H_
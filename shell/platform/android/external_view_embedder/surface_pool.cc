@@ -6,6 +6,8 @@
 
 #include <utility>
 
+#include "flutter/fml/synchronization/waitable_event.h"
+
 namespace flutter {
 
 OverlayLayer::OverlayLayer(int id,
@@ -19,6 +21,9 @@ OverlayLayer::~OverlayLayer() = default;
 
 SurfacePool::SurfacePool() = default;
 
+SurfacePool::SurfacePool(fml::RefPtr<fml::TaskRunner> platform_task_runner)
+    : platform_task_runner_(std::move(platform_task_runner)) {}
+
 SurfacePool::~SurfacePool() = default;
 
 std::shared_ptr<OverlayLayer> SurfacePool::GetLayer(
@@ -41,8 +46,10 @@ std::shared_ptr<OverlayLayer> SurfacePool::GetLayer(
         << "Could not create an OpenGL, Vulkan or Software surface to set up "
            "rendering.";
 
-    std::unique_ptr<PlatformViewAndroidJNI::OverlayMetadata> java_metadata =
-        jni_facade->FlutterViewCreateOverlaySurface();
+    std::unique_ptr<PlatformViewAndroidJNI::OverlayMetadata> java_metadata;
+    RunOnPlatformThread([&java_metadata, &jni_facade]() {
+      java_metadata = jni_facade->FlutterViewCreateOverlaySurface();
+    });
 
     FML_CHECK(java_metadata->window);
     android_surface->SetNativeWindow(java_metadata->window);
@@ -96,7 +103,8 @@ void SurfacePool::DestroyLayersLocked(
   if (layers_.empty()) {
     return;
   }
-  jni_facade->FlutterViewDestroyOverlaySurfaces();
+  RunOnPlatformThread(
+      [&jni_facade]() { jni_facade->FlutterViewDestroyOverlaySurfaces(); });
   layers_.clear();
   available_layer_index_ = 0;
 }
@@ -110,6 +118,20 @@ std::vector<std::shared_ptr<OverlayLayer>> SurfacePool::GetUnusedLayers() {
   return results;
 }
 
+void SurfacePool::RunOnPlatformThread(const fml::closure& closure) {
+  if (!platform_task_runner_) {
+    closure();
+    return;
+  }
+  fml::AutoResetWaitableEvent latch;
+  fml::TaskRunner::RunNowOrPostTask(platform_task_runner_,
+                                    [&closure, &latch]() {
+                                      closure();
+                                      latch.Signal();
+                                    });
+  latch.Wait();
+}
+
 void SurfacePool::SetFrameSize(SkISize frame_size) {
   std::lock_guard lock(mutex_);
   requested_frame_size_ = frame_size;
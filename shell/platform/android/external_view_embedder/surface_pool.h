@@ -8,6 +8,7 @@
 #include <mutex>
 
 #include "flutter/flow/surface.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/shell/platform/android/context/android_context.h"
 #include "flutter/shell/platform/android/surface/android_surface.h"
 
@@ -47,6 +48,11 @@ class SurfacePool {
  public:
   SurfacePool();
 
+  // Creates a pool that is used off the platform thread. The Java methods
+  // that create and destroy overlay surfaces are called on the platform task
+  // runner, and the pool waits for them.
+  explicit SurfacePool(fml::RefPtr<fml::TaskRunner> platform_task_runner);
+
   ~SurfacePool();
 
   // Gets a layer from the pool if available, or allocates a new one.
@@ -103,6 +109,13 @@ class SurfacePool {
   // Used to guard public methods.
   std::mutex mutex_;
 
+  // The task runner to call Java methods on, or null if the pool is used on
+  // the platform thread.
+  const fml::RefPtr<fml::TaskRunner> platform_task_runner_;
+
+  // Runs the closure on the platform thread, and waits for it.
+  void RunOnPlatformThread(const fml::closure& closure);
+
   void DestroyLayersLocked(
       const std::shared_ptr<PlatformViewAndroidJNI>& jni_facade);
 };
@@ -18,7 +18,9 @@ HardwareBufferExternalTextureVK::HardwareBufferExternalTextureVK(
     : HardwareBufferExternalTexture(id, image_texture_entry, jni_facade),
       impeller_context_(impeller_context) {}
 
-HardwareBufferExternalTextureVK::~HardwareBufferExternalTextureVK() {}
+HardwareBufferExternalTextureVK::~HardwareBufferExternalTextureVK() {
+  ClearImportedTextures();
+}
 
 void HardwareBufferExternalTextureVK::ProcessFrame(PaintContext& context,
                                                    const SkRect& bounds) {
@@ -33,32 +35,70 @@ void HardwareBufferExternalTextureVK::ProcessFrame(PaintContext& context,
     return;
   }
 
+  auto texture = GetOrImportTexture(latest_hardware_buffer);
+  if (texture) {
+    dl_image_ = impeller::DlImageImpeller::Make(texture);
+  }
+
+  // GetLatestHardwareBuffer keeps a reference on the hardware buffer, drop it.
+  NDKHelpers::AHardwareBuffer_release(latest_hardware_buffer);
+}
+
+std::shared_ptr<impeller::TextureVK>
+HardwareBufferExternalTextureVK::GetOrImportTexture(
+    AHardwareBuffer* hardware_buffer) {
+  for (auto it = imported_textures_.begin(); it != imported_textures_.end();
+       ++it) {
+    if (it->hardware_buffer == hardware_buffer) {
+      auto imported = std::move(*it);
+      imported_textures_.erase(it);
+      imported_textures_.insert(imported_textures_.begin(), imported);
+      return imported.texture;
+    }
+  }
+
   AHardwareBuffer_Desc hb_desc = {};
-  flutter::NDKHelpers::AHardwareBuffer_describe(latest_hardware_buffer,
-                                                &hb_desc);
+  flutter::NDKHelpers::AHardwareBuffer_describe(hardware_buffer, &hb_desc);
 
   impeller::TextureDescriptor desc;
   desc.storage_mode = impeller::StorageMode::kDevicePrivate;
-  desc.size = {static_cast<int>(bounds.width()),
-               static_cast<int>(bounds.height())};
+  desc.size = {static_cast<int>(hb_desc.width),
+               static_cast<int>(hb_desc.height)};
   // TODO(johnmccutchan): Use hb_desc to compute the correct format at runtime.
   desc.format = impeller::PixelFormat::kR8G8B8A8UNormInt;
   desc.mip_count = 1;
 
   auto texture_source =
       std::make_shared<impeller::AndroidHardwareBufferTextureSourceVK>(
-          desc, impeller_context_->GetDevice(), latest_hardware_buffer,
-          hb_desc);
+          desc, *impeller_context_, hardware_buffer, hb_desc);
+  if (!texture_source->IsValid()) {
+    FML_LOG(ERROR) << "Could not import the hardware buffer.";
+    return nullptr;
+  }
 
   auto texture =
       std::make_shared<impeller::TextureVK>(impeller_context_, texture_source);
 
-  dl_image_ = impeller::DlImageImpeller::Make(texture);
+  if (imported_textures_.size() == kImportedTextureCacheSize) {
+    NDKHelpers::AHardwareBuffer_release(
+        imported_textures_.back().hardware_buffer);
+    imported_textures_.pop_back();
+  }
+  NDKHelpers::AHardwareBuffer_acquire(hardware_buffer);
+  imported_textures_.insert(imported_textures_.begin(),
+                            ImportedTexture{hardware_buffer, texture});
+  return texture;
+}
 
-  // GetLatestHardwareBuffer keeps a reference on the hardware buffer, drop it.
-  NDKHelpers::AHardwareBuffer_release(latest_hardware_buffer);
+void HardwareBufferExternalTextureVK::ClearImportedTextures() {
+  for (const auto& imported : imported_textures_) {
+    NDKHelpers::AHardwareBuffer_release(imported.hardware_buffer);
+  }
+  imported_textures_.clear();
 }
 
-void HardwareBufferExternalTextureVK::Detach() {}
+void HardwareBufferExternalTextureVK::Detach() {
+  ClearImportedTextures();
+}
 
 }  // namespace flutter
@@ -7,6 +7,9 @@
 
 #include "flutter/shell/platform/android/hardware_buffer_external_texture.h"
 
+#include <vector>
+
+#include "flutter/impeller/renderer/backend/vulkan/texture_vk.h"
 #include "flutter/impeller/renderer/backend/vulkan/android_hardware_buffer_texture_source_vk.h"
 #include "flutter/impeller/renderer/backend/vulkan/context_vk.h"
 #include "flutter/impeller/renderer/backend/vulkan/vk.h"
@@ -26,10 +29,29 @@ class HardwareBufferExternalTextureVK : public HardwareBufferExternalTexture {
   ~HardwareBufferExternalTextureVK() override;
 
  private:
+  // The producers of the hardware buffers, like image readers, cycle through a
+  // small number of them. So the textures imported from the most recently used
+  // hardware buffers are kept, instead of creating and binding a new image for
+  // the buffer of every frame. Cached buffers are kept acquired so that their
+  // addresses keep identifying them.
+  static constexpr size_t kImportedTextureCacheSize = 4u;
+
+  struct ImportedTexture {
+    AHardwareBuffer* hardware_buffer = nullptr;
+    std::shared_ptr<impeller::TextureVK> texture;
+  };
+
   void ProcessFrame(PaintContext& context, const SkRect& bounds) override;
   void Detach() override;
 
+  std::shared_ptr<impeller::TextureVK> GetOrImportTexture(
+      AHardwareBuffer* hardware_buffer);
+
+  void ClearImportedTextures();
+
   const std::shared_ptr<impeller::ContextVK> impeller_context_;
+  // Ordered from the most to the least recently used.
+  std::vector<ImportedTexture> imported_textures_;
 };
 
 }  // namespace flutter
@@ -40,6 +40,7 @@ import io.flutter.view.TextureRegistry;
 import java.io.IOException;
 import java.lang.ref.WeakReference;
 import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 import java.util.ArrayList;
 import java.util.List;
 import java.util.Locale;
@@ -1234,6 +1235,110 @@ public class FlutterJNI {
     platformViewsController.onEndFrame();
   }
 
+  // The kinds of records in a platform view frame. These must match the constants in
+  // platform_view_android_jni_impl.cc.
+  private static final int PLATFORM_VIEW_RECORD = 0;
+  private static final int OVERLAY_SURFACE_RECORD = 1;
+  private static final int TRANSFORM_MUTATOR_RECORD = 0;
+  private static final int CLIP_RECT_MUTATOR_RECORD = 1;
+  private static final int CLIP_RRECT_MUTATOR_RECORD = 2;
+
+  /**
+   * Called by native to display the platform views and overlay surfaces of a frame in a single
+   * call.
+   *
+   * <p>The frame is a sequence of records in native byte order, which are applied in order
+   * between {@link PlatformViewsController#onBeginFrame()} and {@link
+   * PlatformViewsController#onEndFrame()}.
+   * The buffer is only valid for the duration of the call.
+   */
+  @SuppressWarnings("unused")
+  @UiThread
+  public void onPlatformViewFrame(@NonNull ByteBuffer frame) {
+    ensureRunningOnMainThread();
+    if (platformViewsController == null) {
+      throw new RuntimeException(
+          "platformViewsController must be set before attempting to display a frame");
+    }
+    frame.order(ByteOrder.nativeOrder());
+    platformViewsController.onBeginFrame();
+    while (frame.hasRemaining()) {
+      final int record = frame.getInt();
+      switch (record) {
+        case PLATFORM_VIEW_RECORD:
+          {
+            final int viewId = frame.getInt();
+            final int x = frame.getInt();
+            final int y = frame.getInt();
+            final int width = frame.getInt();
+            final int height = frame.getInt();
+            final int viewWidth = frame.getInt();
+            final int viewHeight = frame.getInt();
+            final FlutterMutatorsStack mutatorsStack = decodeMutatorsStack(frame);
+            platformViewsController.onDisplayPlatformView(
+                viewId, x, y, width, height, viewWidth, viewHeight, mutatorsStack);
+            break;
+          }
+        case OVERLAY_SURFACE_RECORD:
+          {
+            final int id = frame.getInt();
+            final int x = frame.getInt();
+            final int y = frame.getInt();
+            final int width = frame.getInt();
+            final int height = frame.getInt();
+            platformViewsController.onDisplayOverlaySurface(id, x, y, width, height);
+            break;
+          }
+        default:
+          throw new IllegalStateException("Unknown platform view frame record: " + record);
+      }
+    }
+    platformViewsController.onEndFrame();
+  }
+
+  @NonNull
+  private static FlutterMutatorsStack decodeMutatorsStack(@NonNull ByteBuffer frame) {
+    final FlutterMutatorsStack mutatorsStack = new FlutterMutatorsStack();
+    final int mutatorCount = frame.getInt();
+    for (int i = 0; i < mutatorCount; i++) {
+      final int mutator = frame.getInt();
+      switch (mutator) {
+        case TRANSFORM_MUTATOR_RECORD:
+          {
+            final float[] matrix = new float[9];
+            frame.asFloatBuffer().get(matrix);
+            frame.position(frame.position() + matrix.length * 4);
+            mutatorsStack.pushTransform(matrix);
+            break;
+          }
+        case CLIP_RECT_MUTATOR_RECORD:
+          {
+            final int left = frame.getInt();
+            final int top = frame.getInt();
+            final int right = frame.getInt();
+            final int bottom = frame.getInt();
+            mutatorsStack.pushClipRect(left, top, right, bottom);
+            break;
+          }
+        case CLIP_RRECT_MUTATOR_RECORD:
+          {
+            final int left = frame.getInt();
+            final int top = frame.getInt();
+            final int right = frame.getInt();
+            final int bottom = frame.getInt();
+            final float[] radii = new float[8];
+            frame.asFloatBuffer().get(radii);
+            frame.position(frame.position() + radii.length * 4);
+            mutatorsStack.pushClipRRect(left, top, right, bottom, radii);
+            break;
+          }
+        default:
+          throw new IllegalStateException("Unknown mutator record: " + mutator);
+      }
+    }
+    return mutatorsStack;
+  }
+
   @SuppressWarnings("unused")
   @UiThread
   public FlutterOverlaySurface createOverlaySurface() {
@@ -26,6 +26,8 @@ public class FlutterShellArgs {
   public static final String ARG_START_PAUSED = "--start-paused";
   public static final String ARG_KEY_DISABLE_SERVICE_AUTH_CODES = "disable-service-auth-codes";
   public static final String ARG_DISABLE_SERVICE_AUTH_CODES = "--disable-service-auth-codes";
+  public static final String ARG_KEY_DEFER_VM_SERVICE_STARTUP = "defer-vm-service-startup";
+  public static final String ARG_DEFER_VM_SERVICE_STARTUP = "--defer-vm-service-startup";
   public static final String ARG_KEY_ENDLESS_TRACE_BUFFER = "endless-trace-buffer";
   public static final String ARG_ENDLESS_TRACE_BUFFER = "--endless-trace-buffer";
   public static final String ARG_KEY_USE_TEST_FONTS = "use-test-fonts";
@@ -97,6 +99,9 @@ public class FlutterShellArgs {
     if (intent.getBooleanExtra(ARG_KEY_DISABLE_SERVICE_AUTH_CODES, false)) {
       args.add(ARG_DISABLE_SERVICE_AUTH_CODES);
     }
+    if (intent.getBooleanExtra(ARG_KEY_DEFER_VM_SERVICE_STARTUP, false)) {
+      args.add(ARG_DEFER_VM_SERVICE_STARTUP);
+    }
     if (intent.getBooleanExtra(ARG_KEY_ENDLESS_TRACE_BUFFER, false)) {
       args.add(ARG_ENDLESS_TRACE_BUFFER);
     }
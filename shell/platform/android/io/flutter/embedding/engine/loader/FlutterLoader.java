@@ -43,8 +43,12 @@ public class FlutterLoader {
       "io.flutter.embedding.android.EnableImpeller";
   private static final String ENABLE_VULKAN_VALIDATION_META_DATA_KEY =
       "io.flutter.embedding.android.EnableVulkanValidation";
+  private static final String ENABLE_VULKAN_LOW_LATENCY_PRESENT_META_DATA_KEY =
+      "io.flutter.embedding.android.EnableVulkanLowLatencyPresent";
   private static final String IMPELLER_BACKEND_META_DATA_KEY =
       "io.flutter.embedding.android.ImpellerBackend";
+  private static final String ENABLE_PLATFORM_VIEW_TRANSACTIONS_META_DATA_KEY =
+      "io.flutter.embedding.android.EnablePlatformViewTransactions";
 
   /**
    * Set whether leave or clean up the VM after the last shell shuts down. It can be set from app's
@@ -335,10 +339,16 @@ public class FlutterLoader {
             ENABLE_VULKAN_VALIDATION_META_DATA_KEY, areValidationLayersOnByDefault())) {
           shellArgs.add("--enable-vulkan-validation");
         }
+        if (metaData.getBoolean(ENABLE_VULKAN_LOW_LATENCY_PRESENT_META_DATA_KEY, false)) {
+          shellArgs.add("--enable-vulkan-low-latency-present");
+        }
         String backend = metaData.getString(IMPELLER_BACKEND_META_DATA_KEY);
         if (backend != null) {
           shellArgs.add("--impeller-backend=" + backend);
         }
+        if (metaData.getBoolean(ENABLE_PLATFORM_VIEW_TRANSACTIONS_META_DATA_KEY, false)) {
+          shellArgs.add("--enable-platform-view-transactions");
+        }
       }
 
       final String leakVM = isLeakVM(metaData) ? "true" : "false";
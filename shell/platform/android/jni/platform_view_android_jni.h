@@ -160,6 +160,9 @@ class PlatformViewAndroidJNI {
   //----------------------------------------------------------------------------
   /// @brief      Initiates a frame if using hybrid composition.
   ///
+  ///             The platform views and overlay surfaces displayed until
+  ///             `FlutterViewEndFrame` may be sent to Java together when the
+  ///             frame ends.
   ///
   /// @note       Must be called from the platform thread.
   ///
@@ -24,6 +24,20 @@ typedef void (*fp_AHardwareBuffer_describe)(AHardwareBuffer* buffer,
                                             AHardwareBuffer_Desc* desc);
 typedef EGLClientBuffer (*fp_eglGetNativeClientBufferANDROID)(
     AHardwareBuffer* buffer);
+typedef APerformanceHintManager* (*fp_APerformanceHint_getManager)();
+typedef APerformanceHintSession* (*fp_APerformanceHint_createSession)(
+    APerformanceHintManager* manager,
+    const int32_t* thread_ids,
+    size_t size,
+    int64_t initial_target_work_duration_nanos);
+typedef int (*fp_APerformanceHint_updateTargetWorkDuration)(
+    APerformanceHintSession* session,
+    int64_t target_duration_nanos);
+typedef int (*fp_APerformanceHint_reportActualWorkDuration)(
+    APerformanceHintSession* session,
+    int64_t actual_duration_nanos);
+typedef void (*fp_APerformanceHint_closeSession)(
+    APerformanceHintSession* session);
 
 AHardwareBuffer* (*_AHardwareBuffer_fromHardwareBuffer)(
     JNIEnv* env,
@@ -34,6 +48,13 @@ void (*_AHardwareBuffer_describe)(AHardwareBuffer* buffer,
                                   AHardwareBuffer_Desc* desc) = nullptr;
 EGLClientBuffer (*_eglGetNativeClientBufferANDROID)(AHardwareBuffer* buffer) =
     nullptr;
+fp_APerformanceHint_getManager _APerformanceHint_getManager = nullptr;
+fp_APerformanceHint_createSession _APerformanceHint_createSession = nullptr;
+fp_APerformanceHint_updateTargetWorkDuration
+    _APerformanceHint_updateTargetWorkDuration = nullptr;
+fp_APerformanceHint_reportActualWorkDuration
+    _APerformanceHint_reportActualWorkDuration = nullptr;
+fp_APerformanceHint_closeSession _APerformanceHint_closeSession = nullptr;
 
 std::once_flag init_once;
 
@@ -66,6 +87,31 @@ void InitOnceCallback() {
           ->ResolveFunction<fp_AHardwareBuffer_describe>(
               "AHardwareBuffer_describe")
           .value_or(nullptr);
+  _APerformanceHint_getManager =
+      android
+          ->ResolveFunction<fp_APerformanceHint_getManager>(
+              "APerformanceHint_getManager")
+          .value_or(nullptr);
+  _APerformanceHint_createSession =
+      android
+          ->ResolveFunction<fp_APerformanceHint_createSession>(
+              "APerformanceHint_createSession")
+          .value_or(nullptr);
+  _APerformanceHint_updateTargetWorkDuration =
+      android
+          ->ResolveFunction<fp_APerformanceHint_updateTargetWorkDuration>(
+              "APerformanceHint_updateTargetWorkDuration")
+          .value_or(nullptr);
+  _APerformanceHint_reportActualWorkDuration =
+      android
+          ->ResolveFunction<fp_APerformanceHint_reportActualWorkDuration>(
+              "APerformanceHint_reportActualWorkDuration")
+          .value_or(nullptr);
+  _APerformanceHint_closeSession =
+      android
+          ->ResolveFunction<fp_APerformanceHint_closeSession>(
+              "APerformanceHint_closeSession")
+          .value_or(nullptr);
 }
 
 }  // namespace
@@ -114,4 +160,55 @@ EGLClientBuffer NDKHelpers::eglGetNativeClientBufferANDROID(
   return _eglGetNativeClientBufferANDROID(buffer);
 }
 
+bool NDKHelpers::PerformanceHintSupported() {
+  NDKHelpers::Init();
+  return _APerformanceHint_getManager != nullptr &&
+         _APerformanceHint_createSession != nullptr &&
+         _APerformanceHint_updateTargetWorkDuration != nullptr &&
+         _APerformanceHint_reportActualWorkDuration != nullptr &&
+         _APerformanceHint_closeSession != nullptr;
+}
+
+APerformanceHintManager* NDKHelpers::APerformanceHint_getManager() {
+  NDKHelpers::Init();
+  FML_CHECK(_APerformanceHint_getManager != nullptr);
+  return _APerformanceHint_getManager();
+}
+
+APerformanceHintSession* NDKHelpers::APerformanceHint_createSession(
+    APerformanceHintManager* manager,
+    const int32_t* thread_ids,
+    size_t size,
+    int64_t initial_target_work_duration_nanos) {
+  NDKHelpers::Init();
+  FML_CHECK(_APerformanceHint_createSession != nullptr);
+  return _APerformanceHint_createSession(manager, thread_ids, size,
+                                         initial_target_work_duration_nanos);
+}
+
+int NDKHelpers::APerformanceHint_updateTargetWorkDuration(
+    APerformanceHintSession* session,
+    int64_t target_duration_nanos) {
+  NDKHelpers::Init();
+  FML_CHECK(_APerformanceHint_updateTargetWorkDuration != nullptr);
+  return _APerformanceHint_updateTargetWorkDuration(session,
+                                                    target_duration_nanos);
+}
+
+int NDKHelpers::APerformanceHint_reportActualWorkDuration(
+    APerformanceHintSession* session,
+    int64_t actual_duration_nanos) {
+  NDKHelpers::Init();
+  FML_CHECK(_APerformanceHint_reportActualWorkDuration != nullptr);
+  return _APerformanceHint_reportActualWorkDuration(session,
+                                                    actual_duration_nanos);
+}
+
+void NDKHelpers::APerformanceHint_closeSession(
+    APerformanceHintSession* session) {
+  NDKHelpers::Init();
+  FML_CHECK(_APerformanceHint_closeSession != nullptr);
+  _APerformanceHint_closeSession(session);
+}
+
 }  // namespace flutter
@@ -12,6 +12,10 @@
 
 #include <android/hardware_buffer.h>
 
+// Declared by <android/performance_hint.h> from API level 33.
+struct APerformanceHintManager;
+struct APerformanceHintSession;
+
 namespace flutter {
 
 // A collection of NDK functions that are available depending on the version of
@@ -30,6 +34,22 @@ class NDKHelpers {
   static EGLClientBuffer eglGetNativeClientBufferANDROID(
       AHardwareBuffer* buffer);
 
+  // API Version 33
+  static bool PerformanceHintSupported();
+  static APerformanceHintManager* APerformanceHint_getManager();
+  static APerformanceHintSession* APerformanceHint_createSession(
+      APerformanceHintManager* manager,
+      const int32_t* thread_ids,
+      size_t size,
+      int64_t initial_target_work_duration_nanos);
+  static int APerformanceHint_updateTargetWorkDuration(
+      APerformanceHintSession* session,
+      int64_t target_duration_nanos);
+  static int APerformanceHint_reportActualWorkDuration(
+      APerformanceHintSession* session,
+      int64_t actual_duration_nanos);
+  static void APerformanceHint_closeSession(APerformanceHintSession* session);
+
  private:
   static void Init();
 };
@@ -4,10 +4,33 @@
 
 #include "flutter/shell/platform/android/platform_view_android_delegate/platform_view_android_delegate.h"
 
+#include <string_view>
+#include <unordered_map>
 #include <utility>
 
 namespace flutter {
 
+// Strings are interned, so every distinct string in an update is only sent
+// once and decoded into a single Java string. |string_indices| maps the
+// strings already in |strings| to their index, and must not outlive the
+// strings passed in.
+void putStringIntoBuffer(
+    const std::string& string,
+    int32_t* buffer_int32,
+    size_t& position,
+    std::vector<std::string>& strings,
+    std::unordered_map<std::string_view, int32_t>& string_indices) {
+  if (string.empty()) {
+    buffer_int32[position++] = -1;
+    return;
+  }
+  auto [iter, inserted] = string_indices.try_emplace(string, strings.size());
+  if (inserted) {
+    strings.push_back(string);
+  }
+  buffer_int32[position++] = iter->second;
+}
+
 void putStringAttributesIntoBuffer(
     const StringAttributes& attributes,
     int32_t* buffer_int32,
@@ -83,6 +106,7 @@ void PlatformViewAndroidDelegate::UpdateSemantics(
     float* buffer_float32 = reinterpret_cast<float*>(&buffer[0]);
 
     std::vector<std::string> strings;
+    std::unordered_map<std::string_view, int32_t> string_indices;
     std::vector<std::vector<uint8_t>> string_attribute_args;
     size_t position = 0;
     for (const auto& value : update) {
@@ -103,59 +127,35 @@ void PlatformViewAndroidDelegate::UpdateSemantics(
       buffer_float32[position++] = static_cast<float>(node.scrollPosition);
       buffer_float32[position++] = static_cast<float>(node.scrollExtentMax);
       buffer_float32[position++] = static_cast<float>(node.scrollExtentMin);
-      if (node.label.empty()) {
-        buffer_int32[position++] = -1;
-      } else {
-        buffer_int32[position++] = strings.size();
-        strings.push_back(node.label);
-      }
+      putStringIntoBuffer(node.label, buffer_int32, position, strings,
+                          string_indices);
 
       putStringAttributesIntoBuffer(node.labelAttributes, buffer_int32,
                                     position, string_attribute_args);
-      if (node.value.empty()) {
-        buffer_int32[position++] = -1;
-      } else {
-        buffer_int32[position++] = strings.size();
-        strings.push_back(node.value);
-      }
+      putStringIntoBuffer(node.value, buffer_int32, position, strings,
+                          string_indices);
 
       putStringAttributesIntoBuffer(node.valueAttributes, buffer_int32,
                                     position, string_attribute_args);
-      if (node.increasedValue.empty()) {
-        buffer_int32[position++] = -1;
-      } else {
-        buffer_int32[position++] = strings.size();
-        strings.push_back(node.increasedValue);
-      }
+      putStringIntoBuffer(node.increasedValue, buffer_int32, position, strings,
+                          string_indices);
 
       putStringAttributesIntoBuffer(node.increasedValueAttributes, buffer_int32,
                                     position, string_attribute_args);
-      if (node.decreasedValue.empty()) {
-        buffer_int32[position++] = -1;
-      } else {
-        buffer_int32[position++] = strings.size();
-        strings.push_back(node.decreasedValue);
-      }
+      putStringIntoBuffer(node.decreasedValue, buffer_int32, position, strings,
+                          string_indices);
 
       putStringAttributesIntoBuffer(node.decreasedValueAttributes, buffer_int32,
                                     position, string_attribute_args);
 
-      if (node.hint.empty()) {
-        buffer_int32[position++] = -1;
-      } else {
-        buffer_int32[position++] = strings.size();
-        strings.push_back(node.hint);
-      }
+      putStringIntoBuffer(node.hint, buffer_int32, position, strings,
+                          string_indices);
 
       putStringAttributesIntoBuffer(node.hintAttributes, buffer_int32, position,
                                     string_attribute_args);
 
-      if (node.tooltip.empty()) {
-        buffer_int32[position++] = -1;
-      } else {
-        buffer_int32[position++] = strings.size();
-        strings.push_back(node.tooltip);
-      }
+      putStringIntoBuffer(node.tooltip, buffer_int32, position, strings,
+                          string_indices);
 
       buffer_int32[position++] = node.textDirection;
       buffer_float32[position++] = node.rect.left();
@@ -71,6 +71,64 @@ TEST(PlatformViewShell, UpdateSemanticsDoesFlutterViewUpdateSemantics) {
   delegate->UpdateSemantics(update, actions);
 }
 
+TEST(PlatformViewShell, UpdateSemanticsInternsStrings) {
+  auto jni_mock = std::make_shared<JNIMock>();
+  auto delegate = std::make_unique<PlatformViewAndroidDelegate>(jni_mock);
+
+  flutter::SemanticsNodeUpdates update;
+  flutter::SemanticsNode node0;
+  node0.id = 0;
+  node0.label = "label";
+  node0.hint = "label";
+  update.insert(std::make_pair(0, node0));
+
+  std::vector<uint8_t> expected_buffer(188);
+  std::vector<std::vector<uint8_t>> expected_string_attribute_args(0);
+  size_t position = 0;
+  int32_t* buffer_int32 = reinterpret_cast<int32_t*>(&expected_buffer[0]);
+  float* buffer_float32 = reinterpret_cast<float*>(&expected_buffer[0]);
+  std::vector<std::string> expected_strings{node0.label};
+  buffer_int32[position++] = node0.id;
+  buffer_int32[position++] = node0.flags;
+  buffer_int32[position++] = node0.actions;
+  buffer_int32[position++] = node0.maxValueLength;
+  buffer_int32[position++] = node0.currentValueLength;
+  buffer_int32[position++] = node0.textSelectionBase;
+  buffer_int32[position++] = node0.textSelectionExtent;
+  buffer_int32[position++] = node0.platformViewId;
+  buffer_int32[position++] = node0.scrollChildren;
+  buffer_int32[position++] = node0.scrollIndex;
+  buffer_float32[position++] = static_cast<float>(node0.scrollPosition);
+  buffer_float32[position++] = static_cast<float>(node0.scrollExtentMax);
+  buffer_float32[position++] = static_cast<float>(node0.scrollExtentMin);
+  buffer_int32[position++] = 0;   // node0.label
+  buffer_int32[position++] = -1;  // node0.labelAttributes
+  buffer_int32[position++] = -1;  // node0.value
+  buffer_int32[position++] = -1;  // node0.valueAttributes
+  buffer_int32[position++] = -1;  // node0.increasedValue
+  buffer_int32[position++] = -1;  // node0.increasedValueAttributes
+  buffer_int32[position++] = -1;  // node0.decreasedValue
+  buffer_int32[position++] = -1;  // node0.decreasedValueAttributes
+  buffer_int32[position++] = 0;   // node0.hint
+  buffer_int32[position++] = -1;  // node0.hintAttributes
+  buffer_int32[position++] = -1;  // node0.tooltip
+  buffer_int32[position++] = node0.textDirection;
+  buffer_float32[position++] = node0.rect.left();
+  buffer_float32[position++] = node0.rect.top();
+  buffer_float32[position++] = node0.rect.right();
+  buffer_float32[position++] = node0.rect.bottom();
+  node0.transform.getColMajor(&buffer_float32[position]);
+  position += 16;
+  buffer_int32[position++] = 0;  // node0.childrenInTraversalOrder.size();
+  buffer_int32[position++] = 0;  // node0.customAccessibilityActions.size();
+  EXPECT_CALL(*jni_mock,
+              FlutterViewUpdateSemantics(expected_buffer, expected_strings,
+                                         expected_string_attribute_args));
+  // Creates empty custom actions.
+  flutter::CustomAccessibilityActionUpdates actions;
+  delegate->UpdateSemantics(update, actions);
+}
+
 TEST(PlatformViewShell,
      UpdateSemanticsDoesFlutterViewUpdateSemanticsWithStringAttribtes) {
   auto jni_mock = std::make_shared<JNIMock>();
@@ -8,9 +8,11 @@
 #include <android/native_window_jni.h>
 #include <dlfcn.h>
 #include <jni.h>
+#include <cstring>
 #include <memory>
 #include <sstream>
 #include <utility>
+#include <vector>
 
 #include "flutter/shell/platform/android/ndk_helpers.h"
 #include "include/android/SkImageAndroid.h"
@@ -19,6 +21,7 @@
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/common/constants.h"
 #include "flutter/fml/file.h"
+#include "flutter/fml/icu_util.h"
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/native_library.h"
 #include "flutter/fml/platform/android/jni_util.h"
@@ -103,9 +106,7 @@ static jmethodID g_create_overlay_surface_method = nullptr;
 
 static jmethodID g_destroy_overlay_surfaces_method = nullptr;
 
-static jmethodID g_on_begin_frame_method = nullptr;
-
-static jmethodID g_on_end_frame_method = nullptr;
+static jmethodID g_on_platform_view_frame_method = nullptr;
 
 static jmethodID g_java_weak_reference_get_method = nullptr;
 
@@ -560,30 +561,35 @@ static void SetIsRenderingToImageView(JNIEnv* env,
 static jboolean FlutterTextUtilsIsEmoji(JNIEnv* env,
                                         jobject obj,
                                         jint codePoint) {
+  fml::icu::EnsureICUInitialized();
   return u_hasBinaryProperty(codePoint, UProperty::UCHAR_EMOJI);
 }
 
 static jboolean FlutterTextUtilsIsEmojiModifier(JNIEnv* env,
                                                 jobject obj,
                                                 jint codePoint) {
+  fml::icu::EnsureICUInitialized();
   return u_hasBinaryProperty(codePoint, UProperty::UCHAR_EMOJI_MODIFIER);
 }
 
 static jboolean FlutterTextUtilsIsEmojiModifierBase(JNIEnv* env,
                                                     jobject obj,
                                                     jint codePoint) {
+  fml::icu::EnsureICUInitialized();
   return u_hasBinaryProperty(codePoint, UProperty::UCHAR_EMOJI_MODIFIER_BASE);
 }
 
 static jboolean FlutterTextUtilsIsVariationSelector(JNIEnv* env,
                                                     jobject obj,
                                                     jint codePoint) {
+  fml::icu::EnsureICUInitialized();
   return u_hasBinaryProperty(codePoint, UProperty::UCHAR_VARIATION_SELECTOR);
 }
 
 static jboolean FlutterTextUtilsIsRegionalIndicator(JNIEnv* env,
                                                     jobject obj,
                                                     jint codePoint) {
+  fml::icu::EnsureICUInitialized();
   return u_hasBinaryProperty(codePoint, UProperty::UCHAR_REGIONAL_INDICATOR);
 }
 
@@ -1105,19 +1111,12 @@ bool PlatformViewAndroid::Register(JNIEnv* env) {
     return false;
   }
 
-  g_on_begin_frame_method =
-      env->GetMethodID(g_flutter_jni_class->obj(), "onBeginFrame", "()V");
-
-  if (g_on_begin_frame_method == nullptr) {
-    FML_LOG(ERROR) << "Could not locate onBeginFrame method";
-    return false;
-  }
-
-  g_on_end_frame_method =
-      env->GetMethodID(g_flutter_jni_class->obj(), "onEndFrame", "()V");
+  g_on_platform_view_frame_method =
+      env->GetMethodID(g_flutter_jni_class->obj(), "onPlatformViewFrame",
+                       "(Ljava/nio/ByteBuffer;)V");
 
-  if (g_on_end_frame_method == nullptr) {
-    FML_LOG(ERROR) << "Could not locate onEndFrame method";
+  if (g_on_platform_view_frame_method == nullptr) {
+    FML_LOG(ERROR) << "Could not locate onPlatformViewFrame method";
     return false;
   }
 
@@ -1613,6 +1612,104 @@ void PlatformViewAndroidJNIImpl::HardwareBufferClose(
   FML_CHECK(fml::jni::CheckException(env));
 }
 
+// The kinds of records in a platform view frame. These must match the
+// constants in FlutterJNI.java.
+static constexpr int32_t kPlatformViewRecord = 0;
+static constexpr int32_t kOverlaySurfaceRecord = 1;
+static constexpr int32_t kTransformMutatorRecord = 0;
+static constexpr int32_t kClipRectMutatorRecord = 1;
+static constexpr int32_t kClipRRectMutatorRecord = 2;
+
+template <typename T>
+static void EncodeValue(std::vector<uint8_t>& frame, T value) {
+  static_assert(sizeof(T) == 4, "Java reads 32 bit values.");
+  const size_t offset = frame.size();
+  frame.resize(offset + sizeof(T));
+  memcpy(frame.data() + offset, &value, sizeof(T));
+}
+
+// Encodes a platform view and the mutators that Java supports, in the order
+// they were pushed. Mutators that Java doesn't support are left out.
+static void EncodePlatformView(std::vector<uint8_t>& frame,
+                               int view_id,
+                               int x,
+                               int y,
+                               int width,
+                               int height,
+                               int view_width,
+                               int view_height,
+                               const MutatorsStack& mutators_stack) {
+  EncodeValue<int32_t>(frame, kPlatformViewRecord);
+  for (int value : {view_id, x, y, width, height, view_width, view_height}) {
+    EncodeValue<int32_t>(frame, value);
+  }
+
+  const size_t mutator_count_offset = frame.size();
+  int32_t mutator_count = 0;
+  EncodeValue<int32_t>(frame, mutator_count);
+  for (auto iter = mutators_stack.Begin(); iter != mutators_stack.End();
+       ++iter) {
+    switch ((*iter)->GetType()) {
+      case kTransform: {
+        SkScalar matrix[9];
+        (*iter)->GetMatrix().get9(matrix);
+        EncodeValue<int32_t>(frame, kTransformMutatorRecord);
+        for (SkScalar value : matrix) {
+          EncodeValue<float>(frame, value);
+        }
+        break;
+      }
+      case kClipRect: {
+        const SkRect& rect = (*iter)->GetRect();
+        EncodeValue<int32_t>(frame, kClipRectMutatorRecord);
+        EncodeValue<int32_t>(frame, static_cast<int32_t>(rect.left()));
+        EncodeValue<int32_t>(frame, static_cast<int32_t>(rect.top()));
+        EncodeValue<int32_t>(frame, static_cast<int32_t>(rect.right()));
+        EncodeValue<int32_t>(frame, static_cast<int32_t>(rect.bottom()));
+        break;
+      }
+      case kClipRRect: {
+        const SkRRect& rrect = (*iter)->GetRRect();
+        const SkRect& rect = rrect.rect();
+        EncodeValue<int32_t>(frame, kClipRRectMutatorRecord);
+        EncodeValue<int32_t>(frame, static_cast<int32_t>(rect.left()));
+        EncodeValue<int32_t>(frame, static_cast<int32_t>(rect.top()));
+        EncodeValue<int32_t>(frame, static_cast<int32_t>(rect.right()));
+        EncodeValue<int32_t>(frame, static_cast<int32_t>(rect.bottom()));
+        for (auto corner :
+             {SkRRect::kUpperLeft_Corner, SkRRect::kUpperRight_Corner,
+              SkRRect::kLowerRight_Corner, SkRRect::kLowerLeft_Corner}) {
+          const SkVector& radii = rrect.radii(corner);
+          EncodeValue<float>(frame, radii.x());
+          EncodeValue<float>(frame, radii.y());
+        }
+        break;
+      }
+      // TODO(cyanglaz): Implement other mutators.
+      // https://github.com/flutter/flutter/issues/58426
+      case kClipPath:
+      case kOpacity:
+      case kBackdropFilter:
+        continue;
+    }
+    mutator_count++;
+  }
+  memcpy(frame.data() + mutator_count_offset, &mutator_count,
+         sizeof(mutator_count));
+}
+
+static void EncodeOverlaySurface(std::vector<uint8_t>& frame,
+                                 int surface_id,
+                                 int x,
+                                 int y,
+                                 int width,
+                                 int height) {
+  EncodeValue<int32_t>(frame, kOverlaySurfaceRecord);
+  for (int value : {surface_id, x, y, width, height}) {
+    EncodeValue<int32_t>(frame, value);
+  }
+}
+
 void PlatformViewAndroidJNIImpl::FlutterViewOnDisplayPlatformView(
     int view_id,
     int x,
@@ -1622,6 +1719,12 @@ void PlatformViewAndroidJNIImpl::FlutterViewOnDisplayPlatformView(
     int viewWidth,
     int viewHeight,
     MutatorsStack mutators_stack) {
+  if (is_in_platform_view_frame_) {
+    EncodePlatformView(platform_view_frame_, view_id, x, y, width, height,
+                       viewWidth, viewHeight, mutators_stack);
+    return;
+  }
+
   JNIEnv* env = fml::jni::AttachCurrentThread();
   auto java_object = java_object_.get(env);
   if (java_object.is_null()) {
@@ -1700,6 +1803,12 @@ void PlatformViewAndroidJNIImpl::FlutterViewDisplayOverlaySurface(
     int y,
     int width,
     int height) {
+  if (is_in_platform_view_frame_) {
+    EncodeOverlaySurface(platform_view_frame_, surface_id, x, y, width,
+                         height);
+    return;
+  }
+
   JNIEnv* env = fml::jni::AttachCurrentThread();
 
   auto java_object = java_object_.get(env);
@@ -1714,19 +1823,14 @@ void PlatformViewAndroidJNIImpl::FlutterViewDisplayOverlaySurface(
 }
 
 void PlatformViewAndroidJNIImpl::FlutterViewBeginFrame() {
-  JNIEnv* env = fml::jni::AttachCurrentThread();
-
-  auto java_object = java_object_.get(env);
-  if (java_object.is_null()) {
-    return;
-  }
-
-  env->CallVoidMethod(java_object.obj(), g_on_begin_frame_method);
-
-  FML_CHECK(fml::jni::CheckException(env));
+  // The frame is sent to Java in a single call when it ends.
+  platform_view_frame_.clear();
+  is_in_platform_view_frame_ = true;
 }
 
 void PlatformViewAndroidJNIImpl::FlutterViewEndFrame() {
+  is_in_platform_view_frame_ = false;
+
   JNIEnv* env = fml::jni::AttachCurrentThread();
 
   auto java_object = java_object_.get(env);
@@ -1734,7 +1838,18 @@ void PlatformViewAndroidJNIImpl::FlutterViewEndFrame() {
     return;
   }
 
-  env->CallVoidMethod(java_object.obj(), g_on_end_frame_method);
+  // Java doesn't keep the buffer after the call returns, so it can point
+  // into the encoded frame, which is reused by the next frame.
+  // NewDirectByteBuffer requires a non-null address, even for empty frames.
+  static uint8_t empty_frame = 0;
+  void* frame_data = platform_view_frame_.empty()
+                         ? &empty_frame
+                         : platform_view_frame_.data();
+  fml::jni::ScopedJavaLocalRef<jobject> frame_buffer(
+      env, env->NewDirectByteBuffer(frame_data, platform_view_frame_.size()));
+
+  env->CallVoidMethod(java_object.obj(), g_on_platform_view_frame_method,
+                      frame_buffer.obj());
 
   FML_CHECK(fml::jni::CheckException(env));
 }
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_SHELL_PLATFORM_ANDROID_PLATFORM_VIEW_ANDROID_JNI_IMPL_H_
 #define FLUTTER_SHELL_PLATFORM_ANDROID_PLATFORM_VIEW_ANDROID_JNI_IMPL_H_
 
+#include <vector>
+
 #include "flutter/fml/platform/android/jni_weak_ref.h"
 #include "flutter/shell/platform/android/jni/platform_view_android_jni.h"
 
@@ -106,6 +108,13 @@ class PlatformViewAndroidJNIImpl final : public PlatformViewAndroidJNI {
   // Reference to FlutterJNI object.
   const fml::jni::JavaObjectWeakGlobalRef java_object_;
 
+  // Whether the platform views and overlay surfaces are part of a frame,
+  // which is sent to Java in a single call by `FlutterViewEndFrame`.
+  bool is_in_platform_view_frame_ = false;
+
+  // The encoded platform views and overlay surfaces of the current frame.
+  std::vector<uint8_t> platform_view_frame_;
+
   FML_DISALLOW_COPY_AND_ASSIGN(PlatformViewAndroidJNIImpl);
 };
 
@@ -1,6 +1,8 @@
 package io.flutter.embedding.engine;
 
 import static org.junit.Assert.assertEquals;
+import static org.mockito.ArgumentMatchers.eq;
+import static org.mockito.Mockito.inOrder;
 import static org.mockito.Mockito.mock;
 import static org.mockito.Mockito.spy;
 import static org.mockito.Mockito.times;
@@ -20,10 +22,14 @@ import io.flutter.embedding.engine.systemchannels.LocalizationChannel;
 import io.flutter.plugin.localization.LocalizationPlugin;
 import io.flutter.plugin.platform.PlatformViewsController;
 import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.util.List;
 import java.util.Locale;
 import java.util.concurrent.atomic.AtomicInteger;
 import org.junit.Test;
 import org.junit.runner.RunWith;
+import org.mockito.ArgumentCaptor;
+import org.mockito.InOrder;
 import org.robolectric.annotation.Config;
 
 @Config(manifest = Config.NONE)
@@ -226,6 +232,70 @@ public class FlutterJNITest {
     verify(platformViewsController, times(1)).onEndFrame();
   }
 
+  @Test
+  public void onPlatformViewFrame_callsPlatformViewsControllerInOrder() {
+    PlatformViewsController platformViewsController = mock(PlatformViewsController.class);
+
+    // --- Test Setup ---
+    FlutterJNI flutterJNI = new FlutterJNI();
+    flutterJNI.setPlatformViewsController(platformViewsController);
+
+    ByteBuffer frame = ByteBuffer.allocateDirect(256).order(ByteOrder.nativeOrder());
+    // A platform view with a transform and a clip rect.
+    frame.putInt(0);
+    for (int value : new int[] {1, 10, 20, 100, 200, 100, 200}) {
+      frame.putInt(value);
+    }
+    frame.putInt(2);
+    frame.putInt(0);
+    for (float value : new float[] {1, 0, 5, 0, 1, 6, 0, 0, 1}) {
+      frame.putFloat(value);
+    }
+    frame.putInt(1);
+    for (int value : new int[] {0, 0, 50, 60}) {
+      frame.putInt(value);
+    }
+    // An overlay surface.
+    frame.putInt(1);
+    for (int value : new int[] {2, 30, 40, 50, 60}) {
+      frame.putInt(value);
+    }
+    frame.flip();
+
+    // --- Execute Test ---
+    flutterJNI.onPlatformViewFrame(frame);
+
+    // --- Verify Results ---
+    ArgumentCaptor<FlutterMutatorsStack> stack =
+        ArgumentCaptor.forClass(FlutterMutatorsStack.class);
+    InOrder inOrder = inOrder(platformViewsController);
+    inOrder.verify(platformViewsController).onBeginFrame();
+    inOrder
+        .verify(platformViewsController)
+        .onDisplayPlatformView(
+            /*viewId=*/ eq(1),
+            /*x=*/ eq(10),
+            /*y=*/ eq(20),
+            /*width=*/ eq(100),
+            /*height=*/ eq(200),
+            /*viewWidth=*/ eq(100),
+            /*viewHeight=*/ eq(200),
+            /*mutatorsStack=*/ stack.capture());
+    inOrder
+        .verify(platformViewsController)
+        .onDisplayOverlaySurface(/*id=*/ 2, /*x=*/ 30, /*y=*/ 40, /*width=*/ 50, /*height=*/ 60);
+    inOrder.verify(platformViewsController).onEndFrame();
+
+    List<FlutterMutatorsStack.FlutterMutator> mutators = stack.getValue().getMutators();
+    assertEquals(2, mutators.size());
+    assertEquals(FlutterMutatorsStack.FlutterMutatorType.TRANSFORM, mutators.get(0).getType());
+    assertEquals(FlutterMutatorsStack.FlutterMutatorType.CLIP_RECT, mutators.get(1).getType());
+    float[] matrix = new float[9];
+    mutators.get(0).getMatrix().getValues(matrix);
+    assertEquals(5, matrix[2], 0);
+    assertEquals(6, matrix[5], 0);
+  }
+
   @Test
   public void createOverlaySurface_callsPlatformViewsController() {
     PlatformViewsController platformViewsController = mock(PlatformViewsController.class);
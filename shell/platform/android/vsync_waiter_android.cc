@@ -19,7 +19,19 @@ namespace flutter {
 
 static fml::jni::ScopedJavaGlobalRef<jclass>* g_vsync_waiter_class = nullptr;
 static jmethodID g_async_wait_for_vsync_method_ = nullptr;
-static std::atomic_uint g_refresh_rate_ = 60;
+static std::atomic<float> g_refresh_rate_ = 60.0f;
+
+namespace {
+
+class RefreshRateReporterAndroid final : public VariableRefreshRateReporter {
+ public:
+  RefreshRateReporterAndroid() = default;
+
+  // |VariableRefreshRateReporter|
+  double GetRefreshRate() const override { return g_refresh_rate_; }
+};
+
+}  // namespace
 
 VsyncWaiterAndroid::VsyncWaiterAndroid(const flutter::TaskRunners& task_runners)
     : VsyncWaiter(task_runners),
@@ -34,7 +46,24 @@ void VsyncWaiterAndroid::AwaitVSync() {
     auto* weak_this = new std::weak_ptr<VsyncWaiter>(shared_from_this());
     fml::TaskRunner::RunNowOrPostTask(
         task_runners_.GetUITaskRunner(), [weak_this]() {
-          AndroidChoreographer::PostFrameCallback(&OnVsyncFromNDK, weak_this);
+          // The choreographer is per thread, and so are its refresh rate
+          // callbacks.
+          thread_local bool registered_refresh_rate_callback = false;
+          if (!registered_refresh_rate_callback) {
+            registered_refresh_rate_callback = true;
+            AndroidChoreographer::RegisterRefreshRateCallback(
+                &OnRefreshRateFromNDK, nullptr);
+          }
+          // The frame timeline has the actual deadline of the frame, which
+          // may be earlier than a full refresh period away on displays with
+          // variable refresh rates.
+          if (AndroidChoreographer::SupportsVsyncCallback()) {
+            AndroidChoreographer::PostVsyncCallback(&OnVsyncTimelineFromNDK,
+                                                    weak_this);
+          } else {
+            AndroidChoreographer::PostFrameCallback(&OnVsyncFromNDK,
+                                                    weak_this);
+          }
         });
   } else {
     // TODO(99798): Remove it when we drop support for API level < 29.
@@ -70,6 +99,40 @@ void VsyncWaiterAndroid::OnVsyncFromNDK(int64_t frame_nanos, void* data) {
   ConsumePendingCallback(weak_this, frame_time, target_time);
 }
 
+// static
+void VsyncWaiterAndroid::OnVsyncTimelineFromNDK(
+    const AndroidChoreographer::FrameTimeline& timeline,
+    void* data) {
+  auto frame_time = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromNanoseconds(timeline.frame_time_nanos));
+  auto now = fml::TimePoint::Now();
+  if (frame_time > now) {
+    frame_time = now;
+  }
+  auto target_time = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromNanoseconds(timeline.deadline_nanos));
+  if (target_time <= frame_time) {
+    target_time = frame_time + fml::TimeDelta::FromNanoseconds(
+                                   1000000000.0 / g_refresh_rate_);
+  }
+
+  TRACE_EVENT2_INT("flutter", "PlatformVsync", "frame_start_time",
+                   frame_time.ToEpochDelta().ToMicroseconds(),
+                   "frame_target_time",
+                   target_time.ToEpochDelta().ToMicroseconds());
+
+  auto* weak_this = reinterpret_cast<std::weak_ptr<VsyncWaiter>*>(data);
+  ConsumePendingCallback(weak_this, frame_time, target_time);
+}
+
+// static
+void VsyncWaiterAndroid::OnRefreshRateFromNDK(int64_t vsync_period_nanos,
+                                              void* data) {
+  if (vsync_period_nanos > 0) {
+    g_refresh_rate_ = 1000000000.0f / vsync_period_nanos;
+  }
+}
+
 // static
 void VsyncWaiterAndroid::OnVsyncFromJava(JNIEnv* env,
                                          jclass jcaller,
@@ -108,7 +171,15 @@ void VsyncWaiterAndroid::OnUpdateRefreshRate(JNIEnv* env,
                                              jclass jcaller,
                                              jfloat refresh_rate) {
   FML_DCHECK(refresh_rate > 0);
-  g_refresh_rate_ = static_cast<uint>(refresh_rate);
+  g_refresh_rate_ = refresh_rate;
+}
+
+// static
+const std::shared_ptr<VariableRefreshRateReporter>&
+VsyncWaiterAndroid::GetRefreshRateReporter() {
+  static const std::shared_ptr<VariableRefreshRateReporter> reporter =
+      std::make_shared<RefreshRateReporterAndroid>();
+  return reporter;
 }
 
 // static
@@ -10,16 +10,25 @@
 #include <memory>
 
 #include "flutter/fml/macros.h"
+#include "flutter/shell/common/variable_refresh_rate_reporter.h"
 #include "flutter/shell/common/vsync_waiter.h"
+#include "flutter/shell/platform/android/android_choreographer.h"
 
 namespace flutter {
 
-class AndroidChoreographer;
-
 class VsyncWaiterAndroid final : public VsyncWaiter {
  public:
   static bool Register(JNIEnv* env);
 
+  //----------------------------------------------------------------------------
+  /// @brief      The reporter of the refresh rate of the display the vsync
+  ///             waiters are paced to. The rate is updated by the
+  ///             choreographer when the display changes rates, or by the
+  ///             embedding on API levels without refresh rate callbacks.
+  ///
+  static const std::shared_ptr<VariableRefreshRateReporter>&
+  GetRefreshRateReporter();
+
   explicit VsyncWaiterAndroid(const flutter::TaskRunners& task_runners);
 
   ~VsyncWaiterAndroid() override;
@@ -30,6 +39,12 @@ class VsyncWaiterAndroid final : public VsyncWaiter {
 
   static void OnVsyncFromNDK(int64_t frame_nanos, void* data);
 
+  static void OnVsyncTimelineFromNDK(
+      const AndroidChoreographer::FrameTimeline& timeline,
+      void* data);
+
+  static void OnRefreshRateFromNDK(int64_t vsync_period_nanos, void* data);
+
   static void OnVsyncFromJava(JNIEnv* env,
                               jclass jcaller,
                               jlong frameDelayNanos,
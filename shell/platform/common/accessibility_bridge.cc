@@ -66,6 +66,10 @@ void AccessibilityBridge::CommitUpdates() {
       assert(false);
       return;
     }
+  } else {
+    // Nodes that are moved must be part of the update that re-adds them, so
+    // unchanged nodes can only be dropped if no node moves.
+    RemoveUnchangedNodeUpdates();
   }
 
   // Second, apply the pending node updates. This also moves reparented nodes to
@@ -83,15 +87,15 @@ void AccessibilityBridge::CommitUpdates() {
   std::vector<std::vector<SemanticsNode>> results;
   while (!pending_semantics_node_updates_.empty()) {
     auto begin = pending_semantics_node_updates_.begin();
-    SemanticsNode target = begin->second;
-    std::vector<SemanticsNode> sub_tree_list;
-    GetSubTreeList(target, sub_tree_list);
-    results.push_back(sub_tree_list);
+    SemanticsNode target = std::move(begin->second);
     pending_semantics_node_updates_.erase(begin);
+    std::vector<SemanticsNode> sub_tree_list;
+    GetSubTreeList(std::move(target), sub_tree_list);
+    results.push_back(std::move(sub_tree_list));
   }
 
   for (size_t i = results.size(); i > 0; i--) {
-    for (SemanticsNode node : results[i - 1]) {
+    for (const SemanticsNode& node : results[i - 1]) {
       ConvertFlutterUpdate(node, update);
     }
   }
@@ -112,8 +116,14 @@ void AccessibilityBridge::CommitUpdates() {
   std::string error = tree_->error();
   if (!error.empty()) {
     FML_LOG(ERROR) << "Failed to update ui::AXTree, error: " << error;
+    committed_semantics_nodes_.clear();
     return;
   }
+  for (auto& sub_tree_list : results) {
+    for (SemanticsNode& node : sub_tree_list) {
+      committed_semantics_nodes_[node.id] = std::move(node);
+    }
+  }
   // Handles accessibility events as the result of the semantics update.
   for (const auto& targeted_event : event_generator_) {
     auto event_target =
@@ -178,6 +188,7 @@ void AccessibilityBridge::OnNodeDeleted(ui::AXTree* tree,
   if (id_wrapper_map_.find(node_id) != id_wrapper_map_.end()) {
     id_wrapper_map_.erase(node_id);
   }
+  committed_semantics_nodes_.erase(node_id);
 }
 
 void AccessibilityBridge::OnAtomicUpdateFinished(
@@ -203,7 +214,7 @@ std::optional<ui::AXTreeUpdate>
 AccessibilityBridge::CreateRemoveReparentedNodesUpdate() {
   std::unordered_map<int32_t, ui::AXNodeData> updates;
 
-  for (auto node_update : pending_semantics_node_updates_) {
+  for (const auto& node_update : pending_semantics_node_updates_) {
     for (int32_t child_id : node_update.second.children_in_traversal_order) {
       // Skip nodes that don't exist or have a parent in the current tree.
       ui::AXNode* child = tree_->GetFromId(child_id);
@@ -248,7 +259,7 @@ AccessibilityBridge::CreateRemoveReparentedNodesUpdate() {
       .nodes = std::vector<ui::AXNodeData>(),
   };
 
-  for (std::pair<int32_t, ui::AXNodeData> data : updates) {
+  for (auto& data : updates) {
     update.nodes.push_back(std::move(data.second));
   }
 
@@ -256,19 +267,74 @@ AccessibilityBridge::CreateRemoveReparentedNodesUpdate() {
 }
 
 // Private method.
-void AccessibilityBridge::GetSubTreeList(const SemanticsNode& target,
+void AccessibilityBridge::GetSubTreeList(SemanticsNode target,
                                          std::vector<SemanticsNode>& result) {
-  result.push_back(target);
-  for (int32_t child : target.children_in_traversal_order) {
+  // |result| may grow while the children are visited, so refer to the target
+  // by index.
+  const size_t target_index = result.size();
+  result.push_back(std::move(target));
+  for (size_t i = 0;
+       i < result[target_index].children_in_traversal_order.size(); i++) {
+    int32_t child = result[target_index].children_in_traversal_order[i];
     auto iter = pending_semantics_node_updates_.find(child);
     if (iter != pending_semantics_node_updates_.end()) {
-      SemanticsNode node = iter->second;
-      GetSubTreeList(node, result);
+      SemanticsNode node = std::move(iter->second);
       pending_semantics_node_updates_.erase(iter);
+      GetSubTreeList(std::move(node), result);
+    }
+  }
+}
+
+// Private method.
+void AccessibilityBridge::RemoveUnchangedNodeUpdates() {
+  for (auto iter = pending_semantics_node_updates_.begin();
+       iter != pending_semantics_node_updates_.end();) {
+    const SemanticsNode& node = iter->second;
+    auto committed = committed_semantics_nodes_.find(node.id);
+    // Custom action descriptions and the focus are resolved against the rest
+    // of the update, so nodes using them are always updated.
+    if (committed == committed_semantics_nodes_.end() ||
+        node.actions & kFlutterSemanticsActionCustomAction ||
+        node.flags & kFlutterSemanticsFlagIsFocused ||
+        !SemanticsNodesAreEqual(node, committed->second)) {
+      ++iter;
+      continue;
     }
+    iter = pending_semantics_node_updates_.erase(iter);
   }
 }
 
+// Private method.
+bool AccessibilityBridge::SemanticsNodesAreEqual(const SemanticsNode& a,
+                                                 const SemanticsNode& b) {
+  return a.id == b.id && a.flags == b.flags && a.actions == b.actions &&
+         a.text_selection_base == b.text_selection_base &&
+         a.text_selection_extent == b.text_selection_extent &&
+         a.scroll_child_count == b.scroll_child_count &&
+         a.scroll_index == b.scroll_index &&
+         a.scroll_position == b.scroll_position &&
+         a.scroll_extent_max == b.scroll_extent_max &&
+         a.scroll_extent_min == b.scroll_extent_min &&
+         a.elevation == b.elevation && a.thickness == b.thickness &&
+         a.label == b.label && a.hint == b.hint && a.value == b.value &&
+         a.increased_value == b.increased_value &&
+         a.decreased_value == b.decreased_value && a.tooltip == b.tooltip &&
+         a.text_direction == b.text_direction &&
+         a.rect.left == b.rect.left && a.rect.top == b.rect.top &&
+         a.rect.right == b.rect.right && a.rect.bottom == b.rect.bottom &&
+         a.transform.scaleX == b.transform.scaleX &&
+         a.transform.skewX == b.transform.skewX &&
+         a.transform.transX == b.transform.transX &&
+         a.transform.skewY == b.transform.skewY &&
+         a.transform.scaleY == b.transform.scaleY &&
+         a.transform.transY == b.transform.transY &&
+         a.transform.pers0 == b.transform.pers0 &&
+         a.transform.pers1 == b.transform.pers1 &&
+         a.transform.pers2 == b.transform.pers2 &&
+         a.children_in_traversal_order == b.children_in_traversal_order &&
+         a.custom_accessibility_actions == b.custom_accessibility_actions;
+}
+
 void AccessibilityBridge::ConvertFlutterUpdate(const SemanticsNode& node,
                                                ui::AXTreeUpdate& tree_update) {
   ui::AXNodeData node_data;
@@ -295,7 +361,7 @@ void AccessibilityBridge::ConvertFlutterUpdate(const SemanticsNode& node,
     node_data.child_ids.push_back(child);
   }
   SetTreeData(node, tree_update);
-  tree_update.nodes.push_back(node_data);
+  tree_update.nodes.push_back(std::move(node_data));
 }
 
 void AccessibilityBridge::SetRoleFromFlutterUpdate(ui::AXNodeData& node_data,
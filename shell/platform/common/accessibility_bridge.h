@@ -199,6 +199,9 @@ class AccessibilityBridge
   std::unique_ptr<ui::AXTree> tree_;
   ui::AXEventGenerator event_generator_;
   std::unordered_map<int32_t, SemanticsNode> pending_semantics_node_updates_;
+  // The semantics nodes as of the last committed update, used to drop pending
+  // updates that would not change the tree.
+  std::unordered_map<int32_t, SemanticsNode> committed_semantics_nodes_;
   std::unordered_map<int32_t, SemanticsCustomAction>
       pending_semantics_custom_action_updates_;
   AccessibilityNodeId last_focused_id_ = ui::AXNode::kInvalidAXID;
@@ -209,8 +212,10 @@ class AccessibilityBridge
   // pending_semantics_updates_. Returns std::nullopt if none are reparented.
   std::optional<ui::AXTreeUpdate> CreateRemoveReparentedNodesUpdate();
 
-  void GetSubTreeList(const SemanticsNode& target,
-                      std::vector<SemanticsNode>& result);
+  void GetSubTreeList(SemanticsNode target, std::vector<SemanticsNode>& result);
+  void RemoveUnchangedNodeUpdates();
+  static bool SemanticsNodesAreEqual(const SemanticsNode& a,
+                                     const SemanticsNode& b);
   void ConvertFlutterUpdate(const SemanticsNode& node,
                             ui::AXTreeUpdate& tree_update);
   void SetRoleFromFlutterUpdate(ui::AXNodeData& node_data,
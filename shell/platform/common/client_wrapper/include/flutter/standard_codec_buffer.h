@@ -0,0 +1,189 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_STANDARD_CODEC_BUFFER_H_
+#define FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_STANDARD_CODEC_BUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace flutter {
+
+// A writer of messages in the format of StandardMessageCodec that encodes
+// values directly from caller data, without building an EncodableValue.
+//
+// The writer never allocates. A writer created without a buffer only counts
+// the bytes that would be written, so messages can be encoded into a buffer
+// of the exact size by writing them twice:
+//
+//   StandardCodecBufferWriter sizer;
+//   WriteRecords(records, sizer);
+//   std::vector<uint8_t> message(sizer.size());
+//   StandardCodecBufferWriter writer(message.data(), message.size());
+//   WriteRecords(records, writer);
+//
+// Lists and maps are written as a header with the number of elements, followed
+// by the elements (for maps, alternating keys and values) written with the
+// other methods.
+class StandardCodecBufferWriter {
+ public:
+  // Creates a writer that only counts the bytes written to it.
+  StandardCodecBufferWriter();
+
+  // Creates a writer that writes into |buffer|, which must have a size of at
+  // least |capacity| and must remain valid for the lifetime of this object.
+  StandardCodecBufferWriter(uint8_t* buffer, size_t capacity);
+
+  ~StandardCodecBufferWriter();
+
+  // Prevent copying.
+  StandardCodecBufferWriter(StandardCodecBufferWriter const&) = delete;
+  StandardCodecBufferWriter& operator=(StandardCodecBufferWriter const&) =
+      delete;
+
+  // The number of bytes written so far, including any that didn't fit into
+  // the buffer.
+  size_t size() const { return position_; }
+
+  // Whether more bytes were written than fit into the buffer. The contents of
+  // the buffer are incomplete if this is true.
+  bool overflowed() const { return buffer_ && position_ > capacity_; }
+
+  void WriteNull();
+
+  void WriteBool(bool value);
+
+  // Writes |value| as a 32-bit integer if it fits, as StandardMessageCodec
+  // does for int64_t values.
+  void WriteInt(int64_t value);
+
+  void WriteInt32(int32_t value);
+
+  void WriteInt64(int64_t value);
+
+  void WriteDouble(double value);
+
+  void WriteString(std::string_view value);
+
+  void WriteUInt8List(const uint8_t* values, size_t count);
+
+  void WriteInt32List(const int32_t* values, size_t count);
+
+  void WriteInt64List(const int64_t* values, size_t count);
+
+  void WriteFloat32List(const float* values, size_t count);
+
+  void WriteFloat64List(const double* values, size_t count);
+
+  // Writes the header of a list of |count| values.
+  void WriteListHeader(size_t count);
+
+  // Writes the header of a map of |count| key/value pairs.
+  void WriteMapHeader(size_t count);
+
+ private:
+  void WriteType(uint8_t type);
+  void WriteSize(size_t size);
+  void WriteBytes(const void* bytes, size_t length);
+  void WriteAlignment(size_t alignment);
+  void WriteTypedList(uint8_t type,
+                      const void* values,
+                      size_t count,
+                      size_t element_size);
+
+  uint8_t* buffer_ = nullptr;
+  size_t capacity_ = 0;
+  size_t position_ = 0;
+};
+
+// A reader of messages in the format of StandardMessageCodec that decodes
+// values directly into caller data, without building an EncodableValue.
+//
+// Each Read method returns false and leaves the reader failed if the next
+// value is not of the requested type or the message is truncated. Once the
+// reader has failed, all reads return false. Strings and byte lists are
+// returned as views into the message, which must remain valid for the
+// lifetime of this object.
+class StandardCodecBufferReader {
+ public:
+  // Creates a reader reading from |bytes|, which must have a length of |size|.
+  StandardCodecBufferReader(const uint8_t* bytes, size_t size);
+
+  ~StandardCodecBufferReader();
+
+  // Prevent copying.
+  StandardCodecBufferReader(StandardCodecBufferReader const&) = delete;
+  StandardCodecBufferReader& operator=(StandardCodecBufferReader const&) =
+      delete;
+
+  // Whether all reads so far have succeeded.
+  bool ok() const { return ok_; }
+
+  // Whether the whole message has been read.
+  bool AtEnd() const { return location_ >= size_; }
+
+  // Reads a null value. Returns false without failing the reader if the next
+  // value is not null, so that optional values can be read with:
+  //
+  //   if (!reader.ReadNull()) {
+  //     reader.ReadString(&value);
+  //   }
+  bool ReadNull();
+
+  bool ReadBool(bool* value);
+
+  // Reads a 32-bit integer.
+  bool ReadInt32(int32_t* value);
+
+  // Reads an integer of either size.
+  bool ReadInt64(int64_t* value);
+
+  bool ReadDouble(double* value);
+
+  bool ReadString(std::string_view* value);
+
+  bool ReadUInt8List(const uint8_t** values, size_t* count);
+
+  // Typed lists wider than a byte are copied into |values|, which keeps its
+  // capacity, so that reusing a vector across reads doesn't allocate.
+  bool ReadInt32List(std::vector<int32_t>* values);
+
+  bool ReadInt64List(std::vector<int64_t>* values);
+
+  bool ReadFloat32List(std::vector<float>* values);
+
+  bool ReadFloat64List(std::vector<double>* values);
+
+  // Reads the header of a list, after which the |count| values of the list
+  // are read.
+  bool ReadListHeader(size_t* count);
+
+  // Reads the header of a map, after which the |count| keys and values of the
+  // map are read alternately.
+  bool ReadMapHeader(size_t* count);
+
+  // Skips the next value, including all values in it for lists and maps.
+  bool SkipValue();
+
+ private:
+  bool ReadType(uint8_t type);
+  bool ReadSize(size_t* size);
+  bool ReadBytes(void* buffer, size_t length);
+  bool ReadAlignment(size_t alignment);
+  const uint8_t* ReadView(size_t length);
+  template <typename T>
+  bool ReadTypedList(uint8_t type, std::vector<T>* values);
+  bool Fail();
+
+  const uint8_t* bytes_;
+  size_t size_;
+  size_t location_ = 0;
+  bool ok_ = true;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_STANDARD_CODEC_BUFFER_H_
@@ -3,9 +3,10 @@
 // found in the LICENSE file.
 
 // This file contains what would normally be standard_codec_serializer.cc,
-// standard_message_codec.cc, and standard_method_codec.cc. They are grouped
-// together to simplify use of the client wrapper, since the common case is
-// that any client that needs one of these files needs all three.
+// standard_message_codec.cc, standard_method_codec.cc, and
+// standard_codec_buffer.cc. They are grouped together to simplify use of the
+// client wrapper, since the common case is that any client that needs one of
+// these files needs all of them.
 
 #include <cassert>
 #include <cstring>
@@ -15,6 +16,7 @@
 #include <vector>
 
 #include "byte_buffer_streams.h"
+#include "include/flutter/standard_codec_buffer.h"
 #include "include/flutter/standard_codec_serializer.h"
 #include "include/flutter/standard_message_codec.h"
 #include "include/flutter/standard_method_codec.h"
@@ -463,4 +465,394 @@ bool StandardMethodCodec::DecodeAndProcessResponseEnvelopeInternal(
   }
 }
 
+// ===== standard_codec_buffer.h =====
+
+StandardCodecBufferWriter::StandardCodecBufferWriter() = default;
+
+StandardCodecBufferWriter::StandardCodecBufferWriter(uint8_t* buffer,
+                                                     size_t capacity)
+    : buffer_(buffer), capacity_(capacity) {
+  assert(buffer);
+}
+
+StandardCodecBufferWriter::~StandardCodecBufferWriter() = default;
+
+void StandardCodecBufferWriter::WriteNull() {
+  WriteType(static_cast<uint8_t>(EncodedType::kNull));
+}
+
+void StandardCodecBufferWriter::WriteBool(bool value) {
+  WriteType(static_cast<uint8_t>(value ? EncodedType::kTrue
+                                       : EncodedType::kFalse));
+}
+
+void StandardCodecBufferWriter::WriteInt(int64_t value) {
+  if (value >= INT32_MIN && value <= INT32_MAX) {
+    WriteInt32(static_cast<int32_t>(value));
+  } else {
+    WriteInt64(value);
+  }
+}
+
+void StandardCodecBufferWriter::WriteInt32(int32_t value) {
+  WriteType(static_cast<uint8_t>(EncodedType::kInt32));
+  WriteBytes(&value, sizeof(value));
+}
+
+void StandardCodecBufferWriter::WriteInt64(int64_t value) {
+  WriteType(static_cast<uint8_t>(EncodedType::kInt64));
+  WriteBytes(&value, sizeof(value));
+}
+
+void StandardCodecBufferWriter::WriteDouble(double value) {
+  WriteType(static_cast<uint8_t>(EncodedType::kFloat64));
+  WriteAlignment(8);
+  WriteBytes(&value, sizeof(value));
+}
+
+void StandardCodecBufferWriter::WriteString(std::string_view value) {
+  WriteType(static_cast<uint8_t>(EncodedType::kString));
+  WriteSize(value.size());
+  WriteBytes(value.data(), value.size());
+}
+
+void StandardCodecBufferWriter::WriteUInt8List(const uint8_t* values,
+                                               size_t count) {
+  WriteTypedList(static_cast<uint8_t>(EncodedType::kUInt8List), values, count,
+                 sizeof(uint8_t));
+}
+
+void StandardCodecBufferWriter::WriteInt32List(const int32_t* values,
+                                               size_t count) {
+  WriteTypedList(static_cast<uint8_t>(EncodedType::kInt32List), values, count,
+                 sizeof(int32_t));
+}
+
+void StandardCodecBufferWriter::WriteInt64List(const int64_t* values,
+                                               size_t count) {
+  WriteTypedList(static_cast<uint8_t>(EncodedType::kInt64List), values, count,
+                 sizeof(int64_t));
+}
+
+void StandardCodecBufferWriter::WriteFloat32List(const float* values,
+                                                 size_t count) {
+  WriteTypedList(static_cast<uint8_t>(EncodedType::kFloat32List), values,
+                 count, sizeof(float));
+}
+
+void StandardCodecBufferWriter::WriteFloat64List(const double* values,
+                                                 size_t count) {
+  WriteTypedList(static_cast<uint8_t>(EncodedType::kFloat64List), values,
+                 count, sizeof(double));
+}
+
+void StandardCodecBufferWriter::WriteListHeader(size_t count) {
+  WriteType(static_cast<uint8_t>(EncodedType::kList));
+  WriteSize(count);
+}
+
+void StandardCodecBufferWriter::WriteMapHeader(size_t count) {
+  WriteType(static_cast<uint8_t>(EncodedType::kMap));
+  WriteSize(count);
+}
+
+void StandardCodecBufferWriter::WriteType(uint8_t type) {
+  WriteBytes(&type, 1);
+}
+
+void StandardCodecBufferWriter::WriteSize(size_t size) {
+  if (size < 254) {
+    uint8_t value = static_cast<uint8_t>(size);
+    WriteBytes(&value, 1);
+  } else if (size <= 0xffff) {
+    uint8_t marker = 254;
+    uint16_t value = static_cast<uint16_t>(size);
+    WriteBytes(&marker, 1);
+    WriteBytes(&value, 2);
+  } else {
+    uint8_t marker = 255;
+    uint32_t value = static_cast<uint32_t>(size);
+    WriteBytes(&marker, 1);
+    WriteBytes(&value, 4);
+  }
+}
+
+void StandardCodecBufferWriter::WriteBytes(const void* bytes, size_t length) {
+  if (buffer_ && length > 0 && position_ <= capacity_ &&
+      length <= capacity_ - position_) {
+    std::memcpy(buffer_ + position_, bytes, length);
+  }
+  position_ += length;
+}
+
+void StandardCodecBufferWriter::WriteAlignment(size_t alignment) {
+  size_t mod = position_ % alignment;
+  if (mod) {
+    static constexpr uint8_t kZeros[8] = {};
+    WriteBytes(kZeros, alignment - mod);
+  }
+}
+
+void StandardCodecBufferWriter::WriteTypedList(uint8_t type,
+                                               const void* values,
+                                               size_t count,
+                                               size_t element_size) {
+  WriteType(type);
+  WriteSize(count);
+  // Unlike StandardCodecSerializer, align empty lists too, as the readers of
+  // all platforms expect.
+  if (element_size > 1) {
+    WriteAlignment(element_size);
+  }
+  WriteBytes(values, count * element_size);
+}
+
+StandardCodecBufferReader::StandardCodecBufferReader(const uint8_t* bytes,
+                                                     size_t size)
+    : bytes_(bytes), size_(bytes ? size : 0) {}
+
+StandardCodecBufferReader::~StandardCodecBufferReader() = default;
+
+bool StandardCodecBufferReader::ReadNull() {
+  if (ok_ && location_ < size_ &&
+      bytes_[location_] == static_cast<uint8_t>(EncodedType::kNull)) {
+    location_++;
+    return true;
+  }
+  return false;
+}
+
+bool StandardCodecBufferReader::ReadBool(bool* value) {
+  if (ReadType(static_cast<uint8_t>(EncodedType::kTrue))) {
+    *value = true;
+    return true;
+  }
+  if (ReadType(static_cast<uint8_t>(EncodedType::kFalse))) {
+    *value = false;
+    return true;
+  }
+  return Fail();
+}
+
+bool StandardCodecBufferReader::ReadInt32(int32_t* value) {
+  if (!ReadType(static_cast<uint8_t>(EncodedType::kInt32))) {
+    return Fail();
+  }
+  return ReadBytes(value, sizeof(int32_t));
+}
+
+bool StandardCodecBufferReader::ReadInt64(int64_t* value) {
+  if (ReadType(static_cast<uint8_t>(EncodedType::kInt32))) {
+    int32_t int32_value;
+    if (!ReadBytes(&int32_value, sizeof(int32_t))) {
+      return false;
+    }
+    *value = int32_value;
+    return true;
+  }
+  if (!ReadType(static_cast<uint8_t>(EncodedType::kInt64))) {
+    return Fail();
+  }
+  return ReadBytes(value, sizeof(int64_t));
+}
+
+bool StandardCodecBufferReader::ReadDouble(double* value) {
+  if (!ReadType(static_cast<uint8_t>(EncodedType::kFloat64))) {
+    return Fail();
+  }
+  return ReadAlignment(8) && ReadBytes(value, sizeof(double));
+}
+
+bool StandardCodecBufferReader::ReadString(std::string_view* value) {
+  if (!ReadType(static_cast<uint8_t>(EncodedType::kString)) &&
+      !ReadType(static_cast<uint8_t>(EncodedType::kLargeInt))) {
+    return Fail();
+  }
+  size_t size;
+  if (!ReadSize(&size)) {
+    return false;
+  }
+  const uint8_t* view = ReadView(size);
+  if (!view) {
+    return false;
+  }
+  *value = std::string_view(reinterpret_cast<const char*>(view), size);
+  return true;
+}
+
+bool StandardCodecBufferReader::ReadUInt8List(const uint8_t** values,
+                                              size_t* count) {
+  if (!ReadType(static_cast<uint8_t>(EncodedType::kUInt8List))) {
+    return Fail();
+  }
+  size_t size;
+  if (!ReadSize(&size)) {
+    return false;
+  }
+  const uint8_t* view = ReadView(size);
+  if (!view) {
+    return false;
+  }
+  *values = view;
+  *count = size;
+  return true;
+}
+
+bool StandardCodecBufferReader::ReadInt32List(std::vector<int32_t>* values) {
+  return ReadTypedList(static_cast<uint8_t>(EncodedType::kInt32List), values);
+}
+
+bool StandardCodecBufferReader::ReadInt64List(std::vector<int64_t>* values) {
+  return ReadTypedList(static_cast<uint8_t>(EncodedType::kInt64List), values);
+}
+
+bool StandardCodecBufferReader::ReadFloat32List(std::vector<float>* values) {
+  return ReadTypedList(static_cast<uint8_t>(EncodedType::kFloat32List),
+                       values);
+}
+
+bool StandardCodecBufferReader::ReadFloat64List(std::vector<double>* values) {
+  return ReadTypedList(static_cast<uint8_t>(EncodedType::kFloat64List),
+                       values);
+}
+
+bool StandardCodecBufferReader::ReadListHeader(size_t* count) {
+  if (!ReadType(static_cast<uint8_t>(EncodedType::kList))) {
+    return Fail();
+  }
+  return ReadSize(count);
+}
+
+bool StandardCodecBufferReader::ReadMapHeader(size_t* count) {
+  if (!ReadType(static_cast<uint8_t>(EncodedType::kMap))) {
+    return Fail();
+  }
+  return ReadSize(count);
+}
+
+bool StandardCodecBufferReader::SkipValue() {
+  if (!ok_ || location_ >= size_) {
+    return Fail();
+  }
+  const auto type = static_cast<EncodedType>(bytes_[location_++]);
+  size_t size;
+  switch (type) {
+    case EncodedType::kNull:
+    case EncodedType::kTrue:
+    case EncodedType::kFalse:
+      return true;
+    case EncodedType::kInt32:
+      return ReadView(4) != nullptr;
+    case EncodedType::kInt64:
+      return ReadView(8) != nullptr;
+    case EncodedType::kFloat64:
+      return ReadAlignment(8) && ReadView(8) != nullptr;
+    case EncodedType::kLargeInt:
+    case EncodedType::kString:
+    case EncodedType::kUInt8List:
+      return ReadSize(&size) && ReadView(size) != nullptr;
+    case EncodedType::kInt32List:
+    case EncodedType::kFloat32List:
+      return ReadSize(&size) && ReadAlignment(4) &&
+             ReadView(size * 4) != nullptr;
+    case EncodedType::kInt64List:
+    case EncodedType::kFloat64List:
+      return ReadSize(&size) && ReadAlignment(8) &&
+             ReadView(size * 8) != nullptr;
+    case EncodedType::kList:
+    case EncodedType::kMap: {
+      if (!ReadSize(&size)) {
+        return false;
+      }
+      const size_t value_count = type == EncodedType::kMap ? size * 2 : size;
+      for (size_t i = 0; i < value_count; ++i) {
+        if (!SkipValue()) {
+          return false;
+        }
+      }
+      return true;
+    }
+  }
+  return Fail();
+}
+
+bool StandardCodecBufferReader::ReadType(uint8_t type) {
+  if (!ok_ || location_ >= size_ || bytes_[location_] != type) {
+    return false;
+  }
+  location_++;
+  return true;
+}
+
+bool StandardCodecBufferReader::ReadSize(size_t* size) {
+  uint8_t byte;
+  if (!ReadBytes(&byte, 1)) {
+    return false;
+  }
+  if (byte < 254) {
+    *size = byte;
+    return true;
+  } else if (byte == 254) {
+    uint16_t value;
+    if (!ReadBytes(&value, 2)) {
+      return false;
+    }
+    *size = value;
+    return true;
+  } else {
+    uint32_t value;
+    if (!ReadBytes(&value, 4)) {
+      return false;
+    }
+    *size = value;
+    return true;
+  }
+}
+
+bool StandardCodecBufferReader::ReadBytes(void* buffer, size_t length) {
+  const uint8_t* view = ReadView(length);
+  if (!view) {
+    return false;
+  }
+  std::memcpy(buffer, view, length);
+  return true;
+}
+
+bool StandardCodecBufferReader::ReadAlignment(size_t alignment) {
+  size_t mod = location_ % alignment;
+  return mod == 0 || ReadView(alignment - mod) != nullptr;
+}
+
+const uint8_t* StandardCodecBufferReader::ReadView(size_t length) {
+  if (!ok_ || length > size_ - location_) {
+    Fail();
+    return nullptr;
+  }
+  const uint8_t* view = bytes_ + location_;
+  location_ += length;
+  return view;
+}
+
+template <typename T>
+bool StandardCodecBufferReader::ReadTypedList(uint8_t type,
+                                              std::vector<T>* values) {
+  if (!ReadType(type)) {
+    return Fail();
+  }
+  size_t count;
+  if (!ReadSize(&count) || !ReadAlignment(sizeof(T))) {
+    return false;
+  }
+  if (count > (size_ - location_) / sizeof(T)) {
+    return Fail();
+  }
+  values->resize(count);
+  return count == 0 || ReadBytes(values->data(), count * sizeof(T));
+}
+
+bool StandardCodecBufferReader::Fail() {
+  ok_ = false;
+  return false;
+}
+
 }  // namespace flutter
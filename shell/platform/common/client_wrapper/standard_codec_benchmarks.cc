@@ -0,0 +1,160 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_codec_buffer.h"
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_message_codec.h"
+
+namespace flutter {
+
+namespace {
+
+struct Record {
+  int64_t id;
+  std::string name;
+  double score;
+  bool active;
+};
+
+std::vector<Record> MakeRecords(size_t count) {
+  std::vector<Record> records;
+  records.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    records.push_back({
+        .id = static_cast<int64_t>(i),
+        .name = "record " + std::to_string(i),
+        .score = i * 0.5,
+        .active = i % 2 == 0,
+    });
+  }
+  return records;
+}
+
+EncodableValue ToEncodableValue(const std::vector<Record>& records) {
+  EncodableList list;
+  list.reserve(records.size());
+  for (const auto& record : records) {
+    list.emplace_back(EncodableMap{
+        {EncodableValue("id"), EncodableValue(record.id)},
+        {EncodableValue("name"), EncodableValue(record.name)},
+        {EncodableValue("score"), EncodableValue(record.score)},
+        {EncodableValue("active"), EncodableValue(record.active)},
+    });
+  }
+  return EncodableValue(std::move(list));
+}
+
+void WriteRecords(const std::vector<Record>& records,
+                  StandardCodecBufferWriter& writer) {
+  writer.WriteListHeader(records.size());
+  for (const auto& record : records) {
+    writer.WriteMapHeader(4);
+    writer.WriteString("id");
+    writer.WriteInt(record.id);
+    writer.WriteString("name");
+    writer.WriteString(record.name);
+    writer.WriteString("score");
+    writer.WriteDouble(record.score);
+    writer.WriteString("active");
+    writer.WriteBool(record.active);
+  }
+}
+
+bool ReadRecords(StandardCodecBufferReader& reader,
+                 std::vector<Record>* records) {
+  size_t count;
+  if (!reader.ReadListHeader(&count)) {
+    return false;
+  }
+  records->resize(count);
+  for (auto& record : *records) {
+    size_t field_count;
+    if (!reader.ReadMapHeader(&field_count)) {
+      return false;
+    }
+    for (size_t i = 0; i < field_count; i++) {
+      std::string_view key;
+      std::string_view name;
+      if (!reader.ReadString(&key)) {
+        return false;
+      }
+      if (key == "id") {
+        reader.ReadInt64(&record.id);
+      } else if (key == "name" && reader.ReadString(&name)) {
+        record.name = name;
+      } else if (key == "score") {
+        reader.ReadDouble(&record.score);
+      } else if (key == "active") {
+        reader.ReadBool(&record.active);
+      } else {
+        reader.SkipValue();
+      }
+    }
+  }
+  return reader.ok();
+}
+
+}  // namespace
+
+static void BM_EncodeRecordsWithEncodableValue(benchmark::State& state) {
+  const auto records = MakeRecords(state.range(0));
+  const auto& codec = StandardMessageCodec::GetInstance();
+  for (auto _ : state) {
+    auto message = codec.EncodeMessage(ToEncodableValue(records));
+    benchmark::DoNotOptimize(message);
+  }
+}
+
+static void BM_EncodeRecordsWithBufferWriter(benchmark::State& state) {
+  const auto records = MakeRecords(state.range(0));
+  for (auto _ : state) {
+    StandardCodecBufferWriter sizer;
+    WriteRecords(records, sizer);
+    std::vector<uint8_t> message(sizer.size());
+    StandardCodecBufferWriter writer(message.data(), message.size());
+    WriteRecords(records, writer);
+    benchmark::DoNotOptimize(message);
+  }
+}
+
+static void BM_DecodeRecordsWithEncodableValue(benchmark::State& state) {
+  const auto& codec = StandardMessageCodec::GetInstance();
+  auto message =
+      codec.EncodeMessage(ToEncodableValue(MakeRecords(state.range(0))));
+  for (auto _ : state) {
+    auto value = codec.DecodeMessage(*message);
+    std::vector<Record> records;
+    for (const auto& item : std::get<EncodableList>(*value)) {
+      const auto& map = std::get<EncodableMap>(item);
+      records.push_back({
+          .id = map.at(EncodableValue("id")).LongValue(),
+          .name = std::get<std::string>(map.at(EncodableValue("name"))),
+          .score = std::get<double>(map.at(EncodableValue("score"))),
+          .active = std::get<bool>(map.at(EncodableValue("active"))),
+      });
+    }
+    benchmark::DoNotOptimize(records);
+  }
+}
+
+static void BM_DecodeRecordsWithBufferReader(benchmark::State& state) {
+  auto message = StandardMessageCodec::GetInstance().EncodeMessage(
+      ToEncodableValue(MakeRecords(state.range(0))));
+  std::vector<Record> records;
+  for (auto _ : state) {
+    StandardCodecBufferReader reader(message->data(), message->size());
+    bool ok = ReadRecords(reader, &records);
+    benchmark::DoNotOptimize(ok);
+  }
+}
+
+BENCHMARK(BM_EncodeRecordsWithEncodableValue)->Range(16, 16 << 10);
+BENCHMARK(BM_EncodeRecordsWithBufferWriter)->Range(16, 16 << 10);
+BENCHMARK(BM_DecodeRecordsWithEncodableValue)->Range(16, 16 << 10);
+BENCHMARK(BM_DecodeRecordsWithBufferReader)->Range(16, 16 << 10);
+
+}  // namespace flutter
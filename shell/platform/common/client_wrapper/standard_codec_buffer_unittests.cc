@@ -0,0 +1,146 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_codec_buffer.h"
+
+#include <string>
+#include <vector>
+
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_message_codec.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+
+namespace {
+
+struct Record {
+  int64_t id;
+  std::string name;
+  double score;
+  bool active;
+  std::vector<double> samples;
+};
+
+// Encodes |record| as a list, like a plugin would for a Dart class.
+void WriteRecord(const Record& record, StandardCodecBufferWriter& writer) {
+  writer.WriteListHeader(5);
+  writer.WriteInt(record.id);
+  writer.WriteString(record.name);
+  writer.WriteDouble(record.score);
+  writer.WriteBool(record.active);
+  writer.WriteFloat64List(record.samples.data(), record.samples.size());
+}
+
+bool ReadRecord(StandardCodecBufferReader& reader, Record* record) {
+  size_t count;
+  std::string_view name;
+  if (!reader.ReadListHeader(&count) || count != 5 ||
+      !reader.ReadInt64(&record->id) || !reader.ReadString(&name) ||
+      !reader.ReadDouble(&record->score) || !reader.ReadBool(&record->active) ||
+      !reader.ReadFloat64List(&record->samples)) {
+    return false;
+  }
+  record->name = name;
+  return true;
+}
+
+std::vector<uint8_t> EncodeRecord(const Record& record) {
+  StandardCodecBufferWriter sizer;
+  WriteRecord(record, sizer);
+  std::vector<uint8_t> message(sizer.size());
+  StandardCodecBufferWriter writer(message.data(), message.size());
+  WriteRecord(record, writer);
+  EXPECT_FALSE(writer.overflowed());
+  EXPECT_EQ(writer.size(), message.size());
+  return message;
+}
+
+}  // namespace
+
+TEST(StandardCodecBufferTest, EncodesLikeStandardMessageCodec) {
+  const Record record = {
+      .id = 1ll << 40,
+      .name = "record",
+      .score = 3.5,
+      .active = true,
+      .samples = {1.0, 2.0},
+  };
+  const EncodableValue value(EncodableList{
+      EncodableValue(record.id),
+      EncodableValue(record.name),
+      EncodableValue(record.score),
+      EncodableValue(record.active),
+      EncodableValue(record.samples),
+  });
+
+  auto expected = StandardMessageCodec::GetInstance().EncodeMessage(value);
+  ASSERT_TRUE(expected);
+  EXPECT_EQ(EncodeRecord(record), *expected);
+}
+
+TEST(StandardCodecBufferTest, DecodesStandardMessageCodecMessages) {
+  const EncodableValue value(EncodableList{
+      EncodableValue(7),
+      EncodableValue("name"),
+      EncodableValue(0.25),
+      EncodableValue(false),
+      EncodableValue(std::vector<double>{4.0}),
+  });
+  auto message = StandardMessageCodec::GetInstance().EncodeMessage(value);
+  ASSERT_TRUE(message);
+
+  StandardCodecBufferReader reader(message->data(), message->size());
+  Record record;
+  ASSERT_TRUE(ReadRecord(reader, &record));
+  EXPECT_TRUE(reader.AtEnd());
+  EXPECT_EQ(record.id, 7);
+  EXPECT_EQ(record.name, "name");
+  EXPECT_EQ(record.score, 0.25);
+  EXPECT_FALSE(record.active);
+  EXPECT_EQ(record.samples, std::vector<double>{4.0});
+}
+
+TEST(StandardCodecBufferTest, SkipsValuesAndFailsOnMismatches) {
+  const EncodableValue value(EncodableList{
+      EncodableValue(EncodableMap{
+          {EncodableValue("a"), EncodableValue(std::vector<int32_t>{1, 2})},
+          {EncodableValue("b"), EncodableValue()},
+      }),
+      EncodableValue("after"),
+  });
+  auto message = StandardMessageCodec::GetInstance().EncodeMessage(value);
+  ASSERT_TRUE(message);
+
+  StandardCodecBufferReader reader(message->data(), message->size());
+  size_t count;
+  ASSERT_TRUE(reader.ReadListHeader(&count));
+  EXPECT_EQ(count, 2u);
+  EXPECT_FALSE(reader.ReadNull());
+  EXPECT_TRUE(reader.ok());
+  ASSERT_TRUE(reader.SkipValue());
+  std::string_view after;
+  ASSERT_TRUE(reader.ReadString(&after));
+  EXPECT_EQ(after, "after");
+  EXPECT_TRUE(reader.AtEnd());
+
+  StandardCodecBufferReader mismatched(message->data(), message->size());
+  int32_t number;
+  EXPECT_FALSE(mismatched.ReadInt32(&number));
+  EXPECT_FALSE(mismatched.ok());
+  EXPECT_FALSE(mismatched.ReadListHeader(&count));
+
+  StandardCodecBufferReader truncated(message->data(), message->size() - 1);
+  EXPECT_FALSE(truncated.SkipValue());
+  EXPECT_FALSE(truncated.ok());
+}
+
+TEST(StandardCodecBufferTest, ReportsOverflows) {
+  uint8_t buffer[4];
+  StandardCodecBufferWriter writer(buffer, sizeof(buffer));
+  writer.WriteInt32(1);
+  EXPECT_EQ(writer.size(), 5u);
+  EXPECT_TRUE(writer.overflowed());
+}
+
+}  // namespace flutter
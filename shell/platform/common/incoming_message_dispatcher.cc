@@ -19,6 +19,18 @@ void IncomingMessageDispatcher::HandleMessage(
     const std::function<void(void)>& input_unblock_cb) {
   std::string channel(message.channel);
 
+  auto batch_iterator = batch_channels_.find(channel);
+  if (batch_iterator != batch_channels_.end()) {
+    // The message is only valid for the duration of this call.
+    batch_iterator->second.queue.push_back({
+        .data = std::vector<uint8_t>(message.message,
+                                     message.message + message.message_size),
+        .response_handle = message.response_handle,
+    });
+    ScheduleFlush();
+    return;
+  }
+
   auto callback_iterator = callbacks_.find(channel);
   // Find the handler for the channel; if there isn't one, report the failure.
   if (callback_iterator == callbacks_.end()) {
@@ -44,6 +56,7 @@ void IncomingMessageDispatcher::SetMessageCallback(
     const std::string& channel,
     FlutterDesktopMessageCallback callback,
     void* user_data) {
+  SetBatchMessageCallback(channel, nullptr, nullptr);
   if (!callback) {
     callbacks_.erase(channel);
     return;
@@ -51,6 +64,82 @@ void IncomingMessageDispatcher::SetMessageCallback(
   callbacks_[channel] = std::make_pair(callback, user_data);
 }
 
+void IncomingMessageDispatcher::SetBatchMessageCallback(
+    const std::string& channel,
+    FlutterDesktopMessageBatchCallback callback,
+    void* user_data) {
+  if (callback) {
+    callbacks_.erase(channel);
+    auto& batch_channel = batch_channels_[channel];
+    batch_channel.callback = callback;
+    batch_channel.user_data = user_data;
+    return;
+  }
+  auto batch_iterator = batch_channels_.find(channel);
+  if (batch_iterator == batch_channels_.end()) {
+    return;
+  }
+  auto queue = std::move(batch_iterator->second.queue);
+  batch_channels_.erase(batch_iterator);
+  for (const auto& message : queue) {
+    FlutterDesktopMessengerSendResponse(messenger_, message.response_handle,
+                                        nullptr, 0);
+  }
+}
+
+void IncomingMessageDispatcher::SetFlushScheduler(
+    std::function<void(std::function<void(void)>)> scheduler) {
+  flush_scheduler_ = std::move(scheduler);
+}
+
+void IncomingMessageDispatcher::FlushMessageBatches() {
+  is_flush_scheduled_ = false;
+
+  // Callbacks may change the registered channels, so look every channel up
+  // again before delivering its batch.
+  std::vector<std::string> channels;
+  for (const auto& [channel, batch_channel] : batch_channels_) {
+    if (!batch_channel.queue.empty()) {
+      channels.push_back(channel);
+    }
+  }
+  std::vector<FlutterDesktopMessage> messages;
+  for (const auto& channel : channels) {
+    auto batch_iterator = batch_channels_.find(channel);
+    if (batch_iterator == batch_channels_.end()) {
+      continue;
+    }
+    auto queue = std::move(batch_iterator->second.queue);
+    batch_iterator->second.queue.clear();
+    messages.clear();
+    messages.reserve(queue.size());
+    for (const auto& queued : queue) {
+      messages.push_back({
+          .struct_size = sizeof(FlutterDesktopMessage),
+          .channel = channel.c_str(),
+          .message = queued.data.data(),
+          .message_size = queued.data.size(),
+          .response_handle = queued.response_handle,
+      });
+    }
+    batch_iterator->second.callback(messenger_, messages.data(),
+                                    messages.size(),
+                                    batch_iterator->second.user_data);
+  }
+}
+
+void IncomingMessageDispatcher::ScheduleFlush() {
+  if (!flush_scheduler_) {
+    FlushMessageBatches();
+    return;
+  }
+  if (is_flush_scheduled_) {
+    return;
+  }
+  is_flush_scheduled_ = true;
+  flush_scheduler_([this] { FlushMessageBatches(); });
+}
+
 void IncomingMessageDispatcher::EnableInputBlockingForChannel(
     const std::string& channel) {
   input_blocking_channels_.insert(channel);
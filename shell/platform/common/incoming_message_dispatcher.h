@@ -10,6 +10,7 @@
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "flutter/shell/platform/common/public/flutter_messenger.h"
 
@@ -35,6 +36,10 @@ class IncomingMessageDispatcher {
   // If input blocking has been enabled on that channel, wraps the call to the
   // handler with calls to the given callbacks to block and then unblock input.
   //
+  // If a batch callback is registered for the message's channel, queues a
+  // copy of the message for the next call to FlushMessageBatches instead, and
+  // schedules that call. Input blocking doesn't apply to these channels.
+  //
   // If no handler is registered for the message's channel, sends a
   // NotImplemented response to the engine.
   void HandleMessage(
@@ -52,6 +57,29 @@ class IncomingMessageDispatcher {
                           FlutterDesktopMessageCallback callback,
                           void* user_data);
 
+  // Registers a callback for incoming messages from the Flutter side on the
+  // specified channel that is called with all messages queued for the channel
+  // by HandleMessage when FlushMessageBatches is called.
+  //
+  // Replaces any existing callback. Pass a null callback to unregister the
+  // existing callback, which responds to the queued messages of the channel
+  // with empty responses.
+  void SetBatchMessageCallback(const std::string& channel,
+                               FlutterDesktopMessageBatchCallback callback,
+                               void* user_data);
+
+  // Sets the function that schedules a call to FlushMessageBatches, typically
+  // by posting it as a task. |scheduler| is not called again until the
+  // scheduled flush has run, so messages that arrive in the meantime are
+  // delivered in the same batch.
+  //
+  // Without a scheduler, queued messages are flushed right away.
+  void SetFlushScheduler(
+      std::function<void(std::function<void(void)>)> scheduler);
+
+  // Calls the batch callback of every channel with queued messages.
+  void FlushMessageBatches();
+
   // Enables input blocking on the given channel name.
   //
   // If set, then the parent window should disable input callbacks
@@ -71,6 +99,29 @@ class IncomingMessageDispatcher {
   // Channel names for which input blocking should be enabled during the call to
   // that channel's handler.
   std::set<std::string> input_blocking_channels_;
+
+  // A message copied from the engine to be delivered in a batch.
+  struct QueuedMessage {
+    std::vector<uint8_t> data;
+    const FlutterDesktopMessageResponseHandle* response_handle;
+  };
+
+  struct BatchChannel {
+    FlutterDesktopMessageBatchCallback callback;
+    void* user_data;
+    std::vector<QueuedMessage> queue;
+  };
+
+  // A map from channel names to the batch callbacks and queued messages of
+  // channels registered with SetBatchMessageCallback.
+  std::map<std::string, BatchChannel> batch_channels_;
+
+  std::function<void(std::function<void(void)>)> flush_scheduler_;
+
+  // Whether a call to FlushMessageBatches has been scheduled and not run yet.
+  bool is_flush_scheduled_ = false;
+
+  void ScheduleFlush();
 };
 
 }  // namespace flutter
@@ -4,6 +4,9 @@
 
 #include "flutter/shell/platform/common/incoming_message_dispatcher.h"
 
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 namespace flutter {
@@ -88,4 +91,95 @@ TEST(IncomingMessageDispatcher, BlockInputTrue) {
   EXPECT_EQ(did_call[2], 2);
 }
 
+TEST(IncomingMessageDispatcher, BatchesScheduledMessages) {
+  FlutterDesktopMessengerRef messenger =
+      reinterpret_cast<FlutterDesktopMessengerRef>(0xfeedface);
+  auto dispatcher = std::make_unique<IncomingMessageDispatcher>(messenger);
+  std::vector<std::function<void(void)>> scheduled;
+  dispatcher->SetFlushScheduler([&scheduled](std::function<void(void)> flush) {
+    scheduled.push_back(std::move(flush));
+  });
+  std::vector<std::vector<std::string>> batches;
+  dispatcher->SetBatchMessageCallback(
+      "hello",
+      [](FlutterDesktopMessengerRef messenger,
+         const FlutterDesktopMessage* messages, size_t message_count,
+         void* user_data) {
+        EXPECT_EQ(messenger,
+                  reinterpret_cast<FlutterDesktopMessengerRef>(0xfeedface));
+        std::vector<std::string> batch;
+        for (size_t i = 0; i < message_count; i++) {
+          EXPECT_STREQ(messages[i].channel, "hello");
+          batch.emplace_back(reinterpret_cast<const char*>(messages[i].message),
+                             messages[i].message_size);
+        }
+        reinterpret_cast<std::vector<std::vector<std::string>>*>(user_data)
+            ->push_back(std::move(batch));
+      },
+      &batches);
+
+  for (std::string data : {"a", "bc", "def"}) {
+    FlutterDesktopMessage message = {
+        .struct_size = sizeof(FlutterDesktopMessage),
+        .channel = "hello",
+        .message = reinterpret_cast<const uint8_t*>(data.data()),
+        .message_size = data.size(),
+        .response_handle = nullptr,
+    };
+    dispatcher->HandleMessage(message);
+    // The dispatcher must have copied the message.
+    data.assign(data.size(), 'x');
+  }
+  EXPECT_TRUE(batches.empty());
+  ASSERT_EQ(scheduled.size(), 1u);
+
+  scheduled[0]();
+  ASSERT_EQ(batches.size(), 1u);
+  EXPECT_EQ(batches[0], (std::vector<std::string>{"a", "bc", "def"}));
+
+  // Messages after a flush schedule another one.
+  FlutterDesktopMessage message = {
+      .struct_size = sizeof(FlutterDesktopMessage),
+      .channel = "hello",
+      .message = nullptr,
+      .message_size = 0,
+      .response_handle = nullptr,
+  };
+  dispatcher->HandleMessage(message);
+  ASSERT_EQ(scheduled.size(), 2u);
+  scheduled[1]();
+  ASSERT_EQ(batches.size(), 2u);
+  EXPECT_EQ(batches[1], (std::vector<std::string>{""}));
+}
+
+TEST(IncomingMessageDispatcher, SetMessageCallbackReplacesBatchCallback) {
+  FlutterDesktopMessengerRef messenger = nullptr;
+  auto dispatcher = std::make_unique<IncomingMessageDispatcher>(messenger);
+  int batch_calls = 0;
+  bool did_call = false;
+  dispatcher->SetBatchMessageCallback(
+      "hello",
+      [](FlutterDesktopMessengerRef messenger,
+         const FlutterDesktopMessage* messages, size_t message_count,
+         void* user_data) { (*reinterpret_cast<int*>(user_data))++; },
+      &batch_calls);
+  dispatcher->SetMessageCallback(
+      "hello",
+      [](FlutterDesktopMessengerRef messenger,
+         const FlutterDesktopMessage* message,
+         void* user_data) { *reinterpret_cast<bool*>(user_data) = true; },
+      &did_call);
+  FlutterDesktopMessage message = {
+      .struct_size = sizeof(FlutterDesktopMessage),
+      .channel = "hello",
+      .message = nullptr,
+      .message_size = 0,
+      .response_handle = nullptr,
+  };
+  dispatcher->HandleMessage(message);
+  dispatcher->FlushMessageBatches();
+  EXPECT_TRUE(did_call);
+  EXPECT_EQ(batch_calls, 0);
+}
+
 }  // namespace flutter
@@ -51,6 +51,18 @@ typedef void (*FlutterDesktopMessageCallback)(
     const FlutterDesktopMessage* /* message*/,
     void* /* user data */);
 
+// Function pointer type for batched message handler callback registration.
+//
+// |messages| holds |message_count| messages received on the channel, in the
+// order they were received. The messages are only valid for the duration of
+// the call. The user data will be whatever was passed to
+// FlutterDesktopMessengerSetBatchCallback for the channel.
+typedef void (*FlutterDesktopMessageBatchCallback)(
+    FlutterDesktopMessengerRef /* messenger */,
+    const FlutterDesktopMessage* /* messages */,
+    size_t /* message_count */,
+    void* /* user data */);
+
 // Sends a binary message to the Flutter side on the specified channel.
 FLUTTER_EXPORT bool FlutterDesktopMessengerSend(
     FlutterDesktopMessengerRef messenger,
@@ -90,6 +102,25 @@ FLUTTER_EXPORT void FlutterDesktopMessengerSetCallback(
     FlutterDesktopMessageCallback callback,
     void* user_data);
 
+// Registers a callback function for incoming binary messages from the Flutter
+// side on the specified channel that is called with all messages received on
+// the channel since the last call, instead of once per message.
+//
+// This reduces the overhead of channels that receive many messages in short
+// bursts, like sensor channels. Messages received while the callback is
+// registered are delivered in a later task on the platform thread.
+//
+// Replaces any existing callback, batched or not. Provide a null handler to
+// unregister the existing callback, which responds to the messages that have
+// not been delivered yet with empty responses.
+//
+// If |user_data| is provided, it will be passed in |callback| calls.
+FLUTTER_EXPORT void FlutterDesktopMessengerSetBatchCallback(
+    FlutterDesktopMessengerRef messenger,
+    const char* channel,
+    FlutterDesktopMessageBatchCallback callback,
+    void* user_data);
+
 // Increments the reference count for the |messenger|.
 //
 // Operation is thread-safe.
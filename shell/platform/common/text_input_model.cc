@@ -32,6 +32,7 @@ bool TextInputModel::SetText(const std::string& text,
                              const TextRange& selection,
                              const TextRange& composing_range) {
   text_ = fml::Utf8ToUtf16(text);
+  text_utf8_ = text;
   if (!text_range().Contains(selection) ||
       !text_range().Contains(composing_range)) {
     return false;
@@ -75,7 +76,7 @@ void TextInputModel::UpdateComposingText(const std::u16string& text) {
     return;
   }
   DeleteSelected();
-  text_.replace(composing_range_.start(), composing_range_.length(), text);
+  ReplaceText(composing_range_.start(), composing_range_.length(), text);
   composing_range_.set_end(composing_range_.start() + text.length());
   selection_ = TextRange(composing_range_.end());
 }
@@ -98,12 +99,19 @@ void TextInputModel::EndComposing() {
   composing_range_ = TextRange(0);
 }
 
+void TextInputModel::ReplaceText(size_t start,
+                                 size_t length,
+                                 const std::u16string& text) {
+  text_.replace(start, length, text);
+  text_utf8_.reset();
+}
+
 bool TextInputModel::DeleteSelected() {
   if (selection_.collapsed()) {
     return false;
   }
   size_t start = selection_.start();
-  text_.erase(start, selection_.length());
+  ReplaceText(start, selection_.length(), u"");
   selection_ = TextRange(start);
   if (composing_) {
     // This occurs only immediately after composing has begun with a selection.
@@ -130,12 +138,12 @@ void TextInputModel::AddText(const std::u16string& text) {
   DeleteSelected();
   if (composing_) {
     // Delete the current composing text, set the cursor to composing start.
-    text_.erase(composing_range_.start(), composing_range_.length());
+    ReplaceText(composing_range_.start(), composing_range_.length(), u"");
     selection_ = TextRange(composing_range_.start());
     composing_range_.set_end(composing_range_.start() + text.length());
   }
   size_t position = selection_.position();
-  text_.insert(position, text);
+  ReplaceText(position, 0, text);
   selection_ = TextRange(position + text.length());
 }
 
@@ -151,7 +159,7 @@ bool TextInputModel::Backspace() {
   size_t position = selection_.position();
   if (position != editable_range().start()) {
     int count = IsTrailingSurrogate(text_.at(position - 1)) ? 2 : 1;
-    text_.erase(position - count, count);
+    ReplaceText(position - count, count, u"");
     selection_ = TextRange(position - count);
     if (composing_) {
       composing_range_.set_end(composing_range_.end() - count);
@@ -169,7 +177,7 @@ bool TextInputModel::Delete() {
   size_t position = selection_.position();
   if (position < editable_range().end()) {
     int count = IsLeadingSurrogate(text_.at(position)) ? 2 : 1;
-    text_.erase(position, count);
+    ReplaceText(position, count, u"");
     if (composing_) {
       composing_range_.set_end(composing_range_.end() - count);
     }
@@ -207,7 +215,7 @@ bool TextInputModel::DeleteSurrounding(int offset_from_cursor, int count) {
   }
 
   auto deleted_length = end - start;
-  text_.erase(start, deleted_length);
+  ReplaceText(start, deleted_length, u"");
 
   // Cursor moves only if deleted area is before it.
   selection_ = TextRange(offset_from_cursor <= 0 ? start : selection_.start());
@@ -287,15 +295,37 @@ bool TextInputModel::MoveCursorBack() {
   return false;
 }
 
-std::string TextInputModel::GetText() const {
-  return fml::Utf16ToUtf8(text_);
+const std::string& TextInputModel::GetText() const {
+  if (!text_utf8_.has_value()) {
+    text_utf8_ = fml::Utf16ToUtf8(text_);
+  }
+  return text_utf8_.value();
 }
 
 int TextInputModel::GetCursorOffset() const {
-  // Measure the length of the current text up to the selection extent.
-  // There is probably a much more efficient way of doing this.
-  auto leading_text = text_.substr(0, selection_.extent());
-  return fml::Utf16ToUtf8(leading_text).size();
+  // Measure the UTF-8 length of the current text up to the selection extent,
+  // without converting it.
+  size_t extent = selection_.extent();
+  if (extent == text_.length()) {
+    return GetText().size();
+  }
+  int offset = 0;
+  for (size_t i = 0; i < extent; i++) {
+    char16_t code_unit = text_[i];
+    if (code_unit < 0x80) {
+      offset += 1;
+    } else if (code_unit < 0x800) {
+      offset += 2;
+    } else if (IsLeadingSurrogate(code_unit) && i + 1 < extent &&
+               IsTrailingSurrogate(text_[i + 1])) {
+      // A surrogate pair encodes a single 4 byte code point.
+      offset += 4;
+      i++;
+    } else {
+      offset += 3;
+    }
+  }
+  return offset;
 }
 
 }  // namespace flutter
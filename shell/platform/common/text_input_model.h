@@ -6,6 +6,7 @@
 #define FLUTTER_SHELL_PLATFORM_COMMON_TEXT_INPUT_MODEL_H_
 
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "flutter/shell/platform/common/text_range.h"
@@ -183,7 +184,13 @@ class TextInputModel {
   bool SelectToEnd();
 
   // Gets the current text as UTF-8.
-  std::string GetText() const;
+  //
+  // The UTF-8 text is cached until the text is next changed, so repeated calls
+  // do not convert the whole text again.
+  const std::string& GetText() const;
+
+  // Gets the current text as UTF-16.
+  const std::u16string& GetTextUtf16() const { return text_; }
 
   // Gets the cursor position as a byte offset in UTF-8 string returned from
   // GetText().
@@ -210,6 +217,12 @@ class TextInputModel {
   // reset to the start of the selected range.
   bool DeleteSelected();
 
+  // Replaces |length| UTF-16 code units at |start| with |text|.
+  //
+  // All changes to |text_| must go through this method, which invalidates
+  // |text_utf8_|.
+  void ReplaceText(size_t start, size_t length, const std::u16string& text);
+
   // Returns the currently editable text range.
   //
   // In composing mode, returns the composing range; otherwise, returns a range
@@ -219,6 +232,8 @@ class TextInputModel {
   }
 
   std::u16string text_;
+  // |text_| as UTF-8, if it has been computed since |text_| last changed.
+  mutable std::optional<std::string> text_utf8_;
   TextRange selection_ = TextRange(0);
   TextRange composing_range_ = TextRange(0);
   bool composing_ = false;
@@ -5,8 +5,10 @@
 #import "flutter/shell/platform/darwin/graphics/FlutterDarwinContextMetalImpeller.h"
 
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
 #include "flutter/impeller/renderer/backend/metal/context_mtl.h"
+#include "flutter/impeller/renderer/backend/metal/pipeline_library_mtl.h"
 #include "flutter/shell/common/context_options.h"
 #import "flutter/shell/platform/darwin/common/framework/Headers/FlutterMacros.h"
 #include "impeller/entity/mtl/entity_shaders.h"
@@ -41,6 +43,17 @@ static std::shared_ptr<impeller::ContextMTL> CreateImpellerContext(
   }
   FML_LOG(ERROR) << "Using the Impeller rendering backend.";
 
+#if FML_OS_IOS
+  // Keep the compiled pipelines around so that later launches don't have to
+  // compile them again. The caches directory is private to the app on iOS.
+  NSArray<NSURL*>* caches = [[NSFileManager defaultManager] URLsForDirectory:NSCachesDirectory
+                                                                   inDomains:NSUserDomainMask];
+  if (caches.count > 0u && context->GetPipelineLibrary()) {
+    impeller::PipelineLibraryMTL::Cast(*context->GetPipelineLibrary())
+        .OpenBinaryArchive([caches[0] URLByAppendingPathComponent:@"flutter.impeller.mtlarchive"]);
+  }
+#endif  // FML_OS_IOS
+
   return context;
 }
 
@@ -10,6 +10,7 @@
 #include <string>
 
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/display_list/geometry/dl_region.h"
 #include "flutter/fml/platform/darwin/scoped_nsobject.h"
 #import "flutter/shell/platform/darwin/common/framework/Headers/FlutterChannels.h"
 #import "flutter/shell/platform/darwin/ios/framework/Source/FlutterOverlayView.h"
@@ -691,57 +692,58 @@ bool FlutterPlatformViewsController::SubmitFrame(GrDirectContext* gr_context,
 
     // Check if the current picture contains overlays that intersect with the
     // current platform view or any of the previous platform views.
+    //
+    // The picture is above all of these platform views, so its overlays are all placed above the
+    // current platform view. This shares the overlays between the platform views instead of
+    // allocating overlays for each of them, as each overlay has its own full screen surface.
+    std::vector<SkIRect> intersection_rects;
     for (size_t j = i + 1; j > 0; j--) {
       int64_t current_platform_view_id = composition_order_[j - 1];
       SkRect platform_view_rect = GetPlatformViewRect(current_platform_view_id);
-      std::list<SkRect> intersection_rects =
-          slice->searchNonOverlappingDrawnRects(platform_view_rect);
-      auto allocation_size = intersection_rects.size();
-
-      // For testing purposes, the overlay id is used to find the overlay view.
-      // This is the index of the layer for the current platform view.
-      auto overlay_id = platform_view_layers[current_platform_view_id].size();
-
-      // If the max number of allocations per platform view is exceeded,
-      // then join all the rects into a single one.
-      //
-      // TODO(egarciad): Consider making this configurable.
-      // https://github.com/flutter/flutter/issues/52510
-      if (allocation_size > kMaxLayerAllocations) {
-        SkRect joined_rect = SkRect::MakeEmpty();
-        for (const SkRect& rect : intersection_rects) {
-          joined_rect.join(rect);
-        }
-        // Replace the rects in the intersection rects list for a single rect that is
-        // the union of all the rects in the list.
-        intersection_rects.clear();
-        intersection_rects.push_back(joined_rect);
-      }
-      for (SkRect& joined_rect : intersection_rects) {
+      for (SkRect rect : slice->searchNonOverlappingDrawnRects(platform_view_rect)) {
         // Get the intersection rect between the current rect
         // and the platform view rect.
-        joined_rect.intersect(platform_view_rect);
+        if (!rect.intersect(platform_view_rect)) {
+          continue;
+        }
         // Subpixels in the platform may not align with the canvas subpixels.
         // To workaround it, round the floating point bounds and make the rect slightly larger.
         // For example, {0.3, 0.5, 3.1, 4.7} becomes {0, 0, 4, 5}.
-        joined_rect.setLTRB(std::floor(joined_rect.left()), std::floor(joined_rect.top()),
-                            std::ceil(joined_rect.right()), std::ceil(joined_rect.bottom()));
-        // Clip the background canvas, so it doesn't contain any of the pixels drawn
-        // on the overlay layer.
-        background_canvas->ClipRect(joined_rect, DlCanvas::ClipOp::kDifference);
-        // Get a new host layer.
-        std::shared_ptr<FlutterPlatformViewLayer> layer = GetLayer(gr_context,                //
-                                                                   ios_context,               //
-                                                                   slice,                     //
-                                                                   joined_rect,               //
-                                                                   current_platform_view_id,  //
-                                                                   overlay_id                 //
-        );
-        did_submit &= layer->did_submit_last_frame;
-        platform_view_layers[current_platform_view_id].push_back(layer);
-        overlay_id++;
+        intersection_rects.push_back(rect.roundOut());
       }
     }
+    DlRegion overlay_region(intersection_rects);
+    std::vector<SkIRect> overlay_rects = overlay_region.getRects();
+
+    // If the max number of allocations per picture is exceeded,
+    // then join all the rects into a single one.
+    //
+    // TODO(egarciad): Consider making this configurable.
+    // https://github.com/flutter/flutter/issues/52510
+    if (overlay_rects.size() > kMaxLayerAllocations) {
+      overlay_rects = {overlay_region.bounds()};
+    }
+
+    // For testing purposes, the overlay id is used to find the overlay view.
+    // This is the index of the layer for the current platform view.
+    int64_t overlay_id = 0;
+    for (const SkIRect& overlay_rect : overlay_rects) {
+      SkRect joined_rect = SkRect::Make(overlay_rect);
+      // Clip the background canvas, so it doesn't contain any of the pixels drawn
+      // on the overlay layer.
+      background_canvas->ClipRect(joined_rect, DlCanvas::ClipOp::kDifference);
+      // Get a new host layer.
+      std::shared_ptr<FlutterPlatformViewLayer> layer = GetLayer(gr_context,        //
+                                                                 ios_context,       //
+                                                                 slice,             //
+                                                                 joined_rect,       //
+                                                                 platform_view_id,  //
+                                                                 overlay_id         //
+      );
+      did_submit &= layer->did_submit_last_frame;
+      platform_view_layers[platform_view_id].push_back(layer);
+      overlay_id++;
+    }
     slice->render_into(background_canvas);
   }
 
@@ -10,6 +10,7 @@
 
 #include "unicode/uchar.h"
 
+#include "flutter/fml/icu_util.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/platform/darwin/string_range_sanitization.h"
 
@@ -91,6 +92,7 @@ static BOOL IsEmoji(NSString* text, NSRange charRange) {
                              options:kNilOptions
                                range:charRange
                       remainingRange:NULL];
+  fml::icu::EnsureICUInitialized();
   return gotCodePoint && u_hasBinaryProperty(codePoint, UCHAR_EMOJI);
 }
 
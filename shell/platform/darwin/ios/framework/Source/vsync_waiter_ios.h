@@ -60,6 +60,15 @@
 
 - (void)setMaxRefreshRate:(double)refreshRate;
 
+//------------------------------------------------------------------------------
+/// @brief      Sets the refresh rate the display link prefers within the range set by
+///             `setMaxRefreshRate:`, allowing the display to run slower when the content does
+///             not need to update at the maximum rate.
+///
+/// @param refreshRate The preferred refresh rate, or zero to prefer the maximum refresh rate.
+///
+- (void)setPreferredRefreshRate:(double)refreshRate;
+
 @end
 
 namespace flutter {
@@ -73,6 +82,9 @@ class VsyncWaiterIOS final : public VsyncWaiter, public VariableRefreshRateRepor
   // |VariableRefreshRateReporter|
   double GetRefreshRate() const override;
 
+  // |VsyncWaiter|
+  void SetPreferredFrameRate(double frames_per_second) override;
+
   // Made public for testing.
   fml::scoped_nsobject<VSyncClient> GetVsyncClient() const;
 
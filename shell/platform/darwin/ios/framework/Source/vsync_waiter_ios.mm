@@ -67,6 +67,11 @@ double VsyncWaiterIOS::GetRefreshRate() const {
   return [client_.get() getRefreshRate];
 }
 
+// |VsyncWaiter|
+void VsyncWaiterIOS::SetPreferredFrameRate(double frames_per_second) {
+  [client_.get() setPreferredRefreshRate:frames_per_second];
+}
+
 fml::scoped_nsobject<VSyncClient> VsyncWaiterIOS::GetVsyncClient() const {
   return client_;
 }
@@ -77,6 +82,8 @@ fml::scoped_nsobject<VSyncClient> VsyncWaiterIOS::GetVsyncClient() const {
   flutter::VsyncWaiter::Callback callback_;
   fml::scoped_nsobject<CADisplayLink> display_link_;
   double current_refresh_rate_;
+  double max_refresh_rate_;
+  double preferred_refresh_rate_;
 }
 
 - (instancetype)initWithTaskRunner:(fml::RefPtr<fml::TaskRunner>)task_runner
@@ -105,16 +112,35 @@ fml::scoped_nsobject<VSyncClient> VsyncWaiterIOS::GetVsyncClient() const {
 }
 
 - (void)setMaxRefreshRate:(double)refreshRate {
+  max_refresh_rate_ = refreshRate;
+  [self updateFrameRateRange];
+}
+
+- (void)setPreferredRefreshRate:(double)refreshRate {
+  if (fabs(refreshRate - preferred_refresh_rate_) <= kRefreshRateDiffToIgnore) {
+    return;
+  }
+  preferred_refresh_rate_ = refreshRate;
+  [self updateFrameRateRange];
+}
+
+- (void)updateFrameRateRange {
   if (!DisplayLinkManager.maxRefreshRateEnabledOnIPhone) {
     return;
   }
-  double maxFrameRate = fmax(refreshRate, 60);
+  double maxFrameRate = fmax(max_refresh_rate_, 60);
   double minFrameRate = fmax(maxFrameRate / 2, 60);
+  double preferredFrameRate = maxFrameRate;
+  // Content that only needs to update slowly lets the display drop below the default minimum.
+  if (preferred_refresh_rate_ > 0) {
+    preferredFrameRate = fmin(preferred_refresh_rate_, maxFrameRate);
+    minFrameRate = fmin(minFrameRate, preferredFrameRate);
+  }
   if (@available(iOS 15.0, *)) {
     display_link_.get().preferredFrameRateRange =
-        CAFrameRateRangeMake(minFrameRate, maxFrameRate, maxFrameRate);
+        CAFrameRateRangeMake(minFrameRate, maxFrameRate, preferredFrameRate);
   } else {
-    display_link_.get().preferredFramesPerSecond = maxFrameRate;
+    display_link_.get().preferredFramesPerSecond = preferredFrameRate;
   }
 }
 
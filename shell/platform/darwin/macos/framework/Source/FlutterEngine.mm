@@ -5,6 +5,8 @@
 #import "flutter/shell/platform/darwin/macos/framework/Headers/FlutterEngine.h"
 #import "flutter/shell/platform/darwin/macos/framework/Source/FlutterEngine_Internal.h"
 
+#import <QuartzCore/QuartzCore.h>
+
 #include <algorithm>
 #include <iostream>
 #include <vector>
@@ -22,6 +24,7 @@
 #import "flutter/shell/platform/darwin/macos/framework/Source/FlutterMouseCursorPlugin.h"
 #import "flutter/shell/platform/darwin/macos/framework/Source/FlutterPlatformViewController.h"
 #import "flutter/shell/platform/darwin/macos/framework/Source/FlutterRenderer.h"
+#import "flutter/shell/platform/darwin/macos/framework/Source/FlutterVSyncWaiter.h"
 #import "flutter/shell/platform/darwin/macos/framework/Source/FlutterViewController_Internal.h"
 #import "flutter/shell/platform/darwin/macos/framework/Source/FlutterViewEngineProvider.h"
 
@@ -133,6 +136,22 @@ constexpr char kTextPlainFormat[] = "text/plain";
  */
 - (void)sendUserLocales;
 
+/**
+ * Called by the engine when it needs a vsync. Returns the baton at the next vsync of the display
+ * of the implicit view.
+ */
+- (void)onVSync:(uintptr_t)baton;
+
+/**
+ * Creates the vsync waiter once the engine is initialized.
+ */
+- (void)setUpVSyncWaiter;
+
+/**
+ * Returns the display the implicit view is on, or the main display.
+ */
+- (CGDirectDisplayID)displayIDForVSync;
+
 /**
  * Handles a platform message from the engine.
  */
@@ -430,6 +449,10 @@ static void OnPlatformMessage(const FlutterPlatformMessage* message, FlutterEngi
 
   FlutterThreadSynchronizer* _threadSynchronizer;
 
+  // Paces frames with the refresh of the display of the implicit view. Nil until the engine is
+  // initialized, or if no display link could be created.
+  FlutterVSyncWaiter* _vsyncWaiter;
+
   // The next available view ID.
   int _nextViewId;
 
@@ -620,6 +643,11 @@ static void OnPlatformMessage(const FlutterPlatformMessage* message, FlutterEngi
     [engine engineCallbackOnPreEngineRestart];
   };
 
+  flutterArguments.vsync_callback = [](void* user_data, intptr_t baton) {
+    FlutterEngine* engine = (__bridge FlutterEngine*)user_data;
+    [engine onVSync:baton];
+  };
+
   FlutterRendererConfig rendererConfig = [_renderer createRendererConfig];
   FlutterEngineResult result = _embedderAPI.Initialize(
       FLUTTER_ENGINE_VERSION, &rendererConfig, &flutterArguments, (__bridge void*)(self), &_engine);
@@ -628,6 +656,8 @@ static void OnPlatformMessage(const FlutterPlatformMessage* message, FlutterEngi
     return NO;
   }
 
+  [self setUpVSyncWaiter];
+
   result = _embedderAPI.RunInitialized(_engine);
   if (result != kSuccess) {
     NSLog(@"Failed to run an initialized engine: error %d", result);
@@ -805,11 +835,51 @@ static void OnPlatformMessage(const FlutterPlatformMessage* message, FlutterEngi
   [self updateDisplayConfig];
 }
 
+- (void)setUpVSyncWaiter {
+  // The block is called on the display link thread, and may be called while the platform thread
+  // is blocked during a resize. The engine posts the vsync to the UI thread itself.
+  FlutterEngineProcTable embedderAPI = _embedderAPI;
+  FLUTTER_API_SYMBOL(FlutterEngine) engine = _engine;
+  _vsyncWaiter = [[FlutterVSyncWaiter alloc]
+      initWithDisplayID:[self displayIDForVSync]
+                  block:^(CFTimeInterval timestamp, CFTimeInterval targetTimestamp,
+                          uintptr_t baton) {
+                    // Convert from the time base of CACurrentMediaTime to the engine clock.
+                    uint64_t now = embedderAPI.GetCurrentTime();
+                    CFTimeInterval offset = now / 1e9 - CACurrentMediaTime();
+                    embedderAPI.OnVsync(engine, baton,
+                                        static_cast<uint64_t>((timestamp + offset) * 1e9),
+                                        static_cast<uint64_t>((targetTimestamp + offset) * 1e9));
+                  }];
+}
+
+- (void)onVSync:(uintptr_t)baton {
+  if (_vsyncWaiter == nil) {
+    // Without a display link, let the frame start right away.
+    uint64_t now = _embedderAPI.GetCurrentTime();
+    _embedderAPI.OnVsync(_engine, baton, now, now + 1000000000 / 60);
+    return;
+  }
+  [_vsyncWaiter waitForVSync:baton];
+}
+
+- (CGDirectDisplayID)displayIDForVSync {
+  FlutterViewController* controller = [self viewControllerForId:kFlutterImplicitViewId];
+  NSScreen* screen = controller.viewLoaded ? controller.view.window.screen : nil;
+  if (screen == nil) {
+    return CGMainDisplayID();
+  }
+  return static_cast<CGDirectDisplayID>(
+      [screen.deviceDescription[@"NSScreenNumber"] integerValue]);
+}
+
 - (void)updateDisplayConfig {
   if (!_engine) {
     return;
   }
 
+  [_vsyncWaiter setDisplayID:[self displayIDForVSync]];
+
   std::vector<FlutterEngineDisplay> displays;
   for (NSScreen* screen : [NSScreen screens]) {
     CGDirectDisplayID displayID =
@@ -1021,6 +1091,10 @@ static void OnPlatformMessage(const FlutterPlatformMessage* message, FlutterEngi
   [_threadSynchronizer shutdown];
   _threadSynchronizer = nil;
 
+  // Returns the baton of a pending vsync, which the engine needs before it shuts down.
+  [_vsyncWaiter invalidate];
+  _vsyncWaiter = nil;
+
   FlutterEngineResult result = _embedderAPI.Deinitialize(_engine);
   if (result != kSuccess) {
     NSLog(@"Could not de-initialize the Flutter engine: error %d", result);
@@ -1108,6 +1182,8 @@ static void OnPlatformMessage(const FlutterPlatformMessage* message, FlutterEngi
   while ((nextViewController = [viewControllerEnumerator nextObject])) {
     [self updateWindowMetricsForViewController:nextViewController];
   }
+  // Follow the refresh of the screen the implicit view moved to.
+  [_vsyncWaiter setDisplayID:[self displayIDForVSync]];
 }
 
 - (void)onAccessibilityStatusChanged:(NSNotification*)notification {
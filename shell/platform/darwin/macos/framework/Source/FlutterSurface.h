@@ -26,8 +26,26 @@
 
 - (nonnull instancetype)initWithSize:(CGSize)size device:(nonnull id<MTLDevice>)device;
 
+/**
+ * Returns the size class of surfaces of the given size. Surfaces of the same size class share the
+ * dimensions of their IOSurface, and a surface can be resized to any size of its size class without
+ * allocating a new IOSurface.
+ */
++ (CGSize)sizeClassForSize:(CGSize)size;
+
+/**
+ * Resizes the surface to a size of its size class. This replaces the Metal texture of the surface,
+ * so it must not be called while the surface is borrowed by the engine.
+ */
+- (void)resizeToSize:(CGSize)size;
+
 @property(readonly, nonatomic, nonnull) IOSurfaceRef ioSurface;
 @property(readonly, nonatomic) CGSize size;
+/**
+ * The dimensions of the IOSurface, which is the size class of the surface. The content of the
+ * surface is in the top left corner of the IOSurface.
+ */
+@property(readonly, nonatomic) CGSize ioSurfaceSize;
 @property(readonly, nonatomic) int64_t textureId;
 
 @end
@@ -6,9 +6,15 @@
 
 #import <Metal/Metal.h>
 
+// Surfaces are allocated with their dimensions rounded up to a multiple of this many pixels, so
+// that they can be reused while a window is resized.
+static const CGFloat kSizeClassGranularity = 128;
+
 @interface FlutterSurface () {
   CGSize _size;
+  CGSize _ioSurfaceSize;
   IOSurfaceRef _ioSurface;
+  id<MTLDevice> _device;
   id<MTLTexture> _texture;
 }
 @end
@@ -23,6 +29,10 @@
   return _size;
 }
 
+- (CGSize)ioSurfaceSize {
+  return _ioSurfaceSize;
+}
+
 - (int64_t)textureId {
   return reinterpret_cast<int64_t>(_texture);
 }
@@ -30,12 +40,30 @@
 - (instancetype)initWithSize:(CGSize)size device:(id<MTLDevice>)device {
   if (self = [super init]) {
     self->_size = size;
-    self->_ioSurface = [FlutterSurface createIOSurfaceWithSize:size];
+    self->_ioSurfaceSize = [FlutterSurface sizeClassForSize:size];
+    self->_ioSurface = [FlutterSurface createIOSurfaceWithSize:_ioSurfaceSize];
+    self->_device = device;
     self->_texture = [FlutterSurface createTextureForIOSurface:_ioSurface size:size device:device];
   }
   return self;
 }
 
++ (CGSize)sizeClassForSize:(CGSize)size {
+  return CGSizeMake(ceil(size.width / kSizeClassGranularity) * kSizeClassGranularity,
+                    ceil(size.height / kSizeClassGranularity) * kSizeClassGranularity);
+}
+
+- (void)resizeToSize:(CGSize)size {
+  NSAssert(CGSizeEqualToSize([FlutterSurface sizeClassForSize:size], _ioSurfaceSize),
+           @"The surface can only be resized within its size class.");
+  if (CGSizeEqualToSize(size, _size)) {
+    return;
+  }
+  _size = size;
+  // The texture covers the top left corner of the IOSurface.
+  _texture = [FlutterSurface createTextureForIOSurface:_ioSurface size:size device:_device];
+}
+
 static void ReleaseSurface(void* surface) {
   if (surface != nullptr) {
     CFBridgingRelease(surface);
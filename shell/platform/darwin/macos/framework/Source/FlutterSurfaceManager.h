@@ -77,7 +77,8 @@
 @interface FlutterBackBufferCache : NSObject
 
 /**
- * Removes surface with given size from cache (if available) and returns it.
+ * Removes surface with given size from cache (if available) and returns it. If there is no surface
+ * of the given size, a surface of the same size class is resized and returned instead.
  */
 - (nullable FlutterSurface*)removeSurfaceForSize:(CGSize)size;
 
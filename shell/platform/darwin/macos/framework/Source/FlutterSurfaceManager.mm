@@ -61,7 +61,7 @@ static NSColor* GetBorderColorForLayer(int layer) {
 static void UpdateContentSubLayers(CALayer* layer,
                                    IOSurfaceRef surface,
                                    CGFloat scale,
-                                   CGSize surfaceSize,
+                                   CGSize ioSurfaceSize,
                                    NSColor* borderColor,
                                    const std::vector<FlutterRect>& paintRegion) {
   // Adjust sublayer count to paintRegion count.
@@ -80,8 +80,8 @@ static void UpdateContentSubLayers(CALayer* layer,
     subLayer.frame = CGRectMake(rect.left / scale, rect.top / scale,
                                 (rect.right - rect.left) / scale, (rect.bottom - rect.top) / scale);
 
-    double width = surfaceSize.width;
-    double height = surfaceSize.height;
+    double width = ioSurfaceSize.width;
+    double height = ioSurfaceSize.height;
 
     subLayer.contentsRect =
         CGRectMake(rect.left / width, rect.top / height, (rect.right - rect.left) / width,
@@ -180,12 +180,16 @@ static void UpdateContentSubLayers(CALayer* layer,
     if (i == 0) {
       layer.frame = CGRectMake(info.offset.x / scale, info.offset.y / scale,
                                info.surface.size.width / scale, info.surface.size.height / scale);
+      // Only show the part of the IOSurface that the surface covers.
+      layer.contentsRect =
+          CGRectMake(0, 0, info.surface.size.width / info.surface.ioSurfaceSize.width,
+                     info.surface.size.height / info.surface.ioSurfaceSize.height);
       layer.contents = (__bridge id)info.surface.ioSurface;
     } else {
       layer.frame = CGRectZero;
       NSColor* borderColor = enableSurfaceDebugInfo ? GetBorderColorForLayer(i - 1) : nil;
-      UpdateContentSubLayers(layer, info.surface.ioSurface, scale, info.surface.size, borderColor,
-                             info.paintRegion);
+      UpdateContentSubLayers(layer, info.surface.ioSurface, scale, info.surface.ioSurfaceSize,
+                             borderColor, info.paintRegion);
     }
     layer.zPosition = info.zIndex;
   }
@@ -252,6 +256,7 @@ static const double kIdleDelay = 1.0;
 
 - (nullable FlutterSurface*)removeSurfaceForSize:(CGSize)size {
   @synchronized(self) {
+    // Prefer a surface of the same size, which doesn't need a new texture.
     for (FlutterSurface* surface in _surfaces) {
       if (CGSizeEqualToSize(surface.size, size)) {
         // By default ARC doesn't retain enumeration iteration variables.
@@ -260,6 +265,17 @@ static const double kIdleDelay = 1.0;
         return res;
       }
     }
+    // While a window is resized, the size changes with every frame but usually stays within a
+    // size class, so the IOSurface can be reused.
+    const CGSize sizeClass = [FlutterSurface sizeClassForSize:size];
+    for (FlutterSurface* surface in _surfaces) {
+      if (CGSizeEqualToSize(surface.ioSurfaceSize, sizeClass)) {
+        FlutterSurface* res = surface;
+        [_surfaces removeObject:surface];
+        [res resizeToSize:size];
+        return res;
+      }
+    }
     return nil;
   }
 }
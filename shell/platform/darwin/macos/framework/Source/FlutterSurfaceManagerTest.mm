@@ -164,6 +164,47 @@ TEST(FlutterSurfaceManager, SurfacesAreRecycled) {
   EXPECT_EQ(surface3, surface1);
 }
 
+TEST(FlutterSurfaceManager, SurfacesOfSameSizeClassAreReused) {
+  TestView* testView = [[TestView alloc] init];
+  FlutterSurfaceManager* surfaceManager = CreateSurfaceManager(testView);
+
+  auto surface1 = [surfaceManager surfaceForSize:CGSizeMake(100, 50)];
+  EXPECT_TRUE(CGSizeEqualToSize(surface1.ioSurfaceSize, CGSizeMake(128, 128)));
+  IOSurfaceRef ioSurface1 = surface1.ioSurface;
+  [surfaceManager present:@[ CreatePresentInfo(surface1) ] notify:nil];
+
+  auto surface2 = [surfaceManager surfaceForSize:CGSizeMake(100, 50)];
+  [surfaceManager present:@[ CreatePresentInfo(surface2) ] notify:nil];
+  EXPECT_EQ(surfaceManager.backBufferCache.count, 1ul);
+
+  // A slightly larger surface, as requested while the window is resized, reuses the IOSurface of
+  // the cached surface.
+  auto surface3 = [surfaceManager surfaceForSize:CGSizeMake(110, 60)];
+  EXPECT_EQ(surface3, surface1);
+  EXPECT_EQ(surface3.ioSurface, ioSurface1);
+  EXPECT_TRUE(CGSizeEqualToSize(surface3.size, CGSizeMake(110, 60)));
+  EXPECT_EQ(surfaceManager.backBufferCache.count, 0ul);
+
+  // The Metal texture matches the new size exactly.
+  auto texture = surface3.asFlutterMetalTexture;
+  id<MTLTexture> metalTexture = (__bridge id)texture.texture;
+  EXPECT_EQ(metalTexture.width, 110ul);
+  EXPECT_EQ(metalTexture.height, 60ul);
+  texture.destruction_callback(texture.user_data);
+
+  // Only the part of the IOSurface covered by the surface is shown.
+  [surfaceManager present:@[ CreatePresentInfo(surface3) ] notify:nil];
+  EXPECT_EQ(testView.layer.sublayers.count, 1ul);
+  EXPECT_TRUE(CGRectEqualToRect(testView.layer.sublayers[0].contentsRect,
+                                CGRectMake(0, 0, 110.0 / 128.0, 60.0 / 128.0)));
+  EXPECT_TRUE(CGRectEqualToRect(testView.layer.sublayers[0].frame, CGRectMake(0, 0, 55, 30)));
+
+  // Surfaces of another size class are not reused.
+  auto surface4 = [surfaceManager surfaceForSize:CGSizeMake(200, 60)];
+  EXPECT_NE(surface4, surface2);
+  EXPECT_TRUE(CGSizeEqualToSize(surface4.ioSurfaceSize, CGSizeMake(256, 128)));
+}
+
 inline bool operator==(const CGRect& lhs, const CGRect& rhs) {
   return CGRectEqualToRect(lhs, rhs);
 }
@@ -201,8 +242,14 @@ TEST(FlutterSurfaceManager, LayerManagement) {
     EXPECT_EQ(sublayers.count, 2ul);
     EXPECT_TRUE(CGRectEqualToRect(sublayers[0].frame, CGRectMake(0, 0, 10, 10)));
     EXPECT_TRUE(CGRectEqualToRect(sublayers[1].frame, CGRectMake(20, 0, 10, 10)));
-    EXPECT_TRUE(CGRectEqualToRect(sublayers[0].contentsRect, CGRectMake(0, 0, 1, 1)));
-    EXPECT_TRUE(CGRectEqualToRect(sublayers[1].contentsRect, CGRectMake(2, 0, 1, 1)));
+    // Content rects are relative to the IOSurface, which is rounded up to its size class.
+    const CGSize ioSurfaceSize = surface2_2.ioSurfaceSize;
+    EXPECT_TRUE(CGRectEqualToRect(
+        sublayers[0].contentsRect,
+        CGRectMake(0, 0, 20 / ioSurfaceSize.width, 20 / ioSurfaceSize.height)));
+    EXPECT_TRUE(CGRectEqualToRect(sublayers[1].contentsRect,
+                                  CGRectMake(40 / ioSurfaceSize.width, 0, 20 / ioSurfaceSize.width,
+                                             20 / ioSurfaceSize.height)));
     EXPECT_EQ(sublayers[0].contents, sublayers[1].contents);
     firstOverlaySublayer = sublayers[0];
   }
@@ -0,0 +1,53 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import <Cocoa/Cocoa.h>
+
+/**
+ * Called with the timestamp of the vsync that was waited for, the timestamp the frame started at
+ * this vsync is expected to be displayed at, and the baton that was passed to waitForVSync:.
+ *
+ * Timestamps are in the time base of CACurrentMediaTime.
+ */
+typedef void (^FlutterVSyncWaiterBlock)(CFTimeInterval timestamp,
+                                        CFTimeInterval targetTimestamp,
+                                        uintptr_t baton);
+
+/**
+ * Paces frames with the refresh of a display using a CVDisplayLink.
+ *
+ * The display link only runs while a vsync is being waited for, and is stopped after a few idle
+ * refreshes. Because each vsync reports the time of the next refresh of the display, frames follow
+ * the refresh rate of displays with a variable refresh rate.
+ *
+ * The block is called on the display link thread, which keeps delivering vsyncs while the platform
+ * thread is blocked during a resize.
+ */
+@interface FlutterVSyncWaiter : NSObject
+
+/**
+ * Creates a waiter for the given display, which calls the block for every vsync waited for.
+ */
+- (nullable instancetype)initWithDisplayID:(CGDirectDisplayID)displayID
+                                     block:(nonnull FlutterVSyncWaiterBlock)block;
+
+/**
+ * Calls the block with the baton at the next vsync of the display.
+ *
+ * Only one vsync can be waited for at a time.
+ */
+- (void)waitForVSync:(uintptr_t)baton;
+
+/**
+ * Switches to another display, for example after the window moved to another screen.
+ */
+- (void)setDisplayID:(CGDirectDisplayID)displayID;
+
+/**
+ * Stops the display link. A baton that is still waiting for a vsync is passed to the block right
+ * away, and the block is not called afterwards.
+ */
+- (void)invalidate;
+
+@end
@@ -0,0 +1,184 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import "flutter/shell/platform/darwin/macos/framework/Source/FlutterVSyncWaiter.h"
+
+#import <CoreVideo/CoreVideo.h>
+#import <QuartzCore/QuartzCore.h>
+
+#include <mach/mach_time.h>
+#include <mutex>
+#include <optional>
+
+#import "flutter/fml/logging.h"
+
+// The number of refreshes without a pending vsync after which the display link is stopped.
+static const int kIdleRefreshCount = 4;
+
+// The refresh period to assume when the display link doesn't report one.
+static const CFTimeInterval kDefaultRefreshPeriod = 1.0 / 60.0;
+
+@interface FlutterVSyncWaiter () {
+  FlutterVSyncWaiterBlock _block;
+  CVDisplayLinkRef _displayLink;
+
+  // Serializes starting, stopping and retargeting the display link. _mutex is never held while the
+  // display link is stopped, as stopping it waits for the output handler to return.
+  std::mutex _displayLinkMutex;
+
+  // Guards the state below. Held while the block is called, so that the block is not called after
+  // invalidate returns.
+  std::mutex _mutex;
+  std::optional<uintptr_t> _pendingBaton;
+  int _idleRefreshCount;
+  BOOL _invalidated;
+}
+
+/**
+ * Called on the display link thread for every refresh of the display.
+ */
+- (void)onDisplayLinkWithNow:(const CVTimeStamp*)now outputTime:(const CVTimeStamp*)outputTime;
+
+/**
+ * Stops the display link if no vsync has been waited for since it became idle.
+ */
+- (void)stopIfIdle;
+
+@end
+
+namespace {
+
+CFTimeInterval GetRefreshPeriod(const CVTimeStamp* time) {
+  if (time->videoTimeScale <= 0 || time->videoRefreshPeriod <= 0) {
+    return kDefaultRefreshPeriod;
+  }
+  return static_cast<CFTimeInterval>(time->videoRefreshPeriod) / time->videoTimeScale;
+}
+
+// Converts the host time of a display link timestamp to the time base of CACurrentMediaTime.
+std::optional<CFTimeInterval> GetHostTime(const CVTimeStamp* time) {
+  if ((time->flags & kCVTimeStampHostTimeValid) == 0) {
+    return std::nullopt;
+  }
+  static mach_timebase_info_data_t timebase = [] {
+    mach_timebase_info_data_t info;
+    mach_timebase_info(&info);
+    return info;
+  }();
+  return static_cast<CFTimeInterval>(time->hostTime) * timebase.numer / timebase.denom / 1e9;
+}
+
+}  // namespace
+
+@implementation FlutterVSyncWaiter
+
+- (instancetype)initWithDisplayID:(CGDirectDisplayID)displayID
+                            block:(FlutterVSyncWaiterBlock)block {
+  if (self = [super init]) {
+    if (CVDisplayLinkCreateWithCGDisplay(displayID, &_displayLink) != kCVReturnSuccess) {
+      FML_LOG(ERROR) << "Could not create a display link for display " << displayID << ".";
+      return nil;
+    }
+    _block = block;
+    __weak FlutterVSyncWaiter* weakSelf = self;
+    CVDisplayLinkSetOutputHandler(
+        _displayLink, ^CVReturn(CVDisplayLinkRef displayLink, const CVTimeStamp* inNow,
+                                const CVTimeStamp* inOutputTime, CVOptionFlags flagsIn,
+                                CVOptionFlags* flagsOut) {
+          [weakSelf onDisplayLinkWithNow:inNow outputTime:inOutputTime];
+          return kCVReturnSuccess;
+        });
+  }
+  return self;
+}
+
+- (void)dealloc {
+  if (_displayLink != nullptr) {
+    CVDisplayLinkStop(_displayLink);
+    CVDisplayLinkRelease(_displayLink);
+  }
+}
+
+- (void)waitForVSync:(uintptr_t)baton {
+  {
+    std::scoped_lock lock(_mutex);
+    if (_invalidated) {
+      FML_LOG(ERROR) << "Waiting for a vsync after the vsync waiter was invalidated.";
+      return;
+    }
+    FML_DCHECK(!_pendingBaton.has_value());
+    _pendingBaton = baton;
+    _idleRefreshCount = 0;
+  }
+  std::scoped_lock lock(_displayLinkMutex);
+  if (!CVDisplayLinkIsRunning(_displayLink)) {
+    CVDisplayLinkStart(_displayLink);
+  }
+}
+
+- (void)setDisplayID:(CGDirectDisplayID)displayID {
+  std::scoped_lock lock(_displayLinkMutex);
+  if (CVDisplayLinkGetCurrentCGDisplay(_displayLink) != displayID) {
+    CVDisplayLinkSetCurrentCGDisplay(_displayLink, displayID);
+  }
+}
+
+- (void)invalidate {
+  {
+    std::scoped_lock lock(_displayLinkMutex);
+    CVDisplayLinkStop(_displayLink);
+  }
+  std::scoped_lock lock(_mutex);
+  if (_invalidated) {
+    return;
+  }
+  _invalidated = YES;
+  if (_pendingBaton.has_value()) {
+    // The baton must be returned even though there will be no more vsyncs.
+    CFTimeInterval now = CACurrentMediaTime();
+    _block(now, now + kDefaultRefreshPeriod, *_pendingBaton);
+    _pendingBaton = std::nullopt;
+  }
+}
+
+- (void)onDisplayLinkWithNow:(const CVTimeStamp*)now outputTime:(const CVTimeStamp*)outputTime {
+  std::scoped_lock lock(_mutex);
+  if (_invalidated) {
+    return;
+  }
+  if (!_pendingBaton.has_value()) {
+    if (++_idleRefreshCount == kIdleRefreshCount) {
+      // Stopping the display link from its own thread would wait for this handler to return.
+      __weak FlutterVSyncWaiter* weakSelf = self;
+      dispatch_async(dispatch_get_main_queue(), ^{
+        [weakSelf stopIfIdle];
+      });
+    }
+    return;
+  }
+  std::optional<CFTimeInterval> timestamp = GetHostTime(now);
+  std::optional<CFTimeInterval> targetTimestamp = GetHostTime(outputTime);
+  if (!timestamp.has_value()) {
+    timestamp = CACurrentMediaTime();
+  }
+  if (!targetTimestamp.has_value() || *targetTimestamp <= *timestamp) {
+    targetTimestamp = *timestamp + GetRefreshPeriod(now);
+  }
+  _block(*timestamp, *targetTimestamp, *_pendingBaton);
+  _pendingBaton = std::nullopt;
+}
+
+- (void)stopIfIdle {
+  std::scoped_lock displayLinkLock(_displayLinkMutex);
+  {
+    std::scoped_lock lock(_mutex);
+    if (_pendingBaton.has_value() || _idleRefreshCount < kIdleRefreshCount) {
+      return;
+    }
+  }
+  // A vsync waited for from now on starts the display link again after it is stopped here.
+  CVDisplayLinkStop(_displayLink);
+}
+
+@end
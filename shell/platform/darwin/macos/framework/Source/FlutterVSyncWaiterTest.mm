@@ -0,0 +1,74 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import "flutter/shell/platform/darwin/macos/framework/Source/FlutterVSyncWaiter.h"
+
+#import <QuartzCore/QuartzCore.h>
+
+#include <memory>
+
+#import "flutter/fml/synchronization/waitable_event.h"
+#import "flutter/fml/time/time_delta.h"
+#import "flutter/testing/testing.h"
+
+namespace flutter::testing {
+
+TEST(FlutterVSyncWaiterTest, ReturnsBatonAtNextVSync) {
+  auto latch = std::make_shared<fml::AutoResetWaitableEvent>();
+  __block uintptr_t returnedBaton = 0;
+  __block CFTimeInterval returnedTimestamp = 0;
+  __block CFTimeInterval returnedTargetTimestamp = 0;
+  FlutterVSyncWaiter* waiter = [[FlutterVSyncWaiter alloc]
+      initWithDisplayID:CGMainDisplayID()
+                  block:^(CFTimeInterval timestamp, CFTimeInterval targetTimestamp,
+                          uintptr_t baton) {
+                    returnedBaton = baton;
+                    returnedTimestamp = timestamp;
+                    returnedTargetTimestamp = targetTimestamp;
+                    latch->Signal();
+                  }];
+  ASSERT_NE(waiter, nil);
+
+  CFTimeInterval start = CACurrentMediaTime();
+  [waiter waitForVSync:42];
+  latch->Wait();
+  EXPECT_EQ(returnedBaton, 42u);
+  // The vsync is in the time base of CACurrentMediaTime, and the frame is displayed after it.
+  EXPECT_GT(returnedTimestamp, start - 1);
+  EXPECT_LT(returnedTimestamp, CACurrentMediaTime() + 1);
+  EXPECT_GT(returnedTargetTimestamp, returnedTimestamp);
+
+  // Another vsync can be waited for after the baton was returned.
+  [waiter waitForVSync:43];
+  latch->Wait();
+  EXPECT_EQ(returnedBaton, 43u);
+
+  [waiter invalidate];
+}
+
+TEST(FlutterVSyncWaiterTest, InvalidateReturnsPendingBaton) {
+  __block int callCount = 0;
+  __block uintptr_t returnedBaton = 0;
+  FlutterVSyncWaiter* waiter = [[FlutterVSyncWaiter alloc]
+      initWithDisplayID:CGMainDisplayID()
+                  block:^(CFTimeInterval timestamp, CFTimeInterval targetTimestamp,
+                          uintptr_t baton) {
+                    returnedBaton = baton;
+                    ++callCount;
+                  }];
+  ASSERT_NE(waiter, nil);
+
+  [waiter waitForVSync:7];
+  [waiter invalidate];
+  // The baton is returned exactly once, either by a vsync or by invalidate.
+  EXPECT_EQ(callCount, 1);
+  EXPECT_EQ(returnedBaton, 7u);
+
+  // No vsyncs are delivered after invalidate.
+  [waiter waitForVSync:8];
+  fml::AutoResetWaitableEvent().WaitWithTimeout(fml::TimeDelta::FromMilliseconds(50));
+  EXPECT_EQ(callCount, 1);
+}
+
+}  // namespace flutter::testing
@@ -46,6 +46,7 @@ extern const intptr_t kPlatformStrongDillSize;
 #include "flutter/fml/file.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/message_loop.h"
+#include "flutter/fml/metrics.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/shell/common/rasterizer.h"
@@ -693,12 +694,17 @@ InferSoftwarePlatformViewCreationCallback(
       [software_dispatch_table, platform_dispatch_table,
        external_view_embedder =
            std::move(external_view_embedder)](flutter::Shell& shell) mutable {
+        std::shared_ptr<fml::ConcurrentMessageLoop> tile_loop;
+        if (shell.GetSettings().enable_tiled_software_rendering) {
+          tile_loop = shell.GetDartVM()->GetConcurrentMessageLoop();
+        }
         return std::make_unique<flutter::PlatformViewEmbedder>(
-            shell,                             // delegate
-            shell.GetTaskRunners(),            // task runners
-            software_dispatch_table,           // software dispatch table
-            platform_dispatch_table,           // platform dispatch table
-            std::move(external_view_embedder)  // external view embedder
+            shell,                              // delegate
+            shell.GetTaskRunners(),             // task runners
+            software_dispatch_table,            // software dispatch table
+            platform_dispatch_table,            // platform dispatch table
+            std::move(external_view_embedder),  // external view embedder
+            std::move(tile_loop)                // tile loop
         );
       });
 }
@@ -1150,6 +1156,27 @@ MakeRenderTargetFromSkSurface(FlutterBackingStore backing_store,
       backing_store, std::move(skia_surface), std::move(on_release));
 }
 
+// Renders into an N32 surface that is converted into the embedder supplied
+// surface, as Skia rasterizes into some pixel formats much slower than into
+// N32.
+static std::unique_ptr<flutter::EmbedderRenderTarget>
+MakeRenderTargetFromConvertedSkSurface(FlutterBackingStore backing_store,
+                                       sk_sp<SkSurface> skia_surface,
+                                       fml::closure on_release) {
+  auto render_surface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(
+      skia_surface->width(), skia_surface->height(),
+      skia_surface->imageInfo().refColorSpace()));
+  if (!render_surface) {
+    FML_LOG(ERROR) << "Could not create a surface to convert the pixels of "
+                      "the embedder supplied software render buffer from.";
+    return MakeRenderTargetFromSkSurface(backing_store, std::move(skia_surface),
+                                         std::move(on_release));
+  }
+  return std::make_unique<flutter::EmbedderRenderTargetSkia>(
+      backing_store, std::move(render_surface), std::move(on_release),
+      std::move(skia_surface));
+}
+
 static std::unique_ptr<flutter::EmbedderRenderTarget>
 CreateEmbedderRenderTarget(
     const FlutterCompositor* compositor,
@@ -1232,8 +1259,14 @@ CreateEmbedderRenderTarget(
     case kFlutterBackingStoreTypeSoftware2: {
       auto skia_surface = MakeSkSurfaceFromBackingStore(
           context, config, &backing_store.software2);
-      render_target = MakeRenderTargetFromSkSurface(
-          backing_store, std::move(skia_surface), collect_callback.Release());
+      if (skia_surface &&
+          shouldConvertFromN32(skia_surface->imageInfo().colorType())) {
+        render_target = MakeRenderTargetFromConvertedSkSurface(
+            backing_store, std::move(skia_surface), collect_callback.Release());
+      } else {
+        render_target = MakeRenderTargetFromSkSurface(
+            backing_store, std::move(skia_surface), collect_callback.Release());
+      }
       break;
     }
     case kFlutterBackingStoreTypeMetal: {
@@ -3149,6 +3182,26 @@ FlutterEngineResult FlutterEngineSetNextFrameCallback(
   return kSuccess;
 }
 
+FlutterEngineResult FlutterEngineGetCounters(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineCounterCallback callback,
+    void* user_data) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (callback == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Counter callback was null.");
+  }
+
+  for (const auto& [name, value] :
+       fml::MetricsRegistry::GetInstance().GetCounterValues()) {
+    callback(name.c_str(), value, user_data);
+  }
+
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEngineGetProcAddresses(
     FlutterEngineProcTable* table) {
   if (!table) {
@@ -3201,6 +3254,7 @@ FlutterEngineResult FlutterEngineGetProcAddresses(
   SET_PROC(NotifyDisplayUpdate, FlutterEngineNotifyDisplayUpdate);
   SET_PROC(ScheduleFrame, FlutterEngineScheduleFrame);
   SET_PROC(SetNextFrameCallback, FlutterEngineSetNextFrameCallback);
+  SET_PROC(GetCounters, FlutterEngineGetCounters);
 #undef SET_PROC
 
   return kSuccess;
@@ -1480,6 +1480,13 @@ typedef struct {
   /// run. The same task runner description can be specified for both the render
   /// and platform task runners. This makes the Flutter engine use the same
   /// thread for both task runners.
+  ///
+  /// Each engine renders a single view. Embedders that show multiple windows
+  /// run one engine per window, and the frames of those engines are only
+  /// rasterized concurrently if their render task runners service tasks on
+  /// different threads. Either leave this null so that each engine creates its
+  /// own raster thread, or specify a distinct task runner per engine. Sharing
+  /// one render task runner between engines rasterizes all windows serially.
   const FlutterTaskRunnerDescription* render_task_runner;
   /// Specify a callback that is used to set the thread priority for embedder
   /// task runners.
@@ -1932,6 +1939,12 @@ typedef enum {
 typedef void (*FlutterNativeThreadCallback)(FlutterNativeThreadType type,
                                             void* user_data);
 
+/// A callback made by the engine for each of its counters in response to
+/// `FlutterEngineGetCounters`.
+typedef void (*FlutterEngineCounterCallback)(const char* name,
+                                             int64_t value,
+                                             void* user_data);
+
 /// AOT data source type.
 typedef enum {
   kFlutterEngineAOTDataSourceTypeElfPath
@@ -2942,6 +2955,32 @@ FlutterEngineResult FlutterEngineSetNextFrameCallback(
     VoidCallback callback,
     void* user_data);
 
+//------------------------------------------------------------------------------
+/// @brief      Reports the current values of the counters of the engine, such
+///             as the number of rasterized frames, draw calls and raster cache
+///             hits. The callback is invoked once per counter, synchronously,
+///             on the calling thread. This may be called from any thread.
+///
+///             Counters only grow for the lifetime of the process and are
+///             shared by all engines in the process. Embedders collecting
+///             telemetry should report the difference between two readings.
+///             Counters are updated in all runtime modes at the cost of an
+///             atomic addition. Their names are not part of the API and may
+///             change between engine versions.
+///
+/// @param[in]  engine     A running engine instance.
+/// @param[in]  callback   The callback invoked for each counter.
+/// @param[in]  user_data  A baton passed by the engine to the callback. This
+///                        baton is not interpreted by the engine in any way.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetCounters(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineCounterCallback callback,
+    void* user_data);
+
 #endif  // !FLUTTER_ENGINE_NO_PROTOTYPES
 
 // Typedefs for the function pointers in FlutterEngineProcTable.
@@ -3064,6 +3103,10 @@ typedef FlutterEngineResult (*FlutterEngineSetNextFrameCallbackFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     VoidCallback callback,
     void* user_data);
+typedef FlutterEngineResult (*FlutterEngineGetCountersFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineCounterCallback callback,
+    void* user_data);
 
 /// Function-pointer-based versions of the APIs above.
 typedef struct {
@@ -3110,6 +3153,7 @@ typedef struct {
   FlutterEngineNotifyDisplayUpdateFnPtr NotifyDisplayUpdate;
   FlutterEngineScheduleFrameFnPtr ScheduleFrame;
   FlutterEngineSetNextFrameCallbackFnPtr SetNextFrameCallback;
+  FlutterEngineGetCountersFnPtr GetCounters;
 } FlutterEngineProcTable;
 
 //------------------------------------------------------------------------------
@@ -87,7 +87,14 @@ const EmbeddedViewParams* EmbedderExternalView::GetEmbeddedViewParams() const {
   return embedded_view_params_.get();
 }
 
-bool EmbedderExternalView::Render(const EmbedderRenderTarget& render_target) {
+bool EmbedderExternalView::IsRenderedInto(
+    const EmbedderRenderTarget& render_target) const {
+  TryEndRecording();
+  return render_target.HasRenderedContents(*slice_->display_list(),
+                                           surface_transformation_);
+}
+
+bool EmbedderExternalView::Render(EmbedderRenderTarget& render_target) {
   TRACE_EVENT0("flutter", "EmbedderExternalView::Render");
   TryEndRecording();
   FML_DCHECK(HasEngineRenderedContents())
@@ -105,8 +112,13 @@ bool EmbedderExternalView::Render(const EmbedderRenderTarget& render_target) {
 
     auto dispatcher = impeller::DlDispatcher();
     dispatcher.drawDisplayList(dl_builder.Build(), 1);
-    return aiks_context->Render(dispatcher.EndRecordingAsPicture(),
-                                *impeller_target);
+    if (!aiks_context->Render(dispatcher.EndRecordingAsPicture(),
+                              *impeller_target)) {
+      return false;
+    }
+    render_target.DidRenderContents(slice_->display_list(),
+                                    surface_transformation_);
+    return true;
   }
 #endif  // IMPELLER_SUPPORTS_RENDERING
 
@@ -129,6 +141,8 @@ bool EmbedderExternalView::Render(const EmbedderRenderTarget& render_target) {
   dl_canvas.RestoreToCount(restore_count);
   dl_canvas.Flush();
 
+  render_target.DidRenderContents(slice_->display_list(),
+                                  surface_transformation_);
   return true;
 }
 
@@ -107,7 +107,13 @@ class EmbedderExternalView {
 
   SkISize GetRenderSurfaceSize() const;
 
-  bool Render(const EmbedderRenderTarget& render_target);
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the render target already holds the contents of this
+  ///             view, in which case |Render| need not be called.
+  ///
+  bool IsRenderedInto(const EmbedderRenderTarget& render_target) const;
+
+  bool Render(EmbedderRenderTarget& render_target);
 
   std::list<SkRect> GetEngineRenderedContentsRegion(const SkRect& query) const;
 
@@ -130,9 +130,9 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
   auto [matched_render_targets, pending_keys] =
       render_target_cache_.GetExistingTargetsInCache(pending_views_);
 
-  // This is where unused render targets will be collected. Control may flow to
-  // the embedder. Here, the embedder has the opportunity to trample on the
-  // OpenGL context.
+  // This is where render targets that have gone unused for a few frames will
+  // be collected. Control may flow to the embedder. Here, the embedder has the
+  // opportunity to trample on the OpenGL context.
   //
   // For optimum performance, we should tell the render target cache to clear
   // its unused entries before allocating new ones. This collection step before
@@ -143,7 +143,7 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
   //
   // @warning: Embedder may trample on our OpenGL context here.
   auto deferred_cleanup_render_targets =
-      render_target_cache_.ClearAllRenderTargetsInCache();
+      render_target_cache_.CollectUnusedRenderTargets();
 
   for (const auto& pending_key : pending_keys) {
     const auto& external_view = pending_views_.at(pending_key);
@@ -191,10 +191,16 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
   }
 
   // Scribble embedder provide render targets. The order in which we scribble
-  // into the buffers is irrelevant to the presentation order.
+  // into the buffers is irrelevant to the presentation order. Render targets
+  // that already hold the contents of their view from a previous frame are
+  // presented as not updated instead.
   for (const auto& render_target : matched_render_targets) {
-    if (!pending_views_.at(render_target.first)
-             ->Render(*render_target.second)) {
+    const auto& external_view = pending_views_.at(render_target.first);
+    if (external_view->IsRenderedInto(*render_target.second)) {
+      render_target.second->DidReuseContents();
+      continue;
+    }
+    if (!external_view->Render(*render_target.second)) {
       FML_LOG(ERROR)
           << "Could not render into the embedder supplied render target.";
       return;
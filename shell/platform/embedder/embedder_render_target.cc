@@ -12,8 +12,6 @@ namespace flutter {
 EmbedderRenderTarget::EmbedderRenderTarget(FlutterBackingStore backing_store,
                                            fml::closure on_release)
     : backing_store_(backing_store), on_release_(std::move(on_release)) {
-  // TODO(38468): The optimization to elide backing store updates between frames
-  // has not been implemented yet.
   backing_store_.did_update = true;
 }
 
@@ -27,4 +25,37 @@ const FlutterBackingStore* EmbedderRenderTarget::GetBackingStore() const {
   return &backing_store_;
 }
 
+bool EmbedderRenderTarget::HasRenderedContents(
+    const DisplayList& display_list,
+    const SkMatrix& transformation) const {
+  return rendered_display_list_ &&                    //
+         rendered_transformation_ == transformation &&  //
+         rendered_display_list_->Equals(display_list);
+}
+
+void EmbedderRenderTarget::DidRenderContents(sk_sp<DisplayList> display_list,
+                                             const SkMatrix& transformation) {
+  // The render target is cleared before contents are rendered, so only the
+  // pixels covered by the last or the new contents can have changed.
+  SkIRect dirty_rect = SkIRect::MakeSize(GetRenderTargetSize());
+  if (rendered_display_list_) {
+    SkRect bounds = transformation.mapRect(display_list->bounds());
+    bounds.join(
+        rendered_transformation_.mapRect(rendered_display_list_->bounds()));
+    // Anti-aliasing may touch the pixels just outside of the bounds.
+    if (!dirty_rect.intersect(bounds.roundOut().makeOutset(1, 1))) {
+      dirty_rect.setEmpty();
+    }
+  }
+  OnContentsRendered(dirty_rect);
+
+  rendered_display_list_ = std::move(display_list);
+  rendered_transformation_ = transformation;
+  backing_store_.did_update = true;
+}
+
+void EmbedderRenderTarget::DidReuseContents() {
+  backing_store_.did_update = false;
+}
+
 }  // namespace flutter
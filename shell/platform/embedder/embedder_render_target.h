@@ -6,9 +6,11 @@
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RENDER_TARGET_H_
 
 #include <memory>
+#include "flutter/display_list/display_list.h"
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
 #include "flutter/shell/platform/embedder/embedder.h"
+#include "third_party/skia/include/core/SkMatrix.h"
 #include "third_party/skia/include/core/SkSize.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
@@ -77,6 +79,34 @@ class EmbedderRenderTarget {
   ///
   const FlutterBackingStore* GetBackingStore() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the given contents are the ones that were last
+  ///             rendered into the backing store. Rendering them again may be
+  ///             skipped as the backing store already holds their pixels.
+  ///
+  /// @param[in]  display_list    The contents.
+  /// @param[in]  transformation  The transformation the contents are rendered
+  ///                             with.
+  ///
+  bool HasRenderedContents(const DisplayList& display_list,
+                           const SkMatrix& transformation) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records that the given contents were rendered into the
+  ///             backing store for the frame being presented. The backing
+  ///             store is marked as updated.
+  ///
+  void DidRenderContents(sk_sp<DisplayList> display_list,
+                         const SkMatrix& transformation);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records that the contents of the backing store are presented
+  ///             again without being rendered for the frame. The backing
+  ///             store is marked as not updated so that the embedder may skip
+  ///             compositing it again.
+  ///
+  void DidReuseContents();
+
  protected:
   //----------------------------------------------------------------------------
   /// @brief      Creates a render target whose backing store is managed by the
@@ -93,11 +123,23 @@ class EmbedderRenderTarget {
   EmbedderRenderTarget(FlutterBackingStore backing_store,
                        fml::closure on_release);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Called when contents have been rendered into the render
+  ///             target.
+  ///
+  /// @param[in]  dirty_rect  The area whose pixels may differ from the last
+  ///                         contents rendered into the render target.
+  ///
+  virtual void OnContentsRendered(const SkIRect& dirty_rect) {}
+
  private:
   FlutterBackingStore backing_store_;
 
   fml::closure on_release_;
 
+  sk_sp<DisplayList> rendered_display_list_;
+  SkMatrix rendered_transformation_;
+
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderRenderTarget);
 };
 
@@ -4,6 +4,8 @@
 
 #include "flutter/shell/platform/embedder/embedder_render_target_cache.h"
 
+#include <algorithm>
+
 namespace flutter {
 
 EmbedderRenderTargetCache::EmbedderRenderTargetCache() = default;
@@ -17,37 +19,73 @@ EmbedderRenderTargetCache::GetExistingTargetsInCache(
   RenderTargets resolved_render_targets;
   EmbedderExternalView::ViewIdentifierSet unmatched_identifiers;
 
+  // Prefer the render targets last used by the same view, as they may already
+  // hold the contents of the view.
+  EmbedderExternalView::ViewIdentifierSet unmatched_views;
   for (const auto& view : pending_views) {
     const auto& external_view = view.second;
     if (!external_view->HasEngineRenderedContents()) {
       continue;
     }
-    auto& compatible_targets =
-        cached_render_targets_[external_view->CreateRenderTargetDescriptor()];
-    if (compatible_targets.empty()) {
-      unmatched_identifiers.insert(view.first);
+    auto found = cached_render_targets_.find(
+        external_view->CreateRenderTargetDescriptor());
+    if (found == cached_render_targets_.end() || found->second.empty()) {
+      unmatched_views.insert(view.first);
+      continue;
+    }
+    resolved_render_targets[view.first] =
+        std::move(found->second.back().target);
+    found->second.pop_back();
+  }
+
+  // Then fall back to any render target of the same size.
+  for (const auto& view_identifier : unmatched_views) {
+    const auto& external_view = pending_views.at(view_identifier);
+    auto target = TakeRenderTargetOfSize(external_view->GetRenderSurfaceSize());
+    if (target) {
+      resolved_render_targets[view_identifier] = std::move(target);
     } else {
-      std::unique_ptr<EmbedderRenderTarget> target =
-          std::move(compatible_targets.top());
-      compatible_targets.pop();
-      resolved_render_targets[view.first] = std::move(target);
+      unmatched_identifiers.insert(view_identifier);
     }
   }
   return {std::move(resolved_render_targets), std::move(unmatched_identifiers)};
 }
 
+std::unique_ptr<EmbedderRenderTarget>
+EmbedderRenderTargetCache::TakeRenderTargetOfSize(SkISize size) {
+  for (auto& [desc, targets] : cached_render_targets_) {
+    if (desc.surface_size == size && !targets.empty()) {
+      auto target = std::move(targets.back().target);
+      targets.pop_back();
+      return target;
+    }
+  }
+  return nullptr;
+}
+
 std::set<std::unique_ptr<EmbedderRenderTarget>>
-EmbedderRenderTargetCache::ClearAllRenderTargetsInCache() {
-  std::set<std::unique_ptr<EmbedderRenderTarget>> cleared_targets;
-  for (auto& targets : cached_render_targets_) {
-    auto& targets_stack = targets.second;
-    while (!targets_stack.empty()) {
-      cleared_targets.emplace(std::move(targets_stack.top()));
-      targets_stack.pop();
+EmbedderRenderTargetCache::CollectUnusedRenderTargets() {
+  std::set<std::unique_ptr<EmbedderRenderTarget>> collected_targets;
+  for (auto it = cached_render_targets_.begin();
+       it != cached_render_targets_.end();) {
+    auto& targets = it->second;
+    for (auto& cached : targets) {
+      if (++cached.unused_frames > kMaxUnusedFrames) {
+        collected_targets.emplace(std::move(cached.target));
+      }
+    }
+    targets.erase(std::remove_if(targets.begin(), targets.end(),
+                                 [](const CachedRenderTarget& cached) {
+                                   return cached.target == nullptr;
+                                 }),
+                  targets.end());
+    if (targets.empty()) {
+      it = cached_render_targets_.erase(it);
+    } else {
+      ++it;
     }
   }
-  cached_render_targets_.clear();
-  return cleared_targets;
+  return collected_targets;
 }
 
 void EmbedderRenderTargetCache::CacheRenderTarget(
@@ -58,7 +96,7 @@ void EmbedderRenderTargetCache::CacheRenderTarget(
   }
   auto desc = EmbedderExternalView::RenderTargetDescriptor{
       view_identifier, target->GetRenderTargetSize()};
-  cached_render_targets_[desc].push(std::move(target));
+  cached_render_targets_[desc].push_back({std::move(target), 0u});
 }
 
 size_t EmbedderRenderTargetCache::GetCachedTargetsCount() const {
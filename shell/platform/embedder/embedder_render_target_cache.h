@@ -6,9 +6,9 @@
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RENDER_TARGET_CACHE_H_
 
 #include <set>
-#include <stack>
 #include <tuple>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "flutter/shell/platform/embedder/embedder_external_view.h"
@@ -19,8 +19,20 @@ namespace flutter {
 /// @brief      A cache used to reference render targets that are owned by the
 ///             embedder but needed by th engine to render a frame.
 ///
+///             Render targets are preferably reused by the view that last
+///             rendered into them, whose contents may then not need to be
+///             rendered again. Otherwise any render target of the right size
+///             is reused. Render targets that are not used by a frame are kept
+///             for |kMaxUnusedFrames| frames, so that layers which come and go
+///             (for example as platform views are shown and hidden) don't
+///             cause the embedder to create and collect backing stores.
+///
 class EmbedderRenderTargetCache {
  public:
+  /// The number of consecutive frames a render target may go unused before it
+  /// is collected.
+  static constexpr size_t kMaxUnusedFrames = 2u;
+
   EmbedderRenderTargetCache();
 
   ~EmbedderRenderTargetCache();
@@ -35,8 +47,16 @@ class EmbedderRenderTargetCache {
   GetExistingTargetsInCache(
       const EmbedderExternalView::PendingViews& pending_views);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Marks the render targets remaining in the cache as unused by
+  ///             the current frame, and removes the ones that have gone unused
+  ///             for more than |kMaxUnusedFrames| frames.
+  ///
+  /// @return     The removed render targets. Collecting them may call into the
+  ///             embedder.
+  ///
   std::set<std::unique_ptr<EmbedderRenderTarget>>
-  ClearAllRenderTargetsInCache();
+  CollectUnusedRenderTargets();
 
   void CacheRenderTarget(EmbedderExternalView::ViewIdentifier view_identifier,
                          std::unique_ptr<EmbedderRenderTarget> target);
@@ -44,12 +64,20 @@ class EmbedderRenderTargetCache {
   size_t GetCachedTargetsCount() const;
 
  private:
+  struct CachedRenderTarget {
+    std::unique_ptr<EmbedderRenderTarget> target;
+    size_t unused_frames = 0u;
+  };
+
   using CachedRenderTargets =
       std::unordered_map<EmbedderExternalView::RenderTargetDescriptor,
-                         std::stack<std::unique_ptr<EmbedderRenderTarget>>,
+                         std::vector<CachedRenderTarget>,
                          EmbedderExternalView::RenderTargetDescriptor::Hash,
                          EmbedderExternalView::RenderTargetDescriptor::Equal>;
 
+  // Removes a render target of the given size that was last used by any view.
+  std::unique_ptr<EmbedderRenderTarget> TakeRenderTargetOfSize(SkISize size);
+
   CachedRenderTargets cached_render_targets_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderRenderTargetCache);
@@ -5,15 +5,19 @@
 #include "flutter/shell/platform/embedder/embedder_render_target_skia.h"
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/shell/platform/embedder/pixel_formats.h"
 
 namespace flutter {
 
 EmbedderRenderTargetSkia::EmbedderRenderTargetSkia(
     FlutterBackingStore backing_store,
     sk_sp<SkSurface> render_surface,
-    fml::closure on_release)
+    fml::closure on_release,
+    sk_sp<SkSurface> converted_surface)
     : EmbedderRenderTarget(backing_store, std::move(on_release)),
-      render_surface_(std::move(render_surface)) {
+      render_surface_(std::move(render_surface)),
+      converted_surface_(std::move(converted_surface)) {
   FML_DCHECK(render_surface_);
 }
 
@@ -37,4 +41,19 @@ SkISize EmbedderRenderTargetSkia::GetRenderTargetSize() const {
   return SkISize::Make(render_surface_->width(), render_surface_->height());
 }
 
+void EmbedderRenderTargetSkia::OnContentsRendered(const SkIRect& dirty_rect) {
+  if (!converted_surface_ || dirty_rect.isEmpty()) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "EmbedderRenderTargetSkia::ConvertPixels");
+  SkPixmap rendered_pixels;
+  SkPixmap converted_pixels;
+  if (!render_surface_->peekPixels(&rendered_pixels) ||
+      !converted_surface_->peekPixels(&converted_pixels) ||
+      !convertN32Pixels(rendered_pixels, converted_pixels, dirty_rect)) {
+    FML_LOG(ERROR) << "Could not convert the rendered pixels to the pixel "
+                      "format of the backing store.";
+  }
+}
+
 }  // namespace flutter
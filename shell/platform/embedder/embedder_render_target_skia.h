@@ -11,9 +11,26 @@ namespace flutter {
 
 class EmbedderRenderTargetSkia final : public EmbedderRenderTarget {
  public:
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a render target that is rendered into with Skia.
+  ///
+  /// @param[in]  backing_store      The backing store describing this render
+  ///                                target.
+  /// @param[in]  render_surface     The surface the rasterizer renders into.
+  /// @param[in]  on_release         The callback to invoke when the backing
+  ///                                store is no longer required.
+  /// @param[in]  converted_surface  If not null, the surface of the backing
+  ///                                store, which has a color type that is
+  ///                                faster to convert N32 pixels to than to
+  ///                                render into. The render surface must then
+  ///                                be an N32 surface of the same size, which
+  ///                                is converted into this surface after
+  ///                                contents are rendered.
+  ///
   EmbedderRenderTargetSkia(FlutterBackingStore backing_store,
                            sk_sp<SkSurface> render_surface,
-                           fml::closure on_release);
+                           fml::closure on_release,
+                           sk_sp<SkSurface> converted_surface = nullptr);
 
   // |EmbedderRenderTarget|
   ~EmbedderRenderTargetSkia() override;
@@ -32,6 +49,10 @@ class EmbedderRenderTargetSkia final : public EmbedderRenderTarget {
 
  private:
   sk_sp<SkSurface> render_surface_;
+  sk_sp<SkSurface> converted_surface_;
+
+  // |EmbedderRenderTarget|
+  void OnContentsRendered(const SkIRect& dirty_rect) override;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderRenderTargetSkia);
 };
@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "impeller/entity/gles/entity_shaders_gles.h"
+#include "impeller/entity/gles/framebuffer_blend_shaders_gles.h"
 #include "impeller/renderer/backend/gles/context_gles.h"
 #include "impeller/renderer/backend/gles/proc_table_gles.h"
 
@@ -67,6 +68,9 @@ EmbedderSurfaceGLImpeller::EmbedderSurfaceGLImpeller(
   std::vector<std::shared_ptr<fml::Mapping>> shader_mappings = {
     std::make_shared<fml::NonOwnedMapping>(impeller_entity_shaders_gles_data,
                                            impeller_entity_shaders_gles_length),
+    std::make_shared<fml::NonOwnedMapping>(
+        impeller_framebuffer_blend_shaders_gles_data,
+        impeller_framebuffer_blend_shaders_gles_length),
 #if IMPELLER_ENABLE_3D
     std::make_shared<fml::NonOwnedMapping>(impeller_scene_shaders_gles_data,
                                            impeller_scene_shaders_gles_length),
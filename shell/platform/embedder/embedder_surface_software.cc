@@ -17,9 +17,11 @@ namespace flutter {
 
 EmbedderSurfaceSoftware::EmbedderSurfaceSoftware(
     SoftwareDispatchTable software_dispatch_table,
-    std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
+    std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder,
+    std::shared_ptr<fml::ConcurrentMessageLoop> tile_loop)
     : software_dispatch_table_(std::move(software_dispatch_table)),
-      external_view_embedder_(std::move(external_view_embedder)) {
+      external_view_embedder_(std::move(external_view_embedder)),
+      tile_loop_(std::move(tile_loop)) {
   if (!software_dispatch_table_.software_present_backing_store) {
     return;
   }
@@ -39,7 +41,8 @@ std::unique_ptr<Surface> EmbedderSurfaceSoftware::CreateGPUSurface() {
     return nullptr;
   }
   const bool render_to_surface = !external_view_embedder_;
-  auto surface = std::make_unique<GPUSurfaceSoftware>(this, render_to_surface);
+  auto surface = std::make_unique<GPUSurfaceSoftware>(this, render_to_surface,
+                                                      tile_loop_);
 
   if (!surface->IsValid()) {
     return nullptr;
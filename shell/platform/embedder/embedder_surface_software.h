@@ -24,7 +24,8 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
 
   EmbedderSurfaceSoftware(
       SoftwareDispatchTable software_dispatch_table,
-      std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder);
+      std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder,
+      std::shared_ptr<fml::ConcurrentMessageLoop> tile_loop = nullptr);
 
   ~EmbedderSurfaceSoftware() override;
 
@@ -33,6 +34,8 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
   SoftwareDispatchTable software_dispatch_table_;
   sk_sp<SkSurface> sk_surface_;
   std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder_;
+  // Rasterizes frames in tiles if not null.
+  std::shared_ptr<fml::ConcurrentMessageLoop> tile_loop_;
 
   // |EmbedderSurface|
   bool IsValid() const override;
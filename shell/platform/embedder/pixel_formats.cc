@@ -5,10 +5,198 @@
 #include "flutter/shell/platform/embedder/pixel_formats.h"
 #include "flutter/shell/platform/embedder/embedder.h"
 
+#include <cstdint>
+
 #include "third_party/skia/include/core/SkColorSpace.h"
 #include "third_party/skia/include/core/SkColorType.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// The Rec. 709 luma weights Skia converts to gray with, scaled to add up to
+// 1 << 15.
+constexpr uint16_t kRedLumaWeight = 6966;
+constexpr uint16_t kGreenLumaWeight = 23436;
+constexpr uint16_t kBlueLumaWeight = 2366;
+
+// The byte offsets of the channels of an N32 pixel.
+struct N32Layout {
+  int r;
+  int g;
+  int b;
+  int a;
+};
+
+constexpr N32Layout kRGBALayout = {0, 1, 2, 3};
+constexpr N32Layout kBGRALayout = {2, 1, 0, 3};
+
+// Rounds x / 255 to the nearest integer, for x < 65280.
+inline uint32_t Div255Round(uint32_t x) {
+  x += 128;
+  return (x + (x >> 8)) >> 8;
+}
+
+inline uint16_t PixelToRGB565(const uint8_t* pixel, const N32Layout& layout) {
+  return static_cast<uint16_t>(Div255Round(pixel[layout.r] * 31u) << 11 |
+                               Div255Round(pixel[layout.g] * 63u) << 5 |
+                               Div255Round(pixel[layout.b] * 31u));
+}
+
+inline uint16_t PixelToARGB4444(const uint8_t* pixel,
+                                const N32Layout& layout) {
+  return static_cast<uint16_t>(Div255Round(pixel[layout.r] * 15u) << 12 |
+                               Div255Round(pixel[layout.g] * 15u) << 8 |
+                               Div255Round(pixel[layout.b] * 15u) << 4 |
+                               Div255Round(pixel[layout.a] * 15u));
+}
+
+inline uint8_t PixelToGray8(const uint8_t* pixel, const N32Layout& layout) {
+  return static_cast<uint8_t>((pixel[layout.r] * kRedLumaWeight +
+                               pixel[layout.g] * kGreenLumaWeight +
+                               pixel[layout.b] * kBlueLumaWeight + (1 << 14)) >>
+                              15);
+}
+
+#if defined(__ARM_NEON)
+
+inline uint16x8_t Div255Round(uint16x8_t x) {
+  x = vaddq_u16(x, vdupq_n_u16(128));
+  return vshrq_n_u16(vaddq_u16(x, vshrq_n_u16(x, 8)), 8);
+}
+
+#elif defined(__SSE2__)
+
+inline __m128i Div255Round(__m128i x) {
+  x = _mm_add_epi16(x, _mm_set1_epi16(128));
+  return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+// Loads a channel of 8 pixels into 16 bit lanes.
+inline __m128i LoadChannel(const uint8_t* pixels, int offset) {
+  const __m128i shift = _mm_cvtsi32_si128(offset * 8);
+  const __m128i mask = _mm_set1_epi32(0xFF);
+  const __m128i lo = _mm_and_si128(
+      _mm_srl_epi32(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels)), shift),
+      mask);
+  const __m128i hi = _mm_and_si128(
+      _mm_srl_epi32(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + 16)),
+          shift),
+      mask);
+  return _mm_packs_epi32(lo, hi);
+}
+
+#endif
+
+void ConvertRowToRGB565(const uint8_t* src,
+                        uint16_t* dst,
+                        int count,
+                        const N32Layout& layout) {
+  int x = 0;
+#if defined(__ARM_NEON)
+  for (; x + 8 <= count; x += 8) {
+    const uint8x8x4_t pixels = vld4_u8(src + x * 4);
+    const uint16x8_t r =
+        Div255Round(vmull_u8(pixels.val[layout.r], vdup_n_u8(31)));
+    const uint16x8_t g =
+        Div255Round(vmull_u8(pixels.val[layout.g], vdup_n_u8(63)));
+    const uint16x8_t b =
+        Div255Round(vmull_u8(pixels.val[layout.b], vdup_n_u8(31)));
+    vst1q_u16(dst + x, vorrq_u16(vorrq_u16(vshlq_n_u16(r, 11),
+                                           vshlq_n_u16(g, 5)),
+                                 b));
+  }
+#elif defined(__SSE2__)
+  for (; x + 8 <= count; x += 8) {
+    const uint8_t* pixels = src + x * 4;
+    const __m128i r = Div255Round(
+        _mm_mullo_epi16(LoadChannel(pixels, layout.r), _mm_set1_epi16(31)));
+    const __m128i g = Div255Round(
+        _mm_mullo_epi16(LoadChannel(pixels, layout.g), _mm_set1_epi16(63)));
+    const __m128i b = Div255Round(
+        _mm_mullo_epi16(LoadChannel(pixels, layout.b), _mm_set1_epi16(31)));
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(dst + x),
+        _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5)),
+                     b));
+  }
+#endif
+  for (; x < count; x++) {
+    dst[x] = PixelToRGB565(src + x * 4, layout);
+  }
+}
+
+void ConvertRowToGray8(const uint8_t* src,
+                       uint8_t* dst,
+                       int count,
+                       const N32Layout& layout) {
+  int x = 0;
+#if defined(__ARM_NEON)
+  for (; x + 8 <= count; x += 8) {
+    const uint8x8x4_t pixels = vld4_u8(src + x * 4);
+    const uint16x8_t r = vmovl_u8(pixels.val[layout.r]);
+    const uint16x8_t g = vmovl_u8(pixels.val[layout.g]);
+    const uint16x8_t b = vmovl_u8(pixels.val[layout.b]);
+    uint32x4_t lo = vmull_n_u16(vget_low_u16(r), kRedLumaWeight);
+    lo = vmlal_n_u16(lo, vget_low_u16(g), kGreenLumaWeight);
+    lo = vmlal_n_u16(lo, vget_low_u16(b), kBlueLumaWeight);
+    uint32x4_t hi = vmull_n_u16(vget_high_u16(r), kRedLumaWeight);
+    hi = vmlal_n_u16(hi, vget_high_u16(g), kGreenLumaWeight);
+    hi = vmlal_n_u16(hi, vget_high_u16(b), kBlueLumaWeight);
+    // Rounding shifts add 1 << 14 before shifting by 15.
+    vst1_u8(dst + x, vmovn_u16(vcombine_u16(vrshrn_n_u32(lo, 15),
+                                            vrshrn_n_u32(hi, 15))));
+  }
+#elif defined(__SSE2__)
+  const __m128i rg_weights =
+      _mm_set1_epi32(kGreenLumaWeight << 16 | kRedLumaWeight);
+  const __m128i b_weights = _mm_set1_epi32(1 << 14 << 16 | kBlueLumaWeight);
+  const __m128i one = _mm_set1_epi16(1);
+  for (; x + 8 <= count; x += 8) {
+    const uint8_t* pixels = src + x * 4;
+    const __m128i r = LoadChannel(pixels, layout.r);
+    const __m128i g = LoadChannel(pixels, layout.g);
+    const __m128i b = LoadChannel(pixels, layout.b);
+    // Each 32 bit lane adds up r * r_weight + g * g_weight and
+    // b * b_weight + 1 << 14 for one pixel.
+    const __m128i lo = _mm_srli_epi32(
+        _mm_add_epi32(
+            _mm_madd_epi16(_mm_unpacklo_epi16(r, g), rg_weights),
+            _mm_madd_epi16(_mm_unpacklo_epi16(b, one), b_weights)),
+        15);
+    const __m128i hi = _mm_srli_epi32(
+        _mm_add_epi32(
+            _mm_madd_epi16(_mm_unpackhi_epi16(r, g), rg_weights),
+            _mm_madd_epi16(_mm_unpackhi_epi16(b, one), b_weights)),
+        15);
+    const __m128i gray = _mm_packs_epi32(lo, hi);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + x),
+                     _mm_packus_epi16(gray, gray));
+  }
+#endif
+  for (; x < count; x++) {
+    dst[x] = PixelToGray8(src + x * 4, layout);
+  }
+}
+
+void ConvertRowToARGB4444(const uint8_t* src,
+                          uint16_t* dst,
+                          int count,
+                          const N32Layout& layout) {
+  for (int x = 0; x < count; x++) {
+    dst[x] = PixelToARGB4444(src + x * 4, layout);
+  }
+}
+
+}  // namespace
+
 std::optional<SkColorType> getSkColorType(FlutterSoftwarePixelFormat pixfmt) {
   switch (pixfmt) {
     case kFlutterSoftwarePixelFormatGray8:
@@ -42,3 +230,62 @@ std::optional<SkColorInfo> getSkColorInfo(FlutterSoftwarePixelFormat pixfmt) {
 
   return SkColorInfo(*ct, at, SkColorSpace::MakeSRGB());
 }
+
+bool shouldConvertFromN32(SkColorType color_type) {
+  switch (color_type) {
+    case kRGB_565_SkColorType:
+    case kARGB_4444_SkColorType:
+    case kGray_8_SkColorType:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool convertN32Pixels(const SkPixmap& src,
+                      const SkPixmap& dst,
+                      const SkIRect& rect) {
+  if (src.dimensions() != dst.dimensions() ||
+      src.alphaType() != kPremul_SkAlphaType ||
+      !shouldConvertFromN32(dst.colorType())) {
+    return false;
+  }
+  N32Layout layout;
+  switch (src.colorType()) {
+    case kRGBA_8888_SkColorType:
+      layout = kRGBALayout;
+      break;
+    case kBGRA_8888_SkColorType:
+      layout = kBGRALayout;
+      break;
+    default:
+      return false;
+  }
+
+  SkIRect bounds = rect;
+  if (!bounds.intersect(src.bounds())) {
+    return true;
+  }
+  for (int y = bounds.top(); y < bounds.bottom(); y++) {
+    const auto* src_row =
+        static_cast<const uint8_t*>(src.addr(bounds.left(), y));
+    void* dst_row = dst.writable_addr(bounds.left(), y);
+    switch (dst.colorType()) {
+      case kRGB_565_SkColorType:
+        ConvertRowToRGB565(src_row, static_cast<uint16_t*>(dst_row),
+                           bounds.width(), layout);
+        break;
+      case kARGB_4444_SkColorType:
+        ConvertRowToARGB4444(src_row, static_cast<uint16_t*>(dst_row),
+                             bounds.width(), layout);
+        break;
+      case kGray_8_SkColorType:
+        ConvertRowToGray8(src_row, static_cast<uint8_t*>(dst_row),
+                          bounds.width(), layout);
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
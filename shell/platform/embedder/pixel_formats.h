@@ -8,9 +8,22 @@
 #include <optional>
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/platform/embedder/embedder.h"
+#include "third_party/skia/include/core/SkPixmap.h"
 
 std::optional<SkColorType> getSkColorType(FlutterSoftwarePixelFormat pixfmt);
 
 std::optional<SkColorInfo> getSkColorInfo(FlutterSoftwarePixelFormat pixfmt);
 
+// Whether frames are rendered faster into an N32 surface and then converted
+// with |convertN32Pixels| than rendered into the color type directly.
+bool shouldConvertFromN32(SkColorType color_type);
+
+// Converts the pixels of |rect| from |src|, which must be premultiplied N32,
+// to |dst|, which must have the same dimensions and a color type for which
+// |shouldConvertFromN32| is true. Returns false if the pixmaps aren't
+// supported.
+bool convertN32Pixels(const SkPixmap& src,
+                      const SkPixmap& dst,
+                      const SkIRect& rect);
+
 #endif
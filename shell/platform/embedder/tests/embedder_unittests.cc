@@ -4,6 +4,7 @@
 
 #define FML_USED_ON_EMBEDDER
 
+#include <map>
 #include <string>
 #include <utility>
 #include <vector>
@@ -15,6 +16,7 @@
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/message_loop.h"
+#include "flutter/fml/metrics.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
@@ -2570,6 +2572,29 @@ TEST_F(EmbedderTest, CanSetNextFrameCallback) {
   callback_latch.Wait();
 }
 
+TEST_F(EmbedderTest, CanGetCounters) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  ASSERT_EQ(FlutterEngineGetCounters(engine.get(), nullptr, nullptr),
+            kInvalidArguments);
+
+  FML_COUNTER_ADD("embedder.test.counter", 2);
+  std::map<std::string, int64_t> counters;
+  FlutterEngineCounterCallback callback = [](const char* name, int64_t value,
+                                             void* user_data) {
+    (*static_cast<std::map<std::string, int64_t>*>(user_data))[name] = value;
+  };
+  ASSERT_EQ(FlutterEngineGetCounters(engine.get(), callback, &counters),
+            kSuccess);
+  ASSERT_EQ(counters.count("embedder.test.counter"), 1u);
+  EXPECT_GE(counters["embedder.test.counter"], 2);
+}
+
 #if defined(FML_OS_MACOSX)
 
 static void MockThreadConfigSetter(const fml::Thread::ThreadConfig& config) {
@@ -0,0 +1,107 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/pixel_formats.h"
+
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// Wider than the vector kernels so that the scalar tails are converted too.
+constexpr int kWidth = 21;
+constexpr int kHeight = 3;
+
+SkBitmap MakeN32Bitmap(SkColor color) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(kWidth, kHeight);
+  bitmap.eraseColor(color);
+  return bitmap;
+}
+
+SkBitmap MakeBitmap(SkColorType color_type) {
+  SkBitmap bitmap;
+  bitmap.allocPixels(SkImageInfo::Make(kWidth, kHeight, color_type,
+                                       SkColorTypeIsAlwaysOpaque(color_type)
+                                           ? kOpaque_SkAlphaType
+                                           : kPremul_SkAlphaType));
+  bitmap.eraseColor(SK_ColorTRANSPARENT);
+  return bitmap;
+}
+
+}  // namespace
+
+TEST(PixelFormatsTest, ConvertsFromN32OnlyToSlowColorTypes) {
+  EXPECT_TRUE(shouldConvertFromN32(kRGB_565_SkColorType));
+  EXPECT_TRUE(shouldConvertFromN32(kARGB_4444_SkColorType));
+  EXPECT_TRUE(shouldConvertFromN32(kGray_8_SkColorType));
+  EXPECT_FALSE(shouldConvertFromN32(kN32_SkColorType));
+  EXPECT_FALSE(shouldConvertFromN32(kRGBA_F16_SkColorType));
+}
+
+TEST(PixelFormatsTest, ConvertsN32ToRGB565) {
+  SkBitmap src = MakeN32Bitmap(SK_ColorRED);
+  SkBitmap dst = MakeBitmap(kRGB_565_SkColorType);
+  ASSERT_TRUE(convertN32Pixels(src.pixmap(), dst.pixmap(),
+                               SkIRect::MakeWH(kWidth, kHeight)));
+  for (int y = 0; y < kHeight; y++) {
+    for (int x = 0; x < kWidth; x++) {
+      EXPECT_EQ(*dst.getAddr16(x, y), 0xF800);
+    }
+  }
+}
+
+TEST(PixelFormatsTest, ConvertsN32ToARGB4444) {
+  SkBitmap src = MakeN32Bitmap(SK_ColorGREEN);
+  SkBitmap dst = MakeBitmap(kARGB_4444_SkColorType);
+  ASSERT_TRUE(convertN32Pixels(src.pixmap(), dst.pixmap(),
+                               SkIRect::MakeWH(kWidth, kHeight)));
+  for (int y = 0; y < kHeight; y++) {
+    for (int x = 0; x < kWidth; x++) {
+      EXPECT_EQ(*dst.getAddr16(x, y), 0x0F0F);
+    }
+  }
+}
+
+TEST(PixelFormatsTest, ConvertsN32ToGray8) {
+  SkBitmap src = MakeN32Bitmap(SK_ColorGREEN);
+  SkBitmap dst = MakeBitmap(kGray_8_SkColorType);
+  ASSERT_TRUE(convertN32Pixels(src.pixmap(), dst.pixmap(),
+                               SkIRect::MakeWH(kWidth, kHeight)));
+  for (int y = 0; y < kHeight; y++) {
+    for (int x = 0; x < kWidth; x++) {
+      EXPECT_EQ(*dst.getAddr8(x, y), 0xB6);
+    }
+  }
+}
+
+TEST(PixelFormatsTest, ConvertsOnlyTheRect) {
+  SkBitmap src = MakeN32Bitmap(SK_ColorRED);
+  SkBitmap dst = MakeBitmap(kRGB_565_SkColorType);
+  const SkIRect rect = SkIRect::MakeLTRB(3, 1, 17, 2);
+  ASSERT_TRUE(convertN32Pixels(src.pixmap(), dst.pixmap(), rect));
+  for (int y = 0; y < kHeight; y++) {
+    for (int x = 0; x < kWidth; x++) {
+      EXPECT_EQ(*dst.getAddr16(x, y), rect.contains(x, y) ? 0xF800 : 0);
+    }
+  }
+}
+
+TEST(PixelFormatsTest, RejectsMismatchedPixmaps) {
+  SkBitmap src = MakeN32Bitmap(SK_ColorRED);
+  SkBitmap dst;
+  dst.allocPixels(SkImageInfo::Make(kWidth + 1, kHeight, kRGB_565_SkColorType,
+                                    kOpaque_SkAlphaType));
+  EXPECT_FALSE(convertN32Pixels(src.pixmap(), dst.pixmap(),
+                                SkIRect::MakeWH(kWidth, kHeight)));
+  SkBitmap n32 = MakeN32Bitmap(SK_ColorRED);
+  EXPECT_FALSE(convertN32Pixels(src.pixmap(), n32.pixmap(),
+                                SkIRect::MakeWH(kWidth, kHeight)));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -24,6 +24,9 @@
 #include <unistd.h>
 #include <zircon/status.h>
 
+#include <functional>
+#include <map>
+#include <mutex>
 #include <regex>
 #include <utility>
 
@@ -100,6 +103,78 @@ std::string GetComponentNameFromUrl(const std::string& url) {
 
 }  // namespace
 
+/// The isolate snapshot of a component, either an ELF snapshot or a pair of
+/// blobs.
+struct ComponentSnapshot {
+  dart_utils::ElfSnapshot elf_snapshot;
+  dart_utils::MappedResource isolate_snapshot_data;
+  dart_utils::MappedResource isolate_snapshot_instructions;
+  const uint8_t* isolate_data = nullptr;
+  const uint8_t* isolate_instructions = nullptr;
+};
+
+namespace {
+
+// The snapshots of the running components, so that the components that use
+// the same snapshot map it only once. Entries expire once the last component
+// that uses the snapshot exits.
+std::mutex g_component_snapshots_mutex;
+std::map<std::string, std::weak_ptr<const ComponentSnapshot>>
+    g_component_snapshots;
+
+// Get the merkle root of the package of a component, which identifies the
+// contents of the package. Returns the empty string if it isn't known.
+std::string GetPackageMerkleRoot(fdio_ns_t* namespc) {
+  int root_dir = fdio_ns_opendir(namespc);
+  if (root_dir < 0) {
+    return "";
+  }
+  // Package directories serve the merkle root of the package when their meta
+  // directory is read as a file.
+  std::string merkle_root;
+  const bool result =
+      dart_utils::ReadFileToStringAt(root_dir, "pkg/meta", &merkle_root);
+  close(root_dir);
+  if (!result || merkle_root.size() != 64u) {
+    return "";
+  }
+  return merkle_root;
+}
+
+// Returns the snapshot stored under |key| if a running component already
+// loaded it, and loads it with |load| otherwise. Snapshots with an empty key
+// are loaded but not shared.
+std::shared_ptr<const ComponentSnapshot> LoadSharedSnapshot(
+    const std::string& key,
+    const std::function<bool(ComponentSnapshot&)>& load) {
+  std::unique_lock<std::mutex> lock(g_component_snapshots_mutex,
+                                    std::defer_lock);
+  if (!key.empty()) {
+    lock.lock();
+    if (auto found = g_component_snapshots.find(key);
+        found != g_component_snapshots.end()) {
+      if (auto snapshot = found->second.lock()) {
+        return snapshot;
+      }
+    }
+  }
+
+  auto snapshot = std::make_shared<ComponentSnapshot>();
+  if (!load(*snapshot)) {
+    return nullptr;
+  }
+  if (!key.empty()) {
+    for (auto it = g_component_snapshots.begin();
+         it != g_component_snapshots.end();) {
+      it = it->second.expired() ? g_component_snapshots.erase(it) : ++it;
+    }
+    g_component_snapshots[key] = snapshot;
+  }
+  return snapshot;
+}
+
+}  // namespace
+
 DartComponentController::DartComponentController(
     fuchsia::component::runner::ComponentStartInfo start_info,
     std::shared_ptr<sys::ServiceDirectory> runner_incoming_services,
@@ -299,19 +374,28 @@ bool DartComponentController::SetUpFromKernel() {
     return false;
   }
 
-  if (!dart_utils::MappedResource::LoadFromNamespace(
-          nullptr, "/pkg/data/isolate_core_snapshot_data.bin",
-          isolate_snapshot_data_)) {
-    return false;
-  }
-  if (!dart_utils::MappedResource::LoadFromNamespace(
-          nullptr, "/pkg/data/isolate_core_snapshot_instructions.bin",
-          isolate_snapshot_instructions_, true /* executable */)) {
-    return false;
-  }
-
-  if (!CreateIsolate(isolate_snapshot_data_.address(),
-                     isolate_snapshot_instructions_.address())) {
+  // The core snapshot is in the package of the runner, so all components
+  // share it.
+  snapshot_ = LoadSharedSnapshot(
+      "/pkg/data/isolate_core_snapshot", [](ComponentSnapshot& snapshot) {
+        if (!dart_utils::MappedResource::LoadFromNamespace(
+                nullptr, "/pkg/data/isolate_core_snapshot_data.bin",
+                snapshot.isolate_snapshot_data)) {
+          return false;
+        }
+        if (!dart_utils::MappedResource::LoadFromNamespace(
+                nullptr, "/pkg/data/isolate_core_snapshot_instructions.bin",
+                snapshot.isolate_snapshot_instructions,
+                true /* executable */)) {
+          return false;
+        }
+        snapshot.isolate_data = snapshot.isolate_snapshot_data.address();
+        snapshot.isolate_instructions =
+            snapshot.isolate_snapshot_instructions.address();
+        return true;
+      });
+  if (!snapshot_ || !CreateIsolate(snapshot_->isolate_data,
+                                   snapshot_->isolate_instructions)) {
     return false;
   }
 
@@ -366,28 +450,38 @@ bool DartComponentController::SetUpFromAppSnapshot() {
 #if !defined(AOT_RUNTIME)
   return false;
 #else
-  // Load the ELF snapshot as available, and fall back to a blobs snapshot
-  // otherwise.
-  const uint8_t *isolate_data, *isolate_instructions;
-  if (elf_snapshot_.Load(namespace_, data_path_ + "/app_aot_snapshot.so")) {
-    isolate_data = elf_snapshot_.IsolateData();
-    isolate_instructions = elf_snapshot_.IsolateInstrs();
-    if (isolate_data == nullptr || isolate_instructions == nullptr) {
-      return false;
+  // Components started from the same version of a package share its
+  // snapshot.
+  const std::string merkle_root = GetPackageMerkleRoot(namespace_);
+  const std::string key =
+      merkle_root.empty() ? "" : merkle_root + "/" + data_path_;
+  snapshot_ = LoadSharedSnapshot(key, [this](ComponentSnapshot& snapshot) {
+    // Load the ELF snapshot as available, and fall back to a blobs snapshot
+    // otherwise.
+    if (snapshot.elf_snapshot.Load(namespace_,
+                                   data_path_ + "/app_aot_snapshot.so")) {
+      snapshot.isolate_data = snapshot.elf_snapshot.IsolateData();
+      snapshot.isolate_instructions = snapshot.elf_snapshot.IsolateInstrs();
+      return snapshot.isolate_data != nullptr &&
+             snapshot.isolate_instructions != nullptr;
     }
-  } else {
     if (!dart_utils::MappedResource::LoadFromNamespace(
             namespace_, data_path_ + "/isolate_snapshot_data.bin",
-            isolate_snapshot_data_)) {
+            snapshot.isolate_snapshot_data)) {
       return false;
     }
     if (!dart_utils::MappedResource::LoadFromNamespace(
             namespace_, data_path_ + "/isolate_snapshot_instructions.bin",
-            isolate_snapshot_instructions_, true /* executable */)) {
+            snapshot.isolate_snapshot_instructions, true /* executable */)) {
       return false;
     }
-  }
-  return CreateIsolate(isolate_data, isolate_instructions);
+    snapshot.isolate_data = snapshot.isolate_snapshot_data.address();
+    snapshot.isolate_instructions =
+        snapshot.isolate_snapshot_instructions.address();
+    return true;
+  });
+  return snapshot_ && CreateIsolate(snapshot_->isolate_data,
+                                    snapshot_->isolate_instructions);
 #endif  // defined(AOT_RUNTIME)
 }
 
@@ -25,6 +25,8 @@
 
 namespace dart_runner {
 
+struct ComponentSnapshot;
+
 /// Starts a Dart component written in CFv2.
 class DartComponentController
     : public dart::test::Echo,
@@ -99,9 +101,8 @@ class DartComponentController
   int stdout_fd_ = -1;
   int stderr_fd_ = -1;
 
-  dart_utils::ElfSnapshot elf_snapshot_;                      // AOT snapshot
-  dart_utils::MappedResource isolate_snapshot_data_;          // JIT snapshot
-  dart_utils::MappedResource isolate_snapshot_instructions_;  // JIT snapshot
+  // Shared with the other running components that use the same snapshot.
+  std::shared_ptr<const ComponentSnapshot> snapshot_;
   std::vector<dart_utils::MappedResource> kernel_peices_;
 
   Dart_Isolate isolate_;
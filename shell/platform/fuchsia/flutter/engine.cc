@@ -977,6 +977,13 @@ void Engine::OnLevelChanged(
     FML_LOG(WARNING)
         << "memorypressure watcher: notifying Flutter that memory is low";
     shell_->NotifyLowMemoryWarning();
+
+    // Drop the surfaces pooled for reuse; they are reallocated on demand.
+    shell_->GetTaskRunners().GetRasterTaskRunner()->PostTask([this]() {
+      if (surface_producer_) {
+        surface_producer_->TrimSurfaces();
+      }
+    });
   }
   latest_memory_pressure_level_ = level;
 }
@@ -394,12 +394,20 @@ void ExternalViewEmbedder::SubmitFrame(
         }
 
         // Update the image content and set size.
+        const SkISize& layer_size = layer->second.surface_size;
         flatland_->flatland()->SetContent(layers_[layer_index].transform_id,
                                           {surface_for_layer->GetImageId()});
         flatland_->flatland()->SetImageDestinationSize(
             {surface_for_layer->GetImageId()},
-            {static_cast<uint32_t>(surface_for_layer->GetSize().width()),
-             static_cast<uint32_t>(surface_for_layer->GetSize().height())});
+            {static_cast<uint32_t>(layer_size.width()),
+             static_cast<uint32_t>(layer_size.height())});
+
+        // Pooled surfaces may be padded beyond the size of the layer, so only
+        // sample the part of the image the layer was drawn into.
+        flatland_->flatland()->SetImageSampleRegion(
+            {surface_for_layer->GetImageId()},
+            {0.f, 0.f, static_cast<float>(layer_size.width()),
+             static_cast<float>(layer_size.height())});
 
         // Flutter Embedder lacks an API to detect if a layer has alpha or not.
         // For now, we assume any layer beyond the first has alpha.
@@ -473,8 +481,8 @@ void ExternalViewEmbedder::SubmitFrame(
 
       sk_sp<SkSurface> sk_surface = surface->GetSkiaSurface();
       FML_CHECK(sk_surface != nullptr);
-      FML_CHECK(SkISize::Make(sk_surface->width(), sk_surface->height()) ==
-                frame_size_);
+      FML_CHECK(sk_surface->width() >= frame_size_.width() &&
+                sk_surface->height() >= frame_size_.height());
       SkCanvas* canvas = sk_surface->getCanvas();
       FML_CHECK(canvas != nullptr);
 
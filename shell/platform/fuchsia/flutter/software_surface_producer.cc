@@ -118,6 +118,13 @@ void SoftwareSurfaceProducer::SubmitSurfaces(
   AgeAndCollectOldBuffers();
 }
 
+void SoftwareSurfaceProducer::TrimSurfaces() {
+  TRACE_EVENT0("flutter", "SoftwareSurfaceProducer::TrimSurfaces");
+  available_surfaces_.clear();
+
+  TraceStats();
+}
+
 void SoftwareSurfaceProducer::SubmitSurface(
     std::unique_ptr<SurfaceProducerSurface> surface) {
   TRACE_EVENT0("flutter", "SoftwareSurfacePool::SubmitSurface");
@@ -42,6 +42,9 @@ class SoftwareSurfaceProducer final : public SurfaceProducer {
   void SubmitSurfaces(
       std::vector<std::unique_ptr<SurfaceProducerSurface>> surfaces) override;
 
+  // |SurfaceProducer|
+  void TrimSurfaces() override;
+
  private:
   void SubmitSurface(std::unique_ptr<SurfaceProducerSurface> surface);
   std::unique_ptr<SoftwareSurface> CreateSurface(const SkISize& size);
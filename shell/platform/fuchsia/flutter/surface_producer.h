@@ -76,6 +76,10 @@ class SurfaceProducer {
 
   virtual void SubmitSurfaces(
       std::vector<std::unique_ptr<SurfaceProducerSurface>> surfaces) = 0;
+
+  // Releases the surfaces kept around for reuse, for example when the system
+  // is low on memory.
+  virtual void TrimSurfaces() = 0;
 };
 
 }  // namespace flutter_runner
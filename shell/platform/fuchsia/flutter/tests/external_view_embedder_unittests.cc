@@ -178,6 +178,9 @@ class FakeSurfaceProducer : public SurfaceProducer {
   void SubmitSurfaces(
       std::vector<std::unique_ptr<SurfaceProducerSurface>> surfaces) override {}
 
+  // |SurfaceProducer|
+  void TrimSurfaces() override {}
+
   fuchsia::ui::composition::AllocatorPtr flatland_allocator_;
 };
 
@@ -262,7 +265,10 @@ Matcher<std::shared_ptr<FakeTransform>> IsImageLayer(
       /*content*/
       Pointee(VariantWith<FakeImage>(FieldsAre(
           /*id*/ _, IsImageProperties(layer_size),
-          FakeImage::kDefaultSampleRegion, layer_size,
+          /*sample_region*/
+          fuchsia::math::RectF{0.f, 0.f, static_cast<float>(layer_size.width),
+                               static_cast<float>(layer_size.height)},
+          layer_size,
           FakeImage::kDefaultOpacity, blend_mode,
           /*buffer_import_token*/ _, /*vmo_index*/ 0))),
       /* hit_regions*/ ElementsAreArray(hit_region_matchers)));
@@ -49,6 +49,14 @@ VulkanSurfacePool::VulkanSurfacePool(vulkan::VulkanProvider& vulkan_provider,
 
 VulkanSurfacePool::~VulkanSurfacePool() {}
 
+SkISize VulkanSurfacePool::GetSizeClass(const SkISize& size) {
+  auto round_up = [](int value) {
+    return (value + kSizeClassGranularity - 1) / kSizeClassGranularity *
+           kSizeClassGranularity;
+  };
+  return SkISize::Make(round_up(size.width()), round_up(size.height()));
+}
+
 std::unique_ptr<VulkanSurface> VulkanSurfacePool::AcquireSurface(
     const SkISize& size) {
   auto surface = GetCachedOrCreateSurface(size);
@@ -71,22 +79,43 @@ std::unique_ptr<VulkanSurface> VulkanSurfacePool::GetCachedOrCreateSurface(
     const SkISize& size) {
   TRACE_EVENT2("flutter", "VulkanSurfacePool::GetCachedOrCreateSurface",
                "width", size.width(), "height", size.height());
-  // First try to find a surface that exactly matches |size|.
+  // Try to find the smallest surface that is large enough for |size|, but no
+  // larger than its size class.
   {
-    auto exact_match_it =
-        std::find_if(available_surfaces_.begin(), available_surfaces_.end(),
-                     [&size](const auto& surface) {
-                       return surface->IsValid() && surface->GetSize() == size;
-                     });
-    if (exact_match_it != available_surfaces_.end()) {
-      auto acquired_surface = std::move(*exact_match_it);
-      available_surfaces_.erase(exact_match_it);
-      TRACE_EVENT_INSTANT0("flutter", "Exact match found");
+    const SkISize size_class = GetSizeClass(size);
+    auto best_match_it = available_surfaces_.end();
+    for (auto it = available_surfaces_.begin(); it != available_surfaces_.end();
+         ++it) {
+      if (!(*it)->IsValid()) {
+        continue;
+      }
+      const SkISize surface_size = (*it)->GetSize();
+      if (surface_size.width() < size.width() ||
+          surface_size.height() < size.height() ||
+          surface_size.width() > size_class.width() ||
+          surface_size.height() > size_class.height()) {
+        continue;
+      }
+      if (best_match_it == available_surfaces_.end() ||
+          surface_size.area() < (*best_match_it)->GetSize().area()) {
+        best_match_it = it;
+      }
+    }
+    if (best_match_it != available_surfaces_.end()) {
+      auto acquired_surface = std::move(*best_match_it);
+      available_surfaces_.erase(best_match_it);
+      if (acquired_surface->GetSize() == size) {
+        TRACE_EVENT_INSTANT0("flutter", "Exact match found");
+      } else {
+        TRACE_EVENT_INSTANT0("flutter", "Padded match found");
+      }
+      trace_surfaces_reused_++;
+      total_surfaces_reused_++;
       return acquired_surface;
     }
   }
 
-  return CreateSurface(size);
+  return CreateSurface(GetSizeClass(size));
 }
 
 void VulkanSurfacePool::SubmitSurface(
@@ -125,6 +154,7 @@ std::unique_ptr<VulkanSurface> VulkanSurfacePool::CreateSurface(
     return nullptr;
   }
   trace_surfaces_created_++;
+  total_surfaces_created_++;
   return surface;
 }
 
@@ -230,6 +260,14 @@ void VulkanSurfacePool::ShrinkToFit() {
   TraceStats();
 }
 
+void VulkanSurfacePool::Trim() {
+  TRACE_EVENT0("flutter", "VulkanSurfacePool::Trim");
+  trace_surfaces_trimmed_ += available_surfaces_.size();
+  available_surfaces_.clear();
+
+  TraceStats();
+}
+
 void VulkanSurfacePool::TraceStats() {
   // Resources held in cached buffers.
   size_t cached_surfaces_bytes = 0;
@@ -250,9 +288,15 @@ void VulkanSurfacePool::TraceStats() {
                 "Reused", trace_surfaces_reused_,                 //
                 "PendingInCompositor", pending_surfaces_.size(),  //
                 "Retained", 0,                                    //
+                "Trimmed", trace_surfaces_trimmed_,               //
                 "SkiaCacheResources", skia_resources              //
   );
 
+  TRACE_COUNTER("flutter", "SurfacePoolTotals", 0u,  //
+                "Created", total_surfaces_created_,  //
+                "Reused", total_surfaces_reused_     //
+  );
+
   TRACE_COUNTER("flutter", "SurfacePoolBytes", 0u,          //
                 "CachedBytes", cached_surfaces_bytes,       //
                 "RetainedBytes", 0,                         //
@@ -263,6 +307,7 @@ void VulkanSurfacePool::TraceStats() {
   // Reset per present/frame stats.
   trace_surfaces_created_ = 0;
   trace_surfaces_reused_ = 0;
+  trace_surfaces_trimmed_ = 0;
 }
 
 }  // namespace flutter_runner
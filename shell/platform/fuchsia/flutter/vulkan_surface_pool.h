@@ -21,6 +21,14 @@ class VulkanSurfacePool final {
   static constexpr int kMaxSurfaces = 12;
   // If a surface doesn't get used for 3 or more generations, we discard it.
   static constexpr int kMaxSurfaceAge = 3;
+  // Surfaces are allocated with each dimension rounded up to a multiple of
+  // this many pixels, and may be reused for any smaller size that rounds up to
+  // at least their own.  This avoids allocating new surfaces for every frame
+  // while a view is being resized.
+  static constexpr int kSizeClassGranularity = 64;
+
+  // Returns the size that surfaces used for |size| are allocated with.
+  static SkISize GetSizeClass(const SkISize& size);
 
   VulkanSurfacePool(vulkan::VulkanProvider& vulkan_provider,
                     sk_sp<GrDirectContext> context);
@@ -38,6 +46,11 @@ class VulkanSurfacePool final {
   // small as they can be.
   void ShrinkToFit();
 
+  // Destroy all |VulkanSurfaces| in |available_surfaces_|, for example when
+  // the system is low on memory.  Surfaces still in use by the compositor are
+  // not affected.
+  void Trim();
+
  private:
   vulkan::VulkanProvider& vulkan_provider_;
   sk_sp<GrDirectContext> context_;
@@ -49,6 +62,11 @@ class VulkanSurfacePool final {
 
   size_t trace_surfaces_created_ = 0;
   size_t trace_surfaces_reused_ = 0;
+  size_t trace_surfaces_trimmed_ = 0;
+
+  // Totals over the lifetime of the pool.
+  size_t total_surfaces_created_ = 0;
+  size_t total_surfaces_reused_ = 0;
 
   std::unique_ptr<VulkanSurface> GetCachedOrCreateSurface(const SkISize& size);
 
@@ -281,6 +281,11 @@ std::unique_ptr<SurfaceProducerSurface> VulkanSurfaceProducer::ProduceSurface(
   return surface_pool_->AcquireSurface(size);
 }
 
+void VulkanSurfaceProducer::TrimSurfaces() {
+  FML_CHECK(valid_);
+  surface_pool_->Trim();
+}
+
 void VulkanSurfaceProducer::SubmitSurface(
     std::unique_ptr<SurfaceProducerSurface> surface) {
   FML_CHECK(valid_);
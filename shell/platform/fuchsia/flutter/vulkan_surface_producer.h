@@ -46,6 +46,9 @@ class VulkanSurfaceProducer final : public SurfaceProducer,
   void SubmitSurfaces(
       std::vector<std::unique_ptr<SurfaceProducerSurface>> surfaces) override;
 
+  // |SurfaceProducer|
+  void TrimSurfaces() override;
+
  private:
   // VulkanProvider
   const vulkan::VulkanProcTable& vk() override { return *vk_.get(); }
@@ -1175,6 +1175,15 @@ void FlutterDesktopMessengerSetCallback(FlutterDesktopMessengerRef messenger,
       channel, callback, user_data);
 }
 
+void FlutterDesktopMessengerSetBatchCallback(
+    FlutterDesktopMessengerRef messenger,
+    const char* channel,
+    FlutterDesktopMessageBatchCallback callback,
+    void* user_data) {
+  messenger->GetEngine()->message_dispatcher->SetBatchMessageCallback(
+      channel, callback, user_data);
+}
+
 FlutterDesktopTextureRegistrarRef FlutterDesktopRegistrarGetTextureRegistrar(
     FlutterDesktopPluginRegistrarRef registrar) {
   std::cerr << "GLFW Texture support is not implemented yet." << std::endl;
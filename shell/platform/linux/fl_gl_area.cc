@@ -126,11 +126,52 @@ GtkWidget* fl_gl_area_new(GdkGLContext* context) {
   return GTK_WIDGET(area);
 }
 
-void fl_gl_area_queue_render(FlGLArea* self, GPtrArray* textures) {
+// Returns TRUE if the two lists contain the same textures in the same order.
+static gboolean textures_equal(GPtrArray* a, GPtrArray* b) {
+  if (a == nullptr || b == nullptr || a->len != b->len) {
+    return FALSE;
+  }
+  for (guint i = 0; i < a->len; i++) {
+    if (g_ptr_array_index(a, i) != g_ptr_array_index(b, i)) {
+      return FALSE;
+    }
+  }
+  return TRUE;
+}
+
+void fl_gl_area_queue_render(FlGLArea* self,
+                             GPtrArray* textures,
+                             cairo_region_t* damage) {
   g_return_if_fail(FL_IS_GL_AREA(self));
 
+  gboolean same_textures = textures_equal(self->textures, textures);
+
   g_clear_pointer(&self->textures, g_ptr_array_unref);
   self->textures = g_ptr_array_ref(textures);
 
-  gtk_widget_queue_draw(GTK_WIDGET(self));
+  if (!same_textures || damage == nullptr) {
+    gtk_widget_queue_draw(GTK_WIDGET(self));
+    return;
+  }
+
+  // The window keeps the pixels outside of the queued region, and GDK only
+  // copies the textures into the queued region, so undamaged parts of the
+  // window are not copied again.
+  gint scale = gtk_widget_get_scale_factor(GTK_WIDGET(self));
+  cairo_region_t* region = cairo_region_create();
+  for (int i = 0; i < cairo_region_num_rectangles(damage); i++) {
+    cairo_rectangle_int_t rect;
+    cairo_region_get_rectangle(damage, i, &rect);
+    cairo_rectangle_int_t scaled_rect = {
+        .x = rect.x / scale,
+        .y = rect.y / scale,
+        .width = (rect.x + rect.width + scale - 1) / scale - rect.x / scale,
+        .height = (rect.y + rect.height + scale - 1) / scale - rect.y / scale,
+    };
+    cairo_region_union_rectangle(region, &scaled_rect);
+  }
+  if (!cairo_region_is_empty(region)) {
+    gtk_widget_queue_draw_region(GTK_WIDGET(self), region);
+  }
+  cairo_region_destroy(region);
 }
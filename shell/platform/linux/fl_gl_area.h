@@ -34,10 +34,16 @@ GtkWidget* fl_gl_area_new(GdkGLContext* context);
  * @area: an #FlGLArea.
  * @textures: (transfer none) (element-type FlBackingStoreProvider): a list of
  * #FlBackingStoreProvider.
+ * @damage: (allow-none): the region of the textures, in physical pixels, that
+ * changed since they were last queued, or %NULL if unknown.
  *
- * Queues textures to be drawn later.
+ * Queues textures to be drawn later. If the textures are the ones already
+ * shown, only the damaged region is drawn again, and nothing is drawn if that
+ * region is empty.
  */
-void fl_gl_area_queue_render(FlGLArea* area, GPtrArray* textures);
+void fl_gl_area_queue_render(FlGLArea* area,
+                             GPtrArray* textures,
+                             cairo_region_t* damage);
 
 G_END_DECLS
 
@@ -7,11 +7,26 @@
 #include <epoxy/gl.h>
 #include <gmodule.h>
 
+#include <cstring>
+
 #include "flutter/shell/platform/linux/fl_pixel_buffer_texture_private.h"
 
+// Number of pixel buffer objects uploads are streamed through. While the GL
+// implementation transfers the contents of one, the next frame is written into
+// the other.
+static constexpr size_t kPixelBufferCount = 2;
+
 typedef struct {
   int64_t id;
   GLuint texture_id;
+
+  // Size of the storage allocated for the texture.
+  uint32_t texture_width;
+  uint32_t texture_height;
+
+  // Pixel buffer objects used to upload the pixels, if supported.
+  GLuint pixel_buffers[kPixelBufferCount];
+  size_t next_pixel_buffer;
 } FlPixelBufferTexturePrivate;
 
 static void fl_pixel_buffer_texture_iface_init(FlTextureInterface* iface);
@@ -57,6 +72,10 @@ static void fl_pixel_buffer_texture_dispose(GObject* object) {
     glDeleteTextures(1, &priv->texture_id);
     priv->texture_id = 0;
   }
+  if (priv->pixel_buffers[0]) {
+    glDeleteBuffers(kPixelBufferCount, priv->pixel_buffers);
+    memset(priv->pixel_buffers, 0, sizeof(priv->pixel_buffers));
+  }
 
   G_OBJECT_CLASS(fl_pixel_buffer_texture_parent_class)->dispose(object);
 }
@@ -68,6 +87,56 @@ static void check_gl_error(int line) {
   }
 }
 
+// Returns TRUE if pixels can be uploaded through mapped pixel buffer objects,
+// which requires OpenGL 3.0 or OpenGL ES 3.0.
+static gboolean supports_pixel_buffers() {
+  return epoxy_gl_version() >= 30;
+}
+
+// Uploads @buffer into the bound texture through the next pixel buffer object.
+// The copy into the texture is performed asynchronously by the GL
+// implementation, so the render thread does not wait for it.
+static void upload_through_pixel_buffer(FlPixelBufferTexturePrivate* priv,
+                                        const uint8_t* buffer,
+                                        uint32_t width,
+                                        uint32_t height) {
+  if (priv->pixel_buffers[0] == 0) {
+    glGenBuffers(kPixelBufferCount, priv->pixel_buffers);
+    check_gl_error(__LINE__);
+  }
+
+  GLsizeiptr size = static_cast<GLsizeiptr>(width) * height * 4;
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER,
+               priv->pixel_buffers[priv->next_pixel_buffer]);
+  check_gl_error(__LINE__);
+  priv->next_pixel_buffer = (priv->next_pixel_buffer + 1) % kPixelBufferCount;
+
+  // Orphan the previous contents so mapping does not wait for a transfer from
+  // this buffer that is still in flight.
+  glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+  check_gl_error(__LINE__);
+  void* mapped =
+      glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size,
+                       GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+  check_gl_error(__LINE__);
+  if (mapped != nullptr) {
+    memcpy(mapped, buffer, size);
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    check_gl_error(__LINE__);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA,
+                    GL_UNSIGNED_BYTE, nullptr);
+    check_gl_error(__LINE__);
+  }
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  check_gl_error(__LINE__);
+
+  if (mapped == nullptr) {
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA,
+                    GL_UNSIGNED_BYTE, buffer);
+    check_gl_error(__LINE__);
+  }
+}
+
 gboolean fl_pixel_buffer_texture_populate(FlPixelBufferTexture* texture,
                                           uint32_t width,
                                           uint32_t height,
@@ -101,9 +170,31 @@ gboolean fl_pixel_buffer_texture_populate(FlPixelBufferTexture* texture,
     glBindTexture(GL_TEXTURE_2D, priv->texture_id);
     check_gl_error(__LINE__);
   }
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA,
-               GL_UNSIGNED_BYTE, buffer);
-  check_gl_error(__LINE__);
+
+  // Only allocate storage for the texture when its size changes, after which
+  // the existing storage is updated in place.
+  gboolean allocate =
+      width != priv->texture_width || height != priv->texture_height;
+  if (allocate) {
+    priv->texture_width = width;
+    priv->texture_height = height;
+  }
+  if (supports_pixel_buffers()) {
+    if (allocate) {
+      glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA,
+                   GL_UNSIGNED_BYTE, nullptr);
+      check_gl_error(__LINE__);
+    }
+    upload_through_pixel_buffer(priv, buffer, width, height);
+  } else if (allocate) {
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA,
+                 GL_UNSIGNED_BYTE, buffer);
+    check_gl_error(__LINE__);
+  } else {
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA,
+                    GL_UNSIGNED_BYTE, buffer);
+    check_gl_error(__LINE__);
+  }
 
   opengl_texture->target = GL_TEXTURE_2D;
   opengl_texture->name = priv->texture_id;
@@ -100,6 +100,9 @@ static gboolean fl_renderer_gl_present_layers(FlRenderer* renderer,
   }
 
   g_autoptr(GPtrArray) textures = g_ptr_array_new();
+  // The engine doesn't render backing stores whose contents didn't change, so
+  // those don't need to be drawn again.
+  cairo_region_t* damage = cairo_region_create();
   for (size_t i = 0; i < layers_count; ++i) {
     const FlutterLayer* layer = layers[i];
     switch (layer->type) {
@@ -108,6 +111,15 @@ static gboolean fl_renderer_gl_present_layers(FlRenderer* renderer,
         auto framebuffer = &backing_store->open_gl.framebuffer;
         g_ptr_array_add(textures, reinterpret_cast<FlBackingStoreProvider*>(
                                       framebuffer->user_data));
+        if (backing_store->did_update) {
+          cairo_rectangle_int_t rect = {
+              .x = static_cast<int>(layer->offset.x),
+              .y = static_cast<int>(layer->offset.y),
+              .width = static_cast<int>(layer->size.width),
+              .height = static_cast<int>(layer->size.height),
+          };
+          cairo_region_union_rectangle(damage, &rect);
+        }
       } break;
       case kFlutterLayerContentTypePlatformView: {
         // Currently unsupported.
@@ -115,7 +127,8 @@ static gboolean fl_renderer_gl_present_layers(FlRenderer* renderer,
     }
   }
 
-  fl_view_set_textures(view, context, textures);
+  fl_view_set_textures(view, context, textures, damage);
+  cairo_region_destroy(damage);
 
   return TRUE;
 }
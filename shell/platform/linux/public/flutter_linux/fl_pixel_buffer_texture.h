@@ -28,6 +28,11 @@ G_DECLARE_DERIVABLE_TYPE(FlPixelBufferTexture,
  * #FlPixelBufferTexture represents an OpenGL texture generated from a pixel
  * buffer.
  *
+ * The pixels are copied into the texture on each frame. Sources that already
+ * have their frames in GPU memory, such as dmabufs from a camera or video
+ * decoder, should import them as an EGLImage and provide the resulting texture
+ * through #FlTextureGL instead, which avoids the copy.
+ *
  * The following example shows how to implement an #FlPixelBufferTexture.
  * ![<!-- language="C" -->
  *   struct _MyTexture {
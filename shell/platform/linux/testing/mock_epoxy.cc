@@ -334,10 +334,19 @@ EGLBoolean _eglSwapBuffers(EGLDisplay dpy, EGLSurface surface) {
   return bool_success();
 }
 
+static void _glBindBuffer(GLenum target, GLuint buffer) {}
+
 static void _glBindFramebuffer(GLenum target, GLuint framebuffer) {}
 
 static void _glBindTexture(GLenum target, GLuint texture) {}
 
+static void _glBufferData(GLenum target,
+                          GLsizeiptr size,
+                          const void* data,
+                          GLenum usage) {}
+
+void _glDeleteBuffers(GLsizei n, const GLuint* buffers) {}
+
 void _glDeleteFramebuffers(GLsizei n, const GLuint* framebuffers) {}
 
 void _glDeleteTextures(GLsizei n, const GLuint* textures) {}
@@ -348,6 +357,12 @@ static void _glFramebufferTexture2D(GLenum target,
                                     GLuint texture,
                                     GLint level) {}
 
+static void _glGenBuffers(GLsizei n, GLuint* buffers) {
+  for (GLsizei i = 0; i < n; i++) {
+    buffers[i] = 0;
+  }
+}
+
 static void _glGenTextures(GLsizei n, GLuint* textures) {
   for (GLsizei i = 0; i < n; i++) {
     textures[i] = 0;
@@ -374,6 +389,27 @@ static void _glTexImage2D(GLenum target,
                           GLenum type,
                           const void* pixels) {}
 
+static void _glTexSubImage2D(GLenum target,
+                             GLint level,
+                             GLint xoffset,
+                             GLint yoffset,
+                             GLsizei width,
+                             GLsizei height,
+                             GLenum format,
+                             GLenum type,
+                             const void* pixels) {}
+
+static void* _glMapBufferRange(GLenum target,
+                               GLintptr offset,
+                               GLsizeiptr length,
+                               GLbitfield access) {
+  return nullptr;
+}
+
+static GLboolean _glUnmapBuffer(GLenum target) {
+  return GL_TRUE;
+}
+
 static GLenum _glGetError() {
   return GL_NO_ERROR;
 }
@@ -440,8 +476,14 @@ EGLBoolean (*epoxy_eglMakeCurrent)(EGLDisplay dpy,
                                    EGLContext ctx);
 EGLBoolean (*epoxy_eglSwapBuffers)(EGLDisplay dpy, EGLSurface surface);
 
+void (*epoxy_glBindBuffer)(GLenum target, GLuint buffer);
 void (*epoxy_glBindFramebuffer)(GLenum target, GLuint framebuffer);
 void (*epoxy_glBindTexture)(GLenum target, GLuint texture);
+void (*epoxy_glBufferData)(GLenum target,
+                           GLsizeiptr size,
+                           const void* data,
+                           GLenum usage);
+void (*epoxy_glDeleteBuffers)(GLsizei n, const GLuint* buffers);
 void (*epoxy_glDeleteFramebuffers)(GLsizei n, const GLuint* framebuffers);
 void (*epoxy_glDeleteTextures)(GLsizei n, const GLuint* textures);
 void (*epoxy_glFramebufferTexture2D)(GLenum target,
@@ -449,6 +491,7 @@ void (*epoxy_glFramebufferTexture2D)(GLenum target,
                                      GLenum textarget,
                                      GLuint texture,
                                      GLint level);
+void (*epoxy_glGenBuffers)(GLsizei n, GLuint* buffers);
 void (*epoxy_glGenFramebuffers)(GLsizei n, GLuint* framebuffers);
 void (*epoxy_glGenTextures)(GLsizei n, GLuint* textures);
 void (*epoxy_glTexParameterf)(GLenum target, GLenum pname, GLfloat param);
@@ -462,6 +505,20 @@ void (*epoxy_glTexImage2D)(GLenum target,
                            GLenum format,
                            GLenum type,
                            const void* pixels);
+void (*epoxy_glTexSubImage2D)(GLenum target,
+                              GLint level,
+                              GLint xoffset,
+                              GLint yoffset,
+                              GLsizei width,
+                              GLsizei height,
+                              GLenum format,
+                              GLenum type,
+                              const void* pixels);
+void* (*epoxy_glMapBufferRange)(GLenum target,
+                                GLintptr offset,
+                                GLsizeiptr length,
+                                GLbitfield access);
+GLboolean (*epoxy_glUnmapBuffer)(GLenum target);
 GLenum (*epoxy_glGetError)();
 
 static void library_init() {
@@ -478,15 +535,22 @@ static void library_init() {
   epoxy_eglMakeCurrent = _eglMakeCurrent;
   epoxy_eglSwapBuffers = _eglSwapBuffers;
 
+  epoxy_glBindBuffer = _glBindBuffer;
   epoxy_glBindFramebuffer = _glBindFramebuffer;
   epoxy_glBindTexture = _glBindTexture;
+  epoxy_glBufferData = _glBufferData;
+  epoxy_glDeleteBuffers = _glDeleteBuffers;
   epoxy_glDeleteFramebuffers = _glDeleteFramebuffers;
   epoxy_glDeleteTextures = _glDeleteTextures;
   epoxy_glFramebufferTexture2D = _glFramebufferTexture2D;
+  epoxy_glGenBuffers = _glGenBuffers;
   epoxy_glGenFramebuffers = _glGenFramebuffers;
   epoxy_glGenTextures = _glGenTextures;
   epoxy_glTexParameterf = _glTexParameterf;
   epoxy_glTexParameteri = _glTexParameteri;
   epoxy_glTexImage2D = _glTexImage2D;
+  epoxy_glTexSubImage2D = _glTexSubImage2D;
+  epoxy_glMapBufferRange = _glMapBufferRange;
+  epoxy_glUnmapBuffer = _glUnmapBuffer;
   epoxy_glGetError = _glGetError;
 }
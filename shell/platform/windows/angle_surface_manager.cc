@@ -4,6 +4,7 @@
 
 #include "flutter/shell/platform/windows/angle_surface_manager.h"
 
+#include <cstring>
 #include <vector>
 
 #include "flutter/fml/logging.h"
@@ -153,6 +154,14 @@ bool AngleSurfaceManager::Initialize(bool enable_impeller) {
     }
   }
 
+  // Presenting through DirectComposition makes ANGLE use a flip model swap
+  // chain, which DWM composes without copying it into the redirection surface
+  // of the window. This removes a copy and a frame of latency.
+  const char* extensions = eglQueryString(egl_display_, EGL_EXTENSIONS);
+  supports_direct_composition_ =
+      extensions != nullptr &&
+      strstr(extensions, "EGL_ANGLE_direct_composition") != nullptr;
+
   EGLint numConfigs = 0;
   if (enable_impeller) {
     // First try the MSAA configuration.
@@ -239,14 +248,24 @@ bool AngleSurfaceManager::CreateSurface(WindowsRenderTarget* render_target,
 
   EGLSurface surface = EGL_NO_SURFACE;
 
-  const EGLint surfaceAttributes[] = {
-      EGL_FIXED_SIZE_ANGLE, EGL_TRUE, EGL_WIDTH, width,
-      EGL_HEIGHT,           height,   EGL_NONE};
+  std::vector<EGLint> surfaceAttributes = {EGL_FIXED_SIZE_ANGLE, EGL_TRUE,
+                                           EGL_WIDTH,            width,
+                                           EGL_HEIGHT,           height};
+  if (supports_direct_composition_) {
+    surfaceAttributes.push_back(EGL_DIRECT_COMPOSITION_ANGLE);
+    surfaceAttributes.push_back(EGL_TRUE);
+  }
+  surfaceAttributes.push_back(EGL_NONE);
 
   surface = eglCreateWindowSurface(
       egl_display_, egl_config_,
       static_cast<EGLNativeWindowType>(std::get<HWND>(*render_target)),
-      surfaceAttributes);
+      surfaceAttributes.data());
+  if (surface == EGL_NO_SURFACE && supports_direct_composition_) {
+    LogEglError("DirectComposition surface creation failed, falling back.");
+    supports_direct_composition_ = false;
+    return CreateSurface(render_target, width, height, vsync_enabled);
+  }
   if (surface == EGL_NO_SURFACE) {
     LogEglError("Surface creation failed.");
     return false;
@@ -118,6 +118,9 @@ class AngleSurfaceManager {
   // creating surfaces.
   bool initialize_succeeded_;
 
+  // Whether window surfaces are presented through DirectComposition.
+  bool supports_direct_composition_ = false;
+
   // Current render_surface that engine will draw into.
   EGLSurface render_surface_ = EGL_NO_SURFACE;
 
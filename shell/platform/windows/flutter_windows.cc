@@ -323,6 +323,20 @@ void FlutterDesktopMessengerSetCallback(FlutterDesktopMessengerRef messenger,
       ->SetMessageCallback(channel, callback, user_data);
 }
 
+void FlutterDesktopMessengerSetBatchCallback(
+    FlutterDesktopMessengerRef messenger,
+    const char* channel,
+    FlutterDesktopMessageBatchCallback callback,
+    void* user_data) {
+  FML_DCHECK(FlutterDesktopMessengerIsAvailable(messenger))
+      << "Messenger must reference a running engine to set a callback";
+
+  flutter::FlutterDesktopMessenger::FromRef(messenger)
+      ->GetEngine()
+      ->message_dispatcher()
+      ->SetBatchMessageCallback(channel, callback, user_data);
+}
+
 FlutterDesktopMessengerRef FlutterDesktopMessengerAddRef(
     FlutterDesktopMessengerRef messenger) {
   return flutter::FlutterDesktopMessenger::FromRef(messenger)
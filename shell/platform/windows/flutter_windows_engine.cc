@@ -188,6 +188,12 @@ FlutterWindowsEngine::FlutterWindowsEngine(const FlutterProjectBundle& project)
       std::make_unique<BinaryMessengerImpl>(messenger_->ToRef());
   message_dispatcher_ =
       std::make_unique<IncomingMessageDispatcher>(messenger_->ToRef());
+  // Deliver the messages of batched channels that arrive in one burst of
+  // platform tasks together.
+  message_dispatcher_->SetFlushScheduler(
+      [this](std::function<void(void)> flush) {
+        task_runner_->PostTask(std::move(flush));
+      });
   message_dispatcher_->SetMessageCallback(
       kAccessibilityChannelName,
       [](FlutterDesktopMessengerRef messenger,
@@ -19,6 +19,7 @@ TaskRunnerWindow::TaskRunnerWindow() {
   if (window_handle_) {
     SetWindowLongPtr(window_handle_, GWLP_USERDATA,
                      reinterpret_cast<LONG_PTR>(this));
+    StartHighResolutionTimer();
   } else {
     auto error = GetLastError();
     LPWSTR message = nullptr;
@@ -33,6 +34,7 @@ TaskRunnerWindow::TaskRunnerWindow() {
 }
 
 TaskRunnerWindow::~TaskRunnerWindow() {
+  StopHighResolutionTimer();
   if (window_handle_) {
     DestroyWindow(window_handle_);
     window_handle_ = nullptr;
@@ -52,7 +54,13 @@ std::shared_ptr<TaskRunnerWindow> TaskRunnerWindow::GetSharedInstance() {
 }
 
 void TaskRunnerWindow::WakeUp() {
+  // A single message processes all expired tasks, so there is no need to
+  // post another one while one is pending.
+  if (wake_up_pending_.exchange(true)) {
+    return;
+  }
   if (!PostMessage(window_handle_, WM_NULL, 0, 0)) {
+    wake_up_pending_ = false;
     FML_LOG(ERROR) << "Failed to post message to main thread.";
   }
 }
@@ -83,6 +91,23 @@ void TaskRunnerWindow::ProcessTasks() {
 }
 
 void TaskRunnerWindow::SetTimer(std::chrono::nanoseconds when) {
+  if (timer_) {
+    if (when == std::chrono::nanoseconds::max()) {
+      CancelWaitableTimer(timer_);
+    } else if (when <= std::chrono::nanoseconds::zero()) {
+      CancelWaitableTimer(timer_);
+      WakeUp();
+    } else {
+      // Negative due times are relative, in 100 nanosecond intervals.
+      LARGE_INTEGER due_time;
+      due_time.QuadPart = -std::max<int64_t>(when.count() / 100, 1);
+      if (!SetWaitableTimer(timer_, &due_time, 0, nullptr, nullptr, FALSE)) {
+        FML_LOG(ERROR) << "Failed to set the task runner timer.";
+      }
+    }
+    return;
+  }
+
   if (when == std::chrono::nanoseconds::max()) {
     KillTimer(window_handle_, 0);
   } else {
@@ -91,6 +116,41 @@ void TaskRunnerWindow::SetTimer(std::chrono::nanoseconds when) {
   }
 }
 
+void TaskRunnerWindow::StartHighResolutionTimer() {
+  timer_ = CreateWaitableTimerExW(nullptr, nullptr,
+                                  CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+                                  TIMER_ALL_ACCESS);
+  if (!timer_) {
+    // High resolution timers are only available on Windows 10 1803+.
+    return;
+  }
+  timer_stop_event_ = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+  if (!timer_stop_event_) {
+    CloseHandle(timer_);
+    timer_ = nullptr;
+    return;
+  }
+  timer_thread_ = std::thread([this]() {
+    const HANDLE handles[] = {timer_stop_event_, timer_};
+    while (WaitForMultipleObjects(2, handles, FALSE, INFINITE) ==
+           WAIT_OBJECT_0 + 1) {
+      WakeUp();
+    }
+  });
+}
+
+void TaskRunnerWindow::StopHighResolutionTimer() {
+  if (!timer_) {
+    return;
+  }
+  SetEvent(timer_stop_event_);
+  timer_thread_.join();
+  CloseHandle(timer_stop_event_);
+  CloseHandle(timer_);
+  timer_stop_event_ = nullptr;
+  timer_ = nullptr;
+}
+
 WNDCLASS TaskRunnerWindow::RegisterWindowClass() {
   window_class_name_ = L"FlutterTaskRunnerWindow";
 
@@ -114,8 +174,11 @@ TaskRunnerWindow::HandleMessage(UINT const message,
                                 WPARAM const wparam,
                                 LPARAM const lparam) noexcept {
   switch (message) {
-    case WM_TIMER:
     case WM_NULL:
+      wake_up_pending_ = false;
+      ProcessTasks();
+      return 0;
+    case WM_TIMER:
       ProcessTasks();
       return 0;
   }
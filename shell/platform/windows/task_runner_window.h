@@ -7,9 +7,11 @@
 
 #include <windows.h>
 
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "flutter/fml/macros.h"
@@ -30,7 +32,8 @@ class TaskRunnerWindow {
 
   static std::shared_ptr<TaskRunnerWindow> GetSharedInstance();
 
-  // Triggers processing delegate tasks on main thread
+  // Triggers processing delegate tasks on main thread. Wake ups requested
+  // before the tasks are processed are coalesced into one.
   void WakeUp();
 
   void AddDelegate(Delegate* delegate);
@@ -45,6 +48,13 @@ class TaskRunnerWindow {
 
   void SetTimer(std::chrono::nanoseconds when);
 
+  // Creates a high resolution waitable timer and the thread that waits on it,
+  // if supported by the OS. Otherwise falls back to |::SetTimer|, whose
+  // resolution is that of the system timer (typically ~15ms).
+  void StartHighResolutionTimer();
+
+  void StopHighResolutionTimer();
+
   WNDCLASS RegisterWindowClass();
 
   LRESULT
@@ -61,6 +71,13 @@ class TaskRunnerWindow {
   std::wstring window_class_name_;
   std::vector<Delegate*> delegates_;
 
+  // Whether a wake up message has been posted but not yet handled.
+  std::atomic_bool wake_up_pending_ = false;
+
+  HANDLE timer_ = nullptr;
+  HANDLE timer_stop_event_ = nullptr;
+  std::thread timer_thread_;
+
   FML_DISALLOW_COPY_AND_ASSIGN(TaskRunnerWindow);
 };
 }  // namespace flutter
@@ -3,7 +3,6 @@
 // found in the LICENSE file.
 
 #include "flutter/shell/platform/windows/text_input_plugin.h"
-#include "flutter/fml/string_conversion.h"
 #include "flutter/shell/platform/common/text_editing_delta.h"
 #include "flutter/shell/platform/windows/text_input_plugin_delegate.h"
 
@@ -67,8 +66,7 @@ void TextInputPlugin::TextHook(const std::u16string& text) {
   if (active_model_ == nullptr) {
     return;
   }
-  std::u16string text_before_change =
-      fml::Utf8ToUtf16(active_model_->GetText());
+  std::u16string text_before_change = active_model_->GetTextUtf16();
   TextRange selection_before_change = active_model_->selection();
   active_model_->AddText(text);
 
@@ -193,16 +191,15 @@ void TextInputPlugin::ComposeChangeHook(const std::u16string& text,
   if (active_model_ == nullptr) {
     return;
   }
-  std::string text_before_change = active_model_->GetText();
+  std::u16string text_before_change = active_model_->GetTextUtf16();
   TextRange composing_before_change = active_model_->composing_range();
   active_model_->AddText(text);
   cursor_pos += active_model_->composing_range().start();
   active_model_->UpdateComposingText(text);
   active_model_->SetSelection(TextRange(cursor_pos, cursor_pos));
-  std::string text_after_change = active_model_->GetText();
   if (enable_delta_model) {
-    TextEditingDelta delta = TextEditingDelta(
-        fml::Utf8ToUtf16(text_before_change), composing_before_change, text);
+    TextEditingDelta delta = TextEditingDelta(text_before_change,
+                                              composing_before_change, text);
     SendStateUpdateWithDelta(*active_model_, &delta);
   } else {
     SendStateUpdate(*active_model_);
@@ -450,7 +447,7 @@ void TextInputPlugin::SendStateUpdateWithDelta(const TextInputModel& model,
 void TextInputPlugin::EnterPressed(TextInputModel* model) {
   if (input_type_ == kMultilineInputType &&
       input_action_ == kInputActionNewline) {
-    std::u16string text_before_change = fml::Utf8ToUtf16(model->GetText());
+    std::u16string text_before_change = model->GetTextUtf16();
     TextRange selection_before_change = model->selection();
     model->AddText(u"\n");
     if (enable_delta_model) {
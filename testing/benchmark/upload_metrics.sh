@@ -40,6 +40,8 @@ cd "$SCRIPT_DIR"
   --json $ENGINE_PATH/src/out/host_release/txt_benchmarks.json "$@"
 "$DART" --disable-dart-dev bin/parse_and_send.dart \
   --json $ENGINE_PATH/src/out/host_release/fml_benchmarks.json "$@"
+"$DART" --disable-dart-dev bin/parse_and_send.dart \
+  --json $ENGINE_PATH/src/out/host_release/flow_benchmarks.json "$@"
 "$DART" --disable-dart-dev bin/parse_and_send.dart \
   --json $ENGINE_PATH/src/out/host_release/shell_benchmarks.json "$@"
 "$DART" --disable-dart-dev bin/parse_and_send.dart \
@@ -44,6 +44,24 @@ void main() {
     expect(buffer.length == 354679, true);
   });
 
+  test('returns a range of the bytes of a bundled asset', () async {
+    final ImmutableBuffer buffer = await ImmutableBuffer.fromAssetRange('DashInNooglerHat.jpg', 100, 1000);
+    expect(buffer.length, 1000);
+
+    final ImmutableBuffer tail = await ImmutableBuffer.fromAssetRange('DashInNooglerHat.jpg', 354679 - 10, 10);
+    expect(tail.length, 10);
+  });
+
+  test('Loading a range outside of an asset throws', () async {
+    Object? error;
+    try {
+      await ImmutableBuffer.fromAssetRange('DashInNooglerHat.jpg', 354679 - 10, 11);
+    } catch (err) {
+      error = err;
+    }
+    expect(error is RangeError, true);
+  });
+
   test('Can load an asset with a space in the key', () async {
     // This assets actual path is "fixtures/DashInNooglerHat%20WithSpace.jpg"
     final ImmutableBuffer buffer = await ImmutableBuffer.fromAsset('DashInNooglerHat WithSpace.jpg');
@@ -1106,6 +1106,30 @@ void main() {
     canvas.restoreToCount(canvas.getSaveCount() + 1);
     expect(canvas.getSaveCount(), equals(6));
   });
+
+  test('Draws without paint objects keep their order with other canvas calls', () async {
+    final Image image = await toImage((Canvas canvas) {
+      final Paint paint = Paint()..color = const Color(0xFFFF0000);
+      canvas.save();
+      canvas.translate(10, 0);
+      expect(canvas.getSaveCount(), equals(2));
+      expect(canvas.getTransform()[12], equals(10));
+      // More draws than fit in one command stream.
+      for (int i = 0; i < 10000; i++) {
+        canvas.drawRect(const Rect.fromLTWH(0, 0, 10, 10), paint);
+      }
+      final Path path = Path()..addRect(const Rect.fromLTWH(0, 0, 5, 10));
+      canvas.drawPath(path, Paint()..color = const Color(0xFF00FF00));
+      canvas.restore();
+      paint.color = const Color(0xFF0000FF);
+      canvas.drawCircle(const Offset(5, 5), 5, paint);
+    }, 20, 10);
+    final ByteData data = (await image.toByteData())!;
+    int getPixel(int x, int y) => data.getUint32((x + y * image.width) * 4);
+    expect(getPixel(5, 5), equals(0x0000FFFF));
+    expect(getPixel(12, 5), equals(0x00FF00FF));
+    expect(getPixel(17, 5), equals(0xFF0000FF));
+  });
 }
 
 Matcher listEquals(ByteData expected) => (dynamic v) {
@@ -78,6 +78,16 @@ void main() async {
     }
   });
 
+  test('FragmentProgram can be warmed up', () async {
+    final FragmentProgram program = await FragmentProgram.fromAsset(
+      'blue_green_sampler.frag.iplr',
+    );
+    await program.warmUp();
+
+    // Warming up again is harmless.
+    await program.warmUp();
+  });
+
   test('Disposed FragmentShader on Paint', () async {
     final FragmentProgram program = await FragmentProgram.fromAsset(
       'blue_green_sampler.frag.iplr',
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 import 'dart:isolate';
+import 'dart:typed_data';
 import 'dart:ui';
 
 import 'package:litetest/litetest.dart';
@@ -31,4 +32,107 @@ void main() {
     final List<dynamic> isolateError = await errorPort.first as List<dynamic>;
     expect(isolateError[0], 'UI actions are only available on root isolate.');
   });
+
+  test('IsolatePool runs computations on background isolates', () async {
+    final String rootName = Isolate.current.debugName!;
+    final List<String?> names = await Future.wait(<Future<String?>>[
+      for (int i = 0; i < 4; i++)
+        IsolatePool.run<String?>(() => Isolate.current.debugName),
+    ]);
+    for (final String? name in names) {
+      expect(name, 'IsolatePool');
+      expect(name == rootName, false);
+    }
+
+    // Closures capturing state of the calling isolate can be sent.
+    final List<int> values = <int>[1, 2, 3];
+    expect(await IsolatePool.run<int>(() => values.reduce((int a, int b) => a + b)), 6);
+  });
+
+  test('IsolatePool forwards errors of computations', () async {
+    Object? caught;
+    try {
+      await IsolatePool.run<void>(() => throw StateError('failed'));
+    } catch (error) {
+      caught = error;
+    }
+    expect(caught is StateError, true);
+    expect((caught! as StateError).message, 'failed');
+
+    // The isolate is still usable after an error.
+    expect(await IsolatePool.run<int>(() => 42), 42);
+  });
+
+  test('TransferableImage shares an image through a background isolate', () async {
+    final Image image = _createPicture().toImageSync(10, 20);
+    final TransferableImage transferable = TransferableImage(image);
+    image.dispose();
+
+    final TransferableImage received = await IsolatePool.run<TransferableImage>(() => transferable);
+    final Image materialized = received.materialize();
+    expect(materialized.width, 10);
+    expect(materialized.height, 20);
+    final ByteData? data = await materialized.toByteData();
+    expect(data!.lengthInBytes, 10 * 20 * 4);
+    materialized.dispose();
+
+    Object? caught;
+    try {
+      transferable.materialize();
+    } catch (error) {
+      caught = error;
+    }
+    expect(caught is StateError, true);
+  });
+
+  test('TransferableImage cannot be materialized on a background isolate', () async {
+    final Image image = _createPicture().toImageSync(10, 10);
+    final TransferableImage transferable = TransferableImage(image);
+    image.dispose();
+
+    Object? caught;
+    try {
+      await IsolatePool.run<void>(() => transferable.materialize());
+    } catch (error) {
+      caught = error;
+    }
+    expect(caught, 'UI actions are only available on root isolate.');
+
+    // The handle can still be materialized on the root isolate.
+    transferable.materialize().dispose();
+  });
+
+  test('TransferablePicture shares a picture through a background isolate', () async {
+    final Picture picture = _createPicture();
+    final int bytesUsed = picture.approximateBytesUsed;
+    final TransferablePicture transferable = TransferablePicture(picture);
+    picture.dispose();
+
+    final TransferablePicture received = await IsolatePool.run<TransferablePicture>(() => transferable);
+    final Picture materialized = received.materialize();
+    expect(materialized.approximateBytesUsed, bytesUsed);
+    final Image image = materialized.toImageSync(10, 10);
+    expect(image.width, 10);
+    image.dispose();
+    materialized.dispose();
+
+    final Picture other = _createPicture();
+    final TransferablePicture disposed = TransferablePicture(other);
+    other.dispose();
+    disposed.dispose();
+    Object? caught;
+    try {
+      disposed.materialize();
+    } catch (error) {
+      caught = error;
+    }
+    expect(caught is StateError, true);
+  });
+}
+
+Picture _createPicture() {
+  final PictureRecorder recorder = PictureRecorder();
+  final Canvas canvas = Canvas(recorder);
+  canvas.drawRect(const Rect.fromLTWH(0, 0, 10, 10), Paint()..color = const Color(0xFF00FF00));
+  return recorder.endRecording();
 }
@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+import 'dart:typed_data';
 import 'dart:ui';
 
 import 'package:litetest/litetest.dart';
@@ -282,4 +283,54 @@ void main() {
         expect(metrics, hasLength(1));
     }
   });
+
+  test('batched queries match the single queries', () {
+    const double fontSize = 10.0;
+    final ParagraphBuilder builder = ParagraphBuilder(ParagraphStyle(
+      fontFamily: 'Ahem',
+      fontSize: fontSize,
+    ));
+    builder.addText('Test Ahem');
+    final Paragraph paragraph = builder.build();
+    paragraph.layout(const ParagraphConstraints(width: fontSize * 5.0));
+
+    final Int32List ranges = Int32List.fromList(<int>[0, 2, 3, 7, 4, 4]);
+    final Float32List boxes = Float32List(32);
+    final int boxValueCount = paragraph.getBoxesForRanges(ranges, boxes);
+    expect(boxValueCount, lessThanOrEqualTo(boxes.length));
+    int position = 0;
+    for (int i = 0; i < ranges.length; i += 2) {
+      final List<TextBox> expected = paragraph.getBoxesForRange(ranges[i], ranges[i + 1]);
+      expect(boxes[position++], expected.length);
+      for (final TextBox box in expected) {
+        expect(boxes[position++], box.left);
+        expect(boxes[position++], box.top);
+        expect(boxes[position++], box.right);
+        expect(boxes[position++], box.bottom);
+        expect(boxes[position++], box.direction.index);
+      }
+    }
+    expect(position, boxValueCount);
+    // Too small lists are filled as far as they go.
+    expect(paragraph.getBoxesForRanges(ranges, Float32List(1)), boxValueCount);
+
+    final Float32List offsets = Float32List.fromList(<double>[0, 0, 25, 5, 12, 15]);
+    final Int32List positions = Int32List(offsets.length);
+    paragraph.getPositionsForOffsets(offsets, positions);
+    for (int i = 0; i < offsets.length; i += 2) {
+      final TextPosition expected =
+          paragraph.getPositionForOffset(Offset(offsets[i], offsets[i + 1]));
+      expect(positions[i], expected.offset);
+      expect(positions[i + 1], expected.affinity.index);
+    }
+
+    final List<LineMetrics> lines = paragraph.computeLineMetrics();
+    final Float64List metrics = Float64List(9 * lines.length);
+    expect(paragraph.computeLineMetricsInto(metrics), lines.length);
+    for (int i = 0; i < lines.length; i++) {
+      expect(metrics[i * 9 + 1], lines[i].ascent);
+      expect(metrics[i * 9 + 5], lines[i].width);
+      expect(metrics[i * 9 + 8], lines[i].lineNumber);
+    }
+  });
 }
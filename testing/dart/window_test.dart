@@ -42,6 +42,31 @@ void main() {
             'frameNumber: 23)');
   });
 
+  test('FrameTiming.gpuDuration defaults to zero', () {
+    final FrameTiming timing = FrameTiming(
+      vsyncStart: 500,
+      buildStart: 1000,
+      buildFinish: 8000,
+      rasterStart: 9000,
+      rasterFinish: 19500,
+      rasterFinishWallTime: 19501,
+    );
+    expect(timing.gpuDuration, Duration.zero);
+
+    final FrameTiming measured = FrameTiming(
+      vsyncStart: 500,
+      buildStart: 1000,
+      buildFinish: 8000,
+      rasterStart: 9000,
+      rasterFinish: 19500,
+      rasterFinishWallTime: 19501,
+      gpuDuration: 4200,
+      frameNumber: 31,
+    );
+    expect(measured.gpuDuration, const Duration(microseconds: 4200));
+    expect(measured.frameNumber, 31);
+  });
+
   test('FrameTiming.toString with cache statistics has the correct format', () {
     final FrameTiming timing = FrameTiming(
       vsyncStart: 500,
@@ -103,4 +128,13 @@ void main() {
     expect(PlatformDispatcher.instance.scaleFontSize(3), 3.0);
     expect(PlatformDispatcher.instance.scaleFontSize(3.4), 3.4);
   });
+
+  test('engineCounters only grow', () {
+    final Map<String, int> before = PlatformDispatcher.instance.engineCounters;
+    final Map<String, int> after = PlatformDispatcher.instance.engineCounters;
+    for (final MapEntry<String, int> counter in before.entries) {
+      expect(counter.value >= 0, isTrue);
+      expect(after[counter.key]! >= counter.value, isTrue);
+    }
+  });
 }
@@ -234,21 +234,24 @@ static const CGFloat kCompareAccuracy = 0.001;
   XCTAssertEqual(platform_view2.frame.size.width, 250);
   XCTAssertEqual(platform_view2.frame.size.height, 250);
 
-  XCUIElement* overlay1 = app.otherElements[@"platform_view[0].overlay[0]"];
+  // A is above both platform views, so all of its overlays are placed above the topmost one.
+  XCTAssertFalse(app.otherElements[@"platform_view[0].overlay[0]"].exists);
+
+  XCUIElement* overlay1 = app.otherElements[@"platform_view[1].overlay[0]"];
   XCTAssertTrue(overlay1.exists);
   XCTAssertEqual(overlay1.frame.origin.x, 25);
-  XCTAssertEqual(overlay1.frame.origin.y, 300);
+  XCTAssertEqual(overlay1.frame.origin.y, 0);
   XCTAssertEqual(overlay1.frame.size.width, 225);
-  XCTAssertEqual(overlay1.frame.size.height, 200);
+  XCTAssertEqual(overlay1.frame.size.height, 250);
 
-  XCUIElement* overlay2 = app.otherElements[@"platform_view[1].overlay[0]"];
+  XCUIElement* overlay2 = app.otherElements[@"platform_view[1].overlay[1]"];
   XCTAssertTrue(overlay2.exists);
   XCTAssertEqual(overlay2.frame.origin.x, 25);
-  XCTAssertEqual(overlay2.frame.origin.y, 0);
+  XCTAssertEqual(overlay2.frame.origin.y, 300);
   XCTAssertEqual(overlay2.frame.size.width, 225);
-  XCTAssertEqual(overlay2.frame.size.height, 250);
+  XCTAssertEqual(overlay2.frame.size.height, 200);
 
-  XCUIElement* overlayView0 = app.otherElements[@"platform_view[0].overlay_view[0]"];
+  XCUIElement* overlayView0 = app.otherElements[@"platform_view[1].overlay_view[0]"];
   XCTAssertTrue(overlayView0.exists);
   // Overlay should always be the same frame as the app.
   XCTAssertEqualWithAccuracy(overlayView0.frame.origin.x, app.frame.origin.x, kCompareAccuracy);
@@ -257,7 +260,7 @@ static const CGFloat kCompareAccuracy = 0.001;
   XCTAssertEqualWithAccuracy(overlayView0.frame.size.height, app.frame.size.height,
                              kCompareAccuracy);
 
-  XCUIElement* overlayView1 = app.otherElements[@"platform_view[1].overlay_view[0]"];
+  XCUIElement* overlayView1 = app.otherElements[@"platform_view[1].overlay_view[1]"];
   XCTAssertTrue(overlayView1.exists);
   // Overlay should always be the same frame as the app.
   XCTAssertEqualWithAccuracy(overlayView1.frame.origin.x, app.frame.origin.x, kCompareAccuracy);
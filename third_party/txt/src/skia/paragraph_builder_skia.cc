@@ -15,8 +15,11 @@
  */
 
 #include "paragraph_builder_skia.h"
+#include "paragraph_layout_cache.h"
 #include "paragraph_skia.h"
 
+#include <type_traits>
+
 #include "third_party/skia/modules/skparagraph/include/ParagraphStyle.h"
 #include "third_party/skia/modules/skparagraph/include/TextStyle.h"
 #include "txt/paragraph_style.h"
@@ -42,27 +45,178 @@ SkFontStyle MakeSkFontStyle(txt::FontWeight font_weight,
                                            : SkFontStyle::Slant::kItalic_Slant);
 }
 
+template <typename T>
+void AppendToKey(std::string& key, const T& value) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  key.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void AppendToKey(std::string& key, const std::string& value) {
+  AppendToKey(key, value.size());
+  key.append(value);
+}
+
+void AppendToKey(std::string& key, const std::u16string& value) {
+  AppendToKey(key, value.size());
+  key.append(reinterpret_cast<const char*>(value.data()),
+             value.size() * sizeof(char16_t));
+}
+
+void AppendToKey(std::string& key, const std::vector<std::string>& values) {
+  AppendToKey(key, values.size());
+  for (const auto& value : values) {
+    AppendToKey(key, value);
+  }
+}
+
+void AppendToKey(std::string& key, const ParagraphStyle& style) {
+  AppendToKey(key, style.font_weight);
+  AppendToKey(key, style.font_style);
+  AppendToKey(key, style.font_family);
+  AppendToKey(key, style.font_size);
+  AppendToKey(key, style.height);
+  AppendToKey(key, style.has_height_override);
+  AppendToKey(key, style.text_height_behavior);
+  AppendToKey(key, style.strut_enabled);
+  AppendToKey(key, style.strut_font_weight);
+  AppendToKey(key, style.strut_font_style);
+  AppendToKey(key, style.strut_font_families);
+  AppendToKey(key, style.strut_font_size);
+  AppendToKey(key, style.strut_height);
+  AppendToKey(key, style.strut_has_height_override);
+  AppendToKey(key, style.strut_half_leading);
+  AppendToKey(key, style.strut_leading);
+  AppendToKey(key, style.force_strut_height);
+  AppendToKey(key, style.text_align);
+  AppendToKey(key, style.text_direction);
+  AppendToKey(key, style.max_lines);
+  AppendToKey(key, style.ellipsis);
+  AppendToKey(key, style.locale);
+  AppendToKey(key, style.apply_rounding_hack);
+}
+
+void AppendToKey(std::string& key, const TextStyle& style) {
+  AppendToKey(key, style.color);
+  AppendToKey(key, style.decoration);
+  AppendToKey(key, style.decoration_color);
+  AppendToKey(key, style.decoration_style);
+  AppendToKey(key, style.decoration_thickness_multiplier);
+  AppendToKey(key, style.font_weight);
+  AppendToKey(key, style.font_style);
+  AppendToKey(key, style.text_baseline);
+  AppendToKey(key, style.half_leading);
+  AppendToKey(key, style.font_families);
+  AppendToKey(key, style.font_size);
+  AppendToKey(key, style.letter_spacing);
+  AppendToKey(key, style.word_spacing);
+  AppendToKey(key, style.height);
+  AppendToKey(key, style.has_height_override);
+  AppendToKey(key, style.locale);
+  // Only whether there are paints changes the IDs of the paints.
+  AppendToKey(key, style.background.has_value());
+  AppendToKey(key, style.foreground.has_value());
+  AppendToKey(key, style.text_shadows.size());
+  for (const auto& shadow : style.text_shadows) {
+    AppendToKey(key, shadow.color);
+    AppendToKey(key, shadow.offset);
+    AppendToKey(key, shadow.blur_sigma);
+  }
+  AppendToKey(key, style.font_features.GetFontFeatures().size());
+  for (const auto& [tag, value] : style.font_features.GetFontFeatures()) {
+    AppendToKey(key, tag);
+    AppendToKey(key, value);
+  }
+  AppendToKey(key, style.font_variations.GetAxisValues().size());
+  for (const auto& [tag, value] : style.font_variations.GetAxisValues()) {
+    AppendToKey(key, tag);
+    AppendToKey(key, value);
+  }
+}
+
+void AppendToKey(std::string& key, const PlaceholderRun& placeholder) {
+  AppendToKey(key, placeholder.width);
+  AppendToKey(key, placeholder.height);
+  AppendToKey(key, placeholder.alignment);
+  AppendToKey(key, placeholder.baseline);
+  AppendToKey(key, placeholder.baseline_offset);
+}
+
 }  // anonymous namespace
 
 ParagraphBuilderSkia::ParagraphBuilderSkia(
     const ParagraphStyle& style,
     std::shared_ptr<FontCollection> font_collection,
     const bool impeller_enabled)
-    : base_style_(style.GetTextStyle()), impeller_enabled_(impeller_enabled) {
+    : ParagraphBuilderSkia(style,
+                           font_collection,
+                           impeller_enabled,
+                           font_collection->GetParagraphLayoutCache()) {}
+
+ParagraphBuilderSkia::ParagraphBuilderSkia(
+    const ParagraphStyle& style,
+    std::shared_ptr<FontCollection> font_collection,
+    const bool impeller_enabled,
+    std::shared_ptr<ParagraphLayoutCache> layout_cache)
+    : base_style_(style.GetTextStyle()),
+      font_collection_(std::move(font_collection)),
+      layout_cache_(std::move(layout_cache)),
+      impeller_enabled_(impeller_enabled) {
+  // The paints are created while converting the styles, so styles are
+  // converted even if they are only recorded.
+  auto skia_style = TxtToSkia(style);
+  if (layout_cache_) {
+    recording_ = std::make_shared<ParagraphRecording>();
+    recording_->style = style;
+    AppendToKey(recording_->key, style);
+    return;
+  }
   builder_ = skt::ParagraphBuilder::make(
-      TxtToSkia(style), font_collection->CreateSktFontCollection());
+      skia_style, font_collection_->CreateSktFontCollection());
 }
 
 ParagraphBuilderSkia::~ParagraphBuilderSkia() = default;
 
+std::unique_ptr<skt::Paragraph> ParagraphBuilderSkia::BuildRecording(
+    const ParagraphRecording& recording,
+    const std::shared_ptr<FontCollection>& font_collection) {
+  ParagraphBuilderSkia builder(recording.style, font_collection,
+                               /*impeller_enabled=*/false,
+                               /*layout_cache=*/nullptr);
+  for (const auto& op : recording.ops) {
+    if (auto style = std::get_if<TextStyle>(&op)) {
+      builder.PushStyle(*style);
+    } else if (std::holds_alternative<ParagraphRecording::Pop>(op)) {
+      builder.Pop();
+    } else if (auto text = std::get_if<std::u16string>(&op)) {
+      builder.AddText(*text);
+    } else if (auto placeholder = std::get_if<PlaceholderRun>(&op)) {
+      PlaceholderRun span = *placeholder;
+      builder.AddPlaceholder(span);
+    }
+  }
+  return builder.builder_->Build();
+}
+
 void ParagraphBuilderSkia::PushStyle(const TextStyle& style) {
-  builder_->pushStyle(TxtToSkia(style));
+  auto skia_style = TxtToSkia(style);
   txt_style_stack_.push(style);
+  if (recording_) {
+    recording_->ops.emplace_back(style);
+    recording_->key.push_back('S');
+    AppendToKey(recording_->key, style);
+    return;
+  }
+  builder_->pushStyle(skia_style);
 }
 
 void ParagraphBuilderSkia::Pop() {
-  builder_->pop();
   txt_style_stack_.pop();
+  if (recording_) {
+    recording_->ops.emplace_back(ParagraphRecording::Pop{});
+    recording_->key.push_back('P');
+    return;
+  }
+  builder_->pop();
 }
 
 const TextStyle& ParagraphBuilderSkia::PeekStyle() {
@@ -70,10 +224,22 @@ const TextStyle& ParagraphBuilderSkia::PeekStyle() {
 }
 
 void ParagraphBuilderSkia::AddText(const std::u16string& text) {
+  if (recording_) {
+    recording_->ops.emplace_back(text);
+    recording_->key.push_back('T');
+    AppendToKey(recording_->key, text);
+    return;
+  }
   builder_->addText(text);
 }
 
 void ParagraphBuilderSkia::AddPlaceholder(PlaceholderRun& span) {
+  if (recording_) {
+    recording_->ops.emplace_back(span);
+    recording_->key.push_back('H');
+    AppendToKey(recording_->key, span);
+    return;
+  }
   skt::PlaceholderStyle placeholder_style;
   placeholder_style.fHeight = span.height;
   placeholder_style.fWidth = span.width;
@@ -86,6 +252,16 @@ void ParagraphBuilderSkia::AddPlaceholder(PlaceholderRun& span) {
 }
 
 std::unique_ptr<Paragraph> ParagraphBuilderSkia::Build() {
+  if (recording_) {
+    if (recording_->key.size() > ParagraphLayoutCache::kMaxKeyBytes) {
+      return std::make_unique<ParagraphSkia>(
+          BuildRecording(*recording_, font_collection_), std::move(dl_paints_),
+          impeller_enabled_);
+    }
+    return std::make_unique<ParagraphSkia>(
+        std::move(recording_), font_collection_, layout_cache_,
+        std::move(dl_paints_), impeller_enabled_);
+  }
   return std::make_unique<ParagraphSkia>(
       builder_->Build(), std::move(dl_paints_), impeller_enabled_);
 }
@@ -19,11 +19,31 @@
 
 #include "txt/paragraph_builder.h"
 
+#include <variant>
+
 #include "flutter/display_list/dl_paint.h"
 #include "third_party/skia/modules/skparagraph/include/ParagraphBuilder.h"
 
 namespace txt {
 
+class ParagraphLayoutCache;
+
+//------------------------------------------------------------------------------
+/// @brief      The inputs of a paragraph, recorded so that paragraphs with the
+///             same inputs can share their layouts.
+///
+struct ParagraphRecording {
+  struct Pop {};
+  using Op = std::variant<TextStyle, Pop, std::u16string, PlaceholderRun>;
+
+  ParagraphStyle style;
+  std::vector<Op> ops;
+  /// Everything in the recording that affects the layout or the painting of
+  /// the paragraph, except for the contents of the paints, which paragraphs
+  /// look up by ID in their own paints.
+  std::string key;
+};
+
 //------------------------------------------------------------------------------
 /// @brief      ParagraphBuilder implementation using Skia's text layout module.
 ///
@@ -44,7 +64,19 @@ class ParagraphBuilderSkia : public ParagraphBuilder {
   virtual void AddPlaceholder(PlaceholderRun& span) override;
   virtual std::unique_ptr<Paragraph> Build() override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Build the Skia paragraph of a recording.
+  ///
+  static std::unique_ptr<skia::textlayout::Paragraph> BuildRecording(
+      const ParagraphRecording& recording,
+      const std::shared_ptr<FontCollection>& font_collection);
+
  private:
+  ParagraphBuilderSkia(const ParagraphStyle& style,
+                       std::shared_ptr<FontCollection> font_collection,
+                       const bool impeller_enabled,
+                       std::shared_ptr<ParagraphLayoutCache> layout_cache);
+
   skia::textlayout::ParagraphPainter::PaintID CreatePaintID(
       const flutter::DlPaint& dl_paint);
   skia::textlayout::ParagraphStyle TxtToSkia(const ParagraphStyle& txt);
@@ -52,6 +84,12 @@ class ParagraphBuilderSkia : public ParagraphBuilder {
 
   std::shared_ptr<skia::textlayout::ParagraphBuilder> builder_;
   TextStyle base_style_;
+  std::shared_ptr<FontCollection> font_collection_;
+  std::shared_ptr<ParagraphLayoutCache> layout_cache_;
+  // The inputs of the paragraph if the layout cache is used. The Skia
+  // paragraph is only built from the recording when it is laid out without a
+  // cache hit.
+  std::shared_ptr<ParagraphRecording> recording_;
 
   /// @brief      Whether Impeller is enabled in the runtime.
   ///
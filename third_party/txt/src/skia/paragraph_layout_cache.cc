@@ -0,0 +1,114 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "paragraph_layout_cache.h"
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
+
+namespace txt {
+
+bool ParagraphLayoutCache::Key::operator==(const Key& other) const {
+  return width == other.width && thread == other.thread &&
+         contents == other.contents;
+}
+
+size_t ParagraphLayoutCache::Key::Hash::operator()(const Key& key) const {
+  return fml::HashCombine(std::hash<std::string>{}(key.contents), key.width,
+                          std::hash<std::thread::id>{}(key.thread));
+}
+
+ParagraphLayoutCache::ParagraphLayoutCache(size_t max_entries)
+    : max_entries_(max_entries) {}
+
+ParagraphLayoutCache::~ParagraphLayoutCache() = default;
+
+std::shared_ptr<skia::textlayout::Paragraph> ParagraphLayoutCache::Find(
+    const std::string& key,
+    double width) {
+  std::shared_ptr<skia::textlayout::Paragraph> paragraph;
+  {
+    std::scoped_lock lock(mutex_);
+    auto found = entries_by_key_.find(
+        Key{key, static_cast<float>(width), std::this_thread::get_id()});
+    if (found == entries_by_key_.end()) {
+      miss_count_++;
+    } else {
+      hit_count_++;
+      entries_.splice(entries_.begin(), entries_, found->second);
+      paragraph = found->second->paragraph;
+    }
+  }
+  TraceStatsToTimeline();
+  return paragraph;
+}
+
+void ParagraphLayoutCache::Insert(
+    const std::string& key,
+    double width,
+    std::shared_ptr<skia::textlayout::Paragraph> paragraph) {
+  if (!paragraph || key.size() > kMaxKeyBytes || max_entries_ == 0u) {
+    return;
+  }
+  Key entry_key{key, static_cast<float>(width), std::this_thread::get_id()};
+
+  std::scoped_lock lock(mutex_);
+  if (auto found = entries_by_key_.find(entry_key);
+      found != entries_by_key_.end()) {
+    entries_.erase(found->second);
+    entries_by_key_.erase(found);
+  }
+  while (entries_.size() >= max_entries_) {
+    entries_by_key_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+  entries_.push_front(Entry{
+      .key = entry_key,
+      .paragraph = std::move(paragraph),
+  });
+  entries_by_key_[std::move(entry_key)] = entries_.begin();
+}
+
+void ParagraphLayoutCache::Clear() {
+  std::scoped_lock lock(mutex_);
+  entries_by_key_.clear();
+  entries_.clear();
+}
+
+size_t ParagraphLayoutCache::GetEntryCount() const {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+size_t ParagraphLayoutCache::GetHitCount() const {
+  std::scoped_lock lock(mutex_);
+  return hit_count_;
+}
+
+size_t ParagraphLayoutCache::GetMissCount() const {
+  std::scoped_lock lock(mutex_);
+  return miss_count_;
+}
+
+void ParagraphLayoutCache::TraceStatsToTimeline() const {
+#if !FLUTTER_RELEASE
+  size_t entry_count;
+  size_t hit_count;
+  size_t miss_count;
+  {
+    std::scoped_lock lock(mutex_);
+    entry_count = entries_.size();
+    hit_count = hit_count_;
+    miss_count = miss_count_;
+  }
+  FML_TRACE_COUNTER("flutter",                                          //
+                    "ParagraphLayoutCache",                             //
+                    reinterpret_cast<int64_t>(this),                    //
+                    "Entries", static_cast<int64_t>(entry_count),       //
+                    "Hits", static_cast<int64_t>(hit_count),            //
+                    "Misses", static_cast<int64_t>(miss_count));
+#endif  // !FLUTTER_RELEASE
+}
+
+}  // namespace txt
@@ -0,0 +1,92 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef LIB_TXT_SRC_PARAGRAPH_LAYOUT_CACHE_H_
+#define LIB_TXT_SRC_PARAGRAPH_LAYOUT_CACHE_H_
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/modules/skparagraph/include/Paragraph.h"
+
+namespace txt {
+
+//------------------------------------------------------------------------------
+/// @brief      A bounded cache of laid out paragraphs, keyed by the recorded
+///             contents and styles of the paragraphs and the width they were
+///             laid out at.
+///
+///             Cached paragraphs are shared by all paragraphs with the same
+///             key and must not be laid out again. Paragraphs are only shared
+///             with paragraphs on the thread they were laid out on because
+///             painting a paragraph populates caches in it.
+///
+///             The cache may be used from multiple threads.
+///
+class ParagraphLayoutCache {
+ public:
+  static constexpr size_t kDefaultMaxEntries = 256u;
+
+  /// Paragraphs with longer keys are not cached.
+  static constexpr size_t kMaxKeyBytes = 16u * 1024u;
+
+  explicit ParagraphLayoutCache(size_t max_entries = kDefaultMaxEntries);
+
+  ~ParagraphLayoutCache();
+
+  std::shared_ptr<skia::textlayout::Paragraph> Find(const std::string& key,
+                                                    double width);
+
+  void Insert(const std::string& key,
+              double width,
+              std::shared_ptr<skia::textlayout::Paragraph> paragraph);
+
+  void Clear();
+
+  size_t GetEntryCount() const;
+
+  size_t GetHitCount() const;
+
+  size_t GetMissCount() const;
+
+ private:
+  struct Key {
+    std::string contents;
+    float width;
+    std::thread::id thread;
+
+    bool operator==(const Key& other) const;
+
+    struct Hash {
+      size_t operator()(const Key& key) const;
+    };
+  };
+
+  struct Entry {
+    Key key;
+    std::shared_ptr<skia::textlayout::Paragraph> paragraph;
+  };
+
+  const size_t max_entries_;
+  mutable std::mutex mutex_;
+  // Ordered from the most to the least recently used.
+  std::list<Entry> entries_;
+  std::unordered_map<Key, std::list<Entry>::iterator, Key::Hash>
+      entries_by_key_;
+  size_t hit_count_ = 0u;
+  size_t miss_count_ = 0u;
+
+  void TraceStatsToTimeline() const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ParagraphLayoutCache);
+};
+
+}  // namespace txt
+
+#endif  // LIB_TXT_SRC_PARAGRAPH_LAYOUT_CACHE_H_
@@ -18,6 +18,8 @@
 
 #include <algorithm>
 #include <numeric>
+#include "paragraph_builder_skia.h"
+#include "paragraph_layout_cache.h"
 #include "display_list/dl_paint.h"
 #include "fml/logging.h"
 #include "impeller/typographer/backends/skia/text_frame_skia.h"
@@ -250,22 +252,42 @@ ParagraphSkia::ParagraphSkia(std::unique_ptr<skt::Paragraph> paragraph,
       dl_paints_(dl_paints),
       impeller_enabled_(impeller_enabled) {}
 
+ParagraphSkia::ParagraphSkia(
+    std::shared_ptr<const ParagraphRecording> recording,
+    std::shared_ptr<FontCollection> font_collection,
+    std::shared_ptr<ParagraphLayoutCache> layout_cache,
+    std::vector<flutter::DlPaint>&& dl_paints,
+    bool impeller_enabled)
+    : dl_paints_(dl_paints),
+      impeller_enabled_(impeller_enabled),
+      recording_(std::move(recording)),
+      font_collection_(std::move(font_collection)),
+      layout_cache_(std::move(layout_cache)) {}
+
+skt::Paragraph* ParagraphSkia::GetParagraph() {
+  if (!paragraph_) {
+    paragraph_ =
+        ParagraphBuilderSkia::BuildRecording(*recording_, font_collection_);
+  }
+  return paragraph_.get();
+}
+
 double ParagraphSkia::GetMaxWidth() {
-  return SkScalarToDouble(paragraph_->getMaxWidth());
+  return SkScalarToDouble(GetParagraph()->getMaxWidth());
 }
 
 double ParagraphSkia::GetHeight() {
-  return SkScalarToDouble(paragraph_->getHeight());
+  return SkScalarToDouble(GetParagraph()->getHeight());
 }
 
 double ParagraphSkia::GetLongestLine() {
-  return SkScalarToDouble(paragraph_->getLongestLine());
+  return SkScalarToDouble(GetParagraph()->getLongestLine());
 }
 
 std::vector<LineMetrics>& ParagraphSkia::GetLineMetrics() {
   if (!line_metrics_) {
     std::vector<skt::LineMetrics> metrics;
-    paragraph_->getLineMetrics(metrics);
+    GetParagraph()->getLineMetrics(metrics);
 
     line_metrics_.emplace();
     line_metrics_styles_.reserve(
@@ -302,34 +324,51 @@ std::vector<LineMetrics>& ParagraphSkia::GetLineMetrics() {
 }
 
 double ParagraphSkia::GetMinIntrinsicWidth() {
-  return SkScalarToDouble(paragraph_->getMinIntrinsicWidth());
+  return SkScalarToDouble(GetParagraph()->getMinIntrinsicWidth());
 }
 
 double ParagraphSkia::GetMaxIntrinsicWidth() {
-  return SkScalarToDouble(paragraph_->getMaxIntrinsicWidth());
+  return SkScalarToDouble(GetParagraph()->getMaxIntrinsicWidth());
 }
 
 double ParagraphSkia::GetAlphabeticBaseline() {
-  return SkScalarToDouble(paragraph_->getAlphabeticBaseline());
+  return SkScalarToDouble(GetParagraph()->getAlphabeticBaseline());
 }
 
 double ParagraphSkia::GetIdeographicBaseline() {
-  return SkScalarToDouble(paragraph_->getIdeographicBaseline());
+  return SkScalarToDouble(GetParagraph()->getIdeographicBaseline());
 }
 
 bool ParagraphSkia::DidExceedMaxLines() {
-  return paragraph_->didExceedMaxLines();
+  return GetParagraph()->didExceedMaxLines();
 }
 
 void ParagraphSkia::Layout(double width) {
   line_metrics_.reset();
   line_metrics_styles_.clear();
+  if (!layout_cache_) {
+    paragraph_->layout(width);
+    return;
+  }
+
+  if (auto cached = layout_cache_->Find(recording_->key, width)) {
+    paragraph_ = std::move(cached);
+    paragraph_is_shared_ = true;
+    return;
+  }
+  // Paragraphs that are shared through the cache are never laid out again.
+  if (!paragraph_ || paragraph_is_shared_) {
+    paragraph_ =
+        ParagraphBuilderSkia::BuildRecording(*recording_, font_collection_);
+  }
   paragraph_->layout(width);
+  layout_cache_->Insert(recording_->key, width, paragraph_);
+  paragraph_is_shared_ = true;
 }
 
 bool ParagraphSkia::Paint(DisplayListBuilder* builder, double x, double y) {
   DisplayListParagraphPainter painter(builder, dl_paints_, impeller_enabled_);
-  paragraph_->paint(&painter, x, y);
+  GetParagraph()->paint(&painter, x, y);
   return true;
 }
 
@@ -338,7 +377,7 @@ std::vector<Paragraph::TextBox> ParagraphSkia::GetRectsForRange(
     size_t end,
     RectHeightStyle rect_height_style,
     RectWidthStyle rect_width_style) {
-  std::vector<skt::TextBox> skia_boxes = paragraph_->getRectsForRange(
+  std::vector<skt::TextBox> skia_boxes = GetParagraph()->getRectsForRange(
       start, end, static_cast<skt::RectHeightStyle>(rect_height_style),
       static_cast<skt::RectWidthStyle>(rect_width_style));
 
@@ -352,7 +391,8 @@ std::vector<Paragraph::TextBox> ParagraphSkia::GetRectsForRange(
 }
 
 std::vector<Paragraph::TextBox> ParagraphSkia::GetRectsForPlaceholders() {
-  std::vector<skt::TextBox> skia_boxes = paragraph_->getRectsForPlaceholders();
+  std::vector<skt::TextBox> skia_boxes =
+      GetParagraph()->getRectsForPlaceholders();
 
   std::vector<Paragraph::TextBox> boxes;
   for (const skt::TextBox& skia_box : skia_boxes) {
@@ -367,14 +407,14 @@ Paragraph::PositionWithAffinity ParagraphSkia::GetGlyphPositionAtCoordinate(
     double dx,
     double dy) {
   skt::PositionWithAffinity skia_pos =
-      paragraph_->getGlyphPositionAtCoordinate(dx, dy);
+      GetParagraph()->getGlyphPositionAtCoordinate(dx, dy);
 
   return ParagraphSkia::PositionWithAffinity(
       skia_pos.position, static_cast<Affinity>(skia_pos.affinity));
 }
 
 Paragraph::Range<size_t> ParagraphSkia::GetWordBoundary(size_t offset) {
-  skt::SkRange<size_t> range = paragraph_->getWordBoundary(offset);
+  skt::SkRange<size_t> range = GetParagraph()->getWordBoundary(offset);
   return Paragraph::Range<size_t>(range.start, range.end);
 }
 
@@ -17,14 +17,19 @@
 #ifndef LIB_TXT_SRC_PARAGRAPH_SKIA_H_
 #define LIB_TXT_SRC_PARAGRAPH_SKIA_H_
 
+#include <memory>
 #include <optional>
 
+#include "txt/font_collection.h"
 #include "txt/paragraph.h"
 
 #include "third_party/skia/modules/skparagraph/include/Paragraph.h"
 
 namespace txt {
 
+class ParagraphLayoutCache;
+struct ParagraphRecording;
+
 // Implementation of Paragraph based on Skia's text layout module.
 class ParagraphSkia : public Paragraph {
  public:
@@ -32,6 +37,15 @@ class ParagraphSkia : public Paragraph {
                 std::vector<flutter::DlPaint>&& dl_paints,
                 bool impeller_enabled);
 
+  // A paragraph that shares its layouts through the cache with other
+  // paragraphs of the same recording. The Skia paragraph is only built from
+  // the recording when there is no cached layout.
+  ParagraphSkia(std::shared_ptr<const ParagraphRecording> recording,
+                std::shared_ptr<FontCollection> font_collection,
+                std::shared_ptr<ParagraphLayoutCache> layout_cache,
+                std::vector<flutter::DlPaint>&& dl_paints,
+                bool impeller_enabled);
+
   virtual ~ParagraphSkia() = default;
 
   double GetMaxWidth() override;
@@ -72,11 +86,17 @@ class ParagraphSkia : public Paragraph {
  private:
   TextStyle SkiaToTxt(const skia::textlayout::TextStyle& skia);
 
-  std::unique_ptr<skia::textlayout::Paragraph> paragraph_;
+  skia::textlayout::Paragraph* GetParagraph();
+
+  std::shared_ptr<skia::textlayout::Paragraph> paragraph_;
   std::vector<flutter::DlPaint> dl_paints_;
   std::optional<std::vector<LineMetrics>> line_metrics_;
   std::vector<TextStyle> line_metrics_styles_;
   const bool impeller_enabled_;
+  std::shared_ptr<const ParagraphRecording> recording_;
+  std::shared_ptr<FontCollection> font_collection_;
+  std::shared_ptr<ParagraphLayoutCache> layout_cache_;
+  bool paragraph_is_shared_ = false;
 };
 
 }  // namespace txt
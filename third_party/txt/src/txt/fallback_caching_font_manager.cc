@@ -0,0 +1,147 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "txt/fallback_caching_font_manager.h"
+
+#include <utility>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkStream.h"
+#include "third_party/skia/include/core/SkString.h"
+
+namespace txt {
+
+bool FallbackCachingFontManager::Key::operator==(const Key& other) const {
+  return character == other.character && style == other.style &&
+         family_name == other.family_name && locales == other.locales;
+}
+
+size_t FallbackCachingFontManager::Key::Hash::operator()(
+    const Key& key) const {
+  return fml::HashCombine(key.character, key.style.weight(),
+                          key.style.width(), key.style.slant(),
+                          std::hash<std::string>{}(key.family_name),
+                          std::hash<std::string>{}(key.locales));
+}
+
+FallbackCachingFontManager::FallbackCachingFontManager(
+    sk_sp<SkFontMgr> font_manager)
+    : font_manager_(std::move(font_manager)) {
+  FML_DCHECK(font_manager_ != nullptr);
+}
+
+FallbackCachingFontManager::~FallbackCachingFontManager() = default;
+
+void FallbackCachingFontManager::ClearFallbackCache() {
+  std::scoped_lock lock(mutex_);
+  fallback_typefaces_.clear();
+}
+
+size_t FallbackCachingFontManager::GetFallbackCacheEntryCount() const {
+  std::scoped_lock lock(mutex_);
+  return fallback_typefaces_.size();
+}
+
+int FallbackCachingFontManager::onCountFamilies() const {
+  return font_manager_->countFamilies();
+}
+
+void FallbackCachingFontManager::onGetFamilyName(int index,
+                                                 SkString* familyName) const {
+  font_manager_->getFamilyName(index, familyName);
+}
+
+sk_sp<SkFontStyleSet> FallbackCachingFontManager::onCreateStyleSet(
+    int index) const {
+  return font_manager_->createStyleSet(index);
+}
+
+sk_sp<SkFontStyleSet> FallbackCachingFontManager::onMatchFamily(
+    const char familyName[]) const {
+  return font_manager_->matchFamily(familyName);
+}
+
+sk_sp<SkTypeface> FallbackCachingFontManager::onMatchFamilyStyle(
+    const char familyName[],
+    const SkFontStyle& style) const {
+  return font_manager_->matchFamilyStyle(familyName, style);
+}
+
+sk_sp<SkTypeface> FallbackCachingFontManager::onMatchFamilyStyleCharacter(
+    const char familyName[],
+    const SkFontStyle& style,
+    const char* bcp47[],
+    int bcp47Count,
+    SkUnichar character) const {
+  Key key{
+      .family_name = familyName ? familyName : "",
+      .style = style,
+      .character = character,
+  };
+  for (int i = 0; i < bcp47Count; i++) {
+    key.locales.append(bcp47[i]);
+    key.locales.push_back('\0');
+  }
+
+  {
+    std::scoped_lock lock(mutex_);
+    auto found = fallback_typefaces_.find(key);
+    if (found != fallback_typefaces_.end()) {
+      return found->second;
+    }
+  }
+
+  // Resolved without holding the lock, so that lookups on other threads
+  // aren't held up. Concurrent lookups of the same key resolve the same
+  // typeface.
+  sk_sp<SkTypeface> typeface;
+  {
+    TRACE_EVENT0("flutter", "FallbackCachingFontManager::ResolveFallback");
+    typeface = font_manager_->matchFamilyStyleCharacter(
+        familyName, style, bcp47, bcp47Count, character);
+  }
+
+  std::scoped_lock lock(mutex_);
+  if (fallback_typefaces_.size() >= kMaxEntries) {
+    // Text rarely needs this many fallback characters at once, so starting
+    // over is cheaper than tracking which entries were used last.
+    fallback_typefaces_.clear();
+  }
+  fallback_typefaces_.emplace(std::move(key), typeface);
+  return typeface;
+}
+
+sk_sp<SkTypeface> FallbackCachingFontManager::onMakeFromData(
+    sk_sp<SkData> data,
+    int ttcIndex) const {
+  return font_manager_->makeFromData(std::move(data), ttcIndex);
+}
+
+sk_sp<SkTypeface> FallbackCachingFontManager::onMakeFromStreamIndex(
+    std::unique_ptr<SkStreamAsset> stream,
+    int ttcIndex) const {
+  return font_manager_->makeFromStream(std::move(stream), ttcIndex);
+}
+
+sk_sp<SkTypeface> FallbackCachingFontManager::onMakeFromStreamArgs(
+    std::unique_ptr<SkStreamAsset> stream,
+    const SkFontArguments& args) const {
+  return font_manager_->makeFromStream(std::move(stream), args);
+}
+
+sk_sp<SkTypeface> FallbackCachingFontManager::onMakeFromFile(
+    const char path[],
+    int ttcIndex) const {
+  return font_manager_->makeFromFile(path, ttcIndex);
+}
+
+sk_sp<SkTypeface> FallbackCachingFontManager::onLegacyMakeTypeface(
+    const char familyName[],
+    SkFontStyle style) const {
+  return font_manager_->legacyMakeTypeface(familyName, style);
+}
+
+}  // namespace txt
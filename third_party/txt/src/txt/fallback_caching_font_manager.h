@@ -0,0 +1,117 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef LIB_TXT_SRC_FALLBACK_CACHING_FONT_MANAGER_H_
+#define LIB_TXT_SRC_FALLBACK_CACHING_FONT_MANAGER_H_
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkFontMgr.h"
+#include "third_party/skia/include/core/SkFontStyle.h"
+#include "third_party/skia/include/core/SkTypeface.h"
+
+namespace txt {
+
+//------------------------------------------------------------------------------
+/// @brief      A font manager that forwards to another font manager and
+///             remembers the fallback typefaces it resolves for characters.
+///
+///             Resolving a fallback typeface with
+///             |SkFontMgr::matchFamilyStyleCharacter| scans the system fonts
+///             on Android and Linux, which takes long enough to dominate the
+///             layout of text that mixes scripts or emoji. The resolved
+///             typefaces are cached by character along with the family, style
+///             and locales of the lookup, including characters no typeface
+///             was found for. As a font collection shares its font managers
+///             with its background collections, the cache is shared by all
+///             paragraphs laid out with them.
+///
+///             The font manager may be used from multiple threads.
+///
+class FallbackCachingFontManager : public SkFontMgr {
+ public:
+  static constexpr size_t kMaxEntries = 4096u;
+
+  explicit FallbackCachingFontManager(sk_sp<SkFontMgr> font_manager);
+
+  ~FallbackCachingFontManager() override;
+
+  /// Forget all resolved fallback typefaces, such as after fonts were
+  /// installed.
+  void ClearFallbackCache();
+
+  size_t GetFallbackCacheEntryCount() const;
+
+ private:
+  struct Key {
+    std::string family_name;
+    // The locales of the lookup, each followed by a null character.
+    std::string locales;
+    SkFontStyle style;
+    SkUnichar character;
+
+    bool operator==(const Key& other) const;
+
+    struct Hash {
+      size_t operator()(const Key& key) const;
+    };
+  };
+
+  const sk_sp<SkFontMgr> font_manager_;
+  mutable std::mutex mutex_;
+  mutable std::unordered_map<Key, sk_sp<SkTypeface>, Key::Hash>
+      fallback_typefaces_;
+
+  // |SkFontMgr|
+  int onCountFamilies() const override;
+
+  // |SkFontMgr|
+  void onGetFamilyName(int index, SkString* familyName) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkFontStyleSet> onCreateStyleSet(int index) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkFontStyleSet> onMatchFamily(const char familyName[]) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMatchFamilyStyle(const char familyName[],
+                                       const SkFontStyle&) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMatchFamilyStyleCharacter(
+      const char familyName[],
+      const SkFontStyle&,
+      const char* bcp47[],
+      int bcp47Count,
+      SkUnichar character) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromData(sk_sp<SkData>, int ttcIndex) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromStreamIndex(std::unique_ptr<SkStreamAsset>,
+                                          int ttcIndex) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromStreamArgs(std::unique_ptr<SkStreamAsset>,
+                                         const SkFontArguments&) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromFile(const char path[],
+                                   int ttcIndex) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onLegacyMakeTypeface(const char familyName[],
+                                         SkFontStyle) const override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FallbackCachingFontManager);
+};
+
+}  // namespace txt
+
+#endif  // LIB_TXT_SRC_FALLBACK_CACHING_FONT_MANAGER_H_
@@ -26,6 +26,7 @@
 #include <vector>
 #include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/third_party/txt/src/skia/paragraph_layout_cache.h"
 #include "txt/platform.h"
 #include "txt/text_style.h"
 
@@ -40,33 +41,46 @@ FontCollection::~FontCollection() {
 }
 
 size_t FontCollection::GetFontManagersCount() const {
+  std::scoped_lock lock(mutex_);
   return GetFontManagerOrder().size();
 }
 
 void FontCollection::SetupDefaultFontManager(
     uint32_t font_initialization_data) {
-  default_font_manager_ = GetDefaultFontManager(font_initialization_data);
-  skt_collection_.reset();
+  auto font_manager = GetDefaultFontManager(font_initialization_data);
+  SetDefaultFontManager(std::move(font_manager));
 }
 
 void FontCollection::SetDefaultFontManager(sk_sp<SkFontMgr> font_manager) {
+  std::scoped_lock lock(mutex_);
   default_font_manager_ = font_manager;
+  fallback_font_manager_ =
+      font_manager
+          ? sk_make_sp<FallbackCachingFontManager>(std::move(font_manager))
+          : nullptr;
   skt_collection_.reset();
+  fonts_generation_++;
 }
 
 void FontCollection::SetAssetFontManager(sk_sp<SkFontMgr> font_manager) {
+  std::scoped_lock lock(mutex_);
   asset_font_manager_ = font_manager;
   skt_collection_.reset();
+  fonts_generation_++;
 }
 
 void FontCollection::SetDynamicFontManager(sk_sp<SkFontMgr> font_manager) {
+  std::scoped_lock lock(mutex_);
   dynamic_font_manager_ = font_manager;
   skt_collection_.reset();
+  fonts_generation_++;
 }
 
 void FontCollection::SetTestFontManager(sk_sp<SkFontMgr> font_manager) {
+  std::scoped_lock lock(mutex_);
   test_font_manager_ = font_manager;
   skt_collection_.reset();
+  fonts_generation_++;
 }
 
 // Return the available font managers in the order they should be queried.
@@ -84,28 +98,84 @@ std::vector<sk_sp<SkFontMgr>> FontCollection::GetFontManagerOrder() const {
 }
 
 void FontCollection::DisableFontFallback() {
+  std::scoped_lock lock(mutex_);
   enable_font_fallback_ = false;
   if (skt_collection_) {
     skt_collection_->disableFontFallback();
   }
+  fonts_generation_++;
 }
 
 void FontCollection::ClearFontFamilyCache() {
+  std::scoped_lock lock(mutex_);
   if (skt_collection_) {
     skt_collection_->clearCaches();
   }
+  if (paragraph_layout_cache_) {
+    paragraph_layout_cache_->Clear();
+  }
+  if (fallback_font_manager_) {
+    fallback_font_manager_->ClearFallbackCache();
+  }
+  // Fonts were added to one of the font managers.
+  fonts_generation_++;
+}
+
+void FontCollection::EnableParagraphLayoutCache() {
+  std::scoped_lock lock(mutex_);
+  if (!paragraph_layout_cache_) {
+    paragraph_layout_cache_ = std::make_shared<ParagraphLayoutCache>();
+  }
+}
+
+const std::shared_ptr<ParagraphLayoutCache>&
+FontCollection::GetParagraphLayoutCache() const {
+  return paragraph_layout_cache_;
+}
+
+std::shared_ptr<FontCollection> FontCollection::CreateBackgroundCollection() {
+  auto collection = std::make_shared<FontCollection>();
+  collection->parent_ = shared_from_this();
+  // Copy the fonts on first use.
+  collection->parent_fonts_generation_ = fonts_generation_ - 1u;
+  return collection;
+}
+
+void FontCollection::UpdateFromParent() {
+  if (!parent_) {
+    return;
+  }
+  std::scoped_lock lock(parent_->mutex_);
+  const uint64_t generation = parent_->fonts_generation_;
+  if (generation == parent_fonts_generation_) {
+    return;
+  }
+  default_font_manager_ = parent_->default_font_manager_;
+  fallback_font_manager_ = parent_->fallback_font_manager_;
+  asset_font_manager_ = parent_->asset_font_manager_;
+  dynamic_font_manager_ = parent_->dynamic_font_manager_;
+  test_font_manager_ = parent_->test_font_manager_;
+  enable_font_fallback_ = parent_->enable_font_fallback_;
+  parent_fonts_generation_ = generation;
+  skt_collection_.reset();
 }
 
 sk_sp<skia::textlayout::FontCollection>
 FontCollection::CreateSktFontCollection() {
+  std::scoped_lock lock(mutex_);
+  UpdateFromParent();
   if (!skt_collection_) {
+    // Paragraphs laid out with the previous fonts are stale.
+    if (paragraph_layout_cache_) {
+      paragraph_layout_cache_->Clear();
+    }
     skt_collection_ = sk_make_sp<skia::textlayout::FontCollection>();
 
     std::vector<SkString> default_font_families;
     for (const std::string& family : GetDefaultFontFamilies()) {
       default_font_families.emplace_back(family);
     }
-    skt_collection_->setDefaultFontManager(default_font_manager_,
+    skt_collection_->setDefaultFontManager(fallback_font_manager_,
                                            default_font_families);
     skt_collection_->setAssetFontManager(asset_font_manager_);
     skt_collection_->setDynamicFontManager(dynamic_font_manager_);
@@ -17,7 +17,9 @@
 #ifndef LIB_TXT_SRC_FONT_COLLECTION_H_
 #define LIB_TXT_SRC_FONT_COLLECTION_H_
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -28,10 +30,17 @@
 #include "third_party/skia/include/core/SkRefCnt.h"
 #include "third_party/skia/modules/skparagraph/include/FontCollection.h"  // nogncheck
 #include "txt/asset_font_manager.h"
+#include "txt/fallback_caching_font_manager.h"
 #include "txt/text_style.h"
 
 namespace txt {
 
+class ParagraphLayoutCache;
+
+// A font collection may be used from multiple threads. The Skia text layout
+// font collection it constructs may not, so every thread that lays out text
+// at the same time as other threads needs its own collection created with
+// |CreateBackgroundCollection|.
 class FontCollection : public std::enable_shared_from_this<FontCollection> {
  public:
   FontCollection();
@@ -50,14 +59,33 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
   // missing from the requested font family.
   void DisableFontFallback();
 
-  // Remove all entries in the font family cache.
+  // Remove all entries in the font family cache and all resolved fallback
+  // typefaces.
   void ClearFontFamilyCache();
 
   // Construct a Skia text layout FontCollection based on this collection.
   sk_sp<skia::textlayout::FontCollection> CreateSktFontCollection();
 
+  // Share the layouts of paragraphs with the same text and styles that are
+  // laid out at the same width. The cached layouts are dropped whenever the
+  // fonts change.
+  void EnableParagraphLayoutCache();
+
+  // The paragraph layout cache, or null if it's not enabled.
+  const std::shared_ptr<ParagraphLayoutCache>& GetParagraphLayoutCache() const;
+
+  // Create a collection with the fonts of this collection for laying out text
+  // on another thread. The created collection picks up the fonts of this
+  // collection again whenever they change. It doesn't share the paragraph
+  // layout cache.
+  std::shared_ptr<FontCollection> CreateBackgroundCollection();
+
  private:
+  mutable std::mutex mutex_;
   sk_sp<SkFontMgr> default_font_manager_;
+  // Wraps the default font manager to cache the fallback typefaces it
+  // resolves for the Skia collection.
+  sk_sp<FallbackCachingFontManager> fallback_font_manager_;
   sk_sp<SkFontMgr> asset_font_manager_;
   sk_sp<SkFontMgr> dynamic_font_manager_;
   sk_sp<SkFontMgr> test_font_manager_;
@@ -66,8 +94,23 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
   // An equivalent font collection usable by the Skia text shaper library.
   sk_sp<skia::textlayout::FontCollection> skt_collection_;
 
+  std::shared_ptr<ParagraphLayoutCache> paragraph_layout_cache_;
+
+  // Incremented whenever the fonts of this collection change.
+  std::atomic<uint64_t> fonts_generation_ = 0u;
+
+  // The collection this collection was created from with
+  // |CreateBackgroundCollection|, and the generation of its fonts that were
+  // last copied.
+  std::shared_ptr<FontCollection> parent_;
+  uint64_t parent_fonts_generation_ = 0u;
+
   std::vector<sk_sp<SkFontMgr>> GetFontManagerOrder() const;
 
+  // Copy the fonts of the parent collection if they changed since they were
+  // last copied. The lock of this collection must be held.
+  void UpdateFromParent();
+
   FML_DISALLOW_COPY_AND_ASSIGN(FontCollection);
 };
 
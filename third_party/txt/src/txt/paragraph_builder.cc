@@ -16,6 +16,7 @@
 
 #include "paragraph_builder.h"
 
+#include "flutter/fml/icu_util.h"
 #include "flutter/third_party/txt/src/skia/paragraph_builder_skia.h"
 #include "paragraph_style.h"
 #include "third_party/icu/source/common/unicode/unistr.h"
@@ -32,6 +33,8 @@ std::unique_ptr<ParagraphBuilder> ParagraphBuilder::CreateSkiaBuilder(
     const ParagraphStyle& style,
     std::shared_ptr<FontCollection> font_collection,
     const bool impeller_enabled) {
+  // Text layout is what needs ICU data first when ICU is initialized lazily.
+  fml::icu::EnsureICUInitialized();
   return std::make_unique<ParagraphBuilderSkia>(style, font_collection,
                                                 impeller_enabled);
 }
@@ -17,6 +17,7 @@
 #ifndef TXT_TYPEFACE_FONT_ASSET_PROVIDER_H_
 #define TXT_TYPEFACE_FONT_ASSET_PROVIDER_H_
 
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -48,6 +49,8 @@ class TypefaceFontStyleSet : public SkFontStyleSet {
   sk_sp<SkTypeface> matchStyle(const SkFontStyle& pattern) override;
 
  private:
+  // Typefaces may be registered while other threads lay out text.
+  std::mutex mutex_;
   std::vector<sk_sp<SkTypeface>> typefaces_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(TypefaceFontStyleSet);
@@ -73,6 +76,7 @@ class TypefaceFontAssetProvider : public FontAssetProvider {
   sk_sp<SkFontStyleSet> MatchFamily(const std::string& family_name) override;
 
  private:
+  mutable std::mutex mutex_;
   std::unordered_map<std::string, sk_sp<TypefaceFontStyleSet>>
       registered_families_;
   std::vector<std::string> family_names_;
@@ -18,7 +18,9 @@
 
 #include <sstream>
 
+#include "txt/fallback_caching_font_manager.h"
 #include "txt/font_collection.h"
+#include "txt/platform.h"
 
 namespace txt {
 namespace testing {
@@ -39,5 +41,49 @@ TEST_F(FontCollectionTests, SettingUpDefaultFontManagerClearsCache) {
   sk_font_collection = font_collection.CreateSktFontCollection();
   ASSERT_NE(sk_font_collection->getFallbackManager().get(), nullptr);
 }
+
+TEST_F(FontCollectionTests, BackgroundCollectionsFollowTheirParentsFonts) {
+  auto font_collection = std::make_shared<FontCollection>();
+  auto background_collection = font_collection->CreateBackgroundCollection();
+  sk_sp<skia::textlayout::FontCollection> sk_font_collection =
+      background_collection->CreateSktFontCollection();
+  ASSERT_EQ(sk_font_collection->getFallbackManager().get(), nullptr);
+  // Background collections don't share the Skia collection.
+  ASSERT_NE(sk_font_collection.get(),
+            font_collection->CreateSktFontCollection().get());
+
+  font_collection->SetupDefaultFontManager(0);
+  sk_font_collection = background_collection->CreateSktFontCollection();
+  ASSERT_NE(sk_font_collection->getFallbackManager().get(), nullptr);
+  ASSERT_EQ(background_collection->GetFontManagersCount(), 1u);
+  ASSERT_EQ(sk_font_collection.get(),
+            background_collection->CreateSktFontCollection().get());
+}
+
+TEST_F(FontCollectionTests, FallbackTypefacesAreCachedPerLocale) {
+  auto font_manager =
+      sk_make_sp<FallbackCachingFontManager>(GetDefaultFontManager(0));
+  const char* english[] = {"en-US"};
+  const char* japanese[] = {"ja-JP"};
+  const SkUnichar character = 0x4E00;
+
+  sk_sp<SkTypeface> typeface = font_manager->matchFamilyStyleCharacter(
+      nullptr, SkFontStyle(), english, 1, character);
+  ASSERT_EQ(font_manager->GetFallbackCacheEntryCount(), 1u);
+  ASSERT_EQ(font_manager->matchFamilyStyleCharacter(nullptr, SkFontStyle(),
+                                                    english, 1, character),
+            typeface);
+  ASSERT_EQ(font_manager->GetFallbackCacheEntryCount(), 1u);
+
+  font_manager->matchFamilyStyleCharacter(nullptr, SkFontStyle(), japanese, 1,
+                                          character);
+  font_manager->matchFamilyStyleCharacter(nullptr, SkFontStyle::Bold(),
+                                          english, 1, character);
+  ASSERT_EQ(font_manager->GetFallbackCacheEntryCount(), 3u);
+
+  font_manager->ClearFallbackCache();
+  ASSERT_EQ(font_manager->GetFallbackCacheEntryCount(), 0u);
+}
+
 }  // namespace testing
 }  // namespace txt
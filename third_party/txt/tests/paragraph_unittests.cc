@@ -12,6 +12,7 @@
 #include "include/core/SkScalar.h"
 #include "runtime/test_font_data.h"
 #include "skia/paragraph_builder_skia.h"
+#include "skia/paragraph_layout_cache.h"
 #include "testing/canvas_test.h"
 
 namespace flutter {
@@ -241,5 +242,59 @@ TEST_F(PainterTest, DrawTextBlobNoImpeller) {
 }
 #endif  // IMPELLER_SUPPORTS_RENDERING
 
+TEST(ParagraphLayoutCacheTest, SharesLayoutsOfEqualParagraphs) {
+  auto font_collection = std::make_shared<txt::FontCollection>();
+  auto font_provider = std::make_unique<txt::TypefaceFontAssetProvider>();
+  for (auto& font : GetTestFontData()) {
+    font_provider->RegisterTypeface(font);
+  }
+  font_collection->SetAssetFontManager(
+      sk_make_sp<txt::AssetFontManager>(std::move(font_provider)));
+  font_collection->EnableParagraphLayoutCache();
+  const auto& cache = font_collection->GetParagraphLayoutCache();
+  ASSERT_NE(cache, nullptr);
+
+  auto layout = [&](const std::u16string& text, double width) {
+    txt::ParagraphBuilderSkia builder(txt::ParagraphStyle(), font_collection,
+                                      /*impeller_enabled=*/false);
+    auto style = txt::TextStyle();
+    style.font_size = 14;
+    style.font_families.push_back("ahem");
+    builder.PushStyle(style);
+    builder.AddText(text);
+    builder.Pop();
+    auto paragraph = builder.Build();
+    paragraph->Layout(width);
+    return paragraph;
+  };
+
+  auto narrow = layout(u"Hello World!", 50);
+  EXPECT_EQ(cache->GetMissCount(), 1u);
+  EXPECT_EQ(cache->GetHitCount(), 0u);
+
+  auto narrow_again = layout(u"Hello World!", 50);
+  EXPECT_EQ(cache->GetMissCount(), 1u);
+  EXPECT_EQ(cache->GetHitCount(), 1u);
+  EXPECT_EQ(narrow_again->GetHeight(), narrow->GetHeight());
+
+  auto wide = layout(u"Hello World!", 10000);
+  EXPECT_EQ(cache->GetMissCount(), 2u);
+  EXPECT_LT(wide->GetHeight(), narrow->GetHeight());
+
+  // Laying out a paragraph that shares its layout again doesn't change the
+  // layout of the paragraphs it was shared with.
+  narrow->Layout(10000);
+  EXPECT_EQ(cache->GetHitCount(), 2u);
+  EXPECT_EQ(narrow->GetHeight(), wide->GetHeight());
+  EXPECT_GT(narrow_again->GetHeight(), wide->GetHeight());
+
+  layout(u"Goodbye", 50);
+  EXPECT_EQ(cache->GetMissCount(), 3u);
+  EXPECT_EQ(cache->GetEntryCount(), 3u);
+
+  font_collection->ClearFontFamilyCache();
+  EXPECT_EQ(cache->GetEntryCount(), 0u);
+}
+
 }  // namespace testing
 }  // namespace flutter